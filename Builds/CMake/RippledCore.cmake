@@ -32,6 +32,7 @@ target_sources (xrpl_core PRIVATE
   src/ripple/beast/insight/impl/Hook.cpp
   src/ripple/beast/insight/impl/Metric.cpp
   src/ripple/beast/insight/impl/NullCollector.cpp
+  src/ripple/beast/insight/impl/PrometheusCollector.cpp
   src/ripple/beast/insight/impl/StatsDCollector.cpp
   src/ripple/beast/net/impl/IPAddressConversion.cpp
   src/ripple/beast/net/impl/IPAddressV4.cpp
@@ -60,6 +61,7 @@ target_sources (xrpl_core PRIVATE
     main sources:
       subdir: json
   #]===============================]
+  src/ripple/json/impl/FlatValue.cpp
   src/ripple/json/impl/JsonPropertyStream.cpp
   src/ripple/json/impl/Object.cpp
   src/ripple/json/impl/Output.cpp
@@ -75,6 +77,7 @@ target_sources (xrpl_core PRIVATE
   #]===============================]
   src/ripple/protocol/impl/AccountID.cpp
   src/ripple/protocol/impl/AMMCore.cpp
+  src/ripple/protocol/impl/ApplyProfile.cpp
   src/ripple/protocol/impl/Book.cpp
   src/ripple/protocol/impl/BuildInfo.cpp
   src/ripple/protocol/impl/ErrorCodes.cpp
@@ -120,6 +123,7 @@ target_sources (xrpl_core PRIVATE
   src/ripple/protocol/impl/UintTypes.cpp
   src/ripple/protocol/impl/digest.cpp
   src/ripple/protocol/impl/tokens.cpp
+  src/ripple/protocol/impl/writeJson.cpp
   src/ripple/protocol/impl/NFTSyntheticSerializer.cpp
   src/ripple/protocol/impl/NFTokenID.cpp
   src/ripple/protocol/impl/NFTokenOfferID.cpp
@@ -185,9 +189,11 @@ install (
     src/ripple/basics/make_SSLContext.h
     src/ripple/basics/MathUtilities.h
     src/ripple/basics/mulDiv.h
+    src/ripple/basics/Numa.h
     src/ripple/basics/Number.h
     src/ripple/basics/partitioned_unordered_map.h
     src/ripple/basics/PerfLog.h
+    src/ripple/basics/PersistentMap.h
     src/ripple/basics/random.h
     src/ripple/basics/RangeSet.h
     src/ripple/basics/README.md
@@ -216,6 +222,7 @@ install (
   DESTINATION include/ripple/crypto)
 install (
   FILES
+    src/ripple/json/FlatValue.h
     src/ripple/json/JsonPropertyStream.h
     src/ripple/json/MultivarJson.h
     src/ripple/json/Object.h
@@ -241,6 +248,7 @@ install (
     src/ripple/protocol/AccountID.h
     src/ripple/protocol/AMMCore.h
     src/ripple/protocol/AmountConversions.h
+    src/ripple/protocol/ApplyProfile.h
     src/ripple/protocol/Book.h
     src/ripple/protocol/BuildInfo.h
     src/ripple/protocol/ErrorCodes.h
@@ -303,6 +311,7 @@ install (
     src/ripple/protocol/nft.h
     src/ripple/protocol/nftPageMask.h
     src/ripple/protocol/tokens.h
+    src/ripple/protocol/writeJson.h
   DESTINATION include/ripple/protocol)
 install (
   FILES
@@ -331,6 +340,7 @@ install (
     src/ripple/server/impl/ServerImpl.h
     src/ripple/server/impl/io_list.h
     src/ripple/server/impl/Door.h
+    src/ripple/server/impl/LocalDoor.h
     src/ripple/server/impl/PlainHTTPPeer.h
     src/ripple/server/impl/PlainWSPeer.h
     src/ripple/server/impl/BaseHTTPPeer.h
@@ -339,6 +349,7 @@ install (
     src/ripple/server/impl/LowestLayer.h
     src/ripple/server/impl/SSLHTTPPeer.h
     src/ripple/server/impl/SSLWSPeer.h
+    src/ripple/server/impl/WSSendQueue.h
   DESTINATION include/ripple/server/impl)
 #[===================================[
    beast/legacy headers installation
@@ -459,12 +470,16 @@ target_sources (rippled PRIVATE
   src/ripple/app/ledger/AcceptedLedger.cpp
   src/ripple/app/ledger/AcceptedLedgerTx.cpp
   src/ripple/app/ledger/AccountStateSF.cpp
+  src/ripple/app/ledger/BookIndex.cpp
   src/ripple/app/ledger/BookListeners.cpp
   src/ripple/app/ledger/ConsensusTransSetSF.cpp
   src/ripple/app/ledger/Ledger.cpp
+  src/ripple/app/ledger/LedgerHashIndex.cpp
   src/ripple/app/ledger/LedgerHistory.cpp
+  src/ripple/app/ledger/ObligationsIndex.cpp
   src/ripple/app/ledger/OrderBookDB.cpp
   src/ripple/app/ledger/TransactionStateSF.cpp
+  src/ripple/app/ledger/impl/AcquireScheduler.cpp
   src/ripple/app/ledger/impl/BuildLedger.cpp
   src/ripple/app/ledger/impl/InboundLedger.cpp
   src/ripple/app/ledger/impl/InboundLedgers.cpp
@@ -479,6 +494,8 @@ target_sources (rippled PRIVATE
   src/ripple/app/ledger/impl/LedgerToJson.cpp
   src/ripple/app/ledger/impl/LocalTxs.cpp
   src/ripple/app/ledger/impl/OpenLedger.cpp
+  src/ripple/app/ledger/impl/ParallelApply.cpp
+  src/ripple/app/ledger/impl/ReplayBench.cpp
   src/ripple/app/ledger/impl/SkipListAcquire.cpp
   src/ripple/app/ledger/impl/TimeoutCounter.cpp
   src/ripple/app/ledger/impl/TransactionAcquire.cpp
@@ -497,6 +514,7 @@ target_sources (rippled PRIVATE
   src/ripple/app/misc/impl/AMMHelpers.cpp
   src/ripple/app/misc/impl/AMMUtils.cpp
   src/ripple/app/misc/CanonicalTXSet.cpp
+  src/ripple/app/misc/CompactNodeStore.cpp
   src/ripple/app/misc/FeeVoteImpl.cpp
   src/ripple/app/misc/HashRouter.cpp
   src/ripple/app/misc/NegativeUNLVote.cpp
@@ -509,6 +527,7 @@ target_sources (rippled PRIVATE
   src/ripple/app/misc/impl/LoadFeeTrack.cpp
   src/ripple/app/misc/impl/Manifest.cpp
   src/ripple/app/misc/impl/Transaction.cpp
+  src/ripple/app/misc/impl/TxJsonCache.cpp
   src/ripple/app/misc/impl/TxQ.cpp
   src/ripple/app/misc/impl/ValidatorKeys.cpp
   src/ripple/app/misc/impl/ValidatorList.cpp
@@ -528,8 +547,10 @@ target_sources (rippled PRIVATE
   src/ripple/app/paths/impl/DirectStep.cpp
   src/ripple/app/paths/impl/PaySteps.cpp
   src/ripple/app/paths/impl/XRPEndpointStep.cpp
+  src/ripple/app/rdb/backend/detail/impl/AccountTxIndex.cpp
   src/ripple/app/rdb/backend/detail/impl/Node.cpp
   src/ripple/app/rdb/backend/detail/impl/Shard.cpp
+  src/ripple/app/rdb/backend/detail/impl/TxIndex.cpp
   src/ripple/app/rdb/backend/impl/PostgresDatabase.cpp
   src/ripple/app/rdb/backend/impl/SQLiteDatabase.cpp
   src/ripple/app/rdb/impl/Download.cpp
@@ -570,6 +591,7 @@ target_sources (rippled PRIVATE
   src/ripple/app/tx/impl/OfferStream.cpp
   src/ripple/app/tx/impl/PayChan.cpp
   src/ripple/app/tx/impl/Payment.cpp
+  src/ripple/app/tx/impl/PreflightCache.cpp
   src/ripple/app/tx/impl/SetAccount.cpp
   src/ripple/app/tx/impl/SetOracle.cpp
   src/ripple/app/tx/impl/SetRegularKey.cpp
@@ -588,10 +610,15 @@ target_sources (rippled PRIVATE
   #]===============================]
   src/ripple/basics/impl/Archive.cpp
   src/ripple/basics/impl/BasicConfig.cpp
+  src/ripple/basics/impl/CacheBudget.cpp
+  src/ripple/basics/impl/HeapProfile.cpp
+  src/ripple/basics/impl/HugePages.cpp
   src/ripple/basics/impl/ResolverAsio.cpp
+  src/ripple/basics/impl/Trace.cpp
   src/ripple/basics/impl/UptimeClock.cpp
   src/ripple/basics/impl/make_SSLContext.cpp
   src/ripple/basics/impl/mulDiv.cpp
+  src/ripple/basics/impl/Numa.cpp
   src/ripple/basics/impl/partitioned_unordered_map.cpp
   #[===============================[
      main sources:
@@ -611,6 +638,7 @@ target_sources (rippled PRIVATE
   src/ripple/core/impl/LoadEvent.cpp
   src/ripple/core/impl/LoadMonitor.cpp
   src/ripple/core/impl/SociDB.cpp
+  src/ripple/core/impl/TimeoutWheel.cpp
   src/ripple/core/impl/Workers.cpp
   src/ripple/core/Pg.cpp
   #[===============================[
@@ -633,6 +661,8 @@ target_sources (rippled PRIVATE
   src/ripple/ledger/impl/PaymentSandbox.cpp
   src/ripple/ledger/impl/RawStateTable.cpp
   src/ripple/ledger/impl/ReadView.cpp
+  src/ripple/ledger/impl/RecordingView.cpp
+  src/ripple/ledger/impl/SLEView.cpp
   src/ripple/ledger/impl/View.cpp
   #[===============================[
      main sources:
@@ -657,6 +687,7 @@ target_sources (rippled PRIVATE
   src/ripple/nodestore/backend/NullFactory.cpp
   src/ripple/nodestore/backend/RocksDBFactory.cpp
   src/ripple/nodestore/impl/BatchWriter.cpp
+  src/ripple/nodestore/impl/BloomFilter.cpp
   src/ripple/nodestore/impl/Database.cpp
   src/ripple/nodestore/impl/DatabaseNodeImp.cpp
   src/ripple/nodestore/impl/DatabaseRotatingImp.cpp
@@ -664,7 +695,10 @@ target_sources (rippled PRIVATE
   src/ripple/nodestore/impl/DeterministicShard.cpp
   src/ripple/nodestore/impl/DecodedBlob.cpp
   src/ripple/nodestore/impl/DummyScheduler.cpp
+  src/ripple/nodestore/impl/FetchSuspender.cpp
+  src/ripple/nodestore/impl/IoUringQueue.cpp
   src/ripple/nodestore/impl/ManagerImp.cpp
+  src/ripple/nodestore/impl/NodeDictionary.cpp
   src/ripple/nodestore/impl/NodeObject.cpp
   src/ripple/nodestore/impl/Shard.cpp
   src/ripple/nodestore/impl/ShardInfo.cpp
@@ -682,8 +716,10 @@ target_sources (rippled PRIVATE
   src/ripple/overlay/impl/PeerReservationTable.cpp
   src/ripple/overlay/impl/PeerSet.cpp
   src/ripple/overlay/impl/ProtocolVersion.cpp
+  src/ripple/overlay/impl/SendQueue.cpp
   src/ripple/overlay/impl/TrafficCount.cpp
   src/ripple/overlay/impl/TxMetrics.cpp
+  src/ripple/overlay/impl/TxRelayFanout.cpp
   #[===============================[
      main sources:
        subdir: peerfinder
@@ -714,6 +750,7 @@ target_sources (rippled PRIVATE
   src/ripple/rpc/handlers/AccountOffers.cpp
   src/ripple/rpc/handlers/AccountTx.cpp
   src/ripple/rpc/handlers/AMMInfo.cpp
+  src/ripple/rpc/handlers/ApplyProfile.cpp
   src/ripple/rpc/handlers/BlackList.cpp
   src/ripple/rpc/handlers/BookOffers.cpp
   src/ripple/rpc/handlers/CanDelete.cpp
@@ -728,6 +765,7 @@ target_sources (rippled PRIVATE
   src/ripple/rpc/handlers/GatewayBalances.cpp
   src/ripple/rpc/handlers/GetCounts.cpp
   src/ripple/rpc/handlers/GetAggregatePrice.cpp
+  src/ripple/rpc/handlers/HeapProfile.cpp
   src/ripple/rpc/handlers/LedgerAccept.cpp
   src/ripple/rpc/handlers/LedgerCleanerHandler.cpp
   src/ripple/rpc/handlers/LedgerClosed.cpp
@@ -752,6 +790,7 @@ target_sources (rippled PRIVATE
   src/ripple/rpc/handlers/Print.cpp
   src/ripple/rpc/handlers/Random.cpp
   src/ripple/rpc/handlers/Reservations.cpp
+  src/ripple/rpc/handlers/ResourceUsage.cpp
   src/ripple/rpc/handlers/RipplePathFind.cpp
   src/ripple/rpc/handlers/ServerInfo.cpp
   src/ripple/rpc/handlers/ServerState.cpp
@@ -761,6 +800,7 @@ target_sources (rippled PRIVATE
   src/ripple/rpc/handlers/Submit.cpp
   src/ripple/rpc/handlers/SubmitMultiSigned.cpp
   src/ripple/rpc/handlers/Subscribe.cpp
+  src/ripple/rpc/handlers/TraceHandler.cpp
   src/ripple/rpc/handlers/TransactionEntry.cpp
   src/ripple/rpc/handlers/Tx.cpp
   src/ripple/rpc/handlers/TxHistory.cpp
@@ -774,9 +814,11 @@ target_sources (rippled PRIVATE
   src/ripple/rpc/handlers/WalletPropose.cpp
   src/ripple/rpc/impl/DeliveredAmount.cpp
   src/ripple/rpc/impl/Handler.cpp
+  src/ripple/rpc/impl/LedgerDataStream.cpp
   src/ripple/rpc/impl/LegacyPathFind.cpp
   src/ripple/rpc/impl/RPCHandler.cpp
   src/ripple/rpc/impl/RPCHelpers.cpp
+  src/ripple/rpc/impl/ResponseCache.cpp
   src/ripple/rpc/impl/Role.cpp
   src/ripple/rpc/impl/ServerHandler.cpp
   src/ripple/rpc/impl/ShardArchiveHandler.cpp
@@ -795,10 +837,12 @@ target_sources (rippled PRIVATE
   #]===============================]
   src/ripple/server/impl/JSONRPCUtil.cpp
   src/ripple/server/impl/Port.cpp
+  src/ripple/server/impl/WSSendQueue.cpp
   #[===============================[
      main sources:
        subdir: shamap
   #]===============================]
+  src/ripple/shamap/impl/FullBelowCache.cpp
   src/ripple/shamap/impl/NodeFamily.cpp
   src/ripple/shamap/impl/SHAMap.cpp
   src/ripple/shamap/impl/SHAMapDelta.cpp
@@ -817,10 +861,12 @@ if (tests)
   target_sources (rippled PRIVATE
     src/test/app/AccountDelete_test.cpp
     src/test/app/AccountTxPaging_test.cpp
+    src/test/app/AcquireScheduler_test.cpp
     src/test/app/AmendmentTable_test.cpp
     src/test/app/AMM_test.cpp
     src/test/app/AMMCalc_test.cpp
     src/test/app/AMMExtended_test.cpp
+    src/test/app/CanonicalTXSet_test.cpp
     src/test/app/Check_test.cpp
     src/test/app/Clawback_test.cpp
     src/test/app/CrossingLimits_test.cpp
@@ -834,6 +880,7 @@ if (tests)
     src/test/app/Flow_test.cpp
     src/test/app/Freeze_test.cpp
     src/test/app/HashRouter_test.cpp
+    src/test/app/LedgerHashIndex_test.cpp
     src/test/app/LedgerHistory_test.cpp
     src/test/app/LedgerLoad_test.cpp
     src/test/app/LedgerMaster_test.cpp
@@ -849,9 +896,11 @@ if (tests)
     src/test/app/Offer_test.cpp
     src/test/app/Oracle_test.cpp
     src/test/app/OversizeMeta_test.cpp
+    src/test/app/ParallelApply_test.cpp
     src/test/app/Path_test.cpp
     src/test/app/PayChan_test.cpp
     src/test/app/PayStrand_test.cpp
+    src/test/app/PreflightCache_test.cpp
     src/test/app/PseudoTx_test.cpp
     src/test/app/RCLCensorshipDetector_test.cpp
     src/test/app/RCLValidations_test.cpp
@@ -867,6 +916,8 @@ if (tests)
     src/test/app/Ticket_test.cpp
     src/test/app/Transaction_ordering_test.cpp
     src/test/app/TrustAndBalance_test.cpp
+    src/test/app/TxBenchmark_test.cpp
+    src/test/app/TxJsonCache_test.cpp
     src/test/app/TxQ_test.cpp
     src/test/app/ValidatorKeys_test.cpp
     src/test/app/ValidatorList_test.cpp
@@ -877,18 +928,26 @@ if (tests)
          subdir: basics
     #]===============================]
     src/test/basics/Buffer_test.cpp
+    src/test/basics/CacheBudget_test.cpp
     src/test/basics/DetectCrash_test.cpp
     src/test/basics/Expected_test.cpp
     src/test/basics/FileUtilities_test.cpp
     src/test/basics/IOUAmount_test.cpp
     src/test/basics/KeyCache_test.cpp
+    src/test/basics/LatencyHistogram_test.cpp
+    src/test/basics/Log_test.cpp
     src/test/basics/Number_test.cpp
     src/test/basics/PerfLog_test.cpp
+    src/test/basics/PersistentMap_test.cpp
     src/test/basics/RangeSet_test.cpp
     src/test/basics/scope_test.cpp
+    src/test/basics/ShardedTaggedCache_test.cpp
+    src/test/basics/SlabAllocator_test.cpp
     src/test/basics/Slice_test.cpp
     src/test/basics/StringUtilities_test.cpp
+    src/test/basics/SubscriptionIndex_test.cpp
     src/test/basics/TaggedCache_test.cpp
+    src/test/basics/Trace_test.cpp
     src/test/basics/XRPAmount_test.cpp
     src/test/basics/base58_test.cpp
     src/test/basics/base64_test.cpp
@@ -910,6 +969,7 @@ if (tests)
     src/test/beast/beast_CurrentThreadName_test.cpp
     src/test/beast/beast_Journal_test.cpp
     src/test/beast/beast_PropertyStream_test.cpp
+    src/test/beast/beast_PrometheusCollector_test.cpp
     src/test/beast/beast_Zero_test.cpp
     src/test/beast/beast_abstract_clock_test.cpp
     src/test/beast/beast_basic_seconds_clock_test.cpp
@@ -925,6 +985,7 @@ if (tests)
          subdir: consensus
     #]===============================]
     src/test/consensus/ByzantineFailureSim_test.cpp
+    src/test/consensus/ConsensusScalingSim_test.cpp
     src/test/consensus/Consensus_test.cpp
     src/test/consensus/DistributedValidatorsSim_test.cpp
     src/test/consensus/LedgerTiming_test.cpp
@@ -940,8 +1001,11 @@ if (tests)
     src/test/core/Config_test.cpp
     src/test/core/Coroutine_test.cpp
     src/test/core/CryptoPRNG_test.cpp
+    src/test/core/JobQueueBench_test.cpp
     src/test/core/JobQueue_test.cpp
+    src/test/core/ParallelFor_test.cpp
     src/test/core/SociDB_test.cpp
+    src/test/core/TimeoutWheel_test.cpp
     src/test/core/Workers_test.cpp
     #[===============================[
        test sources:
@@ -957,11 +1021,13 @@ if (tests)
        test sources:
          subdir: json
     #]===============================]
+    src/test/json/FlatValue_test.cpp
     src/test/json/Object_test.cpp
     src/test/json/Output_test.cpp
     src/test/json/Writer_test.cpp
     src/test/json/json_value_test.cpp
     src/test/json/MultivarJson_test.cpp
+    src/test/json/SharedJson_test.cpp
     #[===============================[
        test sources:
          subdir: jtx
@@ -1020,6 +1086,8 @@ if (tests)
     src/test/ledger/Invariants_test.cpp
     src/test/ledger/PaymentSandbox_test.cpp
     src/test/ledger/PendingSaves_test.cpp
+    src/test/ledger/PendingWrites_test.cpp
+    src/test/ledger/SLEView_test.cpp
     src/test/ledger/SkipList_test.cpp
     src/test/ledger/View_test.cpp
     #[===============================[
@@ -1033,8 +1101,11 @@ if (tests)
     #]===============================]
     src/test/nodestore/Backend_test.cpp
     src/test/nodestore/Basics_test.cpp
+    src/test/nodestore/Benchmark_test.cpp
+    src/test/nodestore/BloomFilter_test.cpp
     src/test/nodestore/DatabaseShard_test.cpp
     src/test/nodestore/Database_test.cpp
+    src/test/nodestore/NegativeCache_test.cpp
     src/test/nodestore/Timing_test.cpp
     src/test/nodestore/import_test.cpp
     src/test/nodestore/varint_test.cpp
@@ -1043,12 +1114,15 @@ if (tests)
          subdir: overlay
     #]===============================]
     src/test/overlay/ProtocolVersion_test.cpp
+    src/test/overlay/SendQueue_test.cpp
     src/test/overlay/cluster_test.cpp
     src/test/overlay/short_read_test.cpp
     src/test/overlay/compression_test.cpp
     src/test/overlay/reduce_relay_test.cpp
     src/test/overlay/handshake_test.cpp
     src/test/overlay/tx_reduce_relay_test.cpp
+    src/test/overlay/TxRelayFanout_test.cpp
+    src/test/overlay/overlay_bench_test.cpp
     #[===============================[
        test sources:
          subdir: peerfinder
@@ -1075,7 +1149,9 @@ if (tests)
     src/test/protocol/Seed_test.cpp
     src/test/protocol/SeqProxy_test.cpp
     src/test/protocol/TER_test.cpp
+    src/test/protocol/digest_test.cpp
     src/test/protocol/types_test.cpp
+    src/test/protocol/writeJson_test.cpp
     #[===============================[
        test sources:
          subdir: resource
@@ -1094,6 +1170,7 @@ if (tests)
     src/test/rpc/AccountTx_test.cpp
     src/test/rpc/AmendmentBlocked_test.cpp
     src/test/rpc/AMMInfo_test.cpp
+    src/test/rpc/ApplyProfile_test.cpp
     src/test/rpc/Book_test.cpp
     src/test/rpc/DepositAuthorized_test.cpp
     src/test/rpc/DeliveredAmount_test.cpp
@@ -1101,6 +1178,7 @@ if (tests)
     src/test/rpc/GatewayBalances_test.cpp
     src/test/rpc/GetAggregatePrice_test.cpp
     src/test/rpc/GetCounts_test.cpp
+    src/test/rpc/HeapProfile_test.cpp
     src/test/rpc/JSONRPC_test.cpp
     src/test/rpc/KeyGeneration_test.cpp
     src/test/rpc/LedgerClosed_test.cpp
@@ -1115,13 +1193,16 @@ if (tests)
     src/test/rpc/OwnerInfo_test.cpp
     src/test/rpc/Peers_test.cpp
     src/test/rpc/ReportingETL_test.cpp
+    src/test/rpc/ResponseCache_test.cpp
     src/test/rpc/Roles_test.cpp
+    src/test/rpc/RPCBenchmark_test.cpp
     src/test/rpc/RPCCall_test.cpp
     src/test/rpc/RPCOverload_test.cpp
     src/test/rpc/RobustTransaction_test.cpp
     src/test/rpc/ServerInfo_test.cpp
     src/test/rpc/ShardArchiveHandler_test.cpp
     src/test/rpc/Status_test.cpp
+    src/test/rpc/SubmitBatch_test.cpp
     src/test/rpc/Subscribe_test.cpp
     src/test/rpc/Transaction_test.cpp
     src/test/rpc/TransactionEntry_test.cpp
@@ -1136,11 +1217,15 @@ if (tests)
     #]===============================]
     src/test/server/ServerStatus_test.cpp
     src/test/server/Server_test.cpp
+    src/test/server/WSSendQueue_test.cpp
     #[===============================[
        test sources:
          subdir: shamap
     #]===============================]
     src/test/shamap/FetchPack_test.cpp
+    src/test/shamap/FullBelowCache_test.cpp
+    src/test/shamap/NodeFamily_test.cpp
+    src/test/shamap/SHAMapBench_test.cpp
     src/test/shamap/SHAMapSync_test.cpp
     src/test/shamap/SHAMap_test.cpp
     #[===============================[
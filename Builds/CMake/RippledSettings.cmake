@@ -115,6 +115,15 @@ option(boost_show_deprecated
   "Allow boost to fail on deprecated usage. Only useful if you're trying\
   to find deprecated calls."
   OFF)
+option(tracing
+  "Compile in the timing spans exported by the trace command. When OFF, \
+  spans cost nothing and trace returns no events."
+  ON)
+option(apply_profile
+  "Compile in the counters reported by the apply_profile command, which count \
+  the ledger entries, fields and bytes each transaction type touches. When \
+  OFF, the counters cost nothing and apply_profile reports no counts."
+  OFF)
 option(beast_hashers
   "Use local implementations for sha/ripemd hashes (experimental, not recommended)"
   OFF)
@@ -34,6 +34,7 @@
 #include <ripple/app/misc/TxQ.h>
 #include <ripple/app/misc/ValidatorKeys.h>
 #include <ripple/app/misc/ValidatorList.h>
+#include <ripple/basics/Trace.h>
 #include <ripple/basics/random.h>
 #include <ripple/beast/core/LexicalCast.h>
 #include <ripple/consensus/LedgerTiming.h>
@@ -400,6 +401,178 @@ RCLConsensus::Adaptor::onClose(
             validatorKeys_.nodeID}};
 }
 
+// The close time of the ledger built for a position, and whether the
+// position agreed on one
+static std::pair<NetClock::time_point, bool>
+builtCloseTime(
+    NetClock::time_point position,
+    NetClock::duration closeResolution,
+    RCLCxLedger const& prevLedger)
+{
+    if (position == NetClock::time_point{})
+    {
+        // We agreed to disagree on the close time
+        using namespace std::chrono_literals;
+        return {prevLedger.closeTime() + 1s, false};
+    }
+
+    // We agreed on a close time
+    return {
+        effCloseTime(position, closeResolution, prevLedger.closeTime()), true};
+}
+
+// The transactions of a consensus set, ready to be applied. Those that
+// can't be deserialized are added to failed.
+static CanonicalTXSet
+makeRetriableTxs(
+    RCLTxSet const& txns,
+    std::set<TxID>& failed,
+    beast::Journal j)
+{
+    // We want to put transactions in an unpredictable but deterministic order:
+    // we use the hash of the set.
+    CanonicalTXSet retriableTxs{txns.map_->getHash().as_uint256()};
+
+    JLOG(j.debug()) << "Building canonical tx set: " << retriableTxs.key();
+
+    std::vector<std::shared_ptr<STTx const>> parsed;
+
+    for (auto const& item : *txns.map_)
+    {
+        try
+        {
+            parsed.push_back(
+                std::make_shared<STTx const>(SerialIter{item.slice()}));
+            JLOG(j.debug()) << "    Tx: " << item.key();
+        }
+        catch (std::exception const& ex)
+        {
+            failed.insert(item.key());
+            JLOG(j.warn())
+                << "    Tx: " << item.key() << " throws: " << ex.what();
+        }
+    }
+
+    retriableTxs.insert(parsed);
+    return retriableTxs;
+}
+
+void
+RCLConsensus::Adaptor::onStablePosition(
+    Result const& result,
+    RCLCxLedger const& prevLedger,
+    NetClock::duration closeResolution)
+{
+    if (!app_.config().SPECULATIVE_BUILD ||
+        mode_ == ConsensusMode::wrongLedger)
+        return;
+
+    auto const [closeTime, closeTimeCorrect] = builtCloseTime(
+        result.position.closeTime(), closeResolution, prevLedger);
+    auto speculation = std::make_shared<Speculation>(
+        prevLedger.id(),
+        result.txns.id(),
+        closeTime,
+        closeTimeCorrect,
+        closeResolution);
+
+    {
+        std::lock_guard lock(speculationMutex_);
+
+        // Building this position already, or still busy with another
+        if (speculation_ &&
+            (speculation_->matches(*speculation) || !speculation_->finished))
+            return;
+        speculation_ = speculation;
+    }
+
+    JLOG(j_.debug()) << "Speculatively building ledger #"
+                     << prevLedger.seq() + 1 << " from " << result.txns.id();
+
+    if (!app_.getJobQueue().addJob(
+            jtACCEPT,
+            "speculativeBuild",
+            [this, speculation, txns = result.txns, prevLedger]() {
+                buildSpeculation(speculation, txns, prevLedger);
+            }))
+    {
+        std::lock_guard lock(speculationMutex_);
+        speculation->finished = true;
+        speculationCv_.notify_all();
+    }
+}
+
+void
+RCLConsensus::Adaptor::buildSpeculation(
+    std::shared_ptr<Speculation> const& speculation,
+    RCLTxSet const& txns,
+    RCLCxLedger const& prevLedger)
+{
+    trace::Span span("RCLConsensus::buildSpeculation", prevLedger.seq() + 1);
+
+    std::shared_ptr<Ledger> built;
+    try
+    {
+        speculation->retriableTxs =
+            makeRetriableTxs(txns, speculation->failed, j_);
+        built = buildLedger(
+            prevLedger.ledger_,
+            speculation->closeTime,
+            speculation->closeTimeCorrect,
+            speculation->closeResolution,
+            app_,
+            speculation->retriableTxs,
+            speculation->failed,
+            j_);
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.warn()) << "Speculative build failed: " << e.what();
+    }
+
+    std::lock_guard lock(speculationMutex_);
+    speculation->built = std::move(built);
+    speculation->finished = true;
+    speculationCv_.notify_all();
+}
+
+std::shared_ptr<Ledger>
+RCLConsensus::Adaptor::takeSpeculation(
+    RCLCxLedger const& previousLedger,
+    CanonicalTXSet& retriableTxs,
+    NetClock::time_point closeTime,
+    bool closeTimeCorrect,
+    NetClock::duration closeResolution,
+    std::set<TxID>& failedTxs)
+{
+    std::unique_lock lock(speculationMutex_);
+    auto const speculation = std::move(speculation_);
+    if (!speculation)
+        return nullptr;
+
+    if (!speculation->matches(Speculation{
+            previousLedger.id(),
+            retriableTxs.key(),
+            closeTime,
+            closeTimeCorrect,
+            closeResolution}))
+    {
+        JLOG(j_.debug()) << "Discarding speculative ledger for "
+                         << speculation->txSet;
+        return nullptr;
+    }
+
+    speculationCv_.wait(lock, [&speculation] { return speculation->finished; });
+    if (!speculation->built)
+        return nullptr;
+
+    JLOG(j_.debug()) << "Using speculative ledger "
+                     << speculation->built->info().hash;
+    retriableTxs = std::move(speculation->retriableTxs);
+    failedTxs.insert(speculation->failed.begin(), speculation->failed.end());
+    return speculation->built;
+}
+
 void
 RCLConsensus::Adaptor::onForceAccept(
     Result const& result,
@@ -456,31 +629,16 @@ RCLConsensus::Adaptor::doAccept(
     ConsensusMode const& mode,
     Json::Value&& consensusJson)
 {
+    trace::Span span("RCLConsensus::doAccept", prevLedger.seq() + 1);
     prevProposers_ = result.proposers;
     prevRoundTime_ = result.roundTime.read();
 
-    bool closeTimeCorrect;
-
     const bool proposing = mode == ConsensusMode::proposing;
     const bool haveCorrectLCL = mode != ConsensusMode::wrongLedger;
     const bool consensusFail = result.state == ConsensusState::MovedOn;
 
-    auto consensusCloseTime = result.position.closeTime();
-
-    if (consensusCloseTime == NetClock::time_point{})
-    {
-        // We agreed to disagree on the close time
-        using namespace std::chrono_literals;
-        consensusCloseTime = prevLedger.closeTime() + 1s;
-        closeTimeCorrect = false;
-    }
-    else
-    {
-        // We agreed on a close time
-        consensusCloseTime = effCloseTime(
-            consensusCloseTime, closeResolution, prevLedger.closeTime());
-        closeTimeCorrect = true;
-    }
+    auto const [consensusCloseTime, closeTimeCorrect] = builtCloseTime(
+        result.position.closeTime(), closeResolution, prevLedger);
 
     JLOG(j_.debug()) << "Report: Prop=" << (proposing ? "yes" : "no")
                      << " val=" << (validating_ ? "yes" : "no")
@@ -491,30 +649,7 @@ RCLConsensus::Adaptor::doAccept(
 
     //--------------------------------------------------------------------------
     std::set<TxID> failed;
-
-    // We want to put transactions in an unpredictable but deterministic order:
-    // we use the hash of the set.
-    //
-    // FIXME: Use a std::vector and a custom sorter instead of CanonicalTXSet?
-    CanonicalTXSet retriableTxs{result.txns.map_->getHash().as_uint256()};
-
-    JLOG(j_.debug()) << "Building canonical tx set: " << retriableTxs.key();
-
-    for (auto const& item : *result.txns.map_)
-    {
-        try
-        {
-            retriableTxs.insert(
-                std::make_shared<STTx const>(SerialIter{item.slice()}));
-            JLOG(j_.debug()) << "    Tx: " << item.key();
-        }
-        catch (std::exception const& ex)
-        {
-            failed.insert(item.key());
-            JLOG(j_.warn())
-                << "    Tx: " << item.key() << " throws: " << ex.what();
-        }
-    }
+    CanonicalTXSet retriableTxs = makeRetriableTxs(result.txns, failed, j_);
 
     auto built = buildLCL(
         prevLedger,
@@ -770,6 +905,14 @@ RCLConsensus::Adaptor::buildLCL(
             assert(replayData->parent()->info().hash == previousLedger.id());
             return buildLedger(*replayData, tapNONE, app_, j_);
         }
+        if (auto speculated = takeSpeculation(
+                previousLedger,
+                retriableTxs,
+                closeTime,
+                closeTimeCorrect,
+                closeResolution,
+                failedTxs))
+            return speculated;
         return buildLedger(
             previousLedger.ledger_,
             closeTime,
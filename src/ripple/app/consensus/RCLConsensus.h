@@ -24,6 +24,7 @@
 #include <ripple/app/consensus/RCLCxLedger.h>
 #include <ripple/app/consensus/RCLCxPeerPos.h>
 #include <ripple/app/consensus/RCLCxTx.h>
+#include <ripple/app/misc/CanonicalTXSet.h>
 #include <ripple/app/misc/FeeVote.h>
 #include <ripple/app/misc/NegativeUNLVote.h>
 #include <ripple/basics/CountedObject.h>
@@ -36,6 +37,7 @@
 #include <ripple/protocol/STValidation.h>
 #include <ripple/shamap/SHAMap.h>
 #include <atomic>
+#include <condition_variable>
 #include <mutex>
 #include <set>
 namespace ripple {
@@ -87,6 +89,52 @@ class RCLConsensus
         RCLCensorshipDetector<TxID, LedgerIndex> censorshipDetector_;
         NegativeUNLVote nUnlVote_;
 
+        // A ledger built for our position before consensus accepted it
+        struct Speculation
+        {
+            LedgerHash const parent;
+            uint256 const txSet;
+            NetClock::time_point const closeTime;
+            bool const closeTimeCorrect;
+            NetClock::duration const closeResolution;
+
+            // Set by the build, and only read once it has finished. The
+            // ledger is null if the build failed.
+            bool finished = false;
+            std::shared_ptr<Ledger> built;
+            CanonicalTXSet retriableTxs;
+            std::set<TxID> failed;
+
+            Speculation(
+                LedgerHash const& parent_,
+                uint256 const& txSet_,
+                NetClock::time_point closeTime_,
+                bool closeTimeCorrect_,
+                NetClock::duration closeResolution_)
+                : parent(parent_)
+                , txSet(txSet_)
+                , closeTime(closeTime_)
+                , closeTimeCorrect(closeTimeCorrect_)
+                , closeResolution(closeResolution_)
+                , retriableTxs(txSet_)
+            {
+            }
+
+            bool
+            matches(Speculation const& other) const
+            {
+                return parent == other.parent && txSet == other.txSet &&
+                    closeTime == other.closeTime &&
+                    closeTimeCorrect == other.closeTimeCorrect &&
+                    closeResolution == other.closeResolution;
+            }
+        };
+
+        // The most recent speculative build, which buildLCL takes
+        std::mutex speculationMutex_;
+        std::condition_variable speculationCv_;
+        std::shared_ptr<Speculation> speculation_;
+
     public:
         using Ledger_t = RCLCxLedger;
         using NodeID_t = NodeID;
@@ -305,6 +353,22 @@ class RCLConsensus
             NetClock::time_point const& closeTime,
             ConsensusMode mode);
 
+        /** Start building the ledger for a position likely to be accepted.
+
+            Does nothing unless speculative builds are configured. Only one
+            build runs at a time, and each position is built only once.
+
+            @param result The current state of consensus
+            @param prevLedger The closed ledger consensus works from
+            @param closeResolution The resolution used in agreeing on an
+                                   effective closeTime
+        */
+        void
+        onStablePosition(
+            Result const& result,
+            RCLCxLedger const& prevLedger,
+            NetClock::duration closeResolution);
+
         /** Process the accepted ledger.
 
             @param result The result of consensus
@@ -396,6 +460,39 @@ class RCLConsensus
             std::chrono::milliseconds roundTime,
             std::set<TxID>& failedTxs);
 
+        /** Build the ledger for a speculation on a job thread. */
+        void
+        buildSpeculation(
+            std::shared_ptr<Speculation> const& speculation,
+            RCLTxSet const& txns,
+            RCLCxLedger const& prevLedger);
+
+        /** Take the ledger speculatively built from the given inputs.
+
+            Any other speculative ledger is discarded. If the build is still
+            running, this waits for it.
+
+            @param previousLedger Prior ledger building upon
+            @param retriableTxs The set of transactions to apply; replaced
+                                with the speculation's transactions to retry
+                                if its ledger is returned.
+            @param closeTime The time the ledger closed
+            @param closeTimeCorrect Whether consensus agreed on close time
+            @param closeResolution Resolution used to determine consensus close
+                                   time
+            @param failedTxs Receives the transactions the speculation could
+                             not apply if its ledger is returned.
+            @return The ledger, or nullptr if there is none for these inputs.
+        */
+        std::shared_ptr<Ledger>
+        takeSpeculation(
+            RCLCxLedger const& previousLedger,
+            CanonicalTXSet& retriableTxs,
+            NetClock::time_point closeTime,
+            bool closeTimeCorrect,
+            NetClock::duration closeResolution,
+            std::set<TxID>& failedTxs);
+
         /** Validate the given ledger and share with peers as necessary
 
             @param ledger The ledger to validate
@@ -32,23 +32,36 @@ RCLCxPeerPos::RCLCxPeerPos(
     Slice const& signature,
     uint256 const& suppression,
     Proposal&& proposal)
-    : publicKey_(publicKey)
-    , suppression_(suppression)
-    , proposal_(std::move(proposal))
+    : data_(std::make_shared<Data const>(
+          publicKey,
+          signature,
+          suppression,
+          std::move(proposal)))
+{
+}
+
+RCLCxPeerPos::Data::Data(
+    PublicKey const& pk,
+    Slice const& sig,
+    uint256 const& suppress,
+    Proposal&& prop)
+    : publicKey(pk)
+    , suppression(suppress)
+    , proposal(std::move(prop))
 {
     // The maximum allowed size of a signature is 72 bytes; we verify
     // this elsewhere, but we want to be extra careful here:
-    assert(signature.size() != 0 && signature.size() <= signature_.capacity());
+    assert(sig.size() != 0 && sig.size() <= signature.capacity());
 
-    if (signature.size() != 0 && signature.size() <= signature_.capacity())
-        signature_.assign(signature.begin(), signature.end());
+    if (sig.size() != 0 && sig.size() <= signature.capacity())
+        signature.assign(sig.begin(), sig.end());
 }
 
 bool
 RCLCxPeerPos::checkSign() const
 {
     return verifyDigest(
-        publicKey(), proposal_.signingHash(), signature(), false);
+        publicKey(), proposal().signingHash(), signature(), false);
 }
 
 Json::Value
@@ -31,6 +31,7 @@
 #include <boost/container/static_vector.hpp>
 #include <chrono>
 #include <cstdint>
+#include <memory>
 #include <string>
 
 namespace ripple {
@@ -38,7 +39,10 @@ namespace ripple {
 /** A peer's signed, proposed position for use in RCLConsensus.
 
     Carries a ConsensusProposal signed by a peer. Provides value semantics
-    but manages shared storage of the peer position internally.
+    but manages shared storage of the peer position internally: the job
+    queue, NetworkOPs and the consensus round's current and recent positions
+    all hold copies, which share the one allocation made when the proposal
+    was received.
 */
 class RCLCxPeerPos
 {
@@ -70,27 +74,27 @@ public:
     Slice
     signature() const
     {
-        return {signature_.data(), signature_.size()};
+        return {data_->signature.data(), data_->signature.size()};
     }
 
     //! Public key of peer that sent the proposal
     PublicKey const&
     publicKey() const
     {
-        return publicKey_;
+        return data_->publicKey;
     }
 
     //! Unique id used by hash router to suppress duplicates
     uint256 const&
     suppressionID() const
     {
-        return suppression_;
+        return data_->suppression;
     }
 
     Proposal const&
     proposal() const
     {
-        return proposal_;
+        return data_->proposal;
     }
 
     //! JSON representation of proposal
@@ -98,10 +102,21 @@ public:
     getJson() const;
 
 private:
-    PublicKey publicKey_;
-    uint256 suppression_;
-    Proposal proposal_;
-    boost::container::static_vector<std::uint8_t, 72> signature_;
+    struct Data : public CountedObject<Data>
+    {
+        Data(
+            PublicKey const& pk,
+            Slice const& sig,
+            uint256 const& suppress,
+            Proposal&& prop);
+
+        PublicKey publicKey;
+        uint256 suppression;
+        Proposal proposal;
+        boost::container::static_vector<std::uint8_t, 72> signature;
+    };
+
+    std::shared_ptr<Data const> data_;
 
     template <class Hasher>
     void
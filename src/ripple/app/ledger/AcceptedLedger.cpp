@@ -54,6 +54,91 @@ AcceptedLedger::AcceptedLedger(
         [](auto const& a, auto const& b) {
             return a->getTxnSeq() < b->getTxnSeq();
         });
+
+    buildIndex();
+}
+
+std::vector<std::size_t> const&
+AcceptedLedger::transactionsOf(AccountID const& account) const
+{
+    static std::vector<std::size_t> const none;
+
+    if (auto const it = index_.accounts.find(account);
+        it != index_.accounts.end())
+        return it->second;
+    return none;
+}
+
+void
+AcceptedLedger::buildIndex()
+{
+    for (std::size_t i = 0; i < transactions_.size(); ++i)
+    {
+        auto const& tx = *transactions_[i];
+
+        for (auto const& account : tx.getAffected())
+            index_.accounts[account].push_back(i);
+
+        index_.books.insert(tx.getBooks().begin(), tx.getBooks().end());
+
+        for (auto const& node : tx.getMeta().getNodes())
+        {
+            if (!node.isFieldPresent(sfLedgerEntryType) ||
+                !node.isFieldPresent(sfLedgerIndex))
+                continue;
+
+            auto const type =
+                safe_cast<LedgerEntryType>(node.getFieldU16(sfLedgerEntryType));
+            auto const key = node.getFieldH256(sfLedgerIndex);
+
+            if (type == ltRIPPLE_STATE)
+                index_.rippleStates.insert(key);
+
+            int delta = 0;
+            if (node.getFName() == sfCreatedNode)
+            {
+                index_.created[type].push_back(key);
+                delta = 1;
+            }
+            else if (node.getFName() == sfDeletedNode)
+            {
+                index_.deleted[type].push_back(key);
+                delta = -1;
+            }
+            else
+                continue;
+
+            auto const fields = dynamic_cast<STObject const*>(
+                node.peekAtPField(delta > 0 ? sfNewFields : sfFinalFields));
+            if (!fields)
+                continue;
+
+            // Fields with their default value, such as the currency of XRP,
+            // are left out of the metadata of new entries
+            if (type == ltDIR_NODE && fields->isFieldPresent(sfExchangeRate) &&
+                (*fields)[~sfRootIndex] == key)
+            {
+                Book book;
+                book.in.currency =
+                    (*fields)[~sfTakerPaysCurrency].value_or(beast::zero);
+                book.in.account =
+                    (*fields)[~sfTakerPaysIssuer].value_or(beast::zero);
+                book.out.currency =
+                    (*fields)[~sfTakerGetsCurrency].value_or(beast::zero);
+                book.out.account =
+                    (*fields)[~sfTakerGetsIssuer].value_or(beast::zero);
+                index_.bookChanges.emplace_back(book, delta);
+            }
+            else if (type == ltAMM)
+            {
+                Issue const issue1 = (*fields)[~sfAsset].value_or(xrpIssue());
+                Issue const issue2 =
+                    (*fields)[~sfAsset2].value_or(xrpIssue());
+                index_.bookChanges.emplace_back(Book(issue1, issue2), delta);
+                index_.bookChanges.emplace_back(Book(issue2, issue1), delta);
+            }
+        }
+    }
 }
 
 }  // namespace ripple
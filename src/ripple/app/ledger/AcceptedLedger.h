@@ -21,7 +21,13 @@
 #define RIPPLE_APP_LEDGER_ACCEPTEDLEDGER_H_INCLUDED
 
 #include <ripple/app/ledger/AcceptedLedgerTx.h>
+#include <ripple/basics/UnorderedContainers.h>
 #include <ripple/protocol/AccountID.h>
+#include <ripple/protocol/Book.h>
+#include <ripple/protocol/LedgerFormats.h>
+
+#include <map>
+#include <vector>
 
 namespace ripple {
 
@@ -72,9 +78,55 @@ public:
         return transactions_.end();
     }
 
+    /** What the transactions of the ledger touched, computed once when the
+        ledger is accepted so that the consumers of a validated ledger don't
+        each walk the metadata again.
+    */
+    struct Index
+    {
+        // The positions, in transaction order, of the transactions that
+        // affected each account
+        hash_map<AccountID, std::vector<std::size_t>> accounts;
+
+        // The books of the offers the transactions created, modified or
+        // deleted
+        hash_set<Book> books;
+
+        // The books whose directories and AMMs the transactions created (+1)
+        // or deleted (-1)
+        std::vector<std::pair<Book, int>> bookChanges;
+
+        // The trust lines the transactions created, modified or deleted
+        hash_set<uint256> rippleStates;
+
+        // The keys of the objects the transactions created and deleted
+        std::map<LedgerEntryType, std::vector<uint256>> created;
+        std::map<LedgerEntryType, std::vector<uint256>> deleted;
+    };
+
+    Index const&
+    index() const
+    {
+        return index_;
+    }
+
+    /** The transactions that affected the account, in transaction order. */
+    std::vector<std::size_t> const&
+    transactionsOf(AccountID const& account) const;
+
+    AcceptedLedgerTx const&
+    operator[](std::size_t i) const
+    {
+        return *transactions_[i];
+    }
+
 private:
+    void
+    buildIndex();
+
     std::shared_ptr<ReadView const> mLedger;
     std::vector<std::unique_ptr<AcceptedLedgerTx>> transactions_;
+    Index index_;
 };
 
 }  // namespace ripple
@@ -22,6 +22,7 @@
 #include <ripple/basics/StringUtilities.h>
 #include <ripple/protocol/UintTypes.h>
 #include <ripple/protocol/jss.h>
+#include <algorithm>
 
 namespace ripple {
 
@@ -39,6 +40,37 @@ AcceptedLedgerTx::AcceptedLedgerTx(
     met->add(s);
     mRawMeta = std::move(s.modData());
 
+    for (auto const& node : mMeta.getNodes())
+    {
+        if (!node.isFieldPresent(sfLedgerEntryType) ||
+            node.getFieldU16(sfLedgerEntryType) != ltOFFER)
+            continue;
+
+        // We need a field that contains the TakerGets and TakerPays
+        // parameters.
+        SField const* field = nullptr;
+        if (node.getFName() == sfModifiedNode)
+            field = &sfPreviousFields;
+        else if (node.getFName() == sfCreatedNode)
+            field = &sfNewFields;
+        else if (node.getFName() == sfDeletedNode)
+            field = &sfFinalFields;
+        else
+            continue;
+
+        auto const data =
+            dynamic_cast<STObject const*>(node.peekAtPField(*field));
+        if (!data || !data->isFieldPresent(sfTakerPays) ||
+            !data->isFieldPresent(sfTakerGets))
+            continue;
+
+        Book const book{
+            data->getFieldAmount(sfTakerGets).issue(),
+            data->getFieldAmount(sfTakerPays).issue()};
+        if (std::find(mBooks.begin(), mBooks.end(), book) == mBooks.end())
+            mBooks.push_back(book);
+    }
+
     mJson = Json::objectValue;
     mJson[jss::transaction] = mTxn->getJson(JsonOptions::none);
 
@@ -22,6 +22,7 @@
 
 #include <ripple/app/ledger/Ledger.h>
 #include <ripple/protocol/AccountID.h>
+#include <ripple/protocol/Book.h>
 #include <boost/container/flat_set.hpp>
 
 namespace ripple {
@@ -65,6 +66,14 @@ public:
         return mAffected;
     }
 
+    /** The books of the offers that the transaction created, modified or
+        deleted, without duplicates. */
+    std::vector<Book> const&
+    getBooks() const
+    {
+        return mBooks;
+    }
+
     TxID
     getTransactionID() const
     {
@@ -88,6 +97,12 @@ public:
     std::string
     getEscMeta() const;
 
+    Blob const&
+    getRawMeta() const
+    {
+        return mRawMeta;
+    }
+
     Json::Value const&
     getJson() const
     {
@@ -98,6 +113,7 @@ private:
     std::shared_ptr<STTx const> mTxn;
     TxMeta mMeta;
     boost::container::flat_set<AccountID> mAffected;
+    std::vector<Book> mBooks;
     Blob mRawMeta;
     Json::Value mJson;
 };
@@ -0,0 +1,155 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/BookIndex.h>
+#include <ripple/basics/Log.h>
+#include <ripple/ledger/BookDirs.h>
+#include <ripple/protocol/STArray.h>
+
+namespace ripple {
+
+namespace {
+
+// The books of every offer that the transactions in a validated ledger
+// created, modified or deleted.
+hash_set<Book>
+changedBooks(ReadView const& ledger)
+{
+    hash_set<Book> books;
+
+    for (auto const& [tx, meta] : ledger.txs)
+    {
+        (void)tx;
+        if (!meta || !meta->isFieldPresent(sfAffectedNodes))
+            continue;
+
+        for (auto const& node : meta->getFieldArray(sfAffectedNodes))
+        {
+            if (node.getFieldU16(sfLedgerEntryType) != ltOFFER)
+                continue;
+
+            auto const& fields = node.getFName() == sfCreatedNode
+                ? sfNewFields
+                : sfFinalFields;
+            if (!node.isFieldPresent(fields))
+                continue;
+
+            auto const& inner =
+                static_cast<STObject const&>(node.peekAtField(fields));
+            if (inner.isFieldPresent(sfTakerPays) &&
+                inner.isFieldPresent(sfTakerGets))
+                books.emplace(
+                    inner.getFieldAmount(sfTakerPays).issue(),
+                    inner.getFieldAmount(sfTakerGets).issue());
+        }
+    }
+
+    return books;
+}
+
+}  // namespace
+
+BookIndex::BookIndex(
+    std::size_t maxBooks,
+    std::size_t maxOffers,
+    beast::Journal j)
+    : maxBooks_(maxBooks), maxOffers_(maxOffers), j_(j)
+{
+}
+
+std::shared_ptr<BookIndex::Offers const>
+BookIndex::getOffers(
+    ReadView const& ledger,
+    Book const& book,
+    std::size_t limit)
+{
+    if (!enabled() || ledger.open())
+        return nullptr;
+
+    auto const usable = [&](Offers const& offers) {
+        return offers.complete || offers.offers.size() >= limit;
+    };
+
+    {
+        std::lock_guard lock(mutex_);
+        if (!ledger_ || ledger_->info().hash != ledger.info().hash)
+            return nullptr;
+
+        if (auto const it = books_.find(book); it != books_.end())
+            return usable(*it->second) ? it->second : nullptr;
+
+        if (books_.size() >= maxBooks_)
+            return nullptr;
+    }
+
+    // Read the book without holding the lock
+    auto offers = std::make_shared<Offers>();
+    BookDirs const dirs(ledger, book);
+    auto it = dirs.begin();
+    for (; it != dirs.end() && offers->offers.size() < maxOffers_; ++it)
+    {
+        if (*it)
+            offers->offers.push_back(*it);
+        else
+            JLOG(j_.warn()) << "Missing offer in " << book;
+    }
+    offers->complete = it == dirs.end();
+
+    {
+        std::lock_guard lock(mutex_);
+        if (ledger_ && ledger_->info().hash == ledger.info().hash &&
+            books_.size() < maxBooks_)
+            books_.emplace(book, offers);
+    }
+
+    return usable(*offers) ? offers : nullptr;
+}
+
+void
+BookIndex::update(std::shared_ptr<ReadView const> const& ledger)
+{
+    if (!enabled())
+        return;
+
+    {
+        std::lock_guard lock(mutex_);
+        if (ledger_ && ledger_->info().hash == ledger->info().hash)
+            return;
+    }
+
+    auto const changed = changedBooks(*ledger);
+
+    std::lock_guard lock(mutex_);
+    if (ledger_ && ledger_->info().hash == ledger->info().parentHash)
+    {
+        for (auto const& book : changed)
+            books_.erase(book);
+    }
+    else
+    {
+        books_.clear();
+    }
+
+    JLOG(j_.debug()) << "Indexed ledger " << ledger->info().seq << ", keeping "
+                     << books_.size() << " books (" << changed.size()
+                     << " changed)";
+    ledger_ = ledger;
+}
+
+}  // namespace ripple
@@ -0,0 +1,100 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_BOOKINDEX_H_INCLUDED
+#define RIPPLE_APP_LEDGER_BOOKINDEX_H_INCLUDED
+
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/ledger/ReadView.h>
+#include <ripple/protocol/Book.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ripple {
+
+/** The offers of order books in the last validated ledger.
+
+    The first offers of a book are read from its directories the first
+    time they are asked for, and kept for the following validated ledgers
+    until one of them changes an offer of the book, which the transaction
+    metadata records. Requests for the same books, such as book_offers, are
+    then served without walking the book directories.
+
+    Only the last validated ledger is indexed: reads of other ledgers,
+    including the open ledger, must walk the directories.
+*/
+class BookIndex
+{
+public:
+    /** The first offers of a book, in the order they would be taken. */
+    struct Offers
+    {
+        std::vector<std::shared_ptr<SLE const>> offers;
+
+        // Whether these are all the offers of the book
+        bool complete = false;
+    };
+
+    /** Create the index.
+
+        @param maxBooks The number of books kept. Zero disables the index.
+        @param maxOffers The number of offers kept of each book.
+    */
+    BookIndex(std::size_t maxBooks, std::size_t maxOffers, beast::Journal j);
+
+    bool
+    enabled() const
+    {
+        return maxBooks_ != 0;
+    }
+
+    /** Return the first offers of a book.
+
+        @param limit The number of offers wanted.
+        @return At least `limit` offers, or every offer of the book if it
+                has fewer. `nullptr` if the ledger isn't the one indexed,
+                or if the index doesn't keep that many offers or books.
+    */
+    std::shared_ptr<Offers const>
+    getOffers(ReadView const& ledger, Book const& book, std::size_t limit);
+
+    /** Index a newly validated ledger.
+
+        The books whose offers the ledger changed are dropped. Every book
+        is dropped if the ledger doesn't follow the one indexed.
+    */
+    void
+    update(std::shared_ptr<ReadView const> const& ledger);
+
+private:
+    std::size_t const maxBooks_;
+    std::size_t const maxOffers_;
+    beast::Journal const j_;
+
+    std::mutex mutex_;
+    std::shared_ptr<ReadView const> ledger_;
+    hash_map<Book, std::shared_ptr<Offers const>> books_;
+};
+
+}  // namespace ripple
+
+#endif
@@ -24,6 +24,7 @@
 #include <ripple/beast/utility/Journal.h>
 #include <ripple/ledger/ApplyView.h>
 #include <chrono>
+#include <functional>
 #include <memory>
 
 namespace ripple {
@@ -32,7 +33,9 @@ class Application;
 class CanonicalTXSet;
 class Ledger;
 class LedgerReplay;
+class OpenView;
 class SHAMap;
+class STTx;
 
 /** Build a new ledger by applying consensus transactions
 
@@ -78,5 +81,39 @@ buildLedger(
     Application& app,
     beast::Journal j);
 
+/** Where the time spent building a ledger went. */
+struct BuildLedgerTimes
+{
+    // Applying the transactions and writing the results to the ledger
+    std::chrono::nanoseconds apply{};
+
+    // Hashing the modified SHAMap nodes
+    std::chrono::nanoseconds flush{};
+
+    // Writing those nodes to the node store
+    std::chrono::nanoseconds store{};
+};
+
+/** Build a new ledger by replaying transactions, timing each phase
+
+    Like the overload above, except that each transaction is applied by
+    calling `applyTx`, and the new ledger's nodes are written to the node
+    store before returning rather than in the background.
+
+    @param replayData Data of the ledger to replay
+    @param applyTx Applies one transaction to the ledger being built
+    @param times Incremented by the time spent in each phase
+    @param app Handle to application instance
+    @param j Journal to use for logging
+    @return The newly built ledger
+ */
+std::shared_ptr<Ledger>
+buildLedger(
+    LedgerReplay const& replayData,
+    std::function<void(OpenView&, STTx const&)> const& applyTx,
+    BuildLedgerTimes& times,
+    Application& app,
+    beast::Journal j);
+
 }  // namespace ripple
 #endif
@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <ripple/app/ledger/ConsensusTransSetSF.h>
+#include <ripple/app/ledger/OpenLedger.h>
 #include <ripple/app/ledger/TransactionMaster.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/NetworkOPs.h>
@@ -82,6 +83,14 @@ ConsensusTransSetSF::getNode(SHAMapHash const& nodeHash) const
     if (m_nodeCache.retrieve(nodeHash, nodeData))
         return nodeData;
 
+    auto const makeNode = [&nodeHash](STTx const& stx) {
+        Serializer s;
+        s.add32(HashPrefix::transactionID);
+        stx.add(s);
+        assert(sha512Half(s.slice()) == nodeHash.as_uint256());
+        return s.peekData();
+    };
+
     auto txn =
         app_.getMasterTransaction().fetch_from_cache(nodeHash.as_uint256());
 
@@ -89,12 +98,16 @@ ConsensusTransSetSF::getNode(SHAMapHash const& nodeHash) const
     {
         // this is a transaction, and we have it
         JLOG(j_.trace()) << "Node in our acquiring TX set is TXN we have";
-        Serializer s;
-        s.add32(HashPrefix::transactionID);
-        txn->getSTransaction()->add(s);
-        assert(sha512Half(s.slice()) == nodeHash.as_uint256());
-        nodeData = s.peekData();
-        return nodeData;
+        return makeNode(*txn->getSTransaction());
+    }
+
+    // Most transactions a peer proposes have been applied to our open ledger
+    // too, even once they have aged out of the transaction cache.
+    if (auto const stx =
+            app_.openLedger().current()->txRead(nodeHash.as_uint256()).first)
+    {
+        JLOG(j_.trace()) << "Node in our acquiring TX set is in open ledger";
+        return makeNode(*stx);
     }
 
     return std::nullopt;
@@ -21,6 +21,7 @@
 #define RIPPLE_APP_LEDGER_INBOUNDLEDGER_H_INCLUDED
 
 #include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/ledger/impl/AcquireScheduler.h>
 #include <ripple/app/ledger/impl/TimeoutCounter.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/basics/CountedObject.h>
@@ -31,6 +32,9 @@
 
 namespace ripple {
 
+// millisecond for each ledger timeout
+auto constexpr ledgerAcquireTimeout = std::chrono::milliseconds{3000};
+
 // A ledger we are trying to acquire
 class InboundLedger final : public TimeoutCounter,
                             public std::enable_shared_from_this<InboundLedger>,
@@ -53,7 +57,8 @@ public:
         std::uint32_t seq,
         Reason reason,
         clock_type&,
-        std::unique_ptr<PeerSet> peerSet);
+        std::unique_ptr<PeerSet> peerSet,
+        std::shared_ptr<AcquireScheduler> scheduler = {});
 
     ~InboundLedger();
 
@@ -130,6 +135,14 @@ private:
     void
     trigger(std::shared_ptr<Peer> const&, TriggerReason);
 
+    void
+    sendRequest(
+        protocol::TMGetLedger const& request,
+        std::shared_ptr<Peer> const& peer);
+
+    AcquireScheduler::Priority
+    priority() const;
+
     std::vector<neededHash_t>
     getNeededHashes();
 
@@ -184,7 +197,8 @@ private:
     std::uint32_t mSeq;
     Reason const mReason;
 
-    std::set<uint256> mRecentNodes;
+    // Shared with the other inbound ledgers to coordinate requests
+    std::shared_ptr<AcquireScheduler> mScheduler;
 
     SHAMapAddNode mStats;
 
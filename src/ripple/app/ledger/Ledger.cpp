@@ -24,6 +24,7 @@
 #include <ripple/app/ledger/LedgerToJson.h>
 #include <ripple/app/ledger/OrderBookDB.h>
 #include <ripple/app/ledger/PendingSaves.h>
+#include <ripple/app/ledger/PendingWrites.h>
 #include <ripple/app/ledger/TransactionMaster.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/HashRouter.h>
@@ -466,6 +467,23 @@ Ledger::read(Keylet const& k) const
     return sle;
 }
 
+std::optional<SLEView>
+Ledger::readLazy(Keylet const& k) const
+{
+    if (k.key == beast::zero)
+    {
+        assert(false);
+        return std::nullopt;
+    }
+    auto const& item = stateMap_.peekItem(k.key);
+    if (!item)
+        return std::nullopt;
+    SLEView view(item);
+    if (!k.check(view.getType()))
+        return std::nullopt;
+    return view;
+}
+
 //------------------------------------------------------------------------------
 
 auto
@@ -816,10 +834,11 @@ Ledger::updateNegativeUNL()
 
 //------------------------------------------------------------------------------
 bool
-Ledger::walkLedger(beast::Journal j, bool parallel) const
+Ledger::walkLedger(beast::Journal j, bool parallel, int workers) const
 {
     std::vector<SHAMapMissingNode> missingNodes1;
     std::vector<SHAMapMissingNode> missingNodes2;
+    bool complete = true;
 
     if (stateMap_.getHash().isZero() && !info_.accountHash.isZero() &&
         !stateMap_.fetchRoot(SHAMapHash{info_.accountHash}, nullptr))
@@ -830,7 +849,7 @@ Ledger::walkLedger(beast::Journal j, bool parallel) const
     else
     {
         if (parallel)
-            return stateMap_.walkMapParallel(missingNodes1, 32);
+            complete = stateMap_.walkMapParallel(missingNodes1, 32, workers);
         else
             stateMap_.walkMap(missingNodes1, 32);
     }
@@ -863,7 +882,7 @@ Ledger::walkLedger(beast::Journal j, bool parallel) const
             stream << "First: " << missingNodes2[0].what();
         }
     }
-    return missingNodes1.empty() && missingNodes2.empty();
+    return complete && missingNodes1.empty() && missingNodes2.empty();
 }
 
 bool
@@ -986,6 +1005,10 @@ saveValidatedLedger(
         return true;
     }
 
+    // The database must not refer to a ledger whose nodes
+    // might not be in the node store yet.
+    app.pendingWrites().waitThrough(seq);
+
     auto const db = dynamic_cast<SQLiteDatabase*>(&app.getRelationalDatabase());
     if (!db)
         Throw<std::runtime_error>("Failed to get relational database");
@@ -1183,7 +1206,7 @@ flatFetchTransactions(Application& app, std::vector<uint256>& nodestoreHashes)
         if (obj)
         {
             auto node = SHAMapTreeNode::makeFromPrefix(
-                makeSlice(obj->getData()), SHAMapHash{nodestoreHash});
+                obj->getData(), SHAMapHash{nodestoreHash});
             if (!node)
             {
                 assert(false);
@@ -185,6 +185,9 @@ public:
     std::shared_ptr<SLE const>
     read(Keylet const& k) const override;
 
+    std::optional<SLEView>
+    readLazy(Keylet const& k) const override;
+
     std::unique_ptr<sles_type::iter_base>
     slesBegin() const override;
 
@@ -339,8 +342,15 @@ public:
     void
     updateSkipList();
 
+    /** Check that every node of the ledger's state and transaction maps is
+        available.
+
+        @param parallel Walk the state map with several threads.
+        @param workers The number of threads for a parallel walk, or 0 for
+                       the default.
+    */
     bool
-    walkLedger(beast::Journal j, bool parallel = false) const;
+    walkLedger(beast::Journal j, bool parallel = false, int workers = 0) const;
 
     bool
     assertSensible(beast::Journal ledgerJ) const;
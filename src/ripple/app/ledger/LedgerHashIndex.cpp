@@ -0,0 +1,134 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerHashIndex.h>
+#include <ripple/basics/Log.h>
+#include <ripple/protocol/Serializer.h>
+#include <boost/filesystem/operations.hpp>
+#include <algorithm>
+
+namespace ripple {
+
+// Identifies a ledger hash index file, and the version of its layout
+static std::uint32_t constexpr ledgerHashIndexMagic = 0x524C4831;  // "RLH1"
+
+// The header is the magic, the network ID and the earliest sequence,
+// padded to the size of a slot.
+static std::streamoff constexpr ledgerHashIndexHeader = uint256::bytes;
+
+LedgerHashIndex::LedgerHashIndex(
+    boost::filesystem::path const& file,
+    std::uint32_t networkID,
+    LedgerIndex earliestSeq,
+    beast::Journal journal)
+    : earliestSeq_(earliestSeq), j_(journal)
+{
+    Serializer header(ledgerHashIndexHeader);
+    header.add32(ledgerHashIndexMagic);
+    header.add32(networkID);
+    header.add32(earliestSeq);
+    while (header.size() < ledgerHashIndexHeader)
+        header.add8(0);
+
+    auto const mode = std::ios::in | std::ios::out | std::ios::binary;
+    if (boost::filesystem::exists(file))
+    {
+        file_.open(file.string(), mode);
+
+        char buf[ledgerHashIndexHeader];
+        if (file_.read(buf, sizeof(buf)) &&
+            std::equal(buf, buf + sizeof(buf), header.begin()))
+            return;
+
+        JLOG(j_.warn()) << "Discarding ledger hash index " << file
+                        << " written for a different network";
+        file_.close();
+    }
+
+    file_.open(file.string(), mode | std::ios::trunc);
+    file_.write(reinterpret_cast<char const*>(header.data()), header.size());
+    file_.flush();
+    if (!file_)
+        Throw<std::runtime_error>(
+            "Unable to create ledger hash index " + file.string());
+}
+
+std::optional<LedgerHash>
+LedgerHashIndex::get(LedgerIndex seq)
+{
+    if (seq < earliestSeq_)
+        return std::nullopt;
+
+    std::lock_guard lock(mutex_);
+    LedgerHash hash;
+    file_.seekg(
+        ledgerHashIndexHeader +
+        static_cast<std::streamoff>(seq - earliestSeq_) * hash.size());
+    if (!file_.read(reinterpret_cast<char*>(hash.data()), hash.size()))
+    {
+        // Past the end of the file
+        file_.clear();
+        return std::nullopt;
+    }
+    if (hash.isZero())
+        return std::nullopt;
+    return hash;
+}
+
+void
+LedgerHashIndex::set(LedgerIndex seq, LedgerHash const& hash)
+{
+    if (seq < earliestSeq_ || hash.isZero())
+        return;
+
+    std::lock_guard lock(mutex_);
+    if (!write(seq, hash))
+    {
+        JLOG(j_.warn()) << "Unable to record the hash of ledger " << seq;
+    }
+}
+
+void
+LedgerHashIndex::erase(LedgerIndex seq)
+{
+    if (seq < earliestSeq_)
+        return;
+
+    std::lock_guard lock(mutex_);
+    if (!write(seq, beast::zero))
+    {
+        JLOG(j_.warn()) << "Unable to erase the hash of ledger " << seq;
+    }
+}
+
+bool
+LedgerHashIndex::write(LedgerIndex seq, LedgerHash const& hash)
+{
+    file_.seekp(
+        ledgerHashIndexHeader +
+        static_cast<std::streamoff>(seq - earliestSeq_) * hash.size());
+    file_.write(reinterpret_cast<char const*>(hash.data()), hash.size());
+    file_.flush();
+    if (file_)
+        return true;
+    file_.clear();
+    return false;
+}
+
+}  // namespace ripple
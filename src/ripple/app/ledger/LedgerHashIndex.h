@@ -0,0 +1,83 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_LEDGERHASHINDEX_H_INCLUDED
+#define RIPPLE_APP_LEDGER_LEDGERHASHINDEX_H_INCLUDED
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/protocol/Protocol.h>
+#include <ripple/protocol/RippleLedgerHash.h>
+#include <boost/filesystem/path.hpp>
+#include <fstream>
+#include <mutex>
+#include <optional>
+
+namespace ripple {
+
+/** A file mapping validated ledger sequences to their hashes.
+
+    The file holds a short header followed by one 32 byte slot per
+    sequence, starting at the earliest sequence the node store accepts.
+    A slot of zeroes means the hash is unknown. Finding a hash is a
+    single read at a computed offset, so it needs neither the ledger's
+    skip lists nor the SQL database.
+
+    The header records the network and earliest sequence. A file written
+    for different values is discarded when it is opened.
+*/
+class LedgerHashIndex
+{
+public:
+    LedgerHashIndex(
+        boost::filesystem::path const& file,
+        std::uint32_t networkID,
+        LedgerIndex earliestSeq,
+        beast::Journal journal);
+
+    LedgerHashIndex(LedgerHashIndex const&) = delete;
+    LedgerHashIndex&
+    operator=(LedgerHashIndex const&) = delete;
+
+    /** Return the hash recorded for a sequence, if any. */
+    std::optional<LedgerHash>
+    get(LedgerIndex seq);
+
+    /** Record the hash of a validated ledger. */
+    void
+    set(LedgerIndex seq, LedgerHash const& hash);
+
+    /** Forget the hash recorded for a sequence. */
+    void
+    erase(LedgerIndex seq);
+
+private:
+    // Must be called with the mutex locked
+    bool
+    write(LedgerIndex seq, LedgerHash const& hash);
+
+    std::mutex mutex_;
+    std::fstream file_;
+    LedgerIndex const earliestSeq_;
+    beast::Journal const j_;
+};
+
+}  // namespace ripple
+
+#endif
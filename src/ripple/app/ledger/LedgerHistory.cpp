@@ -24,6 +24,8 @@
 #include <ripple/basics/contract.h>
 #include <ripple/json/to_string.h>
 
+#include <memory>
+
 namespace ripple {
 
 // FIXME: Need to clean up ledgers by index at some point
@@ -65,14 +67,40 @@ LedgerHistory::insert(
     const bool alreadyHad = m_ledgers_by_hash.canonicalize_replace_cache(
         ledger->info().hash, ledger);
     if (validated)
+    {
         mLedgersByIndex[ledger->info().seq] = ledger->info().hash;
+        setRecent(ledger);
+    }
 
     return alreadyHad;
 }
 
+void
+LedgerHistory::setRecent(std::shared_ptr<Ledger const> const& ledger)
+{
+    auto& slot = recent_[ledger->info().seq % recentLedgers];
+
+    // Never let an older ledger displace a newer one that shares its slot
+    auto const current = std::atomic_load(&slot);
+    if (!current || current->info().seq <= ledger->info().seq)
+        std::atomic_store(&slot, ledger);
+}
+
+std::shared_ptr<Ledger const>
+LedgerHistory::getRecentLedgerBySeq(LedgerIndex index) const
+{
+    auto ret = std::atomic_load(&recent_[index % recentLedgers]);
+    if (ret && ret->info().seq == index)
+        return ret;
+    return {};
+}
+
 LedgerHash
 LedgerHistory::getLedgerHash(LedgerIndex index)
 {
+    if (auto const ledger = getRecentLedgerBySeq(index))
+        return ledger->info().hash;
+
     std::unique_lock sl(m_ledgers_by_hash.peekMutex());
     if (auto it = mLedgersByIndex.find(index); it != mLedgersByIndex.end())
         return it->second;
@@ -82,6 +110,9 @@ LedgerHistory::getLedgerHash(LedgerIndex index)
 std::shared_ptr<Ledger const>
 LedgerHistory::getLedgerBySeq(LedgerIndex index)
 {
+    if (auto ret = getRecentLedgerBySeq(index))
+        return ret;
+
     {
         std::unique_lock sl(m_ledgers_by_hash.peekMutex());
         auto it = mLedgersByIndex.find(index);
@@ -108,6 +139,7 @@ LedgerHistory::getLedgerBySeq(LedgerIndex index)
         assert(ret->isImmutable());
         m_ledgers_by_hash.canonicalize_replace_client(ret->info().hash, ret);
         mLedgersByIndex[ret->info().seq] = ret->info().hash;
+        setRecent(ret);
         return (ret->info().seq == index) ? ret : nullptr;
     }
 }
@@ -513,6 +545,12 @@ LedgerHistory::fixIndex(LedgerIndex ledgerIndex, LedgerHash const& ledgerHash)
     if ((it != mLedgersByIndex.end()) && (it->second != ledgerHash))
     {
         it->second = ledgerHash;
+
+        // Drop a recent ledger that no longer matches the index
+        auto& slot = recent_[ledgerIndex % recentLedgers];
+        if (auto const ledger = std::atomic_load(&slot);
+            ledger && ledger->info().seq == ledgerIndex)
+            std::atomic_store(&slot, std::shared_ptr<Ledger const>{});
         return false;
     }
     return true;
@@ -521,6 +559,13 @@ LedgerHistory::fixIndex(LedgerIndex ledgerIndex, LedgerHash const& ledgerHash)
 void
 LedgerHistory::clearLedgerCachePrior(LedgerIndex seq)
 {
+    for (auto& slot : recent_)
+    {
+        if (auto const ledger = std::atomic_load(&slot);
+            ledger && ledger->info().seq < seq)
+            std::atomic_store(&slot, std::shared_ptr<Ledger const>{});
+    }
+
     for (LedgerHash it : m_ledgers_by_hash.getKeys())
     {
         auto const ledger = getLedgerByHash(it);
@@ -26,6 +26,7 @@
 #include <ripple/beast/insight/Event.h>
 #include <ripple/protocol/RippleLedgerHash.h>
 
+#include <array>
 #include <optional>
 
 namespace ripple {
@@ -59,6 +60,17 @@ public:
     std::shared_ptr<Ledger const>
     getLedgerBySeq(LedgerIndex ledgerIndex);
 
+    /** Get a recently validated ledger given its sequence number
+
+        Only consults the ring of recently validated ledgers, so it never
+        blocks on ledger publication or touches the database.
+
+        @return the ledger, or `nullptr` if it is not one of the most
+                recently validated ledgers
+    */
+    std::shared_ptr<Ledger const>
+    getRecentLedgerBySeq(LedgerIndex ledgerIndex) const;
+
     /** Retrieve a ledger given its hash */
     std::shared_ptr<Ledger const>
     getLedgerByHash(LedgerHash const& ledgerHash);
@@ -122,6 +134,10 @@ private:
         std::optional<uint256> const& validatedConsensusHash,
         Json::Value const& consensus);
 
+    /** Publish a validated ledger to the ring of recent ledgers */
+    void
+    setRecent(std::shared_ptr<Ledger const> const& ledger);
+
     Application& app_;
     beast::insight::Collector::ptr collector_;
     beast::insight::Counter mismatch_counter_;
@@ -151,6 +167,13 @@ private:
     // Maps ledger indexes to the corresponding hash.
     std::map<LedgerIndex, LedgerHash> mLedgersByIndex;  // validated ledgers
 
+    // The most recently validated ledgers, indexed by sequence modulo the
+    // ring size. Slots are only accessed with the atomic shared_ptr
+    // functions so readers never take the cache mutex; a reader checks the
+    // sequence of whatever it finds, since a slot may have been reused.
+    static constexpr std::size_t recentLedgers = 128;
+    std::array<std::shared_ptr<Ledger const>, recentLedgers> recent_;
+
     beast::Journal j_;
 };
 
@@ -22,6 +22,7 @@
 
 #include <ripple/app/ledger/AbstractFetchPackContainer.h>
 #include <ripple/app/ledger/InboundLedgers.h>
+#include <ripple/app/ledger/LedgerHashIndex.h>
 #include <ripple/app/ledger/Ledger.h>
 #include <ripple/app/ledger/LedgerHistory.h>
 #include <ripple/app/ledger/LedgerHolder.h>
@@ -43,6 +44,7 @@
 
 namespace ripple {
 
+class Message;
 class Peer;
 class Transaction;
 
@@ -321,11 +323,26 @@ private:
         bool& progress,
         InboundLedger::Reason reason,
         std::unique_lock<std::recursive_mutex>&);
-    // Try to publish ledgers, acquire missing ledgers.  Always called with
-    // m_mutex locked.  The passed lock is a reminder to callers.
+    // Acquire the newest ledgers of additional gaps in the history, each
+    // found from the complete ledger just above it
+    void
+    fetchHistoryGaps(
+        std::vector<ClosedInterval<std::uint32_t>> const& gaps,
+        bool& progress,
+        std::unique_lock<std::recursive_mutex>&);
+    // Publish ledgers that are ready.  Always called with m_mutex locked.
+    // The passed lock is a reminder to callers.
     void
     doAdvance(std::unique_lock<std::recursive_mutex>&);
 
+    // Schedule the history planner unless it is already running.
+    void
+    tryPlanHistory();
+    // Acquire missing history; returns true if more may be acquired.
+    // Always called with m_mutex locked.
+    bool
+    planHistory(std::unique_lock<std::recursive_mutex>&);
+
     std::vector<std::shared_ptr<Ledger const>>
     findNewLedgersToPublish(std::unique_lock<std::recursive_mutex>&);
 
@@ -365,6 +382,9 @@ private:
 
     LedgerHistory mLedgerHistory;
 
+    // Hashes of validated ledgers by sequence, see [node_db] hash_index
+    std::unique_ptr<LedgerHashIndex> hashIndex_;
+
     CanonicalTXSet mHeldTransactions{uint256()};
 
     // A set of transactions to replay during the next close
@@ -378,6 +398,9 @@ private:
 
     // Publish thread has work to do.
     bool mAdvanceWork{false};
+
+    // History planner is running.
+    bool mHistoryThread{false};
     int mFillInProgress{0};
 
     int mPathFindThread{0};  // Pathfinder jobs dispatched
@@ -403,8 +426,18 @@ private:
 
     std::uint32_t const ledger_fetch_size_;
 
+    // Limits on backfilling history, see [history_fetch]
+    std::size_t const history_fetch_segments_;
+    int const history_max_write_load_;
+    std::size_t const history_max_fetch_rate_;
+
     TaggedCache<uint256, Blob> fetch_packs_;
 
+    // Fetch packs we built for peers, keyed by the hash of the ledger the
+    // peer has. The messages are sent again to peers asking for the same
+    // pack, rather than walking the maps again.
+    TaggedCache<uint256, std::vector<std::shared_ptr<Message>>> built_packs_;
+
     std::uint32_t fetch_seq_{0};
 
     // Try to keep a validator from switching from test to live network
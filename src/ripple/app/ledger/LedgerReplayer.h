@@ -64,6 +64,9 @@ std::uint32_t constexpr MAX_TASK_SIZE = 256;
 
 // to limit the number of LedgerReplay related jobs in JobQueue
 std::uint32_t constexpr MAX_QUEUED_TASKS = 100;
+
+// max number of ledger deltas asked for in one TMReplayDeltaRequest
+std::uint32_t constexpr MAX_DELTA_BATCH = 16;
 }  // namespace LedgerReplayParameters
 
 /**
@@ -0,0 +1,259 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/AcceptedLedger.h>
+#include <ripple/app/ledger/ObligationsIndex.h>
+#include <ripple/basics/Log.h>
+#include <ripple/basics/contract.h>
+#include <ripple/ledger/View.h>
+#include <ripple/protocol/Indexes.h>
+
+namespace ripple {
+
+ObligationsIndex::ObligationsIndex(Section const& section, beast::Journal j)
+    : j_(j)
+{
+    for (auto const& value : section.values())
+    {
+        auto const issuer = parseBase58<AccountID>(value);
+        if (!issuer)
+            Throw<std::runtime_error>(
+                "Invalid issuer in [obligations_index]: " + value);
+        issuers_.insert(*issuer);
+    }
+}
+
+bool
+ObligationsIndex::apply(
+    Balances& balances,
+    PathFindTrustLine const& line,
+    int sign)
+{
+    auto const& balance = line.getBalance();
+    int const balSign = balance.signum();
+    if (balSign == 0)
+        return true;
+
+    auto const adjust = [sign](
+                            std::map<Currency, STAmount>& sums,
+                            STAmount const& amount) {
+        auto const delta = sign > 0 ? amount : -amount;
+        auto [it, inserted] = sums.try_emplace(amount.getCurrency(), delta);
+        if (!inserted)
+            it->second += delta;
+        if (it->second == beast::zero)
+            sums.erase(it);
+    };
+
+    auto const adjustHolder =
+        [&adjust](
+            std::map<AccountID, std::map<Currency, STAmount>>& holders,
+            AccountID const& holder,
+            STAmount const& amount) {
+            auto& sums = holders[holder];
+            adjust(sums, amount);
+            if (sums.empty())
+                holders.erase(holder);
+        };
+
+    // As gateway_balances: a negative balance is owed by the issuer, a
+    // positive one is owed to it.
+    try
+    {
+        if (balSign > 0)
+            adjustHolder(balances.assets, line.getAccountIDPeer(), balance);
+        else if (line.getFreeze())
+            adjustHolder(balances.frozen, line.getAccountIDPeer(), -balance);
+        else
+            adjust(balances.obligations, -balance);
+    }
+    catch (std::runtime_error const&)
+    {
+        // Presumably the sum overflowed
+        return false;
+    }
+
+    return true;
+}
+
+std::shared_ptr<ObligationsIndex::Balances const>
+ObligationsIndex::build(ReadView const& ledger, AccountID const& issuer) const
+{
+    auto balances = std::make_shared<Balances>();
+    bool valid = true;
+
+    forEachItem(ledger, issuer, [&](std::shared_ptr<SLE const> const& sle) {
+        if (!valid)
+            return;
+        if (auto const line = PathFindTrustLine::makeItem(issuer, sle))
+            valid = apply(*balances, *line, 1);
+    });
+
+    if (!valid)
+    {
+        JLOG(j_.warn()) << "Balances of " << toBase58(issuer)
+                        << " overflow, not indexed";
+        return nullptr;
+    }
+
+    JLOG(j_.debug()) << "Indexed balances of " << toBase58(issuer)
+                     << " in ledger " << ledger.info().seq;
+    return balances;
+}
+
+std::shared_ptr<ObligationsIndex::Balances const>
+ObligationsIndex::getBalances(ReadView const& ledger, AccountID const& issuer)
+{
+    if (!enabled() || ledger.open() || !issuers_.contains(issuer))
+        return nullptr;
+
+    {
+        std::lock_guard lock(mutex_);
+        if (!ledger_ || ledger_->info().hash != ledger.info().hash)
+            return nullptr;
+
+        if (auto const it = balances_.find(issuer); it != balances_.end())
+            return it->second;
+    }
+
+    // Read the trust lines without holding the lock
+    auto balances = build(ledger, issuer);
+    if (!balances)
+        return nullptr;
+
+    {
+        std::lock_guard lock(mutex_);
+        if (ledger_ && ledger_->info().hash == ledger.info().hash)
+            balances_.emplace(issuer, balances);
+    }
+
+    return balances;
+}
+
+void
+ObligationsIndex::update(AcceptedLedger const& accepted)
+{
+    if (!enabled())
+        return;
+
+    auto const& ledger = accepted.getLedger();
+    std::shared_ptr<ReadView const> previous;
+    hash_map<AccountID, std::shared_ptr<Balances const>> balances;
+
+    {
+        std::lock_guard lock(mutex_);
+        if (ledger_ && ledger_->info().hash == ledger->info().hash)
+            return;
+
+        if (ledger_ && ledger_->info().hash == ledger->info().parentHash)
+        {
+            previous = ledger_;
+            balances = balances_;
+        }
+    }
+
+    // Take the changed trust lines of the indexed issuers out of their
+    // balances as they were, and add them back as they are now. A null
+    // entry marks balances that couldn't be updated.
+    hash_map<AccountID, std::shared_ptr<Balances>> changed;
+
+    if (previous && !balances.empty())
+    {
+        for (auto const& key : accepted.index().rippleStates)
+        {
+            auto const before = previous->read(Keylet(ltRIPPLE_STATE, key));
+            auto const after = ledger->read(Keylet(ltRIPPLE_STATE, key));
+            auto const& sle = after ? after : before;
+            if (!sle)
+                continue;
+
+            for (auto const& issuer :
+                 {sle->getFieldAmount(sfLowLimit).getIssuer(),
+                  sle->getFieldAmount(sfHighLimit).getIssuer()})
+            {
+                auto const it = balances.find(issuer);
+                if (it == balances.end())
+                    continue;
+
+                auto [c, inserted] = changed.try_emplace(issuer);
+                if (inserted)
+                    c->second = std::make_shared<Balances>(*it->second);
+                if (!c->second)
+                    continue;
+
+                bool valid = true;
+                if (auto const line =
+                        PathFindTrustLine::makeItem(issuer, before))
+                    valid = apply(*c->second, *line, -1);
+                if (auto const line =
+                        PathFindTrustLine::makeItem(issuer, after);
+                    line && valid)
+                    valid = apply(*c->second, *line, 1);
+
+                if (!valid)
+                {
+                    JLOG(j_.warn()) << "Balances of " << toBase58(issuer)
+                                    << " overflow, dropped";
+                    c->second.reset();
+                }
+            }
+        }
+    }
+
+    std::lock_guard lock(mutex_);
+    if (previous && ledger_ == previous)
+    {
+        for (auto it = balances_.begin(); it != balances_.end();)
+        {
+            if (auto const c = changed.find(it->first); c != changed.end())
+            {
+                if (c->second)
+                {
+                    it->second = c->second;
+                    ++it;
+                }
+                else
+                {
+                    it = balances_.erase(it);
+                }
+            }
+            else if (!balances.contains(it->first))
+            {
+                // Built while this ledger was applied, so it may have
+                // missed the ledger's changes
+                it = balances_.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+    else
+    {
+        balances_.clear();
+    }
+
+    JLOG(j_.debug()) << "Indexed ledger " << ledger->info().seq
+                     << ", keeping balances of " << balances_.size()
+                     << " issuers (" << changed.size() << " changed)";
+    ledger_ = ledger;
+}
+
+}  // namespace ripple
@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_OBLIGATIONSINDEX_H_INCLUDED
+#define RIPPLE_APP_LEDGER_OBLIGATIONSINDEX_H_INCLUDED
+
+#include <ripple/app/paths/TrustLine.h>
+#include <ripple/basics/BasicConfig.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/ledger/ReadView.h>
+#include <ripple/protocol/AccountID.h>
+#include <ripple/protocol/STAmount.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace ripple {
+
+class AcceptedLedger;
+
+/** The balances of the trust lines of chosen issuers in the last
+    validated ledger.
+
+    An issuer's balances are summed from its trust lines the first time
+    they are asked for, and then kept up to date from the trust lines
+    each following validated ledger changes, so requests such as
+    gateway_balances don't read every trust line of the issuer again.
+
+    Only the last validated ledger is indexed: reads of other ledgers
+    must walk the issuer's owner directory.
+*/
+class ObligationsIndex
+{
+public:
+    /** The balances of an issuer's trust lines, by currency. */
+    struct Balances
+    {
+        // What the issuer owes on lines it hasn't frozen
+        std::map<Currency, STAmount> obligations;
+
+        // What the issuer owes on lines it has frozen, by holder
+        std::map<AccountID, std::map<Currency, STAmount>> frozen;
+
+        // What holders owe the issuer, by holder
+        std::map<AccountID, std::map<Currency, STAmount>> assets;
+    };
+
+    /** Create the index.
+
+        @param section The issuers to index, one address per line. None
+                       disables the index.
+    */
+    ObligationsIndex(Section const& section, beast::Journal j);
+
+    bool
+    enabled() const
+    {
+        return !issuers_.empty();
+    }
+
+    /** Return the balances of an issuer's trust lines.
+
+        @return `nullptr` if the issuer isn't indexed, or if the ledger
+                isn't the one indexed.
+    */
+    std::shared_ptr<Balances const>
+    getBalances(ReadView const& ledger, AccountID const& issuer);
+
+    /** Index a newly validated ledger.
+
+        The trust lines of indexed issuers that the ledger changed are
+        applied to their balances. Every issuer is dropped if the ledger
+        doesn't follow the one indexed.
+    */
+    void
+    update(AcceptedLedger const& ledger);
+
+private:
+    /** Add the balance of an issuer's trust line to its balances.
+
+        @param sign 1 to add the balance, -1 to take it away.
+        @return `false` if the sum overflowed.
+    */
+    static bool
+    apply(Balances& balances, PathFindTrustLine const& line, int sign);
+
+    std::shared_ptr<Balances const>
+    build(ReadView const& ledger, AccountID const& issuer) const;
+
+    hash_set<AccountID> issuers_;
+    beast::Journal const j_;
+
+    std::mutex mutex_;
+    std::shared_ptr<ReadView const> ledger_;
+    hash_map<AccountID, std::shared_ptr<Balances const>> balances_;
+};
+
+}  // namespace ripple
+
+#endif
@@ -52,7 +52,8 @@ private:
     beast::Journal const j_;
     CachedSLEs& cache_;
     std::mutex mutable modify_mutex_;
-    std::mutex mutable current_mutex_;
+    // Published with the atomic shared_ptr functions so readers never
+    // wait on a writer. Only stored while holding modify_mutex_.
     std::shared_ptr<OpenView const> current_;
 
 public:
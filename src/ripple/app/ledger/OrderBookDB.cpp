@@ -24,13 +24,25 @@
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/basics/Log.h>
 #include <ripple/core/Config.h>
+#include <ripple/core/ConfigSections.h>
 #include <ripple/core/JobQueue.h>
+#include <ripple/core/ParallelFor.h>
 #include <ripple/protocol/Indexes.h>
 
+#include <algorithm>
+#include <thread>
+
 namespace ripple {
 
 OrderBookDB::OrderBookDB(Application& app)
-    : app_(app), seq_(0), j_(app.journal("OrderBookDB"))
+    : app_(app)
+    , seq_(0)
+    , j_(app.journal("OrderBookDB"))
+    , bookIndex_(
+          get<std::size_t>(app.config().section(SECTION_BOOK_INDEX), "books"),
+          get<std::size_t>(
+              app.config().section(SECTION_BOOK_INDEX), "offers", 100),
+          j_)
 {
 }
 
@@ -86,72 +98,127 @@ OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
         return;
     }
 
-    decltype(allBooks_) allBooks;
-    decltype(xrpBooks_) xrpBooks;
-
-    allBooks.reserve(allBooks_.size());
-    xrpBooks.reserve(xrpBooks_.size());
-
     JLOG(j_.debug()) << "Beginning update (" << ledger->seq() << ")";
 
-    // walk through the entire ledger looking for orderbook/AMM entries
-    int cnt = 0;
-
-    try
+    // What was found in one range of keys of the ledger
+    struct Found
     {
-        for (auto& sle : ledger->sles)
+        decltype(allBooks_) allBooks;
+        decltype(xrpBooks_) xrpBooks;
+        decltype(bookSources_) bookSources;
+        int cnt = 0;
+    };
+
+    // Walk the ledger looking for orderbook/AMM entries. The key space is
+    // split into ranges that the jobs take in turn.
+    static constexpr int ranges = 64;
+    std::vector<Found> found(ranges);
+    std::atomic<bool> stop = false;
+    std::optional<std::string> missing;
+    std::mutex missingMutex;
+
+    auto const walkRange = [&](std::size_t i) {
+        try
         {
-            if (app_.isStopping())
-            {
-                JLOG(j_.info())
-                    << "Update halted because the process is stopping";
-                seq_.store(0);
-                return;
-            }
+            auto& books = found[i];
 
-            if (sle->getType() == ltDIR_NODE &&
-                sle->isFieldPresent(sfExchangeRate) &&
-                sle->getFieldH256(sfRootIndex) == sle->key())
-            {
-                Book book;
+            auto const addBook = [&](Issue const& in, Issue const& out) {
+                books.allBooks[in].insert(out);
 
-                book.in.currency = sle->getFieldH160(sfTakerPaysCurrency);
-                book.in.account = sle->getFieldH160(sfTakerPaysIssuer);
-                book.out.currency = sle->getFieldH160(sfTakerGetsCurrency);
-                book.out.account = sle->getFieldH160(sfTakerGetsIssuer);
+                if (isXRP(out))
+                    books.xrpBooks.insert(in);
 
-                allBooks[book.in].insert(book.out);
+                ++books.bookSources[Book(in, out)];
+                ++books.cnt;
+            };
 
-                if (isXRP(book.out))
-                    xrpBooks.insert(book.in);
+            // The range holds the keys whose first byte is in
+            // [first, first + 256 / ranges)
+            uint256 first;
+            first.data()[0] = i * (256 / ranges);
+            auto iter = ledger->sles.begin();
+            if (i != 0)
+                iter = ledger->sles.upper_bound(--uint256(first));
 
-                ++cnt;
-            }
-            else if (sle->getType() == ltAMM)
+            for (; iter != ledger->sles.end(); ++iter)
             {
-                auto const issue1 = (*sle)[sfAsset];
-                auto const issue2 = (*sle)[sfAsset2];
-                auto addBook = [&](Issue const& in, Issue const& out) {
-                    allBooks[in].insert(out);
-
-                    if (isXRP(out))
-                        xrpBooks.insert(in);
-
-                    ++cnt;
-                };
-                addBook(issue1, issue2);
-                addBook(issue2, issue1);
+                auto const& sle = *iter;
+                if (sle->key().data()[0] / (256 / ranges) !=
+                    static_cast<unsigned>(i))
+                    break;
+
+                if (app_.isStopping())
+                {
+                    stop = true;
+                    return false;
+                }
+
+                if (sle->getType() == ltDIR_NODE &&
+                    sle->isFieldPresent(sfExchangeRate) &&
+                    sle->getFieldH256(sfRootIndex) == sle->key())
+                {
+                    Book book;
+
+                    book.in.currency = sle->getFieldH160(sfTakerPaysCurrency);
+                    book.in.account = sle->getFieldH160(sfTakerPaysIssuer);
+                    book.out.currency = sle->getFieldH160(sfTakerGetsCurrency);
+                    book.out.account = sle->getFieldH160(sfTakerGetsIssuer);
+
+                    addBook(book.in, book.out);
+                }
+                else if (sle->getType() == ltAMM)
+                {
+                    auto const issue1 = (*sle)[sfAsset];
+                    auto const issue2 = (*sle)[sfAsset2];
+                    addBook(issue1, issue2);
+                    addBook(issue2, issue1);
+                }
             }
         }
-    }
-    catch (SHAMapMissingNode const& mn)
+        catch (SHAMapMissingNode const& mn)
+        {
+            std::lock_guard lock(missingMutex);
+            missing = mn.what();
+            stop = true;
+            return false;
+        }
+        return true;
+    };
+
+    parallelFor(
+        app_.getJobQueue(),
+        jtPATH_UPDATE,
+        "OrderBookDB::update",
+        ranges,
+        std::clamp<unsigned>(std::thread::hardware_concurrency(), 1, 8) - 1,
+        walkRange);
+
+    if (missing)
     {
         JLOG(j_.info()) << "Missing node in " << ledger->seq()
-                        << " during update: " << mn.what();
+                        << " during update: " << *missing;
+        seq_.store(0);
+        return;
+    }
+
+    if (stop)
+    {
+        JLOG(j_.info()) << "Update halted because the process is stopping";
         seq_.store(0);
         return;
     }
 
+    auto& [allBooks, xrpBooks, bookSources, cnt] = found[0];
+    for (int i = 1; i < ranges; ++i)
+    {
+        for (auto& [in, outs] : found[i].allBooks)
+            allBooks[in].insert(outs.begin(), outs.end());
+        xrpBooks.insert(found[i].xrpBooks.begin(), found[i].xrpBooks.end());
+        for (auto const& [book, sources] : found[i].bookSources)
+            bookSources[book] += sources;
+        cnt += found[i].cnt;
+    }
+
     JLOG(j_.debug()) << "Update completed (" << ledger->seq() << "): " << cnt
                      << " books found";
 
@@ -159,11 +226,97 @@ OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
         std::lock_guard sl(mLock);
         allBooks_.swap(allBooks);
         xrpBooks_.swap(xrpBooks);
+        bookSources_.swap(bookSources);
+        booksSeq_ = ledger->seq();
+        booksHash_ = ledger->info().hash;
+
+        // Catch up with the ledgers validated during the update
+        for (auto const& [seq, changes] : pending_)
+        {
+            if (seq <= booksSeq_)
+                continue;
+            if (changes.parentHash != booksHash_)
+                break;
+            applyChanges(changes.changes);
+            booksSeq_ = seq;
+            booksHash_ = changes.hash;
+        }
+        pending_.clear();
     }
 
     app_.getLedgerMaster().newOrderBookDB();
 }
 
+void
+OrderBookDB::processLedger(AcceptedLedger const& ledger)
+{
+    if (app_.config().PATH_SEARCH_MAX == 0)
+        return;  // pathfinding has been disabled
+
+    auto const& info = ledger.getLedger()->info();
+    BookChanges changes{
+        info.hash, info.parentHash, ledger.index().bookChanges};
+
+    {
+        std::lock_guard sl(mLock);
+
+        if (booksSeq_ != 0 && info.seq <= booksSeq_)
+            return;
+
+        if (booksSeq_ != 0 && info.parentHash == booksHash_)
+        {
+            applyChanges(changes.changes);
+            booksSeq_ = info.seq;
+            booksHash_ = info.hash;
+            return;
+        }
+
+        // Keep the changes for the full update to catch up with
+        pending_.emplace(info.seq, std::move(changes));
+        if (pending_.size() > 256)
+            pending_.erase(pending_.begin());
+
+        // Before the first full update, there is nothing to catch up with
+        if (booksSeq_ == 0)
+            return;
+    }
+
+    JLOG(j_.info()) << "Ledger " << info.seq << " doesn't follow the order "
+                    << "books of ledger " << booksSeq_;
+    setup(ledger.getLedger());
+}
+
+void
+OrderBookDB::applyChanges(std::vector<std::pair<Book, int>> const& changes)
+{
+    for (auto const& [book, delta] : changes)
+    {
+        if (delta > 0)
+        {
+            ++bookSources_[book];
+            allBooks_[book.in].insert(book.out);
+            if (isXRP(book.out))
+                xrpBooks_.insert(book.in);
+            continue;
+        }
+
+        auto const it = bookSources_.find(book);
+        if (it == bookSources_.end() || --it->second != 0)
+            continue;
+        bookSources_.erase(it);
+
+        if (auto const books = allBooks_.find(book.in);
+            books != allBooks_.end())
+        {
+            books->second.erase(book.out);
+            if (books->second.empty())
+                allBooks_.erase(books);
+        }
+        if (isXRP(book.out))
+            xrpBooks_.erase(book.in);
+    }
+}
+
 void
 OrderBookDB::addOrderBook(Book const& book)
 {
@@ -261,41 +414,10 @@ OrderBookDB::processTxn(
     // single client has subscribed to those books.
     hash_set<std::uint64_t> havePublished;
 
-    for (auto const& node : alTx.getMeta().getNodes())
+    for (auto const& book : alTx.getBooks())
     {
-        try
-        {
-            if (node.getFieldU16(sfLedgerEntryType) == ltOFFER)
-            {
-                auto process = [&, this](SField const& field) {
-                    if (auto data = dynamic_cast<STObject const*>(
-                            node.peekAtPField(field));
-                        data && data->isFieldPresent(sfTakerPays) &&
-                        data->isFieldPresent(sfTakerGets))
-                    {
-                        auto listeners = getBookListeners(
-                            {data->getFieldAmount(sfTakerGets).issue(),
-                             data->getFieldAmount(sfTakerPays).issue()});
-                        if (listeners)
-                            listeners->publish(jvObj, havePublished);
-                    }
-                };
-
-                // We need a field that contains the TakerGets and TakerPays
-                // parameters.
-                if (node.getFName() == sfModifiedNode)
-                    process(sfPreviousFields);
-                else if (node.getFName() == sfCreatedNode)
-                    process(sfNewFields);
-                else if (node.getFName() == sfDeletedNode)
-                    process(sfFinalFields);
-            }
-        }
-        catch (std::exception const& ex)
-        {
-            JLOG(j_.info())
-                << "processTxn: field not found (" << ex.what() << ")";
-        }
+        if (auto listeners = getBookListeners(book))
+            listeners->publish(jvObj, havePublished);
     }
 }
 
@@ -20,11 +20,14 @@
 #ifndef RIPPLE_APP_LEDGER_ORDERBOOKDB_H_INCLUDED
 #define RIPPLE_APP_LEDGER_ORDERBOOKDB_H_INCLUDED
 
+#include <ripple/app/ledger/AcceptedLedger.h>
 #include <ripple/app/ledger/AcceptedLedgerTx.h>
+#include <ripple/app/ledger/BookIndex.h>
 #include <ripple/app/ledger/BookListeners.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/json/MultivarJson.h>
 
+#include <map>
 #include <mutex>
 
 namespace ripple {
@@ -39,6 +42,15 @@ public:
     void
     update(std::shared_ptr<ReadView const> const& ledger);
 
+    /** Add and remove the books whose directories and AMMs a validated
+        ledger created or deleted.
+
+        Ledgers that don't follow the one the books are up to date with are
+        kept until a full update catches up with them.
+    */
+    void
+    processLedger(AcceptedLedger const& ledger);
+
     void
     addOrderBook(Book const&);
 
@@ -55,6 +67,13 @@ public:
     bool
     isBookToXRP(Issue const&);
 
+    /** The offers of the books in the last validated ledger. */
+    BookIndex&
+    bookIndex()
+    {
+        return bookIndex_;
+    }
+
     BookListeners::pointer
     getBookListeners(Book const&);
     BookListeners::pointer
@@ -76,6 +95,26 @@ private:
     // does an order book to XRP exist
     hash_set<Issue> xrpBooks_;
 
+    // The number of directories and AMMs of each book in the ledger, so
+    // that a book is removed along with the last of them
+    hardened_hash_map<Book, std::uint32_t> bookSources_;
+
+    // The validated ledger that the books are up to date with
+    LedgerIndex booksSeq_ = 0;
+    uint256 booksHash_;
+
+    // The books that a validated ledger added (+1) or removed (-1) a
+    // directory or AMM of
+    struct BookChanges
+    {
+        uint256 hash;
+        uint256 parentHash;
+        std::vector<std::pair<Book, int>> changes;
+    };
+
+    // The changes of validated ledgers which didn't follow the books yet
+    std::map<LedgerIndex, BookChanges> pending_;
+
     std::recursive_mutex mLock;
 
     using BookToListenersMap = hash_map<Book, BookListeners::pointer>;
@@ -84,7 +123,12 @@ private:
 
     std::atomic<std::uint32_t> seq_;
 
+    void
+    applyChanges(std::vector<std::pair<Book, int>> const& changes);
+
     beast::Journal const j_;
+
+    BookIndex bookIndex_;
 };
 
 }  // namespace ripple
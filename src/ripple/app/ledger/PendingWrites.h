@@ -0,0 +1,152 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_PENDINGWRITES_H_INCLUDED
+#define RIPPLE_APP_PENDINGWRITES_H_INCLUDED
+
+#include <ripple/basics/scope.h>
+#include <ripple/protocol/Protocol.h>
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <set>
+
+namespace ripple {
+
+/** Keeps track of built ledgers whose nodes are still being stored.
+
+    Once a ledger has been built and hashed, writing its modified
+    SHAMap nodes to the node store is left to the job queue, so that the
+    next consensus round need not wait for it. This collection holds
+    those writes until a job, or a thread that needs one of them to be
+    done, gets to them.
+*/
+class PendingWrites
+{
+private:
+    struct Write
+    {
+        LedgerIndex seq;
+        std::function<void()> work;
+    };
+
+    std::mutex mutable mutex_;
+    std::condition_variable await_;
+    // writes not yet started, oldest first
+    std::deque<Write> queued_;
+    // ledger sequences of writes queued or in progress
+    std::multiset<LedgerIndex> pending_;
+
+    void
+    run(std::unique_lock<std::mutex>& lock, Write write)
+    {
+        lock.unlock();
+        scope_exit done([&] {
+            lock.lock();
+            pending_.erase(pending_.find(write.seq));
+            await_.notify_all();
+        });
+        write.work();
+    }
+
+public:
+    /** Queue the write of a built ledger's nodes
+
+        @param work Does the write. Left untouched if it is not queued.
+        @param limit Maximum number of writes that may be pending.
+        @return 'true' if queued, 'false' if the caller should do the
+            work itself because too many writes are already pending.
+    */
+    bool
+    add(LedgerIndex seq, std::function<void()>&& work, std::size_t limit)
+    {
+        std::lock_guard lock(mutex_);
+
+        if (pending_.size() >= limit)
+            return false;
+
+        queued_.push_back({seq, std::move(work)});
+        pending_.insert(seq);
+        return true;
+    }
+
+    /** Do the oldest queued write, if any remains
+
+        There is one call for each write queued.
+    */
+    void
+    doWrite()
+    {
+        std::unique_lock lock(mutex_);
+
+        if (queued_.empty())
+            return;
+
+        auto write = std::move(queued_.front());
+        queued_.pop_front();
+        run(lock, std::move(write));
+    }
+
+    /** Wait until the nodes of every ledger up to `seq` are stored
+
+        A ledger shares the nodes its predecessors did not modify, so
+        its state is only complete in the node store once those have
+        been written too. Writes not yet started are done on the calling
+        thread rather than waiting for the job queue to get to them.
+    */
+    void
+    waitThrough(LedgerIndex seq)
+    {
+        std::unique_lock lock(mutex_);
+
+        while (!pending_.empty() && *pending_.begin() <= seq)
+        {
+            auto it = std::find_if(
+                queued_.begin(), queued_.end(), [seq](Write const& w) {
+                    return w.seq <= seq;
+                });
+
+            if (it == queued_.end())
+            {
+                // Already in progress, just need to wait
+                await_.wait(lock);
+                continue;
+            }
+
+            auto write = std::move(*it);
+            queued_.erase(it);
+            run(lock, std::move(write));
+        }
+    }
+
+    /** Return the number of writes queued or in progress. */
+    std::size_t
+    size() const
+    {
+        std::lock_guard lock(mutex_);
+        return pending_.size();
+    }
+};
+
+}  // namespace ripple
+
+#endif
@@ -0,0 +1,51 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_REPLAYBENCH_H_INCLUDED
+#define RIPPLE_APP_LEDGER_REPLAYBENCH_H_INCLUDED
+
+#include <ripple/protocol/Protocol.h>
+#include <ostream>
+
+namespace ripple {
+
+class Application;
+
+/** Rebuild a range of stored ledgers, timing each phase.
+
+    Each ledger in [first, first + count) is rebuilt from its stored parent
+    by applying its transactions again, with no network involved. Each
+    transaction is timed through preflight, preclaim and doApply, and each
+    ledger through applying, hashing its modified nodes and storing them.
+
+    A CSV row is written to `out` for every ledger, followed by a table of
+    the cost of each transaction type.
+
+    @return `false` if a ledger in the range could not be loaded.
+*/
+bool
+replayBench(
+    Application& app,
+    LedgerIndex first,
+    std::uint32_t count,
+    std::ostream& out);
+
+}  // namespace ripple
+
+#endif
@@ -0,0 +1,219 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/impl/AcquireScheduler.h>
+#include <ripple/basics/Log.h>
+#include <ripple/beast/container/aged_container_utility.h>
+#include <algorithm>
+
+namespace ripple {
+
+AcquireScheduler::AcquireScheduler(
+    clock_type& clock,
+    std::chrono::milliseconds timeout,
+    beast::Journal journal)
+    : clock_(clock), timeout_(timeout), j_(journal), requested_(clock)
+{
+}
+
+void
+AcquireScheduler::filterNodes(
+    std::vector<std::pair<SHAMapNodeID, uint256>>& nodes,
+    Priority priority,
+    bool retry,
+    std::size_t limit)
+{
+    std::lock_guard lock(mutex_);
+    auto const now = clock_.now();
+
+    // Sort nodes so that the ones nobody requested recently come before
+    // the ones which are already on their way.
+    auto dup = std::stable_partition(
+        nodes.begin(), nodes.end(), [&](auto const& item) {
+            auto const it = requested_.find(item.second);
+            return it == requested_.end() || it.when() + timeout_ <= now ||
+                it->second < priority;
+        });
+
+    if (dup == nodes.begin())
+    {
+        JLOG(j_.trace()) << "filterNodes: all duplicates";
+
+        if (!retry)
+        {
+            nodes.clear();
+            return;
+        }
+    }
+    else
+    {
+        JLOG(j_.trace()) << "filterNodes: pruning duplicates";
+
+        nodes.erase(dup, nodes.end());
+    }
+
+    if (nodes.size() > limit)
+        nodes.resize(limit);
+
+    for (auto const& n : nodes)
+    {
+        auto const [it, inserted] = requested_.emplace(n.second, priority);
+        if (!inserted)
+        {
+            it->second = std::max(it->second, priority);
+            requested_.touch(it);
+        }
+    }
+}
+
+bool
+AcquireScheduler::reserve(Peer::id_t peer, Priority priority)
+{
+    std::lock_guard lock(mutex_);
+    auto const now = clock_.now();
+
+    auto& state = peers_[peer];
+    expire(state, now);
+    state.lastActive = now;
+
+    if (priority != Priority::consensus)
+    {
+        auto limit = budget(state);
+        if (priority == Priority::history)
+            limit = std::max(minBudget, limit / 2);
+
+        if (state.sent.size() >= limit)
+        {
+            JLOG(j_.trace()) << "Peer " << peer << " is busy ("
+                             << state.sent.size() << "/" << limit << ")";
+            return false;
+        }
+    }
+
+    state.sent.push_back(now);
+    return true;
+}
+
+void
+AcquireScheduler::onReply(Peer::id_t peer)
+{
+    std::lock_guard lock(mutex_);
+    auto const now = clock_.now();
+
+    auto const it = peers_.find(peer);
+    if (it == peers_.end())
+        return;
+
+    auto& state = it->second;
+    expire(state, now);
+    state.lastActive = now;
+
+    // A reply to a request which already timed out tells us nothing
+    if (state.sent.empty())
+        return;
+
+    sample(
+        state,
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            now - state.sent.front()));
+    state.sent.pop_front();
+}
+
+void
+AcquireScheduler::sweep()
+{
+    std::lock_guard lock(mutex_);
+    auto const now = clock_.now();
+
+    beast::expire(requested_, timeout_);
+
+    for (auto it = peers_.begin(); it != peers_.end();)
+    {
+        expire(it->second, now);
+        if (it->second.sent.empty() &&
+            it->second.lastActive + std::chrono::minutes(1) < now)
+            it = peers_.erase(it);
+        else
+            ++it;
+    }
+}
+
+std::size_t
+AcquireScheduler::inFlight(Peer::id_t peer)
+{
+    std::lock_guard lock(mutex_);
+    auto const it = peers_.find(peer);
+    if (it == peers_.end())
+        return 0;
+    expire(it->second, clock_.now());
+    return it->second.sent.size();
+}
+
+std::size_t
+AcquireScheduler::budget(Peer::id_t peer)
+{
+    std::lock_guard lock(mutex_);
+    auto const it = peers_.find(peer);
+    if (it == peers_.end())
+        return defaultBudget;
+    return budget(it->second);
+}
+
+std::optional<std::chrono::milliseconds>
+AcquireScheduler::latency(Peer::id_t peer)
+{
+    std::lock_guard lock(mutex_);
+    auto const it = peers_.find(peer);
+    if (it == peers_.end())
+        return std::nullopt;
+    return it->second.latency;
+}
+
+void
+AcquireScheduler::expire(PeerState& state, clock_type::time_point now)
+{
+    // Requests without a reply count as taking the full timeout, which
+    // shrinks the budget of unresponsive peers
+    while (!state.sent.empty() && state.sent.front() + timeout_ <= now)
+    {
+        state.sent.pop_front();
+        sample(state, timeout_);
+    }
+}
+
+void
+AcquireScheduler::sample(PeerState& state, std::chrono::milliseconds elapsed)
+{
+    if (state.latency)
+        state.latency = (*state.latency * 7 + elapsed) / 8;
+    else
+        state.latency = elapsed;
+}
+
+std::size_t
+AcquireScheduler::budget(PeerState const& state) const
+{
+    if (!state.latency)
+        return defaultBudget;
+
+    auto const latency = std::max(*state.latency, std::chrono::milliseconds{1});
+    return std::clamp<std::size_t>(window / latency, minBudget, maxBudget);
+}
+
+}  // namespace ripple
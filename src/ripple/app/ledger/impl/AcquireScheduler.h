@@ -0,0 +1,164 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_ACQUIRESCHEDULER_H_INCLUDED
+#define RIPPLE_APP_LEDGER_ACQUIRESCHEDULER_H_INCLUDED
+
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/beast/clock/abstract_clock.h>
+#include <ripple/beast/container/aged_unordered_map.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/overlay/Peer.h>
+#include <ripple/shamap/SHAMapNodeID.h>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace ripple {
+
+/** Coordinates the network requests of all inbound ledgers.
+
+    Ledgers being acquired at the same time share most of their state
+    nodes, so without coordination each of them asks its peers for the
+    same nodes. The scheduler remembers which nodes were requested
+    recently, by any acquisition, so that only one request per node is
+    outstanding at a time.
+
+    It also limits how many requests are in flight to each peer. The
+    limit is derived from the peer's measured response time, and
+    acquisitions for the consensus round are favored over backfilling
+    history when a peer is busy.
+*/
+class AcquireScheduler
+{
+public:
+    using clock_type = beast::abstract_clock<std::chrono::steady_clock>;
+
+    /** How urgently an acquisition needs its data. */
+    enum class Priority { history, normal, consensus };
+
+    /** Create a scheduler.
+
+        @param clock The clock to use for timing requests.
+        @param timeout How long an unanswered request is outstanding.
+        @param journal Where to log.
+    */
+    AcquireScheduler(
+        clock_type& clock,
+        std::chrono::milliseconds timeout,
+        beast::Journal journal);
+
+    /** Choose which of the given missing nodes to request.
+
+        Nodes with an outstanding request of at least the same priority are
+        removed, unless every node has one and `retry` is set. The remaining
+        nodes, up to `limit`, are recorded as requested.
+
+        @param nodes The missing nodes. On return, the nodes to request.
+        @param priority The priority of the acquisition.
+        @param retry Whether to keep duplicates rather than request nothing.
+        @param limit The largest number of nodes to request.
+    */
+    void
+    filterNodes(
+        std::vector<std::pair<SHAMapNodeID, uint256>>& nodes,
+        Priority priority,
+        bool retry,
+        std::size_t limit);
+
+    /** Reserve room for a request to a peer.
+
+        Requests for the consensus round are always allowed. Other requests
+        are only allowed while the peer has room, with history requests
+        limited to half of it.
+
+        @return Whether the request should be sent.
+    */
+    bool
+    reserve(Peer::id_t peer, Priority priority);
+
+    /** Record a reply from a peer, updating its response time. */
+    void
+    onReply(Peer::id_t peer);
+
+    /** Forget outstanding requests and peers which have gone quiet. */
+    void
+    sweep();
+
+    /** Return the number of requests in flight to the given peer. */
+    std::size_t
+    inFlight(Peer::id_t peer);
+
+    /** Return the number of requests allowed in flight to the given peer. */
+    std::size_t
+    budget(Peer::id_t peer);
+
+    /** Return the measured response time of the given peer, if known. */
+    std::optional<std::chrono::milliseconds>
+    latency(Peer::id_t peer);
+
+private:
+    struct PeerState
+    {
+        // When each outstanding request was sent, oldest first
+        std::deque<clock_type::time_point> sent;
+        std::optional<std::chrono::milliseconds> latency;
+        clock_type::time_point lastActive;
+    };
+
+    // Requests allowed in flight to a peer of unknown latency
+    static constexpr std::size_t defaultBudget = 4;
+    // Bounds on the requests allowed in flight to any peer
+    static constexpr std::size_t minBudget = 1;
+    static constexpr std::size_t maxBudget = 16;
+    // The amount of a peer's time worth of requests to keep in flight
+    static constexpr std::chrono::milliseconds window{2000};
+
+    void
+    expire(PeerState& state, clock_type::time_point now);
+
+    void
+    sample(PeerState& state, std::chrono::milliseconds elapsed);
+
+    std::size_t
+    budget(PeerState const& state) const;
+
+    clock_type& clock_;
+    std::chrono::milliseconds const timeout_;
+    beast::Journal const j_;
+
+    std::mutex mutex_;
+
+    // Recently requested nodes and the priority they were requested with
+    beast::aged_unordered_map<
+        uint256,
+        Priority,
+        clock_type::clock_type,
+        hardened_hash<strong_hash>>
+        requested_;
+
+    hash_map<Peer::id_t, PeerState> peers_;
+};
+
+}  // namespace ripple
+
+#endif
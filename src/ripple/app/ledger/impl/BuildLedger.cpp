@@ -21,13 +21,62 @@
 #include <ripple/app/ledger/Ledger.h>
 #include <ripple/app/ledger/LedgerReplay.h>
 #include <ripple/app/ledger/OpenLedger.h>
+#include <ripple/app/ledger/PendingWrites.h>
+#include <ripple/app/ledger/impl/ParallelApply.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/CanonicalTXSet.h>
 #include <ripple/app/tx/apply.h>
+#include <ripple/basics/Trace.h>
+#include <ripple/core/Config.h>
+#include <ripple/core/JobQueue.h>
+#include <ripple/protocol/Book.h>
 #include <ripple/protocol/Feature.h>
+#include <ripple/protocol/Indexes.h>
 
 namespace ripple {
 
+// Built ledgers whose nodes may still be waiting to be stored. Beyond
+// this, ledgers are stored before they are returned.
+static constexpr std::size_t maxPendingWrites = 4;
+
+/* Store the nodes flushed from a built ledger's maps
+
+   Unless too many ledgers are already waiting on it, this is left to the
+   job queue: those nodes are canonical in memory already, and nothing
+   needs them in the node store before the ledger is saved.
+*/
+static void
+storeLedgerNodes(
+    Application& app,
+    std::shared_ptr<Ledger const> const& built,
+    std::vector<std::shared_ptr<SHAMapTreeNode>>&& stateNodes,
+    std::vector<std::shared_ptr<SHAMapTreeNode>>&& txNodes)
+{
+    std::function<void()> store = [built,
+                                   stateNodes = std::move(stateNodes),
+                                   txNodes = std::move(txNodes)]() {
+        built->stateMap().storeNodes(hotACCOUNT_NODE, stateNodes);
+        built->txMap().storeNodes(hotTRANSACTION_NODE, txNodes);
+    };
+
+    auto const seq = built->info().seq;
+    auto& pending = app.pendingWrites();
+    if (!pending.add(seq, std::move(store), maxPendingWrites))
+    {
+        store();
+        return;
+    }
+
+    if (!app.getJobQueue().addJob(
+            jtWRITE, "Ledger::storeNodes", [&pending]() {
+                pending.doWrite();
+            }))
+    {
+        // The JobQueue won't do the Job. Do the write synchronously.
+        pending.waitThrough(seq);
+    }
+}
+
 /* Generic buildLedgerImpl that dispatches to ApplyTxs invocable with signature
     void(OpenView&, std::shared_ptr<Ledger> const&)
    It is responsible for adding transactions to the open view to generate the
@@ -43,8 +92,19 @@ buildLedgerImpl(
     NetClock::duration closeResolution,
     Application& app,
     beast::Journal j,
-    ApplyTxs&& applyTxs)
+    ApplyTxs&& applyTxs,
+    BuildLedgerTimes* times = nullptr)
 {
+    using clock_type = std::chrono::steady_clock;
+
+    trace::Span span("buildLedger", parent->seq() + 1);
+    auto start = clock_type::now();
+    auto lap = [&start](std::chrono::nanoseconds& phase) {
+        auto const now = clock_type::now();
+        phase += now - start;
+        start = now;
+    };
+
     auto built = std::make_shared<Ledger>(*parent, closeTime);
 
     if (built->isFlagLedger() && built->rules().enabled(featureNegativeUNL))
@@ -63,12 +123,21 @@ buildLedgerImpl(
     }
 
     built->updateSkipList();
-    {
-        // Write the final version of all modified SHAMap
-        // nodes to the node store to preserve the new LCL
 
-        int const asf = built->stateMap().flushDirty(hotACCOUNT_NODE);
-        int const tmf = built->txMap().flushDirty(hotTRANSACTION_NODE);
+    if (times)
+        lap(times->apply);
+
+    std::vector<std::shared_ptr<SHAMapTreeNode>> stateNodes;
+    std::vector<std::shared_ptr<SHAMapTreeNode>> txNodes;
+    {
+        // Hash the final version of all modified SHAMap nodes. Writing
+        // them to the node store to preserve the new LCL can wait
+        // until the ledger is accepted.
+
+        int const asf =
+            built->stateMap().flushDirty(hotACCOUNT_NODE, stateNodes);
+        int const tmf =
+            built->txMap().flushDirty(hotTRANSACTION_NODE, txNodes);
         JLOG(j.debug()) << "Flushed " << asf << " accounts and " << tmf
                         << " transaction nodes";
     }
@@ -80,9 +149,101 @@ buildLedgerImpl(
         built->read(keylet::fees()));
     built->setAccepted(closeTime, closeResolution, closeTimeCorrect);
 
+    if (times)
+    {
+        // Store the nodes now so that the cost can be measured
+        lap(times->flush);
+        built->stateMap().storeNodes(hotACCOUNT_NODE, stateNodes);
+        built->txMap().storeNodes(hotTRANSACTION_NODE, txNodes);
+        lap(times->store);
+        return built;
+    }
+
+    storeLedgerNodes(app, built, std::move(stateNodes), std::move(txNodes));
+
     return built;
 }
 
+/* Add the keys of the state entries a transaction is likely to read
+
+   Only what the transaction's own fields tell: its accounts, their trust
+   lines for the currencies it moves and the books its offers may cross.
+   Transactors read more than this, but not before reading these.
+*/
+static void
+addPrefetchKeys(STTx const& tx, std::vector<uint256>& keys)
+{
+    auto const account = tx.getAccountID(sfAccount);
+    keys.push_back(keylet::account(account).key);
+    keys.push_back(keylet::ownerDir(account).key);
+
+    std::optional<AccountID> destination;
+    if (tx.isFieldPresent(sfDestination))
+    {
+        destination = tx.getAccountID(sfDestination);
+        keys.push_back(keylet::account(*destination).key);
+    }
+
+    auto const addIssue = [&](Issue const& issue) {
+        if (isXRP(issue))
+            return;
+        keys.push_back(keylet::account(issue.account).key);
+        if (account != issue.account)
+            keys.push_back(keylet::line(account, issue).key);
+        if (destination && *destination != issue.account)
+            keys.push_back(keylet::line(*destination, issue).key);
+    };
+
+    for (auto const field :
+         {&sfAmount, &sfSendMax, &sfDeliverMin, &sfLimitAmount})
+    {
+        if (tx.isFieldPresent(*field))
+            addIssue(tx[*field].issue());
+    }
+
+    if (tx.isFieldPresent(sfTakerPays) && tx.isFieldPresent(sfTakerGets))
+    {
+        auto const pays = tx[sfTakerPays].issue();
+        auto const gets = tx[sfTakerGets].issue();
+        addIssue(pays);
+        addIssue(gets);
+
+        // The book crossed and the book the rest of the offer goes into.
+        // The quality directories share a path with the book's base.
+        keys.push_back(getBookBase({gets, pays}));
+        keys.push_back(getBookBase({pays, gets}));
+    }
+}
+
+/* Read in the state the transactions are likely to touch
+
+   Applying transactions reads the state one entry, and so one node store
+   read, at a time. Reading the entries' paths first lets the NodeStore
+   read threads fetch them in batches, a level of the map at a time.
+*/
+template <class Txns>
+static void
+prefetchState(Ledger const& ledger, Txns const& txns, beast::Journal j)
+{
+    trace::Span span("prefetchState", ledger.seq());
+    auto const start = std::chrono::steady_clock::now();
+
+    std::vector<uint256> keys;
+    keys.reserve(txns.size() * 4);
+    for (auto const& item : txns)
+        addPrefetchKeys(*item.second, keys);
+
+    auto const count = keys.size();
+    ledger.stateMap().prefetch(std::move(keys));
+
+    JLOG(j.debug()) << "Prefetched " << count << " entries for "
+                    << txns.size() << " transactions in "
+                    << std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count()
+                    << "ms";
+}
+
 /** Apply a set of consensus transactions to a ledger.
 
   @param app Handle to application
@@ -105,6 +266,9 @@ applyTransactions(
     bool certainRetry = true;
     std::size_t count = 0;
 
+    auto const threads = app.config().PARALLEL_APPLY_THREADS;
+    ParallelRetries retries;
+
     // Attempt to apply all of the retriable transactions
     for (int pass = 0; pass < LEDGER_TOTAL_PASSES; ++pass)
     {
@@ -112,43 +276,63 @@ applyTransactions(
                         << " begins (" << txns.size() << " transactions)";
         int changes = 0;
 
-        auto it = txns.begin();
-
-        while (it != txns.end())
+        if (threads > 1)
         {
-            auto const txid = it->first.getTXID();
-
-            try
+            // Transactions already in the ledger need no speculation
+            if (pass == 0)
             {
-                if (pass == 0 && built->txExists(txid))
+                for (auto it = txns.begin(); it != txns.end();)
                 {
-                    it = txns.erase(it);
-                    continue;
-                }
-
-                switch (applyTransaction(
-                    app, view, *it->second, certainRetry, tapNONE, j))
-                {
-                    case ApplyResult::Success:
-                        it = txns.erase(it);
-                        ++changes;
-                        break;
-
-                    case ApplyResult::Fail:
-                        failed.insert(txid);
+                    if (built->txExists(it->first.getTXID()))
                         it = txns.erase(it);
-                        break;
-
-                    case ApplyResult::Retry:
+                    else
                         ++it;
                 }
             }
-            catch (std::exception const& ex)
+
+            changes = applyTransactionsParallel(
+                app, txns, failed, view, certainRetry, threads, retries, j);
+        }
+        else
+        {
+            auto it = txns.begin();
+
+            while (it != txns.end())
             {
-                JLOG(j.warn())
-                    << "Transaction " << txid << " throws: " << ex.what();
-                failed.insert(txid);
-                it = txns.erase(it);
+                auto const txid = it->first.getTXID();
+
+                try
+                {
+                    if (pass == 0 && built->txExists(txid))
+                    {
+                        it = txns.erase(it);
+                        continue;
+                    }
+
+                    switch (applyTransaction(
+                        app, view, *it->second, certainRetry, tapNONE, j))
+                    {
+                        case ApplyResult::Success:
+                            it = txns.erase(it);
+                            ++changes;
+                            break;
+
+                        case ApplyResult::Fail:
+                            failed.insert(txid);
+                            it = txns.erase(it);
+                            break;
+
+                        case ApplyResult::Retry:
+                            ++it;
+                    }
+                }
+                catch (std::exception const& ex)
+                {
+                    JLOG(j.warn())
+                        << "Transaction " << txid << " throws: " << ex.what();
+                    failed.insert(txid);
+                    it = txns.erase(it);
+                }
             }
         }
 
@@ -200,6 +384,8 @@ buildLedger(
             JLOG(j.debug())
                 << "Attempting to apply " << txns.size() << " transactions";
 
+            prefetchState(*built, txns, j);
+
             auto const applied =
                 applyTransactions(app, built, txns, failedTxns, accum, j);
 
@@ -232,9 +418,35 @@ buildLedger(
         app,
         j,
         [&](OpenView& accum, std::shared_ptr<Ledger> const& built) {
+            prefetchState(*built, replayData.orderedTxns(), j);
             for (auto& tx : replayData.orderedTxns())
                 applyTransaction(app, accum, *tx.second, false, applyFlags, j);
         });
 }
 
+// Build a ledger by replaying, timing each phase
+std::shared_ptr<Ledger>
+buildLedger(
+    LedgerReplay const& replayData,
+    std::function<void(OpenView&, STTx const&)> const& applyTx,
+    BuildLedgerTimes& times,
+    Application& app,
+    beast::Journal j)
+{
+    auto const& replayLedger = replayData.replay();
+
+    return buildLedgerImpl(
+        replayData.parent(),
+        replayLedger->info().closeTime,
+        ((replayLedger->info().closeFlags & sLCF_NoConsensusTime) == 0),
+        replayLedger->info().closeTimeResolution,
+        app,
+        j,
+        [&](OpenView& accum, std::shared_ptr<Ledger> const& built) {
+            for (auto& tx : replayData.orderedTxns())
+                applyTx(accum, *tx.second);
+        },
+        &times);
+}
+
 }  // namespace ripple
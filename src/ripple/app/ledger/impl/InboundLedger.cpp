@@ -71,16 +71,14 @@ enum {
     reqNodes = 12
 };
 
-// millisecond for each ledger timeout
-auto constexpr ledgerAcquireTimeout = 3000ms;
-
 InboundLedger::InboundLedger(
     Application& app,
     uint256 const& hash,
     std::uint32_t seq,
     Reason reason,
     clock_type& clock,
-    std::unique_ptr<PeerSet> peerSet)
+    std::unique_ptr<PeerSet> peerSet,
+    std::shared_ptr<AcquireScheduler> scheduler)
     : TimeoutCounter(
           app,
           hash,
@@ -95,9 +93,13 @@ InboundLedger::InboundLedger(
     , mByHash(true)
     , mSeq(seq)
     , mReason(reason)
+    , mScheduler(std::move(scheduler))
     , mReceiveDispatched(false)
     , mPeerSet(std::move(peerSet))
 {
+    if (!mScheduler)
+        mScheduler = std::make_shared<AcquireScheduler>(
+            clock, ledgerAcquireTimeout, journal_);
     JLOG(journal_.trace()) << "Acquiring ledger " << hash_;
     touch();
 }
@@ -278,10 +280,10 @@ InboundLedger::tryDB(NodeStore::Database& srcDB)
 {
     if (!mHaveHeader)
     {
-        auto makeLedger = [&, this](Blob const& data) {
+        auto makeLedger = [&, this](Slice data) {
             JLOG(journal_.trace()) << "Ledger header found in fetch pack";
             mLedger = std::make_shared<Ledger>(
-                deserializePrefixedHeader(makeSlice(data)),
+                deserializePrefixedHeader(data),
                 app_.config(),
                 mReason == Reason::SHARD ? *app_.getShardFamily()
                                          : app_.getNodeFamily());
@@ -310,7 +312,8 @@ InboundLedger::tryDB(NodeStore::Database& srcDB)
             auto& dstDB{mLedger->stateMap().family().db()};
             if (std::addressof(dstDB) != std::addressof(srcDB))
             {
-                Blob blob{nodeObject->getData()};
+                auto const d = nodeObject->getData();
+                Blob blob(d.begin(), d.end());
                 dstDB.store(
                     hotLEDGER, std::move(blob), hash_, mLedger->info().seq);
             }
@@ -324,7 +327,7 @@ InboundLedger::tryDB(NodeStore::Database& srcDB)
 
             JLOG(journal_.trace()) << "Ledger header found in fetch pack";
 
-            makeLedger(*data);
+            makeLedger(makeSlice(*data));
             if (failed_)
                 return;
 
@@ -401,8 +404,6 @@ InboundLedger::tryDB(NodeStore::Database& srcDB)
 void
 InboundLedger::onTimer(bool wasProgress, ScopedLockType&)
 {
-    mRecentNodes.clear();
-
     if (isDone())
     {
         JLOG(journal_.info()) << "Already done " << hash_;
@@ -632,7 +633,7 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
             tmGL.set_ledgerseq(mSeq);
         JLOG(journal_.trace()) << "Sending header request to "
                                << (peer ? "selected peer" : "all peers");
-        mPeerSet->sendRequest(tmGL, peer);
+        sendRequest(tmGL, peer);
         return;
     }
 
@@ -669,7 +670,7 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
             *tmGL.add_nodeids() = SHAMapNodeID().getRawString();
             JLOG(journal_.trace()) << "Sending AS root request to "
                                    << (peer ? "selected peer" : "all peers");
-            mPeerSet->sendRequest(tmGL, peer);
+            sendRequest(tmGL, peer);
             return;
         }
         else
@@ -714,7 +715,7 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
                             << "Sending AS node request (" << nodes.size()
                             << ") to "
                             << (peer ? "selected peer" : "all peers");
-                        mPeerSet->sendRequest(tmGL, peer);
+                        sendRequest(tmGL, peer);
                         return;
                     }
                     else
@@ -741,7 +742,7 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
             *(tmGL.add_nodeids()) = SHAMapNodeID().getRawString();
             JLOG(journal_.trace()) << "Sending TX root request to "
                                    << (peer ? "selected peer" : "all peers");
-            mPeerSet->sendRequest(tmGL, peer);
+            sendRequest(tmGL, peer);
             return;
         }
         else
@@ -778,7 +779,7 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
                     JLOG(journal_.trace())
                         << "Sending TX node request (" << nodes.size()
                         << ") to " << (peer ? "selected peer" : "all peers");
-                    mPeerSet->sendRequest(tmGL, peer);
+                    sendRequest(tmGL, peer);
                     return;
                 }
                 else
@@ -804,41 +805,79 @@ InboundLedger::filterNodes(
     std::vector<std::pair<SHAMapNodeID, uint256>>& nodes,
     TriggerReason reason)
 {
-    // Sort nodes so that the ones we haven't recently
-    // requested come before the ones we have.
-    auto dup = std::stable_partition(
-        nodes.begin(), nodes.end(), [this](auto const& item) {
-            return mRecentNodes.count(item.second) == 0;
-        });
-
     // If everything is a duplicate we don't want to send
     // any query at all except on a timeout where we need
     // to query everyone:
-    if (dup == nodes.begin())
+    mScheduler->filterNodes(
+        nodes,
+        priority(),
+        reason == TriggerReason::timeout,
+        (reason == TriggerReason::reply) ? reqNodesReply : reqNodes);
+}
+
+void
+InboundLedger::sendRequest(
+    protocol::TMGetLedger const& request,
+    std::shared_ptr<Peer> const& peer)
+{
+    auto const prio = priority();
+
+    if (peer)
     {
-        JLOG(journal_.trace()) << "filterNodes: all duplicates";
+        if (mScheduler->reserve(peer->id(), prio))
+            mPeerSet->sendRequest(request, peer);
+        else
+            JLOG(journal_.debug()) << "Deferring request for " << hash_
+                                   << " to busy peer " << peer->id();
+        return;
+    }
 
-        if (reason != TriggerReason::timeout)
+    auto const& peerIds = mPeerSet->getPeerIds();
+    if (peerIds.empty())
+        return;
+
+    auto packet = std::make_shared<Message>(request, protocol::mtGET_LEDGER);
+    std::shared_ptr<Peer> deferred;
+    bool sent = false;
+    for (auto id : peerIds)
+    {
+        if (auto p = app_.overlay().findPeerByShortID(id))
         {
-            nodes.clear();
-            return;
+            if (mScheduler->reserve(id, prio))
+            {
+                p->send(packet);
+                sent = true;
+            }
+            else if (!deferred)
+            {
+                deferred = std::move(p);
+            }
         }
     }
-    else
-    {
-        JLOG(journal_.trace()) << "filterNodes: pruning duplicates";
 
-        nodes.erase(dup, nodes.end());
+    // Always make some progress, even when every peer is busy
+    if (!sent && deferred)
+    {
+        mScheduler->reserve(
+            deferred->id(), AcquireScheduler::Priority::consensus);
+        deferred->send(packet);
     }
+}
 
-    std::size_t const limit =
-        (reason == TriggerReason::reply) ? reqNodesReply : reqNodes;
-
-    if (nodes.size() > limit)
-        nodes.resize(limit);
-
-    for (auto const& n : nodes)
-        mRecentNodes.insert(n.second);
+AcquireScheduler::Priority
+InboundLedger::priority() const
+{
+    switch (mReason)
+    {
+        case Reason::CONSENSUS:
+            return AcquireScheduler::Priority::consensus;
+        case Reason::GENERIC:
+            return AcquireScheduler::Priority::normal;
+        case Reason::HISTORY:
+        case Reason::SHARD:
+            break;
+    }
+    return AcquireScheduler::Priority::history;
 }
 
 /** Take ledger header data
@@ -935,6 +974,11 @@ InboundLedger::receiveNode(protocol::TMLedgerData& packet, SHAMapAddNode& san)
     {
         auto const f = filter.get();
 
+        // The other nodes are added together, so that the nodes below the
+        // same inner node share the descent to it.
+        std::vector<std::pair<SHAMapNodeID, Slice>> nodes;
+        nodes.reserve(packet.nodes().size());
+
         for (auto const& node : packet.nodes())
         {
             auto const nodeID = deserializeSHAMapNodeID(node.nodeid());
@@ -945,17 +989,26 @@ InboundLedger::receiveNode(protocol::TMLedgerData& packet, SHAMapAddNode& san)
             if (nodeID->isRoot())
             {
                 san += map.addRootNode(rootHash, makeSlice(node.nodedata()), f);
+
+                if (!san.isGood())
+                {
+                    JLOG(journal_.warn()) << "Received bad node data";
+                    return;
+                }
             }
             else
             {
-                san += map.addKnownNode(*nodeID, makeSlice(node.nodedata()), f);
+                nodes.emplace_back(*nodeID, makeSlice(node.nodedata()));
             }
+        }
 
-            if (!san.isGood())
-            {
-                JLOG(journal_.warn()) << "Received bad node data";
-                return;
-            }
+        if (!nodes.empty())
+            san += map.addKnownNodes(std::move(nodes), f);
+
+        if (!san.isGood())
+        {
+            JLOG(journal_.warn()) << "Received bad node data";
+            return;
         }
     }
     catch (std::exception const& e)
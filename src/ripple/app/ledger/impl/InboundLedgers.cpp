@@ -59,6 +59,10 @@ public:
         , mRecentFailures(clock)
         , mCounter(collector->make_counter("ledger_fetches"))
         , mPeerSetBuilder(std::move(peerSetBuilder))
+        , scheduler_(std::make_shared<AcquireScheduler>(
+              clock,
+              ledgerAcquireTimeout,
+              app.journal("InboundLedger")))
     {
     }
 
@@ -103,7 +107,8 @@ public:
                     seq,
                     reason,
                     std::ref(m_clock),
-                    mPeerSetBuilder->build());
+                    mPeerSetBuilder->build(),
+                    scheduler_);
                 mLedgers.emplace(hash, inbound);
                 inbound->init(sl);
                 ++mCounter;
@@ -181,6 +186,9 @@ public:
         std::shared_ptr<Peer> peer,
         std::shared_ptr<protocol::TMLedgerData> packet) override
     {
+        if (peer)
+            scheduler_->onReply(peer->id());
+
         if (auto ledger = find(hash))
         {
             JLOG(j_.trace()) << "Got data (" << packet->nodes().size()
@@ -393,6 +401,8 @@ public:
             beast::expire(mRecentFailures, kReacquireInterval);
         }
 
+        scheduler_->sweep();
+
         JLOG(j_.debug())
             << "Swept " << stuffToSweep.size() << " out of " << total
             << " inbound ledgers. Duration: "
@@ -433,6 +443,8 @@ private:
     beast::insight::Counter mCounter;
 
     std::unique_ptr<PeerSetBuilder> mPeerSetBuilder;
+
+    std::shared_ptr<AcquireScheduler> const scheduler_;
 };
 
 //------------------------------------------------------------------------------
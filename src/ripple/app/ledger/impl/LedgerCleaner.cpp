@@ -225,7 +225,6 @@ private:
         {
             {
                 std::unique_lock<std::mutex> lock(mutex_);
-                state_ = State::notCleaning;
                 wakeup_.wait(lock, [this]() {
                     return (shouldExit_ || state_ == State::cleaning);
                 });
@@ -300,7 +299,9 @@ private:
             doTxns = true;
         }
 
-        if (doNodes && !nodeLedger->walkLedger(app_.journal("Ledger")))
+        if (doNodes &&
+            !nodeLedger->walkLedger(
+                app_.journal("Ledger"), true, app_.config().VERIFY_WORKERS))
         {
             JLOG(j_.debug()) << "Ledger " << ledgerIndex << " is missing nodes";
             app_.getLedgerMaster().clearLedger(ledgerIndex);
@@ -403,6 +404,7 @@ private:
                     (minRange_ == 0))
                 {
                     minRange_ = maxRange_ = 0;
+                    state_ = State::notCleaning;
                     return;
                 }
                 ledgerIndex = maxRange_;
@@ -55,12 +55,15 @@ LedgerDeltaAcquire::~LedgerDeltaAcquire()
 }
 
 void
-LedgerDeltaAcquire::init(int numPeers)
+LedgerDeltaAcquire::init(int numPeers, std::uint32_t deltaCount)
 {
     ScopedLockType sl(mtx_);
     if (!isDone())
     {
+        deltaCount_ = deltaCount;
         trigger(numPeers, sl);
+        // Retries ask for this delta only
+        deltaCount_ = 1;
         setTimer(sl);
     }
 }
@@ -77,7 +80,7 @@ LedgerDeltaAcquire::trigger(std::size_t limit, ScopedLockType& sl)
         return;
     }
 
-    if (!fallBack_)
+    if (!fallBack_ && deltaCount_ != 0)
     {
         peerSet_->addPeers(
             limit,
@@ -92,6 +95,8 @@ LedgerDeltaAcquire::trigger(std::size_t limit, ScopedLockType& sl)
                         << "Add a peer " << peer->id() << " for " << hash_;
                     protocol::TMReplayDeltaRequest request;
                     request.set_ledgerhash(hash_.data(), hash_.size());
+                    if (deltaCount_ > 1)
+                        request.set_count(deltaCount_);
                     peerSet_->sendRequest(request, peer);
                 }
                 else
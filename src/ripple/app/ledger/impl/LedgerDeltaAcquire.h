@@ -75,9 +75,13 @@ public:
     /**
      * Start the LedgerDeltaAcquire task
      * @param numPeers  number of peers to try initially
+     * @param deltaCount  number of deltas to ask the first peers for: this
+     *        ledger's and those of deltaCount - 1 of its ancestors. Zero
+     *        sends no request, for a delta expected in the reply to a
+     *        descendant's request. It is asked for alone after a timeout.
      */
     void
-    init(int numPeers);
+    init(int numPeers, std::uint32_t deltaCount = 1);
 
     /**
      * Process the data extracted from a peer's reply
@@ -155,6 +159,8 @@ private:
     std::vector<OnDeltaDataCB> dataReadyCallbacks_;
     std::set<InboundLedger::Reason> reasons_;
     std::uint32_t noFeaturePeerCount = 0;
+    // number of deltas to ask for in the next request, see init()
+    std::uint32_t deltaCount_ = 1;
     bool fallBack_ = false;
 
     friend class LedgerReplayTask;  // for asserts only
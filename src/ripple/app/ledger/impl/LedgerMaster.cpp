@@ -35,10 +35,13 @@
 #include <ripple/app/misc/ValidatorList.h>
 #include <ripple/app/paths/PathRequests.h>
 #include <ripple/app/rdb/backend/PostgresDatabase.h>
+#include <ripple/app/rdb/backend/SQLiteDatabase.h>
+#include <ripple/app/reporting/ReportingETL.h>
 #include <ripple/app/tx/apply.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/MathUtilities.h>
 #include <ripple/basics/TaggedCache.h>
+#include <ripple/basics/Trace.h>
 #include <ripple/basics/UptimeClock.h>
 #include <ripple/basics/contract.h>
 #include <ripple/basics/safe_cast.h>
@@ -148,9 +151,6 @@ static constexpr int MAX_LEDGER_GAP{100};
 // Don't acquire history if ledger is too old
 static constexpr std::chrono::minutes MAX_LEDGER_AGE_ACQUIRE{1};
 
-// Don't acquire history if write load is too high
-static constexpr int MAX_WRITE_LOAD_ACQUIRE{8192};
-
 // Helper function for LedgerMaster::doAdvance()
 // Return true if candidateLedger should be fetched from the network.
 static bool
@@ -193,14 +193,32 @@ LedgerMaster::LedgerMaster(
           app_.getSHAMapStore().clampFetchDepth(app_.config().FETCH_DEPTH))
     , ledger_history_(app_.config().LEDGER_HISTORY)
     , ledger_fetch_size_(app_.config().getValueFor(SizedItem::ledgerFetch))
+    , history_fetch_segments_(app_.config().HISTORY_FETCH_SEGMENTS)
+    , history_max_write_load_(app_.config().HISTORY_MAX_WRITE_LOAD)
+    , history_max_fetch_rate_(app_.config().HISTORY_MAX_FETCH_RATE)
     , fetch_packs_(
           "FetchPack",
           65536,
           std::chrono::seconds{45},
           stopwatch,
           app_.journal("TaggedCache"))
+    , built_packs_(
+          "BuiltFetchPack",
+          8,
+          std::chrono::seconds{30},
+          stopwatch,
+          app_.journal("TaggedCache"))
     , m_stats(std::bind(&LedgerMaster::collect_metrics, this), collector)
 {
+    auto const& dbPath = app_.config().legacy("database_path");
+    if (app_.config().LEDGER_HASH_INDEX && !standalone_ && !dbPath.empty())
+    {
+        hashIndex_ = std::make_unique<LedgerHashIndex>(
+            boost::filesystem::path(dbPath) / "ledger_hashes.idx",
+            app_.config().NETWORK_ID,
+            app_.getNodeStore().earliestLedgerSeq(),
+            m_journal);
+    }
 }
 
 LedgerIndex
@@ -529,6 +547,8 @@ LedgerMaster::switchLCL(std::shared_ptr<Ledger const> const& lastClosed)
 bool
 LedgerMaster::fixIndex(LedgerIndex ledgerIndex, LedgerHash const& ledgerHash)
 {
+    if (hashIndex_ && hashIndex_->get(ledgerIndex) != ledgerHash)
+        hashIndex_->set(ledgerIndex, ledgerHash);
     return mLedgerHistory.fixIndex(ledgerIndex, ledgerHash);
 }
 
@@ -594,8 +614,12 @@ LedgerMaster::haveLedger(std::uint32_t seq)
 void
 LedgerMaster::clearLedger(std::uint32_t seq)
 {
-    std::lock_guard sl(mCompleteLock);
-    mCompleteLedgers.erase(seq);
+    {
+        std::lock_guard sl(mCompleteLock);
+        mCompleteLedgers.erase(seq);
+    }
+    if (hashIndex_)
+        hashIndex_->erase(seq);
 }
 
 bool
@@ -983,6 +1007,9 @@ LedgerMaster::setFullLedger(
 
     pendSaveValidated(app_, ledger, isSynchronous, isCurrent);
 
+    if (hashIndex_)
+        hashIndex_->set(ledger->info().seq, ledger->info().hash);
+
     {
         std::lock_guard ml(mCompleteLock);
         mCompleteLedgers.insert(ledger->info().seq);
@@ -1399,6 +1426,18 @@ LedgerMaster::findNewLedgersToPublish(
         return {};
     }
 
+    // The usual case: the newly validated ledger follows the last published
+    // one, so there is nothing to look up or acquire.
+    if (mValidLedgerSeq == mPubLedgerSeq + 1)
+    {
+        auto valLedger = mValidLedger.get();
+        if (valLedger->info().parentHash == mPubLedger->info().hash)
+        {
+            valLedger->setValidated();
+            return {valLedger};
+        }
+    }
+
     int acqCount = 0;
 
     auto pubSeq = mPubLedgerSeq + 1;  // Next sequence to publish
@@ -1535,6 +1574,36 @@ LedgerMaster::tryAdvance()
     }
 }
 
+void
+LedgerMaster::tryPlanHistory()
+{
+    std::lock_guard ml(m_mutex);
+
+    if (standalone_ || mHistoryThread || !mPubLedger)
+        return;
+
+    mHistoryThread = true;
+    if (!app_.getJobQueue().addJob(jtADVANCE, "planHistory", [this]() {
+            std::unique_lock sl(m_mutex);
+
+            JLOG(m_journal.trace()) << "historyThread<";
+
+            try
+            {
+                while (planHistory(sl))
+                    ;
+            }
+            catch (std::exception const& ex)
+            {
+                JLOG(m_journal.fatal()) << "planHistory throws: " << ex.what();
+            }
+
+            mHistoryThread = false;
+            JLOG(m_journal.trace()) << "historyThread>";
+        }))
+        mHistoryThread = false;
+}
+
 void
 LedgerMaster::updatePaths()
 {
@@ -1800,7 +1869,16 @@ LedgerMaster::getHashBySeq(std::uint32_t index)
     if (hash.isNonZero())
         return hash;
 
-    return app_.getRelationalDatabase().getHashByIndex(index);
+    if (hashIndex_)
+    {
+        if (auto const indexed = hashIndex_->get(index))
+            return *indexed;
+    }
+
+    hash = app_.getRelationalDatabase().getHashByIndex(index);
+    if (hashIndex_ && hash.isNonZero())
+        hashIndex_->set(index, hash);
+    return hash;
 }
 
 std::optional<LedgerHash>
@@ -1808,6 +1886,13 @@ LedgerMaster::walkHashBySeq(std::uint32_t index, InboundLedger::Reason reason)
 {
     std::optional<LedgerHash> ledgerHash;
 
+    if (hashIndex_)
+    {
+        ledgerHash = hashIndex_->get(index);
+        if (ledgerHash)
+            return ledgerHash;
+    }
+
     if (auto referenceLedger = mValidLedger.get())
         ledgerHash = walkHashBySeq(index, referenceLedger, reason);
 
@@ -1870,6 +1955,17 @@ LedgerMaster::walkHashBySeq(
 std::shared_ptr<Ledger const>
 LedgerMaster::getLedgerBySeq(std::uint32_t index)
 {
+    // Recently validated ledgers are found without taking any locks
+    if (auto ret = mLedgerHistory.getRecentLedgerBySeq(index))
+        return ret;
+
+    // In reporting mode, the latest ledger is kept in memory by ETL
+    if (app_.config().reporting())
+    {
+        if (auto ret = app_.getReportingETL().getLatestLedger(index))
+            return ret;
+    }
+
     if (index <= mValidLedgerSeq)
     {
         // Always prefer a validated ledger
@@ -1892,6 +1988,15 @@ LedgerMaster::getLedgerBySeq(std::uint32_t index)
         }
     }
 
+    if (hashIndex_)
+    {
+        if (auto const hash = hashIndex_->get(index))
+        {
+            if (auto ret = mLedgerHistory.getLedgerByHash(*hash))
+                return ret;
+        }
+    }
+
     if (auto ret = mLedgerHistory.getLedgerBySeq(index))
         return ret;
 
@@ -1928,6 +2033,7 @@ LedgerMaster::sweep()
 {
     mLedgerHistory.sweep();
     fetch_packs_.sweep();
+    built_packs_.sweep();
 }
 
 float
@@ -2087,10 +2193,152 @@ LedgerMaster::fetchForHistory(
     }
 }
 
-// Try to publish ledgers, acquire missing ledgers
+void
+LedgerMaster::fetchHistoryGaps(
+    std::vector<ClosedInterval<std::uint32_t>> const& gaps,
+    bool& progress,
+    std::unique_lock<std::recursive_mutex>& sl)
+{
+    auto const validSeq = mValidLedgerSeq.load();
+    ScopedUnlock sul{sl};
+
+    for (auto const& gap : gaps)
+    {
+        // Gaps are ordered from the newest, so the rest are too old as well
+        if (!shouldAcquire(
+                validSeq,
+                ledger_history_,
+                app_.getSHAMapStore().minimumOnline(),
+                gap.last(),
+                m_journal))
+            break;
+
+        // The ledger following the gap is complete, and its skip list
+        // holds the hashes of the ledgers in the gap
+        auto const above = getLedgerBySeq(gap.last() + 1);
+        if (!above)
+        {
+            JLOG(m_journal.debug())
+                << "fetchHistoryGaps no ledger above " << to_string(gap);
+            continue;
+        }
+
+        std::uint32_t const fetchSz =
+            std::min(ledger_fetch_size_, gap.last() - gap.first() + 1);
+        try
+        {
+            for (std::uint32_t i = 0; i < fetchSz; ++i)
+            {
+                std::uint32_t const seq = gap.last() - i;
+                auto const hash = hashOfSeq(*above, seq, m_journal);
+                if (!hash || app_.getInboundLedgers().isFailure(*hash))
+                    break;
+
+                if (auto ledger = app_.getInboundLedgers().acquire(
+                        *hash, seq, InboundLedger::Reason::HISTORY))
+                {
+                    JLOG(m_journal.trace())
+                        << "fetchHistoryGaps acquired " << seq;
+                    setFullLedger(ledger, false, false);
+                    progress = true;
+                }
+            }
+        }
+        catch (std::exception const& ex)
+        {
+            JLOG(m_journal.warn())
+                << "Threw while fetching history gaps: " << ex.what();
+        }
+    }
+}
+
+// Decide which missing history to acquire and acquire it. Returns true
+// if a ledger was acquired and planning should continue.
+bool
+LedgerMaster::planHistory(std::unique_lock<std::recursive_mutex>& sl)
+{
+    if (standalone_ || app_.getFeeTrack().isLoadedLocal() ||
+        (app_.getJobQueue().getJobCount(jtPUBOLDLEDGER) >= 10) ||
+        (mValidLedgerSeq != mPubLedgerSeq) ||
+        (getValidatedLedgerAge() >= MAX_LEDGER_AGE_ACQUIRE) ||
+        (app_.getNodeStore().getWriteLoad() >= history_max_write_load_) ||
+        (history_max_fetch_rate_ != 0 &&
+         app_.getInboundLedgers().fetchRate() >= history_max_fetch_rate_))
+    {
+        mHistLedger.reset();
+        mShardLedger.reset();
+        JLOG(m_journal.trace()) << "planHistory not fetching history";
+        return false;
+    }
+
+    // We are in sync, so can acquire
+    bool progress = false;
+    InboundLedger::Reason reason = InboundLedger::Reason::HISTORY;
+    std::optional<std::uint32_t> missing;
+    std::vector<ClosedInterval<std::uint32_t>> gaps;
+    {
+        std::lock_guard sll(mCompleteLock);
+        gaps = missingRanges(
+            mCompleteLedgers,
+            mPubLedger->info().seq,
+            app_.getNodeStore().earliestLedgerSeq(),
+            history_fetch_segments_);
+    }
+    if (!gaps.empty())
+        missing = gaps.front().last();
+    if (missing)
+    {
+        JLOG(m_journal.trace())
+            << "planHistory discovered missing " << *missing;
+        if ((mFillInProgress == 0 || *missing > mFillInProgress) &&
+            shouldAcquire(
+                mValidLedgerSeq,
+                ledger_history_,
+                app_.getSHAMapStore().minimumOnline(),
+                *missing,
+                m_journal))
+        {
+            JLOG(m_journal.trace()) << "historyThread should acquire";
+        }
+        else
+            missing = std::nullopt;
+    }
+    if (!missing && mFillInProgress == 0)
+    {
+        if (auto shardStore = app_.getShardStore())
+        {
+            missing = shardStore->prepareLedger(mValidLedgerSeq);
+            if (missing)
+                reason = InboundLedger::Reason::SHARD;
+        }
+    }
+    if (missing)
+    {
+        fetchForHistory(*missing, progress, reason, sl);
+        if (reason == InboundLedger::Reason::HISTORY && gaps.size() > 1)
+        {
+            gaps.erase(gaps.begin());
+            fetchHistoryGaps(gaps, progress, sl);
+        }
+        if (mValidLedgerSeq != mPubLedgerSeq)
+        {
+            // Publishing comes first; it restarts planning once it has
+            // caught up.
+            JLOG(m_journal.debug()) << "planHistory found last valid changed";
+            tryAdvance();
+            return false;
+        }
+    }
+
+    return progress;
+}
+
+// Publish ledgers that are ready. Backfilling history is left to the
+// history planner so that it never delays publication.
 void
 LedgerMaster::doAdvance(std::unique_lock<std::recursive_mutex>& sl)
 {
+    trace::Span span("LedgerMaster::doAdvance");
     do
     {
         mAdvanceWork = false;  // If there's work to do, we'll make progress
@@ -2099,66 +2347,8 @@ LedgerMaster::doAdvance(std::unique_lock<std::recursive_mutex>& sl)
         auto const pubLedgers = findNewLedgersToPublish(sl);
         if (pubLedgers.empty())
         {
-            if (!standalone_ && !app_.getFeeTrack().isLoadedLocal() &&
-                (app_.getJobQueue().getJobCount(jtPUBOLDLEDGER) < 10) &&
-                (mValidLedgerSeq == mPubLedgerSeq) &&
-                (getValidatedLedgerAge() < MAX_LEDGER_AGE_ACQUIRE) &&
-                (app_.getNodeStore().getWriteLoad() < MAX_WRITE_LOAD_ACQUIRE))
-            {
-                // We are in sync, so can acquire
-                InboundLedger::Reason reason = InboundLedger::Reason::HISTORY;
-                std::optional<std::uint32_t> missing;
-                {
-                    std::lock_guard sll(mCompleteLock);
-                    missing = prevMissing(
-                        mCompleteLedgers,
-                        mPubLedger->info().seq,
-                        app_.getNodeStore().earliestLedgerSeq());
-                }
-                if (missing)
-                {
-                    JLOG(m_journal.trace())
-                        << "tryAdvance discovered missing " << *missing;
-                    if ((mFillInProgress == 0 || *missing > mFillInProgress) &&
-                        shouldAcquire(
-                            mValidLedgerSeq,
-                            ledger_history_,
-                            app_.getSHAMapStore().minimumOnline(),
-                            *missing,
-                            m_journal))
-                    {
-                        JLOG(m_journal.trace())
-                            << "advanceThread should acquire";
-                    }
-                    else
-                        missing = std::nullopt;
-                }
-                if (!missing && mFillInProgress == 0)
-                {
-                    if (auto shardStore = app_.getShardStore())
-                    {
-                        missing = shardStore->prepareLedger(mValidLedgerSeq);
-                        if (missing)
-                            reason = InboundLedger::Reason::SHARD;
-                    }
-                }
-                if (missing)
-                {
-                    fetchForHistory(*missing, progress, reason, sl);
-                    if (mValidLedgerSeq != mPubLedgerSeq)
-                    {
-                        JLOG(m_journal.debug())
-                            << "tryAdvance found last valid changed";
-                        progress = true;
-                    }
-                }
-            }
-            else
-            {
-                mHistLedger.reset();
-                mShardLedger.reset();
-                JLOG(m_journal.trace()) << "tryAdvance not fetching history";
-            }
+            // Caught up, look for history to backfill
+            tryPlanHistory();
         }
         else
         {
@@ -2220,6 +2410,9 @@ LedgerMaster::gotFetchPack(bool progress, std::uint32_t seq)
     }
 }
 
+// Fetch packs are sent in messages of about this many bytes of node data
+static constexpr std::size_t fetchPackChunkBytes = 1024 * 1024;
+
 /** Populate a fetch pack with data from the map the recipient wants.
 
     A recipient may or may not have the map that they are asking for. If
@@ -2228,8 +2421,7 @@ LedgerMaster::gotFetchPack(bool progress, std::uint32_t seq)
 
     @param have The map that the recipient already has (if any).
     @param cnt The maximum number of nodes to return.
-    @param into The protocol object into which we add information.
-    @param seq The sequence number of the ledger the map is a part of.
+    @param add Called with the hash and serialized data of each node.
     @param withLeaves True if leaf nodes should be included.
 
     @note: The withLeaves parameter is configurable even though the
@@ -2245,13 +2437,13 @@ LedgerMaster::gotFetchPack(bool progress, std::uint32_t seq)
            the transactions because the caller is unlikely to have
            them.
  */
+template <class Add>
 static void
 populateFetchPack(
     SHAMap const& want,
     SHAMap const* have,
     std::uint32_t cnt,
-    protocol::TMGetObjectByHash* into,
-    std::uint32_t seq,
+    Add&& add,
     bool withLeaves = true)
 {
     assert(cnt != 0);
@@ -2259,20 +2451,14 @@ populateFetchPack(
     Serializer s(1024);
 
     want.visitDifferences(
-        have,
-        [&s, withLeaves, &cnt, into, seq](SHAMapTreeNode const& n) -> bool {
+        have, [&s, withLeaves, &cnt, &add](SHAMapTreeNode const& n) -> bool {
             if (!withLeaves && n.isLeaf())
                 return true;
 
             s.erase();
             n.serializeWithPrefix(s);
 
-            auto const& hash = n.getHash().as_uint256();
-
-            protocol::TMIndexedObject* obj = into->add_objects();
-            obj->set_ledgerseq(seq);
-            obj->set_hash(hash.data(), hash.size());
-            obj->set_data(s.getDataPtr(), s.getLength());
+            add(n.getHash().as_uint256(), s.slice());
 
             return --cnt != 0;
         });
@@ -2339,18 +2525,73 @@ LedgerMaster::makeFetchPack(
         return;
     }
 
+    // A peer never sets seq in its request, so the reply depends only on
+    // the ledger it has, and one built for another peer can be sent again.
+    bool const cacheable = !request->has_seq();
+
+    if (cacheable)
+    {
+        if (auto const pack = built_packs_.fetch(haveLedgerHash))
+        {
+            JLOG(m_journal.info()) << "Sending cached fetch pack of "
+                                   << pack->size() << " messages";
+            for (auto const& msg : *pack)
+                peer->send(msg);
+            return;
+        }
+    }
+
     try
     {
         Serializer hdr(128);
 
+        auto pack = std::make_shared<std::vector<std::shared_ptr<Message>>>();
+        std::size_t nodes = 0;
+        std::size_t bytes = 0;
+
         protocol::TMGetObjectByHash reply;
-        reply.set_query(false);
+        std::size_t replyBytes = 0;
+
+        auto const startReply = [&reply, &replyBytes, &request]() {
+            reply.Clear();
+            reply.set_query(false);
+
+            if (request->has_seq())
+                reply.set_seq(request->seq());
+
+            reply.set_ledgerhash(request->ledgerhash());
+            reply.set_type(protocol::TMGetObjectByHash::otFETCH_PACK);
+            replyBytes = 0;
+        };
+
+        // Send the nodes gathered so far, so the peer can start on them
+        // while we walk the maps for the rest
+        auto const sendReply = [&]() {
+            if (reply.objects_size() == 0)
+                return;
+
+            auto msg =
+                std::make_shared<Message>(reply, protocol::mtGET_OBJECTS);
+            bytes += msg->getBufferSize();
+            peer->send(msg);
+            pack->push_back(std::move(msg));
+            startReply();
+        };
 
-        if (request->has_seq())
-            reply.set_seq(request->seq());
+        auto const addObject =
+            [&](uint256 const& hash, Slice data, std::uint32_t seq) {
+                protocol::TMIndexedObject* obj = reply.add_objects();
+                obj->set_ledgerseq(seq);
+                obj->set_hash(hash.data(), hash.size());
+                obj->set_data(data.data(), data.size());
+                ++nodes;
+
+                replyBytes += hash.size() + data.size();
+                if (replyBytes >= fetchPackChunkBytes)
+                    sendReply();
+            };
 
-        reply.set_ledgerhash(request->ledgerhash());
-        reply.set_type(protocol::TMGetObjectByHash::otFETCH_PACK);
+        startReply();
 
         // Building a fetch pack:
         //  1. Add the header for the requested ledger.
@@ -2360,6 +2601,7 @@ LedgerMaster::makeFetchPack(
         //  4. If the FetchPack now contains at least 512 entries then stop.
         //  5. If not very much time has elapsed, then loop back and repeat
         //     the same process adding the previous ledger to the FetchPack.
+        // Nodes are sent in messages of about fetchPackChunkBytes each.
         do
         {
             std::uint32_t lSeq = want->info().seq;
@@ -2372,35 +2614,36 @@ LedgerMaster::makeFetchPack(
                 addRaw(want->info(), hdr);
 
                 // Add the data
-                protocol::TMIndexedObject* obj = reply.add_objects();
-                obj->set_hash(
-                    want->info().hash.data(), want->info().hash.size());
-                obj->set_data(hdr.getDataPtr(), hdr.getLength());
-                obj->set_ledgerseq(lSeq);
+                addObject(want->info().hash, hdr.slice(), lSeq);
             }
 
-            populateFetchPack(
-                want->stateMap(), &have->stateMap(), 16384, &reply, lSeq);
+            auto const add = [&addObject, lSeq](
+                                 uint256 const& hash, Slice data) {
+                addObject(hash, data, lSeq);
+            };
+
+            populateFetchPack(want->stateMap(), &have->stateMap(), 16384, add);
 
             // We use nullptr here because transaction maps are per ledger
             // and so the requestor is unlikely to already have it.
             if (want->info().txHash.isNonZero())
-                populateFetchPack(want->txMap(), nullptr, 512, &reply, lSeq);
+                populateFetchPack(want->txMap(), nullptr, 512, add);
 
-            if (reply.objects().size() >= 512)
+            if (nodes >= 512)
                 break;
 
             have = std::move(want);
             want = getLedgerByHash(have->info().parentHash);
         } while (want && UptimeClock::now() <= uptime + 1s);
 
-        auto msg = std::make_shared<Message>(reply, protocol::mtGET_OBJECTS);
+        sendReply();
 
         JLOG(m_journal.info())
-            << "Built fetch pack with " << reply.objects().size() << " nodes ("
-            << msg->getBufferSize() << " bytes)";
+            << "Built fetch pack with " << nodes << " nodes in "
+            << pack->size() << " messages (" << bytes << " bytes)";
 
-        peer->send(msg);
+        if (cacheable)
+            built_packs_.canonicalize_replace_client(haveLedgerHash, pack);
     }
     catch (std::exception const& ex)
     {
@@ -2430,6 +2673,17 @@ LedgerMaster::txnIdFromIndex(uint32_t ledgerSeq, uint32_t txnIndex)
     if (!getValidatedRange(first, last) || last < ledgerSeq)
         return {};
 
+    if (!app_.config().reporting())
+    {
+        if (auto const db =
+                dynamic_cast<SQLiteDatabase*>(&app_.getRelationalDatabase()))
+        {
+            if (auto const txID = db->getTransactionIdByIndex(
+                    ledgerSeq, txnIndex))
+                return txID;
+        }
+    }
+
     auto const lgr = getLedgerBySeq(ledgerSeq);
     if (!lgr || lgr->txs.empty())
         return {};
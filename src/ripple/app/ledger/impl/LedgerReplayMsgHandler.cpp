@@ -23,9 +23,31 @@
 #include <ripple/app/main/Application.h>
 #include <ripple/protocol/LedgerHeader.h>
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 namespace ripple {
+
+namespace {
+
+// Pack the header and transactions of a ledger into a reply
+void
+packReplayDelta(Ledger const& ledger, protocol::TMReplayDeltaResponse& reply)
+{
+    // pack header
+    Serializer nData(128);
+    addRaw(ledger.info(), nData);
+    reply.set_ledgerheader(nData.getDataPtr(), nData.getLength());
+    // pack transactions
+    ledger.txMap().visitLeaves(
+        [&](boost::intrusive_ptr<SHAMapItem const> const& txNode) {
+            reply.add_transaction(txNode->data(), txNode->size());
+        });
+}
+
+}  // namespace
+
 LedgerReplayMsgHandler::LedgerReplayMsgHandler(
     Application& app,
     LedgerReplayer& replayer)
@@ -201,22 +223,47 @@ LedgerReplayMsgHandler::processReplayDeltaRequest(
         return reply;
     }
 
-    // pack header
-    Serializer nData(128);
-    addRaw(ledger->info(), nData);
-    reply.set_ledgerheader(nData.getDataPtr(), nData.getLength());
-    // pack transactions
-    auto const& txMap = ledger->txMap();
-    txMap.visitLeaves(
-        [&](boost::intrusive_ptr<SHAMapItem const> const& txNode) {
-            reply.add_transaction(txNode->data(), txNode->size());
-        });
+    packReplayDelta(*ledger, reply);
 
     JLOG(journal_.debug()) << "getReplayDelta for ledger " << ledgerHash
-                           << " txMap hash " << txMap.getHash().as_uint256();
+                           << " txMap hash "
+                           << ledger->txMap().getHash().as_uint256();
     return reply;
 }
 
+void
+LedgerReplayMsgHandler::processReplayDeltaAncestors(
+    std::shared_ptr<protocol::TMReplayDeltaRequest> const& msg,
+    std::function<void(protocol::TMReplayDeltaResponse const&)> const& send)
+{
+    protocol::TMReplayDeltaRequest& packet = *msg;
+    if (!packet.has_count() || packet.count() <= 1 ||
+        packet.ledgerhash().size() != uint256::size())
+        return;
+
+    auto const count =
+        std::min(packet.count(), LedgerReplayParameters::MAX_DELTA_BATCH);
+    auto ledger =
+        app_.getLedgerMaster().getLedgerByHash(uint256{packet.ledgerhash()});
+
+    for (std::uint32_t i = 1; ledger && i < count; ++i)
+    {
+        auto const parentHash = ledger->info().parentHash;
+        ledger = app_.getLedgerMaster().getLedgerByHash(parentHash);
+        if (!ledger || !ledger->isImmutable())
+        {
+            JLOG(journal_.debug())
+                << "getReplayDelta: Don't have ancestor " << parentHash;
+            return;
+        }
+
+        protocol::TMReplayDeltaResponse reply;
+        reply.set_ledgerhash(parentHash.data(), parentHash.size());
+        packReplayDelta(*ledger, reply);
+        send(reply);
+    }
+}
+
 bool
 LedgerReplayMsgHandler::processReplayDeltaResponse(
     std::shared_ptr<protocol::TMReplayDeltaResponse> const& msg)
@@ -240,7 +287,8 @@ LedgerReplayMsgHandler::processReplayDeltaResponse(
 
     auto numTxns = reply.transaction_size();
     std::map<std::uint32_t, std::shared_ptr<STTx const>> orderedTxns;
-    SHAMap txMap(SHAMapType::TRANSACTION, app_.getNodeFamily());
+    std::vector<boost::intrusive_ptr<SHAMapItem const>> items;
+    items.reserve(numTxns);
     try
     {
         for (int i = 0; i < numTxns; ++i)
@@ -265,14 +313,7 @@ LedgerReplayMsgHandler::processReplayDeltaResponse(
             auto tid = tx->getTransactionID();
             STObject meta(metaSit, sfMetadata);
             orderedTxns.emplace(meta[sfTransactionIndex], std::move(tx));
-
-            if (!txMap.addGiveItem(
-                    SHAMapNodeType::tnTRANSACTION_MD,
-                    make_shamapitem(tid, shaMapItemData.slice())))
-            {
-                JLOG(journal_.debug()) << "Bad message: Cannot deserialize";
-                return false;
-            }
+            items.push_back(make_shamapitem(tid, shaMapItemData.slice()));
         }
     }
     catch (std::exception const&)
@@ -281,6 +322,21 @@ LedgerReplayMsgHandler::processReplayDeltaResponse(
         return false;
     }
 
+    // The transactions are sent in key order, so the map can be built
+    // bottom up. Sorting keeps any other order acceptable.
+    auto const byKey = [](auto const& a, auto const& b) {
+        return a->key() < b->key();
+    };
+    if (!std::is_sorted(items.begin(), items.end(), byKey))
+        std::sort(items.begin(), items.end(), byKey);
+
+    SHAMap txMap(SHAMapType::TRANSACTION, app_.getNodeFamily());
+    if (!txMap.addSortedItems(SHAMapNodeType::tnTRANSACTION_MD, items))
+    {
+        JLOG(journal_.debug()) << "Bad message: Cannot deserialize";
+        return false;
+    }
+
     if (txMap.getHash().as_uint256() != info.txHash)
     {
         JLOG(journal_.debug()) << "Bad message: Transactions verify failed";
@@ -23,6 +23,8 @@
 #include <ripple/beast/utility/Journal.h>
 #include <ripple/protocol/messages.h>
 
+#include <functional>
+
 namespace ripple {
 class Application;
 class LedgerReplayer;
@@ -58,6 +60,19 @@ public:
     processReplayDeltaRequest(
         std::shared_ptr<protocol::TMReplayDeltaRequest> const& msg);
 
+    /**
+     * Process the ancestors asked for by the count of a TMReplayDeltaRequest
+     * @param msg  the request, already answered by processReplayDeltaRequest
+     * @param send  called with a TMReplayDeltaResponse for each ancestor,
+     *              newest first
+     * @note stops at the first ancestor that we don't have
+     */
+    void
+    processReplayDeltaAncestors(
+        std::shared_ptr<protocol::TMReplayDeltaRequest> const& msg,
+        std::function<void(protocol::TMReplayDeltaResponse const&)> const&
+            send);
+
     /**
      * Process TMReplayDeltaResponse
      * @return false if the response message has bad format or bad data;
@@ -134,6 +134,24 @@ LedgerReplayer::createDeltas(std::shared_ptr<LedgerReplayTask> task)
             return;
         }
 
+        // New deltas of consecutive ledgers, oldest first. They are asked
+        // for in batches: the newest delta of a batch asks one peer for
+        // the whole batch, and the others wait for that reply.
+        std::vector<std::shared_ptr<LedgerDeltaAcquire>> run;
+        auto const initRun = [&run]() {
+            for (std::size_t begin = 0; begin < run.size();
+                 begin += LedgerReplayParameters::MAX_DELTA_BATCH)
+            {
+                auto const end = std::min<std::size_t>(
+                    begin + LedgerReplayParameters::MAX_DELTA_BATCH,
+                    run.size());
+                for (auto i = begin; i + 1 < end; ++i)
+                    run[i]->init(1, 0);
+                run[end - 1]->init(1, end - begin);
+            }
+            run.clear();
+        };
+
         for (std::uint32_t seq = parameter.startSeq_ + 1;
              seq <= parameter.finishSeq_ &&
              skipListItem != parameter.skipList_.end();
@@ -164,8 +182,12 @@ LedgerReplayer::createDeltas(std::shared_ptr<LedgerReplayTask> task)
 
             task->addDelta(delta);
             if (newDelta)
-                delta->init(1);
+                run.push_back(std::move(delta));
+            else
+                initRun();
         }
+
+        initRun();
     }
 }
 
@@ -23,16 +23,23 @@
 #include <ripple/app/misc/DeliverMax.h>
 #include <ripple/app/misc/TxQ.h>
 #include <ripple/basics/base_uint.h>
+#include <ripple/core/ParallelFor.h>
 #include <ripple/core/Pg.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/DeliveredAmount.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
+#include <thread>
+#include <vector>
 
 namespace ripple {
 
 namespace {
 
+// Fewer expanded transactions than this for each thread are not worth
+// sharing out.
+constexpr std::size_t txsPerThread = 64;
+
 bool
 isFull(LedgerFill const& fill)
 {
@@ -227,11 +234,45 @@ fillJsonTx(Object& json, LedgerFill const& fill)
     try
     {
         auto appendAll = [&](auto const& txs) {
-            for (auto& i : txs)
+            if (!bExpanded || !fill.context)
             {
-                txns.append(
-                    fillJsonTx(fill, bBinary, bExpanded, i.first, i.second));
+                for (auto& i : txs)
+                {
+                    txns.append(fillJsonTx(
+                        fill, bBinary, bExpanded, i.first, i.second));
+                }
+                return;
             }
+
+            // Expanding a transaction and its metadata costs far more than
+            // writing the result, so the transactions are expanded on
+            // several threads and then written in ledger order.
+            std::vector<ReadView::tx_type> const items(txs.begin(), txs.end());
+            std::vector<Json::Value> results(items.size());
+
+            auto const threads = std::max<std::size_t>(
+                std::min<std::size_t>(
+                    std::thread::hardware_concurrency(),
+                    items.size() / txsPerThread),
+                1);
+            parallelFor(
+                fill.context->app.getJobQueue(),
+                jtCLIENT_RPC,
+                "LedgerToJson::fillJsonTx",
+                items.size(),
+                threads - 1,
+                [&](std::size_t i) {
+                    results[i] = fillJsonTx(
+                        fill,
+                        bBinary,
+                        bExpanded,
+                        items[i].first,
+                        items[i].second);
+                    return true;
+                });
+
+            for (auto& result : results)
+                txns.append(std::move(result));
         };
 
         if (fill.context && fill.context->app.config().reporting())
@@ -22,12 +22,17 @@
 #include <ripple/app/misc/HashRouter.h>
 #include <ripple/app/misc/TxQ.h>
 #include <ripple/app/tx/apply.h>
+#include <ripple/app/tx/applySteps.h>
+#include <ripple/basics/Trace.h>
+#include <ripple/core/ParallelFor.h>
 #include <ripple/ledger/CachedView.h>
 #include <ripple/overlay/Message.h>
 #include <ripple/overlay/Overlay.h>
 #include <ripple/overlay/predicates.h>
 #include <ripple/protocol/Feature.h>
 #include <boost/range/adaptor/transformed.hpp>
+#include <algorithm>
+#include <memory>
 
 namespace ripple {
 
@@ -42,15 +47,13 @@ OpenLedger::OpenLedger(
 bool
 OpenLedger::empty() const
 {
-    std::lock_guard lock(modify_mutex_);
-    return current_->txCount() == 0;
+    return current()->txCount() == 0;
 }
 
 std::shared_ptr<OpenView const>
 OpenLedger::current() const
 {
-    std::lock_guard lock(current_mutex_);
-    return current_;
+    return std::atomic_load(&current_);
 }
 
 bool
@@ -60,13 +63,37 @@ OpenLedger::modify(modify_type const& f)
     auto next = std::make_shared<OpenView>(*current_);
     auto const changed = f(*next, j_);
     if (changed)
-    {
-        std::lock_guard lock2(current_mutex_);
-        current_ = std::move(next);
-    }
+        std::atomic_store(
+            &current_, std::shared_ptr<OpenView const>{std::move(next)});
     return changed;
 }
 
+/** Preflight transactions on the job queue.
+
+    The results land in the preflight cache, where applying the
+    transactions to an open view finds them. Exceptions are handled by
+    `preflight` itself.
+*/
+static void
+preflightAll(
+    Application& app,
+    Rules const& rules,
+    std::vector<std::shared_ptr<STTx const>> const& txs,
+    ApplyFlags flags,
+    beast::Journal j)
+{
+    parallelFor(
+        app.getJobQueue(),
+        jtTRANSACTION,
+        "OpenLedger::preflight",
+        txs.size(),
+        ParallelGrain{},
+        [&](std::size_t i) {
+            preflight(app, rules, *txs[i], flags, j);
+            return true;
+        });
+}
+
 void
 OpenLedger::accept(
     Application& app,
@@ -79,8 +106,27 @@ OpenLedger::accept(
     std::string const& suffix,
     modify_type const& f)
 {
+    trace::Span span("OpenLedger::accept", ledger->seq());
     JLOG(j_.trace()) << "accept ledger " << ledger->seq() << " " << suffix;
     auto next = create(rules, ledger);
+
+    // Everything below may be applied to the new view. The checks that do
+    // not depend on the view are run up front, in parallel and outside the
+    // lock, so only the work that does stays on the serialized path.
+    {
+        std::vector<std::shared_ptr<STTx const>> candidates;
+        auto const snapshot = current();
+        candidates.reserve(
+            retries.size() + snapshot->txCount() + locals.size());
+        for (auto const& item : retries)
+            candidates.push_back(item.second);
+        for (auto const& item : snapshot->txs)
+            candidates.push_back(item.first);
+        for (auto const& item : locals)
+            candidates.push_back(item.second);
+        preflightAll(app, rules, candidates, flags, j_);
+    }
+
     if (retriesFirst)
     {
         // Handle disputed tx, outside lock
@@ -137,8 +183,8 @@ OpenLedger::accept(
     }
 
     // Switch to the new open view
-    std::lock_guard lock2(current_mutex_);
-    current_ = std::move(next);
+    std::atomic_store(
+        &current_, std::shared_ptr<OpenView const>{std::move(next)});
 }
 
 //------------------------------------------------------------------------------
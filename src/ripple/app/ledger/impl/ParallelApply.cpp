@@ -0,0 +1,321 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/impl/ParallelApply.h>
+#include <ripple/app/main/Application.h>
+#include <ripple/app/misc/CanonicalTXSet.h>
+#include <ripple/app/tx/apply.h>
+#include <ripple/basics/Log.h>
+#include <ripple/core/JobQueue.h>
+#include <ripple/core/ParallelFor.h>
+#include <ripple/ledger/RecordingView.h>
+#include <ripple/protocol/STObject.h>
+#include <ripple/protocol/STTx.h>
+
+#include <algorithm>
+#include <cassert>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace ripple {
+
+namespace {
+
+// Applies the changes of a view to the view it was built on, recording
+// which keys were written, and by which commit.
+//
+// Transactions applied to a view of their own get metadata whose
+// TransactionIndex is relative to that view. It is rewritten here to the
+// index the transaction has in the target.
+class CommitView : public TxsRawView
+{
+    OpenView& to_;
+    std::set<uint256>& written_;
+    ParallelRetries& retries_;
+
+    void
+    write(uint256 const& key)
+    {
+        written_.insert(key);
+        retries_.written[key] = retries_.commits;
+    }
+
+public:
+    CommitView(
+        OpenView& to,
+        std::set<uint256>& written,
+        ParallelRetries& retries)
+        : to_(to), written_(written), retries_(retries)
+    {
+    }
+
+    void
+    rawErase(std::shared_ptr<SLE> const& sle) override
+    {
+        write(sle->key());
+        to_.rawErase(sle);
+    }
+
+    void
+    rawInsert(std::shared_ptr<SLE> const& sle) override
+    {
+        write(sle->key());
+        to_.rawInsert(sle);
+    }
+
+    void
+    rawReplace(std::shared_ptr<SLE> const& sle) override
+    {
+        write(sle->key());
+        to_.rawReplace(sle);
+    }
+
+    void
+    rawDestroyXRP(XRPAmount const& fee) override
+    {
+        to_.rawDestroyXRP(fee);
+    }
+
+    void
+    rawTxInsert(
+        ReadView::key_type const& key,
+        std::shared_ptr<Serializer const> const& txn,
+        std::shared_ptr<Serializer const> const& metaData) override
+    {
+        if (!metaData)
+        {
+            to_.rawTxInsert(key, txn, metaData);
+            return;
+        }
+
+        STObject meta(SerialIter{metaData->slice()}, sfMetadata);
+        meta.setFieldU32(
+            sfTransactionIndex, static_cast<std::uint32_t>(to_.txCount()));
+
+        auto s = std::make_shared<Serializer>();
+        meta.add(*s);
+        to_.rawTxInsert(key, txn, s);
+    }
+};
+
+struct Speculation
+{
+    std::shared_ptr<STTx const> tx;
+    std::unique_ptr<RecordingView> reads;
+    std::unique_ptr<OpenView> view;
+    ApplyResult result = ApplyResult::Retry;
+
+    // Nothing the transaction read when it last had to be retried had been
+    // written as of the start of the window, so it wasn't speculated on.
+    bool unchanged = false;
+};
+
+// Whether anything a transaction read when it last had to be retried was
+// written since.
+bool
+changedSince(ParallelRetries const& state, ParallelRetries::Retry const& retry)
+{
+    auto const& reads = retry.reads;
+    if (!reads.complete)
+        return true;
+
+    for (auto const& key : reads.keys)
+    {
+        if (auto const it = state.written.find(key);
+            it != state.written.end() && it->second > retry.commits)
+            return true;
+    }
+
+    for (auto const& [first, last] : reads.ranges)
+    {
+        for (auto it = state.written.upper_bound(first);
+             it != state.written.end() && it->first <= last;
+             ++it)
+        {
+            if (it->second > retry.commits)
+                return true;
+        }
+    }
+
+    return false;
+}
+
+// How many transactions to speculate on per thread before committing.
+// The cap bounds the number of views alive at once, and committing often
+// keeps later speculation close to the state it will commit against.
+constexpr std::size_t windowPerThread = 8;
+
+}  // namespace
+
+int
+applyTransactionsParallel(
+    Application& app,
+    CanonicalTXSet& txns,
+    std::set<TxID>& failed,
+    OpenView& view,
+    bool certainRetry,
+    std::size_t threads,
+    ParallelRetries& retries,
+    beast::Journal j)
+{
+    assert(threads > 1);
+
+    int changes = 0;
+    std::size_t speculated = 0;
+    std::size_t conflicts = 0;
+    std::size_t skipped = 0;
+
+    // Whether a transaction would certainly have to be retried again
+    auto const unchanged = [&](TxID const& txid) {
+        auto const it = retries.retries.find(txid);
+        return it != retries.retries.end() &&
+            it->second.certainRetry == certainRetry &&
+            !changedSince(retries, it->second);
+    };
+
+    std::vector<Speculation> window;
+    window.reserve(threads * windowPerThread);
+
+    auto it = txns.begin();
+    while (it != txns.end())
+    {
+        window.clear();
+        std::size_t speculating = 0;
+        for (auto next = it;
+             next != txns.end() && speculating < window.capacity();
+             ++next)
+        {
+            auto& s = window.emplace_back();
+            s.tx = next->second;
+            s.unchanged = unchanged(next->first.getTXID());
+            if (!s.unchanged)
+                ++speculating;
+        }
+
+        // Speculate, against the state as of the start of this window
+        parallelFor(
+            app.getJobQueue(),
+            jtACCEPT,
+            "applyTransactionsParallel",
+            window.size(),
+            std::min(threads, std::max<std::size_t>(speculating, 1)) - 1,
+            [&](std::size_t i) {
+                auto& s = window[i];
+                if (s.unchanged)
+                    return true;
+                s.reads = std::make_unique<RecordingView>(view);
+                s.view = std::make_unique<OpenView>(s.reads.get());
+                s.result = applyTransaction(
+                    app, *s.view, *s.tx, certainRetry, tapNONE, j);
+                return true;
+            });
+        speculated += speculating;
+
+        // Commit in canonical order
+        std::set<uint256> written;
+        auto const commit = [&](OpenView& from) {
+            ++retries.commits;
+            CommitView to(view, written, retries);
+            from.apply(to);
+        };
+        for (auto& s : window)
+        {
+            auto const txid = s.tx->getTransactionID();
+            assert(it != txns.end() && it->second == s.tx);
+
+            try
+            {
+                if (s.unchanged && unchanged(txid))
+                {
+                    // Applying it again would give the same result
+                    ++skipped;
+                    s.result = ApplyResult::Retry;
+                    ++it;
+                    continue;
+                }
+
+                if (s.unchanged ||
+                    (!written.empty() && s.reads->reads().changedBy(written)))
+                {
+                    // Something this transaction read has changed since it
+                    // was speculated; apply it again.
+                    if (!s.unchanged)
+                        ++conflicts;
+                    s.view.reset();
+
+                    s.reads = std::make_unique<RecordingView>(view);
+                    OpenView serial(s.reads.get());
+                    s.result = applyTransaction(
+                        app, serial, *s.tx, certainRetry, tapNONE, j);
+                    if (s.result == ApplyResult::Success)
+                        commit(serial);
+                }
+                else if (s.result == ApplyResult::Success)
+                {
+                    commit(*s.view);
+                }
+
+                switch (s.result)
+                {
+                    case ApplyResult::Success:
+                        retries.retries.erase(txid);
+                        it = txns.erase(it);
+                        ++changes;
+                        break;
+
+                    case ApplyResult::Fail:
+                        retries.retries.erase(txid);
+                        failed.insert(txid);
+                        it = txns.erase(it);
+                        break;
+
+                    case ApplyResult::Retry:
+                        retries.retries.insert_or_assign(
+                            txid,
+                            ParallelRetries::Retry{
+                                s.reads->reads(),
+                                retries.commits,
+                                certainRetry});
+                        ++it;
+                }
+            }
+            catch (std::exception const& ex)
+            {
+                JLOG(j.warn())
+                    << "Transaction " << txid << " throws: " << ex.what();
+                retries.retries.erase(txid);
+                failed.insert(txid);
+                it = txns.erase(it);
+            }
+
+            s.view.reset();
+            s.reads.reset();
+        }
+    }
+
+    JLOG(j.debug()) << "Applied " << speculated << " transactions on "
+                    << threads << " threads, " << conflicts
+                    << " reapplied after conflicts, " << skipped
+                    << " left to retry unchanged";
+
+    return changes;
+}
+
+}  // namespace ripple
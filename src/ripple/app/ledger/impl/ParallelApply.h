@@ -0,0 +1,96 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_IMPL_PARALLELAPPLY_H_INCLUDED
+#define RIPPLE_APP_LEDGER_IMPL_PARALLELAPPLY_H_INCLUDED
+
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/ledger/OpenView.h>
+#include <ripple/ledger/RecordingView.h>
+#include <ripple/protocol/Protocol.h>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+
+namespace ripple {
+
+class Application;
+class CanonicalTXSet;
+
+/** What the transactions left to retry read, kept across passes.
+
+    Applying a transaction again gives the same result until something it
+    read changes, so a pass leaves a transaction to retry without applying
+    it if nothing it read was written since it was last applied.
+*/
+struct ParallelRetries
+{
+    struct Retry
+    {
+        // What the transaction read when it was last applied
+        RecordingView::Reads reads;
+
+        // The number of transactions committed as of then
+        std::uint64_t commits;
+
+        // Whether it was applied in a pass of certain retries
+        bool certainRetry;
+    };
+
+    // The number of transactions committed so far
+    std::uint64_t commits = 0;
+
+    // The commit that last wrote each key
+    std::map<uint256, std::uint64_t> written;
+
+    std::map<TxID, Retry> retries;
+};
+
+/** Run one pass over a set of consensus transactions in parallel.
+
+    Transactions are first applied speculatively, each against its own
+    view on top of `view`, by up to `threads` jobs, recording every
+    state entry and key range they read. They are then committed to
+    `view` in canonical order. A transaction whose reads overlap anything
+    written by an earlier transaction of the pass is discarded and applied
+    again against the current state, so the resulting view is exactly the
+    one a serial pass would produce.
+
+    @param txns On entry, transactions to apply; on exit, transactions
+                to retry.
+    @param failed Populated with transactions that should not be retried.
+    @param retries What the transactions to retry read, which passes over
+                   the same view share.
+    @return The number of transactions applied.
+*/
+int
+applyTransactionsParallel(
+    Application& app,
+    CanonicalTXSet& txns,
+    std::set<TxID>& failed,
+    OpenView& view,
+    bool certainRetry,
+    std::size_t threads,
+    ParallelRetries& retries,
+    beast::Journal j);
+
+}  // namespace ripple
+
+#endif
@@ -0,0 +1,193 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/BuildLedger.h>
+#include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/ledger/LedgerReplay.h>
+#include <ripple/app/ledger/ReplayBench.h>
+#include <ripple/app/main/Application.h>
+#include <ripple/app/tx/applySteps.h>
+#include <ripple/basics/Log.h>
+#include <ripple/basics/Number.h>
+#include <ripple/protocol/Feature.h>
+#include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/TxFormats.h>
+#include <chrono>
+#include <iomanip>
+#include <map>
+
+namespace ripple {
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+// The cost of one transaction type, summed over every replayed ledger
+struct TxTypeTimes
+{
+    std::size_t count = 0;
+    std::size_t applied = 0;
+    std::chrono::nanoseconds preflight{};
+    std::chrono::nanoseconds preclaim{};
+    std::chrono::nanoseconds doApply{};
+};
+
+double
+toMillis(std::chrono::nanoseconds d)
+{
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+double
+toMicros(std::chrono::nanoseconds d, std::size_t n)
+{
+    return n ? std::chrono::duration<double, std::micro>(d).count() / n : 0;
+}
+
+}  // namespace
+
+bool
+replayBench(
+    Application& app,
+    LedgerIndex first,
+    std::uint32_t count,
+    std::ostream& out)
+{
+    auto const j = app.journal("ReplayBench");
+
+    std::shared_ptr<Ledger const> parent = loadByIndex(first - 1, app, false);
+    if (!parent)
+    {
+        JLOG(j.fatal()) << "Unable to load ledger " << first - 1;
+        return false;
+    }
+
+    std::map<TxType, TxTypeTimes> byType;
+    BuildLedgerTimes totals;
+    std::size_t totalTxs = 0;
+    std::size_t mismatched = 0;
+
+    out << "ledger,txs,apply_ms,preflight_ms,preclaim_ms,do_apply_ms,"
+           "flush_ms,store_ms,total_ms,hash_match"
+        << std::endl;
+    out << std::fixed << std::setprecision(3);
+
+    for (LedgerIndex seq = first; seq != first + count; ++seq)
+    {
+        std::shared_ptr<Ledger const> replay = loadByIndex(seq, app, false);
+        if (!replay)
+        {
+            JLOG(j.fatal()) << "Unable to load ledger " << seq;
+            return false;
+        }
+
+        LedgerReplay const replayData(parent, replay);
+
+        TxTypeTimes ledgerTimes;
+        auto applyTx = [&](OpenView& view, STTx const& tx) {
+            auto& typeTimes = byType[tx.getTxnType()];
+
+            auto const& rules = view.rules();
+            STAmountSO stAmountSO{rules.enabled(fixSTAmountCanonicalize)};
+            NumberSO stNumberSO{rules.enabled(fixUniversalNumber)};
+
+            try
+            {
+                auto const t0 = clock_type::now();
+                auto const pfresult = preflight(app, rules, tx, tapNONE, j);
+                auto const t1 = clock_type::now();
+                auto const pcresult = preclaim(pfresult, app, view);
+                auto const t2 = clock_type::now();
+                auto const applied = doApply(pcresult, app, view).second;
+                auto const t3 = clock_type::now();
+
+                for (auto times : {&typeTimes, &ledgerTimes})
+                {
+                    ++times->count;
+                    times->applied += applied ? 1 : 0;
+                    times->preflight += t1 - t0;
+                    times->preclaim += t2 - t1;
+                    times->doApply += t3 - t2;
+                }
+            }
+            catch (std::exception const& e)
+            {
+                JLOG(j.warn()) << "Transaction " << tx.getTransactionID()
+                               << " throws: " << e.what();
+            }
+        };
+
+        BuildLedgerTimes times;
+        auto const built = buildLedger(replayData, applyTx, times, app, j);
+
+        bool const match = built->info().hash == replay->info().hash;
+        if (!match)
+            ++mismatched;
+
+        out << seq << "," << ledgerTimes.count << ","
+            << toMillis(times.apply) << ","
+            << toMillis(ledgerTimes.preflight) << ","
+            << toMillis(ledgerTimes.preclaim) << ","
+            << toMillis(ledgerTimes.doApply) << "," << toMillis(times.flush)
+            << "," << toMillis(times.store) << ","
+            << toMillis(times.apply + times.flush + times.store) << ","
+            << (match ? 1 : 0) << std::endl;
+
+        totals.apply += times.apply;
+        totals.flush += times.flush;
+        totals.store += times.store;
+        totalTxs += ledgerTimes.count;
+
+        // Replay each ledger on its stored parent, so that one ledger
+        // that doesn't reproduce doesn't skew the rest
+        parent = std::move(replay);
+    }
+
+    out << std::endl
+        << "type,count,applied,preflight_us,preclaim_us,do_apply_us,"
+           "total_ms"
+        << std::endl;
+
+    for (auto const& [type, times] : byType)
+    {
+        auto const format = TxFormats::getInstance().findByType(type);
+        out << (format ? format->getName() : std::to_string(type)) << ","
+            << times.count << "," << times.applied << ","
+            << toMicros(times.preflight, times.count) << ","
+            << toMicros(times.preclaim, times.count) << ","
+            << toMicros(times.doApply, times.count) << ","
+            << toMillis(times.preflight + times.preclaim + times.doApply)
+            << std::endl;
+    }
+
+    out << std::endl
+        << "Replayed " << count << " ledgers and " << totalTxs
+        << " transactions in "
+        << toMillis(totals.apply + totals.flush + totals.store)
+        << " ms (apply " << toMillis(totals.apply) << ", flush "
+        << toMillis(totals.flush) << ", store " << toMillis(totals.store)
+        << ")";
+    if (mismatched)
+        out << "; " << mismatched << " ledgers did not reproduce";
+    out << std::endl;
+
+    return true;
+}
+
+}  // namespace ripple
@@ -20,6 +20,7 @@
 #include <ripple/app/ledger/impl/TimeoutCounter.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/core/JobQueue.h>
+#include <ripple/core/TimeoutWheel.h>
 #include <ripple/overlay/Overlay.h>
 
 namespace ripple {
@@ -41,7 +42,6 @@ TimeoutCounter::TimeoutCounter(
     , progress_(false)
     , timerInterval_(interval)
     , queueJobParameter_(std::move(jobParameter))
-    , timer_(app_.getIOService())
 {
     assert((timerInterval_ > 10ms) && (timerInterval_ < 30s));
 }
@@ -51,16 +51,14 @@ TimeoutCounter::setTimer(ScopedLockType& sl)
 {
     if (isDone())
         return;
-    timer_.expires_after(timerInterval_);
-    timer_.async_wait(
-        [wptr = pmDowncast()](boost::system::error_code const& ec) {
-            if (ec == boost::asio::error::operation_aborted)
-                return;
-
+    app_.getTimeoutWheel().schedule(
+        timerInterval_,
+        [wptr = pmDowncast(), generation = ++timerGeneration_]() {
             if (auto ptr = wptr.lock())
             {
                 ScopedLockType sl(ptr->mtx_);
-                ptr->queueJob(sl);
+                if (generation == ptr->timerGeneration_)
+                    ptr->queueJob(sl);
             }
         });
 }
@@ -24,14 +24,13 @@
 #include <ripple/beast/clock/abstract_clock.h>
 #include <ripple/beast/utility/Journal.h>
 #include <ripple/core/Job.h>
-#include <boost/asio/basic_waitable_timer.hpp>
 #include <mutex>
 
 namespace ripple {
 
 /**
-    This class is an "active" object. It maintains its own timer
-    and dispatches work to a job queue. Implementations derive
+    This class is an "active" object. It keeps a timeout on the
+    application's TimeoutWheel and dispatches work to a job queue. Implementations derive
     from this class and override the abstract hook functions in
     the base.
 
@@ -144,7 +143,10 @@ private:
     void
     invokeOnTimer();
 
-    boost::asio::basic_waitable_timer<std::chrono::steady_clock> timer_;
+    /** Counts calls to setTimer(). The wheel cannot cancel a timeout, so
+     *  only the one scheduled last acts when it expires.
+     */
+    std::uint64_t timerGeneration_ = 0;
 };
 
 }  // namespace ripple
@@ -199,6 +199,7 @@ TransactionAcquire::takeNodes(
             return SHAMapAddNode::invalid();
 
         ConsensusTransSetSF sf(app_, app_.getTempNodeCache());
+        std::vector<std::pair<SHAMapNodeID, Slice>> nodes;
 
         for (auto const& d : data)
         {
@@ -216,13 +217,19 @@ TransactionAcquire::takeNodes(
                 else
                     mHaveRoot = true;
             }
-            else if (!mMap->addKnownNode(d.first, d.second, &sf).isGood())
+            else
             {
-                JLOG(journal_.warn()) << "TX acquire got bad non-root node";
-                return SHAMapAddNode::invalid();
+                nodes.push_back(d);
             }
         }
 
+        if (!nodes.empty() &&
+            mMap->addKnownNodes(std::move(nodes), &sf).isInvalid())
+        {
+            JLOG(journal_.warn()) << "TX acquire got bad non-root node";
+            return SHAMapAddNode::invalid();
+        }
+
         trigger(peer);
         progress_ = true;
         return SHAMapAddNode::useful();
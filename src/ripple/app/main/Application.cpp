@@ -24,9 +24,11 @@
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/ledger/LedgerReplayer.h>
 #include <ripple/app/ledger/LedgerToJson.h>
+#include <ripple/app/ledger/ObligationsIndex.h>
 #include <ripple/app/ledger/OpenLedger.h>
 #include <ripple/app/ledger/OrderBookDB.h>
 #include <ripple/app/ledger/PendingSaves.h>
+#include <ripple/app/ledger/PendingWrites.h>
 #include <ripple/app/ledger/TransactionMaster.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/main/BasicApp.h>
@@ -41,6 +43,7 @@
 #include <ripple/app/misc/LoadFeeTrack.h>
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/app/misc/SHAMapStore.h>
+#include <ripple/app/misc/TxJsonCache.h>
 #include <ripple/app/misc/TxQ.h>
 #include <ripple/app/misc/ValidatorKeys.h>
 #include <ripple/app/misc/ValidatorSite.h>
@@ -48,8 +51,11 @@
 #include <ripple/app/rdb/Wallet.h>
 #include <ripple/app/rdb/backend/PostgresDatabase.h>
 #include <ripple/app/reporting/ReportingETL.h>
+#include <ripple/app/tx/PreflightCache.h>
 #include <ripple/app/tx/apply.h>
 #include <ripple/basics/ByteUtilities.h>
+#include <ripple/basics/CacheBudget.h>
+#include <ripple/basics/HugePages.h>
 #include <ripple/basics/PerfLog.h>
 #include <ripple/basics/ResolverAsio.h>
 #include <ripple/basics/random.h>
@@ -57,6 +63,8 @@
 #include <ripple/beast/asio/io_latency_probe.h>
 #include <ripple/beast/core/LexicalCast.h>
 #include <ripple/core/DatabaseCon.h>
+#include <ripple/core/ParallelFor.h>
+#include <ripple/core/TimeoutWheel.h>
 #include <ripple/crypto/csprng.h>
 #include <ripple/json/json_reader.h>
 #include <ripple/nodestore/DatabaseShard.h>
@@ -70,6 +78,7 @@
 #include <ripple/protocol/Protocol.h>
 #include <ripple/protocol/STParsedJSON.h>
 #include <ripple/resource/Fees.h>
+#include <ripple/rpc/ResponseCache.h>
 #include <ripple/rpc/ShardArchiveHandler.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
 #include <ripple/shamap/NodeFamily.h>
@@ -81,6 +90,7 @@
 
 #include <date/date.h>
 
+#include <algorithm>
 #include <chrono>
 #include <condition_variable>
 #include <cstring>
@@ -89,6 +99,7 @@
 #include <mutex>
 #include <optional>
 #include <sstream>
+#include <thread>
 #include <utility>
 #include <variant>
 
@@ -181,7 +192,10 @@ public:
     NodeStoreScheduler m_nodeStoreScheduler;
     std::unique_ptr<SHAMapStore> m_shaMapStore;
     PendingSaves pendingSaves_;
+    PendingWrites pendingWrites_;
     std::optional<OpenLedger> openLedger_;
+    // Ledger loaded at startup whose nodes are verified in the background.
+    std::optional<LedgerIndex> deferredVerify_;
 
     NodeCache m_tempNodeCache;
     CachedSLEs cachedSLEs_;
@@ -204,6 +218,8 @@ public:
     std::unique_ptr<InboundTransactions> m_inboundTransactions;
     std::unique_ptr<LedgerReplayer> m_ledgerReplayer;
     TaggedCache<uint256, AcceptedLedger> m_acceptedLedgerCache;
+    std::unique_ptr<ObligationsIndex> obligationsIndex_;
+    CacheBudget cacheBudget_;
     std::unique_ptr<NetworkOPs> m_networkOPs;
     std::unique_ptr<Cluster> cluster_;
     std::unique_ptr<PeerReservationTable> peerReservations_;
@@ -215,12 +231,16 @@ public:
     std::unique_ptr<AmendmentTable> m_amendmentTable;
     std::unique_ptr<LoadFeeTrack> mFeeTrack;
     std::unique_ptr<HashRouter> hashRouter_;
+    std::unique_ptr<PreflightCache> preflightCache_;
+    std::unique_ptr<TxJsonCache> txJsonCache_;
+    std::unique_ptr<RPC::ResponseCache> rpcResponseCache_;
     RCLValidations mValidations;
     std::unique_ptr<LoadManager> m_loadManager;
     std::unique_ptr<TxQ> txQ_;
     ClosureCounter<void, boost::system::error_code const&> waitHandlerCounter_;
     boost::asio::steady_timer sweepTimer_;
     boost::asio::steady_timer entropyTimer_;
+    TimeoutWheel timeoutWheel_;
 
     std::unique_ptr<RelationalDatabase> mRelationalDatabase;
     std::unique_ptr<DatabaseCon> mWalletDB;
@@ -239,12 +259,29 @@ public:
     std::unique_ptr<ResolverAsio> m_resolver;
 
     io_latency_sampler m_io_latency_sampler;
+    std::optional<io_latency_sampler> overlayLatencySampler_;
+    std::optional<io_latency_sampler> serverLatencySampler_;
 
     std::unique_ptr<GRPCServer> grpcServer_;
     std::unique_ptr<ReportingETL> reportingETL_;
 
     //--------------------------------------------------------------------------
 
+    static BasicApp::Setup
+    setup_BasicApp(Config const& config)
+    {
+        BasicApp::Setup setup;
+        setup.threads = numberOfThreads(config);
+        setup.cpus = config.IO_AFFINITY;
+#if !RIPPLE_SINGLE_IO_SERVICE_THREAD
+        setup.overlayThreads = config.OVERLAY_IO_WORKERS;
+        setup.serverThreads = config.SERVER_IO_WORKERS;
+#endif
+        setup.overlayCpus = config.OVERLAY_IO_AFFINITY;
+        setup.serverCpus = config.SERVER_IO_AFFINITY;
+        return setup;
+    }
+
     static std::size_t
     numberOfThreads(Config const& config)
     {
@@ -273,7 +310,7 @@ public:
         std::unique_ptr<Config> config,
         std::unique_ptr<Logs> logs,
         std::unique_ptr<TimeKeeper> timeKeeper)
-        : BasicApp(numberOfThreads(*config))
+        : BasicApp(setup_BasicApp(*config))
         , config_(std::move(config))
         , logs_(std::move(logs))
         , timeKeeper_(std::move(timeKeeper))
@@ -326,7 +363,8 @@ public:
               m_collectorManager->group("jobq"),
               logs_->journal("JobQueue"),
               *logs_,
-              *perfLog_))
+              *perfLog_,
+              config_->NUMA_SPREAD))
 
         , m_nodeStoreScheduler(*m_jobQueue)
 
@@ -353,7 +391,8 @@ public:
 
         , m_resourceManager(Resource::make_Manager(
               m_collectorManager->collector(),
-              logs_->journal("Resource")))
+              logs_->journal("Resource"),
+              config_->CHARGE_MEASURED_COST))
 
         , m_nodeStore(m_shaMapStore->makeNodeStore(
               config_->PREFETCH_WORKERS > 0 ? config_->PREFETCH_WORKERS : 4))
@@ -410,6 +449,14 @@ public:
               stopwatch(),
               logs_->journal("TaggedCache"))
 
+        , obligationsIndex_(std::make_unique<ObligationsIndex>(
+              config_->section(SECTION_OBLIGATIONS_INDEX),
+              logs_->journal("ObligationsIndex")))
+
+        , cacheBudget_(
+              megabytes(config_->CACHE_BUDGET.value_or(0)),
+              logs_->journal("CacheBudget"))
+
         , m_networkOPs(make_NetworkOPs(
               *this,
               stopwatch(),
@@ -446,7 +493,8 @@ public:
 
         , serverHandler_(make_ServerHandler(
               *this,
-              get_io_service(),
+              get_server_io_service(),
+              get_overlay_io_service(),
               *m_jobQueue,
               *m_networkOPs,
               *m_resourceManager,
@@ -459,6 +507,20 @@ public:
               stopwatch(),
               HashRouter::getDefaultHoldTime()))
 
+        , preflightCache_(std::make_unique<PreflightCache>(
+              stopwatch(),
+              PreflightCache::defaultSize,
+              PreflightCache::defaultAge))
+
+        , txJsonCache_(std::make_unique<TxJsonCache>(
+              stopwatch(),
+              TxJsonCache::defaultSize,
+              TxJsonCache::defaultAge))
+
+        , rpcResponseCache_(std::make_unique<RPC::ResponseCache>(
+              config_->section(SECTION_RPC_RESPONSE_CACHE).values(),
+              logs_->journal("RPC")))
+
         , mValidations(
               ValidationParms(),
               stopwatch(),
@@ -474,6 +536,8 @@ public:
 
         , entropyTimer_(get_io_service())
 
+        , timeoutWheel_(get_io_service())
+
         , m_signals(get_io_service())
 
         , checkSigs_(true)
@@ -491,10 +555,38 @@ public:
               config_->reporting() ? std::make_unique<ReportingETL>(*this)
                                    : nullptr)
     {
+        hugePages::setMode(config_->HUGE_PAGES);
         initAccountIdCache(config_->getValueFor(SizedItem::accountIdCacheSize));
 
+        // Each separate pool samples its own latency.
+        if (hasOverlayPool())
+            overlayLatencySampler_.emplace(
+                m_collectorManager->collector()->make_event(
+                    "overlay_ios_latency"),
+                logs_->journal("Application"),
+                std::chrono::milliseconds(100),
+                get_overlay_io_service());
+        if (hasServerPool())
+            serverLatencySampler_.emplace(
+                m_collectorManager->collector()->make_event(
+                    "server_ios_latency"),
+                logs_->journal("Application"),
+                std::chrono::milliseconds(100),
+                get_server_io_service());
+
         add(m_resourceManager.get());
 
+        // The bytes held by each entry are rough estimates, which include
+        // the container overhead and what the cached object points to.
+        cacheBudget_.add(
+            "TreeNodeCache", *nodeFamily_.getTreeNodeCache(0), 512);
+        cacheBudget_.add(
+            "FullBelowCache", *nodeFamily_.getFullBelowCache(0), 16);
+        cacheBudget_.add("CachedSLEs", cachedSLEs_, 512);
+        cacheBudget_.add("TempNodeCache", m_tempNodeCache, 256);
+        cacheBudget_.add("MasterTransaction", m_txMaster.getCache(), 1024);
+        cacheBudget_.add("AcceptedLedger", m_acceptedLedgerCache, 128 * 1024);
+
         //
         // VFALCO - READ THIS!
         //
@@ -628,6 +720,22 @@ public:
         return m_io_latency_sampler.get();
     }
 
+    std::optional<std::chrono::milliseconds>
+    getOverlayIOLatency() override
+    {
+        if (!overlayLatencySampler_)
+            return std::nullopt;
+        return overlayLatencySampler_->get();
+    }
+
+    std::optional<std::chrono::milliseconds>
+    getServerIOLatency() override
+    {
+        if (!serverLatencySampler_)
+            return std::nullopt;
+        return serverLatencySampler_->get();
+    }
+
     LedgerMaster&
     getLedgerMaster() override
     {
@@ -664,6 +772,12 @@ public:
         return m_acceptedLedgerCache;
     }
 
+    ObligationsIndex&
+    getObligationsIndex() override
+    {
+        return *obligationsIndex_;
+    }
+
     void
     gotTXSet(std::shared_ptr<SHAMap> const& set, bool fromAcquire)
     {
@@ -761,6 +875,12 @@ public:
         return shardArchiveHandler_.get();
     }
 
+    RPC::ResponseCache&
+    getRPCResponseCache() override
+    {
+        return *rpcResponseCache_;
+    }
+
     Application::MutexType&
     getMasterMutex() override
     {
@@ -797,6 +917,12 @@ public:
         return cachedSLEs_;
     }
 
+    CacheBudget&
+    getCacheBudget() override
+    {
+        return cacheBudget_;
+    }
+
     AmendmentTable&
     getAmendmentTable() override
     {
@@ -815,6 +941,24 @@ public:
         return *hashRouter_;
     }
 
+    PreflightCache&
+    getPreflightCache() override
+    {
+        return *preflightCache_;
+    }
+
+    TxJsonCache&
+    getTxJsonCache() override
+    {
+        return *txJsonCache_;
+    }
+
+    TimeoutWheel&
+    getTimeoutWheel() override
+    {
+        return timeoutWheel_;
+    }
+
     RCLValidations&
     getValidations() override
     {
@@ -869,6 +1013,12 @@ public:
         return pendingSaves_;
     }
 
+    PendingWrites&
+    pendingWrites() override
+    {
+        return pendingWrites_;
+    }
+
     OpenLedger&
     openLedger() override
     {
@@ -1068,11 +1218,23 @@ public:
             signalStop();
         }
 
+        // Adjust the target sizes first, so this sweep enforces them.
+        cacheBudget_.rebalance();
+
         // VFALCO NOTE Does the order of calls matter?
         // VFALCO TODO fix the dependency inversion using an observer,
         //         have listeners register for "onSweep ()" notification.
 
-        {
+        // The largest caches are swept by jobs of their own, which run
+        // concurrently with each other and with the rest of this sweep. The
+        // sweep timer is set again once the last of them has finished.
+        auto const done =
+            std::shared_ptr<void>(nullptr, [this](void*) { setSweepTimer(); });
+        auto const sweepJob = [this, &done](char const* name, auto sweep) {
+            m_jobQueue->addJob(jtSWEEP, name, [done, sweep]() { sweep(); });
+        };
+
+        sweepJob("sweepNodeFamily", [this]() {
             std::shared_ptr<FullBelowCache const> const fullBelowCache =
                 nodeFamily_.getFullBelowCache(0);
 
@@ -1092,7 +1254,50 @@ public:
             JLOG(m_journal.debug())
                 << "NodeFamily::TreeNodeCache sweep.  Size before: "
                 << oldTreeNodeSize << "; size after: " << treeNodeCache->size();
-        }
+        });
+        sweepJob("sweepMasterTransaction", [this]() {
+            TaggedCache<uint256, Transaction> const& masterTxCache =
+                getMasterTransaction().getCache();
+
+            std::size_t const oldMasterTxSize = masterTxCache.size();
+
+            getMasterTransaction().sweep();
+
+            JLOG(m_journal.debug())
+                << "MasterTransaction sweep.  Size before: " << oldMasterTxSize
+                << "; size after: " << masterTxCache.size();
+        });
+        sweepJob("sweepTempNodeCache", [this]() {
+            // NodeCache == TaggedCache<SHAMapHash, Blob>
+            std::size_t const oldTempNodeCacheSize = getTempNodeCache().size();
+
+            getTempNodeCache().sweep();
+
+            JLOG(m_journal.debug())
+                << "TempNodeCache sweep.  Size before: " << oldTempNodeCacheSize
+                << "; size after: " << getTempNodeCache().size();
+        });
+        sweepJob("sweepAcceptedLedger", [this]() {
+            std::size_t const oldAcceptedLedgerSize =
+                m_acceptedLedgerCache.size();
+
+            m_acceptedLedgerCache.sweep();
+
+            JLOG(m_journal.debug())
+                << "AcceptedLedgerCache sweep.  Size before: "
+                << oldAcceptedLedgerSize
+                << "; size after: " << m_acceptedLedgerCache.size();
+        });
+        sweepJob("sweepCachedSLEs", [this]() {
+            std::size_t const oldCachedSLEsSize = cachedSLEs_.size();
+
+            cachedSLEs_.sweep();
+
+            JLOG(m_journal.debug())
+                << "CachedSLEs sweep.  Size before: " << oldCachedSLEsSize
+                << "; size after: " << cachedSLEs_.size();
+        });
+
         if (shardFamily_)
         {
             std::size_t const oldFullBelowSize =
@@ -1113,16 +1318,13 @@ public:
                 << shardFamily_->getTreeNodeCacheSize().second;
         }
         {
-            TaggedCache<uint256, Transaction> const& masterTxCache =
-                getMasterTransaction().getCache();
-
-            std::size_t const oldMasterTxSize = masterTxCache.size();
-
-            getMasterTransaction().sweep();
-
-            JLOG(m_journal.debug())
-                << "MasterTransaction sweep.  Size before: " << oldMasterTxSize
-                << "; size after: " << masterTxCache.size();
+            getHashRouter().sweep();
+        }
+        {
+            getPreflightCache().sweep();
+        }
+        {
+            getTxJsonCache().sweep();
         }
         {
             // Does not appear to have an associated cache.
@@ -1144,16 +1346,6 @@ public:
                 << oldLedgerMasterCacheSize << "; size after: "
                 << getLedgerMaster().getFetchPackCacheSize();
         }
-        {
-            // NodeCache == TaggedCache<SHAMapHash, Blob>
-            std::size_t const oldTempNodeCacheSize = getTempNodeCache().size();
-
-            getTempNodeCache().sweep();
-
-            JLOG(m_journal.debug())
-                << "TempNodeCache sweep.  Size before: " << oldTempNodeCacheSize
-                << "; size after: " << getTempNodeCache().size();
-        }
         {
             std::size_t const oldCurrentCacheSize =
                 getValidations().sizeOfCurrentCache();
@@ -1218,34 +1410,13 @@ public:
                 << oldSkipListsSize
                 << "; size after: " << getLedgerReplayer().skipListsSize();
         }
-        {
-            std::size_t const oldAcceptedLedgerSize =
-                m_acceptedLedgerCache.size();
-
-            m_acceptedLedgerCache.sweep();
-
-            JLOG(m_journal.debug())
-                << "AcceptedLedgerCache sweep.  Size before: "
-                << oldAcceptedLedgerSize
-                << "; size after: " << m_acceptedLedgerCache.size();
-        }
-        {
-            std::size_t const oldCachedSLEsSize = cachedSLEs_.size();
-
-            cachedSLEs_.sweep();
-
-            JLOG(m_journal.debug())
-                << "CachedSLEs sweep.  Size before: " << oldCachedSLEsSize
-                << "; size after: " << cachedSLEs_.size();
-        }
 
 #ifdef RIPPLED_REPORTING
         if (auto pg = dynamic_cast<PostgresDatabase*>(&*mRelationalDatabase))
             pg->sweep();
 #endif
 
-        // Set timer to do another sweep later.
-        setSweepTimer();
+        // The sweep timer is set once the sweep jobs have finished.
     }
 
     LedgerIndex
@@ -1276,6 +1447,14 @@ private:
 
     void
     setMaxDisallowedLedger();
+
+    // Where the keys of the node family's caches are saved between runs
+    boost::filesystem::path
+    cacheSnapshotFile() const
+    {
+        return boost::filesystem::path(config_->legacy("database_path")) /
+            "shamap_cache.snapshot";
+    }
 };
 
 //------------------------------------------------------------------------------
@@ -1385,6 +1564,9 @@ ApplicationImp::setup(boost::program_options::variables_map const& cmdline)
 
     Pathfinder::initPathTable();
 
+    if (config_->CACHE_SNAPSHOT && !config_->reporting())
+        nodeFamily_.loadCaches(cacheSnapshotFile());
+
     auto const startUp = config_->START_UP;
     JLOG(m_journal.debug()) << "startUp: " << startUp;
     if (!config_->reporting())
@@ -1525,7 +1707,7 @@ ApplicationImp::setup(boost::program_options::variables_map const& cmdline)
             *serverHandler_,
             *m_resourceManager,
             *m_resolver,
-            get_io_service(),
+            get_overlay_io_service(),
             *config_,
             m_collectorManager->collector());
         add(*overlay_);  // add to PropertyStream
@@ -1705,6 +1887,10 @@ ApplicationImp::start(bool withTimers)
     }
 
     m_io_latency_sampler.start();
+    if (overlayLatencySampler_)
+        overlayLatencySampler_->start();
+    if (serverLatencySampler_)
+        serverLatencySampler_->start();
     m_resolver->start();
     m_loadManager->start();
     m_shaMapStore->start();
@@ -1712,6 +1898,13 @@ ApplicationImp::start(bool withTimers)
         overlay_->start();
     grpcServer_->start();
     ledgerCleaner_->start();
+    if (deferredVerify_)
+    {
+        Json::Value params(Json::objectValue);
+        params[jss::ledger] = *deferredVerify_;
+        params[jss::fix_txns] = false;
+        ledgerCleaner_->clean(params);
+    }
     perfLog_->start();
 }
 
@@ -1735,6 +1928,10 @@ ApplicationImp::run()
     JLOG(m_journal.debug()) << "Application stopping";
 
     m_io_latency_sampler.cancel_async();
+    if (overlayLatencySampler_)
+        overlayLatencySampler_->cancel_async();
+    if (serverLatencySampler_)
+        serverLatencySampler_->cancel_async();
 
     // VFALCO Enormous hack, we have to force the probe to cancel
     //        before we stop the io_service queue or else it never
@@ -1743,6 +1940,10 @@ ApplicationImp::run()
     //        naturally return from io_service::run() instead of
     //        forcing a call to io_service::stop()
     m_io_latency_sampler.cancel();
+    if (overlayLatencySampler_)
+        overlayLatencySampler_->cancel();
+    if (serverLatencySampler_)
+        serverLatencySampler_->cancel();
 
     m_resolver->stop_async();
 
@@ -1767,6 +1968,8 @@ ApplicationImp::run()
             JLOG(m_journal.error())
                 << "Application: entropyTimer cancel error: " << ec.message();
         }
+
+        timeoutWheel_.stop();
     }
 
     // Make sure that any waitHandlers pending in our timers are done
@@ -1812,6 +2015,8 @@ ApplicationImp::run()
         reportingETL_->stop();
     if (auto pg = dynamic_cast<PostgresDatabase*>(&*mRelationalDatabase))
         pg->stop();
+    if (config_->CACHE_SNAPSHOT && !config_->reporting())
+        nodeFamily_.saveCaches(cacheSnapshotFile());
     m_nodeStore->stop();
     perfLog_->stop();
 
@@ -1944,6 +2149,91 @@ ApplicationImp::getLastFullLedger()
     }
 }
 
+namespace {
+
+// Converts one entry of a ledger file's accountState into a state map item.
+// An entry is either a ledger object in JSON, with its key in "index", or
+// a "hash" and "tx_blob" pair as returned by the ledger method with
+// "binary": true. Returns nullptr if the entry is invalid.
+boost::intrusive_ptr<SHAMapItem const>
+makeStateItem(Json::Value& entry)
+{
+    if (!entry.isObject())
+        return nullptr;
+
+    uint256 key;
+
+    if (entry.isMember(jss::tx_blob))
+    {
+        auto const blob = strUnHex(entry[jss::tx_blob].asString());
+        if (!blob || !key.parseHex(entry[jss::hash].asString()) ||
+            key.isZero())
+            return nullptr;
+
+        // Throws if the entry is malformed
+        SerialIter sit(makeSlice(*blob));
+        STLedgerEntry const sle(sit, key);
+        return make_shamapitem(key, makeSlice(*blob));
+    }
+
+    if (!key.parseHex(entry[jss::index].asString()) || key.isZero())
+        return nullptr;
+
+    entry.removeMember(jss::index);
+
+    STParsedJSONObject stp("sle", entry);
+    if (!stp.object)
+        return nullptr;
+
+    // VFALCO TODO This is the only place that
+    //             constructor is used, try to remove it
+    STLedgerEntry const sle(*stp.object, key);
+    auto const s = sle.getSerializer();
+    return make_shamapitem(key, s.slice());
+}
+
+// Converts the entries of a ledger file's accountState, dividing them
+// between jobs since parsing dominates the time taken to load a large
+// ledger. The items are returned sorted by key, with nullptr in place of
+// any invalid entry.
+std::vector<boost::intrusive_ptr<SHAMapItem const>>
+makeStateItems(JobQueue& jobQueue, Json::Value& entries)
+{
+    std::vector<Json::Value*> pending;
+    pending.reserve(entries.size());
+    for (auto& entry : entries)
+        pending.push_back(&entry);
+
+    std::vector<boost::intrusive_ptr<SHAMapItem const>> items(pending.size());
+
+    // Small ledgers aren't worth the threads
+    constexpr std::size_t minPerThread = 1024;
+    auto const threadCount = std::clamp<std::size_t>(
+        pending.size() / minPerThread,
+        1,
+        std::max(1u, std::thread::hardware_concurrency()));
+
+    parallelFor(
+        jobQueue,
+        jtADMIN,
+        "makeStateItems",
+        pending.size(),
+        threadCount - 1,
+        [&](std::size_t i) {
+            items[i] = makeStateItem(*pending[i]);
+            return true;
+        });
+
+    std::sort(items.begin(), items.end(), [](auto const& a, auto const& b) {
+        if (!a || !b)
+            return !a && b;
+        return a->key() < b->key();
+    });
+    return items;
+}
+
+}  // namespace
+
 std::shared_ptr<Ledger>
 ApplicationImp::loadLedgerFromFile(std::string const& name)
 {
@@ -1984,6 +2274,24 @@ ApplicationImp::loadLedgerFromFile(std::string const& name)
 
         if (ledger.get().isMember("accountState"))
         {
+            // A ledger saved in binary has its header serialized
+            if (ledger.get().isMember(jss::ledger_data))
+            {
+                auto const data =
+                    strUnHex(ledger.get()[jss::ledger_data].asString());
+                if (!data)
+                {
+                    JLOG(m_journal.fatal()) << "Invalid ledger header";
+                    return nullptr;
+                }
+                auto const info = deserializeHeader(makeSlice(*data));
+                seq = info.seq;
+                closeTime = info.closeTime;
+                closeTimeResolution = info.closeTimeResolution;
+                closeTimeEstimated = !getCloseAgree(info);
+                totalDrops = info.drops.drops();
+            }
+
             if (ledger.get().isMember(jss::ledger_index))
             {
                 seq = ledger.get()[jss::ledger_index].asUInt();
@@ -2025,44 +2333,31 @@ ApplicationImp::loadLedgerFromFile(std::string const& name)
             std::make_shared<Ledger>(seq, closeTime, *config_, nodeFamily_);
         loadLedger->setTotalDrops(totalDrops);
 
-        for (Json::UInt index = 0; index < ledger.get().size(); ++index)
-        {
-            Json::Value& entry = ledger.get()[index];
-
-            if (!entry.isObjectOrNull())
-            {
-                JLOG(m_journal.fatal()) << "Invalid entry in ledger";
-                return nullptr;
-            }
-
-            uint256 uIndex;
+        auto const items = makeStateItems(getJobQueue(), ledger.get());
 
-            if (!uIndex.parseHex(entry[jss::index].asString()))
-            {
-                JLOG(m_journal.fatal()) << "Invalid entry in ledger";
-                return nullptr;
-            }
-
-            entry.removeMember(jss::index);
-
-            STParsedJSONObject stp("sle", ledger.get()[index]);
-
-            if (!stp.object || uIndex.isZero())
-            {
-                JLOG(m_journal.fatal()) << "Invalid entry in ledger";
-                return nullptr;
-            }
+        // Invalid entries sort first
+        if (!items.empty() && !items.front())
+        {
+            JLOG(m_journal.fatal()) << "Invalid entry in ledger";
+            return nullptr;
+        }
 
-            // VFALCO TODO This is the only place that
-            //             constructor is used, try to remove it
-            STLedgerEntry sle(*stp.object, uIndex);
+        auto const duplicate = std::adjacent_find(
+            items.begin(), items.end(), [](auto const& a, auto const& b) {
+                return a->key() == b->key();
+            });
+        if (duplicate != items.end())
+        {
+            JLOG(m_journal.fatal())
+                << "Couldn't add serialized ledger: " << (*duplicate)->key();
+            return nullptr;
+        }
 
-            if (!loadLedger->addSLE(sle))
-            {
-                JLOG(m_journal.fatal())
-                    << "Couldn't add serialized ledger: " << uIndex;
-                return nullptr;
-            }
+        if (!loadLedger->stateMap().addSortedItems(
+                SHAMapNodeType::tnACCOUNT_STATE, items))
+        {
+            JLOG(m_journal.fatal()) << "Couldn't add serialized ledger";
+            return nullptr;
         }
 
         loadLedger->stateMap().flushDirty(hotACCOUNT_NODE);
@@ -2199,7 +2494,16 @@ ApplicationImp::loadOldLedger(
             return false;
         }
 
-        if (!loadLedger->walkLedger(journal("Ledger"), true))
+        if (config_->LAZY_LOAD && !replay)
+        {
+            // Trust the stored header and roots; the remaining nodes are
+            // fetched on demand and verified by the ledger cleaner.
+            JLOG(m_journal.info()) << "Deferring verification of ledger "
+                                   << loadLedger->info().seq;
+            deferredVerify_ = loadLedger->info().seq;
+        }
+        else if (!loadLedger->walkLedger(
+                     journal("Ledger"), true, config_->VERIFY_WORKERS))
         {
             JLOG(m_journal.fatal()) << "Ledger is missing nodes.";
             assert(false);
@@ -31,6 +31,7 @@
 #include <boost/program_options.hpp>
 #include <memory>
 #include <mutex>
+#include <optional>
 
 namespace ripple {
 
@@ -48,6 +49,7 @@ namespace perf {
 class PerfLog;
 }
 namespace RPC {
+class ResponseCache;
 class ShardArchiveHandler;
 }
 
@@ -64,8 +66,9 @@ template <
 class TaggedCache;
 class STLedgerEntry;
 using SLE = STLedgerEntry;
-using CachedSLEs = TaggedCache<uint256, SLE const>;
+using CachedSLEs = TaggedCache<uint256, SLE const, false, digest_hash>;
 
+class CacheBudget;
 class CollectorManager;
 class Family;
 class HashRouter;
@@ -83,11 +86,16 @@ class LoadManager;
 class ManifestCache;
 class ValidatorKeys;
 class NetworkOPs;
+class ObligationsIndex;
 class OpenLedger;
 class OrderBookDB;
 class Overlay;
 class PathRequests;
+class PreflightCache;
+class TxJsonCache;
+class TimeoutWheel;
 class PendingSaves;
+class PendingWrites;
 class PublicKey;
 class ServerHandler;
 class SecretKey;
@@ -182,10 +190,18 @@ public:
     getTempNodeCache() = 0;
     virtual CachedSLEs&
     cachedSLEs() = 0;
+    virtual CacheBudget&
+    getCacheBudget() = 0;
     virtual AmendmentTable&
     getAmendmentTable() = 0;
     virtual HashRouter&
     getHashRouter() = 0;
+    virtual PreflightCache&
+    getPreflightCache() = 0;
+    virtual TxJsonCache&
+    getTxJsonCache() = 0;
+    virtual TimeoutWheel&
+    getTimeoutWheel() = 0;
     virtual LoadFeeTrack&
     getFeeTrack() = 0;
     virtual LoadManager&
@@ -214,6 +230,8 @@ public:
     getShardStore() = 0;
     virtual RPC::ShardArchiveHandler*
     getShardArchiveHandler(bool tryRecovery = false) = 0;
+    virtual RPC::ResponseCache&
+    getRPCResponseCache() = 0;
     virtual InboundLedgers&
     getInboundLedgers() = 0;
     virtual InboundTransactions&
@@ -221,6 +239,8 @@ public:
 
     virtual TaggedCache<uint256, AcceptedLedger>&
     getAcceptedLedgerCache() = 0;
+    virtual ObligationsIndex&
+    getObligationsIndex() = 0;
 
     virtual LedgerMaster&
     getLedgerMaster() = 0;
@@ -253,6 +273,8 @@ public:
     getSHAMapStore() = 0;
     virtual PendingSaves&
     pendingSaves() = 0;
+    virtual PendingWrites&
+    pendingWrites() = 0;
     virtual OpenLedger&
     openLedger() = 0;
     virtual OpenLedger const&
@@ -263,6 +285,13 @@ public:
     virtual std::chrono::milliseconds
     getIOLatency() = 0;
 
+    /** The latency of the io_service pools for peer and for client
+        connections, if they are separate from the main one. */
+    virtual std::optional<std::chrono::milliseconds>
+    getOverlayIOLatency() = 0;
+    virtual std::optional<std::chrono::milliseconds>
+    getServerIOLatency() = 0;
+
     virtual ReportingETL&
     getReportingETL() = 0;
 
@@ -18,27 +18,41 @@
 //==============================================================================
 
 #include <ripple/app/main/BasicApp.h>
+#include <ripple/basics/Numa.h>
 #include <ripple/beast/core/CurrentThreadName.h>
 
-BasicApp::BasicApp(std::size_t numberOfThreads)
+IOPool::IOPool(
+    std::string const& name,
+    std::size_t numberOfThreads,
+    std::vector<unsigned> const& cpus)
 {
     work_.emplace(io_service_);
     threads_.reserve(numberOfThreads);
 
     while (numberOfThreads--)
     {
-        threads_.emplace_back([this, numberOfThreads]() {
+        threads_.emplace_back([this, name, numberOfThreads]() {
             beast::setCurrentThreadName(
-                "io svc #" + std::to_string(numberOfThreads));
+                name + " #" + std::to_string(numberOfThreads));
             this->io_service_.run();
         });
+        ripple::numa::pin(threads_.back(), cpus);
     }
 }
 
-BasicApp::~BasicApp()
+IOPool::~IOPool()
 {
     work_.reset();
 
     for (auto& t : threads_)
         t.join();
 }
+
+BasicApp::BasicApp(Setup const& setup)
+    : main_("io svc", setup.threads, setup.cpus)
+{
+    if (setup.overlayThreads != 0)
+        overlay_.emplace("overlay io", setup.overlayThreads, setup.overlayCpus);
+    if (setup.serverThreads != 0)
+        server_.emplace("server io", setup.serverThreads, setup.serverCpus);
+}
@@ -22,11 +22,12 @@
 
 #include <boost/asio/io_service.hpp>
 #include <optional>
+#include <string>
 #include <thread>
 #include <vector>
 
-// This is so that the io_service can outlive all the children
-class BasicApp
+/** Threads running an io_service. */
+class IOPool
 {
 private:
     std::optional<boost::asio::io_service::work> work_;
@@ -34,8 +35,23 @@ private:
     boost::asio::io_service io_service_;
 
 public:
-    BasicApp(std::size_t numberOfThreads);
-    ~BasicApp();
+    /** Start the threads.
+
+        @param name The threads are named after it.
+        @param numberOfThreads The number of threads.
+        @param cpus If not empty, the CPUs the threads may run on. This is
+                    only supported on Linux.
+    */
+    IOPool(
+        std::string const& name,
+        std::size_t numberOfThreads,
+        std::vector<unsigned> const& cpus = {});
+
+    IOPool(IOPool const&) = delete;
+    IOPool&
+    operator=(IOPool const&) = delete;
+
+    ~IOPool();
 
     boost::asio::io_service&
     get_io_service()
@@ -44,4 +60,63 @@ public:
     }
 };
 
+// This is so that the io_service can outlive all the children
+class BasicApp
+{
+public:
+    struct Setup
+    {
+        std::size_t threads = 1;
+        std::vector<unsigned> cpus;
+
+        // Zero threads share the main io_service
+        std::size_t overlayThreads = 0;
+        std::vector<unsigned> overlayCpus;
+        std::size_t serverThreads = 0;
+        std::vector<unsigned> serverCpus;
+    };
+
+private:
+    // Declared first, so it is stopped last
+    IOPool main_;
+    std::optional<IOPool> overlay_;
+    std::optional<IOPool> server_;
+
+public:
+    explicit BasicApp(Setup const& setup);
+
+    /** The io_service for timers and internal work. */
+    boost::asio::io_service&
+    get_io_service()
+    {
+        return main_.get_io_service();
+    }
+
+    /** The io_service for peer connections. */
+    boost::asio::io_service&
+    get_overlay_io_service()
+    {
+        return overlay_ ? overlay_->get_io_service() : get_io_service();
+    }
+
+    /** The io_service for client connections. */
+    boost::asio::io_service&
+    get_server_io_service()
+    {
+        return server_ ? server_->get_io_service() : get_io_service();
+    }
+
+    bool
+    hasOverlayPool() const
+    {
+        return overlay_.has_value();
+    }
+
+    bool
+    hasServerPool() const
+    {
+        return server_.has_value();
+    }
+};
+
 #endif
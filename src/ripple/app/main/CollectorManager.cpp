@@ -43,6 +43,15 @@ public:
             m_collector =
                 beast::insight::StatsDCollector::New(address, prefix, journal);
         }
+        else if (server == "prometheus")
+        {
+            beast::IP::Endpoint const address(
+                beast::IP::Endpoint::from_string(get(params, "address")));
+            std::string const& prefix(get(params, "prefix"));
+
+            m_collector = beast::insight::PrometheusCollector::New(
+                address, prefix, journal);
+        }
         else
         {
             m_collector = beast::insight::NullCollector::New();
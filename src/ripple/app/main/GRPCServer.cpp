@@ -67,7 +67,8 @@ GRPCServerImpl::CallData<Request, Response>::CallData(
     Forward<Request, Response> forward,
     RPC::Condition requiredCondition,
     Resource::Charge loadType,
-    std::vector<boost::asio::ip::address> const& secureGatewayIPs)
+    std::vector<boost::asio::ip::address> const& secureGatewayIPs,
+    ConcurrencyLimit& limit)
     : service_(service)
     , cq_(cq)
     , finished_(false)
@@ -79,6 +80,7 @@ GRPCServerImpl::CallData<Request, Response>::CallData(
     , requiredCondition_(std::move(requiredCondition))
     , loadType_(std::move(loadType))
     , secureGatewayIPs_(secureGatewayIPs)
+    , limit_(limit)
 {
     // Bind a listener. When a request is received, "this" will be returned
     // from CompletionQueue::Next
@@ -98,7 +100,8 @@ GRPCServerImpl::CallData<Request, Response>::clone()
         forward_,
         requiredCondition_,
         loadType_,
-        secureGatewayIPs_);
+        secureGatewayIPs_,
+        limit_);
 }
 
 template <class Request, class Response>
@@ -120,16 +123,27 @@ GRPCServerImpl::CallData<Request, Response>::process()
     // ensures that finished is always true when this CallData object
     // is returned as a tag in handleRpcs(), after sending the response
     finished_ = true;
-    auto coro = app_.getJobQueue().postCoro(
-        JobType::jtRPC,
-        "gRPC-Client",
-        [thisShared](std::shared_ptr<JobQueue::Coro> coro) {
-            thisShared->process(coro);
+
+    if (!limit_.tryAcquire())
+    {
+        grpc::Status status{
+            grpc::StatusCode::RESOURCE_EXHAUSTED,
+            "too many concurrent requests of this type"};
+        responder_.FinishWithError(status, this);
+        return;
+    }
+
+    // No gRPC handler suspends, so none needs a coroutine
+    auto const posted = app_.getJobQueue().addJob(
+        JobType::jtRPC, "gRPC-Client", [thisShared]() {
+            thisShared->process({});
+            thisShared->limit_.release();
         });
 
-    // If coro is null, then the JobQueue has already been shutdown
-    if (!coro)
+    // If the job was not added, then the JobQueue has already been shutdown
+    if (!posted)
     {
+        limit_.release();
         grpc::Status status{
             grpc::StatusCode::INTERNAL, "Job Queue is already stopped"};
         responder_.FinishWithError(status, this);
@@ -424,14 +438,62 @@ GRPCServerImpl::CallData<Request, Response>::getUsage()
     Throw<std::runtime_error>("Failed to get client endpoint");
 }
 
+bool
+GRPCServerImpl::ConcurrencyLimit::tryAcquire()
+{
+    if (max_ == 0)
+    {
+        ++active_;
+        return true;
+    }
+
+    auto active = active_.load();
+    do
+    {
+        if (active >= max_)
+            return false;
+    } while (!active_.compare_exchange_weak(active, active + 1));
+    return true;
+}
+
 GRPCServerImpl::GRPCServerImpl(Application& app)
     : app_(app), journal_(app_.journal("gRPC Server"))
 {
+    for (auto const name :
+         {"GetLedger",
+          "GetLedgerData",
+          "GetLedgerDiff",
+          "GetLedgerEntry",
+          "GetAccountInfo",
+          "GetAccountTransactionHistory",
+          "GetBookOffers"})
+        limits_.try_emplace(name);
+
     // if present, get endpoint from config
     if (app_.config().exists(SECTION_PORT_GRPC))
     {
         Section const& section = app_.config().section(SECTION_PORT_GRPC);
 
+        try
+        {
+            numThreads_ = std::max<std::size_t>(
+                section.value_or<std::size_t>("threads", 1), 1);
+
+            auto const defaultLimit =
+                section.value_or<std::uint32_t>("concurrency_limit", 0);
+            for (auto& [name, limit] : limits_)
+                limit.setMax(section.value_or<std::uint32_t>(
+                    "concurrency_limit_" + name, defaultLimit));
+        }
+        catch (std::exception const&)
+        {
+            JLOG(journal_.error())
+                << "Error parsing threads or concurrency limits for grpc "
+                   "server";
+            Throw<std::runtime_error>(
+                "Error parsing threads or concurrency_limit in port_grpc");
+        }
+
         auto const optIp = section.get("ip");
         if (!optIp)
             return;
@@ -499,25 +561,29 @@ GRPCServerImpl::shutdown()
     // requests being processed are completed. CallData objects in the midst of
     // processing requests need to actually send data back to the client, via
     // responder_.Finish(...) or responder_.FinishWithError(...), for this call
-    // to unblock. Each cancelled listener is returned via cq_.Next(...) with ok
+    // to unblock. Each cancelled listener is returned via cq.Next(...) with ok
     // set to false
     server_->Shutdown();
     JLOG(journal_.debug()) << "Server has been shutdown";
 
-    // Always shutdown the completion queue after the server. This call allows
-    // cq_.Next() to return false, once all events posted to the completion
+    // Always shutdown the completion queues after the server. This call allows
+    // cq.Next() to return false, once all events posted to the completion
     // queue have been processed. See handleRpcs() for more details.
-    cq_->Shutdown();
-    JLOG(journal_.debug()) << "Completion Queue has been shutdown";
+    for (auto& cq : cqs_)
+        cq->Shutdown();
+    JLOG(journal_.debug()) << "Completion Queues have been shutdown";
 }
 
 void
-GRPCServerImpl::handleRpcs()
+GRPCServerImpl::handleRpcs(std::size_t i)
 {
+    auto& cq = *cqs_.at(i);
+
     // This collection should really be an unordered_set. However, to delete
-    // from the unordered_set, we need a shared_ptr, but cq_.Next() (see below
-    // while loop) sets the tag to a raw pointer.
-    std::vector<std::shared_ptr<Processor>> requests = setupListeners();
+    // from the unordered_set, we need a shared_ptr, but cq.Next() (see below
+    // while loop) sets the tag to a raw pointer. Each queue has its own
+    // listeners, and only this thread touches them.
+    std::vector<std::shared_ptr<Processor>> requests = setupListeners(cq);
 
     auto erase = [&requests](Processor* ptr) {
         auto it = std::find_if(
@@ -537,17 +603,17 @@ GRPCServerImpl::handleRpcs()
     // event is uniquely identified by its tag, which in this case is the
     // memory address of a CallData instance.
     // The return value of Next should always be checked. This return value
-    // tells us whether there is any kind of event or cq_ is shutting down.
-    // When cq_.Next(...) returns false, all work has been completed and the
+    // tells us whether there is any kind of event or cq is shutting down.
+    // When cq.Next(...) returns false, all work has been completed and the
     // loop can exit. When the server is shutdown, each CallData object that is
     // listening for a request is forceably cancelled, and is returned by
-    // cq_->Next() with ok set to false. Then, each CallData object processing
+    // cq.Next() with ok set to false. Then, each CallData object processing
     // a request must complete (by sending data to the client), each of which
-    // will be returned from cq_->Next() with ok set to true. After all
+    // will be returned from cq.Next() with ok set to true. After all
     // cancelled listeners and all CallData objects processing requests are
-    // returned via cq_->Next(), cq_->Next() will return false, causing the
+    // returned via cq.Next(), cq.Next() will return false, causing the
     // loop to exit.
-    while (cq_->Next(&tag, &ok))
+    while (cq.Next(&tag, &ok))
     {
         auto ptr = static_cast<Processor*>(tag);
         JLOG(journal_.trace()) << "Processing CallData object."
@@ -583,7 +649,7 @@ GRPCServerImpl::handleRpcs()
 
 // create a CallData instance for each RPC
 std::vector<std::shared_ptr<Processor>>
-GRPCServerImpl::setupListeners()
+GRPCServerImpl::setupListeners(grpc::ServerCompletionQueue& cq)
 {
     std::vector<std::shared_ptr<Processor>> requests;
 
@@ -598,7 +664,7 @@ GRPCServerImpl::setupListeners()
 
         addToRequests(std::make_shared<cd>(
             service_,
-            *cq_,
+            cq,
             app_,
             &org::xrpl::rpc::v1::XRPLedgerAPIService::AsyncService::
                 RequestGetLedger,
@@ -606,7 +672,8 @@ GRPCServerImpl::setupListeners()
             &org::xrpl::rpc::v1::XRPLedgerAPIService::Stub::GetLedger,
             RPC::NO_CONDITION,
             Resource::feeMediumBurdenRPC,
-            secureGatewayIPs_));
+            secureGatewayIPs_,
+            limits_.at("GetLedger")));
     }
     {
         using cd = CallData<
@@ -615,7 +682,7 @@ GRPCServerImpl::setupListeners()
 
         addToRequests(std::make_shared<cd>(
             service_,
-            *cq_,
+            cq,
             app_,
             &org::xrpl::rpc::v1::XRPLedgerAPIService::AsyncService::
                 RequestGetLedgerData,
@@ -623,7 +690,8 @@ GRPCServerImpl::setupListeners()
             &org::xrpl::rpc::v1::XRPLedgerAPIService::Stub::GetLedgerData,
             RPC::NO_CONDITION,
             Resource::feeMediumBurdenRPC,
-            secureGatewayIPs_));
+            secureGatewayIPs_,
+            limits_.at("GetLedgerData")));
     }
     {
         using cd = CallData<
@@ -632,7 +700,7 @@ GRPCServerImpl::setupListeners()
 
         addToRequests(std::make_shared<cd>(
             service_,
-            *cq_,
+            cq,
             app_,
             &org::xrpl::rpc::v1::XRPLedgerAPIService::AsyncService::
                 RequestGetLedgerDiff,
@@ -640,7 +708,8 @@ GRPCServerImpl::setupListeners()
             &org::xrpl::rpc::v1::XRPLedgerAPIService::Stub::GetLedgerDiff,
             RPC::NO_CONDITION,
             Resource::feeMediumBurdenRPC,
-            secureGatewayIPs_));
+            secureGatewayIPs_,
+            limits_.at("GetLedgerDiff")));
     }
     {
         using cd = CallData<
@@ -649,7 +718,7 @@ GRPCServerImpl::setupListeners()
 
         addToRequests(std::make_shared<cd>(
             service_,
-            *cq_,
+            cq,
             app_,
             &org::xrpl::rpc::v1::XRPLedgerAPIService::AsyncService::
                 RequestGetLedgerEntry,
@@ -657,7 +726,63 @@ GRPCServerImpl::setupListeners()
             &org::xrpl::rpc::v1::XRPLedgerAPIService::Stub::GetLedgerEntry,
             RPC::NO_CONDITION,
             Resource::feeMediumBurdenRPC,
-            secureGatewayIPs_));
+            secureGatewayIPs_,
+            limits_.at("GetLedgerEntry")));
+    }
+    {
+        using cd = CallData<
+            org::xrpl::rpc::v1::GetAccountInfoRequest,
+            org::xrpl::rpc::v1::GetAccountInfoResponse>;
+
+        addToRequests(std::make_shared<cd>(
+            service_,
+            cq,
+            app_,
+            &org::xrpl::rpc::v1::XRPLedgerAPIService::AsyncService::
+                RequestGetAccountInfo,
+            doAccountInfoGrpc,
+            &org::xrpl::rpc::v1::XRPLedgerAPIService::Stub::GetAccountInfo,
+            RPC::NO_CONDITION,
+            Resource::feeReferenceRPC,
+            secureGatewayIPs_,
+            limits_.at("GetAccountInfo")));
+    }
+    {
+        using cd = CallData<
+            org::xrpl::rpc::v1::GetAccountTransactionHistoryRequest,
+            org::xrpl::rpc::v1::GetAccountTransactionHistoryResponse>;
+
+        addToRequests(std::make_shared<cd>(
+            service_,
+            cq,
+            app_,
+            &org::xrpl::rpc::v1::XRPLedgerAPIService::AsyncService::
+                RequestGetAccountTransactionHistory,
+            doAccountTxGrpc,
+            &org::xrpl::rpc::v1::XRPLedgerAPIService::Stub::
+                GetAccountTransactionHistory,
+            RPC::NO_CONDITION,
+            Resource::feeMediumBurdenRPC,
+            secureGatewayIPs_,
+            limits_.at("GetAccountTransactionHistory")));
+    }
+    {
+        using cd = CallData<
+            org::xrpl::rpc::v1::GetBookOffersRequest,
+            org::xrpl::rpc::v1::GetBookOffersResponse>;
+
+        addToRequests(std::make_shared<cd>(
+            service_,
+            cq,
+            app_,
+            &org::xrpl::rpc::v1::XRPLedgerAPIService::AsyncService::
+                RequestGetBookOffers,
+            doBookOffersGrpc,
+            &org::xrpl::rpc::v1::XRPLedgerAPIService::Stub::GetBookOffers,
+            RPC::NO_CONDITION,
+            Resource::feeMediumBurdenRPC,
+            secureGatewayIPs_,
+            limits_.at("GetBookOffers")));
     }
     return requests;
 }
@@ -677,9 +802,10 @@ GRPCServerImpl::start()
     // Register "service_" as the instance through which we'll communicate with
     // clients. In this case it corresponds to an *asynchronous* service.
     builder.RegisterService(&service_);
-    // Get hold of the completion queue used for the asynchronous communication
-    // with the gRPC runtime.
-    cq_ = builder.AddCompletionQueue();
+    // Get hold of the completion queues used for the asynchronous
+    // communication with the gRPC runtime.
+    for (std::size_t i = 0; i < numThreads_; ++i)
+        cqs_.push_back(builder.AddCompletionQueue());
     // Finally assemble the server.
     server_ = builder.BuildAndStart();
 
@@ -692,12 +818,15 @@ GRPCServer::start()
     // Start the server and setup listeners
     if (running_ = impl_.start(); running_)
     {
-        thread_ = std::thread([this]() {
-            beast::setCurrentThreadName("rippled : GRPCServer");
-            // Start the event loop and begin handling requests
-            beast::setCurrentThreadName("rippled: grpc");
-            this->impl_.handleRpcs();
-        });
+        for (std::size_t i = 0; i < impl_.queueCount(); ++i)
+        {
+            threads_.emplace_back([this, i]() {
+                beast::setCurrentThreadName(
+                    "rippled: grpc #" + std::to_string(i));
+                // Start the event loop and begin handling requests
+                this->impl_.handleRpcs(i);
+            });
+        }
     }
 }
 
@@ -707,7 +836,9 @@ GRPCServer::stop()
     if (running_)
     {
         impl_.shutdown();
-        thread_.join();
+        for (auto& t : threads_)
+            t.join();
+        threads_.clear();
         running_ = false;
     }
 }
@@ -35,6 +35,10 @@
 #include "org/xrpl/rpc/v1/xrp_ledger.grpc.pb.h"
 #include <grpcpp/grpcpp.h>
 
+#include <atomic>
+#include <map>
+#include <thread>
+
 namespace ripple {
 
 // Interface that CallData implements
@@ -70,11 +74,44 @@ public:
 class GRPCServerImpl final
 {
 private:
-    // CompletionQueue returns events that have occurred, or events that have
-    // been cancelled
-    std::unique_ptr<grpc::ServerCompletionQueue> cq_;
+    // Caps the number of requests of one RPC that are processed at once.
+    // Shared by the listeners of that RPC on every completion queue.
+    class ConcurrencyLimit
+    {
+    private:
+        std::atomic<std::uint32_t> active_{0};
 
-    std::vector<std::shared_ptr<Processor>> requests_;
+        // zero means unlimited
+        std::uint32_t max_ = 0;
+
+    public:
+        void
+        setMax(std::uint32_t max)
+        {
+            max_ = max;
+        }
+
+        // true if the request may be processed. Must be paired with
+        // release() once the request has been answered
+        bool
+        tryAcquire();
+
+        void
+        release()
+        {
+            --active_;
+        }
+    };
+
+    // CompletionQueues return events that have occurred, or events that have
+    // been cancelled. Each queue is drained by its own thread.
+    std::vector<std::unique_ptr<grpc::ServerCompletionQueue>> cqs_;
+
+    // Number of completion queues, and so of polling threads
+    std::size_t numThreads_ = 1;
+
+    // Per-RPC concurrency limits, keyed by RPC name (e.g. "GetLedgerData")
+    std::map<std::string, ConcurrencyLimit, std::less<>> limits_;
 
     // The gRPC service defined by the .proto files
     org::xrpl::rpc::v1::XRPLedgerAPIService::AsyncService service_;
@@ -133,13 +170,22 @@ public:
     bool
     start();
 
-    // the main event loop
+    // Number of completion queues. Call handleRpcs() once for each, from its
+    // own thread
+    std::size_t
+    queueCount() const
+    {
+        return cqs_.size();
+    }
+
+    // the main event loop for the completion queue with index i
     void
-    handleRpcs();
+    handleRpcs(std::size_t i);
 
-    // Create a CallData object for each RPC. Return created objects in vector
+    // Create a CallData object for each RPC, listening on cq. Return created
+    // objects in vector
     std::vector<std::shared_ptr<Processor>>
-    setupListeners();
+    setupListeners(grpc::ServerCompletionQueue& cq);
 
 private:
     // Class encompasing the state and logic needed to serve a request.
@@ -193,6 +239,9 @@ private:
 
         std::vector<boost::asio::ip::address> const& secureGatewayIPs_;
 
+        // Concurrency limit for this RPC
+        ConcurrencyLimit& limit_;
+
     public:
         virtual ~CallData() = default;
 
@@ -208,7 +257,8 @@ private:
             Forward<Request, Response> forward,
             RPC::Condition requiredCondition,
             Resource::Charge loadType,
-            std::vector<boost::asio::ip::address> const& secureGatewayIPs);
+            std::vector<boost::asio::ip::address> const& secureGatewayIPs,
+            ConcurrencyLimit& limit);
 
         CallData(const CallData&) = delete;
 
@@ -315,7 +365,7 @@ public:
 
 private:
     GRPCServerImpl impl_;
-    std::thread thread_;
+    std::vector<std::thread> threads_;
     bool running_ = false;
 };
 }  // namespace ripple
@@ -21,12 +21,17 @@
 #include <ripple/app/main/LoadManager.h>
 #include <ripple/app/misc/LoadFeeTrack.h>
 #include <ripple/app/misc/NetworkOPs.h>
+#include <ripple/basics/LatencyHistogram.h>
 #include <ripple/basics/UptimeClock.h>
 #include <ripple/beast/core/CurrentThreadName.h>
+#include <ripple/core/JobQueue.h>
 #include <ripple/json/to_string.h>
+#include <algorithm>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 namespace ripple {
 
@@ -96,6 +101,67 @@ LoadManager::stop()
 
 //------------------------------------------------------------------------------
 
+namespace {
+
+/** Samples the time a subsystem's jobs wait in the job queue. */
+class QueueSampler
+{
+    std::vector<JobType> const types_;
+
+    // The subsystem is overloaded if, over the window, the median wait is
+    // longer than median_ or the 99th percentile or the oldest waiting job
+    // is longer than peak_.
+    std::chrono::microseconds const median_;
+    std::chrono::microseconds const peak_;
+
+    // The wait times counted so far at each of the last samples, oldest
+    // first.
+    std::deque<LatencyHistogram::Counts> history_;
+    std::size_t const window_;
+
+public:
+    QueueSampler(
+        std::vector<JobType> types,
+        std::chrono::microseconds median,
+        std::chrono::microseconds peak,
+        std::size_t window)
+        : types_(std::move(types))
+        , median_(median)
+        , peak_(peak)
+        , window_(window)
+    {
+    }
+
+    bool
+    sample(JobQueue& jobQueue)
+    {
+        LatencyHistogram::Counts counts{};
+        std::chrono::microseconds age{0};
+        for (auto const type : types_)
+        {
+            auto const c = jobQueue.getQueueLatency(type).snapshot();
+            for (std::size_t i = 0; i < counts.size(); ++i)
+                counts[i] += c[i];
+            age = std::max(age, jobQueue.getQueueAge(type));
+        }
+
+        history_.push_back(counts);
+        if (history_.size() > window_ + 1)
+            history_.pop_front();
+
+        // The waits of the jobs which started running during the window
+        auto window = counts;
+        for (std::size_t i = 0; i < window.size(); ++i)
+            window[i] -= history_.front()[i];
+
+        return age > peak_ ||
+            LatencyHistogram::percentile(window, 0.5) > median_ ||
+            LatencyHistogram::percentile(window, 0.99) > peak_;
+    }
+};
+
+}  // namespace
+
 void
 LoadManager::run()
 {
@@ -104,11 +170,59 @@ LoadManager::run()
     using namespace std::chrono_literals;
     using clock_type = std::chrono::steady_clock;
 
+    // Queue waits are sampled every tick, over a window of a second. The
+    // deadlock detector runs once a second, and so does the local fee
+    // unless a subsystem has just become overloaded.
+    constexpr auto tick = 100ms;
+    constexpr std::size_t ticksPerSecond = 1s / tick;
+
+    static std::array<char const*, subsystems> const names{
+        {"RPC", "peer", "consensus"}};
+
+    std::array<QueueSampler, subsystems> samplers{
+        QueueSampler{
+            {jtCLIENT,
+             jtCLIENT_SUBSCRIBE,
+             jtCLIENT_FEE_CHANGE,
+             jtCLIENT_CONSENSUS,
+             jtCLIENT_ACCT_HIST,
+             jtCLIENT_SHARD,
+             jtCLIENT_RPC,
+             jtCLIENT_WEBSOCKET,
+             jtRPC},
+            500ms,
+            2000ms,
+            ticksPerSecond},
+        QueueSampler{
+            {jtVALIDATION_ut,
+             jtMANIFEST,
+             jtREPLAY_REQ,
+             jtLEDGER_REQ,
+             jtPROPOSAL_ut,
+             jtTRANSACTION,
+             jtMISSING_TXN,
+             jtREQUESTED_TXN,
+             jtBATCH},
+            250ms,
+            1000ms,
+            ticksPerSecond},
+        QueueSampler{
+            {jtLEDGER_DATA,
+             jtADVANCE,
+             jtPUBLEDGER,
+             jtTXN_DATA,
+             jtVALIDATION_t,
+             jtACCEPT,
+             jtPROPOSAL_t},
+            100ms,
+            500ms,
+            ticksPerSecond}};
+
     auto t = clock_type::now();
 
-    while (true)
+    for (std::size_t ticks = 1;; ++ticks)
     {
-        t += 1s;
+        t += tick;
 
         std::unique_lock sl(mutex_);
         if (cv_.wait_until(sl, t, [this] { return stop_; }))
@@ -119,75 +233,103 @@ LoadManager::run()
         auto const armed = armed_;
         sl.unlock();
 
-        // Measure the amount of time we have been deadlocked, in seconds.
-        using namespace std::chrono;
-        auto const timeSpentDeadlocked =
-            duration_cast<seconds>(steady_clock::now() - deadLock);
+        bool newlyOverloaded = false;
+        for (std::size_t i = 0; i < subsystems; ++i)
+        {
+            bool const overloaded = samplers[i].sample(app_.getJobQueue());
+            if (overloaded_[i].exchange(overloaded) != overloaded)
+            {
+                JLOG(journal_.info()) << names[i]
+                                      << (overloaded ? " overloaded"
+                                                     : " no longer overloaded");
+                newlyOverloaded = newlyOverloaded || overloaded;
+            }
+        }
+
+        bool const second = ticks % ticksPerSecond == 0;
+        if (!second && !newlyOverloaded)
+            continue;
+
+        if (second)
+            checkDeadlock(deadLock, armed);
+
+        bool change;
+
+        if (app_.getJobQueue().isOverloaded() || isOverloaded(consensus))
+        {
+            JLOG(journal_.info()) << "Raising local fee (JQ overload): "
+                                  << app_.getJobQueue().getJson(0);
+            change = app_.getFeeTrack().raiseLocalFee();
+        }
+        else
+        {
+            change = app_.getFeeTrack().lowerLocalFee();
+        }
+
+        if (change)
+        {
+            // VFALCO TODO replace this with a Listener / observer and
+            // subscribe in NetworkOPs or Application.
+            app_.getOPs().reportFeeChange();
+        }
+    }
+}
+
+void
+LoadManager::checkDeadlock(
+    std::chrono::steady_clock::time_point deadLock,
+    bool armed)
+{
+    using namespace std::chrono_literals;
+
+    // Measure the amount of time we have been deadlocked, in seconds.
+    using namespace std::chrono;
+    auto const timeSpentDeadlocked =
+        duration_cast<seconds>(steady_clock::now() - deadLock);
 
-        constexpr auto reportingIntervalSeconds = 10s;
-        constexpr auto deadlockFatalLogMessageTimeLimit = 90s;
-        constexpr auto deadlockLogicErrorTimeLimit = 600s;
+    constexpr auto reportingIntervalSeconds = 10s;
+    constexpr auto deadlockFatalLogMessageTimeLimit = 90s;
+    constexpr auto deadlockLogicErrorTimeLimit = 600s;
 
-        if (armed && (timeSpentDeadlocked >= reportingIntervalSeconds))
+    if (armed && (timeSpentDeadlocked >= reportingIntervalSeconds))
+    {
+        // Report the deadlocked condition every
+        // reportingIntervalSeconds
+        if ((timeSpentDeadlocked % reportingIntervalSeconds) == 0s)
         {
-            // Report the deadlocked condition every
-            // reportingIntervalSeconds
-            if ((timeSpentDeadlocked % reportingIntervalSeconds) == 0s)
+            if (timeSpentDeadlocked < deadlockFatalLogMessageTimeLimit)
             {
-                if (timeSpentDeadlocked < deadlockFatalLogMessageTimeLimit)
-                {
-                    JLOG(journal_.warn())
-                        << "Server stalled for " << timeSpentDeadlocked.count()
-                        << " seconds.";
-                    if (app_.getJobQueue().isOverloaded())
-                    {
-                        JLOG(journal_.warn()) << app_.getJobQueue().getJson(0);
-                    }
-                }
-                else
+                JLOG(journal_.warn())
+                    << "Server stalled for " << timeSpentDeadlocked.count()
+                    << " seconds.";
+                if (app_.getJobQueue().isOverloaded())
                 {
-                    JLOG(journal_.fatal())
-                        << "Deadlock detected. Deadlocked time: "
-                        << timeSpentDeadlocked.count() << "s";
-                    JLOG(journal_.fatal())
-                        << "JobQueue: " << app_.getJobQueue().getJson(0);
+                    JLOG(journal_.warn()) << app_.getJobQueue().getJson(0);
                 }
             }
-
-            // If we go over the deadlockTimeLimit spent deadlocked, it
-            // means that the deadlock resolution code has failed, which
-            // qualifies as undefined behavior.
-            //
-            if (timeSpentDeadlocked >= deadlockLogicErrorTimeLimit)
+            else
             {
                 JLOG(journal_.fatal())
-                    << "LogicError: Deadlock detected. Deadlocked time: "
+                    << "Deadlock detected. Deadlocked time: "
                     << timeSpentDeadlocked.count() << "s";
                 JLOG(journal_.fatal())
                     << "JobQueue: " << app_.getJobQueue().getJson(0);
-                LogicError("Deadlock detected");
             }
         }
-    }
-
-    bool change;
-
-    if (app_.getJobQueue().isOverloaded())
-    {
-        JLOG(journal_.info()) << "Raising local fee (JQ overload): "
-                              << app_.getJobQueue().getJson(0);
-        change = app_.getFeeTrack().raiseLocalFee();
-    }
-    else
-    {
-        change = app_.getFeeTrack().lowerLocalFee();
-    }
 
-    if (change)
-    {
-        // VFALCO TODO replace this with a Listener / observer and
-        // subscribe in NetworkOPs or Application.
-        app_.getOPs().reportFeeChange();
+        // If we go over the deadlockTimeLimit spent deadlocked, it
+        // means that the deadlock resolution code has failed, which
+        // qualifies as undefined behavior.
+        //
+        if (timeSpentDeadlocked >= deadlockLogicErrorTimeLimit)
+        {
+            JLOG(journal_.fatal())
+                << "LogicError: Deadlock detected. Deadlocked time: "
+                << timeSpentDeadlocked.count() << "s";
+            JLOG(journal_.fatal())
+                << "JobQueue: " << app_.getJobQueue().getJson(0);
+            LogicError("Deadlock detected");
+        }
     }
 }
 
@@ -21,7 +21,9 @@
 #define RIPPLE_APP_MAIN_LOADMANAGER_H_INCLUDED
 
 #include <ripple/beast/utility/Journal.h>
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
@@ -41,12 +43,25 @@ class Application;
 
     The warning system is used instead of merely dropping, because hostile
     peers can just reconnect anyway.
+
+    Every 100ms the time jobs wait in the job queue is sampled for each
+    subsystem. A subsystem whose jobs wait too long is overloaded until
+    they no longer do, so that its work can be shed quickly and without
+    affecting the others. Consensus overload raises the local fee.
 */
 class LoadManager
 {
     LoadManager(Application& app, beast::Journal journal);
 
 public:
+    /** The parts of the server whose load is tracked separately. */
+    enum Subsystem {
+        rpc,        // Client requests and subscriptions
+        peer,       // Requests and untrusted messages from peers
+        consensus,  // Trusted messages and ledger advancement
+        subsystems
+    };
+
     LoadManager() = delete;
     LoadManager(LoadManager const&) = delete;
     LoadManager&
@@ -81,6 +96,13 @@ public:
     void
     resetDeadlockDetector();
 
+    /** Returns `true` if the subsystem's jobs are waiting too long. */
+    bool
+    isOverloaded(Subsystem subsystem) const
+    {
+        return overloaded_[subsystem].load(std::memory_order_relaxed);
+    }
+
     //--------------------------------------------------------------------------
 
     void
@@ -93,6 +115,9 @@ private:
     void
     run();
 
+    void
+    checkDeadlock(std::chrono::steady_clock::time_point deadLock, bool armed);
+
 private:
     Application& app_;
     beast::Journal const journal_;
@@ -106,6 +131,8 @@ private:
         deadLock_;  // Detect server deadlocks.
     bool armed_;
 
+    std::array<std::atomic<bool>, subsystems> overloaded_{};
+
     friend std::unique_ptr<LoadManager>
     make_LoadManager(Application& app, beast::Journal journal);
 };
@@ -17,19 +17,27 @@
 */
 //==============================================================================
 
+#include <ripple/app/ledger/ReplayBench.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/main/DBInit.h>
+#include <ripple/app/misc/CompactNodeStore.h>
 #include <ripple/app/rdb/Vacuum.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/StringUtilities.h>
 #include <ripple/basics/contract.h>
+#include <ripple/basics/random.h>
 #include <ripple/beast/clock/basic_seconds_clock.h>
 #include <ripple/beast/core/CurrentThreadName.h>
+#include <ripple/beast/core/LexicalCast.h>
 #include <ripple/core/Config.h>
 #include <ripple/core/ConfigSections.h>
 #include <ripple/core/TimeKeeper.h>
 #include <ripple/json/to_string.h>
 #include <ripple/net/RPCCall.h>
+#include <ripple/nodestore/DummyScheduler.h>
+#include <ripple/nodestore/Manager.h>
+#include <ripple/nodestore/impl/EncodedBlob.h>
+#include <ripple/nodestore/impl/NodeDictionary.h>
 #include <ripple/protocol/BuildInfo.h>
 #include <ripple/resource/Fees.h>
 #include <ripple/rpc/RPCHandler.h>
@@ -48,6 +56,7 @@
 
 #include <cstdlib>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
 #include <utility>
 
@@ -134,6 +143,7 @@ printHelp(const po::options_description& desc)
            "     account_tx accountID [ledger_index_min [ledger_index_max "
            "[limit "
            "]]] [binary]\n"
+           "     apply_profile [clear]\n"
            "     book_changes [<ledger hash|id>]\n"
            "     book_offers <taker_pays> <taker_gets> [<taker [<ledger> "
            "[<limit> [<proof> [<marker>]]]]]\n"
@@ -150,6 +160,7 @@ printHelp(const po::options_description& desc)
            "     gateway_balances [<ledger>] <issuer_account> [ <hotwallet> [ "
            "<hotwallet> ]]\n"
            "     get_counts\n"
+           "     heap_profile [purge|dump]\n"
            "     json <method> <json>\n"
            "     ledger [<id>|current|closed|validated] [full]\n"
            "     ledger_accept\n"
@@ -178,6 +189,7 @@ printHelp(const po::options_description& desc)
            "     stop\n"
            "     submit <tx_blob>|[<private_key> <tx_json>]\n"
            "     submit_multisigned <tx_json>\n"
+           "     trace [start|stop|clear]\n"
            "     tx <id>\n"
            "     validation_create [<seed>|<pass_phrase>|<key>]\n"
            "     validator_info\n"
@@ -344,6 +356,63 @@ runUnitTests(
 #endif  // ENABLE_TESTS
 //------------------------------------------------------------------------------
 
+// Train zstd dictionaries on the contents of the node database
+static int
+trainNodeDictionary(Config const& config, std::string const& file)
+{
+    if (boost::filesystem::exists(file))
+    {
+        // Databases written with the old dictionaries can't be read
+        // without them.
+        std::cerr << file << " exists and will not be replaced.\n";
+        return -1;
+    }
+
+    try
+    {
+        // Dictionaries that don't exist yet, such as the ones being
+        // trained, can't have been used to write the database
+        auto section = config.section(ConfigSection::nodeDatabase());
+        if (auto const path = get(section, "zstd_dictionary");
+            !path.empty() && !boost::filesystem::exists(path))
+            section.set("zstd_dictionary", "");
+
+        NodeStore::DummyScheduler scheduler;
+        auto backend = NodeStore::Manager::instance().make_Backend(
+            section,
+            config.getValueFor(SizedItem::burstSize),
+            scheduler,
+            beast::Journal{beast::Journal::getNullSink()});
+        backend->open(false);
+
+        NodeStore::NodeDictionary::Trainer trainer;
+        backend->for_each([&trainer](std::shared_ptr<NodeObject> object) {
+            NodeStore::EncodedBlob const e(object);
+            trainer.insert(e.getData(), e.getSize());
+        });
+        backend->close();
+
+        // The version only has to differ from that of other dictionaries
+        auto const version = rand_int<std::uint32_t>(
+            1, std::numeric_limits<std::uint32_t>::max());
+        auto const dictionary = trainer.finish(
+            version, beast::Journal{beast::Journal::getNullSink()});
+        dictionary->save(file);
+
+        std::cout << "Saved " << dictionary->size()
+                  << " dictionaries, version " << dictionary->version()
+                  << ", to " << file << std::endl;
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "exception " << e.what() << " in function " << __func__
+                  << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+
 int
 run(int argc, char** argv)
 {
@@ -389,7 +458,12 @@ run(int argc, char** argv)
             "version", "Display the build version.");
 
     po::options_description data("Ledger/Data Options");
-    data.add_options()("import", importText.c_str())(
+    data.add_options()(
+        "compact_nodestore",
+        po::value<std::string>(),
+        "Rewrite the NuDB node database so that the nodes of the ledger "
+        "with the given hash are stored in tree order, and exit.")(
+        "import", importText.c_str())(
         "ledger",
         po::value<std::string>(),
         "Load the specified ledger and start from the value given.")(
@@ -400,7 +474,16 @@ run(int argc, char** argv)
         "net", "Get the initial ledger from the network.")(
         "nodetoshard", "Import node store into shards")(
         "replay", "Replay a ledger close.")(
+        "replay_bench",
+        po::value<std::uint32_t>(),
+        "Replay the given number of ledger closes, starting with the ledger "
+        "index given by --ledger, report how long each phase took, and "
+        "exit.")(
         "start", "Start from a fresh Ledger.")(
+        "train_dictionary",
+        po::value<std::string>(),
+        "Train zstd dictionaries on the node database, save them to the "
+        "given file for the zstd_dictionary option, and exit.")(
         "startReporting",
         po::value<std::string>(),
         "Start reporting from a fresh Ledger.")(
@@ -608,6 +691,22 @@ run(int argc, char** argv)
         return 0;
     }
 
+    if (vm.count("compact_nodestore"))
+    {
+        uint256 ledgerHash;
+        if (!ledgerHash.parseHex(vm["compact_nodestore"].as<std::string>()))
+        {
+            std::cerr << "compact_nodestore needs a ledger hash.\n";
+            return -1;
+        }
+
+        return doCompactNodeStore(*config, ledgerHash) ? 0 : -1;
+    }
+
+    if (vm.count("train_dictionary"))
+        return trainNodeDictionary(
+            *config, vm["train_dictionary"].as<std::string>());
+
     if (vm.contains("force_ledger_present_range"))
     {
         try
@@ -693,6 +792,28 @@ run(int argc, char** argv)
         config->START_UP = Config::LOAD;
     }
 
+    LedgerIndex replayBenchFirst = 0;
+    if (vm.count("replay_bench"))
+    {
+        if (!vm.count("ledger") ||
+            !beast::lexicalCastChecked(
+                replayBenchFirst, vm["ledger"].as<std::string>()) ||
+            replayBenchFirst == 0)
+        {
+            std::cerr << "--replay_bench needs a ledger index given by "
+                         "--ledger"
+                      << std::endl;
+            return -1;
+        }
+
+        if (vm.count("net"))
+        {
+            std::cerr << "Net and replay_bench options are incompatible"
+                      << std::endl;
+            return -1;
+        }
+    }
+
     if (vm.count("net") && !config->FAST_LOAD)
     {
         if ((config->START_UP == Config::LOAD) ||
@@ -809,6 +930,17 @@ run(int argc, char** argv)
         if (!app->setup(vm))
             return -1;
 
+        if (vm.count("replay_bench"))
+        {
+            return replayBench(
+                       *app,
+                       replayBenchFirst,
+                       vm["replay_bench"].as<std::uint32_t>(),
+                       std::cout)
+                ? 0
+                : -1;
+        }
+
         // With our configuration parsed, ensure we have
         // enough file descriptors available:
         if (!adjustDescriptorLimit(
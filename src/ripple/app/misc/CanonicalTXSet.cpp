@@ -19,22 +19,21 @@
 
 #include <ripple/app/misc/CanonicalTXSet.h>
 
+#include <algorithm>
+
 namespace ripple {
 
 bool
 operator<(CanonicalTXSet::Key const& lhs, CanonicalTXSet::Key const& rhs)
 {
-    if (lhs.account_ < rhs.account_)
-        return true;
-
-    if (lhs.account_ > rhs.account_)
-        return false;
+    if (lhs.accountPrefix_ != rhs.accountPrefix_)
+        return lhs.accountPrefix_ < rhs.accountPrefix_;
 
-    if (lhs.seqProxy_ < rhs.seqProxy_)
-        return true;
+    if (auto const c = lhs.account_ <=> rhs.account_; c != 0)
+        return c < 0;
 
-    if (lhs.seqProxy_ > rhs.seqProxy_)
-        return false;
+    if (lhs.seqProxy_ != rhs.seqProxy_)
+        return lhs.seqProxy_ < rhs.seqProxy_;
 
     return lhs.txId_ < rhs.txId_;
 }
@@ -58,6 +57,29 @@ CanonicalTXSet::insert(std::shared_ptr<STTx const> const& txn)
         txn));
 }
 
+void
+CanonicalTXSet::insert(std::vector<std::shared_ptr<STTx const>> const& txns)
+{
+    std::vector<std::pair<Key, std::shared_ptr<STTx const>>> sorted;
+    sorted.reserve(txns.size());
+
+    for (auto const& txn : txns)
+        sorted.emplace_back(
+            Key(accountKey(txn->getAccountID(sfAccount)),
+                txn->getSeqProxy(),
+                txn->getTransactionID()),
+            txn);
+
+    std::sort(sorted.begin(), sorted.end(), [](auto const& a, auto const& b) {
+        return a.first < b.first;
+    });
+
+    // A hint that is right makes each insertion constant time.  When the
+    // set wasn't empty the hint may be wrong, which is merely slower.
+    for (auto& entry : sorted)
+        map_.insert(map_.end(), std::move(entry));
+}
+
 std::shared_ptr<STTx const>
 CanonicalTXSet::popAcctTransaction(std::shared_ptr<STTx const> const& tx)
 {
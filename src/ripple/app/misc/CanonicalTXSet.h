@@ -21,10 +21,14 @@
 #define RIPPLE_APP_MISC_CANONICALTXSET_H_INCLUDED
 
 #include <ripple/basics/CountedObject.h>
+#include <ripple/basics/Slice.h>
 #include <ripple/protocol/RippleLedgerHash.h>
 #include <ripple/protocol/STTx.h>
 #include <ripple/protocol/SeqProxy.h>
 
+#include <map>
+#include <vector>
+
 namespace ripple {
 
 /** Holds transactions which were deferred to the next pass of consensus.
@@ -42,7 +46,10 @@ private:
     {
     public:
         Key(uint256 const& account, SeqProxy seqProx, uint256 const& id)
-            : account_(account), txId_(id), seqProxy_(seqProx)
+            : account_(account)
+            , txId_(id)
+            , seqProxy_(seqProx)
+            , accountPrefix_(prefix(account))
         {
         }
 
@@ -92,9 +99,23 @@ private:
         }
 
     private:
+        // The leading bytes of a key as an integer that sorts the same way
+        static std::uint64_t
+        prefix(uint256 const& key)
+        {
+            std::uint64_t ret = 0;
+            for (auto const b : Slice(key.data(), sizeof(ret)))
+                ret = (ret << 8) | b;
+            return ret;
+        }
+
         uint256 account_;
         uint256 txId_;
         SeqProxy seqProxy_;
+
+        // Salted accounts are random, so comparing just the prefixes of
+        // accounts almost always decides the order.
+        std::uint64_t accountPrefix_;
     };
 
     friend bool
@@ -116,6 +137,14 @@ public:
     void
     insert(std::shared_ptr<STTx const> const& txn);
 
+    /** Insert a batch of transactions.
+
+        The batch is sorted before it is inserted, which is cheaper than
+        inserting the transactions one at a time when building a large set.
+    */
+    void
+    insert(std::vector<std::shared_ptr<STTx const>> const& txns);
+
     // Pops the next transaction on account that follows seqProx in the
     // sort order.  Normally called when a transaction is successfully
     // applied to the open ledger so the next transaction can be resubmitted
@@ -0,0 +1,227 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <ripple/app/misc/CompactNodeStore.h>
+#include <ripple/basics/contract.h>
+#include <ripple/core/ConfigSections.h>
+#include <ripple/nodestore/impl/NodeDictionary.h>
+#include <ripple/nodestore/impl/codec.h>
+#include <ripple/protocol/LedgerHeader.h>
+#include <ripple/shamap/SHAMapInnerNode.h>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem.hpp>
+#include <nudb/nudb.hpp>
+
+#include <iostream>
+#include <vector>
+
+namespace ripple {
+
+bool
+doCompactNodeStore(Config const& config, uint256 const& ledgerHash)
+{
+    using namespace boost::filesystem;
+
+    auto const& section = config.section(ConfigSection::nodeDatabase());
+    if (!boost::iequals(get(section, "type"), "NuDB"))
+    {
+        std::cerr << "Only a NuDB node database can be compacted.\n";
+        return false;
+    }
+
+    auto const folder = path(get(section, "path"));
+    auto const dp = folder / "nudb.dat";
+    auto const kp = folder / "nudb.key";
+    auto const lp = folder / "nudb.log";
+    auto const temp = folder / "compact";
+    auto const tdp = temp / "nudb.dat";
+    auto const tkp = temp / "nudb.key";
+    auto const tlp = temp / "nudb.log";
+
+    try
+    {
+        auto const dbSize = file_size(dp) + file_size(kp);
+        if (auto const available = space(folder).available;
+            available < dbSize)
+        {
+            std::cerr << "The database filesystem must have at least as "
+                         "much free space as the size of the database, "
+                         "which is "
+                      << dbSize << " bytes. Only " << available
+                      << " bytes are available.\n";
+            return false;
+        }
+
+        // Values are copied as stored, but the dictionaries are needed
+        // to read the nodes that lead to others
+        std::shared_ptr<NodeStore::NodeDictionary const> dictionary;
+        if (auto const file = get(section, "zstd_dictionary"); !file.empty())
+            dictionary = NodeStore::NodeDictionary::load(file);
+
+        nudb::error_code ec;
+        nudb::store src;
+        src.open(dp.string(), kp.string(), lp.string(), ec);
+        if (ec)
+            Throw<nudb::system_error>(ec);
+
+        remove_all(temp);
+        create_directories(temp);
+        nudb::create<nudb::xxhasher>(
+            tdp.string(),
+            tkp.string(),
+            tlp.string(),
+            src.appnum(),
+            nudb::make_uid(),
+            nudb::make_salt(),
+            src.key_size(),
+            nudb::block_size(tkp.string()),
+            0.50,
+            ec);
+        if (ec)
+            Throw<nudb::system_error>(ec);
+
+        nudb::store dst;
+        dst.open(tdp.string(), tkp.string(), tlp.string(), ec);
+        if (ec)
+            Throw<nudb::system_error>(ec);
+
+        // Copy one record, returning the object it holds
+        std::uint64_t missing = 0;
+        auto copy = [&](uint256 const& key) -> std::shared_ptr<NodeObject> {
+            std::shared_ptr<NodeObject> object;
+            nudb::error_code ec;
+            src.fetch(
+                key.data(),
+                [&](void const* data, std::size_t size) {
+                    dst.insert(key.data(), data, size, ec);
+                    if (ec == nudb::error::key_exists)
+                        ec = {};
+                    nudb::detail::buffer bf;
+                    object = NodeStore::nodeobject_decode(
+                        key.data(), data, size, bf, dictionary.get());
+                },
+                ec);
+            if (ec == nudb::error::key_not_found)
+            {
+                ++missing;
+                return {};
+            }
+            if (ec)
+                Throw<nudb::system_error>(ec);
+            return object;
+        };
+
+        auto const header = copy(ledgerHash);
+        if (!header)
+        {
+            std::cerr << "Ledger " << ledgerHash
+                      << " is not in the node database.\n";
+            dst.close(ec);
+            remove_all(temp);
+            return false;
+        }
+        auto const info =
+            deserializePrefixedHeader(makeSlice(header->getData()));
+
+        // Copy each tree in depth-first order, visiting the branches of an
+        // inner node from the first to the last
+        std::uint64_t ordered = 1;
+        for (auto const& root : {info.txHash, info.accountHash})
+        {
+            std::vector<uint256> stack;
+            if (root.isNonZero())
+                stack.push_back(root);
+
+            while (!stack.empty())
+            {
+                auto const hash = stack.back();
+                stack.pop_back();
+
+                auto const object = copy(hash);
+                if (!object)
+                    continue;
+                ++ordered;
+
+                auto const node = SHAMapTreeNode::makeFromPrefix(
+                    makeSlice(object->getData()), SHAMapHash{hash});
+                if (!node || !node->isInner())
+                    continue;
+
+                auto const inner =
+                    std::static_pointer_cast<SHAMapInnerNode>(node);
+                for (int branch = SHAMapInnerNode::branchFactor; branch--;)
+                {
+                    if (!inner->isEmptyBranch(branch))
+                        stack.push_back(
+                            inner->getChildHash(branch).as_uint256());
+                }
+            }
+        }
+
+        src.close(ec);
+        if (ec)
+            Throw<nudb::system_error>(ec);
+
+        // Then everything else, in the order it was stored
+        std::uint64_t others = 0;
+        nudb::visit(
+            dp.string(),
+            [&](void const* key,
+                std::size_t,
+                void const* data,
+                std::size_t size,
+                nudb::error_code& ec) {
+                dst.insert(key, data, size, ec);
+                if (ec == nudb::error::key_exists)
+                    ec = {};
+                else if (!ec)
+                    ++others;
+            },
+            nudb::no_progress{},
+            ec);
+        if (ec)
+            Throw<nudb::system_error>(ec);
+
+        dst.close(ec);
+        if (ec)
+            Throw<nudb::system_error>(ec);
+
+        rename(tdp, dp);
+        rename(tkp, kp);
+        remove_all(temp);
+
+        std::cout << "Wrote " << ordered << " records of ledger "
+                  << ledgerHash << " in tree order, then " << others
+                  << " other records.";
+        if (missing)
+            std::cout << " " << missing << " nodes of the ledger are missing.";
+        std::cout << std::endl;
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "exception " << e.what() << " in function " << __func__
+                  << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+}  // namespace ripple
@@ -0,0 +1,50 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#ifndef RIPPLE_APP_MISC_COMPACTNODESTORE_H_INCLUDED
+#define RIPPLE_APP_MISC_COMPACTNODESTORE_H_INCLUDED
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/core/Config.h>
+
+namespace ripple {
+
+/** Rewrite the NuDB node database in the tree order of a ledger.
+
+    NuDB appends records to its data file in the order they are stored,
+    so the nodes of one subtree end up spread over the whole file. This
+    copies the database, writing the ledger's header, then the nodes of
+    its transaction and state trees in depth-first order, then every
+    other record, and replaces the database with the copy. Walks of that
+    ledger then read the data file mostly sequentially.
+
+    The server must not be running, and the filesystem must have as much
+    free space as the size of the database.
+
+    @param config The configuration naming the [node_db].
+    @param ledgerHash The hash of a ledger in the database.
+    @return True if the database was rewritten.
+*/
+bool
+doCompactNodeStore(Config const& config, uint256 const& ledgerHash);
+
+}  // namespace ripple
+
+#endif
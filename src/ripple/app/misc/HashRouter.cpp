@@ -18,33 +18,84 @@
 //==============================================================================
 
 #include <ripple/app/misc/HashRouter.h>
+#include <ripple/basics/Trace.h>
+#include <ripple/basics/partitioned_unordered_map.h>
 
 namespace ripple {
 
+HashRouter::HashRouter(
+    Stopwatch& clock,
+    std::chrono::seconds entryHoldTimeInSeconds)
+    : clock_(clock)
+    , lastAdded_(clock.now())
+    , holdTime_(entryHoldTimeInSeconds)
+{
+    shards_.reserve(shardCount);
+    for (std::size_t i = 0; i < shardCount; ++i)
+        shards_.push_back(std::make_unique<Shard>(clock));
+}
+
 auto
-HashRouter::emplace(uint256 const& key) -> std::pair<Entry&, bool>
+HashRouter::shardFor(uint256 const& key) -> Shard&
 {
-    auto iter = suppressionMap_.find(key);
+    return *shards_[partitioner(key, shardCount)];
+}
 
-    if (iter != suppressionMap_.end())
+bool
+HashRouter::expired(Stopwatch::time_point lastUsed) const
+{
+    return lastUsed + holdTime_ <= lastAdded_.load();
+}
+
+auto
+HashRouter::emplace(Shard& shard, uint256 const& key)
+    -> std::pair<Entry&, bool>
+{
+    auto& map = shard.suppressionMap;
+    auto iter = map.find(key);
+
+    if (iter != map.end())
     {
-        suppressionMap_.touch(iter);
-        return std::make_pair(std::ref(iter->second), false);
+        if (!expired(iter.when()))
+        {
+            map.refresh(iter);
+            return std::make_pair(std::ref(iter->second), false);
+        }
+
+        // Expired, but not swept yet
+        map.erase(iter);
     }
 
-    // See if any supressions need to be expired
-    expire(suppressionMap_, holdTime_);
+    // Adding a hash is what expires the entries which are old enough.
+    auto const now = clock_.now();
+    auto last = lastAdded_.load();
+    while (last < now && !lastAdded_.compare_exchange_weak(last, now))
+        ;
 
     return std::make_pair(
-        std::ref(suppressionMap_.emplace(key, Entry()).first->second), true);
+        std::ref(map.emplace(key, Entry()).first->second), true);
+}
+
+void
+HashRouter::sweep()
+{
+    for (auto& shard : shards_)
+    {
+        std::lock_guard lock(shard->mutex);
+        auto& map = shard->suppressionMap;
+        for (auto iter = map.chronological.cbegin();
+             iter != map.chronological.cend() && expired(iter.when());)
+            iter = map.erase(iter);
+    }
 }
 
 void
 HashRouter::addSuppression(uint256 const& key)
 {
-    std::lock_guard lock(mutex_);
+    auto& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
 
-    emplace(key);
+    emplace(shard, key);
 }
 
 bool
@@ -56,9 +107,10 @@ HashRouter::addSuppressionPeer(uint256 const& key, PeerShortID peer)
 std::pair<bool, std::optional<Stopwatch::time_point>>
 HashRouter::addSuppressionPeerWithStatus(const uint256& key, PeerShortID peer)
 {
-    std::lock_guard lock(mutex_);
+    auto& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
 
-    auto result = emplace(key);
+    auto result = emplace(shard, key);
     result.first.addPeer(peer);
     return {result.second, result.first.relayed()};
 }
@@ -66,9 +118,10 @@ HashRouter::addSuppressionPeerWithStatus(const uint256& key, PeerShortID peer)
 bool
 HashRouter::addSuppressionPeer(uint256 const& key, PeerShortID peer, int& flags)
 {
-    std::lock_guard lock(mutex_);
+    auto& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
 
-    auto [s, created] = emplace(key);
+    auto [s, created] = emplace(shard, key);
     s.addPeer(peer);
     flags = s.getFlags();
     return created;
@@ -81,21 +134,24 @@ HashRouter::shouldProcess(
     int& flags,
     std::chrono::seconds tx_interval)
 {
-    std::lock_guard lock(mutex_);
+    trace::Span span("HashRouter::shouldProcess", trace::idOf(key));
+    auto& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
 
-    auto result = emplace(key);
+    auto result = emplace(shard, key);
     auto& s = result.first;
     s.addPeer(peer);
     flags = s.getFlags();
-    return s.shouldProcess(suppressionMap_.clock().now(), tx_interval);
+    return s.shouldProcess(clock_.now(), tx_interval);
 }
 
 int
 HashRouter::getFlags(uint256 const& key)
 {
-    std::lock_guard lock(mutex_);
+    auto& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
 
-    return emplace(key).first.getFlags();
+    return emplace(shard, key).first.getFlags();
 }
 
 bool
@@ -103,9 +159,10 @@ HashRouter::setFlags(uint256 const& key, int flags)
 {
     assert(flags != 0);
 
-    std::lock_guard lock(mutex_);
+    auto& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
 
-    auto& s = emplace(key).first;
+    auto& s = emplace(shard, key).first;
 
     if ((s.getFlags() & flags) == flags)
         return false;
@@ -118,11 +175,12 @@ auto
 HashRouter::shouldRelay(uint256 const& key)
     -> std::optional<std::set<PeerShortID>>
 {
-    std::lock_guard lock(mutex_);
+    auto& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
 
-    auto& s = emplace(key).first;
+    auto& s = emplace(shard, key).first;
 
-    if (!s.shouldRelay(suppressionMap_.clock().now(), holdTime_))
+    if (!s.shouldRelay(clock_.now(), holdTime_))
         return {};
 
     return s.releasePeerSet();
@@ -26,7 +26,11 @@
 #include <ripple/basics/chrono.h>
 #include <ripple/beast/container/aged_unordered_map.h>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <vector>
 
 namespace ripple {
 
@@ -49,6 +53,12 @@ namespace ripple {
     This table keeps track of which hashes have been received by which peers.
     It is used to manage the routing and broadcasting of messages in the peer
     to peer overlay.
+
+    The table is split into shards, each with its own lock, so that peers
+    looking up different hashes rarely wait for each other. An entry
+    expires once another hash has been added at least the hold time after
+    the entry was last used. Lookups ignore expired entries, and sweep()
+    removes them, so adding a hash does not have to walk other shards.
 */
 class HashRouter
 {
@@ -143,10 +153,7 @@ public:
         return 300s;
     }
 
-    HashRouter(Stopwatch& clock, std::chrono::seconds entryHoldTimeInSeconds)
-        : suppressionMap_(clock), holdTime_(entryHoldTimeInSeconds)
-    {
-    }
+    HashRouter(Stopwatch& clock, std::chrono::seconds entryHoldTimeInSeconds);
 
     HashRouter&
     operator=(HashRouter const&) = delete;
@@ -205,20 +212,47 @@ public:
     std::optional<std::set<PeerShortID>>
     shouldRelay(uint256 const& key);
 
+    /** Remove the expired entries. Called periodically. */
+    void
+    sweep();
+
 private:
+    static constexpr std::size_t shardCount = 32;
+
+    struct Shard
+    {
+        explicit Shard(Stopwatch& clock) : suppressionMap(clock)
+        {
+        }
+
+        std::mutex mutex;
+
+        // Stores the suppressed hashes and when they were last used
+        beast::aged_unordered_map<
+            uint256,
+            Entry,
+            Stopwatch::clock_type,
+            digest_hash>
+            suppressionMap;
+    };
+
+    Shard&
+    shardFor(uint256 const& key);
+
+    // The caller must hold the lock of the shard.
     // pair.second indicates whether the entry was created
     std::pair<Entry&, bool>
-    emplace(uint256 const&);
+    emplace(Shard& shard, uint256 const& key);
+
+    bool
+    expired(Stopwatch::time_point lastUsed) const;
+
+    Stopwatch& clock_;
 
-    std::mutex mutable mutex_;
+    std::vector<std::unique_ptr<Shard>> shards_;
 
-    // Stores all suppressed hashes and their expiration time
-    beast::aged_unordered_map<
-        uint256,
-        Entry,
-        Stopwatch::clock_type,
-        hardened_hash<strong_hash>>
-        suppressionMap_;
+    // When a hash was last added to the table
+    std::atomic<Stopwatch::time_point> lastAdded_;
 
     std::chrono::seconds const holdTime_;
 };
@@ -25,15 +25,17 @@
 #include <ripple/app/ledger/LedgerToJson.h>
 #include <ripple/app/ledger/LocalTxs.h>
 #include <ripple/app/ledger/OpenLedger.h>
+#include <ripple/app/ledger/ObligationsIndex.h>
 #include <ripple/app/ledger/OrderBookDB.h>
 #include <ripple/app/ledger/TransactionMaster.h>
 #include <ripple/app/main/LoadManager.h>
 #include <ripple/app/misc/AmendmentTable.h>
-#include <ripple/app/misc/DeliverMax.h>
 #include <ripple/app/misc/HashRouter.h>
 #include <ripple/app/misc/LoadFeeTrack.h>
 #include <ripple/app/misc/NetworkOPs.h>
+#include <ripple/app/misc/SHAMapStore.h>
 #include <ripple/app/misc/Transaction.h>
+#include <ripple/app/misc/TxJsonCache.h>
 #include <ripple/app/misc/TxQ.h>
 #include <ripple/app/misc/ValidatorKeys.h>
 #include <ripple/app/misc/ValidatorList.h>
@@ -42,7 +44,10 @@
 #include <ripple/app/rdb/backend/SQLiteDatabase.h>
 #include <ripple/app/reporting/ReportingETL.h>
 #include <ripple/app/tx/apply.h>
+#include <ripple/app/tx/applySteps.h>
 #include <ripple/basics/PerfLog.h>
+#include <ripple/basics/SubscriptionIndex.h>
+#include <ripple/basics/Trace.h>
 #include <ripple/basics/UptimeClock.h>
 #include <ripple/basics/mulDiv.h>
 #include <ripple/basics/safe_cast.h>
@@ -50,6 +55,7 @@
 #include <ripple/beast/utility/rngfill.h>
 #include <ripple/consensus/Consensus.h>
 #include <ripple/consensus/ConsensusParms.h>
+#include <ripple/core/ParallelFor.h>
 #include <ripple/crypto/RFC1751.h>
 #include <ripple/crypto/csprng.h>
 #include <ripple/json/MultivarJson.h>
@@ -73,6 +79,7 @@
 #include <boost/asio/steady_timer.hpp>
 
 #include <algorithm>
+#include <functional>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -289,6 +296,22 @@ public:
         bool bLocal,
         FailHard failType) override;
 
+    void
+    processTransactions(
+        std::vector<std::shared_ptr<Transaction>>& transactions,
+        bool bUnlimited,
+        FailHard failType) override;
+
+    /**
+     * Reject transactions known or found to have a bad signature, and
+     * replace the transaction by its canonical object.
+     *
+     * @param transaction Transaction object.
+     * @return Whether the transaction should be applied.
+     */
+    bool
+    preProcessTransaction(std::shared_ptr<Transaction>& transaction);
+
     /**
      * For transactions submitted directly by a client, apply batch of
      * transactions and wait for this transaction to complete.
@@ -318,6 +341,19 @@ public:
         bool bUnlimited,
         FailHard failtype);
 
+    /**
+     * Apply batches of transactions until the callback returns false.
+     *
+     * @param lock The lock on mMutex, which must be held.
+     * @param retryCallback Whether the transactions being waited for are
+     *                      still being applied.
+     */
+    void
+    doTransactionSyncBatch(
+        std::unique_lock<std::mutex>& lock,
+        std::function<bool(std::unique_lock<std::mutex> const&)> const&
+            retryCallback);
+
     /**
      * Apply transactions in batches. Continue until none are queued.
      */
@@ -332,6 +368,17 @@ public:
     void
     apply(std::unique_lock<std::mutex>& batchLock);
 
+    /**
+     * Call a function for each transaction of a batch, spread over several
+     * jobs when the batch is large enough.
+     *
+     * @param transactions The batch
+     * @param f Called with each entry. Calls may be concurrent.
+     */
+    template <class Function>
+    void
+    forEachInBatch(std::vector<TransactionStatus>& transactions, Function&& f);
+
     //
     // Owner functions.
     //
@@ -355,6 +402,9 @@ public:
         Json::Value const& jvMarker,
         Json::Value& jvResult) override;
 
+    std::shared_ptr<Json::Value const>
+    getBookChanges(std::shared_ptr<ReadView const> const& ledger) override;
+
     // Ledger proposal/close functions.
     bool
     processTrustedProposal(RCLCxPeerPos proposal) override;
@@ -657,7 +707,7 @@ private:
 
 private:
     using SubMapType = hash_map<std::uint64_t, InfoSub::wptr>;
-    using SubInfoMapType = hash_map<AccountID, SubMapType>;
+    using SubInfoMapType = SubscriptionIndex<AccountID, InfoSub>;
     using subRpcMapType = hash_map<std::string, InfoSub::pointer>;
 
     /*
@@ -764,6 +814,15 @@ private:
 
     std::array<SubMapType, SubTypes::sLastEntry> mStreamMaps;
 
+    // The book changes of the closed ledgers most recently asked for
+    static constexpr std::size_t bookChangesCacheSize = 16;
+    std::mutex bookChangesMutex_;
+    std::array<
+        std::pair<uint256, std::shared_ptr<Json::Value const>>,
+        bookChangesCacheSize>
+        bookChanges_;
+    std::size_t bookChangesNext_ = 0;
+
     ServerFeeSummary mLastFeeSummary;
 
     JobQueue& m_job_queue;
@@ -1195,7 +1254,61 @@ NetworkOPsImp::processTransaction(
     bool bLocal,
     FailHard failType)
 {
+    trace::Span span(
+        "NetworkOPs::processTransaction", trace::idOf(transaction->getID()));
     auto ev = m_job_queue.makeLoadEvent(jtTXN_PROC, "ProcessTXN");
+
+    if (!preProcessTransaction(transaction))
+        return;
+
+    if (bLocal)
+        doTransactionSync(transaction, bUnlimited, failType);
+    else
+        doTransactionAsync(transaction, bUnlimited, failType);
+}
+
+void
+NetworkOPsImp::processTransactions(
+    std::vector<std::shared_ptr<Transaction>>& transactions,
+    bool bUnlimited,
+    FailHard failType)
+{
+    auto ev = m_job_queue.makeLoadEvent(jtTXN_PROC, "ProcessTXNs");
+
+    std::vector<std::shared_ptr<Transaction>> submitted;
+    submitted.reserve(transactions.size());
+    for (auto& transaction : transactions)
+    {
+        if (preProcessTransaction(transaction))
+            submitted.push_back(transaction);
+    }
+
+    if (submitted.empty())
+        return;
+
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    for (auto const& transaction : submitted)
+    {
+        if (!transaction->getApplying())
+        {
+            mTransactions.push_back(
+                TransactionStatus(transaction, bUnlimited, true, failType));
+            transaction->setApplying();
+        }
+    }
+
+    doTransactionSyncBatch(lock, [&submitted](auto const&) {
+        return std::any_of(
+            submitted.begin(), submitted.end(), [](auto const& transaction) {
+                return transaction->getApplying();
+            });
+    });
+}
+
+bool
+NetworkOPsImp::preProcessTransaction(std::shared_ptr<Transaction>& transaction)
+{
     auto const newFlags = app_.getHashRouter().getFlags(transaction->getID());
 
     if ((newFlags & SF_BAD) != 0)
@@ -1204,7 +1317,7 @@ NetworkOPsImp::processTransaction(
         JLOG(m_journal.warn()) << transaction->getID() << ": cached bad!\n";
         transaction->setStatus(INVALID);
         transaction->setResult(temBAD_SIGNATURE);
-        return;
+        return false;
     }
 
     // NOTE eahennis - I think this check is redundant,
@@ -1225,16 +1338,13 @@ NetworkOPsImp::processTransaction(
         transaction->setStatus(INVALID);
         transaction->setResult(temBAD_SIGNATURE);
         app_.getHashRouter().setFlags(transaction->getID(), SF_BAD);
-        return;
+        return false;
     }
 
     // canonicalize can change our pointer
     app_.getMasterTransaction().canonicalize(&transaction);
 
-    if (bLocal)
-        doTransactionSync(transaction, bUnlimited, failType);
-    else
-        doTransactionAsync(transaction, bUnlimited, failType);
+    return true;
 }
 
 void
@@ -1277,6 +1387,17 @@ NetworkOPsImp::doTransactionSync(
         transaction->setApplying();
     }
 
+    doTransactionSyncBatch(lock, [&transaction](auto const&) {
+        return transaction->getApplying();
+    });
+}
+
+void
+NetworkOPsImp::doTransactionSyncBatch(
+    std::unique_lock<std::mutex>& lock,
+    std::function<bool(std::unique_lock<std::mutex> const&)> const&
+        retryCallback)
+{
     do
     {
         if (mDispatchState == DispatchState::running)
@@ -1299,7 +1420,7 @@ NetworkOPsImp::doTransactionSync(
                 }
             }
         }
-    } while (transaction->getApplying());
+    } while (retryCallback(lock));
 }
 
 void
@@ -1316,9 +1437,28 @@ NetworkOPsImp::transactionBatch()
     }
 }
 
+template <class Function>
+void
+NetworkOPsImp::forEachInBatch(
+    std::vector<TransactionStatus>& transactions,
+    Function&& f)
+{
+    parallelFor(
+        app_.getJobQueue(),
+        jtBATCH,
+        "NetworkOPs::forEachInBatch",
+        transactions.size(),
+        ParallelGrain{},
+        [&](std::size_t i) {
+            f(transactions[i]);
+            return true;
+        });
+}
+
 void
 NetworkOPsImp::apply(std::unique_lock<std::mutex>& batchLock)
 {
+    trace::Span span("NetworkOPs::apply");
     std::vector<TransactionStatus> submit_held;
     std::vector<TransactionStatus> transactions;
     mTransactions.swap(transactions);
@@ -1329,6 +1469,31 @@ NetworkOPsImp::apply(std::unique_lock<std::mutex>& batchLock)
 
     batchLock.unlock();
 
+    auto const applyFlags = [](TransactionStatus const& e) {
+        ApplyFlags flags = tapNONE;
+        if (e.admin)
+            flags |= tapUNLIMITED;
+
+        if (e.failType == FailHard::yes)
+            flags |= tapFAIL_HARD;
+        return flags;
+    };
+
+    // Run the checks that do not depend on the open ledger's state before
+    // taking the master lock. TxQ::apply finds their results in the
+    // preflight cache.
+    {
+        auto const rules = app_.openLedger().current()->rules();
+        forEachInBatch(transactions, [&](TransactionStatus& e) {
+            preflight(
+                app_,
+                rules,
+                *e.transaction->getSTransaction(),
+                applyFlags(e),
+                m_journal);
+        });
+    }
+
     {
         std::unique_lock masterLock{app_.getMasterMutex(), std::defer_lock};
         bool changed = false;
@@ -1340,16 +1505,12 @@ NetworkOPsImp::apply(std::unique_lock<std::mutex>& batchLock)
             app_.openLedger().modify([&](OpenView& view, beast::Journal j) {
                 for (TransactionStatus& e : transactions)
                 {
-                    // we check before adding to the batch
-                    ApplyFlags flags = tapNONE;
-                    if (e.admin)
-                        flags |= tapUNLIMITED;
-
-                    if (e.failType == FailHard::yes)
-                        flags |= tapFAIL_HARD;
-
                     auto const result = app_.getTxQ().apply(
-                        app_, view, e.transaction->getSTransaction(), flags, j);
+                        app_,
+                        view,
+                        e.transaction->getSTransaction(),
+                        applyFlags(e),
+                        j);
                     e.result = result.first;
                     e.applied = result.second;
                     changed = changed || result.second;
@@ -1462,9 +1623,17 @@ NetworkOPsImp::apply(std::unique_lock<std::mutex>& batchLock)
                     e.transaction->getSTransaction());
                 e.transaction->setKept();
             }
+        }
+
+        // Relaying and the fee state only depend on each transaction's own
+        // result, so they need not be done in order.
+        auto const mode = mMode.load();
+        forEachInBatch(transactions, [&](TransactionStatus& e) {
+            auto const enforceFailHard =
+                e.failType == FailHard::yes && !isTesSuccess(e.result);
 
             if ((e.applied ||
-                 ((mMode != OperatingMode::FULL) &&
+                 ((mode != OperatingMode::FULL) &&
                   (e.failType != FailHard::yes) && e.local) ||
                  (e.result == terQUEUED)) &&
                 !enforceFailHard)
@@ -1497,7 +1666,7 @@ NetworkOPsImp::apply(std::unique_lock<std::mutex>& batchLock)
                 e.transaction->setCurrentLedgerState(
                     *validatedLedgerIndex, fee, accountSeq, availableSeq);
             }
-        }
+        });
     }
 
     batchLock.lock();
@@ -2453,6 +2622,12 @@ NetworkOPsImp::getServerInfo(bool human, bool admin, bool counters)
     }
     info[jss::io_latency_ms] =
         static_cast<Json::UInt>(app_.getIOLatency().count());
+    if (auto const latency = app_.getOverlayIOLatency())
+        info[jss::overlay_io_latency_ms] =
+            static_cast<Json::UInt>(latency->count());
+    if (auto const latency = app_.getServerIOLatency())
+        info[jss::server_io_latency_ms] =
+            static_cast<Json::UInt>(latency->count());
 
     if (admin)
     {
@@ -2466,6 +2641,12 @@ NetworkOPsImp::getServerInfo(bool human, bool admin, bool counters)
         {
             info[jss::pubkey_validator] = "none";
         }
+
+        if (auto onlineDelete = app_.getSHAMapStore().getJson();
+            !onlineDelete.isNull())
+        {
+            info[jss::online_delete] = std::move(onlineDelete);
+        }
     }
 
     if (counters)
@@ -2478,6 +2659,7 @@ NetworkOPsImp::getServerInfo(bool human, bool admin, bool counters)
         else
             app_.getNodeStore().getCountsJson(nodestore);
         info[jss::counters][jss::nodestore] = nodestore;
+        info[jss::counters][jss::latency] = app_.getPerfLog().latencyJson();
         info[jss::current_activities] = app_.getPerfLog().currentJson();
     }
 
@@ -2698,6 +2880,9 @@ NetworkOPsImp::getServerInfo(bool human, bool admin, bool counters)
         Json::Value ports{Json::arrayValue};
         for (auto const& port : app_.getServerHandler().setup().ports)
         {
+            // Local sockets have no port number to publish
+            if (port.local())
+                continue;
             // Don't publish admin ports for non-admin users
             if (!admin &&
                 !(port.admin_nets_v4.empty() && port.admin_nets_v6.empty() &&
@@ -2760,6 +2945,8 @@ NetworkOPsImp::pubProposedTransaction(
         transJson(transaction, result, false, ledger, std::nullopt);
 
     {
+        auto const shared = share(jvObj);
+
         std::lock_guard sl(mSubLock);
 
         auto it = mStreamMaps[sRTTransactions].begin();
@@ -2769,8 +2956,7 @@ NetworkOPsImp::pubProposedTransaction(
 
             if (p)
             {
-                p->send(
-                    jvObj.select(apiVersionSelector(p->getApiVersion())), true);
+                p->publish(shared[apiVersionSelector(p->getApiVersion())()]);
                 ++it;
             }
             else
@@ -2878,12 +3064,8 @@ NetworkOPsImp::forwardProposedAccountTransaction(Json::Value const& jvObj)
     hash_set<InfoSub::pointer> notify;
     int iProposed = 0;
     // check if there are any subscribers before attempting to parse the JSON
-    {
-        std::lock_guard sl(mSubLock);
-
-        if (mSubRTAccount.empty())
-            return;
-    }
+    if (mSubRTAccount.empty())
+        return;
 
     // parse the JSON outside of the lock
     std::vector<AccountID> accounts;
@@ -2901,34 +3083,11 @@ NetworkOPsImp::forwardProposedAccountTransaction(Json::Value const& jvObj)
             return;
         }
     }
+    for (auto const& affectedAccount : accounts)
     {
-        std::lock_guard sl(mSubLock);
-
-        if (!mSubRTAccount.empty())
-        {
-            for (auto const& affectedAccount : accounts)
-            {
-                auto simiIt = mSubRTAccount.find(affectedAccount);
-                if (simiIt != mSubRTAccount.end())
-                {
-                    auto it = simiIt->second.begin();
-
-                    while (it != simiIt->second.end())
-                    {
-                        InfoSub::pointer p = it->second.lock();
-
-                        if (p)
-                        {
-                            notify.insert(p);
-                            ++it;
-                            ++iProposed;
-                        }
-                        else
-                            it = simiIt->second.erase(it);
-                    }
-                }
-            }
-        }
+        iProposed += mSubRTAccount.forEach(
+            affectedAccount,
+            [&](InfoSub::pointer const& p) { notify.insert(p); });
     }
     JLOG(m_journal.trace()) << "forwardProposedAccountTransaction:"
                             << " iProposed=" << iProposed;
@@ -2946,6 +3105,8 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
     // Ledgers are published only when they acquire sufficient validations
     // Holes are filled across connection loss or other catastrophe
 
+    trace::Span span("NetworkOPs::pubLedger", lpAccepted->info().seq);
+
     std::shared_ptr<AcceptedLedger> alpAccepted =
         app_.getAcceptedLedgerCache().fetch(lpAccepted->info().hash);
     if (!alpAccepted)
@@ -2957,6 +3118,10 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
 
     assert(alpAccepted->getLedger().get() == lpAccepted.get());
 
+    app_.getOrderBookDB().processLedger(*alpAccepted);
+    app_.getOrderBookDB().bookIndex().update(lpAccepted);
+    app_.getObligationsIndex().update(*alpAccepted);
+
     {
         JLOG(m_journal.debug())
             << "Publishing ledger " << lpAccepted->info().seq << " "
@@ -2990,13 +3155,14 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
                     app_.getLedgerMaster().getCompleteLedgers();
             }
 
+            SharedJson const shared{jvObj};
             auto it = mStreamMaps[sLedger].begin();
             while (it != mStreamMaps[sLedger].end())
             {
                 InfoSub::pointer p = it->second.lock();
                 if (p)
                 {
-                    p->send(jvObj, true);
+                    p->publish(shared);
                     ++it;
                 }
                 else
@@ -3006,7 +3172,8 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
 
         if (!mStreamMaps[sBookChanges].empty())
         {
-            Json::Value jvObj = ripple::RPC::computeBookChanges(lpAccepted);
+            auto const changes = getBookChanges(lpAccepted);
+            SharedJson const shared{*changes};
 
             auto it = mStreamMaps[sBookChanges].begin();
             while (it != mStreamMaps[sBookChanges].end())
@@ -3014,7 +3181,7 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
                 InfoSub::pointer p = it->second.lock();
                 if (p)
                 {
-                    p->send(jvObj, true);
+                    p->publish(shared);
                     ++it;
                 }
                 else
@@ -3113,8 +3280,6 @@ NetworkOPsImp::transJson(
     // NOTE jvObj is not a finished object for either API version. After
     // it's populated, we need to finish it for a specific API version. This is
     // done in a loop, near the end of this function.
-    jvObj[jss::transaction] =
-        transaction->getJson(JsonOptions::disable_API_prior_V2, false);
 
     if (meta)
     {
@@ -3129,8 +3294,6 @@ NetworkOPsImp::transJson(
     if (validated)
     {
         jvObj[jss::ledger_index] = ledger->info().seq;
-        jvObj[jss::transaction][jss::date] =
-            ledger->info().closeTime.time_since_epoch().count();
         jvObj[jss::validated] = true;
         jvObj[jss::close_time_iso] = to_string_iso(ledger->info().closeTime);
 
@@ -3147,6 +3310,7 @@ NetworkOPsImp::transJson(
     jvObj[jss::engine_result_code] = result;
     jvObj[jss::engine_result_message] = sHuman;
 
+    std::optional<std::string> ownerFunds;
     if (transaction->getTxnType() == ttOFFER_CREATE)
     {
         auto const account = transaction->getAccountID(sfAccount);
@@ -3155,13 +3319,13 @@ NetworkOPsImp::transJson(
         // If the offer create is not self funded then add the owner balance
         if (account != amount.issue().account)
         {
-            auto const ownerFunds = accountFunds(
+            auto const funds = accountFunds(
                 *ledger,
                 account,
                 amount,
                 fhIGNORE_FREEZE,
                 app_.journal("View"));
-            jvObj[jss::transaction][jss::owner_funds] = ownerFunds.getText();
+            ownerFunds = funds.getText();
         }
     }
 
@@ -3170,17 +3334,25 @@ NetworkOPsImp::transJson(
     visit<RPC::apiMinimumSupportedVersion, RPC::apiMaximumValidVersion>(
         multiObj,  //
         [&](Json::Value& jvTx, unsigned int apiVersion) {
-            RPC::insertDeliverMax(
-                jvTx[jss::transaction], transaction->getTxnType(), apiVersion);
+            // The transaction is shared with the other streams and the tx
+            // and account_tx methods. Before API version 2 it already has
+            // the hash.
+            Json::Value tx =
+                *app_.getTxJsonCache().get(*transaction, apiVersion, false);
+            if (validated)
+                tx[jss::date] =
+                    ledger->info().closeTime.time_since_epoch().count();
+            if (ownerFunds)
+                tx[jss::owner_funds] = *ownerFunds;
 
             if (apiVersion > 1)
             {
-                jvTx[jss::tx_json] = jvTx.removeMember(jss::transaction);
+                jvTx[jss::tx_json] = std::move(tx);
                 jvTx[jss::hash] = hash;
             }
             else
             {
-                jvTx[jss::transaction][jss::hash] = hash;
+                jvTx[jss::transaction] = std::move(tx);
             }
         });
 
@@ -3201,6 +3373,9 @@ NetworkOPsImp::pubValidatedTransaction(
     MultiApiJson jvObj = transJson(stTxn, trResult, true, ledger, metaRef);
 
     {
+        // Every subscriber using an API version shares one serialization
+        auto const shared = share(jvObj);
+
         std::lock_guard sl(mSubLock);
 
         auto it = mStreamMaps[sTransactions].begin();
@@ -3210,8 +3385,7 @@ NetworkOPsImp::pubValidatedTransaction(
 
             if (p)
             {
-                p->send(
-                    jvObj.select(apiVersionSelector(p->getApiVersion())), true);
+                p->publish(shared[apiVersionSelector(p->getApiVersion())()]);
                 ++it;
             }
             else
@@ -3226,8 +3400,7 @@ NetworkOPsImp::pubValidatedTransaction(
 
             if (p)
             {
-                p->send(
-                    jvObj.select(apiVersionSelector(p->getApiVersion())), true);
+                p->publish(shared[apiVersionSelector(p->getApiVersion())()]);
                 ++it;
             }
             else
@@ -3253,53 +3426,24 @@ NetworkOPsImp::pubAccountTransaction(
 
     std::vector<SubAccountHistoryInfo> accountHistoryNotify;
     auto const currLedgerSeq = ledger->seq();
+    if (!mSubAccount.empty() || !mSubRTAccount.empty())
+    {
+        auto const insert = [&](InfoSub::pointer const& p) {
+            notify.insert(p);
+        };
+        for (auto const& affectedAccount : transaction.getAffected())
+        {
+            iProposed += mSubRTAccount.forEach(affectedAccount, insert);
+            iAccepted += mSubAccount.forEach(affectedAccount, insert);
+        }
+    }
     {
         std::lock_guard sl(mSubLock);
 
-        if (!mSubAccount.empty() || !mSubRTAccount.empty() ||
-            !mSubAccountHistory.empty())
+        if (!mSubAccountHistory.empty())
         {
             for (auto const& affectedAccount : transaction.getAffected())
             {
-                if (auto simiIt = mSubRTAccount.find(affectedAccount);
-                    simiIt != mSubRTAccount.end())
-                {
-                    auto it = simiIt->second.begin();
-
-                    while (it != simiIt->second.end())
-                    {
-                        InfoSub::pointer p = it->second.lock();
-
-                        if (p)
-                        {
-                            notify.insert(p);
-                            ++it;
-                            ++iProposed;
-                        }
-                        else
-                            it = simiIt->second.erase(it);
-                    }
-                }
-
-                if (auto simiIt = mSubAccount.find(affectedAccount);
-                    simiIt != mSubAccount.end())
-                {
-                    auto it = simiIt->second.begin();
-                    while (it != simiIt->second.end())
-                    {
-                        InfoSub::pointer p = it->second.lock();
-
-                        if (p)
-                        {
-                            notify.insert(p);
-                            ++it;
-                            ++iAccepted;
-                        }
-                        else
-                            it = simiIt->second.erase(it);
-                    }
-                }
-
                 if (auto histoIt = mSubAccountHistory.find(affectedAccount);
                     histoIt != mSubAccountHistory.end())
                 {
@@ -3345,11 +3489,11 @@ NetworkOPsImp::pubAccountTransaction(
         auto const trResult = transaction.getResult();
         MultiApiJson jvObj = transJson(stTxn, trResult, true, ledger, metaRef);
 
-        for (InfoSub::ref isrListener : notify)
         {
-            isrListener->send(
-                jvObj.select(apiVersionSelector(isrListener->getApiVersion())),
-                true);
+            auto const shared = share(jvObj);
+            for (InfoSub::ref isrListener : notify)
+                isrListener->publish(
+                    shared[apiVersionSelector(isrListener->getApiVersion())()]);
         }
 
         if (last)
@@ -3384,38 +3528,14 @@ NetworkOPsImp::pubProposedAccountTransaction(
 
     std::vector<SubAccountHistoryInfo> accountHistoryNotify;
 
-    {
-        std::lock_guard sl(mSubLock);
-
-        if (mSubRTAccount.empty())
-            return;
-
-        if (!mSubAccount.empty() || !mSubRTAccount.empty() ||
-            !mSubAccountHistory.empty())
-        {
-            for (auto const& affectedAccount : tx->getMentionedAccounts())
-            {
-                if (auto simiIt = mSubRTAccount.find(affectedAccount);
-                    simiIt != mSubRTAccount.end())
-                {
-                    auto it = simiIt->second.begin();
-
-                    while (it != simiIt->second.end())
-                    {
-                        InfoSub::pointer p = it->second.lock();
+    if (mSubRTAccount.empty())
+        return;
 
-                        if (p)
-                        {
-                            notify.insert(p);
-                            ++it;
-                            ++iProposed;
-                        }
-                        else
-                            it = simiIt->second.erase(it);
-                    }
-                }
-            }
-        }
+    for (auto const& affectedAccount : tx->getMentionedAccounts())
+    {
+        iProposed += mSubRTAccount.forEach(
+            affectedAccount,
+            [&](InfoSub::pointer const& p) { notify.insert(p); });
     }
 
     JLOG(m_journal.trace()) << "pubProposedAccountTransaction: " << iProposed;
@@ -3425,10 +3545,12 @@ NetworkOPsImp::pubProposedAccountTransaction(
         // Create two different Json objects, for different API versions
         MultiApiJson jvObj = transJson(tx, result, false, ledger, std::nullopt);
 
-        for (InfoSub::ref isrListener : notify)
-            isrListener->send(
-                jvObj.select(apiVersionSelector(isrListener->getApiVersion())),
-                true);
+        {
+            auto const shared = share(jvObj);
+            for (InfoSub::ref isrListener : notify)
+                isrListener->publish(
+                    shared[apiVersionSelector(isrListener->getApiVersion())()]);
+        }
 
         assert(
             jvObj.isMember(jss::account_history_tx_stream) ==
@@ -3466,25 +3588,8 @@ NetworkOPsImp::subAccount(
         isrListener->insertSubAccountInfo(naAccountID, rt);
     }
 
-    std::lock_guard sl(mSubLock);
-
     for (auto const& naAccountID : vnaAccountIDs)
-    {
-        auto simIterator = subMap.find(naAccountID);
-        if (simIterator == subMap.end())
-        {
-            // Not found, note that account has a new single listner.
-            SubMapType usisElement;
-            usisElement[isrListener->getSeq()] = isrListener;
-            // VFALCO NOTE This is making a needless copy of naAccountID
-            subMap.insert(simIterator, make_pair(naAccountID, usisElement));
-        }
-        else
-        {
-            // Found, note that the account has another listener.
-            simIterator->second[isrListener->getSeq()] = isrListener;
-        }
-    }
+        subMap.insert(naAccountID, isrListener->getSeq(), isrListener);
 }
 
 void
@@ -3509,26 +3614,10 @@ NetworkOPsImp::unsubAccountInternal(
     hash_set<AccountID> const& vnaAccountIDs,
     bool rt)
 {
-    std::lock_guard sl(mSubLock);
-
     SubInfoMapType& subMap = rt ? mSubRTAccount : mSubAccount;
 
     for (auto const& naAccountID : vnaAccountIDs)
-    {
-        auto simIterator = subMap.find(naAccountID);
-
-        if (simIterator != subMap.end())
-        {
-            // Found
-            simIterator->second.erase(uSeq);
-
-            if (simIterator->second.empty())
-            {
-                // Don't need hash entry.
-                subMap.erase(simIterator);
-            }
-        }
-    }
+        subMap.erase(naAccountID, uSeq);
 }
 
 void
@@ -4297,6 +4386,39 @@ NetworkOPsImp::tryRemoveRpcSub(std::string const& strUrl)
     return true;
 }
 
+std::shared_ptr<Json::Value const>
+NetworkOPsImp::getBookChanges(std::shared_ptr<ReadView const> const& ledger)
+{
+    if (ledger->open())
+        return std::make_shared<Json::Value const>(
+            RPC::computeBookChanges(ledger));
+
+    auto const& hash = ledger->info().hash;
+
+    {
+        std::lock_guard lock(bookChangesMutex_);
+        for (auto const& [key, changes] : bookChanges_)
+        {
+            if (changes && key == hash)
+                return changes;
+        }
+    }
+
+    // A ledger that was published recently has its transactions and
+    // metadata already deserialized, and knows which touched offers
+    std::shared_ptr<Json::Value const> changes;
+    if (auto const accepted = app_.getAcceptedLedgerCache().fetch(hash))
+        changes = std::make_shared<Json::Value const>(
+            RPC::computeBookChanges(*accepted));
+    else
+        changes = std::make_shared<Json::Value const>(
+            RPC::computeBookChanges(ledger));
+
+    std::lock_guard lock(bookChangesMutex_);
+    bookChanges_[bookChangesNext_++ % bookChangesCacheSize] = {hash, changes};
+    return changes;
+}
+
 #ifndef USE_NEW_BOOK_PAGE
 
 // NIKB FIXME this should be looked at. There's no reason why this shouldn't
@@ -4344,6 +4466,125 @@ NetworkOPsImp::getBookPage(
     auto const rate = transferRate(view, book.out.account);
     auto viewJ = app_.journal("View");
 
+    // Add an offer to the page along with the funds of its owner
+    auto addOffer = [&](std::shared_ptr<SLE const> const& sleOffer,
+                        STAmount const& dirRate) {
+        auto const uOfferOwnerID = sleOffer->getAccountID(sfAccount);
+        auto const& saTakerGets = sleOffer->getFieldAmount(sfTakerGets);
+        auto const& saTakerPays = sleOffer->getFieldAmount(sfTakerPays);
+        STAmount saOwnerFunds;
+        bool firstOwnerOffer(true);
+
+        if (book.out.account == uOfferOwnerID)
+        {
+            // If an offer is selling issuer's own IOUs, it is fully
+            // funded.
+            saOwnerFunds = saTakerGets;
+        }
+        else if (bGlobalFreeze)
+        {
+            // If either asset is globally frozen, consider all offers
+            // that aren't ours to be totally unfunded
+            saOwnerFunds.clear(book.out);
+        }
+        else
+        {
+            auto umBalanceEntry = umBalance.find(uOfferOwnerID);
+            if (umBalanceEntry != umBalance.end())
+            {
+                // Found in running balance table.
+
+                saOwnerFunds = umBalanceEntry->second;
+                firstOwnerOffer = false;
+            }
+            else
+            {
+                // Did not find balance in table.
+
+                saOwnerFunds = accountHolds(
+                    view,
+                    uOfferOwnerID,
+                    book.out.currency,
+                    book.out.account,
+                    fhZERO_IF_FROZEN,
+                    viewJ);
+
+                if (saOwnerFunds < beast::zero)
+                {
+                    // Treat negative funds as zero.
+
+                    saOwnerFunds.clear();
+                }
+            }
+        }
+
+        Json::Value jvOffer = sleOffer->getJson(JsonOptions::none);
+
+        STAmount saTakerGetsFunded;
+        STAmount saOwnerFundsLimit = saOwnerFunds;
+        Rate offerRate = parityRate;
+
+        if (rate != parityRate
+            // Have a tranfer fee.
+            && uTakerID != book.out.account
+            // Not taking offers of own IOUs.
+            && book.out.account != uOfferOwnerID)
+        // Offer owner not issuing ownfunds
+        {
+            // Need to charge a transfer fee to offer owner.
+            offerRate = rate;
+            saOwnerFundsLimit = divide(saOwnerFunds, offerRate);
+        }
+
+        if (saOwnerFundsLimit >= saTakerGets)
+        {
+            // Sufficient funds no shenanigans.
+            saTakerGetsFunded = saTakerGets;
+        }
+        else
+        {
+            // Only provide, if not fully funded.
+
+            saTakerGetsFunded = saOwnerFundsLimit;
+
+            saTakerGetsFunded.setJson(jvOffer[jss::taker_gets_funded]);
+            std::min(
+                saTakerPays,
+                multiply(saTakerGetsFunded, dirRate, saTakerPays.issue()))
+                .setJson(jvOffer[jss::taker_pays_funded]);
+        }
+
+        STAmount saOwnerPays = (parityRate == offerRate)
+            ? saTakerGetsFunded
+            : std::min(saOwnerFunds, multiply(saTakerGetsFunded, offerRate));
+
+        umBalance[uOfferOwnerID] = saOwnerFunds - saOwnerPays;
+
+        // Include all offers funded and unfunded
+        Json::Value& jvOf = jvOffers.append(jvOffer);
+        jvOf[jss::quality] = dirRate.getText();
+
+        if (firstOwnerOffer)
+            jvOf[jss::owner_funds] = saOwnerFunds.getText();
+    };
+
+    // Serve the books in the last validated ledger from the index
+    if (auto const index =
+            app_.getOrderBookDB().bookIndex().getOffers(view, book, iLimit))
+    {
+        auto const& offers = index->offers;
+        auto const count = std::min<std::size_t>(iLimit, offers.size());
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto const& sleOffer = offers[i];
+            addOffer(
+                sleOffer,
+                amountFromQuality(
+                    getQuality(sleOffer->getFieldH256(sfBookDirectory))));
+        }
+        return;
+    }
+
     while (!bDone && iLimit-- > 0)
     {
         if (bDirectAdvance)
@@ -4383,105 +4624,7 @@ NetworkOPsImp::getBookPage(
 
             if (sleOffer)
             {
-                auto const uOfferOwnerID = sleOffer->getAccountID(sfAccount);
-                auto const& saTakerGets = sleOffer->getFieldAmount(sfTakerGets);
-                auto const& saTakerPays = sleOffer->getFieldAmount(sfTakerPays);
-                STAmount saOwnerFunds;
-                bool firstOwnerOffer(true);
-
-                if (book.out.account == uOfferOwnerID)
-                {
-                    // If an offer is selling issuer's own IOUs, it is fully
-                    // funded.
-                    saOwnerFunds = saTakerGets;
-                }
-                else if (bGlobalFreeze)
-                {
-                    // If either asset is globally frozen, consider all offers
-                    // that aren't ours to be totally unfunded
-                    saOwnerFunds.clear(book.out);
-                }
-                else
-                {
-                    auto umBalanceEntry = umBalance.find(uOfferOwnerID);
-                    if (umBalanceEntry != umBalance.end())
-                    {
-                        // Found in running balance table.
-
-                        saOwnerFunds = umBalanceEntry->second;
-                        firstOwnerOffer = false;
-                    }
-                    else
-                    {
-                        // Did not find balance in table.
-
-                        saOwnerFunds = accountHolds(
-                            view,
-                            uOfferOwnerID,
-                            book.out.currency,
-                            book.out.account,
-                            fhZERO_IF_FROZEN,
-                            viewJ);
-
-                        if (saOwnerFunds < beast::zero)
-                        {
-                            // Treat negative funds as zero.
-
-                            saOwnerFunds.clear();
-                        }
-                    }
-                }
-
-                Json::Value jvOffer = sleOffer->getJson(JsonOptions::none);
-
-                STAmount saTakerGetsFunded;
-                STAmount saOwnerFundsLimit = saOwnerFunds;
-                Rate offerRate = parityRate;
-
-                if (rate != parityRate
-                    // Have a tranfer fee.
-                    && uTakerID != book.out.account
-                    // Not taking offers of own IOUs.
-                    && book.out.account != uOfferOwnerID)
-                // Offer owner not issuing ownfunds
-                {
-                    // Need to charge a transfer fee to offer owner.
-                    offerRate = rate;
-                    saOwnerFundsLimit = divide(saOwnerFunds, offerRate);
-                }
-
-                if (saOwnerFundsLimit >= saTakerGets)
-                {
-                    // Sufficient funds no shenanigans.
-                    saTakerGetsFunded = saTakerGets;
-                }
-                else
-                {
-                    // Only provide, if not fully funded.
-
-                    saTakerGetsFunded = saOwnerFundsLimit;
-
-                    saTakerGetsFunded.setJson(jvOffer[jss::taker_gets_funded]);
-                    std::min(
-                        saTakerPays,
-                        multiply(
-                            saTakerGetsFunded, saDirRate, saTakerPays.issue()))
-                        .setJson(jvOffer[jss::taker_pays_funded]);
-                }
-
-                STAmount saOwnerPays = (parityRate == offerRate)
-                    ? saTakerGetsFunded
-                    : std::min(
-                          saOwnerFunds, multiply(saTakerGetsFunded, offerRate));
-
-                umBalance[uOfferOwnerID] = saOwnerFunds - saOwnerPays;
-
-                // Include all offers funded and unfunded
-                Json::Value& jvOf = jvOffers.append(jvOffer);
-                jvOf[jss::quality] = saDirRate.getText();
-
-                if (firstOwnerOffer)
-                    jvOf[jss::owner_funds] = saOwnerFunds.getText();
+                addOffer(sleOffer, saDirRate);
             }
             else
             {
@@ -139,6 +139,22 @@ public:
         bool bLocal,
         FailHard failType) = 0;
 
+    /**
+     * Process transactions submitted together by a client. They are applied
+     * to the open ledger in one batch, and the call returns once all of them
+     * have been applied.
+     *
+     * @param transactions Transaction objects, which may be replaced by the
+     *                     canonical objects for the same transactions.
+     * @param bUnlimited Whether a privileged client connection submitted them.
+     * @param failType fail_hard setting from transaction submission.
+     */
+    virtual void
+    processTransactions(
+        std::vector<std::shared_ptr<Transaction>>& transactions,
+        bool bUnlimited,
+        FailHard failType) = 0;
+
     //--------------------------------------------------------------------------
     //
     // Owner functions
@@ -164,6 +180,15 @@ public:
         Json::Value const& jvMarker,
         Json::Value& jvResult) = 0;
 
+    /** Return the book changes of a ledger.
+
+        The changes of closed ledgers are computed once and kept for the
+        most recent ledgers they were asked for, for both the book_changes
+        stream and the RPC.
+    */
+    virtual std::shared_ptr<Json::Value const>
+    getBookChanges(std::shared_ptr<ReadView const> const& ledger) = 0;
+
     //--------------------------------------------------------------------------
 
     // ledger proposal/close functions
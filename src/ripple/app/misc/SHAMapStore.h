@@ -21,6 +21,7 @@
 #define RIPPLE_APP_MISC_SHAMAPSTORE_H_INCLUDED
 
 #include <ripple/app/ledger/Ledger.h>
+#include <ripple/json/json_value.h>
 #include <ripple/nodestore/Manager.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <optional>
@@ -97,6 +98,14 @@ public:
     */
     virtual std::optional<LedgerIndex>
     minimumOnline() const = 0;
+
+    /** Progress of online deletion, for server_info.
+
+        @return An object describing what online deletion is doing, or
+            null if online deletion is not enabled.
+    */
+    virtual Json::Value
+    getJson() const = 0;
 };
 
 //------------------------------------------------------------------------------
@@ -20,14 +20,17 @@
 #include <ripple/app/misc/SHAMapStoreImp.h>
 
 #include <ripple/app/ledger/TransactionMaster.h>
+#include <ripple/app/misc/LoadFeeTrack.h>
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/app/rdb/State.h>
 #include <ripple/app/rdb/backend/SQLiteDatabase.h>
 #include <ripple/beast/core/CurrentThreadName.h>
 #include <ripple/core/ConfigSections.h>
+#include <ripple/core/JobQueue.h>
 #include <ripple/core/Pg.h>
 #include <ripple/nodestore/Scheduler.h>
 #include <ripple/nodestore/impl/DatabaseRotatingImp.h>
+#include <ripple/protocol/jss.h>
 #include <ripple/shamap/SHAMapMissingNode.h>
 
 #include <boost/algorithm/string/predicate.hpp>
@@ -117,6 +120,15 @@ SHAMapStoreImp::SHAMapStoreImp(
     }
 
     get_if_exists(section, "online_delete", deleteInterval_);
+    coldTier_ = config.exists(ConfigSection::coldNodeDatabase());
+
+    if (coldTier_ && !deleteInterval_)
+    {
+        Throw<std::runtime_error>(
+            "[" + ConfigSection::coldNodeDatabase() +
+            "] requires online_delete in [" + ConfigSection::nodeDatabase() +
+            "]");
+    }
 
     if (deleteInterval_)
     {
@@ -153,7 +165,8 @@ SHAMapStoreImp::SHAMapStoreImp(
                 std::to_string(minInterval));
         }
 
-        if (config.LEDGER_HISTORY > deleteInterval_)
+        // With a cold tier, nothing is deleted
+        if (!coldTier_ && config.LEDGER_HISTORY > deleteInterval_)
         {
             Throw<std::runtime_error>(
                 "online_delete must not be less than ledger_history "
@@ -184,6 +197,9 @@ SHAMapStoreImp::makeNodeStore(int readThreads)
             std::to_string(app_.config().getValueFor(
                 SizedItem::treeCacheAge, std::nullopt)));
 
+    if (app_.config().NUMA_SPREAD && !nscfg.exists("numa_spread"))
+        nscfg.set("numa_spread", "1");
+
     std::unique_ptr<NodeStore::Database> db;
 
     if (deleteInterval_)
@@ -204,6 +220,18 @@ SHAMapStoreImp::makeNodeStore(int readThreads)
             state_db_.setState(state);
         }
 
+        std::shared_ptr<NodeStore::Backend> coldBackend;
+        if (coldTier_)
+        {
+            coldBackend = NodeStore::Manager::instance().make_Backend(
+                app_.config().section(ConfigSection::coldNodeDatabase()),
+                megabytes(app_.config().getValueFor(
+                    SizedItem::burstSize, std::nullopt)),
+                scheduler_,
+                app_.logs().journal(nodeStoreName_));
+            coldBackend->open();
+        }
+
         // Create NodeStore with two backends to allow online deletion of
         // data
         auto dbr = std::make_unique<NodeStore::DatabaseRotatingImp>(
@@ -212,7 +240,8 @@ SHAMapStoreImp::makeNodeStore(int readThreads)
             std::move(writableBackend),
             std::move(archiveBackend),
             nscfg,
-            app_.logs().journal(nodeStoreName_));
+            app_.logs().journal(nodeStoreName_),
+            std::move(coldBackend));
         fdRequired_ += dbr->fdRequired();
         dbRotating_ = dbr.get();
         db.reset(dynamic_cast<NodeStore::Database*>(dbr.release()));
@@ -269,10 +298,51 @@ SHAMapStoreImp::copyNode(std::uint64_t& nodeCount, SHAMapTreeNode const& node)
         true);
     if (!(++nodeCount % checkHealthInterval_))
     {
+        nodesCopied_ = nodeCount;
         if (healthWait() == stopping)
             return false;
+        throttle();
+    }
+
+    return true;
+}
+
+bool
+SHAMapStoreImp::copyState(Ledger const& ledger, SHAMap const* have)
+{
+    JLOG(journal_.debug()) << "copying ledger " << ledger.info().seq
+                           << (have ? " incrementally" : "");
+    phase_ = Phase::copying;
+    nodesCopied_ = 0;
+    std::uint64_t nodeCount = 0;
+    bool complete = true;
+    auto const visit = [&](SHAMapTreeNode const& node) {
+        return complete = copyNode(nodeCount, node);
+    };
+
+    try
+    {
+        auto const stateMap = ledger.stateMap().snapShot(false);
+        if (have)
+            stateMap->visitDifferences(have, visit);
+        else
+            stateMap->visitNodes(visit);
     }
+    catch (SHAMapMissingNode const& e)
+    {
+        JLOG(journal_.error())
+            << "Missing node while copying ledger " << ledger.info().seq
+            << ": " << e.what();
+        return false;
+    }
+
+    nodesCopied_ = nodeCount;
+    if (!complete)
+        return false;
 
+    // Only log if we completed without a "health" abort
+    JLOG(journal_.debug()) << "copied ledger " << ledger.info().seq
+                           << " nodecount " << nodeCount;
     return true;
 }
 
@@ -288,6 +358,7 @@ SHAMapStoreImp::run()
     }
     beast::setCurrentThreadName("SHAMapStore");
     LedgerIndex lastRotated = state_db_.getState().lastRotated;
+    lastRotated_ = lastRotated;
     netOPs_ = &app_.getOPs();
     ledgerMaster_ = &app_.getLedgerMaster();
     fullBelowCache_ = &(*app_.getNodeFamily().getFullBelowCache(0));
@@ -301,6 +372,7 @@ SHAMapStoreImp::run()
         healthy_ = true;
         std::shared_ptr<Ledger const> validatedLedger;
 
+        phase_ = Phase::idle;
         {
             std::unique_lock<std::mutex> lock(mutex_);
             working_ = false;
@@ -323,6 +395,7 @@ SHAMapStoreImp::run()
         {
             lastRotated = validatedSeq;
             state_db_.setLastRotated(lastRotated);
+            lastRotated_ = lastRotated;
         }
 
         bool const readyToRotate =
@@ -358,37 +431,33 @@ SHAMapStoreImp::run()
                 << app_.getOPs().strOperatingMode(false) << " age "
                 << ledgerMaster_->getValidatedLedgerAge().count() << 's';
 
-            clearPrior(lastRotated);
-            if (healthWait() == stopping)
-                return;
-
-            JLOG(journal_.debug()) << "copying ledger " << validatedSeq;
-            std::uint64_t nodeCount = 0;
-
-            try
+            // The ledgers being rotated out stay available from the cold
+            // tier, so only clear them without one.
+            if (!coldTier_)
             {
-                validatedLedger->stateMap().snapShot(false)->visitNodes(
-                    std::bind(
-                        &SHAMapStoreImp::copyNode,
-                        this,
-                        std::ref(nodeCount),
-                        std::placeholders::_1));
-            }
-            catch (SHAMapMissingNode const& e)
-            {
-                JLOG(journal_.error())
-                    << "Missing node while copying ledger before rotate: "
-                    << e.what();
-                continue;
+                phase_ = Phase::clearing;
+                clearPrior(lastRotated);
+                if (healthWait() == stopping)
+                    return;
             }
 
+            // If the state of an earlier ledger has already been copied,
+            // only the nodes which changed since then need to be.
+            std::shared_ptr<Ledger const> copiedLedger;
+            if (copiedSeq_)
+                copiedLedger = ledgerMaster_->getLedgerByHash(copiedHash_);
+
+            bool const copied = copyState(
+                *validatedLedger,
+                copiedLedger ? &copiedLedger->stateMap() : nullptr);
+            copiedLedger.reset();
             if (healthWait() == stopping)
                 return;
-            // Only log if we completed without a "health" abort
-            JLOG(journal_.debug()) << "copied ledger " << validatedSeq
-                                   << " nodecount " << nodeCount;
+            if (!copied)
+                continue;
 
             JLOG(journal_.debug()) << "freshening caches";
+            phase_ = Phase::freshening;
             freshenCaches();
             if (healthWait() == stopping)
                 return;
@@ -405,6 +474,7 @@ SHAMapStoreImp::run()
                 return;
 
             lastRotated = validatedSeq;
+            phase_ = Phase::rotating;
 
             dbRotating_->rotateWithLock(
                 [&](std::string const& writableBackendName) {
@@ -419,8 +489,25 @@ SHAMapStoreImp::run()
                     return std::move(newBackend);
                 });
 
+            // The writable backend is new, so nothing has been copied to it
+            copiedSeq_ = 0;
+            lastRotated_ = lastRotated;
+
             JLOG(journal_.warn()) << "finished rotation " << validatedSeq;
         }
+        else if (
+            !copiedSeq_ && validatedSeq >= lastRotated + deleteInterval_ / 2 &&
+            healthWait() == keepGoing)
+        {
+            // Halfway to the next rotation, copy the state of the validated
+            // ledger into the writable backend ahead of time. There is no
+            // deadline, so this can back off as much as the server needs.
+            if (copyState(*validatedLedger, nullptr))
+            {
+                copiedHash_ = validatedLedger->info().hash;
+                copiedSeq_ = validatedSeq;
+            }
+        }
     }
 }
 
@@ -590,7 +677,7 @@ SHAMapStoreImp::clearSql(
         if (healthWait() == stopping)
             return;
         if (min < lastRotated)
-            std::this_thread::sleep_for(backOff_);
+            std::this_thread::sleep_for(backOff_ + loadBackOff());
         if (healthWait() == stopping)
             return;
     }
@@ -698,6 +785,65 @@ SHAMapStoreImp::healthWait()
     return stop_ ? stopping : keepGoing;
 }
 
+std::chrono::milliseconds
+SHAMapStoreImp::loadBackOff()
+{
+    // Double the delay for each sign that the server is busy
+    int busy = 0;
+    if (app_.getFeeTrack().isLoadedLocal())
+        ++busy;
+    auto& jobQueue = app_.getJobQueue();
+    if (jobQueue.isOverloaded())
+        ++busy;
+    if (jobQueue.getJobCountGE(jtCLIENT) > busyJobCount_)
+        ++busy;
+
+    return backOff_ * ((1 << busy) - 1);
+}
+
+void
+SHAMapStoreImp::throttle()
+{
+    if (auto const wait = loadBackOff(); wait.count())
+    {
+        JLOG(journal_.trace())
+            << "Backing off " << wait.count() << "ms for a busy server";
+        std::this_thread::sleep_for(wait);
+    }
+}
+
+Json::Value
+SHAMapStoreImp::getJson() const
+{
+    if (!deleteInterval_)
+        return Json::nullValue;
+
+    Json::Value ret(Json::objectValue);
+    switch (phase_.load())
+    {
+        case Phase::idle:
+            ret[jss::state] = "idle";
+            break;
+        case Phase::clearing:
+            ret[jss::state] = "clearing";
+            break;
+        case Phase::copying:
+            ret[jss::state] = "copying";
+            break;
+        case Phase::freshening:
+            ret[jss::state] = "freshening";
+            break;
+        case Phase::rotating:
+            ret[jss::state] = "rotating";
+            break;
+    }
+    ret[jss::last_rotated] = lastRotated_.load();
+    if (auto const copied = copiedSeq_.load())
+        ret[jss::copied_ledger] = copied;
+    ret[jss::nodes_copied] = std::to_string(nodesCopied_.load());
+    return ret;
+}
+
 void
 SHAMapStoreImp::stop()
 {
@@ -83,6 +83,8 @@ private:
     static std::uint32_t const minimumDeletionIntervalSA_ = 8;
     // minimum ledger to maintain online.
     std::atomic<LedgerIndex> minimumOnline_{};
+    // waiting jobs beyond which the server is considered busy
+    static int const busyJobCount_ = 100;
 
     NodeStore::Scheduler& scheduler_;
     beast::Journal const journal_;
@@ -100,6 +102,8 @@ private:
     int fdRequired_ = 0;
 
     std::uint32_t deleteInterval_ = 0;
+    // Rotated out data is moved to [node_db_cold] instead of deleted
+    bool coldTier_ = false;
     bool advisoryDelete_ = false;
     std::uint32_t deleteBatch_ = 100;
     std::chrono::milliseconds backOff_{100};
@@ -110,6 +114,18 @@ private:
     /// See also: "recovery_wait_seconds" in rippled-example.cfg
     std::chrono::seconds recoveryWaitTime_{5};
 
+    // A ledger validated since the last rotation whose state has been
+    // copied into the writable backend. Rotation then only has to copy
+    // the nodes of the new ledger which differ from it.
+    std::atomic<LedgerIndex> copiedSeq_{0};
+    uint256 copiedHash_;
+
+    // progress of online deletion, reported by getJson()
+    enum class Phase { idle, clearing, copying, freshening, rotating };
+    std::atomic<Phase> phase_{Phase::idle};
+    std::atomic<std::uint64_t> nodesCopied_{0};
+    std::atomic<LedgerIndex> lastRotated_{0};
+
     // these do not exist upon SHAMapStore creation, but do exist
     // as of run() or before
     NetworkOPs* netOPs_ = nullptr;
@@ -176,10 +192,22 @@ public:
     std::optional<LedgerIndex>
     minimumOnline() const override;
 
+    Json::Value
+    getJson() const override;
+
 private:
     // callback for visitNodes
     bool
     copyNode(std::uint64_t& nodeCount, SHAMapTreeNode const& node);
+
+    /** Copy the state map of a ledger into the writable backend.
+
+        @param have If not null, only nodes not present in this map are
+            copied. Its nodes must already be in the writable backend.
+        @return Whether every node was copied.
+    */
+    bool
+    copyState(Ledger const& ledger, SHAMap const* have);
     void
     run();
     void
@@ -198,8 +226,12 @@ private:
         {
             dbRotating_->fetchNodeObject(
                 key, 0, NodeStore::FetchType::synchronous, true);
-            if (!(++check % checkHealthInterval_) && healthWait() == stopping)
-                return true;
+            if (!(++check % checkHealthInterval_))
+            {
+                if (healthWait() == stopping)
+                    return true;
+                throttle();
+            }
         }
 
         return false;
@@ -233,6 +265,17 @@ private:
     [[nodiscard]] HealthResult
     healthWait();
 
+    /** Extra delay to apply between units of work while the server is
+        busy with other work, judged by the local load fee and the depth
+        of the job queue. Zero when the server is not busy.
+    */
+    std::chrono::milliseconds
+    loadBackOff();
+
+    // Sleep for loadBackOff(), if the server is busy.
+    void
+    throttle();
+
 public:
     void
     start() override
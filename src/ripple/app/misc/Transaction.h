@@ -309,6 +309,18 @@ public:
     Json::Value
     getJson(JsonOptions options, bool binary = false) const;
 
+    /** Return the JSON for clients using an API version.
+
+        The transaction itself comes from the application's TxJsonCache
+        and already has `DeliverMax` inserted. Ledger fields are added as
+        by `getJson`.
+    */
+    Json::Value
+    getApiJson(
+        unsigned int apiVersion,
+        JsonOptions options,
+        bool binary = false) const;
+
     // Information used to locate a transaction.
     // Contains a nodestore hash and ledger sequence pair if the transaction was
     // found. Otherwise, contains the range of ledgers present in the database
@@ -385,6 +397,9 @@ private:
         std::optional<ClosedInterval<uint32_t>> const& range,
         error_code_i& ec);
 
+    void
+    addLedgerJson(Json::Value& ret, JsonOptions options) const;
+
     uint256 mTransactionID;
 
     LedgerIndex mLedgerIndex = 0;
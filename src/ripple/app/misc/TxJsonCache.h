@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#ifndef RIPPLE_APP_MISC_TXJSONCACHE_H_INCLUDED
+#define RIPPLE_APP_MISC_TXJSONCACHE_H_INCLUDED
+
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/basics/chrono.h>
+#include <ripple/beast/container/aged_unordered_map.h>
+#include <ripple/json/MultivarJson.h>
+#include <ripple/json/json_value.h>
+#include <ripple/protocol/STTx.h>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+namespace ripple {
+
+/** Shares the JSON form of recently seen transactions.
+
+    A validated transaction is shown to clients by the transactions stream,
+    by every subscription to an account it affects, and later by the tx and
+    account_tx methods. Each of them needs the same JSON for the transaction
+    itself, so it is built once for each API version and kept here.
+
+    The JSON only depends on the signed transaction, which is identified by
+    its ID, so entries never go stale; they are dropped when unused for a
+    while or when the cache is full. Fields which depend on the ledger the
+    transaction is in, and the metadata, are added by the caller.
+*/
+class TxJsonCache
+{
+public:
+    /** Create a cache.
+
+        @param clock The clock used to age entries.
+        @param size The largest number of transactions to keep.
+        @param age How long an entry is kept after it was last used.
+    */
+    TxJsonCache(Stopwatch& clock, std::size_t size, std::chrono::seconds age);
+
+    /** Return the JSON for a transaction.
+
+        This is `STTx::getJson` with the options for the API version and,
+        unless `binary` is set, `DeliverMax` inserted for the API version.
+    */
+    std::shared_ptr<Json::Value const>
+    get(STTx const& tx, unsigned int apiVersion, bool binary);
+
+    /** Remove entries which have not been used recently. */
+    void
+    sweep();
+
+    /** Return the number of cached transactions. */
+    std::size_t
+    size() const;
+
+    /** The default number of transactions to keep. */
+    static constexpr std::size_t defaultSize = 16384;
+
+    /** The default time to keep an unused entry. */
+    static constexpr std::chrono::seconds defaultAge{120};
+
+private:
+    static constexpr std::size_t versions = MultiApiJson::size;
+
+    // One slot for each API version, first as JSON and then as binary
+    using Entry = std::array<std::shared_ptr<Json::Value const>, 2 * versions>;
+
+    std::size_t const size_;
+    std::chrono::seconds const age_;
+
+    std::mutex mutable mutex_;
+
+    beast::aged_unordered_map<
+        uint256,
+        Entry,
+        Stopwatch::clock_type,
+        hardened_hash<strong_hash>>
+        entries_;
+};
+
+}  // namespace ripple
+
+#endif
@@ -29,6 +29,8 @@
 #include <ripple/protocol/TER.h>
 #include <boost/circular_buffer.hpp>
 #include <boost/intrusive/set.hpp>
+#include <atomic>
+#include <memory>
 #include <optional>
 
 namespace ripple {
@@ -309,6 +311,9 @@ public:
     nextQueuableSeq(std::shared_ptr<SLE const> const& sleAccount) const;
 
     /** Returns fee metrics in reference fee level units.
+
+        The queue figures are read from the state last published by
+        the queue, so this does not contend with transaction processing.
      */
     Metrics
     getMetrics(OpenView const& view) const;
@@ -764,6 +769,24 @@ private:
         locked mutex_
     */
     FeeMetrics feeMetrics_;
+    /** Copy of the @ref FeeMetrics::Snapshot, republished whenever
+        `feeMetrics_` changes, so the open ledger fee level can be
+        computed without taking `mutex_`. Both fields are replaced
+        together by swapping the pointer, so a reader racing an update
+        sees the snapshot from either side of the ledger close, the same
+        as if it had taken the lock just before or just after it.
+        Only accessed with std::atomic_load and std::atomic_store.
+    */
+    std::shared_ptr<FeeMetrics::Snapshot const> publishedMetrics_;
+    /** Copy of the queue size, size limit and minimum fee level to
+        get into the queue, republished whenever the queue changes so
+        @ref getMetrics can be answered without taking `mutex_`. The
+        fields are stored separately, so a reader may see some of them
+        from just before a change and the rest from just after it.
+    */
+    std::atomic<std::size_t> publishedTxCount_{0};
+    std::atomic<std::size_t> publishedMaxSize_;
+    std::atomic<FeeLevel64::value_type> publishedMinLevel_;
     /** The queue itself: the collection of transactions ordered
         by fee level.
         @note This member must always and only be accessed under
@@ -799,6 +822,18 @@ private:
     std::mutex mutable mutex_;
 
 private:
+    /// Republish the fee metrics for lock free readers.
+    void
+    publishMetrics(std::lock_guard<std::mutex> const& lock);
+
+    /// The most recently published fee metrics.
+    FeeMetrics::Snapshot
+    publishedMetrics() const;
+
+    /// Republish the queue size and limits for lock free readers.
+    void
+    publishQueueState(std::lock_guard<std::mutex> const& lock);
+
     /// Is the queue at least `fillPercentage` full?
     template <size_t fillPercentage = 100>
     bool
@@ -239,6 +239,13 @@ class ValidatorList
     // Listed master public keys with the number of lists they appear on
     hash_map<PublicKey, std::size_t> keyListings_;
 
+    // Parsed lists whose signature checked out, by the hash of the signing
+    // key, blob and signature. The same list arrives from many peers, in
+    // different messages, and is only verified and parsed once.
+    static constexpr std::size_t maxVerifiedLists = 256;
+    std::mutex verifiedMutex_;
+    hash_map<uint256, std::shared_ptr<Json::Value const>> verifiedLists_;
+
     // The current list of trusted master keys
     hash_set<PublicKey> trustedMasterKeys_;
 
@@ -870,6 +877,19 @@ private:
         std::string const& blob,
         std::string const& signature);
 
+    /** Check a list's signature and parse it, or use the earlier result
+
+        Does not need the mutex.
+
+        @return The parsed list, or nullptr if the signature or the blob is
+                invalid.
+    */
+    std::shared_ptr<Json::Value const>
+    verifyBlob(
+        PublicKey const& signingKey,
+        std::string const& blob,
+        std::string const& signature);
+
     /** Stop trusting publisher's list of keys.
 
         @param publisherKey Publisher public key
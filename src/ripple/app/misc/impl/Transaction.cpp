@@ -21,6 +21,7 @@
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/HashRouter.h>
 #include <ripple/app/misc/Transaction.h>
+#include <ripple/app/misc/TxJsonCache.h>
 #include <ripple/app/rdb/backend/PostgresDatabase.h>
 #include <ripple/app/rdb/backend/SQLiteDatabase.h>
 #include <ripple/app/tx/apply.h>
@@ -170,7 +171,27 @@ Transaction::getJson(JsonOptions options, bool binary) const
     // Note, we explicitly suppress `include_date` option here
     Json::Value ret(
         mTransaction->getJson(options & ~JsonOptions::include_date, binary));
+    addLedgerJson(ret, options);
+    return ret;
+}
+
+Json::Value
+Transaction::getApiJson(
+    unsigned int apiVersion,
+    JsonOptions options,
+    bool binary) const
+{
+    Json::Value ret(
+        *mApp.getTxJsonCache().get(*mTransaction, apiVersion, binary));
+    if (apiVersion > 1)
+        options = options | JsonOptions::disable_API_prior_V2;
+    addLedgerJson(ret, options);
+    return ret;
+}
 
+void
+Transaction::addLedgerJson(Json::Value& ret, JsonOptions options) const
+{
     // NOTE Binary STTx::getJson output might not be a JSON object
     if (ret.isObject() && mLedgerIndex)
     {
@@ -191,8 +212,6 @@ Transaction::getJson(JsonOptions options, bool binary) const
                 ret[jss::date] = ct->time_since_epoch().count();
         }
     }
-
-    return ret;
 }
 
 }  // namespace ripple
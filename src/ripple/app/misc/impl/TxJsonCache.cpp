@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <ripple/app/misc/DeliverMax.h>
+#include <ripple/app/misc/TxJsonCache.h>
+#include <ripple/beast/container/aged_container_utility.h>
+
+namespace ripple {
+
+TxJsonCache::TxJsonCache(
+    Stopwatch& clock,
+    std::size_t size,
+    std::chrono::seconds age)
+    : size_(size), age_(age), entries_(clock)
+{
+    assert(size_ > 0);
+}
+
+std::shared_ptr<Json::Value const>
+TxJsonCache::get(STTx const& tx, unsigned int apiVersion, bool binary)
+{
+    auto const slot =
+        apiVersionSelector(apiVersion)() + (binary ? versions : 0);
+    auto const& txID = tx.getTransactionID();
+
+    {
+        std::lock_guard lock(mutex_);
+        if (auto const it = entries_.find(txID); it != entries_.end())
+        {
+            entries_.touch(it);
+            if (auto const& json = it->second[slot])
+                return json;
+        }
+    }
+
+    // Build the JSON without holding the lock. If two threads race, both
+    // results are the same and either may be kept.
+    auto const options = apiVersion > 1 ? JsonOptions::disable_API_prior_V2
+                                        : JsonOptions::none;
+    auto json = std::make_shared<Json::Value>(tx.getJson(options, binary));
+    if (!binary)
+        RPC::insertDeliverMax(*json, tx.getTxnType(), apiVersion);
+
+    std::lock_guard lock(mutex_);
+
+    auto it = entries_.find(txID);
+    if (it == entries_.end())
+    {
+        it = entries_.emplace(txID, Entry{}).first;
+        while (entries_.size() > size_)
+            entries_.erase(entries_.chronological.begin());
+    }
+    else
+    {
+        entries_.touch(it);
+    }
+    it->second[slot] = json;
+    return json;
+}
+
+void
+TxJsonCache::sweep()
+{
+    std::lock_guard lock(mutex_);
+    beast::expire(entries_, age_);
+}
+
+std::size_t
+TxJsonCache::size() const
+{
+    std::lock_guard lock(mutex_);
+    return entries_.size();
+}
+
+}  // namespace ripple
@@ -22,7 +22,9 @@
 #include <ripple/app/misc/LoadFeeTrack.h>
 #include <ripple/app/misc/TxQ.h>
 #include <ripple/app/tx/apply.h>
+#include <ripple/basics/Trace.h>
 #include <ripple/basics/mulDiv.h>
+#include <ripple/basics/scope.h>
 #include <ripple/protocol/Feature.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/protocol/st.h>
@@ -352,7 +354,14 @@ TxQ::TxQAccount::remove(SeqProxy seqProx)
 //////////////////////////////////////////////////////////////////////////
 
 TxQ::TxQ(Setup const& setup, beast::Journal j)
-    : setup_(setup), j_(j), feeMetrics_(setup, j), maxSize_(std::nullopt)
+    : setup_(setup)
+    , j_(j)
+    , feeMetrics_(setup, j)
+    , publishedMetrics_(std::make_shared<FeeMetrics::Snapshot const>(
+          feeMetrics_.getSnapshot()))
+    , publishedMaxSize_(std::numeric_limits<std::size_t>::max())
+    , publishedMinLevel_(baseLevel.value())
+    , maxSize_(std::nullopt)
 {
 }
 
@@ -718,6 +727,7 @@ TxQ::apply(
     ApplyFlags flags,
     beast::Journal j)
 {
+    trace::Span span("TxQ::apply", trace::idOf(tx->getTransactionID()));
     STAmountSO stAmountSO{view.rules().enabled(fixSTAmountCanonicalize)};
     NumberSO stNumberSO{view.rules().enabled(fixUniversalNumber)};
 
@@ -764,6 +774,7 @@ TxQ::apply(
     }
 
     std::lock_guard lock(mutex_);
+    scope_exit publish([&] { publishQueueState(lock); });
 
     // accountIter is not const because it may be updated further down.
     AccountMap::iterator accountIter = byAccount_.find(account);
@@ -1349,6 +1360,7 @@ TxQ::processClosedLedger(Application& app, ReadView const& view, bool timeLeap)
     std::lock_guard lock(mutex_);
 
     feeMetrics_.update(app, view, timeLeap, setup_);
+    publishMetrics(lock);
     auto const& snapshot = feeMetrics_.getSnapshot();
 
     auto ledgerSeq = view.info().seq;
@@ -1381,6 +1393,8 @@ TxQ::processClosedLedger(Application& app, ReadView const& view, bool timeLeap)
         else
             ++txQAccountIter;
     }
+
+    publishQueueState(lock);
 }
 
 /*
@@ -1415,6 +1429,8 @@ TxQ::processClosedLedger(Application& app, ReadView const& view, bool timeLeap)
 bool
 TxQ::accept(Application& app, OpenView& view)
 {
+    trace::Span span("TxQ::accept", view.seq());
+
     /* Move transactions from the queue from largest fee level to smallest.
        As we add more transactions, the required fee level will increase.
        Stop when the transaction fee level gets lower than the required fee
@@ -1424,11 +1440,32 @@ TxQ::accept(Application& app, OpenView& view)
     auto ledgerChanged = false;
 
     std::lock_guard lock(mutex_);
+    scope_exit publish([&] { publishQueueState(lock); });
 
     auto const metricsSnapshot = feeMetrics_.getSnapshot();
 
+    // The required fee level only depends on the number of transactions
+    // in the open ledger, so it only needs to be recomputed after a
+    // queued transaction is applied.
+    auto requiredFeeLevel =
+        getRequiredFeeLevel(view, tapNONE, metricsSnapshot, lock);
+
     for (auto candidateIter = byFee_.begin(); candidateIter != byFee_.end();)
     {
+        auto const feeLevelPaid = candidateIter->feeLevel;
+        if (feeLevelPaid < requiredFeeLevel)
+        {
+            // byFee_ is ordered by fee level, so nothing after this
+            // candidate can clear the threshold either. Stop here rather
+            // than walking the rest of the queue skipping entries.
+            JLOG(j_.trace())
+                << "Queued transaction " << candidateIter->txID
+                << " from account " << candidateIter->account
+                << " has fee level of " << feeLevelPaid
+                << " needs at least " << requiredFeeLevel;
+            break;
+        }
+
         auto& account = byAccount_.at(candidateIter->account);
         auto const beginIter = account.transactions.begin();
         if (candidateIter->seqProxy.isSeq() &&
@@ -1444,105 +1481,93 @@ TxQ::accept(Application& app, OpenView& view)
             candidateIter++;
             continue;
         }
-        auto const requiredFeeLevel =
-            getRequiredFeeLevel(view, tapNONE, metricsSnapshot, lock);
-        auto const feeLevelPaid = candidateIter->feeLevel;
         JLOG(j_.trace()) << "Queued transaction " << candidateIter->txID
                          << " from account " << candidateIter->account
                          << " has fee level of " << feeLevelPaid
                          << " needs at least " << requiredFeeLevel;
-        if (feeLevelPaid >= requiredFeeLevel)
-        {
-            JLOG(j_.trace()) << "Applying queued transaction "
-                             << candidateIter->txID << " to open ledger.";
+        JLOG(j_.trace()) << "Applying queued transaction "
+                         << candidateIter->txID << " to open ledger.";
 
-            auto const [txnResult, didApply] =
-                candidateIter->apply(app, view, j_);
+        auto const [txnResult, didApply] = candidateIter->apply(app, view, j_);
 
-            if (didApply)
-            {
-                // Remove the candidate from the queue
-                JLOG(j_.debug())
-                    << "Queued transaction " << candidateIter->txID
-                    << " applied successfully with " << transToken(txnResult)
-                    << ". Remove from queue.";
-
-                candidateIter = eraseAndAdvance(candidateIter);
-                ledgerChanged = true;
-            }
-            else if (
-                isTefFailure(txnResult) || isTemMalformed(txnResult) ||
-                candidateIter->retriesRemaining <= 0)
-            {
-                if (candidateIter->retriesRemaining <= 0)
-                    account.retryPenalty = true;
-                else
-                    account.dropPenalty = true;
-                JLOG(j_.debug()) << "Queued transaction " << candidateIter->txID
-                                 << " failed with " << transToken(txnResult)
-                                 << ". Remove from queue.";
-                candidateIter = eraseAndAdvance(candidateIter);
-            }
+        if (didApply)
+        {
+            // Remove the candidate from the queue
+            JLOG(j_.debug()) << "Queued transaction " << candidateIter->txID
+                             << " applied successfully with "
+                             << transToken(txnResult) << ". Remove from queue.";
+
+            candidateIter = eraseAndAdvance(candidateIter);
+            ledgerChanged = true;
+            requiredFeeLevel =
+                getRequiredFeeLevel(view, tapNONE, metricsSnapshot, lock);
+        }
+        else if (
+            isTefFailure(txnResult) || isTemMalformed(txnResult) ||
+            candidateIter->retriesRemaining <= 0)
+        {
+            if (candidateIter->retriesRemaining <= 0)
+                account.retryPenalty = true;
+            else
+                account.dropPenalty = true;
+            JLOG(j_.debug()) << "Queued transaction " << candidateIter->txID
+                             << " failed with " << transToken(txnResult)
+                             << ". Remove from queue.";
+            candidateIter = eraseAndAdvance(candidateIter);
+        }
+        else
+        {
+            JLOG(j_.debug()) << "Queued transaction " << candidateIter->txID
+                             << " failed with " << transToken(txnResult)
+                             << ". Leave in queue."
+                             << " Applied: " << didApply
+                             << ". Flags: " << candidateIter->flags;
+            if (account.retryPenalty && candidateIter->retriesRemaining > 2)
+                candidateIter->retriesRemaining = 1;
             else
+                --candidateIter->retriesRemaining;
+            candidateIter->lastResult = txnResult;
+            if (account.dropPenalty && account.transactions.size() > 1 &&
+                isFull<95>())
             {
-                JLOG(j_.debug()) << "Queued transaction " << candidateIter->txID
-                                 << " failed with " << transToken(txnResult)
-                                 << ". Leave in queue."
-                                 << " Applied: " << didApply
-                                 << ". Flags: " << candidateIter->flags;
-                if (account.retryPenalty && candidateIter->retriesRemaining > 2)
-                    candidateIter->retriesRemaining = 1;
-                else
-                    --candidateIter->retriesRemaining;
-                candidateIter->lastResult = txnResult;
-                if (account.dropPenalty && account.transactions.size() > 1 &&
-                    isFull<95>())
+                // The queue is close to full, this account has multiple
+                // txs queued, and this account has had a transaction
+                // fail.
+                if (candidateIter->seqProxy.isTicket())
                 {
-                    // The queue is close to full, this account has multiple
-                    // txs queued, and this account has had a transaction
-                    // fail.
-                    if (candidateIter->seqProxy.isTicket())
-                    {
-                        // Since the failed transaction has a ticket, order
-                        // doesn't matter.  Drop this one.
-                        JLOG(j_.info())
-                            << "Queue is nearly full, and transaction "
-                            << candidateIter->txID << " failed with "
-                            << transToken(txnResult)
-                            << ". Removing ticketed tx from account "
-                            << account.account;
-                        candidateIter = eraseAndAdvance(candidateIter);
-                    }
-                    else
-                    {
-                        // Even though we're giving this transaction another
-                        // chance, chances are it won't recover. To avoid
-                        // making things worse, drop the _last_ transaction for
-                        // this account.
-                        auto dropRIter = account.transactions.rbegin();
-                        assert(
-                            dropRIter->second.account ==
-                            candidateIter->account);
-
-                        JLOG(j_.info())
-                            << "Queue is nearly full, and transaction "
-                            << candidateIter->txID << " failed with "
-                            << transToken(txnResult)
-                            << ". Removing last item from account "
-                            << account.account;
-                        auto endIter = byFee_.iterator_to(dropRIter->second);
-                        if (endIter != candidateIter)
-                            erase(endIter);
-                        ++candidateIter;
-                    }
+                    // Since the failed transaction has a ticket, order
+                    // doesn't matter.  Drop this one.
+                    JLOG(j_.info())
+                        << "Queue is nearly full, and transaction "
+                        << candidateIter->txID << " failed with "
+                        << transToken(txnResult)
+                        << ". Removing ticketed tx from account "
+                        << account.account;
+                    candidateIter = eraseAndAdvance(candidateIter);
                 }
                 else
+                {
+                    // Even though we're giving this transaction another
+                    // chance, chances are it won't recover. To avoid
+                    // making things worse, drop the _last_ transaction for
+                    // this account.
+                    auto dropRIter = account.transactions.rbegin();
+                    assert(dropRIter->second.account == candidateIter->account);
+
+                    JLOG(j_.info())
+                        << "Queue is nearly full, and transaction "
+                        << candidateIter->txID << " failed with "
+                        << transToken(txnResult)
+                        << ". Removing last item from account "
+                        << account.account;
+                    auto endIter = byFee_.iterator_to(dropRIter->second);
+                    if (endIter != candidateIter)
+                        erase(endIter);
                     ++candidateIter;
+                }
             }
-        }
-        else
-        {
-            break;
+            else
+                ++candidateIter;
         }
     }
 
@@ -1643,6 +1668,32 @@ TxQ::nextQueuableSeqImpl(
     return attempt;
 }
 
+void
+TxQ::publishMetrics(std::lock_guard<std::mutex> const&)
+{
+    std::atomic_store(
+        &publishedMetrics_,
+        std::make_shared<FeeMetrics::Snapshot const>(
+            feeMetrics_.getSnapshot()));
+}
+
+TxQ::FeeMetrics::Snapshot
+TxQ::publishedMetrics() const
+{
+    return *std::atomic_load(&publishedMetrics_);
+}
+
+void
+TxQ::publishQueueState(std::lock_guard<std::mutex> const&)
+{
+    publishedTxCount_.store(byFee_.size());
+    publishedMaxSize_.store(
+        maxSize_.value_or(std::numeric_limits<std::size_t>::max()));
+    publishedMinLevel_.store(
+        (isFull() ? byFee_.rbegin()->feeLevel + FeeLevel64{1} : baseLevel)
+            .value());
+}
+
 FeeLevel64
 TxQ::getRequiredFeeLevel(
     OpenView& view,
@@ -1676,11 +1727,10 @@ TxQ::tryDirectApply(
     if (txSeqProx.isSeq() && txSeqProx != acctSeqProx)
         return {};
 
-    FeeLevel64 const requiredFeeLevel = [this, &view, flags]() {
-        std::lock_guard lock(mutex_);
-        return getRequiredFeeLevel(
-            view, flags, feeMetrics_.getSnapshot(), lock);
-    }();
+    // Most transactions either go straight into the open ledger or not
+    // at all, so don't contend on mutex_ just to find out which.
+    FeeLevel64 const requiredFeeLevel =
+        FeeMetrics::scaleFeeLevel(publishedMetrics(), view);
 
     // If the transaction's fee is high enough we may be able to put the
     // transaction straight into the ledger.
@@ -1716,6 +1766,7 @@ TxQ::tryDirectApply(
                     existingIter != txQAcct.transactions.end())
                 {
                     removeFromByFee(existingIter, tx);
+                    publishQueueState(lock);
                 }
             }
         }
@@ -1749,17 +1800,16 @@ TxQ::getMetrics(OpenView const& view) const
 {
     Metrics result;
 
-    std::lock_guard lock(mutex_);
-
-    auto const snapshot = feeMetrics_.getSnapshot();
+    auto const snapshot = publishedMetrics();
 
-    result.txCount = byFee_.size();
-    result.txQMaxSize = maxSize_;
+    result.txCount = publishedTxCount_.load();
+    if (auto const maxSize = publishedMaxSize_.load();
+        maxSize != std::numeric_limits<std::size_t>::max())
+        result.txQMaxSize = maxSize;
     result.txInLedger = view.txCount();
     result.txPerLedger = snapshot.txnsExpected;
     result.referenceFeeLevel = baseLevel;
-    result.minProcessingFeeLevel =
-        isFull() ? byFee_.rbegin()->feeLevel + FeeLevel64{1} : baseLevel;
+    result.minProcessingFeeLevel = FeeLevel64{publishedMinLevel_.load()};
     result.medFeeLevel = snapshot.escalationMultiplier;
     result.openLedgerFeeLevel = FeeMetrics::scaleFeeLevel(snapshot, view);
 
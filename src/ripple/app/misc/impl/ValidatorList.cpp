@@ -939,6 +939,24 @@ ValidatorList::applyLists(
             version) != 1)
         return PublisherListStats{ListDisposition::unsupported_version};
 
+    // Check signatures and parse the lists of trusted publishers before
+    // taking the lock, so that doesn't hold up everything else
+    for (auto const& blobInfo : blobs)
+    {
+        auto const m = deserializeManifest(base64_decode(
+            blobInfo.manifest ? *blobInfo.manifest : manifest));
+        if (!m || !m->signingKey)
+            continue;
+
+        {
+            std::shared_lock read_lock{mutex_};
+            if (!publisherLists_.count(m->masterKey))
+                continue;
+        }
+
+        verifyBlob(*m->signingKey, blobInfo.blob, blobInfo.signature);
+    }
+
     std::lock_guard lock{mutex_};
 
     PublisherListStats result;
@@ -1309,14 +1327,11 @@ ValidatorList::verify(
     if (revoked || !signingKey || result == ManifestDisposition::invalid)
         return {ListDisposition::untrusted, masterPubKey};
 
-    auto const sig = strUnHex(signature);
-    auto const data = base64_decode(blob);
-    if (!sig || !ripple::verify(*signingKey, makeSlice(data), makeSlice(*sig)))
+    auto const verified = verifyBlob(*signingKey, blob, signature);
+    if (!verified)
         return {ListDisposition::invalid, masterPubKey};
 
-    Json::Reader r;
-    if (!r.parse(data, list))
-        return {ListDisposition::invalid, masterPubKey};
+    list = *verified;
 
     if (list.isMember(jss::sequence) && list[jss::sequence].isInt() &&
         list.isMember(jss::expiration) && list[jss::expiration].isInt() &&
@@ -1366,6 +1381,41 @@ ValidatorList::verify(
     return {ListDisposition::accepted, masterPubKey};
 }
 
+std::shared_ptr<Json::Value const>
+ValidatorList::verifyBlob(
+    PublicKey const& signingKey,
+    std::string const& blob,
+    std::string const& signature)
+{
+    auto const key = sha512Half(signingKey, blob, signature);
+
+    {
+        std::lock_guard lock{verifiedMutex_};
+        if (auto const it = verifiedLists_.find(key);
+            it != verifiedLists_.end())
+            return it->second;
+    }
+
+    auto const sig = strUnHex(signature);
+    auto const data = base64_decode(blob);
+    if (!sig || !ripple::verify(signingKey, makeSlice(data), makeSlice(*sig)))
+        return {};
+
+    auto list = std::make_shared<Json::Value>();
+    Json::Reader r;
+    if (!r.parse(data, *list))
+        return {};
+
+    std::lock_guard lock{verifiedMutex_};
+
+    // Only trusted publishers can sign lists, so this fills slowly; start
+    // over rather than track which entries are stale.
+    if (verifiedLists_.size() >= maxVerifiedLists)
+        verifiedLists_.clear();
+
+    return verifiedLists_.emplace(key, std::move(list)).first->second;
+}
+
 bool
 ValidatorList::listed(PublicKey const& identity) const
 {
@@ -23,16 +23,16 @@
 #include "ripple/app/misc/AMMHelpers.h"
 #include "ripple/app/misc/AMMUtils.h"
 #include "ripple/app/paths/AMMContext.h"
+#include "ripple/app/paths/AMMOffer.h"
 #include "ripple/basics/Log.h"
 #include "ripple/ledger/ReadView.h"
 #include "ripple/ledger/View.h"
 #include "ripple/protocol/Quality.h"
 #include "ripple/protocol/STLedgerEntry.h"
 
-namespace ripple {
+#include <deque>
 
-template <typename TIn, typename TOut>
-class AMMOffer;
+namespace ripple {
 
 /** AMMLiquidity class provides AMM offers to BookStep class.
  * The offers are generated in two ways. If there are multiple
@@ -62,6 +62,22 @@ private:
     TAmounts<TIn, TOut> const initialBalances_;
     beast::Journal const j_;
 
+    // An offer generated for given pool balances. BookStep asks for the
+    // offer at the same balances several times per strand, and each strand
+    // of a payment asks again, so the last few offers generated are kept
+    // for the lifetime of the payment.
+    struct GeneratedOffer
+    {
+        TAmounts<TIn, TOut> balances;
+        std::optional<Quality> clobQuality;
+        std::uint16_t iterations;
+        bool multiPath;
+        Number::rounding_mode mode;
+        std::optional<AMMOffer<TIn, TOut>> offer;
+    };
+    static constexpr std::size_t maxGeneratedOffers = 4;
+    std::deque<GeneratedOffer> mutable generated_;
+
 public:
     AMMLiquidity(
         ReadView const& view,
@@ -141,6 +157,14 @@ private:
      */
     AMMOffer<TIn, TOut>
     maxOffer(TAmounts<TIn, TOut> const& balances) const;
+
+    /** Generate the offer for the current balances, which getOffer()
+     * checked aren't frozen and allow for an offer.
+     */
+    std::optional<AMMOffer<TIn, TOut>>
+    generateOffer(
+        TAmounts<TIn, TOut> const& balances,
+        std::optional<Quality> const& clobQuality) const;
 };
 
 }  // namespace ripple
@@ -28,6 +28,8 @@
 #include <ripple/basics/Log.h>
 #include <ripple/beast/core/LexicalCast.h>
 #include <ripple/core/Config.h>
+#include <ripple/core/JobTypes.h>
+#include <ripple/core/ParallelFor.h>
 #include <ripple/net/RPCErr.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/protocol/UintTypes.h>
@@ -143,10 +145,30 @@ PathRequest::needsUpdate(bool newOnly, LedgerIndex index)
         return false;
     }
 
+    if (mLastIndex != 0 && lastCost_ > updateBudget_)
+    {
+        // Spread the cost of an expensive request over several ledgers,
+        // so that it doesn't hold up the others
+        auto const interval = std::min(
+            static_cast<LedgerIndex>(
+                (lastCost_ + updateBudget_ - std::chrono::nanoseconds{1}) /
+                updateBudget_),
+            maxUpdateInterval_);
+        if (index < mLastIndex + interval)
+            return false;
+    }
+
     mInProgress = true;
     return true;
 }
 
+std::chrono::steady_clock::time_point
+PathRequest::lastFullReply()
+{
+    std::lock_guard sl(mIndexLock);
+    return lastFullReply_;
+}
+
 bool
 PathRequest::hasCompletion()
 {
@@ -520,36 +542,43 @@ PathRequest::findPaths(
     }
 
     auto const dst_amount = convertAmount(saDstAmount, convert_all_);
-    hash_map<Currency, std::unique_ptr<Pathfinder>> currency_map;
-    for (auto const& issue : sourceCurrencies)
-    {
-        if (continueCallback && !continueCallback())
-            break;
-        JLOG(m_journal.debug())
-            << iIdentifier
-            << " Trying to find paths: " << STAmount(issue, 1).getFullText();
-
-        auto& pathfinder = getPathFinder(
-            cache,
-            currency_map,
-            issue.currency,
-            dst_amount,
-            level,
-            continueCallback);
+
+    std::vector<Issue> const issues(
+        sourceCurrencies.begin(), sourceCurrencies.end());
+    std::vector<std::optional<Json::Value>> entries(issues.size());
+    for (auto const& issue : issues)
+        mContext.emplace(issue, STPathSet{});
+
+    // The time spent searching, summed over all of the threads
+    std::atomic<std::chrono::steady_clock::rep> searchTime = 0;
+    std::function<bool(void)> const withinBudget = [&]() {
+        if (searchTime.load() >=
+            std::chrono::steady_clock::duration(
+                RPC::Tuning::maxPathfindSearchTime)
+                .count())
+            return false;
+        return !continueCallback || continueCallback();
+    };
+
+    auto findIssuePaths = [&](std::size_t index,
+                              std::unique_ptr<Pathfinder> const& pathfinder) {
+        auto const& issue = issues[index];
         if (!pathfinder)
         {
             JLOG(m_journal.debug()) << iIdentifier << " No paths found";
-            continue;
+            return;
         }
 
+        // Every issue has an entry already, so this doesn't modify the map
+        auto& context = mContext.at(issue);
         STPath fullLiquidityPath;
         auto ps = pathfinder->getBestPaths(
             max_paths_,
             fullLiquidityPath,
-            mContext[issue],
+            context,
             issue.account,
-            continueCallback);
-        mContext[issue] = ps;
+            withinBudget);
+        context = ps;
 
         auto const& sourceAccount = [&] {
             if (!isXRP(issue.account))
@@ -634,21 +663,82 @@ PathRequest::findPaths(
                 jvEntry[jss::paths_canonical] = Json::arrayValue;
             }
 
-            jvArray.append(jvEntry);
+            entries[index] = std::move(jvEntry);
         }
         else
         {
             JLOG(m_journal.debug()) << iIdentifier << " rippleCalc returns "
                                     << transHuman(rc.result());
         }
+    };
+
+    // The issues are sorted by currency, and the issues of a currency share
+    // one Pathfinder, so each run of a currency is searched in turn while the
+    // runs are searched concurrently.
+    std::vector<std::size_t> runs;
+    for (std::size_t i = 0; i < issues.size(); ++i)
+    {
+        if (i == 0 || issues[i].currency != issues[i - 1].currency)
+            runs.push_back(i);
+    }
+
+    // Only share the work out while the client's resource use is ok
+    std::size_t const helpers = consumer_.disposition() == Resource::ok
+        ? JobTypes::instance().get(jtPATH_UPDATE).limit()
+        : 0;
+
+    parallelFor(
+        app_.getJobQueue(),
+        jtPATH_UPDATE,
+        "PathRequest::findPaths",
+        runs.size(),
+        helpers,
+        [&](std::size_t run) {
+            auto const start = std::chrono::steady_clock::now();
+            auto const end =
+                (run + 1 < runs.size()) ? runs[run + 1] : issues.size();
+
+            hash_map<Currency, std::unique_ptr<Pathfinder>> currency_map;
+            for (auto index = runs[run]; index < end; ++index)
+            {
+                if (!withinBudget())
+                    break;
+                JLOG(m_journal.debug())
+                    << iIdentifier << " Trying to find paths: "
+                    << STAmount(issues[index], 1).getFullText();
+
+                auto& pathfinder = getPathFinder(
+                    cache,
+                    currency_map,
+                    issues[index].currency,
+                    dst_amount,
+                    level,
+                    withinBudget);
+                findIssuePaths(index, pathfinder);
+            }
+
+            searchTime += (std::chrono::steady_clock::now() - start).count();
+            return withinBudget();
+        });
+
+    for (auto& entry : entries)
+    {
+        if (entry)
+            jvArray.append(std::move(*entry));
     }
 
-    /*  The resource fee is based on the number of source currencies used.
-        The minimum cost is 50 and the maximum is 400. The cost increases
-        after four source currencies, 50 - (4 * 4) = 34.
+    /*  The resource fee is based on the number of source currencies used,
+        plus one for every 10ms spent searching. The minimum cost is 50 and
+        the maximum is 400. The cost increases after four source currencies,
+        50 - (4 * 4) = 34.
     */
     int const size = sourceCurrencies.size();
-    consumer_.charge({std::clamp(size * size + 34, 50, 400), "path update"});
+    auto const searchMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                              std::chrono::steady_clock::duration(searchTime))
+                              .count();
+    int const cost = size * size + 34 +
+        static_cast<int>(std::min<std::int64_t>(searchMs / 10, 400));
+    consumer_.charge({std::clamp(cost, 50, 400), "path update"});
     return true;
 }
 
@@ -662,6 +752,8 @@ PathRequest::doUpdate(
     JLOG(m_journal.debug())
         << iIdentifier << " update " << (fast ? "fast" : "normal");
 
+    auto const start = steady_clock::now();
+
     {
         std::lock_guard sl(mLock);
 
@@ -752,6 +844,14 @@ PathRequest::doUpdate(
         jvStatus = newStatus;
     }
 
+    if (!fast)
+    {
+        std::lock_guard sl(mIndexLock);
+        mLastIndex = cache->getLedger()->seq();
+        lastFullReply_ = steady_clock::now();
+        lastCost_ = lastFullReply_ - start;
+    }
+
     JLOG(m_journal.debug())
         << iIdentifier << " update finished " << (fast ? "fast" : "normal");
     return newStatus;
@@ -26,6 +26,7 @@
 #include <ripple/json/json_value.h>
 #include <ripple/net/InfoSub.h>
 #include <ripple/protocol/UintTypes.h>
+#include <chrono>
 #include <map>
 #include <mutex>
 #include <optional>
@@ -78,9 +79,19 @@ public:
 
     bool
     isNew();
+
+    /** Whether the request should be updated for the given ledger.
+
+        A request whose last update took longer than its share of
+        processing time is only updated every few ledgers.
+    */
     bool
     needsUpdate(bool newOnly, LedgerIndex index);
 
+    /** When the last full reply was made, or zero if there was none. */
+    std::chrono::steady_clock::time_point
+    lastFullReply();
+
     // Called when the PathRequest update is complete.
     void
     updateComplete();
@@ -160,6 +171,9 @@ private:
     std::recursive_mutex mIndexLock;
     LedgerIndex mLastIndex;
     bool mInProgress;
+    // When the last full update finished, and how long it took
+    std::chrono::steady_clock::time_point lastFullReply_;
+    std::chrono::steady_clock::duration lastCost_{};
 
     int iLevel;
     bool bLastSuccess;
@@ -171,6 +185,12 @@ private:
     std::chrono::steady_clock::time_point full_reply_;
 
     static unsigned int const max_paths_ = 4;
+
+    // The processing time a request may take per ledger, on average
+    static constexpr std::chrono::milliseconds updateBudget_{250};
+
+    // The most ledgers an expensive request waits between updates
+    static constexpr LedgerIndex maxUpdateInterval_ = 8;
 };
 
 }  // namespace ripple
@@ -22,6 +22,8 @@
 #include <ripple/app/paths/PathRequests.h>
 #include <ripple/basics/Log.h>
 #include <ripple/core/JobQueue.h>
+#include <ripple/core/JobTypes.h>
+#include <ripple/core/ParallelFor.h>
 #include <ripple/net/RPCErr.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/protocol/jss.h>
@@ -40,7 +42,7 @@ PathRequests::getLineCache(
 {
     std::lock_guard sl(mLock);
 
-    auto lineCache = lineCache_.lock();
+    auto lineCache = lineCache_;
 
     std::uint32_t const lineSeq = lineCache ? lineCache->getLedger()->seq() : 0;
     std::uint32_t const lgrSeq = ledger->seq();
@@ -53,40 +55,74 @@ PathRequests::getLineCache(
          ((lgrSeq + 8) < lineSeq)) ||  // we jumped way back for some reason
         (lgrSeq > (lineSeq + 8)))      // we jumped way forward for some reason
     {
-        JLOG(mJournal.debug())
-            << "getLineCache creating new cache for " << lgrSeq;
-        // Assign to the local before the member, because the member is a
-        // weak_ptr, and will immediately discard it if there are no other
-        // references.
-        lineCache_ = lineCache = std::make_shared<RippleLineCache>(
-            ledger, app_.journal("RippleLineCache"));
+        if (lineCache && lineCache->canAdvanceTo(*ledger))
+        {
+            JLOG(mJournal.debug())
+                << "getLineCache advancing cache to " << lgrSeq;
+            lineCache = std::make_shared<RippleLineCache>(
+                ledger, *lineCache, app_.journal("RippleLineCache"));
+        }
+        else
+        {
+            JLOG(mJournal.debug())
+                << "getLineCache creating new cache for " << lgrSeq;
+            lineCache = std::make_shared<RippleLineCache>(
+                ledger, app_.journal("RippleLineCache"));
+        }
+
+        // Keep the cache from one ledger to the next, so that it only has
+        // to be refreshed for the accounts whose trust lines changed.
+        lineCache_ = lineCache;
     }
     return lineCache;
 }
 
-void
-PathRequests::updateAll(std::shared_ptr<ReadView const> const& inLedger)
+// Order requests so that those whose last full reply is oldest come first.
+// Requests that haven't had one yet, and those that are gone, lead.
+static void
+oldestFirst(std::vector<PathRequest::wptr>& requests)
 {
-    auto event =
-        app_.getJobQueue().makeLoadEvent(jtPATH_FIND, "PathRequest::updateAll");
-
-    std::vector<PathRequest::wptr> requests;
-    std::shared_ptr<RippleLineCache> cache;
-
-    // Get the ledger and cache we should be using
+    std::vector<std::pair<std::chrono::steady_clock::time_point, std::size_t>>
+        keys;
+    keys.reserve(requests.size());
+    for (std::size_t i = 0; i < requests.size(); ++i)
     {
-        std::lock_guard sl(mLock);
-        requests = requests_;
-        cache = getLineCache(inLedger, true);
+        auto const request = requests[i].lock();
+        keys.emplace_back(
+            request ? request->lastFullReply()
+                    : std::chrono::steady_clock::time_point{},
+            i);
     }
+    std::stable_sort(
+        keys.begin(), keys.end(), [](auto const& a, auto const& b) {
+            return a.first < b.first;
+        });
 
-    bool newRequests = app_.getLedgerMaster().isNewPathRequest();
-    bool mustBreak = false;
+    std::vector<PathRequest::wptr> ordered;
+    ordered.reserve(requests.size());
+    for (auto const& [_, i] : keys)
+        ordered.push_back(std::move(requests[i]));
+    requests = std::move(ordered);
+}
 
-    JLOG(mJournal.trace()) << "updateAll seq=" << cache->getLedger()->seq()
-                           << ", " << requests.size() << " requests";
+// The requests being updated by one pass of updateAll
+struct PathRequests::UpdatePass
+{
+    std::shared_ptr<RippleLineCache> cache;
+    bool newRequests = false;
 
-    int processed = 0, removed = 0;
+    std::atomic<bool> mustBreak = false;
+    std::atomic<int> processed = 0;
+    std::atomic<int> removed = 0;
+};
+
+bool
+PathRequests::updateRequest(
+    UpdatePass& pass,
+    PathRequest::wptr const& wr)
+{
+    if (app_.getJobQueue().isStopping())
+        return false;
 
     auto getSubscriber =
         [](PathRequest::pointer const& request) -> InfoSub::pointer {
@@ -99,93 +135,134 @@ PathRequests::updateAll(std::shared_ptr<ReadView const> const& inLedger)
         return nullptr;
     };
 
-    do
+    auto const& cache = pass.cache;
+    auto request = wr.lock();
+    bool remove = true;
+    JLOG(mJournal.trace())
+        << "updateAll request " << (request ? "" : "not ") << "found";
+
+    if (request)
     {
-        JLOG(mJournal.trace()) << "updateAll looping";
-        for (auto const& wr : requests)
+        auto continueCallback = [&getSubscriber, &request]() {
+            // This callback is used by doUpdate to determine whether to
+            // continue working. If getSubscriber returns null, that
+            // indicates that this request is no longer relevant.
+            return (bool)getSubscriber(request);
+        };
+        if (!request->needsUpdate(pass.newRequests, cache->getLedger()->seq()))
+            remove = false;
+        else
         {
-            if (app_.getJobQueue().isStopping())
-                break;
-
-            auto request = wr.lock();
-            bool remove = true;
-            JLOG(mJournal.trace())
-                << "updateAll request " << (request ? "" : "not ") << "found";
-
-            if (request)
+            if (auto ipSub = getSubscriber(request))
             {
-                auto continueCallback = [&getSubscriber, &request]() {
-                    // This callback is used by doUpdate to determine whether to
-                    // continue working. If getSubscriber returns null, that
-                    // indicates that this request is no longer relevant.
-                    return (bool)getSubscriber(request);
-                };
-                if (!request->needsUpdate(
-                        newRequests, cache->getLedger()->seq()))
-                    remove = false;
-                else
+                if (!ipSub->getConsumer().warn())
                 {
-                    if (auto ipSub = getSubscriber(request))
-                    {
-                        if (!ipSub->getConsumer().warn())
-                        {
-                            // Release the shared ptr to the subscriber so that
-                            // it can be freed if the client disconnects, and
-                            // thus fail to lock later.
-                            ipSub.reset();
-                            Json::Value update = request->doUpdate(
-                                cache, false, continueCallback);
-                            request->updateComplete();
-                            update[jss::type] = "path_find";
-                            if ((ipSub = getSubscriber(request)))
-                            {
-                                ipSub->send(update, false);
-                                remove = false;
-                                ++processed;
-                            }
-                        }
-                    }
-                    else if (request->hasCompletion())
+                    // Release the shared ptr to the subscriber so that
+                    // it can be freed if the client disconnects, and
+                    // thus fail to lock later.
+                    ipSub.reset();
+                    Json::Value update =
+                        request->doUpdate(cache, false, continueCallback);
+                    request->updateComplete();
+                    update[jss::type] = "path_find";
+                    if ((ipSub = getSubscriber(request)))
                     {
-                        // One-shot request with completion function
-                        request->doUpdate(cache, false);
-                        request->updateComplete();
-                        ++processed;
+                        ipSub->send(update, false);
+                        remove = false;
+                        ++pass.processed;
                     }
                 }
             }
-
-            if (remove)
+            else if (request->hasCompletion())
             {
-                std::lock_guard sl(mLock);
-
-                // Remove any dangling weak pointers or weak
-                // pointers that refer to this path request.
-                auto ret = std::remove_if(
-                    requests_.begin(),
-                    requests_.end(),
-                    [&removed, &request](auto const& wl) {
-                        auto r = wl.lock();
-
-                        if (r && r != request)
-                            return false;
-                        ++removed;
-                        return true;
-                    });
-
-                requests_.erase(ret, requests_.end());
+                // One-shot request with completion function
+                request->doUpdate(cache, false);
+                request->updateComplete();
+                ++pass.processed;
             }
+        }
+    }
+
+    if (remove)
+    {
+        std::lock_guard sl(mLock);
+
+        // Remove any dangling weak pointers or weak
+        // pointers that refer to this path request.
+        auto ret = std::remove_if(
+            requests_.begin(),
+            requests_.end(),
+            [&pass, &request](auto const& wl) {
+                auto r = wl.lock();
+
+                if (r && r != request)
+                    return false;
+                ++pass.removed;
+                return true;
+            });
+
+        requests_.erase(ret, requests_.end());
+    }
 
-            mustBreak =
-                !newRequests && app_.getLedgerMaster().isNewPathRequest();
+    // We weren't handling new requests and then
+    // there was a new request
+    if (!pass.newRequests && app_.getLedgerMaster().isNewPathRequest())
+        pass.mustBreak = true;
 
-            // We weren't handling new requests and then
-            // there was a new request
-            if (mustBreak)
-                break;
-        }
+    return !pass.mustBreak;
+}
+
+void
+PathRequests::updateAll(std::shared_ptr<ReadView const> const& inLedger)
+{
+    auto event =
+        app_.getJobQueue().makeLoadEvent(jtPATH_FIND, "PathRequest::updateAll");
+
+    std::vector<PathRequest::wptr> requests;
+    std::shared_ptr<RippleLineCache> cache;
+
+    // Get the ledger and cache we should be using
+    {
+        std::lock_guard sl(mLock);
+        requests = requests_;
+        cache = getLineCache(inLedger, true);
+    }
+    oldestFirst(requests);
+
+    bool newRequests = app_.getLedgerMaster().isNewPathRequest();
 
-        if (mustBreak)
+    JLOG(mJournal.trace()) << "updateAll seq=" << cache->getLedger()->seq()
+                           << ", " << requests.size() << " requests";
+
+    int processed = 0, removed = 0;
+
+    // The requests of each pass are shared out between this thread and as
+    // many helper jobs as the job queue will run at once.
+    auto const helpers = static_cast<std::size_t>(
+        JobTypes::instance().get(jtPATH_UPDATE).limit());
+
+    do
+    {
+        JLOG(mJournal.trace()) << "updateAll looping";
+
+        UpdatePass pass;
+        pass.cache = cache;
+        pass.newRequests = newRequests;
+
+        parallelFor(
+            app_.getJobQueue(),
+            jtPATH_UPDATE,
+            "PathRequest::update",
+            requests.size(),
+            std::min(helpers, requests.size() / 2),
+            [this, &pass, &requests](std::size_t i) {
+                return updateRequest(pass, requests[i]);
+            });
+
+        processed += pass.processed;
+        removed += pass.removed;
+
+        if (pass.mustBreak)
         {  // a new request came in while we were working
             newRequests = true;
         }
@@ -213,8 +290,17 @@ PathRequests::updateAll(std::shared_ptr<ReadView const> const& inLedger)
             lastCache = cache;
             cache = getLineCache(cache->getLedger(), false);
         }
+        oldestFirst(requests);
     } while (!app_.getJobQueue().isStopping());
 
+    // Don't hold on to the ledger once nobody is pathfinding in it
+    std::shared_ptr<RippleLineCache> lastCache;
+    {
+        std::lock_guard sl(mLock);
+        if (requests_.empty())
+            lastCache = std::move(lineCache_);
+    }
+
     JLOG(mJournal.debug()) << "updateAll complete: " << processed
                            << " processed and " << removed << " removed";
 }
@@ -99,9 +99,15 @@ public:
     }
 
 private:
+    struct UpdatePass;
+
     void
     insertPathRequest(PathRequest::pointer const&);
 
+    // Update one request of a pass, returning false if the pass should stop
+    bool
+    updateRequest(UpdatePass& pass, PathRequest::wptr const& request);
+
     Application& app_;
     beast::Journal mJournal;
 
@@ -111,8 +117,9 @@ private:
     // Track all requests
     std::vector<PathRequest::wptr> requests_;
 
-    // Use a RippleLineCache
-    std::weak_ptr<RippleLineCache> lineCache_;
+    // The RippleLineCache for the latest ledger, advanced from one ledger
+    // to the next while there are requests
+    std::shared_ptr<RippleLineCache> lineCache_;
 
     std::atomic<int> mLastIdentifier;
 
@@ -29,6 +29,7 @@
 #include <ripple/core/JobQueue.h>
 #include <ripple/json/to_string.h>
 #include <ripple/ledger/PaymentSandbox.h>
+#include <ripple/ledger/RecordingView.h>
 
 #include <tuple>
 
@@ -156,6 +157,29 @@ smallestUsefulAmount(STAmount const& amount, int maxPaths)
 {
     return divide(amount, STAmount(maxPaths + 2), amount.issue());
 }
+
+// A digest of everything a liquidity computation depends on besides the
+// ledger.
+uint256
+liquidityKey(
+    AccountID const& srcAccount,
+    AccountID const& dstAccount,
+    STAmount const& srcAmount,
+    std::initializer_list<STAmount const*> dstAmounts,
+    bool partialPayment,
+    STPathSet const& pathSet)
+{
+    Serializer s;
+    s.addBitString(srcAccount);
+    s.addBitString(dstAccount);
+    srcAmount.add(s);
+    for (auto const amount : dstAmounts)
+        amount->add(s);
+    s.add8(partialPayment ? 1 : 0);
+    s.add8(pathSet.empty() ? 1 : 0);
+    pathSet.add(s);
+    return s.getSHA512Half();
+}
 }  // namespace
 
 Pathfinder::Pathfinder(
@@ -351,10 +375,28 @@ Pathfinder::getPathLiquidity(
     STPathSet pathSet;
     pathSet.push_back(path);
 
+    auto const key = liquidityKey(
+        mSrcAccount,
+        mDstAccount,
+        mSrcAmount,
+        {&minDstAmount, &mDstAmount},
+        convert_all_,
+        pathSet);
+    if (auto const cached = mRLCache->getLiquidity(key))
+    {
+        if (cached->result == tesSUCCESS)
+        {
+            amountOut = cached->amountOut;
+            qualityOut = cached->quality;
+        }
+        return cached->result;
+    }
+
     path::RippleCalc::Input rcInput;
     rcInput.defaultPathsAllowed = false;
 
-    PaymentSandbox sandbox(&*mLedger, tapNONE);
+    RecordingView recorder(*mLedger);
+    PaymentSandbox sandbox(&recorder, tapNONE);
 
     try
     {
@@ -373,7 +415,13 @@ Pathfinder::getPathLiquidity(
             &rcInput);
         // If we can't get even the minimum liquidity requested, we're done.
         if (rc.result() != tesSUCCESS)
+        {
+            mRLCache->setLiquidity(
+                key,
+                {rc.result(), STAmount{}, STAmount{}, 0},
+                recorder.reads());
             return rc.result();
+        }
 
         qualityOut = getRate(rc.actualAmountOut, rc.actualAmountIn);
         amountOut = rc.actualAmountOut;
@@ -397,6 +445,10 @@ Pathfinder::getPathLiquidity(
                 amountOut += rc.actualAmountOut;
         }
 
+        mRLCache->setLiquidity(
+            key,
+            {tesSUCCESS, STAmount{}, amountOut, qualityOut},
+            recorder.reads());
         return tesSUCCESS;
     }
     catch (std::exception const& e)
@@ -417,30 +469,46 @@ Pathfinder::computePathRanks(
     // Must subtract liquidity in default path from remaining amount.
     try
     {
-        PaymentSandbox sandbox(&*mLedger, tapNONE);
-
-        path::RippleCalc::Input rcInput;
-        rcInput.partialPaymentAllowed = true;
-        auto rc = path::RippleCalc::rippleCalculate(
-            sandbox,
-            mSrcAmount,
-            mRemainingAmount,
-            mDstAccount,
+        auto const key = liquidityKey(
             mSrcAccount,
-            STPathSet(),
-            app_.logs(),
-            &rcInput);
+            mDstAccount,
+            mSrcAmount,
+            {&mRemainingAmount},
+            true,
+            STPathSet());
+        auto liquidity = mRLCache->getLiquidity(key);
+        if (!liquidity)
+        {
+            RecordingView recorder(*mLedger);
+            PaymentSandbox sandbox(&recorder, tapNONE);
+
+            path::RippleCalc::Input rcInput;
+            rcInput.partialPaymentAllowed = true;
+            auto rc = path::RippleCalc::rippleCalculate(
+                sandbox,
+                mSrcAmount,
+                mRemainingAmount,
+                mDstAccount,
+                mSrcAccount,
+                STPathSet(),
+                app_.logs(),
+                &rcInput);
+
+            liquidity.emplace(RippleLineCache::Liquidity{
+                rc.result(), rc.actualAmountIn, rc.actualAmountOut});
+            mRLCache->setLiquidity(key, *liquidity, recorder.reads());
+        }
 
-        if (rc.result() == tesSUCCESS)
+        if (liquidity->result == tesSUCCESS)
         {
             JLOG(j_.debug())
-                << "Default path contributes: " << rc.actualAmountIn;
-            mRemainingAmount -= rc.actualAmountOut;
+                << "Default path contributes: " << liquidity->amountIn;
+            mRemainingAmount -= liquidity->amountOut;
         }
         else
         {
             JLOG(j_.debug())
-                << "Default path fails: " << transToken(rc.result());
+                << "Default path fails: " << transToken(liquidity->result);
         }
     }
     catch (std::exception const&)
@@ -21,8 +21,76 @@
 #include <ripple/app/paths/TrustLine.h>
 #include <ripple/ledger/OpenView.h>
 
+#include <boost/container/flat_set.hpp>
+
+#include <algorithm>
+#include <set>
+
 namespace ripple {
 
+namespace {
+
+// Bounds the memory held by the recorded reads of the cached liquidity.
+constexpr std::size_t maxLiquidityReads = 1 << 20;
+
+// The accounts on either side of every trust line that the transactions in a
+// closed ledger created, modified or deleted.
+boost::container::flat_set<AccountID>
+changedLineAccounts(ReadView const& ledger)
+{
+    boost::container::flat_set<AccountID> accounts;
+
+    for (auto const& [tx, meta] : ledger.txs)
+    {
+        (void)tx;
+        if (!meta || !meta->isFieldPresent(sfAffectedNodes))
+            continue;
+
+        for (auto const& node : meta->getFieldArray(sfAffectedNodes))
+        {
+            if (node.getFieldU16(sfLedgerEntryType) != ltRIPPLE_STATE)
+                continue;
+
+            auto const& fields = node.getFName() == sfCreatedNode
+                ? sfNewFields
+                : sfFinalFields;
+            if (!node.isFieldPresent(fields))
+                continue;
+
+            auto const& inner =
+                static_cast<STObject const&>(node.peekAtField(fields));
+            if (inner.isFieldPresent(sfLowLimit))
+                accounts.insert(inner.getFieldAmount(sfLowLimit).getIssuer());
+            if (inner.isFieldPresent(sfHighLimit))
+                accounts.insert(inner.getFieldAmount(sfHighLimit).getIssuer());
+        }
+    }
+
+    return accounts;
+}
+
+// The keys of every ledger entry that the transactions in a closed ledger
+// created, modified or deleted.
+std::set<uint256>
+changedKeys(ReadView const& ledger)
+{
+    std::set<uint256> keys;
+
+    for (auto const& [tx, meta] : ledger.txs)
+    {
+        (void)tx;
+        if (!meta || !meta->isFieldPresent(sfAffectedNodes))
+            continue;
+
+        for (auto const& node : meta->getFieldArray(sfAffectedNodes))
+            keys.insert(node.getFieldH256(sfLedgerIndex));
+    }
+
+    return keys;
+}
+
+}  // namespace
+
 RippleLineCache::RippleLineCache(
     std::shared_ptr<ReadView const> const& ledger,
     beast::Journal j)
@@ -31,6 +99,52 @@ RippleLineCache::RippleLineCache(
     JLOG(journal_.debug()) << "created for ledger " << ledger_->info().seq;
 }
 
+RippleLineCache::RippleLineCache(
+    std::shared_ptr<ReadView const> const& ledger,
+    RippleLineCache& previous,
+    beast::Journal j)
+    : ledger_(ledger), journal_(j)
+{
+    assert(previous.canAdvanceTo(*ledger_));
+
+    auto const changed = changedLineAccounts(*ledger_);
+
+    std::lock_guard sl(previous.mLock);
+    lines_.reserve(previous.lines_.size());
+    for (auto const& [key, lines] : previous.lines_)
+    {
+        if (changed.count(key.account_))
+            continue;
+        lines_.emplace(key, lines);
+        if (lines)
+            totalLineCount_ += lines->size();
+    }
+
+    // What the payment engine computes also depends on the fees and the
+    // amendments in force, which it doesn't read as ledger entries.
+    auto const keys = changedKeys(*ledger_);
+    if (!keys.count(keylet::fees().key) &&
+        !keys.count(keylet::amendments().key))
+    {
+        for (auto const& [key, entry] : previous.liquidity_)
+        {
+            if (entry.reads.timed || entry.reads.changedBy(keys))
+                continue;
+            liquidity_.emplace(key, entry);
+            totalLiquidityReads_ +=
+                entry.reads.keys.size() + entry.reads.ranges.size();
+        }
+    }
+
+    JLOG(journal_.debug()) << "created for ledger " << ledger_->info().seq
+                           << " from ledger " << previous.ledger_->info().seq
+                           << ", keeping " << lines_.size() << " of "
+                           << previous.lines_.size() << " accounts ("
+                           << changed.size() << " changed) and "
+                           << liquidity_.size() << " of "
+                           << previous.liquidity_.size() << " liquidities";
+}
+
 RippleLineCache::~RippleLineCache()
 {
     JLOG(journal_.debug()) << "destroyed for ledger " << ledger_->info().seq
@@ -125,4 +239,45 @@ RippleLineCache::getRippleLines(
     return it->second;
 }
 
+auto
+RippleLineCache::getLiquidity(uint256 const& key) -> std::optional<Liquidity>
+{
+    std::lock_guard sl(mLock);
+    if (auto const it = liquidity_.find(key); it != liquidity_.end())
+        return it->second.liquidity;
+    return std::nullopt;
+}
+
+void
+RippleLineCache::setLiquidity(
+    uint256 const& key,
+    Liquidity const& liquidity,
+    RecordingView::Reads const& reads)
+{
+    // The same entries are typically read many times over.
+    LiquidityEntry entry{liquidity, reads};
+    auto& keys = entry.reads.keys;
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    keys.shrink_to_fit();
+
+    auto const size = keys.size() + entry.reads.ranges.size();
+
+    std::lock_guard sl(mLock);
+    if (totalLiquidityReads_ + size > maxLiquidityReads)
+        return;
+    if (liquidity_.emplace(key, std::move(entry)).second)
+        totalLiquidityReads_ += size;
+}
+
+bool
+RippleLineCache::canAdvanceTo(ReadView const& ledger) const
+{
+    // The trust lines can only be carried over if every change between the
+    // two ledgers is recorded in the metadata of the later one.
+    return !ledger_->open() && !ledger.open() &&
+        ledger.info().seq == ledger_->info().seq + 1 &&
+        ledger.info().parentHash == ledger_->info().hash;
+}
+
 }  // namespace ripple
@@ -24,10 +24,14 @@
 #include <ripple/app/paths/TrustLine.h>
 #include <ripple/basics/CountedObject.h>
 #include <ripple/basics/hardened_hash.h>
+#include <ripple/ledger/RecordingView.h>
+#include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/TER.h>
 
 #include <cstddef>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <vector>
 
 namespace ripple {
@@ -39,6 +43,24 @@ public:
     explicit RippleLineCache(
         std::shared_ptr<ReadView const> const& l,
         beast::Journal j);
+
+    /** Create a cache for a ledger that directly follows the ledger of
+        another cache.
+
+        The trust lines of every account that is not a party to a trust line
+        created, modified or deleted by the transactions in @ledger are
+        carried over from @previous, so only those accounts need to be read
+        from the ledger again. So is the liquidity found along every path
+        that none of those transactions changed the ledger entries of.
+
+        @param ledger The closed ledger whose parent is @previous's ledger.
+        @param previous The cache to carry trust lines over from.
+    */
+    RippleLineCache(
+        std::shared_ptr<ReadView const> const& ledger,
+        RippleLineCache& previous,
+        beast::Journal j);
+
     ~RippleLineCache();
 
     std::shared_ptr<ReadView const> const&
@@ -62,6 +84,36 @@ public:
     std::shared_ptr<std::vector<PathFindTrustLine>>
     getRippleLines(AccountID const& accountID, LineDirection direction);
 
+    /** The outcome of computing the liquidity along some paths. */
+    struct Liquidity
+    {
+        TER result;
+        STAmount amountIn;
+        STAmount amountOut;
+        std::uint64_t quality = 0;
+    };
+
+    /** Return the liquidity computed earlier for @key, if any. */
+    std::optional<Liquidity>
+    getLiquidity(uint256 const& key);
+
+    /** Remember the liquidity computed for @key.
+
+        @param key A digest of everything the computation depends on
+                   other than the ledger.
+        @param liquidity The outcome of the computation.
+        @param reads What the computation read from the ledger.
+    */
+    void
+    setLiquidity(
+        uint256 const& key,
+        Liquidity const& liquidity,
+        RecordingView::Reads const& reads);
+
+    /** Whether a cache for @ledger can be derived from this one. */
+    bool
+    canAdvanceTo(ReadView const& ledger) const;
+
 private:
     std::mutex mLock;
 
@@ -125,6 +177,15 @@ private:
         AccountKey::Hash>
         lines_;
     std::size_t totalLineCount_ = 0;
+
+    struct LiquidityEntry
+    {
+        Liquidity liquidity;
+        RecordingView::Reads reads;
+    };
+
+    hash_map<uint256, LiquidityEntry> liquidity_;
+    std::size_t totalLiquidityReads_ = 0;
 };
 
 }  // namespace ripple
@@ -159,42 +159,23 @@ AMMLiquidity<TIn, TOut>::getOffer(
     }
 
     auto offer = [&]() -> std::optional<AMMOffer<TIn, TOut>> {
-        try
+        auto const iterations = ammContext_.curIters();
+        auto const multiPath = ammContext_.multiPath();
+        auto const mode = Number::getround();
+        for (auto const& g : generated_)
         {
-            if (ammContext_.multiPath())
-            {
-                auto const amounts = generateFibSeqOffer(balances);
-                if (clobQuality && Quality{amounts} < clobQuality)
-                    return std::nullopt;
-                return AMMOffer<TIn, TOut>(
-                    *this, amounts, std::nullopt, Quality{amounts});
-            }
-            else if (!clobQuality)
-            {
-                // If there is no CLOB to compare against, return the largest
-                // amount, which doesn't overflow. The size is going to be
-                // changed in BookStep per either deliver amount limit, or
-                // sendmax, or available output or input funds.
-                return maxOffer(balances);
-            }
-            else if (
-                auto const amounts =
-                    changeSpotPriceQuality(balances, *clobQuality, tradingFee_))
-            {
-                return AMMOffer<TIn, TOut>(
-                    *this, *amounts, balances, Quality{*amounts});
-            }
+            if (g.balances == balances && g.clobQuality == clobQuality &&
+                g.iterations == iterations && g.multiPath == multiPath &&
+                g.mode == mode)
+                return g.offer;
         }
-        catch (std::overflow_error const& e)
-        {
-            JLOG(j_.error()) << "AMMLiquidity::getOffer overflow " << e.what();
-            return maxOffer(balances);
-        }
-        catch (std::exception const& e)
-        {
-            JLOG(j_.error()) << "AMMLiquidity::getOffer exception " << e.what();
-        }
-        return std::nullopt;
+
+        auto generated = generateOffer(balances, clobQuality);
+        if (generated_.size() == maxGeneratedOffers)
+            generated_.pop_front();
+        generated_.push_back(
+            {balances, clobQuality, iterations, multiPath, mode, generated});
+        return generated;
     }();
 
     if (offer)
@@ -215,6 +196,50 @@ AMMLiquidity<TIn, TOut>::getOffer(
     return std::nullopt;
 }
 
+template <typename TIn, typename TOut>
+std::optional<AMMOffer<TIn, TOut>>
+AMMLiquidity<TIn, TOut>::generateOffer(
+    TAmounts<TIn, TOut> const& balances,
+    std::optional<Quality> const& clobQuality) const
+{
+    try
+    {
+        if (ammContext_.multiPath())
+        {
+            auto const amounts = generateFibSeqOffer(balances);
+            if (clobQuality && Quality{amounts} < clobQuality)
+                return std::nullopt;
+            return AMMOffer<TIn, TOut>(
+                *this, amounts, std::nullopt, Quality{amounts});
+        }
+        else if (!clobQuality)
+        {
+            // If there is no CLOB to compare against, return the largest
+            // amount, which doesn't overflow. The size is going to be
+            // changed in BookStep per either deliver amount limit, or
+            // sendmax, or available output or input funds.
+            return maxOffer(balances);
+        }
+        else if (
+            auto const amounts =
+                changeSpotPriceQuality(balances, *clobQuality, tradingFee_))
+        {
+            return AMMOffer<TIn, TOut>(
+                *this, *amounts, balances, Quality{*amounts});
+        }
+    }
+    catch (std::overflow_error const& e)
+    {
+        JLOG(j_.error()) << "AMMLiquidity::getOffer overflow " << e.what();
+        return maxOffer(balances);
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.error()) << "AMMLiquidity::getOffer exception " << e.what();
+    }
+    return std::nullopt;
+}
+
 template class AMMLiquidity<STAmount, STAmount>;
 template class AMMLiquidity<IOUAmount, IOUAmount>;
 template class AMMLiquidity<XRPAmount, IOUAmount>;
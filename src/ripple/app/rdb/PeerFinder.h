@@ -54,12 +54,13 @@ updatePeerFinderDB(
  * @brief readPeerFinderDB Reads all entries from the peer finder database and
  *        invokes the given callback for each entry.
  * @param session Session with the database.
- * @param func Callback to invoke for each entry.
+ * @param func Callback to invoke for each entry with the address, the
+ *        valence and the handshake latency in milliseconds.
  */
 void
 readPeerFinderDB(
     soci::session& session,
-    std::function<void(std::string const&, int)> const& func);
+    std::function<void(std::string const&, int, int)> const& func);
 
 /**
  * @brief savePeerFinderDB Saves a new entry to the peer finder database.
@@ -272,6 +272,17 @@ public:
         std::optional<ClosedInterval<uint32_t>> const& range,
         error_code_i& ec) = 0;
 
+    /**
+     * @brief getTransactionIdByIndex Returns the ID of the transaction at
+     *        the given position of a validated ledger, if the position is
+     *        recorded by the transaction index.
+     * @param ledgerSeq Sequence of the ledger.
+     * @param txnIndex Index of the transaction within the ledger.
+     * @return The transaction ID if found, otherwise no value.
+     */
+    virtual std::optional<uint256>
+    getTransactionIdByIndex(LedgerIndex ledgerSeq, std::uint32_t txnIndex) = 0;
+
     /**
      * @brief getKBUsedAll Returns the amount of space used by all databases.
      * @return Space in kilobytes.
@@ -0,0 +1,130 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_RDB_BACKEND_DETAIL_ACCOUNTTXINDEX_H_INCLUDED
+#define RIPPLE_APP_RDB_BACKEND_DETAIL_ACCOUNTTXINDEX_H_INCLUDED
+
+#include <ripple/basics/BasicConfig.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/protocol/AccountID.h>
+#include <ripple/protocol/Protocol.h>
+#include <boost/filesystem.hpp>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+namespace detail {
+
+/** An ordered index of the transactions that affected each account.
+
+    This takes the place of the AccountTransactions table. Entries are
+    kept sorted by (account, ledger sequence, transaction sequence) so that
+    a page of account_tx results is found with one seek and a short scan,
+    no matter how many transactions the account has. The transactions
+    themselves are still read from the Transactions table.
+*/
+class AccountTxIndex
+{
+public:
+    /** A position in an account's transaction history. */
+    struct Entry
+    {
+        LedgerIndex ledgerSeq;
+        std::uint32_t txnSeq;
+        uint256 txID;
+    };
+
+    /** A transaction of a ledger and one of the accounts it affected. */
+    struct Affected
+    {
+        AccountID account;
+        std::uint32_t txnSeq;
+        uint256 txID;
+    };
+
+    virtual ~AccountTxIndex() = default;
+
+    /** Record the transactions of a validated ledger.
+
+        Any entries already recorded for the ledger are replaced.
+    */
+    virtual void
+    insert(LedgerIndex ledgerSeq, std::vector<Affected> const& affected) = 0;
+
+    /** Return entries of an account in ledger sequence order.
+
+        @param account The account whose history to search.
+        @param minLedger The lowest ledger sequence to return.
+        @param maxLedger The highest ledger sequence to return.
+        @param from If set, the (ledger sequence, transaction sequence) to
+                    start the search at, inclusive. It takes the place of
+                    minLedger when searching forward and of maxLedger when
+                    searching backward.
+        @param forward True for ascending order, false for descending.
+        @param limit The largest number of entries to return.
+    */
+    virtual std::vector<Entry>
+    find(
+        AccountID const& account,
+        LedgerIndex minLedger,
+        LedgerIndex maxLedger,
+        std::optional<std::pair<LedgerIndex, std::uint32_t>> const& from,
+        bool forward,
+        std::size_t limit) = 0;
+
+    /** Remove the entries of one ledger. */
+    virtual void
+    erase(LedgerIndex ledgerSeq) = 0;
+
+    /** Remove the entries of every ledger before the given one. */
+    virtual void
+    eraseBefore(LedgerIndex ledgerSeq) = 0;
+
+    /** Return the lowest ledger sequence with an entry, if any. */
+    virtual std::optional<LedgerIndex>
+    minLedgerSeq() = 0;
+
+    /** Return the number of entries. This may be an estimate. */
+    virtual std::size_t
+    size() = 0;
+};
+
+/** Create the account transaction index described by a config section.
+
+    The section's `type` selects the implementation: `rocksdb` for an
+    on-disk index or `memory` for one that lives only as long as the
+    process. The on-disk index is kept under `path`, or under the given
+    directory if the section does not name one.
+
+    @throws std::runtime_error if the index can't be created.
+*/
+std::unique_ptr<AccountTxIndex>
+makeAccountTxIndex(
+    Section const& section,
+    boost::filesystem::path const& defaultPath,
+    beast::Journal j);
+
+}  // namespace detail
+}  // namespace ripple
+
+#endif
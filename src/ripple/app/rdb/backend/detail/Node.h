@@ -23,6 +23,8 @@
 #include <ripple/app/ledger/Ledger.h>
 #include <ripple/app/misc/Manifest.h>
 #include <ripple/app/rdb/RelationalDatabase.h>
+#include <ripple/app/rdb/backend/detail/AccountTxIndex.h>
+#include <ripple/app/rdb/backend/detail/TxIndex.h>
 #include <ripple/core/Config.h>
 #include <ripple/overlay/PeerReservationTable.h>
 #include <ripple/peerfinder/impl/Store.h>
@@ -120,6 +122,22 @@ getRows(soci::session& session, TableType type);
 RelationalDatabase::CountMinMax
 getRowsMinMax(soci::session& session, TableType type);
 
+/**
+ * @brief migrateAccountTransactions Moves the rows of the
+ *        AccountTransactions table into an account transaction index, a
+ *        range of ledgers at a time. Each range is deleted from the table
+ *        once the index holds it, so an interrupted migration resumes
+ *        where it stopped.
+ * @param session Session with the transaction database.
+ * @param index The index to move the rows into.
+ * @param j Journal to report progress to.
+ */
+void
+migrateAccountTransactions(
+    soci::session& session,
+    AccountTxIndex& index,
+    beast::Journal j);
+
 /**
  * @brief saveValidatedLedger Saves ledger into database.
  * @param lgrDB Link to ledgers database.
@@ -127,6 +145,11 @@ getRowsMinMax(soci::session& session, TableType type);
  * @param app Application object.
  * @param ledger The ledger.
  * @param current True if ledger is current.
+ * @param accountTxIndex If set, the index which records the accounts
+ *        affected by each transaction in place of the AccountTransactions
+ *        table.
+ * @param txIndex If set, the index which records each transaction by ID
+ *        alongside the Transactions table.
  * @return True is saving was successfull.
  */
 bool
@@ -135,7 +158,9 @@ saveValidatedLedger(
     DatabaseCon& txnDB,
     Application& app,
     std::shared_ptr<Ledger const> const& ledger,
-    bool current);
+    bool current,
+    AccountTxIndex* accountTxIndex = nullptr,
+    TxIndex* txIndex = nullptr);
 
 /**
  * @brief getLedgerInfoByIndex Returns ledger by its sequence.
@@ -388,7 +413,7 @@ getNewestAccountTxsB(
  * @brief oldestAccountTxPage Searches oldest transactions for given
  *        account which match given criteria starting from given marker
  *        and calls callback for each found transaction.
- * @param session Session with database.
+ * @param statements Prepared statements for the database.
  * @param onUnsavedLedger Callback function to call on each found unsaved
  *        ledger within given range.
  * @param onTransaction Callback function to call on each found transaction.
@@ -406,7 +431,7 @@ getNewestAccountTxsB(
  */
 std::pair<std::optional<RelationalDatabase::AccountTxMarker>, int>
 oldestAccountTxPage(
-    soci::session& session,
+    SQLiteStatements& statements,
     std::function<void(std::uint32_t)> const& onUnsavedLedger,
     std::function<
         void(std::uint32_t, std::string const&, Blob&&, Blob&&)> const&
@@ -419,7 +444,7 @@ oldestAccountTxPage(
  * @brief newestAccountTxPage Searches newest transactions for given
  *        account which match given criteria starting from given marker
  *        and calls callback for each found transaction.
- * @param session Session with database.
+ * @param statements Prepared statements for the database.
  * @param onUnsavedLedger Callback function to call on each found unsaved
  *        ledger within given range.
  * @param onTransaction Callback function to call on each found transaction.
@@ -437,7 +462,7 @@ oldestAccountTxPage(
  */
 std::pair<std::optional<RelationalDatabase::AccountTxMarker>, int>
 newestAccountTxPage(
-    soci::session& session,
+    SQLiteStatements& statements,
     std::function<void(std::uint32_t)> const& onUnsavedLedger,
     std::function<
         void(std::uint32_t, std::string const&, Blob&&, Blob&&)> const&
@@ -446,6 +471,37 @@ newestAccountTxPage(
     int limit_used,
     std::uint32_t page_length);
 
+/**
+ * @brief accountTxPage Searches the oldest or newest transactions for the
+ *        account that match the given criteria using an account
+ *        transaction index, starting from the provided marker, and calls
+ *        the callback for each found transaction.
+ * @param statements Prepared statements for the transaction database.
+ * @param index Index of the transactions affecting each account.
+ * @param onUnsavedLedger Callback function to call on each found unsaved
+ *        ledger within given range.
+ * @param onTransaction Callback function to call on each found transaction.
+ * @param options Struct AccountTxPageOptions which contain criteria to
+ *        match: the account, minimum and maximum ledger numbers to search,
+ *        marker of first returned entry, number of transactions to return,
+ *        flag if this number unlimited.
+ * @param page_length Total number of transactions to return.
+ * @param forward True for ascending order, false for descending.
+ * @return Marker for the next search if the search is not finished, and
+ *         the number of transactions processed during this call.
+ */
+std::pair<std::optional<RelationalDatabase::AccountTxMarker>, int>
+accountTxPage(
+    SQLiteStatements& statements,
+    AccountTxIndex& index,
+    std::function<void(std::uint32_t)> const& onUnsavedLedger,
+    std::function<
+        void(std::uint32_t, std::string const&, Blob&&, Blob&&)> const&
+        onTransaction,
+    RelationalDatabase::AccountTxPageOptions const& options,
+    std::uint32_t page_length,
+    bool forward);
+
 /**
  * @brief getTransaction Returns transaction with given hash. If not found
  *        and range given then check if all ledgers from the range are
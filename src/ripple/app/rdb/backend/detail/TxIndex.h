@@ -0,0 +1,101 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_RDB_BACKEND_DETAIL_TXINDEX_H_INCLUDED
+#define RIPPLE_APP_RDB_BACKEND_DETAIL_TXINDEX_H_INCLUDED
+
+#include <ripple/basics/BasicConfig.h>
+#include <ripple/basics/Blob.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/protocol/Protocol.h>
+#include <boost/filesystem.hpp>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace ripple {
+namespace detail {
+
+/** An index of validated transactions by their ID.
+
+    Each entry holds the ledger and position of a transaction along with
+    the transaction and its metadata, so a lookup by ID is a single read
+    that needs neither the Transactions table nor the ledger's SHAMap.
+    Entries can also be found by (ledger sequence, transaction index),
+    which is what a CTID names.
+*/
+class TxIndex
+{
+public:
+    /** A transaction as it was recorded. */
+    struct Entry
+    {
+        uint256 txID;
+        LedgerIndex ledgerSeq;
+        std::uint32_t txnSeq;
+        Blob rawTxn;
+        Blob rawMeta;
+    };
+
+    virtual ~TxIndex() = default;
+
+    /** Record the transactions of a validated ledger.
+
+        Any entries already recorded for the ledger are replaced. Every
+        entry must have the given ledger sequence.
+    */
+    virtual void
+    insert(LedgerIndex ledgerSeq, std::vector<Entry> const& entries) = 0;
+
+    /** Return the entry of a transaction, if any. */
+    virtual std::optional<Entry>
+    find(uint256 const& txID) = 0;
+
+    /** Return the ID of the transaction at a position in a ledger. */
+    virtual std::optional<uint256>
+    find(LedgerIndex ledgerSeq, std::uint32_t txnSeq) = 0;
+
+    /** Remove the entries of one ledger. */
+    virtual void
+    erase(LedgerIndex ledgerSeq) = 0;
+
+    /** Remove the entries of every ledger before the given one. */
+    virtual void
+    eraseBefore(LedgerIndex ledgerSeq) = 0;
+};
+
+/** Create the transaction index described by a config section.
+
+    The section's `type` selects the implementation, as for
+    makeAccountTxIndex.
+
+    @throws std::runtime_error if the index can't be created.
+*/
+std::unique_ptr<TxIndex>
+makeTxIndex(
+    Section const& section,
+    boost::filesystem::path const& defaultPath,
+    beast::Journal j);
+
+}  // namespace detail
+}  // namespace ripple
+
+#endif
@@ -0,0 +1,438 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/rdb/backend/detail/AccountTxIndex.h>
+#include <ripple/basics/ByteUtilities.h>
+#include <ripple/basics/contract.h>
+#include <ripple/unity/rocksdb.h>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/endian/conversion.hpp>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace ripple {
+namespace detail {
+
+namespace {
+
+/** An index kept in memory, for tests and standalone use. */
+class MemoryAccountTxIndex final : public AccountTxIndex
+{
+    using Key = std::tuple<AccountID, LedgerIndex, std::uint32_t>;
+
+    std::mutex mutex_;
+    std::map<Key, uint256> byAccount_;
+    std::map<LedgerIndex, std::vector<Key>> byLedger_;
+
+    void
+    eraseLedger(std::map<LedgerIndex, std::vector<Key>>::iterator it)
+    {
+        for (auto const& key : it->second)
+            byAccount_.erase(key);
+        byLedger_.erase(it);
+    }
+
+public:
+    void
+    insert(LedgerIndex ledgerSeq, std::vector<Affected> const& affected)
+        override
+    {
+        std::lock_guard lock(mutex_);
+
+        if (auto it = byLedger_.find(ledgerSeq); it != byLedger_.end())
+            eraseLedger(it);
+
+        auto& keys = byLedger_[ledgerSeq];
+        keys.reserve(affected.size());
+        for (auto const& a : affected)
+        {
+            Key key{a.account, ledgerSeq, a.txnSeq};
+            byAccount_[key] = a.txID;
+            keys.push_back(std::move(key));
+        }
+    }
+
+    std::vector<Entry>
+    find(
+        AccountID const& account,
+        LedgerIndex minLedger,
+        LedgerIndex maxLedger,
+        std::optional<std::pair<LedgerIndex, std::uint32_t>> const& from,
+        bool forward,
+        std::size_t limit) override
+    {
+        std::vector<Entry> ret;
+
+        std::lock_guard lock(mutex_);
+
+        if (forward)
+        {
+            auto it = byAccount_.lower_bound(
+                from ? Key{account, from->first, from->second}
+                     : Key{account, minLedger, 0});
+            for (; it != byAccount_.end() && ret.size() < limit; ++it)
+            {
+                auto const& [acct, seq, txnSeq] = it->first;
+                if (acct != account || seq > maxLedger)
+                    break;
+                ret.push_back({seq, txnSeq, it->second});
+            }
+        }
+        else
+        {
+            auto it = std::make_reverse_iterator(byAccount_.upper_bound(
+                from ? Key{account, from->first, from->second}
+                     : Key{account, maxLedger, UINT32_MAX}));
+            for (; it != byAccount_.rend() && ret.size() < limit; ++it)
+            {
+                auto const& [acct, seq, txnSeq] = it->first;
+                if (acct != account || seq < minLedger)
+                    break;
+                ret.push_back({seq, txnSeq, it->second});
+            }
+        }
+
+        return ret;
+    }
+
+    void
+    erase(LedgerIndex ledgerSeq) override
+    {
+        std::lock_guard lock(mutex_);
+        if (auto it = byLedger_.find(ledgerSeq); it != byLedger_.end())
+            eraseLedger(it);
+    }
+
+    void
+    eraseBefore(LedgerIndex ledgerSeq) override
+    {
+        std::lock_guard lock(mutex_);
+        while (!byLedger_.empty() && byLedger_.begin()->first < ledgerSeq)
+            eraseLedger(byLedger_.begin());
+    }
+
+    std::optional<LedgerIndex>
+    minLedgerSeq() override
+    {
+        std::lock_guard lock(mutex_);
+        if (byLedger_.empty())
+            return std::nullopt;
+        return byLedger_.begin()->first;
+    }
+
+    std::size_t
+    size() override
+    {
+        std::lock_guard lock(mutex_);
+        return byAccount_.size();
+    }
+};
+
+#if RIPPLE_ROCKSDB_AVAILABLE
+
+/** An index stored in RocksDB.
+
+    Every entry is written under two keys:
+
+        'A' account ledgerSeq txnSeq  ->  transaction ID
+        'L' ledgerSeq txnSeq account  ->  (empty)
+
+    All integers are big-endian, so the keys sort in the order we search
+    them. The first family answers account_tx queries. The second finds
+    everything recorded for a range of ledgers, which is what rewriting or
+    deleting ledgers needs.
+*/
+class RocksDBAccountTxIndex final : public AccountTxIndex
+{
+    static constexpr std::size_t keySize = 1 + 20 + 4 + 4;
+
+    std::unique_ptr<rocksdb::DB> db_;
+    beast::Journal const j_;
+
+    static void
+    append32(std::string& s, std::uint32_t v)
+    {
+        v = boost::endian::native_to_big(v);
+        s.append(reinterpret_cast<char const*>(&v), sizeof(v));
+    }
+
+    static std::uint32_t
+    read32(char const* p)
+    {
+        std::uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return boost::endian::big_to_native(v);
+    }
+
+    static std::string
+    accountKey(AccountID const& account, LedgerIndex seq, std::uint32_t txn)
+    {
+        std::string key;
+        key.reserve(keySize);
+        key.push_back('A');
+        key.append(reinterpret_cast<char const*>(account.data()), 20);
+        append32(key, seq);
+        append32(key, txn);
+        return key;
+    }
+
+    static std::string
+    ledgerKey(LedgerIndex seq, std::uint32_t txn, AccountID const& account)
+    {
+        std::string key;
+        key.reserve(keySize);
+        key.push_back('L');
+        append32(key, seq);
+        append32(key, txn);
+        key.append(reinterpret_cast<char const*>(account.data()), 20);
+        return key;
+    }
+
+    // Delete every entry of the ledgers in [first, last). The deletions are
+    // written in bounded batches so a large range is never held in memory.
+    void
+    eraseLedgers(LedgerIndex first, std::optional<LedgerIndex> last)
+    {
+        std::unique_ptr<rocksdb::Iterator> it(
+            db_->NewIterator(rocksdb::ReadOptions()));
+
+        std::string start(1, 'L');
+        append32(start, first);
+
+        rocksdb::WriteBatch batch;
+
+        for (it->Seek(start); it->Valid(); it->Next())
+        {
+            auto const key = it->key();
+            if (key.size() != keySize || key[0] != 'L')
+                break;
+
+            auto const seq = read32(key.data() + 1);
+            if (last && seq >= *last)
+                break;
+
+            auto const txn = read32(key.data() + 5);
+            auto const account = AccountID::fromVoid(key.data() + 9);
+
+            batch.Delete(key);
+            batch.Delete(accountKey(account, seq, txn));
+
+            if (batch.Count() >= 16384)
+            {
+                write(batch);
+                batch.Clear();
+            }
+        }
+
+        if (!it->status().ok())
+            Throw<std::runtime_error>(
+                "account_tx index: " + it->status().ToString());
+
+        write(batch);
+    }
+
+    void
+    write(rocksdb::WriteBatch& batch)
+    {
+        if (batch.Count() == 0)
+            return;
+
+        if (auto const status = db_->Write(rocksdb::WriteOptions(), &batch);
+            !status.ok())
+            Throw<std::runtime_error>(
+                "account_tx index: " + status.ToString());
+    }
+
+public:
+    RocksDBAccountTxIndex(
+        Section const& section,
+        boost::filesystem::path const& path,
+        beast::Journal j)
+        : j_(j)
+    {
+        rocksdb::Options options;
+        options.create_if_missing = true;
+
+        if (int threads = 0;
+            get_if_exists(section, "background_threads", threads))
+            options.IncreaseParallelism(threads);
+
+        rocksdb::BlockBasedTableOptions table;
+        if (int cacheMB = 0; get_if_exists(section, "cache_mb", cacheMB))
+            table.block_cache = rocksdb::NewLRUCache(megabytes(cacheMB));
+        options.table_factory.reset(rocksdb::NewBlockBasedTableFactory(table));
+
+        boost::filesystem::create_directories(path);
+
+        rocksdb::DB* db = nullptr;
+        auto const status = rocksdb::DB::Open(options, path.string(), &db);
+        if (!status.ok() || !db)
+            Throw<std::runtime_error>(
+                "Unable to open account_tx index at " + path.string() + ": " +
+                status.ToString());
+        db_.reset(db);
+
+        JLOG(j_.info()) << "Opened account_tx index at " << path.string();
+    }
+
+    void
+    insert(LedgerIndex ledgerSeq, std::vector<Affected> const& affected)
+        override
+    {
+        eraseLedgers(ledgerSeq, ledgerSeq + 1);
+
+        rocksdb::WriteBatch batch;
+        for (auto const& a : affected)
+        {
+            auto const txID = rocksdb::Slice(
+                reinterpret_cast<char const*>(a.txID.data()), a.txID.size());
+            batch.Put(accountKey(a.account, ledgerSeq, a.txnSeq), txID);
+            batch.Put(
+                ledgerKey(ledgerSeq, a.txnSeq, a.account), rocksdb::Slice());
+        }
+        write(batch);
+    }
+
+    std::vector<Entry>
+    find(
+        AccountID const& account,
+        LedgerIndex minLedger,
+        LedgerIndex maxLedger,
+        std::optional<std::pair<LedgerIndex, std::uint32_t>> const& from,
+        bool forward,
+        std::size_t limit) override
+    {
+        std::vector<Entry> ret;
+
+        std::unique_ptr<rocksdb::Iterator> it(
+            db_->NewIterator(rocksdb::ReadOptions()));
+
+        auto const prefix = accountKey(account, 0, 0).substr(0, 21);
+
+        if (forward)
+            it->Seek(
+                from ? accountKey(account, from->first, from->second)
+                     : accountKey(account, minLedger, 0));
+        else
+            it->SeekForPrev(
+                from ? accountKey(account, from->first, from->second)
+                     : accountKey(account, maxLedger, UINT32_MAX));
+
+        for (; it->Valid() && ret.size() < limit;
+             forward ? it->Next() : it->Prev())
+        {
+            auto const key = it->key();
+            if (key.size() != keySize || !key.starts_with(prefix))
+                break;
+
+            auto const seq = read32(key.data() + 21);
+            if (forward ? seq > maxLedger : seq < minLedger)
+                break;
+
+            auto const value = it->value();
+            if (value.size() != uint256::size())
+            {
+                JLOG(j_.error()) << "account_tx index: bad entry for "
+                                 << toBase58(account) << " in ledger " << seq;
+                continue;
+            }
+
+            ret.push_back(
+                {seq,
+                 read32(key.data() + 25),
+                 uint256::fromVoid(value.data())});
+        }
+
+        if (!it->status().ok())
+            Throw<std::runtime_error>(
+                "account_tx index: " + it->status().ToString());
+
+        return ret;
+    }
+
+    void
+    erase(LedgerIndex ledgerSeq) override
+    {
+        eraseLedgers(ledgerSeq, ledgerSeq + 1);
+    }
+
+    void
+    eraseBefore(LedgerIndex ledgerSeq) override
+    {
+        if (ledgerSeq != 0)
+            eraseLedgers(0, ledgerSeq);
+    }
+
+    std::optional<LedgerIndex>
+    minLedgerSeq() override
+    {
+        std::unique_ptr<rocksdb::Iterator> it(
+            db_->NewIterator(rocksdb::ReadOptions()));
+        it->Seek("L");
+        if (!it->Valid() || it->key().size() != keySize || it->key()[0] != 'L')
+            return std::nullopt;
+        return read32(it->key().data() + 1);
+    }
+
+    std::size_t
+    size() override
+    {
+        // Each entry is stored under two keys
+        std::uint64_t keys = 0;
+        db_->GetIntProperty("rocksdb.estimate-num-keys", &keys);
+        return keys / 2;
+    }
+};
+
+#endif
+
+}  // namespace
+
+std::unique_ptr<AccountTxIndex>
+makeAccountTxIndex(
+    Section const& section,
+    boost::filesystem::path const& defaultPath,
+    beast::Journal j)
+{
+    std::string const type = get(section, "type");
+
+    if (boost::iequals(type, "memory"))
+        return std::make_unique<MemoryAccountTxIndex>();
+
+    if (boost::iequals(type, "rocksdb"))
+    {
+#if RIPPLE_ROCKSDB_AVAILABLE
+        boost::filesystem::path path = get(section, "path");
+        if (path.empty())
+            path = defaultPath;
+        return std::make_unique<RocksDBAccountTxIndex>(section, path, j);
+#else
+        Throw<std::runtime_error>(
+            "account_tx index type 'rocksdb' requires a build with RocksDB");
+#endif
+    }
+
+    Throw<std::runtime_error>(
+        "Unknown account_tx index type '" + type + "'");
+}
+
+}  // namespace detail
+}  // namespace ripple
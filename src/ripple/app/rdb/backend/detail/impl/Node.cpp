@@ -33,6 +33,8 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <soci/sqlite3/soci-sqlite3.h>
+#include <algorithm>
+#include <array>
 
 namespace ripple {
 namespace detail {
@@ -69,21 +71,54 @@ makeLedgerDBs(
     DatabaseCon::Setup const& setup,
     DatabaseCon::CheckpointerSetup const& checkpointerSetup)
 {
+    auto const& sqlite = config.section("sqlite");
+
+    // The page cache and memory map sizes of a database, in megabytes. The
+    // cache defaults to one sized for the node and the map to the one set
+    // when the database was opened.
+    auto const tuning = [&](std::string const& db, SizedItem cache) {
+        std::vector<std::string> pragma;
+        pragma.push_back(boost::str(
+            boost::format("PRAGMA cache_size=-%d;") %
+            kilobytes(get<std::uint64_t>(
+                sqlite, db + "_cache_size", config.getValueFor(cache)))));
+        if (std::uint64_t mmap; set(mmap, db + "_mmap_size", sqlite))
+            pragma.push_back(boost::str(
+                boost::format("PRAGMA mmap_size=%d;") % megabytes(mmap)));
+        return pragma;
+    };
+
+    // Read-only connections, so that queries run concurrently rather than
+    // taking turns on the main session.
+    auto const openReaders = [&](DatabaseCon& con,
+                                 std::string const& db,
+                                 auto const& dbPragma,
+                                 std::vector<std::string> const& tuned) {
+        std::vector<std::string> pragma;
+        if (auto const common = setup.commonPragma())
+            pragma = *common;
+        pragma.insert(pragma.end(), dbPragma.begin(), dbPragma.end());
+        pragma.insert(pragma.end(), tuned.begin(), tuned.end());
+        con.openReaders(get<std::size_t>(sqlite, db + "_readers", 4), pragma);
+    };
+
     // ledger database
     auto lgr{std::make_unique<DatabaseCon>(
         setup, LgrDBName, LgrDBPragma, LgrDBInit, checkpointerSetup)};
-    lgr->getSession() << boost::str(
-        boost::format("PRAGMA cache_size=-%d;") %
-        kilobytes(config.getValueFor(SizedItem::lgrDBCache)));
+    auto const lgrTuning = tuning("ledger_db", SizedItem::lgrDBCache);
+    for (auto const& pragma : lgrTuning)
+        lgr->getSession() << pragma;
+    openReaders(*lgr, "ledger_db", LgrDBPragma, lgrTuning);
 
     if (config.useTxTables())
     {
         // transaction database
         auto tx{std::make_unique<DatabaseCon>(
             setup, TxDBName, TxDBPragma, TxDBInit, checkpointerSetup)};
-        tx->getSession() << boost::str(
-            boost::format("PRAGMA cache_size=-%d;") %
-            kilobytes(config.getValueFor(SizedItem::txnDBCache)));
+        auto const txTuning = tuning("transaction_db", SizedItem::txnDBCache);
+        for (auto const& pragma : txTuning)
+            tx->getSession() << pragma;
+        openReaders(*tx, "transaction_db", TxDBPragma, txTuning);
 
         if (!setup.standAlone || setup.startUp == Config::LOAD ||
             setup.startUp == Config::LOAD_FILE ||
@@ -183,13 +218,135 @@ getRowsMinMax(soci::session& session, TableType type)
     return res;
 }
 
+/** Run a statement over a list of rows, a bounded number at a time.
+
+    @param session The session to run the statements on.
+    @param prefix Text preceding the comma separated rows.
+    @param rows The rows.
+    @param suffix Text following the rows.
+*/
+static void
+runBatched(
+    soci::session& session,
+    std::string const& prefix,
+    std::vector<std::string> const& rows,
+    char const* suffix)
+{
+    // Bounds the size of each statement, as transaction rows hold the
+    // transaction and its metadata.
+    std::size_t constexpr rowsPerStatement = 256;
+
+    for (std::size_t i = 0; i < rows.size(); i += rowsPerStatement)
+    {
+        auto const last = std::min(rows.size(), i + rowsPerStatement);
+        std::string sql(prefix);
+        sql += rows[i];
+        for (auto j = i + 1; j < last; ++j)
+        {
+            sql += ", ";
+            sql += rows[j];
+        }
+        sql += suffix;
+        session << sql;
+    }
+}
+
+void
+migrateAccountTransactions(
+    soci::session& session,
+    AccountTxIndex& index,
+    beast::Journal j)
+{
+    auto const minSeq =
+        getMinLedgerSeq(session, TableType::AccountTransactions);
+    auto const maxSeq =
+        getMaxLedgerSeq(session, TableType::AccountTransactions);
+    if (!minSeq || !maxSeq)
+        return;
+
+    JLOG(j.warn()) << "Moving the AccountTransactions of ledgers " << *minSeq
+                   << " to " << *maxSeq << " into the account_tx index";
+
+    // The number of ledgers moved at a time
+    static constexpr LedgerIndex step = 1000;
+
+    std::string txID;
+    std::string account;
+    LedgerIndex ledgerSeq;
+    std::uint32_t txnSeq;
+    LedgerIndex first;
+    LedgerIndex last;
+
+    soci::statement st =
+        (session.prepare
+             << "SELECT TransID, Account, LedgerSeq, TxnSeq "
+                "FROM AccountTransactions "
+                "WHERE LedgerSeq >= :first AND LedgerSeq <= :last "
+                "ORDER BY LedgerSeq;",
+         soci::use(first),
+         soci::use(last),
+         soci::into(txID),
+         soci::into(account),
+         soci::into(ledgerSeq),
+         soci::into(txnSeq));
+
+    for (first = *minSeq; first <= *maxSeq; first = last + 1)
+    {
+        last = *maxSeq - first < step ? *maxSeq : first + step - 1;
+
+        std::optional<LedgerIndex> current;
+        std::vector<AccountTxIndex::Affected> affected;
+        auto const flush = [&]() {
+            if (current)
+                index.insert(*current, affected);
+            affected.clear();
+        };
+
+        st.execute();
+        while (st.fetch())
+        {
+            if (ledgerSeq != current)
+            {
+                flush();
+                current = ledgerSeq;
+            }
+
+            auto const id = parseBase58<AccountID>(account);
+            uint256 hash;
+            if (!id || !hash.parseHex(txID))
+            {
+                JLOG(j.warn()) << "Skipping a malformed AccountTransactions "
+                               << "row of ledger " << ledgerSeq;
+                continue;
+            }
+            affected.push_back({*id, txnSeq, hash});
+        }
+        flush();
+
+        // The rows are only removed once the index holds them
+        session << "DELETE FROM AccountTransactions "
+                   "WHERE LedgerSeq >= :first AND LedgerSeq <= :last;",
+            soci::use(first), soci::use(last);
+
+        JLOG(j.info()) << "Moved the AccountTransactions of ledgers up to "
+                       << last;
+        if (last == *maxSeq)
+            break;
+    }
+
+    JLOG(j.warn()) << "Moved the AccountTransactions table into the "
+                   << "account_tx index";
+}
+
 bool
 saveValidatedLedger(
     DatabaseCon& ldgDB,
     DatabaseCon& txnDB,
     Application& app,
     std::shared_ptr<Ledger const> const& ledger,
-    bool current)
+    bool current,
+    AccountTxIndex* accountTxIndex,
+    TxIndex* txIndex)
 {
     auto j = app.journal("Ledger");
     auto seq = ledger->info().seq;
@@ -252,8 +409,6 @@ saveValidatedLedger(
             "DELETE FROM Transactions WHERE LedgerSeq = %u;");
         static boost::format deleteTrans2(
             "DELETE FROM AccountTransactions WHERE LedgerSeq = %u;");
-        static boost::format deleteAcctTrans(
-            "DELETE FROM AccountTransactions WHERE TransID = '%s';");
 
         {
             auto db = ldgDB.checkoutDb();
@@ -267,10 +422,21 @@ saveValidatedLedger(
             soci::transaction tr(*db);
 
             *db << boost::str(deleteTrans1 % seq);
-            *db << boost::str(deleteTrans2 % seq);
+            if (!accountTxIndex)
+                *db << boost::str(deleteTrans2 % seq);
 
             std::string const ledgerSeq(std::to_string(seq));
 
+            std::vector<AccountTxIndex::Affected> affected;
+            std::vector<std::string> txnIds;
+            std::vector<std::string> acctRows;
+            std::vector<std::string> txnRows;
+            std::vector<TxIndex::Entry> txEntries;
+            txnIds.reserve(aLedger->size());
+            txnRows.reserve(aLedger->size());
+            if (txIndex)
+                txEntries.reserve(aLedger->size());
+
             for (auto const& acceptedLedgerTx : *aLedger)
             {
                 uint256 transactionID = acceptedLedgerTx->getTransactionID();
@@ -279,44 +445,34 @@ saveValidatedLedger(
                 std::string const txnSeq(
                     std::to_string(acceptedLedgerTx->getTxnSeq()));
 
-                *db << boost::str(deleteAcctTrans % transactionID);
-
                 auto const& accts = acceptedLedgerTx->getAffected();
 
-                if (!accts.empty())
+                if (!accts.empty() && accountTxIndex)
+                {
+                    for (auto const& account : accts)
+                        affected.push_back(
+                            {account,
+                             acceptedLedgerTx->getTxnSeq(),
+                             transactionID});
+                }
+                else if (!accts.empty())
                 {
-                    std::string sql(
-                        "INSERT INTO AccountTransactions "
-                        "(TransID, Account, LedgerSeq, TxnSeq) VALUES ");
-
-                    // Try to make an educated guess on how much space we'll
-                    // need for our arguments. In argument order we have: 64
-                    // + 34 + 10 + 10 = 118 + 10 extra = 128 bytes
-                    sql.reserve(sql.length() + (accts.size() * 128));
-
-                    bool first = true;
                     for (auto const& account : accts)
                     {
-                        if (!first)
-                            sql += ", ('";
-                        else
-                        {
-                            sql += "('";
-                            first = false;
-                        }
-
-                        sql += txnId;
-                        sql += "','";
-                        sql += toBase58(account);
-                        sql += "',";
-                        sql += ledgerSeq;
-                        sql += ",";
-                        sql += txnSeq;
-                        sql += ")";
+                        std::string row;
+                        // In argument order we have: 64 + 34 + 10 + 10
+                        row.reserve(128);
+                        row += "('";
+                        row += txnId;
+                        row += "','";
+                        row += toBase58(account);
+                        row += "',";
+                        row += ledgerSeq;
+                        row += ",";
+                        row += txnSeq;
+                        row += ")";
+                        acctRows.push_back(std::move(row));
                     }
-                    sql += ";";
-                    JLOG(j.trace()) << "ActTx: " << sql;
-                    *db << sql;
                 }
                 else if (auto const& sleTxn = acceptedLedgerTx->getTxn();
                          !isPseudoTx(*sleTxn))
@@ -328,16 +484,49 @@ saveValidatedLedger(
                     JLOG(j.warn()) << sleTxn->getJson(JsonOptions::none);
                 }
 
-                *db
-                    << (STTx::getMetaSQLInsertReplaceHeader() +
-                        acceptedLedgerTx->getTxn()->getMetaSQL(
-                            seq, acceptedLedgerTx->getEscMeta()) +
-                        ";");
+                txnIds.push_back("'" + txnId + "'");
+                txnRows.push_back(acceptedLedgerTx->getTxn()->getMetaSQL(
+                    seq, acceptedLedgerTx->getEscMeta()));
+
+                if (txIndex)
+                {
+                    Serializer s;
+                    acceptedLedgerTx->getTxn()->add(s);
+                    txEntries.push_back(
+                        {transactionID,
+                         seq,
+                         acceptedLedgerTx->getTxnSeq(),
+                         std::move(s.modData()),
+                         acceptedLedgerTx->getRawMeta()});
+                }
 
                 app.getMasterTransaction().inLedger(transactionID, seq);
             }
 
+            // The rows of a ledger are written with a few statements rather
+            // than one (or more) per transaction.
+            if (!accountTxIndex)
+                runBatched(
+                    *db,
+                    "DELETE FROM AccountTransactions WHERE TransID IN (",
+                    txnIds,
+                    ");");
+            runBatched(
+                *db,
+                "INSERT INTO AccountTransactions "
+                "(TransID, Account, LedgerSeq, TxnSeq) VALUES ",
+                acctRows,
+                ";");
+            runBatched(
+                *db, STTx::getMetaSQLInsertReplaceHeader(), txnRows, ";");
+
             tr.commit();
+
+            // The indexes are written after the transactions they refer to
+            if (accountTxIndex)
+                accountTxIndex->insert(seq, affected);
+            if (txIndex)
+                txIndex->insert(seq, txEntries);
         }
 
         {
@@ -1044,7 +1233,7 @@ getNewestAccountTxsB(
  * @brief accountTxPage Searches for the oldest or newest transactions for the
  *        account that matches the given criteria starting from the provided
  *        marker and invokes the callback parameter for each found transaction.
- * @param session Session with the database.
+ * @param statements Prepared statements for the database.
  * @param onUnsavedLedger Callback function to call on each found unsaved
  *        ledger within the given range.
  * @param onTransaction Callback function to call on each found transaction.
@@ -1063,7 +1252,7 @@ getNewestAccountTxsB(
  */
 static std::pair<std::optional<RelationalDatabase::AccountTxMarker>, int>
 accountTxPage(
-    soci::session& session,
+    SQLiteStatements& statements,
     std::function<void(std::uint32_t)> const& onUnsavedLedger,
     std::function<
         void(std::uint32_t, std::string const&, Blob&&, Blob&&)> const&
@@ -1107,89 +1296,67 @@ accountTxPage(
     if (limit_used > 0)
         newmarker = options.marker;
 
-    static std::string const prefix(
-        R"(SELECT AccountTransactions.LedgerSeq,AccountTransactions.TxnSeq,
-          Status,RawTxn,TxnMeta
-          FROM AccountTransactions INNER JOIN Transactions
-          ON Transactions.TransID = AccountTransactions.TransID
-          AND AccountTransactions.Account = '%s' WHERE
-          )");
-
-    std::string sql;
-
-    // SQL's BETWEEN uses a closed interval ([a,b])
-
-    const char* const order = forward ? "ASC" : "DESC";
-
-    if (findLedger == 0)
-    {
-        sql = boost::str(
+    // The queries only differ by whether they start from a marker and by
+    // direction, so each of the four is compiled once per connection.
+    auto const query = [](bool marker, bool forward) {
+        char const* const order = forward ? "ASC" : "DESC";
+
+        // SQL's BETWEEN uses a closed interval ([a,b])
+        std::string range = "AccountTransactions.LedgerSeq BETWEEN ?2 AND ?3";
+        if (marker)
+            range = boost::str(
+                boost::format(R"((%s) OR
+            (AccountTransactions.LedgerSeq = ?4 AND
+            AccountTransactions.TxnSeq %s ?5))") %
+                range % (forward ? ">=" : "<="));
+
+        return boost::str(
             boost::format(
-                prefix + (R"(AccountTransactions.LedgerSeq BETWEEN '%u' AND '%u'
-             ORDER BY AccountTransactions.LedgerSeq %s,
-             AccountTransactions.TxnSeq %s
-             LIMIT %u;)")) %
-            toBase58(options.account) % options.minLedger % options.maxLedger %
-            order % order % queryLimit);
-    }
-    else
-    {
-        const char* const compare = forward ? ">=" : "<=";
-        const std::uint32_t minLedger =
-            forward ? findLedger + 1 : options.minLedger;
-        const std::uint32_t maxLedger =
-            forward ? options.maxLedger : findLedger - 1;
-
-        auto b58acct = toBase58(options.account);
-        sql = boost::str(
-            boost::format((
                 R"(SELECT AccountTransactions.LedgerSeq,AccountTransactions.TxnSeq,
             Status,RawTxn,TxnMeta
-            FROM AccountTransactions, Transactions WHERE
-            (AccountTransactions.TransID = Transactions.TransID AND
-            AccountTransactions.Account = '%s' AND
-            AccountTransactions.LedgerSeq BETWEEN '%u' AND '%u')
-            OR
-            (AccountTransactions.TransID = Transactions.TransID AND
-            AccountTransactions.Account = '%s' AND
-            AccountTransactions.LedgerSeq = '%u' AND
-            AccountTransactions.TxnSeq %s '%u')
+            FROM AccountTransactions INNER JOIN Transactions
+            ON Transactions.TransID = AccountTransactions.TransID
+            AND AccountTransactions.Account = ?1 WHERE %s
             ORDER BY AccountTransactions.LedgerSeq %s,
             AccountTransactions.TxnSeq %s
-            LIMIT %u;
-            )")) %
-            b58acct % minLedger % maxLedger % b58acct % findLedger % compare %
-            findSeq % order % order % queryLimit);
+            LIMIT ?6;)") %
+            range % order % order);
+    };
+
+    static std::array<std::string, 4> const queries{
+        query(false, false),
+        query(false, true),
+        query(true, false),
+        query(true, true)};
+
+    auto st = statements.get(queries[2 * (findLedger != 0) + forward]);
+    st.bind(1, toBase58(options.account));
+    if (findLedger == 0)
+    {
+        st.bind(2, options.minLedger);
+        st.bind(3, options.maxLedger);
     }
+    else
+    {
+        st.bind(2, forward ? findLedger + 1 : options.minLedger);
+        st.bind(3, forward ? options.maxLedger : findLedger - 1);
+        st.bind(4, findLedger);
+        st.bind(5, findSeq);
+    }
+    st.bind(6, queryLimit);
 
     {
         Blob rawData;
         Blob rawMeta;
 
-        // SOCI requires boost::optional (not std::optional) as parameters.
-        boost::optional<std::uint64_t> ledgerSeq;
-        boost::optional<std::uint32_t> txnSeq;
-        boost::optional<std::string> status;
-        soci::blob txnData(session);
-        soci::blob txnMeta(session);
-        soci::indicator dataPresent, metaPresent;
-
-        soci::statement st =
-            (session.prepare << sql,
-             soci::into(ledgerSeq),
-             soci::into(txnSeq),
-             soci::into(status),
-             soci::into(txnData, dataPresent),
-             soci::into(txnMeta, metaPresent));
-
-        st.execute();
-
-        while (st.fetch())
+        while (st.step())
         {
+            auto const ledgerSeq = st.getInt(0);
+            auto const txnSeq = static_cast<std::uint32_t>(st.getInt(1));
+
             if (lookingForMarker)
             {
-                if (findLedger == ledgerSeq.value_or(0) &&
-                    findSeq == txnSeq.value_or(0))
+                if (findLedger == ledgerSeq && findSeq == txnSeq)
                 {
                     lookingForMarker = false;
                 }
@@ -1199,36 +1366,28 @@ accountTxPage(
             else if (numberOfResults == 0)
             {
                 newmarker = {
-                    rangeCheckedCast<std::uint32_t>(ledgerSeq.value_or(0)),
-                    txnSeq.value_or(0)};
+                    rangeCheckedCast<std::uint32_t>(ledgerSeq), txnSeq};
                 break;
             }
 
-            if (dataPresent == soci::i_ok)
-                convert(txnData, rawData);
-            else
-                rawData.clear();
-
-            if (metaPresent == soci::i_ok)
-                convert(txnMeta, rawMeta);
-            else
-                rawMeta.clear();
+            st.getBlob(3, rawData);
+            st.getBlob(4, rawMeta);
 
             // Work around a bug that could leave the metadata missing
             if (rawMeta.size() == 0)
-                onUnsavedLedger(ledgerSeq.value_or(0));
+                onUnsavedLedger(ledgerSeq);
 
             // `rawData` and `rawMeta` will be used after they are moved.
             // That's OK.
             onTransaction(
-                rangeCheckedCast<std::uint32_t>(ledgerSeq.value_or(0)),
-                *status,
+                rangeCheckedCast<std::uint32_t>(ledgerSeq),
+                st.getText(2),
                 std::move(rawData),
                 std::move(rawMeta));
             // Note some callbacks will move the data, some will not. Clear
             // them so code doesn't depend on if the data was actually moved
             // or not. The code will be more efficient if `rawData` and
-            // `rawMeta` don't have to allocate in `convert`, so don't
+            // `rawMeta` don't have to allocate in `getBlob`, so don't
             // refactor my moving these variables into loop scope.
             rawData.clear();
             rawMeta.clear();
@@ -1243,7 +1402,7 @@ accountTxPage(
 
 std::pair<std::optional<RelationalDatabase::AccountTxMarker>, int>
 oldestAccountTxPage(
-    soci::session& session,
+    SQLiteStatements& statements,
     std::function<void(std::uint32_t)> const& onUnsavedLedger,
     std::function<
         void(std::uint32_t, std::string const&, Blob&&, Blob&&)> const&
@@ -1253,7 +1412,7 @@ oldestAccountTxPage(
     std::uint32_t page_length)
 {
     return accountTxPage(
-        session,
+        statements,
         onUnsavedLedger,
         onTransaction,
         options,
@@ -1264,7 +1423,7 @@ oldestAccountTxPage(
 
 std::pair<std::optional<RelationalDatabase::AccountTxMarker>, int>
 newestAccountTxPage(
-    soci::session& session,
+    SQLiteStatements& statements,
     std::function<void(std::uint32_t)> const& onUnsavedLedger,
     std::function<
         void(std::uint32_t, std::string const&, Blob&&, Blob&&)> const&
@@ -1274,7 +1433,7 @@ newestAccountTxPage(
     std::uint32_t page_length)
 {
     return accountTxPage(
-        session,
+        statements,
         onUnsavedLedger,
         onTransaction,
         options,
@@ -1283,6 +1442,91 @@ newestAccountTxPage(
         false);
 }
 
+std::pair<std::optional<RelationalDatabase::AccountTxMarker>, int>
+accountTxPage(
+    SQLiteStatements& statements,
+    AccountTxIndex& index,
+    std::function<void(std::uint32_t)> const& onUnsavedLedger,
+    std::function<
+        void(std::uint32_t, std::string const&, Blob&&, Blob&&)> const&
+        onTransaction,
+    RelationalDatabase::AccountTxPageOptions const& options,
+    std::uint32_t page_length,
+    bool forward)
+{
+    std::uint32_t numberOfResults;
+
+    if (options.limit == 0 || options.limit == UINT32_MAX ||
+        (options.limit > page_length && !options.bAdmin))
+        numberOfResults = page_length;
+    else
+        numberOfResults = options.limit;
+
+    std::optional<std::pair<LedgerIndex, std::uint32_t>> from;
+    if (options.marker)
+        from.emplace(options.marker->ledgerSeq, options.marker->txnSeq);
+
+    // Ask for one more entry than we return; if it exists, it becomes the
+    // marker for the next page.
+    auto const entries = index.find(
+        options.account,
+        options.minLedger,
+        options.maxLedger,
+        from,
+        forward,
+        std::size_t{numberOfResults} + 1);
+
+    // A marker that no longer names an entry matches nothing, the same as
+    // the SQL search.
+    if (from && !entries.empty() &&
+        (entries.front().ledgerSeq != from->first ||
+         entries.front().txnSeq != from->second))
+        return {std::nullopt, 0};
+
+    std::optional<RelationalDatabase::AccountTxMarker> newmarker;
+    int total = 0;
+
+    static std::string const sql =
+        "SELECT Status,RawTxn,TxnMeta FROM Transactions WHERE TransID = ?1;";
+
+    Blob rawData;
+    Blob rawMeta;
+
+    for (auto const& entry : entries)
+    {
+        if (numberOfResults == 0)
+        {
+            newmarker = {entry.ledgerSeq, entry.txnSeq};
+            break;
+        }
+
+        auto st = statements.get(sql);
+        st.bind(1, to_string(entry.txID));
+        if (!st.step())
+            continue;
+
+        st.getBlob(1, rawData);
+        st.getBlob(2, rawMeta);
+
+        // Work around a bug that could leave the metadata missing
+        if (rawMeta.size() == 0)
+            onUnsavedLedger(entry.ledgerSeq);
+
+        onTransaction(
+            entry.ledgerSeq,
+            st.getText(0),
+            std::move(rawData),
+            std::move(rawMeta));
+        rawData.clear();
+        rawMeta.clear();
+
+        --numberOfResults;
+        total++;
+    }
+
+    return {newmarker, total};
+}
+
 std::variant<RelationalDatabase::AccountTx, TxSearched>
 getTransaction(
     soci::session& session,
@@ -0,0 +1,397 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/rdb/backend/detail/TxIndex.h>
+#include <ripple/basics/ByteUtilities.h>
+#include <ripple/basics/contract.h>
+#include <ripple/unity/rocksdb.h>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/endian/conversion.hpp>
+#include <cassert>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace ripple {
+namespace detail {
+
+namespace {
+
+/** An index kept in memory, for tests and standalone use. */
+class MemoryTxIndex final : public TxIndex
+{
+    using Position = std::pair<LedgerIndex, std::uint32_t>;
+
+    std::mutex mutex_;
+    std::map<uint256, Entry> byID_;
+    std::map<Position, uint256> byPosition_;
+
+    // Erase the entries of the ledgers in [first, last)
+    void
+    eraseLedgers(LedgerIndex first, LedgerIndex last)
+    {
+        auto it = byPosition_.lower_bound({first, 0});
+        while (it != byPosition_.end() && it->first.first < last)
+        {
+            // The transaction may since have been recorded in another ledger
+            if (auto e = byID_.find(it->second);
+                e != byID_.end() && e->second.ledgerSeq == it->first.first)
+                byID_.erase(e);
+            it = byPosition_.erase(it);
+        }
+    }
+
+public:
+    void
+    insert(LedgerIndex ledgerSeq, std::vector<Entry> const& entries) override
+    {
+        std::lock_guard lock(mutex_);
+
+        eraseLedgers(ledgerSeq, ledgerSeq + 1);
+        for (auto const& e : entries)
+        {
+            assert(e.ledgerSeq == ledgerSeq);
+            byPosition_[{ledgerSeq, e.txnSeq}] = e.txID;
+            byID_[e.txID] = e;
+        }
+    }
+
+    std::optional<Entry>
+    find(uint256 const& txID) override
+    {
+        std::lock_guard lock(mutex_);
+        if (auto it = byID_.find(txID); it != byID_.end())
+            return it->second;
+        return std::nullopt;
+    }
+
+    std::optional<uint256>
+    find(LedgerIndex ledgerSeq, std::uint32_t txnSeq) override
+    {
+        std::lock_guard lock(mutex_);
+        if (auto it = byPosition_.find({ledgerSeq, txnSeq});
+            it != byPosition_.end())
+            return it->second;
+        return std::nullopt;
+    }
+
+    void
+    erase(LedgerIndex ledgerSeq) override
+    {
+        std::lock_guard lock(mutex_);
+        eraseLedgers(ledgerSeq, ledgerSeq + 1);
+    }
+
+    void
+    eraseBefore(LedgerIndex ledgerSeq) override
+    {
+        std::lock_guard lock(mutex_);
+        eraseLedgers(0, ledgerSeq);
+    }
+};
+
+#if RIPPLE_ROCKSDB_AVAILABLE
+
+/** An index stored in RocksDB.
+
+    Every transaction is written under two keys:
+
+        'T' txID             ->  ledgerSeq txnSeq size(rawTxn) rawTxn rawMeta
+        'P' ledgerSeq txnSeq ->  txID
+
+    All integers are big-endian. The first key answers lookups by ID. The
+    second answers lookups by CTID, and finds everything recorded for a
+    range of ledgers, which is what rewriting or deleting ledgers needs.
+*/
+class RocksDBTxIndex final : public TxIndex
+{
+    static constexpr std::size_t idKeySize = 1 + 32;
+    static constexpr std::size_t positionKeySize = 1 + 4 + 4;
+    static constexpr std::size_t headerSize = 4 + 4 + 4;
+
+    std::unique_ptr<rocksdb::DB> db_;
+    beast::Journal const j_;
+
+    static void
+    append32(std::string& s, std::uint32_t v)
+    {
+        v = boost::endian::native_to_big(v);
+        s.append(reinterpret_cast<char const*>(&v), sizeof(v));
+    }
+
+    static std::uint32_t
+    read32(char const* p)
+    {
+        std::uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return boost::endian::big_to_native(v);
+    }
+
+    static std::string
+    idKey(uint256 const& txID)
+    {
+        std::string key;
+        key.reserve(idKeySize);
+        key.push_back('T');
+        key.append(reinterpret_cast<char const*>(txID.data()), txID.size());
+        return key;
+    }
+
+    static std::string
+    positionKey(LedgerIndex seq, std::uint32_t txn)
+    {
+        std::string key;
+        key.reserve(positionKeySize);
+        key.push_back('P');
+        append32(key, seq);
+        append32(key, txn);
+        return key;
+    }
+
+    // Returns the ledger sequence a transaction is recorded in, if any
+    std::optional<LedgerIndex>
+    recordedIn(uint256 const& txID)
+    {
+        std::string value;
+        auto const status =
+            db_->Get(rocksdb::ReadOptions(), idKey(txID), &value);
+        if (status.IsNotFound())
+            return std::nullopt;
+        if (!status.ok())
+            Throw<std::runtime_error>("tx index: " + status.ToString());
+        if (value.size() < headerSize)
+            return std::nullopt;
+        return read32(value.data());
+    }
+
+    // Delete every entry of the ledgers in [first, last). The deletions are
+    // written in bounded batches so a large range is never held in memory.
+    void
+    eraseLedgers(LedgerIndex first, std::optional<LedgerIndex> last)
+    {
+        std::unique_ptr<rocksdb::Iterator> it(
+            db_->NewIterator(rocksdb::ReadOptions()));
+
+        rocksdb::WriteBatch batch;
+
+        for (it->Seek(positionKey(first, 0)); it->Valid(); it->Next())
+        {
+            auto const key = it->key();
+            if (key.size() != positionKeySize || key[0] != 'P')
+                break;
+
+            auto const seq = read32(key.data() + 1);
+            if (last && seq >= *last)
+                break;
+
+            batch.Delete(key);
+
+            // The transaction may since have been recorded in another ledger
+            if (auto const value = it->value(); value.size() == uint256::size())
+            {
+                auto const txID = uint256::fromVoid(value.data());
+                if (recordedIn(txID) == seq)
+                    batch.Delete(idKey(txID));
+            }
+
+            if (batch.Count() >= 16384)
+            {
+                write(batch);
+                batch.Clear();
+            }
+        }
+
+        if (!it->status().ok())
+            Throw<std::runtime_error>("tx index: " + it->status().ToString());
+
+        write(batch);
+    }
+
+    void
+    write(rocksdb::WriteBatch& batch)
+    {
+        if (batch.Count() == 0)
+            return;
+
+        if (auto const status = db_->Write(rocksdb::WriteOptions(), &batch);
+            !status.ok())
+            Throw<std::runtime_error>("tx index: " + status.ToString());
+    }
+
+public:
+    RocksDBTxIndex(
+        Section const& section,
+        boost::filesystem::path const& path,
+        beast::Journal j)
+        : j_(j)
+    {
+        rocksdb::Options options;
+        options.create_if_missing = true;
+
+        if (int threads = 0;
+            get_if_exists(section, "background_threads", threads))
+            options.IncreaseParallelism(threads);
+
+        rocksdb::BlockBasedTableOptions table;
+        if (int cacheMB = 0; get_if_exists(section, "cache_mb", cacheMB))
+            table.block_cache = rocksdb::NewLRUCache(megabytes(cacheMB));
+        // Lookups by ID are point reads of keys that are usually present
+        table.filter_policy.reset(rocksdb::NewBloomFilterPolicy(10));
+        options.table_factory.reset(rocksdb::NewBlockBasedTableFactory(table));
+
+        boost::filesystem::create_directories(path);
+
+        rocksdb::DB* db = nullptr;
+        auto const status = rocksdb::DB::Open(options, path.string(), &db);
+        if (!status.ok() || !db)
+            Throw<std::runtime_error>(
+                "Unable to open tx index at " + path.string() + ": " +
+                status.ToString());
+        db_.reset(db);
+
+        JLOG(j_.info()) << "Opened tx index at " << path.string();
+    }
+
+    void
+    insert(LedgerIndex ledgerSeq, std::vector<Entry> const& entries) override
+    {
+        eraseLedgers(ledgerSeq, ledgerSeq + 1);
+
+        rocksdb::WriteBatch batch;
+        std::string value;
+        for (auto const& e : entries)
+        {
+            assert(e.ledgerSeq == ledgerSeq);
+
+            value.clear();
+            value.reserve(headerSize + e.rawTxn.size() + e.rawMeta.size());
+            append32(value, ledgerSeq);
+            append32(value, e.txnSeq);
+            append32(value, e.rawTxn.size());
+            value.append(
+                reinterpret_cast<char const*>(e.rawTxn.data()),
+                e.rawTxn.size());
+            value.append(
+                reinterpret_cast<char const*>(e.rawMeta.data()),
+                e.rawMeta.size());
+            batch.Put(idKey(e.txID), value);
+
+            batch.Put(
+                positionKey(ledgerSeq, e.txnSeq),
+                rocksdb::Slice(
+                    reinterpret_cast<char const*>(e.txID.data()),
+                    e.txID.size()));
+        }
+        write(batch);
+    }
+
+    std::optional<Entry>
+    find(uint256 const& txID) override
+    {
+        std::string value;
+        auto const status =
+            db_->Get(rocksdb::ReadOptions(), idKey(txID), &value);
+        if (status.IsNotFound())
+            return std::nullopt;
+        if (!status.ok())
+            Throw<std::runtime_error>("tx index: " + status.ToString());
+
+        if (value.size() < headerSize ||
+            value.size() - headerSize < read32(value.data() + 8))
+        {
+            JLOG(j_.error()) << "tx index: bad entry for " << txID;
+            return std::nullopt;
+        }
+
+        auto const txnSize = read32(value.data() + 8);
+        auto const txn = reinterpret_cast<std::uint8_t const*>(
+            value.data() + headerSize);
+        auto const end =
+            reinterpret_cast<std::uint8_t const*>(value.data() + value.size());
+        return Entry{
+            txID,
+            read32(value.data()),
+            read32(value.data() + 4),
+            Blob(txn, txn + txnSize),
+            Blob(txn + txnSize, end)};
+    }
+
+    std::optional<uint256>
+    find(LedgerIndex ledgerSeq, std::uint32_t txnSeq) override
+    {
+        std::string value;
+        auto const status = db_->Get(
+            rocksdb::ReadOptions(), positionKey(ledgerSeq, txnSeq), &value);
+        if (status.IsNotFound())
+            return std::nullopt;
+        if (!status.ok())
+            Throw<std::runtime_error>("tx index: " + status.ToString());
+        if (value.size() != uint256::size())
+            return std::nullopt;
+        return uint256::fromVoid(value.data());
+    }
+
+    void
+    erase(LedgerIndex ledgerSeq) override
+    {
+        eraseLedgers(ledgerSeq, ledgerSeq + 1);
+    }
+
+    void
+    eraseBefore(LedgerIndex ledgerSeq) override
+    {
+        if (ledgerSeq != 0)
+            eraseLedgers(0, ledgerSeq);
+    }
+};
+
+#endif
+
+}  // namespace
+
+std::unique_ptr<TxIndex>
+makeTxIndex(
+    Section const& section,
+    boost::filesystem::path const& defaultPath,
+    beast::Journal j)
+{
+    std::string const type = get(section, "type");
+
+    if (boost::iequals(type, "memory"))
+        return std::make_unique<MemoryTxIndex>();
+
+    if (boost::iequals(type, "rocksdb"))
+    {
+#if RIPPLE_ROCKSDB_AVAILABLE
+        boost::filesystem::path path = get(section, "path");
+        if (path.empty())
+            path = defaultPath;
+        return std::make_unique<RocksDBTxIndex>(section, path, j);
+#else
+        Throw<std::runtime_error>(
+            "tx index type 'rocksdb' requires a build with RocksDB");
+#endif
+    }
+
+    Throw<std::runtime_error>("Unknown tx index type '" + type + "'");
+}
+
+}  // namespace detail
+}  // namespace ripple
@@ -315,27 +315,26 @@ loadLedgerHelper(
 }
 
 #ifdef RIPPLED_REPORTING
-static bool
-writeToLedgersDB(LedgerInfo const& info, PgQuery& pgQuery, beast::Journal& j)
+/**
+ * @brief ledgerInsert Statement writing a ledger to the ledgers table
+ * @param info Ledger to write
+ * @return Database command with parameters
+ */
+static pg_params
+ledgerInsert(LedgerInfo const& info)
 {
-    JLOG(j.debug()) << __func__;
-    auto cmd = boost::format(
-        R"(INSERT INTO ledgers
-           VALUES (%u,'\x%s', '\x%s',%u,%u,%u,%u,%u,'\x%s','\x%s'))");
-
-    auto ledgerInsert = boost::str(
-        cmd % info.seq % strHex(info.hash) % strHex(info.parentHash) %
-        info.drops.drops() % info.closeTime.time_since_epoch().count() %
-        info.parentCloseTime.time_since_epoch().count() %
-        info.closeTimeResolution.count() % info.closeFlags %
-        strHex(info.accountHash) % strHex(info.txHash));
-    JLOG(j.trace()) << __func__ << " : "
-                    << " : "
-                    << "query string = " << ledgerInsert;
-
-    auto res = pgQuery(ledgerInsert.data());
-
-    return res;
+    return {
+        "INSERT INTO ledgers VALUES ($1, $2, $3, $4, $5, $6, $7, $8, $9, $10)",
+        {std::to_string(info.seq),
+         "\\x" + strHex(info.hash),
+         "\\x" + strHex(info.parentHash),
+         std::to_string(info.drops.drops()),
+         std::to_string(info.closeTime.time_since_epoch().count()),
+         std::to_string(info.parentCloseTime.time_since_epoch().count()),
+         std::to_string(info.closeTimeResolution.count()),
+         std::to_string(info.closeFlags),
+         "\\x" + strHex(info.accountHash),
+         "\\x" + strHex(info.txHash)}};
 }
 
 enum class DataFormat { binary, expanded };
@@ -547,54 +546,55 @@ PostgresDatabaseImp::writeLedgerAndTransactions(
     try
     {
         // Create a PgQuery object to run multiple commands over the same
-        // connection in a single transaction block.
+        // connection in a single transaction block. Starting the transaction
+        // and writing the ledger only take one round trip.
         PgQuery pg(pgPool_);
-        auto res = pg("BEGIN");
-        if (!res || res.status() != PGRES_COMMAND_OK)
+        auto begin = pg.pipeline({{"BEGIN", {}}, ledgerInsert(info)});
+        if (!begin[0] || begin[0].status() != PGRES_COMMAND_OK)
         {
             std::stringstream msg;
-            msg << "bulkWriteToTable : Postgres insert error: " << res.msg();
+            msg << "bulkWriteToTable : Postgres insert error: "
+                << begin[0].msg();
             Throw<std::runtime_error>(msg.str());
         }
 
         // Writing to the ledgers db fails if the ledger already exists in the
         // db. In this situation, the ETL process has detected there is another
         // writer, and falls back to only publishing
-        if (!writeToLedgersDB(info, pg, j_))
+        if (!begin[1])
         {
             JLOG(j_.warn()) << __func__ << " : "
                             << "Failed to write to ledgers database.";
             return false;
         }
 
-        std::stringstream transactionsCopyBuffer;
-        std::stringstream accountTransactionsCopyBuffer;
+        PgCopyBinary transactionsCopy;
+        PgCopyBinary accountTransactionsCopy;
         for (auto const& data : accountTxData)
         {
-            std::string txHash = strHex(data.txHash);
-            std::string nodestoreHash = strHex(data.nodestoreHash);
             auto idx = data.transactionIndex;
             auto ledgerSeq = data.ledgerSequence;
 
-            transactionsCopyBuffer << std::to_string(ledgerSeq) << '\t'
-                                   << std::to_string(idx) << '\t' << "\\\\x"
-                                   << txHash << '\t' << "\\\\x" << nodestoreHash
-                                   << '\n';
+            transactionsCopy.row(4);
+            transactionsCopy.bigint(ledgerSeq);
+            transactionsCopy.bigint(idx);
+            transactionsCopy.bytea(data.txHash.data(), data.txHash.size());
+            transactionsCopy.bytea(
+                data.nodestoreHash.data(), data.nodestoreHash.size());
 
             for (auto const& a : data.accounts)
             {
-                std::string acct = strHex(a);
-                accountTransactionsCopyBuffer
-                    << "\\\\x" << acct << '\t' << std::to_string(ledgerSeq)
-                    << '\t' << std::to_string(idx) << '\n';
+                accountTransactionsCopy.row(3);
+                accountTransactionsCopy.bytea(a.data(), a.size());
+                accountTransactionsCopy.bigint(ledgerSeq);
+                accountTransactionsCopy.bigint(idx);
             }
         }
 
-        pg.bulkInsert("transactions", transactionsCopyBuffer.str());
-        pg.bulkInsert(
-            "account_transactions", accountTransactionsCopyBuffer.str());
+        pg.bulkInsert("transactions", transactionsCopy);
+        pg.bulkInsert("account_transactions", accountTransactionsCopy);
 
-        res = pg("COMMIT");
+        auto res = pg("COMMIT");
         if (!res || res.status() != PGRES_COMMAND_OK)
         {
             std::stringstream msg;
@@ -898,7 +898,7 @@ PostgresDatabaseImp::getAccountTx(AccountTxArgs const& args)
                          << (values[i] ? values[i].value() : "null");
     }
 
-    auto res = PgQuery(pgPool_)(dbParams);
+    auto res = PgQuery(pgPool_)("account_tx", dbParams);
     if (!res)
     {
         JLOG(j_.error()) << __func__
@@ -27,12 +27,15 @@
 #include <ripple/app/rdb/backend/detail/Node.h>
 #include <ripple/app/rdb/backend/detail/Shard.h>
 #include <ripple/basics/BasicConfig.h>
+#include <ripple/basics/PerfLog.h>
 #include <ripple/basics/StringUtilities.h>
+#include <ripple/core/ConfigSections.h>
 #include <ripple/core/DatabaseCon.h>
 #include <ripple/core/SociDB.h>
 #include <ripple/json/to_string.h>
 #include <ripple/nodestore/DatabaseShard.h>
 #include <soci/sqlite3/soci-sqlite3.h>
+#include <chrono>
 
 namespace ripple {
 
@@ -60,6 +63,25 @@ public:
             Throw<std::runtime_error>(error.data());
         }
 
+        if (useTxTables_ && config.exists(SECTION_ACCOUNT_TX_INDEX))
+        {
+            accountTxIndex_ = detail::makeAccountTxIndex(
+                config.section(SECTION_ACCOUNT_TX_INDEX),
+                setup.dataDir / "account_tx",
+                app_.journal("AccountTxIndex"));
+
+            // Carry over what was recorded before the index was configured
+            auto db = txdb_->checkoutDb();
+            detail::migrateAccountTransactions(
+                *db, *accountTxIndex_, app_.journal("AccountTxIndex"));
+        }
+
+        if (useTxTables_ && config.exists(SECTION_TX_INDEX))
+            txIndex_ = detail::makeTxIndex(
+                config.section(SECTION_TX_INDEX),
+                setup.dataDir / "tx",
+                app_.journal("TxIndex"));
+
         if (app.getShardStore() &&
             !makeMetaDBs(
                 config,
@@ -169,6 +191,10 @@ public:
         std::optional<ClosedInterval<std::uint32_t>> const& range,
         error_code_i& ec) override;
 
+    std::optional<uint256>
+    getTransactionIdByIndex(LedgerIndex ledgerSeq, std::uint32_t txnIndex)
+        override;
+
     bool
     ledgerDbHasSpace(Config const& config) override;
 
@@ -195,6 +221,10 @@ private:
     bool const useTxTables_;
     beast::Journal j_;
     std::unique_ptr<DatabaseCon> lgrdb_, txdb_;
+    // Replaces the AccountTransactions table, if configured
+    std::unique_ptr<detail::AccountTxIndex> accountTxIndex_;
+    // Finds transactions by ID or position without SQL, if configured
+    std::unique_ptr<detail::TxIndex> txIndex_;
     std::unique_ptr<DatabaseCon> lgrMetaDB_, txMetaDB_;
 
     /**
@@ -314,6 +344,47 @@ private:
         return txdb_->checkoutDb();
     }
 
+    /**
+     * @brief checkoutReader Checks out a read-only session to the given
+     *        database and reports the time spent waiting for it.
+     * @param db Database to check out a session to.
+     * @param name Name of the database reported to the PerfLog.
+     * @return Reader for the database.
+     */
+    LockedSQLiteReader
+    checkoutReader(DatabaseCon& db, std::string const& name)
+    {
+        using namespace std::chrono;
+        auto const start = steady_clock::now();
+        auto reader = db.checkoutReader();
+        app_.getPerfLog().dbReader(
+            name, duration_cast<microseconds>(steady_clock::now() - start));
+        return reader;
+    }
+
+    /**
+     * @brief checkoutLedgerReader Checks out a read-only session to the
+     *        node store ledger database.
+     * @return Reader for the node store ledger database.
+     */
+    auto
+    checkoutLedgerReader()
+    {
+        return checkoutReader(*lgrdb_, LgrDBName);
+    }
+
+    /**
+     * @brief checkoutTransactionReader Checks out a read-only session to
+     *        the node store transaction database, with its prepared
+     *        statements.
+     * @return Reader for the node store transaction database.
+     */
+    auto
+    checkoutTransactionReader()
+    {
+        return checkoutReader(*txdb_, TxDBName);
+    }
+
     /**
      * @brief doLedger Checks out the ledger database owned by the shard
      *        containing the given ledger, and invokes the provided callback
@@ -474,7 +545,7 @@ SQLiteDatabaseImp::getMinLedgerSeq()
     /* if databases exists, use it */
     if (existsLedger())
     {
-        auto db = checkoutLedger();
+        auto db = checkoutLedgerReader();
         return detail::getMinLedgerSeq(*db, detail::TableType::Ledgers);
     }
 
@@ -503,7 +574,7 @@ SQLiteDatabaseImp::getTransactionsMinLedgerSeq()
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionReader();
         return detail::getMinLedgerSeq(*db, detail::TableType::Transactions);
     }
 
@@ -530,7 +601,10 @@ SQLiteDatabaseImp::getAccountTransactionsMinLedgerSeq()
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        if (accountTxIndex_)
+            return accountTxIndex_->minLedgerSeq();
+
+        auto db = checkoutTransactionReader();
         return detail::getMinLedgerSeq(
             *db, detail::TableType::AccountTransactions);
     }
@@ -555,7 +629,7 @@ SQLiteDatabaseImp::getMaxLedgerSeq()
 {
     if (existsLedger())
     {
-        auto db = checkoutLedger();
+        auto db = checkoutLedgerReader();
         return detail::getMaxLedgerSeq(*db, detail::TableType::Ledgers);
     }
 
@@ -629,6 +703,9 @@ SQLiteDatabaseImp::deleteTransactionsBeforeLedgerSeq(LedgerIndex ledgerSeq)
 
     if (existsTransaction())
     {
+        if (txIndex_)
+            txIndex_->eraseBefore(ledgerSeq);
+
         auto db = checkoutTransaction();
         detail::deleteBeforeLedgerSeq(
             *db, detail::TableType::Transactions, ledgerSeq);
@@ -656,6 +733,9 @@ SQLiteDatabaseImp::deleteAccountTransactionsBeforeLedgerSeq(
 
     if (existsTransaction())
     {
+        if (accountTxIndex_)
+            return accountTxIndex_->eraseBefore(ledgerSeq);
+
         auto db = checkoutTransaction();
         detail::deleteBeforeLedgerSeq(
             *db, detail::TableType::AccountTransactions, ledgerSeq);
@@ -682,7 +762,7 @@ SQLiteDatabaseImp::getTransactionCount()
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionReader();
         return detail::getRows(*db, detail::TableType::Transactions);
     }
 
@@ -709,7 +789,10 @@ SQLiteDatabaseImp::getAccountTransactionCount()
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        if (accountTxIndex_)
+            return accountTxIndex_->size();
+
+        auto db = checkoutTransactionReader();
         return detail::getRows(*db, detail::TableType::AccountTransactions);
     }
 
@@ -733,7 +816,7 @@ SQLiteDatabaseImp::getLedgerCountMinMax()
 {
     if (existsLedger())
     {
-        auto db = checkoutLedger();
+        auto db = checkoutLedgerReader();
         return detail::getRowsMinMax(*db, detail::TableType::Ledgers);
     }
 
@@ -767,7 +850,13 @@ SQLiteDatabaseImp::saveValidatedLedger(
     if (existsLedger())
     {
         if (!detail::saveValidatedLedger(
-                *lgrdb_, *txdb_, app_, ledger, current))
+                *lgrdb_,
+                *txdb_,
+                app_,
+                ledger,
+                current,
+                accountTxIndex_.get(),
+                txIndex_.get()))
             return false;
     }
 
@@ -800,7 +889,7 @@ SQLiteDatabaseImp::getLedgerInfoByIndex(LedgerIndex ledgerSeq)
 {
     if (existsLedger())
     {
-        auto db = checkoutLedger();
+        auto db = checkoutLedgerReader();
         auto const res = detail::getLedgerInfoByIndex(*db, ledgerSeq, j_);
 
         if (res.has_value())
@@ -825,7 +914,7 @@ SQLiteDatabaseImp::getNewestLedgerInfo()
 {
     if (existsLedger())
     {
-        auto db = checkoutLedger();
+        auto db = checkoutLedgerReader();
         auto const res = detail::getNewestLedgerInfo(*db, j_);
 
         if (res.has_value())
@@ -856,7 +945,7 @@ SQLiteDatabaseImp::getLimitedOldestLedgerInfo(LedgerIndex ledgerFirstIndex)
 {
     if (existsLedger())
     {
-        auto db = checkoutLedger();
+        auto db = checkoutLedgerReader();
         auto const res =
             detail::getLimitedOldestLedgerInfo(*db, ledgerFirstIndex, j_);
 
@@ -890,7 +979,7 @@ SQLiteDatabaseImp::getLimitedNewestLedgerInfo(LedgerIndex ledgerFirstIndex)
 {
     if (existsLedger())
     {
-        auto db = checkoutLedger();
+        auto db = checkoutLedgerReader();
         auto const res =
             detail::getLimitedNewestLedgerInfo(*db, ledgerFirstIndex, j_);
 
@@ -923,7 +1012,7 @@ SQLiteDatabaseImp::getLedgerInfoByHash(uint256 const& ledgerHash)
 {
     if (existsLedger())
     {
-        auto db = checkoutLedger();
+        auto db = checkoutLedgerReader();
         auto const res = detail::getLedgerInfoByHash(*db, ledgerHash, j_);
 
         if (res.has_value())
@@ -956,7 +1045,7 @@ SQLiteDatabaseImp::getHashByIndex(LedgerIndex ledgerIndex)
 {
     if (existsLedger())
     {
-        auto db = checkoutLedger();
+        auto db = checkoutLedgerReader();
         auto const res = detail::getHashByIndex(*db, ledgerIndex);
 
         if (res.isNonZero())
@@ -981,7 +1070,7 @@ SQLiteDatabaseImp::getHashesByIndex(LedgerIndex ledgerIndex)
 {
     if (existsLedger())
     {
-        auto db = checkoutLedger();
+        auto db = checkoutLedgerReader();
         auto const res = detail::getHashesByIndex(*db, ledgerIndex, j_);
 
         if (res.has_value())
@@ -1006,7 +1095,7 @@ SQLiteDatabaseImp::getHashesByIndex(LedgerIndex minSeq, LedgerIndex maxSeq)
 {
     if (existsLedger())
     {
-        auto db = checkoutLedger();
+        auto db = checkoutLedgerReader();
         auto const res = detail::getHashesByIndex(*db, minSeq, maxSeq, j_);
 
         if (!res.empty())
@@ -1044,7 +1133,7 @@ SQLiteDatabaseImp::getTxHistory(LedgerIndex startIndex)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionReader();
         auto const res =
             detail::getTxHistory(*db, app_, startIndex, 20, false).first;
 
@@ -1091,7 +1180,7 @@ SQLiteDatabaseImp::getOldestAccountTxs(AccountTxOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionReader();
         return detail::getOldestAccountTxs(
                    *db, app_, ledgerMaster, options, {}, j_)
             .first;
@@ -1151,7 +1240,7 @@ SQLiteDatabaseImp::getNewestAccountTxs(AccountTxOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionReader();
         return detail::getNewestAccountTxs(
                    *db, app_, ledgerMaster, options, {}, j_)
             .first;
@@ -1209,7 +1298,7 @@ SQLiteDatabaseImp::getOldestAccountTxsB(AccountTxOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionReader();
         return detail::getOldestAccountTxsB(*db, app_, options, {}, j_).first;
     }
 
@@ -1265,7 +1354,7 @@ SQLiteDatabaseImp::getNewestAccountTxsB(AccountTxOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionReader();
         return detail::getNewestAccountTxsB(*db, app_, options, {}, j_).first;
     }
 
@@ -1336,11 +1425,25 @@ SQLiteDatabaseImp::oldestAccountTxPage(AccountTxPageOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
-        auto newmarker =
-            detail::oldestAccountTxPage(
-                *db, onUnsavedLedger, onTransaction, options, 0, page_length)
-                .first;
+        auto db = checkoutTransactionReader();
+        auto newmarker = accountTxIndex_
+            ? detail::accountTxPage(
+                  db.statements(),
+                  *accountTxIndex_,
+                  onUnsavedLedger,
+                  onTransaction,
+                  options,
+                  page_length,
+                  true)
+                  .first
+            : detail::oldestAccountTxPage(
+                  db.statements(),
+                  onUnsavedLedger,
+                  onTransaction,
+                  options,
+                  0,
+                  page_length)
+                  .first;
         return {ret, newmarker};
     }
 
@@ -1355,8 +1458,9 @@ SQLiteDatabaseImp::oldestAccountTxPage(AccountTxPageOptions const& options)
                 if (opt.maxLedger != UINT32_MAX &&
                     shardIndex > seqToShardIndex(opt.minLedger))
                     return false;
+                SQLiteStatements statements(session);
                 auto [marker, total] = detail::oldestAccountTxPage(
-                    session,
+                    statements,
                     onUnsavedLedger,
                     onTransaction,
                     opt,
@@ -1398,11 +1502,25 @@ SQLiteDatabaseImp::newestAccountTxPage(AccountTxPageOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
-        auto newmarker =
-            detail::newestAccountTxPage(
-                *db, onUnsavedLedger, onTransaction, options, 0, page_length)
-                .first;
+        auto db = checkoutTransactionReader();
+        auto newmarker = accountTxIndex_
+            ? detail::accountTxPage(
+                  db.statements(),
+                  *accountTxIndex_,
+                  onUnsavedLedger,
+                  onTransaction,
+                  options,
+                  page_length,
+                  false)
+                  .first
+            : detail::newestAccountTxPage(
+                  db.statements(),
+                  onUnsavedLedger,
+                  onTransaction,
+                  options,
+                  0,
+                  page_length)
+                  .first;
         return {ret, newmarker};
     }
 
@@ -1417,8 +1535,9 @@ SQLiteDatabaseImp::newestAccountTxPage(AccountTxPageOptions const& options)
                 if (opt.minLedger &&
                     shardIndex < seqToShardIndex(opt.minLedger))
                     return false;
+                SQLiteStatements statements(session);
                 auto [marker, total] = detail::newestAccountTxPage(
-                    session,
+                    statements,
                     onUnsavedLedger,
                     onTransaction,
                     opt,
@@ -1459,11 +1578,25 @@ SQLiteDatabaseImp::oldestAccountTxPageB(AccountTxPageOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
-        auto newmarker =
-            detail::oldestAccountTxPage(
-                *db, onUnsavedLedger, onTransaction, options, 0, page_length)
-                .first;
+        auto db = checkoutTransactionReader();
+        auto newmarker = accountTxIndex_
+            ? detail::accountTxPage(
+                  db.statements(),
+                  *accountTxIndex_,
+                  onUnsavedLedger,
+                  onTransaction,
+                  options,
+                  page_length,
+                  true)
+                  .first
+            : detail::oldestAccountTxPage(
+                  db.statements(),
+                  onUnsavedLedger,
+                  onTransaction,
+                  options,
+                  0,
+                  page_length)
+                  .first;
         return {ret, newmarker};
     }
 
@@ -1478,8 +1611,9 @@ SQLiteDatabaseImp::oldestAccountTxPageB(AccountTxPageOptions const& options)
                 if (opt.maxLedger != UINT32_MAX &&
                     shardIndex > seqToShardIndex(opt.minLedger))
                     return false;
+                SQLiteStatements statements(session);
                 auto [marker, total] = detail::oldestAccountTxPage(
-                    session,
+                    statements,
                     onUnsavedLedger,
                     onTransaction,
                     opt,
@@ -1520,11 +1654,25 @@ SQLiteDatabaseImp::newestAccountTxPageB(AccountTxPageOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
-        auto newmarker =
-            detail::newestAccountTxPage(
-                *db, onUnsavedLedger, onTransaction, options, 0, page_length)
-                .first;
+        auto db = checkoutTransactionReader();
+        auto newmarker = accountTxIndex_
+            ? detail::accountTxPage(
+                  db.statements(),
+                  *accountTxIndex_,
+                  onUnsavedLedger,
+                  onTransaction,
+                  options,
+                  page_length,
+                  false)
+                  .first
+            : detail::newestAccountTxPage(
+                  db.statements(),
+                  onUnsavedLedger,
+                  onTransaction,
+                  options,
+                  0,
+                  page_length)
+                  .first;
         return {ret, newmarker};
     }
 
@@ -1539,8 +1687,9 @@ SQLiteDatabaseImp::newestAccountTxPageB(AccountTxPageOptions const& options)
                 if (opt.minLedger &&
                     shardIndex < seqToShardIndex(opt.minLedger))
                     return false;
+                SQLiteStatements statements(session);
                 auto [marker, total] = detail::newestAccountTxPage(
-                    session,
+                    statements,
                     onUnsavedLedger,
                     onTransaction,
                     opt,
@@ -1570,7 +1719,32 @@ SQLiteDatabaseImp::getTransaction(
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        if (txIndex_)
+        {
+            if (auto const entry = txIndex_->find(id))
+            {
+                try
+                {
+                    auto txn = Transaction::transactionFromSQL(
+                        entry->ledgerSeq,
+                        std::string(1, txnSqlValidated),
+                        entry->rawTxn,
+                        app_);
+                    auto txMeta = std::make_shared<TxMeta>(
+                        id, entry->ledgerSeq, entry->rawMeta);
+                    return std::pair{std::move(txn), std::move(txMeta)};
+                }
+                catch (std::exception const& e)
+                {
+                    JLOG(j_.warn()) << "Unable to deserialize transaction "
+                                    << id << " from the tx index: " << e.what();
+                }
+            }
+        }
+
+        // Transactions saved before the index was configured are only in
+        // the table.
+        auto db = checkoutTransactionReader();
         return detail::getTransaction(*db, app_, id, range, ec);
     }
 
@@ -1608,6 +1782,16 @@ SQLiteDatabaseImp::getTransaction(
     return TxSearched::unknown;
 }
 
+std::optional<uint256>
+SQLiteDatabaseImp::getTransactionIdByIndex(
+    LedgerIndex ledgerSeq,
+    std::uint32_t txnIndex)
+{
+    if (!txIndex_)
+        return std::nullopt;
+    return txIndex_->find(ledgerSeq, txnIndex);
+}
+
 bool
 SQLiteDatabaseImp::ledgerDbHasSpace(Config const& config)
 {
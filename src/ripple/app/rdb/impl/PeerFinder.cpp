@@ -44,7 +44,8 @@ initPeerFinderDB(
     session << "CREATE TABLE IF NOT EXISTS PeerFinder_BootstrapCache ( "
                "  id       INTEGER PRIMARY KEY AUTOINCREMENT, "
                "  address  TEXT UNIQUE NOT NULL, "
-               "  valence  INTEGER"
+               "  valence  INTEGER, "
+               "  latency  INTEGER NOT NULL DEFAULT 0"
                ");";
 
     session << "CREATE INDEX IF NOT EXISTS "
@@ -184,6 +185,17 @@ updatePeerFinderDB(
                    "  ); ";
     }
 
+    if (version < 5)
+    {
+        //
+        // Add the measured handshake latency to the bootstrap table.
+        // Version 4 tables, including the one rebuilt above, lack it.
+        //
+
+        session << "ALTER TABLE PeerFinder_BootstrapCache "
+                   "  ADD COLUMN latency INTEGER NOT NULL DEFAULT 0;";
+    }
+
     if (version < 3)
     {
         //
@@ -216,22 +228,25 @@ updatePeerFinderDB(
 void
 readPeerFinderDB(
     soci::session& session,
-    std::function<void(std::string const&, int)> const& func)
+    std::function<void(std::string const&, int, int)> const& func)
 {
     std::string s;
     int valence;
+    int latency;
     soci::statement st =
         (session.prepare << "SELECT "
                             " address, "
-                            " valence "
+                            " valence, "
+                            " latency "
                             "FROM PeerFinder_BootstrapCache;",
          soci::into(s),
-         soci::into(valence));
+         soci::into(valence),
+         soci::into(latency));
 
     st.execute();
     while (st.fetch())
     {
-        func(s, valence);
+        func(s, valence, latency);
     }
 }
 
@@ -247,22 +262,26 @@ savePeerFinderDB(
     {
         std::vector<std::string> s;
         std::vector<int> valence;
+        std::vector<int> latency;
         s.reserve(v.size());
         valence.reserve(v.size());
+        latency.reserve(v.size());
 
         for (auto const& e : v)
         {
             s.emplace_back(to_string(e.endpoint));
             valence.emplace_back(e.valence);
+            latency.emplace_back(static_cast<int>(e.latency.count()));
         }
 
         session << "INSERT INTO PeerFinder_BootstrapCache ( "
                    "  address, "
-                   "  valence "
+                   "  valence, "
+                   "  latency "
                    ") VALUES ( "
-                   "  :s, :valence "
+                   "  :s, :valence, :latency "
                    ");",
-            soci::use(s), soci::use(valence);
+            soci::use(s), soci::use(valence), soci::use(latency);
     }
 
     tr.commit();
@@ -21,7 +21,9 @@
 #define RIPPLE_APP_REPORTING_ETLHELPERS_H_INCLUDED
 #include <ripple/app/main/Application.h>
 #include <ripple/ledger/ReadView.h>
+#include <bitset>
 #include <condition_variable>
+#include <deque>
 #include <mutex>
 #include <optional>
 #include <queue>
@@ -191,5 +193,82 @@ getMarkers(size_t numMarkers)
     return markers;
 }
 
+/// Tracks the progress of the initial ledger download. The key space is split
+/// into a fixed number of ranges. A range is downloaded once all of its
+/// objects have been pushed onto the write queue, and is consumed once the
+/// writer has popped all of them. Only consumed ranges can be checkpointed.
+///
+/// Objects are pushed by a single thread at a time, so the writer knows a
+/// range is consumed once it has popped as many objects as had been pushed
+/// when the range was downloaded.
+class InitialLoadProgress
+{
+public:
+    /// The number of ranges the key space is split into
+    static constexpr std::size_t numRanges = 256;
+
+    using Ranges = std::bitset<numRanges>;
+
+private:
+    mutable std::mutex m_;
+
+    Ranges downloaded_;
+
+    Ranges consumed_;
+
+    std::uint64_t pushed_ = 0;
+
+    // Ranges downloaded but not yet consumed, with the number of objects
+    // pushed when each was downloaded
+    std::deque<std::pair<std::uint64_t, std::size_t>> pending_;
+
+public:
+    /// @param consumed ranges already loaded by an earlier, interrupted
+    /// download
+    explicit InitialLoadProgress(Ranges const& consumed = {})
+        : downloaded_(consumed), consumed_(consumed)
+    {
+    }
+
+    /// @return whether the range has already been downloaded
+    bool
+    downloaded(std::size_t range) const
+    {
+        std::lock_guard lck(m_);
+        return downloaded_[range];
+    }
+
+    /// Record that objects were pushed onto the write queue
+    void
+    pushed(std::size_t count)
+    {
+        std::lock_guard lck(m_);
+        pushed_ += count;
+    }
+
+    /// Record that all of the objects of a range were pushed
+    void
+    finished(std::size_t range)
+    {
+        std::lock_guard lck(m_);
+        downloaded_[range] = true;
+        pending_.emplace_back(pushed_, range);
+    }
+
+    /// @param popped the number of objects the writer has popped
+    /// @return the ranges that have been consumed
+    Ranges
+    consumed(std::uint64_t popped)
+    {
+        std::lock_guard lck(m_);
+        while (!pending_.empty() && pending_.front().first <= popped)
+        {
+            consumed_[pending_.front().second] = true;
+            pending_.pop_front();
+        }
+        return consumed_;
+    }
+};
+
 }  // namespace ripple
 #endif
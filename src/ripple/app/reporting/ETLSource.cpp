@@ -23,6 +23,9 @@
 #include <ripple/json/json_reader.h>
 #include <ripple/json/json_writer.h>
 
+#include <algorithm>
+#include <chrono>
+
 namespace ripple {
 
 // Create ETL source without grpc endpoint
@@ -467,6 +470,7 @@ public:
         std::unique_ptr<org::xrpl::rpc::v1::XRPLedgerAPIService::Stub>& stub,
         grpc::CompletionQueue& cq,
         ThreadSafeQueue<std::shared_ptr<SLE>>& queue,
+        InitialLoadProgress& progress,
         bool abort = false)
     {
         JLOG(journal_.debug()) << "Processing calldata";
@@ -523,6 +527,7 @@ public:
 
             queue.push(sle);
         }
+        progress.pushed(cur_->ledger_objects().objects_size());
 
         return more ? CallStatus::MORE : CallStatus::DONE;
     }
@@ -543,6 +548,13 @@ public:
         rpc->Finish(next_.get(), &status_, this);
     }
 
+    /// @return the number of objects in the last response processed
+    std::size_t
+    numObjects() const
+    {
+        return cur_->ledger_objects().objects_size();
+    }
+
     std::string
     getMarkerPrefix()
     {
@@ -556,7 +568,8 @@ public:
 bool
 ETLSource::loadInitialLedger(
     uint32_t sequence,
-    ThreadSafeQueue<std::shared_ptr<SLE>>& writeQueue)
+    ThreadSafeQueue<std::shared_ptr<SLE>>& writeQueue,
+    InitialLoadProgress& progress)
 {
     if (!stub_)
         return false;
@@ -567,27 +580,77 @@ ETLSource::loadInitialLedger(
 
     bool ok = false;
 
+    // Each range of the key space is downloaded by its own chain of calls.
+    // Ranges downloaded by an earlier attempt are skipped.
+    std::vector<uint256> const markers{
+        getMarkers(InitialLoadProgress::numRanges)};
+    std::vector<std::size_t> ranges;
     std::vector<AsyncCallData> calls;
-    std::vector<uint256> markers{getMarkers(etl_.getNumMarkers())};
-
+    calls.reserve(markers.size());
     for (size_t i = 0; i < markers.size(); ++i)
     {
+        if (progress.downloaded(i))
+            continue;
         std::optional<uint256> nextMarker;
         if (i + 1 < markers.size())
             nextMarker = markers[i + 1];
+        ranges.push_back(i);
         calls.emplace_back(markers[i], nextMarker, sequence, journal_);
     }
 
     JLOG(journal_.debug()) << "Starting data download for ledger " << sequence
-                           << ". Using source = " << toString();
+                           << ". Using source = " << toString() << ". "
+                           << calls.size() << " of " << markers.size()
+                           << " ranges left to download";
+
+    // The number of chains of calls in flight starts at num_markers and is
+    // then tuned by the observed throughput: it grows for as long as that
+    // improves the rate at which objects arrive, up to max_markers, and
+    // shrinks when the rate drops.
+    auto const maxInFlight = std::max<std::size_t>(
+        std::min<std::size_t>(etl_.getMaxMarkers(), calls.size()), 1);
+    std::size_t target =
+        std::clamp<std::size_t>(etl_.getNumMarkers(), 1, maxInFlight);
+    std::size_t next = 0;
+    std::size_t inFlight = 0;
+    bool abort = false;
 
-    for (auto& c : calls)
-        c.call(stub_, cq);
+    auto const startCalls = [&]() {
+        while (!abort && inFlight < target && next < calls.size())
+        {
+            calls[next++].call(stub_, cq);
+            ++inFlight;
+        }
+    };
 
-    size_t numFinished = 0;
-    bool abort = false;
-    while (numFinished < calls.size() && !etl_.isStopping() &&
-           cq.Next(&tag, &ok))
+    using namespace std::chrono_literals;
+    auto const tuneInterval = 10s;
+    auto windowStart = std::chrono::steady_clock::now();
+    std::size_t windowObjects = 0;
+    double lastRate = 0;
+
+    auto const tune = [&]() {
+        auto const now = std::chrono::steady_clock::now();
+        if (now - windowStart < tuneInterval)
+            return;
+        auto const rate = windowObjects /
+            std::chrono::duration<double>(now - windowStart).count();
+        if (rate > lastRate * 1.05 && target < maxInFlight)
+            ++target;
+        else if (rate < lastRate * 0.95 && target > 1)
+            --target;
+        JLOG(journal_.info())
+            << "Initial ledger download: " << static_cast<std::size_t>(rate)
+            << " objects/s with " << inFlight << " calls in flight. "
+            << "Target is now " << target;
+        lastRate = rate;
+        windowStart = now;
+        windowObjects = 0;
+    };
+
+    startCalls();
+
+    while (inFlight > 0 && !etl_.isStopping() && cq.Next(&tag, &ok))
     {
         assert(tag);
 
@@ -603,21 +666,27 @@ ETLSource::loadInitialLedger(
         {
             JLOG(journal_.debug())
                 << "Marker prefix = " << ptr->getMarkerPrefix();
-            auto result = ptr->process(stub_, cq, writeQueue, abort);
+            auto result = ptr->process(stub_, cq, writeQueue, progress, abort);
+            if (result != AsyncCallData::CallStatus::ERRORED)
+                windowObjects += ptr->numObjects();
             if (result != AsyncCallData::CallStatus::MORE)
             {
-                numFinished++;
+                --inFlight;
                 JLOG(journal_.debug())
                     << "Finished a marker. "
-                    << "Current number of finished = " << numFinished;
+                    << "Current number in flight = " << inFlight;
             }
+            if (result == AsyncCallData::CallStatus::DONE)
+                progress.finished(ranges[ptr - calls.data()]);
             if (result == AsyncCallData::CallStatus::ERRORED)
             {
                 abort = true;
             }
         }
+        tune();
+        startCalls();
     }
-    return !abort;
+    return !abort && next == calls.size() && inFlight == 0;
 }
 
 std::pair<grpc::Status, org::xrpl::rpc::v1::GetLedgerResponse>
@@ -679,11 +748,13 @@ ETLLoadBalancer::add(std::string& host, std::string& websocketPort)
 void
 ETLLoadBalancer::loadInitialLedger(
     uint32_t sequence,
-    ThreadSafeQueue<std::shared_ptr<SLE>>& writeQueue)
+    ThreadSafeQueue<std::shared_ptr<SLE>>& writeQueue,
+    InitialLoadProgress& progress)
 {
     execute(
-        [this, &sequence, &writeQueue](auto& source) {
-            bool res = source->loadInitialLedger(sequence, writeQueue);
+        [this, &sequence, &writeQueue, &progress](auto& source) {
+            bool res =
+                source->loadInitialLedger(sequence, writeQueue, progress);
             if (!res)
             {
                 JLOG(journal_.error()) << "Failed to download initial ledger. "
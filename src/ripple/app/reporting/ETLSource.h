@@ -245,11 +245,13 @@ public:
     /// Download a ledger in full
     /// @param ledgerSequence sequence of the ledger to download
     /// @param writeQueue queue to push downloaded ledger objects
+    /// @param progress ranges already downloaded, updated as ranges complete
     /// @return true if the download was successful
     bool
     loadInitialLedger(
         uint32_t ledgerSequence,
-        ThreadSafeQueue<std::shared_ptr<SLE>>& writeQueue);
+        ThreadSafeQueue<std::shared_ptr<SLE>>& writeQueue,
+        InitialLoadProgress& progress);
 
     /// Begin sequence of operations to connect to the ETL source and subscribe
     /// to ledgers and transactions_proposed
@@ -342,10 +344,12 @@ public:
     /// Load the initial ledger, writing data to the queue
     /// @param sequence sequence of ledger to download
     /// @param writeQueue queue to push downloaded data to
+    /// @param progress ranges already downloaded, updated as ranges complete
     void
     loadInitialLedger(
         uint32_t sequence,
-        ThreadSafeQueue<std::shared_ptr<SLE>>& writeQueue);
+        ThreadSafeQueue<std::shared_ptr<SLE>>& writeQueue,
+        InitialLoadProgress& progress);
 
     /// Fetch data for a specific ledger. This function will continuously try
     /// to fetch data for the specified ledger until the fetch succeeds, the
@@ -50,7 +50,11 @@ needCurrentOrClosed(Request& request)
         std::is_same<Request, org::xrpl::rpc::v1::GetLedgerRequest>::value ||
         std::is_same<Request, org::xrpl::rpc::v1::GetLedgerDataRequest>::
             value ||
-        std::is_same<Request, org::xrpl::rpc::v1::GetLedgerEntryRequest>::value)
+        std::is_same<Request, org::xrpl::rpc::v1::GetLedgerEntryRequest>::
+            value ||
+        std::is_same<Request, org::xrpl::rpc::v1::GetAccountInfoRequest>::
+            value ||
+        std::is_same<Request, org::xrpl::rpc::v1::GetBookOffersRequest>::value)
     {
         if (request.ledger().ledger_case() ==
             org::xrpl::rpc::v1::LedgerSpecifier::LedgerCase::kShortcut)
@@ -21,17 +21,23 @@
 #include <ripple/app/reporting/ReportingETL.h>
 
 #include <ripple/beast/core/CurrentThreadName.h>
+#include <ripple/core/JobQueue.h>
+#include <ripple/core/ParallelFor.h>
 #include <ripple/json/json_reader.h>
 #include <ripple/json/json_writer.h>
 #include <boost/asio/connect.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/websocket.hpp>
+#include <boost/filesystem.hpp>
 #include <cctype>
 #include <charconv>
 #include <cstdlib>
+#include <exception>
+#include <fstream>
 #include <iostream>
 #include <string>
+#include <thread>
 #include <variant>
 
 namespace ripple {
@@ -53,22 +59,192 @@ toString(LedgerInfo const& info)
 void
 ReportingETL::consumeLedgerData(
     std::shared_ptr<Ledger>& ledger,
-    ThreadSafeQueue<std::shared_ptr<SLE>>& writeQueue)
+    ThreadSafeQueue<std::shared_ptr<SLE>>& writeQueue,
+    InitialLoadProgress& progress)
 {
     std::shared_ptr<SLE> sle;
     size_t num = 0;
-    while (!stopping_ && (sle = writeQueue.pop()))
+    auto checkpointed = progress.consumed(0);
+    // The queue is bounded, so keep draining it when stopping. Otherwise the
+    // download could block forever on a full queue.
+    while ((sle = writeQueue.pop()))
     {
-        assert(sle);
+        if (stopping_)
+            continue;
+
         if (!ledger->exists(sle->key()))
             ledger->rawInsert(sle);
 
         if (flushInterval_ != 0 && (num % flushInterval_) == 0)
         {
             JLOG(journal_.debug()) << "Flushing! key = " << strHex(sle->key());
-            ledger->stateMap().flushDirty(hotACCOUNT_NODE);
+            flushStateMap(*ledger);
         }
         ++num;
+
+        if (checkpointInterval_ != 0 && (num % checkpointInterval_) == 0)
+        {
+            auto const consumed = progress.consumed(num);
+            if (consumed != checkpointed)
+            {
+                saveCheckpoint(*ledger, consumed);
+                checkpointed = consumed;
+            }
+        }
+    }
+}
+
+int
+ReportingETL::flushStateMap(Ledger& ledger)
+{
+    auto& map = ledger.stateMap();
+    std::vector<std::shared_ptr<SHAMapTreeNode>> nodes;
+    auto const numFlushed = map.flushDirty(hotACCOUNT_NODE, nodes);
+
+    // Fewer nodes per thread than this are not worth a thread
+    static constexpr std::size_t perThread = 256;
+    auto const threads = std::min(writeThreads_, nodes.size() / perThread);
+    if (threads < 2)
+    {
+        map.storeNodes(hotACCOUNT_NODE, nodes);
+        return numFlushed;
+    }
+
+    std::vector<std::vector<std::shared_ptr<SHAMapTreeNode>>> chunks(threads);
+    for (std::size_t i = 0; i < nodes.size(); ++i)
+        chunks[i % threads].push_back(std::move(nodes[i]));
+
+    parallelFor(
+        app_.getJobQueue(),
+        jtWRITE,
+        "ReportingETL::flushStateMap",
+        threads,
+        threads - 1,
+        [&](std::size_t t) {
+            map.storeNodes(hotACCOUNT_NODE, chunks[t]);
+            return true;
+        });
+    return numFlushed;
+}
+
+// Identifies a checkpoint file, and the version of its layout
+static std::uint32_t constexpr etlCheckpointMagic = 0x45544C31;  // "ETL1"
+
+static boost::filesystem::path
+etlCheckpointFile(Config const& config)
+{
+    return boost::filesystem::path(config.legacy("database_path")) /
+        "reporting_etl.checkpoint";
+}
+
+void
+ReportingETL::saveCheckpoint(
+    Ledger& ledger,
+    InitialLoadProgress::Ranges const& ranges)
+{
+    auto const start = std::chrono::system_clock::now();
+
+    // Every node of the partial map must be stored before the checkpoint
+    // claims it can be loaded
+    flushStateMap(ledger);
+    app_.getNodeStore().sync();
+
+    uint256 bits;
+    for (std::size_t i = 0; i < ranges.size(); ++i)
+    {
+        if (ranges[i])
+            bits.data()[i / 8] |= 1 << (i % 8);
+    }
+
+    Serializer s(128);
+    s.add32(etlCheckpointMagic);
+    s.add32(ledger.info().seq);
+    s.addBitString(ledger.stateMap().getHash().as_uint256());
+    s.addBitString(bits);
+
+    auto const file = etlCheckpointFile(app_.config());
+    auto temp = file;
+    temp += ".tmp";
+    {
+        std::ofstream out(temp.string(), std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<char const*>(s.data()), s.size());
+        if (!out)
+        {
+            JLOG(journal_.error()) << "Unable to write checkpoint " << temp;
+            return;
+        }
+    }
+
+    boost::system::error_code ec;
+    boost::filesystem::rename(temp, file, ec);
+    if (ec)
+    {
+        JLOG(journal_.error())
+            << "Unable to write checkpoint " << file << ": " << ec.message();
+        return;
+    }
+
+    auto const seconds =
+        (std::chrono::system_clock::now() - start).count() / 1000000000.0;
+    JLOG(journal_.info()) << "Checkpointed the download of ledger "
+                          << ledger.info().seq << " with " << ranges.count()
+                          << " of " << ranges.size() << " ranges loaded in "
+                          << seconds << " seconds";
+}
+
+std::optional<ReportingETL::Checkpoint>
+ReportingETL::loadCheckpoint() const
+{
+    auto const file = etlCheckpointFile(app_.config());
+    Blob data;
+    {
+        std::ifstream in(file.string(), std::ios::binary);
+        if (!in)
+            return std::nullopt;
+        data.assign(
+            std::istreambuf_iterator<char>(in),
+            std::istreambuf_iterator<char>());
+    }
+
+    try
+    {
+        SerialIter sit(makeSlice(data));
+        if (sit.get32() != etlCheckpointMagic)
+        {
+            JLOG(journal_.warn())
+                << "Ignoring unrecognized checkpoint " << file;
+            return std::nullopt;
+        }
+
+        Checkpoint checkpoint;
+        checkpoint.sequence = sit.get32();
+        checkpoint.stateRoot = sit.get256();
+        auto const bits = sit.get256();
+        for (std::size_t i = 0; i < checkpoint.ranges.size(); ++i)
+            checkpoint.ranges[i] = (bits.data()[i / 8] >> (i % 8)) & 1;
+        return checkpoint;
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(journal_.warn())
+            << "Ignoring damaged checkpoint " << file << ": " << e.what();
+        return std::nullopt;
+    }
+}
+
+void
+ReportingETL::removeCheckpoint() const
+{
+    auto const file = etlCheckpointFile(app_.config());
+    boost::system::error_code ec;
+    if (boost::filesystem::remove(file, ec))
+    {
+        JLOG(journal_.info()) << "Removed checkpoint " << file;
+    }
+    else if (ec)
+    {
+        JLOG(journal_.error())
+            << "Unable to remove checkpoint " << file << ": " << ec.message();
     }
 }
 
@@ -137,6 +313,36 @@ ReportingETL::loadInitialLedger(uint32_t startingSequence)
     ledger->stateMap().clearSynching();
     ledger->txMap().clearSynching();
 
+    // Resume an interrupted download of the same ledger, starting from the
+    // partial account state map it checkpointed
+    InitialLoadProgress::Ranges loaded;
+    if (auto const checkpoint = loadCheckpoint())
+    {
+        if (checkpoint->sequence != startingSequence)
+        {
+            JLOG(journal_.warn())
+                << __func__ << " : "
+                << "Ignoring checkpoint of ledger " << checkpoint->sequence;
+        }
+        else if (!ledger->stateMap().fetchRoot(
+                     SHAMapHash{checkpoint->stateRoot}, nullptr))
+        {
+            JLOG(journal_.warn())
+                << __func__ << " : "
+                << "Ignoring checkpoint with missing root "
+                << checkpoint->stateRoot;
+        }
+        else
+        {
+            loaded = checkpoint->ranges;
+            JLOG(journal_.info())
+                << __func__ << " : "
+                << "Resuming download from checkpoint with " << loaded.count()
+                << " of " << loaded.size() << " ranges loaded";
+        }
+    }
+    InitialLoadProgress progress{loaded};
+
 #ifdef RIPPLED_REPORTING
     std::vector<AccountTransactionsData> accountTxData =
         insertTransactions(ledger, *ledgerData);
@@ -144,16 +350,17 @@ ReportingETL::loadInitialLedger(uint32_t startingSequence)
 
     auto start = std::chrono::system_clock::now();
 
-    ThreadSafeQueue<std::shared_ptr<SLE>> writeQueue;
-    std::thread asyncWriter{[this, &ledger, &writeQueue]() {
-        consumeLedgerData(ledger, writeQueue);
+    // The queue is bounded so that the download waits for the writer
+    ThreadSafeQueue<std::shared_ptr<SLE>> writeQueue(writeQueueSize_);
+    std::thread asyncWriter{[this, &ledger, &writeQueue, &progress]() {
+        consumeLedgerData(ledger, writeQueue, progress);
     }};
 
     // download the full account state map. This function downloads full ledger
     // data and pushes the downloaded data into the writeQueue. asyncWriter
     // consumes from the queue and inserts the data into the Ledger object.
     // Once the below call returns, all data has been pushed into the queue
-    loadBalancer_.loadInitialLedger(startingSequence, writeQueue);
+    loadBalancer_.loadInitialLedger(startingSequence, writeQueue, progress);
 
     // null is used to represent the end of the queue
     std::shared_ptr<SLE> null;
@@ -171,6 +378,7 @@ ReportingETL::loadInitialLedger(uint32_t startingSequence)
                 ->writeLedgerAndTransactions(ledger->info(), accountTxData);
 #endif
         }
+        removeCheckpoint();
     }
     auto end = std::chrono::system_clock::now();
     JLOG(journal_.debug()) << "Time to download and store ledger = "
@@ -195,7 +403,7 @@ ReportingETL::flushLedger(std::shared_ptr<Ledger>& ledger)
     ledger->setImmutable(false);
     auto start = std::chrono::system_clock::now();
 
-    auto numFlushed = ledger->stateMap().flushDirty(hotACCOUNT_NODE);
+    auto numFlushed = flushStateMap(*ledger);
 
     auto numTxFlushed = ledger->txMap().flushDirty(hotTRANSACTION_NODE);
 
@@ -277,6 +485,7 @@ ReportingETL::flushLedger(std::shared_ptr<Ledger>& ledger)
 void
 ReportingETL::publishLedger(std::shared_ptr<Ledger>& ledger)
 {
+    setLatestLedger(ledger);
     app_.getOPs().pubLedger(ledger);
 
     setLastPublish();
@@ -702,6 +911,14 @@ ReportingETL::monitor()
                 << *startSequence_;
             ledger = loadInitialLedger(*startSequence_);
         }
+        else if (auto const checkpoint = loadCheckpoint())
+        {
+            JLOG(journal_.info())
+                << __func__ << " : "
+                << "Resuming the interrupted download of ledger "
+                << checkpoint->sequence;
+            ledger = loadInitialLedger(checkpoint->sequence);
+        }
         else
         {
             JLOG(journal_.info())
@@ -954,6 +1171,40 @@ ReportingETL::ReportingETL(Application& app)
                 numMarkers_,
                 *optNumMarkers,
                 "Expected integral num_markers config entry.  Got: ");
+
+        auto const optMaxMarkers = section.get("max_markers");
+        if (optMaxMarkers)
+            asciiToIntThrows(
+                maxMarkers_,
+                *optMaxMarkers,
+                "Expected integral max_markers config entry.  Got: ");
+        maxMarkers_ = std::clamp<size_t>(
+            std::max(maxMarkers_, numMarkers_),
+            1,
+            InitialLoadProgress::numRanges);
+
+        auto const optWriteThreads = section.get("write_threads");
+        if (optWriteThreads)
+            asciiToIntThrows(
+                writeThreads_,
+                *optWriteThreads,
+                "Expected integral write_threads config entry.  Got: ");
+        writeThreads_ = std::max<size_t>(writeThreads_, 1);
+
+        auto const optQueueSize = section.get("write_queue_size");
+        if (optQueueSize)
+            asciiToIntThrows(
+                writeQueueSize_,
+                *optQueueSize,
+                "Expected integral write_queue_size config entry.  Got: ");
+        writeQueueSize_ = std::max<size_t>(writeQueueSize_, 1);
+
+        auto const optCheckpoint = section.get("checkpoint_interval");
+        if (optCheckpoint)
+            asciiToIntThrows(
+                checkpointInterval_,
+                *optCheckpoint,
+                "Expected integral checkpoint_interval config entry.  Got: ");
     }
 }
 
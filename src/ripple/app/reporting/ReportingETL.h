@@ -125,6 +125,25 @@ private:
     /// more load on the ETL source.
     size_t numMarkers_ = 2;
 
+    /// The initial ledger download starts with numMarkers_ chains of
+    /// GetLedgerData calls, and adds more while doing so increases the rate
+    /// at which ledger objects arrive, up to this many.
+    size_t maxMarkers_ = 16;
+
+    /// The number of jobs used to write SHAMap nodes to the nodestore.
+    size_t writeThreads_ = 4;
+
+    /// The number of downloaded ledger objects the initial ledger download
+    /// may hold in memory before the download waits for the writer.
+    size_t writeQueueSize_ = 100000;
+
+    /// If non-zero, every checkpointInterval_ ledger objects during the
+    /// initial ledger download, the partial account state map is written to
+    /// the nodestore along with a record of which ranges of the key space it
+    /// holds. An interrupted download then resumes from the last checkpoint
+    /// instead of starting over.
+    size_t checkpointInterval_ = 0;
+
     /// Whether the process is in strict read-only mode. In strict read-only
     /// mode, the process will never attempt to become the ETL writer, and will
     /// only publish ledgers as they are written to the database.
@@ -158,6 +177,21 @@ private:
         lastPublish_ = std::chrono::system_clock::now();
     }
 
+    /// The most recently published ledger, kept in memory so that reads
+    /// against the latest ledger are served from its state map instead of
+    /// being reloaded from the databases. Only one ledger is retained; its
+    /// state map shares unmodified nodes with its ancestors.
+    std::shared_ptr<Ledger const> latestLedger_;
+
+    mutable std::mutex latestLedgerMtx_;
+
+    void
+    setLatestLedger(std::shared_ptr<Ledger const> const& ledger)
+    {
+        std::lock_guard lck(latestLedgerMtx_);
+        latestLedger_ = ledger;
+    }
+
     /// Download a ledger with specified sequence in full, via GetLedgerData,
     /// and write the data to the databases. This takes several minutes or
     /// longer.
@@ -260,10 +294,41 @@ private:
     /// returns nullptr. This is used during the initial ledger download
     /// @param ledger the ledger to insert data into
     /// @param writeQueue the queue with extracted data
+    /// @param progress used to tell which ranges have been consumed, for
+    /// checkpoints
     void
     consumeLedgerData(
         std::shared_ptr<Ledger>& ledger,
-        ThreadSafeQueue<std::shared_ptr<SLE>>& writeQueue);
+        ThreadSafeQueue<std::shared_ptr<SLE>>& writeQueue,
+        InitialLoadProgress& progress);
+
+    /// Write the modified nodes of a ledger's account state map to the
+    /// nodestore, using up to writeThreads_ jobs
+    /// @return the number of nodes written
+    int
+    flushStateMap(Ledger& ledger);
+
+    /// The state of an interrupted initial ledger download
+    struct Checkpoint
+    {
+        uint32_t sequence;
+        uint256 stateRoot;
+        InitialLoadProgress::Ranges ranges;
+    };
+
+    /// Flush the partial account state map of the initial ledger and record
+    /// which ranges of the key space it holds
+    void
+    saveCheckpoint(Ledger& ledger, InitialLoadProgress::Ranges const& ranges);
+
+    /// @return the checkpoint of an interrupted initial ledger download, if
+    /// there is one
+    std::optional<Checkpoint>
+    loadCheckpoint() const;
+
+    /// Remove the checkpoint once the initial ledger has been written
+    void
+    removeCheckpoint() const;
 
 public:
     explicit ReportingETL(Application& app);
@@ -294,6 +359,15 @@ public:
         return numMarkers_;
     }
 
+    /// Get the most markers to use at once during the initial ledger
+    /// download
+    /// @return the maximum number of markers
+    uint32_t
+    getMaxMarkers()
+    {
+        return maxMarkers_;
+    }
+
     Application&
     getApplication()
     {
@@ -352,6 +426,19 @@ public:
         JLOG(journal_.debug()) << "Joined worker thread";
     }
 
+    /// Get the most recently published ledger, if it is held in memory
+    /// @param sequence the sequence of the requested ledger
+    /// @return the ledger, or nullptr if the latest ledger has a different
+    /// sequence or nothing has been published yet
+    std::shared_ptr<Ledger const>
+    getLatestLedger(std::uint32_t sequence) const
+    {
+        std::lock_guard lck(latestLedgerMtx_);
+        if (latestLedger_ && latestLedger_->info().seq == sequence)
+            return latestLedger_;
+        return {};
+    }
+
     ETLLoadBalancer&
     getETLLoadBalancer()
     {
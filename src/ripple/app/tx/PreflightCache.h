@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_TX_PREFLIGHTCACHE_H_INCLUDED
+#define RIPPLE_TX_PREFLIGHTCACHE_H_INCLUDED
+
+#include <ripple/app/tx/applySteps.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/basics/chrono.h>
+#include <ripple/beast/container/aged_unordered_map.h>
+#include <ripple/protocol/Rules.h>
+#include <chrono>
+#include <mutex>
+#include <optional>
+
+namespace ripple {
+
+/** Remembers the outcome of `preflight` for recently seen transactions.
+
+    A transaction is usually preflighted several times on its way into a
+    validated ledger: when it is submitted to the queue, when it is applied
+    to the open ledger, and again for each pass over it while building the
+    consensus ledger. The checks only depend on the transaction, the rules
+    and the flags, so the result of the first check is kept here and reused
+    by the later ones.
+
+    `tapRETRY` only affects how a transaction is handled after `preflight`,
+    so it is ignored when matching flags. Any other difference in flags, or
+    any difference in the rules, causes the transaction to be checked again.
+*/
+class PreflightCache
+{
+public:
+    /** Create a cache.
+
+        @param clock The clock used to age entries.
+        @param size The largest number of entries to keep.
+        @param age How long an entry is kept after it was last used.
+    */
+    PreflightCache(
+        Stopwatch& clock,
+        std::size_t size,
+        std::chrono::seconds age);
+
+    /** Return the cached result of preflighting a transaction, if any. */
+    std::optional<std::pair<NotTEC, TxConsequences>>
+    fetch(uint256 const& txID, Rules const& rules, ApplyFlags flags);
+
+    /** Remember the result of preflighting a transaction. */
+    void
+    insert(
+        uint256 const& txID,
+        Rules const& rules,
+        ApplyFlags flags,
+        std::pair<NotTEC, TxConsequences> const& result);
+
+    /** Remove entries which have not been used recently. */
+    void
+    sweep();
+
+    /** Return the number of cached entries. */
+    std::size_t
+    size() const;
+
+    /** The default number of entries to keep. */
+    static constexpr std::size_t defaultSize = 32768;
+
+    /** The default time to keep an unused entry. */
+    static constexpr std::chrono::seconds defaultAge{120};
+
+private:
+    struct Entry
+    {
+        Rules rules;
+        ApplyFlags flags;
+        NotTEC ter;
+        TxConsequences consequences;
+    };
+
+    static ApplyFlags
+    significant(ApplyFlags flags);
+
+    std::size_t const size_;
+    std::chrono::seconds const age_;
+
+    std::mutex mutable mutex_;
+
+    beast::aged_unordered_map<
+        uint256,
+        Entry,
+        Stopwatch::clock_type,
+        hardened_hash<strong_hash>>
+        entries_;
+};
+
+}  // namespace ripple
+
+#endif
@@ -99,13 +99,23 @@ ApplyContext::checkInvariantsHelper(
     {
         auto checkers = getInvariantChecks();
 
+        // Only the checks that constrain this type of transaction look at
+        // the modified entries
+        auto const type = tx.getTxnType();
+        std::array<bool, sizeof...(Is)> const active{
+            {invariantApplies<std::tuple_element_t<Is, InvariantChecks>>(
+                type)...}};
+
         // call each check's per-entry method
-        visit([&checkers](
+        visit([&checkers, &active](
                   uint256 const& index,
                   bool isDelete,
                   std::shared_ptr<SLE const> const& before,
                   std::shared_ptr<SLE const> const& after) {
-            (..., std::get<Is>(checkers).visitEntry(isDelete, before, after));
+            (...,
+             (active[Is] ? std::get<Is>(checkers).visitEntry(
+                               isDelete, before, after)
+                         : void()));
         });
 
         // Note: do not replace this logic with a `...&&` fold expression.
@@ -98,7 +98,7 @@ XRPNotCreated::visitEntry(
         switch (before->getType())
         {
             case ltACCOUNT_ROOT:
-                drops_ -= (*before)[sfBalance].xrp().drops();
+                drops_ -= before->getFieldAmount(sfBalance).xrp().drops();
                 break;
             case ltPAYCHAN:
                 drops_ -=
@@ -117,7 +117,7 @@ XRPNotCreated::visitEntry(
         switch (after->getType())
         {
             case ltACCOUNT_ROOT:
-                drops_ += (*after)[sfBalance].xrp().drops();
+                drops_ += after->getFieldAmount(sfBalance).xrp().drops();
                 break;
             case ltPAYCHAN:
                 if (!isDelete)
@@ -190,10 +190,10 @@ XRPBalanceChecks::visitEntry(
     };
 
     if (before && before->getType() == ltACCOUNT_ROOT)
-        bad_ |= isBad((*before)[sfBalance]);
+        bad_ |= isBad(before->getFieldAmount(sfBalance));
 
     if (after && after->getType() == ltACCOUNT_ROOT)
-        bad_ |= isBad((*after)[sfBalance]);
+        bad_ |= isBad(after->getFieldAmount(sfBalance));
 }
 
 bool
@@ -29,6 +29,7 @@
 #include <cstdint>
 #include <map>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 
 namespace ripple {
@@ -81,6 +82,18 @@ public:
         XRPAmount const fee,
         ReadView const& view,
         beast::Journal const& j);
+
+    /**
+     * @brief optional; whether the check constrains a transaction type.
+     *
+     * When present and false, visitEntry is not called for transactions of
+     * that type. finalize is still called and must pass. Checks that do not
+     * declare it visit the entries of every transaction.
+     *
+     * @param type the type of the transaction being applied
+     */
+    static bool
+    appliesTo(TxType type);
 };
 #endif
 
@@ -403,6 +416,12 @@ class ValidClawback
     std::uint32_t trustlinesChanged = 0;
 
 public:
+    static bool
+    appliesTo(TxType type)
+    {
+        return type == ttCLAWBACK;
+    }
+
     void
     visitEntry(
         bool,
@@ -448,6 +467,39 @@ getInvariantChecks()
     return InvariantChecks{};
 }
 
+namespace detail {
+
+template <class Check, class = std::void_t<>>
+struct has_appliesTo : std::false_type
+{
+};
+
+template <class Check>
+struct has_appliesTo<
+    Check,
+    std::void_t<decltype(Check::appliesTo(std::declval<TxType>()))>>
+    : std::true_type
+{
+};
+
+}  // namespace detail
+
+/**
+ * @brief whether an invariant check needs to visit the entries modified by
+ * a transaction of the given type
+ *
+ * @see ripple::InvariantChecker_PROTOTYPE::appliesTo
+ */
+template <class Check>
+bool
+invariantApplies(TxType type)
+{
+    if constexpr (detail::has_appliesTo<Check>::value)
+        return Check::appliesTo(type);
+    else
+        return true;
+}
+
 }  // namespace ripple
 
 #endif
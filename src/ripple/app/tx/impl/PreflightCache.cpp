@@ -0,0 +1,98 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/tx/PreflightCache.h>
+#include <ripple/beast/container/aged_container_utility.h>
+
+namespace ripple {
+
+PreflightCache::PreflightCache(
+    Stopwatch& clock,
+    std::size_t size,
+    std::chrono::seconds age)
+    : size_(size), age_(age), entries_(clock)
+{
+    assert(size_ > 0);
+}
+
+ApplyFlags
+PreflightCache::significant(ApplyFlags flags)
+{
+    return flags & ~tapRETRY;
+}
+
+std::optional<std::pair<NotTEC, TxConsequences>>
+PreflightCache::fetch(uint256 const& txID, Rules const& rules, ApplyFlags flags)
+{
+    std::lock_guard lock(mutex_);
+
+    auto const it = entries_.find(txID);
+    if (it == entries_.end())
+        return std::nullopt;
+
+    auto const& entry = it->second;
+    if (entry.flags != significant(flags) || entry.rules != rules)
+        return std::nullopt;
+
+    entries_.touch(it);
+    return std::make_pair(entry.ter, entry.consequences);
+}
+
+void
+PreflightCache::insert(
+    uint256 const& txID,
+    Rules const& rules,
+    ApplyFlags flags,
+    std::pair<NotTEC, TxConsequences> const& result)
+{
+    std::lock_guard lock(mutex_);
+
+    Entry entry{rules, significant(flags), result.first, result.second};
+
+    // A result from different rules or flags is replaced: the new one is
+    // the one later checks are most likely to ask for.
+    if (auto const it = entries_.find(txID); it != entries_.end())
+    {
+        it->second = std::move(entry);
+        entries_.touch(it);
+    }
+    else
+    {
+        entries_.emplace(txID, std::move(entry));
+    }
+
+    while (entries_.size() > size_)
+        entries_.erase(entries_.chronological.begin());
+}
+
+void
+PreflightCache::sweep()
+{
+    std::lock_guard lock(mutex_);
+    beast::expire(entries_, age_);
+}
+
+std::size_t
+PreflightCache::size() const
+{
+    std::lock_guard lock(mutex_);
+    return entries_.size();
+}
+
+}  // namespace ripple
@@ -28,6 +28,7 @@
 #include <ripple/core/Config.h>
 #include <ripple/json/to_string.h>
 #include <ripple/ledger/View.h>
+#include <ripple/protocol/ApplyProfile.h>
 #include <ripple/protocol/Feature.h>
 #include <ripple/protocol/Indexes.h>
 #include <ripple/protocol/Protocol.h>
@@ -831,6 +832,7 @@ Transactor::operator()()
 {
     JLOG(j_.trace()) << "apply: " << ctx_.tx.getTransactionID();
 
+    applyProfile::Scope const profile{ctx_.tx.getTxnType()};
     STAmountSO stAmountSO{view().rules().enabled(fixSTAmountCanonicalize)};
     NumberSO stNumberSO{view().rules().enabled(fixUniversalNumber)};
 
@@ -17,6 +17,8 @@
 */
 //==============================================================================
 
+#include <ripple/app/main/Application.h>
+#include <ripple/app/tx/PreflightCache.h>
 #include <ripple/app/tx/applySteps.h>
 #include <ripple/app/tx/impl/AMMBid.h>
 #include <ripple/app/tx/impl/AMMCreate.h>
@@ -366,9 +368,17 @@ preflight(
     beast::Journal j)
 {
     PreflightContext const pfctx(app, tx, rules, flags, j);
+
+    auto& cache = app.getPreflightCache();
+    auto const txID = tx.getTransactionID();
+    if (auto const cached = cache.fetch(txID, rules, flags))
+        return {pfctx, *cached};
+
     try
     {
-        return {pfctx, invoke_preflight(pfctx)};
+        auto const result = invoke_preflight(pfctx);
+        cache.insert(txID, rules, flags, result);
+        return {pfctx, result};
     }
     catch (std::exception const& e)
     {
@@ -26,6 +26,7 @@
 #include <ripple/protocol/STArray.h>
 #include <ripple/protocol/TxFlags.h>
 #include <ripple/protocol/nftPageMask.h>
+#include <algorithm>
 #include <functional>
 #include <memory>
 
@@ -238,6 +239,31 @@ compareTokens(uint256 const& a, uint256 const& b)
     return a < b;
 }
 
+/** Locate a token within the contents of a single page.
+
+    The tokens on a page are kept sorted by compareTokens (the invariant
+    checker enforces this), so a binary search suffices.
+
+    @return an iterator to the token, or arr.end() if it is not present.
+ */
+template <class Array>
+static auto
+findInPage(Array& arr, uint256 const& nftokenID)
+{
+    auto const it = std::lower_bound(
+        arr.begin(),
+        arr.end(),
+        nftokenID,
+        [](STObject const& obj, uint256 const& id) {
+            return compareTokens(obj.getFieldH256(sfNFTokenID), id);
+        });
+
+    if (it != arr.end() && it->getFieldH256(sfNFTokenID) == nftokenID)
+        return it;
+
+    return arr.end();
+}
+
 /** Insert the token in the owner's token directory. */
 TER
 insertToken(ApplyView& view, AccountID owner, STObject&& nft)
@@ -369,10 +395,7 @@ removeToken(
     auto arr = curr->getFieldArray(sfNFTokens);
 
     {
-        auto x = std::find_if(
-            arr.begin(), arr.end(), [&nftokenID](STObject const& obj) {
-                return (obj[sfNFTokenID] == nftokenID);
-            });
+        auto x = findInPage(arr, nftokenID);
 
         if (x == arr.end())
             return tecNO_ENTRY;
@@ -492,11 +515,10 @@ findToken(
         return std::nullopt;
 
     // We found a candidate page, but the given NFT may not be in it.
-    for (auto const& t : page->getFieldArray(sfNFTokens))
-    {
-        if (t[sfNFTokenID] == nftokenID)
-            return t;
-    }
+    auto const& arr = page->getFieldArray(sfNFTokens);
+
+    if (auto const t = findInPage(arr, nftokenID); t != arr.end())
+        return *t;
 
     return std::nullopt;
 }
@@ -514,13 +536,12 @@ findTokenAndPage(
         return std::nullopt;
 
     // We found a candidate page, but the given NFT may not be in it.
-    for (auto const& t : page->getFieldArray(sfNFTokens))
-    {
-        if (t[sfNFTokenID] == nftokenID)
-            // This std::optional constructor is explicit, so it is spelled out.
-            return std::optional<TokenAndPage>(
-                std::in_place, t, std::move(page));
-    }
+    auto const& arr = page->getFieldArray(sfNFTokens);
+
+    if (auto const t = findInPage(arr, nftokenID); t != arr.end())
+        // This std::optional constructor is explicit, so it is spelled out.
+        return std::optional<TokenAndPage>(std::in_place, *t, std::move(page));
+
     return std::nullopt;
 }
 
@@ -0,0 +1,143 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_CACHEBUDGET_H_INCLUDED
+#define RIPPLE_BASICS_CACHEBUDGET_H_INCLUDED
+
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/json/json_value.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+
+/** Shares a memory budget between the caches of a server.
+
+    Each cache is added with an estimate of the memory held by one of its
+    entries, from which the bytes it holds are estimated. Every time the
+    caches are swept, rebalance measures them:
+
+    - While they hold more than the budget, the target sizes of the caches
+      with the fewest hits per byte since the last rebalance are lowered,
+      so the following sweep ages their entries out first.
+
+    - While they hold less than seven eighths of the budget, the target
+      size of the full cache with the most misses per byte is raised by an
+      eighth, since growing it would turn the most misses into hits.
+
+    No target is lowered below an eighth or raised above four times the
+    size the cache was configured with. Without a budget, the caches are
+    only measured.
+*/
+class CacheBudget
+{
+public:
+    /** @param budget The bytes the caches may hold, or 0 for no limit. */
+    CacheBudget(std::size_t budget, beast::Journal journal);
+
+    CacheBudget(CacheBudget const&) = delete;
+    CacheBudget&
+    operator=(CacheBudget const&) = delete;
+
+    /** Manage a cache.
+
+        @param name The name the cache is reported under.
+        @param cache A TaggedCache, which must outlive this object.
+        @param entryBytes The estimated memory held by each entry.
+    */
+    template <class Cache>
+    void
+    add(std::string const& name, Cache& cache, std::size_t entryBytes)
+    {
+        Source source;
+        source.name = name;
+        source.entryBytes = std::max<std::size_t>(entryBytes, 1);
+        source.baseTarget = cache.getTargetSize();
+        source.size = [&cache]() -> std::size_t { return cache.size(); };
+        source.getTarget = [&cache] { return cache.getTargetSize(); };
+        source.setTarget = [&cache](int size) { cache.setTargetSize(size); };
+        source.hitsAndMisses = [&cache] { return cache.getHitsAndMisses(); };
+
+        std::lock_guard lock(mutex_);
+        sources_.push_back(std::move(source));
+    }
+
+    /** Measure the caches and adjust their target sizes to the budget. */
+    void
+    rebalance();
+
+    /** The bytes the caches may hold, or 0 for no limit. */
+    std::size_t
+    budget() const
+    {
+        return budget_;
+    }
+
+    /** Returns the budget and the current size of each cache. */
+    Json::Value
+    getJson() const;
+
+private:
+    struct Source
+    {
+        std::string name;
+        std::size_t entryBytes;
+        int baseTarget;
+
+        std::function<std::size_t()> size;
+        std::function<int()> getTarget;
+        std::function<void(int)> setTarget;
+        std::function<std::pair<std::uint64_t, std::uint64_t>()> hitsAndMisses;
+
+        // As measured by the last rebalance
+        std::size_t entries = 0;
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t recentHits = 0;
+        std::uint64_t recentMisses = 0;
+
+        std::size_t
+        bytes() const
+        {
+            return entries * entryBytes;
+        }
+    };
+
+    void
+    shrink(std::size_t excess);
+
+    void
+    grow(std::size_t room);
+
+    std::size_t const budget_;
+    beast::Journal const j_;
+
+    mutable std::mutex mutex_;
+    std::vector<Source> sources_;
+};
+
+}  // namespace ripple
+
+#endif
@@ -22,6 +22,8 @@
 
 #include <ripple/beast/type_name.h>
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -41,6 +43,14 @@ public:
     List
     getCounts(int minimumThreshold) const;
 
+    using ByteList = std::vector<std::pair<std::string, std::int64_t>>;
+
+    /** The memory held by each type with at least minimumThreshold
+        instances, for the types which account for it.
+    */
+    ByteList
+    getBytes(int minimumThreshold) const;
+
 public:
     /** Implementation for @ref CountedObject.
 
@@ -49,7 +59,11 @@ public:
     class Counter
     {
     public:
-        Counter(std::string name) noexcept : name_(std::move(name)), count_(0)
+        /** @param objectSize The size of each counted object, or 0 if
+                              its memory is not accounted for.
+        */
+        Counter(std::string name, std::size_t objectSize = 0) noexcept
+            : name_(std::move(name)), objectSize_(objectSize), count_(0)
         {
             // Insert ourselves at the front of the lock-free linked list
             CountedObjects& instance = CountedObjects::getInstance();
@@ -84,6 +98,25 @@ public:
             return count_.load();
         }
 
+        /** Account for memory allocated, or freed if negative, by the
+            counted objects beyond their own size.
+        */
+        void
+        addBytes(std::ptrdiff_t bytes) noexcept
+        {
+            extraBytes_.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        /** The memory held by the counted objects, or 0 if it is not
+            accounted for.
+        */
+        std::int64_t
+        getBytes() const noexcept
+        {
+            return static_cast<std::int64_t>(objectSize_) * count_.load() +
+                extraBytes_.load(std::memory_order_relaxed);
+        }
+
         Counter*
         getNext() const noexcept
         {
@@ -98,7 +131,9 @@ public:
 
     private:
         std::string const name_;
+        std::size_t const objectSize_;
         std::atomic<int> count_;
+        std::atomic<std::int64_t> extraBytes_{0};
         Counter* next_;
     };
 
@@ -118,6 +153,9 @@ private:
     Derived classes have their instances counted automatically. This is used
     for reporting purposes.
 
+    The memory they hold is the size of each instance, plus whatever memory
+    the derived class reports allocating through countBytes.
+
     @ingroup ripple_basics
 */
 template <class Object>
@@ -127,10 +165,23 @@ private:
     static auto&
     getCounter() noexcept
     {
-        static CountedObjects::Counter c{beast::type_name<Object>()};
+        static CountedObjects::Counter c{
+            beast::type_name<Object>(), sizeof(Object)};
         return c;
     }
 
+protected:
+    /** Account for memory allocated, or freed if negative, by an object
+        beyond its own size, such as the contents of its containers.
+
+        Every allocation counted must be uncounted when it is freed.
+    */
+    static void
+    countBytes(std::ptrdiff_t bytes) noexcept
+    {
+        getCounter().addBytes(bytes);
+    }
+
 public:
     CountedObject() noexcept
     {
@@ -39,6 +39,18 @@ writeFileContents(
     boost::filesystem::path const& destPath,
     std::string const& contents);
 
+/** Replace a file's contents as a single step.
+
+    The contents are written to destPath with ".tmp" appended, which is
+    then renamed over destPath. A crash part way through leaves either the
+    old file or the new one, never a partly written file.
+*/
+void
+writeFileContentsAtomic(
+    boost::system::error_code& ec,
+    boost::filesystem::path const& destPath,
+    std::string const& contents);
+
 }  // namespace ripple
 
 #endif
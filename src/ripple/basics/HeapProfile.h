@@ -0,0 +1,69 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_HEAPPROFILE_H_INCLUDED
+#define RIPPLE_BASICS_HEAPPROFILE_H_INCLUDED
+
+#include <ripple/json/json_value.h>
+#include <string>
+
+namespace ripple {
+namespace heapProfile {
+
+/** Inspects and controls the process's memory allocator.
+
+    Servers built with -Djemalloc=ON report jemalloc's statistics, for
+    the process and for each arena, and can write heap profiles when
+    jemalloc's profiling was enabled at startup, for example by running
+    with MALLOC_CONF=prof:true. Other servers report what their C library
+    allocator provides, if anything.
+
+    These are exported by the heap_profile command.
+*/
+
+/** Returns the name of the allocator in use. */
+char const*
+allocator() noexcept;
+
+/** Returns the allocator's statistics.
+
+    Byte counts are strings, since they may not fit a Json::UInt.
+*/
+Json::Value
+getJson();
+
+/** Return unused dirty pages held by the allocator to the system.
+
+    @return `true` if the allocator supports this.
+*/
+bool
+purge();
+
+/** Write a heap profile.
+
+    @param error Set to the reason if no profile was written.
+    @return `true` if a profile was written.
+*/
+bool
+dump(std::string& error);
+
+}  // namespace heapProfile
+}  // namespace ripple
+
+#endif
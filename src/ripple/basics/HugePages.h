@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_HUGEPAGES_H_INCLUDED
+#define RIPPLE_BASICS_HUGEPAGES_H_INCLUDED
+
+#include <ripple/basics/ByteUtilities.h>
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <string>
+
+namespace ripple {
+namespace hugePages {
+
+/** Backs large, long lived blocks of memory with huge pages.
+
+    The slabs SHAMapItems are carved from and the blocks SHAMap inner
+    nodes' child arrays are pooled in are read at random by every ledger
+    lookup. Mapping them with 2 MiB pages instead of 4 KiB ones lets the
+    TLB cover far more of them.
+
+    Blocks are whole multiples of the huge page size, aligned to it. How
+    they are backed depends on the mode, which is set from the
+    [huge_pages] configuration section:
+
+        off             The C library allocator's pages.
+        transparent     Memory which the kernel is asked, with madvise,
+                        to back with transparent huge pages. This is the
+                        default.
+        explicit        Huge pages reserved by the administrator through
+                        vm.nr_hugepages, mapped with MAP_HUGETLB. When
+                        none are left, this falls back to transparent.
+
+    On systems other than Linux, every mode behaves like off.
+*/
+enum class Mode { off, transparent, explicit_ };
+
+/** The size of a huge page. */
+constexpr std::size_t size = megabytes(std::size_t(2));
+
+/** Returns the mode named, if it is one. */
+std::optional<Mode>
+parseMode(std::string const& name);
+
+/** Sets how blocks allocated from now on are backed. */
+void
+setMode(Mode mode) noexcept;
+
+/** Returns how blocks are being backed. */
+Mode
+mode() noexcept;
+
+/** Allocate a block.
+
+    @param bytes The size of the block, which is rounded up to a multiple
+                 of the huge page size.
+    @return The block, aligned to the huge page size, or nullptr.
+*/
+void*
+allocate(std::size_t bytes) noexcept;
+
+/** Free a block returned by allocate.
+
+    @param bytes The size the block was allocated with.
+*/
+void
+deallocate(void* p, std::size_t bytes) noexcept;
+
+/** A boost.pool UserAllocator whose blocks are allocated by allocate.
+
+    The pool must always ask for blocks of at most BlockSize bytes.
+*/
+template <std::size_t BlockSize>
+struct PoolAllocator
+{
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    static char*
+    malloc(size_type const bytes)
+    {
+        assert(bytes <= BlockSize);
+        if (bytes > BlockSize)
+            return nullptr;
+        return static_cast<char*>(allocate(BlockSize));
+    }
+
+    static void
+    free(char* const block)
+    {
+        deallocate(block, BlockSize);
+    }
+};
+
+}  // namespace hugePages
+}  // namespace ripple
+
+#endif
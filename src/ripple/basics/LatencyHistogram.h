@@ -0,0 +1,180 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_LATENCYHISTOGRAM_H_INCLUDED
+#define RIPPLE_BASICS_LATENCYHISTOGRAM_H_INCLUDED
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+namespace ripple {
+
+/** A histogram of durations which can be updated without locking.
+
+    Durations are counted in buckets whose width grows with the duration,
+    in the style of an HDR histogram: values below 16 microseconds each
+    have a bucket, and above that each power of two is split into eight
+    buckets of equal width. Any recorded value is therefore reported to
+    within an eighth of its true value, over a range of almost 13 days,
+    with a fixed amount of memory.
+
+    Recording is a single relaxed atomic increment. Percentiles read the
+    buckets without stopping writers, so they may miss samples recorded
+    at the same time.
+*/
+class LatencyHistogram
+{
+public:
+    using duration = std::chrono::microseconds;
+
+    /** Count one sample. Negative durations are counted as zero. */
+    void
+    record(duration d) noexcept
+    {
+        auto const us = d.count() > 0 ? static_cast<std::uint64_t>(d.count())
+                                      : std::uint64_t{0};
+        buckets_[bucketFor(us)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /** Return the number of samples recorded. */
+    std::uint64_t
+    count() const noexcept
+    {
+        std::uint64_t total = 0;
+        for (auto const& b : buckets_)
+            total += b.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    /** Return the smallest duration that the given fraction of samples
+        do not exceed, or zero if there are no samples.
+
+        The result is the largest value in the bucket holding that
+        sample, so it is never less than the true percentile.
+
+        @param fraction The fraction of samples, between 0 and 1.
+    */
+    duration
+    percentile(double fraction) const noexcept
+    {
+        return percentile(snapshot(), fraction);
+    }
+
+private:
+    // Each power of two is split into 2^subBits buckets
+    static constexpr unsigned subBits = 3;
+    static constexpr std::uint64_t subCount = 1 << subBits;
+    // Values below this each have their own bucket
+    static constexpr std::uint64_t linearCount = 2 * subCount;
+    // Values are clamped below 2^maxBits microseconds
+    static constexpr unsigned maxBits = 40;
+
+public:
+    static constexpr std::size_t bucketCount =
+        linearCount + (maxBits - subBits - 1) * subCount;
+
+    /** The number of samples in each bucket. */
+    using Counts = std::array<std::uint64_t, bucketCount>;
+
+    /** Return the number of samples in each bucket so far.
+
+        Subtracting an earlier snapshot from a later one gives the samples
+        recorded in between, which lets percentiles be found over a window
+        of time rather than since the histogram was created.
+    */
+    Counts
+    snapshot() const noexcept
+    {
+        Counts counts;
+        for (std::size_t i = 0; i < bucketCount; ++i)
+            counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        return counts;
+    }
+
+    /** Return the percentile of the samples in a snapshot.
+
+        @see percentile
+    */
+    static duration
+    percentile(Counts const& counts, double fraction) noexcept
+    {
+        std::uint64_t total = 0;
+        for (auto const c : counts)
+            total += c;
+
+        if (total == 0)
+            return duration{0};
+
+        auto target = static_cast<std::uint64_t>(
+            std::ceil(std::clamp(fraction, 0.0, 1.0) * total));
+        if (target == 0)
+            target = 1;
+
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < bucketCount; ++i)
+        {
+            seen += counts[i];
+            if (seen >= target)
+                return duration(highestInBucket(i));
+        }
+        return duration(highestInBucket(bucketCount - 1));
+    }
+
+    /** Return the bucket a value in microseconds is counted in. */
+    static constexpr std::size_t
+    bucketFor(std::uint64_t us) noexcept
+    {
+        if (us < linearCount)
+            return us;
+        if (us >= (std::uint64_t{1} << maxBits))
+            return bucketCount - 1;
+
+        // The position of the highest bit picks the power of two, and the
+        // next subBits bits pick the bucket within it.
+        unsigned const high = std::bit_width(us) - 1;
+        auto const sub = (us >> (high - subBits)) & (subCount - 1);
+        return linearCount + (high - subBits - 1) * subCount + sub;
+    }
+
+    /** Return the largest value in microseconds counted in a bucket. */
+    static constexpr std::uint64_t
+    highestInBucket(std::size_t bucket) noexcept
+    {
+        if (bucket < linearCount)
+            return bucket;
+
+        auto const offset = bucket - linearCount;
+        unsigned const high = offset / subCount + subBits + 1;
+        auto const sub = offset % subCount;
+        auto const width = std::uint64_t{1} << (high - subBits);
+        return ((subCount + sub) << (high - subBits)) + width - 1;
+    }
+
+private:
+    std::array<std::atomic<std::uint64_t>, bucketCount> buckets_{};
+};
+
+}  // namespace ripple
+
+#endif
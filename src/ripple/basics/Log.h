@@ -24,6 +24,9 @@
 #include <ripple/beast/utility/Journal.h>
 #include <boost/beast/core/string.hpp>
 #include <boost/filesystem.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -146,6 +149,10 @@ private:
         }
         /** @} */
 
+        /** Flush anything buffered to the log file. */
+        void
+        flush();
+
     private:
         std::unique_ptr<std::ofstream> m_stream;
         boost::filesystem::path m_path;
@@ -159,7 +166,15 @@ private:
         sinks_;
     beast::severities::Severity thresh_;
     File file_;
-    bool silent_ = false;
+    std::atomic<bool> silent_{false};
+
+    // Formats and writes messages on its own thread
+    class Writer;
+    std::once_flag writerStarted_;
+    std::unique_ptr<Writer> writer_;
+
+    Writer&
+    writer();
 
 public:
     Logs(beast::severities::Severity level);
@@ -168,7 +183,7 @@ public:
     Logs&
     operator=(Logs const&) = delete;
 
-    virtual ~Logs() = default;
+    virtual ~Logs();
 
     bool
     open(boost::filesystem::path const& pathToLogFile);
@@ -191,6 +206,13 @@ public:
     std::vector<std::pair<std::string, std::string>>
     partition_severities() const;
 
+    /** Write a message to the log file and the console.
+
+        The message is queued and written by a separate thread, so the
+        caller never waits on the file. If the queue is full the message
+        is dropped and counted. Fatal messages are written before this
+        returns.
+    */
     void
     write(
         beast::severities::Severity level,
@@ -198,6 +220,14 @@ public:
         std::string const& text,
         bool console);
 
+    /** Wait until every message queued so far has been written. */
+    void
+    flush();
+
+    /** Returns the number of messages dropped because the queue was full. */
+    std::uint64_t
+    dropped();
+
     std::string
     rotate();
 
@@ -209,7 +239,7 @@ public:
     void
     silent(bool bSilent)
     {
-        silent_ = bSilent;
+        silent_.store(bSilent, std::memory_order_relaxed);
     }
 
     virtual std::unique_ptr<beast::Journal::Sink>
@@ -242,7 +272,8 @@ private:
         std::string& output,
         std::string const& message,
         beast::severities::Severity severity,
-        std::string const& partition);
+        std::string const& partition,
+        std::chrono::system_clock::time_point when);
 };
 
 // Wraps a Journal::Stream to skip evaluation of
@@ -21,8 +21,12 @@
 #define RIPPLE_BASICS_MATHUTILITIES_H_INCLUDED
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 
 namespace ripple {
 
@@ -63,6 +67,70 @@ static_assert(calculatePercent(50'000'000, 100'000'000) == 50);
 static_assert(calculatePercent(50'000'001, 100'000'000) == 51);
 static_assert(calculatePercent(99'999'999, 100'000'000) == 100);
 
+/** The powers of ten that fit in 64 bits, 10^0 through 10^19. */
+inline constexpr std::array<std::uint64_t, 20> powersOfTen = []() {
+    std::array<std::uint64_t, 20> powers{};
+    std::uint64_t power = 1;
+    for (auto& p : powers)
+    {
+        p = power;
+        power *= 10;
+    }
+    return powers;
+}();
+
+/** Return the number of decimal digits in a value other than zero.
+ *
+ * floor(log10(2) * bit width) is either the number of digits or one less,
+ * so a table lookup tells which without a loop.
+ */
+constexpr int
+decimalDigits(std::uint64_t value)
+{
+    assert(value != 0);
+    int const guess = (static_cast<int>(std::bit_width(value)) * 1233) >> 12;
+    return guess + (value >= powersOfTen[guess] ? 1 : 0);
+}
+
+/** Scale a positive mantissa up to at least a number of decimal digits.
+ *
+ * This gives the same mantissa and exponent as multiplying the mantissa by
+ * ten and decrementing the exponent until the mantissa has enough digits or
+ * the exponent reaches its minimum, but multiplies only once.
+ *
+ * @param mantissa The mantissa, which must be positive.
+ * @param exponent The exponent of @mantissa.
+ * @param digits The number of digits to scale @mantissa up to, at most 19.
+ * @param minExponent The exponent not to scale below.
+ */
+template <class Mantissa>
+constexpr void
+scaleToDigits(
+    Mantissa& mantissa,
+    int& exponent,
+    int digits,
+    int minExponent = std::numeric_limits<int>::min())
+{
+    assert(mantissa > 0 && digits < 20);
+    auto const shift = std::min<std::int64_t>(
+        digits - decimalDigits(static_cast<std::uint64_t>(mantissa)),
+        std::int64_t{exponent} - minExponent);
+    if (shift > 0)
+    {
+        mantissa *= static_cast<Mantissa>(powersOfTen[shift]);
+        exponent -= static_cast<int>(shift);
+    }
+}
+
+// unit tests
+static_assert(decimalDigits(1) == 1);
+static_assert(decimalDigits(9) == 1);
+static_assert(decimalDigits(10) == 2);
+static_assert(decimalDigits(999'999'999'999'999) == 15);
+static_assert(decimalDigits(1'000'000'000'000'000) == 16);
+static_assert(decimalDigits(9'999'999'999'999'999) == 16);
+static_assert(decimalDigits(std::numeric_limits<std::uint64_t>::max()) == 20);
+
 }  // namespace ripple
 
 #endif
@@ -0,0 +1,75 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_NUMA_H_INCLUDED
+#define RIPPLE_BASICS_NUMA_H_INCLUDED
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+namespace numa {
+
+/** Places threads on the NUMA nodes of the machine.
+
+    On a server with several sockets, a thread which wanders between them
+    keeps reaching across the interconnect for memory it first touched
+    elsewhere. Pinning a thread to the CPUs of one node before it starts
+    work means the pages it faults in are allocated on that node, since
+    Linux places a page on the node of the thread which first touches it.
+
+    On systems other than Linux, no nodes are found and pinning does
+    nothing.
+*/
+
+/** Returns the CPUs of each NUMA node, indexed by node number.
+
+    The topology is read once from /sys/devices/system/node. A node
+    without CPUs has an empty entry. If the topology can not be read,
+    the result is empty.
+*/
+std::vector<std::vector<unsigned>> const&
+nodes();
+
+/** Restrict a thread to a set of CPUs.
+
+    A thread which can not be pinned still runs, just anywhere.
+
+    @param cpus The CPUs the thread may run on. If empty, nothing changes.
+*/
+void
+pin(std::thread& t, std::vector<unsigned> const& cpus) noexcept;
+
+/** Restrict a thread to the CPUs of one NUMA node.
+
+    Successive indexes are spread over the nodes which have CPUs, so that
+    the threads of a pool are divided evenly between them. On a machine
+    with a single node, nothing changes.
+
+    @param index The position of the thread in its pool.
+*/
+void
+spread(std::thread& t, std::size_t index) noexcept;
+
+}  // namespace numa
+}  // namespace ripple
+
+#endif
@@ -138,6 +138,23 @@ public:
     virtual void
     jobFinish(JobType const type, microseconds dur, int instance) = 0;
 
+    /**
+     * Log the checkout of a read-only database connection
+     *
+     * @param database Name of the database
+     * @param wait Time spent waiting for a connection to be free
+     */
+    virtual void
+    dbReader(std::string const& database, microseconds wait) = 0;
+
+    /**
+     * Log a wait for the JobQueue's lock, which another thread held
+     *
+     * @param wait Time spent waiting for the lock
+     */
+    virtual void
+    jobQueueLock(microseconds wait) = 0;
+
     /**
      * Render performance counters in Json
      *
@@ -154,6 +171,15 @@ public:
     virtual Json::Value
     currentJson() const = 0;
 
+    /**
+     * Render the 50th, 99th and 99.9th percentiles of the durations of
+     * each RPC method, and of each job type's queued and running times.
+     *
+     * @return Latency percentiles Json object
+     */
+    virtual Json::Value
+    latencyJson() const = 0;
+
     /**
      * Ensure enough room to store each currently executing job
      *
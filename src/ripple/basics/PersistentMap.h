@@ -0,0 +1,405 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_PERSISTENTMAP_H_INCLUDED
+#define RIPPLE_BASICS_PERSISTENTMAP_H_INCLUDED
+
+#include <ripple/basics/random.h>
+#include <boost/container/small_vector.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace ripple {
+
+/** An ordered map whose copies share their nodes.
+
+    The map is a treap of reference counted nodes. Copying a map copies
+    one pointer. Changing a map copies only the nodes on the path to the
+    changed key that are shared with another map, and modifies the nodes
+    it owns alone in place, so a map that is never copied costs about
+    what a std::map does.
+
+    Maps sharing nodes may be used from different threads. As with the
+    standard containers, one map may not be changed while it is being
+    read, and changing a map invalidates its iterators.
+*/
+template <class Key, class T, class Compare = std::less<Key>>
+class PersistentMap
+{
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key const, T>;
+    using size_type = std::size_t;
+
+private:
+    struct Node;
+    using node_ptr = std::shared_ptr<Node>;
+
+    struct Node
+    {
+        value_type value;
+        std::uint64_t priority;
+        node_ptr left;
+        node_ptr right;
+    };
+
+    node_ptr root_;
+    size_type size_ = 0;
+    Compare comp_;
+
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = PersistentMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = value_type const*;
+        using reference = value_type const&;
+
+        const_iterator() = default;
+
+        reference
+        operator*() const
+        {
+            return stack_.back()->value;
+        }
+
+        pointer
+        operator->() const
+        {
+            return &stack_.back()->value;
+        }
+
+        const_iterator&
+        operator++()
+        {
+            Node const* const n = stack_.back();
+            stack_.pop_back();
+            pushLeft(n->right.get());
+            return *this;
+        }
+
+        const_iterator
+        operator++(int)
+        {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+
+        friend bool
+        operator==(const_iterator const& lhs, const_iterator const& rhs)
+        {
+            if (lhs.stack_.empty() || rhs.stack_.empty())
+                return lhs.stack_.empty() == rhs.stack_.empty();
+            return lhs.stack_.back() == rhs.stack_.back();
+        }
+
+        friend bool
+        operator!=(const_iterator const& lhs, const_iterator const& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        friend class PersistentMap;
+
+        // The current node is on top, below it are the ancestors whose
+        // left subtree holds it, which come next in order.
+        boost::container::small_vector<Node const*, 32> stack_;
+
+        void
+        pushLeft(Node const* n)
+        {
+            for (; n; n = n->left.get())
+                stack_.push_back(n);
+        }
+    };
+
+    using iterator = const_iterator;
+
+    PersistentMap() = default;
+    PersistentMap(PersistentMap const&) = default;
+    PersistentMap(PersistentMap&&) = default;
+    PersistentMap&
+    operator=(PersistentMap const&) = default;
+    PersistentMap&
+    operator=(PersistentMap&&) = default;
+
+    size_type
+    size() const
+    {
+        return size_;
+    }
+
+    bool
+    empty() const
+    {
+        return size_ == 0;
+    }
+
+    void
+    clear()
+    {
+        root_.reset();
+        size_ = 0;
+    }
+
+    const_iterator
+    begin() const
+    {
+        const_iterator result;
+        result.pushLeft(root_.get());
+        return result;
+    }
+
+    const_iterator
+    end() const
+    {
+        return {};
+    }
+
+    const_iterator
+    cbegin() const
+    {
+        return begin();
+    }
+
+    const_iterator
+    cend() const
+    {
+        return end();
+    }
+
+    /** Returns the value for a key, or nullptr if there is none.
+
+        This is cheaper than find, which has to prepare for iteration.
+    */
+    T const*
+    get(Key const& key) const
+    {
+        for (Node const* n = root_.get(); n;)
+        {
+            if (comp_(key, n->value.first))
+                n = n->left.get();
+            else if (comp_(n->value.first, key))
+                n = n->right.get();
+            else
+                return &n->value.second;
+        }
+        return nullptr;
+    }
+
+    const_iterator
+    find(Key const& key) const
+    {
+        auto result = lower_bound(key);
+        if (result != end() && comp_(key, result->first))
+            return end();
+        return result;
+    }
+
+    const_iterator
+    lower_bound(Key const& key) const
+    {
+        const_iterator result;
+        for (Node const* n = root_.get(); n;)
+        {
+            if (comp_(n->value.first, key))
+            {
+                n = n->right.get();
+            }
+            else
+            {
+                result.stack_.push_back(n);
+                n = n->left.get();
+            }
+        }
+        return result;
+    }
+
+    const_iterator
+    upper_bound(Key const& key) const
+    {
+        const_iterator result;
+        for (Node const* n = root_.get(); n;)
+        {
+            if (comp_(key, n->value.first))
+            {
+                result.stack_.push_back(n);
+                n = n->left.get();
+            }
+            else
+            {
+                n = n->right.get();
+            }
+        }
+        return result;
+    }
+
+    /** Adds a value if the key is not present.
+
+        @return `true` if the value was added.
+    */
+    bool
+    insert(Key const& key, T const& value)
+    {
+        if (get(key))
+            return false;
+        assign(root_, key, value, default_prng()());
+        ++size_;
+        return true;
+    }
+
+    /** Sets the value for a key.
+
+        @return `true` if the key was not present.
+    */
+    bool
+    insert_or_assign(Key const& key, T const& value)
+    {
+        bool const inserted = assign(root_, key, value, default_prng()());
+        if (inserted)
+            ++size_;
+        return inserted;
+    }
+
+    /** Removes a key.
+
+        @return The number of values removed.
+    */
+    size_type
+    erase(Key const& key)
+    {
+        if (!get(key))
+            return 0;
+        remove(root_, key);
+        --size_;
+        return 1;
+    }
+
+private:
+    // Returns the node a pointer refers to, first replacing it with a copy
+    // if any other map may still refer to it.
+    static Node&
+    mutate(node_ptr& p)
+    {
+        if (p.use_count() != 1)
+            p = std::make_shared<Node>(*p);
+        else
+            std::atomic_thread_fence(std::memory_order_acquire);
+        return *p;
+    }
+
+    // Nodes on the path from the root to a change are owned by this map
+    // alone by the time they are relinked.
+    static void
+    rotateRight(node_ptr& p)
+    {
+        node_ptr l = std::move(p->left);
+        p->left = std::move(l->right);
+        l->right = std::move(p);
+        p = std::move(l);
+    }
+
+    static void
+    rotateLeft(node_ptr& p)
+    {
+        node_ptr r = std::move(p->right);
+        p->right = std::move(r->left);
+        r->left = std::move(p);
+        p = std::move(r);
+    }
+
+    bool
+    assign(
+        node_ptr& p,
+        Key const& key,
+        T const& value,
+        std::uint64_t priority)
+    {
+        if (!p)
+        {
+            p = std::make_shared<Node>(
+                Node{value_type{key, value}, priority, nullptr, nullptr});
+            return true;
+        }
+
+        Node& n = mutate(p);
+        if (comp_(key, n.value.first))
+        {
+            bool const inserted = assign(n.left, key, value, priority);
+            if (n.left->priority > n.priority)
+                rotateRight(p);
+            return inserted;
+        }
+        if (comp_(n.value.first, key))
+        {
+            bool const inserted = assign(n.right, key, value, priority);
+            if (n.right->priority > n.priority)
+                rotateLeft(p);
+            return inserted;
+        }
+        n.value.second = value;
+        return false;
+    }
+
+    // The key must be present
+    void
+    remove(node_ptr& p, Key const& key)
+    {
+        Node& n = mutate(p);
+        if (comp_(key, n.value.first))
+            return remove(n.left, key);
+        if (comp_(n.value.first, key))
+            return remove(n.right, key);
+        node_ptr left = std::move(n.left);
+        node_ptr right = std::move(n.right);
+        p = merge(std::move(left), std::move(right));
+    }
+
+    static node_ptr
+    merge(node_ptr left, node_ptr right)
+    {
+        if (!left)
+            return right;
+        if (!right)
+            return left;
+        if (left->priority > right->priority)
+        {
+            Node& n = mutate(left);
+            n.right = merge(std::move(n.right), std::move(right));
+            return left;
+        }
+        Node& n = mutate(right);
+        n.left = merge(std::move(left), std::move(n.left));
+        return right;
+    }
+};
+
+}  // namespace ripple
+
+#endif
@@ -191,6 +191,31 @@ prevMissing(RangeSet<T> const& rs, T t, T minVal = 0)
     return boost::icl::last(tgt);
 }
 
+/** Find the largest ranges of values not in the set below a given value.
+
+    @param rs The set of interest
+    @param t The value that must be larger than the results
+    @param minVal The smallest allowed value
+    @param maxCount The largest number of ranges to return
+    @return Up to maxCount disjoint intervals of values v such that
+            minVal <= v < t and !contains(rs, v), ordered from the largest
+            values down. The first interval ends at prevMissing(rs, t, minVal).
+*/
+template <class T>
+std::vector<ClosedInterval<T>>
+missingRanges(RangeSet<T> const& rs, T t, T minVal, std::size_t maxCount)
+{
+    std::vector<ClosedInterval<T>> ret;
+    if (rs.empty() || t <= minVal || maxCount == 0)
+        return ret;
+    RangeSet<T> tgt{ClosedInterval<T>{minVal, t - 1}};
+    tgt -= rs;
+    for (auto it = tgt.rbegin(); it != tgt.rend() && ret.size() < maxCount;
+         ++it)
+        ret.push_back(*it);
+    return ret;
+}
+
 }  // namespace ripple
 
 #endif
@@ -0,0 +1,709 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_SHARDEDTAGGEDCACHE_H_INCLUDED
+#define RIPPLE_BASICS_SHARDEDTAGGEDCACHE_H_INCLUDED
+
+#include <ripple/basics/Log.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/basics/hardened_hash.h>
+#include <ripple/basics/partitioned_unordered_map.h>
+#include <ripple/beast/clock/abstract_clock.h>
+#include <ripple/beast/insight/Insight.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+
+/** Map/cache combination with a lock per shard.
+
+    This offers the same interface and the same semantics as TaggedCache
+    for caches of values, but the keys are split across a number of
+    shards by hash, each with its own lock. Lookups and insertions only
+    contend with other operations on the same shard, and a sweep visits
+    one shard at a time so readers of the other shards are not stalled.
+
+    Because there is no single lock over the whole cache, there is no
+    equivalent of TaggedCache::peekMutex(). Sizes and hit rates are
+    gathered shard by shard and may be slightly stale under concurrent
+    modification.
+
+    @note Callers must not modify data objects that are stored in the cache.
+*/
+template <
+    class Key,
+    class T,
+    class Hash = hardened_hash<>,
+    class KeyEqual = std::equal_to<Key>,
+    class Mutex = std::mutex>
+class ShardedTaggedCache
+{
+public:
+    using mutex_type = Mutex;
+    using key_type = Key;
+    using mapped_type = T;
+    using clock_type = beast::abstract_clock<std::chrono::steady_clock>;
+
+    /** Construct the cache.
+
+        @param shards The number of shards. If zero, one shard is created
+                      per hardware thread.
+    */
+    ShardedTaggedCache(
+        std::string const& name,
+        int size,
+        clock_type::duration expiration,
+        clock_type& clock,
+        beast::Journal journal,
+        beast::insight::Collector::ptr const& collector =
+            beast::insight::NullCollector::New(),
+        std::size_t shards = 0)
+        : m_journal(journal)
+        , m_clock(clock)
+        , m_stats(
+              name,
+              std::bind(&ShardedTaggedCache::collect_metrics, this),
+              collector)
+        , m_name(name)
+        , m_target_size(size)
+        , m_target_age(expiration)
+        , m_shards(std::max<std::size_t>(
+              shards ? shards : std::thread::hardware_concurrency(),
+              1))
+    {
+    }
+
+    /** Return the clock associated with the cache. */
+    clock_type&
+    clock()
+    {
+        return m_clock;
+    }
+
+    /** Returns the number of shards. */
+    std::size_t
+    shards() const
+    {
+        return m_shards.size();
+    }
+
+    /** Returns the number of items in the container. */
+    std::size_t
+    size() const
+    {
+        std::size_t ret = 0;
+        for (auto const& shard : m_shards)
+        {
+            std::lock_guard lock(shard.mutex);
+            ret += shard.map.size();
+        }
+        return ret;
+    }
+
+    int
+    getTargetSize() const
+    {
+        return m_target_size.load();
+    }
+
+    void
+    setTargetSize(int s)
+    {
+        m_target_size = s;
+
+        if (s > 0)
+        {
+            for (auto& shard : m_shards)
+            {
+                std::lock_guard lock(shard.mutex);
+                shard.map.rehash(static_cast<std::size_t>(
+                    (s + (s >> 2)) /
+                        (shard.map.max_load_factor() * m_shards.size()) +
+                    1));
+            }
+        }
+
+        JLOG(m_journal.debug()) << m_name << " target size set to " << s;
+    }
+
+    clock_type::duration
+    getTargetAge() const
+    {
+        return m_target_age.load();
+    }
+
+    void
+    setTargetAge(clock_type::duration s)
+    {
+        m_target_age = s;
+        JLOG(m_journal.debug())
+            << m_name << " target age set to " << s.count();
+    }
+
+    int
+    getCacheSize() const
+    {
+        int ret = 0;
+        for (auto const& shard : m_shards)
+        {
+            std::lock_guard lock(shard.mutex);
+            ret += shard.cacheCount;
+        }
+        return ret;
+    }
+
+    int
+    getTrackSize() const
+    {
+        return static_cast<int>(size());
+    }
+
+    /** Returns the number of lookups which found and did not find an item.
+     */
+    std::pair<std::uint64_t, std::uint64_t>
+    getHitsAndMisses() const
+    {
+        return {m_hits.load(), m_misses.load()};
+    }
+
+    float
+    getHitRate()
+    {
+        auto const total = static_cast<float>(m_hits + m_misses);
+        return m_hits * (100.0f / std::max(1.0f, total));
+    }
+
+    void
+    clear()
+    {
+        for (auto& shard : m_shards)
+        {
+            std::lock_guard lock(shard.mutex);
+            shard.map.clear();
+            shard.cacheCount = 0;
+        }
+    }
+
+    void
+    reset()
+    {
+        clear();
+        m_hits = 0;
+        m_misses = 0;
+    }
+
+    /** Refresh the last access time on a key if present.
+        @return `true` If the key was found.
+    */
+    bool
+    touch_if_exists(key_type const& key)
+    {
+        auto& shard = shardFor(key);
+        std::lock_guard lock(shard.mutex);
+        auto const iter(shard.map.find(key));
+        if (iter == shard.map.end())
+        {
+            ++m_stats.misses;
+            return false;
+        }
+        iter->second.touch(m_clock.now());
+        ++m_stats.hits;
+        return true;
+    }
+
+    void
+    sweep()
+    {
+        clock_type::time_point const now(m_clock.now());
+        auto const start = std::chrono::steady_clock::now();
+
+        // The target size is spread evenly across the shards, so each
+        // shard ages its entries as if it were a cache of its own.
+        int const targetSize = m_target_size;
+        int const shardTarget = targetSize == 0
+            ? 0
+            : std::max(1, targetSize / static_cast<int>(m_shards.size()));
+        auto const targetAge = m_target_age.load();
+
+        int allRemovals = 0;
+        for (auto& shard : m_shards)
+            allRemovals += sweepShard(shard, now, shardTarget, targetAge);
+
+        JLOG(m_journal.debug())
+            << m_name << " ShardedTaggedCache sweep of " << allRemovals
+            << " entries took "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now() - start)
+                   .count()
+            << "ms";
+    }
+
+    bool
+    del(key_type const& key, bool valid)
+    {
+        // Remove from cache, if !valid, remove from map too. Returns true if
+        // removed from cache
+        auto& shard = shardFor(key);
+        std::lock_guard lock(shard.mutex);
+
+        auto cit = shard.map.find(key);
+
+        if (cit == shard.map.end())
+            return false;
+
+        Entry& entry = cit->second;
+
+        bool ret = false;
+
+        if (entry.isCached())
+        {
+            --shard.cacheCount;
+            entry.ptr.reset();
+            ret = true;
+        }
+
+        if (!valid || entry.isExpired())
+            shard.map.erase(cit);
+
+        return ret;
+    }
+
+    /** Replace aliased objects with originals.
+
+        @see TaggedCache::canonicalize
+
+        @return `true` If the key already existed.
+    */
+    bool
+    canonicalize(
+        key_type const& key,
+        std::shared_ptr<T>& data,
+        std::function<bool(std::shared_ptr<T> const&)>&& replace)
+    {
+        auto& shard = shardFor(key);
+        std::lock_guard lock(shard.mutex);
+
+        auto cit = shard.map.find(key);
+
+        if (cit == shard.map.end())
+        {
+            shard.map.emplace(
+                std::piecewise_construct,
+                std::forward_as_tuple(key),
+                std::forward_as_tuple(m_clock.now(), data));
+            ++shard.cacheCount;
+            return false;
+        }
+
+        Entry& entry = cit->second;
+        entry.touch(m_clock.now());
+
+        if (entry.isCached())
+        {
+            if (replace(entry.ptr))
+            {
+                entry.ptr = data;
+                entry.weak_ptr = data;
+            }
+            else
+            {
+                data = entry.ptr;
+            }
+
+            return true;
+        }
+
+        auto cachedData = entry.lock();
+
+        if (cachedData)
+        {
+            if (replace(entry.ptr))
+            {
+                entry.ptr = data;
+                entry.weak_ptr = data;
+            }
+            else
+            {
+                entry.ptr = cachedData;
+                data = cachedData;
+            }
+
+            ++shard.cacheCount;
+            return true;
+        }
+
+        entry.ptr = data;
+        entry.weak_ptr = data;
+        ++shard.cacheCount;
+
+        return false;
+    }
+
+    bool
+    canonicalize_replace_cache(
+        key_type const& key,
+        std::shared_ptr<T> const& data)
+    {
+        return canonicalize(
+            key,
+            const_cast<std::shared_ptr<T>&>(data),
+            [](std::shared_ptr<T> const&) { return true; });
+    }
+
+    bool
+    canonicalize_replace_client(key_type const& key, std::shared_ptr<T>& data)
+    {
+        return canonicalize(
+            key, data, [](std::shared_ptr<T> const&) { return false; });
+    }
+
+    std::shared_ptr<T>
+    fetch(key_type const& key)
+    {
+        auto& shard = shardFor(key);
+        std::lock_guard lock(shard.mutex);
+        auto ret = initialFetch(shard, key);
+        if (!ret)
+            ++m_misses;
+        return ret;
+    }
+
+    /** Insert the element into the container.
+        If the key already exists, nothing happens.
+        @return `true` If the element was inserted
+    */
+    bool
+    insert(key_type const& key, T const& value)
+    {
+        auto p = std::make_shared<T>(std::cref(value));
+        return canonicalize_replace_client(key, p);
+    }
+
+    bool
+    retrieve(key_type const& key, T& data)
+    {
+        // retrieve the value of the stored data
+        auto entry = fetch(key);
+
+        if (!entry)
+            return false;
+
+        data = *entry;
+        return true;
+    }
+
+    std::vector<key_type>
+    getKeys() const
+    {
+        std::vector<key_type> v;
+
+        for (auto const& shard : m_shards)
+        {
+            std::lock_guard lock(shard.mutex);
+            v.reserve(v.size() + shard.map.size());
+            for (auto const& _ : shard.map)
+                v.push_back(_.first);
+        }
+
+        return v;
+    }
+
+    /** Returns the fraction of cache hits. */
+    double
+    rate() const
+    {
+        auto const hits = m_hits.load();
+        auto const tot = hits + m_misses.load();
+        if (tot == 0)
+            return 0;
+        return double(hits) / tot;
+    }
+
+    /** Fetch an item from the cache.
+        If the digest was not found, Handler
+        will be called with this signature:
+            std::shared_ptr<T>(void)
+    */
+    template <class Handler>
+    std::shared_ptr<T>
+    fetch(key_type const& digest, Handler const& h)
+    {
+        auto& shard = shardFor(digest);
+        {
+            std::lock_guard lock(shard.mutex);
+            if (auto ret = initialFetch(shard, digest))
+                return ret;
+        }
+
+        auto sle = h();
+        if (!sle)
+            return {};
+
+        std::lock_guard lock(shard.mutex);
+        ++m_misses;
+        auto const [it, inserted] =
+            shard.map.emplace(digest, Entry(m_clock.now(), std::move(sle)));
+        if (inserted)
+            ++shard.cacheCount;
+        else
+            it->second.touch(m_clock.now());
+        return it->second.ptr;
+    }
+
+private:
+    class Entry
+    {
+    public:
+        std::shared_ptr<mapped_type> ptr;
+        std::weak_ptr<mapped_type> weak_ptr;
+        clock_type::time_point last_access;
+
+        Entry(
+            clock_type::time_point const& last_access_,
+            std::shared_ptr<mapped_type> const& ptr_)
+            : ptr(ptr_), weak_ptr(ptr_), last_access(last_access_)
+        {
+        }
+
+        bool
+        isWeak() const
+        {
+            return ptr == nullptr;
+        }
+        bool
+        isCached() const
+        {
+            return ptr != nullptr;
+        }
+        bool
+        isExpired() const
+        {
+            return weak_ptr.expired();
+        }
+        std::shared_ptr<mapped_type>
+        lock()
+        {
+            return weak_ptr.lock();
+        }
+        void
+        touch(clock_type::time_point const& now)
+        {
+            last_access = now;
+        }
+    };
+
+    struct Shard
+    {
+        mutex_type mutable mutex;
+        hardened_hash_map<key_type, Entry, Hash, KeyEqual> map;
+        // Number of items cached (held by a strong pointer)
+        int cacheCount = 0;
+    };
+
+    struct Stats
+    {
+        template <class Handler>
+        Stats(
+            std::string const& prefix,
+            Handler const& handler,
+            beast::insight::Collector::ptr const& collector)
+            : hook(collector->make_hook(handler))
+            , size(collector->make_gauge(prefix, "size"))
+            , hit_rate(collector->make_gauge(prefix, "hit_rate"))
+            , hits(0)
+            , misses(0)
+        {
+        }
+
+        beast::insight::Hook hook;
+        beast::insight::Gauge size;
+        beast::insight::Gauge hit_rate;
+
+        std::atomic<std::size_t> hits;
+        std::atomic<std::size_t> misses;
+    };
+
+    Shard&
+    shardFor(key_type const& key)
+    {
+        return m_shards[partitioner(key, m_shards.size())];
+    }
+
+    std::shared_ptr<T>
+    initialFetch(Shard& shard, key_type const& key)
+    {
+        auto cit = shard.map.find(key);
+        if (cit == shard.map.end())
+            return {};
+
+        Entry& entry = cit->second;
+        if (entry.isCached())
+        {
+            ++m_hits;
+            entry.touch(m_clock.now());
+            return entry.ptr;
+        }
+        entry.ptr = entry.lock();
+        if (entry.isCached())
+        {
+            // independent of cache size, so not counted as a hit
+            ++shard.cacheCount;
+            entry.touch(m_clock.now());
+            return entry.ptr;
+        }
+
+        shard.map.erase(cit);
+        return {};
+    }
+
+    /** Sweep a single shard, holding only that shard's lock.
+
+        @return The number of entries removed from the cache.
+    */
+    int
+    sweepShard(
+        Shard& shard,
+        clock_type::time_point const& now,
+        int targetSize,
+        clock_type::duration targetAge)
+    {
+        // Keep references to all the stuff we sweep
+        // so that we can destroy them outside the lock.
+        std::vector<std::shared_ptr<mapped_type>> stuffToSweep;
+        int cacheRemovals = 0;
+        int mapRemovals = 0;
+
+        {
+            std::lock_guard lock(shard.mutex);
+
+            clock_type::time_point when_expire;
+            auto const size = shard.map.size();
+            if (targetSize == 0 || (static_cast<int>(size) <= targetSize))
+            {
+                when_expire = now - targetAge;
+            }
+            else
+            {
+                when_expire = now - targetAge * targetSize / size;
+
+                clock_type::duration const minimumAge(std::chrono::seconds(1));
+                if (when_expire > (now - minimumAge))
+                    when_expire = now - minimumAge;
+            }
+
+            stuffToSweep.reserve(size);
+
+            auto cit = shard.map.begin();
+            while (cit != shard.map.end())
+            {
+                if (cit->second.isWeak())
+                {
+                    // weak
+                    if (cit->second.isExpired())
+                    {
+                        ++mapRemovals;
+                        cit = shard.map.erase(cit);
+                    }
+                    else
+                    {
+                        ++cit;
+                    }
+                }
+                else if (cit->second.last_access <= when_expire)
+                {
+                    // strong, expired
+                    ++cacheRemovals;
+                    if (cit->second.ptr.use_count() == 1)
+                    {
+                        stuffToSweep.push_back(std::move(cit->second.ptr));
+                        ++mapRemovals;
+                        cit = shard.map.erase(cit);
+                    }
+                    else
+                    {
+                        // remains weakly cached
+                        cit->second.ptr.reset();
+                        ++cit;
+                    }
+                }
+                else
+                {
+                    // strong, not expired
+                    ++cit;
+                }
+            }
+
+            shard.cacheCount -= cacheRemovals;
+        }
+
+        if (mapRemovals || cacheRemovals)
+        {
+            JLOG(m_journal.trace())
+                << "ShardedTaggedCache shard sweep " << m_name
+                << ": cache -= " << cacheRemovals
+                << ", map -= " << mapRemovals;
+        }
+
+        // stuffToSweep goes out of scope here, outside the lock.
+        return cacheRemovals;
+    }
+
+    void
+    collect_metrics()
+    {
+        m_stats.size.set(getCacheSize());
+
+        {
+            beast::insight::Gauge::value_type hit_rate(0);
+            auto const hits = m_hits.load();
+            auto const total(hits + m_misses.load());
+            if (total != 0)
+                hit_rate = (hits * 100) / total;
+            m_stats.hit_rate.set(hit_rate);
+        }
+    }
+
+    beast::Journal m_journal;
+    clock_type& m_clock;
+    Stats m_stats;
+
+    // Used for logging
+    std::string m_name;
+
+    // Desired number of cache entries (0 = ignore)
+    std::atomic<int> m_target_size;
+
+    // Desired maximum cache age
+    std::atomic<clock_type::duration> m_target_age;
+
+    std::vector<Shard> m_shards;
+    std::atomic<std::uint64_t> m_hits{0};
+    std::atomic<std::uint64_t> m_misses{0};
+};
+
+}  // namespace ripple
+
+#endif
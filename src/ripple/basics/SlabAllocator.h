@@ -20,11 +20,11 @@
 #ifndef RIPPLE_BASICS_SLABALLOCATOR_H_INCLUDED
 #define RIPPLE_BASICS_SLABALLOCATOR_H_INCLUDED
 
+#include <ripple/basics/HugePages.h>
 #include <ripple/beast/type_name.h>
 
 #include <boost/align.hpp>
 #include <boost/container/static_vector.hpp>
-#include <boost/predef.h>
 
 #include <algorithm>
 #include <atomic>
@@ -32,10 +32,8 @@
 #include <cstdint>
 #include <cstring>
 #include <mutex>
-
-#if BOOST_OS_LINUX
-#include <sys/mman.h>
-#endif
+#include <stdexcept>
+#include <vector>
 
 namespace ripple {
 
@@ -66,6 +64,12 @@ class SlabAllocator
         // The extent of the underlying memory block:
         std::size_t const size_;
 
+        // The number of items carved out of the block:
+        std::size_t capacity_ = 0;
+
+        // The number of items on the freelist:
+        std::size_t free_ = 0;
+
         SlabBlock(
             SlabBlock* next,
             std::uint8_t* data,
@@ -83,7 +87,10 @@ class SlabAllocator
                 std::memcpy(data, &l_, sizeof(std::uint8_t*));
                 l_ = data;
                 data += item;
+                ++capacity_;
             }
+
+            free_ = capacity_;
         }
 
         ~SlabBlock()
@@ -123,12 +130,34 @@ class SlabAllocator
                     // Use memcpy to avoid unaligned UB
                     // (will optimize to equivalent code)
                     std::memcpy(&l_, ret, sizeof(std::uint8_t*));
+                    --free_;
                 }
             }
 
             return ret;
         }
 
+        /** Take up to `count` items from the freelist at once.
+
+            @return the number of items written to `items`.
+         */
+        std::size_t
+        allocate(std::uint8_t** items, std::size_t count) noexcept
+        {
+            std::lock_guard l(m_);
+
+            std::size_t n = 0;
+
+            while (n != count && l_ != nullptr)
+            {
+                items[n++] = l_;
+                std::memcpy(&l_, items[n - 1], sizeof(std::uint8_t*));
+            }
+
+            free_ -= n;
+            return n;
+        }
+
         /** Return an item to this allocator's freelist.
 
             @param ptr The pointer to the chunk of memory being deallocated.
@@ -149,73 +178,216 @@ class SlabAllocator
             // (will optimize to equivalent code)
             std::memcpy(ptr, &l_, sizeof(std::uint8_t*));
             l_ = ptr;
+            ++free_;
+        }
+
+        /** Return several items, all owned by this block, at once. */
+        void
+        deallocate(std::uint8_t* const* items, std::size_t count) noexcept
+        {
+            std::lock_guard l(m_);
+
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                assert(own(items[i]));
+                std::memcpy(items[i], &l_, sizeof(std::uint8_t*));
+                l_ = items[i];
+            }
+
+            free_ += count;
+        }
+
+        /** Returns the number of items on the freelist. */
+        std::size_t
+        available() noexcept
+        {
+            std::lock_guard l(m_);
+            return free_;
+        }
+    };
+
+public:
+    /** Usage counters, as returned by stats(). */
+    struct Stats
+    {
+        // The number of slabs and the memory they take up:
+        std::size_t slabs = 0;
+        std::size_t bytes = 0;
+
+        // The number of items the slabs hold:
+        std::size_t items = 0;
+
+        // Items taken from the slabs, including the few that are free but
+        // held in per-thread magazines:
+        std::size_t inUse = 0;
+
+        Stats&
+        operator+=(Stats const& other) noexcept
+        {
+            slabs += other.slabs;
+            bytes += other.bytes;
+            items += other.items;
+            inUse += other.inUse;
+            return *this;
         }
     };
 
 private:
-    // A linked list of slabs
-    std::atomic<SlabBlock*> slabs_ = nullptr;
+    /** Free items a thread keeps for one allocator.
 
-    // The alignment requirements of the item we're allocating:
-    std::size_t const itemAlignment_;
+        Allocating and deallocating go through the calling thread's
+        magazine, which only exchanges items with the slabs, under their
+        locks, in batches of half its size.
+     */
+    struct Magazine
+    {
+        static constexpr std::size_t size = 32;
 
-    // The size of an item, including the extra bytes requested and
-    // any padding needed for alignment purposes:
-    std::size_t const itemSize_;
+        // Only the owning thread sets this to an allocator, but the
+        // allocator clears it when it is destroyed.
+        std::atomic<SlabAllocator*> owner = nullptr;
 
-    // The size of each individual slab:
-    std::size_t const slabSize_;
+        // The next magazine registered with the same allocator
+        Magazine* next = nullptr;
 
-public:
-    /** Constructs a slab allocator able to allocate objects of a fixed size
+        std::size_t count = 0;
+        std::uint8_t* items[size];
+    };
 
-        @param count the number of items the slab allocator can allocate; note
-                     that a count of 0 is valid and means that the allocator
-                     is, effectively, disabled. This can be very useful in some
-                     contexts (e.g. when mimimal memory usage is needed) and
-                     allows for graceful failure.
+    /** Protects the registration of magazines with their allocators.
+
+        Only taken when a thread first uses an allocator, when it exits,
+        and when an allocator is destroyed.
      */
-    constexpr explicit SlabAllocator(
-        std::size_t extra,
-        std::size_t alloc = 0,
-        std::size_t align = 0)
-        : itemAlignment_(align ? align : alignof(Type))
-        , itemSize_(
-              boost::alignment::align_up(sizeof(Type) + extra, itemAlignment_))
-        , slabSize_(alloc)
+    static std::mutex&
+    registryMutex() noexcept
     {
-        assert((itemAlignment_ & (itemAlignment_ - 1)) == 0);
+        static std::mutex m;
+        return m;
     }
 
-    SlabAllocator(SlabAllocator const& other) = delete;
-    SlabAllocator&
-    operator=(SlabAllocator const& other) = delete;
+    struct Magazines
+    {
+        // How many allocators of one type a thread can cache for
+        static constexpr std::size_t size = 16;
 
-    SlabAllocator(SlabAllocator&& other) = delete;
-    SlabAllocator&
-    operator=(SlabAllocator&& other) = delete;
+        Magazine m[size];
 
-    ~SlabAllocator()
+        Magazines() = default;
+        Magazines(Magazines const&) = delete;
+        Magazines&
+        operator=(Magazines const&) = delete;
+
+        ~Magazines()
+        {
+            std::lock_guard l(registryMutex());
+
+            for (auto& mag : m)
+            {
+                if (auto owner = mag.owner.load())
+                {
+                    owner->flush(mag, mag.count);
+                    owner->unregister(mag);
+                }
+            }
+        }
+    };
+
+    /** Returns the calling thread's magazine for this allocator, or nullptr
+        if the thread has no room for another one.
+     */
+    Magazine*
+    magazine() noexcept
     {
-        // FIXME: We can't destroy the memory blocks we've allocated, because
-        //        we can't be sure that they are not being used. Cleaning the
-        //        shutdown process up could make this possible.
+        static thread_local Magazines mags;
+
+        for (auto& mag : mags.m)
+        {
+            auto const owner = mag.owner.load(std::memory_order_relaxed);
+
+            if (owner == this)
+                return &mag;
+
+            if (owner == nullptr)
+            {
+                std::lock_guard l(registryMutex());
+                mag.count = 0;
+                mag.owner = this;
+                mag.next = magazines_;
+                magazines_ = &mag;
+                return &mag;
+            }
+        }
+
+        return nullptr;
     }
 
-    /** Returns the size of the memory block this allocator returns. */
-    constexpr std::size_t
-    size() const noexcept
+    /** Forget a magazine. Called with the registry mutex held. */
+    void
+    unregister(Magazine& mag) noexcept
     {
-        return itemSize_;
+        for (auto p = &magazines_; *p != nullptr; p = &(*p)->next)
+        {
+            if (*p == &mag)
+            {
+                *p = mag.next;
+                break;
+            }
+        }
+
+        mag.next = nullptr;
+        mag.owner = nullptr;
     }
 
-    /** Returns a suitably aligned pointer, if one is available.
+    /** Fill half of an empty magazine from the slabs. */
+    void
+    refill(Magazine& mag) noexcept
+    {
+        assert(mag.count == 0);
 
-        @return a pointer to a block of memory from the allocator, or
-                nullptr if the allocator can't satisfy this request.
-     */
+        for (auto slab = slabs_.load(); slab != nullptr; slab = slab->next_)
+        {
+            mag.count += slab->allocate(
+                mag.items + mag.count, Magazine::size / 2 - mag.count);
+
+            if (mag.count == Magazine::size / 2)
+                break;
+        }
+    }
+
+    /** Return the oldest `count` items of a magazine to their slabs. */
+    void
+    flush(Magazine& mag, std::size_t count) noexcept
+    {
+        assert(count <= mag.count);
+
+        // Items are returned in runs that belong to the same slab, so that
+        // each run only takes that slab's lock once.
+        std::size_t i = 0;
+
+        while (i != count)
+        {
+            auto slab = slabs_.load();
+
+            while (!slab->own(mag.items[i]))
+                slab = slab->next_;
+
+            std::size_t j = i + 1;
+
+            while (j != count && slab->own(mag.items[j]))
+                ++j;
+
+            slab->deallocate(mag.items + i, j - i);
+            i = j;
+        }
+
+        std::copy(mag.items + count, mag.items + mag.count, mag.items);
+        mag.count -= count;
+    }
+
+    /** Allocate an item directly from the slabs, adding one if needed. */
     std::uint8_t*
-    allocate() noexcept
+    allocateFromSlabs() noexcept
     {
         auto slab = slabs_.load();
 
@@ -231,25 +403,15 @@ public:
         // one here:
         std::size_t size = slabSize_;
 
-        // We want to allocate the memory at a 2 MiB boundary, to make it
-        // possible to use hugepage mappings on Linux:
-        auto buf =
-            boost::alignment::aligned_alloc(megabytes(std::size_t(2)), size);
+        // The memory is allocated at a huge page boundary, and backed by
+        // huge pages if they are enabled:
+        auto buf = hugePages::allocate(size);
 
         // clang-format off
         if (!buf) [[unlikely]]
             return nullptr;
             // clang-format on
 
-#if BOOST_OS_LINUX
-        // When allocating large blocks, attempt to leverage Linux's
-        // transparent hugepage support. It is unclear and difficult
-        // to accurately determine if doing this impacts performance
-        // enough to justify using platform-specific tricks.
-        if (size >= megabytes(std::size_t(4)))
-            madvise(buf, size, MADV_HUGEPAGE);
-#endif
-
         // We need to carve out a bit of memory for the slab header
         // and then align the rest appropriately:
         auto slabData = reinterpret_cast<void*>(
@@ -261,7 +423,7 @@ public:
         if (!boost::alignment::align(
                 itemAlignment_, itemSize_, slabData, slabSize))
         {
-            boost::alignment::aligned_free(buf);
+            hugePages::deallocate(buf, size);
             return nullptr;
         }
 
@@ -284,6 +446,93 @@ public:
         return slab->allocate();
     }
 
+    // A linked list of slabs
+    std::atomic<SlabBlock*> slabs_ = nullptr;
+
+    // The alignment requirements of the item we're allocating:
+    std::size_t const itemAlignment_;
+
+    // The size of an item, including the extra bytes requested and
+    // any padding needed for alignment purposes:
+    std::size_t const itemSize_;
+
+    // The size of each individual slab:
+    std::size_t const slabSize_;
+
+    // The magazines of the threads that use this allocator; guarded by
+    // registryMutex():
+    Magazine* magazines_ = nullptr;
+
+public:
+    /** Constructs a slab allocator able to allocate objects of a fixed size
+
+        @param count the number of items the slab allocator can allocate; note
+                     that a count of 0 is valid and means that the allocator
+                     is, effectively, disabled. This can be very useful in some
+                     contexts (e.g. when mimimal memory usage is needed) and
+                     allows for graceful failure.
+     */
+    constexpr explicit SlabAllocator(
+        std::size_t extra,
+        std::size_t alloc = 0,
+        std::size_t align = 0)
+        : itemAlignment_(align ? align : alignof(Type))
+        , itemSize_(
+              boost::alignment::align_up(sizeof(Type) + extra, itemAlignment_))
+        , slabSize_(alloc)
+    {
+        assert((itemAlignment_ & (itemAlignment_ - 1)) == 0);
+    }
+
+    SlabAllocator(SlabAllocator const& other) = delete;
+    SlabAllocator&
+    operator=(SlabAllocator const& other) = delete;
+
+    SlabAllocator(SlabAllocator&& other) = delete;
+    SlabAllocator&
+    operator=(SlabAllocator&& other) = delete;
+
+    ~SlabAllocator()
+    {
+        // FIXME: We can't destroy the memory blocks we've allocated, because
+        //        we can't be sure that they are not being used. Cleaning the
+        //        shutdown process up could make this possible.
+
+        // Threads may outlive us; their magazines must not refer to us once
+        // we are gone. The items they hold stay with the leaked blocks.
+        std::lock_guard l(registryMutex());
+
+        while (magazines_ != nullptr)
+            unregister(*magazines_);
+    }
+
+    /** Returns the size of the memory block this allocator returns. */
+    constexpr std::size_t
+    size() const noexcept
+    {
+        return itemSize_;
+    }
+
+    /** Returns a suitably aligned pointer, if one is available.
+
+        @return a pointer to a block of memory from the allocator, or
+                nullptr if the allocator can't satisfy this request.
+     */
+    std::uint8_t*
+    allocate() noexcept
+    {
+        if (auto mag = magazine())
+        {
+            if (mag->count == 0)
+                refill(*mag);
+
+            if (mag->count != 0)
+                return mag->items[--mag->count];
+        }
+
+        return allocateFromSlabs();
+    }
+
     /** Returns the memory block to the allocator.
 
         @param ptr A pointer to a memory block.
@@ -300,13 +549,41 @@ public:
         {
             if (slab->own(ptr))
             {
-                slab->deallocate(ptr);
+                if (auto mag = magazine())
+                {
+                    if (mag->count == Magazine::size)
+                        flush(*mag, Magazine::size / 2);
+
+                    mag->items[mag->count++] = ptr;
+                }
+                else
+                {
+                    slab->deallocate(ptr);
+                }
+
                 return true;
             }
         }
 
         return false;
     }
+
+    /** Returns how much memory the allocator holds and how it is used. */
+    Stats
+    stats() const noexcept
+    {
+        Stats ret;
+
+        for (auto slab = slabs_.load(); slab != nullptr; slab = slab->next_)
+        {
+            ++ret.slabs;
+            ret.bytes += slabSize_;
+            ret.items += slab->capacity_;
+            ret.inUse += slab->capacity_ - slab->available();
+        }
+
+        return ret;
+    }
 };
 
 /** A collection of slab allocators of various sizes for a given type. */
@@ -425,6 +702,18 @@ public:
 
         return false;
     }
+
+    /** Returns the combined usage counters of the allocators in this set. */
+    typename SlabAllocator<Type>::Stats
+    stats() const noexcept
+    {
+        typename SlabAllocator<Type>::Stats ret;
+
+        for (auto const& a : allocators_)
+            ret += a.stats();
+
+        return ret;
+    }
 };
 
 }  // namespace ripple
@@ -0,0 +1,279 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_SUBSCRIPTIONINDEX_H_INCLUDED
+#define RIPPLE_BASICS_SUBSCRIPTIONINDEX_H_INCLUDED
+
+#include <ripple/basics/hardened_hash.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ripple {
+
+/** The subscribers to each of a set of keys, such as accounts.
+
+    This is built for publishing, which looks up many keys for every
+    message and finds that most of them have no subscribers, while a few
+    keys have thousands:
+
+    - A counting Bloom filter over the keys that have subscribers answers
+      most lookups without taking any lock.
+    - The keys are split across shards by hash, each with its own lock,
+      which a lookup only holds long enough to copy a pointer.
+    - The subscribers to a key are an immutable vector, which publishing
+      walks with no lock held. Subscribing and unsubscribing build a new
+      vector and swap it in, so they never block on a publisher.
+
+    Subscribers are held by weak pointer, and the ones that have gone
+    away are removed the next time their key is published.
+*/
+template <class Key, class Subscriber, class Hash = hardened_hash<>>
+class SubscriptionIndex
+{
+public:
+    struct Entry
+    {
+        std::uint64_t seq;
+        std::weak_ptr<Subscriber> subscriber;
+    };
+
+    using Subscribers = std::vector<Entry>;
+
+private:
+    static constexpr std::size_t shardCount = 16;
+
+    // Three counters of the filter are derived from each hash
+    static constexpr int filterBits = 16;
+    static constexpr std::size_t filterSize = std::size_t(1) << filterBits;
+    static constexpr std::uint64_t filterMask = filterSize - 1;
+
+    using List = std::shared_ptr<Subscribers const>;
+
+    struct Shard
+    {
+        // Serializes changes, so that copying a list does not hold `mutex`
+        std::mutex writeMutex;
+        std::mutex mutex;
+        std::unordered_map<Key, List, Hash> lists;
+    };
+
+    Hash hash_;
+    std::array<Shard, shardCount> shards_;
+    std::vector<std::atomic<std::uint32_t>> filter_;
+    std::atomic<std::size_t> keys_{0};
+
+public:
+    SubscriptionIndex() : filter_(filterSize)
+    {
+    }
+
+    SubscriptionIndex(SubscriptionIndex const&) = delete;
+    SubscriptionIndex&
+    operator=(SubscriptionIndex const&) = delete;
+
+    /** Return `true` if no key has subscribers. */
+    bool
+    empty() const
+    {
+        return keys_.load(std::memory_order_relaxed) == 0;
+    }
+
+    /** Return the number of keys with subscribers. */
+    std::size_t
+    size() const
+    {
+        return keys_.load(std::memory_order_relaxed);
+    }
+
+    /** Subscribe to a key, replacing any subscriber with the same seq. */
+    void
+    insert(
+        Key const& key,
+        std::uint64_t seq,
+        std::shared_ptr<Subscriber> const& subscriber)
+    {
+        std::uint64_t const h = hash_(key);
+        auto& shard = shardFor(h);
+        std::lock_guard writeLock(shard.writeMutex);
+
+        auto const current = find(shard, key);
+        auto next = current ? std::make_shared<Subscribers>(*current)
+                            : std::make_shared<Subscribers>();
+        auto it = std::find_if(next->begin(), next->end(), [seq](auto& e) {
+            return e.seq == seq;
+        });
+        if (it != next->end())
+            it->subscriber = subscriber;
+        else
+            next->push_back({seq, subscriber});
+
+        // Count the key in the filter before it can be found
+        if (!current)
+        {
+            adjustFilter(h, true);
+            keys_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        std::lock_guard lock(shard.mutex);
+        shard.lists[key] = std::move(next);
+    }
+
+    /** Unsubscribe from a key. */
+    void
+    erase(Key const& key, std::uint64_t seq)
+    {
+        std::uint64_t const h = hash_(key);
+        auto& shard = shardFor(h);
+        std::lock_guard writeLock(shard.writeMutex);
+        replace(shard, h, key, [seq](Entry const& e) { return e.seq == seq; });
+    }
+
+    /** Call a function with each subscriber to a key.
+
+        @return The number of subscribers.
+    */
+    template <class Function>
+    std::size_t
+    forEach(Key const& key, Function&& f)
+    {
+        std::uint64_t const h = hash_(key);
+        if (!mayContain(h))
+            return 0;
+
+        auto& shard = shardFor(h);
+        List list;
+        {
+            std::lock_guard lock(shard.mutex);
+            if (auto it = shard.lists.find(key); it != shard.lists.end())
+                list = it->second;
+        }
+        if (!list)
+            return 0;
+
+        std::size_t count = 0;
+        bool expired = false;
+        for (auto const& e : *list)
+        {
+            if (auto sp = e.subscriber.lock())
+            {
+                f(sp);
+                ++count;
+            }
+            else
+                expired = true;
+        }
+
+        if (expired)
+        {
+            std::lock_guard writeLock(shard.writeMutex);
+            replace(shard, h, key, [](Entry const& e) {
+                return e.subscriber.expired();
+            });
+        }
+
+        return count;
+    }
+
+private:
+    Shard&
+    shardFor(std::uint64_t h)
+    {
+        return shards_[h % shardCount];
+    }
+
+    static List
+    find(Shard& shard, Key const& key)
+    {
+        std::lock_guard lock(shard.mutex);
+        if (auto it = shard.lists.find(key); it != shard.lists.end())
+            return it->second;
+        return {};
+    }
+
+    bool
+    mayContain(std::uint64_t h) const
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            if (filter_[(h >> (i * filterBits)) & filterMask].load(
+                    std::memory_order_relaxed) == 0)
+                return false;
+        }
+        return true;
+    }
+
+    void
+    adjustFilter(std::uint64_t h, bool add)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            auto& counter = filter_[(h >> (i * filterBits)) & filterMask];
+            if (add)
+                counter.fetch_add(1, std::memory_order_relaxed);
+            else
+                counter.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Remove the subscribers matching a predicate. Called with the
+    // shard's writeMutex held.
+    template <class Predicate>
+    void
+    replace(Shard& shard, std::uint64_t h, Key const& key, Predicate&& pred)
+    {
+        auto const current = find(shard, key);
+        if (!current)
+            return;
+
+        auto next = std::make_shared<Subscribers>();
+        next->reserve(current->size());
+        for (auto const& e : *current)
+        {
+            if (!pred(e))
+                next->push_back(e);
+        }
+
+        if (next->size() == current->size())
+            return;
+
+        if (!next->empty())
+        {
+            std::lock_guard lock(shard.mutex);
+            shard.lists[key] = std::move(next);
+            return;
+        }
+
+        {
+            std::lock_guard lock(shard.mutex);
+            shard.lists.erase(key);
+        }
+        adjustFilter(h, false);
+        keys_.fetch_sub(1, std::memory_order_relaxed);
+    }
+};
+
+}  // namespace ripple
+
+#endif
@@ -25,11 +25,15 @@
 #include <ripple/basics/hardened_hash.h>
 #include <ripple/beast/clock/abstract_clock.h>
 #include <ripple/beast/insight/Insight.h>
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <mutex>
 #include <thread>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace ripple {
@@ -101,6 +105,13 @@ public:
         return m_cache.size();
     }
 
+    int
+    getTargetSize() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_target_size;
+    }
+
     void
     setTargetSize(int s)
     {
@@ -151,6 +162,15 @@ public:
         return m_cache.size();
     }
 
+    /** Returns the number of lookups which found and did not find an item.
+     */
+    std::pair<std::uint64_t, std::uint64_t>
+    getHitsAndMisses() const
+    {
+        std::lock_guard lock(m_mutex);
+        return {m_hits, m_misses};
+    }
+
     float
     getHitRate()
     {
@@ -200,69 +220,93 @@ public:
         std::vector<std::shared_ptr<mapped_type>>,
         std::vector<std::weak_ptr<mapped_type>>>;
 
+    /** Remove expired items from the whole cache.
+
+        The partitions are swept one at a time, so that lookups wait for
+        the sweep of at most one partition rather than the whole cache.
+    */
     void
     sweep()
     {
-        // Keep references to all the stuff we sweep
-        // For performance, each worker thread should exit before the swept data
-        // is destroyed but still within the main cache lock.
-        std::vector<SweptPointersVector> allStuffToSweep(m_cache.partitions());
+        auto const start = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::duration longest{};
+
+        for (std::size_t p = 0; p < m_cache.partitions(); ++p)
+        {
+            auto const partitionStart = std::chrono::steady_clock::now();
+            sweepPartitions(1);
+            longest = std::max(
+                longest, std::chrono::steady_clock::now() - partitionStart);
+        }
+
+        using namespace std::chrono;
+        JLOG(m_journal.debug())
+            << m_name << " TaggedCache sweep took "
+            << duration_cast<milliseconds>(steady_clock::now() - start).count()
+            << "ms, holding the lock for at most "
+            << duration_cast<milliseconds>(longest).count() << "ms";
+    }
+
+    /** Remove expired items from the next partitions of the cache.
+
+        Each call continues from the partition after the last one swept
+        by the previous call. The lock is only held while the partitions
+        are walked; the swept items are released after it is.
+
+        @param count The number of partitions to sweep.
+        @return `true` if the last partition was swept, so that the next
+                call starts another pass over the cache.
+    */
+    bool
+    sweepPartitions(std::size_t count)
+    {
+        // Keep references to all the stuff we sweep, so that it is
+        // destroyed outside the lock.
+        SweptPointersVector stuffToSweep;
+        bool wrapped = false;
+
+        std::lock_guard lock(m_mutex);
 
         clock_type::time_point const now(m_clock.now());
         clock_type::time_point when_expire;
 
-        auto const start = std::chrono::steady_clock::now();
+        if (m_target_size == 0 ||
+            (static_cast<int>(m_cache.size()) <= m_target_size))
         {
-            std::lock_guard lock(m_mutex);
+            when_expire = now - m_target_age;
+        }
+        else
+        {
+            when_expire = now - m_target_age * m_target_size / m_cache.size();
 
-            if (m_target_size == 0 ||
-                (static_cast<int>(m_cache.size()) <= m_target_size))
-            {
-                when_expire = now - m_target_age;
-            }
-            else
-            {
-                when_expire =
-                    now - m_target_age * m_target_size / m_cache.size();
-
-                clock_type::duration const minimumAge(std::chrono::seconds(1));
-                if (when_expire > (now - minimumAge))
-                    when_expire = now - minimumAge;
-
-                JLOG(m_journal.trace())
-                    << m_name << " is growing fast " << m_cache.size() << " of "
-                    << m_target_size << " aging at "
-                    << (now - when_expire).count() << " of "
-                    << m_target_age.count();
-            }
+            clock_type::duration const minimumAge(std::chrono::seconds(1));
+            if (when_expire > (now - minimumAge))
+                when_expire = now - minimumAge;
 
-            std::vector<std::thread> workers;
-            workers.reserve(m_cache.partitions());
-            std::atomic<int> allRemovals = 0;
+            JLOG(m_journal.trace())
+                << m_name << " is growing fast " << m_cache.size() << " of "
+                << m_target_size << " aging at " << (now - when_expire).count()
+                << " of " << m_target_age.count();
+        }
 
-            for (std::size_t p = 0; p < m_cache.partitions(); ++p)
+        auto const partitions = m_cache.partitions();
+        for (std::size_t i = 0; i < std::min(count, partitions); ++i)
+        {
+            m_cache_count -= sweepHelper(
+                when_expire,
+                now,
+                m_cache.map()[m_sweep_cursor],
+                stuffToSweep,
+                lock);
+
+            if (++m_sweep_cursor == partitions)
             {
-                workers.push_back(sweepHelper(
-                    when_expire,
-                    now,
-                    m_cache.map()[p],
-                    allStuffToSweep[p],
-                    allRemovals,
-                    lock));
+                m_sweep_cursor = 0;
+                wrapped = true;
             }
-            for (std::thread& worker : workers)
-                worker.join();
-
-            m_cache_count -= allRemovals;
         }
-        // At this point allStuffToSweep will go out of scope outside the lock
-        // and decrement the reference count on each strong pointer.
-        JLOG(m_journal.debug())
-            << m_name << " TaggedCache sweep lock duration "
-            << std::chrono::duration_cast<std::chrono::milliseconds>(
-                   std::chrono::steady_clock::now() - start)
-                   .count()
-            << "ms";
+
+        return wrapped;
     }
 
     bool
@@ -650,126 +694,108 @@ private:
     using cache_type =
         hardened_partitioned_hash_map<key_type, Entry, Hash, KeyEqual>;
 
-    [[nodiscard]] std::thread
+    int
     sweepHelper(
         clock_type::time_point const& when_expire,
         [[maybe_unused]] clock_type::time_point const& now,
         typename KeyValueCacheType::map_type& partition,
         SweptPointersVector& stuffToSweep,
-        std::atomic<int>& allRemovals,
-        std::lock_guard<std::recursive_mutex> const&)
+        std::lock_guard<mutex_type> const&)
     {
-        return std::thread([&, this]() {
-            int cacheRemovals = 0;
-            int mapRemovals = 0;
+        int cacheRemovals = 0;
+        int mapRemovals = 0;
 
-            // Keep references to all the stuff we sweep
-            // so that we can destroy them outside the lock.
-            stuffToSweep.first.reserve(partition.size());
-            stuffToSweep.second.reserve(partition.size());
+        auto cit = partition.begin();
+        while (cit != partition.end())
+        {
+            if (cit->second.isWeak())
+            {
+                // weak
+                if (cit->second.isExpired())
+                {
+                    stuffToSweep.second.push_back(
+                        std::move(cit->second.weak_ptr));
+                    ++mapRemovals;
+                    cit = partition.erase(cit);
+                }
+                else
+                {
+                    ++cit;
+                }
+            }
+            else if (cit->second.last_access <= when_expire)
             {
-                auto cit = partition.begin();
-                while (cit != partition.end())
+                // strong, expired
+                ++cacheRemovals;
+                if (cit->second.ptr.use_count() == 1)
                 {
-                    if (cit->second.isWeak())
-                    {
-                        // weak
-                        if (cit->second.isExpired())
-                        {
-                            stuffToSweep.second.push_back(
-                                std::move(cit->second.weak_ptr));
-                            ++mapRemovals;
-                            cit = partition.erase(cit);
-                        }
-                        else
-                        {
-                            ++cit;
-                        }
-                    }
-                    else if (cit->second.last_access <= when_expire)
-                    {
-                        // strong, expired
-                        ++cacheRemovals;
-                        if (cit->second.ptr.use_count() == 1)
-                        {
-                            stuffToSweep.first.push_back(
-                                std::move(cit->second.ptr));
-                            ++mapRemovals;
-                            cit = partition.erase(cit);
-                        }
-                        else
-                        {
-                            // remains weakly cached
-                            cit->second.ptr.reset();
-                            ++cit;
-                        }
-                    }
-                    else
-                    {
-                        // strong, not expired
-                        ++cit;
-                    }
+                    stuffToSweep.first.push_back(std::move(cit->second.ptr));
+                    ++mapRemovals;
+                    cit = partition.erase(cit);
+                }
+                else
+                {
+                    // remains weakly cached
+                    cit->second.ptr.reset();
+                    ++cit;
                 }
             }
-
-            if (mapRemovals || cacheRemovals)
+            else
             {
-                JLOG(m_journal.debug())
-                    << "TaggedCache partition sweep " << m_name
-                    << ": cache = " << partition.size() << "-" << cacheRemovals
-                    << ", map-=" << mapRemovals;
+                // strong, not expired
+                ++cit;
             }
+        }
 
-            allRemovals += cacheRemovals;
-        });
+        if (mapRemovals || cacheRemovals)
+        {
+            JLOG(m_journal.debug())
+                << "TaggedCache partition sweep " << m_name
+                << ": cache = " << partition.size() << "-" << cacheRemovals
+                << ", map-=" << mapRemovals;
+        }
+
+        return cacheRemovals;
     }
 
-    [[nodiscard]] std::thread
+    int
     sweepHelper(
         clock_type::time_point const& when_expire,
         clock_type::time_point const& now,
         typename KeyOnlyCacheType::map_type& partition,
         SweptPointersVector&,
-        std::atomic<int>& allRemovals,
-        std::lock_guard<std::recursive_mutex> const&)
+        std::lock_guard<mutex_type> const&)
     {
-        return std::thread([&, this]() {
-            int cacheRemovals = 0;
-            int mapRemovals = 0;
+        int mapRemovals = 0;
 
-            // Keep references to all the stuff we sweep
-            // so that we can destroy them outside the lock.
+        auto cit = partition.begin();
+        while (cit != partition.end())
+        {
+            if (cit->second.last_access > now)
             {
-                auto cit = partition.begin();
-                while (cit != partition.end())
-                {
-                    if (cit->second.last_access > now)
-                    {
-                        cit->second.last_access = now;
-                        ++cit;
-                    }
-                    else if (cit->second.last_access <= when_expire)
-                    {
-                        cit = partition.erase(cit);
-                    }
-                    else
-                    {
-                        ++cit;
-                    }
-                }
+                cit->second.last_access = now;
+                ++cit;
             }
-
-            if (mapRemovals || cacheRemovals)
+            else if (cit->second.last_access <= when_expire)
             {
-                JLOG(m_journal.debug())
-                    << "TaggedCache partition sweep " << m_name
-                    << ": cache = " << partition.size() << "-" << cacheRemovals
-                    << ", map-=" << mapRemovals;
+                ++mapRemovals;
+                cit = partition.erase(cit);
             }
+            else
+            {
+                ++cit;
+            }
+        }
 
-            allRemovals += cacheRemovals;
-        });
-    };
+        if (mapRemovals)
+        {
+            JLOG(m_journal.debug())
+                << "TaggedCache partition sweep " << m_name
+                << ": map-=" << mapRemovals;
+        }
+
+        return 0;
+    }
 
     beast::Journal m_journal;
     clock_type& m_clock;
@@ -789,6 +815,7 @@ private:
     // Number of items cached
     int m_cache_count;
     cache_type m_cache;  // Hold strong reference to recent objects
+    std::size_t m_sweep_cursor = 0;  // The next partition to sweep
     std::uint64_t m_hits;
     std::uint64_t m_misses;
 };
@@ -0,0 +1,165 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_TRACE_H_INCLUDED
+#define RIPPLE_BASICS_TRACE_H_INCLUDED
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/json/json_value.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Tracing can be compiled out entirely by defining RIPPLE_TRACING to 0,
+// in which case spans are empty objects and cost nothing.
+#ifndef RIPPLE_TRACING
+#define RIPPLE_TRACING 1
+#endif
+
+namespace ripple {
+namespace trace {
+
+/** Lightweight timing spans for the transaction and ledger paths.
+
+    A Span records the time between its construction and destruction.
+    Completed spans are written to a fixed-size ring buffer owned by the
+    thread that ran them, so recording never takes a lock or allocates
+    after the thread's first span. When a ring is full the oldest spans
+    are overwritten.
+
+    Recording is off until enabled at run time. While it is off, a span
+    costs one relaxed atomic load.
+
+    The recorded spans can be exported in the Chrome trace event format,
+    which chrome://tracing, Perfetto and other trace viewers can load.
+*/
+
+/** The number of spans each thread keeps. */
+constexpr std::size_t ringSize = 4096;
+
+namespace detail {
+
+#if RIPPLE_TRACING
+extern std::atomic<bool> enabled;
+
+/** Nanoseconds since the trace clock epoch. */
+std::uint64_t
+now() noexcept;
+
+void
+record(
+    char const* name,
+    std::uint64_t id,
+    std::uint64_t start,
+    std::uint64_t end) noexcept;
+#endif
+
+}  // namespace detail
+
+/** Returns `true` if spans are being recorded. */
+inline bool
+enabled() noexcept
+{
+#if RIPPLE_TRACING
+    return detail::enabled.load(std::memory_order_relaxed);
+#else
+    return false;
+#endif
+}
+
+/** Start or stop recording spans.
+
+    Has no effect if tracing is compiled out.
+*/
+void
+enable(bool on);
+
+/** Discard every span recorded so far. */
+void
+clear();
+
+/** Returns the recorded spans as a Chrome trace event object.
+
+    Each span is a complete ("X") event with its start and duration in
+    microseconds. Spans that carry an identifier report it, in hex, as
+    the "id" argument so a transaction or ledger can be followed across
+    threads. For identifiers made by idOf, that is the first sixteen
+    digits of the hash.
+*/
+Json::Value
+getChromeTrace();
+
+/** Returns the leading 64 bits of a hash, for correlating spans. */
+template <std::size_t Bits, class Tag>
+std::uint64_t
+idOf(base_uint<Bits, Tag> const& hash) noexcept
+{
+    static_assert(Bits >= 64);
+    std::uint64_t id = 0;
+    for (auto b = hash.data(), e = b + sizeof(id); b != e; ++b)
+        id = (id << 8) | *b;
+    return id;
+}
+
+/** Times a scope.
+
+    The name must be a string literal, or otherwise outlive every
+    export of the trace, since only the pointer is stored.
+*/
+class Span
+{
+#if RIPPLE_TRACING
+    char const* name_ = nullptr;
+    std::uint64_t id_;
+    std::uint64_t start_;
+#endif
+
+public:
+    explicit Span(char const* name, std::uint64_t id = 0) noexcept
+    {
+#if RIPPLE_TRACING
+        if (enabled())
+        {
+            name_ = name;
+            id_ = id;
+            start_ = detail::now();
+        }
+#else
+        (void)name;
+        (void)id;
+#endif
+    }
+
+    ~Span()
+    {
+#if RIPPLE_TRACING
+        if (name_)
+            detail::record(name_, id_, start_, detail::now());
+#endif
+    }
+
+    Span(Span const&) = delete;
+    Span&
+    operator=(Span const&) = delete;
+};
+
+}  // namespace trace
+}  // namespace ripple
+
+#endif
@@ -28,6 +28,7 @@
 
 #include <chrono>
 #include <cstdint>
+#include <ctime>
 #include <ratio>
 #include <string>
 #include <type_traits>
@@ -124,6 +125,32 @@ stopwatch()
     return beast::get_abstract_clock<Facade, Clock>();
 }
 
+/** A clock measuring the CPU time used by the calling thread.
+
+    On platforms which can't measure it, time does not advance.
+*/
+struct ThreadCpuClock
+{
+    using duration = std::chrono::nanoseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<ThreadCpuClock>;
+    static constexpr bool is_steady = true;
+
+    static time_point
+    now() noexcept
+    {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+        timespec ts;
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+            return time_point{
+                std::chrono::seconds{ts.tv_sec} +
+                std::chrono::nanoseconds{ts.tv_nsec}};
+#endif
+        return time_point{};
+    }
+};
+
 }  // namespace ripple
 
 #endif
@@ -23,7 +23,9 @@
 #include <ripple/beast/hash/hash_append.h>
 #include <ripple/beast/hash/xxhasher.h>
 
+#include <array>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <mutex>
 #include <random>
@@ -60,6 +62,27 @@ make_seed_pair() noexcept
     return {state.dist(state.gen), state.dist(state.gen)};
 }
 
+// Multiplies two words and folds the high half of the product into the
+// low half, so that every bit of either word affects the result.
+inline std::uint64_t
+fold_multiply(std::uint64_t a, std::uint64_t b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    auto const p = static_cast<unsigned __int128>(a) * b;
+    return static_cast<std::uint64_t>(p) ^ static_cast<std::uint64_t>(p >> 64);
+#else
+    std::uint64_t const aLo = a & 0xffffffff, aHi = a >> 32;
+    std::uint64_t const bLo = b & 0xffffffff, bHi = b >> 32;
+    std::uint64_t const ll = aLo * bLo, lh = aLo * bHi;
+    std::uint64_t const hl = aHi * bLo, hh = aHi * bHi;
+    std::uint64_t const mid =
+        (ll >> 32) + (lh & 0xffffffff) + (hl & 0xffffffff);
+    std::uint64_t const lo = (mid << 32) | (ll & 0xffffffff);
+    std::uint64_t const hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    return lo ^ hi;
+#endif
+}
+
 }  // namespace detail
 
 /**
@@ -115,6 +138,47 @@ public:
     }
 };
 
+/** Seeded hash for keys which are already uniformly distributed
+
+    Keys such as ledger, node and transaction hashes are digests, whose
+    bits are already uniform, so running xxhash over all of their bytes
+    buys nothing. This folds the four words of a 256-bit key with four
+    random seeds drawn once per construction instead. The seeds are
+    secret, so an attacker who can choose keys still cannot predict
+    which of them share a bucket.
+
+    Only use this for keys which are digests. Keys with structure, like
+    small integers stored in a base_uint, are hashed poorly.
+*/
+class digest_hash
+{
+private:
+    std::array<std::uint64_t, 4> m_seeds;
+
+public:
+    using result_type = std::size_t;
+
+    digest_hash()
+    {
+        auto const [s0, s1] = detail::make_seed_pair<>();
+        auto const [s2, s3] = detail::make_seed_pair<>();
+        m_seeds = {s0, s1, s2, s3};
+    }
+
+    template <class Key>
+    result_type
+    operator()(Key const& key) const noexcept
+    {
+        static_assert(Key::bytes == 32, "digest_hash needs 256-bit keys");
+
+        std::uint64_t w[4];
+        std::memcpy(w, key.data(), sizeof(w));
+        return static_cast<result_type>(
+            detail::fold_multiply(w[0] ^ m_seeds[0], w[1] ^ m_seeds[1]) ^
+            detail::fold_multiply(w[2] ^ m_seeds[2], w[3] ^ m_seeds[3]));
+    }
+};
+
 }  // namespace ripple
 
 #endif
@@ -0,0 +1,182 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/CacheBudget.h>
+#include <ripple/basics/Log.h>
+#include <ripple/protocol/jss.h>
+
+namespace ripple {
+
+namespace {
+
+// Targets stay within these multiples of the configured target size.
+constexpr int minFraction = 8;
+constexpr int maxMultiple = 4;
+
+}  // namespace
+
+CacheBudget::CacheBudget(std::size_t budget, beast::Journal journal)
+    : budget_(budget), j_(journal)
+{
+}
+
+void
+CacheBudget::rebalance()
+{
+    std::lock_guard lock(mutex_);
+
+    std::size_t total = 0;
+    for (auto& source : sources_)
+    {
+        source.entries = source.size();
+
+        // A cache which was reset counts again from zero.
+        auto const [hits, misses] = source.hitsAndMisses();
+        source.recentHits = hits >= source.hits ? hits - source.hits : hits;
+        source.recentMisses =
+            misses >= source.misses ? misses - source.misses : misses;
+        source.hits = hits;
+        source.misses = misses;
+
+        total += source.bytes();
+    }
+
+    if (budget_ == 0)
+        return;
+
+    JLOG(j_.debug()) << "Caches hold about " << total << " of " << budget_
+                     << " bytes";
+
+    if (total > budget_)
+        shrink(total - budget_);
+    else if (auto const full = budget_ - budget_ / minFraction; total < full)
+        grow(full - total);
+}
+
+void
+CacheBudget::shrink(std::size_t excess)
+{
+    // Take memory from the caches giving the fewest hits for it first.
+    std::vector<Source*> order;
+    for (auto& source : sources_)
+    {
+        if (source.entries != 0)
+            order.push_back(&source);
+    }
+    std::sort(order.begin(), order.end(), [](Source* a, Source* b) {
+        return static_cast<double>(a->recentHits) / a->bytes() <
+            static_cast<double>(b->recentHits) / b->bytes();
+    });
+
+    for (auto source : order)
+    {
+        if (excess == 0)
+            break;
+
+        // A cache without a target is sized from what it holds.
+        if (source->baseTarget <= 0)
+            source->baseTarget = static_cast<int>(source->entries);
+
+        auto const floor = static_cast<std::size_t>(
+            std::max(source->baseTarget / minFraction, 1));
+        if (source->entries <= floor)
+            continue;
+
+        auto const cut = std::min(
+            source->entries - floor,
+            (excess + source->entryBytes - 1) / source->entryBytes);
+        auto const target = static_cast<int>(source->entries - cut);
+        auto const current = source->getTarget();
+        if (current <= 0 || target < current)
+        {
+            source->setTarget(target);
+            JLOG(j_.info()) << source->name << " target size lowered to "
+                            << target << " to fit the cache budget";
+        }
+        excess -= std::min(excess, cut * source->entryBytes);
+    }
+}
+
+void
+CacheBudget::grow(std::size_t room)
+{
+    // Give memory to the full cache with the most misses for it.
+    Source* best = nullptr;
+    double bestMisses = 0;
+    for (auto& source : sources_)
+    {
+        auto const target = source.getTarget();
+        if (target <= 0 || source.entries < static_cast<std::size_t>(target) ||
+            target >= source.baseTarget * maxMultiple)
+            continue;
+
+        auto const misses =
+            static_cast<double>(source.recentMisses) / source.entryBytes;
+        if (misses > bestMisses)
+        {
+            best = &source;
+            bestMisses = misses;
+        }
+    }
+
+    if (!best)
+        return;
+
+    auto const target = best->getTarget();
+    auto const step = std::min<std::size_t>(
+        {static_cast<std::size_t>(std::max(target / minFraction, 1)),
+         static_cast<std::size_t>(best->baseTarget * maxMultiple - target),
+         room / best->entryBytes});
+    if (step == 0)
+        return;
+
+    best->setTarget(target + static_cast<int>(step));
+    JLOG(j_.info()) << best->name << " target size raised to "
+                    << target + step << " within the cache budget";
+}
+
+Json::Value
+CacheBudget::getJson() const
+{
+    std::lock_guard lock(mutex_);
+
+    Json::Value ret(Json::objectValue);
+    ret[jss::budget] = std::to_string(budget_);
+
+    std::size_t total = 0;
+    Json::Value& caches = (ret[jss::caches] = Json::objectValue);
+    for (auto const& source : sources_)
+    {
+        auto const entries = source.size();
+        auto const [hits, misses] = source.hitsAndMisses();
+        auto const lookups = static_cast<double>(hits + misses);
+
+        Json::Value& jv = (caches[source.name] = Json::objectValue);
+        jv[jss::entries] = std::to_string(entries);
+        jv[jss::bytes] = std::to_string(entries * source.entryBytes);
+        jv[jss::target_size] = source.getTarget();
+        jv[jss::hit_rate] = lookups == 0 ? 0.0 : hits * 100.0 / lookups;
+        total += entries * source.entryBytes;
+    }
+    ret[jss::bytes] = std::to_string(total);
+
+    return ret;
+}
+
+}  // namespace ripple
@@ -55,4 +55,21 @@ CountedObjects::getCounts(int minimumThreshold) const
     return counts;
 }
 
+CountedObjects::ByteList
+CountedObjects::getBytes(int minimumThreshold) const
+{
+    ByteList bytes;
+
+    for (auto* ctr = m_head.load(); ctr != nullptr; ctr = ctr->getNext())
+    {
+        if (auto const b = ctr->getBytes();
+            b != 0 && ctr->getCount() >= minimumThreshold)
+            bytes.emplace_back(ctr->getName(), b);
+    }
+
+    std::sort(bytes.begin(), bytes.end());
+
+    return bytes;
+}
+
 }  // namespace ripple
@@ -41,7 +41,7 @@ getFileContents(
         return {};
     }
 
-    ifstream fileStream(fullPath, std::ios::in);
+    ifstream fileStream(fullPath, std::ios::in | std::ios::binary);
 
     if (!fileStream)
     {
@@ -71,7 +71,8 @@ writeFileContents(
     using namespace boost::filesystem;
     using namespace boost::system::errc;
 
-    ofstream fileStream(destPath, std::ios::out | std::ios::trunc);
+    ofstream fileStream(
+        destPath, std::ios::out | std::ios::trunc | std::ios::binary);
 
     if (!fileStream)
     {
@@ -80,6 +81,7 @@ writeFileContents(
     }
 
     fileStream << contents;
+    fileStream.flush();
 
     if (fileStream.bad())
     {
@@ -88,4 +90,20 @@ writeFileContents(
     }
 }
 
+void
+writeFileContentsAtomic(
+    boost::system::error_code& ec,
+    boost::filesystem::path const& destPath,
+    std::string const& contents)
+{
+    auto temp = destPath;
+    temp += ".tmp";
+
+    writeFileContents(ec, temp, contents);
+    if (ec)
+        return;
+
+    boost::filesystem::rename(temp, destPath, ec);
+}
+
 }  // namespace ripple
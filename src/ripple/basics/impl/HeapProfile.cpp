@@ -0,0 +1,192 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/HeapProfile.h>
+#include <ripple/protocol/jss.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+
+#if defined(PROFILE_JEMALLOC)
+#include <jemalloc/jemalloc.h>
+#elif defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace ripple {
+namespace heapProfile {
+
+#if defined(PROFILE_JEMALLOC)
+
+namespace {
+
+template <class T>
+std::optional<T>
+read(std::string const& name)
+{
+    T value;
+    std::size_t size = sizeof(value);
+    if (mallctl(name.c_str(), &value, &size, nullptr, 0) != 0)
+        return std::nullopt;
+    return value;
+}
+
+void
+setBytes(
+    Json::Value& jv,
+    Json::StaticString key,
+    std::optional<std::size_t> bytes)
+{
+    if (bytes)
+        jv[key] = std::to_string(*bytes);
+}
+
+}  // namespace
+
+char const*
+allocator() noexcept
+{
+    return "jemalloc";
+}
+
+Json::Value
+getJson()
+{
+    Json::Value ret(Json::objectValue);
+    ret[jss::allocator] = allocator();
+
+    // The statistics are a snapshot, taken when the epoch is advanced
+    std::uint64_t epoch = 1;
+    std::size_t size = sizeof(epoch);
+    mallctl("epoch", &epoch, &size, &epoch, size);
+
+    setBytes(ret, jss::allocated, read<std::size_t>("stats.allocated"));
+    setBytes(ret, jss::active, read<std::size_t>("stats.active"));
+    setBytes(ret, jss::metadata, read<std::size_t>("stats.metadata"));
+    setBytes(ret, jss::resident, read<std::size_t>("stats.resident"));
+    setBytes(ret, jss::mapped, read<std::size_t>("stats.mapped"));
+    setBytes(ret, jss::retained, read<std::size_t>("stats.retained"));
+    ret[jss::profiling] = read<bool>("opt.prof").value_or(false);
+
+    auto const page = read<std::size_t>("arenas.page").value_or(4096);
+    auto const pages = [page](std::string const& name) {
+        auto const n = read<std::size_t>(name);
+        return n ? std::optional<std::size_t>(*n * page) : std::nullopt;
+    };
+
+    Json::Value& arenas = (ret[jss::arenas] = Json::arrayValue);
+    auto const narenas = read<unsigned>("arenas.narenas").value_or(0);
+    for (unsigned i = 0; i < narenas; ++i)
+    {
+        auto const prefix = "stats.arenas." + std::to_string(i) + ".";
+        if (!read<bool>("arena." + std::to_string(i) + ".initialized")
+                 .value_or(false))
+            continue;
+
+        Json::Value& jv = arenas.append(Json::objectValue);
+        jv[jss::arena] = i;
+        jv[jss::threads] = read<unsigned>(prefix + "nthreads").value_or(0);
+        setBytes(jv, jss::active, pages(prefix + "pactive"));
+        setBytes(jv, jss::dirty, pages(prefix + "pdirty"));
+        setBytes(jv, jss::muzzy, pages(prefix + "pmuzzy"));
+        setBytes(jv, jss::resident, read<std::size_t>(prefix + "resident"));
+        setBytes(jv, jss::retained, read<std::size_t>(prefix + "retained"));
+    }
+
+    return ret;
+}
+
+bool
+purge()
+{
+    auto const name =
+        "arena." + std::to_string(MALLCTL_ARENAS_ALL) + ".purge";
+    return mallctl(name.c_str(), nullptr, nullptr, nullptr, 0) == 0;
+}
+
+bool
+dump(std::string& error)
+{
+    if (!read<bool>("opt.prof").value_or(false))
+    {
+        error = "Heap profiling was not enabled at startup.";
+        return false;
+    }
+
+    // Written to a file named by jemalloc's prof_prefix option
+    if (auto const ec = mallctl("prof.dump", nullptr, nullptr, nullptr, 0))
+    {
+        error = std::strerror(ec);
+        return false;
+    }
+    return true;
+}
+
+#else
+
+char const*
+allocator() noexcept
+{
+#if defined(__GLIBC__)
+    return "glibc";
+#else
+    return "unknown";
+#endif
+}
+
+Json::Value
+getJson()
+{
+    Json::Value ret(Json::objectValue);
+    ret[jss::allocator] = allocator();
+    ret[jss::profiling] = false;
+
+#if defined(__GLIBC__) && __GLIBC_PREREQ(2, 33)
+    auto const info = mallinfo2();
+    ret[jss::allocated] = std::to_string(info.uordblks + info.hblkhd);
+    ret[jss::mapped] = std::to_string(info.arena + info.hblkhd);
+    ret[jss::free] = std::to_string(info.fordblks);
+#endif
+
+    return ret;
+}
+
+bool
+purge()
+{
+#if defined(__GLIBC__)
+    malloc_trim(0);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool
+dump(std::string& error)
+{
+    error = "Heap profiles need a server built with jemalloc.";
+    return false;
+}
+
+#endif
+
+}  // namespace heapProfile
+}  // namespace ripple
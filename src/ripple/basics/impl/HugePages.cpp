@@ -0,0 +1,164 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/HugePages.h>
+#include <boost/align/aligned_alloc.hpp>
+#include <boost/align/align_up.hpp>
+#include <boost/predef.h>
+#include <atomic>
+#include <mutex>
+#include <unordered_set>
+
+#if BOOST_OS_LINUX
+#include <sys/mman.h>
+#endif
+
+namespace ripple {
+namespace hugePages {
+
+namespace {
+
+std::atomic<Mode> mode_{Mode::transparent};
+
+#if BOOST_OS_LINUX
+// The blocks mapped from the reserved huge pages, which are unmapped
+// rather than freed. Blocks are few and large, so a lock costs little.
+struct Mapped
+{
+    std::mutex mutex;
+    std::unordered_set<void*> blocks;
+};
+
+// Never destroyed, since pools may free their blocks during exit
+Mapped&
+mapped()
+{
+    static auto* const m = new Mapped;
+    return *m;
+}
+
+void*
+mapExplicit(std::size_t bytes) noexcept
+{
+    auto const p = mmap(
+        nullptr,
+        bytes,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+        -1,
+        0);
+    if (p == MAP_FAILED)
+        return nullptr;
+
+    try
+    {
+        auto& m = mapped();
+        std::lock_guard lock(m.mutex);
+        m.blocks.insert(p);
+    }
+    catch (...)
+    {
+        munmap(p, bytes);
+        return nullptr;
+    }
+    return p;
+}
+
+bool
+unmapExplicit(void* p, std::size_t bytes) noexcept
+{
+    {
+        auto& m = mapped();
+        std::lock_guard lock(m.mutex);
+        if (m.blocks.erase(p) == 0)
+            return false;
+    }
+    munmap(p, bytes);
+    return true;
+}
+#endif
+
+}  // namespace
+
+std::optional<Mode>
+parseMode(std::string const& name)
+{
+    if (name == "off")
+        return Mode::off;
+    if (name == "transparent")
+        return Mode::transparent;
+    if (name == "explicit")
+        return Mode::explicit_;
+    return std::nullopt;
+}
+
+void
+setMode(Mode mode) noexcept
+{
+    mode_.store(mode, std::memory_order_relaxed);
+}
+
+Mode
+mode() noexcept
+{
+    return mode_.load(std::memory_order_relaxed);
+}
+
+void*
+allocate(std::size_t bytes) noexcept
+{
+    bytes = boost::alignment::align_up(bytes, size);
+    auto const m = mode();
+
+#if BOOST_OS_LINUX
+    if (m == Mode::explicit_)
+    {
+        if (auto p = mapExplicit(bytes))
+            return p;
+    }
+#endif
+
+    auto p = boost::alignment::aligned_alloc(size, bytes);
+
+#if BOOST_OS_LINUX
+    if (p && m != Mode::off)
+        madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+
+    return p;
+}
+
+void
+deallocate(void* p, std::size_t bytes) noexcept
+{
+    if (!p)
+        return;
+
+#if BOOST_OS_LINUX
+    if (unmapExplicit(p, boost::alignment::align_up(bytes, size)))
+        return;
+#else
+    (void)bytes;
+#endif
+
+    boost::alignment::aligned_free(p);
+}
+
+}  // namespace hugePages
+}  // namespace ripple
@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <ripple/basics/IOUAmount.h>
+#include <ripple/basics/MathUtilities.h>
 #include <ripple/basics/contract.h>
 #include <boost/multiprecision/cpp_int.hpp>
 #include <algorithm>
@@ -89,11 +90,8 @@ IOUAmount::normalize()
     if (negative)
         mantissa_ = -mantissa_;
 
-    while ((mantissa_ < minMantissa) && (exponent_ > minExponent))
-    {
-        mantissa_ *= 10;
-        --exponent_;
-    }
+    scaleToDigits(
+        mantissa_, exponent_, decimalDigits(minMantissa), minExponent);
 
     while (mantissa_ > maxMantissa)
     {
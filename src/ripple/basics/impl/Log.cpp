@@ -20,13 +20,17 @@
 #include <ripple/basics/Log.h>
 #include <ripple/basics/chrono.h>
 #include <ripple/basics/contract.h>
+#include <ripple/beast/core/CurrentThreadName.h>
 #include <boost/algorithm/string.hpp>
+#include <atomic>
 #include <cassert>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <thread>
 
 namespace ripple {
 
@@ -113,6 +117,215 @@ Logs::File::writeln(char const* text)
     }
 }
 
+void
+Logs::File::flush()
+{
+    if (m_stream != nullptr)
+        m_stream->flush();
+}
+
+//------------------------------------------------------------------------------
+
+/*  Messages are queued in a bounded ring and written by one thread.
+
+    The ring is the usual sequenced array: each cell's sequence number
+    says whether it is free for the writer at a given position or holds
+    the message for it. Producers claim positions with a CAS and never
+    block; when the ring is full the message is dropped and counted.
+    The writer formats messages, which includes the timestamp taken when
+    they were queued, and writes them to the file in batches.
+*/
+class Logs::Writer
+{
+    struct Message
+    {
+        std::chrono::system_clock::time_point when;
+        beast::severities::Severity level;
+        std::string partition;
+        std::string text;
+    };
+
+    struct Cell
+    {
+        std::atomic<std::uint64_t> sequence;
+        Message message;
+    };
+
+    static constexpr std::uint64_t capacity = 8192;
+    static constexpr std::size_t maxBatch = 256;
+
+    Logs& logs_;
+    std::unique_ptr<Cell[]> cells_;
+
+    // The next position to queue a message at
+    alignas(64) std::atomic<std::uint64_t> tail_{0};
+
+    // Bumped after queueing a message, to wake the writer
+    alignas(64) std::atomic<std::uint64_t> queued_{0};
+
+    // Messages written so far, which is also the writer's position
+    alignas(64) std::atomic<std::uint64_t> written_{0};
+
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<bool> stop_{false};
+    std::thread thread_;
+
+public:
+    explicit Writer(Logs& logs)
+        : logs_(logs), cells_(std::make_unique<Cell[]>(capacity))
+    {
+        for (std::uint64_t i = 0; i != capacity; ++i)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+
+        thread_ = std::thread([this] { run(); });
+    }
+
+    ~Writer()
+    {
+        stop_.store(true, std::memory_order_release);
+        queued_.fetch_add(1, std::memory_order_release);
+        queued_.notify_one();
+        thread_.join();
+    }
+
+    /** Queue a message, returning its position or nothing if full. */
+    std::optional<std::uint64_t>
+    push(
+        beast::severities::Severity level,
+        std::string const& partition,
+        std::string const& text)
+    {
+        auto pos = tail_.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        for (;;)
+        {
+            cell = &cells_[pos % capacity];
+            auto const seq = cell->sequence.load(std::memory_order_acquire);
+
+            if (seq == pos)
+            {
+                if (tail_.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (seq < pos)
+            {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+            else
+            {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->message.when = std::chrono::system_clock::now();
+        cell->message.level = level;
+        cell->message.partition = partition;
+        cell->message.text = text;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+
+        queued_.fetch_add(1, std::memory_order_release);
+        queued_.notify_one();
+        return pos;
+    }
+
+    /** Wait until the message at the given position has been written. */
+    void
+    waitFor(std::uint64_t pos)
+    {
+        for (auto written = written_.load(std::memory_order_acquire);
+             written <= pos;
+             written = written_.load(std::memory_order_acquire))
+            written_.wait(written, std::memory_order_acquire);
+    }
+
+    /** Wait until every message queued so far has been written. */
+    void
+    flush()
+    {
+        auto const tail = tail_.load(std::memory_order_acquire);
+        if (tail != 0)
+            waitFor(tail - 1);
+    }
+
+    std::uint64_t
+    dropped() const
+    {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+private:
+    void
+    run()
+    {
+        beast::setCurrentThreadName("rippled: log");
+
+        std::string batch;
+        std::string line;
+        std::uint64_t reported = 0;
+
+        for (;;)
+        {
+            auto const queued = queued_.load(std::memory_order_acquire);
+            auto pos = written_.load(std::memory_order_relaxed);
+
+            batch.clear();
+            std::size_t count = 0;
+
+            for (; count != maxBatch; ++count, ++pos)
+            {
+                auto& cell = cells_[pos % capacity];
+                if (cell.sequence.load(std::memory_order_acquire) != pos + 1)
+                    break;
+
+                auto& m = cell.message;
+                format(line, m.text, m.level, m.partition, m.when);
+                batch += line;
+                batch += '\n';
+
+                cell.sequence.store(pos + capacity, std::memory_order_release);
+            }
+
+            if (auto const dropped = dropped_.load(std::memory_order_relaxed);
+                dropped != reported)
+            {
+                format(
+                    line,
+                    std::to_string(dropped - reported) +
+                        " log messages were dropped",
+                    beast::severities::kWarning,
+                    "Logs",
+                    std::chrono::system_clock::now());
+                batch += line;
+                batch += '\n';
+                reported = dropped;
+            }
+
+            if (!batch.empty())
+            {
+                {
+                    std::lock_guard lock(logs_.mutex_);
+                    logs_.file_.write(batch);
+                    logs_.file_.flush();
+                    if (!logs_.silent_.load(std::memory_order_relaxed))
+                        std::cerr << batch;
+                }
+
+                written_.store(pos, std::memory_order_release);
+                written_.notify_all();
+                continue;
+            }
+
+            if (stop_.load(std::memory_order_acquire))
+                break;
+
+            queued_.wait(queued, std::memory_order_acquire);
+        }
+    }
+};
+
 //------------------------------------------------------------------------------
 
 Logs::Logs(beast::severities::Severity thresh)
@@ -120,6 +333,18 @@ Logs::Logs(beast::severities::Severity thresh)
 {
 }
 
+Logs::~Logs() = default;
+
+Logs::Writer&
+Logs::writer()
+{
+    // Started on first use, since many Logs never write to the file
+    std::call_once(writerStarted_, [this] {
+        writer_ = std::make_unique<Writer>(*this);
+    });
+    return *writer_;
+}
+
 bool
 Logs::open(boost::filesystem::path const& pathToLogFile)
 {
@@ -179,17 +404,41 @@ Logs::write(
     std::string const& text,
     bool console)
 {
-    std::string s;
-    format(s, text, level, partition);
-    std::lock_guard lock(mutex_);
-    file_.writeln(s);
-    if (!silent_)
-        std::cerr << s << '\n';
+    if (auto const pos = writer().push(level, partition, text))
+    {
+        if (level >= beast::severities::kFatal)
+            writer().waitFor(*pos);
+        return;
+    }
+
+    if (level >= beast::severities::kFatal)
+    {
+        // Never drop a fatal message
+        std::string s;
+        format(s, text, level, partition, std::chrono::system_clock::now());
+        std::lock_guard lock(mutex_);
+        file_.writeln(s);
+        if (!silent_.load(std::memory_order_relaxed))
+            std::cerr << s << '\n';
+    }
+
     // VFALCO TODO Fix console output
     // if (console)
     //    out_.write_console(s);
 }
 
+void
+Logs::flush()
+{
+    writer().flush();
+}
+
+std::uint64_t
+Logs::dropped()
+{
+    return writer().dropped();
+}
+
 std::string
 Logs::rotate()
 {
@@ -312,11 +561,12 @@ Logs::format(
     std::string& output,
     std::string const& message,
     beast::severities::Severity severity,
-    std::string const& partition)
+    std::string const& partition,
+    std::chrono::system_clock::time_point when)
 {
     output.reserve(message.size() + partition.size() + 100);
 
-    output = to_string(std::chrono::system_clock::now());
+    output = to_string(when);
 
     output += " ";
     if (!partition.empty())
@@ -0,0 +1,147 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+//==============================================================================
+
+#include <ripple/basics/Numa.h>
+#include <boost/predef.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#if BOOST_OS_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace ripple {
+namespace numa {
+
+namespace {
+
+// Parses a kernel CPU list, like "0-3,8-11"
+std::vector<unsigned>
+parseCpuList(std::string const& list)
+{
+    std::vector<unsigned> ret;
+    std::istringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        auto const dash = item.find('-');
+        try
+        {
+            auto const first = std::stoul(item.substr(0, dash));
+            auto const last = dash == std::string::npos
+                ? first
+                : std::stoul(item.substr(dash + 1));
+            for (auto cpu = first; cpu <= last; ++cpu)
+                ret.push_back(static_cast<unsigned>(cpu));
+        }
+        catch (std::exception const&)
+        {
+            return {};
+        }
+    }
+    return ret;
+}
+
+std::vector<std::vector<unsigned>>
+readNodes()
+{
+    std::vector<std::vector<unsigned>> ret;
+#if BOOST_OS_LINUX
+    for (std::size_t node = 0;; ++node)
+    {
+        std::ifstream file(
+            "/sys/devices/system/node/node" + std::to_string(node) +
+            "/cpulist");
+        if (!file)
+            break;
+        std::string list;
+        std::getline(file, list);
+        ret.push_back(parseCpuList(list));
+    }
+#endif
+    return ret;
+}
+
+}  // namespace
+
+std::vector<std::vector<unsigned>> const&
+nodes()
+{
+    static auto const ret = readNodes();
+    return ret;
+}
+
+void
+pin(std::thread& t, std::vector<unsigned> const& cpus) noexcept
+{
+#if BOOST_OS_LINUX
+    if (cpus.empty())
+        return;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (auto const cpu : cpus)
+    {
+        if (cpu < CPU_SETSIZE)
+            CPU_SET(cpu, &set);
+    }
+    pthread_setaffinity_np(t.native_handle(), sizeof(set), &set);
+#else
+    (void)t;
+    (void)cpus;
+#endif
+}
+
+void
+spread(std::thread& t, std::size_t index) noexcept
+{
+    std::vector<std::vector<unsigned>> const* all = nullptr;
+    try
+    {
+        all = &nodes();
+    }
+    catch (std::exception const&)
+    {
+        return;
+    }
+
+    auto const used = std::count_if(
+        all->begin(), all->end(), [](auto const& cpus) {
+            return !cpus.empty();
+        });
+    if (used < 2)
+        return;
+
+    // Pick the node with CPUs at this position, skipping the empty ones
+    auto n = index % used;
+    for (auto const& cpus : *all)
+    {
+        if (cpus.empty())
+            continue;
+        if (n-- == 0)
+            return pin(t, cpus);
+    }
+}
+
+}  // namespace numa
+}  // namespace ripple
@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/basics/MathUtilities.h>
 #include <ripple/basics/Number.h>
 #include <boost/predef.h>
 #include <algorithm>
@@ -180,11 +181,7 @@ Number::normalize()
     auto m = static_cast<std::make_unsigned_t<rep>>(mantissa_);
     if (negative)
         m = -m;
-    while ((m < minMantissa) && (exponent_ > minExponent))
-    {
-        m *= 10;
-        --exponent_;
-    }
+    scaleToDigits(m, exponent_, decimalDigits(minMantissa), minExponent);
     Guard g;
     if (negative)
         g.set_negative();
@@ -0,0 +1,282 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/Trace.h>
+#include <ripple/basics/strHex.h>
+#include <ripple/beast/core/CurrentThreadName.h>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ripple {
+namespace trace {
+
+#if RIPPLE_TRACING
+
+namespace detail {
+
+std::atomic<bool> enabled{false};
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+clock_type::time_point const epoch = clock_type::now();
+
+// Spans which started before this time have been cleared.
+std::atomic<std::uint64_t> clearedAt{0};
+
+// One recorded span, guarded by a sequence lock: seq is odd while the
+// owning thread writes the slot, and readers discard a copy if seq
+// changed while they were reading it.
+struct Slot
+{
+    std::atomic<std::uint64_t> seq{0};
+    std::atomic<char const*> name{nullptr};
+    std::atomic<std::uint64_t> id{0};
+    std::atomic<std::uint64_t> start{0};
+    std::atomic<std::uint64_t> end{0};
+};
+
+struct Ring
+{
+    Ring(std::uint32_t tid_, std::string threadName_)
+        : tid(tid_), threadName(std::move(threadName_))
+    {
+    }
+
+    std::uint32_t const tid;
+    std::string const threadName;
+
+    // The number of spans ever written; only the owning thread writes.
+    std::atomic<std::uint64_t> head{0};
+    std::array<Slot, ringSize> slots;
+};
+
+struct Event
+{
+    char const* name;
+    std::uint64_t id;
+    std::uint64_t start;
+    std::uint64_t end;
+};
+
+class Registry
+{
+    std::mutex mutex_;
+    std::vector<std::weak_ptr<Ring>> rings_;
+    std::uint32_t nextTid_ = 1;
+
+public:
+    std::shared_ptr<Ring>
+    add()
+    {
+        std::lock_guard lock(mutex_);
+        auto ring = std::make_shared<Ring>(
+            nextTid_++, beast::getCurrentThreadName());
+        std::erase_if(
+            rings_, [](std::weak_ptr<Ring> const& w) { return w.expired(); });
+        rings_.push_back(ring);
+        return ring;
+    }
+
+    std::vector<std::shared_ptr<Ring>>
+    rings()
+    {
+        std::vector<std::shared_ptr<Ring>> result;
+        std::lock_guard lock(mutex_);
+        result.reserve(rings_.size());
+        for (auto const& w : rings_)
+        {
+            if (auto ring = w.lock())
+                result.push_back(std::move(ring));
+        }
+        return result;
+    }
+};
+
+Registry&
+registry()
+{
+    static Registry r;
+    return r;
+}
+
+// A thread's ring is released when the thread exits, taking its
+// unexported spans with it.
+Ring&
+localRing()
+{
+    thread_local std::shared_ptr<Ring> const ring = registry().add();
+    return *ring;
+}
+
+std::vector<Event>
+read(Ring const& ring)
+{
+    std::vector<Event> events;
+    auto const cutoff = clearedAt.load(std::memory_order_relaxed);
+    auto const head = ring.head.load(std::memory_order_acquire);
+    auto const first = head > ringSize ? head - ringSize : 0;
+    events.reserve(head - first);
+
+    for (auto n = first; n != head; ++n)
+    {
+        auto const& slot = ring.slots[n % ringSize];
+        auto const seq = slot.seq.load(std::memory_order_acquire);
+        Event const e{
+            slot.name.load(std::memory_order_relaxed),
+            slot.id.load(std::memory_order_relaxed),
+            slot.start.load(std::memory_order_relaxed),
+            slot.end.load(std::memory_order_relaxed)};
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        // Skip slots which were overwritten while being read.
+        if (seq != 2 * n + 2 ||
+            slot.seq.load(std::memory_order_relaxed) != seq)
+            continue;
+
+        if (e.start >= cutoff)
+            events.push_back(e);
+    }
+    return events;
+}
+
+}  // namespace
+
+std::uint64_t
+now() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               clock_type::now() - epoch)
+        .count();
+}
+
+void
+record(
+    char const* name,
+    std::uint64_t id,
+    std::uint64_t start,
+    std::uint64_t end) noexcept
+{
+    Ring* ring;
+    try
+    {
+        ring = &localRing();
+    }
+    catch (...)
+    {
+        // Losing a span is better than failing the traced operation.
+        return;
+    }
+
+    auto const n = ring->head.load(std::memory_order_relaxed);
+    auto& slot = ring->slots[n % ringSize];
+    slot.seq.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.id.store(id, std::memory_order_relaxed);
+    slot.start.store(start, std::memory_order_relaxed);
+    slot.end.store(end, std::memory_order_relaxed);
+    slot.seq.store(2 * n + 2, std::memory_order_release);
+    ring->head.store(n + 1, std::memory_order_release);
+}
+
+}  // namespace detail
+
+void
+enable(bool on)
+{
+    detail::enabled.store(on, std::memory_order_relaxed);
+}
+
+void
+clear()
+{
+    detail::clearedAt.store(detail::now(), std::memory_order_relaxed);
+}
+
+Json::Value
+getChromeTrace()
+{
+    Json::Value result(Json::objectValue);
+    auto& events = result["traceEvents"] = Json::arrayValue;
+    result["displayTimeUnit"] = "ms";
+
+    for (auto const& ring : detail::registry().rings())
+    {
+        auto const spans = detail::read(*ring);
+        if (spans.empty())
+            continue;
+
+        auto& meta = events.append(Json::objectValue);
+        meta["name"] = "thread_name";
+        meta["ph"] = "M";
+        meta["pid"] = 1;
+        meta["tid"] = ring->tid;
+        meta["args"]["name"] = ring->threadName;
+
+        for (auto const& span : spans)
+        {
+            auto& e = events.append(Json::objectValue);
+            e["name"] = span.name;
+            e["cat"] = "rippled";
+            e["ph"] = "X";
+            e["pid"] = 1;
+            e["tid"] = ring->tid;
+            e["ts"] = static_cast<double>(span.start) / 1000;
+            e["dur"] = static_cast<double>(span.end - span.start) / 1000;
+            if (span.id != 0)
+            {
+                std::array<std::uint8_t, sizeof(span.id)> bytes;
+                for (std::size_t i = 0; i != bytes.size(); ++i)
+                    bytes[i] = span.id >> (8 * (bytes.size() - 1 - i));
+                e["args"]["id"] = strHex(bytes);
+            }
+        }
+    }
+    return result;
+}
+
+#else
+
+void
+enable(bool)
+{
+}
+
+void
+clear()
+{
+}
+
+Json::Value
+getChromeTrace()
+{
+    Json::Value result(Json::objectValue);
+    result["traceEvents"] = Json::arrayValue;
+    return result;
+}
+
+#endif
+
+}  // namespace trace
+}  // namespace ripple
@@ -1198,6 +1198,22 @@ public:
         touch(pos, clock().now());
     }
 
+    /** Update an element's time, unless it is already current.
+
+        Elements with equal times expire together, so one that is already
+        current keeps its place in the chronological order without being
+        relinked. Unlike touch, the order among elements touched within
+        one tick of the clock is not preserved.
+    */
+    template <bool is_const, class Iterator>
+    void
+    refresh(beast::detail::aged_container_iterator<is_const, Iterator> pos)
+    {
+        auto const now(clock().now());
+        if (pos.iterator()->when != now)
+            touch(pos, now);
+    }
+
     template <class K>
     auto
     touch(K const& k) -> size_type;
@@ -1518,8 +1534,13 @@ private:
     {
         auto& e(*pos.iterator());
         e.when = now;
-        chronological.list.erase(chronological.list.iterator_to(e));
-        chronological.list.push_back(e);
+
+        // The most recently touched element needs no relinking
+        if (&e != &chronological.list.back())
+        {
+            chronological.list.erase(chronological.list.iterator_to(e));
+            chronological.list.push_back(e);
+        }
     }
 
     template <
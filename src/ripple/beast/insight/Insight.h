@@ -32,6 +32,7 @@
 #include <ripple/beast/insight/Hook.h>
 #include <ripple/beast/insight/HookImpl.h>
 #include <ripple/beast/insight/NullCollector.h>
+#include <ripple/beast/insight/PrometheusCollector.h>
 #include <ripple/beast/insight/StatsDCollector.h>
 
 #endif
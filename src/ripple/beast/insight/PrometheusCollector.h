@@ -0,0 +1,73 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of Beast: https://github.com/vinniefalco/Beast
+    Copyright 2013, Vinnie Falco <vinnie.falco@gmail.com>
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef BEAST_INSIGHT_PROMETHEUSCOLLECTOR_H_INCLUDED
+#define BEAST_INSIGHT_PROMETHEUSCOLLECTOR_H_INCLUDED
+
+#include <ripple/beast/insight/Collector.h>
+
+#include <ripple/beast/net/IPEndpoint.h>
+#include <ripple/beast/utility/Journal.h>
+
+namespace beast {
+namespace insight {
+
+/** A Collector which serves its metrics to be scraped over HTTP.
+
+    Metrics are kept in atomics, so updating them never takes a lock. A GET
+    of /metrics on the listening port returns their current values in the
+    OpenMetrics text format. Hooks are called once for each scrape, just
+    before the values are read.
+
+    Counters and meters are reported as counters, gauges as gauges, and
+    events as histograms of their durations in milliseconds.
+
+    Reference:
+        https://github.com/OpenObservability/OpenMetrics
+*/
+class PrometheusCollector : public Collector
+{
+public:
+    explicit PrometheusCollector() = default;
+
+    /** Return the current values of all metrics in the OpenMetrics text
+        format, as served to scrapers.
+    */
+    virtual std::string
+    render() = 0;
+
+    /** Return the address scrapers connect to. */
+    virtual IP::Endpoint
+    local_endpoint() const = 0;
+
+    /** Create a Prometheus collector.
+        @param address The IP address and port to listen on for scrapes.
+        @param prefix A string pre-pended before each metric name.
+        @param journal Destination for logging output.
+    */
+    static std::shared_ptr<PrometheusCollector>
+    New(IP::Endpoint const& address,
+        std::string const& prefix,
+        Journal journal);
+};
+
+}  // namespace insight
+}  // namespace beast
+
+#endif
@@ -0,0 +1,754 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of Beast: https://github.com/vinniefalco/Beast
+    Copyright 2013, Vinnie Falco <vinnie.falco@gmail.com>
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/core/List.h>
+#include <ripple/beast/insight/CounterImpl.h>
+#include <ripple/beast/insight/EventImpl.h>
+#include <ripple/beast/insight/GaugeImpl.h>
+#include <ripple/beast/insight/HookImpl.h>
+#include <ripple/beast/insight/MeterImpl.h>
+#include <ripple/beast/insight/PrometheusCollector.h>
+#include <ripple/beast/net/IPAddressConversion.h>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
+#include <boost/beast/http/empty_body.hpp>
+#include <boost/beast/http/read.hpp>
+#include <boost/beast/http/string_body.hpp>
+#include <boost/beast/http/write.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace beast {
+namespace insight {
+
+namespace detail {
+
+class PrometheusCollectorImp;
+
+//------------------------------------------------------------------------------
+
+/** The samples of one metric family, in the order they are written. */
+struct PrometheusFamily
+{
+    char const* type;
+    std::vector<std::pair<std::string, std::int64_t>> samples;
+};
+
+using PrometheusFamilies = std::map<std::string, PrometheusFamily>;
+
+class PrometheusMetricBase : public List<PrometheusMetricBase>::Node
+{
+public:
+    virtual void
+    do_process(PrometheusFamilies& families) = 0;
+    virtual ~PrometheusMetricBase() = default;
+    PrometheusMetricBase() = default;
+    PrometheusMetricBase(PrometheusMetricBase const&) = delete;
+    PrometheusMetricBase&
+    operator=(PrometheusMetricBase const&) = delete;
+};
+
+//------------------------------------------------------------------------------
+
+class PrometheusHookImpl : public HookImpl, public PrometheusMetricBase
+{
+public:
+    PrometheusHookImpl(
+        HandlerType const& handler,
+        std::shared_ptr<PrometheusCollectorImp> const& impl);
+
+    ~PrometheusHookImpl() override;
+
+    void
+    do_process(PrometheusFamilies& families) override;
+
+private:
+    std::shared_ptr<PrometheusCollectorImp> m_impl;
+    HandlerType m_handler;
+};
+
+//------------------------------------------------------------------------------
+
+class PrometheusCounterImpl : public CounterImpl, public PrometheusMetricBase
+{
+public:
+    PrometheusCounterImpl(
+        std::string const& name,
+        std::shared_ptr<PrometheusCollectorImp> const& impl);
+
+    ~PrometheusCounterImpl() override;
+
+    void
+    increment(CounterImpl::value_type amount) override;
+
+    void
+    do_process(PrometheusFamilies& families) override;
+
+private:
+    std::shared_ptr<PrometheusCollectorImp> m_impl;
+    std::string m_name;
+    std::atomic<CounterImpl::value_type> m_value{0};
+};
+
+//------------------------------------------------------------------------------
+
+class PrometheusEventImpl : public EventImpl, public PrometheusMetricBase
+{
+public:
+    PrometheusEventImpl(
+        std::string const& name,
+        std::shared_ptr<PrometheusCollectorImp> const& impl);
+
+    ~PrometheusEventImpl() override;
+
+    void
+    notify(EventImpl::value_type const& value) override;
+
+    void
+    do_process(PrometheusFamilies& families) override;
+
+private:
+    // Upper bounds of the buckets, in milliseconds
+    static constexpr std::array<std::int64_t, 13> bounds{
+        1, 2, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000};
+
+    std::shared_ptr<PrometheusCollectorImp> m_impl;
+    std::string m_name;
+    // One more bucket than bounds, for larger values
+    std::array<std::atomic<std::int64_t>, bounds.size() + 1> m_buckets{};
+    std::atomic<std::int64_t> m_sum{0};
+};
+
+//------------------------------------------------------------------------------
+
+class PrometheusGaugeImpl : public GaugeImpl, public PrometheusMetricBase
+{
+public:
+    PrometheusGaugeImpl(
+        std::string const& name,
+        std::shared_ptr<PrometheusCollectorImp> const& impl);
+
+    ~PrometheusGaugeImpl() override;
+
+    void
+    set(GaugeImpl::value_type value) override;
+    void
+    increment(GaugeImpl::difference_type amount) override;
+
+    void
+    do_process(PrometheusFamilies& families) override;
+
+private:
+    std::shared_ptr<PrometheusCollectorImp> m_impl;
+    std::string m_name;
+    std::atomic<GaugeImpl::value_type> m_value{0};
+};
+
+//------------------------------------------------------------------------------
+
+class PrometheusMeterImpl : public MeterImpl, public PrometheusMetricBase
+{
+public:
+    PrometheusMeterImpl(
+        std::string const& name,
+        std::shared_ptr<PrometheusCollectorImp> const& impl);
+
+    ~PrometheusMeterImpl() override;
+
+    void
+    increment(MeterImpl::value_type amount) override;
+
+    void
+    do_process(PrometheusFamilies& families) override;
+
+private:
+    std::shared_ptr<PrometheusCollectorImp> m_impl;
+    std::string m_name;
+    std::atomic<MeterImpl::value_type> m_value{0};
+};
+
+//------------------------------------------------------------------------------
+
+/** Answers the requests made on one connection by a scraper. */
+class PrometheusSession
+    : public std::enable_shared_from_this<PrometheusSession>
+{
+public:
+    PrometheusSession(
+        PrometheusCollectorImp& impl,
+        boost::asio::ip::tcp::socket&& socket);
+
+    void
+    run();
+
+private:
+    void
+    on_read(boost::system::error_code ec, std::size_t);
+
+    void
+    on_write(bool close, boost::system::error_code ec, std::size_t);
+
+    PrometheusCollectorImp& m_impl;
+    boost::beast::tcp_stream m_stream;
+    boost::beast::flat_buffer m_buffer;
+    boost::beast::http::request<boost::beast::http::empty_body> m_request;
+    boost::beast::http::response<boost::beast::http::string_body> m_response;
+};
+
+//------------------------------------------------------------------------------
+
+class PrometheusCollectorImp
+    : public PrometheusCollector,
+      public std::enable_shared_from_this<PrometheusCollectorImp>
+{
+private:
+    Journal m_journal;
+    std::string m_prefix;
+    boost::asio::io_service m_io_service;
+    boost::asio::ip::tcp::acceptor m_acceptor;
+    // Only taken to add and remove metrics, and to scrape them. Hooks may
+    // create metrics while the lock is held.
+    std::recursive_mutex metricsLock_;
+    List<PrometheusMetricBase> metrics_;
+
+    std::thread m_thread;
+
+public:
+    PrometheusCollectorImp(
+        IP::Endpoint const& address,
+        std::string const& prefix,
+        Journal journal)
+        : m_journal(journal)
+        , m_prefix(prefix)
+        , m_acceptor(m_io_service)
+    {
+        // Listen before returning, so the port is known to the caller
+        if (listen(address))
+        {
+            do_accept();
+            m_thread = std::thread([this] { m_io_service.run(); });
+        }
+    }
+
+    ~PrometheusCollectorImp() override
+    {
+        // Connections still open are abandoned
+        m_io_service.stop();
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+
+    Hook
+    make_hook(HookImpl::HandlerType const& handler) override
+    {
+        return Hook(std::make_shared<detail::PrometheusHookImpl>(
+            handler, shared_from_this()));
+    }
+
+    Counter
+    make_counter(std::string const& name) override
+    {
+        return Counter(std::make_shared<detail::PrometheusCounterImpl>(
+            name, shared_from_this()));
+    }
+
+    Event
+    make_event(std::string const& name) override
+    {
+        return Event(std::make_shared<detail::PrometheusEventImpl>(
+            name, shared_from_this()));
+    }
+
+    Gauge
+    make_gauge(std::string const& name) override
+    {
+        return Gauge(std::make_shared<detail::PrometheusGaugeImpl>(
+            name, shared_from_this()));
+    }
+
+    Meter
+    make_meter(std::string const& name) override
+    {
+        return Meter(std::make_shared<detail::PrometheusMeterImpl>(
+            name, shared_from_this()));
+    }
+
+    IP::Endpoint
+    local_endpoint() const override
+    {
+        boost::system::error_code ec;
+        return IP::from_asio(m_acceptor.local_endpoint(ec));
+    }
+
+    //--------------------------------------------------------------------------
+
+    void
+    add(PrometheusMetricBase& metric)
+    {
+        std::lock_guard _(metricsLock_);
+        metrics_.push_back(metric);
+    }
+
+    void
+    remove(PrometheusMetricBase& metric)
+    {
+        std::lock_guard _(metricsLock_);
+        metrics_.erase(metrics_.iterator_to(metric));
+    }
+
+    //--------------------------------------------------------------------------
+
+    // Metric names may only hold letters, digits, underscores and colons,
+    // and may not start with a digit.
+    static std::string
+    sanitize(std::string name)
+    {
+        for (auto& c : name)
+        {
+            if (!std::isalnum(static_cast<unsigned char>(c)) && c != ':')
+                c = '_';
+        }
+        if (!name.empty() && std::isdigit(static_cast<unsigned char>(name[0])))
+            name.insert(name.begin(), '_');
+        return name;
+    }
+
+    /** Add the samples of a metric to its family.
+
+        Metrics created with the same name are reported as one, with their
+        values added together.
+    */
+    void
+    merge(
+        PrometheusFamilies& families,
+        std::string const& name,
+        PrometheusFamily&& family)
+    {
+        auto const fullName =
+            sanitize(m_prefix.empty() ? name : m_prefix + "." + name);
+
+        auto const [it, inserted] =
+            families.try_emplace(fullName, std::move(family));
+        if (inserted)
+            return;
+
+        auto& existing = it->second;
+        if (std::string_view(existing.type) != family.type ||
+            existing.samples.size() != family.samples.size())
+        {
+            if (auto stream = m_journal.debug())
+                stream << "Metric " << fullName << " has conflicting types";
+            return;
+        }
+
+        for (std::size_t i = 0; i < family.samples.size(); ++i)
+            existing.samples[i].second += family.samples[i].second;
+    }
+
+    std::string
+    render() override
+    {
+        PrometheusFamilies families;
+        {
+            std::lock_guard _(metricsLock_);
+
+            // Hooks come first, so the gauges they set are current
+            for (auto& m : metrics_)
+            {
+                if (dynamic_cast<PrometheusHookImpl*>(&m))
+                    m.do_process(families);
+            }
+            for (auto& m : metrics_)
+            {
+                if (!dynamic_cast<PrometheusHookImpl*>(&m))
+                    m.do_process(families);
+            }
+        }
+
+        std::ostringstream ss;
+        for (auto const& [name, family] : families)
+        {
+            ss << "# TYPE " << name << " " << family.type << "\n";
+            for (auto const& [suffix, value] : family.samples)
+                ss << name << suffix << " " << value << "\n";
+        }
+        ss << "# EOF\n";
+        return ss.str();
+    }
+
+    //--------------------------------------------------------------------------
+
+    void
+    do_accept()
+    {
+        m_acceptor.async_accept(
+            [this](
+                boost::system::error_code ec,
+                boost::asio::ip::tcp::socket socket) {
+                if (ec == boost::asio::error::operation_aborted)
+                    return;
+
+                if (ec)
+                {
+                    if (auto stream = m_journal.warn())
+                        stream << "accept failed: " << ec.message();
+                }
+                else
+                {
+                    std::make_shared<PrometheusSession>(
+                        *this, std::move(socket))
+                        ->run();
+                }
+
+                do_accept();
+            });
+    }
+
+    bool
+    listen(IP::Endpoint const& address)
+    {
+        boost::system::error_code ec;
+        auto const endpoint = IP::to_asio_endpoint(address);
+
+        m_acceptor.open(endpoint.protocol(), ec);
+        if (!ec)
+            m_acceptor.set_option(
+                boost::asio::ip::tcp::acceptor::reuse_address(true), ec);
+        if (!ec)
+            m_acceptor.bind(endpoint, ec);
+        if (!ec)
+            m_acceptor.listen(
+                boost::asio::socket_base::max_listen_connections, ec);
+        if (ec)
+        {
+            if (auto stream = m_journal.error())
+                stream << "Listen on " << address
+                       << " failed: " << ec.message();
+            return false;
+        }
+        return true;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+PrometheusSession::PrometheusSession(
+    PrometheusCollectorImp& impl,
+    boost::asio::ip::tcp::socket&& socket)
+    : m_impl(impl), m_stream(std::move(socket))
+{
+}
+
+void
+PrometheusSession::run()
+{
+    using namespace std::chrono_literals;
+
+    m_request = {};
+    m_stream.expires_after(30s);
+    boost::beast::http::async_read(
+        m_stream,
+        m_buffer,
+        m_request,
+        std::bind(
+            &PrometheusSession::on_read,
+            shared_from_this(),
+            std::placeholders::_1,
+            std::placeholders::_2));
+}
+
+void
+PrometheusSession::on_read(boost::system::error_code ec, std::size_t)
+{
+    namespace http = boost::beast::http;
+    using namespace std::chrono_literals;
+
+    if (ec)
+        return;
+
+    m_response = {};
+    m_response.version(m_request.version());
+    m_response.keep_alive(m_request.keep_alive());
+    m_response.set(http::field::server, "rippled");
+
+    if (m_request.method() != http::verb::get)
+    {
+        m_response.result(http::status::method_not_allowed);
+        m_response.set(http::field::allow, "GET");
+    }
+    else if (m_request.target() != "/metrics")
+    {
+        m_response.result(http::status::not_found);
+    }
+    else
+    {
+        m_response.result(http::status::ok);
+        m_response.set(
+            http::field::content_type,
+            "application/openmetrics-text; version=1.0.0; charset=utf-8");
+        m_response.body() = m_impl.render();
+    }
+    m_response.prepare_payload();
+
+    m_stream.expires_after(30s);
+    http::async_write(
+        m_stream,
+        m_response,
+        std::bind(
+            &PrometheusSession::on_write,
+            shared_from_this(),
+            !m_response.keep_alive(),
+            std::placeholders::_1,
+            std::placeholders::_2));
+}
+
+void
+PrometheusSession::on_write(
+    bool close,
+    boost::system::error_code ec,
+    std::size_t)
+{
+    if (ec)
+        return;
+
+    if (close)
+    {
+        m_stream.socket().shutdown(
+            boost::asio::ip::tcp::socket::shutdown_send, ec);
+        return;
+    }
+
+    run();
+}
+
+//------------------------------------------------------------------------------
+
+PrometheusHookImpl::PrometheusHookImpl(
+    HandlerType const& handler,
+    std::shared_ptr<PrometheusCollectorImp> const& impl)
+    : m_impl(impl), m_handler(handler)
+{
+    m_impl->add(*this);
+}
+
+PrometheusHookImpl::~PrometheusHookImpl()
+{
+    m_impl->remove(*this);
+}
+
+void
+PrometheusHookImpl::do_process(PrometheusFamilies&)
+{
+    m_handler();
+}
+
+//------------------------------------------------------------------------------
+
+PrometheusCounterImpl::PrometheusCounterImpl(
+    std::string const& name,
+    std::shared_ptr<PrometheusCollectorImp> const& impl)
+    : m_impl(impl), m_name(name)
+{
+    m_impl->add(*this);
+}
+
+PrometheusCounterImpl::~PrometheusCounterImpl()
+{
+    m_impl->remove(*this);
+}
+
+void
+PrometheusCounterImpl::increment(CounterImpl::value_type amount)
+{
+    m_value.fetch_add(amount, std::memory_order_relaxed);
+}
+
+void
+PrometheusCounterImpl::do_process(PrometheusFamilies& families)
+{
+    m_impl->merge(
+        families,
+        m_name,
+        {"counter", {{"_total", m_value.load(std::memory_order_relaxed)}}});
+}
+
+//------------------------------------------------------------------------------
+
+PrometheusEventImpl::PrometheusEventImpl(
+    std::string const& name,
+    std::shared_ptr<PrometheusCollectorImp> const& impl)
+    : m_impl(impl), m_name(name)
+{
+    m_impl->add(*this);
+}
+
+PrometheusEventImpl::~PrometheusEventImpl()
+{
+    m_impl->remove(*this);
+}
+
+void
+PrometheusEventImpl::notify(EventImpl::value_type const& value)
+{
+    auto const ms = std::max<std::int64_t>(value.count(), 0);
+    auto const bucket =
+        std::lower_bound(bounds.begin(), bounds.end(), ms) - bounds.begin();
+    m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(ms, std::memory_order_relaxed);
+}
+
+void
+PrometheusEventImpl::do_process(PrometheusFamilies& families)
+{
+    PrometheusFamily family{"histogram", {}};
+    family.samples.reserve(bounds.size() + 3);
+
+    // Buckets are reported cumulatively
+    std::int64_t count = 0;
+    for (std::size_t i = 0; i < bounds.size(); ++i)
+    {
+        count += m_buckets[i].load(std::memory_order_relaxed);
+        family.samples.emplace_back(
+            "_bucket{le=\"" + std::to_string(bounds[i]) + "\"}", count);
+    }
+    count += m_buckets[bounds.size()].load(std::memory_order_relaxed);
+    family.samples.emplace_back("_bucket{le=\"+Inf\"}", count);
+    family.samples.emplace_back("_count", count);
+    family.samples.emplace_back(
+        "_sum", m_sum.load(std::memory_order_relaxed));
+
+    m_impl->merge(families, m_name, std::move(family));
+}
+
+//------------------------------------------------------------------------------
+
+PrometheusGaugeImpl::PrometheusGaugeImpl(
+    std::string const& name,
+    std::shared_ptr<PrometheusCollectorImp> const& impl)
+    : m_impl(impl), m_name(name)
+{
+    m_impl->add(*this);
+}
+
+PrometheusGaugeImpl::~PrometheusGaugeImpl()
+{
+    m_impl->remove(*this);
+}
+
+void
+PrometheusGaugeImpl::set(GaugeImpl::value_type value)
+{
+    m_value.store(value, std::memory_order_relaxed);
+}
+
+void
+PrometheusGaugeImpl::increment(GaugeImpl::difference_type amount)
+{
+    // Saturate at the limits of the value, as the StatsD gauge does
+    auto value = m_value.load(std::memory_order_relaxed);
+    GaugeImpl::value_type next;
+    do
+    {
+        if (amount > 0)
+        {
+            auto const d = static_cast<GaugeImpl::value_type>(amount);
+            next = (d >= std::numeric_limits<GaugeImpl::value_type>::max() -
+                        value)
+                ? std::numeric_limits<GaugeImpl::value_type>::max()
+                : value + d;
+        }
+        else
+        {
+            auto const d = static_cast<GaugeImpl::value_type>(-amount);
+            next = (d >= value) ? 0 : value - d;
+        }
+    } while (!m_value.compare_exchange_weak(
+        value, next, std::memory_order_relaxed));
+}
+
+void
+PrometheusGaugeImpl::do_process(PrometheusFamilies& families)
+{
+    m_impl->merge(
+        families,
+        m_name,
+        {"gauge",
+         {{"",
+           static_cast<std::int64_t>(
+               m_value.load(std::memory_order_relaxed))}}});
+}
+
+//------------------------------------------------------------------------------
+
+PrometheusMeterImpl::PrometheusMeterImpl(
+    std::string const& name,
+    std::shared_ptr<PrometheusCollectorImp> const& impl)
+    : m_impl(impl), m_name(name)
+{
+    m_impl->add(*this);
+}
+
+PrometheusMeterImpl::~PrometheusMeterImpl()
+{
+    m_impl->remove(*this);
+}
+
+void
+PrometheusMeterImpl::increment(MeterImpl::value_type amount)
+{
+    m_value.fetch_add(amount, std::memory_order_relaxed);
+}
+
+void
+PrometheusMeterImpl::do_process(PrometheusFamilies& families)
+{
+    m_impl->merge(
+        families,
+        m_name,
+        {"counter",
+         {{"_total",
+           static_cast<std::int64_t>(
+               m_value.load(std::memory_order_relaxed))}}});
+}
+
+}  // namespace detail
+
+//------------------------------------------------------------------------------
+
+std::shared_ptr<PrometheusCollector>
+PrometheusCollector::New(
+    IP::Endpoint const& address,
+    std::string const& prefix,
+    Journal journal)
+{
+    return std::make_shared<detail::PrometheusCollectorImp>(
+        address, prefix, journal);
+}
+
+}  // namespace insight
+}  // namespace beast
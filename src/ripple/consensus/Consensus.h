@@ -21,6 +21,7 @@
 #define RIPPLE_CONSENSUS_CONSENSUS_H_INCLUDED
 
 #include <ripple/basics/Log.h>
+#include <ripple/basics/Trace.h>
 #include <ripple/basics/chrono.h>
 #include <ripple/beast/utility/Journal.h>
 #include <ripple/consensus/ConsensusParms.h>
@@ -247,6 +248,12 @@ checkConsensus(
       // Called when ledger closes
       Result onClose(Ledger const &, Ledger const & prev, Mode mode);
 
+      // Called when our position held through an establish period, so
+      // it is likely to be the one accepted
+      void onStablePosition(Result const & result,
+        Ledger const & prevLedger,
+        NetClock::duration closeResolution);
+
       // Called when ledger is accepted by consensus
       void onAccept(Result const & result,
         RCLCxLedger const & prevLedger,
@@ -359,6 +366,9 @@ public:
 
     /** A peer has proposed a new position, adjust our tracking.
 
+        In the establish phase, the position is considered right away
+        rather than on the next call to timerEntry.
+
         @param now The network adjusted time
         @param newProposal The new proposal from a peer
         @return Whether we should do delayed relay of this proposal.
@@ -377,6 +387,8 @@ public:
 
     /** Process a transaction set acquired from the network
 
+        Like a peer position, a set peers propose is considered right away.
+
         @param now The network adjusted time
         @param txSet the transaction set
     */
@@ -475,11 +487,19 @@ private:
     void
     phaseOpen();
 
+    /** A peer position or transaction set arrived.
+
+        In the establish phase, re-evaluate the round right away instead
+        of on the next timer, at most once per ledgerEVENT_GRANULARITY.
+    */
+    void
+    peerChanged();
+
     /** Handle establish phase.
 
         In the establish phase, the ledger has closed and we work with peers
-        to reach consensus. Update our position only on the timer, and in this
-        phase.
+        to reach consensus. Update our position only in this phase, on the
+        timer or as peer positions and transaction sets arrive.
 
         If we have consensus, move to the accepted phase.
     */
@@ -557,6 +577,9 @@ private:
     // How long has this round been open
     ConsensusTimer openTime_;
 
+    // When the establish phase was last evaluated
+    typename clock_type::time_point lastEstablish_;
+
     NetClock::duration closeResolution_ = ledgerDefaultTimeResolution;
 
     // Time it took for the last consensus round to converge
@@ -715,7 +738,12 @@ Consensus<Adaptor>::peerProposal(
 
         props.push_back(newPeerPos);
     }
-    return peerProposalInternal(now, newPeerPos);
+
+    if (!peerProposalInternal(now, newPeerPos))
+        return false;
+
+    peerChanged();
+    return true;
 }
 
 template <class Adaptor>
@@ -879,6 +907,10 @@ Consensus<Adaptor>::gotTxSet(
             JLOG(j_.warn())
                 << "By the time we got " << id << " no peers were proposing it";
         }
+        else
+        {
+            peerChanged();
+        }
     }
 }
 
@@ -1256,17 +1288,39 @@ Consensus<Adaptor>::shouldPause() const
     return willPause;
 }
 
+template <class Adaptor>
+void
+Consensus<Adaptor>::peerChanged()
+{
+    if (phase_ != ConsensusPhase::establish)
+        return;
+
+    if (clock_.now() - lastEstablish_ <
+        adaptor_.parms().ledgerEVENT_GRANULARITY)
+        return;
+
+    // As on the timer, make sure we are on the proper ledger before
+    // accepting one built on it (this may change phase_)
+    checkLedger();
+
+    if (phase_ == ConsensusPhase::establish)
+        phaseEstablish();
+}
+
 template <class Adaptor>
 void
 Consensus<Adaptor>::phaseEstablish()
 {
+    trace::Span span("Consensus::phaseEstablish");
+
     // can only establish consensus if we already took a stance
     assert(result_);
 
     using namespace std::chrono;
     ConsensusParms const& parms = adaptor_.parms();
 
-    result_->roundTime.tick(clock_.now());
+    lastEstablish_ = clock_.now();
+    result_->roundTime.tick(lastEstablish_);
     result_->proposers = currPeerPositions_.size();
 
     convergePercent_ = result_->roundTime.read() * 100 /
@@ -1276,8 +1330,15 @@ Consensus<Adaptor>::phaseEstablish()
     if (result_->roundTime.read() < parms.ledgerMIN_CONSENSUS)
         return;
 
+    auto const position = result_->position.position();
+    auto const closeTime = result_->position.closeTime();
+
     updateOurPositions();
 
+    if (result_->position.position() == position &&
+        result_->position.closeTime() == closeTime)
+        adaptor_.onStablePosition(*result_, previousLedger_, closeResolution_);
+
     // Nothing to do if too many laggards or we don't have consensus.
     if (shouldPause() || !haveConsensus())
         return;
@@ -1636,6 +1697,17 @@ Consensus<Adaptor>::createDisputes(TxSet_t const& o)
 
     auto differences = result_->txns.compare(o);
 
+    // Find the sets of the peers' positions once rather than for each
+    // disputed transaction.
+    std::vector<std::pair<NodeID_t, TxSet_t const*>> peerSets;
+    peerSets.reserve(currPeerPositions_.size());
+    for (auto const& [nodeId, peerPos] : currPeerPositions_)
+    {
+        auto const cit = acquired_.find(peerPos.proposal().position());
+        if (cit != acquired_.end())
+            peerSets.emplace_back(nodeId, &cit->second);
+    }
+
     int dc = 0;
 
     for (auto const& [txId, inThisSet] : differences)
@@ -1661,13 +1733,8 @@ Consensus<Adaptor>::createDisputes(TxSet_t const& o)
             j_};
 
         // Update all of the available peer's votes on the disputed transaction
-        for (auto const& [nodeId, peerPos] : currPeerPositions_)
-        {
-            Proposal_t const& peerProp = peerPos.proposal();
-            auto const cit = acquired_.find(peerProp.position());
-            if (cit != acquired_.end())
-                dtx.setVote(nodeId, cit->second.exists(txID));
-        }
+        for (auto const& [nodeId, peerSet] : peerSets)
+            dtx.setVote(nodeId, peerSet->exists(txID));
         adaptor_.share(dtx.tx());
 
         result_->disputes.emplace(txID, std::move(dtx));
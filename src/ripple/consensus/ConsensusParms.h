@@ -94,6 +94,12 @@ struct ConsensusParms
     //! How often we check state or change positions
     std::chrono::milliseconds ledgerGRANULARITY = std::chrono::seconds{1};
 
+    /** How often, at most, arriving positions and transaction sets make us
+        check state between timer calls.
+    */
+    std::chrono::milliseconds ledgerEVENT_GRANULARITY =
+        std::chrono::milliseconds{100};
+
     /** The minimum amount of time to consider the previous round
         to have taken.
 
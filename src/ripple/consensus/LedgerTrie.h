@@ -21,12 +21,14 @@
 #define RIPPLE_APP_CONSENSUS_LEDGERS_TRIE_H_INCLUDED
 
 #include <ripple/basics/ToString.h>
+#include <ripple/basics/UnorderedContainers.h>
 #include <ripple/json/json_value.h>
 #include <algorithm>
 #include <memory>
 #include <optional>
 #include <sstream>
 #include <stack>
+#include <tuple>
 #include <vector>
 
 namespace ripple {
@@ -147,8 +149,15 @@ public:
     SpanTip<Ledger>
     tip() const
     {
-        Seq tipSeq{end_ - Seq{1}};
-        return SpanTip<Ledger>{tipSeq, ledger_[tipSeq], ledger_};
+        return tipAt(end_ - Seq{1});
+    }
+
+    // The tip of the span [start_,seq]
+    SpanTip<Ledger>
+    tipAt(Seq seq) const
+    {
+        assert(start_ <= seq && seq < end_);
+        return SpanTip<Ledger>{seq, ledger_[seq], ledger_};
     }
 
 private:
@@ -211,17 +220,24 @@ struct Node
     std::uint32_t tipSupport = 0;
     std::uint32_t branchSupport = 0;
 
+    // Ordered by decreasing branch support, breaking ties with the larger
+    // span starting ID first
     std::vector<std::unique_ptr<Node>> children;
     Node* parent = nullptr;
 
-    /** Remove the given node from this Node's children
+    /** Whether a should be ordered before b amongst siblings
+     */
+    static bool
+    before(std::unique_ptr<Node> const& a, std::unique_ptr<Node> const& b)
+    {
+        return std::make_tuple(a->branchSupport, a->span.startID()) >
+            std::make_tuple(b->branchSupport, b->span.startID());
+    }
 
-        @param child The address of the child node to remove
-        @note The child must be a member of the vector. The passed pointer
-              will be dangling as a result of this call
-    */
-    void
-    erase(Node const* child)
+    /** Find the given node amongst this Node's children
+     */
+    auto
+    findChild(Node const* child)
     {
         auto it = std::find_if(
             children.begin(),
@@ -230,8 +246,39 @@ struct Node
                 return curr.get() == child;
             });
         assert(it != children.end());
-        std::swap(*it, children.back());
-        children.pop_back();
+        return it;
+    }
+
+    /** Restore the order of children after the support of one changed
+
+        @param child The address of the child node whose support changed
+    */
+    void
+    reorder(Node const* child)
+    {
+        auto it = findChild(child);
+        while (it != children.begin() && before(*it, *std::prev(it)))
+        {
+            std::iter_swap(it, std::prev(it));
+            --it;
+        }
+        while (std::next(it) != children.end() && before(*std::next(it), *it))
+        {
+            std::iter_swap(it, std::next(it));
+            ++it;
+        }
+    }
+
+    /** Remove the given node from this Node's children
+
+        @param child The address of the child node to remove
+        @note The child must be a member of the vector. The passed pointer
+              will be dangling as a result of this call
+    */
+    void
+    erase(Node const* child)
+    {
+        children.erase(findChild(child));
     }
 
     friend std::ostream&
@@ -358,6 +405,9 @@ class LedgerTrie
     // Count of the tip support for each sequence number
     std::map<Seq, std::uint32_t> seqSupport;
 
+    // Every node in the trie, indexed by the ID of its tip ledger
+    hash_map<ID, Node*> byTip;
+
     /** Find the node in the trie that represents the longest common ancestry
         with the given ledger.
 
@@ -399,23 +449,31 @@ class LedgerTrie
     /** Find the node in the trie with an exact match to the given ledger ID
 
         @return the found node or nullptr if an exact match was not found.
-
-        @note O(n) since this searches all nodes until a match is found
     */
     Node*
-    findByLedgerID(Ledger const& ledger, Node* parent = nullptr) const
+    findByLedgerID(Ledger const& ledger) const
     {
-        if (!parent)
-            parent = root.get();
-        if (ledger.id() == parent->span.tip().id)
-            return parent;
-        for (auto const& child : parent->children)
+        auto const it = byTip.find(ledger.id());
+        if (it == byTip.end())
+            return nullptr;
+        return it->second;
+    }
+
+    // Adjust the branch support of node and its ancestors, keeping
+    // each level's children ordered
+    void
+    addBranchSupport(Node* node, std::uint32_t count, bool increase)
+    {
+        while (node)
         {
-            auto cl = findByLedgerID(ledger, child.get());
-            if (cl)
-                return cl;
+            if (increase)
+                node->branchSupport += count;
+            else
+                node->branchSupport -= count;
+            if (node->parent)
+                node->parent->reorder(node);
+            node = node->parent;
         }
-        return nullptr;
     }
 
     void
@@ -438,6 +496,7 @@ class LedgerTrie
 public:
     LedgerTrie() : root{std::make_unique<Node>()}
     {
+        byTip.emplace(root->span.tip().id, root.get());
     }
 
     /** Insert and/or increment the support for the given ledger.
@@ -494,6 +553,8 @@ public:
             assert(prefix);
             loc->span = *prefix;
             newNode->parent = loc;
+            byTip[newNode->span.tip().id] = newNode.get();
+            byTip.emplace(loc->span.tip().id, loc);
             loc->children.emplace_back(std::move(newNode));
             loc->tipSupport = 0;
         }
@@ -511,15 +572,12 @@ public:
             newNode->parent = loc;
             // increment support starting from the new node
             incNode = newNode.get();
+            byTip.emplace(ledger.id(), incNode);
             loc->children.push_back(std::move(newNode));
         }
 
         incNode->tipSupport += count;
-        while (incNode)
-        {
-            incNode->branchSupport += count;
-            incNode = incNode->parent;
-        }
+        addBranchSupport(incNode, count, true);
 
         seqSupport[ledger.seq()] += count;
     }
@@ -549,12 +607,7 @@ public:
         if (it->second == 0)
             seqSupport.erase(it->first);
 
-        Node* decNode = loc;
-        while (decNode)
-        {
-            decNode->branchSupport -= count;
-            decNode = decNode->parent;
-        }
+        addBranchSupport(loc, count, false);
 
         while (loc->tipSupport == 0 && loc != root.get())
         {
@@ -562,16 +615,19 @@ public:
             if (loc->children.empty())
             {
                 // this node can be erased
+                byTip.erase(loc->span.tip().id);
                 parent->erase(loc);
             }
             else if (loc->children.size() == 1)
             {
-                // This node can be combined with its child
+                // This node can be combined with its child, which takes
+                // its place amongst the siblings since it has the same
+                // branch support and starting ledger
                 std::unique_ptr<Node> child = std::move(loc->children.front());
                 child->span = merge(loc->span, child->span);
                 child->parent = parent;
-                parent->children.emplace_back(std::move(child));
-                parent->erase(loc);
+                byTip.erase(loc->span.tip().id);
+                *parent->findChild(loc) = std::move(child);
             }
             else
                 break;
@@ -720,7 +776,7 @@ public:
                 // We did not consume the entire span, so we have found the
                 // preferred ledger
                 if (nextSeq < curr->span.end())
-                    return curr->span.before(nextSeq)->tip();
+                    return curr->span.tipAt(nextSeq - Seq{1});
             }
 
             // We have reached the end of the current span, so we need to
@@ -734,20 +790,8 @@ public:
             }
             else if (!curr->children.empty())
             {
-                // Sort placing children with largest branch support in the
+                // Children are kept with the largest branch support in the
                 // front, breaking ties with the span's starting ID
-                std::partial_sort(
-                    curr->children.begin(),
-                    curr->children.begin() + 2,
-                    curr->children.end(),
-                    [](std::unique_ptr<Node> const& a,
-                       std::unique_ptr<Node> const& b) {
-                        return std::make_tuple(
-                                   a->branchSupport, a->span.startID()) >
-                            std::make_tuple(
-                                   b->branchSupport, b->span.startID());
-                    });
-
                 best = curr->children[0].get();
                 margin = curr->children[0]->branchSupport -
                     curr->children[1]->branchSupport;
@@ -804,6 +848,7 @@ public:
     checkInvariants() const
     {
         std::map<Seq, std::uint32_t> expectedSeqSupport;
+        std::size_t numNodes = 0;
 
         std::stack<Node const*> nodes;
         nodes.push(root.get());
@@ -814,6 +859,19 @@ public:
             if (!curr)
                 continue;
 
+            // Every node is indexed by its tip
+            ++numNodes;
+            if (auto const it = byTip.find(curr->span.tip().id);
+                it == byTip.end() || it->second != curr)
+                return false;
+
+            // Children are ordered by decreasing branch support
+            if (!std::is_sorted(
+                    curr->children.begin(),
+                    curr->children.end(),
+                    &Node::before))
+                return false;
+
             // Node with 0 tip support must have multiple children
             // unless it is the root node
             if (curr != root.get() && curr->tipSupport == 0 &&
@@ -837,7 +895,7 @@ public:
             if (support != curr->branchSupport)
                 return false;
         }
-        return expectedSeqSupport == seqSupport;
+        return expectedSeqSupport == seqSupport && numNodes == byTip.size();
     }
 };
 
@@ -28,6 +28,9 @@
 #include <ripple/consensus/LedgerTrie.h>
 #include <ripple/protocol/PublicKey.h>
 
+#include <array>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <type_traits>
@@ -344,6 +347,37 @@ class Validations
     // Set of ledgers being acquired from the network
     hash_map<std::pair<Seq, ID>, hash_set<NodeID>> acquiring_;
 
+    /** Trusted full validations for a single ledger.
+
+        A set is immutable once published; readers hold a reference to it
+        without taking mutex_.
+    */
+    struct TrustedSet
+    {
+        std::vector<Validation> validations;
+
+        // Last time a reader looked at this set. Readers cannot touch
+        // byLedger_ themselves, so expire does it on their behalf.
+        mutable std::atomic<std::chrono::steady_clock::time_point> used;
+    };
+
+    // Number of independently locked partitions of the published sets
+    static constexpr std::size_t trustedShardCount = 16;
+
+    struct TrustedShard
+    {
+        Mutex mutex;
+        hash_map<ID, std::shared_ptr<TrustedSet const>> sets;
+    };
+
+    // Snapshots of the trusted full validations in byLedger_, replaced
+    // whenever the corresponding entry changes. The shard mutexes are only
+    // held long enough to swap or copy a pointer.
+    std::array<TrustedShard, trustedShardCount> trusted_;
+
+    // Clock used by byLedger_, read without holding mutex_
+    beast::abstract_clock<std::chrono::steady_clock>& clock_;
+
     // Parameters to determine validation staleness
     ValidationParms const parms_;
 
@@ -352,6 +386,60 @@ class Validations
     Adaptor adaptor_;
 
 private:
+    TrustedShard&
+    trustedShard(ID const& ledgerID)
+    {
+        return trusted_[beast::uhash<>{}(ledgerID) % trusted_.size()];
+    }
+
+    // Replace the published trusted set for a ledger with one reflecting
+    // the current contents of byLedger_
+    void
+    publishTrusted(std::lock_guard<Mutex> const&, ID const& ledgerID)
+    {
+        auto& shard = trustedShard(ledgerID);
+
+        auto const it = byLedger_.find(ledgerID);
+        if (it == byLedger_.end())
+        {
+            std::lock_guard sl{shard.mutex};
+            shard.sets.erase(ledgerID);
+            return;
+        }
+
+        auto set = std::make_shared<TrustedSet>();
+        set->validations.reserve(it->second.size());
+        for (auto const& [_, val] : it->second)
+        {
+            (void)_;
+            if (val.trusted() && val.full())
+                set->validations.push_back(val);
+        }
+
+        std::lock_guard sl{shard.mutex};
+        auto& published = shard.sets[ledgerID];
+        set->used = published ? published->used.load()
+                              : std::chrono::steady_clock::time_point{};
+        published = std::move(set);
+    }
+
+    // Return the published trusted set for a ledger, if any
+    std::shared_ptr<TrustedSet const>
+    trustedForLedger(ID const& ledgerID)
+    {
+        std::shared_ptr<TrustedSet const> set;
+        {
+            auto& shard = trustedShard(ledgerID);
+            std::lock_guard sl{shard.mutex};
+            auto const it = shard.sets.find(ledgerID);
+            if (it == shard.sets.end())
+                return set;
+            set = it->second;
+        }
+        set->used.store(clock_.now(), std::memory_order_relaxed);
+        return set;
+    }
+
     // Remove support of a validated ledger
     void
     removeTrie(
@@ -530,37 +618,6 @@ private:
         }
     }
 
-    /** Iterate the set of validations associated with a given ledger id
-
-        @param lock Existing lock on mutex_
-        @param ledgerID The identifier of the ledger
-        @param pre Invokable with signature(std::size_t)
-        @param f Invokable with signature (NodeID const &, Validation const &)
-
-        @note The invokable `pre` is called prior to iterating validations. The
-              argument is the number of times `f` will be called.
-        @warning The invokable f is expected to be a simple transformation of
-       its arguments and will be called with mutex_ under lock.
-    */
-    template <class Pre, class F>
-    void
-    byLedger(
-        std::lock_guard<Mutex> const&,
-        ID const& ledgerID,
-        Pre&& pre,
-        F&& f)
-    {
-        auto it = byLedger_.find(ledgerID);
-        if (it != byLedger_.end())
-        {
-            // Update set time since it is being used
-            byLedger_.touch(it);
-            pre(it->second.size());
-            for (auto const& [key, val] : it->second)
-                f(key, val);
-        }
-    }
-
 public:
     /** Constructor
 
@@ -575,6 +632,7 @@ public:
         Ts&&... ts)
         : byLedger_(c)
         , bySequence_(c)
+        , clock_(c)
         , parms_(p)
         , adaptor_(std::forward<Ts>(ts)...)
     {
@@ -679,6 +737,7 @@ public:
             }
 
             byLedger_[val.ledgerID()].insert_or_assign(nodeID, val);
+            publishTrusted(lock, val.ledgerID());
 
             auto const [it, inserted] = current_.emplace(nodeID, val);
             if (!inserted)
@@ -768,8 +827,37 @@ public:
                 }
             }
 
+            auto const now = byLedger_.clock().now();
+            for (auto& shard : trusted_)
+            {
+                std::lock_guard sl{shard.mutex};
+                for (auto const& [id, set] : shard.sets)
+                {
+                    // Refresh sets which readers used since they were last
+                    // touched, if touching them then would have kept them
+                    auto const used = set->used.load(std::memory_order_relaxed);
+                    if (now >= used + parms_.validationSET_EXPIRES)
+                        continue;
+                    if (auto it = byLedger_.find(id);
+                        it != byLedger_.end() && it.when() < used)
+                        byLedger_.touch(it);
+                }
+            }
+
             beast::expire(byLedger_, parms_.validationSET_EXPIRES);
             beast::expire(bySequence_, parms_.validationSET_EXPIRES);
+
+            for (auto& shard : trusted_)
+            {
+                std::lock_guard sl{shard.mutex};
+                for (auto it = shard.sets.begin(); it != shard.sets.end();)
+                {
+                    if (byLedger_.find(it->first) == byLedger_.end())
+                        it = shard.sets.erase(it);
+                    else
+                        ++it;
+                }
+            }
         }
         JLOG(j.debug())
             << "Validations sets sweep lock duration "
@@ -807,9 +895,8 @@ public:
             }
         }
 
-        for (auto& [_, validationMap] : byLedger_)
+        for (auto& [ledgerID, validationMap] : byLedger_)
         {
-            (void)_;
             for (auto& [nodeId, validation] : validationMap)
             {
                 if (added.find(nodeId) != added.end())
@@ -821,6 +908,7 @@ public:
                     validation.setUntrusted();
                 }
             }
+            publishTrusted(lock, ledgerID);
         }
     }
 
@@ -1033,17 +1121,8 @@ public:
     std::size_t
     numTrustedForLedger(ID const& ledgerID)
     {
-        std::size_t count = 0;
-        std::lock_guard lock{mutex_};
-        byLedger(
-            lock,
-            ledgerID,
-            [&](std::size_t) {},  // nothing to reserve
-            [&](NodeID const&, Validation const& v) {
-                if (v.trusted() && v.full())
-                    ++count;
-            });
-        return count;
+        auto const set = trustedForLedger(ledgerID);
+        return set ? set->validations.size() : 0;
     }
 
     /**  Get trusted full validations for a specific ledger
@@ -1056,16 +1135,15 @@ public:
     getTrustedForLedger(ID const& ledgerID, Seq const& seq)
     {
         std::vector<WrappedValidationType> res;
-        std::lock_guard lock{mutex_};
-        byLedger(
-            lock,
-            ledgerID,
-            [&](std::size_t numValidations) { res.reserve(numValidations); },
-            [&](NodeID const&, Validation const& v) {
-                if (v.trusted() && v.full() && v.seq() == seq)
+        if (auto const set = trustedForLedger(ledgerID))
+        {
+            res.reserve(set->validations.size());
+            for (auto const& v : set->validations)
+            {
+                if (v.seq() == seq)
                     res.emplace_back(v.unwrap());
-            });
-
+            }
+        }
         return res;
     }
 
@@ -1079,21 +1157,18 @@ public:
     fees(ID const& ledgerID, std::uint32_t baseFee)
     {
         std::vector<std::uint32_t> res;
-        std::lock_guard lock{mutex_};
-        byLedger(
-            lock,
-            ledgerID,
-            [&](std::size_t numValidations) { res.reserve(numValidations); },
-            [&](NodeID const&, Validation const& v) {
-                if (v.trusted() && v.full())
-                {
-                    std::optional<std::uint32_t> loadFee = v.loadFee();
-                    if (loadFee)
-                        res.push_back(*loadFee);
-                    else
-                        res.push_back(baseFee);
-                }
-            });
+        if (auto const set = trustedForLedger(ledgerID))
+        {
+            res.reserve(set->validations.size());
+            for (auto const& v : set->validations)
+            {
+                std::optional<std::uint32_t> loadFee = v.loadFee();
+                if (loadFee)
+                    res.push_back(*loadFee);
+                else
+                    res.push_back(baseFee);
+            }
+        }
         return res;
     }
 
@@ -22,6 +22,7 @@
 
 #include <ripple/basics/BasicConfig.h>
 #include <ripple/basics/FeeUnits.h>
+#include <ripple/basics/HugePages.h>
 #include <ripple/basics/base_uint.h>
 #include <ripple/beast/net/IPEndpoint.h>
 #include <ripple/beast/utility/Journal.h>
@@ -217,6 +218,13 @@ public:
     std::uint32_t LEDGER_HISTORY = 256;
     std::uint32_t FETCH_DEPTH = 1000000000;
 
+    // Backfilling of missing history: the number of gaps to fetch at once,
+    // the node store write load above which to pause, and the largest
+    // number of ledgers to fetch per minute (0 for no limit).
+    std::size_t HISTORY_FETCH_SEGMENTS = 1;
+    int HISTORY_MAX_WRITE_LOAD = 8192;
+    std::size_t HISTORY_MAX_FETCH_RATE = 0;
+
     // Tunable that adjusts various parameters, typically associated
     // with hardware parameters (RAM size and CPU cores). The default
     // is 'tiny'.
@@ -232,6 +240,13 @@ public:
     // Enable the experimental Ledger Replay functionality
     bool LEDGER_REPLAY = false;
 
+    // Threads used to apply consensus transactions when building a ledger.
+    // Values below 2 apply them serially.
+    std::size_t PARALLEL_APPLY_THREADS = 0;
+
+    // Build the ledger for our position before consensus is reached
+    bool SPECULATIVE_BUILD = false;
+
     // Work queue limits
     int MAX_TRANSACTIONS = 250;
     static constexpr int MAX_JOB_QUEUE_TX = 1000;
@@ -244,6 +259,15 @@ public:
     int WORKERS = 0;           // jobqueue thread count. default: upto 6
     int IO_WORKERS = 0;        // io svc thread count. default: 2
     int PREFETCH_WORKERS = 0;  // prefetch thread count. default: 4
+    int VERIFY_WORKERS = 0;    // ledger verify thread count. default: 16
+
+    // Separate io svc pools for peer and client connections (0 = share the
+    // io svc), and the CPUs each pool may run on (empty = any).
+    int OVERLAY_IO_WORKERS = 0;
+    int SERVER_IO_WORKERS = 0;
+    std::vector<unsigned> IO_AFFINITY;
+    std::vector<unsigned> OVERLAY_IO_AFFINITY;
+    std::vector<unsigned> SERVER_IO_AFFINITY;
 
     // Can only be set in code, specifically unit tests
     bool FORCE_MULTI_THREAD = false;
@@ -252,6 +276,19 @@ public:
     // size, but we allow admins to explicitly set it in the config.
     std::optional<int> SWEEP_INTERVAL;
 
+    // The memory, in megabytes, the caches may hold between them. Without
+    // it, the caches keep the target sizes deduced from the node size.
+    std::optional<std::size_t> CACHE_BUDGET;
+
+    // How slabs and SHAMap child arrays are backed by huge pages.
+    hugePages::Mode HUGE_PAGES = hugePages::Mode::transparent;
+
+    // Divide the job queue and prefetch threads between the NUMA nodes.
+    bool NUMA_SPREAD = false;
+
+    // Charge consumers for the CPU time measured doing their work.
+    bool CHARGE_MEASURED_COST = false;
+
     // Reduce-relay - these parameters are experimental.
     // Enable reduce-relay features
     // Validation/proposal reduce-relay feature
@@ -280,6 +317,13 @@ public:
     // Percentage of peers with the tx reduce-relay feature enabled
     // to relay to out of total active peers
     std::size_t TX_RELAY_PERCENTAGE = 25;
+    // If not zero, the copies of each transaction the server aims
+    // to receive. TX_RELAY_PERCENTAGE is then only the starting
+    // point, and the percentage is adjusted to approach this target.
+    std::size_t TX_TARGET_REDUNDANCY = 0;
+    // Relayed transactions are batched into TMTransactions for peers
+    // which enable the feature too.
+    bool TX_RELAY_BATCH = false;
 
     // These override the command line client settings
     std::optional<beast::IP::Endpoint> rpc_ip;
@@ -299,6 +343,14 @@ public:
 
     // First, attempt to load the latest ledger directly from disk.
     bool FAST_LOAD = false;
+    // Skip the full walk of the ledger loaded at startup and verify it in
+    // the background instead.
+    bool LAZY_LOAD = false;
+    // Keep a file of validated ledger hashes indexed by sequence.
+    bool LEDGER_HASH_INDEX = false;
+    // Save the keys of the SHAMap caches on shutdown and reload them on
+    // the next start.
+    bool CACHE_SNAPSHOT = false;
     // When starting rippled with existing database it do not know it has those
     // ledgers locally until the server naturally tries to backfill. This makes
     // is difficult to test some functionality (in particular performance
@@ -44,12 +44,20 @@ struct ConfigSection
     {
         return "import_db";
     }
+    static std::string
+    coldNodeDatabase()
+    {
+        return "node_db_cold";
+    }
 };
 
 // VFALCO TODO Rename and replace these macros with variables.
+#define SECTION_ACCOUNT_TX_INDEX "account_tx_index"
 #define SECTION_AMENDMENTS "amendments"
 #define SECTION_AMENDMENT_MAJORITY_TIME "amendment_majority_time"
 #define SECTION_BETA_RPC_API "beta_rpc_api"
+#define SECTION_BOOK_INDEX "book_index"
+#define SECTION_CACHE_BUDGET "cache_budget"
 #define SECTION_CLUSTER_NODES "cluster_nodes"
 #define SECTION_COMPRESSION "compression"
 #define SECTION_DEBUG_LOGFILE "debug_logfile"
@@ -57,18 +65,25 @@ struct ConfigSection
 #define SECTION_FEE_DEFAULT "fee_default"
 #define SECTION_FETCH_DEPTH "fetch_depth"
 #define SECTION_HISTORICAL_SHARD_PATHS "historical_shard_paths"
+#define SECTION_HISTORY_FETCH "history_fetch"
+#define SECTION_HUGE_PAGES "huge_pages"
 #define SECTION_INSIGHT "insight"
+#define SECTION_IO_POOLS "io_pools"
 #define SECTION_IO_WORKERS "io_workers"
 #define SECTION_IPS "ips"
 #define SECTION_IPS_FIXED "ips_fixed"
 #define SECTION_LEDGER_HISTORY "ledger_history"
 #define SECTION_LEDGER_REPLAY "ledger_replay"
 #define SECTION_MAX_TRANSACTIONS "max_transactions"
+#define SECTION_MEASURED_COST "measured_cost"
 #define SECTION_NETWORK_ID "network_id"
 #define SECTION_NETWORK_QUORUM "network_quorum"
 #define SECTION_NODE_SEED "node_seed"
 #define SECTION_NODE_SIZE "node_size"
+#define SECTION_NUMA "numa"
+#define SECTION_OBLIGATIONS_INDEX "obligations_index"
 #define SECTION_OVERLAY "overlay"
+#define SECTION_PARALLEL_APPLY "parallel_apply"
 #define SECTION_PATH_SEARCH_OLD "path_search_old"
 #define SECTION_PATH_SEARCH "path_search"
 #define SECTION_PATH_SEARCH_FAST "path_search_fast"
@@ -83,14 +98,17 @@ struct ConfigSection
 #define SECTION_RELATIONAL_DB "relational_db"
 #define SECTION_RELAY_PROPOSALS "relay_proposals"
 #define SECTION_RELAY_VALIDATIONS "relay_validations"
+#define SECTION_RPC_RESPONSE_CACHE "rpc_response_cache"
 #define SECTION_RPC_STARTUP "rpc_startup"
 #define SECTION_SIGNING_SUPPORT "signing_support"
 #define SECTION_SNTP "sntp_servers"
+#define SECTION_SPECULATIVE_BUILD "speculative_build"
 #define SECTION_SSL_VERIFY "ssl_verify"
 #define SECTION_SSL_VERIFY_FILE "ssl_verify_file"
 #define SECTION_SSL_VERIFY_DIR "ssl_verify_dir"
 #define SECTION_SERVER_DOMAIN "server_domain"
 #define SECTION_SWEEP_INTERVAL "sweep_interval"
+#define SECTION_TX_INDEX "tx_index"
 #define SECTION_VALIDATORS_FILE "validators_file"
 #define SECTION_VALIDATION_SEED "validation_seed"
 #define SECTION_VALIDATOR_KEYS "validator_keys"
@@ -99,6 +117,7 @@ struct ConfigSection
 #define SECTION_VALIDATOR_LIST_SITES "validator_list_sites"
 #define SECTION_VALIDATORS "validators"
 #define SECTION_VALIDATOR_TOKEN "validator_token"
+#define SECTION_VERIFY_WORKERS "verify_workers"
 #define SECTION_VETO_AMENDMENTS "veto_amendments"
 #define SECTION_WORKERS "workers"
 
@@ -61,7 +61,7 @@ inline void
 JobQueue::Coro::yield() const
 {
     {
-        std::lock_guard lock(jq_.m_mutex);
+        auto const lock = jq_.lockProfiled();
         ++jq_.nSuspend_;
     }
     (*yield_)();
@@ -97,7 +97,7 @@ JobQueue::Coro::resume()
         running_ = true;
     }
     {
-        std::lock_guard lock(jq_.m_mutex);
+        auto const lock = jq_.lockProfiled();
         --jq_.nSuspend_;
     }
     auto saved = detail::getLocalValues().release();
@@ -24,9 +24,12 @@
 #include <ripple/core/Config.h>
 #include <ripple/core/SociDB.h>
 #include <boost/filesystem/path.hpp>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace soci {
 class session;
@@ -78,6 +81,45 @@ public:
     }
 };
 
+/** A session checked out for reading, with its prepared statements. */
+class LockedSQLiteReader
+{
+public:
+    using mutex = LockedSociSession::mutex;
+
+private:
+    soci::session* session_;
+    SQLiteStatements* statements_;
+    std::unique_lock<mutex> lock_;
+
+public:
+    LockedSQLiteReader(
+        soci::session& session,
+        SQLiteStatements& statements,
+        std::unique_lock<mutex> lock)
+        : session_(&session), statements_(&statements), lock_(std::move(lock))
+    {
+    }
+
+    soci::session&
+    session()
+    {
+        return *session_;
+    }
+
+    soci::session&
+    operator*()
+    {
+        return *session_;
+    }
+
+    SQLiteStatements&
+    statements()
+    {
+        return *statements_;
+    }
+};
+
 class DatabaseCon
 {
 public:
@@ -180,6 +222,27 @@ public:
         return LockedSociSession(session_, lock_);
     }
 
+    /** Open read-only connections for checkoutReader to hand out.
+
+        Readers are only opened for a database file which uses a
+        write-ahead log, so that they neither block nor are blocked by the
+        writer. Must be called before the database is used concurrently.
+
+        @param count The number of connections to open.
+        @param pragma Statements to run on each new connection.
+        @return The number of connections opened.
+    */
+    std::size_t
+    openReaders(std::size_t count, std::vector<std::string> const& pragma);
+
+    /** Check out a session for read-only queries.
+
+        Queries on different readers run concurrently. Without readers,
+        this locks the main session, like checkoutDb.
+    */
+    LockedSQLiteReader
+    checkoutReader();
+
 private:
     void
     setupCheckpointing(JobQueue*, Logs&);
@@ -190,9 +253,9 @@ private:
         std::vector<std::string> const* commonPragma,
         std::array<char const*, N> const& pragma,
         std::array<char const*, M> const& initSQL)
-        : session_(std::make_shared<soci::session>())
+        : path_(pPath.string()), session_(std::make_shared<soci::session>())
     {
-        open(*session_, "sqlite", pPath.string());
+        open(*session_, "sqlite", path_);
 
         if (commonPragma)
         {
@@ -214,6 +277,16 @@ private:
         }
     }
 
+    struct Reader
+    {
+        LockedSQLiteReader::mutex mutex;
+        soci::session session;
+        std::unique_ptr<SQLiteStatements> statements;
+    };
+
+    // Empty for a temporary database.
+    std::string const path_;
+
     LockedSociSession::mutex lock_;
 
     // checkpointer may outlive the DatabaseCon when the checkpointer jobQueue
@@ -224,6 +297,13 @@ private:
     // shared_ptr in this class. session_ will never be null.
     std::shared_ptr<soci::session> const session_;
     std::shared_ptr<Checkpointer> checkpointer_;
+
+    // Prepared statements for readers checked out of session_, guarded by
+    // lock_. Declared after session_ so they are finalized before it closes.
+    std::unique_ptr<SQLiteStatements> statements_;
+
+    std::vector<std::unique_ptr<Reader>> readers_;
+    std::atomic<std::size_t> nextReader_{0};
 };
 
 // Return the checkpointer from its id. If the checkpointer no longer exists, an
@@ -55,6 +55,7 @@ enum JobType {
     jtVALIDATION_ut,      // A validation from an untrusted source
     jtMANIFEST,           // A validator's manifest
     jtUPDATE_PF,          // Update pathfinding requests
+    jtPATH_UPDATE,        // Help update pathfinding requests
     jtTRANSACTION_l,      // A local transaction
     jtREPLAY_REQ,         // Peer request a ledger delta or a skip list
     jtLEDGER_REQ,         // Peer request ledger/txnset data
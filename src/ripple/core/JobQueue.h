@@ -145,7 +145,8 @@ public:
         beast::insight::Collector::ptr const& collector,
         beast::Journal journal,
         Logs& logs,
-        perf::PerfLog& perfLog);
+        perf::PerfLog& perfLog,
+        bool numaSpread = false);
     ~JobQueue();
 
     /** Adds a job to the JobQueue.
@@ -201,6 +202,16 @@ public:
     int
     getJobCountGE(JobType t) const;
 
+    /** The distribution of the time jobs of this type waited to run.
+     */
+    LatencyHistogram const&
+    getQueueLatency(JobType t) const;
+
+    /** How long the oldest waiting job of this type has waited, or zero.
+     */
+    std::chrono::microseconds
+    getQueueAge(JobType t) const;
+
     /** Return a scoped LoadEvent.
      */
     std::unique_ptr<LoadEvent>
@@ -245,7 +256,12 @@ private:
     beast::Journal m_journal;
     mutable std::mutex m_mutex;
     std::uint64_t m_lastJob;
-    std::set<Job> m_jobSet;
+
+    // Waiting jobs are kept in a FIFO queue per job type. Bit n of
+    // m_pending is set while jobs of type n are waiting, so the highest
+    // priority type with work can be found without scanning every job.
+    std::uint64_t m_pending = 0;
+    std::size_t m_jobCount = 0;
     JobCounter jobCounter_;
     std::atomic_bool stopping_{false};
     std::atomic_bool stopped_{false};
@@ -273,6 +289,10 @@ private:
     JobTypeData&
     getJobTypeData(JobType type);
 
+    // Locks m_mutex, logging any wait for another thread to release it.
+    std::unique_lock<std::mutex>
+    lockProfiled() const;
+
     // Adds a reference counted job to the JobQueue.
     //
     //    param type The type of job.
@@ -310,7 +330,7 @@ private:
     // Indicates that a running Job has completed its task.
     //
     // Pre-conditions:
-    //  Job must not exist in mJobSet.
+    //  Job must not be in the queue of its type.
     //  The JobType must not be invalid.
     //
     // Post-conditions:
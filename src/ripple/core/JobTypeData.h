@@ -20,9 +20,12 @@
 #ifndef RIPPLE_CORE_JOBTYPEDATA_H_INCLUDED
 #define RIPPLE_CORE_JOBTYPEDATA_H_INCLUDED
 
+#include <ripple/basics/LatencyHistogram.h>
 #include <ripple/basics/Log.h>
 #include <ripple/beast/insight/Collector.h>
+#include <ripple/core/Job.h>
 #include <ripple/core/JobTypeInfo.h>
+#include <deque>
 
 namespace ripple {
 
@@ -47,6 +50,12 @@ public:
     /* And the number we deferred executing because of job limits */
     int deferred;
 
+    /* The jobs waiting, oldest first */
+    std::deque<Job> queue;
+
+    /* How long jobs waited in the queue before running */
+    LatencyHistogram queued;
+
     /* Notification callbacks */
     beast::insight::Event dequeue;
     beast::insight::Event execute;
@@ -89,6 +89,7 @@ private:
         add(jtCLIENT_WEBSOCKET,  "clientWebsocket",      maxLimit,  2000ms,  5000ms);
         add(jtRPC,               "RPC",                  maxLimit,     0ms,     0ms);
         add(jtUPDATE_PF,         "updatePaths",                 1,     0ms,     0ms);
+        add(jtPATH_UPDATE,       "updatePathRequests",          4,     0ms,     0ms);
         add(jtTRANSACTION,       "transaction",          maxLimit,   250ms,  1000ms);
         add(jtBATCH,             "batch",                maxLimit,   250ms,  1000ms);
         add(jtADVANCE,           "advanceLedger",        maxLimit,     0ms,     0ms);
@@ -99,7 +100,7 @@ private:
         add(jtWRITE,             "writeObjects",         maxLimit,  1750ms,  2500ms);
         add(jtACCEPT,            "acceptLedger",         maxLimit,     0ms,     0ms);
         add(jtPROPOSAL_t,        "trustedProposal",      maxLimit,   100ms,   500ms);
-        add(jtSWEEP,             "sweep",                       1,     0ms,     0ms);
+        add(jtSWEEP,             "sweep",                       4,     0ms,     0ms);
         add(jtNETOP_CLUSTER,     "clusterReport",               1,  9999ms,  9999ms);
         add(jtNETOP_TIMER,       "heartbeat",                   1,   999ms,   999ms);
         add(jtADMIN,             "administration",       maxLimit,     0ms,     0ms);
@@ -0,0 +1,169 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_CORE_PARALLELFOR_H_INCLUDED
+#define RIPPLE_CORE_PARALLELFOR_H_INCLUDED
+
+#include <ripple/core/JobQueue.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace ripple {
+
+/** Call a function for every index in [0, count), using several threads.
+
+    The calls are shared out between the calling thread and up to `helpers`
+    jobs of the given type. The calling thread never waits for a job to be
+    dispatched: once every index has been taken it only waits for the jobs
+    that are already working, and a job which starts after that returns
+    straight away. This makes it safe to call from a job, however busy the
+    job queue is.
+
+    If a call throws, no further calls are started and the exception is
+    rethrown on the calling thread once the other calls have finished.
+
+    @param work Called with each index. Returning false stops the calls for
+                the indexes which haven't been started yet.
+    @return false if the work was stopped, true otherwise.
+*/
+inline bool
+parallelFor(
+    JobQueue& jobQueue,
+    JobType type,
+    std::string const& name,
+    std::size_t count,
+    std::size_t helpers,
+    std::function<bool(std::size_t)> const& work)
+{
+    struct State
+    {
+        std::function<bool(std::size_t)> const& work;
+        std::size_t const count;
+
+        std::atomic<std::size_t> next = 0;
+        std::atomic<bool> stopped = false;
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        int active = 0;
+        bool finished = false;
+        std::exception_ptr error;
+
+        State(std::function<bool(std::size_t)> const& w, std::size_t c)
+            : work(w), count(c)
+        {
+        }
+
+        void
+        run()
+        {
+            try
+            {
+                while (!stopped)
+                {
+                    auto const index = next++;
+                    if (index >= count)
+                        break;
+                    if (!work(index))
+                        stopped = true;
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard lock(mutex);
+                if (!error)
+                    error = std::current_exception();
+                stopped = true;
+            }
+        }
+    };
+
+    auto state = std::make_shared<State>(work, count);
+
+    helpers = std::min(helpers, count > 1 ? count - 1 : 0);
+    for (std::size_t i = 0; i < helpers; ++i)
+    {
+        jobQueue.addJob(type, name, [state]() {
+            {
+                std::lock_guard lock(state->mutex);
+                // The work may have been completed without this job
+                if (state->finished)
+                    return;
+                ++state->active;
+            }
+            state->run();
+            std::lock_guard lock(state->mutex);
+            if (--state->active == 0)
+                state->cv.notify_all();
+        });
+    }
+
+    state->run();
+
+    std::unique_lock lock(state->mutex);
+    state->finished = true;
+    state->cv.wait(lock, [&state] { return state->active == 0; });
+
+    if (state->error)
+        std::rethrow_exception(state->error);
+    return !state->stopped;
+}
+
+/** How many indexes are worth a thread of their own.
+
+    Splitting cheap work too finely costs more in dispatch than it saves.
+*/
+struct ParallelGrain
+{
+    std::size_t size = 16;
+};
+
+/** Call a function for every index in [0, count), using a thread for
+    every `grain.size` indexes, up to the number of hardware threads.
+
+    @see parallelFor above.
+*/
+inline bool
+parallelFor(
+    JobQueue& jobQueue,
+    JobType type,
+    std::string const& name,
+    std::size_t count,
+    ParallelGrain grain,
+    std::function<bool(std::size_t)> const& work)
+{
+    auto const threads = std::min<std::size_t>(
+        std::max(std::thread::hardware_concurrency(), 1u),
+        count / std::max<std::size_t>(grain.size, 1));
+
+    return parallelFor(
+        jobQueue, type, name, count, threads > 1 ? threads - 1 : 0, work);
+}
+
+}  // namespace ripple
+
+#endif
@@ -90,11 +90,13 @@ Pg::connect()
         // Nothing to do if we already have a good connection.
         if (PQstatus(conn_.get()) == CONNECTION_OK)
             return;
-        /* Try resetting connection. */
+        /* Try resetting connection, which drops prepared statements. */
         PQreset(conn_.get());
+        prepared_.clear();
     }
     else  // Make new connection.
     {
+        prepared_.clear();
         conn_.reset(PQconnectdbParams(
             reinterpret_cast<char const* const*>(&config_.keywordsIdx[0]),
             reinterpret_cast<char const* const*>(&config_.valuesIdx[0]),
@@ -167,6 +169,12 @@ Pg::query(char const* command, std::size_t nParams, char const* const* values)
         }
     }
 
+    return checkResult(std::move(ret));
+}
+
+PgResult
+Pg::checkResult(pg_result_type&& ret)
+{
     // Ensure proper query execution.
     switch (PQresultStatus(ret.get()))
     {
@@ -238,13 +246,188 @@ Pg::query(pg_params const& dbParams)
             : nullptr);
 }
 
+PgResult
+Pg::queryPrepared(char const* name, pg_params const& dbParams)
+{
+    auto const formattedParams = formatParams(dbParams, j_);
+    auto const values = formattedParams.size()
+        ? reinterpret_cast<char const* const*>(&formattedParams[0])
+        : nullptr;
+
+    // The result object must be freed using the libpq API PQclear() call.
+    pg_result_type ret{nullptr, [](PGresult* result) { PQclear(result); }};
+    // Connect, prepare if needed, then submit query.
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stop_)
+                return PgResult();
+        }
+        try
+        {
+            connect();
+            if (!prepared_.count(name))
+            {
+                ret.reset(PQprepare(
+                    conn_.get(),
+                    name,
+                    dbParams.first,
+                    formattedParams.size(),
+                    nullptr));
+                if (!ret)
+                    Throw<std::runtime_error>("no result structure returned");
+                if (PQresultStatus(ret.get()) != PGRES_COMMAND_OK)
+                {
+                    JLOG(j_.error()) << "error preparing " << name << ": "
+                                     << PQerrorMessage(conn_.get());
+                    return PgResult(ret.get(), conn_.get());
+                }
+                prepared_.emplace(name);
+            }
+            ret.reset(PQexecPrepared(
+                conn_.get(),
+                name,
+                formattedParams.size(),
+                values,
+                nullptr,
+                nullptr,
+                0));
+            if (!ret)
+                Throw<std::runtime_error>("no result structure returned");
+            break;
+        }
+        catch (std::exception const& e)
+        {
+            // Sever connection and retry until successful.
+            disconnect();
+            JLOG(j_.error()) << "database error, retrying: " << e.what();
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+    }
+
+    return checkResult(std::move(ret));
+}
+
+std::vector<PgResult>
+Pg::pipeline(std::vector<pg_params> const& queries)
+{
+    std::vector<PgResult> results;
+    results.reserve(queries.size());
+#ifdef LIBPQ_HAS_PIPELINING
+    // https://www.postgresql.org/docs/14/libpq-pipeline-mode.html
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stop_)
+                return std::vector<PgResult>(queries.size());
+        }
+        try
+        {
+            connect();
+            if (PQenterPipelineMode(conn_.get()) != 1)
+                Throw<std::runtime_error>("unable to enter pipeline mode");
+            for (auto const& dbParams : queries)
+            {
+                auto const formattedParams = formatParams(dbParams, j_);
+                if (PQsendQueryParams(
+                        conn_.get(),
+                        dbParams.first,
+                        formattedParams.size(),
+                        nullptr,
+                        formattedParams.size()
+                            ? reinterpret_cast<char const* const*>(
+                                  &formattedParams[0])
+                            : nullptr,
+                        nullptr,
+                        nullptr,
+                        0) != 1)
+                    Throw<std::runtime_error>(PQerrorMessage(conn_.get()));
+            }
+            if (PQpipelineSync(conn_.get()) != 1)
+                Throw<std::runtime_error>(PQerrorMessage(conn_.get()));
+            break;
+        }
+        catch (std::exception const& e)
+        {
+            // Sever connection and retry until successful.
+            disconnect();
+            JLOG(j_.error()) << "database error, retrying: " << e.what();
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+    }
+
+    // Each query returns its result followed by a null pointer. Queries
+    // following a failed one return PGRES_PIPELINE_ABORTED. The pipeline
+    // ends with the result of the synchronization point.
+    bool ok = true;
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        pg_result_type ret{PQgetResult(conn_.get()), [](PGresult* result) {
+                               PQclear(result);
+                           }};
+        if (!ret)
+        {
+            JLOG(j_.error()) << "pipeline ended early: "
+                             << PQerrorMessage(conn_.get());
+            ok = false;
+            break;
+        }
+        while (PGresult* end = PQgetResult(conn_.get()))
+            PQclear(end);
+
+        switch (PQresultStatus(ret.get()))
+        {
+            case PGRES_TUPLES_OK:
+            case PGRES_COMMAND_OK:
+                results.emplace_back(std::move(ret));
+                break;
+            default:
+                JLOG(j_.error()) << "bad pipeline query result: "
+                                 << PQresStatus(PQresultStatus(ret.get()))
+                                 << " error message: "
+                                 << PQerrorMessage(conn_.get());
+                results.emplace_back(ret.get(), conn_.get());
+                ok = false;
+        }
+    }
+    if (ok)
+    {
+        pg_result_type sync{PQgetResult(conn_.get()), [](PGresult* result) {
+                                PQclear(result);
+                            }};
+        ok = PQresultStatus(sync.get()) == PGRES_PIPELINE_SYNC &&
+            PQexitPipelineMode(conn_.get()) == 1;
+    }
+    // As with single queries, don't reuse a connection after an error.
+    if (!ok)
+        disconnect();
+    results.resize(queries.size());
+#else
+    for (auto const& dbParams : queries)
+    {
+        if (!results.empty() && !results.back())
+        {
+            results.emplace_back();
+            continue;
+        }
+        results.push_back(query(dbParams));
+    }
+#endif
+    return results;
+}
+
 void
-Pg::bulkInsert(char const* table, std::string const& records)
+Pg::bulkInsert(char const* table, std::string const& records, bool binary)
 {
     // https://www.postgresql.org/docs/12/libpq-copy.html#LIBPQ-COPY-SEND
     assert(conn_.get());
     static auto copyCmd = boost::format(R"(COPY %s FROM stdin)");
-    auto res = query(boost::str(copyCmd % table).c_str());
+    static auto binaryCopyCmd =
+        boost::format(R"(COPY %s FROM stdin WITH (FORMAT binary))");
+    auto res = query(
+        boost::str((binary ? binaryCopyCmd : copyCmd) % table).c_str());
     if (!res || res.status() != PGRES_COPY_IN)
     {
         std::stringstream ss;
@@ -26,14 +26,17 @@
 #include <ripple/protocol/Protocol.h>
 #include <boost/lexical_cast.hpp>
 #include <atomic>
+#include <cassert>
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <libpq-fe.h>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -247,6 +250,79 @@ public:
     }
 };
 
+/** Records for Postgres' bulk COPY in the binary format.
+ *
+ * The binary format avoids converting integers to text and byte arrays to
+ * escaped hex, on both the client and the server. Each field of a row must
+ * match the type of the corresponding column exactly.
+ *
+ * https://www.postgresql.org/docs/12/sql-copy.html#id-1.9.3.55.9.4
+ */
+class PgCopyBinary
+{
+    std::string buf_;
+    bool finished_ = false;
+
+    template <class Int>
+    void
+    append(Int value)
+    {
+        for (int i = sizeof(Int) - 1; i >= 0; --i)
+            buf_.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+    }
+
+public:
+    PgCopyBinary()
+    {
+        // Signature, then 32 bit flags and header extension length
+        static char const header[] = "PGCOPY\n\377\r\n\0";
+        buf_.append(header, sizeof(header) - 1);
+        append(std::int32_t{0});
+        append(std::int32_t{0});
+    }
+
+    /** Start a new row.
+     *
+     * @param fields Number of fields the row holds.
+     */
+    void
+    row(std::int16_t fields)
+    {
+        assert(!finished_);
+        append(fields);
+    }
+
+    /** Add a field for a bigint column. */
+    void
+    bigint(std::int64_t value)
+    {
+        append(std::int32_t{sizeof(value)});
+        append(value);
+    }
+
+    /** Add a field for a bytea column. */
+    void
+    bytea(void const* data, std::size_t size)
+    {
+        append(static_cast<std::int32_t>(size));
+        buf_.append(static_cast<char const*>(data), size);
+    }
+
+    /** Return the records, ending them on the first call. */
+    std::string const&
+    finish()
+    {
+        if (!finished_)
+        {
+            append(std::int16_t{-1});
+            finished_ = true;
+        }
+        return buf_;
+    }
+};
+
+//-----------------------------------------------------------------------------
+
 /* Class that contains and operates upon a postgres connection. */
 class Pg
 {
@@ -261,6 +337,9 @@ class Pg
     // The connection object must be freed using the libpq API PQfinish() call.
     pg_connection_type conn_{nullptr, [](PGconn* conn) { PQfinish(conn); }};
 
+    // Names of the statements prepared on the current connection.
+    std::unordered_set<std::string> prepared_;
+
     /** Clear results from the connection.
      *
      * Results from previous commands must be cleared before new commands
@@ -287,8 +366,19 @@ class Pg
     disconnect()
     {
         conn_.reset();
+        prepared_.clear();
     }
 
+    /** Check the status of a query result.
+     *
+     * Disconnects if the query failed.
+     *
+     * @param result Result returned by the postgres API.
+     * @return Query result object.
+     */
+    PgResult
+    checkResult(pg_result_type&& result);
+
     /** Execute postgres query.
      *
      * If parameters are included, then the command should contain only a
@@ -323,15 +413,44 @@ class Pg
     PgResult
     query(pg_params const& dbParams);
 
+    /** Execute a prepared statement with parameters.
+     *
+     * The statement is prepared the first time it is used on each
+     * connection, which saves the server from parsing and planning it
+     * again on later calls.
+     *
+     * @param name Name of the prepared statement.
+     * @param dbParams Database command and parameter values.
+     * @return Query result object.
+     */
+    PgResult
+    queryPrepared(char const* name, pg_params const& dbParams);
+
+    /** Execute several queries with a single round trip.
+     *
+     * Uses the pipeline mode of libpq when available, and executes the
+     * queries one after the other otherwise. Queries following a failed
+     * one are not executed and return an error.
+     *
+     * @param queries Database commands and parameter values.
+     * @return Query result objects, one for each query.
+     */
+    std::vector<PgResult>
+    pipeline(std::vector<pg_params> const& queries);
+
     /** Insert multiple records into a table using Postgres' bulk COPY.
      *
      * Throws upon error.
      *
      * @param table Name of table for import.
      * @param records Records in the COPY IN format.
+     * @param binary Whether the records are in the binary format.
      */
     void
-    bulkInsert(char const* table, std::string const& records);
+    bulkInsert(
+        char const* table,
+        std::string const& records,
+        bool binary = false);
 
 public:
     /** Constructor for Pg class.
@@ -479,6 +598,33 @@ public:
         return operator()(pg_params{command, {}});
     }
 
+    /** Execute a prepared statement with parameters.
+     *
+     * @param name Name of the prepared statement.
+     * @param dbParams Database command with parameters.
+     * @return Result of query, including errors.
+     */
+    PgResult
+    operator()(char const* name, pg_params const& dbParams)
+    {
+        if (!pg_)  // It means we're stopping. Return empty result.
+            return PgResult();
+        return pg_->queryPrepared(name, dbParams);
+    }
+
+    /** Execute several queries with a single round trip.
+     *
+     * @param queries Database commands with parameters.
+     * @return Results of the queries, including errors.
+     */
+    std::vector<PgResult>
+    pipeline(std::vector<pg_params> const& queries)
+    {
+        if (!pg_)  // It means we're stopping. Return empty results.
+            return std::vector<PgResult>(queries.size());
+        return pg_->pipeline(queries);
+    }
+
     /** Insert multiple records into a table using Postgres' bulk COPY.
      *
      * Throws upon error.
@@ -491,6 +637,19 @@ public:
     {
         pg_->bulkInsert(table, records);
     }
+
+    /** Insert multiple records into a table using Postgres' binary COPY.
+     *
+     * Throws upon error.
+     *
+     * @param table Name of table for import.
+     * @param records Records in the binary COPY format.
+     */
+    void
+    bulkInsert(char const* table, PgCopyBinary& records)
+    {
+        pg_->bulkInsert(table, records.finish(), true);
+    }
 };
 
 //-----------------------------------------------------------------------------
@@ -39,10 +39,12 @@
 #include <cstdint>
 #include <soci/soci.h>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace sqlite_api {
 struct sqlite3;
+struct sqlite3_stmt;
 }
 
 namespace ripple {
@@ -111,6 +113,83 @@ convert(std::vector<std::uint8_t> const& from, soci::blob& to);
 void
 convert(std::string const& from, soci::blob& to);
 
+/** Prepared statements for one SQLite session, kept for reuse.
+
+    Hot queries use these instead of soci: a statement is compiled once,
+    on first use, and its results are read straight from SQLite without
+    soci's intermediate buffers. Like its session, a cache may only be used
+    by one thread at a time, and must be destroyed before the session is.
+*/
+class SQLiteStatements
+{
+public:
+    /** A statement checked out of the cache.
+
+        The statement is reset, and its bindings cleared, when the handle
+        is destroyed. Only one handle to each statement may exist at once.
+    */
+    class Statement
+    {
+        sqlite_api::sqlite3_stmt* stmt_;
+
+    public:
+        explicit Statement(sqlite_api::sqlite3_stmt* stmt) : stmt_(stmt)
+        {
+        }
+
+        Statement(Statement&& other) noexcept;
+
+        Statement&
+        operator=(Statement&&) = delete;
+
+        ~Statement();
+
+        /** Bind a parameter. Parameters are numbered from 1. */
+        void
+        bind(int index, std::int64_t value);
+        void
+        bind(int index, std::string const& value);
+
+        /** Step to the next row.
+
+            @return `false` once there are no more rows.
+            @throws std::runtime_error if the query fails.
+        */
+        bool
+        step();
+
+        /** Read a column of the current row. Columns are numbered from 0.
+
+            Null columns read as zero or empty.
+        */
+        std::int64_t
+        getInt(int column) const;
+        std::string
+        getText(int column) const;
+        void
+        getBlob(int column, std::vector<std::uint8_t>& to) const;
+    };
+
+    explicit SQLiteStatements(soci::session& session);
+
+    ~SQLiteStatements();
+
+    SQLiteStatements(SQLiteStatements const&) = delete;
+    SQLiteStatements&
+    operator=(SQLiteStatements const&) = delete;
+
+    /** Returns the statement for some SQL, compiling it on first use.
+
+        @throws std::runtime_error if the SQL does not compile.
+    */
+    Statement
+    get(std::string const& sql);
+
+private:
+    sqlite_api::sqlite3* const db_;
+    std::unordered_map<std::string, sqlite_api::sqlite3_stmt*> statements_;
+};
+
 class Checkpointer : public std::enable_shared_from_this<Checkpointer>
 {
 public:
@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#ifndef RIPPLE_CORE_TIMEOUTWHEEL_H_INCLUDED
+#define RIPPLE_CORE_TIMEOUTWHEEL_H_INCLUDED
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace ripple {
+
+/** Runs handlers after a delay, sharing one timer between all of them.
+
+    Acquisitions of ledgers and transaction sets each wait on a timeout
+    which is re-armed every time it expires. With thousands of them in
+    flight, giving each its own asio timer means a steady churn through
+    the io_service's timer queue. Here they are instead kept in a wheel of
+    slots, one per tick, and a single timer advances the wheel. The
+    handlers that expire in a tick are called together on the io_service.
+
+    Handlers run up to one tick late, and are never cancelled: a handler
+    which may outlive its owner should hold a weak pointer and check it.
+    The timer only runs while handlers are waiting.
+*/
+class TimeoutWheel
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    /** Create a wheel.
+
+        @param io_service The io_service to run the handlers on.
+        @param tick The resolution of the wheel.
+    */
+    explicit TimeoutWheel(
+        boost::asio::io_service& io_service,
+        std::chrono::milliseconds tick = defaultTick);
+
+    ~TimeoutWheel();
+
+    /** Call a handler once, after a delay. */
+    void
+    schedule(std::chrono::milliseconds delay, std::function<void()> handler);
+
+    /** Stop the timer and drop the waiting handlers without calling them.
+
+        Later calls to schedule are ignored.
+    */
+    void
+    stop();
+
+    /** Return the number of handlers waiting. */
+    std::size_t
+    size() const;
+
+    /** The default resolution of the wheel. */
+    static constexpr std::chrono::milliseconds defaultTick{25};
+
+private:
+    struct Entry
+    {
+        // The tick after which the handler is due
+        std::uint64_t due;
+        std::function<void()> handler;
+    };
+
+    // A handler further away than the wheel spans stays in its slot for
+    // more than one turn, so this only needs to cover common delays.
+    static constexpr std::size_t slotCount = 1024;
+
+    std::uint64_t
+    ticksSinceStart(clock_type::time_point when) const;
+
+    void
+    arm(std::lock_guard<std::mutex> const&);
+
+    void
+    onTimer(boost::system::error_code const& ec);
+
+    std::chrono::milliseconds const tick_;
+    clock_type::time_point const start_;
+
+    std::mutex mutable mutex_;
+    boost::asio::steady_timer timer_;
+    std::array<std::vector<Entry>, slotCount> slots_;
+    // Every tick up to and including this one has been processed
+    std::uint64_t current_;
+    std::size_t size_ = 0;
+    bool armed_ = false;
+    bool stopped_ = false;
+};
+
+}  // namespace ripple
+
+#endif
@@ -19,6 +19,7 @@
 
 #include <ripple/basics/FileUtilities.h>
 #include <ripple/basics/Log.h>
+#include <ripple/basics/Numa.h>
 #include <ripple/basics/StringUtilities.h>
 #include <ripple/basics/contract.h>
 #include <ripple/beast/core/LexicalCast.h>
@@ -419,6 +420,9 @@ Config::setup(
 
     Section& nodeDbSection{section(ConfigSection::nodeDatabase())};
     get_if_exists(nodeDbSection, "fast_load", FAST_LOAD);
+    get_if_exists(nodeDbSection, "lazy_load", LAZY_LOAD);
+    get_if_exists(nodeDbSection, "hash_index", LEDGER_HASH_INDEX);
+    get_if_exists(nodeDbSection, "cache_snapshot", CACHE_SNAPSHOT);
 }
 
 void
@@ -574,6 +578,9 @@ Config::loadFromString(std::string const& fileContents)
     if (getSingleSection(secConfig, SECTION_SSL_VERIFY, strTemp, j_))
         SSL_VERIFY = beast::lexicalCastThrow<bool>(strTemp);
 
+    if (getSingleSection(secConfig, SECTION_MEASURED_COST, strTemp, j_))
+        CHARGE_MEASURED_COST = beast::lexicalCastThrow<bool>(strTemp);
+
     if (getSingleSection(secConfig, SECTION_RELAY_VALIDATIONS, strTemp, j_))
     {
         if (boost::iequals(strTemp, "all"))
@@ -641,6 +648,23 @@ Config::loadFromString(std::string const& fileContents)
             FETCH_DEPTH = 10;
     }
 
+    if (exists(SECTION_HISTORY_FETCH))
+    {
+        auto const sec = section(SECTION_HISTORY_FETCH);
+        HISTORY_FETCH_SEGMENTS =
+            sec.value_or("segments", HISTORY_FETCH_SEGMENTS);
+        HISTORY_MAX_WRITE_LOAD =
+            sec.value_or("max_write_load", HISTORY_MAX_WRITE_LOAD);
+        HISTORY_MAX_FETCH_RATE =
+            sec.value_or("max_fetch_rate", HISTORY_MAX_FETCH_RATE);
+        if (HISTORY_FETCH_SEGMENTS < 1 || HISTORY_FETCH_SEGMENTS > 16 ||
+            HISTORY_MAX_WRITE_LOAD < 1)
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_HISTORY_FETCH
+                ", segments must be between 1 and 16 inclusive"
+                ", max_write_load must be greater than 0");
+    }
+
     // By default, validators don't have pathfinding enabled, unless it is
     // explicitly requested by the server's admin.
     if (exists(SECTION_VALIDATION_SEED) || exists(SECTION_VALIDATOR_TOKEN))
@@ -667,6 +691,37 @@ Config::loadFromString(std::string const& fileContents)
                                       ": must be between 10 and 600 inclusive");
     }
 
+    if (getSingleSection(secConfig, SECTION_CACHE_BUDGET, strTemp, j_))
+    {
+        CACHE_BUDGET = beast::lexicalCastThrow<std::size_t>(strTemp);
+
+        if (*CACHE_BUDGET < 64 || *CACHE_BUDGET > 1024 * 1024)
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_CACHE_BUDGET
+                ": must be between 64 and 1048576 megabytes inclusive.");
+    }
+
+    if (getSingleSection(secConfig, SECTION_HUGE_PAGES, strTemp, j_))
+    {
+        auto const mode = hugePages::parseMode(strTemp);
+        if (!mode)
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_HUGE_PAGES
+                ": must be off, transparent or explicit.");
+        HUGE_PAGES = *mode;
+    }
+
+    if (getSingleSection(secConfig, SECTION_NUMA, strTemp, j_))
+    {
+        if (strTemp == "spread")
+            NUMA_SPREAD = true;
+        else if (strTemp == "off")
+            NUMA_SPREAD = false;
+        else
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_NUMA ": must be off or spread.");
+    }
+
     if (getSingleSection(secConfig, SECTION_WORKERS, strTemp, j_))
     {
         WORKERS = beast::lexicalCastThrow<int>(strTemp);
@@ -687,6 +742,76 @@ Config::loadFromString(std::string const& fileContents)
                 ": must be between 1 and 1024 inclusive.");
     }
 
+    if (exists(SECTION_IO_POOLS))
+    {
+        auto const sec = section(SECTION_IO_POOLS);
+
+        auto const workers = [&sec](char const* name) {
+            auto const n = sec.value_or(name, 0);
+            if (n < 0 || n > 1024)
+                Throw<std::runtime_error>(
+                    std::string("Invalid value '") + name +
+                    "' in " SECTION_IO_POOLS
+                    ": must be between 0 and 1024 inclusive.");
+            return n;
+        };
+        OVERLAY_IO_WORKERS = workers("overlay_workers");
+        SERVER_IO_WORKERS = workers("server_workers");
+
+        // A list of CPUs and ranges of them, like "0,2-3", where "nodeN"
+        // stands for the CPUs of NUMA node N
+        auto const cpus = [&sec](char const* name) {
+            std::vector<unsigned> ret;
+            auto const val = sec.get(name);
+            if (!val)
+                return ret;
+
+            std::vector<std::string> items;
+            boost::split(items, *val, boost::algorithm::is_any_of(","));
+            try
+            {
+                for (auto item : items)
+                {
+                    boost::trim(item);
+                    if (boost::starts_with(item, "node"))
+                    {
+                        auto const node = beast::lexicalCastThrow<std::size_t>(
+                            item.substr(4));
+                        auto const& nodes = numa::nodes();
+                        if (node >= nodes.size() || nodes[node].empty())
+                            Throw<std::runtime_error>("bad node");
+                        ret.insert(
+                            ret.end(), nodes[node].begin(), nodes[node].end());
+                        continue;
+                    }
+                    auto const dash = item.find('-');
+                    auto const first = beast::lexicalCastThrow<unsigned>(
+                        item.substr(0, dash));
+                    auto const last = dash == std::string::npos
+                        ? first
+                        : beast::lexicalCastThrow<unsigned>(
+                              item.substr(dash + 1));
+                    if (last < first || last >= 1024)
+                        Throw<std::runtime_error>("bad range");
+                    for (auto cpu = first; cpu <= last; ++cpu)
+                        ret.push_back(cpu);
+                }
+            }
+            catch (std::exception const&)
+            {
+                Throw<std::runtime_error>(
+                    std::string("Invalid value '") + name +
+                    "' in " SECTION_IO_POOLS
+                    ": must be a list of CPUs or NUMA nodes, like "
+                    "'0,2-3' or 'node1'.");
+            }
+            return ret;
+        };
+        IO_AFFINITY = cpus("io_affinity");
+        OVERLAY_IO_AFFINITY = cpus("overlay_affinity");
+        SERVER_IO_AFFINITY = cpus("server_affinity");
+    }
+
     if (getSingleSection(secConfig, SECTION_PREFETCH_WORKERS, strTemp, j_))
     {
         PREFETCH_WORKERS = beast::lexicalCastThrow<int>(strTemp);
@@ -697,12 +822,35 @@ Config::loadFromString(std::string const& fileContents)
                 ": must be between 1 and 1024 inclusive.");
     }
 
+    if (getSingleSection(secConfig, SECTION_VERIFY_WORKERS, strTemp, j_))
+    {
+        VERIFY_WORKERS = beast::lexicalCastThrow<int>(strTemp);
+
+        if (VERIFY_WORKERS < 1 || VERIFY_WORKERS > 1024)
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_VERIFY_WORKERS
+                ": must be between 1 and 1024 inclusive.");
+    }
+
     if (getSingleSection(secConfig, SECTION_COMPRESSION, strTemp, j_))
         COMPRESSION = beast::lexicalCastThrow<bool>(strTemp);
 
     if (getSingleSection(secConfig, SECTION_LEDGER_REPLAY, strTemp, j_))
         LEDGER_REPLAY = beast::lexicalCastThrow<bool>(strTemp);
 
+    if (getSingleSection(secConfig, SECTION_PARALLEL_APPLY, strTemp, j_))
+    {
+        PARALLEL_APPLY_THREADS = beast::lexicalCastThrow<std::size_t>(strTemp);
+
+        if (PARALLEL_APPLY_THREADS > 64)
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_PARALLEL_APPLY
+                ": must be between 0 and 64 inclusive.");
+    }
+
+    if (getSingleSection(secConfig, SECTION_SPECULATIVE_BUILD, strTemp, j_))
+        SPECULATIVE_BUILD = beast::lexicalCastThrow<bool>(strTemp);
+
     if (exists(SECTION_REDUCE_RELAY))
     {
         auto sec = section(SECTION_REDUCE_RELAY);
@@ -712,6 +860,8 @@ Config::loadFromString(std::string const& fileContents)
         TX_REDUCE_RELAY_METRICS = sec.value_or("tx_metrics", false);
         TX_REDUCE_RELAY_MIN_PEERS = sec.value_or("tx_min_peers", 20);
         TX_RELAY_PERCENTAGE = sec.value_or("tx_relay_percentage", 25);
+        TX_TARGET_REDUNDANCY = sec.value_or("tx_target_redundancy", 0);
+        TX_RELAY_BATCH = sec.value_or("tx_batch", false);
         if (TX_RELAY_PERCENTAGE < 10 || TX_RELAY_PERCENTAGE > 100 ||
             TX_REDUCE_RELAY_MIN_PEERS < 10)
             Throw<std::runtime_error>(
@@ -719,6 +869,10 @@ Config::loadFromString(std::string const& fileContents)
                 ", tx_min_peers must be greater or equal to 10"
                 ", tx_relay_percentage must be greater or equal to 10 "
                 "and less or equal to 100");
+        if (TX_TARGET_REDUNDANCY == 1)
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_REDUCE_RELAY
+                ", tx_target_redundancy must be 0 or greater than 1");
     }
 
     if (getSingleSection(secConfig, SECTION_MAX_TRANSACTIONS, strTemp, j_))
@@ -102,6 +102,65 @@ DatabaseCon::~DatabaseCon()
     }
 }
 
+std::size_t
+DatabaseCon::openReaders(
+    std::size_t count,
+    std::vector<std::string> const& pragma)
+{
+    if (path_.empty())
+        return 0;
+
+    std::string journalMode;
+    *session_ << "PRAGMA journal_mode;", soci::into(journalMode);
+    if (!boost::iequals(journalMode, "wal"))
+        return 0;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto reader = std::make_unique<Reader>();
+        open(reader->session, "sqlite", path_);
+        for (auto const& p : pragma)
+        {
+            soci::statement st = reader->session.prepare << p;
+            st.execute(true);
+        }
+        reader->session << "PRAGMA query_only=1;";
+        reader->statements =
+            std::make_unique<SQLiteStatements>(reader->session);
+        readers_.push_back(std::move(reader));
+    }
+    return readers_.size();
+}
+
+LockedSQLiteReader
+DatabaseCon::checkoutReader()
+{
+    if (readers_.empty())
+    {
+        std::unique_lock lock(lock_);
+        if (!statements_)
+            statements_ = std::make_unique<SQLiteStatements>(*session_);
+        return {*session_, *statements_, std::move(lock)};
+    }
+
+    // Take the first idle reader, starting from a different one each time,
+    // and wait for one only if they are all busy.
+    auto const start = nextReader_.fetch_add(1, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < readers_.size(); ++i)
+    {
+        auto& reader = *readers_[(start + i) % readers_.size()];
+        std::unique_lock lock(reader.mutex, std::try_to_lock);
+        if (lock)
+            return {reader.session, *reader.statements, std::move(lock)};
+    }
+
+    auto& reader = *readers_[start % readers_.size()];
+    return {
+        reader.session,
+        *reader.statements,
+        std::unique_lock<LockedSQLiteReader::mutex>(reader.mutex)};
+}
+
 DatabaseCon::Setup
 setup_DatabaseCon(Config const& c, std::optional<beast::Journal> j)
 {
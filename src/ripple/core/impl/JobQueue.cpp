@@ -20,21 +20,25 @@
 #include <ripple/basics/PerfLog.h>
 #include <ripple/basics/contract.h>
 #include <ripple/core/JobQueue.h>
+#include <bit>
 #include <mutex>
 
 namespace ripple {
 
+static_assert(jtNS_WRITE < 64, "JobQueue::m_pending has a bit per JobType");
+
 JobQueue::JobQueue(
     int threadCount,
     beast::insight::Collector::ptr const& collector,
     beast::Journal journal,
     Logs& logs,
-    perf::PerfLog& perfLog)
+    perf::PerfLog& perfLog,
+    bool numaSpread)
     : m_journal(journal)
     , m_lastJob(0)
     , m_invalidJobData(JobTypes::instance().getInvalid(), collector, logs)
     , m_processCount(0)
-    , m_workers(*this, &perfLog, "JobQueue", threadCount)
+    , m_workers(*this, &perfLog, "JobQueue", threadCount, numaSpread)
     , perfLog_(perfLog)
     , m_collector(collector)
 {
@@ -71,7 +75,7 @@ void
 JobQueue::collect()
 {
     std::lock_guard lock(m_mutex);
-    job_count = m_jobSet.size();
+    job_count = m_jobCount;
 }
 
 bool
@@ -98,19 +102,13 @@ JobQueue::addRefCountedJob(
         m_workers.getNumberOfThreads() > 0);
 
     {
-        std::lock_guard lock(m_mutex);
-        auto result =
-            m_jobSet.emplace(type, name, ++m_lastJob, data.load(), func);
-        auto const& job = *result.first;
-
-        JobType const type(job.getType());
-        assert(type != jtINVALID);
-        assert(m_jobSet.find(job) != m_jobSet.end());
+        auto const lock = lockProfiled();
+        data.queue.emplace_back(type, name, ++m_lastJob, data.load(), func);
+        m_pending |= std::uint64_t(1) << type;
+        ++m_jobCount;
         perfLog_.jobQueue(type);
 
-        JobTypeData& data(getJobTypeData(type));
-
-        if (data.waiting + data.running < getJobLimit(type))
+        if (data.waiting + data.running < data.info.limit())
         {
             m_workers.addTask();
         }
@@ -161,6 +159,31 @@ JobQueue::getJobCountGE(JobType t) const
     return ret;
 }
 
+LatencyHistogram const&
+JobQueue::getQueueLatency(JobType t) const
+{
+    JobDataMap::const_iterator c = m_jobData.find(t);
+    assert(c != m_jobData.end());
+
+    return (c == m_jobData.end()) ? m_invalidJobData.queued
+                                  : c->second.queued;
+}
+
+std::chrono::microseconds
+JobQueue::getQueueAge(JobType t) const
+{
+    using namespace std::chrono;
+    auto const now = Job::clock_type::now();
+
+    std::lock_guard lock(m_mutex);
+
+    JobDataMap::const_iterator c = m_jobData.find(t);
+    if (c == m_jobData.end() || c->second.queue.empty())
+        return microseconds{0};
+
+    return ceil<microseconds>(now - c->second.queue.front().queue_time());
+}
+
 std::unique_ptr<LoadEvent>
 JobQueue::makeLoadEvent(JobType t, std::string const& name)
 {
@@ -254,7 +277,22 @@ void
 JobQueue::rendezvous()
 {
     std::unique_lock<std::mutex> lock(m_mutex);
-    cv_.wait(lock, [this] { return m_processCount == 0 && m_jobSet.empty(); });
+    cv_.wait(lock, [this] { return m_processCount == 0 && m_jobCount == 0; });
+}
+
+std::unique_lock<std::mutex>
+JobQueue::lockProfiled() const
+{
+    // An uncontended lock costs no more than it would otherwise.
+    std::unique_lock lock(m_mutex, std::try_to_lock);
+    if (!lock.owns_lock())
+    {
+        auto const start = Job::clock_type::now();
+        lock.lock();
+        perfLog_.jobQueueLock(std::chrono::ceil<std::chrono::microseconds>(
+            Job::clock_type::now() - start));
+    }
+    return lock;
 }
 
 JobTypeData&
@@ -285,9 +323,9 @@ JobQueue::stop()
         // we must wait on the condition variable to make these assertions.
         std::unique_lock<std::mutex> lock(m_mutex);
         cv_.wait(
-            lock, [this] { return m_processCount == 0 && m_jobSet.empty(); });
+            lock, [this] { return m_processCount == 0 && m_jobCount == 0; });
         assert(m_processCount == 0);
-        assert(m_jobSet.empty());
+        assert(m_jobCount == 0);
         assert(nSuspend_ == 0);
         stopped_ = true;
     }
@@ -302,30 +340,35 @@ JobQueue::isStopped() const
 void
 JobQueue::getNextJob(Job& job)
 {
-    assert(!m_jobSet.empty());
+    assert(m_jobCount > 0);
 
-    std::set<Job>::const_iterator iter;
-    for (iter = m_jobSet.begin(); iter != m_jobSet.end(); ++iter)
+    // Visit the types with waiting jobs from the highest priority down
+    for (auto pending = m_pending; pending != 0;)
     {
-        JobType const type = iter->getType();
-        assert(type != jtINVALID);
+        auto const type = static_cast<JobType>(std::bit_width(pending) - 1);
+        pending &= ~(std::uint64_t(1) << type);
 
         JobTypeData& data(getJobTypeData(type));
-        assert(data.running <= getJobLimit(type));
+        assert(!data.queue.empty());
+        assert(data.running <= data.info.limit());
 
-        // Run this job if we're running below the limit.
-        if (data.running < getJobLimit(data.type()))
+        // Run the oldest job of this type if we're running below the limit.
+        if (data.running < data.info.limit())
         {
             assert(data.waiting > 0);
             --data.waiting;
             ++data.running;
-            break;
+
+            job = std::move(data.queue.front());
+            data.queue.pop_front();
+            if (data.queue.empty())
+                m_pending &= ~(std::uint64_t(1) << type);
+            --m_jobCount;
+            return;
         }
     }
 
-    assert(iter != m_jobSet.end());
-    job = *iter;
-    m_jobSet.erase(iter);
+    LogicError("JobQueue::getNextJob() : no job can be run");
 }
 
 void
@@ -358,7 +401,7 @@ JobQueue::processTask(int instance)
         {
             Job job;
             {
-                std::lock_guard lock(m_mutex);
+                auto const lock = lockProfiled();
                 getNextJob(job);
                 ++m_processCount;
             }
@@ -369,6 +412,7 @@ JobQueue::processTask(int instance)
             // The amount of time that the job was in the queue
             auto const q_time =
                 ceil<microseconds>(start_time - job.queue_time());
+            data.queued.record(q_time);
             perfLog_.jobStart(type, q_time, start_time, instance);
 
             job.doJob();
@@ -387,12 +431,12 @@ JobQueue::processTask(int instance)
     }
 
     {
-        std::lock_guard lock(m_mutex);
+        auto const lock = lockProfiled();
         // Job should be destroyed before stopping
         // otherwise destructors with side effects can access
         // parent objects that are already destroyed.
         finishJob(type);
-        if (--m_processCount == 0 && m_jobSet.empty())
+        if (--m_processCount == 0 && m_jobCount == 0)
             cv_.notify_all();
     }
 
@@ -31,6 +31,7 @@
 #include <boost/filesystem.hpp>
 #include <memory>
 #include <soci/sqlite3/soci-sqlite3.h>
+#include <utility>
 
 namespace ripple {
 
@@ -185,6 +186,132 @@ convert(std::string const& from, soci::blob& to)
         to.trim(0);
 }
 
+//------------------------------------------------------------------------------
+
+SQLiteStatements::Statement::Statement(Statement&& other) noexcept
+    : stmt_(std::exchange(other.stmt_, nullptr))
+{
+}
+
+SQLiteStatements::Statement::~Statement()
+{
+    if (stmt_)
+    {
+        sqlite_api::sqlite3_reset(stmt_);
+        sqlite_api::sqlite3_clear_bindings(stmt_);
+    }
+}
+
+void
+SQLiteStatements::Statement::bind(int index, std::int64_t value)
+{
+    if (sqlite_api::sqlite3_bind_int64(stmt_, index, value) != SQLITE_OK)
+        Throw<std::runtime_error>(
+            sqlite_api::sqlite3_errmsg(sqlite_api::sqlite3_db_handle(stmt_)));
+}
+
+void
+SQLiteStatements::Statement::bind(int index, std::string const& value)
+{
+    // SQLITE_TRANSIENT, which has SQLite copy the value. The macro can't be
+    // used outside the sqlite_api namespace.
+    auto const transient =
+        reinterpret_cast<sqlite_api::sqlite3_destructor_type>(
+            static_cast<std::intptr_t>(-1));
+    if (sqlite_api::sqlite3_bind_text(
+            stmt_,
+            index,
+            value.data(),
+            static_cast<int>(value.size()),
+            transient) != SQLITE_OK)
+        Throw<std::runtime_error>(
+            sqlite_api::sqlite3_errmsg(sqlite_api::sqlite3_db_handle(stmt_)));
+}
+
+bool
+SQLiteStatements::Statement::step()
+{
+    switch (sqlite_api::sqlite3_step(stmt_))
+    {
+        case SQLITE_ROW:
+            return true;
+        case SQLITE_DONE:
+            return false;
+        default:
+            Throw<std::runtime_error>(sqlite_api::sqlite3_errmsg(
+                sqlite_api::sqlite3_db_handle(stmt_)));
+    }
+    return false;  // Silence compiler warning.
+}
+
+std::int64_t
+SQLiteStatements::Statement::getInt(int column) const
+{
+    return sqlite_api::sqlite3_column_int64(stmt_, column);
+}
+
+std::string
+SQLiteStatements::Statement::getText(int column) const
+{
+    auto const text = sqlite_api::sqlite3_column_text(stmt_, column);
+    if (!text)
+        return {};
+    return std::string(
+        reinterpret_cast<char const*>(text),
+        sqlite_api::sqlite3_column_bytes(stmt_, column));
+}
+
+void
+SQLiteStatements::Statement::getBlob(
+    int column,
+    std::vector<std::uint8_t>& to) const
+{
+    auto const data = static_cast<std::uint8_t const*>(
+        sqlite_api::sqlite3_column_blob(stmt_, column));
+    if (!data)
+    {
+        to.clear();
+        return;
+    }
+    to.assign(data, data + sqlite_api::sqlite3_column_bytes(stmt_, column));
+}
+
+SQLiteStatements::SQLiteStatements(soci::session& session)
+    : db_(getConnection(session))
+{
+}
+
+SQLiteStatements::~SQLiteStatements()
+{
+    for (auto const& [sql, stmt] : statements_)
+        sqlite_api::sqlite3_finalize(stmt);
+}
+
+SQLiteStatements::Statement
+SQLiteStatements::get(std::string const& sql)
+{
+    auto iter = statements_.find(sql);
+    if (iter == statements_.end())
+    {
+        sqlite_api::sqlite3_stmt* stmt = nullptr;
+        if (sqlite_api::sqlite3_prepare_v3(
+                db_,
+                sql.data(),
+                static_cast<int>(sql.size()),
+                SQLITE_PREPARE_PERSISTENT,
+                &stmt,
+                nullptr) != SQLITE_OK)
+        {
+            sqlite_api::sqlite3_finalize(stmt);
+            Throw<std::runtime_error>(sqlite_api::sqlite3_errmsg(db_));
+        }
+        iter = statements_.emplace(sql, stmt).first;
+    }
+    return Statement(iter->second);
+}
+
+//------------------------------------------------------------------------------
+
 namespace {
 
 /** Run a thread to checkpoint the write ahead log (wal) for
@@ -0,0 +1,140 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <ripple/core/TimeoutWheel.h>
+#include <algorithm>
+#include <cassert>
+
+namespace ripple {
+
+TimeoutWheel::TimeoutWheel(
+    boost::asio::io_service& io_service,
+    std::chrono::milliseconds tick)
+    : tick_(tick), start_(clock_type::now()), timer_(io_service), current_(0)
+{
+    assert(tick_.count() > 0);
+}
+
+TimeoutWheel::~TimeoutWheel()
+{
+    stop();
+}
+
+std::uint64_t
+TimeoutWheel::ticksSinceStart(clock_type::time_point when) const
+{
+    return (when - start_) / tick_;
+}
+
+void
+TimeoutWheel::schedule(
+    std::chrono::milliseconds delay,
+    std::function<void()> handler)
+{
+    std::lock_guard lock(mutex_);
+    if (stopped_)
+        return;
+
+    auto const now = clock_type::now();
+    // The wheel stands still while nothing is waiting
+    if (!armed_)
+        current_ = std::max(current_, ticksSinceStart(now));
+
+    // Round up, so that the handler never runs early
+    auto const due = std::max(
+        ticksSinceStart(now + delay + tick_ - clock_type::duration{1}),
+        current_ + 1);
+    slots_[due % slotCount].push_back({due, std::move(handler)});
+    ++size_;
+
+    if (!armed_)
+        arm(lock);
+}
+
+void
+TimeoutWheel::arm(std::lock_guard<std::mutex> const&)
+{
+    armed_ = true;
+    timer_.expires_at(start_ + (current_ + 1) * tick_);
+    timer_.async_wait(
+        [this](boost::system::error_code const& ec) { onTimer(ec); });
+}
+
+void
+TimeoutWheel::onTimer(boost::system::error_code const& ec)
+{
+    if (ec == boost::asio::error::operation_aborted)
+        return;
+
+    std::vector<std::function<void()>> expired;
+    {
+        std::lock_guard lock(mutex_);
+        armed_ = false;
+        if (stopped_)
+            return;
+
+        auto const last = ticksSinceStart(clock_type::now());
+        // Visit each slot at most once, however late the timer is
+        auto const first = std::max<std::uint64_t>(
+            current_ + 1, last >= slotCount ? last - slotCount + 1 : 0);
+        for (auto t = first; t <= last; ++t)
+        {
+            auto& slot = slots_[t % slotCount];
+            auto const due = std::partition(
+                slot.begin(), slot.end(), [last](Entry const& e) {
+                    return e.due > last;
+                });
+            for (auto it = due; it != slot.end(); ++it)
+                expired.push_back(std::move(it->handler));
+            slot.erase(due, slot.end());
+        }
+        size_ -= expired.size();
+        current_ = std::max(current_, last);
+
+        if (size_ != 0)
+            arm(lock);
+    }
+
+    for (auto& handler : expired)
+        handler();
+}
+
+void
+TimeoutWheel::stop()
+{
+    std::lock_guard lock(mutex_);
+    stopped_ = true;
+
+    boost::system::error_code ec;
+    timer_.cancel(ec);
+
+    for (auto& slot : slots_)
+        slot.clear();
+    size_ = 0;
+}
+
+std::size_t
+TimeoutWheel::size() const
+{
+    std::lock_guard lock(mutex_);
+    return size_;
+}
+
+}  // namespace ripple
@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/basics/Numa.h>
 #include <ripple/basics/PerfLog.h>
 #include <ripple/beast/core/CurrentThreadName.h>
 #include <ripple/core/impl/Workers.h>
@@ -28,10 +29,12 @@ Workers::Workers(
     Callback& callback,
     perf::PerfLog* perfLog,
     std::string const& threadNames,
-    int numberOfThreads)
+    int numberOfThreads,
+    bool numaSpread)
     : m_callback(callback)
     , perfLog_(perfLog)
     , m_threadNames(threadNames)
+    , numaSpread_(numaSpread)
     , m_allPaused(true)
     , m_semaphore(0)
     , m_numberOfThreads(0)
@@ -166,6 +169,8 @@ Workers::Worker::Worker(
     , shouldExit_{false}
 {
     thread_ = std::thread{&Workers::Worker::run, this};
+    if (m_workers.numaSpread_)
+        numa::spread(thread_, instance_);
 }
 
 Workers::Worker::~Worker()
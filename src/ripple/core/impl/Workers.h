@@ -108,13 +108,16 @@ public:
         default is to create one thread per CPU.
 
         @param threadNames The name given to each created worker thread.
+        @param numaSpread Whether to divide the threads evenly between the
+                          NUMA nodes, pinning each to the CPUs of one.
     */
     explicit Workers(
         Callback& callback,
         perf::PerfLog* perfLog,
         std::string const& threadNames = "Worker",
         int numberOfThreads =
-            static_cast<int>(std::thread::hardware_concurrency()));
+            static_cast<int>(std::thread::hardware_concurrency()),
+        bool numaSpread = false);
 
     ~Workers();
 
@@ -218,6 +221,7 @@ private:
     Callback& m_callback;
     perf::PerfLog* perfLog_;
     std::string m_threadNames;     // The name to give each thread
+    bool const numaSpread_;        // pin each thread to a NUMA node
     std::condition_variable m_cv;  // signaled when all threads paused
     std::mutex m_mut;
     bool m_allPaused;
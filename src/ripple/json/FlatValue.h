@@ -0,0 +1,288 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_JSON_FLATVALUE_H_INCLUDED
+#define RIPPLE_JSON_FLATVALUE_H_INCLUDED
+
+#include <ripple/json/Output.h>
+#include <ripple/json/json_value.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Json {
+
+class FlatValue;
+
+/** The memory behind a tree of FlatValue.
+
+    Everything a FlatValue allocates, member names and strings included,
+    comes from the arena and is released at once when the arena is
+    destroyed. An arena is meant to live for one request.
+*/
+class Arena
+{
+public:
+    explicit Arena(std::size_t initialSize = 16 * 1024)
+        : resource_(initialSize)
+    {
+    }
+
+    Arena(Arena const&) = delete;
+    Arena&
+    operator=(Arena const&) = delete;
+
+    /** The root of a new tree of values. */
+    FlatValue
+    make(ValueType type = nullValue);
+
+    std::pmr::memory_resource&
+    resource()
+    {
+        return resource_;
+    }
+
+    /** Copy a string into the arena. */
+    std::string_view
+    copy(std::string_view s);
+
+private:
+    std::pmr::monotonic_buffer_resource resource_;
+};
+
+//------------------------------------------------------------------------------
+
+/** A JSON value for building large responses cheaply.
+
+    This is an alternative to Json::Value for code which builds big trees.
+    The members of an object are kept in a vector sorted by name instead
+    of a std::map, and all of the memory comes from an Arena, so adding a
+    value is a pointer bump rather than an allocation. Names given as a
+    StaticString, which includes every jss:: name, are stored without a
+    copy.
+
+    Values live in their arena and must not outlive it. As with
+    Json::Value, references to members and elements stay valid while more
+    are added. Assigning one FlatValue to another copies the tree.
+
+    Objects are written in the same order as Json::Value, so both produce
+    identical output, and toValue() converts where a Json::Value is still
+    needed.
+*/
+class FlatValue
+{
+public:
+    struct Member
+    {
+        std::string_view name;
+        FlatValue* value;
+    };
+
+    FlatValue(Arena& arena, ValueType type = nullValue);
+
+    FlatValue(FlatValue const&) = delete;
+
+    /** Deep copy, into the arena of this value. */
+    FlatValue&
+    operator=(FlatValue const& other);
+
+    ValueType
+    type() const
+    {
+        return type_;
+    }
+
+    Arena&
+    arena() const
+    {
+        return *arena_;
+    }
+
+    bool
+    isNull() const
+    {
+        return type_ == nullValue;
+    }
+
+    /** Number of members or elements; 0 for scalars. */
+    std::size_t
+    size() const;
+
+    //--------------------------------------------------------------------------
+    // Scalars
+
+    FlatValue&
+    operator=(Int i);
+
+    FlatValue&
+    operator=(UInt u);
+
+    FlatValue&
+    operator=(double d);
+
+    FlatValue&
+    operator=(bool b);
+
+    /** Store a string which outlives the arena without copying it. */
+    FlatValue&
+    operator=(StaticString s);
+
+    FlatValue&
+    operator=(char const* s)
+    {
+        return *this = std::string_view(s);
+    }
+
+    FlatValue&
+    operator=(std::string const& s)
+    {
+        return *this = std::string_view(s);
+    }
+
+    FlatValue&
+    operator=(std::string_view s);
+
+    /** Deep copy a Json::Value into this arena. */
+    FlatValue&
+    operator=(Value const& v);
+
+    Int
+    asInt() const;
+
+    UInt
+    asUInt() const;
+
+    double
+    asDouble() const;
+
+    bool
+    asBool() const;
+
+    std::string_view
+    asString() const;
+
+    //--------------------------------------------------------------------------
+    // Objects
+
+    /** Access a member, adding it if it is missing.
+
+        A null value becomes an object.
+    */
+    FlatValue&
+    operator[](StaticString key);
+
+    FlatValue&
+    operator[](std::string_view key);
+
+    FlatValue&
+    operator[](std::string const& key)
+    {
+        return (*this)[std::string_view(key)];
+    }
+
+    FlatValue&
+    operator[](char const* key)
+    {
+        return (*this)[std::string_view(key)];
+    }
+
+    /** Returns the member, or nullptr if there is none. */
+    FlatValue const*
+    find(std::string_view key) const;
+
+    bool
+    isMember(std::string_view key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    /** The members of an object, sorted by name. */
+    std::pmr::vector<Member> const&
+    members() const;
+
+    //--------------------------------------------------------------------------
+    // Arrays
+
+    /** Add a null element at the end and return it.
+
+        A null value becomes an array.
+    */
+    FlatValue&
+    append();
+
+    template <class T>
+    FlatValue&
+    append(T const& t)
+    {
+        return append() = t;
+    }
+
+    FlatValue&
+    operator[](UInt index);
+
+    FlatValue const&
+    operator[](UInt index) const;
+
+    std::pmr::vector<FlatValue*> const&
+    elements() const;
+
+    //--------------------------------------------------------------------------
+
+    /** Deep copy into a Json::Value. */
+    Value
+    toValue() const;
+
+private:
+    using Members = std::pmr::vector<Member>;
+    using Elements = std::pmr::vector<FlatValue*>;
+
+    FlatValue&
+    member(std::string_view key, bool copy);
+
+    FlatValue*
+    make();
+
+    void
+    become(ValueType type);
+
+    Arena* arena_;
+    ValueType type_;
+    std::uint32_t size_ = 0;
+    union
+    {
+        Int int_;
+        UInt uint_;
+        double real_;
+        bool bool_;
+        char const* string_;
+        Members* members_;
+        Elements* elements_;
+    };
+};
+
+/** Writes a minimal representation of a FlatValue to an Output. */
+void
+outputJson(FlatValue const&, Output const&);
+
+}  // namespace Json
+
+#endif
@@ -0,0 +1,86 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_JSON_SHAREDJSON_H_INCLUDED
+#define RIPPLE_JSON_SHAREDJSON_H_INCLUDED
+
+#include <ripple/json/MultivarJson.h>
+#include <ripple/json/json_value.h>
+#include <ripple/json/json_writer.h>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace ripple {
+
+/** A Json::Value sent to many recipients, serialized at most once.
+
+    The value is serialized the first time a recipient asks for its text,
+    and every later recipient shares that text. It is not thread safe, and
+    the value must outlive it.
+*/
+class SharedJson
+{
+    Json::Value const& json_;
+    mutable std::shared_ptr<std::string const> text_;
+
+public:
+    explicit SharedJson(Json::Value const& json) : json_(json)
+    {
+    }
+
+    Json::Value const&
+    json() const
+    {
+        return json_;
+    }
+
+    /** The value in compact form, as Json::stream writes it. */
+    std::shared_ptr<std::string const> const&
+    text() const
+    {
+        if (!text_)
+        {
+            std::string text;
+            Json::stream(json_, [&text](void const* data, std::size_t n) {
+                text.append(static_cast<char const*>(data), n);
+            });
+            text_ = std::make_shared<std::string const>(std::move(text));
+        }
+        return text_;
+    }
+};
+
+/** Share each API version of a MultivarJson. */
+template <std::size_t Size>
+std::array<SharedJson, Size>
+share(MultivarJson<Size> const& json)
+{
+    return [&json]<std::size_t... index>(std::index_sequence<index...>)
+    {
+        return std::array<SharedJson, Size>{SharedJson{json.val[index]}...};
+    }
+    (std::make_index_sequence<Size>{});
+}
+
+}  // namespace ripple
+
+#endif
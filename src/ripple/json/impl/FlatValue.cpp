@@ -0,0 +1,514 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/contract.h>
+#include <ripple/json/FlatValue.h>
+#include <ripple/json/Writer.h>
+#include <ripple/json/json_errors.h>
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace Json {
+
+FlatValue
+Arena::make(ValueType type)
+{
+    return FlatValue(*this, type);
+}
+
+std::string_view
+Arena::copy(std::string_view s)
+{
+    if (s.empty())
+        return {};
+    auto const p = static_cast<char*>(resource_.allocate(s.size(), 1));
+    std::memcpy(p, s.data(), s.size());
+    return {p, s.size()};
+}
+
+//------------------------------------------------------------------------------
+
+FlatValue::FlatValue(Arena& arena, ValueType type)
+    : arena_(&arena), type_(nullValue), int_(0)
+{
+    become(type);
+}
+
+FlatValue*
+FlatValue::make()
+{
+    auto const p =
+        arena_->resource().allocate(sizeof(FlatValue), alignof(FlatValue));
+    return new (p) FlatValue(*arena_);
+}
+
+void
+FlatValue::become(ValueType type)
+{
+    if (type_ == type)
+        return;
+    if (type_ != nullValue)
+        ripple::Throw<Json::error>("FlatValue: not a null value");
+
+    auto& resource = arena_->resource();
+    switch (type)
+    {
+        case arrayValue:
+            elements_ = new (resource.allocate(
+                sizeof(Elements), alignof(Elements))) Elements(&resource);
+            break;
+        case objectValue:
+            members_ = new (resource.allocate(
+                sizeof(Members), alignof(Members))) Members(&resource);
+            break;
+        case realValue:
+            real_ = 0;
+            break;
+        case stringValue:
+            string_ = "";
+            size_ = 0;
+            break;
+        case booleanValue:
+            bool_ = false;
+            break;
+        default:
+            int_ = 0;
+            break;
+    }
+    type_ = type;
+}
+
+std::size_t
+FlatValue::size() const
+{
+    if (type_ == arrayValue)
+        return elements_->size();
+    if (type_ == objectValue)
+        return members_->size();
+    return 0;
+}
+
+FlatValue&
+FlatValue::operator=(FlatValue const& other)
+{
+    if (&other == this)
+        return *this;
+
+    switch (other.type_)
+    {
+        case nullValue:
+            type_ = nullValue;
+            break;
+        case intValue:
+            *this = other.int_;
+            break;
+        case uintValue:
+            *this = other.uint_;
+            break;
+        case realValue:
+            *this = other.real_;
+            break;
+        case stringValue:
+            *this = other.asString();
+            break;
+        case booleanValue:
+            *this = other.bool_;
+            break;
+        case arrayValue:
+            type_ = nullValue;
+            become(arrayValue);
+            elements_->reserve(other.elements_->size());
+            for (auto const e : *other.elements_)
+                append() = *e;
+            break;
+        case objectValue:
+            type_ = nullValue;
+            become(objectValue);
+            // The members are already in order.
+            members_->reserve(other.members_->size());
+            for (auto const& m : *other.members_)
+            {
+                auto const value = make();
+                *value = *m.value;
+                members_->push_back({arena_->copy(m.name), value});
+            }
+            break;
+    }
+    return *this;
+}
+
+FlatValue&
+FlatValue::operator=(Int i)
+{
+    type_ = intValue;
+    int_ = i;
+    return *this;
+}
+
+FlatValue&
+FlatValue::operator=(UInt u)
+{
+    type_ = uintValue;
+    uint_ = u;
+    return *this;
+}
+
+FlatValue&
+FlatValue::operator=(double d)
+{
+    type_ = realValue;
+    real_ = d;
+    return *this;
+}
+
+FlatValue&
+FlatValue::operator=(bool b)
+{
+    type_ = booleanValue;
+    bool_ = b;
+    return *this;
+}
+
+FlatValue&
+FlatValue::operator=(StaticString s)
+{
+    type_ = stringValue;
+    string_ = s.c_str();
+    size_ = std::strlen(string_);
+    return *this;
+}
+
+FlatValue&
+FlatValue::operator=(std::string_view s)
+{
+    auto const copy = arena_->copy(s);
+    type_ = stringValue;
+    string_ = copy.data();
+    size_ = copy.size();
+    return *this;
+}
+
+FlatValue&
+FlatValue::operator=(Value const& v)
+{
+    switch (v.type())
+    {
+        case nullValue:
+            type_ = nullValue;
+            break;
+        case intValue:
+            *this = v.asInt();
+            break;
+        case uintValue:
+            *this = v.asUInt();
+            break;
+        case realValue:
+            *this = v.asDouble();
+            break;
+        case stringValue:
+            *this = v.asString();
+            break;
+        case booleanValue:
+            *this = v.asBool();
+            break;
+        case arrayValue:
+            type_ = nullValue;
+            become(arrayValue);
+            elements_->reserve(v.size());
+            for (auto const& e : v)
+                append() = e;
+            break;
+        case objectValue:
+            type_ = nullValue;
+            become(objectValue);
+            members_->reserve(v.size());
+            for (auto it = v.begin(); it != v.end(); ++it)
+                member(it.memberName(), true) = *it;
+            break;
+    }
+    return *this;
+}
+
+Int
+FlatValue::asInt() const
+{
+    switch (type_)
+    {
+        case nullValue:
+            return 0;
+        case intValue:
+            return int_;
+        case uintValue:
+            return static_cast<Int>(uint_);
+        case realValue:
+            return static_cast<Int>(real_);
+        case booleanValue:
+            return bool_ ? 1 : 0;
+        default:
+            ripple::Throw<Json::error>("FlatValue: not convertible to int");
+    }
+    return 0;
+}
+
+UInt
+FlatValue::asUInt() const
+{
+    switch (type_)
+    {
+        case nullValue:
+            return 0;
+        case intValue:
+            return static_cast<UInt>(int_);
+        case uintValue:
+            return uint_;
+        case realValue:
+            return static_cast<UInt>(real_);
+        case booleanValue:
+            return bool_ ? 1 : 0;
+        default:
+            ripple::Throw<Json::error>("FlatValue: not convertible to uint");
+    }
+    return 0;
+}
+
+double
+FlatValue::asDouble() const
+{
+    switch (type_)
+    {
+        case nullValue:
+            return 0;
+        case intValue:
+            return int_;
+        case uintValue:
+            return uint_;
+        case realValue:
+            return real_;
+        case booleanValue:
+            return bool_ ? 1 : 0;
+        default:
+            ripple::Throw<Json::error>("FlatValue: not convertible to double");
+    }
+    return 0;
+}
+
+bool
+FlatValue::asBool() const
+{
+    switch (type_)
+    {
+        case nullValue:
+            return false;
+        case intValue:
+            return int_ != 0;
+        case uintValue:
+            return uint_ != 0;
+        case realValue:
+            return real_ != 0;
+        case booleanValue:
+            return bool_;
+        case stringValue:
+            return size_ != 0;
+        default:
+            return size() != 0;
+    }
+}
+
+std::string_view
+FlatValue::asString() const
+{
+    if (type_ == nullValue)
+        return {};
+    if (type_ != stringValue)
+        ripple::Throw<Json::error>("FlatValue: not a string");
+    return {string_, size_};
+}
+
+FlatValue&
+FlatValue::member(std::string_view key, bool copy)
+{
+    become(objectValue);
+    auto const it = std::lower_bound(
+        members_->begin(),
+        members_->end(),
+        key,
+        [](Member const& m, std::string_view key) { return m.name < key; });
+    if (it != members_->end() && it->name == key)
+        return *it->value;
+    auto const value = make();
+    members_->insert(it, {copy ? arena_->copy(key) : key, value});
+    return *value;
+}
+
+FlatValue&
+FlatValue::operator[](StaticString key)
+{
+    return member(key.c_str(), false);
+}
+
+FlatValue&
+FlatValue::operator[](std::string_view key)
+{
+    return member(key, true);
+}
+
+FlatValue const*
+FlatValue::find(std::string_view key) const
+{
+    if (type_ != objectValue)
+        return nullptr;
+    auto const it = std::lower_bound(
+        members_->begin(),
+        members_->end(),
+        key,
+        [](Member const& m, std::string_view key) { return m.name < key; });
+    if (it != members_->end() && it->name == key)
+        return it->value;
+    return nullptr;
+}
+
+std::pmr::vector<FlatValue::Member> const&
+FlatValue::members() const
+{
+    static Members const empty;
+    return type_ == objectValue ? *members_ : empty;
+}
+
+FlatValue&
+FlatValue::append()
+{
+    become(arrayValue);
+    return *elements_->emplace_back(make());
+}
+
+FlatValue&
+FlatValue::operator[](UInt index)
+{
+    become(arrayValue);
+    while (elements_->size() <= index)
+        elements_->push_back(make());
+    return *(*elements_)[index];
+}
+
+FlatValue const&
+FlatValue::operator[](UInt index) const
+{
+    if (type_ != arrayValue || index >= elements_->size())
+        ripple::Throw<Json::error>("FlatValue: index out of range");
+    return *(*elements_)[index];
+}
+
+std::pmr::vector<FlatValue*> const&
+FlatValue::elements() const
+{
+    static Elements const empty;
+    return type_ == arrayValue ? *elements_ : empty;
+}
+
+Value
+FlatValue::toValue() const
+{
+    switch (type_)
+    {
+        case intValue:
+            return int_;
+        case uintValue:
+            return uint_;
+        case realValue:
+            return real_;
+        case stringValue:
+            return std::string(string_, size_);
+        case booleanValue:
+            return bool_;
+        case arrayValue: {
+            Value v(Json::arrayValue);
+            for (auto const e : *elements_)
+                v.append(e->toValue());
+            return v;
+        }
+        case objectValue: {
+            Value v(Json::objectValue);
+            for (auto const& m : *members_)
+                v[std::string(m.name)] = m.value->toValue();
+            return v;
+        }
+        default:
+            return Value();
+    }
+}
+
+//------------------------------------------------------------------------------
+
+namespace {
+
+void
+outputJson(FlatValue const& value, Writer& writer)
+{
+    switch (value.type())
+    {
+        case nullValue:
+            writer.output(nullptr);
+            break;
+        case intValue:
+            writer.output(value.asInt());
+            break;
+        case uintValue:
+            writer.output(value.asUInt());
+            break;
+        case realValue:
+            writer.output(value.asDouble());
+            break;
+        case stringValue:
+            writer.output(std::string(value.asString()));
+            break;
+        case booleanValue:
+            writer.output(value.asBool());
+            break;
+        case arrayValue:
+            writer.startRoot(Writer::array);
+            for (auto const e : value.elements())
+            {
+                writer.rawAppend();
+                outputJson(*e, writer);
+            }
+            writer.finish();
+            break;
+        case objectValue:
+            writer.startRoot(Writer::object);
+            for (auto const& m : value.members())
+            {
+                writer.rawSet(std::string(m.name));
+                outputJson(*m.value, writer);
+            }
+            writer.finish();
+            break;
+    }
+}
+
+}  // namespace
+
+void
+outputJson(FlatValue const& value, Output const& out)
+{
+    Writer writer(out);
+    outputJson(value, writer);
+}
+
+}  // namespace Json
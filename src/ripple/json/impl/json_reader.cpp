@@ -22,6 +22,8 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
+#include <cstring>
 #include <istream>
 #include <string>
 
@@ -66,6 +68,36 @@ codePointToUTF8(unsigned int cp)
     return result;
 }
 
+// Returns the first quote or backslash in [p, end), or end if there is none.
+// Strings are scanned a 64-bit word at a time, since almost all of a request
+// body is string contents without either byte.
+static Reader::Location
+findQuoteOrEscape(Reader::Location p, Reader::Location end)
+{
+    constexpr std::uint64_t ones = 0x0101010101010101ull;
+    constexpr std::uint64_t highs = 0x8080808080808080ull;
+
+    // Nonzero if any byte of word is zero
+    auto const hasZeroByte = [](std::uint64_t word) {
+        return (word - ones) & ~word & highs;
+    };
+
+    while (end - p >= 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+        if (hasZeroByte(word ^ (ones * '"')) ||
+            hasZeroByte(word ^ (ones * '\\')))
+            break;
+        p += 8;
+    }
+
+    while (p != end && *p != '"' && *p != '\\')
+        ++p;
+
+    return p;
+}
+
 // Class Reader
 // //////////////////////////////////////////////////////////////////
 
@@ -400,6 +432,7 @@ Reader::readString()
 
     while (current_ != end_)
     {
+        current_ = findQuoteOrEscape(current_, end_);
         c = getNextChar();
 
         if (c == '\\')
@@ -679,6 +712,14 @@ Reader::decodeString(Token& token, std::string& decoded)
 
     while (current != end)
     {
+        // Copy the run up to the next quote or escape in one go
+        Location const next = findQuoteOrEscape(current, end);
+        decoded.append(current, next);
+        current = next;
+
+        if (current == end)
+            break;
+
         Char c = *current++;
 
         if (c == '"')
@@ -740,10 +781,6 @@ Reader::decodeString(Token& token, std::string& decoded)
                         "Bad escape sequence in string", token, current);
             }
         }
-        else
-        {
-            decoded += c;
-        }
     }
 
     return true;
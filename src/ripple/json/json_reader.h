@@ -212,11 +212,13 @@ bool
 Reader::parse(Value& root, BufferSequence const& bs)
 {
     using namespace boost::asio;
-    std::string s;
-    s.reserve(buffer_size(bs));
+    // Gather the sequence straight into the document, so it is copied once
+    document_.clear();
+    document_.reserve(buffer_size(bs));
     for (auto const& b : bs)
-        s.append(buffer_cast<char const*>(b), buffer_size(b));
-    return parse(s, root);
+        document_.append(buffer_cast<char const*>(b), buffer_size(b));
+    const char* begin = document_.c_str();
+    return parse(begin, begin + document_.length(), root);
 }
 
 /** \brief Read from 'sin' into 'root'.
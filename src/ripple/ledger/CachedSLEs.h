@@ -25,7 +25,7 @@
 #include <ripple/protocol/STLedgerEntry.h>
 
 namespace ripple {
-using CachedSLEs = TaggedCache<uint256, SLE const>;
+using CachedSLEs = TaggedCache<uint256, SLE const, false, digest_hash>;
 }
 
 #endif  // RIPPLE_LEDGER_CACHEDSLES_H_INCLUDED
@@ -23,6 +23,7 @@
 #include <ripple/basics/hardened_hash.h>
 #include <ripple/ledger/CachedSLEs.h>
 #include <ripple/ledger/ReadView.h>
+#include <array>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -35,10 +36,34 @@ namespace detail {
 class CachedViewImpl : public DigestAwareReadView
 {
 private:
+    struct Entry
+    {
+        uint256 digest;
+
+        // The last entry read, while someone still holds it
+        std::weak_ptr<SLE const> sle;
+    };
+
+    // Every RPC and pathfinding thread reading a ledger shares its view,
+    // so the keys are spread over shards which each have their own lock.
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<key_type, Entry, hardened_hash<>> map;
+    };
+
+    static constexpr std::size_t shardCount = 16;
+
     DigestAwareReadView const& base_;
     CachedSLEs& cache_;
-    std::mutex mutable mutex_;
-    std::unordered_map<key_type, uint256, hardened_hash<>> mutable map_;
+    std::array<Shard, shardCount> mutable shards_;
+
+    Shard&
+    shardFor(key_type const& key) const
+    {
+        // Keys are hashes, so any of their bytes is as good as another
+        return shards_[*key.begin() % shardCount];
+    }
 
 public:
     CachedViewImpl() = delete;
@@ -61,6 +86,13 @@ public:
     std::shared_ptr<SLE const>
     read(Keylet const& k) const override;
 
+    // Views of the base are as cheap as looking the entry up in the cache
+    std::optional<SLEView>
+    readLazy(Keylet const& k) const override
+    {
+        return base_.readLazy(k);
+    }
+
     bool
     open() const override
     {
@@ -20,14 +20,12 @@
 #ifndef RIPPLE_LEDGER_OPENVIEW_H_INCLUDED
 #define RIPPLE_LEDGER_OPENVIEW_H_INCLUDED
 
+#include <ripple/basics/PersistentMap.h>
 #include <ripple/basics/XRPAmount.h>
 #include <ripple/ledger/RawView.h>
 #include <ripple/ledger/ReadView.h>
 #include <ripple/ledger/detail/RawStateTable.h>
 
-#include <boost/container/pmr/monotonic_buffer_resource.hpp>
-#include <boost/container/pmr/polymorphic_allocator.hpp>
-
 #include <functional>
 #include <utility>
 
@@ -55,11 +53,6 @@ extern open_ledger_t const open_ledger;
 class OpenView final : public ReadView, public TxsRawView
 {
 private:
-    // Initial size for the monotonic_buffer_resource used for allocations
-    // The size was chosen from the old `qalloc` code (which this replaces).
-    // It is unclear how the size initially chosen in qalloc.
-    static constexpr size_t initialBufferSize = kilobytes(256);
-
     class txs_iter_impl;
 
     struct txData
@@ -76,20 +69,10 @@ private:
         }
     };
 
-    // List of tx, key order
-    // Use boost::pmr functionality instead of std::pmr
-    // functions b/c clang does not support pmr yet (as-of 9/2020)
-    using txs_map = std::map<
-        key_type,
-        txData,
-        std::less<key_type>,
-        boost::container::pmr::polymorphic_allocator<
-            std::pair<key_type const, txData>>>;
-
-    // monotonic_resource_ must outlive `items_`. Make a pointer so it may be
-    // easily moved.
-    std::unique_ptr<boost::container::pmr::monotonic_buffer_resource>
-        monotonic_resource_;
+    // List of tx, key order. Copies of the view share it, so copying
+    // does not depend on how many transactions the view holds.
+    using txs_map = PersistentMap<key_type, txData>;
+
     txs_map txs_;
     Rules rules_;
     LedgerInfo info_;
@@ -114,6 +97,11 @@ public:
             Creates a new object with a copy of
             the modification state table.
 
+        The copy takes constant time: the state and
+        tx tables share their entries with the
+        original, and each view copies only the
+        entries it changes afterwards.
+
         The objects managed by shared pointers are
         not duplicated but shared between instances.
         Since the SLEs are immutable, calls on the
@@ -211,6 +199,9 @@ public:
     std::shared_ptr<SLE const>
     read(Keylet const& k) const override;
 
+    std::optional<SLEView>
+    readLazy(Keylet const& k) const override;
+
     std::unique_ptr<sles_type::iter_base>
     slesBegin() const override;
 
@@ -24,6 +24,7 @@
 #include <ripple/ledger/Sandbox.h>
 #include <ripple/ledger/detail/ApplyViewBase.h>
 #include <ripple/protocol/AccountID.h>
+#include <boost/container/flat_map.hpp>
 #include <map>
 #include <utility>
 
@@ -89,8 +90,10 @@ private:
     static Key
     makeKey(AccountID const& a1, AccountID const& a2, Currency const& c);
 
-    std::map<Key, Value> credits_;
-    std::map<AccountID, std::uint32_t> ownerCounts_;
+    // A payment's strands create and apply many nested sandboxes which
+    // each hold few credits, so sorted vectors beat node-based maps.
+    boost::container::flat_map<Key, Value> credits_;
+    boost::container::flat_map<AccountID, std::uint32_t> ownerCounts_;
 };
 
 }  // namespace detail
@@ -26,6 +26,7 @@
 #include <ripple/basics/chrono.h>
 #include <ripple/beast/hash/uhash.h>
 #include <ripple/beast/utility/Journal.h>
+#include <ripple/ledger/SLEView.h>
 #include <ripple/ledger/detail/ReadViewFwdRange.h>
 #include <ripple/protocol/Fees.h>
 #include <ripple/protocol/Indexes.h>
@@ -173,6 +174,18 @@ public:
     virtual std::shared_ptr<SLE const>
     read(Keylet const& k) const = 0;
 
+    /** Return a view of the state item associated with a key.
+
+        Unlike read(), this doesn't need to deserialize the whole item,
+        which makes it cheaper for callers that only read a few fields.
+        The default implementation wraps the result of read().
+
+        @return An empty optional if the key is not present or
+                if the type does not match.
+    */
+    virtual std::optional<SLEView>
+    readLazy(Keylet const& k) const;
+
     // Accounts in a payment are not allowed to use assets acquired during that
     // payment. The PaymentSandbox tracks the debits, credits, and owner count
     // changes that accounts make during a payment. `balanceHook` adjusts
@@ -0,0 +1,168 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_LEDGER_RECORDINGVIEW_H_INCLUDED
+#define RIPPLE_LEDGER_RECORDINGVIEW_H_INCLUDED
+
+#include <ripple/ledger/ReadView.h>
+
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+
+/** A read-only view that records what is read through it from another view.
+
+    Whatever is computed from a view only by reading entries and looking up
+    successors still holds in a later ledger in which none of the entries
+    read changed and no entry was created or deleted among the keys that a
+    successor was looked up across.
+*/
+class RecordingView final : public ReadView
+{
+public:
+    struct Reads
+    {
+        // The keys of the entries read or checked for.
+        std::vector<uint256> keys;
+
+        // The ranges of keys (first, last] that successors were found in.
+        std::vector<std::pair<uint256, uint256>> ranges;
+
+        // An entry was read that expires or otherwise depends on the close
+        // time of the parent ledger.
+        bool timed = false;
+
+        // The state or transactions were iterated over, which isn't recorded.
+        bool complete = true;
+
+        /** Whether what was read may differ in a later state.
+
+            This doesn't account for entries that depend on the close time.
+
+            @param changed The keys of every entry created, modified or
+                           deleted since the state that was read.
+        */
+        bool
+        changedBy(std::set<uint256> const& changed) const;
+    };
+
+    RecordingView(RecordingView const&) = delete;
+    RecordingView&
+    operator=(RecordingView const&) = delete;
+
+    explicit RecordingView(ReadView const& base) : base_(base)
+    {
+    }
+
+    /** What was read so far. */
+    Reads const&
+    reads() const
+    {
+        return reads_;
+    }
+
+    //
+    // ReadView
+    //
+
+    bool
+    exists(Keylet const& k) const override;
+
+    std::optional<key_type>
+    succ(
+        key_type const& key,
+        std::optional<key_type> const& last = std::nullopt) const override;
+
+    std::shared_ptr<SLE const>
+    read(Keylet const& k) const override;
+
+    std::optional<SLEView>
+    readLazy(Keylet const& k) const override;
+
+    bool
+    open() const override
+    {
+        return base_.open();
+    }
+
+    LedgerInfo const&
+    info() const override
+    {
+        return base_.info();
+    }
+
+    Fees const&
+    fees() const override
+    {
+        return base_.fees();
+    }
+
+    Rules const&
+    rules() const override
+    {
+        return base_.rules();
+    }
+
+    STAmount
+    balanceHook(
+        AccountID const& account,
+        AccountID const& issuer,
+        STAmount const& amount) const override
+    {
+        return base_.balanceHook(account, issuer, amount);
+    }
+
+    std::uint32_t
+    ownerCountHook(AccountID const& account, std::uint32_t count)
+        const override
+    {
+        return base_.ownerCountHook(account, count);
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesBegin() const override;
+
+    std::unique_ptr<sles_type::iter_base>
+    slesEnd() const override;
+
+    std::unique_ptr<sles_type::iter_base>
+    slesUpperBound(key_type const& key) const override;
+
+    std::unique_ptr<txs_type::iter_base>
+    txsBegin() const override;
+
+    std::unique_ptr<txs_type::iter_base>
+    txsEnd() const override;
+
+    bool
+    txExists(key_type const& key) const override;
+
+    tx_type
+    txRead(key_type const& key) const override;
+
+private:
+    ReadView const& base_;
+    Reads mutable reads_;
+};
+
+}  // namespace ripple
+
+#endif
@@ -0,0 +1,112 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_LEDGER_SLEVIEW_H_INCLUDED
+#define RIPPLE_LEDGER_SLEVIEW_H_INCLUDED
+
+#include <ripple/protocol/STLedgerEntry.h>
+#include <ripple/shamap/SHAMapItem.h>
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+#include <memory>
+#include <optional>
+
+namespace ripple {
+
+/** A read-only ledger entry whose fields are decoded as they are read.
+
+    A view of an entry in the state map of a ledger refers to the serialized
+    bytes of its SHAMap item, and finds each field read in those bytes
+    rather than deserializing the whole entry. Reading a few fields of an
+    entry this way allocates nothing. Views of entries that are only known
+    deserialized, such as those modified in an open ledger, refer to the
+    deserialized entry instead.
+
+    Fields not present in the entry read as their default value, as
+    optional fields of an STObject do.
+*/
+class SLEView
+{
+public:
+    explicit SLEView(std::shared_ptr<SLE const> sle);
+
+    explicit SLEView(boost::intrusive_ptr<SHAMapItem const> item);
+
+    uint256 const&
+    key() const;
+
+    LedgerEntryType
+    getType() const
+    {
+        return type_;
+    }
+
+    std::uint32_t
+    getFlags() const;
+
+    bool
+    isFlag(std::uint32_t flag) const
+    {
+        return (getFlags() & flag) != 0;
+    }
+
+    bool
+    isFieldPresent(SField const& field) const;
+
+    std::uint8_t
+    getFieldU8(SField const& field) const;
+
+    std::uint16_t
+    getFieldU16(SField const& field) const;
+
+    std::uint32_t
+    getFieldU32(SField const& field) const;
+
+    std::uint64_t
+    getFieldU64(SField const& field) const;
+
+    uint256
+    getFieldH256(SField const& field) const;
+
+    AccountID
+    getAccountID(SField const& field) const;
+
+    STAmount
+    getFieldAmount(SField const& field) const;
+
+    /** Return the deserialized entry. */
+    std::shared_ptr<SLE const>
+    sle() const;
+
+private:
+    // Return an iterator over the value of a field of the SHAMap item
+    std::optional<SerialIter>
+    find(SField const& field) const;
+
+    template <class T, class Get>
+    T
+    get(SField const& field, Get&& get) const;
+
+    std::shared_ptr<SLE const> sle_;
+    boost::intrusive_ptr<SHAMapItem const> item_;
+    LedgerEntryType type_;
+};
+
+}  // namespace ripple
+
+#endif
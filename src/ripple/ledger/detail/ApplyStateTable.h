@@ -20,6 +20,7 @@
 #ifndef RIPPLE_LEDGER_APPLYSTATETABLE_H_INCLUDED
 #define RIPPLE_LEDGER_APPLYSTATETABLE_H_INCLUDED
 
+#include <ripple/basics/ByteUtilities.h>
 #include <ripple/basics/XRPAmount.h>
 #include <ripple/beast/utility/Journal.h>
 #include <ripple/ledger/OpenView.h>
@@ -27,6 +28,10 @@
 #include <ripple/ledger/ReadView.h>
 #include <ripple/protocol/TER.h>
 #include <ripple/protocol/TxMeta.h>
+
+#include <boost/container/pmr/monotonic_buffer_resource.hpp>
+
+#include <map>
 #include <memory>
 
 namespace ripple {
@@ -38,6 +43,10 @@ class ApplyStateTable
 public:
     using key_type = ReadView::key_type;
 
+    // Initial size for the arena that holds the table's items.
+    // Kept small because most transactions touch only a few entries.
+    static constexpr size_t initialBufferSize = kilobytes(4);
+
 private:
     enum class Action {
         cache,
@@ -46,13 +55,77 @@ private:
         modify,
     };
 
-    using items_t = std::map<key_type, std::pair<Action, std::shared_ptr<SLE>>>;
+    using Arena = boost::container::pmr::monotonic_buffer_resource;
+
+    // Allocates the table's items from its arena. Every copy of the
+    // allocator keeps the arena alive, so the table stays movable and the
+    // memory is released in one step once the table is gone. The SLEs
+    // themselves use the default allocator, since they are handed to views
+    // that outlive the transaction.
+    template <class T>
+    class ArenaAllocator
+    {
+    public:
+        using value_type = T;
+
+        explicit ArenaAllocator(std::shared_ptr<Arena> arena)
+            : arena_(std::move(arena))
+        {
+        }
+
+        ArenaAllocator(ArenaAllocator const&) = default;
+
+        template <class U>
+        ArenaAllocator(ArenaAllocator<U> const& other) : arena_(other.arena_)
+        {
+        }
+
+        T*
+        allocate(std::size_t n)
+        {
+            return static_cast<T*>(
+                arena_->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void
+        deallocate(T* p, std::size_t n)
+        {
+            arena_->deallocate(p, n * sizeof(T), alignof(T));
+        }
+
+        template <class U>
+        bool
+        operator==(ArenaAllocator<U> const& other) const
+        {
+            return arena_ == other.arena_;
+        }
+
+    private:
+        template <class>
+        friend class ArenaAllocator;
+
+        std::shared_ptr<Arena> arena_;
+    };
+
+    using items_t = std::map<
+        key_type,
+        std::pair<Action, std::shared_ptr<SLE>>,
+        std::less<key_type>,
+        ArenaAllocator<
+            std::pair<key_type const, std::pair<Action, std::shared_ptr<SLE>>>>>;
 
+    // arena_ must outlive `items_`.
+    std::shared_ptr<Arena> arena_;
     items_t items_;
     XRPAmount dropsDestroyed_{0};
 
 public:
-    ApplyStateTable() = default;
+    ApplyStateTable()
+        : arena_{std::make_shared<Arena>(initialBufferSize)}
+        , items_{ArenaAllocator<items_t::value_type>(arena_)}
+    {
+    }
+
     ApplyStateTable(ApplyStateTable&&) = default;
 
     ApplyStateTable(ApplyStateTable const&) = delete;
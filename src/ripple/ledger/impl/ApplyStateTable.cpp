@@ -20,6 +20,7 @@
 #include <ripple/basics/Log.h>
 #include <ripple/json/to_string.h>
 #include <ripple/ledger/detail/ApplyStateTable.h>
+#include <ripple/protocol/ApplyProfile.h>
 #include <ripple/protocol/Feature.h>
 #include <ripple/protocol/st.h>
 #include <cassert>
@@ -258,6 +259,7 @@ ApplyStateTable::apply(
         //        metadata even when the base view is open?
         JLOG(j.trace()) << "metadata " << meta.getJson(JsonOptions::none);
     }
+    applyProfile::countBytes(sTx->size() + (sMeta ? sMeta->size() : 0));
     to.rawTxInsert(tx.getTransactionID(), sTx, sMeta);
     apply(to);
 }
@@ -353,6 +355,7 @@ ApplyStateTable::peek(ReadView const& base, Keylet const& k)
         if (!sle)
             return nullptr;
         // Make our own copy
+        applyProfile::count(applyProfile::copy, sle->getType());
         using namespace std;
         iter = items_.emplace_hint(
             iter,
@@ -19,6 +19,7 @@
 
 #include <ripple/basics/contract.h>
 #include <ripple/ledger/detail/ApplyViewBase.h>
+#include <ripple/protocol/ApplyProfile.h>
 
 namespace ripple {
 namespace detail {
@@ -70,7 +71,8 @@ ApplyViewBase::succ(key_type const& key, std::optional<key_type> const& last)
 std::shared_ptr<SLE const>
 ApplyViewBase::read(Keylet const& k) const
 {
-    return items_.read(*base_, k);
+    return applyProfile::access(
+        applyProfile::read, k, [&] { return items_.read(*base_, k); });
 }
 
 auto
@@ -127,7 +129,8 @@ ApplyViewBase::flags() const
 std::shared_ptr<SLE>
 ApplyViewBase::peek(Keylet const& k)
 {
-    return items_.peek(*base_, k);
+    return applyProfile::access(
+        applyProfile::peek, k, [&] { return items_.peek(*base_, k); });
 }
 
 void
@@ -139,6 +142,7 @@ ApplyViewBase::erase(std::shared_ptr<SLE> const& sle)
 void
 ApplyViewBase::insert(std::shared_ptr<SLE> const& sle)
 {
+    applyProfile::count(applyProfile::insert, sle->getType());
     items_.insert(*base_, sle);
 }
 
@@ -38,19 +38,29 @@ CachedViewImpl::read(Keylet const& k) const
     static CountedObjects::Counter misses{"CachedView::miss"};
     bool cacheHit = false;
     bool baseRead = false;
+    auto& shard = shardFor(k.key);
 
-    auto const digest = [&]() -> std::optional<uint256> {
+    std::optional<uint256> digest;
+    {
+        std::lock_guard lock(shard.mutex);
+        auto const iter = shard.map.find(k.key);
+        if (iter != shard.map.end())
         {
-            std::lock_guard lock(mutex_);
-            auto const iter = map_.find(k.key);
-            if (iter != map_.end())
+            // An entry someone still holds needs no trip to the cache
+            if (auto sle = iter->second.sle.lock())
             {
-                cacheHit = true;
-                return iter->second;
+                if (!k.check(*sle))
+                    LogicError("CachedView::read: wrong type");
+                hits.increment();
+                return sle;
             }
+
+            cacheHit = true;
+            digest = iter->second.digest;
         }
-        return base_.digest(k.key);
-    }();
+    }
+    if (!digest)
+        digest = base_.digest(k.key);
     if (!digest)
         return nullptr;
     auto sle = cache_.fetch(*digest, [&]() {
@@ -63,8 +73,8 @@ CachedViewImpl::read(Keylet const& k) const
         hits.increment();
     else
         misses.increment();
-    std::lock_guard lock(mutex_);
-    auto const er = map_.emplace(k.key, *digest);
+    std::lock_guard lock(shard.mutex);
+    auto const er = shard.map.emplace(k.key, Entry{*digest, {}});
     bool const inserted = er.second;
     if (sle && !k.check(*sle))
     {
@@ -77,6 +87,7 @@ CachedViewImpl::read(Keylet const& k) const
         }
         return nullptr;
     }
+    er.first->second.sle = sle;
     return sle;
 }
 
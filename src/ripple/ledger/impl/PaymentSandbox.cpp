@@ -53,8 +53,8 @@ DeferredCredits::credit(
     assert(!amount.negative());
 
     auto const k = makeKey(sender, receiver, amount.getCurrency());
-    auto i = credits_.find(k);
-    if (i == credits_.end())
+    auto i = credits_.lower_bound(k);
+    if (i == credits_.end() || i->first != k)
     {
         Value v;
 
@@ -71,7 +71,7 @@ DeferredCredits::credit(
             v.lowAcctOrigBalance = -preCreditSenderBalance;
         }
 
-        credits_[k] = v;
+        credits_.emplace_hint(i, k, v);
     }
     else
     {
@@ -141,6 +141,7 @@ DeferredCredits::adjustments(
 void
 DeferredCredits::apply(DeferredCredits& to)
 {
+    to.credits_.reserve(to.credits_.size() + credits_.size());
     for (auto const& i : credits_)
     {
         auto r = to.credits_.emplace(i);
@@ -154,6 +155,7 @@ DeferredCredits::apply(DeferredCredits& to)
         }
     }
 
+    to.ownerCounts_.reserve(to.ownerCounts_.size() + ownerCounts_.size());
     for (auto const& i : ownerCounts_)
     {
         auto r = to.ownerCounts_.emplace(i);
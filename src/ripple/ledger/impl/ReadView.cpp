@@ -21,6 +21,14 @@
 
 namespace ripple {
 
+std::optional<SLEView>
+ReadView::readLazy(Keylet const& k) const
+{
+    if (auto sle = read(k))
+        return SLEView{std::move(sle)};
+    return std::nullopt;
+}
+
 ReadView::sles_type::sles_type(ReadView const& view) : ReadViewFwdRange(view)
 {
 }
@@ -0,0 +1,146 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/ledger/RecordingView.h>
+
+namespace ripple {
+
+namespace {
+
+// Offers, checks, escrows and payment channels can expire, and the fee of an
+// AMM depends on whether its auction slot has expired.
+template <class Entry>
+bool
+dependsOnCloseTime(Entry const& entry)
+{
+    return entry.getType() == ltAMM || entry.isFieldPresent(sfExpiration);
+}
+
+}  // namespace
+
+bool
+RecordingView::Reads::changedBy(std::set<uint256> const& changed) const
+{
+    if (!complete)
+        return true;
+
+    for (auto const& key : keys)
+    {
+        if (changed.count(key))
+            return true;
+    }
+
+    for (auto const& [first, last] : ranges)
+    {
+        if (auto const it = changed.upper_bound(first);
+            it != changed.end() && *it <= last)
+            return true;
+    }
+
+    return false;
+}
+
+bool
+RecordingView::exists(Keylet const& k) const
+{
+    reads_.keys.push_back(k.key);
+    return base_.exists(k);
+}
+
+auto
+RecordingView::succ(key_type const& key, std::optional<key_type> const& last)
+    const -> std::optional<key_type>
+{
+    auto const next = base_.succ(key, last);
+    reads_.ranges.emplace_back(
+        key, next ? *next : last ? *last : ~key_type{});
+    return next;
+}
+
+std::shared_ptr<SLE const>
+RecordingView::read(Keylet const& k) const
+{
+    reads_.keys.push_back(k.key);
+    auto sle = base_.read(k);
+    if (sle && dependsOnCloseTime(*sle))
+        reads_.timed = true;
+    return sle;
+}
+
+std::optional<SLEView>
+RecordingView::readLazy(Keylet const& k) const
+{
+    reads_.keys.push_back(k.key);
+    auto view = base_.readLazy(k);
+    if (view && dependsOnCloseTime(*view))
+        reads_.timed = true;
+    return view;
+}
+
+auto
+RecordingView::slesBegin() const -> std::unique_ptr<sles_type::iter_base>
+{
+    reads_.complete = false;
+    return base_.slesBegin();
+}
+
+auto
+RecordingView::slesEnd() const -> std::unique_ptr<sles_type::iter_base>
+{
+    reads_.complete = false;
+    return base_.slesEnd();
+}
+
+auto
+RecordingView::slesUpperBound(key_type const& key) const
+    -> std::unique_ptr<sles_type::iter_base>
+{
+    reads_.complete = false;
+    return base_.slesUpperBound(key);
+}
+
+auto
+RecordingView::txsBegin() const -> std::unique_ptr<txs_type::iter_base>
+{
+    reads_.complete = false;
+    return base_.txsBegin();
+}
+
+auto
+RecordingView::txsEnd() const -> std::unique_ptr<txs_type::iter_base>
+{
+    reads_.complete = false;
+    return base_.txsEnd();
+}
+
+bool
+RecordingView::txExists(key_type const& key) const
+{
+    reads_.complete = false;
+    return base_.txExists(key);
+}
+
+auto
+RecordingView::txRead(key_type const& key) const -> tx_type
+{
+    reads_.complete = false;
+    return base_.txRead(key);
+}
+
+}  // namespace ripple
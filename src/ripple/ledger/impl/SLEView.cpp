@@ -0,0 +1,216 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/contract.h>
+#include <ripple/ledger/SLEView.h>
+#include <ripple/protocol/impl/STVar.h>
+
+namespace ripple {
+
+// Advance past the value of a field
+static void
+skipSLEViewField(SerialIter& sit, int type, int name)
+{
+    switch (type)
+    {
+        case STI_UINT8:
+            sit.skip(1);
+            return;
+        case STI_UINT16:
+            sit.skip(2);
+            return;
+        case STI_UINT32:
+            sit.skip(4);
+            return;
+        case STI_UINT64:
+            sit.skip(8);
+            return;
+        case STI_UINT128:
+            sit.skip(16);
+            return;
+        case STI_UINT160:
+            sit.skip(20);
+            return;
+        case STI_UINT256:
+            sit.skip(32);
+            return;
+        case STI_AMOUNT:
+            // Issued amounts are followed by their currency and issuer
+            if (sit.get64() & STAmount::cNotNative)
+                sit.skip(40);
+            return;
+        case STI_VL:
+        case STI_ACCOUNT:
+        case STI_VECTOR256:
+            sit.skip(sit.getVLDataLength());
+            return;
+        default:
+            break;
+    }
+
+    // The other kinds of fields are rare and are skipped by deserializing
+    auto const& field = SField::getField(type, name);
+    if (field.isInvalid())
+        Throw<std::runtime_error>("Unknown field");
+    detail::STVar{sit, field};
+}
+
+SLEView::SLEView(std::shared_ptr<SLE const> sle)
+    : sle_(std::move(sle)), type_(sle_->getType())
+{
+}
+
+SLEView::SLEView(boost::intrusive_ptr<SHAMapItem const> item)
+    : item_(std::move(item))
+{
+    // The type is the first field of every entry
+    auto sit = find(sfLedgerEntryType);
+    if (!sit)
+        Throw<std::runtime_error>("Ledger entry without type");
+    type_ = safe_cast<LedgerEntryType>(sit->get16());
+}
+
+uint256 const&
+SLEView::key() const
+{
+    return sle_ ? sle_->key() : item_->key();
+}
+
+std::optional<SerialIter>
+SLEView::find(SField const& field) const
+{
+    SerialIter sit(item_->slice());
+    while (!sit.empty())
+    {
+        int type;
+        int name;
+        sit.getFieldID(type, name);
+
+        auto const code = field_code(type, name);
+        if (code == field.fieldCode)
+            return sit;
+
+        // Fields are serialized in the order of their codes
+        if (code > field.fieldCode)
+            break;
+
+        skipSLEViewField(sit, type, name);
+    }
+    return std::nullopt;
+}
+
+template <class T, class Get>
+T
+SLEView::get(SField const& field, Get&& get) const
+{
+    if (auto sit = find(field))
+        return get(*sit);
+    return T{};
+}
+
+std::uint32_t
+SLEView::getFlags() const
+{
+    return getFieldU32(sfFlags);
+}
+
+bool
+SLEView::isFieldPresent(SField const& field) const
+{
+    if (sle_)
+        return sle_->isFieldPresent(field);
+    return find(field).has_value();
+}
+
+std::uint8_t
+SLEView::getFieldU8(SField const& field) const
+{
+    if (sle_)
+        return sle_->getFieldU8(field);
+    return get<std::uint8_t>(field, [](SerialIter& sit) { return sit.get8(); });
+}
+
+std::uint16_t
+SLEView::getFieldU16(SField const& field) const
+{
+    if (sle_)
+        return sle_->getFieldU16(field);
+    return get<std::uint16_t>(
+        field, [](SerialIter& sit) { return sit.get16(); });
+}
+
+std::uint32_t
+SLEView::getFieldU32(SField const& field) const
+{
+    if (sle_)
+        return sle_->getFieldU32(field);
+    return get<std::uint32_t>(
+        field, [](SerialIter& sit) { return sit.get32(); });
+}
+
+std::uint64_t
+SLEView::getFieldU64(SField const& field) const
+{
+    if (sle_)
+        return sle_->getFieldU64(field);
+    return get<std::uint64_t>(
+        field, [](SerialIter& sit) { return sit.get64(); });
+}
+
+uint256
+SLEView::getFieldH256(SField const& field) const
+{
+    if (sle_)
+        return sle_->getFieldH256(field);
+    return get<uint256>(field, [](SerialIter& sit) { return sit.get256(); });
+}
+
+AccountID
+SLEView::getAccountID(SField const& field) const
+{
+    if (sle_)
+        return sle_->getAccountID(field);
+    return get<AccountID>(field, [](SerialIter& sit) {
+        auto const size = sit.getVLDataLength();
+        if (size == 0)
+            return AccountID{};
+        if (size != AccountID::bytes)
+            Throw<std::runtime_error>("incorrect size for AccountID");
+        return sit.getBitString<160, detail::AccountIDTag>();
+    });
+}
+
+STAmount
+SLEView::getFieldAmount(SField const& field) const
+{
+    if (sle_)
+        return sle_->getFieldAmount(field);
+    return get<STAmount>(
+        field, [&field](SerialIter& sit) { return STAmount{sit, field}; });
+}
+
+std::shared_ptr<SLE const>
+SLEView::sle() const
+{
+    if (sle_)
+        return sle_;
+    return std::make_shared<SLE>(SerialIter{item_->slice()}, item_->key());
+}
+
+}  // namespace ripple
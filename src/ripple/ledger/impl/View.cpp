@@ -172,7 +172,7 @@ isGlobalFrozen(ReadView const& view, AccountID const& issuer)
 {
     if (isXRP(issuer))
         return false;
-    if (auto const sle = view.read(keylet::account(issuer)))
+    if (auto const sle = view.readLazy(keylet::account(issuer)))
         return sle->isFlag(lsfGlobalFreeze);
     return false;
 }
@@ -189,7 +189,8 @@ isIndividualFrozen(
     if (issuer != account)
     {
         // Check if the issuer froze the line
-        auto const sle = view.read(keylet::line(account, issuer, currency));
+        auto const sle =
+            view.readLazy(keylet::line(account, issuer, currency));
         if (sle &&
             sle->isFlag((issuer > account) ? lsfHighFreeze : lsfLowFreeze))
             return true;
@@ -208,13 +209,13 @@ isFrozen(
 {
     if (isXRP(currency))
         return false;
-    auto sle = view.read(keylet::account(issuer));
+    auto sle = view.readLazy(keylet::account(issuer));
     if (sle && sle->isFlag(lsfGlobalFreeze))
         return true;
     if (issuer != account)
     {
         // Check if the issuer froze the line
-        sle = view.read(keylet::line(account, issuer, currency));
+        sle = view.readLazy(keylet::line(account, issuer, currency));
         if (sle &&
             sle->isFlag((issuer > account) ? lsfHighFreeze : lsfLowFreeze))
             return true;
@@ -238,7 +239,7 @@ accountHolds(
     }
 
     // IOU: Return balance on trust line modulo freeze
-    auto const sle = view.read(keylet::line(account, issuer, currency));
+    auto const sle = view.readLazy(keylet::line(account, issuer, currency));
     if (!sle)
     {
         amount.clear({currency, issuer});
@@ -349,8 +350,8 @@ xrpLiquid(
     std::int32_t ownerCountAdj,
     beast::Journal j)
 {
-    auto const sle = view.read(keylet::account(id));
-    if (sle == nullptr)
+    auto const sle = view.readLazy(keylet::account(id));
+    if (!sle)
         return beast::zero;
 
     // Return balance minus reserve
@@ -407,14 +408,17 @@ forEachItem(
     }
 }
 
-bool
-forEachItemAfter(
+// Visit the keys in a directory after a given key.  The visitor returns
+// true for each item that counts toward the limit.
+template <class Visit>
+static bool
+forEachKeyAfter(
     ReadView const& view,
     Keylet const& root,
     uint256 const& after,
     std::uint64_t const hint,
     unsigned int limit,
-    std::function<bool(std::shared_ptr<SLE const> const&)> const& f)
+    Visit const& visit)
 {
     assert(root.type == ltDIR_NODE);
 
@@ -454,7 +458,7 @@ forEachItemAfter(
                     if (key == after)
                         found = true;
                 }
-                else if (f(view.read(keylet::child(key))) && limit-- <= 1)
+                else if (visit(key) && limit-- <= 1)
                 {
                     return found;
                 }
@@ -474,7 +478,7 @@ forEachItemAfter(
             if (!ownerDir)
                 return true;
             for (auto const& key : ownerDir->getFieldV256(sfIndexes))
-                if (f(view.read(keylet::child(key))) && limit-- <= 1)
+                if (visit(key) && limit-- <= 1)
                     return true;
             auto const uNodeNext = ownerDir->getFieldU64(sfIndexNext);
             if (uNodeNext == 0)
@@ -484,10 +488,46 @@ forEachItemAfter(
     }
 }
 
+bool
+forEachItemAfter(
+    ReadView const& view,
+    Keylet const& root,
+    uint256 const& after,
+    std::uint64_t const hint,
+    unsigned int limit,
+    std::function<bool(std::shared_ptr<SLE const> const&)> const& f)
+{
+    return forEachKeyAfter(
+        view, root, after, hint, limit, [&view, &f](uint256 const& key) {
+            return f(view.read(keylet::child(key)));
+        });
+}
+
+bool
+forEachItemAfter(
+    ReadView const& view,
+    Keylet const& root,
+    uint256 const& after,
+    std::uint64_t const hint,
+    unsigned int limit,
+    std::function<bool(SLEView const&)> const& f)
+{
+    return forEachKeyAfter(
+        view, root, after, hint, limit, [&view, &f](uint256 const& key) {
+            auto const item = view.readLazy(keylet::child(key));
+            if (!item)
+            {
+                assert(false);
+                return false;
+            }
+            return f(*item);
+        });
+}
+
 Rate
 transferRate(ReadView const& view, AccountID const& issuer)
 {
-    auto const sle = view.read(keylet::account(issuer));
+    auto const sle = view.readLazy(keylet::account(issuer));
 
     if (sle && sle->isFieldPresent(sfTransferRate))
         return Rate{sle->getFieldU32(sfTransferRate)};
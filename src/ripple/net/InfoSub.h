@@ -22,6 +22,7 @@
 
 #include <ripple/app/misc/Manifest.h>
 #include <ripple/basics/CountedObject.h>
+#include <ripple/json/SharedJson.h>
 #include <ripple/json/json_value.h>
 #include <ripple/protocol/Book.h>
 #include <ripple/protocol/ErrorCodes.h>
@@ -201,6 +202,17 @@ public:
     virtual void
     send(Json::Value const& jvObj, bool broadcast) = 0;
 
+    /** Send a message which is published to many subscribers.
+
+        Subscribers which can send the text shared by all of them override
+        this. The default sends the message as a broadcast.
+    */
+    virtual void
+    publish(SharedJson const& message)
+    {
+        send(message.json(), true);
+    }
+
     std::uint64_t
     getSeq();
 
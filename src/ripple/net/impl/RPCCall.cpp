@@ -987,6 +987,62 @@ private:
         return rpcError(rpcINVALID_PARAMS);
     }
 
+    // apply_profile [clear]
+    Json::Value
+    parseApplyProfile(Json::Value const& jvParams)
+    {
+        Json::Value jvRequest(Json::objectValue);
+
+        if (jvParams.size() == 0)
+            return jvRequest;
+
+        if (jvParams[0u].asString() != "clear")
+            return rpcError(rpcINVALID_PARAMS);
+
+        jvRequest[jss::clear] = true;
+        return jvRequest;
+    }
+
+    // heap_profile [purge|dump]
+    Json::Value
+    parseHeapProfile(Json::Value const& jvParams)
+    {
+        Json::Value jvRequest(Json::objectValue);
+
+        if (jvParams.size() == 0)
+            return jvRequest;
+
+        auto const action = jvParams[0u].asString();
+        if (action == "purge")
+            jvRequest[jss::purge] = true;
+        else if (action == "dump")
+            jvRequest[jss::dump] = true;
+        else
+            return rpcError(rpcINVALID_PARAMS);
+
+        return jvRequest;
+    }
+
+    // trace [start|stop|clear]
+    Json::Value
+    parseTrace(Json::Value const& jvParams)
+    {
+        Json::Value jvRequest(Json::objectValue);
+
+        if (jvParams.size() == 0)
+            return jvRequest;
+
+        auto const action = jvParams[0u].asString();
+        if (action == "start" || action == "stop")
+            jvRequest[jss::enable] = action == "start";
+        else if (action == "clear")
+            jvRequest[jss::clear] = true;
+        else
+            return rpcError(rpcINVALID_PARAMS);
+
+        return jvRequest;
+    }
+
     // transaction_entry <tx_hash> <ledger_hash/ledger_index>
     Json::Value
     parseTransactionEntry(Json::Value const& jvParams)
@@ -1193,6 +1249,7 @@ public:
             {"account_offers", &RPCParser::parseAccountItems, 1, 4},
             {"account_tx", &RPCParser::parseAccountTransactions, 1, 8},
             {"amm_info", &RPCParser::parseAsIs, 1, 2},
+            {"apply_profile", &RPCParser::parseApplyProfile, 0, 1},
             {"book_changes", &RPCParser::parseLedgerId, 1, 1},
             {"book_offers", &RPCParser::parseBookOffers, 2, 7},
             {"can_delete", &RPCParser::parseCanDelete, 0, 1},
@@ -1207,6 +1264,7 @@ public:
             {"fetch_info", &RPCParser::parseFetchInfo, 0, 1},
             {"gateway_balances", &RPCParser::parseGatewayBalances, 1, -1},
             {"get_counts", &RPCParser::parseGetCounts, 0, 1},
+            {"heap_profile", &RPCParser::parseHeapProfile, 0, 1},
             {"json", &RPCParser::parseJson, 2, 2},
             {"json2", &RPCParser::parseJson2, 1, 1},
             {"ledger", &RPCParser::parseLedger, 0, 2},
@@ -1237,6 +1295,7 @@ public:
              1,
              1},
             {"peer_reservations_list", &RPCParser::parseAsIs, 0, 0},
+            {"resource_usage", &RPCParser::parseAsIs, 0, 0},
             {"ripple_path_find", &RPCParser::parseRipplePathFind, 1, 2},
             {"server_definitions", &RPCParser::parseServerDefinitions, 0, 1},
             {"server_info", &RPCParser::parseServerInfo, 0, 1},
@@ -1246,6 +1305,7 @@ public:
             {"stop", &RPCParser::parseAsIs, 0, 0},
             {"submit", &RPCParser::parseSignSubmit, 1, 3},
             {"submit_multisigned", &RPCParser::parseSubmitMultiSigned, 1, 1},
+            {"trace", &RPCParser::parseTrace, 0, 1},
             {"transaction_entry", &RPCParser::parseTransactionEntry, 2, 2},
             {"tx", &RPCParser::parseTx, 1, 4},
             {"tx_history", &RPCParser::parseTxHistory, 1, 1},
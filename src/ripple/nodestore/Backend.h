@@ -20,6 +20,7 @@
 #ifndef RIPPLE_NODESTORE_BACKEND_H_INCLUDED
 #define RIPPLE_NODESTORE_BACKEND_H_INCLUDED
 
+#include <ripple/json/json_value.h>
 #include <ripple/nodestore/Types.h>
 #include <atomic>
 #include <cstdint>
@@ -185,6 +186,15 @@ public:
     {
         return std::nullopt;
     }
+
+    /** Add statistics specific to the backend to a JSON object.
+
+        The default adds nothing.
+    */
+    virtual void
+    getCountsJson(Json::Value& obj) const
+    {
+    }
 };
 
 }  // namespace NodeStore
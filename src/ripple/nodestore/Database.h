@@ -22,6 +22,7 @@
 
 #include <ripple/basics/TaggedCache.h>
 #include <ripple/nodestore/Backend.h>
+#include <ripple/nodestore/FetchSuspender.h>
 #include <ripple/nodestore/NodeObject.h>
 #include <ripple/nodestore/Scheduler.h>
 #include <ripple/protocol/SystemParameters.h>
@@ -131,6 +132,9 @@ public:
         database during the fetch, or failed to load correctly during the fetch,
         `nullptr` is returned.
 
+        A synchronous fetch made by work which installed a FetchSuspender
+        suspends that work until the read threads have made the fetch.
+
         @note This can be called concurrently.
         @param hash The key of the object to retrieve.
         @param ledgerSeq The sequence of the ledger where the object is stored.
@@ -343,7 +347,9 @@ protected:
 
     // Called by the public storeLedger function
     bool
-    storeLedger(Ledger const& srcLedger, std::shared_ptr<Backend> dstBackend);
+    storeLedger(
+        std::shared_ptr<Ledger const> const& srcLedger,
+        std::shared_ptr<Backend> dstBackend);
 
     void
     updateFetchMetrics(uint64_t fetches, uint64_t hits, uint64_t duration)
@@ -353,6 +359,13 @@ protected:
         fetchDurationUs_ += duration;
     }
 
+    // Account for the results of fetchNodeObjects as if each object had
+    // been fetched asynchronously on its own.
+    void
+    batchFetchStats(
+        std::vector<std::shared_ptr<NodeObject>> const& objects,
+        std::chrono::steady_clock::duration elapsed);
+
 private:
     std::atomic<std::uint64_t> storeCount_{0};
     std::atomic<std::uint64_t> storeSz_{0};
@@ -360,6 +373,13 @@ private:
     std::atomic<std::uint64_t> fetchDurationUs_{0};
     std::atomic<std::uint64_t> storeDurationUs_{0};
 
+    // The ledger most recently copied by storeLedger, and the backend it
+    // was copied to.  Copying another ledger to the same backend only
+    // needs the nodes that differ from it.
+    std::mutex storedLock_;
+    std::weak_ptr<Backend> storedBackend_;
+    std::shared_ptr<Ledger const> storedLedger_;
+
     mutable std::mutex readLock_;
     std::condition_variable readCondVar_;
 
@@ -375,6 +395,12 @@ private:
     std::atomic<int> readThreads_ = 0;
     std::atomic<int> runningThreads_ = 0;
 
+    std::shared_ptr<NodeObject>
+    fetchSuspended(
+        uint256 const& hash,
+        std::uint32_t ledgerSeq,
+        FetchSuspender& suspender);
+
     virtual std::shared_ptr<NodeObject>
     fetchNodeObject(
         uint256 const& hash,
@@ -382,6 +408,21 @@ private:
         FetchReport& fetchReport,
         bool duplicate) = 0;
 
+    /** Fetch several objects on behalf of the read threads.
+
+        The default implementation fetches each object on its own.
+        Databases whose backends can look up many keys in one call
+        override this to do so.
+
+        @param requests The hash of each object and the sequence of the
+                        ledger it belongs to.
+        @return One entry per request, `nullptr` if the object could not
+                be retrieved.
+    */
+    virtual std::vector<std::shared_ptr<NodeObject>>
+    fetchNodeObjects(
+        std::vector<std::pair<uint256, std::uint32_t>> const& requests);
+
     /** Visit every object in the database
         This is usually called during import.
 
@@ -403,6 +444,13 @@ private:
         return std::nullopt;
     }
 
+    /** Add the statistics specific to the backend in use to a JSON object.
+     */
+    virtual void
+    getBackendCountsJson(Json::Value& obj) const
+    {
+    }
+
     void
     threadEntry();
 };
@@ -0,0 +1,75 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_NODESTORE_FETCHSUSPENDER_H_INCLUDED
+#define RIPPLE_NODESTORE_FETCHSUSPENDER_H_INCLUDED
+
+namespace ripple {
+namespace NodeStore {
+
+/** Lets work wait for a fetch without blocking the thread it runs on.
+
+    While a suspender is installed with Scope, synchronous fetches made by
+    the installing coroutine are handed to the read threads with
+    Database::asyncFetch. The work is suspended until the fetch completes,
+    so that its thread can run other work meanwhile.
+
+    The suspender is kept with the coroutine's local values, so it follows
+    the work from thread to thread, and fetches made by other work on the
+    same thread are not affected.
+*/
+class FetchSuspender
+{
+public:
+    virtual ~FetchSuspender() = default;
+
+    /** Suspend the calling work until resume is called. */
+    virtual void
+    suspend() = 0;
+
+    /** Resume the work. Called once per suspend, from another thread,
+        possibly before the work has suspended.
+    */
+    virtual void
+    resume() = 0;
+
+    /** Returns the suspender installed by the calling work, if any. */
+    static FetchSuspender*
+    current();
+
+    /** Installs a suspender for the lifetime of the scope. */
+    class Scope
+    {
+    public:
+        explicit Scope(FetchSuspender& suspender);
+        ~Scope();
+
+        Scope(Scope const&) = delete;
+        Scope&
+        operator=(Scope const&) = delete;
+
+    private:
+        FetchSuspender* saved_;
+    };
+};
+
+}  // namespace NodeStore
+}  // namespace ripple
+
+#endif
@@ -22,6 +22,7 @@
 
 #include <ripple/basics/Blob.h>
 #include <ripple/basics/CountedObject.h>
+#include <ripple/basics/Slice.h>
 #include <ripple/protocol/Protocol.h>
 
 // VFALCO NOTE Intentionally not in the NodeStore namespace
@@ -43,6 +44,10 @@ enum NodeObjectType : std::uint32_t {
     the blob. The blob is a variable length block of serialized data. The
     type identifies what the blob contains.
 
+    The blob is kept in the same allocation as the object and its reference
+    count, so that each of the many objects held by the caches costs a
+    single allocation.
+
     @note No checking is performed to make sure the hash matches the data.
     @see SHAMap
 */
@@ -60,14 +65,36 @@ private:
         explicit PrivateAccess() = default;
     };
 
+    // Where the blob is copied to, or the Blob holding it is moved to,
+    // just past the storage that make_shared allocates for the object.
+    // Set when that storage is allocated.
+    struct Trailer
+    {
+        std::size_t bytes;
+        std::uint8_t* buffer = nullptr;
+    };
+
+    template <class T>
+    struct TrailingAllocator;
+
 public:
     // This constructor is private, use createObject instead.
     NodeObject(
         NodeObjectType type,
-        Blob&& data,
         uint256 const& hash,
+        Trailer const& trailer,
+        PrivateAccess);
+
+    // This constructor is private, use createObject instead.
+    NodeObject(
+        NodeObjectType type,
+        uint256 const& hash,
+        Blob&& data,
+        Trailer const& trailer,
         PrivateAccess);
 
+    ~NodeObject();
+
     /** Create an object from fields.
 
         The caller's variable is modified during this call. The
@@ -82,6 +109,37 @@ public:
     static std::shared_ptr<NodeObject>
     createObject(NodeObjectType type, Blob&& data, uint256 const& hash);
 
+    /** Create an object from fields, copying the payload.
+
+        @param type The type of object.
+        @param data The payload.
+        @param hash The 256-bit hash of the payload data.
+    */
+    static std::shared_ptr<NodeObject>
+    createObject(NodeObjectType type, Slice data, uint256 const& hash);
+
+    /** Create an object whose payload is written in place.
+
+        @param type The type of object.
+        @param size The number of bytes in the payload.
+        @param hash The 256-bit hash of the payload data.
+        @param fill Called with the object's `size` byte buffer, must
+                    write the whole payload.
+    */
+    template <class Fill>
+    static std::shared_ptr<NodeObject>
+    createObject(
+        NodeObjectType type,
+        std::size_t size,
+        uint256 const& hash,
+        Fill&& fill)
+    {
+        std::uint8_t* buffer;
+        auto object = allocate(type, size, hash, buffer);
+        fill(buffer);
+        return object;
+    }
+
     /** Returns the type of this object. */
     NodeObjectType
     getType() const;
@@ -91,13 +149,24 @@ public:
     getHash() const;
 
     /** Returns the underlying data. */
-    Blob const&
+    Slice
     getData() const;
 
 private:
-    NodeObjectType const mType;
+    // Returns an object with room for size bytes of payload at buffer
+    static std::shared_ptr<NodeObject>
+    allocate(
+        NodeObjectType type,
+        std::size_t size,
+        uint256 const& hash,
+        std::uint8_t*& buffer);
+
     uint256 const mHash;
-    Blob const mData;
+    NodeObjectType const mType;
+    std::uint32_t const mSize;
+    std::uint8_t const* const mData;
+    // The Blob taken over by the object, if it was created from one
+    Blob* const mBlob;
 };
 
 }  // namespace ripple
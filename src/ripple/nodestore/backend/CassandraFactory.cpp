@@ -35,6 +35,7 @@
 #include <ripple/protocol/digest.h>
 #include <boost/asio/steady_timer.hpp>
 #include <boost/filesystem.hpp>
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <chrono>
@@ -44,6 +45,7 @@
 #include <cstring>
 #include <exception>
 #include <fstream>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <nudb/nudb.hpp>
@@ -59,7 +61,95 @@ namespace NodeStore {
 void
 writeCallback(CassFuture* fut, void* cbData);
 void
+batchWriteCallback(CassFuture* fut, void* cbData);
+void
 readCallback(CassFuture* fut, void* cbData);
+void
+readManyCallback(CassFuture* fut, void* cbData);
+
+// The token Cassandra's default Murmur3 partitioner assigns to a partition
+// key. Keys with nearby tokens are owned by the same replicas, so requests
+// for them are grouped together
+std::int64_t
+cassandraToken(void const* key, std::size_t size)
+{
+    auto const rotl = [](std::uint64_t x, int r) {
+        return (x << r) | (x >> (64 - r));
+    };
+    auto const fmix = [](std::uint64_t k) {
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccdULL;
+        k ^= k >> 33;
+        k *= 0xc4ceb9fe1a85ec53ULL;
+        k ^= k >> 33;
+        return k;
+    };
+    std::uint64_t const c1 = 0x87c37b91114253d5ULL;
+    std::uint64_t const c2 = 0x4cf5ad432745937fULL;
+
+    auto const* data = static_cast<std::uint8_t const*>(key);
+    auto const block = [data](std::size_t offset) {
+        std::uint64_t k = 0;
+        for (std::size_t i = 8; i > 0; --i)
+            k = (k << 8) | data[offset + i - 1];
+        return k;
+    };
+
+    std::uint64_t h1 = 0;
+    std::uint64_t h2 = 0;
+    std::size_t const blocks = size / 16;
+    for (std::size_t i = 0; i < blocks; ++i)
+    {
+        std::uint64_t k1 = block(i * 16);
+        std::uint64_t k2 = block(i * 16 + 8);
+
+        k1 *= c1;
+        k1 = rotl(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+        h1 = rotl(h1, 27);
+        h1 += h2;
+        h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= c2;
+        k2 = rotl(k2, 33);
+        k2 *= c1;
+        h2 ^= k2;
+        h2 = rotl(h2, 31);
+        h2 += h1;
+        h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    // Cassandra sign extends the trailing bytes
+    auto const* tail = data + blocks * 16;
+    auto const byte = [tail](std::size_t i) {
+        return static_cast<std::uint64_t>(
+            static_cast<std::int64_t>(static_cast<std::int8_t>(tail[i])));
+    };
+    std::uint64_t k1 = 0;
+    std::uint64_t k2 = 0;
+    for (std::size_t i = size & 15; i > 8; --i)
+        k2 ^= byte(i - 1) << ((i - 9) * 8);
+    for (std::size_t i = std::min<std::size_t>(size & 15, 8); i > 0; --i)
+        k1 ^= byte(i - 1) << ((i - 1) * 8);
+    k2 *= c2;
+    k2 = rotl(k2, 33);
+    k2 *= c1;
+    h2 ^= k2;
+    k1 *= c1;
+    k1 = rotl(k1, 31);
+    k1 *= c2;
+    h1 ^= k1;
+
+    h1 ^= size;
+    h2 ^= size;
+    h1 += h2;
+    h2 += h1;
+    h1 = fmix(h1);
+    h2 = fmix(h2);
+    h1 += h2;
+    return static_cast<std::int64_t>(h1);
+}
 
 class CassandraBackend : public Backend
 {
@@ -107,6 +197,7 @@ private:
     // than making a new statement
     const CassPrepared* insert_ = nullptr;
     const CassPrepared* select_ = nullptr;
+    const CassPrepared* selectMany_ = nullptr;
 
     // io_context used for exponential backoff for write retries
     boost::asio::io_context ioContext_;
@@ -118,6 +209,25 @@ private:
     uint32_t maxRequestsOutstanding = 10000000;
     std::atomic_uint32_t numRequestsOutstanding_ = 0;
 
+    // current limit on in flight requests. It is halved when writes time out
+    // or take longer than targetWriteLatency_, and grows back towards
+    // maxRequestsOutstanding as writes succeed
+    std::atomic_uint32_t requestLimit_ = 10000000;
+    std::chrono::microseconds targetWriteLatency_{0};
+    std::chrono::steady_clock::time_point lastBackoff_;
+
+    // number of writes sent to Cassandra in one unlogged batch statement.
+    // Writes are held back until a batch is full, or until sync() is called
+    std::size_t batchSize_ = 1;
+    // pending writes are grouped by the token range of their key, so the
+    // writes of one batch are owned by the same replicas
+    std::size_t tokenRanges_ = 1;
+    std::mutex batchMutex_;
+    std::vector<std::vector<std::shared_ptr<NodeObject>>> batches_;
+
+    // number of keys read by a single statement in fetchBatch
+    std::size_t readBatchSize_ = 1;
+
     // mutex and condition_variable to limit the number of concurrent in flight
     // requests
     std::mutex throttleMutex_;
@@ -252,6 +362,18 @@ public:
         unsigned int const ioThreads = get<int>(config_, "io_threads", 4);
         maxRequestsOutstanding =
             get<int>(config_, "max_requests_outstanding", 10000000);
+        requestLimit_ = maxRequestsOutstanding;
+        targetWriteLatency_ = std::chrono::milliseconds(
+            std::max(get<int>(config_, "target_write_latency", 0), 0));
+        batchSize_ = std::max(get<int>(config_, "batch_size", 1), 1);
+        tokenRanges_ =
+            std::clamp(get<int>(config_, "batch_token_ranges", 64), 1, 65536);
+        batches_.resize(tokenRanges_);
+        readBatchSize_ = std::max(get<int>(config_, "read_batch_size", 1), 1);
+        JLOG(j_.info()) << "Writing to Cassandra in batches of " << batchSize_
+                        << " over " << tokenRanges_
+                        << " token ranges, reading in batches of "
+                        << readBatchSize_;
         JLOG(j_.info()) << "Configuring Cassandra driver to use " << ioThreads
                         << " IO threads. Capping maximum pending requests at "
                         << maxRequestsOutstanding;
@@ -405,18 +527,13 @@ public:
 
         cass_cluster_free(cluster);
 
-        bool setupPreparedStatements = false;
-        while (!setupPreparedStatements)
-        {
-            std::this_thread::sleep_for(std::chrono::seconds(1));
-            std::stringstream query;
-            query << "INSERT INTO " << tableName
-                  << " (hash, object) VALUES (?, ?)";
+        // Statements are prepared once per session and shared by all requests
+        auto prepare = [this](std::string const& query) -> CassPrepared const* {
             CassFuture* prepare_future =
-                cass_session_prepare(session_.get(), query.str().c_str());
+                cass_session_prepare(session_.get(), query.c_str());
 
             /* Wait for the statement to prepare and get the result */
-            rc = cass_future_error_code(prepare_future);
+            CassError rc = cass_future_error_code(prepare_future);
 
             if (rc != CASS_OK)
             {
@@ -424,48 +541,37 @@ public:
                 cass_future_free(prepare_future);
 
                 std::stringstream ss;
-                ss << "nodestore: Error preparing insert : " << rc << ", "
-                   << cass_error_desc(rc);
+                ss << "nodestore: Error preparing " << query << " : " << rc
+                   << ", " << cass_error_desc(rc);
                 JLOG(j_.error()) << ss.str();
-                continue;
+                return nullptr;
             }
 
             /* Get the prepared object from the future */
-            insert_ = cass_future_get_prepared(prepare_future);
+            CassPrepared const* prepared =
+                cass_future_get_prepared(prepare_future);
 
             /* The future can be freed immediately after getting the prepared
              * object
              */
             cass_future_free(prepare_future);
+            return prepared;
+        };
 
-            query.str("");
-            query << "SELECT object FROM " << tableName << " WHERE hash = ?";
-            prepare_future =
-                cass_session_prepare(session_.get(), query.str().c_str());
-
-            /* Wait for the statement to prepare and get the result */
-            rc = cass_future_error_code(prepare_future);
-
-            if (rc != CASS_OK)
-            {
-                /* Handle error */
-                cass_future_free(prepare_future);
-
-                std::stringstream ss;
-                ss << "nodestore: Error preparing select : " << rc << ", "
-                   << cass_error_desc(rc);
-                JLOG(j_.error()) << ss.str();
-                continue;
-            }
-
-            /* Get the prepared object from the future */
-            select_ = cass_future_get_prepared(prepare_future);
-
-            /* The future can be freed immediately after getting the prepared
-             * object
-             */
-            cass_future_free(prepare_future);
-            setupPreparedStatements = true;
+        while (!insert_ || !select_ || !selectMany_)
+        {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            if (!insert_)
+                insert_ = prepare(
+                    "INSERT INTO " + tableName +
+                    " (hash, object) VALUES (?, ?)");
+            if (!select_)
+                select_ = prepare(
+                    "SELECT object FROM " + tableName + " WHERE hash = ?");
+            if (!selectMany_)
+                selectMany_ = prepare(
+                    "SELECT hash, object FROM " + tableName +
+                    " WHERE hash IN ?");
         }
 
         work_.emplace(ioContext_);
@@ -489,6 +595,11 @@ public:
                 cass_prepared_free(select_);
                 select_ = nullptr;
             }
+            if (selectMany_)
+            {
+                cass_prepared_free(selectMany_);
+                selectMany_ = nullptr;
+            }
             work_.reset();
             ioThread_.join();
         }
@@ -502,6 +613,9 @@ public:
     Status
     fetch(void const* key, std::shared_ptr<NodeObject>* pno) override
     {
+        if ((*pno = findUnwritten(uint256::fromVoid(key))))
+            return ok;
+
         JLOG(j_.trace()) << "Fetching from cassandra";
         CassStatement* statement = cass_prepared_bind(select_);
         cass_statement_set_consistency(statement, CASS_CONSISTENCY_QUORUM);
@@ -556,12 +670,10 @@ public:
         }
 
         nudb::detail::buffer bf;
-        std::pair<void const*, std::size_t> uncompressed =
-            nodeobject_decompress(buf, bufSize, bf);
-        DecodedBlob decoded(key, uncompressed.first, uncompressed.second);
+        *pno = nodeobject_decode(key, buf, bufSize, bf);
         cass_result_free(res);
 
-        if (!decoded.wasOk())
+        if (!*pno)
         {
             pno->reset();
             JLOG(j_.error()) << "Cassandra error decoding result: " << rc
@@ -569,7 +681,6 @@ public:
             ++counters_.readErrors;
             return dataCorrupt;
         }
-        *pno = decoded.createObject();
         return ok;
     }
 
@@ -602,9 +713,131 @@ public:
         ReadCallbackData(ReadCallbackData const& other) = default;
     };
 
+    struct MultiReadCallbackData
+    {
+        CassandraBackend& backend;
+        // sorted keys to read, and the object found for each of them
+        std::vector<uint256> keys;
+        std::vector<std::shared_ptr<NodeObject>> results;
+
+        std::mutex& mtx;
+        std::condition_variable& cv;
+        std::atomic_uint32_t& numFinished;
+        size_t numReads;
+
+        void
+        finish()
+        {
+            std::lock_guard lock(mtx);
+            if (++numFinished == numReads)
+                cv.notify_all();
+        }
+    };
+
+    // Read the objects of several keys with one statement each for groups of
+    // up to readBatchSize_ keys from the same token range. Duplicate keys are
+    // only read once
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchCoalesced(std::vector<uint256 const*> const& hashes)
+    {
+        std::map<uint256, std::vector<std::size_t>> positions;
+        for (std::size_t i = 0; i < hashes.size(); ++i)
+            positions[*hashes[i]].push_back(i);
+
+        std::vector<std::vector<uint256>> groups(tokenRanges_);
+        for (auto const& [hash, _] : positions)
+            groups[tokenRange(hash)].push_back(hash);
+
+        std::atomic_uint32_t numFinished = 0;
+        std::condition_variable cv;
+        std::mutex mtx;
+        std::vector<std::unique_ptr<MultiReadCallbackData>> cbs;
+        for (auto const& group : groups)
+        {
+            for (std::size_t i = 0; i < group.size(); i += readBatchSize_)
+            {
+                auto const end = std::min(group.size(), i + readBatchSize_);
+                cbs.push_back(std::make_unique<MultiReadCallbackData>(
+                    MultiReadCallbackData{
+                        *this,
+                        {group.begin() + i, group.begin() + end},
+                        std::vector<std::shared_ptr<NodeObject>>(end - i),
+                        mtx,
+                        cv,
+                        numFinished,
+                        0}));
+            }
+        }
+        for (auto& cb : cbs)
+            cb->numReads = cbs.size();
+        for (auto& cb : cbs)
+            readMany(*cb);
+
+        {
+            std::unique_lock<std::mutex> lck(mtx);
+            cv.wait(lck, [&numFinished, &cbs]() {
+                return numFinished == cbs.size();
+            });
+        }
+
+        std::vector<std::shared_ptr<NodeObject>> results{hashes.size()};
+        for (auto const& cb : cbs)
+        {
+            for (std::size_t i = 0; i < cb->keys.size(); ++i)
+            {
+                for (auto const pos : positions[cb->keys[i]])
+                    results[pos] = cb->results[i];
+            }
+        }
+        return results;
+    }
+
+    void
+    readMany(MultiReadCallbackData& data)
+    {
+        CassStatement* statement = cass_prepared_bind(selectMany_);
+        cass_statement_set_consistency(statement, CASS_CONSISTENCY_QUORUM);
+        CassCollection* keys =
+            cass_collection_new(CASS_COLLECTION_TYPE_LIST, data.keys.size());
+        for (auto const& key : data.keys)
+            cass_collection_append_bytes(
+                keys, static_cast<cass_byte_t const*>(key.data()), keyBytes_);
+        CassError rc = cass_statement_bind_collection(statement, 0, keys);
+        cass_collection_free(keys);
+        if (rc != CASS_OK)
+        {
+            cass_statement_free(statement);
+            JLOG(j_.error()) << "Binding Cassandra fetch query: " << rc << ", "
+                             << cass_error_desc(rc);
+            data.finish();
+            return;
+        }
+
+        CassFuture* fut = cass_session_execute(session_.get(), statement);
+
+        cass_statement_free(statement);
+
+        cass_future_set_callback(
+            fut, readManyCallback, static_cast<void*>(&data));
+        cass_future_free(fut);
+    }
+
     std::pair<std::vector<std::shared_ptr<NodeObject>>, Status>
     fetchBatch(std::vector<uint256 const*> const& hashes) override
     {
+        if (readBatchSize_ > 1)
+        {
+            JLOG(j_.trace()) << "Fetching " << hashes.size()
+                             << " records from Cassandra";
+            auto results = fetchCoalesced(hashes);
+            for (std::size_t i = 0; i < hashes.size(); ++i)
+            {
+                if (!results[i])
+                    results[i] = findUnwritten(*hashes[i]);
+            }
+            return {results, ok};
+        }
+
         std::size_t const numHashes = hashes.size();
         JLOG(j_.trace()) << "Fetching " << numHashes
                          << " records from Cassandra";
@@ -632,11 +865,48 @@ public:
             return numFinished == numHashes;
         });
 
+        for (std::size_t i = 0; i < numHashes; ++i)
+        {
+            if (!results[i])
+                results[i] = findUnwritten(*hashes[i]);
+        }
+
         JLOG(j_.trace()) << "Fetched " << numHashes
                          << " records from Cassandra";
         return {results, ok};
     }
 
+    // Find an object held back for a batch that has not been sent yet
+    std::shared_ptr<NodeObject>
+    findUnwritten(uint256 const& hash)
+    {
+        if (batchSize_ <= 1)
+            return {};
+
+        auto const range = tokenRange(hash);
+        std::lock_guard lock(batchMutex_);
+        for (auto const& no : batches_[range])
+        {
+            if (no->getHash() == hash)
+                return no;
+        }
+        return {};
+    }
+
+    // The token range a key belongs to, out of tokenRanges_ equal ranges
+    std::size_t
+    tokenRange(uint256 const& hash) const
+    {
+        if (tokenRanges_ == 1)
+            return 0;
+
+        // Map the signed token onto [0, 2^64) keeping its order
+        auto const token =
+            static_cast<std::uint64_t>(cassandraToken(hash.data(), keyBytes_)) ^
+            (std::uint64_t{1} << 63);
+        return static_cast<std::size_t>(((token >> 32) * tokenRanges_) >> 32);
+    }
+
     void
     read(ReadCallbackData& data)
     {
@@ -693,30 +963,88 @@ public:
         }
     };
 
+    struct BatchWriteCallbackData
+    {
+        CassandraBackend* backend;
+        std::vector<std::unique_ptr<WriteCallbackData>> writes;
+        std::chrono::steady_clock::time_point begin;
+        uint32_t currentRetries = 0;
+    };
+
     void
-    write(WriteCallbackData& data, bool isRetry)
+    throttle(bool isRetry)
     {
+        // We limit the total number of concurrent inflight writes. This is
+        // a client side throttling to prevent overloading the database.
+        // This is mostly useful when the very first ledger is being written
+        // in full, which is several millions records. On sufficiently large
+        // Cassandra clusters, this throttling is not needed; the default
+        // value of maxRequestsOutstanding is 10 million, which is more
+        // records than are present in any single ledger
+        std::unique_lock<std::mutex> lck(throttleMutex_);
+        if (!isRetry && numRequestsOutstanding_ > requestLimit_)
         {
-            // We limit the total number of concurrent inflight writes. This is
-            // a client side throttling to prevent overloading the database.
-            // This is mostly useful when the very first ledger is being written
-            // in full, which is several millions records. On sufficiently large
-            // Cassandra clusters, this throttling is not needed; the default
-            // value of maxRequestsOutstanding is 10 million, which is more
-            // records than are present in any single ledger
-            std::unique_lock<std::mutex> lck(throttleMutex_);
-            if (!isRetry && numRequestsOutstanding_ > maxRequestsOutstanding)
-            {
-                JLOG(j_.trace()) << __func__ << " : "
-                                 << "Max outstanding requests reached. "
-                                 << "Waiting for other requests to finish";
-                ++counters_.writesDelayed;
-                throttleCv_.wait(lck, [this]() {
-                    return numRequestsOutstanding_ < maxRequestsOutstanding;
-                });
-            }
+            JLOG(j_.trace()) << __func__ << " : "
+                             << "Max outstanding requests reached. "
+                             << "Waiting for other requests to finish";
+            ++counters_.writesDelayed;
+            throttleCv_.wait(lck, [this]() {
+                return numRequestsOutstanding_ < requestLimit_;
+            });
         }
+    }
 
+    // Adjust the limit on in flight requests after a write completed.
+    // Writes that failed because the cluster is overloaded, or that took
+    // longer than the target latency, halve the limit. Other writes grow it
+    // back by the number of objects written
+    void
+    adaptRequestLimit(
+        CassError rc,
+        std::size_t writes,
+        std::chrono::microseconds latency)
+    {
+        bool const overloaded = rc == CASS_ERROR_LIB_REQUEST_TIMED_OUT ||
+            rc == CASS_ERROR_LIB_REQUEST_QUEUE_FULL ||
+            rc == CASS_ERROR_SERVER_WRITE_TIMEOUT ||
+            rc == CASS_ERROR_SERVER_OVERLOADED ||
+            (rc == CASS_OK && targetWriteLatency_.count() != 0 &&
+             latency > targetWriteLatency_);
+
+        if (!overloaded)
+        {
+            if (rc != CASS_OK)
+                return;
+            auto limit = requestLimit_.load();
+            while (limit < maxRequestsOutstanding &&
+                   !requestLimit_.compare_exchange_weak(
+                       limit,
+                       static_cast<std::uint32_t>(std::min<std::uint64_t>(
+                           std::uint64_t{limit} + writes,
+                           maxRequestsOutstanding))))
+                ;
+            return;
+        }
+
+        // Back off at most once per interval, so the writes already in
+        // flight when the cluster became overloaded only count once
+        using namespace std::chrono_literals;
+        std::uint32_t const minimum =
+            std::min<std::uint32_t>(64, maxRequestsOutstanding);
+        auto const now = std::chrono::steady_clock::now();
+        std::lock_guard lock(throttleMutex_);
+        if (now - lastBackoff_ < 100ms)
+            return;
+        lastBackoff_ = now;
+        requestLimit_ = std::max(minimum, requestLimit_ / 2);
+        JLOG(j_.warn()) << "Cassandra is overloaded. Limiting outstanding "
+                        << "requests to " << requestLimit_;
+    }
+
+    // Bind an insert statement for one write. The caller frees it
+    CassStatement*
+    bindInsert(WriteCallbackData& data)
+    {
         CassStatement* statement = cass_prepared_bind(insert_);
         cass_statement_set_consistency(statement, CASS_CONSISTENCY_QUORUM);
         CassError rc = cass_statement_bind_bytes(
@@ -747,6 +1075,15 @@ public:
             JLOG(j_.error()) << __func__ << " : " << ss.str();
             Throw<std::runtime_error>(ss.str());
         }
+        return statement;
+    }
+
+    void
+    write(WriteCallbackData& data, bool isRetry)
+    {
+        throttle(isRetry);
+
+        CassStatement* statement = bindInsert(data);
         data.begin = std::chrono::steady_clock::now();
         CassFuture* fut = cass_session_execute(session_.get(), statement);
         cass_statement_free(statement);
@@ -755,9 +1092,73 @@ public:
         cass_future_free(fut);
     }
 
+    void
+    write(BatchWriteCallbackData& data, bool isRetry)
+    {
+        throttle(isRetry);
+
+        CassBatch* batch = cass_batch_new(CASS_BATCH_TYPE_UNLOGGED);
+        cass_batch_set_consistency(batch, CASS_CONSISTENCY_QUORUM);
+        try
+        {
+            for (auto const& w : data.writes)
+            {
+                CassStatement* statement = bindInsert(*w);
+                cass_batch_add_statement(batch, statement);
+                cass_statement_free(statement);
+            }
+        }
+        catch (...)
+        {
+            cass_batch_free(batch);
+            throw;
+        }
+        data.begin = std::chrono::steady_clock::now();
+        CassFuture* fut = cass_session_execute_batch(session_.get(), batch);
+        cass_batch_free(batch);
+
+        cass_future_set_callback(
+            fut, batchWriteCallback, static_cast<void*>(&data));
+        cass_future_free(fut);
+    }
+
+    void
+    writeBatch(std::vector<std::shared_ptr<NodeObject>> const& objects)
+    {
+        if (objects.empty())
+            return;
+
+        JLOG(j_.trace()) << "Writing a batch of " << objects.size()
+                         << " to cassandra";
+        auto* data = new BatchWriteCallbackData{this, {}, {}};
+        data->writes.reserve(objects.size());
+        for (auto const& no : objects)
+            data->writes.push_back(std::make_unique<WriteCallbackData>(
+                this, no, counters_.writeRetries));
+
+        numRequestsOutstanding_ += objects.size();
+        write(*data, false);
+    }
+
     void
     store(std::shared_ptr<NodeObject> const& no) override
     {
+        if (batchSize_ > 1)
+        {
+            auto const range = tokenRange(no->getHash());
+            std::vector<std::shared_ptr<NodeObject>> full;
+            {
+                std::lock_guard lock(batchMutex_);
+                auto& pending = batches_[range];
+                pending.push_back(no);
+                if (pending.size() < batchSize_)
+                    return;
+                full.swap(pending);
+            }
+            writeBatch(full);
+            return;
+        }
+
         JLOG(j_.trace()) << "Writing to cassandra";
         WriteCallbackData* data =
             new WriteCallbackData(this, no, counters_.writeRetries);
@@ -769,6 +1170,24 @@ public:
     void
     storeBatch(Batch const& batch) override
     {
+        if (batchSize_ > 1)
+        {
+            std::vector<std::vector<std::shared_ptr<NodeObject>>> groups(
+                tokenRanges_);
+            for (auto const& no : batch)
+                groups[tokenRange(no->getHash())].push_back(no);
+
+            for (auto const& group : groups)
+            {
+                for (std::size_t i = 0; i < group.size(); i += batchSize_)
+                {
+                    auto const end = std::min(group.size(), i + batchSize_);
+                    writeBatch({group.begin() + i, group.begin() + end});
+                }
+            }
+            return;
+        }
+
         for (auto const& no : batch)
         {
             store(no);
@@ -778,6 +1197,19 @@ public:
     void
     sync() override
     {
+        if (batchSize_ > 1)
+        {
+            std::vector<std::vector<std::shared_ptr<NodeObject>>> partial(
+                tokenRanges_);
+            {
+                std::lock_guard lock(batchMutex_);
+                partial.swap(batches_);
+                batches_.resize(tokenRanges_);
+            }
+            for (auto const& objects : partial)
+                writeBatch(objects);
+        }
+
         std::unique_lock<std::mutex> lck(syncMutex_);
 
         syncCv_.wait(lck, [this]() { return numRequestsOutstanding_ == 0; });
@@ -819,8 +1251,14 @@ public:
     friend void
     writeCallback(CassFuture* fut, void* cbData);
 
+    friend void
+    batchWriteCallback(CassFuture* fut, void* cbData);
+
     friend void
     readCallback(CassFuture* fut, void* cbData);
+
+    friend void
+    readManyCallback(CassFuture* fut, void* cbData);
 };
 
 // Process the result of an asynchronous read. Retry on error
@@ -880,13 +1318,11 @@ readCallback(CassFuture* fut, void* cbData)
             return;
         }
         nudb::detail::buffer bf;
-        std::pair<void const*, std::size_t> uncompressed =
-            nodeobject_decompress(buf, bufSize, bf);
-        DecodedBlob decoded(
-            requestParams.key, uncompressed.first, uncompressed.second);
+        requestParams.result =
+            nodeobject_decode(requestParams.key, buf, bufSize, bf);
         cass_result_free(res);
 
-        if (!decoded.wasOk())
+        if (!requestParams.result)
         {
             JLOG(requestParams.backend.j_.fatal())
                 << "Cassandra fetch error - data corruption : " << rc << ", "
@@ -895,11 +1331,78 @@ readCallback(CassFuture* fut, void* cbData)
             finish();
             return;
         }
-        requestParams.result = decoded.createObject();
         finish();
     }
 }
 
+// Process the result of an asynchronous read of several keys. Retry on error
+// @param fut cassandra future associated with the read
+// @param cbData struct that holds the request parameters
+void
+readManyCallback(CassFuture* fut, void* cbData)
+{
+    CassandraBackend::MultiReadCallbackData& requestParams =
+        *static_cast<CassandraBackend::MultiReadCallbackData*>(cbData);
+    CassandraBackend& backend = requestParams.backend;
+
+    CassError rc = cass_future_error_code(fut);
+
+    if (rc != CASS_OK)
+    {
+        ++(backend.counters_.readRetries);
+        JLOG(backend.j_.warn())
+            << "Cassandra fetch error : " << rc << " : " << cass_error_desc(rc)
+            << " - retrying";
+        // Retry right away, for the same reasons as readCallback
+        backend.readMany(requestParams);
+        return;
+    }
+
+    CassResult const* res = cass_future_get_result(fut);
+    CassIterator* rows = cass_iterator_from_result(res);
+    while (cass_iterator_next(rows))
+    {
+        CassRow const* row = cass_iterator_get_row(rows);
+        cass_byte_t const* key;
+        std::size_t keySize;
+        cass_byte_t const* buf;
+        std::size_t bufSize;
+        rc = cass_value_get_bytes(cass_row_get_column(row, 0), &key, &keySize);
+        if (rc == CASS_OK)
+            rc = cass_value_get_bytes(
+                cass_row_get_column(row, 1), &buf, &bufSize);
+        if (rc != CASS_OK || keySize != backend.keyBytes_)
+        {
+            JLOG(backend.j_.error())
+                << "Cassandra fetch get bytes error : " << rc << ", "
+                << cass_error_desc(rc);
+            ++backend.counters_.readErrors;
+            continue;
+        }
+
+        auto const& keys = requestParams.keys;
+        auto const hash = uint256::fromVoid(key);
+        auto const it = std::lower_bound(keys.begin(), keys.end(), hash);
+        if (it == keys.end() || *it != hash)
+            continue;
+
+        nudb::detail::buffer bf;
+        auto object = nodeobject_decode(key, buf, bufSize, bf);
+        if (!object)
+        {
+            JLOG(backend.j_.fatal())
+                << "Cassandra fetch error - data corruption : " << rc << ", "
+                << cass_error_desc(rc);
+            ++backend.counters_.readErrors;
+            continue;
+        }
+        requestParams.results[it - keys.begin()] = std::move(object);
+    }
+    cass_iterator_free(rows);
+    cass_result_free(res);
+    requestParams.finish();
+}
+
 // Process the result of an asynchronous write. Retry on error
 // @param fut cassandra future associated with the write
 // @param cbData struct that holds the request parameters
@@ -910,6 +1413,9 @@ writeCallback(CassFuture* fut, void* cbData)
         *static_cast<CassandraBackend::WriteCallbackData*>(cbData);
     CassandraBackend& backend = *requestParams.backend;
     auto rc = cass_future_error_code(fut);
+    auto const latency = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - requestParams.begin);
+    backend.adaptRequestLimit(rc, 1, latency);
     if (rc != CASS_OK)
     {
         JLOG(backend.j_.error())
@@ -930,10 +1436,7 @@ writeCallback(CassFuture* fut, void* cbData)
     }
     else
     {
-        backend.counters_.writeDurationUs +=
-            std::chrono::duration_cast<std::chrono::microseconds>(
-                std::chrono::steady_clock::now() - requestParams.begin)
-                .count();
+        backend.counters_.writeDurationUs += latency.count();
         --(backend.numRequestsOutstanding_);
 
         backend.throttleCv_.notify_all();
@@ -943,6 +1446,51 @@ writeCallback(CassFuture* fut, void* cbData)
     }
 }
 
+// Process the result of an asynchronous batch of writes. Retry the whole
+// batch on error
+// @param fut cassandra future associated with the batch
+// @param cbData struct that holds the request parameters
+void
+batchWriteCallback(CassFuture* fut, void* cbData)
+{
+    CassandraBackend::BatchWriteCallbackData& requestParams =
+        *static_cast<CassandraBackend::BatchWriteCallbackData*>(cbData);
+    CassandraBackend& backend = *requestParams.backend;
+    auto rc = cass_future_error_code(fut);
+    auto const size = requestParams.writes.size();
+    auto const latency = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - requestParams.begin);
+    backend.adaptRequestLimit(rc, size, latency);
+    if (rc != CASS_OK)
+    {
+        JLOG(backend.j_.error())
+            << "ERROR!!! Cassandra batch insert error: " << rc << ", "
+            << cass_error_desc(rc) << ", retrying ";
+        backend.counters_.writeRetries += size;
+        // exponential backoff with a max wait of 2^10 ms (about 1 second)
+        auto wait = std::chrono::milliseconds(
+            lround(std::pow(2, std::min(10u, requestParams.currentRetries))));
+        ++requestParams.currentRetries;
+        std::shared_ptr<boost::asio::steady_timer> timer =
+            std::make_shared<boost::asio::steady_timer>(
+                backend.ioContext_, std::chrono::steady_clock::now() + wait);
+        timer->async_wait([timer, &requestParams, &backend](
+                              const boost::system::error_code& error) {
+            backend.write(requestParams, true);
+        });
+    }
+    else
+    {
+        backend.counters_.writeDurationUs += latency.count() * size;
+        backend.numRequestsOutstanding_ -= size;
+
+        backend.throttleCv_.notify_all();
+        if (backend.numRequestsOutstanding_ == 0)
+            backend.syncCv_.notify_all();
+        delete &requestParams;
+    }
+}
+
 //------------------------------------------------------------------------------
 
 class CassandraFactory : public Factory
@@ -20,8 +20,9 @@
 #include <ripple/basics/contract.h>
 #include <ripple/nodestore/Factory.h>
 #include <ripple/nodestore/Manager.h>
-#include <ripple/nodestore/impl/DecodedBlob.h>
 #include <ripple/nodestore/impl/EncodedBlob.h>
+#include <ripple/nodestore/impl/IoUringFile.h>
+#include <ripple/nodestore/impl/NodeDictionary.h>
 #include <ripple/nodestore/impl/codec.h>
 #include <boost/filesystem.hpp>
 #include <cassert>
@@ -31,10 +32,13 @@
 #include <exception>
 #include <memory>
 #include <nudb/nudb.hpp>
+#include <system_error>
+#include <type_traits>
 
 namespace ripple {
 namespace NodeStore {
 
+template <class File>
 class NuDBBackend : public Backend
 {
 public:
@@ -44,13 +48,23 @@ public:
     /* "SHRD" in ASCII */
     static constexpr std::uint64_t deterministicType = 0x5348524400000000ull;
 
+    /* "ZDIC" in ASCII, with the dictionary version in the random part */
+    static constexpr std::uint64_t dictionaryType = 0x5A44494300000000ull;
+
     beast::Journal const j_;
     size_t const keyBytes_;
     std::size_t const burstSize_;
     std::string const name_;
-    nudb::store db_;
+    nudb::basic_store<nudb::xxhasher, File> db_;
     std::atomic<bool> deletePath_;
     Scheduler& scheduler_;
+    std::string const dictionaryPath_;
+    std::shared_ptr<NodeDictionary const> dictionary_;
+    // The dictionaries the open database was written with, if any
+    NodeDictionary const* codecDictionary_ = nullptr;
+#if RIPPLE_IO_URING_AVAILABLE
+    std::shared_ptr<IoUringQueue> ioUring_;
+#endif
 
     NuDBBackend(
         size_t keyBytes,
@@ -64,6 +78,7 @@ public:
         , name_(get(keyValues, "path"))
         , deletePath_(false)
         , scheduler_(scheduler)
+        , dictionaryPath_(get(keyValues, "zstd_dictionary"))
     {
         if (name_.empty())
             Throw<std::runtime_error>(
@@ -84,6 +99,7 @@ public:
         , db_(context)
         , deletePath_(false)
         , scheduler_(scheduler)
+        , dictionaryPath_(get(keyValues, "zstd_dictionary"))
     {
         if (name_.empty())
             Throw<std::runtime_error>(
@@ -145,10 +161,31 @@ public:
             if (ec)
                 Throw<nudb::system_error>(ec);
         }
-        db_.open(dp, kp, lp, ec);
+        openStore(dp, kp, lp, ec);
         if (ec)
             Throw<nudb::system_error>(ec);
 
+        /** Databases written with zstd dictionaries have the version of
+         *  the dictionaries in the random part of appnum, so that they are
+         *  never read with other dictionaries.
+         */
+        codecDictionary_ = nullptr;
+        if ((db_.appnum() & deterministicMask) == dictionaryType)
+        {
+            auto const version = db_.appnum() & ~deterministicMask;
+            if (!dictionary_ || dictionary_->version() != version)
+                Throw<std::runtime_error>(
+                    "nodestore: database needs zstd_dictionary version " +
+                    std::to_string(version));
+            codecDictionary_ = dictionary_.get();
+        }
+        else if (dictionary_ && db_.appnum() == currentType)
+        {
+            JLOG(j_.warn()) << "NuDB: " << name_
+                            << " was created without zstd dictionaries, "
+                               "which will not be used";
+        }
+
         /** Old value currentType is accepted for appnum in traditional
          *  databases, new value is used for deterministic shard databases.
          *  New 64-bit value is constructed from fixed and random parts.
@@ -158,7 +195,8 @@ public:
          *  The contents of appnum field should match either old or new rule.
          */
         if (db_.appnum() != currentType &&
-            (db_.appnum() & deterministicMask) != deterministicType)
+            (db_.appnum() & deterministicMask) != deterministicType &&
+            !codecDictionary_)
             Throw<std::runtime_error>("nodestore: unknown appnum");
         db_.set_burst(burstSize_);
     }
@@ -172,7 +210,20 @@ public:
     void
     open(bool createIfMissing) override
     {
-        open(createIfMissing, currentType, nudb::make_uid(), nudb::make_salt());
+        if (!dictionaryPath_.empty() && !dictionary_)
+        {
+            dictionary_ = NodeDictionary::load(dictionaryPath_);
+            JLOG(j_.info()) << "NuDB: loaded " << dictionary_->size()
+                            << " zstd dictionaries, version "
+                            << dictionary_->version();
+        }
+
+        open(
+            createIfMissing,
+            dictionary_ ? dictionaryType | dictionary_->version()
+                        : currentType,
+            nudb::make_uid(),
+            nudb::make_salt());
     }
 
     void
@@ -209,17 +260,11 @@ public:
         nudb::error_code ec;
         db_.fetch(
             key,
-            [key, pno, &status](void const* data, std::size_t size) {
+            [this, key, pno, &status](void const* data, std::size_t size) {
                 nudb::detail::buffer bf;
-                auto const result = nodeobject_decompress(data, size, bf);
-                DecodedBlob decoded(key, result.first, result.second);
-                if (!decoded.wasOk())
-                {
-                    status = dataCorrupt;
-                    return;
-                }
-                *pno = decoded.createObject();
-                status = ok;
+                *pno =
+                    nodeobject_decode(key, data, size, bf, codecDictionary_);
+                status = *pno ? ok : dataCorrupt;
             },
             ec);
         if (ec == nudb::error::key_not_found)
@@ -232,18 +277,25 @@ public:
     std::pair<std::vector<std::shared_ptr<NodeObject>>, Status>
     fetchBatch(std::vector<uint256 const*> const& hashes) override
     {
-        std::vector<std::shared_ptr<NodeObject>> results;
-        results.reserve(hashes.size());
-        for (auto const& h : hashes)
-        {
+        std::vector<std::shared_ptr<NodeObject>> results(hashes.size());
+        auto const fetchOne = [&](std::size_t i) {
             std::shared_ptr<NodeObject> nObj;
-            Status status = fetch(h->begin(), &nObj);
-            if (status != ok)
-                results.push_back({});
-            else
-                results.push_back(nObj);
+            if (fetch(hashes[i]->begin(), &nObj) == ok)
+                results[i] = std::move(nObj);
+        };
+
+#if RIPPLE_IO_URING_AVAILABLE
+        // Fetch the objects side by side, so that their reads go to the
+        // ring together
+        if constexpr (std::is_same_v<File, IoUringFile>)
+        {
+            IoUringBatch::run(*ioUring_, hashes.size(), fetchOne);
+            return {results, ok};
         }
+#endif
 
+        for (std::size_t i = 0; i < hashes.size(); ++i)
+            fetchOne(i);
         return {results, ok};
     }
 
@@ -253,7 +305,8 @@ public:
         EncodedBlob e(no);
         nudb::error_code ec;
         nudb::detail::buffer bf;
-        auto const result = nodeobject_compress(e.getData(), e.getSize(), bf);
+        auto const result = nodeobject_compress(
+            e.getData(), e.getSize(), bf, codecDictionary_);
         db_.insert(e.getKey(), result.first, result.second, ec);
         if (ec && ec != nudb::error::key_exists)
             Throw<nudb::system_error>(ec);
@@ -308,20 +361,20 @@ public:
                 std::size_t size,
                 nudb::error_code&) {
                 nudb::detail::buffer bf;
-                auto const result = nodeobject_decompress(data, size, bf);
-                DecodedBlob decoded(key, result.first, result.second);
-                if (!decoded.wasOk())
+                auto object =
+                    nodeobject_decode(key, data, size, bf, codecDictionary_);
+                if (!object)
                 {
                     ec = make_error_code(nudb::error::missing_value);
                     return;
                 }
-                f(decoded.createObject());
+                f(std::move(object));
             },
             nudb::no_progress{},
             ec);
         if (ec)
             Throw<nudb::system_error>(ec);
-        db_.open(dp, kp, lp, ec);
+        openStore(dp, kp, lp, ec);
         if (ec)
             Throw<nudb::system_error>(ec);
     }
@@ -352,7 +405,7 @@ public:
         nudb::verify<nudb::xxhasher>(vi, dp, kp, 0, nudb::no_progress{}, ec);
         if (ec)
             Throw<nudb::system_error>(ec);
-        db_.open(dp, kp, lp, ec);
+        openStore(dp, kp, lp, ec);
         if (ec)
             Throw<nudb::system_error>(ec);
     }
@@ -360,7 +413,30 @@ public:
     int
     fdRequired() const override
     {
-        return 3;
+        // Files opened for io_uring keep a second descriptor for reads,
+        // and the ring itself needs one.
+        if constexpr (std::is_same_v<File, nudb::native_file>)
+            return 3;
+        else
+            return 7;
+    }
+
+private:
+    void
+    openStore(
+        std::string const& dp,
+        std::string const& kp,
+        std::string const& lp,
+        nudb::error_code& ec)
+    {
+#if RIPPLE_IO_URING_AVAILABLE
+        if constexpr (std::is_same_v<File, IoUringFile>)
+        {
+            db_.open(dp, kp, lp, ec, ioUring_);
+            return;
+        }
+#endif
+        db_.open(dp, kp, lp, ec);
     }
 };
 
@@ -368,6 +444,43 @@ public:
 
 class NuDBFactory : public Factory
 {
+    template <class... Args>
+    static std::unique_ptr<Backend>
+    make(Section const& keyValues, beast::Journal journal, Args&&... args)
+    {
+        if (get<bool>(keyValues, "io_uring", false))
+        {
+#if RIPPLE_IO_URING_AVAILABLE
+            std::shared_ptr<IoUringQueue> queue;
+            try
+            {
+                queue = std::make_shared<IoUringQueue>(get<std::size_t>(
+                    keyValues, "io_uring_depth", IoUringQueue::defaultDepth));
+            }
+            catch (std::system_error const& e)
+            {
+                JLOG(journal.warn())
+                    << "NuDB: io_uring unavailable, using blocking reads: "
+                    << e.what();
+            }
+
+            if (queue)
+            {
+                auto backend = std::make_unique<NuDBBackend<IoUringFile>>(
+                    std::forward<Args>(args)..., journal);
+                backend->ioUring_ = std::move(queue);
+                return backend;
+            }
+#else
+            JLOG(journal.warn()) << "NuDB: io_uring is not supported on "
+                                    "this platform, using blocking reads";
+#endif
+        }
+
+        return std::make_unique<NuDBBackend<nudb::native_file>>(
+            std::forward<Args>(args)..., journal);
+    }
+
 public:
     NuDBFactory()
     {
@@ -393,8 +506,8 @@ public:
         Scheduler& scheduler,
         beast::Journal journal) override
     {
-        return std::make_unique<NuDBBackend>(
-            keyBytes, keyValues, burstSize, scheduler, journal);
+        return make(
+            keyValues, journal, keyBytes, keyValues, burstSize, scheduler);
     }
 
     std::unique_ptr<Backend>
@@ -406,8 +519,14 @@ public:
         nudb::context& context,
         beast::Journal journal) override
     {
-        return std::make_unique<NuDBBackend>(
-            keyBytes, keyValues, burstSize, scheduler, context, journal);
+        return make(
+            keyValues,
+            journal,
+            keyBytes,
+            keyValues,
+            burstSize,
+            scheduler,
+            context);
     }
 };
 
@@ -34,6 +34,7 @@
 
 #include <atomic>
 #include <memory>
+#include <mutex>
 
 namespace ripple {
 namespace NodeStore {
@@ -82,6 +83,33 @@ public:
 
 //------------------------------------------------------------------------------
 
+/** A block cache shared by every backend that asks for it.
+
+    With online_delete two databases are open at once. Sharing one cache
+    lets the busier of them use most of it, instead of each being limited
+    to its own half.
+*/
+class RocksDBSharedCache
+{
+    std::mutex mutex_;
+    std::shared_ptr<rocksdb::Cache> cache_;
+
+public:
+    /** Return the cache, growing it to at least the given capacity. */
+    std::shared_ptr<rocksdb::Cache>
+    get(std::size_t capacity)
+    {
+        std::lock_guard lock(mutex_);
+        if (!cache_)
+            cache_ = rocksdb::NewLRUCache(capacity);
+        else if (cache_->GetCapacity() < capacity)
+            cache_->SetCapacity(capacity);
+        return cache_;
+    }
+};
+
+//------------------------------------------------------------------------------
+
 class RocksDBBackend : public Backend, public BatchWriter::Callback
 {
 private:
@@ -101,7 +129,8 @@ public:
         Section const& keyValues,
         Scheduler& scheduler,
         beast::Journal journal,
-        RocksDBEnv* env)
+        RocksDBEnv* env,
+        RocksDBSharedCache& sharedCache)
         : m_deletePath(false)
         , m_journal(journal)
         , m_keyBytes(keyBytes)
@@ -123,17 +152,56 @@ public:
             if (!hard_set && size == 256)
                 size = 1024;
 
-            table_options.block_cache = rocksdb::NewLRUCache(megabytes(size));
+            if (get<bool>(keyValues, "shared_cache"))
+                table_options.block_cache = sharedCache.get(megabytes(size));
+            else
+                table_options.block_cache =
+                    rocksdb::NewLRUCache(megabytes(size));
         }
 
+        // Partitioned filters only work with full filters
+        bool const partition = get<bool>(keyValues, "partition_filters");
+
         if (auto const v = get<int>(keyValues, "filter_bits"))
         {
-            bool const filter_blocks = !keyValues.exists("filter_full") ||
-                (get<int>(keyValues, "filter_full") == 0);
+            bool const filter_blocks = !partition &&
+                (!keyValues.exists("filter_full") ||
+                 (get<int>(keyValues, "filter_full") == 0));
             table_options.filter_policy.reset(
                 rocksdb::NewBloomFilterPolicy(v, filter_blocks));
         }
 
+        if (partition)
+        {
+            // Split the index and the filters into blocks that go through
+            // the block cache, and keep only their top level in memory.
+            // This bounds the memory used by large databases.
+            table_options.index_type =
+                rocksdb::BlockBasedTableOptions::kTwoLevelIndexSearch;
+            table_options.partition_filters =
+                static_cast<bool>(table_options.filter_policy);
+            table_options.cache_index_and_filter_blocks = true;
+            table_options.cache_index_and_filter_blocks_with_high_priority =
+                true;
+            table_options.pin_top_level_index_and_filter = true;
+        }
+
+        if (get<bool>(keyValues, "direct_io"))
+        {
+            // Bypass the page cache, the block cache is used instead
+            m_options.use_direct_reads = true;
+            m_options.use_direct_io_for_flush_and_compaction = true;
+        }
+
+        if (auto const rate = get<int>(keyValues, "compaction_rate_mb"))
+        {
+            m_options.rate_limiter.reset(
+                rocksdb::NewGenericRateLimiter(megabytes(rate)));
+        }
+
+        if (get<bool>(keyValues, "statistics"))
+            m_options.statistics = rocksdb::CreateDBStatistics();
+
         if (get_if_exists(keyValues, "open_files", m_options.max_open_files))
         {
             if (!hard_set && m_options.max_open_files == 2000)
@@ -325,16 +393,43 @@ public:
     std::pair<std::vector<std::shared_ptr<NodeObject>>, Status>
     fetchBatch(std::vector<uint256 const*> const& hashes) override
     {
+        assert(m_db);
+
+        std::vector<rocksdb::Slice> keys;
+        keys.reserve(hashes.size());
+        for (auto const& h : hashes)
+            keys.emplace_back(
+                reinterpret_cast<char const*>(h->data()), m_keyBytes);
+
+        // Let RocksDB look up all the keys in one call instead of paying
+        // for a separate Get for each of them.
+        rocksdb::ReadOptions const options;
+        std::vector<std::string> values;
+        auto const statuses = m_db->MultiGet(options, keys, &values);
+
         std::vector<std::shared_ptr<NodeObject>> results;
         results.reserve(hashes.size());
-        for (auto const& h : hashes)
+        for (std::size_t i = 0; i < hashes.size(); ++i)
         {
             std::shared_ptr<NodeObject> nObj;
-            Status status = fetch(h->begin(), &nObj);
-            if (status != ok)
-                results.push_back({});
-            else
-                results.push_back(nObj);
+
+            if (statuses[i].ok())
+            {
+                DecodedBlob decoded(
+                    hashes[i]->data(), values[i].data(), values[i].size());
+
+                if (decoded.wasOk())
+                    nObj = decoded.createObject();
+                else
+                    JLOG(m_journal.fatal())
+                        << "Corrupt NodeObject #" << *hashes[i];
+            }
+            else if (!statuses[i].IsNotFound())
+            {
+                JLOG(m_journal.error()) << statuses[i].ToString();
+            }
+
+            results.push_back(std::move(nObj));
         }
 
         return {results, ok};
@@ -440,6 +535,58 @@ public:
     {
         return fdRequired_;
     }
+
+    void
+    getCountsJson(Json::Value& obj) const override
+    {
+        m_batch.getCountsJson(obj);
+
+        if (!m_db)
+            return;
+
+        Json::Value& stats = (obj["rocksdb"] = Json::objectValue);
+        for (auto const& name :
+             {"rocksdb.estimate-num-keys",
+              "rocksdb.estimate-live-data-size",
+              "rocksdb.total-sst-files-size",
+              "rocksdb.block-cache-usage",
+              "rocksdb.block-cache-pinned-usage",
+              "rocksdb.estimate-table-readers-mem",
+              "rocksdb.cur-size-all-mem-tables",
+              "rocksdb.num-running-compactions",
+              "rocksdb.estimate-pending-compaction-bytes"})
+        {
+            // Report the properties without their "rocksdb." prefix
+            std::uint64_t value;
+            if (m_db->GetIntProperty(name, &value))
+                stats[name + 8] = std::to_string(value);
+        }
+
+        if (auto const& s = m_options.statistics)
+        {
+            for (auto const& [ticker, name] :
+                 {std::pair{rocksdb::BLOCK_CACHE_HIT, "block_cache_hit"},
+                  std::pair{rocksdb::BLOCK_CACHE_MISS, "block_cache_miss"},
+                  std::pair{rocksdb::BLOOM_FILTER_USEFUL, "bloom_useful"},
+                  std::pair{rocksdb::GET_HIT_L0, "get_hit_l0"},
+                  std::pair{rocksdb::GET_HIT_L1, "get_hit_l1"},
+                  std::pair{rocksdb::GET_HIT_L2_AND_UP, "get_hit_l2_and_up"},
+                  std::pair{rocksdb::BYTES_READ, "bytes_read"},
+                  std::pair{rocksdb::BYTES_WRITTEN, "bytes_written"},
+                  std::pair{rocksdb::COMPACT_READ_BYTES, "compact_read_bytes"},
+                  std::pair{
+                      rocksdb::COMPACT_WRITE_BYTES, "compact_write_bytes"},
+                  std::pair{rocksdb::STALL_MICROS, "stall_us"}})
+            {
+                stats[name] = std::to_string(s->getTickerCount(ticker));
+            }
+
+            rocksdb::HistogramData get;
+            s->histogramData(rocksdb::DB_GET, &get);
+            stats["get_us_median"] = std::to_string(get.median);
+            stats["get_us_p99"] = std::to_string(get.percentile99);
+        }
+    }
 };
 
 //------------------------------------------------------------------------------
@@ -448,6 +595,7 @@ class RocksDBFactory : public Factory
 {
 public:
     RocksDBEnv m_env;
+    RocksDBSharedCache m_cache;
 
     RocksDBFactory()
     {
@@ -474,7 +622,7 @@ public:
         beast::Journal journal) override
     {
         return std::make_unique<RocksDBBackend>(
-            keyBytes, keyValues, scheduler, journal, &m_env);
+            keyBytes, keyValues, scheduler, journal, &m_env, m_cache);
     }
 };
 
@@ -18,17 +18,31 @@
 //==============================================================================
 
 #include <ripple/nodestore/impl/BatchWriter.h>
+#include <iterator>
 
 namespace ripple {
 namespace NodeStore {
 
+// Each storing thread keeps to one lane, handed out round-robin
+static std::size_t
+laneIndex(std::size_t laneCount)
+{
+    static std::atomic<std::size_t> next{0};
+    thread_local std::size_t const lane = next++;
+    return lane % laneCount;
+}
+
 BatchWriter::BatchWriter(Callback& callback, Scheduler& scheduler)
     : m_callback(callback)
     , m_scheduler(scheduler)
+    , mPending(0)
     , mWriteLoad(0)
     , mWritePending(false)
+    , mStalls(0)
+    , mStallDurationUs(0)
 {
-    mWriteSet.reserve(batchWritePreallocationSize);
+    for (auto& lane : mLanes)
+        lane.batch.reserve(batchWritePreallocationSize / laneCount);
 }
 
 BatchWriter::~BatchWriter()
@@ -39,29 +53,48 @@ BatchWriter::~BatchWriter()
 void
 BatchWriter::store(std::shared_ptr<NodeObject> const& object)
 {
-    std::unique_lock<decltype(mWriteMutex)> sl(mWriteMutex);
-
     // If the batch has reached its limit, we wait
-    // until the batch writer is finished
-    while (mWriteSet.size() >= batchWriteLimitSize)
-        mWriteCondition.wait(sl);
-
-    mWriteSet.push_back(object);
+    // until the batch writer has taken it
+    if (mPending.load() >= batchWriteLimitSize)
+    {
+        auto const before = std::chrono::steady_clock::now();
+        {
+            std::unique_lock sl(mWaitMutex);
+            mWaitCondition.wait(
+                sl, [this] { return mPending.load() < batchWriteLimitSize; });
+        }
+        ++mStalls;
+        mStallDurationUs +=
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - before)
+                .count();
+    }
 
-    if (!mWritePending)
     {
-        mWritePending = true;
+        auto& lane = mLanes[laneIndex(laneCount)];
+        std::lock_guard sl(lane.mutex);
 
-        m_scheduler.scheduleTask(*this);
+        // Counted under the lane lock so the writer never takes
+        // an object before it has been counted
+        ++mPending;
+        lane.batch.push_back(object);
     }
+
+    if (!mWritePending.exchange(true))
+        m_scheduler.scheduleTask(*this);
 }
 
 int
-BatchWriter::getWriteLoad()
+BatchWriter::getWriteLoad() const
 {
-    std::lock_guard sl(mWriteMutex);
+    return std::max(mWriteLoad.load(), static_cast<int>(mPending.load()));
+}
 
-    return std::max(mWriteLoad, static_cast<int>(mWriteSet.size()));
+void
+BatchWriter::getCountsJson(Json::Value& obj) const
+{
+    obj["write_stalls"] = std::to_string(mStalls);
+    obj["write_stall_duration_us"] = std::to_string(mStallDurationUs);
 }
 
 void
@@ -73,27 +106,58 @@ BatchWriter::performScheduledTask()
 void
 BatchWriter::writeBatch()
 {
+    Batch set;
+
     for (;;)
     {
-        std::vector<std::shared_ptr<NodeObject>> set;
-
-        set.reserve(batchWritePreallocationSize);
+        set.clear();
 
+        for (auto& lane : mLanes)
         {
-            std::lock_guard sl(mWriteMutex);
+            std::lock_guard sl(lane.mutex);
 
-            mWriteSet.swap(set);
-            assert(mWriteSet.empty());
-            mWriteLoad = set.size();
+            if (lane.batch.empty())
+                continue;
 
+            // The lane keeps the emptied buffer from the last pass
             if (set.empty())
+                set.swap(lane.batch);
+            else
             {
+                set.insert(
+                    set.end(),
+                    std::make_move_iterator(lane.batch.begin()),
+                    std::make_move_iterator(lane.batch.end()));
+                lane.batch.clear();
+            }
+        }
+
+        mWriteLoad = set.size();
+
+        if (set.empty())
+        {
+            {
+                std::lock_guard sl(mWaitMutex);
                 mWritePending = false;
-                mWriteCondition.notify_all();
+            }
+            mWaitCondition.notify_all();
 
-                // VFALCO NOTE Fix this function to not return from the middle
+            // A store that raced with the last pass found us still
+            // pending and did not schedule another task, so its
+            // object is ours to write
+            if (mPending.load() == 0 || mWritePending.exchange(true))
                 return;
+
+            continue;
+        }
+
+        if (mPending.fetch_sub(set.size()) >= batchWriteLimitSize)
+        {
+            // Release stores held back by the limit
+            {
+                std::lock_guard sl(mWaitMutex);
             }
+            mWaitCondition.notify_all();
         }
 
         BatchWriteReport report;
@@ -112,10 +176,10 @@ BatchWriter::writeBatch()
 void
 BatchWriter::waitForWriting()
 {
-    std::unique_lock<decltype(mWriteMutex)> sl(mWriteMutex);
+    std::unique_lock sl(mWaitMutex);
 
-    while (mWritePending)
-        mWriteCondition.wait(sl);
+    mWaitCondition.wait(
+        sl, [this] { return !mWritePending.load() && mPending.load() == 0; });
 }
 
 }  // namespace NodeStore
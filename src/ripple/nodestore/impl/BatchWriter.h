@@ -23,7 +23,11 @@
 #include <ripple/nodestore/Scheduler.h>
 #include <ripple/nodestore/Task.h>
 #include <ripple/nodestore/Types.h>
+#include <ripple/json/json_value.h>
+#include <array>
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <mutex>
 
 namespace ripple {
@@ -35,6 +39,11 @@ namespace NodeStore {
     class it not required. A backend can implement its own write batching,
     or skip write batching if doing so yields a performance benefit.
 
+    Objects are staged in a small set of lanes, each with its own lock,
+    and a storing thread always uses the same lane. The writer swaps each
+    lane's batch for an empty one in turn, so stores only contend with
+    other threads sharing their lane and never with the write itself.
+
     @see Scheduler
 */
 class BatchWriter : private Task
@@ -72,7 +81,15 @@ public:
 
     /** Get an estimate of the amount of writing I/O pending. */
     int
-    getWriteLoad();
+    getWriteLoad() const;
+
+    /** Add write back-pressure statistics to a JSON object.
+
+        Reports how often, and for how long, store had to wait because
+        the pending batch had reached its limit.
+    */
+    void
+    getCountsJson(Json::Value& obj) const;
 
 private:
     void
@@ -83,16 +100,29 @@ private:
     waitForWriting();
 
 private:
-    using LockType = std::recursive_mutex;
-    using CondvarType = std::condition_variable_any;
+    static constexpr std::size_t laneCount = 16;
+
+    struct alignas(64) Lane
+    {
+        std::mutex mutex;
+        Batch batch;
+    };
 
     Callback& m_callback;
     Scheduler& m_scheduler;
-    LockType mWriteMutex;
-    CondvarType mWriteCondition;
-    int mWriteLoad;
-    bool mWritePending;
-    Batch mWriteSet;
+    std::array<Lane, laneCount> mLanes;
+
+    // Objects staged in the lanes but not yet taken by the writer
+    std::atomic<std::size_t> mPending;
+    std::atomic<int> mWriteLoad;
+    std::atomic<bool> mWritePending;
+
+    // Only used to block, for back-pressure or to wait for the writer
+    std::mutex mWaitMutex;
+    std::condition_variable mWaitCondition;
+
+    std::atomic<std::uint64_t> mStalls;
+    std::atomic<std::uint64_t> mStallDurationUs;
 };
 
 }  // namespace NodeStore
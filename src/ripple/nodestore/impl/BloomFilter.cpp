@@ -0,0 +1,174 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/FileUtilities.h>
+#include <ripple/basics/Log.h>
+#include <ripple/basics/contract.h>
+#include <ripple/nodestore/impl/BloomFilter.h>
+#include <ripple/protocol/Serializer.h>
+#include <boost/filesystem/operations.hpp>
+
+#include <cstring>
+
+namespace ripple {
+namespace NodeStore {
+
+// Identifies a file written by save, and the version of its layout
+static std::uint32_t constexpr bloomFilterMagic = 0x52424631;  // "RBF1"
+
+BloomFilter::BloomFilter(std::uint64_t objects)
+{
+    if (objects == 0)
+        return;
+
+    // At least 10 bits per key keeps false positives near 1% with 7 hashes
+    std::uint64_t bits = 64;
+    while (bits < objects * 10)
+        bits <<= 1;
+    words_ = std::vector<std::atomic<std::uint64_t>>(bits / 64);
+    mask_ = bits - 1;
+}
+
+template <class F>
+void
+BloomFilter::forEachBit(uint256 const& key, F&& f) const
+{
+    // Keys are hashes already, so their bits can index the filter directly
+    std::uint64_t h1;
+    std::uint64_t h2;
+    std::memcpy(&h1, key.data(), sizeof(h1));
+    std::memcpy(&h2, key.data() + sizeof(h1), sizeof(h2));
+    h2 |= 1;
+    for (int i = 0; i < hashes; ++i)
+    {
+        auto const bit = (h1 + i * h2) & mask_;
+        f(bit / 64, std::uint64_t{1} << (bit % 64));
+    }
+}
+
+void
+BloomFilter::insert(uint256 const& key)
+{
+    if (!enabled())
+        return;
+
+    forEachBit(key, [this](std::size_t word, std::uint64_t bit) {
+        if (!(words_[word].load(std::memory_order_relaxed) & bit))
+            words_[word].fetch_or(bit, std::memory_order_relaxed);
+    });
+}
+
+bool
+BloomFilter::mayContain(uint256 const& key) const
+{
+    if (!enabled())
+        return true;
+
+    bool found = true;
+    forEachBit(key, [this, &found](std::size_t word, std::uint64_t bit) {
+        if (!(words_[word].load(std::memory_order_relaxed) & bit))
+            found = false;
+    });
+    return found;
+}
+
+bool
+BloomFilter::save(boost::filesystem::path const& file, beast::Journal j) const
+{
+    if (!enabled() || !complete_)
+        return false;
+
+    Serializer s(16 + words_.size() * sizeof(std::uint64_t));
+    s.add32(bloomFilterMagic);
+    s.add64(words_.size());
+    for (auto const& word : words_)
+        s.add64(word.load(std::memory_order_relaxed));
+
+    boost::system::error_code ec;
+    writeFileContentsAtomic(ec, file, s.getString());
+    if (ec)
+    {
+        JLOG(j.error()) << "Unable to write Bloom filter " << file << ": "
+                        << ec.message();
+        return false;
+    }
+
+    JLOG(j.info()) << "Saved Bloom filter " << file;
+    return true;
+}
+
+bool
+BloomFilter::load(boost::filesystem::path const& file, beast::Journal j)
+{
+    if (!enabled())
+        return false;
+
+    boost::system::error_code ec;
+    auto const data = getFileContents(ec, file);
+    if (ec)
+    {
+        if (ec != boost::system::errc::no_such_file_or_directory)
+            JLOG(j.error()) << "Unable to read Bloom filter " << file << ": "
+                            << ec.message();
+        return false;
+    }
+
+    boost::filesystem::remove(file, ec);
+    if (ec)
+    {
+        // Reusing the file on a later start could claim that keys stored
+        // since then are missing.
+        JLOG(j.error()) << "Unable to remove Bloom filter " << file << ": "
+                        << ec.message();
+        return false;
+    }
+
+    try
+    {
+        SerialIter sit(makeSlice(data));
+        if (sit.get32() != bloomFilterMagic)
+        {
+            JLOG(j.warn()) << "Ignoring unrecognized Bloom filter " << file;
+            return false;
+        }
+        if (sit.get64() != words_.size())
+        {
+            JLOG(j.warn()) << "Ignoring Bloom filter " << file
+                           << " of a different size";
+            return false;
+        }
+        for (auto& word : words_)
+            word.store(sit.get64(), std::memory_order_relaxed);
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j.warn()) << "Ignoring damaged Bloom filter " << file << ": "
+                       << e.what();
+        for (auto& word : words_)
+            word.store(0, std::memory_order_relaxed);
+        return false;
+    }
+
+    complete_ = true;
+    JLOG(j.info()) << "Loaded Bloom filter " << file;
+    return true;
+}
+
+}  // namespace NodeStore
+}  // namespace ripple
@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_NODESTORE_BLOOMFILTER_H_INCLUDED
+#define RIPPLE_NODESTORE_BLOOMFILTER_H_INCLUDED
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/beast/utility/Journal.h>
+#include <boost/filesystem/path.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace ripple {
+namespace NodeStore {
+
+/** A Bloom filter of the keys stored in a backend.
+
+    The filter can only tell that a key is missing from the backend if it
+    saw every key stored in it. That is the case for a backend that was
+    empty when the filter was created, or for a filter saved when the
+    backend was closed and loaded when it was opened again. Otherwise the
+    filter is incomplete and excludes nothing.
+
+    @note This can be called concurrently.
+*/
+class BloomFilter
+{
+public:
+    /** Create an empty, incomplete filter.
+
+        @param objects The expected number of keys. About 10 to 20 bits
+                       of memory are used per key. Zero disables the filter.
+    */
+    explicit BloomFilter(std::uint64_t objects);
+
+    BloomFilter(BloomFilter const&) = delete;
+    BloomFilter&
+    operator=(BloomFilter const&) = delete;
+
+    bool
+    enabled() const
+    {
+        return !words_.empty();
+    }
+
+    /** Set whether every key of the backend was inserted. */
+    void
+    setComplete(bool complete)
+    {
+        complete_ = complete;
+    }
+
+    bool
+    complete() const
+    {
+        return complete_;
+    }
+
+    /** Insert a key. Call before storing the key in the backend. */
+    void
+    insert(uint256 const& key);
+
+    /** Return whether the key may have been inserted. */
+    bool
+    mayContain(uint256 const& key) const;
+
+    /** Return whether the key is certainly missing from the backend. */
+    bool
+    excludes(uint256 const& key) const
+    {
+        return enabled() && complete_ && !mayContain(key);
+    }
+
+    /** Write a complete filter to a file.
+
+        @return `true` if the filter was written.
+    */
+    bool
+    save(boost::filesystem::path const& file, beast::Journal j) const;
+
+    /** Read a filter written by save(), and mark it complete.
+
+        The file is removed, so that writes made after this call can't be
+        missing from the filter on a later start.
+
+        @return `true` if the filter was read.
+    */
+    bool
+    load(boost::filesystem::path const& file, beast::Journal j);
+
+private:
+    static constexpr int hashes = 7;
+
+    std::vector<std::atomic<std::uint64_t>> words_;
+    std::uint64_t mask_ = 0;
+    std::atomic<bool> complete_{false};
+
+    template <class F>
+    void
+    forEachBit(uint256 const& key, F&& f) const;
+};
+
+}  // namespace NodeStore
+}  // namespace ripple
+
+#endif
@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <ripple/app/ledger/Ledger.h>
+#include <ripple/basics/Numa.h>
 #include <ripple/basics/chrono.h>
 #include <ripple/beast/core/CurrentThreadName.h>
 #include <ripple/json/json_value.h>
@@ -57,6 +58,8 @@ Database::Database(
     if (requestBundle_ < 1 || requestBundle_ > 64)
         Throw<std::runtime_error>("Invalid rq_bundle");
 
+    bool const numaSpread = get<int>(config, "numa_spread", 0) != 0;
+
     for (int i = readThreads_.load(); i != 0; --i)
     {
         std::thread t(
@@ -94,22 +97,29 @@ Database::Database(
                             read.insert(read_.extract(read_.begin()));
                     }
 
-                    for (auto it = read.begin(); it != read.end(); ++it)
+                    // Look up everything we extracted at once, so that
+                    // backends which support it can fetch the whole
+                    // bundle in a single call.
+                    std::vector<std::pair<uint256, std::uint32_t>> requests;
+                    requests.reserve(read.size());
+                    for (auto const& [hash, data] : read)
                     {
-                        assert(!it->second.empty());
+                        assert(!data.empty());
+                        requests.emplace_back(hash, data[0].first);
+                    }
 
-                        auto const& hash = it->first;
-                        auto const& data = it->second;
-                        auto const seqn = data[0].first;
+                    auto const objs = fetchNodeObjects(requests);
+                    assert(objs.size() == requests.size());
 
-                        auto obj =
-                            fetchNodeObject(hash, seqn, FetchType::async);
+                    std::size_t index = 0;
+                    for (auto const& [hash, data] : read)
+                    {
+                        auto const& obj = objs[index];
+                        auto const seqn = requests[index].second;
+                        ++index;
 
-                        // This could be further optimized: if there are
-                        // multiple requests for sequence numbers mapping to
-                        // multiple databases by sorting requests such that all
-                        // indices mapping to the same database are grouped
-                        // together and serviced by a single read.
+                        // Requests for sequence numbers that map to a
+                        // different database are serviced individually.
                         for (auto const& req : data)
                         {
                             req.second(
@@ -127,6 +137,8 @@ Database::Database(
                 --readThreads_;
             },
             i);
+        if (numaSpread)
+            numa::spread(t, i);
         t.detach();
     }
 }
@@ -247,6 +259,54 @@ Database::importInternal(Backend& dstBackend, Database& srcDB)
         storeBatch();
 }
 
+// Hand the fetch to the read threads and suspend until it completes
+std::shared_ptr<NodeObject>
+Database::fetchSuspended(
+    uint256 const& hash,
+    std::uint32_t ledgerSeq,
+    FetchSuspender& suspender)
+{
+    struct State
+    {
+        explicit State(FetchSuspender& s) : suspender(s)
+        {
+        }
+
+        FetchSuspender& suspender;
+        std::shared_ptr<NodeObject> object;
+        // Set by whichever of the fetch and the waiting side finishes
+        // first. The other side resumes, or does not suspend.
+        std::atomic<bool> claimed{false};
+    };
+
+    // Completes the fetch when the last copy of the callback goes away,
+    // whether or not it was called.
+    struct Completion
+    {
+        std::shared_ptr<State> state;
+
+        ~Completion()
+        {
+            if (state->claimed.exchange(true))
+                state->suspender.resume();
+        }
+    };
+
+    auto state = std::make_shared<State>(suspender);
+    auto completion = std::make_shared<Completion>(Completion{state});
+    asyncFetch(
+        hash,
+        ledgerSeq,
+        [completion = std::move(completion)](
+            std::shared_ptr<NodeObject> const& object) {
+            completion->state->object = object;
+        });
+
+    if (!state->claimed.exchange(true))
+        suspender.suspend();
+    return std::move(state->object);
+}
+
 // Perform a fetch and report the time it took
 std::shared_ptr<NodeObject>
 Database::fetchNodeObject(
@@ -255,6 +315,13 @@ Database::fetchNodeObject(
     FetchType fetchType,
     bool duplicate)
 {
+    // The read threads account for the fetches they make
+    if (fetchType == FetchType::synchronous && !duplicate && !isStopping())
+    {
+        if (auto suspender = FetchSuspender::current())
+            return fetchSuspended(hash, ledgerSeq, *suspender);
+    }
+
     FetchReport fetchReport(fetchType);
 
     using namespace std::chrono;
@@ -275,23 +342,64 @@ Database::fetchNodeObject(
     return nodeObject;
 }
 
+std::vector<std::shared_ptr<NodeObject>>
+Database::fetchNodeObjects(
+    std::vector<std::pair<uint256, std::uint32_t>> const& requests)
+{
+    std::vector<std::shared_ptr<NodeObject>> objs;
+    objs.reserve(requests.size());
+    for (auto const& [hash, seq] : requests)
+        objs.push_back(fetchNodeObject(hash, seq, FetchType::async));
+    return objs;
+}
+
+void
+Database::batchFetchStats(
+    std::vector<std::shared_ptr<NodeObject>> const& objects,
+    std::chrono::steady_clock::duration elapsed)
+{
+    using namespace std::chrono;
+
+    if (objects.empty())
+        return;
+
+    fetchDurationUs_ += duration_cast<microseconds>(elapsed).count();
+    fetchTotalCount_ += objects.size();
+
+    // Spread the time evenly so the scheduler sees the same number of
+    // fetches it would have seen had they been done one at a time.
+    auto const each = duration_cast<milliseconds>(elapsed / objects.size());
+    for (auto const& nodeObject : objects)
+    {
+        FetchReport fetchReport(FetchType::async);
+        if (nodeObject)
+        {
+            ++fetchHitCount_;
+            fetchSz_ += nodeObject->getData().size();
+            fetchReport.wasFound = true;
+        }
+        fetchReport.elapsed = each;
+        scheduler_.onFetch(fetchReport);
+    }
+}
+
 bool
 Database::storeLedger(
-    Ledger const& srcLedger,
+    std::shared_ptr<Ledger const> const& srcLedger,
     std::shared_ptr<Backend> dstBackend)
 {
     auto fail = [&](std::string const& msg) {
-        JLOG(j_.error()) << "Source ledger sequence " << srcLedger.info().seq
+        JLOG(j_.error()) << "Source ledger sequence " << srcLedger->info().seq
                          << ". " << msg;
         return false;
     };
 
-    if (srcLedger.info().hash.isZero())
+    if (srcLedger->info().hash.isZero())
         return fail("Invalid hash");
-    if (srcLedger.info().accountHash.isZero())
+    if (srcLedger->info().accountHash.isZero())
         return fail("Invalid account hash");
 
-    auto& srcDB = const_cast<Database&>(srcLedger.stateMap().family().db());
+    auto& srcDB = const_cast<Database&>(srcLedger->stateMap().family().db());
     if (&srcDB == this)
         return fail("Source and destination databases are the same");
 
@@ -323,18 +431,18 @@ Database::storeLedger(
     {
         Serializer s(sizeof(std::uint32_t) + sizeof(LedgerInfo));
         s.add32(HashPrefix::ledgerMaster);
-        addRaw(srcLedger.info(), s);
+        addRaw(srcLedger->info(), s);
         auto nObj = NodeObject::createObject(
-            hotLEDGER, std::move(s.modData()), srcLedger.info().hash);
+            hotLEDGER, std::move(s.modData()), srcLedger->info().hash);
         batch.emplace_back(std::move(nObj));
     }
 
     bool error = false;
-    auto visit = [&](SHAMapTreeNode& node) {
+    auto visit = [&](SHAMapTreeNode const& node) {
         if (!isStopping())
         {
             if (auto nodeObject = srcDB.fetchNodeObject(
-                    node.getHash().as_uint256(), srcLedger.info().seq))
+                    node.getHash().as_uint256(), srcLedger->info().seq))
             {
                 batch.emplace_back(std::move(nodeObject));
                 if (batch.size() < batchWritePreallocationSize || storeBatch())
@@ -347,23 +455,40 @@ Database::storeLedger(
     };
 
     // Store the state map
-    if (srcLedger.stateMap().getHash().isNonZero())
+    if (srcLedger->stateMap().getHash().isNonZero())
     {
-        if (!srcLedger.stateMap().isValid())
+        if (!srcLedger->stateMap().isValid())
             return fail("Invalid state map");
 
-        srcLedger.stateMap().snapShot(false)->visitNodes(visit);
+        // Every node of the ledger stored last is in the backend, so the
+        // nodes the source shares with it can be skipped.  Consecutive
+        // ledgers share nearly all of their nodes.
+        std::shared_ptr<Ledger const> have;
+        {
+            std::lock_guard lock(storedLock_);
+            if (storedBackend_.lock() == dstBackend)
+                have = storedLedger_;
+        }
+
+        if (have && have->stateMap().getHash().isNonZero())
+        {
+            auto haveMap = have->stateMap().snapShot(false);
+            srcLedger->stateMap().snapShot(false)->visitDifferences(
+                &(*haveMap), visit);
+        }
+        else
+            srcLedger->stateMap().snapShot(false)->visitNodes(visit);
         if (error)
             return fail("Failed to store state map");
     }
 
     // Store the transaction map
-    if (srcLedger.info().txHash.isNonZero())
+    if (srcLedger->info().txHash.isNonZero())
     {
-        if (!srcLedger.txMap().isValid())
+        if (!srcLedger->txMap().isValid())
             return fail("Invalid transaction map");
 
-        srcLedger.txMap().snapShot(false)->visitNodes(visit);
+        srcLedger->txMap().snapShot(false)->visitNodes(visit);
         if (error)
             return fail("Failed to store transaction map");
     }
@@ -371,6 +496,12 @@ Database::storeLedger(
     if (!batch.empty() && !storeBatch())
         return fail("Failed to store");
 
+    {
+        std::lock_guard lock(storedLock_);
+        storedBackend_ = dstBackend;
+        storedLedger_ = srcLedger;
+    }
+
     return true;
 }
 
@@ -403,6 +534,8 @@ Database::getCountsJson(Json::Value& obj)
         obj[jss::node_writes_delayed] = std::to_string(c->writesDelayed);
         obj[jss::node_writes_duration_us] = std::to_string(c->writeDurationUs);
     }
+
+    getBackendCountsJson(obj);
 }
 
 }  // namespace NodeStore
@@ -109,7 +109,7 @@ DatabaseNodeImp::fetchNodeObject(
                     else
                     {
                         auto notFound =
-                            NodeObject::createObject(hotDUMMY, {}, hash);
+                            NodeObject::createObject(hotDUMMY, Blob{}, hash);
                         cache_->canonicalize_replace_client(hash, notFound);
                         if (notFound->getType() != hotDUMMY)
                             nodeObject = notFound;
@@ -197,7 +197,8 @@ DatabaseNodeImp::fetchBatch(std::vector<uint256> const& hashes)
                 << "record not found in db or cache. hash = " << strHex(hash);
             if (cache_)
             {
-                auto notFound = NodeObject::createObject(hotDUMMY, {}, hash);
+                auto notFound =
+                    NodeObject::createObject(hotDUMMY, Blob{}, hash);
                 cache_->canonicalize_replace_client(hash, notFound);
                 if (notFound->getType() != hotDUMMY)
                     nObj = std::move(notFound);
@@ -214,5 +215,75 @@ DatabaseNodeImp::fetchBatch(std::vector<uint256> const& hashes)
     return results;
 }
 
+std::vector<std::shared_ptr<NodeObject>>
+DatabaseNodeImp::fetchNodeObjects(
+    std::vector<std::pair<uint256, std::uint32_t>> const& requests)
+{
+    using namespace std::chrono;
+    auto const before = steady_clock::now();
+
+    std::vector<std::shared_ptr<NodeObject>> results{requests.size()};
+    std::vector<uint256 const*> cacheMisses;
+    std::vector<std::size_t> missIndex;
+
+    for (std::size_t i = 0; i < requests.size(); ++i)
+    {
+        auto const& hash = requests[i].first;
+        auto nObj = cache_ ? cache_->fetch(hash) : nullptr;
+        if (!nObj)
+        {
+            cacheMisses.push_back(&hash);
+            missIndex.push_back(i);
+        }
+        else if (nObj->getType() != hotDUMMY)
+            results[i] = std::move(nObj);
+    }
+
+    if (!cacheMisses.empty())
+    {
+        std::vector<std::shared_ptr<NodeObject>> dbResults;
+        try
+        {
+            dbResults = backend_->fetchBatch(cacheMisses).first;
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.fatal()) << "fetchNodeObjects: Exception fetching "
+                             << cacheMisses.size()
+                             << " records from backend: " << e.what();
+            Rethrow();
+        }
+
+        assert(dbResults.size() == cacheMisses.size());
+        for (std::size_t i = 0; i < dbResults.size(); ++i)
+        {
+            auto nObj = std::move(dbResults[i]);
+            auto const& hash = *cacheMisses[i];
+
+            if (cache_)
+            {
+                if (nObj)
+                    cache_->canonicalize_replace_client(hash, nObj);
+                else
+                {
+                    auto notFound =
+                        NodeObject::createObject(hotDUMMY, Blob{}, hash);
+                    cache_->canonicalize_replace_client(hash, notFound);
+                    if (notFound->getType() != hotDUMMY)
+                        nObj = std::move(notFound);
+                }
+            }
+            results[missIndex[i]] = std::move(nObj);
+        }
+    }
+
+    JLOG(j_.trace()) << "fetchNodeObjects: " << requests.size()
+                     << " requests, " << cacheMisses.size()
+                     << " read from backend";
+
+    batchFetchStats(results, steady_clock::now() - before);
+    return results;
+}
+
 }  // namespace NodeStore
 }  // namespace ripple
@@ -20,7 +20,7 @@
 #ifndef RIPPLE_NODESTORE_DATABASENODEIMP_H_INCLUDED
 #define RIPPLE_NODESTORE_DATABASENODEIMP_H_INCLUDED
 
-#include <ripple/basics/TaggedCache.h>
+#include <ripple/basics/ShardedTaggedCache.h>
 #include <ripple/basics/chrono.h>
 #include <ripple/nodestore/Database.h>
 
@@ -68,7 +68,7 @@ public:
 
         if (cacheSize != 0 || cacheAge != 0)
         {
-            cache_ = std::make_shared<TaggedCache<uint256, NodeObject>>(
+            cache_ = std::make_shared<Cache>(
                 "DatabaseNodeImp",
                 cacheSize.value_or(0),
                 std::chrono::minutes(cacheAge.value_or(0)),
@@ -131,16 +131,18 @@ public:
     bool
     storeLedger(std::shared_ptr<Ledger const> const& srcLedger) override
     {
-        return Database::storeLedger(*srcLedger, backend_);
+        return Database::storeLedger(srcLedger, backend_);
     }
 
     void
     sweep() override;
 
 private:
+    using Cache = ShardedTaggedCache<uint256, NodeObject, digest_hash>;
+
     // Cache for database objects. This cache is not always initialized. Check
     // for null before using.
-    std::shared_ptr<TaggedCache<uint256, NodeObject>> cache_;
+    std::shared_ptr<Cache> cache_;
     // Persistent key/value storage
     std::shared_ptr<Backend> backend_;
 
@@ -151,6 +153,10 @@ private:
         FetchReport& fetchReport,
         bool duplicate) override;
 
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchNodeObjects(std::vector<std::pair<uint256, std::uint32_t>> const&
+                         requests) override;
+
     void
     for_each(std::function<void(std::shared_ptr<NodeObject>)> f) override
     {
@@ -162,6 +168,12 @@ private:
     {
         return backend_->counters();
     }
+
+    void
+    getBackendCountsJson(Json::Value& obj) const override
+    {
+        backend_->getCountsJson(obj);
+    }
 };
 
 }  // namespace NodeStore
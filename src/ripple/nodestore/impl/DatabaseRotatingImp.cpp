@@ -18,27 +18,87 @@
 //==============================================================================
 
 #include <ripple/app/ledger/Ledger.h>
+#include <ripple/basics/chrono.h>
 #include <ripple/nodestore/impl/DatabaseRotatingImp.h>
 #include <ripple/protocol/HashPrefix.h>
+#include <boost/filesystem/operations.hpp>
 
 namespace ripple {
 namespace NodeStore {
 
+// Where the Bloom filter of a backend is saved. Only backends stored in a
+// directory of their own get one, so it is removed along with the backend.
+static std::optional<boost::filesystem::path>
+filterPath(Backend& backend)
+{
+    boost::filesystem::path const dir = backend.getName();
+    boost::system::error_code ec;
+    if (!boost::filesystem::is_directory(dir, ec))
+        return std::nullopt;
+    return dir / "bloom_filter";
+}
+
 DatabaseRotatingImp::DatabaseRotatingImp(
     Scheduler& scheduler,
     int readThreads,
     std::shared_ptr<Backend> writableBackend,
     std::shared_ptr<Backend> archiveBackend,
     Section const& config,
-    beast::Journal j)
+    beast::Journal j,
+    std::shared_ptr<Backend> coldBackend)
     : DatabaseRotating(scheduler, readThreads, config, j)
     , writableBackend_(std::move(writableBackend))
     , archiveBackend_(std::move(archiveBackend))
+    , coldBackend_(std::move(coldBackend))
+    , missing_(
+          get<std::size_t>(config, "negative_cache_size", 16384),
+          std::chrono::seconds(get<int>(config, "negative_cache_age", 10)),
+          stopwatch())
+    , filterObjects_(get<std::uint64_t>(config, "bloom_filter_objects", 0))
 {
     if (writableBackend_)
+    {
         fdRequired_ += writableBackend_->fdRequired();
+        writableFilter_ = openFilter(*writableBackend_);
+    }
     if (archiveBackend_)
+    {
         fdRequired_ += archiveBackend_->fdRequired();
+        archiveFilter_ = openFilter(*archiveBackend_);
+    }
+    if (coldBackend_)
+        fdRequired_ += coldBackend_->fdRequired();
+}
+
+std::shared_ptr<BloomFilter>
+DatabaseRotatingImp::openFilter(Backend& backend) const
+{
+    auto filter = std::make_shared<BloomFilter>(filterObjects_);
+    if (filter->enabled())
+    {
+        if (auto const path = filterPath(backend))
+            filter->load(*path, j_);
+        if (!filter->complete())
+            JLOG(j_.info()) << "No Bloom filter for " << backend.getName()
+                            << ", lookups won't be skipped until it is rotated"
+                            << " out";
+    }
+    return filter;
+}
+
+void
+DatabaseRotatingImp::saveFilters() const
+{
+    std::lock_guard lock(mutex_);
+    for (auto const& [backend, filter] :
+         {std::pair{writableBackend_, writableFilter_},
+          std::pair{archiveBackend_, archiveFilter_}})
+    {
+        if (!backend || !filter->complete())
+            continue;
+        if (auto const path = filterPath(*backend))
+            filter->save(*path, j_);
+    }
 }
 
 void
@@ -46,12 +106,64 @@ DatabaseRotatingImp::rotateWithLock(
     std::function<std::unique_ptr<NodeStore::Backend>(
         std::string const& writableBackendName)> const& f)
 {
-    std::lock_guard lock(mutex_);
+    std::shared_ptr<Backend> retiring;
+    {
+        std::lock_guard lock(mutex_);
+
+        auto newBackend = f(writableBackend_->getName());
+        if (coldBackend_)
+            retiringBackend_ = retiring = std::move(archiveBackend_);
+        else
+            archiveBackend_->setDeletePath();
+        archiveBackend_ = std::move(writableBackend_);
+        writableBackend_ = std::move(newBackend);
+        missing_.clear();
+
+        // The new backend is empty, so its filter sees every key stored in it
+        archiveFilter_ = std::move(writableFilter_);
+        writableFilter_ = std::make_shared<BloomFilter>(filterObjects_);
+        writableFilter_->setComplete(true);
+    }
+
+    if (retiring)
+        demote(retiring);
+}
+
+void
+DatabaseRotatingImp::demote(std::shared_ptr<Backend> const& backend)
+{
+    JLOG(j_.info()) << "Moving " << backend->getName() << " to "
+                    << coldBackend_->getName();
+
+    // The retired backend stays readable until every object is copied, so
+    // nothing goes missing in between.
+    std::uint64_t count = 0;
+    Batch batch;
+    batch.reserve(batchWritePreallocationSize);
+    backend->for_each([&](std::shared_ptr<NodeObject> nodeObject) {
+        batch.emplace_back(std::move(nodeObject));
+        if (batch.size() >= batchWritePreallocationSize)
+        {
+            coldBackend_->storeBatch(batch);
+            count += batch.size();
+            batch.clear();
+        }
+    });
+    if (!batch.empty())
+    {
+        coldBackend_->storeBatch(batch);
+        count += batch.size();
+    }
+    coldBackend_->sync();
+
+    {
+        std::lock_guard lock(mutex_);
+        retiringBackend_.reset();
+    }
+    backend->setDeletePath();
 
-    auto newBackend = f(writableBackend_->getName());
-    archiveBackend_->setDeletePath();
-    archiveBackend_ = std::move(writableBackend_);
-    writableBackend_ = std::move(newBackend);
+    JLOG(j_.info()) << "Moved " << count << " objects to "
+                    << coldBackend_->getName();
 }
 
 std::string
@@ -69,25 +181,42 @@ DatabaseRotatingImp::getWriteLoad() const
 }
 
 void
-DatabaseRotatingImp::importDatabase(Database& source)
+DatabaseRotatingImp::getBackendCountsJson(Json::Value& obj) const
 {
     auto const backend = [&] {
         std::lock_guard lock(mutex_);
         return writableBackend_;
     }();
+    backend->getCountsJson(obj);
+}
+
+void
+DatabaseRotatingImp::importDatabase(Database& source)
+{
+    auto const [backend, filter] = [&] {
+        std::lock_guard lock(mutex_);
+        return std::make_pair(writableBackend_, writableFilter_);
+    }();
 
+    // The imported keys bypass the filter
+    filter->setComplete(false);
     importInternal(*backend, source);
+    missing_.clear();
 }
 
 bool
 DatabaseRotatingImp::storeLedger(std::shared_ptr<Ledger const> const& srcLedger)
 {
-    auto const backend = [&] {
+    auto const [backend, filter] = [&] {
         std::lock_guard lock(mutex_);
-        return writableBackend_;
+        return std::make_pair(writableBackend_, writableFilter_);
     }();
 
-    return Database::storeLedger(*srcLedger, backend);
+    // The keys of the ledger bypass the filter
+    filter->setComplete(false);
+    auto const stored = Database::storeLedger(srcLedger, backend);
+    missing_.clear();
+    return stored;
 }
 
 void
@@ -106,12 +235,14 @@ DatabaseRotatingImp::store(
 {
     auto nObj = NodeObject::createObject(type, std::move(data), hash);
 
-    auto const backend = [&] {
+    auto const [backend, filter] = [&] {
         std::lock_guard lock(mutex_);
-        return writableBackend_;
+        return std::make_pair(writableBackend_, writableFilter_);
     }();
 
+    filter->insert(hash);
     backend->store(nObj);
+    missing_.erase(hash);
     storeStats(1, nObj->getData().size());
 }
 
@@ -128,6 +259,12 @@ DatabaseRotatingImp::fetchNodeObject(
     FetchReport& fetchReport,
     bool duplicate)
 {
+    // Skip the backends if they recently didn't have the object
+    if (missing_.contains(hash))
+        return nullptr;
+    auto const ticket = missing_.ticket(hash);
+    bool notFoundAnywhere = true;
+
     auto fetch = [&](std::shared_ptr<Backend> const& backend) {
         Status status;
         std::shared_ptr<NodeObject> nodeObject;
@@ -148,9 +285,11 @@ DatabaseRotatingImp::fetchNodeObject(
                 break;
             case dataCorrupt:
                 JLOG(j_.fatal()) << "Corrupt NodeObject #" << hash;
+                notFoundAnywhere = false;
                 break;
             default:
                 JLOG(j_.warn()) << "Unknown status=" << status;
+                notFoundAnywhere = false;
                 break;
         }
 
@@ -160,37 +299,178 @@ DatabaseRotatingImp::fetchNodeObject(
     // See if the node object exists in the cache
     std::shared_ptr<NodeObject> nodeObject;
 
-    auto [writable, archive] = [&] {
+    auto [writable, archive, retiring, writableFilter, archiveFilter] = [&] {
         std::lock_guard lock(mutex_);
-        return std::make_pair(writableBackend_, archiveBackend_);
+        return std::make_tuple(
+            writableBackend_,
+            archiveBackend_,
+            retiringBackend_,
+            writableFilter_,
+            archiveFilter_);
     }();
 
     // Try to fetch from the writable backend
-    nodeObject = fetch(writable);
+    if (!writableFilter->excludes(hash))
+        nodeObject = fetch(writable);
     if (!nodeObject)
     {
-        // Otherwise try to fetch from the archive backend
-        nodeObject = fetch(archive);
+        // Otherwise try to fetch from the archive backend, and then from
+        // the cold backend and any backend being moved to it
+        if (!archiveFilter->excludes(hash))
+            nodeObject = fetch(archive);
+        if (!nodeObject && retiring)
+            nodeObject = fetch(retiring);
+        if (!nodeObject && coldBackend_)
+            nodeObject = fetch(coldBackend_);
         if (nodeObject)
         {
             {
                 // Refresh the writable backend pointer
                 std::lock_guard lock(mutex_);
                 writable = writableBackend_;
+                writableFilter = writableFilter_;
             }
 
-            // Update writable backend with data from the archive backend
+            // Update writable backend with data from the older backends
             if (duplicate)
+            {
+                writableFilter->insert(hash);
                 writable->store(nodeObject);
+            }
         }
     }
 
     if (nodeObject)
         fetchReport.wasFound = true;
+    else if (notFoundAnywhere)
+        missing_.insert(hash, ticket);
 
     return nodeObject;
 }
 
+std::vector<std::shared_ptr<NodeObject>>
+DatabaseRotatingImp::fetchNodeObjects(
+    std::vector<std::pair<uint256, std::uint32_t>> const& requests)
+{
+    using namespace std::chrono;
+    auto const before = steady_clock::now();
+
+    auto fetch = [&](std::shared_ptr<Backend> const& backend,
+                     std::vector<uint256 const*> const& hashes) {
+        try
+        {
+            return backend->fetchBatch(hashes).first;
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.fatal()) << "Exception, " << e.what();
+            Rethrow();
+        }
+    };
+
+    auto const [writable, archive, retiring, writableFilter, archiveFilter] =
+        [&] {
+            std::lock_guard lock(mutex_);
+            return std::make_tuple(
+                writableBackend_,
+                archiveBackend_,
+                retiringBackend_,
+                writableFilter_,
+                archiveFilter_);
+        }();
+
+    // Skip the objects the backends recently didn't have
+    std::vector<std::shared_ptr<NodeObject>> results(requests.size());
+    std::vector<uint256 const*> hashes;
+    std::vector<std::size_t> hashIndex;
+    std::vector<std::uint64_t> tickets;
+    hashes.reserve(requests.size());
+    hashIndex.reserve(requests.size());
+    tickets.reserve(requests.size());
+    for (std::size_t i = 0; i < requests.size(); ++i)
+    {
+        auto const& hash = requests[i].first;
+        if (missing_.contains(hash))
+            continue;
+        tickets.push_back(missing_.ticket(hash));
+        hashes.push_back(&hash);
+        hashIndex.push_back(i);
+    }
+
+    // Fetch from a backend whatever its filter doesn't exclude
+    auto fetchFiltered = [&fetch](
+                             std::shared_ptr<Backend> const& backend,
+                             BloomFilter const& filter,
+                             std::vector<uint256 const*> const& keys) {
+        std::vector<uint256 const*> kept;
+        std::vector<std::size_t> keptIndex;
+        for (std::size_t i = 0; i < keys.size(); ++i)
+        {
+            if (!filter.excludes(*keys[i]))
+            {
+                kept.push_back(keys[i]);
+                keptIndex.push_back(i);
+            }
+        }
+
+        std::vector<std::shared_ptr<NodeObject>> found(keys.size());
+        if (!kept.empty())
+        {
+            auto fetched = fetch(backend, kept);
+            assert(fetched.size() == kept.size());
+            for (std::size_t i = 0; i < fetched.size(); ++i)
+                found[keptIndex[i]] = std::move(fetched[i]);
+        }
+        return found;
+    };
+
+    if (!hashes.empty())
+    {
+        // Try to fetch everything from the writable backend
+        auto fetched = fetchFiltered(writable, *writableFilter, hashes);
+
+        // Then look for whatever is left in each older backend in turn
+        auto fetchMisses = [&](std::shared_ptr<Backend> const& backend,
+                               BloomFilter const* filter) {
+            std::vector<uint256 const*> misses;
+            std::vector<std::size_t> missIndex;
+            for (std::size_t i = 0; i < fetched.size(); ++i)
+            {
+                if (!fetched[i])
+                {
+                    misses.push_back(hashes[i]);
+                    missIndex.push_back(i);
+                }
+            }
+
+            if (misses.empty())
+                return;
+
+            auto found = filter ? fetchFiltered(backend, *filter, misses)
+                                : fetch(backend, misses);
+            assert(found.size() == misses.size());
+            for (std::size_t i = 0; i < found.size(); ++i)
+                fetched[missIndex[i]] = std::move(found[i]);
+        };
+
+        fetchMisses(archive, archiveFilter.get());
+        if (retiring)
+            fetchMisses(retiring, nullptr);
+        if (coldBackend_)
+            fetchMisses(coldBackend_, nullptr);
+
+        for (std::size_t i = 0; i < fetched.size(); ++i)
+        {
+            if (!fetched[i])
+                missing_.insert(*hashes[i], tickets[i]);
+            results[hashIndex[i]] = std::move(fetched[i]);
+        }
+    }
+
+    batchFetchStats(results, steady_clock::now() - before);
+    return results;
+}
+
 void
 DatabaseRotatingImp::for_each(
     std::function<void(std::shared_ptr<NodeObject>)> f)
@@ -205,6 +485,10 @@ DatabaseRotatingImp::for_each(
 
     // Iterate the archive backend
     archive->for_each(f);
+
+    // Iterate the cold backend
+    if (coldBackend_)
+        coldBackend_->for_each(f);
 }
 
 }  // namespace NodeStore
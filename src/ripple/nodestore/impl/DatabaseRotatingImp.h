@@ -21,6 +21,8 @@
 #define RIPPLE_NODESTORE_DATABASEROTATINGIMP_H_INCLUDED
 
 #include <ripple/nodestore/DatabaseRotating.h>
+#include <ripple/nodestore/impl/BloomFilter.h>
+#include <ripple/nodestore/impl/NegativeCache.h>
 
 namespace ripple {
 namespace NodeStore {
@@ -39,11 +41,13 @@ public:
         std::shared_ptr<Backend> writableBackend,
         std::shared_ptr<Backend> archiveBackend,
         Section const& config,
-        beast::Journal j);
+        beast::Journal j,
+        std::shared_ptr<Backend> coldBackend = nullptr);
 
     ~DatabaseRotatingImp()
     {
         stop();
+        saveFilters();
     }
 
     void
@@ -84,6 +88,21 @@ private:
     std::shared_ptr<Backend> archiveBackend_;
     mutable std::mutex mutex_;
 
+    // If set, the contents of each rotated out archive backend are moved
+    // here rather than deleted, and lookups fall back to it
+    std::shared_ptr<Backend> const coldBackend_;
+
+    // The rotated out archive backend while it is moved to the cold backend
+    std::shared_ptr<Backend> retiringBackend_;
+
+    // Keys stored in each backend, used to skip lookups that would miss
+    std::uint64_t const filterObjects_;
+    std::shared_ptr<BloomFilter> writableFilter_;
+    std::shared_ptr<BloomFilter> archiveFilter_;
+
+    // Keys recently found in neither backend
+    NegativeCache missing_;
+
     std::shared_ptr<NodeObject>
     fetchNodeObject(
         uint256 const& hash,
@@ -91,8 +110,30 @@ private:
         FetchReport& fetchReport,
         bool duplicate) override;
 
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchNodeObjects(std::vector<std::pair<uint256, std::uint32_t>> const&
+                         requests) override;
+
     void
     for_each(std::function<void(std::shared_ptr<NodeObject>)> f) override;
+
+    // Only the writable backend is reported, it serves most of the reads
+    void
+    getBackendCountsJson(Json::Value& obj) const override;
+
+    // Create the filter of a backend, reading it from beside the backend if
+    // it was saved when the backend was last closed
+    std::shared_ptr<BloomFilter>
+    openFilter(Backend& backend) const;
+
+    // Save the complete filters beside their backends
+    void
+    saveFilters() const;
+
+    // Copy a rotated out archive backend to the cold backend, then let it
+    // be deleted
+    void
+    demote(std::shared_ptr<Backend> const& backend);
 };
 
 }  // namespace NodeStore
@@ -36,6 +36,9 @@
 
 #include <boost/algorithm/string/predicate.hpp>
 
+#include <algorithm>
+#include <thread>
+
 #if BOOST_OS_LINUX
 #include <sys/statvfs.h>
 #endif
@@ -589,7 +592,7 @@ DatabaseShardImp::fetchLedger(uint256 const& hash, std::uint32_t ledgerSeq)
     };
 
     auto ledger{std::make_shared<Ledger>(
-        deserializePrefixedHeader(makeSlice(nodeObject->getData())),
+        deserializePrefixedHeader(nodeObject->getData()),
         app_.config(),
         *app_.getShardFamily())};
 
@@ -1376,6 +1379,18 @@ DatabaseShardImp::initConfig(std::lock_guard<std::mutex> const&)
     if (!boost::iequals(backendName_, "NuDB"))
         return fail("'type' value unsupported");
 
+    // Each shard is finalized by verifying its ledgers one after another,
+    // which is bound by a single core. Finalizing several shards at once
+    // keeps the storage busy instead.
+    {
+        std::uint32_t finalizeThreads{std::clamp(
+            std::thread::hardware_concurrency() / 4, 1u, 4u)};
+        get_if_exists(section, "finalize_threads", finalizeThreads);
+        if (finalizeThreads == 0)
+            return fail("'finalize_threads' must be positive");
+        taskQueue_.setThreads(finalizeThreads);
+    }
+
     return true;
 }
 
@@ -78,10 +78,10 @@ DecodedBlob::createObject()
 
     if (m_success)
     {
-        Blob data(m_objectData, m_objectData + m_dataBytes);
-
         object = NodeObject::createObject(
-            m_objectType, std::move(data), uint256::fromVoid(m_key));
+            m_objectType,
+            Slice(m_objectData, m_dataBytes),
+            uint256::fromVoid(m_key));
     }
 
     return object;
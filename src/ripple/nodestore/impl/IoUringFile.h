@@ -0,0 +1,344 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_NODESTORE_IOURINGFILE_H_INCLUDED
+#define RIPPLE_NODESTORE_IOURINGFILE_H_INCLUDED
+
+#include <ripple/nodestore/impl/IoUringQueue.h>
+
+#if RIPPLE_IO_URING_AVAILABLE
+
+#include <ripple/basics/ByteUtilities.h>
+#include <ripple/basics/scope.h>
+#include <boost/coroutine/all.hpp>
+#include <nudb/posix_file.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+namespace NodeStore {
+
+/** Runs functions side by side so that their reads go to the ring together.
+
+    Each function runs as a coroutine on the calling thread. A read through
+    an IoUringFile on the same queue suspends the coroutine; once every
+    coroutine is suspended or done, the reads they are waiting for are
+    submitted with a single system call, reaped together, and the
+    coroutines resumed. At most one coroutine per slot of the queue runs at
+    a time.
+*/
+class IoUringBatch
+{
+    using Coro = boost::coroutines::asymmetric_coroutine<void>;
+
+    struct Task
+    {
+        std::optional<Coro::pull_type> coro;
+        Coro::push_type* yield = nullptr;
+        IoUringQueue::Read read;
+    };
+
+    IoUringQueue& queue_;
+    Task* running_ = nullptr;
+
+    static inline thread_local IoUringBatch* current_ = nullptr;
+
+    explicit IoUringBatch(IoUringQueue& queue) : queue_(queue)
+    {
+    }
+
+    void
+    resume(Task& task)
+    {
+        running_ = &task;
+        (*task.coro)();
+        running_ = nullptr;
+    }
+
+    void
+    start(Task& task, std::function<void(std::size_t)> const& f, std::size_t i)
+    {
+        running_ = &task;
+        task.coro.emplace(
+            [&task, &f, i](Coro::push_type& yield) {
+                task.yield = &yield;
+                f(i);
+            },
+            boost::coroutines::attributes(kilobytes(256)));
+        running_ = nullptr;
+    }
+
+public:
+    /** Call f with every index below count, the calls reading together.
+
+        An exception thrown by a call is rethrown once the calls already
+        suspended have been abandoned.
+    */
+    static void
+    run(IoUringQueue& queue,
+        std::size_t count,
+        std::function<void(std::size_t)> const& f)
+    {
+        IoUringBatch batch(queue);
+        auto const previous = std::exchange(current_, &batch);
+        scope_exit restore([previous]() noexcept { current_ = previous; });
+
+        std::vector<Task> tasks(std::min(count, queue.depth()));
+        std::vector<IoUringQueue::Read> reads;
+        std::vector<Task*> waiting;
+        std::size_t next = 0;
+        while (true)
+        {
+            reads.clear();
+            waiting.clear();
+            for (auto& task : tasks)
+            {
+                // A slot whose call is done takes the next index
+                while ((!task.coro || !*task.coro) && next < count)
+                    batch.start(task, f, next++);
+
+                if (task.coro && *task.coro)
+                {
+                    reads.push_back(task.read);
+                    waiting.push_back(&task);
+                }
+            }
+
+            if (waiting.empty())
+                break;
+
+            queue.read(reads);
+            for (std::size_t i = 0; i < waiting.size(); ++i)
+            {
+                waiting[i]->read.result = reads[i].result;
+                batch.resume(*waiting[i]);
+            }
+        }
+    }
+
+    /** The batch whose calls are running on this thread, if any. */
+    static IoUringBatch*
+    current()
+    {
+        return current_;
+    }
+
+    IoUringQueue&
+    queue() const
+    {
+        return queue_;
+    }
+
+    /** Queue a read for the running call and suspend it until it's done.
+
+        @return As for IoUringQueue::read.
+    */
+    int
+    read(int fd, void* buffer, std::size_t bytes, std::uint64_t offset)
+    {
+        auto& task = *running_;
+        task.read = {fd, buffer, bytes, offset};
+        (*task.yield)();
+        return task.read.result;
+    }
+};
+
+/** A NuDB File whose reads go through an IoUringQueue.
+
+    Everything except reads is delegated to nudb::posix_file. Reads use a
+    second, read-only descriptor on the same file so that they can be
+    handed to the ring. Reads made within an IoUringBatch on the same
+    queue are submitted along with the batch's other reads.
+*/
+class IoUringFile
+{
+    nudb::posix_file file_;
+    std::shared_ptr<IoUringQueue> queue_;
+    int fd_ = -1;
+
+public:
+    explicit IoUringFile(std::shared_ptr<IoUringQueue> queue)
+        : queue_(std::move(queue))
+    {
+        assert(queue_);
+    }
+
+    IoUringFile(IoUringFile const&) = delete;
+    IoUringFile&
+    operator=(IoUringFile const&) = delete;
+
+    IoUringFile(IoUringFile&& other)
+        : file_(std::move(other.file_))
+        , queue_(std::move(other.queue_))
+        , fd_(std::exchange(other.fd_, -1))
+    {
+    }
+
+    IoUringFile&
+    operator=(IoUringFile&& other)
+    {
+        if (&other != this)
+        {
+            close();
+            file_ = std::move(other.file_);
+            queue_ = std::move(other.queue_);
+            fd_ = std::exchange(other.fd_, -1);
+        }
+        return *this;
+    }
+
+    ~IoUringFile()
+    {
+        close();
+    }
+
+    bool
+    is_open() const
+    {
+        return file_.is_open();
+    }
+
+    void
+    close()
+    {
+        if (fd_ != -1)
+        {
+            ::close(fd_);
+            fd_ = -1;
+        }
+        file_.close();
+    }
+
+    void
+    create(
+        nudb::file_mode mode,
+        nudb::path_type const& path,
+        nudb::error_code& ec)
+    {
+        file_.create(mode, path, ec);
+        if (!ec)
+            openReader(path, ec);
+    }
+
+    void
+    open(
+        nudb::file_mode mode,
+        nudb::path_type const& path,
+        nudb::error_code& ec)
+    {
+        file_.open(mode, path, ec);
+        if (!ec)
+            openReader(path, ec);
+    }
+
+    static void
+    erase(nudb::path_type const& path, nudb::error_code& ec)
+    {
+        nudb::posix_file::erase(path, ec);
+    }
+
+    std::uint64_t
+    size(nudb::error_code& ec) const
+    {
+        return file_.size(ec);
+    }
+
+    void
+    read(
+        std::uint64_t offset,
+        void* buffer,
+        std::size_t bytes,
+        nudb::error_code& ec)
+    {
+        auto p = static_cast<char*>(buffer);
+        while (bytes > 0)
+        {
+            auto const batch = IoUringBatch::current();
+            auto const n = batch && &batch->queue() == queue_.get()
+                ? batch->read(fd_, p, bytes, offset)
+                : queue_->read(fd_, p, bytes, offset);
+            if (n == -EINTR || n == -EAGAIN)
+                continue;
+            if (n < 0)
+            {
+                ec = nudb::error_code{-n, nudb::system_category()};
+                return;
+            }
+            if (n == 0)
+            {
+                ec = nudb::error::short_read;
+                return;
+            }
+            offset += n;
+            p += n;
+            bytes -= n;
+        }
+    }
+
+    void
+    write(
+        std::uint64_t offset,
+        void const* buffer,
+        std::size_t bytes,
+        nudb::error_code& ec)
+    {
+        file_.write(offset, buffer, bytes, ec);
+    }
+
+    void
+    sync(nudb::error_code& ec)
+    {
+        file_.sync(ec);
+    }
+
+    void
+    trunc(std::uint64_t length, nudb::error_code& ec)
+    {
+        file_.trunc(length, ec);
+    }
+
+private:
+    void
+    openReader(nudb::path_type const& path, nudb::error_code& ec)
+    {
+        fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd_ == -1)
+        {
+            ec = nudb::error_code{errno, nudb::system_category()};
+            file_.close();
+        }
+    }
+};
+
+}  // namespace NodeStore
+}  // namespace ripple
+
+#endif
+
+#endif
@@ -0,0 +1,355 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/nodestore/impl/IoUringQueue.h>
+
+#if RIPPLE_IO_URING_AVAILABLE
+
+#include <ripple/basics/contract.h>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <vector>
+
+namespace ripple {
+namespace NodeStore {
+
+struct IoUringQueue::Request
+{
+    Read* read = nullptr;
+    iovec iov;
+    bool done = false;
+};
+
+namespace {
+
+int
+ioUringSetup(unsigned entries, io_uring_params* params)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int
+ioUringEnter(
+    int fd,
+    unsigned toSubmit,
+    unsigned minComplete,
+    unsigned flags)
+{
+    return static_cast<int>(syscall(
+        __NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+template <class T>
+T*
+offset(void* base, std::uint32_t off)
+{
+    return reinterpret_cast<T*>(static_cast<char*>(base) + off);
+}
+
+[[noreturn]] void
+throwErrno(char const* what)
+{
+    Throw<std::system_error>(
+        std::error_code(errno, std::system_category()), what);
+}
+
+}  // namespace
+
+IoUringQueue::IoUringQueue(std::size_t depth)
+    : depth_(std::clamp<std::size_t>(depth, 1, maxDepth))
+    , slots_(static_cast<std::ptrdiff_t>(depth_))
+{
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+
+    ringFd_ = ioUringSetup(static_cast<unsigned>(depth_), &params);
+    if (ringFd_ < 0)
+        throwErrno("io_uring_setup");
+
+    sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize_ =
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+    bool const singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMap)
+        sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+
+    sqRing_ = mmap(
+        nullptr,
+        sqRingSize_,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        ringFd_,
+        IORING_OFF_SQ_RING);
+    if (sqRing_ == MAP_FAILED)
+    {
+        sqRing_ = nullptr;
+        unmap();
+        throwErrno("io_uring mmap");
+    }
+
+    if (singleMap)
+        cqRing_ = sqRing_;
+    else
+    {
+        cqRing_ = mmap(
+            nullptr,
+            cqRingSize_,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE,
+            ringFd_,
+            IORING_OFF_CQ_RING);
+        if (cqRing_ == MAP_FAILED)
+        {
+            cqRing_ = nullptr;
+            unmap();
+            throwErrno("io_uring mmap");
+        }
+    }
+
+    sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+    auto const sqes = mmap(
+        nullptr,
+        sqesSize_,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        ringFd_,
+        IORING_OFF_SQES);
+    if (sqes == MAP_FAILED)
+    {
+        unmap();
+        throwErrno("io_uring mmap");
+    }
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    sqTail_ = offset<unsigned>(sqRing_, params.sq_off.tail);
+    sqMask_ = *offset<unsigned>(sqRing_, params.sq_off.ring_mask);
+    sqArray_ = offset<unsigned>(sqRing_, params.sq_off.array);
+    cqHead_ = offset<unsigned>(cqRing_, params.cq_off.head);
+    cqTail_ = offset<unsigned>(cqRing_, params.cq_off.tail);
+    cqMask_ = *offset<unsigned>(cqRing_, params.cq_off.ring_mask);
+    cqes_ = offset<io_uring_cqe>(cqRing_, params.cq_off.cqes);
+}
+
+IoUringQueue::~IoUringQueue()
+{
+    unmap();
+}
+
+void
+IoUringQueue::unmap()
+{
+    if (sqes_)
+        munmap(sqes_, sqesSize_);
+    if (cqRing_ && cqRing_ != sqRing_)
+        munmap(cqRing_, cqRingSize_);
+    if (sqRing_)
+        munmap(sqRing_, sqRingSize_);
+    if (ringFd_ >= 0)
+        ::close(ringFd_);
+
+    sqes_ = nullptr;
+    cqRing_ = nullptr;
+    sqRing_ = nullptr;
+    ringFd_ = -1;
+}
+
+int
+IoUringQueue::read(
+    int fd,
+    void* buffer,
+    std::size_t bytes,
+    std::uint64_t offset)
+{
+    Read r{fd, buffer, bytes, offset};
+    read(std::span<Read>(&r, 1));
+    return r.result;
+}
+
+void
+IoUringQueue::read(std::span<Read> reads)
+{
+    std::vector<Request> requests(reads.size());
+    for (std::size_t i = 0; i < reads.size(); ++i)
+    {
+        requests[i].read = &reads[i];
+        requests[i].iov.iov_base = reads[i].buffer;
+        requests[i].iov.iov_len = reads[i].bytes;
+    }
+
+    std::size_t next = 0;
+    while (next < requests.size())
+    {
+        // Block for a slot only while none of our reads is in flight, so
+        // that whoever holds the slots is reaping them.
+        auto const first = next;
+        slots_.acquire();
+        ++next;
+        while (next < requests.size() && slots_.try_acquire())
+            ++next;
+
+        auto const batch =
+            std::span<Request>(requests).subspan(first, next - first);
+        wait(batch.first(submit(batch)));
+    }
+}
+
+std::size_t
+IoUringQueue::submit(std::span<Request> requests)
+{
+    int err;
+    {
+        std::lock_guard lock(mutex_);
+        err = error_;
+    }
+
+    std::size_t submitted = 0;
+    if (err == 0)
+    {
+        std::lock_guard lock(submitMutex_);
+
+        unsigned const tail = *sqTail_;
+        for (std::size_t i = 0; i < requests.size(); ++i)
+        {
+            auto& request = requests[i];
+            unsigned const index = (tail + i) & sqMask_;
+            auto& sqe = sqes_[index];
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = IORING_OP_READV;
+            sqe.fd = request.read->fd;
+            sqe.off = request.read->offset;
+            sqe.addr = reinterpret_cast<std::uint64_t>(&request.iov);
+            sqe.len = 1;
+            sqe.user_data = reinterpret_cast<std::uint64_t>(&request);
+            sqArray_[index] = index;
+        }
+        __atomic_store_n(sqTail_, tail + requests.size(), __ATOMIC_RELEASE);
+
+        while (submitted < requests.size())
+        {
+            int const ret =
+                ioUringEnter(ringFd_, requests.size() - submitted, 0, 0);
+            if (ret > 0)
+                submitted += ret;
+            else if (ret == 0)
+                err = EAGAIN;
+            else if (errno != EINTR)
+                err = errno;
+            if (err != 0)
+                break;
+        }
+
+        // The kernel did not take the rest. Nothing else can have been
+        // queued behind them because we still hold the submission lock.
+        if (submitted < requests.size())
+            __atomic_store_n(sqTail_, tail + submitted, __ATOMIC_RELEASE);
+    }
+
+    for (auto& request : requests.subspan(submitted))
+    {
+        request.read->result = -err;
+        slots_.release();
+    }
+    return submitted;
+}
+
+void
+IoUringQueue::wait(std::span<Request> requests)
+{
+    auto const done = [&]() {
+        return std::all_of(
+            requests.begin(), requests.end(), [](Request const& request) {
+                return request.done;
+            });
+    };
+
+    std::unique_lock lock(mutex_);
+    while (!done())
+    {
+        if (error_ != 0)
+        {
+            // Nothing reaps the ring any more
+            for (auto& request : requests)
+            {
+                if (request.done)
+                    continue;
+                request.read->result = -error_;
+                request.done = true;
+                slots_.release();
+            }
+            break;
+        }
+
+        if (reaping_)
+        {
+            cv_.wait(lock, [&] { return done() || !reaping_; });
+            continue;
+        }
+
+        reaping_ = true;
+        lock.unlock();
+        reap();
+        lock.lock();
+        reaping_ = false;
+        cv_.notify_all();
+    }
+}
+
+void
+IoUringQueue::reap()
+{
+    int ret;
+    do
+    {
+        ret = ioUringEnter(ringFd_, 0, 1, IORING_ENTER_GETEVENTS);
+    } while (ret < 0 && errno == EINTR);
+    auto const err = ret < 0 ? errno : 0;
+
+    std::lock_guard lock(mutex_);
+
+    if (err != 0 && error_ == 0)
+        error_ = err;
+
+    unsigned head = *cqHead_;
+    unsigned const tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head)
+    {
+        auto const& cqe = cqes_[head & cqMask_];
+        auto request = reinterpret_cast<Request*>(cqe.user_data);
+        request->read->result = cqe.res;
+        request->done = true;
+        slots_.release();
+    }
+    __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+}
+
+}  // namespace NodeStore
+}  // namespace ripple
+
+#endif
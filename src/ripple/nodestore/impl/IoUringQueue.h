@@ -0,0 +1,168 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_NODESTORE_IOURINGQUEUE_H_INCLUDED
+#define RIPPLE_NODESTORE_IOURINGQUEUE_H_INCLUDED
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define RIPPLE_IO_URING_AVAILABLE 1
+#else
+#define RIPPLE_IO_URING_AVAILABLE 0
+#endif
+
+#if RIPPLE_IO_URING_AVAILABLE
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <semaphore>
+#include <span>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace ripple {
+namespace NodeStore {
+
+/** Submits file reads to the kernel through an io_uring.
+
+    Any number of threads may call read() concurrently. Each call places its
+    requests on the shared submission queue with a single system call and
+    then waits for them to finish. Rather than dedicating a thread to the
+    completion queue, whichever waiter gets there first reaps completions on
+    behalf of everyone until its own requests are done.
+
+    At most `depth` requests are in flight; further callers block until a
+    slot frees up.
+
+    If waiting for completions fails for any reason other than a signal,
+    the ring is unusable: the reads still waiting, and every later read,
+    fail with that error.
+*/
+class IoUringQueue
+{
+public:
+    static constexpr std::size_t defaultDepth = 64;
+    static constexpr std::size_t maxDepth = 4096;
+
+    /** A read to submit along with others. */
+    struct Read
+    {
+        int fd = -1;
+        void* buffer = nullptr;
+        std::size_t bytes = 0;
+        std::uint64_t offset = 0;
+
+        /** The number of bytes read, which may be fewer than requested, or
+            a negated errno value.
+        */
+        int result = 0;
+    };
+
+    /** Create the ring.
+
+        @throws std::system_error if the kernel refuses to create it.
+    */
+    explicit IoUringQueue(std::size_t depth);
+
+    ~IoUringQueue();
+
+    IoUringQueue(IoUringQueue const&) = delete;
+    IoUringQueue&
+    operator=(IoUringQueue const&) = delete;
+
+    /** Read from a file descriptor at the given offset.
+
+        @return The number of bytes read, which may be fewer than requested,
+                or a negated errno value.
+    */
+    int
+    read(int fd, void* buffer, std::size_t bytes, std::uint64_t offset);
+
+    /** Submit several reads together and wait for all of them.
+
+        As many reads as there are free slots go to the kernel in one
+        system call and are reaped together.
+    */
+    void
+    read(std::span<Read> reads);
+
+    std::size_t
+    depth() const
+    {
+        return depth_;
+    }
+
+private:
+    struct Request;
+
+    std::size_t const depth_;
+    int ringFd_ = -1;
+
+    // Shared memory mapped from the kernel
+    void* sqRing_ = nullptr;
+    std::size_t sqRingSize_ = 0;
+    void* cqRing_ = nullptr;
+    std::size_t cqRingSize_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    std::size_t sqesSize_ = 0;
+
+    unsigned* sqTail_ = nullptr;
+    unsigned sqMask_ = 0;
+    unsigned* sqArray_ = nullptr;
+    unsigned* cqHead_ = nullptr;
+    unsigned* cqTail_ = nullptr;
+    unsigned cqMask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+
+    std::counting_semaphore<maxDepth> slots_;
+
+    // Protects the submission queue
+    std::mutex submitMutex_;
+
+    // Protects the completion state of every request, reaping_ and error_
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool reaping_ = false;
+
+    // The errno value which left the ring unusable, if any
+    int error_ = 0;
+
+    // Submit the requests, returning the number the kernel took
+    std::size_t
+    submit(std::span<Request> requests);
+
+    // Wait for the requests to finish, reaping completions meanwhile
+    void
+    wait(std::span<Request> requests);
+
+    void
+    reap();
+
+    void
+    unmap();
+};
+
+}  // namespace NodeStore
+}  // namespace ripple
+
+#endif
+
+#endif
@@ -0,0 +1,197 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_NODESTORE_NEGATIVECACHE_H_INCLUDED
+#define RIPPLE_NODESTORE_NEGATIVECACHE_H_INCLUDED
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/beast/clock/abstract_clock.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace ripple {
+namespace NodeStore {
+
+/** A bounded cache of keys known to be missing from a database.
+
+    Keys map to a fixed number of slots, and a key replaces whatever key
+    previously occupied its slot. Entries expire after a configurable age,
+    and clear() forgets every entry at once by starting a new generation.
+
+    A lookup that misses races with a concurrent store of the same key, so
+    the caller takes a ticket before looking the key up, and insert() only
+    records the miss if nothing erased the slot since the ticket was taken.
+    Because some backends make writes visible asynchronously, the age also
+    bounds how long a miss can be remembered for a key that was just
+    stored.
+
+    @note This can be called concurrently.
+*/
+class NegativeCache
+{
+public:
+    using clock_type = beast::abstract_clock<std::chrono::steady_clock>;
+
+    /** Create the cache.
+
+        @param size The maximum number of entries, rounded up to a power
+                    of two. Zero disables the cache.
+        @param age How long a miss is remembered.
+        @param clock The clock used to expire entries.
+    */
+    NegativeCache(std::size_t size, clock_type::duration age, clock_type& clock)
+        : age_(age), clock_(clock)
+    {
+        if (size == 0 || age <= clock_type::duration::zero())
+            return;
+
+        std::size_t slots = 1;
+        while (slots < size)
+            slots <<= 1;
+        slots_.resize(slots);
+        mask_ = slots - 1;
+    }
+
+    NegativeCache(NegativeCache const&) = delete;
+    NegativeCache&
+    operator=(NegativeCache const&) = delete;
+
+    bool
+    enabled() const
+    {
+        return !slots_.empty();
+    }
+
+    /** Return whether the key is known to be missing. */
+    bool
+    contains(uint256 const& key) const
+    {
+        if (!enabled())
+            return false;
+
+        auto const i = index(key);
+        std::lock_guard lock(mutex(i));
+        auto const& slot = slots_[i];
+        return slot.used && slot.generation == generation_ &&
+            slot.key == key && slot.expires > clock_.now();
+    }
+
+    /** Return the ticket to pass to insert() after looking up the key. */
+    std::uint64_t
+    ticket(uint256 const& key) const
+    {
+        if (!enabled())
+            return 0;
+
+        auto const i = index(key);
+        std::lock_guard lock(mutex(i));
+        return (std::uint64_t{generation_} << 32) | slots_[i].version;
+    }
+
+    /** Remember that the key is missing.
+
+        @param key The key that was not found.
+        @param ticket The ticket taken before the key was looked up.
+    */
+    void
+    insert(uint256 const& key, std::uint64_t ticket)
+    {
+        if (!enabled())
+            return;
+
+        auto const i = index(key);
+        std::lock_guard lock(mutex(i));
+        auto& slot = slots_[i];
+        std::uint32_t const generation = generation_;
+        if (ticket != ((std::uint64_t{generation} << 32) | slot.version))
+            return;
+        slot.key = key;
+        slot.generation = generation;
+        slot.expires = clock_.now() + age_;
+        slot.used = true;
+    }
+
+    /** Forget that the key is missing, because it was stored. */
+    void
+    erase(uint256 const& key)
+    {
+        if (!enabled())
+            return;
+
+        auto const i = index(key);
+        std::lock_guard lock(mutex(i));
+        auto& slot = slots_[i];
+        // Reject the misses of lookups that started before the store
+        ++slot.version;
+        if (slot.key == key)
+            slot.used = false;
+    }
+
+    /** Forget every key. */
+    void
+    clear()
+    {
+        ++generation_;
+    }
+
+private:
+    struct Slot
+    {
+        uint256 key;
+        clock_type::time_point expires;
+        std::uint32_t generation = 0;
+        std::uint32_t version = 0;
+        bool used = false;
+    };
+
+    static constexpr std::size_t mutexes = 64;
+
+    clock_type::duration const age_;
+    clock_type& clock_;
+    std::vector<Slot> slots_;
+    std::size_t mask_ = 0;
+    std::atomic<std::uint32_t> generation_{0};
+    mutable std::array<std::mutex, mutexes> mutexes_;
+
+    std::size_t
+    index(uint256 const& key) const
+    {
+        // Keys are hashes already, so any of their bits will do
+        std::uint64_t bits;
+        std::memcpy(&bits, key.data(), sizeof(bits));
+        return static_cast<std::size_t>(bits) & mask_;
+    }
+
+    std::mutex&
+    mutex(std::size_t index) const
+    {
+        return mutexes_[index % mutexes];
+    }
+};
+
+}  // namespace NodeStore
+}  // namespace ripple
+
+#endif
@@ -0,0 +1,221 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <ripple/basics/FileUtilities.h>
+#include <ripple/basics/Log.h>
+#include <ripple/basics/contract.h>
+#include <ripple/nodestore/NodeObject.h>
+#include <ripple/nodestore/impl/NodeDictionary.h>
+#include <ripple/protocol/HashPrefix.h>
+#include <ripple/protocol/Serializer.h>
+#include <boost/filesystem/operations.hpp>
+
+#include <zdict.h>
+
+namespace ripple {
+namespace NodeStore {
+
+// Identifies a file written by save, and the version of its layout
+static std::uint32_t constexpr nodeDictionaryMagic = 0x524E4431;  // "RND1"
+
+NodeDictionary::NodeDictionary(
+    std::uint32_t version,
+    std::map<std::uint32_t, Blob> dictionaries)
+    : version_(version)
+{
+    for (auto& [family, data] : dictionaries)
+    {
+        auto& entry = entries_[family];
+        entry.data = std::move(data);
+        entry.cdict.reset(ZSTD_createCDict(
+            entry.data.data(), entry.data.size(), compressionLevel));
+        entry.ddict.reset(
+            ZSTD_createDDict(entry.data.data(), entry.data.size()));
+        if (!entry.cdict || !entry.ddict)
+            Throw<std::runtime_error>(
+                "NodeDictionary: bad dictionary for family " +
+                std::to_string(family));
+    }
+}
+
+std::uint32_t
+NodeDictionary::family(void const* data, std::size_t size)
+{
+    // The layout is 8 unused bytes, the type and then the payload
+    auto const p = static_cast<std::uint8_t const*>(data);
+    if (size < 9)
+        return 0;
+
+    std::uint32_t const type = p[8];
+
+    // The payload of an account state leaf is its prefix, then the entry.
+    // The first field of an entry is always sfLedgerEntryType, whose
+    // header byte is 0x11 (a UINT16, field 1).
+    if (type == hotACCOUNT_NODE && size >= 16 && p[13] == 0x11)
+    {
+        std::uint32_t const prefix = (std::uint32_t{p[9]} << 24) |
+            (std::uint32_t{p[10]} << 16) | (std::uint32_t{p[11]} << 8) |
+            std::uint32_t{p[12]};
+        if (prefix == static_cast<std::uint32_t>(HashPrefix::leafNode))
+            return (type << 16) | (std::uint32_t{p[14]} << 8) | p[15];
+    }
+
+    return type << 16;
+}
+
+ZSTD_CDict const*
+NodeDictionary::compressor(std::uint32_t family) const
+{
+    auto const it = entries_.find(family);
+    return it == entries_.end() ? nullptr : it->second.cdict.get();
+}
+
+ZSTD_DDict const*
+NodeDictionary::decompressor(std::uint32_t family) const
+{
+    auto const it = entries_.find(family);
+    return it == entries_.end() ? nullptr : it->second.ddict.get();
+}
+
+void
+NodeDictionary::save(boost::filesystem::path const& file) const
+{
+    Serializer s;
+    s.add32(nodeDictionaryMagic);
+    s.add32(version_);
+    s.add32(static_cast<std::uint32_t>(entries_.size()));
+    for (auto const& [family, entry] : entries_)
+    {
+        s.add32(family);
+        s.add32(static_cast<std::uint32_t>(entry.data.size()));
+        s.addRaw(entry.data);
+    }
+
+    boost::system::error_code ec;
+    writeFileContentsAtomic(ec, file, s.getString());
+    if (ec)
+        Throw<std::runtime_error>(
+            "NodeDictionary: unable to write " + file.string() + ": " +
+            ec.message());
+}
+
+std::shared_ptr<NodeDictionary const>
+NodeDictionary::load(boost::filesystem::path const& file)
+{
+    boost::system::error_code ec;
+    auto const data = getFileContents(ec, file);
+    if (ec)
+        Throw<std::runtime_error>(
+            "NodeDictionary: unable to read " + file.string() + ": " +
+            ec.message());
+
+    SerialIter sit(makeSlice(data));
+    if (sit.get32() != nodeDictionaryMagic)
+        Throw<std::runtime_error>(
+            "NodeDictionary: unrecognized file " + file.string());
+
+    auto const version = sit.get32();
+    std::map<std::uint32_t, Blob> dictionaries;
+    for (auto count = sit.get32(); count; --count)
+    {
+        auto const family = sit.get32();
+        auto const size = sit.get32();
+        auto const slice = sit.getSlice(size);
+        dictionaries[family].assign(slice.begin(), slice.end());
+    }
+    if (!sit.empty())
+        Throw<std::runtime_error>(
+            "NodeDictionary: trailing data in " + file.string());
+
+    return std::make_shared<NodeDictionary const>(
+        version, std::move(dictionaries));
+}
+
+//------------------------------------------------------------------------------
+
+NodeDictionary::Trainer::Trainer(std::size_t dictionarySize)
+    : dictionarySize_(dictionarySize)
+{
+}
+
+void
+NodeDictionary::Trainer::insert(void const* data, std::size_t size)
+{
+    // Large values don't need a dictionary, and zstd recommends about
+    // a hundred times the dictionary size in samples.
+    if (size > dictionarySize_)
+        return;
+
+    auto& samples = samples_[family(data, size)];
+    if (samples.data.size() + size > 100 * dictionarySize_)
+        return;
+
+    auto const p = static_cast<std::uint8_t const*>(data);
+    samples.data.insert(samples.data.end(), p, p + size);
+    samples.sizes.push_back(size);
+}
+
+std::shared_ptr<NodeDictionary const>
+NodeDictionary::Trainer::finish(std::uint32_t version, beast::Journal j)
+{
+    // Fewer samples than this train a dictionary that barely helps
+    std::size_t constexpr minSamples = 1000;
+
+    std::map<std::uint32_t, Blob> dictionaries;
+    for (auto const& [family, samples] : samples_)
+    {
+        if (samples.sizes.size() < minSamples)
+        {
+            JLOG(j.info()) << "NodeDictionary: " << samples.sizes.size()
+                           << " samples of family " << std::hex << family
+                           << std::dec << " are too few to train on";
+            continue;
+        }
+
+        Blob dictionary(dictionarySize_);
+        auto const size = ZDICT_trainFromBuffer(
+            dictionary.data(),
+            dictionary.size(),
+            samples.data.data(),
+            samples.sizes.data(),
+            samples.sizes.size());
+        if (ZDICT_isError(size))
+        {
+            JLOG(j.warn()) << "NodeDictionary: training family " << std::hex
+                           << family << std::dec
+                           << " failed: " << ZDICT_getErrorName(size);
+            continue;
+        }
+
+        dictionary.resize(size);
+        JLOG(j.info()) << "NodeDictionary: trained " << size
+                       << " bytes for family " << std::hex << family
+                       << std::dec << " from " << samples.sizes.size()
+                       << " samples";
+        dictionaries.emplace(family, std::move(dictionary));
+    }
+
+    samples_.clear();
+    return std::make_shared<NodeDictionary const>(
+        version, std::move(dictionaries));
+}
+
+}  // namespace NodeStore
+}  // namespace ripple
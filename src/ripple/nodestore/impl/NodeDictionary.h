@@ -0,0 +1,154 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#ifndef RIPPLE_NODESTORE_NODEDICTIONARY_H_INCLUDED
+#define RIPPLE_NODESTORE_NODEDICTIONARY_H_INCLUDED
+
+#include <ripple/basics/Blob.h>
+#include <ripple/beast/utility/Journal.h>
+#include <boost/filesystem/path.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+#include <zstd.h>
+
+namespace ripple {
+namespace NodeStore {
+
+/** A versioned set of zstd dictionaries for NodeStore values.
+
+    Values of the same kind, such as the ledger entries of one type, are
+    small and share most of their structure, so they compress badly on
+    their own. A dictionary trained on samples of that kind supplies the
+    shared structure up front.
+
+    Values are grouped into families by their NodeObjectType and, for
+    account state leaves, their LedgerEntryType. There is at most one
+    dictionary per family. A backend records the version of the set its
+    values were compressed with, and will not open with any other set.
+
+    @note This can be used concurrently once constructed.
+*/
+class NodeDictionary
+{
+public:
+    class Trainer;
+
+    /** The zstd compression level the dictionaries are prepared for. */
+    static int constexpr compressionLevel = 3;
+
+    /** Create a set from raw dictionaries, keyed by family. */
+    NodeDictionary(
+        std::uint32_t version,
+        std::map<std::uint32_t, Blob> dictionaries);
+
+    NodeDictionary(NodeDictionary const&) = delete;
+    NodeDictionary&
+    operator=(NodeDictionary const&) = delete;
+
+    std::uint32_t
+    version() const
+    {
+        return version_;
+    }
+
+    std::size_t
+    size() const
+    {
+        return entries_.size();
+    }
+
+    /** Return the family of a value in database format.
+
+        @see EncodedBlob
+    */
+    static std::uint32_t
+    family(void const* data, std::size_t size);
+
+    /** Return the dictionary for a family, or nullptr if there is none. */
+    ZSTD_CDict const*
+    compressor(std::uint32_t family) const;
+
+    ZSTD_DDict const*
+    decompressor(std::uint32_t family) const;
+
+    /** Write the set to a file. Throws on failure. */
+    void
+    save(boost::filesystem::path const& file) const;
+
+    /** Read a set written by save. Throws on failure. */
+    static std::shared_ptr<NodeDictionary const>
+    load(boost::filesystem::path const& file);
+
+private:
+    struct Entry
+    {
+        Blob data;
+        std::unique_ptr<ZSTD_CDict, decltype(&ZSTD_freeCDict)> cdict{
+            nullptr,
+            &ZSTD_freeCDict};
+        std::unique_ptr<ZSTD_DDict, decltype(&ZSTD_freeDDict)> ddict{
+            nullptr,
+            &ZSTD_freeDDict};
+    };
+
+    std::uint32_t const version_;
+    std::map<std::uint32_t, Entry> entries_;
+};
+
+/** Collects sample values and trains a dictionary for each family. */
+class NodeDictionary::Trainer
+{
+public:
+    /** @param dictionarySize The size of each trained dictionary. */
+    explicit Trainer(std::size_t dictionarySize = 64 * 1024);
+
+    /** Add a value in database format as a sample of its family.
+
+        Samples beyond what training a dictionary can use are ignored.
+    */
+    void
+    insert(void const* data, std::size_t size);
+
+    /** Train the dictionaries.
+
+        Families with too few samples to train on get no dictionary,
+        and their values stay LZ4 compressed.
+    */
+    std::shared_ptr<NodeDictionary const>
+    finish(std::uint32_t version, beast::Journal j);
+
+private:
+    struct Samples
+    {
+        Blob data;
+        std::vector<std::size_t> sizes;
+    };
+
+    std::size_t const dictionarySize_;
+    std::map<std::uint32_t, Samples> samples_;
+};
+
+}  // namespace NodeStore
+}  // namespace ripple
+
+#endif
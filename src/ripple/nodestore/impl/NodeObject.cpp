@@ -18,26 +18,139 @@
 //==============================================================================
 
 #include <ripple/nodestore/NodeObject.h>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <new>
 
 namespace ripple {
 
+// Allocates room for the blob after whatever allocate_shared asks for,
+// which holds the object along with its reference counts.
+template <class T>
+struct NodeObject::TrailingAllocator
+{
+    using value_type = T;
+
+    Trailer* trailer;
+
+    explicit TrailingAllocator(Trailer& t) : trailer(&t)
+    {
+    }
+
+    template <class U>
+    TrailingAllocator(TrailingAllocator<U> const& other)
+        : trailer(other.trailer)
+    {
+    }
+
+    T*
+    allocate(std::size_t n)
+    {
+        auto const p = static_cast<std::uint8_t*>(
+            ::operator new(n * sizeof(T) + trailer->bytes));
+        trailer->buffer = p + n * sizeof(T);
+        return reinterpret_cast<T*>(p);
+    }
+
+    void
+    deallocate(T* p, std::size_t) noexcept
+    {
+        ::operator delete(p);
+    }
+
+    template <class U>
+    bool
+    operator==(TrailingAllocator<U> const& other) const noexcept
+    {
+        return trailer == other.trailer;
+    }
+};
+
 //------------------------------------------------------------------------------
 
 NodeObject::NodeObject(
     NodeObjectType type,
-    Blob&& data,
     uint256 const& hash,
+    Trailer const& trailer,
+    PrivateAccess)
+    : mHash(hash)
+    , mType(type)
+    , mSize(static_cast<std::uint32_t>(trailer.bytes))
+    , mData(trailer.buffer)
+    , mBlob(nullptr)
+{
+    // The storage is allocated before the object is constructed
+    assert(trailer.buffer);
+    countBytes(mSize);
+}
+
+NodeObject::NodeObject(
+    NodeObjectType type,
+    uint256 const& hash,
+    Blob&& data,
+    Trailer const& trailer,
     PrivateAccess)
-    : mType(type), mHash(hash), mData(std::move(data))
+    : mHash(hash)
+    , mType(type)
+    , mSize(static_cast<std::uint32_t>(data.size()))
+    // Moving the Blob keeps its buffer, so this stays valid
+    , mData(data.data())
+    , mBlob(new (trailer.buffer) Blob(std::move(data)))
+{
+    assert(trailer.bytes == sizeof(Blob));
+    assert(
+        reinterpret_cast<std::uintptr_t>(trailer.buffer) % alignof(Blob) ==
+        0);
+    countBytes(mSize);
+}
+
+NodeObject::~NodeObject()
 {
+    countBytes(-static_cast<std::ptrdiff_t>(mSize));
+    if (mBlob)
+        std::destroy_at(mBlob);
+}
+
+std::shared_ptr<NodeObject>
+NodeObject::allocate(
+    NodeObjectType type,
+    std::size_t size,
+    uint256 const& hash,
+    std::uint8_t*& buffer)
+{
+    Trailer trailer{size};
+    auto object = std::allocate_shared<NodeObject>(
+        TrailingAllocator<NodeObject>(trailer),
+        type,
+        hash,
+        trailer,
+        PrivateAccess());
+    buffer = trailer.buffer;
+    return object;
 }
 
 std::shared_ptr<NodeObject>
 NodeObject::createObject(NodeObjectType type, Blob&& data, uint256 const& hash)
 {
-    return std::make_shared<NodeObject>(
-        type, std::move(data), hash, PrivateAccess());
+    Trailer trailer{sizeof(Blob)};
+    return std::allocate_shared<NodeObject>(
+        TrailingAllocator<NodeObject>(trailer),
+        type,
+        hash,
+        std::move(data),
+        trailer,
+        PrivateAccess());
+}
+
+std::shared_ptr<NodeObject>
+NodeObject::createObject(NodeObjectType type, Slice data, uint256 const& hash)
+{
+    return createObject(type, data.size(), hash, [&](std::uint8_t* buffer) {
+        if (!data.empty())
+            std::memcpy(buffer, data.data(), data.size());
+    });
 }
 
 NodeObjectType
@@ -52,10 +165,10 @@ NodeObject::getHash() const
     return mHash;
 }
 
-Blob const&
+Slice
 NodeObject::getData() const
 {
-    return mData;
+    return {mData, mSize};
 }
 
 }  // namespace ripple
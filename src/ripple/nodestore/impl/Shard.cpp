@@ -384,11 +384,21 @@ Shard::storeLedger(
         if (!srcLedger->stateMap().isValid())
             return fail("Invalid state map");
 
-        if (next && next->info().parentHash == srcLedger->info().hash)
+        // Every node of a ledger stored in the shard is in its backend, so
+        // the nodes the source shares with such a ledger can be skipped.
+        // Consecutive ledgers share nearly all of their nodes.
+        auto have = next;
+        if (!have)
         {
-            auto have = next->stateMap().snapShot(false);
+            std::lock_guard lock(recentMutex_);
+            have = recentStored_;
+        }
+
+        if (have && have->stateMap().getHash().isNonZero())
+        {
+            auto haveMap = have->stateMap().snapShot(false);
             srcLedger->stateMap().snapShot(false)->visitDifferences(
-                &(*have), visit);
+                &(*haveMap), visit);
         }
         else
             srcLedger->stateMap().snapShot(false)->visitNodes(visit);
@@ -410,6 +420,11 @@ Shard::storeLedger(
     if (!batch.empty() && !storeBatch())
         return fail("Failed to store");
 
+    {
+        std::lock_guard lock(recentMutex_);
+        recentStored_ = srcLedger;
+    }
+
     return result;
 }
 
@@ -496,8 +511,13 @@ Shard::setLedgerStored(std::shared_ptr<Ledger const> const& ledger)
     // Update progress
     progress_ = boost::icl::length(acquireInfo_->storedSeqs);
     if (progress_ == maxLedgers_)
+    {
         state_ = ShardState::complete;
 
+        std::lock_guard recentLock(recentMutex_);
+        recentStored_.reset();
+    }
+
     setFileStats(lock);
     JLOG(j_.trace()) << "shard " << index_ << " stored ledger sequence "
                      << ledgerSeq;
@@ -679,7 +699,7 @@ Shard::finalize(bool writeSQLite, std::optional<uint256> const& referenceHash)
             return fail("invalid ledger");
 
         ledger = std::make_shared<Ledger>(
-            deserializePrefixedHeader(makeSlice(nodeObject->getData())),
+            deserializePrefixedHeader(nodeObject->getData()),
             config,
             shardFamily);
         if (ledger->info().seq != ledgerSeq)
@@ -1203,13 +1223,19 @@ Shard::verifyFetch(uint256 const& hash) const
 
     try
     {
-        std::lock_guard lock(mutex_);
-        switch (backend_->fetch(hash.data(), &nodeObject))
+        Status status;
+        {
+            std::lock_guard lock(mutex_);
+            status = backend_->fetch(hash.data(), &nodeObject);
+        }
+
+        switch (status)
         {
             case ok:
-                // Verify that the hash of node object matches the payload
-                if (nodeObject->getHash() !=
-                    sha512Half(makeSlice(nodeObject->getData())))
+                // Verify that the hash of node object matches the payload.
+                // This is done without holding the lock so that other
+                // threads can keep fetching from the shard meanwhile.
+                if (nodeObject->getHash() != sha512Half(nodeObject->getData()))
                     return fail("Node object hash does not match payload");
                 return nodeObject;
             case notFound:
@@ -40,7 +40,7 @@
 namespace ripple {
 namespace NodeStore {
 
-using PCache = TaggedCache<uint256, NodeObject>;
+using PCache = TaggedCache<uint256, NodeObject, false, digest_hash>;
 using NCache = KeyCache;
 class DatabaseShard;
 
@@ -123,8 +123,12 @@ public:
 
     /** Store a ledger.
 
+        Only the state nodes that differ from a ledger already stored in the
+        shard are copied: either `next`, or else the ledger stored last.
+
         @param srcLedger The ledger to store.
-        @param next The ledger that immediately follows srcLedger, can be null.
+        @param next A ledger stored in this shard, typically the one that
+                    immediately follows srcLedger, can be null.
         @return StoreLedgerResult containing data about the store.
     */
     struct StoreLedgerResult
@@ -301,6 +305,10 @@ private:
     mutable std::mutex mutex_;
     mutable std::mutex storedMutex_;
 
+    // The ledger most recently copied into the shard while acquiring it
+    std::mutex recentMutex_;
+    std::shared_ptr<Ledger const> recentStored_;
+
     // Shard Index
     std::uint32_t const index_;
 
@@ -51,6 +51,12 @@ TaskQueue::size() const
     return tasks_.size() + processing_;
 }
 
+void
+TaskQueue::setThreads(int threads)
+{
+    workers_.setNumberOfThreads(threads);
+}
+
 void
 TaskQueue::processTask(int instance)
 {
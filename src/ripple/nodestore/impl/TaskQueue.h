@@ -48,6 +48,11 @@ public:
     [[nodiscard]] size_t
     size() const;
 
+    /** Set the number of tasks that may be processed at the same time
+     */
+    void
+    setThreads(int threads);
+
 private:
     mutable std::mutex mutex_;
     Workers workers_;
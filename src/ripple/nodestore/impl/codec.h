@@ -26,14 +26,19 @@
 #include <ripple/basics/contract.h>
 #include <ripple/basics/safe_cast.h>
 #include <ripple/nodestore/NodeObject.h>
+#include <ripple/nodestore/impl/DecodedBlob.h>
+#include <ripple/nodestore/impl/NodeDictionary.h>
 #include <ripple/nodestore/impl/varint.h>
 #include <ripple/protocol/HashPrefix.h>
 #include <cstddef>
 #include <cstring>
+#include <limits>
 #include <lz4.h>
+#include <memory>
 #include <nudb/detail/field.hpp>
 #include <string>
 #include <utility>
+#include <zstd.h>
 
 namespace ripple {
 namespace NodeStore {
@@ -92,6 +97,82 @@ lz4_compress(void const* in, std::size_t in_size, BufferFactory&& bf)
     return result;
 }
 
+/** Decompresses a value compressed with a dictionary of its family.
+
+    The input is the family as a varint, then a zstd frame.
+*/
+template <class BufferFactory>
+std::pair<void const*, std::size_t>
+zstd_dict_decompress(
+    NodeDictionary const* dictionary,
+    void const* in,
+    std::size_t in_size,
+    BufferFactory&& bf)
+{
+    std::size_t family = 0;
+    auto const n = read_varint(
+        reinterpret_cast<std::uint8_t const*>(in), in_size, family);
+
+    if (n == 0 || n >= in_size)
+        Throw<std::runtime_error>("zstd_dict_decompress: invalid blob");
+
+    auto const ddict = dictionary
+        ? dictionary->decompressor(static_cast<std::uint32_t>(family))
+        : nullptr;
+    if (!ddict)
+        Throw<std::runtime_error>(
+            "zstd_dict_decompress: no dictionary for family " +
+            std::to_string(family));
+
+    auto const frame = reinterpret_cast<char const*>(in) + n;
+    auto const outSize = ZSTD_getFrameContentSize(frame, in_size - n);
+    if (outSize == ZSTD_CONTENTSIZE_UNKNOWN ||
+        outSize == ZSTD_CONTENTSIZE_ERROR ||
+        outSize > std::numeric_limits<std::uint32_t>::max())
+        Throw<std::runtime_error>("zstd_dict_decompress: invalid frame");
+
+    static thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)>
+        ctx{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+    if (!ctx)
+        Throw<std::runtime_error>("zstd_dict_decompress: no context");
+
+    void* const out = bf(outSize);
+    auto const size = ZSTD_decompress_usingDDict(
+        ctx.get(), out, outSize, frame, in_size - n, ddict);
+    if (ZSTD_isError(size) || size != outSize)
+        Throw<std::runtime_error>("zstd_dict_decompress: failed");
+
+    return {out, size};
+}
+
+template <class BufferFactory>
+std::pair<void const*, std::size_t>
+zstd_dict_compress(
+    ZSTD_CDict const* cdict,
+    std::uint32_t family,
+    void const* in,
+    std::size_t in_size,
+    BufferFactory&& bf)
+{
+    using namespace nudb::detail;
+
+    static thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)>
+        ctx{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+    if (!ctx)
+        Throw<std::runtime_error>("zstd_dict_compress: no context");
+
+    std::array<std::uint8_t, varint_traits<std::size_t>::max> vi;
+    auto const n = write_varint(vi.data(), family);
+    auto const out_max = ZSTD_compressBound(in_size);
+    std::uint8_t* out = reinterpret_cast<std::uint8_t*>(bf(n + out_max));
+    std::memcpy(out, vi.data(), n);
+    auto const out_size = ZSTD_compress_usingCDict(
+        ctx.get(), out + n, out_max, in, in_size, cdict);
+    if (ZSTD_isError(out_size))
+        Throw<std::runtime_error>("zstd_dict_compress: failed");
+    return {out, n + out_size};
+}
+
 //------------------------------------------------------------------------------
 
 /*
@@ -101,11 +182,82 @@ lz4_compress(void const* in, std::size_t in_size, BufferFactory&& bf)
     1 = lz4 compressed
     2 = inner node compressed
     3 = full inner node
+    4 = zstd compressed with a dictionary of the value's family
 */
 
+/** Expands a v1 inner node, of object type 2 or 3, into the 516 bytes
+    of its serialized form: the prefix and sixteen child hashes.
+*/
+template <class = void>
+void
+inner_node_expand(
+    std::size_t type,
+    std::uint8_t const* p,
+    std::size_t in_size,
+    void* out)
+{
+    using namespace nudb::detail;
+
+    ostream os(out, 516);
+    if (type == 2)  // compressed v1 inner node
+    {
+        auto const hs = field<std::uint16_t>::size;  // Mask
+        if (in_size < hs + 32)
+            Throw<std::runtime_error>(
+                "nodeobject codec v1: short inner node size: " +
+                std::string("in_size = ") + std::to_string(in_size) +
+                " hs = " + std::to_string(hs));
+        istream is(p, in_size);
+        std::uint16_t mask;
+        read<std::uint16_t>(is, mask);  // Mask
+        in_size -= hs;
+        write<std::uint32_t>(
+            os, static_cast<std::uint32_t>(HashPrefix::innerNode));
+        if (mask == 0)
+            Throw<std::runtime_error>("nodeobject codec v1: empty inner node");
+        std::uint16_t bit = 0x8000;
+        for (int i = 16; i--; bit >>= 1)
+        {
+            if (mask & bit)
+            {
+                if (in_size < 32)
+                    Throw<std::runtime_error>(
+                        "nodeobject codec v1: short inner node subsize: " +
+                        std::string("in_size = ") + std::to_string(in_size) +
+                        " i = " + std::to_string(i));
+                std::memcpy(os.data(32), is(32), 32);
+                in_size -= 32;
+            }
+            else
+            {
+                std::memset(os.data(32), 0, 32);
+            }
+        }
+        if (in_size > 0)
+            Throw<std::runtime_error>(
+                "nodeobject codec v1: long inner node, in_size = " +
+                std::to_string(in_size));
+    }
+    else  // full v1 inner node
+    {
+        if (in_size != 16 * 32)  // hashes
+            Throw<std::runtime_error>(
+                "nodeobject codec v1: short full inner node, in_size = " +
+                std::to_string(in_size));
+        istream is(p, in_size);
+        write<std::uint32_t>(
+            os, static_cast<std::uint32_t>(HashPrefix::innerNode));
+        write(os, is(512), 512);
+    }
+}
+
 template <class BufferFactory>
 std::pair<void const*, std::size_t>
-nodeobject_decompress(void const* in, std::size_t in_size, BufferFactory&& bf)
+nodeobject_decompress(
+    void const* in,
+    std::size_t in_size,
+    BufferFactory&& bf,
+    NodeDictionary const* dictionary = nullptr)
 {
     using namespace nudb::detail;
 
@@ -132,17 +284,8 @@ nodeobject_decompress(void const* in, std::size_t in_size, BufferFactory&& bf)
             break;
         }
         case 2:  // compressed v1 inner node
+        case 3:  // full v1 inner node
         {
-            auto const hs = field<std::uint16_t>::size;  // Mask
-            if (in_size < hs + 32)
-                Throw<std::runtime_error>(
-                    "nodeobject codec v1: short inner node size: " +
-                    std::string("in_size = ") + std::to_string(in_size) +
-                    " hs = " + std::to_string(hs));
-            istream is(p, in_size);
-            std::uint16_t mask;
-            read<std::uint16_t>(is, mask);  // Mask
-            in_size -= hs;
             result.second = 525;
             void* const out = bf(result.second);
             result.first = out;
@@ -150,53 +293,12 @@ nodeobject_decompress(void const* in, std::size_t in_size, BufferFactory&& bf)
             write<std::uint32_t>(os, 0);
             write<std::uint32_t>(os, 0);
             write<std::uint8_t>(os, hotUNKNOWN);
-            write<std::uint32_t>(
-                os, static_cast<std::uint32_t>(HashPrefix::innerNode));
-            if (mask == 0)
-                Throw<std::runtime_error>(
-                    "nodeobject codec v1: empty inner node");
-            std::uint16_t bit = 0x8000;
-            for (int i = 16; i--; bit >>= 1)
-            {
-                if (mask & bit)
-                {
-                    if (in_size < 32)
-                        Throw<std::runtime_error>(
-                            "nodeobject codec v1: short inner node subsize: " +
-                            std::string("in_size = ") +
-                            std::to_string(in_size) +
-                            " i = " + std::to_string(i));
-                    std::memcpy(os.data(32), is(32), 32);
-                    in_size -= 32;
-                }
-                else
-                {
-                    std::memset(os.data(32), 0, 32);
-                }
-            }
-            if (in_size > 0)
-                Throw<std::runtime_error>(
-                    "nodeobject codec v1: long inner node, in_size = " +
-                    std::to_string(in_size));
+            inner_node_expand(type, p, in_size, os.data(516));
             break;
         }
-        case 3:  // full v1 inner node
+        case 4:  // zstd with a dictionary
         {
-            if (in_size != 16 * 32)  // hashes
-                Throw<std::runtime_error>(
-                    "nodeobject codec v1: short full inner node, in_size = " +
-                    std::to_string(in_size));
-            istream is(p, in_size);
-            result.second = 525;
-            void* const out = bf(result.second);
-            result.first = out;
-            ostream os(out, result.second);
-            write<std::uint32_t>(os, 0);
-            write<std::uint32_t>(os, 0);
-            write<std::uint8_t>(os, hotUNKNOWN);
-            write<std::uint32_t>(
-                os, static_cast<std::uint32_t>(HashPrefix::innerNode));
-            write(os, is(512), 512);
+            result = zstd_dict_decompress(dictionary, p, in_size, bf);
             break;
         }
         default:
@@ -206,6 +308,49 @@ nodeobject_decompress(void const* in, std::size_t in_size, BufferFactory&& bf)
     return result;
 }
 
+/** Decodes a value read from a backend into a NodeObject.
+
+    Inner nodes stored in the v1 codec formats are expanded straight into
+    the object's payload. Other values are decompressed, if need be, into
+    a buffer from the factory and then copied into the object. Values
+    compressed with a dictionary need the set they were compressed with.
+
+    @return The object, or nullptr if the value is not a valid NodeObject.
+*/
+template <class BufferFactory>
+std::shared_ptr<NodeObject>
+nodeobject_decode(
+    void const* key,
+    void const* in,
+    std::size_t in_size,
+    BufferFactory&& bf,
+    NodeDictionary const* dictionary = nullptr)
+{
+    std::uint8_t const* p = reinterpret_cast<std::uint8_t const*>(in);
+    std::size_t type;
+    auto const vn = read_varint(p, in_size, type);
+    if (vn == 0)
+        Throw<std::runtime_error>("nodeobject decompress");
+
+    if (type == 2 || type == 3)
+    {
+        // The kind byte of these is always hotUNKNOWN
+        return NodeObject::createObject(
+            hotUNKNOWN,
+            516,
+            uint256::fromVoid(key),
+            [&](std::uint8_t* out) {
+                inner_node_expand(type, p + vn, in_size - vn, out);
+            });
+    }
+
+    auto const result = nodeobject_decompress(in, in_size, bf, dictionary);
+    DecodedBlob decoded(key, result.first, result.second);
+    if (!decoded.wasOk())
+        return {};
+    return decoded.createObject();
+}
+
 template <class = void>
 void const*
 zero32()
@@ -214,9 +359,19 @@ zero32()
     return v.data();
 }
 
+/** Encodes a value in database format for a backend.
+
+    Inner nodes use the compact v1 formats. Other values are compressed
+    with the dictionary for their family if the set has one, and with
+    LZ4 otherwise.
+*/
 template <class BufferFactory>
 std::pair<void const*, std::size_t>
-nodeobject_compress(void const* in, std::size_t in_size, BufferFactory&& bf)
+nodeobject_compress(
+    void const* in,
+    std::size_t in_size,
+    BufferFactory&& bf,
+    NodeDictionary const* dictionary = nullptr)
 {
     using std::runtime_error;
     using namespace nudb::detail;
@@ -278,6 +433,26 @@ nodeobject_compress(void const* in, std::size_t in_size, BufferFactory&& bf)
         }
     }
 
+    if (dictionary)
+    {
+        auto const family = NodeDictionary::family(in, in_size);
+        if (auto const cdict = dictionary->compressor(family))
+        {
+            // 4 = zstd with a dictionary
+            auto const type = 4U;
+            auto const vs = size_varint(type);
+            std::uint8_t* p;
+            auto const zr = zstd_dict_compress(
+                cdict, family, in, in_size, [&p, &vs, &bf](std::size_t n) {
+                    p = reinterpret_cast<std::uint8_t*>(bf(vs + n));
+                    return p + vs;
+                });
+            ostream os(p, vs);
+            write<varint>(os, type);
+            return {p, vs + zr.second};
+        }
+    }
+
     std::array<std::uint8_t, varint_traits<std::size_t>::max> vi;
 
     constexpr std::size_t codecType = 1;
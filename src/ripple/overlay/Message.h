@@ -81,10 +81,13 @@ public:
      * the message is not compressible then the uncompressed buffer is returned.
      * @param compressed Request compressed (Compress::On) or
      *     uncompressed (Compress::Off) payload buffer
+     * @param algorithm The best algorithm the recipient accepts. ZSTD is
+     *     only used for bulk message types above compression::zstdMinBytes;
+     *     other messages fall back to LZ4.
      * @return Payload buffer
      */
     std::vector<uint8_t> const&
-    getBuffer(Compressed tryCompressed);
+    getBuffer(Compressed tryCompressed, Algorithm algorithm = Algorithm::LZ4);
 
     /** Get the traffic category */
     std::size_t
@@ -93,6 +96,13 @@ public:
         return category_;
     }
 
+    /** Get the protocol message type */
+    int
+    getType() const
+    {
+        return type_;
+    }
+
     /** Get the validator's key */
     std::optional<PublicKey> const&
     getValidatorKey() const
@@ -103,8 +113,11 @@ public:
 private:
     std::vector<uint8_t> buffer_;
     std::vector<uint8_t> bufferCompressed_;
+    std::vector<uint8_t> bufferZstd_;
     std::size_t category_;
+    int type_;
     std::once_flag once_flag_;
+    std::once_flag zstdOnceFlag_;
     std::optional<PublicKey> validatorKey_;
 
     /** Set the payload header
@@ -112,7 +125,7 @@ private:
      * @param payloadBytes Size of the payload excluding the header size
      * @param type Protocol message type
      * @param compression Compression algorithm used in compression,
-     *   currently LZ4 only. If None then the message is uncompressed.
+     *   LZ4 or ZSTD. If None then the message is uncompressed.
      * @param uncompressedBytes Size of the uncompressed message
      */
     void
@@ -124,11 +137,17 @@ private:
         std::uint32_t uncompressedBytes);
 
     /** Try to compress the payload.
-     * Can be called concurrently by multiple peers but is compressed once.
-     * If the message is not compressible then the serialized buffer_ is used.
+     * Can be called concurrently by multiple peers but is compressed once
+     * per algorithm. If the message is not compressible then the serialized
+     * buffer_ is used.
+     * @param algorithm Compression algorithm to use
      */
     void
-    compress();
+    compress(Algorithm algorithm);
+
+    /** Whether the message type and size benefit from ZSTD over LZ4. */
+    bool
+    preferZstd() const;
 
     /** Get the message type from the payload header.
      * First four bytes are the compression/algorithm flag and the payload size.
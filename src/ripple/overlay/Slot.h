@@ -21,6 +21,7 @@
 #define RIPPLE_OVERLAY_SLOT_H_INCLUDED
 
 #include <ripple/basics/Log.h>
+#include <ripple/basics/UnorderedContainers.h>
 #include <ripple/basics/chrono.h>
 #include <ripple/beast/container/aged_unordered_map.h>
 #include <ripple/beast/utility/Journal.h>
@@ -31,7 +32,9 @@
 #include <ripple/protocol/messages.h>
 
 #include <algorithm>
+#include <array>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <tuple>
@@ -527,6 +530,11 @@ Slot<clock_type>::getPeers() const
 /** Slots is a container for validator's Slot and handles Slot update
  * when a message is received from a validator. It also handles Slot aging
  * and checks for peers which are disconnected or stopped relaying the messages.
+ *
+ * Slots are partitioned into shards by validator. Each shard has its own
+ * lock and its own duplicate message filter, so messages from different
+ * validators are counted concurrently. A message key is always paired with
+ * the same validator, hence the per-shard filters see every copy of it.
  */
 template <typename clock_type>
 class Slots final
@@ -539,6 +547,19 @@ class Slots final
         clock_type,
         hardened_hash<strong_hash>>;
 
+    static constexpr std::size_t shardCount = 16;
+
+    struct Shard
+    {
+        std::mutex mutable mutex;
+        hash_map<PublicKey, Slot<clock_type>> slots;
+        // Maintain aged container of message/peers. This is required
+        // to discard duplicate message from the same peer. A message
+        // is aged after IDLED seconds. A message received IDLED seconds
+        // after it was relayed is ignored by PeerImp.
+        messages peersWithMessage{beast::get_abstract_clock<clock_type>()};
+    };
+
 public:
     /**
      * @param app Applicaton reference
@@ -550,6 +571,7 @@ public:
     }
     ~Slots() = default;
     /** Calls Slot::update of Slot associated with the validator.
+     * Safe to call concurrently; only the validator's shard is locked.
      * @param key Message's hash
      * @param validator Validator's public key
      * @param id Peer's id which received the message
@@ -572,8 +594,10 @@ public:
     std::optional<std::uint16_t>
     inState(PublicKey const& validator, PeerState state) const
     {
-        auto const& it = slots_.find(validator);
-        if (it != slots_.end())
+        auto const& shard = shardFor(validator);
+        std::lock_guard lock(shard.mutex);
+        auto const& it = shard.slots.find(validator);
+        if (it != shard.slots.end())
             return it->second.inState(state);
         return {};
     }
@@ -582,8 +606,10 @@ public:
     std::optional<std::uint16_t>
     notInState(PublicKey const& validator, PeerState state) const
     {
-        auto const& it = slots_.find(validator);
-        if (it != slots_.end())
+        auto const& shard = shardFor(validator);
+        std::lock_guard lock(shard.mutex);
+        auto const& it = shard.slots.find(validator);
+        if (it != shard.slots.end())
             return it->second.notInState(state);
         return {};
     }
@@ -592,8 +618,10 @@ public:
     bool
     inState(PublicKey const& validator, SlotState state) const
     {
-        auto const& it = slots_.find(validator);
-        if (it != slots_.end())
+        auto const& shard = shardFor(validator);
+        std::lock_guard lock(shard.mutex);
+        auto const& it = shard.slots.find(validator);
+        if (it != shard.slots.end())
             return it->second.state_ == state;
         return false;
     }
@@ -602,8 +630,10 @@ public:
     std::set<id_t>
     getSelected(PublicKey const& validator)
     {
-        auto const& it = slots_.find(validator);
-        if (it != slots_.end())
+        auto const& shard = shardFor(validator);
+        std::lock_guard lock(shard.mutex);
+        auto const& it = shard.slots.find(validator);
+        if (it != shard.slots.end())
             return it->second.getSelected();
         return {};
     }
@@ -616,8 +646,10 @@ public:
         std::tuple<PeerState, uint16_t, uint32_t, std::uint32_t>>
     getPeers(PublicKey const& validator)
     {
-        auto const& it = slots_.find(validator);
-        if (it != slots_.end())
+        auto const& shard = shardFor(validator);
+        std::lock_guard lock(shard.mutex);
+        auto const& it = shard.slots.find(validator);
+        if (it != shard.slots.end())
             return it->second.getPeers();
         return {};
     }
@@ -626,8 +658,10 @@ public:
     std::optional<SlotState>
     getState(PublicKey const& validator)
     {
-        auto const& it = slots_.find(validator);
-        if (it != slots_.end())
+        auto const& shard = shardFor(validator);
+        std::lock_guard lock(shard.mutex);
+        auto const& it = shard.slots.find(validator);
+        if (it != shard.slots.end())
             return it->second.getState();
         return {};
     }
@@ -642,38 +676,46 @@ public:
     deletePeer(id_t id, bool erase);
 
 private:
+    Shard&
+    shardFor(PublicKey const& validator)
+    {
+        return shards_[beast::uhash<>{}(validator) % shardCount];
+    }
+
+    Shard const&
+    shardFor(PublicKey const& validator) const
+    {
+        return shards_[beast::uhash<>{}(validator) % shardCount];
+    }
+
     /** Add message/peer if have not seen this message
      * from the peer. A message is aged after IDLED seconds.
+     * The shard's mutex must be held.
      * Return true if added */
     bool
-    addPeerMessage(uint256 const& key, id_t id);
+    addPeerMessage(Shard& shard, uint256 const& key, id_t id);
 
-    hash_map<PublicKey, Slot<clock_type>> slots_;
+    std::array<Shard, shardCount> shards_;
     SquelchHandler const& handler_;  // squelch/unsquelch handler
     Logs& logs_;
     beast::Journal const journal_;
-    // Maintain aged container of message/peers. This is required
-    // to discard duplicate message from the same peer. A message
-    // is aged after IDLED seconds. A message received IDLED seconds
-    // after it was relayed is ignored by PeerImp.
-    inline static messages peersWithMessage_{
-        beast::get_abstract_clock<clock_type>()};
 };
 
 template <typename clock_type>
 bool
-Slots<clock_type>::addPeerMessage(uint256 const& key, id_t id)
+Slots<clock_type>::addPeerMessage(Shard& shard, uint256 const& key, id_t id)
 {
-    beast::expire(peersWithMessage_, reduce_relay::IDLED);
+    auto& peersWithMessage = shard.peersWithMessage;
+    beast::expire(peersWithMessage, reduce_relay::IDLED);
 
     if (key.isNonZero())
     {
-        auto it = peersWithMessage_.find(key);
-        if (it == peersWithMessage_.end())
+        auto it = peersWithMessage.find(key);
+        if (it == peersWithMessage.end())
         {
             JLOG(journal_.trace())
                 << "addPeerMessage: new " << to_string(key) << " " << id;
-            peersWithMessage_.emplace(key, std::unordered_set<id_t>{id});
+            peersWithMessage.emplace(key, std::unordered_set<id_t>{id});
             return true;
         }
 
@@ -701,15 +743,18 @@ Slots<clock_type>::updateSlotAndSquelch(
     id_t id,
     protocol::MessageType type)
 {
-    if (!addPeerMessage(key, id))
+    auto& shard = shardFor(validator);
+    std::lock_guard lock(shard.mutex);
+
+    if (!addPeerMessage(shard, key, id))
         return;
 
-    auto it = slots_.find(validator);
-    if (it == slots_.end())
+    auto it = shard.slots.find(validator);
+    if (it == shard.slots.end())
     {
         JLOG(journal_.trace())
             << "updateSlotAndSquelch: new slot " << Slice(validator);
-        auto it = slots_
+        auto it = shard.slots
                       .emplace(std::make_pair(
                           validator,
                           Slot<clock_type>(handler_, logs_.journal("Slot"))))
@@ -724,8 +769,12 @@ template <typename clock_type>
 void
 Slots<clock_type>::deletePeer(id_t id, bool erase)
 {
-    for (auto& [validator, slot] : slots_)
-        slot.deletePeer(validator, id, erase);
+    for (auto& shard : shards_)
+    {
+        std::lock_guard lock(shard.mutex);
+        for (auto& [validator, slot] : shard.slots)
+            slot.deletePeer(validator, id, erase);
+    }
 }
 
 template <typename clock_type>
@@ -734,17 +783,22 @@ Slots<clock_type>::deleteIdlePeers()
 {
     auto now = clock_type::now();
 
-    for (auto it = slots_.begin(); it != slots_.end();)
+    for (auto& shard : shards_)
     {
-        it->second.deleteIdlePeer(it->first);
-        if (now - it->second.getLastSelected() > MAX_UNSQUELCH_EXPIRE_DEFAULT)
+        std::lock_guard lock(shard.mutex);
+        for (auto it = shard.slots.begin(); it != shard.slots.end();)
         {
-            JLOG(journal_.trace())
-                << "deleteIdlePeers: deleting idle slot " << Slice(it->first);
-            it = slots_.erase(it);
+            it->second.deleteIdlePeer(it->first);
+            if (now - it->second.getLastSelected() >
+                MAX_UNSQUELCH_EXPIRE_DEFAULT)
+            {
+                JLOG(journal_.trace()) << "deleteIdlePeers: deleting idle slot "
+                                       << Slice(it->first);
+                it = shard.slots.erase(it);
+            }
+            else
+                ++it;
         }
-        else
-            ++it;
     }
 }
 
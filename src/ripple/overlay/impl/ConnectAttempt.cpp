@@ -77,6 +77,7 @@ ConnectAttempt::stop()
 void
 ConnectAttempt::run()
 {
+    start_ = std::chrono::steady_clock::now();
     stream_.next_layer().async_connect(
         remote_endpoint_,
         strand_.wrap(std::bind(
@@ -206,7 +207,8 @@ ConnectAttempt::onHandshake(error_code ec)
         app_.config().COMPRESSION,
         app_.config().LEDGER_REPLAY,
         app_.config().TX_REDUCE_RELAY_ENABLE,
-        app_.config().VP_REDUCE_RELAY_ENABLE);
+        app_.config().VP_REDUCE_RELAY_ENABLE,
+        app_.config().TX_RELAY_BATCH);
 
     buildHandshake(
         req_,
@@ -373,6 +375,11 @@ ConnectAttempt::processResponse()
             JLOG(journal_.info()) << "Cluster name: " << *member;
         }
 
+        overlay_.peerFinder().onHandshakeLatency(
+            slot_,
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start_));
+
         auto const result = overlay_.peerFinder().activate(
             slot_, publicKey, static_cast<bool>(member));
         if (result != PeerFinder::Result::success)
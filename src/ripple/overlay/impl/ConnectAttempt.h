@@ -60,6 +60,8 @@ private:
     response_type response_;
     std::shared_ptr<PeerFinder::Slot> slot_;
     request_type req_;
+    // When the connection attempt started
+    std::chrono::steady_clock::time_point start_;
 
 public:
     ConnectAttempt(
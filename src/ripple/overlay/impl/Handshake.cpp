@@ -77,17 +77,21 @@ makeFeaturesRequestHeader(
     bool comprEnabled,
     bool ledgerReplayEnabled,
     bool txReduceRelayEnabled,
-    bool vpReduceRelayEnabled)
+    bool vpReduceRelayEnabled,
+    bool txBatchEnabled)
 {
     std::stringstream str;
     if (comprEnabled)
-        str << FEATURE_COMPR << "=lz4" << DELIM_FEATURE;
+        str << FEATURE_COMPR << "=lz4" << DELIM_VALUE << "zstd"
+            << DELIM_FEATURE;
     if (ledgerReplayEnabled)
         str << FEATURE_LEDGER_REPLAY << "=1" << DELIM_FEATURE;
     if (txReduceRelayEnabled)
         str << FEATURE_TXRR << "=1" << DELIM_FEATURE;
     if (vpReduceRelayEnabled)
         str << FEATURE_VPRR << "=1" << DELIM_FEATURE;
+    if (txBatchEnabled)
+        str << FEATURE_TX_BATCH << "=1" << DELIM_FEATURE;
     return str.str();
 }
 
@@ -97,17 +101,27 @@ makeFeaturesResponseHeader(
     bool comprEnabled,
     bool ledgerReplayEnabled,
     bool txReduceRelayEnabled,
-    bool vpReduceRelayEnabled)
+    bool vpReduceRelayEnabled,
+    bool txBatchEnabled)
 {
     std::stringstream str;
     if (comprEnabled && isFeatureValue(headers, FEATURE_COMPR, "lz4"))
-        str << FEATURE_COMPR << "=lz4" << DELIM_FEATURE;
+    {
+        // Older peers only know lz4; zstd is offered in addition to it and
+        // is only echoed back when the requester offered it too.
+        str << FEATURE_COMPR << "=lz4";
+        if (isFeatureValue(headers, FEATURE_COMPR, "zstd"))
+            str << DELIM_VALUE << "zstd";
+        str << DELIM_FEATURE;
+    }
     if (ledgerReplayEnabled && featureEnabled(headers, FEATURE_LEDGER_REPLAY))
         str << FEATURE_LEDGER_REPLAY << "=1" << DELIM_FEATURE;
     if (txReduceRelayEnabled && featureEnabled(headers, FEATURE_TXRR))
         str << FEATURE_TXRR << "=1" << DELIM_FEATURE;
     if (vpReduceRelayEnabled && featureEnabled(headers, FEATURE_VPRR))
         str << FEATURE_VPRR << "=1" << DELIM_FEATURE;
+    if (txBatchEnabled && featureEnabled(headers, FEATURE_TX_BATCH))
+        str << FEATURE_TX_BATCH << "=1" << DELIM_FEATURE;
     return str.str();
 }
 
@@ -369,7 +383,8 @@ makeRequest(
     bool comprEnabled,
     bool ledgerReplayEnabled,
     bool txReduceRelayEnabled,
-    bool vpReduceRelayEnabled) -> request_type
+    bool vpReduceRelayEnabled,
+    bool txBatchEnabled) -> request_type
 {
     request_type m;
     m.method(boost::beast::http::verb::get);
@@ -386,7 +401,8 @@ makeRequest(
             comprEnabled,
             ledgerReplayEnabled,
             txReduceRelayEnabled,
-            vpReduceRelayEnabled));
+            vpReduceRelayEnabled,
+            txBatchEnabled));
     return m;
 }
 
@@ -416,7 +432,8 @@ makeResponse(
             app.config().COMPRESSION,
             app.config().LEDGER_REPLAY,
             app.config().TX_REDUCE_RELAY_ENABLE,
-            app.config().VP_REDUCE_RELAY_ENABLE));
+            app.config().VP_REDUCE_RELAY_ENABLE,
+            app.config().TX_RELAY_BATCH));
 
     buildHandshake(resp, sharedValue, networkID, public_ip, remote_ip, app);
 
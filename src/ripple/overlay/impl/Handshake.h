@@ -100,6 +100,7 @@ verifyHandshake(
    enabled
    @param vpReduceRelayEnabled if true then validation/proposal reduce-relay
    feature is enabled
+   @param txBatchEnabled if true then transaction batching feature is enabled
    @return http request with empty body
  */
 request_type
@@ -108,7 +109,8 @@ makeRequest(
     bool comprEnabled,
     bool ledgerReplayEnabled,
     bool txReduceRelayEnabled,
-    bool vpReduceRelayEnabled);
+    bool vpReduceRelayEnabled,
+    bool txBatchEnabled);
 
 /** Make http response
 
@@ -146,6 +148,8 @@ static constexpr char FEATURE_VPRR[] = "vprr";
 static constexpr char FEATURE_TXRR[] = "txrr";
 // ledger replay
 static constexpr char FEATURE_LEDGER_REPLAY[] = "ledgerreplay";
+// relayed transactions batched into TMTransactions
+static constexpr char FEATURE_TX_BATCH[] = "txbatch";
 static constexpr char DELIM_FEATURE[] = ";";
 static constexpr char DELIM_VALUE[] = ",";
 
@@ -223,6 +227,7 @@ peerFeatureEnabled(
    enabled
    @param vpReduceRelayEnabled if true then validation/proposal reduce-relay
    feature is enabled
+   @param txBatchEnabled if true then transaction batching feature is enabled
    @return X-Protocol-Ctl header value
  */
 std::string
@@ -230,7 +235,8 @@ makeFeaturesRequestHeader(
     bool comprEnabled,
     bool ledgerReplayEnabled,
     bool txReduceRelayEnabled,
-    bool vpReduceRelayEnabled);
+    bool vpReduceRelayEnabled,
+    bool txBatchEnabled);
 
 /** Make response header X-Protocol-Ctl value with supported features.
     If the request has a feature that we support enabled
@@ -244,6 +250,7 @@ makeFeaturesRequestHeader(
    @param vpReduceRelayEnabled if true then validation/proposal reduce-relay
    feature is enabled
    @param vpReduceRelayEnabled if true then reduce-relay feature is enabled
+   @param txBatchEnabled if true then transaction batching feature is enabled
    @return X-Protocol-Ctl header value
  */
 std::string
@@ -252,7 +259,8 @@ makeFeaturesResponseHeader(
     bool comprEnabled,
     bool ledgerReplayEnabled,
     bool txReduceRelayEnabled,
-    bool vpReduceRelayEnabled);
+    bool vpReduceRelayEnabled,
+    bool txBatchEnabled);
 
 }  // namespace ripple
 
@@ -28,6 +28,7 @@ Message::Message(
     int type,
     std::optional<PublicKey> const& validator)
     : category_(TrafficCount::categorize(message, type, false))
+    , type_(type)
     , validatorKey_(validator)
 {
     using namespace ripple::compression;
@@ -64,10 +65,38 @@ Message::totalSize(::google::protobuf::Message const& message)
     return messageSize(message) + compression::headerBytes;
 }
 
+bool
+Message::preferZstd() const
+{
+    using namespace ripple::compression;
+
+    if (buffer_.size() - headerBytes < zstdMinBytes)
+        return false;
+
+    // Bulk messages carry many similar objects and gain the most from the
+    // stronger compressor; the rest stay on the cheaper LZ4.
+    switch (type_)
+    {
+        case protocol::mtMANIFESTS:
+        case protocol::mtLEDGER_DATA:
+        case protocol::mtGET_OBJECTS:
+        case protocol::mtVALIDATORLIST:
+        case protocol::mtVALIDATORLISTCOLLECTION:
+        case protocol::mtREPLAY_DELTA_RESPONSE:
+        case protocol::mtTRANSACTIONS:
+            return true;
+        default:
+            break;
+    }
+    return false;
+}
+
 void
-Message::compress()
+Message::compress(Algorithm algorithm)
 {
     using namespace ripple::compression;
+    auto& bufferCompressed =
+        algorithm == Algorithm::ZSTD ? bufferZstd_ : bufferCompressed_;
     auto const messageBytes = buffer_.size() - headerBytes;
 
     auto type = getType(buffer_.data());
@@ -115,23 +144,25 @@ Message::compress()
             payload,
             messageBytes,
             [&](std::size_t inSize) {  // size of required compressed buffer
-                bufferCompressed_.resize(inSize + headerBytesCompressed);
-                return (bufferCompressed_.data() + headerBytesCompressed);
-            });
-
-        if (compressedSize <
-            (messageBytes - (headerBytesCompressed - headerBytes)))
+                bufferCompressed.resize(inSize + headerBytesCompressed);
+                return (bufferCompressed.data() + headerBytesCompressed);
+            },
+            algorithm);
+
+        if (compressedSize != 0 &&
+            compressedSize <
+                (messageBytes - (headerBytesCompressed - headerBytes)))
         {
-            bufferCompressed_.resize(headerBytesCompressed + compressedSize);
+            bufferCompressed.resize(headerBytesCompressed + compressedSize);
             setHeader(
-                bufferCompressed_.data(),
+                bufferCompressed.data(),
                 compressedSize,
                 type,
-                Algorithm::LZ4,
+                algorithm,
                 messageBytes);
         }
         else
-            bufferCompressed_.resize(0);
+            bufferCompressed.resize(0);
     }
 }
 
@@ -207,12 +238,21 @@ Message::getBufferSize()
 }
 
 std::vector<uint8_t> const&
-Message::getBuffer(Compressed tryCompressed)
+Message::getBuffer(Compressed tryCompressed, Algorithm algorithm)
 {
     if (tryCompressed == Compressed::Off)
         return buffer_;
 
-    std::call_once(once_flag_, &Message::compress, this);
+    if (algorithm == Algorithm::ZSTD && preferZstd())
+    {
+        std::call_once(
+            zstdOnceFlag_, &Message::compress, this, Algorithm::ZSTD);
+
+        if (bufferZstd_.size() > 0)
+            return bufferZstd_;
+    }
+
+    std::call_once(once_flag_, &Message::compress, this, Algorithm::LZ4);
 
     if (bufferCompressed_.size() > 0)
         return bufferCompressed_;
@@ -28,6 +28,7 @@
 #include <ripple/basics/make_SSLContext.h>
 #include <ripple/basics/random.h>
 #include <ripple/beast/core/LexicalCast.h>
+#include <ripple/json/to_string.h>
 #include <ripple/nodestore/DatabaseShard.h>
 #include <ripple/overlay/Cluster.h>
 #include <ripple/overlay/impl/ConnectAttempt.h>
@@ -39,6 +40,7 @@
 #include <ripple/server/SimpleWriter.h>
 
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/beast/http/string_body.hpp>
 #include <boost/utility/in_place_factory.hpp>
 
 namespace ripple {
@@ -109,6 +111,9 @@ OverlayImpl::Timer::on_timer(error_code ec)
     if ((++overlay_.timer_count_ % Tuning::checkIdlePeers) == 0)
         overlay_.deleteIdlePeers();
 
+    overlay_.fatNodes_.sweep();
+    overlay_.ledgerReplies_.sweep();
+
     async_wait();
 }
 
@@ -141,6 +146,21 @@ OverlayImpl::OverlayImpl(
     , next_id_(1)
     , timer_count_(0)
     , slots_(app.logs(), *this)
+    , txRelayFanout_(
+          app_.config().TX_RELAY_PERCENTAGE,
+          app_.config().TX_TARGET_REDUNDANCY)
+    , fatNodes_(
+          "FatNodes",
+          Tuning::fatNodeCacheSize,
+          Tuning::ledgerReplyCacheAge,
+          stopwatch(),
+          app_.journal("TaggedCache"))
+    , ledgerReplies_(
+          "LedgerReplies",
+          Tuning::ledgerReplyCacheSize,
+          Tuning::ledgerReplyCacheAge,
+          stopwatch(),
+          app_.journal("TaggedCache"))
     , m_stats(
           std::bind(&OverlayImpl::collect_metrics, this),
           collector,
@@ -936,34 +956,52 @@ OverlayImpl::processCrawl(http_request_type const& req, Handoff& handoff)
         setup_.crawlOptions == CrawlOptions::Disabled)
         return false;
 
-    boost::beast::http::response<json_body> msg;
+    boost::beast::http::response<boost::beast::http::string_body> msg;
     msg.version(req.version());
     msg.result(boost::beast::http::status::ok);
     msg.insert("Server", BuildInfo::getFullVersionString());
     msg.insert("Content-Type", "application/json");
     msg.insert("Connection", "close");
-    msg.body()["version"] = Json::Value(2u);
+    msg.body() = *getCrawlBody();
+    msg.prepare_payload();
+    handoff.response = std::make_shared<SimpleWriter>(msg);
+    return true;
+}
+
+std::shared_ptr<std::string const>
+OverlayImpl::getCrawlBody()
+{
+    auto const now = clock_type::now();
+
+    // Crawlers may poll many times a second; serve the last response until
+    // it expires, so that only one request per interval walks the peers.
+    std::lock_guard lock(crawlMutex_);
+    if (crawlBody_ && now < crawlExpires_)
+        return crawlBody_;
+
+    Json::Value body(Json::objectValue);
+    body["version"] = Json::Value(2u);
 
     if (setup_.crawlOptions & CrawlOptions::Overlay)
     {
-        msg.body()["overlay"] = getOverlayInfo();
+        body["overlay"] = getOverlayInfo();
     }
     if (setup_.crawlOptions & CrawlOptions::ServerInfo)
     {
-        msg.body()["server"] = getServerInfo();
+        body["server"] = getServerInfo();
     }
     if (setup_.crawlOptions & CrawlOptions::ServerCounts)
     {
-        msg.body()["counts"] = getServerCounts();
+        body["counts"] = getServerCounts();
     }
     if (setup_.crawlOptions & CrawlOptions::Unl)
     {
-        msg.body()["unl"] = getUnlInfo();
+        body["unl"] = getUnlInfo();
     }
 
-    msg.prepare_payload();
-    handoff.response = std::make_shared<SimpleWriter>(msg);
-    return true;
+    crawlBody_ = std::make_shared<std::string const>(to_string(body));
+    crawlExpires_ = now + setup_.crawlCacheInterval;
+    return crawlBody_;
 }
 
 bool
@@ -1313,6 +1351,18 @@ OverlayImpl::relay(
     std::size_t disabled = 0;
     std::size_t enabledInSkip = 0;
 
+    // Peers which batch relayed transactions share one copy of it.
+    // Only OverlayImpl creates peers, so they are all PeerImp.
+    std::shared_ptr<protocol::TMTransaction const> tx;
+    auto const send = [&](std::shared_ptr<Peer> const& p) {
+        auto& peer = static_cast<PeerImp&>(*p);
+        if (!peer.txBatchEnabled())
+            return peer.send(sm);
+        if (!tx)
+            tx = std::make_shared<protocol::TMTransaction const>(m);
+        peer.batchTransaction(tx);
+    };
+
     // total peers excluding peers in toSkip
     auto peers = getActivePeers(toSkip, total, disabled, enabledInSkip);
     auto minRelay = app_.config().TX_REDUCE_RELAY_MIN_PEERS + disabled;
@@ -1320,7 +1370,7 @@ OverlayImpl::relay(
     if (!app_.config().TX_REDUCE_RELAY_ENABLE || total <= minRelay)
     {
         for (auto const& p : peers)
-            p->send(sm);
+            send(p);
         if (app_.config().TX_REDUCE_RELAY_ENABLE ||
             app_.config().TX_REDUCE_RELAY_METRICS)
             txMetrics_.addMetrics(total, toSkip.size(), 0);
@@ -1330,13 +1380,27 @@ OverlayImpl::relay(
     // We have more peers than the minimum (disabled + minimum enabled),
     // relay to all disabled and some randomly selected enabled that
     // do not have the transaction.
+    bool const adaptive = app_.config().TX_TARGET_REDUNDANCY != 0;
+    auto const percentage = adaptive
+        ? txRelayFanout_.percentage(TxRelayFanout::clock_type::now())
+        : app_.config().TX_RELAY_PERCENTAGE;
     auto enabledTarget = app_.config().TX_REDUCE_RELAY_MIN_PEERS +
-        (total - minRelay) * app_.config().TX_RELAY_PERCENTAGE / 100;
+        (total - minRelay) * percentage / 100;
 
     txMetrics_.addMetrics(enabledTarget, toSkip.size(), disabled);
 
     if (enabledTarget > enabledInSkip)
-        std::shuffle(peers.begin(), peers.end(), default_prng());
+    {
+        if (adaptive)
+            TxRelayFanout::shuffle(
+                peers,
+                [](std::shared_ptr<Peer> const& p) {
+                    return static_cast<PeerImp const&>(*p).txDuplicateRatio();
+                },
+                default_prng());
+        else
+            std::shuffle(peers.begin(), peers.end(), default_prng());
+    }
 
     JLOG(journal_.trace()) << "relaying tx, total peers " << peers.size()
                            << " selected " << enabledTarget << " skip "
@@ -1349,12 +1413,12 @@ OverlayImpl::relay(
         // always relay to a peer with the disabled feature
         if (!p->txReduceRelayEnabled())
         {
-            p->send(sm);
+            send(p);
         }
         else if (enabledAndRelayed < enabledTarget)
         {
             enabledAndRelayed++;
-            p->send(sm);
+            send(p);
         }
         else
         {
@@ -1363,6 +1427,14 @@ OverlayImpl::relay(
     }
 }
 
+Json::Value
+OverlayImpl::txMetrics() const
+{
+    auto ret = txMetrics_.json();
+    ret[jss::txr_fanout] = txRelayFanout_.json();
+    return ret;
+}
+
 //------------------------------------------------------------------------------
 
 void
@@ -1487,13 +1559,8 @@ OverlayImpl::updateSlotAndSquelch(
     std::set<Peer::id_t>&& peers,
     protocol::MessageType type)
 {
-    if (!strand_.running_in_this_thread())
-        return post(
-            strand_,
-            [this, key, validator, peers = std::move(peers), type]() mutable {
-                updateSlotAndSquelch(key, validator, std::move(peers), type);
-            });
-
+    // Slots locks only the validator's shard, so messages from
+    // different validators are counted in parallel on the caller's thread.
     for (auto id : peers)
         slots_.updateSlotAndSquelch(key, validator, id, type);
 }
@@ -1505,11 +1572,6 @@ OverlayImpl::updateSlotAndSquelch(
     Peer::id_t peer,
     protocol::MessageType type)
 {
-    if (!strand_.running_in_this_thread())
-        return post(strand_, [this, key, validator, peer, type]() {
-            updateSlotAndSquelch(key, validator, peer, type);
-        });
-
     slots_.updateSlotAndSquelch(key, validator, peer, type);
 }
 
@@ -1603,6 +1665,9 @@ setup_Overlay(BasicConfig const& config)
                 setup.crawlOptions |= CrawlOptions::Unl;
             }
         }
+
+        setup.crawlCacheInterval = std::chrono::milliseconds(
+            get<std::uint32_t>(section, "cache_ms", 1000));
     }
     {
         auto const& section = config.section("vl");
@@ -22,6 +22,7 @@
 
 #include <ripple/app/main/Application.h>
 #include <ripple/basics/Resolver.h>
+#include <ripple/basics/TaggedCache.h>
 #include <ripple/basics/UnorderedContainers.h>
 #include <ripple/basics/chrono.h>
 #include <ripple/core/Job.h>
@@ -31,9 +32,11 @@
 #include <ripple/overlay/impl/Handshake.h>
 #include <ripple/overlay/impl/TrafficCount.h>
 #include <ripple/overlay/impl/TxMetrics.h>
+#include <ripple/overlay/impl/TxRelayFanout.h>
 #include <ripple/peerfinder/PeerfinderManager.h>
 #include <ripple/resource/ResourceManager.h>
 #include <ripple/rpc/ServerHandler.h>
+#include <ripple/shamap/SHAMapNodeID.h>
 #include <ripple/server/Handoff.h>
 #include <boost/asio/basic_waitable_timer.hpp>
 #include <boost/asio/ip/tcp.hpp>
@@ -130,6 +133,20 @@ private:
     // Transaction reduce-relay metrics
     metrics::TxMetrics txMetrics_;
 
+    // Tunes the tx reduce-relay fan-out to the duplicates received
+    TxRelayFanout txRelayFanout_;
+
+    // Nodes and replies served to peers asking for ledger data. Near a
+    // ledger close many peers ask for the same nodes of the same maps.
+    TaggedCache<uint256, std::vector<std::pair<SHAMapNodeID, Blob>>>
+        fatNodes_;
+    TaggedCache<uint256, Message> ledgerReplies_;
+
+    // Serialized /crawl response and when it must be rebuilt
+    std::mutex crawlMutex_;
+    std::shared_ptr<std::string const> crawlBody_;
+    clock_type::time_point crawlExpires_;
+
     // A message with the list of manifests we send to peers
     std::shared_ptr<Message> manifestMessage_;
     // Used to track whether we need to update the cached list of manifests
@@ -436,9 +453,26 @@ public:
     deletePeer(Peer::id_t id);
 
     Json::Value
-    txMetrics() const override
+    txMetrics() const override;
+
+    TxRelayFanout&
+    txRelayFanout()
+    {
+        return txRelayFanout_;
+    }
+
+    /** getNodeFat results, keyed by map, node, depth and fatLeaves. */
+    TaggedCache<uint256, std::vector<std::pair<SHAMapNodeID, Blob>>>&
+    fatNodes()
+    {
+        return fatNodes_;
+    }
+
+    /** Serialized replies to TMGetLedger requests without a cookie. */
+    TaggedCache<uint256, Message>&
+    ledgerReplies()
     {
-        return txMetrics_.json();
+        return ledgerReplies_;
     }
 
     /** Add tx reduce-relay metrics. */
@@ -485,6 +519,12 @@ private:
     bool
     processCrawl(http_request_type const& req, Handoff& handoff);
 
+    /** Returns the serialized /crawl response body.
+        The body is rebuilt at most once per configured cache interval.
+    */
+    std::shared_ptr<std::string const>
+    getCrawlBody();
+
     /** Handles validator list requests.
         Using a /vl/<hex-encoded public key> URL, will retrieve the
         latest valdiator list (or UNL) that this node has for that
@@ -22,12 +22,14 @@
 #include <ripple/app/ledger/InboundTransactions.h>
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/ledger/TransactionMaster.h>
+#include <ripple/app/main/LoadManager.h>
 #include <ripple/app/misc/HashRouter.h>
 #include <ripple/app/misc/LoadFeeTrack.h>
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/app/misc/Transaction.h>
 #include <ripple/app/misc/ValidatorList.h>
 #include <ripple/app/tx/apply.h>
+#include <ripple/basics/Trace.h>
 #include <ripple/basics/UptimeClock.h>
 #include <ripple/basics/base64.h>
 #include <ripple/basics/random.h>
@@ -40,6 +42,7 @@
 #include <ripple/overlay/impl/Tuning.h>
 #include <ripple/overlay/predicates.h>
 #include <ripple/protocol/digest.h>
+#include <ripple/resource/MeasuredCost.h>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/predicate.hpp>
@@ -49,6 +52,7 @@
 #include <memory>
 #include <mutex>
 #include <numeric>
+#include <span>
 #include <sstream>
 
 using namespace std::chrono_literals;
@@ -85,6 +89,7 @@ PeerImp::PeerImp(
     , stream_(*stream_ptr_)
     , strand_(socket_.get_executor())
     , timer_(waitable_timer{socket_.get_executor()})
+    , txBatchTimer_(waitable_timer{socket_.get_executor()})
     , remote_address_(slot->remote_endpoint())
     , overlay_(overlay)
     , inbound_(true)
@@ -108,6 +113,14 @@ PeerImp::PeerImp(
               app_.config().COMPRESSION)
               ? Compressed::On
               : Compressed::Off)
+    , compressionAlgorithm_(
+          peerFeatureEnabled(
+              headers_,
+              FEATURE_COMPR,
+              "zstd",
+              app_.config().COMPRESSION)
+              ? Algorithm::ZSTD
+              : Algorithm::LZ4)
     , txReduceRelayEnabled_(peerFeatureEnabled(
           headers_,
           FEATURE_TXRR,
@@ -120,10 +133,16 @@ PeerImp::PeerImp(
           headers_,
           FEATURE_LEDGER_REPLAY,
           app_.config().LEDGER_REPLAY))
+    , txBatchEnabled_(peerFeatureEnabled(
+          headers_,
+          FEATURE_TX_BATCH,
+          app_.config().TX_RELAY_BATCH))
     , ledgerReplayMsgHandler_(app, app.getLedgerReplayer())
 {
     JLOG(journal_.info()) << "compression enabled "
                           << (compressionEnabled_ == Compressed::On)
+                          << " zstd "
+                          << (compressionAlgorithm_ == Algorithm::ZSTD)
                           << " vp reduce-relay enabled "
                           << vpReduceRelayEnabled_
                           << " tx reduce-relay enabled "
@@ -247,14 +266,15 @@ PeerImp::send(std::shared_ptr<Message> const& m)
     if (detaching_)
         return;
 
-    auto validator = m->getValidatorKey();
+    auto const& validator = m->getValidatorKey();
     if (validator && !squelch_.expireSquelch(*validator))
         return;
 
     overlay_.reportTraffic(
         safe_cast<TrafficCount::category>(m->getCategory()),
         false,
-        static_cast<int>(m->getBuffer(compressionEnabled_).size()));
+        static_cast<int>(
+            m->getBuffer(compressionEnabled_, compressionAlgorithm_).size()));
 
     auto sendq_size = send_queue_.size();
 
@@ -275,13 +295,32 @@ PeerImp::send(std::shared_ptr<Message> const& m)
 
     send_queue_.push(m);
 
-    if (sendq_size != 0)
+    if (send_queue_.writing())
         return;
 
+    writeSendQueue();
+}
+
+void
+PeerImp::writeSendQueue()
+{
+    assert(strand_.running_in_this_thread());
+    assert(!send_queue_.empty());
+    assert(!send_queue_.writing());
+
+    // Gather the next batch of queued messages into one write. The queue
+    // keeps the messages, and so their buffers, alive until it completes.
+    auto const& batch =
+        send_queue_.startWrite(compressionEnabled_, compressionAlgorithm_);
+    auto const n = batch.size();
+    for (std::size_t i = 0; i != n; ++i)
+        send_buffers_[i] = boost::asio::buffer(
+            batch[i]->getBuffer(compressionEnabled_, compressionAlgorithm_));
+
+    // Timeout on writes only
     boost::asio::async_write(
         stream_,
-        boost::asio::buffer(
-            send_queue_.front()->getBuffer(compressionEnabled_)),
+        std::span<boost::asio::const_buffer const>(send_buffers_.data(), n),
         bind_executor(
             strand_,
             std::bind(
@@ -339,6 +378,77 @@ PeerImp::removeTxQueue(uint256 const& hash)
     JLOG(p_journal_.trace()) << "removeTxQueue " << removed;
 }
 
+void
+PeerImp::batchTransaction(
+    std::shared_ptr<protocol::TMTransaction const> const& tx)
+{
+    if (!strand_.running_in_this_thread())
+        return post(
+            strand_,
+            std::bind(&PeerImp::batchTransaction, shared_from_this(), tx));
+    if (gracefulClose_ || detaching_)
+        return;
+
+    txBatch_.push_back(tx);
+    txBatchBytes_ += tx->rawtransaction().size();
+    if (txBatch_.size() >= Tuning::txBatchMaxCount ||
+        txBatchBytes_ >= Tuning::txBatchMaxBytes)
+        return sendTxBatch();
+
+    if (txBatch_.size() != 1)
+        return;
+
+    error_code ec;
+    txBatchTimer_.expires_from_now(Tuning::txBatchDelay, ec);
+    if (ec)
+    {
+        JLOG(journal_.error()) << "batchTransaction: " << ec.message();
+        return sendTxBatch();
+    }
+    txBatchTimer_.async_wait(bind_executor(
+        strand_, [self = shared_from_this()](error_code const& ec) {
+            if (ec != boost::asio::error::operation_aborted)
+                self->sendTxBatch();
+        }));
+}
+
+void
+PeerImp::flushTxBatch()
+{
+    if (!strand_.running_in_this_thread())
+        return post(
+            strand_, std::bind(&PeerImp::flushTxBatch, shared_from_this()));
+    sendTxBatch();
+}
+
+void
+PeerImp::sendTxBatch()
+{
+    if (txBatch_.empty())
+        return;
+
+    error_code ec;
+    txBatchTimer_.cancel(ec);
+
+    if (txBatch_.size() == 1)
+    {
+        send(std::make_shared<Message>(
+            *txBatch_.front(), protocol::mtTRANSACTION));
+    }
+    else
+    {
+        protocol::TMTransactions batch;
+        batch.set_relayed(true);
+        for (auto const& tx : txBatch_)
+            *batch.add_transactions() = *tx;
+        JLOG(p_journal_.trace()) << "sendTxBatch " << txBatch_.size();
+        send(std::make_shared<Message>(batch, protocol::mtTRANSACTIONS));
+    }
+
+    txBatch_.clear();
+    txBatchBytes_ = 0;
+}
+
 void
 PeerImp::charge(Resource::Charge const& fee)
 {
@@ -368,6 +478,13 @@ PeerImp::cluster() const
     return static_cast<bool>(app_.cluster().member(publicKey_));
 }
 
+bool
+PeerImp::isLoaded() const
+{
+    return app_.getFeeTrack().isLoadedLocal() ||
+        app_.getLoadManager().isOverloaded(LoadManager::peer);
+}
+
 std::string
 PeerImp::getVersion() const
 {
@@ -404,6 +521,12 @@ PeerImp::json()
 
     ret[jss::load] = usage_.balance();
 
+    if (auto const usage = usage_.usage(); usage.jobs != 0)
+    {
+        ret[jss::cpu_duration_us] = std::to_string(usage.cpu.count());
+        ret[jss::wall_duration_us] = std::to_string(usage.wall.count());
+    }
+
     if (auto const version = getVersion(); !version.empty())
         ret[jss::version] = version;
 
@@ -418,6 +541,8 @@ PeerImp::json()
     ret[jss::uptime] = static_cast<Json::UInt>(
         std::chrono::duration_cast<std::chrono::seconds>(uptime()).count());
 
+    ret[jss::send_queue] = send_queue_.json();
+
     std::uint32_t minSeq, maxSeq;
     ledgerRange(minSeq, maxSeq);
 
@@ -583,6 +708,7 @@ PeerImp::close()
         detaching_ = true;  // DEPRECATED
         error_code ec;
         timer_.cancel(ec);
+        txBatchTimer_.cancel(ec);
         socket_.close(ec);
         overlay_.incPeerDisconnect();
         if (inbound_)
@@ -642,7 +768,7 @@ PeerImp::gracefulClose()
     assert(socket_.is_open());
     assert(!gracefulClose_);
     gracefulClose_ = true;
-    if (send_queue_.size() > 0)
+    if (!send_queue_.empty())
         return;
     setTimer();
     stream_.async_shutdown(bind_executor(
@@ -964,23 +1090,10 @@ PeerImp::onWriteMessage(error_code ec, std::size_t bytes_transferred)
 
     metrics_.sent.add_message(bytes_transferred);
 
-    assert(!send_queue_.empty());
-    send_queue_.pop();
+    send_queue_.finishWrite();
+
     if (!send_queue_.empty())
-    {
-        // Timeout on writes only
-        return boost::asio::async_write(
-            stream_,
-            boost::asio::buffer(
-                send_queue_.front()->getBuffer(compressionEnabled_)),
-            bind_executor(
-                strand_,
-                std::bind(
-                    &PeerImp::onWriteMessage,
-                    shared_from_this(),
-                    std::placeholders::_1,
-                    std::placeholders::_2)));
-    }
+        return writeSendQueue();
 
     if (gracefulClose_)
     {
@@ -1048,6 +1161,45 @@ PeerImp::onMessageEnd(
     charge(fee_);
 }
 
+template <class T>
+void
+PeerImp::onMessageDeferred(
+    detail::MessageHeader const& header,
+    std::vector<std::uint8_t>&& message)
+{
+    std::weak_ptr<PeerImp> weak{shared_from_this()};
+    app_.getJobQueue().addJob(
+        jtPEER,
+        "parseMessage",
+        [weak, header, message = std::move(message)]() {
+            auto const peer = weak.lock();
+            if (!peer)
+                return;
+
+            auto const m = detail::parseMessageContent<T>(
+                header, boost::asio::buffer(message), true);
+
+            post(peer->strand_, [peer, header, m]() {
+                if (!peer->socket_.is_open() || peer->gracefulClose_)
+                    return;
+                if (!m)
+                    return peer->fail(
+                        "onReadMessage",
+                        make_error_code(boost::system::errc::bad_message));
+
+                using namespace ripple::compression;
+                peer->onMessageBegin(
+                    header.message_type,
+                    m,
+                    header.payload_wire_size,
+                    header.uncompressed_size,
+                    header.algorithm != Algorithm::None);
+                peer->onMessage(m);
+                peer->onMessageEnd(header.message_type, m);
+            });
+        });
+}
+
 void
 PeerImp::onMessage(std::shared_ptr<protocol::TMManifests> const& m)
 {
@@ -1515,6 +1667,7 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMEndpoints> const& m)
 void
 PeerImp::onMessage(std::shared_ptr<protocol::TMTransaction> const& m)
 {
+    trace::Span span("PeerImp::onMessage(TMTransaction)");
     handleTransaction(m, true);
 }
 
@@ -1545,7 +1698,22 @@ PeerImp::handleTransaction(
         int flags;
         constexpr std::chrono::seconds tx_interval = 10s;
 
-        if (!app_.getHashRouter().shouldProcess(txID, id_, flags, tx_interval))
+        bool const duplicate =
+            !app_.getHashRouter().shouldProcess(txID, id_, flags, tx_interval);
+
+        // Only transactions relayed unprompted measure relay redundancy,
+        // not those the server asked for.
+        if (eraseTxQueue && app_.config().TX_TARGET_REDUNDANCY != 0)
+        {
+            overlay_.txRelayFanout().received(duplicate);
+            txDuplicateRatio_.store(
+                TxRelayFanout::updateRatio(
+                    txDuplicateRatio_.load(std::memory_order_relaxed),
+                    duplicate),
+                std::memory_order_relaxed);
+        }
+
+        if (duplicate)
         {
             // we have seen this transaction recently
             if (flags & SF_BAD)
@@ -1710,7 +1878,10 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMGetLedger> const& m)
     std::weak_ptr<PeerImp> weak = shared_from_this();
     app_.getJobQueue().addJob(jtLEDGER_REQ, "recvGetLedger", [weak, m]() {
         if (auto peer = weak.lock())
+        {
+            Resource::MeasuredCost cost(peer->usage_);
             peer->processLedgerRequest(m);
+        }
     });
 }
 
@@ -1730,6 +1901,7 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMProofPathRequest> const& m)
         jtREPLAY_REQ, "recvProofPathRequest", [weak, m]() {
             if (auto peer = weak.lock())
             {
+                Resource::MeasuredCost cost(peer->usage_);
                 auto reply =
                     peer->ledgerReplayMsgHandler_.processProofPathRequest(m);
                 if (reply.has_error())
@@ -1779,6 +1951,7 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMReplayDeltaRequest> const& m)
         jtREPLAY_REQ, "recvReplayDeltaRequest", [weak, m]() {
             if (auto peer = weak.lock())
             {
+                Resource::MeasuredCost cost(peer->usage_);
                 auto reply =
                     peer->ledgerReplayMsgHandler_.processReplayDeltaRequest(m);
                 if (reply.has_error())
@@ -1792,6 +1965,11 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMReplayDeltaRequest> const& m)
                 {
                     peer->send(std::make_shared<Message>(
                         reply, protocol::mtREPLAY_DELTA_RESPONSE));
+                    peer->ledgerReplayMsgHandler_.processReplayDeltaAncestors(
+                        m, [&peer](protocol::TMReplayDeltaResponse const& r) {
+                            peer->send(std::make_shared<Message>(
+                                r, protocol::mtREPLAY_DELTA_RESPONSE));
+                        });
                 }
             }
         });
@@ -1936,31 +2114,23 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMProposeSet> const& m)
         return;
     }
 
-    // RH TODO: when isTrusted = false we should probably also cache a key
-    // suppression for 30 seconds to avoid doing a relatively expensive lookup
-    // every time a spam packet is received
-    PublicKey const publicKey{makeSlice(set.nodepubkey())};
-    auto const isTrusted = app_.validators().trusted(publicKey);
-
-    // If the operator has specified that untrusted proposals be dropped then
-    // this happens here I.e. before further wasting CPU verifying the signature
-    // of an untrusted key
-    if (!isTrusted && app_.config().RELAY_UNTRUSTED_PROPOSALS == -1)
-        return;
-
     uint256 const proposeHash{set.currenttxhash()};
     uint256 const prevLedger{set.previousledger()};
 
     NetClock::time_point const closeTime{NetClock::duration{set.closetime()}};
 
+    // The same proposal arrives from most of our peers, so look for it in
+    // the hash router before anything else is done with it.
     uint256 const suppression = proposalUniqueId(
         proposeHash,
         prevLedger,
         set.proposeseq(),
         closeTime,
-        publicKey.slice(),
+        makeSlice(set.nodepubkey()),
         sig);
 
+    PublicKey const publicKey{makeSlice(set.nodepubkey())};
+
     if (auto [added, relayed] =
             app_.getHashRouter().addSuppressionPeerWithStatus(suppression, id_);
         !added)
@@ -1975,6 +2145,14 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMProposeSet> const& m)
         return;
     }
 
+    auto const isTrusted = app_.validators().trusted(publicKey);
+
+    // If the operator has specified that untrusted proposals be dropped then
+    // this happens here I.e. before further wasting CPU verifying the signature
+    // of an untrusted key
+    if (!isTrusted && app_.config().RELAY_UNTRUSTED_PROPOSALS == -1)
+        return;
+
     if (!isTrusted)
     {
         if (tracking_.load() == Tracking::diverged)
@@ -1984,7 +2162,7 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMProposeSet> const& m)
             return;
         }
 
-        if (!cluster() && app_.getFeeTrack().isLoadedLocal())
+        if (!cluster() && isLoaded())
         {
             JLOG(p_journal_.debug()) << "Proposal: Dropping untrusted (load)";
             return;
@@ -2010,7 +2188,7 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMProposeSet> const& m)
     app_.getJobQueue().addJob(
         isTrusted ? jtPROPOSAL_t : jtPROPOSAL_ut,
         "recvPropose->checkPropose",
-        [weak, isTrusted, m, proposal]() {
+        [weak, isTrusted, m, proposal = std::move(proposal)]() {
             if (auto peer = weak.lock())
                 peer->checkPropose(isTrusted, m, proposal);
         });
@@ -2594,7 +2772,7 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMValidation> const& m)
             JLOG(p_journal_.debug())
                 << "Dropping untrusted validation from diverged peer";
         }
-        else if (isTrusted || !app_.getFeeTrack().isLoadedLocal())
+        else if (isTrusted || !isLoaded())
         {
             std::string const name = [isTrusted, val]() {
                 std::string ret =
@@ -2669,7 +2847,10 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMGetObjectByHash> const& m)
             app_.getJobQueue().addJob(
                 jtREQUESTED_TXN, "doTransactions", [weak, m]() {
                     if (auto peer = weak.lock())
+                    {
+                        Resource::MeasuredCost cost(peer->usage_);
                         peer->doTransactions(m);
+                    }
                 });
             return;
         }
@@ -2720,7 +2901,7 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMGetObjectByHash> const& m)
                     protocol::TMIndexedObject& newObj = *reply.add_objects();
                     newObj.set_hash(hash.begin(), hash.size());
                     newObj.set_data(
-                        &nodeObject->getData().front(),
+                        nodeObject->getData().data(),
                         nodeObject->getData().size());
 
                     if (obj.has_nodeid())
@@ -2866,10 +3047,14 @@ PeerImp::handleHaveTransactions(
 void
 PeerImp::onMessage(std::shared_ptr<protocol::TMTransactions> const& m)
 {
-    if (!txReduceRelayEnabled())
+    // A batch of relayed transactions, or the transactions requested by
+    // tx reduce-relay.
+    bool const relayed = m->relayed();
+    if (relayed ? !txBatchEnabled() : !txReduceRelayEnabled())
     {
         JLOG(p_journal_.error())
-            << "TMTransactions: tx reduce-relay is disabled";
+            << "TMTransactions: "
+            << (relayed ? "tx batching" : "tx reduce-relay") << " is disabled";
         fee_ = Resource::feeInvalidRequest;
         return;
     }
@@ -2877,13 +3062,14 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMTransactions> const& m)
     JLOG(p_journal_.trace())
         << "received TMTransactions " << m->transactions_size();
 
-    overlay_.addTxMetrics(m->transactions_size());
+    if (!relayed)
+        overlay_.addTxMetrics(m->transactions_size());
 
     for (std::uint32_t i = 0; i < m->transactions_size(); ++i)
         handleTransaction(
             std::shared_ptr<protocol::TMTransaction>(
                 m->mutable_transactions(i), [](protocol::TMTransaction*) {}),
-            false);
+            relayed);
 }
 
 void
@@ -2964,7 +3150,7 @@ PeerImp::doFetchPack(const std::shared_ptr<protocol::TMGetObjectByHash>& packet)
     // VFALCO TODO Invert this dependency using an observer and shared state
     // object. Don't queue fetch pack jobs if we're under load or we already
     // have some queued.
-    if (app_.getFeeTrack().isLoadedLocal() ||
+    if (isLoaded() ||
         (app_.getLedgerMaster().getValidatedLedgerAge() > 40s) ||
         (app_.getJobQueue().getJobCount(jtPACK) > 10))
     {
@@ -2987,7 +3173,10 @@ PeerImp::doFetchPack(const std::shared_ptr<protocol::TMGetObjectByHash>& packet)
     auto elapsed = UptimeClock::now();
     auto const pap = &app_;
     app_.getJobQueue().addJob(
-        jtPACK, "MakeFetchPack", [pap, weak, packet, hash, elapsed]() {
+        jtPACK,
+        "MakeFetchPack",
+        [pap, weak, packet, hash, elapsed, usage = usage_]() {
+            Resource::MeasuredCost cost(usage);
             pap->getLedgerMaster().makeFetchPack(weak, packet, hash, elapsed);
         });
 }
@@ -3053,6 +3242,9 @@ PeerImp::checkTransaction(
     bool checkSignature,
     std::shared_ptr<STTx const> const& stx)
 {
+    trace::Span span(
+        "PeerImp::checkTransaction", trace::idOf(stx->getTransactionID()));
+
     // VFALCO TODO Rewrite to not use exceptions
     try
     {
@@ -3484,7 +3676,7 @@ PeerImp::processLedgerRequest(std::shared_ptr<protocol::TMGetLedger> const& m)
                 << "processLedgerRequest: Large send queue";
             return;
         }
-        if (app_.getFeeTrack().isLoadedLocal() && !cluster())
+        if (isLoaded() && !cluster())
         {
             JLOG(p_journal_.debug()) << "processLedgerRequest: Too busy";
             return;
@@ -3534,13 +3726,42 @@ PeerImp::processLedgerRequest(std::shared_ptr<protocol::TMGetLedger> const& m)
         return;
     }
 
+    // Unless it must carry a cookie, a reply depends only on the map, the
+    // nodes asked for and the depth. Peers asking for the same nodes get
+    // the same serialized reply.
+    std::optional<uint256> replyKey;
+
     // Add requested node data to reply
     if (m->nodeids_size() > 0)
     {
         auto const queryDepth{
             m->has_querydepth() ? m->querydepth() : (isHighLatency() ? 2 : 1)};
-
-        std::vector<std::pair<SHAMapNodeID, Blob>> data;
+        auto const mapHash{map->getHash().as_uint256()};
+
+        if (!m->has_requestcookie())
+        {
+            sha512_half_hasher h;
+            using beast::hash_append;
+            hash_append(
+                h,
+                ledgerData.ledgerhash(),
+                ledgerData.ledgerseq(),
+                static_cast<int>(itype),
+                mapHash,
+                queryDepth,
+                fatLeaves);
+            for (auto const& nodeId : m->nodeids())
+                hash_append(h, nodeId);
+            replyKey = static_cast<sha512_half_hasher::result_type>(h);
+
+            if (auto const reply = overlay_.ledgerReplies().fetch(*replyKey))
+            {
+                JLOG(p_journal_.debug())
+                    << "processLedgerRequest: Sending cached reply";
+                send(reply);
+                return;
+            }
+        }
 
         for (int i = 0; i < m->nodeids_size() &&
              ledgerData.nodes_size() < Tuning::softMaxReplyNodes;
@@ -3548,18 +3769,38 @@ PeerImp::processLedgerRequest(std::shared_ptr<protocol::TMGetLedger> const& m)
         {
             auto const shaMapNodeId{deserializeSHAMapNodeID(m->nodeids(i))};
 
-            data.clear();
-            data.reserve(Tuning::softMaxReplyNodes);
-
             try
             {
-                if (map->getNodeFat(*shaMapNodeId, data, fatLeaves, queryDepth))
+                sha512_half_hasher h;
+                using beast::hash_append;
+                hash_append(h, mapHash, m->nodeids(i), queryDepth, fatLeaves);
+                auto const key =
+                    static_cast<sha512_half_hasher::result_type>(h);
+
+                // The map is identified by its hash, so the nodes found
+                // for it never change
+                auto data = overlay_.fatNodes().fetch(key);
+                if (!data)
+                {
+                    std::vector<std::pair<SHAMapNodeID, Blob>> nodes;
+                    if (map->getNodeFat(
+                            *shaMapNodeId, nodes, fatLeaves, queryDepth))
+                    {
+                        data = std::make_shared<
+                            std::vector<std::pair<SHAMapNodeID, Blob>>>(
+                            std::move(nodes));
+                        overlay_.fatNodes().canonicalize_replace_client(
+                            key, data);
+                    }
+                }
+
+                if (data)
                 {
                     JLOG(p_journal_.trace())
                         << "processLedgerRequest: getNodeFat got "
-                        << data.size() << " nodes";
+                        << data->size() << " nodes";
 
-                    for (auto const& d : data)
+                    for (auto const& d : *data)
                     {
                         protocol::TMLedgerNode* node{ledgerData.add_nodes()};
                         node->set_nodeid(d.first.getRawString());
@@ -3568,6 +3809,7 @@ PeerImp::processLedgerRequest(std::shared_ptr<protocol::TMGetLedger> const& m)
                 }
                 else
                 {
+                    replyKey.reset();
                     JLOG(p_journal_.warn())
                         << "processLedgerRequest: getNodeFat returns false";
                 }
@@ -3602,6 +3844,7 @@ PeerImp::processLedgerRequest(std::shared_ptr<protocol::TMGetLedger> const& m)
                 if (!m->has_ledgerhash())
                     info += ", no hash specified";
 
+                replyKey.reset();
                 JLOG(p_journal_.error())
                     << "processLedgerRequest: getNodeFat with nodeId "
                     << *shaMapNodeId << " and ledger info type " << info
@@ -3615,7 +3858,14 @@ PeerImp::processLedgerRequest(std::shared_ptr<protocol::TMGetLedger> const& m)
             << ledgerData.nodes_size() << " nodes";
     }
 
-    send(std::make_shared<Message>(ledgerData, protocol::mtLEDGER_DATA));
+    auto reply = std::make_shared<Message>(ledgerData, protocol::mtLEDGER_DATA);
+
+    // Replies missing nodes we failed to find are not kept, since we may
+    // have those nodes later
+    if (replyKey)
+        overlay_.ledgerReplies().canonicalize_replace_client(*replyKey, reply);
+
+    send(reply);
 }
 
 int
@@ -3637,11 +3887,21 @@ PeerImp::getScore(bool haveItem) const
     // Penalty for unknown latency; should be roughly spRandomMax
     static const int spNoLatency = 8000;
 
+    // Score for being a member of our cluster, which is run by the same
+    // operator and is usually close by, so it is asked first for ledgers
+    // and nodes both have; should be roughly spRandomMax
+    static const int spCluster = 10000;
+
     int score = rand_int(spRandomMax);
 
     if (haveItem)
+    {
         score += spHaveItem;
 
+        if (cluster())
+            score += spCluster;
+    }
+
     std::optional<std::chrono::milliseconds> latency;
     {
         std::lock_guard sl(recentLock_);
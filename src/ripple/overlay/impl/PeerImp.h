@@ -31,6 +31,8 @@
 #include <ripple/overlay/impl/OverlayImpl.h>
 #include <ripple/overlay/impl/ProtocolMessage.h>
 #include <ripple/overlay/impl/ProtocolVersion.h>
+#include <ripple/overlay/impl/SendQueue.h>
+#include <ripple/overlay/impl/Tuning.h>
 #include <ripple/peerfinder/PeerfinderManager.h>
 #include <ripple/protocol/Protocol.h>
 #include <ripple/protocol/STTx.h>
@@ -40,9 +42,10 @@
 #include <boost/circular_buffer.hpp>
 #include <boost/endian/conversion.hpp>
 #include <boost/thread/shared_mutex.hpp>
+#include <array>
 #include <cstdint>
+#include <deque>
 #include <optional>
-#include <queue>
 
 namespace ripple {
 
@@ -68,6 +71,7 @@ private:
     using waitable_timer =
         boost::asio::basic_waitable_timer<std::chrono::steady_clock>;
     using Compressed = compression::Compressed;
+    using Algorithm = compression::Algorithm;
 
     Application& app_;
     id_t const id_;
@@ -80,6 +84,7 @@ private:
     stream_type& stream_;
     boost::asio::strand<boost::asio::executor> strand_;
     waitable_timer timer_;
+    waitable_timer txBatchTimer_;
 
     // Updated at each stage of the connection process to reflect
     // the current conditions as closely as possible.
@@ -155,7 +160,10 @@ private:
     http_request_type request_;
     http_response_type response_;
     boost::beast::http::fields const& headers_;
-    std::queue<std::shared_ptr<Message>> send_queue_;
+    SendQueue send_queue_;
+    // The buffers of the messages being written, if any.
+    std::array<boost::asio::const_buffer, Tuning::sendBatchMessages>
+        send_buffers_;
     bool gracefulClose_ = false;
     int large_sendq_ = 0;
     std::unique_ptr<LoadEvent> load_event_;
@@ -168,6 +176,8 @@ private:
     std::mutex mutable shardInfoMutex_;
 
     Compressed compressionEnabled_ = Compressed::Off;
+    // The best algorithm the peer accepts when compression is enabled.
+    Algorithm compressionAlgorithm_ = Algorithm::LZ4;
 
     // Queue of transactions' hashes that have not been
     // relayed. The hashes are sent once a second to a peer
@@ -175,10 +185,18 @@ private:
     hash_set<uint256> txQueue_;
     // true if tx reduce-relay feature is enabled on the peer.
     bool txReduceRelayEnabled_ = false;
+    // How often transactions relayed by this peer were already known.
+    // Written only while handling the peer's messages.
+    std::atomic<std::uint32_t> txDuplicateRatio_{0};
     // true if validation/proposal reduce-relay feature is enabled
     // on the peer.
     bool vpReduceRelayEnabled_ = false;
     bool ledgerReplayEnabled_ = false;
+    // true if relayed transactions are batched into TMTransactions.
+    bool txBatchEnabled_ = false;
+    // Relayed transactions waiting to be sent as one TMTransactions.
+    std::vector<std::shared_ptr<protocol::TMTransaction const>> txBatch_;
+    std::size_t txBatchBytes_ = 0;
     LedgerReplayMsgHandler ledgerReplayMsgHandler_;
 
     friend class OverlayImpl;
@@ -431,6 +449,34 @@ public:
         return txReduceRelayEnabled_;
     }
 
+    bool
+    txBatchEnabled() const
+    {
+        return txBatchEnabled_;
+    }
+
+    /** Relay a transaction in a batch with others.
+
+        The batch is sent once it is full, or a few milliseconds after its
+        first transaction was added.
+    */
+    void
+    batchTransaction(std::shared_ptr<protocol::TMTransaction const> const& tx);
+
+    /** Send the batched transactions now, without waiting for the delay. */
+    void
+    flushTxBatch();
+
+    /** Returns the share of relayed transactions that were duplicates.
+
+        @see TxRelayFanout::updateRatio
+    */
+    std::uint32_t
+    txDuplicateRatio() const
+    {
+        return txDuplicateRatio_.load(std::memory_order_relaxed);
+    }
+
 private:
     void
     close();
@@ -447,6 +493,10 @@ private:
     void
     cancelTimer();
 
+    // Send the batched transactions
+    void
+    sendTxBatch();
+
     static std::string
     makePrefix(id_t id);
 
@@ -479,18 +529,22 @@ private:
     void
     onReadMessage(error_code ec, std::size_t bytes_transferred);
 
+    // Start writing the messages at the front of the send queue
+    void
+    writeSendQueue();
+
     // Called when protocol messages bytes are sent
     void
     onWriteMessage(error_code ec, std::size_t bytes_transferred);
 
     /** Called from onMessage(TMTransaction(s)).
        @param m Transaction protocol message
-       @param eraseTxQueue is true when called from onMessage(TMTransaction)
-       and is false when called from onMessage(TMTransactions). If true then
-       the transaction hash is erased from txQueue_. Don't need to erase from
-       the queue when called from onMessage(TMTransactions) because this
-       message is a response to the missing transactions request and the queue
-       would not have any of these transactions.
+       @param eraseTxQueue is true when the transaction was relayed by the
+       peer, in a TMTransaction or in a batch of them, and is false when it
+       was sent in a TMTransactions in response to the missing transactions
+       request. If true then the transaction hash is erased from txQueue_.
+       A response does not need to erase from the queue because the queue
+       would not have any of the transactions it requested.
      */
     void
     handleTransaction(
@@ -511,6 +565,11 @@ private:
     bool
     reduceRelayReady();
 
+    // Check if work from peers which may be refused should be: the local
+    // fee has been raised, or peer jobs are waiting too long to run
+    bool
+    isLoaded() const;
+
 public:
     //--------------------------------------------------------------------------
     //
@@ -534,6 +593,13 @@ public:
         std::uint16_t type,
         std::shared_ptr<::google::protobuf::Message> const& m);
 
+    /** Parses a large message in a job, then handles it on the strand. */
+    template <class T>
+    void
+    onMessageDeferred(
+        detail::MessageHeader const& header,
+        std::vector<std::uint8_t>&& message);
+
     void
     onMessage(std::shared_ptr<protocol::TMManifests> const& m);
     void
@@ -670,6 +736,7 @@ PeerImp::PeerImp(
     , stream_(*stream_ptr_)
     , strand_(socket_.get_executor())
     , timer_(waitable_timer{socket_.get_executor()})
+    , txBatchTimer_(waitable_timer{socket_.get_executor()})
     , remote_address_(slot->remote_endpoint())
     , overlay_(overlay)
     , inbound_(false)
@@ -693,6 +760,14 @@ PeerImp::PeerImp(
               app_.config().COMPRESSION)
               ? Compressed::On
               : Compressed::Off)
+    , compressionAlgorithm_(
+          peerFeatureEnabled(
+              headers_,
+              FEATURE_COMPR,
+              "zstd",
+              app_.config().COMPRESSION)
+              ? Algorithm::ZSTD
+              : Algorithm::LZ4)
     , txReduceRelayEnabled_(peerFeatureEnabled(
           headers_,
           FEATURE_TXRR,
@@ -705,12 +780,18 @@ PeerImp::PeerImp(
           headers_,
           FEATURE_LEDGER_REPLAY,
           app_.config().LEDGER_REPLAY))
+    , txBatchEnabled_(peerFeatureEnabled(
+          headers_,
+          FEATURE_TX_BATCH,
+          app_.config().TX_RELAY_BATCH))
     , ledgerReplayMsgHandler_(app, app.getLedgerReplayer())
 {
     read_buffer_.commit(boost::asio::buffer_copy(
         read_buffer_.prepare(boost::asio::buffer_size(buffers)), buffers));
     JLOG(journal_.info()) << "compression enabled "
                           << (compressionEnabled_ == Compressed::On)
+                          << " zstd "
+                          << (compressionAlgorithm_ == Algorithm::ZSTD)
                           << " vp reduce-relay enabled "
                           << vpReduceRelayEnabled_
                           << " tx reduce-relay enabled "
@@ -25,6 +25,7 @@
 #include <ripple/overlay/Message.h>
 #include <ripple/overlay/impl/ZeroCopyStream.h>
 #include <ripple/protocol/messages.h>
+#include <google/protobuf/arena.h>
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/buffers_iterator.hpp>
 #include <boost/system/error_code.hpp>
@@ -209,7 +210,8 @@ parseMessageHeader(
 
         hdr.algorithm = static_cast<compression::Algorithm>(*iter & 0xF0);
 
-        if (hdr.algorithm != compression::Algorithm::LZ4)
+        if (hdr.algorithm != compression::Algorithm::LZ4 &&
+            hdr.algorithm != compression::Algorithm::ZSTD)
         {
             ec = make_error_code(boost::system::errc::protocol_error);
             return std::nullopt;
@@ -263,15 +265,37 @@ parseMessageHeader(
     return std::nullopt;
 }
 
+/** Messages at least this large, of the types which may be handled out of
+    order, are parsed off the I/O thread.
+*/
+constexpr std::size_t deferredParseBytes = 64 * 1024;
+
 template <
     class T,
     class Buffers,
     class = std::enable_if_t<
         std::is_base_of<::google::protobuf::Message, T>::value>>
 std::shared_ptr<T>
-parseMessageContent(MessageHeader const& header, Buffers const& buffers)
+parseMessageContent(
+    MessageHeader const& header,
+    Buffers const& buffers,
+    bool useArena = false)
 {
-    auto const m = std::make_shared<T>();
+    std::shared_ptr<T> m;
+    if (useArena)
+    {
+        // Every part of the message comes from the arena, which is freed
+        // in one step with the last reference to the message.
+        ::google::protobuf::ArenaOptions options;
+        options.start_block_size = header.uncompressed_size;
+        auto arena = std::make_shared<::google::protobuf::Arena>(options);
+        auto const p = ::google::protobuf::Arena::CreateMessage<T>(arena.get());
+        m = std::shared_ptr<T>(std::move(arena), p);
+    }
+    else
+    {
+        m = std::make_shared<T>();
+    }
 
     ZeroCopyInputStream<Buffers> stream(buffers);
     stream.Skip(header.header_size);
@@ -291,7 +315,8 @@ parseMessageContent(MessageHeader const& header, Buffers const& buffers)
         if (payloadSize == 0 || !m->ParseFromArray(payload.data(), payloadSize))
             return {};
     }
-    else if (!m->ParseFromZeroCopyStream(&stream))
+    else if (!m->ParseFromBoundedZeroCopyStream(
+                 &stream, header.payload_wire_size))
         return {};
 
     return m;
@@ -323,6 +348,31 @@ invoke(MessageHeader const& header, Buffers const& buffers, Handler& handler)
     return true;
 }
 
+/** Hands a large message to the handler to be parsed off the I/O thread.
+
+    The handler may then handle it after messages which follow it.
+*/
+template <
+    class T,
+    class Buffers,
+    class Handler,
+    class = std::enable_if_t<
+        std::is_base_of<::google::protobuf::Message, T>::value>>
+bool
+invokeDeferred(
+    MessageHeader const& header,
+    Buffers const& buffers,
+    Handler& handler)
+{
+    if (header.uncompressed_size < deferredParseBytes)
+        return invoke<T>(header, buffers, handler);
+
+    std::vector<std::uint8_t> message(header.total_wire_size);
+    boost::asio::buffer_copy(boost::asio::buffer(message), buffers);
+    handler.template onMessageDeferred<T>(header, std::move(message));
+    return true;
+}
+
 }  // namespace detail
 
 /** Calls the handler for up to one protocol message in the passed buffers.
@@ -417,7 +467,7 @@ invokeProtocolMessage(
                 *header, buffers, handler);
             break;
         case protocol::mtLEDGER_DATA:
-            success = detail::invoke<protocol::TMLedgerData>(
+            success = detail::invokeDeferred<protocol::TMLedgerData>(
                 *header, buffers, handler);
             break;
         case protocol::mtPROPOSE_LEDGER:
@@ -461,7 +511,7 @@ invokeProtocolMessage(
                 *header, buffers, handler);
             break;
         case protocol::mtTRANSACTIONS:
-            success = detail::invoke<protocol::TMTransactions>(
+            success = detail::invokeDeferred<protocol::TMTransactions>(
                 *header, buffers, handler);
             break;
         case protocol::mtSQUELCH:
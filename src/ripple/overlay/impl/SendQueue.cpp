@@ -0,0 +1,154 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/overlay/impl/SendQueue.h>
+#include <ripple/overlay/impl/Tuning.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/protocol/messages.h>
+
+#include <cassert>
+
+namespace ripple {
+
+SendQueue::Class
+SendQueue::classify(int type)
+{
+    switch (type)
+    {
+        // Manifests are small and rare, and go with proposals so that
+        // a validator's new key arrives before anything signed with it.
+        case protocol::mtPROPOSE_LEDGER:
+        case protocol::mtSTATUS_CHANGE:
+        case protocol::mtHAVE_SET:
+        case protocol::mtPING:
+        case protocol::mtSQUELCH:
+        case protocol::mtMANIFESTS:
+            return Class::consensus;
+        case protocol::mtVALIDATION:
+            return Class::validations;
+        case protocol::mtTRANSACTION:
+        case protocol::mtTRANSACTIONS:
+            return Class::transactions;
+        case protocol::mtLEDGER_DATA:
+        case protocol::mtGET_OBJECTS:
+        case protocol::mtPROOF_PATH_RESPONSE:
+        case protocol::mtREPLAY_DELTA_RESPONSE:
+        case protocol::mtSHARD_INFO:
+        case protocol::mtPEER_SHARD_INFO:
+        case protocol::mtPEER_SHARD_INFO_V2:
+            return Class::ledgerData;
+        default:
+            return Class::inventory;
+    }
+}
+
+SendQueue::SendQueue() : credits_(weights)
+{
+    for (auto& d : depths_)
+        d.store(0, std::memory_order_relaxed);
+    inFlight_.reserve(Tuning::sendBatchMessages);
+}
+
+void
+SendQueue::push(std::shared_ptr<Message> const& m)
+{
+    auto const c = static_cast<std::size_t>(classify(m->getType()));
+    queues_[c].push_back(m);
+    depths_[c].fetch_add(1, std::memory_order_relaxed);
+    ++queued_;
+}
+
+std::size_t
+SendQueue::nextClass()
+{
+    for (int round = 0; round != 2; ++round)
+    {
+        for (std::size_t c = 0; c != classCount; ++c)
+        {
+            if (!queues_[c].empty() && credits_[c] != 0)
+            {
+                --credits_[c];
+                return c;
+            }
+        }
+
+        // Every class with messages has used its turns; start a round.
+        credits_ = weights;
+    }
+
+    // Unreachable: a new round gives every class a turn.
+    assert(false);
+    return 0;
+}
+
+std::vector<std::shared_ptr<Message>> const&
+SendQueue::startWrite(
+    compression::Compressed compressed,
+    compression::Algorithm algorithm)
+{
+    assert(!writing());
+    assert(queued_ != 0);
+
+    auto const c = nextClass();
+    auto& queue = queues_[c];
+    bool const capBytes = c == static_cast<std::size_t>(Class::ledgerData);
+    std::size_t bytes = 0;
+
+    while (!queue.empty() && inFlight_.size() != Tuning::sendBatchMessages)
+    {
+        if (capBytes)
+        {
+            auto const size =
+                queue.front()->getBuffer(compressed, algorithm).size();
+            if (!inFlight_.empty() &&
+                bytes + size > Tuning::sendBatchLedgerDataBytes)
+                break;
+            bytes += size;
+        }
+
+        inFlight_.push_back(std::move(queue.front()));
+        queue.pop_front();
+    }
+
+    depths_[c].fetch_sub(inFlight_.size(), std::memory_order_relaxed);
+    queued_ -= inFlight_.size();
+    return inFlight_;
+}
+
+void
+SendQueue::finishWrite()
+{
+    inFlight_.clear();
+}
+
+Json::Value
+SendQueue::json() const
+{
+    Json::Value ret(Json::objectValue);
+    ret[jss::consensus] = static_cast<Json::UInt>(depth(Class::consensus));
+    ret[jss::validations] =
+        static_cast<Json::UInt>(depth(Class::validations));
+    ret[jss::transactions] =
+        static_cast<Json::UInt>(depth(Class::transactions));
+    ret[jss::ledger_data] = static_cast<Json::UInt>(depth(Class::ledgerData));
+    ret[jss::inventory] = static_cast<Json::UInt>(depth(Class::inventory));
+    return ret;
+}
+
+}  // namespace ripple
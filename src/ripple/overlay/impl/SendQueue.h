@@ -0,0 +1,148 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_OVERLAY_SENDQUEUE_H_INCLUDED
+#define RIPPLE_OVERLAY_SENDQUEUE_H_INCLUDED
+
+#include <ripple/json/json_value.h>
+#include <ripple/overlay/Message.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace ripple {
+
+/** The messages waiting to be written to a peer.
+
+    Messages are queued by class, so that a backlog of one kind, such as
+    ledger data, does not hold up the proposals and validations that
+    consensus is waiting for. Each write takes messages of one class.
+    Classes with queued messages take turns by weighted round robin:
+    each class may start as many writes per round as its weight, and
+    within a round higher priority classes go first.
+
+    A write coalesces the consecutive queued messages of its class, up to
+    Tuning::sendBatchMessages of them. Ledger data is also limited to
+    Tuning::sendBatchLedgerDataBytes per write, so a single write of
+    ledger data cannot keep other classes waiting for long.
+
+    Only the peer's strand may use the queue, except for depth(), which
+    may be called from any thread.
+*/
+class SendQueue
+{
+public:
+    /** The message classes, in priority order. */
+    enum class Class : std::uint8_t {
+        consensus,
+        validations,
+        transactions,
+        ledgerData,
+        inventory
+    };
+
+    static constexpr std::size_t classCount = 5;
+
+    /** The writes each class may start in one round. */
+    static constexpr std::array<std::uint32_t, classCount> weights{
+        8, 6, 4, 2, 1};
+
+    /** Returns the class of a protocol message type. */
+    static Class
+    classify(int type);
+
+    SendQueue();
+
+    SendQueue(SendQueue const&) = delete;
+    SendQueue&
+    operator=(SendQueue const&) = delete;
+
+    /** Queue a message. */
+    void
+    push(std::shared_ptr<Message> const& m);
+
+    /** The number of messages queued or being written. */
+    std::size_t
+    size() const
+    {
+        return queued_ + inFlight_.size();
+    }
+
+    bool
+    empty() const
+    {
+        return size() == 0;
+    }
+
+    /** Returns `true` if a write is in progress. */
+    bool
+    writing() const
+    {
+        return !inFlight_.empty();
+    }
+
+    /** Choose the messages for the next write.
+
+        The messages stay referenced by the queue until finishWrite() is
+        called, which keeps their buffers alive during the write.
+
+        @param compressed Whether the peer is sent compressed messages,
+            which decides the size of ledger data.
+        @param algorithm The best compression algorithm the peer accepts.
+        @return The messages to write, in order.
+    */
+    std::vector<std::shared_ptr<Message>> const&
+    startWrite(
+        compression::Compressed compressed,
+        compression::Algorithm algorithm = compression::Algorithm::LZ4);
+
+    /** Release the messages of the write which completed. */
+    void
+    finishWrite();
+
+    /** Returns the number of messages of a class waiting to be written. */
+    std::size_t
+    depth(Class c) const
+    {
+        return depths_[static_cast<std::size_t>(c)].load(
+            std::memory_order_relaxed);
+    }
+
+    /** Returns the depth of each class, for the peers command. */
+    Json::Value
+    json() const;
+
+private:
+    std::size_t
+    nextClass();
+
+    std::array<std::deque<std::shared_ptr<Message>>, classCount> queues_;
+    std::array<std::atomic<std::size_t>, classCount> depths_;
+    std::array<std::uint32_t, classCount> credits_;
+    std::size_t queued_ = 0;
+    std::vector<std::shared_ptr<Message>> inFlight_;
+};
+
+}  // namespace ripple
+
+#endif
@@ -160,8 +160,12 @@ TrafficCount::categorize(
     if (type == protocol::mtHAVE_TRANSACTIONS)
         return TrafficCount::category::have_transactions;
 
-    if (type == protocol::mtTRANSACTIONS)
+    if (auto msg = dynamic_cast<protocol::TMTransactions const*>(&message))
+    {
+        if (msg->relayed())
+            return TrafficCount::category::transaction;
         return TrafficCount::category::requested_transactions;
+    }
 
     return TrafficCount::category::unknown;
 }
@@ -54,13 +54,38 @@ enum {
     /** How often to log send queue size */
     sendQueueLogFreq = 64,
 
+    /** How many queued messages may be handed to a single write */
+    sendBatchMessages = 32,
+
+    /** How many bytes of ledger data may be handed to a single write,
+        unless the first message alone is larger */
+    sendBatchLedgerDataBytes = 256 * 1024,
+
     /** How often we check for idle peers (seconds) */
     checkIdlePeers = 4,
 
     /** The maximum number of levels to search */
     maxQueryDepth = 3,
+
+    /** How many getNodeFat results are kept for reuse */
+    fatNodeCacheSize = 1024,
+
+    /** How many serialized ledger data replies are kept for reuse */
+    ledgerReplyCacheSize = 256,
+
+    /** How many relayed transactions a batch holds at most */
+    txBatchMaxCount = 64,
+
+    /** How many bytes of relayed transactions a batch holds at most */
+    txBatchMaxBytes = 64 * 1024,
 };
 
+/** How long relayed transactions wait to be batched with others. */
+std::chrono::milliseconds constexpr txBatchDelay{5};
+
+/** How long cached getNodeFat results and ledger data replies are kept. */
+std::chrono::seconds constexpr ledgerReplyCacheAge{15};
+
 /** Size of buffer used to read from the socket. */
 std::size_t constexpr readBufferBytes = 16384;
 
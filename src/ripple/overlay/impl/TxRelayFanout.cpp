@@ -0,0 +1,93 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/overlay/impl/TxRelayFanout.h>
+#include <ripple/protocol/jss.h>
+
+#include <string>
+
+namespace ripple {
+
+TxRelayFanout::TxRelayFanout(
+    std::size_t percentage,
+    std::size_t targetRedundancy)
+    : target_(targetRedundancy)
+    , percentage_(std::clamp(percentage, minPercentage, maxPercentage))
+    , nextUpdate_(clock_type::now() + interval)
+{
+}
+
+std::size_t
+TxRelayFanout::percentage(clock_type::time_point now)
+{
+    if (target_ == 0)
+        return percentage_.load(std::memory_order_relaxed);
+
+    // Whoever holds the lock is updating; everyone else uses the
+    // current value rather than waiting.
+    std::unique_lock lock(mutex_, std::try_to_lock);
+    if (!lock || now < nextUpdate_)
+        return percentage_.load(std::memory_order_relaxed);
+
+    nextUpdate_ = now + interval;
+
+    auto const fresh = new_.exchange(0, std::memory_order_relaxed);
+    auto const duplicates = duplicates_.exchange(0, std::memory_order_relaxed);
+    if (fresh < minSamples)
+    {
+        // Too few transactions to judge; keep counting.
+        new_.fetch_add(fresh, std::memory_order_relaxed);
+        duplicates_.fetch_add(duplicates, std::memory_order_relaxed);
+        return percentage_.load(std::memory_order_relaxed);
+    }
+
+    auto const redundancy = (fresh + duplicates) * 100 / fresh;
+    redundancy_.store(redundancy, std::memory_order_relaxed);
+
+    // Leave a band of 10% around the target so that the percentage
+    // settles instead of moving every interval.
+    auto const target = target_ * 100;
+    auto pct = percentage_.load(std::memory_order_relaxed);
+    if (redundancy * 10 > target * 11)
+        pct = std::max(pct, minPercentage + step) - step;
+    else if (redundancy * 10 < target * 9)
+        pct = std::min(pct + step, maxPercentage);
+    percentage_.store(pct, std::memory_order_relaxed);
+
+    return pct;
+}
+
+Json::Value
+TxRelayFanout::json() const
+{
+    Json::Value ret(Json::objectValue);
+
+    ret[jss::relay_percentage] =
+        std::to_string(percentage_.load(std::memory_order_relaxed));
+    ret[jss::target_redundancy] = std::to_string(target_);
+
+    auto const redundancy = redundancy_.load(std::memory_order_relaxed);
+    auto const hundredths = std::to_string(100 + redundancy % 100);
+    ret[jss::redundancy] =
+        std::to_string(redundancy / 100) + "." + hundredths.substr(1);
+
+    return ret;
+}
+
+}  // namespace ripple
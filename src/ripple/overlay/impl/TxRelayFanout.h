@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_OVERLAY_TXRELAYFANOUT_H_INCLUDED
+#define RIPPLE_OVERLAY_TXRELAYFANOUT_H_INCLUDED
+
+#include <ripple/json/json_value.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+
+/** Adapts how many tx reduce-relay peers each transaction is sent to.
+
+    Each transaction relayed to the server by a peer is counted as new or
+    as a duplicate of one already seen. Once per interval the number of
+    copies received for each new transaction is compared with a target.
+    The relay percentage then moves one step down if more copies arrived
+    than the target, or one step up if fewer did.
+
+    The copies a server receives depend on how widely its peers relay,
+    not on how widely it relays itself. The adjustment is useful when
+    peers follow the same policy: if every server trims its fan-out while
+    duplicates are high, together they approach the target.
+
+    Peers to relay to are also chosen using how many duplicates each one
+    sends. A peer that sends mostly transactions the server already has
+    is getting them from elsewhere, so it is picked less often.
+*/
+class TxRelayFanout
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    /** The bounds of the relay percentage, as allowed in the config. */
+    static constexpr std::size_t minPercentage = 10;
+    static constexpr std::size_t maxPercentage = 100;
+
+    /** How far the relay percentage moves in one interval. */
+    static constexpr std::size_t step = 2;
+
+    /** How often the relay percentage is reconsidered. */
+    static constexpr std::chrono::seconds interval{1};
+
+    /** New transactions needed in an interval before adjusting. */
+    static constexpr std::uint64_t minSamples = 50;
+
+    /** The value of a duplicate ratio of one. */
+    static constexpr std::uint32_t ratioScale = 1 << 16;
+
+    /** Create the tuner.
+
+        @param percentage The initial relay percentage.
+        @param targetRedundancy The copies of each transaction to aim to
+            receive. Zero leaves the percentage unchanged.
+    */
+    TxRelayFanout(std::size_t percentage, std::size_t targetRedundancy);
+
+    TxRelayFanout(TxRelayFanout const&) = delete;
+    TxRelayFanout&
+    operator=(TxRelayFanout const&) = delete;
+
+    /** Count a transaction relayed to the server by a peer. */
+    void
+    received(bool duplicate) noexcept
+    {
+        (duplicate ? duplicates_ : new_)
+            .fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /** Returns the relay percentage, first updating it if due. */
+    std::size_t
+    percentage(clock_type::time_point now);
+
+    /** Returns a peer's duplicate ratio updated with another transaction.
+
+        The ratio is an exponentially decaying average of the share of
+        duplicates, where ratioScale means that every transaction was a
+        duplicate.
+    */
+    static std::uint32_t
+    updateRatio(std::uint32_t ratio, bool duplicate) noexcept
+    {
+        std::int64_t const sample = duplicate ? ratioScale : 0;
+        return ratio + (sample - static_cast<std::int64_t>(ratio)) / 16;
+    }
+
+    /** Randomly order peers, favoring those with low duplicate ratios.
+
+        Each peer is weighted between 1, for a ratio of zero, and 0.1,
+        for a ratio of one. The order is a weighted random sample
+        without replacement (Efraimidis and Spirakis): each peer draws
+        log(u) / weight for a uniform u, and the largest draws go first.
+
+        @param peers The peers to order.
+        @param ratioOf A function returning a peer's duplicate ratio.
+        @param engine The random number generator.
+    */
+    template <class Peers, class RatioOf, class Engine>
+    static void
+    shuffle(Peers& peers, RatioOf&& ratioOf, Engine& engine)
+    {
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        std::vector<std::pair<double, typename Peers::value_type>> keyed;
+        keyed.reserve(peers.size());
+        for (auto& p : peers)
+        {
+            auto const ratio = std::min(ratioOf(p), ratioScale);
+            auto const weight = 1.0 - 0.9 * ratio / ratioScale;
+            keyed.emplace_back(
+                std::log(std::max(uniform(engine), 1e-300)) / weight,
+                std::move(p));
+        }
+        std::sort(
+            keyed.begin(), keyed.end(), [](auto const& a, auto const& b) {
+                return a.first > b.first;
+            });
+
+        peers.clear();
+        for (auto& k : keyed)
+            peers.push_back(std::move(k.second));
+    }
+
+    /** Returns the state of the tuner for tx_reduce_relay. */
+    Json::Value
+    json() const;
+
+private:
+    std::size_t const target_;
+    std::atomic<std::size_t> percentage_;
+
+    // Transactions received since the last adjustment
+    std::atomic<std::uint64_t> new_{0};
+    std::atomic<std::uint64_t> duplicates_{0};
+
+    // Copies received per new transaction in the last full interval,
+    // in hundredths
+    std::atomic<std::uint64_t> redundancy_{0};
+
+    std::mutex mutex_;
+    clock_type::time_point nextUpdate_;
+};
+
+}  // namespace ripple
+
+#endif
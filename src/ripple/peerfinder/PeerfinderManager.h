@@ -249,6 +249,17 @@ public:
         std::shared_ptr<Slot> const& slot,
         beast::IP::Endpoint const& local_endpoint) = 0;
 
+    /** Called when an outbound connection completes its handshake.
+        Records how long the attempt took so that faster addresses are
+        tried first on later connection attempts.
+        @param latency Time from starting the connection to receiving the
+                       peer's handshake response.
+    */
+    virtual void
+    onHandshakeLatency(
+        std::shared_ptr<Slot> const& slot,
+        std::chrono::milliseconds latency) = 0;
+
     /** Request an active slot type. */
     virtual Result
     activate(
@@ -88,10 +88,13 @@ void
 Bootcache::load()
 {
     clear();
-    auto const n(
-        m_store.load([this](beast::IP::Endpoint const& endpoint, int valence) {
-            auto const result(
-                this->m_map.insert(value_type(endpoint, valence)));
+    auto const n(m_store.load(
+        [this](
+            beast::IP::Endpoint const& endpoint,
+            int valence,
+            std::chrono::milliseconds latency) {
+            auto const result(this->m_map.insert(
+                value_type(endpoint, Entry(valence, latency))));
             if (!result.second)
             {
                 JLOG(this->m_journal.error())
@@ -195,6 +198,36 @@ Bootcache::on_failure(beast::IP::Endpoint const& endpoint)
     flagForUpdate();
 }
 
+void
+Bootcache::on_latency(
+    beast::IP::Endpoint const& endpoint,
+    std::chrono::milliseconds latency)
+{
+    // Zero means unmeasured, so round faster handshakes up
+    latency = std::max(latency, std::chrono::milliseconds(1));
+
+    auto result(m_map.insert(value_type(endpoint, Entry(0, latency))));
+    if (result.second)
+    {
+        prune();
+    }
+    else
+    {
+        Entry entry(result.first->right);
+        if (entry.latency() == std::chrono::milliseconds::zero())
+            entry.latency() = latency;
+        else
+            entry.latency() = (3 * entry.latency() + latency) / 4;
+        m_map.erase(result.first);
+        result = m_map.insert(value_type(endpoint, entry));
+        assert(result.second);
+    }
+    JLOG(m_journal.debug())
+        << beast::leftw(18) << "Bootcache latency " << endpoint << " "
+        << result.first->right.latency().count() << "ms";
+    flagForUpdate();
+}
+
 void
 Bootcache::periodicActivity()
 {
@@ -212,6 +245,9 @@ Bootcache::onWrite(beast::PropertyStream::Map& map)
         beast::PropertyStream::Map entry(entries);
         entry["endpoint"] = iter->get_left().to_string();
         entry["valence"] = std::int32_t(iter->get_right().valence());
+        if (auto const latency = iter->get_right().latency();
+            latency != std::chrono::milliseconds::zero())
+            entry["latency"] = std::int32_t(latency.count());
     }
 }
 
@@ -259,6 +295,7 @@ Bootcache::update()
         Store::Entry se;
         se.endpoint = e.get_left();
         se.valence = e.get_right().valence();
+        se.latency = e.get_right().latency();
         list.push_back(se);
     }
     m_store.save(list);
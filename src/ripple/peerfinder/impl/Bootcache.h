@@ -44,9 +44,14 @@ namespace PeerFinder {
         consecutive connection attempts when positive, and the number of
         failed consecutive connection attempts when negative.
 
+    Latency
+        The smoothed time taken by our outbound connection attempts to
+        complete the handshake, or zero if it was never measured.
+
     When choosing addresses from the boot cache for the purpose of
-    establishing outgoing connections, addresses are ranked in decreasing
-    order of high uptime, with valence as the tie breaker.
+    establishing outgoing connections, addresses whose last attempts
+    succeeded come first, ranked by increasing latency with unmeasured
+    ones last. The remaining addresses follow in decreasing valence.
 */
 class Bootcache
 {
@@ -54,7 +59,8 @@ private:
     class Entry
     {
     public:
-        Entry(int valence) : m_valence(valence)
+        Entry(int valence, std::chrono::milliseconds latency = {})
+            : m_valence(valence), m_latency(latency)
         {
         }
 
@@ -70,9 +76,35 @@ private:
             return m_valence;
         }
 
+        std::chrono::milliseconds&
+        latency()
+        {
+            return m_latency;
+        }
+
+        std::chrono::milliseconds
+        latency() const
+        {
+            return m_latency;
+        }
+
         friend bool
         operator<(Entry const& lhs, Entry const& rhs)
         {
+            bool const lhsGood = lhs.valence() > 0;
+            bool const rhsGood = rhs.valence() > 0;
+            if (lhsGood != rhsGood)
+                return lhsGood;
+
+            if (lhsGood && lhs.latency() != rhs.latency())
+            {
+                if (lhs.latency() == std::chrono::milliseconds::zero())
+                    return false;
+                if (rhs.latency() == std::chrono::milliseconds::zero())
+                    return true;
+                return lhs.latency() < rhs.latency();
+            }
+
             if (lhs.valence() > rhs.valence())
                 return true;
             return false;
@@ -80,6 +112,7 @@ private:
 
     private:
         int m_valence;
+        std::chrono::milliseconds m_latency;
     };
 
     using left_t = boost::bimaps::unordered_set_of<
@@ -139,7 +172,7 @@ public:
     map_type::size_type
     size() const;
 
-    /** IP::Endpoint iterators that traverse in decreasing valence. */
+    /** IP::Endpoint iterators that traverse in decreasing rank. */
     /** @{ */
     const_iterator
     begin() const;
@@ -173,6 +206,12 @@ public:
     void
     on_failure(beast::IP::Endpoint const& endpoint);
 
+    /** Called with the time an outbound connection took to handshake. */
+    void
+    on_latency(
+        beast::IP::Endpoint const& endpoint,
+        std::chrono::milliseconds latency);
+
     /** Stores the cache in the persistent database on a timer. */
     void
     periodicActivity();
@@ -961,6 +961,19 @@ public:
         bootcache_.on_failure(slot->remote_endpoint());
     }
 
+    void
+    onHandshakeLatency(
+        SlotImp::ptr const& slot,
+        std::chrono::milliseconds latency)
+    {
+        if (slot->inbound())
+            return;
+
+        std::lock_guard _(lock_);
+
+        bootcache_.on_latency(slot->remote_endpoint(), latency);
+    }
+
     // Insert a set of redirect IP addresses into the Bootcache
     template <class FwdIter>
     void
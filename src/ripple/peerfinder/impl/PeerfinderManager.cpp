@@ -177,6 +177,15 @@ public:
         return m_logic.onConnected(impl, local_endpoint);
     }
 
+    void
+    onHandshakeLatency(
+        std::shared_ptr<Slot> const& slot,
+        std::chrono::milliseconds latency) override
+    {
+        SlotImp::ptr impl(std::dynamic_pointer_cast<SlotImp>(slot));
+        m_logic.onHandshakeLatency(impl, latency);
+    }
+
     Result
     activate(
         std::shared_ptr<Slot> const& slot,
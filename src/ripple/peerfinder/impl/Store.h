@@ -20,6 +20,8 @@
 #ifndef RIPPLE_PEERFINDER_STORE_H_INCLUDED
 #define RIPPLE_PEERFINDER_STORE_H_INCLUDED
 
+#include <chrono>
+
 namespace ripple {
 namespace PeerFinder {
 
@@ -32,7 +34,8 @@ public:
     }
 
     // load the bootstrap cache
-    using load_callback = std::function<void(beast::IP::Endpoint, int)>;
+    using load_callback = std::function<
+        void(beast::IP::Endpoint, int, std::chrono::milliseconds)>;
     virtual std::size_t
     load(load_callback const& cb) = 0;
 
@@ -43,6 +46,8 @@ public:
 
         beast::IP::Endpoint endpoint;
         int valence;
+        // Smoothed handshake latency, zero if never measured
+        std::chrono::milliseconds latency{0};
     };
     virtual void
     save(std::vector<Entry> const& v) = 0;
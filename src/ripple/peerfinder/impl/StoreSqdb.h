@@ -39,7 +39,7 @@ private:
 public:
     enum {
         // This determines the on-database format of the data
-        currentSchemaVersion = 4
+        currentSchemaVersion = 5
     };
 
     explicit StoreSqdb(
@@ -66,21 +66,24 @@ public:
     {
         std::size_t n(0);
 
-        readPeerFinderDB(m_sqlDb, [&](std::string const& s, int valence) {
-            beast::IP::Endpoint const endpoint(
-                beast::IP::Endpoint::from_string(s));
-
-            if (!is_unspecified(endpoint))
-            {
-                cb(endpoint, valence);
-                ++n;
-            }
-            else
-            {
-                JLOG(m_journal.error())
-                    << "Bad address string '" << s << "' in Bootcache table";
-            }
-        });
+        readPeerFinderDB(
+            m_sqlDb, [&](std::string const& s, int valence, int latency) {
+                beast::IP::Endpoint const endpoint(
+                    beast::IP::Endpoint::from_string(s));
+
+                if (!is_unspecified(endpoint))
+                {
+                    cb(endpoint,
+                       valence,
+                       std::chrono::milliseconds(std::max(latency, 0)));
+                    ++n;
+                }
+                else
+                {
+                    JLOG(m_journal.error()) << "Bad address string '" << s
+                                            << "' in Bootcache table";
+                }
+            });
 
         return n;
     }
@@ -20,12 +20,14 @@
 #include <ripple/perflog/impl/PerfLogImp.h>
 
 #include <ripple/basics/BasicConfig.h>
+#include <ripple/basics/CountedObject.h>
 #include <ripple/beast/core/CurrentThreadName.h>
 #include <ripple/beast/utility/Journal.h>
 #include <ripple/core/JobTypes.h>
 #include <ripple/json/json_writer.h>
 #include <ripple/json/to_string.h>
 #include <ripple/nodestore/DatabaseShard.h>
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <cstdlib>
@@ -51,7 +53,7 @@ PerfLogImp::Counters::Counters(
         rpc_.reserve(labels.size());
         for (std::string const label : labels)
         {
-            auto const inserted = rpc_.emplace(label, Rpc()).second;
+            auto const inserted = rpc_.try_emplace(label).second;
             if (!inserted)
             {
                 // Ensure that no other function populates this entry.
@@ -64,7 +66,7 @@ PerfLogImp::Counters::Counters(
         jq_.reserve(jobTypes.size());
         for (auto const& [jobType, _] : jobTypes)
         {
-            auto const inserted = jq_.emplace(jobType, Jq()).second;
+            auto const inserted = jq_.try_emplace(jobType).second;
             if (!inserted)
             {
                 // Ensure that no other function populates this entry.
@@ -78,86 +80,83 @@ Json::Value
 PerfLogImp::Counters::countersJson() const
 {
     Json::Value rpcobj(Json::objectValue);
-    // totalRpc represents all rpc methods. All that started, finished, etc.
-    Rpc totalRpc;
-    for (auto const& proc : rpc_)
+    // Totals for all rpc methods. All that started, finished, etc.
+    std::uint64_t totalStarted = 0;
+    std::uint64_t totalFinished = 0;
+    std::uint64_t totalErrored = 0;
+    std::uint64_t totalDuration = 0;
+    for (auto const& [name, counter] : rpc_)
     {
-        Rpc value;
-        {
-            std::lock_guard lock(proc.second.mutex);
-            if (!proc.second.value.started && !proc.second.value.finished &&
-                !proc.second.value.errored)
-            {
-                continue;
-            }
-            value = proc.second.value;
-        }
+        auto const started = counter.started.load();
+        auto const finished = counter.finished.load();
+        auto const errored = counter.errored.load();
+        if (!started && !finished && !errored)
+            continue;
+        auto const duration = counter.duration.load();
 
         Json::Value p(Json::objectValue);
-        p[jss::started] = std::to_string(value.started);
-        totalRpc.started += value.started;
-        p[jss::finished] = std::to_string(value.finished);
-        totalRpc.finished += value.finished;
-        p[jss::errored] = std::to_string(value.errored);
-        totalRpc.errored += value.errored;
-        p[jss::duration_us] = std::to_string(value.duration.count());
-        totalRpc.duration += value.duration;
-        rpcobj[proc.first] = p;
+        p[jss::started] = std::to_string(started);
+        totalStarted += started;
+        p[jss::finished] = std::to_string(finished);
+        totalFinished += finished;
+        p[jss::errored] = std::to_string(errored);
+        totalErrored += errored;
+        p[jss::duration_us] = std::to_string(duration);
+        totalDuration += duration;
+        rpcobj[name] = p;
     }
 
-    if (totalRpc.started)
+    if (totalStarted)
     {
         Json::Value totalRpcJson(Json::objectValue);
-        totalRpcJson[jss::started] = std::to_string(totalRpc.started);
-        totalRpcJson[jss::finished] = std::to_string(totalRpc.finished);
-        totalRpcJson[jss::errored] = std::to_string(totalRpc.errored);
-        totalRpcJson[jss::duration_us] =
-            std::to_string(totalRpc.duration.count());
+        totalRpcJson[jss::started] = std::to_string(totalStarted);
+        totalRpcJson[jss::finished] = std::to_string(totalFinished);
+        totalRpcJson[jss::errored] = std::to_string(totalErrored);
+        totalRpcJson[jss::duration_us] = std::to_string(totalDuration);
         rpcobj[jss::total] = totalRpcJson;
     }
 
     Json::Value jqobj(Json::objectValue);
-    // totalJq represents all jobs. All enqueued, started, finished, etc.
-    Jq totalJq;
-    for (auto const& proc : jq_)
+    // Totals for all jobs. All enqueued, started, finished, etc.
+    std::uint64_t totalQueued = 0;
+    std::uint64_t totalJobsStarted = 0;
+    std::uint64_t totalJobsFinished = 0;
+    std::uint64_t totalQueuedDuration = 0;
+    std::uint64_t totalRunningDuration = 0;
+    for (auto const& [type, counter] : jq_)
     {
-        Jq value;
-        {
-            std::lock_guard lock(proc.second.mutex);
-            if (!proc.second.value.queued && !proc.second.value.started &&
-                !proc.second.value.finished)
-            {
-                continue;
-            }
-            value = proc.second.value;
-        }
+        auto const queued = counter.queued.load();
+        auto const started = counter.started.load();
+        auto const finished = counter.finished.load();
+        if (!queued && !started && !finished)
+            continue;
+        auto const queuedDuration = counter.queuedDuration.load();
+        auto const runningDuration = counter.runningDuration.load();
 
         Json::Value j(Json::objectValue);
-        j[jss::queued] = std::to_string(value.queued);
-        totalJq.queued += value.queued;
-        j[jss::started] = std::to_string(value.started);
-        totalJq.started += value.started;
-        j[jss::finished] = std::to_string(value.finished);
-        totalJq.finished += value.finished;
-        j[jss::queued_duration_us] =
-            std::to_string(value.queuedDuration.count());
-        totalJq.queuedDuration += value.queuedDuration;
-        j[jss::running_duration_us] =
-            std::to_string(value.runningDuration.count());
-        totalJq.runningDuration += value.runningDuration;
-        jqobj[JobTypes::name(proc.first)] = j;
+        j[jss::queued] = std::to_string(queued);
+        totalQueued += queued;
+        j[jss::started] = std::to_string(started);
+        totalJobsStarted += started;
+        j[jss::finished] = std::to_string(finished);
+        totalJobsFinished += finished;
+        j[jss::queued_duration_us] = std::to_string(queuedDuration);
+        totalQueuedDuration += queuedDuration;
+        j[jss::running_duration_us] = std::to_string(runningDuration);
+        totalRunningDuration += runningDuration;
+        jqobj[JobTypes::name(type)] = j;
     }
 
-    if (totalJq.queued)
+    if (totalQueued)
     {
         Json::Value totalJqJson(Json::objectValue);
-        totalJqJson[jss::queued] = std::to_string(totalJq.queued);
-        totalJqJson[jss::started] = std::to_string(totalJq.started);
-        totalJqJson[jss::finished] = std::to_string(totalJq.finished);
+        totalJqJson[jss::queued] = std::to_string(totalQueued);
+        totalJqJson[jss::started] = std::to_string(totalJobsStarted);
+        totalJqJson[jss::finished] = std::to_string(totalJobsFinished);
         totalJqJson[jss::queued_duration_us] =
-            std::to_string(totalJq.queuedDuration.count());
+            std::to_string(totalQueuedDuration);
         totalJqJson[jss::running_duration_us] =
-            std::to_string(totalJq.runningDuration.count());
+            std::to_string(totalRunningDuration);
         jqobj[jss::total] = totalJqJson;
     }
 
@@ -166,9 +165,80 @@ PerfLogImp::Counters::countersJson() const
     // even if empty.
     counters[jss::rpc] = rpcobj;
     counters[jss::job_queue] = jqobj;
+
+    Json::Value dbobj(Json::objectValue);
+    {
+        std::lock_guard lock(dbReaders_.mutex);
+        for (auto const& [database, reader] : dbReaders_.value)
+        {
+            Json::Value j(Json::objectValue);
+            j[jss::checkouts] = std::to_string(reader.checkouts);
+            j[jss::wait_us] = std::to_string(reader.wait);
+            j[jss::max_wait_us] = std::to_string(reader.maxWait);
+            dbobj[database] = j;
+        }
+    }
+    if (dbobj.size())
+        counters[jss::db_readers] = dbobj;
+
+    LockWait lockWait;
+    {
+        std::lock_guard lock(jobQueueLock_.mutex);
+        lockWait = jobQueueLock_.value;
+    }
+    if (lockWait.waits)
+    {
+        Json::Value lockobj(Json::objectValue);
+        lockobj[jss::waits] = std::to_string(lockWait.waits);
+        lockobj[jss::wait_us] = std::to_string(lockWait.wait);
+        lockobj[jss::max_wait_us] = std::to_string(lockWait.maxWait);
+        counters[jss::job_queue_lock] = lockobj;
+    }
     return counters;
 }
 
+static Json::Value
+percentilesJson(LatencyHistogram const& histogram)
+{
+    Json::Value result(Json::objectValue);
+    result[jss::count] = std::to_string(histogram.count());
+    result[jss::p50_us] =
+        std::to_string(histogram.percentile(0.5).count());
+    result[jss::p99_us] =
+        std::to_string(histogram.percentile(0.99).count());
+    result[jss::p999_us] =
+        std::to_string(histogram.percentile(0.999).count());
+    return result;
+}
+
+Json::Value
+PerfLogImp::Counters::latencyJson() const
+{
+    Json::Value rpcobj(Json::objectValue);
+    for (auto const& [name, counter] : rpc_)
+    {
+        if (counter.latency.count())
+            rpcobj[name] = percentilesJson(counter.latency);
+    }
+
+    Json::Value jqobj(Json::objectValue);
+    for (auto const& [type, counter] : jq_)
+    {
+        if (!counter.queuedLatency.count() && !counter.runningLatency.count())
+            continue;
+
+        Json::Value j(Json::objectValue);
+        j[jss::queued] = percentilesJson(counter.queuedLatency);
+        j[jss::running] = percentilesJson(counter.runningLatency);
+        jqobj[JobTypes::name(type)] = j;
+    }
+
+    Json::Value latency(Json::objectValue);
+    latency[jss::rpc] = rpcobj;
+    latency[jss::job_queue] = jqobj;
+    return latency;
+}
+
 Json::Value
 PerfLogImp::Counters::currentJson() const
 {
@@ -304,6 +374,12 @@ PerfLogImp::report()
     else
         app_.getNodeStore().getCountsJson(report[jss::nodestore]);
     report[jss::current_activities] = counters_.currentJson();
+    report[jss::latency] = counters_.latencyJson();
+    {
+        Json::Value& jv = (report[jss::object_bytes] = Json::objectValue);
+        for (auto const& [k, v] : CountedObjects::getInstance().getBytes(0))
+            jv[k] = std::to_string(v);
+    }
     app_.getOPs().stateAccounting(report);
 
     logFile_ << Json::Compact{std::move(report)} << std::endl;
@@ -334,10 +410,7 @@ PerfLogImp::rpcStart(std::string const& method, std::uint64_t const requestId)
         return;
     }
 
-    {
-        std::lock_guard lock(counter->second.mutex);
-        ++counter->second.value.started;
-    }
+    ++counter->second.started;
     std::lock_guard lock(counters_.methodsMutex_);
     counters_.methods_[requestId] = {
         counter->first.c_str(), steady_clock::now()};
@@ -369,13 +442,14 @@ PerfLogImp::rpcEnd(
             assert(false);
         }
     }
-    std::lock_guard lock(counter->second.mutex);
     if (finish)
-        ++counter->second.value.finished;
+        ++counter->second.finished;
     else
-        ++counter->second.value.errored;
-    counter->second.value.duration += std::chrono::duration_cast<microseconds>(
+        ++counter->second.errored;
+    auto const duration = std::chrono::duration_cast<microseconds>(
         steady_clock::now() - startTime);
+    counter->second.duration += duration.count();
+    counter->second.latency.record(duration);
 }
 
 void
@@ -387,8 +461,7 @@ PerfLogImp::jobQueue(JobType const type)
         assert(false);
         return;
     }
-    std::lock_guard lock(counter->second.mutex);
-    ++counter->second.value.queued;
+    ++counter->second.queued;
 }
 
 void
@@ -404,11 +477,9 @@ PerfLogImp::jobStart(
         assert(false);
         return;
     }
-    {
-        std::lock_guard lock(counter->second.mutex);
-        ++counter->second.value.started;
-        counter->second.value.queuedDuration += dur;
-    }
+    ++counter->second.started;
+    counter->second.queuedDuration += dur.count();
+    counter->second.queuedLatency.record(dur);
     std::lock_guard lock(counters_.jobsMutex_);
     if (instance >= 0 && instance < counters_.jobs_.size())
         counters_.jobs_[instance] = {type, startTime};
@@ -423,16 +494,34 @@ PerfLogImp::jobFinish(JobType const type, microseconds dur, int instance)
         assert(false);
         return;
     }
-    {
-        std::lock_guard lock(counter->second.mutex);
-        ++counter->second.value.finished;
-        counter->second.value.runningDuration += dur;
-    }
+    ++counter->second.finished;
+    counter->second.runningDuration += dur.count();
+    counter->second.runningLatency.record(dur);
     std::lock_guard lock(counters_.jobsMutex_);
     if (instance >= 0 && instance < counters_.jobs_.size())
         counters_.jobs_[instance] = {jtINVALID, steady_time_point()};
 }
 
+void
+PerfLogImp::dbReader(std::string const& database, microseconds wait)
+{
+    std::lock_guard lock(counters_.dbReaders_.mutex);
+    auto& value = counters_.dbReaders_.value[database];
+    ++value.checkouts;
+    value.wait += wait.count();
+    value.maxWait = std::max<std::uint64_t>(value.maxWait, wait.count());
+}
+
+void
+PerfLogImp::jobQueueLock(microseconds wait)
+{
+    std::lock_guard lock(counters_.jobQueueLock_.mutex);
+    auto& value = counters_.jobQueueLock_.value;
+    ++value.waits;
+    value.wait += wait.count();
+    value.maxWait = std::max<std::uint64_t>(value.maxWait, wait.count());
+}
+
 void
 PerfLogImp::resizeJobs(int const resize)
 {
@@ -20,15 +20,18 @@
 #ifndef RIPPLE_BASICS_PERFLOGIMP_H
 #define RIPPLE_BASICS_PERFLOGIMP_H
 
+#include <ripple/basics/LatencyHistogram.h>
 #include <ripple/basics/PerfLog.h>
 #include <ripple/basics/chrono.h>
 #include <ripple/beast/utility/Journal.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/rpc/impl/Handler.h>
 #include <boost/asio/ip/host_name.hpp>
+#include <atomic>
 #include <condition_variable>
 #include <cstdint>
 #include <fstream>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -82,11 +85,14 @@ class PerfLogImp : public PerfLog
         {
             // Counters for each time a method starts and then either
             // finishes successfully or with an exception.
-            std::uint64_t started{0};
-            std::uint64_t finished{0};
-            std::uint64_t errored{0};
-            // Cumulative duration of all finished and errored method calls.
-            microseconds duration{0};
+            std::atomic<std::uint64_t> started{0};
+            std::atomic<std::uint64_t> finished{0};
+            std::atomic<std::uint64_t> errored{0};
+            // Cumulative duration in microseconds of all finished and
+            // errored method calls.
+            std::atomic<std::uint64_t> duration{0};
+            // Distribution of the durations of finished and errored calls.
+            LatencyHistogram latency;
         };
 
         /**
@@ -96,28 +102,60 @@ class PerfLogImp : public PerfLog
         {
             // Counters for each time a job is enqueued, begins to run,
             // finishes.
-            std::uint64_t queued{0};
-            std::uint64_t started{0};
-            std::uint64_t finished{0};
-            // Cumulative duration of all jobs' queued and running times.
-            microseconds queuedDuration{0};
-            microseconds runningDuration{0};
+            std::atomic<std::uint64_t> queued{0};
+            std::atomic<std::uint64_t> started{0};
+            std::atomic<std::uint64_t> finished{0};
+            // Cumulative duration in microseconds of all jobs' queued and
+            // running times.
+            std::atomic<std::uint64_t> queuedDuration{0};
+            std::atomic<std::uint64_t> runningDuration{0};
+            // Distributions of the jobs' queued and running times.
+            LatencyHistogram queuedLatency;
+            LatencyHistogram runningLatency;
+        };
+
+        /**
+         * Read-only database connection counters.
+         */
+        struct DbReader
+        {
+            std::uint64_t checkouts{0};
+            // Cumulative and longest wait in microseconds for a
+            // connection to be free.
+            std::uint64_t wait{0};
+            std::uint64_t maxWait{0};
+        };
+
+        /**
+         * Waits for the JobQueue's lock.
+         */
+        struct LockWait
+        {
+            std::uint64_t waits{0};
+            // Cumulative and longest wait in microseconds.
+            std::uint64_t wait{0};
+            std::uint64_t maxWait{0};
         };
 
         // rpc_ and jq_ do not need mutex protection because all
-        // keys and values are created before more threads are started.
-        std::unordered_map<std::string, Locked<Rpc>> rpc_;
-        std::unordered_map<JobType, Locked<Jq>> jq_;
+        // keys and values are created before more threads are started,
+        // and the counters themselves are atomic.
+        std::unordered_map<std::string, Rpc> rpc_;
+        std::unordered_map<JobType, Jq> jq_;
         std::vector<std::pair<JobType, steady_time_point>> jobs_;
         mutable std::mutex jobsMutex_;
         std::unordered_map<std::uint64_t, MethodStart> methods_;
         mutable std::mutex methodsMutex_;
+        Locked<std::map<std::string, DbReader>> dbReaders_;
+        Locked<LockWait> jobQueueLock_;
 
         Counters(std::set<char const*> const& labels, JobTypes const& jobTypes);
         Json::Value
         countersJson() const;
         Json::Value
         currentJson() const;
+        Json::Value
+        latencyJson() const;
     };
 
     Setup const setup_;
@@ -180,6 +218,10 @@ public:
         int instance) override;
     void
     jobFinish(JobType const type, microseconds dur, int instance) override;
+    void
+    dbReader(std::string const& database, microseconds wait) override;
+    void
+    jobQueueLock(microseconds wait) override;
 
     Json::Value
     countersJson() const override
@@ -193,6 +235,12 @@ public:
         return counters_.currentJson();
     }
 
+    Json::Value
+    latencyJson() const override
+    {
+        return counters_.latencyJson();
+    }
+
     void
     resizeJobs(int const resize) override;
     void
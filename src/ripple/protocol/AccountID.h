@@ -29,6 +29,7 @@
 #include <ripple/protocol/json_get_or_throw.h>
 
 #include <cstddef>
+#include <cstdint>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -123,6 +124,20 @@ operator<<(std::ostream& os, AccountID const& x)
 void
 initAccountIdCache(std::size_t count);
 
+/** How the AccountID cache is doing. */
+struct AccountIdCacheStats
+{
+    // The number of entries the cache holds; zero if it is disabled
+    std::size_t size = 0;
+
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+};
+
+/** Returns the AccountID cache's size and hit counters. */
+AccountIdCacheStats
+getAccountIdCacheStats();
+
 }  // namespace ripple
 
 //------------------------------------------------------------------------------
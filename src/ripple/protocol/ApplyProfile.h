@@ -0,0 +1,209 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_PROTOCOL_APPLYPROFILE_H_INCLUDED
+#define RIPPLE_PROTOCOL_APPLYPROFILE_H_INCLUDED
+
+#include <ripple/json/json_value.h>
+#include <ripple/protocol/Keylet.h>
+#include <ripple/protocol/LedgerFormats.h>
+#include <ripple/protocol/TxFormats.h>
+#include <cstddef>
+
+// Profiling is compiled in by defining RIPPLE_APPLY_PROFILE to 1. When it
+// is 0, the default, every hook below is empty.
+#ifndef RIPPLE_APPLY_PROFILE
+#define RIPPLE_APPLY_PROFILE 0
+#endif
+
+namespace ripple {
+namespace applyProfile {
+
+/** Counts the work done while applying transactions.
+
+    While a transaction is applied, the ledger entries it reads, peeks,
+    copies into its views and inserts are counted against both its
+    transaction type and the entry's type. The STObject field lookups
+    made on the applying thread and the bytes of transaction and metadata
+    serialized for the ledger are counted against the transaction type.
+
+    The counts depend only on the transactions and the ledger they are
+    applied to, not on timing, so the same workload gives the same counts
+    from run to run. They are exported by the apply_profile command.
+*/
+
+/** What was done to a ledger entry. */
+enum Event : std::size_t {
+    read,    // Looked up through ApplyView::read
+    peek,    // Looked up through ApplyView::peek
+    copy,    // Copied into a view to be modified
+    insert,  // Created through ApplyView::insert
+    events
+};
+
+namespace detail {
+
+#if RIPPLE_APPLY_PROFILE
+// The type of the transaction this thread is applying, or -1.
+extern thread_local int current;
+
+// The number of nested reads and peeks in progress on this thread.
+extern thread_local int depth;
+
+// Starts attributing work to a transaction type, returning the type
+// previously attributed to.
+int
+begin(TxType type) noexcept;
+
+void
+count(Event event, LedgerEntryType type) noexcept;
+
+void
+countField() noexcept;
+
+void
+countBytes(std::size_t bytes) noexcept;
+#endif
+
+}  // namespace detail
+
+/** Returns `true` if profiling was compiled in. */
+constexpr bool
+compiled() noexcept
+{
+    return RIPPLE_APPLY_PROFILE != 0;
+}
+
+/** Attributes the work done in a scope to a transaction type. */
+class Scope
+{
+#if RIPPLE_APPLY_PROFILE
+    int previous_;
+#endif
+
+public:
+    explicit Scope(TxType type) noexcept
+#if RIPPLE_APPLY_PROFILE
+        : previous_(detail::begin(type))
+    {
+    }
+#else
+    {
+        (void)type;
+    }
+#endif
+
+    ~Scope()
+    {
+#if RIPPLE_APPLY_PROFILE
+        detail::current = previous_;
+#endif
+    }
+
+    Scope(Scope const&) = delete;
+    Scope&
+    operator=(Scope const&) = delete;
+};
+
+/** Counts an event on a ledger entry. */
+inline void
+count(Event event, LedgerEntryType type) noexcept
+{
+#if RIPPLE_APPLY_PROFILE
+    if (detail::current >= 0)
+        detail::count(event, type);
+#else
+    (void)event;
+    (void)type;
+#endif
+}
+
+/** Counts a read or peek made by calling f.
+
+    Views are stacked, and a lookup which misses in one view is passed to
+    the view below it. Only the outermost lookup is counted, against the
+    type of the entry found or, if none was, the type of the keylet.
+*/
+template <class F>
+auto
+access(Event event, Keylet const& k, F&& f)
+{
+#if RIPPLE_APPLY_PROFILE
+    if (detail::current < 0)
+        return f();
+
+    ++detail::depth;
+    auto sle = [&] {
+        try
+        {
+            return f();
+        }
+        catch (...)
+        {
+            --detail::depth;
+            throw;
+        }
+    }();
+    if (--detail::depth == 0)
+        detail::count(event, sle ? sle->getType() : k.type);
+    return sle;
+#else
+    (void)event;
+    (void)k;
+    return f();
+#endif
+}
+
+/** Counts a lookup of an STObject field. */
+inline void
+countField() noexcept
+{
+#if RIPPLE_APPLY_PROFILE
+    if (detail::current >= 0)
+        detail::countField();
+#endif
+}
+
+/** Counts bytes serialized for the ledger. */
+inline void
+countBytes(std::size_t bytes) noexcept
+{
+#if RIPPLE_APPLY_PROFILE
+    if (detail::current >= 0)
+        detail::countBytes(bytes);
+#else
+    (void)bytes;
+#endif
+}
+
+/** Discard every count. */
+void
+clear();
+
+/** Returns the counts, by transaction type and ledger entry type.
+
+    Types with nothing counted are omitted.
+*/
+Json::Value
+getJson();
+
+}  // namespace applyProfile
+}  // namespace ripple
+
+#endif
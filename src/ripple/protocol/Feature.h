@@ -26,6 +26,7 @@
 #include <bitset>
 #include <optional>
 #include <string>
+#include <type_traits>
 
 /**
  * @page Feature How to add new features
@@ -98,12 +99,39 @@ numUpVotedAmendments();
 
 }  // namespace detail
 
+/** An amendment registered in Feature.cpp.
+
+    It is the amendment's ID, and also carries the amendment's index in a
+    FeatureBitset, so checking it against a set of amendments, as
+    Rules::enabled does, needs no lookup.
+*/
+class RegisteredFeature : public uint256
+{
+    std::size_t index_;
+
+public:
+    RegisteredFeature(uint256 const& feature, std::size_t index)
+        : uint256(feature), index_(index)
+    {
+    }
+
+    std::size_t
+    index() const
+    {
+        return index_;
+    }
+};
+
 std::optional<uint256>
 getRegisteredFeature(std::string const& name);
 
 size_t
 featureToBitsetIndex(uint256 const& f);
 
+/** Returns the FeatureBitset index of a feature, if it is registered. */
+std::optional<std::size_t>
+findFeatureBitsetIndex(uint256 const& f);
+
 uint256
 bitsetIndexToFeature(size_t i);
 
@@ -155,7 +183,9 @@ public:
         assert(count() == (sizeof...(fs) + 1));
     }
 
+    // A single feature is not a collection of them
     template <class Col>
+        requires(!std::is_convertible_v<Col const&, uint256 const&>)
     explicit FeatureBitset(Col const& fs)
     {
         for (auto const& f : fs)
@@ -302,59 +332,59 @@ foreachFeature(FeatureBitset bs, F&& f)
             f(bitsetIndexToFeature(i));
 }
 
-extern uint256 const featureOwnerPaysFee;
-extern uint256 const featureFlow;
-extern uint256 const featureFlowCross;
-extern uint256 const featureCryptoConditionsSuite;
-extern uint256 const fix1513;
-extern uint256 const featureDepositAuth;
-extern uint256 const featureChecks;
-extern uint256 const fix1571;
-extern uint256 const fix1543;
-extern uint256 const fix1623;
-extern uint256 const featureDepositPreauth;
-extern uint256 const fix1515;
-extern uint256 const fix1578;
-extern uint256 const featureMultiSignReserve;
-extern uint256 const fixTakerDryOfferRemoval;
-extern uint256 const fixMasterKeyAsRegularKey;
-extern uint256 const fixCheckThreading;
-extern uint256 const fixPayChanRecipientOwnerDir;
-extern uint256 const featureDeletableAccounts;
-extern uint256 const fixQualityUpperBound;
-extern uint256 const featureRequireFullyCanonicalSig;
-extern uint256 const fix1781;
-extern uint256 const featureHardenedValidations;
-extern uint256 const fixAmendmentMajorityCalc;
-extern uint256 const featureNegativeUNL;
-extern uint256 const featureTicketBatch;
-extern uint256 const featureFlowSortStrands;
-extern uint256 const fixSTAmountCanonicalize;
-extern uint256 const fixRmSmallIncreasedQOffers;
-extern uint256 const featureCheckCashMakesTrustLine;
-extern uint256 const featureNonFungibleTokensV1;
-extern uint256 const featureExpandedSignerList;
-extern uint256 const fixNFTokenDirV1;
-extern uint256 const fixNFTokenNegOffer;
-extern uint256 const featureNonFungibleTokensV1_1;
-extern uint256 const fixTrustLinesToSelf;
-extern uint256 const fixRemoveNFTokenAutoTrustLine;
-extern uint256 const featureImmediateOfferKilled;
-extern uint256 const featureDisallowIncoming;
-extern uint256 const featureXRPFees;
-extern uint256 const featureAMM;
-extern uint256 const fixUniversalNumber;
-extern uint256 const fixNonFungibleTokensV1_2;
-extern uint256 const fixNFTokenRemint;
-extern uint256 const fixReducedOffersV1;
-extern uint256 const featureClawback;
-extern uint256 const featureXChainBridge;
-extern uint256 const fixDisallowIncomingV1;
-extern uint256 const featureDID;
-extern uint256 const fixFillOrKill;
-extern uint256 const fixNFTokenReserve;
-extern uint256 const fixInnerObjTemplate;
-extern uint256 const featurePriceOracle;
+extern RegisteredFeature const featureOwnerPaysFee;
+extern RegisteredFeature const featureFlow;
+extern RegisteredFeature const featureFlowCross;
+extern RegisteredFeature const featureCryptoConditionsSuite;
+extern RegisteredFeature const fix1513;
+extern RegisteredFeature const featureDepositAuth;
+extern RegisteredFeature const featureChecks;
+extern RegisteredFeature const fix1571;
+extern RegisteredFeature const fix1543;
+extern RegisteredFeature const fix1623;
+extern RegisteredFeature const featureDepositPreauth;
+extern RegisteredFeature const fix1515;
+extern RegisteredFeature const fix1578;
+extern RegisteredFeature const featureMultiSignReserve;
+extern RegisteredFeature const fixTakerDryOfferRemoval;
+extern RegisteredFeature const fixMasterKeyAsRegularKey;
+extern RegisteredFeature const fixCheckThreading;
+extern RegisteredFeature const fixPayChanRecipientOwnerDir;
+extern RegisteredFeature const featureDeletableAccounts;
+extern RegisteredFeature const fixQualityUpperBound;
+extern RegisteredFeature const featureRequireFullyCanonicalSig;
+extern RegisteredFeature const fix1781;
+extern RegisteredFeature const featureHardenedValidations;
+extern RegisteredFeature const fixAmendmentMajorityCalc;
+extern RegisteredFeature const featureNegativeUNL;
+extern RegisteredFeature const featureTicketBatch;
+extern RegisteredFeature const featureFlowSortStrands;
+extern RegisteredFeature const fixSTAmountCanonicalize;
+extern RegisteredFeature const fixRmSmallIncreasedQOffers;
+extern RegisteredFeature const featureCheckCashMakesTrustLine;
+extern RegisteredFeature const featureNonFungibleTokensV1;
+extern RegisteredFeature const featureExpandedSignerList;
+extern RegisteredFeature const fixNFTokenDirV1;
+extern RegisteredFeature const fixNFTokenNegOffer;
+extern RegisteredFeature const featureNonFungibleTokensV1_1;
+extern RegisteredFeature const fixTrustLinesToSelf;
+extern RegisteredFeature const fixRemoveNFTokenAutoTrustLine;
+extern RegisteredFeature const featureImmediateOfferKilled;
+extern RegisteredFeature const featureDisallowIncoming;
+extern RegisteredFeature const featureXRPFees;
+extern RegisteredFeature const featureAMM;
+extern RegisteredFeature const fixUniversalNumber;
+extern RegisteredFeature const fixNonFungibleTokensV1_2;
+extern RegisteredFeature const fixNFTokenRemint;
+extern RegisteredFeature const fixReducedOffersV1;
+extern RegisteredFeature const featureClawback;
+extern RegisteredFeature const featureXChainBridge;
+extern RegisteredFeature const fixDisallowIncomingV1;
+extern RegisteredFeature const featureDID;
+extern RegisteredFeature const fixFillOrKill;
+extern RegisteredFeature const fixNFTokenReserve;
+extern RegisteredFeature const fixInnerObjTemplate;
+extern RegisteredFeature const featurePriceOracle;
 
 }  // namespace ripple
 
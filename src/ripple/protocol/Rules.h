@@ -22,6 +22,7 @@
 
 #include <ripple/basics/base_uint.h>
 #include <ripple/beast/hash/uhash.h>
+#include <ripple/protocol/Feature.h>
 #include <ripple/protocol/STVector256.h>
 #include <unordered_set>
 
@@ -79,6 +80,14 @@ public:
     bool
     enabled(uint256 const& feature) const;
 
+    /** Returns `true` if a feature is enabled.
+
+        This is a single bit test, which is what checking any of the
+        features declared in Feature.h costs.
+    */
+    bool
+    enabled(RegisteredFeature const& feature) const;
+
     /** Returns `true` if two rule sets are identical.
 
         @note This is for diagnostics.
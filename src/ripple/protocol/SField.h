@@ -25,6 +25,8 @@
 
 #include <cstdint>
 #include <map>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 
 namespace ripple {
@@ -299,6 +301,11 @@ public:
 private:
     static int num;
     static std::map<int, SField const*> knownCodeToField;
+
+    // Fields by name, for parsing JSON. The names are views of the
+    // fieldName of the fields themselves.
+    static std::unordered_map<std::string_view, SField const*>
+        knownNameToField;
 };
 
 /** A field with a type known at compile time. */
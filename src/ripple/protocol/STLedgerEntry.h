@@ -32,6 +32,9 @@ class STLedgerEntry final : public STObject, public CountedObject<STLedgerEntry>
     uint256 key_;
     LedgerEntryType type_;
 
+    // The memory held by the fields, as last counted by recount()
+    std::uint32_t countedBytes_ = 0;
+
 public:
     using pointer = std::shared_ptr<STLedgerEntry>;
     using ref = const std::shared_ptr<STLedgerEntry>&;
@@ -42,6 +45,12 @@ public:
     STLedgerEntry(SerialIter& sit, uint256 const& index);
     STLedgerEntry(SerialIter&& sit, uint256 const& index);
     STLedgerEntry(STObject const& object, uint256 const& index);
+    STLedgerEntry(STLedgerEntry const& other);
+    STLedgerEntry(STLedgerEntry&& other);
+    ~STLedgerEntry();
+
+    STLedgerEntry&
+    operator=(STLedgerEntry const& other);
 
     SerializedTypeID
     getSType() const override;
@@ -83,6 +92,10 @@ private:
     void
     setSLEType();
 
+    // Account for the memory held by the fields of the entry
+    void
+    recount();
+
     friend Invariants_test;  // this test wants access to the private type_
 
     STBase*
@@ -27,13 +27,18 @@
 #include <ripple/basics/contract.h>
 #include <ripple/protocol/HashPrefix.h>
 #include <ripple/protocol/SOTemplate.h>
+#include <ripple/protocol/STAccount.h>
 #include <ripple/protocol/STAmount.h>
 #include <ripple/protocol/STBase.h>
+#include <ripple/protocol/STBitString.h>
+#include <ripple/protocol/STBlob.h>
 #include <ripple/protocol/STCurrency.h>
+#include <ripple/protocol/STInteger.h>
 #include <ripple/protocol/STIssue.h>
 #include <ripple/protocol/STPathSet.h>
 #include <ripple/protocol/STVector256.h>
 #include <ripple/protocol/impl/STVar.h>
+#include <boost/container/small_vector.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 #include <cassert>
 #include <optional>
@@ -52,6 +57,54 @@ throwFieldNotFound(SField const& field)
     Throw<std::runtime_error>("Field not found: " + field.getName());
 }
 
+namespace detail {
+
+// The serialized type that only objects of the class report. Fields of
+// these classes can be cast by checking their type rather than with a
+// dynamic_cast, which costs much more.
+template <class T>
+inline constexpr SerializedTypeID exactSType = STI_UNKNOWN;
+template <>
+inline constexpr SerializedTypeID exactSType<STUInt8> = STI_UINT8;
+template <>
+inline constexpr SerializedTypeID exactSType<STUInt16> = STI_UINT16;
+template <>
+inline constexpr SerializedTypeID exactSType<STUInt32> = STI_UINT32;
+template <>
+inline constexpr SerializedTypeID exactSType<STUInt64> = STI_UINT64;
+template <>
+inline constexpr SerializedTypeID exactSType<STUInt128> = STI_UINT128;
+template <>
+inline constexpr SerializedTypeID exactSType<STUInt160> = STI_UINT160;
+template <>
+inline constexpr SerializedTypeID exactSType<STUInt256> = STI_UINT256;
+template <>
+inline constexpr SerializedTypeID exactSType<STAmount> = STI_AMOUNT;
+template <>
+inline constexpr SerializedTypeID exactSType<STAccount> = STI_ACCOUNT;
+template <>
+inline constexpr SerializedTypeID exactSType<STBlob> = STI_VL;
+template <>
+inline constexpr SerializedTypeID exactSType<STVector256> = STI_VECTOR256;
+
+/** Return the field as a T, or nullptr if it isn't one. */
+template <class T, class Base>
+T*
+fieldCast(Base* field)
+{
+    static_assert(std::is_const_v<T> == std::is_const_v<Base>);
+
+    constexpr auto stype = exactSType<std::remove_const_t<T>>;
+    if constexpr (stype != STI_UNKNOWN)
+    {
+        if (field && field->getSType() == stype)
+            return static_cast<T*>(field);
+    }
+    return dynamic_cast<T*>(field);
+}
+
+}  // namespace detail
+
 class STObject : public STBase, public CountedObject<STObject>
 {
     // Proxy value for a STBase derived class
@@ -422,10 +475,14 @@ private:
     void
     add(Serializer& s, WhichFields whichFields) const;
 
+    // Enough room for the fields of nearly every object without
+    // allocating.
+    using SortedFields = boost::container::small_vector<STBase const*, 32>;
+
     // Sort the entries in an STObject into the order that they will be
     // serialized.  Note: they are not sorted into pointer value order, they
     // are sorted by SField::fieldCode.
-    static std::vector<STBase const*>
+    static SortedFields
     getSortedFields(STObject const& objToSort, WhichFields whichFields);
 
     // Implementation for getting (most) fields that return by value.
@@ -698,7 +755,7 @@ template <class T>
 inline T const*
 STObject::Proxy<T>::find() const
 {
-    return dynamic_cast<T const*>(st_->peekAtPField(*f_));
+    return detail::fieldCast<T const>(st_->peekAtPField(*f_));
 }
 
 template <class T>
@@ -713,9 +770,9 @@ STObject::Proxy<T>::assign(U&& u)
     }
     T* t;
     if (style_ == soeINVALID)
-        t = dynamic_cast<T*>(st_->getPField(*f_, true));
+        t = detail::fieldCast<T>(st_->getPField(*f_, true));
     else
-        t = dynamic_cast<T*>(st_->makeFieldPresent(*f_));
+        t = detail::fieldCast<T>(st_->makeFieldPresent(*f_));
     assert(t);
     *t = std::forward<U>(u);
 }
@@ -991,7 +1048,7 @@ STObject::at(TypedField<T> const& f) const
         // with no template
         Throw<STObject::FieldErr>("Missing field: " + f.getName());
 
-    if (auto const u = dynamic_cast<T const*>(b))
+    if (auto const u = detail::fieldCast<T const>(b))
         return u->value();
 
     assert(mType);
@@ -1015,7 +1072,7 @@ STObject::at(OptionaledField<T> const& of) const
     auto const b = peekAtPField(*of.f);
     if (!b)
         return std::nullopt;
-    auto const u = dynamic_cast<T const*>(b);
+    auto const u = detail::fieldCast<T const>(b);
     if (!u)
     {
         assert(mType);
@@ -1055,7 +1112,7 @@ STObject::setFieldH160(SField const& field, base_uint<160, Tag> const& v)
         rf = makeFieldPresent(field);
 
     using Bits = STBitString<160>;
-    if (auto cf = dynamic_cast<Bits*>(rf))
+    if (auto cf = detail::fieldCast<Bits>(rf))
         cf->setValue(v);
     else
         Throw<std::runtime_error>("Wrong field type");
@@ -1081,7 +1138,7 @@ STObject::getFieldByValue(SField const& field) const
     if (id == STI_NOTPRESENT)
         return V();  // optional field not present
 
-    const T* cf = dynamic_cast<const T*>(rf);
+    const T* cf = detail::fieldCast<T const>(rf);
 
     if (!cf)
         Throw<std::runtime_error>("Wrong field type");
@@ -1108,7 +1165,7 @@ STObject::getFieldByConstRef(SField const& field, V const& empty) const
     if (id == STI_NOTPRESENT)
         return empty;  // optional field not present
 
-    const T* cf = dynamic_cast<const T*>(rf);
+    const T* cf = detail::fieldCast<T const>(rf);
 
     if (!cf)
         Throw<std::runtime_error>("Wrong field type");
@@ -1131,7 +1188,7 @@ STObject::setFieldUsingSetValue(SField const& field, V value)
     if (rf->getSType() == STI_NOTPRESENT)
         rf = makeFieldPresent(field);
 
-    T* cf = dynamic_cast<T*>(rf);
+    T* cf = detail::fieldCast<T>(rf);
 
     if (!cf)
         Throw<std::runtime_error>("Wrong field type");
@@ -1152,7 +1209,7 @@ STObject::setFieldUsingAssignment(SField const& field, T const& value)
     if (rf->getSType() == STI_NOTPRESENT)
         rf = makeFieldPresent(field);
 
-    T* cf = dynamic_cast<T*>(rf);
+    T* cf = detail::fieldCast<T>(rf);
 
     if (!cf)
         Throw<std::runtime_error>("Wrong field type");
@@ -1173,7 +1230,7 @@ STObject::peekField(SField const& field)
     if (rf->getSType() == STI_NOTPRESENT)
         rf = makeFieldPresent(field);
 
-    T* cf = dynamic_cast<T*>(rf);
+    T* cf = detail::fieldCast<T>(rf);
 
     if (!cf)
         Throw<std::runtime_error>("Wrong field type");
@@ -33,6 +33,7 @@
 #include <cstdint>
 #include <cstring>
 #include <iomanip>
+#include <optional>
 #include <type_traits>
 
 namespace ripple {
@@ -306,6 +307,44 @@ Serializer::addVL(Iter begin, Iter end, int len)
 
 //------------------------------------------------------------------------------
 
+/** A Serializer for data that is only needed briefly.
+
+    Hashing or verifying the signature of an object needs its serialized
+    form only until the digest is computed. Each thread keeps one buffer
+    for such uses, which is cleared and lent to a ScratchSerializer while
+    it exists, so the serialization does not allocate once the buffer has
+    grown to fit. A ScratchSerializer created while the thread's buffer
+    is lent out uses a buffer of its own.
+*/
+class ScratchSerializer
+{
+private:
+    Serializer* s_;
+    std::optional<Serializer> own_;
+
+public:
+    ScratchSerializer();
+    ~ScratchSerializer();
+
+    ScratchSerializer(ScratchSerializer const&) = delete;
+    ScratchSerializer&
+    operator=(ScratchSerializer const&) = delete;
+
+    Serializer&
+    operator*()
+    {
+        return *s_;
+    }
+
+    Serializer*
+    operator->()
+    {
+        return s_;
+    }
+};
+
+//------------------------------------------------------------------------------
+
 // DEPRECATED
 // Transitional adapter to new serialization interfaces
 class SerialIter
@@ -18,71 +18,177 @@
 //==============================================================================
 
 #include <ripple/basics/hardened_hash.h>
-#include <ripple/basics/spinlock.h>
 #include <ripple/protocol/AccountID.h>
 #include <ripple/protocol/PublicKey.h>
 #include <ripple/protocol/digest.h>
 #include <ripple/protocol/tokens.h>
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
 #include <cstring>
-#include <mutex>
+#include <memory>
 
 namespace ripple {
 
 namespace detail {
 
-/** Caches the base58 representations of AccountIDs */
+/** Caches the base58 representations of AccountIDs
+
+    The cache is set associative: an AccountID maps to a set of a few
+    entries, any of which may hold it. Each set is guarded by a sequence
+    lock, so lookups never block or write to the set: a reader copies the
+    set and only trusts the copy if no writer touched the set in the
+    meantime. A writer that finds the set busy simply doesn't cache its
+    result. Within a set, the oldest entry is replaced first.
+
+    The one shared write a lookup makes is to the hit and miss counters.
+    They are striped by set, so lookups of different sets mostly update
+    different cache lines.
+*/
 class AccountIdCache
 {
 private:
-    struct CachedAccountID
+    // An entry is the AccountID, padded to 24 bytes, followed by the
+    // encoding, padded to 40 bytes. Entries are stored as atomic words so
+    // that readers racing a writer see torn data, never undefined
+    // behavior; the sequence number tells them to discard it.
+    static constexpr std::size_t idWords = 3;
+    static constexpr std::size_t encodingWords = 5;
+    static constexpr std::size_t entryWords = idWords + encodingWords;
+
+    // The number of entries in each set
+    static constexpr std::size_t ways = 4;
+
+    struct alignas(64) Set
+    {
+        // Odd while a writer is updating the set
+        std::atomic<std::uint32_t> sequence{0};
+
+        // The entry to replace next
+        std::uint32_t victim = 0;
+
+        std::array<std::atomic<std::uint64_t>, entryWords> entries[ways];
+    };
+
+    struct alignas(64) Counters
     {
-        AccountID id;
-        char encoding[40] = {0};
+        std::atomic<std::uint64_t> hits{0};
+        std::atomic<std::uint64_t> misses{0};
     };
 
-    // The actual cache
-    std::vector<CachedAccountID> cache_;
+    std::unique_ptr<Set[]> sets_;
+    std::size_t const size_;
+
+    // Spread over several cache lines so counting doesn't make threads
+    // contend on a single one
+    std::array<Counters, 16> counters_;
 
     // We use a hash function designed to resist algorithmic complexity attacks
     hardened_hash<> hasher_;
 
-    // 64 spinlocks, packed into a single 64-bit value
-    std::atomic<std::uint64_t> locks_ = 0;
+    static std::array<std::uint64_t, idWords>
+    toWords(AccountID const& id)
+    {
+        std::array<std::uint64_t, idWords> ret{};
+        std::memcpy(ret.data(), id.data(), id.size());
+        return ret;
+    }
 
 public:
-    AccountIdCache(std::size_t count) : cache_(count)
+    AccountIdCache(std::size_t count)
+        : sets_(std::make_unique<Set[]>(std::max<std::size_t>(count / ways, 1)))
+        , size_(std::max<std::size_t>(count / ways, 1))
     {
-        // This is non-binding, but we try to avoid wasting memory that
-        // is caused by overallocation.
-        cache_.shrink_to_fit();
     }
 
     std::string
     toBase58(AccountID const& id)
     {
-        auto const index = hasher_(id) % cache_.size();
-
-        packed_spinlock sl(locks_, index % 64);
+        auto const index = hasher_(id) % size_;
+        auto& set = sets_[index];
+        auto& counters = counters_[index % counters_.size()];
+        auto const key = toWords(id);
 
+        if (auto const seq = set.sequence.load(std::memory_order_acquire);
+            (seq & 1) == 0)
         {
-            std::lock_guard lock(sl);
-
-            // The check against the first character of the encoding ensures
-            // that we don't mishandle the case of the all-zero account:
-            if (cache_[index].encoding[0] != 0 && cache_[index].id == id)
-                return cache_[index].encoding;
+            std::array<std::uint64_t, encodingWords + 1> encoding{};
+            bool found = false;
+
+            for (auto const& entry : set.entries)
+            {
+                std::size_t i = 0;
+                while (i != idWords &&
+                       entry[i].load(std::memory_order_relaxed) == key[i])
+                    ++i;
+
+                // An empty entry has no encoding, which also keeps the
+                // all-zero account from matching one
+                if (i == idWords &&
+                    entry[idWords].load(std::memory_order_relaxed) != 0)
+                {
+                    for (std::size_t j = 0; j != encodingWords; ++j)
+                        encoding[j] = entry[idWords + j].load(
+                            std::memory_order_relaxed);
+                    found = true;
+                    break;
+                }
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (found &&
+                set.sequence.load(std::memory_order_relaxed) == seq)
+            {
+                counters.hits.fetch_add(1, std::memory_order_relaxed);
+                return reinterpret_cast<char const*>(encoding.data());
+            }
         }
 
+        counters.misses.fetch_add(1, std::memory_order_relaxed);
+
         auto ret =
             encodeBase58Token(TokenType::AccountID, id.data(), id.size());
 
-        assert(ret.size() <= 38);
+        assert(ret.size() < encodingWords * sizeof(std::uint64_t));
+
+        auto seq = set.sequence.load(std::memory_order_relaxed);
+        if ((seq & 1) == 0 &&
+            set.sequence.compare_exchange_strong(
+                seq, seq + 1, std::memory_order_acquire))
+        {
+            std::atomic_thread_fence(std::memory_order_release);
+
+            std::array<std::uint64_t, encodingWords> encoding{};
+            std::memcpy(encoding.data(), ret.data(), ret.size());
+
+            auto& entry = set.entries[set.victim];
+            set.victim = (set.victim + 1) % ways;
+
+            for (std::size_t i = 0; i != idWords; ++i)
+                entry[i].store(key[i], std::memory_order_relaxed);
+            for (std::size_t i = 0; i != encodingWords; ++i)
+                entry[idWords + i].store(
+                    encoding[i], std::memory_order_relaxed);
+
+            set.sequence.store(seq + 2, std::memory_order_release);
+        }
+
+        return ret;
+    }
+
+    AccountIdCacheStats
+    stats() const
+    {
+        AccountIdCacheStats ret;
+        ret.size = size_ * ways;
 
+        for (auto const& c : counters_)
         {
-            std::lock_guard lock(sl);
-            cache_[index].id = id;
-            std::strcpy(cache_[index].encoding, ret.c_str());
+            ret.hits += c.hits.load(std::memory_order_relaxed);
+            ret.misses += c.misses.load(std::memory_order_relaxed);
         }
 
         return ret;
@@ -100,6 +206,15 @@ initAccountIdCache(std::size_t count)
         accountIdCache = std::make_unique<detail::AccountIdCache>(count);
 }
 
+AccountIdCacheStats
+getAccountIdCacheStats()
+{
+    if (accountIdCache)
+        return accountIdCache->stats();
+
+    return {};
+}
+
 std::string
 toBase58(AccountID const& v)
 {
@@ -0,0 +1,188 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/protocol/ApplyProfile.h>
+#include <ripple/protocol/jss.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace ripple {
+namespace applyProfile {
+
+#if RIPPLE_APPLY_PROFILE
+
+namespace detail {
+
+thread_local int current = -1;
+thread_local int depth = 0;
+
+namespace {
+
+// Every transaction and ledger entry type in use fits in a byte. Entries
+// of larger types, like the ltANY of an unchecked keylet that found
+// nothing, are not counted by type.
+constexpr std::size_t types = 256;
+
+// The counters kept for each transaction type, after one per Event.
+enum TxCounter : std::size_t { applied = events, fields, bytes, txCounters };
+
+using Counters = std::array<std::atomic<std::uint64_t>, txCounters>;
+
+std::array<Counters, types> byTx;
+std::array<Counters, types> byEntry;
+
+void
+add(std::atomic<std::uint64_t>& counter, std::uint64_t n = 1) noexcept
+{
+    counter.fetch_add(n, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+int
+begin(TxType type) noexcept
+{
+    if (static_cast<std::size_t>(type) < types)
+        add(byTx[type][applied]);
+    return std::exchange(current, type);
+}
+
+void
+count(Event event, LedgerEntryType type) noexcept
+{
+    if (static_cast<std::size_t>(current) < types)
+        add(byTx[current][event]);
+    if (static_cast<std::size_t>(type) < types)
+        add(byEntry[type][event]);
+}
+
+void
+countField() noexcept
+{
+    if (static_cast<std::size_t>(current) < types)
+        add(byTx[current][fields]);
+}
+
+void
+countBytes(std::size_t n) noexcept
+{
+    if (static_cast<std::size_t>(current) < types)
+        add(byTx[current][bytes], n);
+}
+
+}  // namespace detail
+
+void
+clear()
+{
+    for (auto const table : {&detail::byTx, &detail::byEntry})
+    {
+        for (auto& counters : *table)
+        {
+            for (auto& counter : counters)
+                counter.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+Json::Value
+getJson()
+{
+    using namespace detail;
+
+    // Counts can outgrow a Json::UInt, so they are reported as strings.
+    auto const load = [](Counters const& counters, std::size_t i) {
+        return std::to_string(counters[i].load(std::memory_order_relaxed));
+    };
+
+    auto const entryJson = [&load](Counters const& counters) {
+        Json::Value ret{Json::objectValue};
+        ret[jss::reads] = load(counters, read);
+        ret[jss::peeks] = load(counters, peek);
+        ret[jss::copies] = load(counters, copy);
+        ret[jss::inserts] = load(counters, insert);
+        return ret;
+    };
+
+    auto const empty = [](Counters const& counters) {
+        for (auto const& counter : counters)
+        {
+            if (counter.load(std::memory_order_relaxed) != 0)
+                return false;
+        }
+        return true;
+    };
+
+    Json::Value ret{Json::objectValue};
+
+    auto& txs = ret[jss::transactions] = Json::objectValue;
+    for (std::size_t type = 0; type < types; ++type)
+    {
+        auto const& counters = byTx[type];
+        if (empty(counters))
+            continue;
+
+        auto const item = TxFormats::getInstance().findByType(
+            static_cast<TxType>(type));
+        auto& json = txs[item ? item->getName() : std::to_string(type)] =
+            entryJson(counters);
+        json[jss::applied] = load(counters, applied);
+        json[jss::field_lookups] = load(counters, fields);
+        json[jss::serialized_bytes] = load(counters, bytes);
+    }
+
+    auto& entries = ret[jss::ledger_entries] = Json::objectValue;
+    for (std::size_t type = 0; type < types; ++type)
+    {
+        auto const& counters = byEntry[type];
+        if (empty(counters))
+            continue;
+
+        auto const item = LedgerFormats::getInstance().findByType(
+            static_cast<LedgerEntryType>(type));
+        entries[item ? item->getName() : std::to_string(type)] =
+            entryJson(counters);
+    }
+
+    return ret;
+}
+
+#else
+
+void
+clear()
+{
+}
+
+Json::Value
+getJson()
+{
+    Json::Value ret{Json::objectValue};
+    ret[jss::transactions] = Json::objectValue;
+    ret[jss::ledger_entries] = Json::objectValue;
+    return ret;
+}
+
+#endif
+
+}  // namespace applyProfile
+}  // namespace ripple
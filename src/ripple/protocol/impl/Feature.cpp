@@ -160,7 +160,7 @@ public:
     std::optional<uint256>
     getRegisteredFeature(std::string const& name) const;
 
-    uint256
+    RegisteredFeature
     registerFeature(
         std::string const& name,
         Supported support,
@@ -173,6 +173,9 @@ public:
     std::size_t
     featureToBitsetIndex(uint256 const& f) const;
 
+    std::optional<std::size_t>
+    findFeatureBitsetIndex(uint256 const& f) const;
+
     uint256 const&
     bitsetIndexToFeature(size_t i) const;
 
@@ -227,7 +230,7 @@ check(bool condition, const char* logicErrorMessage)
         LogicError(logicErrorMessage);
 }
 
-uint256
+RegisteredFeature
 FeatureCollections::registerFeature(
     std::string const& name,
     Supported support,
@@ -266,7 +269,7 @@ FeatureCollections::registerFeature(
         check(
             supported.size() <= features.size(),
             "More supported features than defined features");
-        return f;
+        return {f, features.size() - 1};
     }
     else
         // Each feature should only be registered once
@@ -293,6 +296,16 @@ FeatureCollections::featureToBitsetIndex(uint256 const& f) const
     return getIndex(*feature);
 }
 
+std::optional<std::size_t>
+FeatureCollections::findFeatureBitsetIndex(uint256 const& f) const
+{
+    assert(readOnly);
+
+    if (Feature const* feature = getByFeature(f))
+        return getIndex(*feature);
+    return std::nullopt;
+}
+
 uint256 const&
 FeatureCollections::bitsetIndexToFeature(size_t i) const
 {
@@ -344,7 +357,7 @@ getRegisteredFeature(std::string const& name)
     return featureCollections.getRegisteredFeature(name);
 }
 
-uint256
+RegisteredFeature
 registerFeature(std::string const& name, Supported support, VoteBehavior vote)
 {
     return featureCollections.registerFeature(name, support, vote);
@@ -371,6 +384,12 @@ featureToBitsetIndex(uint256 const& f)
     return featureCollections.featureToBitsetIndex(f);
 }
 
+std::optional<std::size_t>
+findFeatureBitsetIndex(uint256 const& f)
+{
+    return featureCollections.findFeatureBitsetIndex(f);
+}
+
 uint256
 bitsetIndexToFeature(size_t i)
 {
@@ -392,7 +411,7 @@ register the feature, and create a variable whose name is "feature" plus the
 feature name.
 */
 #define REGISTER_FEATURE(fName, supported, votebehavior) \
-    uint256 const feature##fName =                       \
+    RegisteredFeature const feature##fName =             \
         registerFeature(#fName, supported, votebehavior)
 
 #pragma push_macro("REGISTER_FIX")
@@ -403,8 +422,9 @@ Takes the name of a feature, whether it's supported, and the default vote. Will
 register the feature, and create a variable whose name is the unmodified feature
 name.
 */
-#define REGISTER_FIX(fName, supported, votebehavior) \
-    uint256 const fName = registerFeature(#fName, supported, votebehavior)
+#define REGISTER_FIX(fName, supported, votebehavior)     \
+    RegisteredFeature const fName =                      \
+        registerFeature(#fName, supported, votebehavior)
 
 // clang-format off
 
@@ -25,6 +25,11 @@
 #include <boost/multiprecision/cpp_int.hpp>
 #include <ed25519.h>
 
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <mutex>
+
 namespace ripple {
 
 std::ostream&
@@ -218,6 +223,83 @@ publicKeyType(Slice const& slice)
     return std::nullopt;
 }
 
+namespace {
+
+/** Remembers recently parsed secp256k1 public keys.
+
+    Parsing a compressed key recovers its y coordinate, which takes a
+    modular square root and costs a good part of a verification. Validator,
+    manifest and busy account keys recur constantly, so their parsed form
+    is kept in a small direct-mapped table. A collision only evicts an
+    entry; the full key is always compared.
+*/
+class ParsedKeyCache
+{
+    static constexpr std::size_t size = 4096;
+    static constexpr std::size_t shards = 64;
+
+    struct Entry
+    {
+        std::array<std::uint8_t, 33> key{};
+        secp256k1_pubkey parsed;
+        bool valid = false;
+    };
+
+    std::array<std::mutex, shards> locks_;
+    std::array<Entry, size> entries_;
+
+    static std::size_t
+    slot(PublicKey const& pk) noexcept
+    {
+        // The x coordinate is uniformly distributed, so any of its bytes
+        // make a good index.
+        std::uint32_t x;
+        std::memcpy(&x, pk.data() + 1, sizeof(x));
+        return x % size;
+    }
+
+public:
+    bool
+    parse(PublicKey const& pk, secp256k1_pubkey& out)
+    {
+        assert(pk.size() == 33);
+
+        auto const i = slot(pk);
+        auto& e = entries_[i];
+
+        {
+            std::lock_guard lock(locks_[i % shards]);
+            if (e.valid && std::memcmp(e.key.data(), pk.data(), 33) == 0)
+            {
+                out = e.parsed;
+                return true;
+            }
+        }
+
+        if (secp256k1_ec_pubkey_parse(
+                secp256k1Context(),
+                &out,
+                reinterpret_cast<unsigned char const*>(pk.data()),
+                pk.size()) != 1)
+            return false;
+
+        std::lock_guard lock(locks_[i % shards]);
+        std::memcpy(e.key.data(), pk.data(), 33);
+        e.parsed = out;
+        e.valid = true;
+        return true;
+    }
+};
+
+ParsedKeyCache&
+parsedKeys()
+{
+    static ParsedKeyCache cache;
+    return cache;
+}
+
+}  // namespace
+
 bool
 verifyDigest(
     PublicKey const& publicKey,
@@ -235,11 +317,7 @@ verifyDigest(
         return false;
 
     secp256k1_pubkey pubkey_imp;
-    if (secp256k1_ec_pubkey_parse(
-            secp256k1Context(),
-            &pubkey_imp,
-            reinterpret_cast<unsigned char const*>(publicKey.data()),
-            publicKey.size()) != 1)
+    if (!parsedKeys().parse(publicKey, pubkey_imp))
         return false;
 
     secp256k1_ecdsa_signature sig_imp;
@@ -25,14 +25,44 @@ namespace ripple {
 class Rules::Impl
 {
 private:
-    std::unordered_set<uint256, hardened_hash<>> set_;
+    // Registered features are tested by bit. The set holds any others,
+    // which only someone asking by ID could look for.
+    FeatureBitset features_;
+    std::unordered_set<uint256, hardened_hash<>> unknown_;
     std::optional<uint256> digest_;
     std::unordered_set<uint256, beast::uhash<>> const& presets_;
 
+    void
+    add(uint256 const& feature)
+    {
+        if (auto const index = findFeatureBitsetIndex(feature))
+            features_.set(*index);
+        else
+            unknown_.insert(feature);
+    }
+
+    void
+    addImplied()
+    {
+        // The functionality of the "NonFungibleTokensV1_1" amendment is
+        // precisely the functionality of the following three amendments
+        // so if their status is ever queried individually, they are
+        // reported as enabled to simplify the checking elsewhere.
+        if (enabled(featureNonFungibleTokensV1_1.index()))
+        {
+            features_.set(featureNonFungibleTokensV1.index());
+            features_.set(fixNFTokenNegOffer.index());
+            features_.set(fixNFTokenDirV1.index());
+        }
+    }
+
 public:
     explicit Impl(std::unordered_set<uint256, beast::uhash<>> const& presets)
         : presets_(presets)
     {
+        for (auto const& feature : presets_)
+            add(feature);
+        addImplied();
     }
 
     Impl(
@@ -41,8 +71,11 @@ public:
         STVector256 const& amendments)
         : digest_(digest), presets_(presets)
     {
-        set_.reserve(amendments.size());
-        set_.insert(amendments.begin(), amendments.end());
+        for (auto const& feature : presets_)
+            add(feature);
+        for (auto const& feature : amendments)
+            add(feature);
+        addImplied();
     }
 
     std::unordered_set<uint256, beast::uhash<>> const&
@@ -51,12 +84,18 @@ public:
         return presets_;
     }
 
+    bool
+    enabled(std::size_t index) const
+    {
+        return features_.test(index);
+    }
+
     bool
     enabled(uint256 const& feature) const
     {
-        if (presets_.count(feature) > 0)
-            return true;
-        return set_.count(feature) > 0;
+        if (auto const index = findFeatureBitsetIndex(feature))
+            return enabled(*index);
+        return unknown_.count(feature) > 0;
     }
 
     bool
@@ -94,21 +133,16 @@ bool
 Rules::enabled(uint256 const& feature) const
 {
     assert(impl_);
-
-    // The functionality of the "NonFungibleTokensV1_1" amendment is
-    // precisely the functionality of the following three amendments
-    // so if their status is ever queried individually, we inject an
-    // extra check here to simplify the checking elsewhere.
-    if (feature == featureNonFungibleTokensV1 ||
-        feature == fixNFTokenNegOffer || feature == fixNFTokenDirV1)
-    {
-        if (impl_->enabled(featureNonFungibleTokensV1_1))
-            return true;
-    }
-
     return impl_->enabled(feature);
 }
 
+bool
+Rules::enabled(RegisteredFeature const& feature) const
+{
+    assert(impl_);
+    return impl_->enabled(feature.index());
+}
+
 bool
 Rules::operator==(Rules const& other) const
 {
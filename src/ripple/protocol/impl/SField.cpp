@@ -29,6 +29,7 @@ namespace ripple {
 SField::IsSigning const SField::notSigning;
 int SField::num = 0;
 std::map<int, SField const*> SField::knownCodeToField;
+std::unordered_map<std::string_view, SField const*> SField::knownNameToField;
 
 // Give only this translation unit permission to construct SFields
 struct SField::private_access_tag_t
@@ -446,6 +447,8 @@ SField::SField(
     , jsonName(fieldName.c_str())
 {
     knownCodeToField[fieldCode] = this;
+    if (!fieldName.empty())
+        knownNameToField.emplace(fieldName, this);
 }
 
 SField::SField(private_access_tag_t, int fc)
@@ -491,11 +494,11 @@ SField::compare(SField const& f1, SField const& f2)
 SField const&
 SField::getField(std::string const& fieldName)
 {
-    for (auto const& [_, f] : knownCodeToField)
+    auto it = knownNameToField.find(fieldName);
+
+    if (it != knownNameToField.end())
     {
-        (void)_;
-        if (f->fieldName == fieldName)
-            return *f;
+        return *(it->second);
     }
     return sfInvalid;
 }
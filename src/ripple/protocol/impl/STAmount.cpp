@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <ripple/basics/Log.h>
+#include <ripple/basics/MathUtilities.h>
 #include <ripple/basics/contract.h>
 #include <ripple/basics/safe_cast.h>
 #include <ripple/beast/core/LexicalCast.h>
@@ -26,12 +27,20 @@
 #include <ripple/protocol/UintTypes.h>
 #include <ripple/protocol/jss.h>
 #include <boost/algorithm/string.hpp>
-#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/predef.h>
 #include <boost/regex.hpp>
 #include <iostream>
 #include <iterator>
 #include <memory>
 
+// BOOST_COMP_MSVC is always defined, as zero for other compilers
+#if BOOST_COMP_MSVC
+#include <boost/multiprecision/cpp_int.hpp>
+using uint128_t = boost::multiprecision::uint128_t;
+#else   // !BOOST_COMP_MSVC
+using uint128_t = __uint128_t;
+#endif  // !BOOST_COMP_MSVC
+
 namespace ripple {
 
 namespace {
@@ -61,6 +70,11 @@ static const std::uint64_t tenTo14 = 100000000000000ull;
 static const std::uint64_t tenTo14m1 = tenTo14 - 1;
 static const std::uint64_t tenTo17 = tenTo14 * 1000;
 
+// The number of decimal digits in the mantissa of every IOU amount other
+// than zero.
+static constexpr int mantissaDigits = 16;
+static_assert(powersOfTen[mantissaDigits - 1] == STAmount::cMinValue);
+
 //------------------------------------------------------------------------------
 static std::int64_t
 getSNValue(STAmount const& amount)
@@ -755,10 +769,12 @@ STAmount::canonicalize()
         }
         else
         {
-            while (mOffset < 0)
+            if (mOffset < 0)
             {
-                mValue /= 10;
-                ++mOffset;
+                // One division truncates the same as dividing by ten again
+                // and again.
+                mValue /= powersOfTen[-mOffset];
+                mOffset = 0;
             }
 
             while (mOffset > 0)
@@ -797,11 +813,7 @@ STAmount::canonicalize()
         return;
     }
 
-    while ((mValue < cMinValue) && (mOffset > cMinOffset))
-    {
-        mValue *= 10;
-        --mOffset;
-    }
+    scaleToDigits(mValue, mOffset, mantissaDigits, cMinOffset);
 
     while (mValue > cMaxValue)
     {
@@ -1121,9 +1133,7 @@ muldiv(
     std::uint64_t multiplicand,
     std::uint64_t divisor)
 {
-    boost::multiprecision::uint128_t ret;
-
-    boost::multiprecision::multiply(ret, multiplier, multiplicand);
+    uint128_t ret = uint128_t(multiplier) * uint128_t(multiplicand);
     ret /= divisor;
 
     if (ret > std::numeric_limits<std::uint64_t>::max())
@@ -1143,9 +1153,7 @@ muldiv_round(
     std::uint64_t divisor,
     std::uint64_t rounding)
 {
-    boost::multiprecision::uint128_t ret;
-
-    boost::multiprecision::multiply(ret, multiplier, multiplicand);
+    uint128_t ret = uint128_t(multiplier) * uint128_t(multiplicand);
     ret += rounding;
     ret /= divisor;
 
@@ -1175,23 +1183,10 @@ divide(STAmount const& num, STAmount const& den, Issue const& issue)
     int denOffset = den.exponent();
 
     if (num.native())
-    {
-        while (numVal < STAmount::cMinValue)
-        {
-            // Need to bring into range
-            numVal *= 10;
-            --numOffset;
-        }
-    }
+        scaleToDigits(numVal, numOffset, mantissaDigits);
 
     if (den.native())
-    {
-        while (denVal < STAmount::cMinValue)
-        {
-            denVal *= 10;
-            --denOffset;
-        }
-    }
+        scaleToDigits(denVal, denOffset, mantissaDigits);
 
     // We divide the two mantissas (each is between 10^15
     // and 10^16). To maintain precision, we multiply the
@@ -1236,22 +1231,10 @@ multiply(STAmount const& v1, STAmount const& v2, Issue const& issue)
     int offset2 = v2.exponent();
 
     if (v1.native())
-    {
-        while (value1 < STAmount::cMinValue)
-        {
-            value1 *= 10;
-            --offset1;
-        }
-    }
+        scaleToDigits(value1, offset1, mantissaDigits);
 
     if (v2.native())
-    {
-        while (value2 < STAmount::cMinValue)
-        {
-            value2 *= 10;
-            --offset2;
-        }
-    }
+        scaleToDigits(value2, offset2, mantissaDigits);
 
     // We multiply the two mantissas (each is between 10^15
     // and 10^16), so their product is in the 10^30 to 10^32
@@ -1291,14 +1274,13 @@ canonicalizeRound(bool native, std::uint64_t& value, int& offset, bool)
     {
         if (offset < 0)
         {
-            int loops = 0;
-
-            while (offset < -1)
-            {
-                value /= 10;
-                ++offset;
-                ++loops;
-            }
+            // Divide by ten until the offset is -1, all at once since that
+            // truncates the same way.
+            int const loops = -1 - offset;
+            value = loops < std::ssize(powersOfTen)
+                ? value / powersOfTen[loops]
+                : 0;
+            offset = -1;
 
             value += (loops >= 2) ? 9 : 10;  // add before last divide
             value /= 10;
@@ -1334,18 +1316,22 @@ canonicalizeRoundStrict(
     {
         if (offset < 0)
         {
+            // Divide by ten until the offset is -1, all at once since that
+            // truncates the same way and leaves a remainder if any of the
+            // divisions would have.
+            int const loops = -1 - offset;
             bool hadRemainder = false;
-
-            while (offset < -1)
+            if (loops >= std::ssize(powersOfTen))
+            {
+                hadRemainder = value != 0;
+                value = 0;
+            }
+            else
             {
-                // It would be better to use std::lldiv than to separately
-                // compute the remainder.  But std::lldiv does not support
-                // unsigned arguments.
-                std::uint64_t const newValue = value / 10;
-                hadRemainder |= (value != (newValue * 10));
-                value = newValue;
-                ++offset;
+                hadRemainder = value % powersOfTen[loops] != 0;
+                value /= powersOfTen[loops];
             }
+            offset = -1;
             value +=
                 (hadRemainder && roundUp) ? 10 : 9;  // Add before last divide
             value /= 10;
@@ -1443,22 +1429,10 @@ mulRoundImpl(
     int offset1 = v1.exponent(), offset2 = v2.exponent();
 
     if (v1.native())
-    {
-        while (value1 < STAmount::cMinValue)
-        {
-            value1 *= 10;
-            --offset1;
-        }
-    }
+        scaleToDigits(value1, offset1, mantissaDigits);
 
     if (v2.native())
-    {
-        while (value2 < STAmount::cMinValue)
-        {
-            value2 *= 10;
-            --offset2;
-        }
-    }
+        scaleToDigits(value2, offset2, mantissaDigits);
 
     bool const resultNegative = v1.negative() != v2.negative();
 
@@ -1546,22 +1520,10 @@ divRoundImpl(
     int numOffset = num.exponent(), denOffset = den.exponent();
 
     if (num.native())
-    {
-        while (numVal < STAmount::cMinValue)
-        {
-            numVal *= 10;
-            --numOffset;
-        }
-    }
+        scaleToDigits(numVal, numOffset, mantissaDigits);
 
     if (den.native())
-    {
-        while (denVal < STAmount::cMinValue)
-        {
-            denVal *= 10;
-            --denOffset;
-        }
-    }
+        scaleToDigits(denVal, denOffset, mantissaDigits);
 
     bool const resultNegative = (num.negative() != den.negative());
 
@@ -26,6 +26,7 @@
 #include <ripple/protocol/jss.h>
 #include <boost/format.hpp>
 #include <limits>
+#include <utility>
 
 namespace ripple {
 
@@ -42,6 +43,7 @@ STLedgerEntry::STLedgerEntry(Keylet const& k)
     set(format->getSOTemplate());
 
     setFieldU16(sfLedgerEntryType, static_cast<std::uint16_t>(type_));
+    recount();
 }
 
 STLedgerEntry::STLedgerEntry(SerialIter& sit, uint256 const& index)
@@ -49,12 +51,62 @@ STLedgerEntry::STLedgerEntry(SerialIter& sit, uint256 const& index)
 {
     set(sit);
     setSLEType();
+    recount();
 }
 
 STLedgerEntry::STLedgerEntry(STObject const& object, uint256 const& index)
     : STObject(object), key_(index)
 {
     setSLEType();
+    recount();
+}
+
+STLedgerEntry::STLedgerEntry(STLedgerEntry const& other)
+    : STObject(other)
+    , CountedObject<STLedgerEntry>(other)
+    , key_(other.key_)
+    , type_(other.type_)
+{
+    recount();
+}
+
+STLedgerEntry::STLedgerEntry(STLedgerEntry&& other)
+    : STObject(std::move(other))
+    , CountedObject<STLedgerEntry>(other)
+    , key_(other.key_)
+    , type_(other.type_)
+    , countedBytes_(std::exchange(other.countedBytes_, 0))
+{
+    recount();
+}
+
+STLedgerEntry::~STLedgerEntry()
+{
+    CountedObject<STLedgerEntry>::countBytes(
+        -static_cast<std::ptrdiff_t>(countedBytes_));
+}
+
+STLedgerEntry&
+STLedgerEntry::operator=(STLedgerEntry const& other)
+{
+    STObject::operator=(other);
+    key_ = other.key_;
+    type_ = other.type_;
+    recount();
+    return *this;
+}
+
+void
+STLedgerEntry::recount()
+{
+    // Fields added to an entry after this are not counted until it is
+    // copied, which is how most modified entries are made.
+    auto const bytes =
+        static_cast<std::uint32_t>(getCount() * sizeof(detail::STVar));
+    CountedObject<STLedgerEntry>::countBytes(
+        static_cast<std::ptrdiff_t>(bytes) -
+        static_cast<std::ptrdiff_t>(countedBytes_));
+    countedBytes_ = bytes;
 }
 
 void
@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <ripple/basics/Log.h>
+#include <ripple/protocol/ApplyProfile.h>
 #include <ripple/protocol/Feature.h>
 #include <ripple/protocol/InnerObjectFormats.h>
 #include <ripple/protocol/Rules.h>
@@ -140,24 +141,35 @@ STObject::applyTemplate(const SOTemplate& type)
     };
 
     mType = &type;
+
+    // Find the fields of the template in one pass over the object. A field
+    // the template doesn't have, or a second copy of one it does, is left
+    // over.
+    std::vector<detail::STVar*> found(type.size(), nullptr);
+    std::vector<detail::STVar const*> leftover;
+    for (auto& e : v_)
+    {
+        auto const index = type.getIndex(e.get().getFName());
+        if (index >= 0 && !found[index])
+            found[index] = &e;
+        else
+            leftover.push_back(&e);
+    }
+
     decltype(v_) v;
     v.reserve(type.size());
-    for (auto const& e : type)
+    for (std::size_t i = 0; i < type.size(); ++i)
     {
-        auto const iter =
-            std::find_if(v_.begin(), v_.end(), [&](detail::STVar const& b) {
-                return b.get().getFName() == e.sField();
-            });
-        if (iter != v_.end())
+        auto const& e = *(type.begin() + i);
+        if (auto const field = found[i])
         {
-            if ((e.style() == soeDEFAULT) && iter->get().isDefault())
+            if ((e.style() == soeDEFAULT) && field->get().isDefault())
             {
                 throwFieldErr(
                     e.sField().fieldName,
                     "may not be explicitly set to default.");
             }
-            v.emplace_back(std::move(*iter));
-            v_.erase(iter);
+            v.emplace_back(std::move(*field));
         }
         else
         {
@@ -168,13 +180,13 @@ STObject::applyTemplate(const SOTemplate& type)
             v.emplace_back(detail::nonPresentObject, e.sField());
         }
     }
-    for (auto const& e : v_)
+    for (auto const e : leftover)
     {
         // Anything left over in the object must be discardable
-        if (!e->getFName().isDiscardable())
+        if (!(*e)->getFName().isDiscardable())
         {
             throwFieldErr(
-                e->getFName().getName(), "found in disallowed location.");
+                (*e)->getFName().getName(), "found in disallowed location.");
         }
     }
     // Swap the template matching data in for the old data,
@@ -199,6 +211,11 @@ STObject::set(SerialIter& sit, int depth)
 
     v_.clear();
 
+    // Most objects have a template, which replaces this vector with one of
+    // exactly the right size, so start with room for a typical object
+    // rather than growing it one field at a time.
+    v_.reserve(std::min<std::size_t>(sit.getBytesLeft() / 2, 16));
+
     // Consume data in the pipe until we run out or reach the end
     while (!sit.empty())
     {
@@ -354,24 +371,26 @@ STObject::isEquivalent(const STBase& t) const
 uint256
 STObject::getHash(HashPrefix prefix) const
 {
-    Serializer s;
-    s.add32(prefix);
-    add(s, withAllFields);
-    return s.getSHA512Half();
+    ScratchSerializer s;
+    s->add32(prefix);
+    add(*s, withAllFields);
+    return s->getSHA512Half();
 }
 
 uint256
 STObject::getSigningHash(HashPrefix prefix) const
 {
-    Serializer s;
-    s.add32(prefix);
-    add(s, omitSigningFields);
-    return s.getSHA512Half();
+    ScratchSerializer s;
+    s->add32(prefix);
+    add(*s, omitSigningFields);
+    return s->getSHA512Half();
 }
 
 int
 STObject::getFieldIndex(SField const& field) const
 {
+    applyProfile::countField();
+
     if (mType != nullptr)
         return mType->getIndex(field);
 
@@ -466,7 +485,7 @@ STObject::peekFieldArray(SField const& field)
 bool
 STObject::setFlag(std::uint32_t f)
 {
-    STUInt32* t = dynamic_cast<STUInt32*>(getPField(sfFlags, true));
+    STUInt32* t = detail::fieldCast<STUInt32>(getPField(sfFlags, true));
 
     if (!t)
         return false;
@@ -478,7 +497,7 @@ STObject::setFlag(std::uint32_t f)
 bool
 STObject::clearFlag(std::uint32_t f)
 {
-    STUInt32* t = dynamic_cast<STUInt32*>(getPField(sfFlags));
+    STUInt32* t = detail::fieldCast<STUInt32>(getPField(sfFlags));
 
     if (!t)
         return false;
@@ -496,7 +515,8 @@ STObject::isFlag(std::uint32_t f) const
 std::uint32_t
 STObject::getFlags(void) const
 {
-    const STUInt32* t = dynamic_cast<const STUInt32*>(peekAtPField(sfFlags));
+    const STUInt32* t =
+        detail::fieldCast<STUInt32 const>(peekAtPField(sfFlags));
 
     if (!t)
         return 0;
@@ -823,8 +843,7 @@ STObject::add(Serializer& s, WhichFields whichFields) const
 {
     // Depending on whichFields, signing fields are either serialized or
     // not.  Then fields are added to the Serializer sorted by fieldCode.
-    std::vector<STBase const*> const fields{
-        getSortedFields(*this, whichFields)};
+    SortedFields const fields{getSortedFields(*this, whichFields)};
 
     // insert sorted
     for (STBase const* const field : fields)
@@ -843,10 +862,10 @@ STObject::add(Serializer& s, WhichFields whichFields) const
     }
 }
 
-std::vector<STBase const*>
+STObject::SortedFields
 STObject::getSortedFields(STObject const& objToSort, WhichFields whichFields)
 {
-    std::vector<STBase const*> sf;
+    SortedFields sf;
     sf.reserve(objToSort.getCount());
 
     // Choose the fields that we need to sort.
@@ -193,20 +193,13 @@ static std::optional<detail::STVar>
 parseLeaf(
     std::string const& json_name,
     std::string const& fieldName,
+    SField const& field,
     SField const* name,
     Json::Value const& value,
     Json::Value& error)
 {
     std::optional<detail::STVar> ret;
 
-    auto const& field = SField::getField(fieldName);
-
-    if (field == sfInvalid)
-    {
-        error = unknown_field(json_name, fieldName);
-        return ret;
-    }
-
     switch (field.fieldType)
     {
         case STI_UINT8:
@@ -816,9 +809,10 @@ parseObject(
     {
         STObject data(inName);
 
-        for (auto const& fieldName : json.getMemberNames())
+        for (auto it = json.begin(); it != json.end(); ++it)
         {
-            Json::Value const& value = json[fieldName];
+            std::string const fieldName = it.memberName();
+            Json::Value const& value = *it;
 
             auto const& field = SField::getField(fieldName);
 
@@ -885,8 +879,8 @@ parseObject(
 
                 // Everything else (types that don't recurse).
                 default: {
-                    auto leaf =
-                        parseLeaf(json_name, fieldName, &inName, value, error);
+                    auto leaf = parseLeaf(
+                        json_name, fieldName, field, &inName, value, error);
 
                     if (!leaf)
                         return std::nullopt;
@@ -951,11 +945,8 @@ parseArray(
                 return std::nullopt;
             }
 
-            // TODO: There doesn't seem to be a nice way to get just the
-            // first/only key in an object without copying all keys into
-            // a vector
-            std::string const objectName(json[i].getMemberNames()[0]);
-            ;
+            auto const member = json[i].begin();
+            std::string const objectName(member.memberName());
             auto const& nameField(SField::getField(objectName));
 
             if (nameField == sfInvalid)
@@ -964,7 +955,7 @@ parseArray(
                 return std::nullopt;
             }
 
-            Json::Value const objectFields(json[i][objectName]);
+            Json::Value const& objectFields(*member);
 
             std::stringstream ss;
             ss << json_name << "."
@@ -32,11 +32,13 @@
 #include <ripple/protocol/Sign.h>
 #include <ripple/protocol/TxFlags.h>
 #include <ripple/protocol/UintTypes.h>
+#include <ripple/protocol/digest.h>
 #include <ripple/protocol/jss.h>
 #include <boost/format.hpp>
 
 #include <array>
 #include <memory>
+#include <optional>
 #include <type_traits>
 #include <utility>
 
@@ -152,12 +154,18 @@ STTx::getMentionedAccounts() const
     return list;
 }
 
+static void
+addSigningData(STTx const& that, Serializer& s)
+{
+    s.add32(HashPrefix::txSign);
+    that.addWithoutSigningFields(s);
+}
+
 static Blob
 getSigningData(STTx const& that)
 {
     Serializer s;
-    s.add32(HashPrefix::txSign);
-    that.addWithoutSigningFields(s);
+    addSigningData(that, s);
     return s.getData();
 }
 
@@ -198,9 +206,10 @@ STTx::getSeqProxy() const
 void
 STTx::sign(PublicKey const& publicKey, SecretKey const& secretKey)
 {
-    auto const data = getSigningData(*this);
+    ScratchSerializer data;
+    addSigningData(*this, *data);
 
-    auto const sig = ripple::sign(publicKey, secretKey, makeSlice(data));
+    auto const sig = ripple::sign(publicKey, secretKey, data->slice());
 
     setFieldVL(sfTxnSignature, sig);
     tid_ = getHash(HashPrefix::transactionID);
@@ -326,11 +335,12 @@ STTx::checkSingleSign(RequireFullyCanonicalSig requireCanonicalSig) const
         if (publicKeyType(makeSlice(spk)))
         {
             Blob const signature = getFieldVL(sfTxnSignature);
-            Blob const data = getSigningData(*this);
+            ScratchSerializer data;
+            addSigningData(*this, *data);
 
             validSig = verify(
                 PublicKey(makeSlice(spk)),
-                makeSlice(data),
+                data->slice(),
                 makeSlice(signature),
                 fullyCanonical);
         }
@@ -368,10 +378,14 @@ STTx::checkMultiSign(
         signers.size() > maxMultiSigners(&rules))
         return Unexpected("Invalid Signers array size.");
 
-    // We can ease the computational load inside the loop a bit by
-    // pre-constructing part of the data that we hash.  Fill a Serializer
-    // with the stuff that stays constant from signature to signature.
+    // The signing data of each signer is the same large prefix followed
+    // by the signer's account. Build and hash the prefix once: secp256k1
+    // signers only hash their account into a copy of the hash state.
+    // Ed25519 signs the whole message, so those signers each get a copy
+    // of it.
     Serializer const dataStart{startMultiSigningData(*this)};
+    sha512_half_hasher prefixHasher;
+    prefixHasher(dataStart.data(), dataStart.size());
 
     // We also use the sfAccount field inside the loop.  Get it once.
     auto const txnAccountID = getAccountID(sfAccount);
@@ -406,19 +420,27 @@ STTx::checkMultiSign(
         bool validSig = false;
         try
         {
-            Serializer s = dataStart;
-            finishMultiSigningData(accountID, s);
+            auto const spk = signer.getFieldVL(sfSigningPubKey);
+            auto const type = publicKeyType(makeSlice(spk));
 
-            auto spk = signer.getFieldVL(sfSigningPubKey);
-
-            if (publicKeyType(makeSlice(spk)))
+            if (type == KeyType::secp256k1)
             {
-                Blob const signature = signer.getFieldVL(sfTxnSignature);
-
+                auto h = prefixHasher;
+                h(accountID.data(), accountID.size());
+                validSig = verifyDigest(
+                    PublicKey(makeSlice(spk)),
+                    static_cast<uint256>(h),
+                    makeSlice(signer.getFieldVL(sfTxnSignature)),
+                    fullyCanonical);
+            }
+            else if (type == KeyType::ed25519)
+            {
+                Serializer s = dataStart;
+                finishMultiSigningData(accountID, s);
                 validSig = verify(
                     PublicKey(makeSlice(spk)),
                     s.slice(),
-                    makeSlice(signature),
+                    makeSlice(signer.getFieldVL(sfTxnSignature)),
                     fullyCanonical);
             }
         }
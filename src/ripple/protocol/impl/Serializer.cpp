@@ -335,6 +335,49 @@ Serializer::decodeVLLength(int b1, int b2, int b3)
 
 //------------------------------------------------------------------------------
 
+namespace {
+
+struct ScratchBuffer
+{
+    // Larger buffers are released rather than kept for reuse
+    static constexpr std::size_t retainLimit = 64 * 1024;
+
+    Serializer buffer{4096};
+    bool lent = false;
+};
+
+thread_local ScratchBuffer scratchBuffer;
+
+}  // namespace
+
+ScratchSerializer::ScratchSerializer()
+{
+    auto& scratch = scratchBuffer;
+    if (scratch.lent)
+    {
+        s_ = &own_.emplace();
+        return;
+    }
+
+    scratch.lent = true;
+    scratch.buffer.erase();
+    s_ = &scratch.buffer;
+}
+
+ScratchSerializer::~ScratchSerializer()
+{
+    if (own_)
+        return;
+
+    auto& scratch = scratchBuffer;
+    assert(s_ == &scratch.buffer && scratch.lent);
+    if (scratch.buffer.modData().capacity() > ScratchBuffer::retainLimit)
+        scratch.buffer = Serializer{4096};
+    scratch.lent = false;
+}
+
+//------------------------------------------------------------------------------
+
 SerialIter::SerialIter(void const* data, std::size_t size) noexcept
     : p_(reinterpret_cast<std::uint8_t const*>(data)), remain_(size)
 {
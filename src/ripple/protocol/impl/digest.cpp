@@ -20,6 +20,8 @@
 #include <ripple/protocol/digest.h>
 #include <openssl/ripemd.h>
 #include <openssl/sha.h>
+#include <cassert>
+#include <cstring>
 #include <type_traits>
 
 namespace ripple {
@@ -103,4 +105,231 @@ openssl_sha256_hasher::operator result_type() noexcept
     return digest;
 }
 
+//------------------------------------------------------------------------------
+
+namespace {
+
+#if (defined(__x86_64__) || defined(_M_X64)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define RIPPLE_SHA512_BATCH_X86 1
+#endif
+
+#ifdef RIPPLE_SHA512_BATCH_X86
+
+// clang-format off
+constexpr std::uint64_t sha512K[80] = {
+    0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f, 0xe9b5dba58189dbbc,
+    0x3956c25bf348b538, 0x59f111f1b605d019, 0x923f82a4af194f9b, 0xab1c5ed5da6d8118,
+    0xd807aa98a3030242, 0x12835b0145706fbe, 0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2,
+    0x72be5d74f27b896f, 0x80deb1fe3b1696b1, 0x9bdc06a725c71235, 0xc19bf174cf692694,
+    0xe49b69c19ef14ad2, 0xefbe4786384f25e3, 0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65,
+    0x2de92c6f592b0275, 0x4a7484aa6ea6e483, 0x5cb0a9dcbd41fbd4, 0x76f988da831153b5,
+    0x983e5152ee66dfab, 0xa831c66d2db43210, 0xb00327c898fb213f, 0xbf597fc7beef0ee4,
+    0xc6e00bf33da88fc2, 0xd5a79147930aa725, 0x06ca6351e003826f, 0x142929670a0e6e70,
+    0x27b70a8546d22ffc, 0x2e1b21385c26c926, 0x4d2c6dfc5ac42aed, 0x53380d139d95b3df,
+    0x650a73548baf63de, 0x766a0abb3c77b2a8, 0x81c2c92e47edaee6, 0x92722c851482353b,
+    0xa2bfe8a14cf10364, 0xa81a664bbc423001, 0xc24b8b70d0f89791, 0xc76c51a30654be30,
+    0xd192e819d6ef5218, 0xd69906245565a910, 0xf40e35855771202a, 0x106aa07032bbd1b8,
+    0x19a4c116b8d2d0c8, 0x1e376c085141ab53, 0x2748774cdf8eeb99, 0x34b0bcb5e19b48a8,
+    0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb, 0x5b9cca4f7763e373, 0x682e6ff3d6b2b8a3,
+    0x748f82ee5defb2fc, 0x78a5636f43172f60, 0x84c87814a1f0ab72, 0x8cc702081a6439ec,
+    0x90befffa23631e28, 0xa4506cebde82bde9, 0xbef9a3f7b2c67915, 0xc67178f2e372532b,
+    0xca273eceea26619c, 0xd186b8c721c0c207, 0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178,
+    0x06f067aa72176fba, 0x0a637dc5a2c898a6, 0x113f9804bef90dae, 0x1b710b35131c471b,
+    0x28db77f523047d84, 0x32caab7b40c72493, 0x3c9ebe0a15c9bebc, 0x431d67c49c100d4c,
+    0x4cc5d4becb3e42b6, 0x597f299cfc657e2a, 0x5fcb6fab3ad6faec, 0x6c44198c4a475817};
+
+constexpr std::uint64_t sha512IV[8] = {
+    0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
+    0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179};
+// clang-format on
+
+// Each element of these vectors holds one 64-bit word of the SHA-512 state
+// for a different message, so that every operation of the round function
+// advances all of the messages at once.
+using lanes4 = std::uint64_t __attribute__((vector_size(32)));
+using lanes8 = std::uint64_t __attribute__((vector_size(64)));
+
+template <class V>
+[[gnu::always_inline]] inline V
+rotr(V x, int n)
+{
+    return (x >> n) | (x << (64 - n));
+}
+
+template <class V>
+[[gnu::always_inline]] inline void
+compressLanes(V* state, std::uint8_t const* const* blocks)
+{
+    constexpr std::size_t lanes = sizeof(V) / sizeof(std::uint64_t);
+
+    V w[16];
+    for (int t = 0; t < 16; ++t)
+    {
+        for (std::size_t lane = 0; lane != lanes; ++lane)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, blocks[lane] + 8 * t, sizeof(word));
+            w[t][lane] = boost::endian::big_to_native(word);
+        }
+    }
+
+    V a = state[0], b = state[1], c = state[2], d = state[3];
+    V e = state[4], f = state[5], g = state[6], h = state[7];
+
+    for (int t = 0; t < 80; ++t)
+    {
+        if (t >= 16)
+        {
+            V const w15 = w[(t - 15) & 15];
+            V const w2 = w[(t - 2) & 15];
+            w[t & 15] += (rotr(w15, 1) ^ rotr(w15, 8) ^ (w15 >> 7)) +
+                w[(t - 7) & 15] + (rotr(w2, 19) ^ rotr(w2, 61) ^ (w2 >> 6));
+        }
+
+        V const t1 = h + (rotr(e, 14) ^ rotr(e, 18) ^ rotr(e, 41)) +
+            ((e & f) ^ (~e & g)) + sha512K[t] + w[t & 15];
+        V const t2 = (rotr(a, 28) ^ rotr(a, 34) ^ rotr(a, 39)) +
+            ((a & b) ^ (a & c) ^ (b & c));
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+template <class V>
+[[gnu::always_inline]] inline void
+hashLanes(
+    std::uint8_t const* const* messages,
+    std::size_t size,
+    uint256* results)
+{
+    constexpr std::size_t lanes = sizeof(V) / sizeof(std::uint64_t);
+    constexpr std::size_t blockSize = 128;
+
+    V state[8];
+    for (int i = 0; i < 8; ++i)
+        state[i] = V{} + sha512IV[i];
+
+    std::uint8_t const* blocks[lanes];
+
+    std::size_t const full = size / blockSize;
+    for (std::size_t n = 0; n != full; ++n)
+    {
+        for (std::size_t lane = 0; lane != lanes; ++lane)
+            blocks[lane] = messages[lane] + n * blockSize;
+        compressLanes(state, blocks);
+    }
+
+    // The final one or two blocks carry what is left of the message, the
+    // 0x80 terminator and the message length in bits as a 128-bit value.
+    std::size_t const rem = size % blockSize;
+    std::size_t const padded =
+        (rem + 17 <= blockSize) ? blockSize : 2 * blockSize;
+
+    std::uint8_t tail[lanes][2 * blockSize];
+    for (std::size_t lane = 0; lane != lanes; ++lane)
+    {
+        auto const p = tail[lane];
+        std::memcpy(p, messages[lane] + full * blockSize, rem);
+        p[rem] = 0x80;
+        std::memset(p + rem + 1, 0, padded - rem - 17);
+        auto const hi = boost::endian::native_to_big(
+            static_cast<std::uint64_t>(size) >> 61);
+        auto const lo = boost::endian::native_to_big(
+            static_cast<std::uint64_t>(size) << 3);
+        std::memcpy(p + padded - 16, &hi, sizeof(hi));
+        std::memcpy(p + padded - 8, &lo, sizeof(lo));
+    }
+
+    for (std::size_t n = 0; n != padded / blockSize; ++n)
+    {
+        for (std::size_t lane = 0; lane != lanes; ++lane)
+            blocks[lane] = tail[lane] + n * blockSize;
+        compressLanes(state, blocks);
+    }
+
+    // SHA512-Half keeps the first four words of the digest
+    for (std::size_t lane = 0; lane != lanes; ++lane)
+    {
+        std::uint64_t digest[4];
+        for (int i = 0; i < 4; ++i)
+            digest[i] = boost::endian::native_to_big(state[i][lane]);
+        results[lane] = uint256::fromVoid(digest);
+    }
+}
+
+[[gnu::target("avx2")]] void
+hashLanesAVX2(
+    std::uint8_t const* const* messages,
+    std::size_t size,
+    uint256* results)
+{
+    hashLanes<lanes4>(messages, size, results);
+}
+
+[[gnu::target("avx512f")]] void
+hashLanesAVX512(
+    std::uint8_t const* const* messages,
+    std::size_t size,
+    uint256* results)
+{
+    hashLanes<lanes8>(messages, size, results);
+}
+
+#endif
+
+}  // namespace
+
+void
+sha512HalfBatch(
+    std::span<std::uint8_t const* const> messages,
+    std::size_t size,
+    std::span<uint256> results)
+{
+    assert(messages.size() == results.size());
+
+    std::size_t const count = messages.size();
+    std::size_t i = 0;
+
+#ifdef RIPPLE_SHA512_BATCH_X86
+    static bool const avx512 = __builtin_cpu_supports("avx512f");
+    static bool const avx2 = __builtin_cpu_supports("avx2");
+
+    if (avx512)
+    {
+        for (; i + 8 <= count; i += 8)
+            hashLanesAVX512(&messages[i], size, &results[i]);
+    }
+
+    if (avx2)
+    {
+        for (; i + 4 <= count; i += 4)
+            hashLanesAVX2(&messages[i], size, &results[i]);
+    }
+#endif
+
+    for (; i != count; ++i)
+    {
+        sha512_half_hasher h;
+        h(messages[i], size);
+        results[i] = static_cast<sha512_half_hasher::result_type>(h);
+    }
+}
+
 }  // namespace ripple
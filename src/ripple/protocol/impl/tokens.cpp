@@ -640,6 +640,41 @@ encodeBase58Token(
     std::span<std::uint8_t const> b58Span(buf.data(), input.size() + 5);
     return detail::b256_to_b58_be(b58Span, out);
 }
+B58Result<std::span<std::uint8_t>>
+encodeBase58Tokens(
+    TokenType type,
+    std::size_t tokenSize,
+    std::span<std::uint8_t const> input,
+    std::span<std::uint8_t> out,
+    std::span<std::size_t> ends)
+{
+    if (tokenSize == 0)
+        return Unexpected(TokenCodecErrc::inputTooSmall);
+
+    auto const count = input.size() / tokenSize;
+    if (count * tokenSize != input.size())
+        return Unexpected(TokenCodecErrc::inputTooSmall);
+    if (ends.size() < count)
+        return Unexpected(TokenCodecErrc::outputTooSmall);
+
+    std::size_t written = 0;
+
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        auto const r = encodeBase58Token(
+            type,
+            input.subspan(i * tokenSize, tokenSize),
+            out.subspan(written));
+        if (!r)
+            return r;
+
+        written += r.value().size();
+        ends[i] = written;
+    }
+
+    return out.subspan(0, written);
+}
+
 // Convert from base 58 to base 256, largest coefficients first
 // The input is encoded in XPRL format, with the token in the first
 // byte and the checksum in the last four bytes.
@@ -0,0 +1,172 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/STArray.h>
+#include <ripple/protocol/STLedgerEntry.h>
+#include <ripple/protocol/STObject.h>
+#include <ripple/protocol/STTx.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/protocol/writeJson.h>
+#include <boost/container/small_vector.hpp>
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace ripple {
+
+namespace {
+
+// A member of an object being written: a field, or a string the object
+// adds to its fields, such as the hash of a transaction.
+struct Member
+{
+    char const* name;
+    STBase const* field;
+    std::string const* text;
+};
+
+void
+writeValue(Json::Writer& writer, STBase const& value, JsonOptions options);
+
+void
+writeObject(
+    Json::Writer& writer,
+    STObject const& object,
+    JsonOptions options,
+    Member const* extra = nullptr)
+{
+    // Json::Value keeps the members of an object sorted by name and the
+    // last one set wins, so do the same.
+    boost::container::small_vector<Member, 32> members;
+    for (auto const& field : object)
+    {
+        if (field.getSType() != STI_NOTPRESENT)
+            members.push_back(
+                {field.getFName().getJsonName().c_str(), &field, nullptr});
+    }
+    if (extra)
+        members.push_back(*extra);
+
+    auto const less = [](Member const& a, Member const& b) {
+        return std::strcmp(a.name, b.name) < 0;
+    };
+    std::stable_sort(members.begin(), members.end(), less);
+
+    writer.startRoot(Json::Writer::object);
+    for (auto it = members.begin(); it != members.end(); ++it)
+    {
+        auto const next = std::next(it);
+        if (next != members.end() && !less(*it, *next))
+            continue;
+        writer.rawSet(it->name);
+        if (it->field)
+            writeValue(writer, *it->field, options);
+        else
+            writer.output(*it->text);
+    }
+    writer.finish();
+}
+
+void
+writeArray(Json::Writer& writer, STArray const& array, JsonOptions options)
+{
+    writer.startRoot(Json::Writer::array);
+    for (auto const& object : array)
+    {
+        if (object.getSType() == STI_NOTPRESENT)
+            continue;
+        writer.rawAppend();
+        writer.startRoot(Json::Writer::object);
+        writer.rawSet(object.getFName().getJsonName().c_str());
+        writeObject(writer, object, options);
+        writer.finish();
+    }
+    writer.finish();
+}
+
+void
+writeAmount(Json::Writer& writer, STAmount const& amount)
+{
+    if (amount.native())
+    {
+        writer.output(amount.getText());
+        return;
+    }
+
+    writer.startRoot(Json::Writer::object);
+    writer.rawSet(jss::currency.c_str());
+    writer.output(to_string(amount.getCurrency()));
+    writer.rawSet(jss::issuer.c_str());
+    writer.output(to_string(amount.getIssuer()));
+    writer.rawSet(jss::value.c_str());
+    writer.output(amount.getText());
+    writer.finish();
+}
+
+void
+writeValue(Json::Writer& writer, STBase const& value, JsonOptions options)
+{
+    switch (value.getSType())
+    {
+        case STI_OBJECT:
+            writeObject(
+                writer, static_cast<STObject const&>(value), options);
+            break;
+        case STI_ARRAY:
+            writeArray(writer, static_cast<STArray const&>(value), options);
+            break;
+        case STI_AMOUNT:
+            writeAmount(writer, static_cast<STAmount const&>(value));
+            break;
+        default:
+            writer.output(value.getJson(options));
+            break;
+    }
+}
+
+}  // namespace
+
+void
+writeJson(Json::Writer& writer, STBase const& value, JsonOptions options)
+{
+    writeValue(writer, value, options);
+}
+
+void
+writeJson(Json::Writer& writer, STLedgerEntry const& sle, JsonOptions options)
+{
+    auto const index = to_string(sle.key());
+    Member const extra{jss::index.c_str(), nullptr, &index};
+    writeObject(writer, sle, options, &extra);
+}
+
+void
+writeJson(Json::Writer& writer, STTx const& tx, JsonOptions options)
+{
+    // Like STTx::getJson, the fields are written without the options.
+    if (options & JsonOptions::disable_API_prior_V2)
+        return writeObject(writer, tx, JsonOptions::none);
+
+    auto const hash = to_string(tx.getTransactionID());
+    Member const extra{jss::hash.c_str(), nullptr, &hash};
+    writeObject(writer, tx, JsonOptions::none, &extra);
+}
+
+}  // namespace ripple
@@ -41,6 +41,8 @@ namespace jss {
    error: Common properties of RPC error responses.
 */
 
+JSS(AID_size);             // out: GetCounts
+JSS(AID_hit_rate);         // out: GetCounts
 JSS(AL_size);              // out: GetCounts
 JSS(AL_hit_rate);          // out: GetCounts
 JSS(Account);              // in: TransactionSign; field.
@@ -185,9 +187,12 @@ JSS(accounts);                  // in: LedgerEntry, Subscribe,
 JSS(accounts_proposed);         // in: Subscribe, Unsubscribe
 JSS(action);
 JSS(acquiring);                   // out: LedgerRequest
+JSS(active);                      // out: HeapProfile
 JSS(address);                     // out: PeerImp
 JSS(affected);                    // out: AcceptedLedgerTx
 JSS(age);                         // out: NetworkOPs, Peers
+JSS(allocated);                   // out: HeapProfile
+JSS(allocator);                   // out: HeapProfile
 JSS(alternatives);                // out: PathRequest, RipplePathFind
 JSS(amendment_blocked);           // out: NetworkOPs
 JSS(amendments);                  // in: AccountObjects, out: NetworkOPs
@@ -198,6 +203,8 @@ JSS(amount2);                     // out: amm_info
 JSS(api_version);                 // in: many, out: Version
 JSS(api_version_low);             // out: Version
 JSS(applied);                     // out: SubmitTransaction
+JSS(arena);                       // out: HeapProfile
+JSS(arenas);                      // out: HeapProfile
 JSS(asks);                        // out: Subscribe
 JSS(asset);                       // in: amm_info
 JSS(asset2);                      // in: amm_info
@@ -232,8 +239,12 @@ JSS(both_sides);                  // in: Subscribe, Unsubscribe
 JSS(broadcast);                   // out: SubmitTransaction
 JSS(bridge);                      // in: LedgerEntry
 JSS(bridge_account);              // in: LedgerEntry
+JSS(budget);                      // out: GetCounts
 JSS(build_path);                  // in: TransactionSign
 JSS(build_version);               // out: NetworkOPs
+JSS(bytes);                       // out: GetCounts
+JSS(cache_budget);                // out: GetCounts
+JSS(caches);                      // out: GetCounts
 JSS(cancel_after);                // out: AccountChannels
 JSS(can_delete);                  // out: CanDelete
 JSS(changes);                     // out: BookChanges
@@ -241,6 +252,7 @@ JSS(channel_id);                  // out: AccountChannels
 JSS(channels);                    // out: AccountChannels
 JSS(check);                       // in: AccountObjects
 JSS(check_nodes);                 // in: LedgerCleaner
+JSS(checkouts);                   // out: PerfLog
 JSS(clear);                       // in/out: FetchInfo
 JSS(close);                       // out: BookChanges
 JSS(close_flags);                 // out: LedgerToJson
@@ -262,11 +274,15 @@ JSS(complete);                    // out: NetworkOPs, InboundLedger
 JSS(complete_ledgers);            // out: NetworkOPs, PeerImp
 JSS(complete_shards);             // out: OverlayImpl, PeerImp
 JSS(consensus);                   // out: NetworkOPs, LedgerConsensus
+JSS(consumers);                   // out: ResourceUsage
 JSS(converge_time);               // out: NetworkOPs
 JSS(converge_time_s);             // out: NetworkOPs
 JSS(cookie);                      // out: NetworkOPs
+JSS(copied_ledger);               // out: NetworkOPs
+JSS(copies);                      // out: ApplyProfile
 JSS(count);                       // in: AccountTx*, ValidatorList
 JSS(counters);                    // in/out: retrieve counters
+JSS(cpu_duration_us);             // out: ResourceUsage, Peers
 JSS(ctid);                        // in/out: Tx RPC
 JSS(currency_a);                  // out: BookChanges
 JSS(currency_b);                  // out: BookChanges
@@ -284,6 +300,7 @@ JSS(date);                    // out: tx/Transaction, NetworkOPs
 JSS(dbKBLedger);              // out: getCounts
 JSS(dbKBTotal);               // out: getCounts
 JSS(dbKBTransaction);         // out: getCounts
+JSS(db_readers);              // out: PerfLog
 JSS(debug_signing);           // in: TransactionSign
 JSS(deletion_blockers_only);  // in: AccountObjects
 JSS(delivered_amount);        // out: insertDeliveredAmount
@@ -305,17 +322,22 @@ JSS(dir_entry);               // out: DirectoryEntryIterator
 JSS(dir_index);               // out: DirectoryEntryIterator
 JSS(dir_root);                // out: DirectoryEntryIterator
 JSS(directory);               // in: LedgerEntry
+JSS(dirty);                   // out: HeapProfile
 JSS(discounted_fee);          // out: amm_info
 JSS(domain);                  // out: ValidatorInfo, Manifest
 JSS(drops);                   // out: TxQ
+JSS(dump);                    // in: HeapProfile
+JSS(dumped);                  // out: HeapProfile
 JSS(duration_us);             // out: NetworkOPs
 JSS(effective);               // out: ValidatorList
                               // in: UNL
-JSS(enabled);                 // out: AmendmentTable
+JSS(enable);                  // in: Trace
+JSS(enabled);                 // out: AmendmentTable, Trace
 JSS(engine_result);           // out: NetworkOPs, TransactionSign, Submit
 JSS(engine_result_code);      // out: NetworkOPs, TransactionSign, Submit
 JSS(engine_result_message);   // out: NetworkOPs, TransactionSign, Submit
 JSS(entire_set);              // out: get_aggregate_price
+JSS(entries);                 // out: GetCounts
 JSS(ephemeral_key);           // out: ValidatorInfo
                               // in/out: Manifest
 JSS(error);                   // out: error
@@ -341,6 +363,7 @@ JSS(fee_level);             // out: AccountInfo
 JSS(fee_mult_max);          // in: TransactionSign
 JSS(fee_ref);               // out: NetworkOPs, DEPRECATED
 JSS(fetch_pack);            // out: NetworkOPs
+JSS(field_lookups);         // out: ApplyProfile
 JSS(FIELDS);                // out: RPC server_definitions
                             // matches definitions.json format
 JSS(first);                 // out: rpc/Version
@@ -351,6 +374,7 @@ JSS(fix_txns);              // in: LedgerCleaner
 JSS(flags);                 // out: AccountOffers,
                             //      NetworkOPs
 JSS(forward);               // in: AccountTx
+JSS(free);                  // out: HeapProfile
 JSS(freeze);                // out: AccountLines
 JSS(freeze_peer);           // out: AccountLines
 JSS(frozen_balances);       // out: GatewayBalances
@@ -368,12 +392,14 @@ JSS(high);                  // out: BookChanges
 JSS(highest_sequence);      // out: AccountInfo
 JSS(highest_ticket);        // out: AccountInfo
 JSS(historical_perminute);  // historical_perminute.
+JSS(hit_rate);              // out: GetCounts
 JSS(hostid);                // out: NetworkOPs
 JSS(hotwallet);             // in: GatewayBalances
 JSS(id);                    // websocket.
 JSS(ident);                 // in: AccountCurrencies, AccountInfo,
                             //     OwnerInfo
 JSS(ignore_default);        // in: AccountLines
+JSS(in_use);                // out: GetCounts
 JSS(inLedger);              // out: tx/Transaction
 JSS(inbound);               // out: PeerImp
 JSS(index);                 // in: LedgerEntry, DownloadShard
@@ -381,7 +407,9 @@ JSS(index);                 // in: LedgerEntry, DownloadShard
                             //      LedgerEntry, TxHistory, LedgerData
 JSS(info);                  // out: ServerInfo, ConsensusInfo, FetchInfo
 JSS(initial_sync_duration_us);
+JSS(inserts);              // out: ApplyProfile
 JSS(internal_command);     // in: Internal
+JSS(inventory);            // out: PeerImp
 JSS(invalid_API_version);  // out: Many, when a request has an invalid
                            //      version
 JSS(io_latency_ms);        // out: NetworkOPs
@@ -396,8 +424,10 @@ JSS(isVLEncoded);          // out: RPC server_definitions
 JSS(issuer);               // in: RipplePathFind, Subscribe,
                            //     Unsubscribe, BookOffers
                            // out: STPathSet, STAmount
+JSS(items);                // out: GetCounts
 JSS(job);
 JSS(job_queue);
+JSS(job_queue_lock);       // out: PerfLog
 JSS(jobs);
 JSS(jsonrpc);                     // json version
 JSS(jq_trans_overflow);           // JobQueue transaction limit overflow.
@@ -412,6 +442,7 @@ JSS(last_close);                  // out: NetworkOPs
 JSS(last_refresh_time);           // out: ValidatorSite
 JSS(last_refresh_status);         // out: ValidatorSite
 JSS(last_refresh_message);        // out: ValidatorSite
+JSS(last_rotated);                // out: NetworkOPs
 JSS(ledger);                      // in: NetworkOPs, LedgerCleaner,
                                   //     RPCHelpers
                                   // out: NetworkOPs, PeerImp
@@ -419,6 +450,7 @@ JSS(ledger_current_index);        // out: NetworkOPs, RPCHelpers,
                                   //      LedgerCurrent, LedgerAccept,
                                   //      AccountLines
 JSS(ledger_data);                 // out: LedgerHeader
+JSS(ledger_entries);              // out: ApplyProfile
 JSS(ledger_hash);                 // in: RPCHelpers, LedgerRequest,
                                   //     RipplePathFind, TransactionEntry,
                                   //     handlers/Ledger
@@ -461,6 +493,7 @@ JSS(lowest_ticket);               // out: AccountInfo
 JSS(lp_token);                    // out: amm_info
 JSS(majority);                    // out: RPC feature
 JSS(manifest);                    // out: ValidatorInfo, Manifest
+JSS(mapped);                      // out: HeapProfile
 JSS(marker);                      // in/out: AccountTx, AccountOffers,
                                   //         AccountLines, AccountObjects,
                                   //         LedgerData
@@ -475,6 +508,7 @@ JSS(max_ledger);                  // in/out: LedgerCleaner
 JSS(max_queue_size);              // out: TxQ
 JSS(max_spend_drops);             // out: AccountInfo
 JSS(max_spend_drops_total);       // out: AccountInfo
+JSS(max_wait_us);                 // out: PerfLog
 JSS(mean);                        // out: get_aggregate_price
 JSS(median);                      // out: get_aggregate_price
 JSS(median_fee);                  // out: TxQ
@@ -492,6 +526,7 @@ JSS(min_ledger);                 // in: LedgerCleaner
 JSS(minimum_fee);                // out: TxQ
 JSS(minimum_level);              // out: TxQ
 JSS(missingCommand);             // error
+JSS(muzzy);                      // out: HeapProfile
 JSS(name);                       // out: AmendmentTableImpl, PeerImp
 JSS(needed_state_hashes);        // out: InboundLedger
 JSS(needed_transaction_hashes);  // out: InboundLedger
@@ -518,18 +553,21 @@ JSS(node_reads_total);           // out: GetCounts
 JSS(node_reads_duration_us);     // out: GetCounts
 JSS(node_size);                  // out: server_info
 JSS(nodestore);                  // out: GetCounts
+JSS(nodes_copied);               // out: NetworkOPs
 JSS(node_writes);                // out: GetCounts
 JSS(node_written_bytes);         // out: GetCounts
 JSS(node_writes_duration_us);    // out: GetCounts
 JSS(node_write_retries);         // out: GetCounts
 JSS(node_writes_delayed);        // out::GetCounts
 JSS(nth);                        // out: RPC server_definitions
+JSS(object_bytes);               // out: GetCounts, PerfLog
 JSS(obligations);                // out: GatewayBalances
 JSS(offer);                      // in: LedgerEntry
 JSS(offers);                     // out: NetworkOPs, AccountOffers, Subscribe
 JSS(offer_id);                   // out: insertNFTokenOfferID
 JSS(offline);                    // in: TransactionSign
 JSS(offset);                     // in/out: AccountTxOld
+JSS(online_delete);              // out: NetworkOPs
 JSS(open);                       // out: handlers/Ledger
 JSS(open_ledger_cost);           // out: SubmitTransaction
 JSS(open_ledger_fee);            // out: TxQ
@@ -537,8 +575,12 @@ JSS(open_ledger_level);          // out: TxQ
 JSS(oracle);                     // in: LedgerEntry
 JSS(oracles);                    // in: get_aggregate_price
 JSS(oracle_document_id);         // in: get_aggregate_price
+JSS(overlay_io_latency_ms);      // out: NetworkOPs
 JSS(owner);                      // in: LedgerEntry, out: NetworkOPs
 JSS(owner_funds);                // in/out: Ledger, NetworkOPs, AcceptedLedgerTx
+JSS(p50_us);                      // out: PerfLog
+JSS(p999_us);                     // out: PerfLog
+JSS(p99_us);                      // out: PerfLog
 JSS(page_index);
 JSS(params);                      // RPC
 JSS(parent_close_time);           // out: LedgerToJson
@@ -550,6 +592,7 @@ JSS(paths);                       // in: RipplePathFind
 JSS(paths_canonical);             // out: RipplePathFind
 JSS(paths_computed);              // out: PathRequest, RipplePathFind
 JSS(payment_channel);             // in: LedgerEntry
+JSS(peeks);                       // out: ApplyProfile
 JSS(peer);                        // in: AccountLines
 JSS(peer_authorized);             // out: AccountLines
 JSS(peer_id);                     // out: RCLCxPeerPos
@@ -562,6 +605,7 @@ JSS(ports);                       // out: NetworkOPs
 JSS(previous);                    // out: Reservations
 JSS(previous_ledger);             // out: LedgerPropose
 JSS(price);                       // out: amm_info, AuctionSlot
+JSS(profiling);                   // out: HeapProfile
 JSS(proof);                       // in: BookOffers
 JSS(propose_seq);                 // out: LedgerPropose
 JSS(proposers);                   // out: NetworkOPs, LedgerConsensus
@@ -576,6 +620,8 @@ JSS(public_key);                  // out: OverlayImpl, PeerImp, WalletPropose,
 JSS(public_key_hex);              // out: WalletPropose
 JSS(published_ledger);            // out: NetworkOPs
 JSS(publisher_lists);             // out: ValidatorList
+JSS(purge);                       // in: HeapProfile
+JSS(purged);                      // out: HeapProfile
 JSS(quality);                     // out: NetworkOPs
 JSS(quality_in);                  // out: AccountLines
 JSS(quality_out);                 // out: AccountLines
@@ -586,11 +632,14 @@ JSS(queued_duration_us);
 JSS(quote_asset);           // in: get_aggregate_price
 JSS(random);                // out: Random
 JSS(raw_meta);              // out: AcceptedLedgerTx
+JSS(reads);                 // out: ApplyProfile
 JSS(receive_currencies);    // out: AccountCurrencies
+JSS(redundancy);            // out: TxRelayFanout
 JSS(reference_level);       // out: TxQ
 JSS(refresh_interval);      // in: UNL
 JSS(refresh_interval_min);  // out: ValidatorSites
 JSS(regular_seed);          // in/out: LedgerEntry
+JSS(relay_percentage);      // out: TxRelayFanout
 JSS(remaining);             // out: ValidatorList
 JSS(remote);                // out: Logic.h
 JSS(request);               // RPC
@@ -600,14 +649,17 @@ JSS(reserve_base);          // out: NetworkOPs
 JSS(reserve_base_xrp);      // out: NetworkOPs
 JSS(reserve_inc);           // out: NetworkOPs
 JSS(reserve_inc_xrp);       // out: NetworkOPs
+JSS(resident);              // out: HeapProfile
 JSS(response);              // websocket
 JSS(result);                // RPC
+JSS(retained);              // out: HeapProfile
 JSS(ripple_lines);          // out: NetworkOPs
 JSS(ripple_state);          // in: LedgerEntr
 JSS(ripplerpc);             // ripple RPC version
 JSS(role);                  // out: Ping.cpp
 JSS(rpc);
 JSS(rt_accounts);  // in: Subscribe, Unsubscribe
+JSS(running);  // out: PerfLog
 JSS(running_duration_us);
 JSS(search_depth);              // in: RipplePathFind
 JSS(searched_all);              // out: Tx
@@ -618,12 +670,15 @@ JSS(seed);                      //
 JSS(seed_hex);                  // in: WalletPropose, TransactionSign
 JSS(send_currencies);           // out: AccountCurrencies
 JSS(send_max);                  // in: PathRequest, RipplePathFind
+JSS(send_queue);                // out: PeerImp
 JSS(seq);                       // in: LedgerEntry;
                                 // out: NetworkOPs, RPCSub, AccountOffers,
                                 //      ValidatorList, ValidatorInfo, Manifest
 JSS(sequence);                  // in: UNL
 JSS(sequence_count);            // out: AccountInfo
+JSS(serialized_bytes);          // out: ApplyProfile
 JSS(server_domain);             // out: NetworkOPs
+JSS(server_io_latency_ms);      // out: NetworkOPs
 JSS(server_state);              // out: NetworkOPs
 JSS(server_state_duration_us);  // out: NetworkOPs
 JSS(server_status);             // out: NetworkOPs
@@ -639,6 +694,7 @@ JSS(signing_time);              // out: NetworkOPs
 JSS(signer_list);               // in: AccountObjects
 JSS(signer_lists);              // in/out: AccountInfo
 JSS(size);                      // out: get_aggregate_price
+JSS(slabs);                     // out: GetCounts
 JSS(snapshot);                  // in: Subscribe
 JSS(source_account);            // in: PathRequest, RipplePathFind
 JSS(source_amount);             // in: PathRequest, RipplePathFind
@@ -655,6 +711,7 @@ JSS(status);                // error
 JSS(stop);                  // in: LedgerCleaner
 JSS(stop_history_tx_only);  // in: Unsubscribe, stop history tx stream
 JSS(storedSeqs);            // out: NodeToShardStatus
+JSS(stream);                // in: LedgerData
 JSS(streams);               // in: Subscribe, Unsubscribe
 JSS(strict);                // in: AccountCurrencies, AccountInfo
 JSS(sub_index);             // in: LedgerEntry
@@ -669,6 +726,9 @@ JSS(taker_gets);            // in: Subscribe, Unsubscribe, BookOffers
 JSS(taker_gets_funded);     // out: NetworkOPs
 JSS(taker_pays);            // in: Subscribe, Unsubscribe, BookOffers
 JSS(taker_pays_funded);     // out: NetworkOPs
+JSS(target_redundancy);     // out: TxRelayFanout
+JSS(target_size);           // out: GetCounts
+JSS(threads);               // out: HeapProfile
 JSS(threshold);             // in: Blacklist
 JSS(ticket);                // in: AccountObjects
 JSS(ticket_count);          // out: AccountInfo
@@ -727,6 +787,7 @@ JSS(txr_selected_cnt);        // out: selected peers count
 JSS(txr_suppressed_cnt);      // out: suppressed peers count
 JSS(txr_not_enabled_cnt);     // out: peers with tx reduce-relay disabled count
 JSS(txr_missing_tx_freq);     // out: missing tx frequency average
+JSS(txr_fanout);              // out: adaptive tx relay fan-out
 JSS(txs);                     // out: TxHistory
 JSS(type);                    // in: AccountObjects
                               // out: NetworkOPs, RPC server_definitions
@@ -765,6 +826,9 @@ JSS(volume_b);                // out: BookChanges
 JSS(vote);                    // in: Feature
 JSS(vote_slots);              // out: amm_info
 JSS(vote_weight);             // out: amm_info
+JSS(wait_us);                 // out: PerfLog
+JSS(waits);                   // out: PerfLog
+JSS(wall_duration_us);        // out: ResourceUsage, Peers
 JSS(warning);                 // rpc:
 JSS(warnings);                // out: server_info, server_state
 JSS(workers);
@@ -109,6 +109,30 @@ decodeBase58Token(
     std::string_view s,
     std::span<std::uint8_t> outBuf);
 
+/** Encode several tokens of the same type and size.
+
+    Meant for writers that emit many tokens in a row, such as AccountIDs
+    in bulk JSON output: the encodings go back to back into one buffer
+    instead of one string each.
+
+    @param type The type of the tokens.
+    @param tokenSize The size of each token.
+    @param input The tokens, back to back; a whole number of them.
+    @param out Receives the encodings, back to back. 64 bytes per token
+               always suffice.
+    @param ends Receives the offset just past each encoding; must have room
+                for one entry per token.
+
+    @return the part of `out` that was written.
+*/
+[[nodiscard]] B58Result<std::span<std::uint8_t>>
+encodeBase58Tokens(
+    TokenType type,
+    std::size_t tokenSize,
+    std::span<std::uint8_t const> input,
+    std::span<std::uint8_t> out,
+    std::span<std::size_t> ends);
+
 // This interface matches the old interface, but requires additional allocation
 [[nodiscard]] std::string
 encodeBase58Token(TokenType type, void const* token, std::size_t size);
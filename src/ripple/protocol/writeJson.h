@@ -0,0 +1,64 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_PROTOCOL_WRITEJSON_H_INCLUDED
+#define RIPPLE_PROTOCOL_WRITEJSON_H_INCLUDED
+
+#include <ripple/json/Output.h>
+#include <ripple/json/Writer.h>
+#include <ripple/protocol/STBase.h>
+
+namespace ripple {
+
+class STLedgerEntry;
+class STTx;
+
+/** Write the JSON form of a serialized value straight to a Json::Writer.
+
+    The text is identical to writing value.getJson(options), but objects,
+    arrays and amounts are written as they are visited instead of first
+    being built into a Json::Value tree. Only the small values of the
+    other field types go through a Json::Value.
+
+    The writer must be ready for a value: at the root, or right after a
+    rawSet or rawAppend.
+*/
+/** @{ */
+void
+writeJson(Json::Writer& writer, STBase const& value, JsonOptions options);
+
+void
+writeJson(Json::Writer& writer, STLedgerEntry const& sle, JsonOptions options);
+
+void
+writeJson(Json::Writer& writer, STTx const& tx, JsonOptions options);
+/** @} */
+
+/** Write the JSON form of a serialized value to an Output. */
+template <class T>
+void
+outputJson(T const& value, Json::Output const& out, JsonOptions options)
+{
+    Json::Writer writer(out);
+    writeJson(writer, value, options);
+}
+
+}  // namespace ripple
+
+#endif
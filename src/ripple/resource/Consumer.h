@@ -23,6 +23,8 @@
 #include <ripple/basics/Log.h>
 #include <ripple/resource/Charge.h>
 #include <ripple/resource/Disposition.h>
+#include <chrono>
+#include <cstdint>
 
 namespace ripple {
 namespace Resource {
@@ -30,6 +32,16 @@ namespace Resource {
 struct Entry;
 class Logic;
 
+/** The time spent doing work on behalf of a consumer. */
+struct Usage
+{
+    std::chrono::microseconds cpu{0};
+    std::chrono::microseconds wall{0};
+
+    // The number of jobs measured
+    std::uint64_t jobs = 0;
+};
+
 /** An endpoint that consumes resources. */
 class Consumer
 {
@@ -69,6 +81,18 @@ public:
     Disposition
     charge(Charge const& fee);
 
+    /** Record the time taken by one job done for the consumer.
+
+        If the resource manager charges measured costs, the CPU time is
+        also charged to the consumer's balance.
+    */
+    Disposition
+    chargeTime(std::chrono::microseconds cpu, std::chrono::microseconds wall);
+
+    /** Returns the time spent on behalf of the consumer. */
+    Usage
+    usage() const;
+
     /** Returns `true` if the consumer should be warned.
         This consumes the warning.
     */
@@ -0,0 +1,74 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_RESOURCE_MEASUREDCOST_H_INCLUDED
+#define RIPPLE_RESOURCE_MEASUREDCOST_H_INCLUDED
+
+#include <ripple/basics/chrono.h>
+#include <ripple/resource/Consumer.h>
+#include <chrono>
+
+namespace ripple {
+namespace Resource {
+
+/** Measures the time taken by a piece of work done for a consumer.
+
+    The time is charged to the consumer when the object is destroyed.
+    Work which may suspend the thread, such as a coroutine, should only
+    measure the wall time: the CPU clock of the thread would include the
+    work of whatever else ran on it.
+*/
+class MeasuredCost
+{
+public:
+    MeasuredCost(Consumer consumer, bool measureCpu = true)
+        : consumer_(std::move(consumer))
+        , measureCpu_(measureCpu)
+        , cpuStart_(measureCpu ? ThreadCpuClock::now()
+                               : ThreadCpuClock::time_point{})
+        , wallStart_(std::chrono::steady_clock::now())
+    {
+    }
+
+    MeasuredCost(MeasuredCost const&) = delete;
+    MeasuredCost&
+    operator=(MeasuredCost const&) = delete;
+
+    ~MeasuredCost()
+    {
+        using namespace std::chrono;
+        auto const cpu = measureCpu_
+            ? duration_cast<microseconds>(ThreadCpuClock::now() - cpuStart_)
+            : microseconds{0};
+        consumer_.chargeTime(
+            cpu,
+            duration_cast<microseconds>(steady_clock::now() - wallStart_));
+    }
+
+private:
+    Consumer consumer_;
+    bool const measureCpu_;
+    ThreadCpuClock::time_point const cpuStart_;
+    std::chrono::steady_clock::time_point const wallStart_;
+};
+
+}  // namespace Resource
+}  // namespace ripple
+
+#endif
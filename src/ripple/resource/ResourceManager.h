@@ -69,6 +69,12 @@ public:
     virtual Json::Value
     getJson(int threshold) = 0;
 
+    /** Report the consumers which have used the most CPU time.
+        @param limit The most consumers to report.
+    */
+    virtual Json::Value
+    getUsageJson(std::size_t limit) = 0;
+
     /** Import packaged consumer information.
         @param origin An identifier that unique labels the origin.
     */
@@ -78,10 +84,15 @@ public:
 
 //------------------------------------------------------------------------------
 
+/** Create a resource manager.
+    @param chargeMeasuredCost Whether the measured CPU time of the jobs done
+                              for a consumer is charged to its balance.
+*/
 std::unique_ptr<Manager>
 make_Manager(
     beast::insight::Collector::ptr const& collector,
-    beast::Journal journal);
+    beast::Journal journal,
+    bool chargeMeasuredCost = false);
 
 }  // namespace Resource
 }  // namespace ripple
@@ -106,6 +106,24 @@ Consumer::charge(Charge const& what)
     return d;
 }
 
+Disposition
+Consumer::chargeTime(
+    std::chrono::microseconds cpu,
+    std::chrono::microseconds wall)
+{
+    if (m_logic && m_entry)
+        return m_logic->chargeTime(*m_entry, cpu, wall);
+    return ok;
+}
+
+Usage
+Consumer::usage() const
+{
+    if (m_logic && m_entry)
+        return m_logic->usage(*m_entry);
+    return {};
+}
+
 bool
 Consumer::warn()
 {
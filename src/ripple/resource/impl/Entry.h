@@ -23,6 +23,7 @@
 #include <ripple/basics/DecayingSample.h>
 #include <ripple/beast/clock/abstract_clock.h>
 #include <ripple/beast/core/List.h>
+#include <ripple/resource/Consumer.h>
 #include <ripple/resource/impl/Key.h>
 #include <ripple/resource/impl/Tuning.h>
 #include <cassert>
@@ -42,7 +43,8 @@ struct Entry : public beast::List<Entry>::Node
        @param now Construction time of Entry.
     */
     explicit Entry(clock_type::time_point const now)
-        : refcount(0)
+        : shard(0)
+        , refcount(0)
         , local_balance(now)
         , remote_balance(0)
         , lastWarningTime()
@@ -85,6 +87,9 @@ struct Entry : public beast::List<Entry>::Node
     // Back pointer to the map key (bit of a hack here)
     Key const* key;
 
+    // Index of the table shard holding this entry
+    std::size_t shard;
+
     // Number of Consumer references
     int refcount;
 
@@ -94,6 +99,9 @@ struct Entry : public beast::List<Entry>::Node
     // Normalized balance contribution from imports
     int remote_balance;
 
+    // Time spent on behalf of this consumer
+    Usage usage;
+
     // Time of the last warning
     clock_type::time_point lastWarningTime;
 
@@ -31,8 +31,12 @@
 #include <ripple/resource/Fees.h>
 #include <ripple/resource/Gossip.h>
 #include <ripple/resource/impl/Import.h>
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <mutex>
+#include <tuple>
+#include <vector>
 
 namespace ripple {
 namespace Resource {
@@ -57,30 +61,45 @@ private:
         beast::insight::Meter drop;
     };
 
-    Stats m_stats;
-    Stopwatch& m_clock;
-    beast::Journal m_journal;
+    // A slice of the table of consumers, selected by the hash of the key.
+    // An Entry never leaves its shard, and is only read or modified while
+    // holding the lock of that shard.
+    struct Shard
+    {
+        std::mutex lock;
+
+        // Table of all entries in this shard
+        Table table;
+
+        // Because the following are intrusive lists, a given Entry may be in
+        // at most list at a given instant.  The Entry must be removed from
+        // one list before placing it in another.
 
-    std::recursive_mutex lock_;
+        // List of all active inbound entries
+        EntryIntrusiveList inbound;
 
-    // Table of all entries
-    Table table_;
+        // List of all active outbound entries
+        EntryIntrusiveList outbound;
 
-    // Because the following are intrusive lists, a given Entry may be in
-    // at most list at a given instant.  The Entry must be removed from
-    // one list before placing it in another.
+        // List of all active admin entries
+        EntryIntrusiveList admin;
 
-    // List of all active inbound entries
-    EntryIntrusiveList inbound_;
+        // List of all inactve entries
+        EntryIntrusiveList inactive;
+    };
+
+    Stats m_stats;
+    Stopwatch& m_clock;
+    beast::Journal m_journal;
 
-    // List of all active outbound entries
-    EntryIntrusiveList outbound_;
+    // Whether the measured CPU time of jobs is charged to balances
+    bool const chargeMeasuredCost_;
 
-    // List of all active admin entries
-    EntryIntrusiveList admin_;
+    std::array<Shard, tableShards> shards_;
 
-    // List of all inactve entries
-    EntryIntrusiveList inactive_;
+    // Protects importTable_. A shard lock may be acquired while holding it,
+    // but never the other way around.
+    std::mutex importLock_;
 
     // All imported gossip data
     Imports importTable_;
@@ -90,8 +109,12 @@ public:
     Logic(
         beast::insight::Collector::ptr const& collector,
         clock_type& clock,
-        beast::Journal journal)
-        : m_stats(collector), m_clock(clock), m_journal(journal)
+        beast::Journal journal,
+        bool chargeMeasuredCost = false)
+        : m_stats(collector)
+        , m_clock(clock)
+        , m_journal(journal)
+        , chargeMeasuredCost_(chargeMeasuredCost)
     {
     }
 
@@ -103,65 +126,28 @@ public:
         // destroyed before the consumer table.
         //
         importTable_.clear();
-        table_.clear();
+        for (auto& shard : shards_)
+            shard.table.clear();
     }
 
     Consumer
     newInboundEndpoint(beast::IP::Endpoint const& address)
     {
-        Entry* entry(nullptr);
+        Entry& entry = newEndpoint(kindInbound, address.at_port(0));
 
-        {
-            std::lock_guard _(lock_);
-            auto [resultIt, resultInserted] = table_.emplace(
-                std::piecewise_construct,
-                std::make_tuple(kindInbound, address.at_port(0)),  // Key
-                std::make_tuple(m_clock.now()));                   // Entry
-
-            entry = &resultIt->second;
-            entry->key = &resultIt->first;
-            ++entry->refcount;
-            if (entry->refcount == 1)
-            {
-                if (!resultInserted)
-                {
-                    inactive_.erase(inactive_.iterator_to(*entry));
-                }
-                inbound_.push_back(*entry);
-            }
-        }
-
-        JLOG(m_journal.debug()) << "New inbound endpoint " << *entry;
+        JLOG(m_journal.debug()) << "New inbound endpoint " << entry;
 
-        return Consumer(*this, *entry);
+        return Consumer(*this, entry);
     }
 
     Consumer
     newOutboundEndpoint(beast::IP::Endpoint const& address)
     {
-        Entry* entry(nullptr);
-
-        {
-            std::lock_guard _(lock_);
-            auto [resultIt, resultInserted] = table_.emplace(
-                std::piecewise_construct,
-                std::make_tuple(kindOutbound, address),  // Key
-                std::make_tuple(m_clock.now()));         // Entry
-
-            entry = &resultIt->second;
-            entry->key = &resultIt->first;
-            ++entry->refcount;
-            if (entry->refcount == 1)
-            {
-                if (!resultInserted)
-                    inactive_.erase(inactive_.iterator_to(*entry));
-                outbound_.push_back(*entry);
-            }
-        }
+        Entry& entry = newEndpoint(kindOutbound, address);
 
-        JLOG(m_journal.debug()) << "New outbound endpoint " << *entry;
+        JLOG(m_journal.debug()) << "New outbound endpoint " << entry;
 
-        return Consumer(*this, *entry);
+        return Consumer(*this, entry);
     }
 
     /**
@@ -172,29 +158,11 @@ public:
     Consumer
     newUnlimitedEndpoint(beast::IP::Endpoint const& address)
     {
-        Entry* entry(nullptr);
+        Entry& entry = newEndpoint(kindUnlimited, address.at_port(1));
 
-        {
-            std::lock_guard _(lock_);
-            auto [resultIt, resultInserted] = table_.emplace(
-                std::piecewise_construct,
-                std::make_tuple(kindUnlimited, address.at_port(1)),  // Key
-                std::make_tuple(m_clock.now()));                     // Entry
-
-            entry = &resultIt->second;
-            entry->key = &resultIt->first;
-            ++entry->refcount;
-            if (entry->refcount == 1)
-            {
-                if (!resultInserted)
-                    inactive_.erase(inactive_.iterator_to(*entry));
-                admin_.push_back(*entry);
-            }
-        }
+        JLOG(m_journal.debug()) << "New unlimited endpoint " << entry;
 
-        JLOG(m_journal.debug()) << "New unlimited endpoint " << *entry;
-
-        return Consumer(*this, *entry);
+        return Consumer(*this, entry);
     }
 
     Json::Value
@@ -210,45 +178,66 @@ public:
         clock_type::time_point const now(m_clock.now());
 
         Json::Value ret(Json::objectValue);
-        std::lock_guard _(lock_);
 
-        for (auto& inboundEntry : inbound_)
+        for (auto& shard : shards_)
         {
-            int localBalance = inboundEntry.local_balance.value(now);
-            if ((localBalance + inboundEntry.remote_balance) >= threshold)
-            {
-                Json::Value& entry =
-                    (ret[inboundEntry.to_string()] = Json::objectValue);
-                entry[jss::local] = localBalance;
-                entry[jss::remote] = inboundEntry.remote_balance;
-                entry[jss::type] = "inbound";
-            }
+            std::lock_guard _(shard.lock);
+            addJson(ret, shard.inbound, "inbound", threshold, now);
+            addJson(ret, shard.outbound, "outbound", threshold, now);
+            addJson(ret, shard.admin, "admin", threshold, now);
         }
-        for (auto& outboundEntry : outbound_)
+
+        return ret;
+    }
+
+    /** Returns the consumers which have used the most CPU time.
+
+        Includes consumers which have recently become inactive.
+
+        @param limit The most consumers to return.
+        @return A Json::arrayValue, in decreasing order of CPU time.
+    */
+    Json::Value
+    getUsageJson(std::size_t limit)
+    {
+        std::vector<std::tuple<Usage, std::string, char const*>> usages;
+        for (auto& shard : shards_)
         {
-            int localBalance = outboundEntry.local_balance.value(now);
-            if ((localBalance + outboundEntry.remote_balance) >= threshold)
-            {
-                Json::Value& entry =
-                    (ret[outboundEntry.to_string()] = Json::objectValue);
-                entry[jss::local] = localBalance;
-                entry[jss::remote] = outboundEntry.remote_balance;
-                entry[jss::type] = "outbound";
-            }
+            std::lock_guard _(shard.lock);
+            auto add = [&](EntryIntrusiveList& list, char const* type) {
+                for (auto& entry : list)
+                {
+                    if (entry.usage.jobs != 0)
+                        usages.emplace_back(
+                            entry.usage, entry.to_string(), type);
+                }
+            };
+            add(shard.inbound, "inbound");
+            add(shard.outbound, "outbound");
+            add(shard.admin, "admin");
+            add(shard.inactive, "inactive");
         }
-        for (auto& adminEntry : admin_)
+
+        auto const count = std::min(limit, usages.size());
+        std::partial_sort(
+            usages.begin(),
+            usages.begin() + count,
+            usages.end(),
+            [](auto const& a, auto const& b) {
+                return std::get<0>(a).cpu > std::get<0>(b).cpu;
+            });
+
+        Json::Value ret(Json::arrayValue);
+        for (std::size_t i = 0; i < count; ++i)
         {
-            int localBalance = adminEntry.local_balance.value(now);
-            if ((localBalance + adminEntry.remote_balance) >= threshold)
-            {
-                Json::Value& entry =
-                    (ret[adminEntry.to_string()] = Json::objectValue);
-                entry[jss::local] = localBalance;
-                entry[jss::remote] = adminEntry.remote_balance;
-                entry[jss::type] = "admin";
-            }
+            auto const& [usage, address, type] = usages[i];
+            Json::Value& entry = ret.append(Json::objectValue);
+            entry[jss::address] = address;
+            entry[jss::type] = type;
+            entry[jss::cpu_duration_us] = std::to_string(usage.cpu.count());
+            entry[jss::wall_duration_us] = std::to_string(usage.wall.count());
+            entry[jss::jobs] = static_cast<Json::UInt>(usage.jobs);
         }
-
         return ret;
     }
 
@@ -258,18 +247,20 @@ public:
         clock_type::time_point const now(m_clock.now());
 
         Gossip gossip;
-        std::lock_guard _(lock_);
-
-        gossip.items.reserve(inbound_.size());
 
-        for (auto& inboundEntry : inbound_)
+        for (auto& shard : shards_)
         {
-            Gossip::Item item;
-            item.balance = inboundEntry.local_balance.value(now);
-            if (item.balance >= minimumGossipBalance)
+            std::lock_guard _(shard.lock);
+
+            for (auto& inboundEntry : shard.inbound)
             {
-                item.address = inboundEntry.key->address;
-                gossip.items.push_back(item);
+                Gossip::Item item;
+                item.balance = inboundEntry.local_balance.value(now);
+                if (item.balance >= minimumGossipBalance)
+                {
+                    item.address = inboundEntry.key->address;
+                    gossip.items.push_back(item);
+                }
             }
         }
 
@@ -282,56 +273,36 @@ public:
     importConsumers(std::string const& origin, Gossip const& gossip)
     {
         auto const elapsed = m_clock.now();
-        {
-            std::lock_guard _(lock_);
-            auto [resultIt, resultInserted] = importTable_.emplace(
-                std::piecewise_construct,
-                std::make_tuple(origin),  // Key
-                std::make_tuple(
-                    m_clock.now().time_since_epoch().count()));  // Import
-
-            if (resultInserted)
-            {
-                // This is a new import
-                Import& next(resultIt->second);
-                next.whenExpires = elapsed + gossipExpirationSeconds;
-                next.items.reserve(gossip.items.size());
 
-                for (auto const& gossipItem : gossip.items)
-                {
-                    Import::Item item;
-                    item.balance = gossipItem.balance;
-                    item.consumer = newInboundEndpoint(gossipItem.address);
-                    item.consumer.entry().remote_balance += item.balance;
-                    next.items.push_back(item);
-                }
-            }
-            else
-            {
-                // Previous import exists so add the new remote
-                // balances and then deduct the old remote balances.
+        std::lock_guard _(importLock_);
+        auto [resultIt, resultInserted] = importTable_.emplace(
+            std::piecewise_construct,
+            std::make_tuple(origin),  // Key
+            std::make_tuple(
+                m_clock.now().time_since_epoch().count()));  // Import
 
-                Import next;
-                next.whenExpires = elapsed + gossipExpirationSeconds;
-                next.items.reserve(gossip.items.size());
-                for (auto const& gossipItem : gossip.items)
-                {
-                    Import::Item item;
-                    item.balance = gossipItem.balance;
-                    item.consumer = newInboundEndpoint(gossipItem.address);
-                    item.consumer.entry().remote_balance += item.balance;
-                    next.items.push_back(item);
-                }
+        Import next;
+        next.whenExpires = elapsed + gossipExpirationSeconds;
+        next.items.reserve(gossip.items.size());
 
-                Import& prev(resultIt->second);
-                for (auto& item : prev.items)
-                {
-                    item.consumer.entry().remote_balance -= item.balance;
-                }
+        for (auto const& gossipItem : gossip.items)
+        {
+            Import::Item item;
+            item.balance = gossipItem.balance;
+            item.consumer = newInboundEndpoint(gossipItem.address);
+            addRemoteBalance(item.consumer.entry(), item.balance);
+            next.items.push_back(item);
+        }
 
-                std::swap(next, prev);
-            }
+        if (!resultInserted)
+        {
+            // Previous import exists so the new remote balances were
+            // added above, now deduct the old remote balances.
+            for (auto& item : resultIt->second.items)
+                addRemoteBalance(item.consumer.entry(), -item.balance);
         }
+
+        std::swap(next, resultIt->second);
     }
 
     //--------------------------------------------------------------------------
@@ -341,25 +312,31 @@ public:
     void
     periodicActivity()
     {
-        std::lock_guard _(lock_);
-
         auto const elapsed = m_clock.now();
 
-        for (auto iter(inactive_.begin()); iter != inactive_.end();)
+        for (auto& shard : shards_)
         {
-            if (iter->whenExpires <= elapsed)
-            {
-                JLOG(m_journal.debug()) << "Expired " << *iter;
-                auto table_iter = table_.find(*iter->key);
-                ++iter;
-                erase(table_iter);
-            }
-            else
+            std::lock_guard _(shard.lock);
+
+            for (auto iter(shard.inactive.begin());
+                 iter != shard.inactive.end();)
             {
-                break;
+                if (iter->whenExpires <= elapsed)
+                {
+                    JLOG(m_journal.debug()) << "Expired " << *iter;
+                    auto table_iter = shard.table.find(*iter->key);
+                    ++iter;
+                    erase(shard, table_iter);
+                }
+                else
+                {
+                    break;
+                }
             }
         }
 
+        std::lock_guard _(importLock_);
+
         auto iter = importTable_.begin();
         while (iter != importTable_.end())
         {
@@ -370,8 +347,8 @@ public:
                      item_iter != import.items.end();
                      ++item_iter)
                 {
-                    item_iter->consumer.entry().remote_balance -=
-                        item_iter->balance;
+                    addRemoteBalance(
+                        item_iter->consumer.entry(), -item_iter->balance);
                 }
 
                 iter = importTable_.erase(iter);
@@ -396,47 +373,25 @@ public:
         return Disposition::ok;
     }
 
-    void
-    erase(Table::iterator iter)
-    {
-        std::lock_guard _(lock_);
-        Entry& entry(iter->second);
-        assert(entry.refcount == 0);
-        inactive_.erase(inactive_.iterator_to(entry));
-        table_.erase(iter);
-    }
-
     void
     acquire(Entry& entry)
     {
-        std::lock_guard _(lock_);
+        std::lock_guard _(shardOf(entry).lock);
         ++entry.refcount;
     }
 
     void
     release(Entry& entry)
     {
-        std::lock_guard _(lock_);
+        Shard& shard = shardOf(entry);
+        std::lock_guard _(shard.lock);
         if (--entry.refcount == 0)
         {
             JLOG(m_journal.debug()) << "Inactive " << entry;
 
-            switch (entry.key->kind)
-            {
-                case kindInbound:
-                    inbound_.erase(inbound_.iterator_to(entry));
-                    break;
-                case kindOutbound:
-                    outbound_.erase(outbound_.iterator_to(entry));
-                    break;
-                case kindUnlimited:
-                    admin_.erase(admin_.iterator_to(entry));
-                    break;
-                default:
-                    assert(false);
-                    break;
-            }
-            inactive_.push_back(entry);
+            auto& active = activeList(shard, entry.key->kind);
+            active.erase(active.iterator_to(entry));
+            shard.inactive.push_back(entry);
             entry.whenExpires = m_clock.now() + secondsUntilExpiration;
         }
     }
@@ -444,11 +399,37 @@ public:
     Disposition
     charge(Entry& entry, Charge const& fee)
     {
-        std::lock_guard _(lock_);
-        clock_type::time_point const now(m_clock.now());
-        int const balance(entry.add(fee.cost(), now));
-        JLOG(m_journal.trace()) << "Charging " << entry << " for " << fee;
-        return disposition(balance);
+        std::lock_guard lock(shardOf(entry).lock);
+        return charge(entry, fee, lock);
+    }
+
+    Disposition
+    chargeTime(
+        Entry& entry,
+        std::chrono::microseconds cpu,
+        std::chrono::microseconds wall)
+    {
+        std::lock_guard lock(shardOf(entry).lock);
+        entry.usage.cpu += cpu;
+        entry.usage.wall += wall;
+        ++entry.usage.jobs;
+
+        if (!chargeMeasuredCost_ || entry.isUnlimited() ||
+            cpu < measuredCostUnit)
+            return disposition(entry.balance(m_clock.now()));
+
+        // A single huge job is charged at most enough to be dropped
+        auto const cost = std::min<std::int64_t>(
+            cpu / measuredCostUnit, dropThreshold);
+        return charge(
+            entry, Charge(static_cast<Charge::value_type>(cost)), lock);
+    }
+
+    Usage
+    usage(Entry& entry)
+    {
+        std::lock_guard _(shardOf(entry).lock);
+        return entry.usage;
     }
 
     bool
@@ -457,15 +438,17 @@ public:
         if (entry.isUnlimited())
             return false;
 
-        std::lock_guard _(lock_);
         bool notify(false);
-        auto const elapsed = m_clock.now();
-        if (entry.balance(m_clock.now()) >= warningThreshold &&
-            elapsed != entry.lastWarningTime)
         {
-            charge(entry, feeWarning);
-            notify = true;
-            entry.lastWarningTime = elapsed;
+            std::lock_guard lock(shardOf(entry).lock);
+            auto const elapsed = m_clock.now();
+            if (entry.balance(m_clock.now()) >= warningThreshold &&
+                elapsed != entry.lastWarningTime)
+            {
+                charge(entry, feeWarning, lock);
+                notify = true;
+                entry.lastWarningTime = elapsed;
+            }
         }
         if (notify)
         {
@@ -481,7 +464,7 @@ public:
         if (entry.isUnlimited())
             return false;
 
-        std::lock_guard _(lock_);
+        std::lock_guard lock(shardOf(entry).lock);
         bool drop(false);
         clock_type::time_point const now(m_clock.now());
         int const balance(entry.balance(now));
@@ -494,7 +477,7 @@ public:
             // Adding feeDrop at this point keeps the dropped connection
             // from re-connecting for at least a little while after it is
             // dropped.
-            charge(entry, feeDrop);
+            charge(entry, feeDrop, lock);
             ++m_stats.drop;
             drop = true;
         }
@@ -504,7 +487,7 @@ public:
     int
     balance(Entry& entry)
     {
-        std::lock_guard _(lock_);
+        std::lock_guard _(shardOf(entry).lock);
         return entry.balance(m_clock.now());
     }
 
@@ -533,26 +516,146 @@ public:
     {
         clock_type::time_point const now(m_clock.now());
 
-        std::lock_guard _(lock_);
-
         {
             beast::PropertyStream::Set s("inbound", map);
-            writeList(now, s, inbound_);
+            for (auto& shard : shards_)
+            {
+                std::lock_guard _(shard.lock);
+                writeList(now, s, shard.inbound);
+            }
         }
 
         {
             beast::PropertyStream::Set s("outbound", map);
-            writeList(now, s, outbound_);
+            for (auto& shard : shards_)
+            {
+                std::lock_guard _(shard.lock);
+                writeList(now, s, shard.outbound);
+            }
         }
 
         {
             beast::PropertyStream::Set s("admin", map);
-            writeList(now, s, admin_);
+            for (auto& shard : shards_)
+            {
+                std::lock_guard _(shard.lock);
+                writeList(now, s, shard.admin);
+            }
         }
 
         {
             beast::PropertyStream::Set s("inactive", map);
-            writeList(now, s, inactive_);
+            for (auto& shard : shards_)
+            {
+                std::lock_guard _(shard.lock);
+                writeList(now, s, shard.inactive);
+            }
+        }
+    }
+
+private:
+    Shard&
+    shardOf(Entry const& entry)
+    {
+        return shards_[entry.shard];
+    }
+
+    static EntryIntrusiveList&
+    activeList(Shard& shard, Kind kind)
+    {
+        switch (kind)
+        {
+            case kindInbound:
+                return shard.inbound;
+            case kindOutbound:
+                return shard.outbound;
+            case kindUnlimited:
+                return shard.admin;
+            default:
+                break;
+        }
+        assert(false);
+        return shard.inbound;
+    }
+
+    // Find or create the entry for a key and take a reference to it
+    Entry&
+    newEndpoint(Kind kind, beast::IP::Endpoint const& address)
+    {
+        Key const key(kind, address);
+        auto const index = Key::hasher{}(key) % tableShards;
+        Shard& shard = shards_[index];
+
+        std::lock_guard _(shard.lock);
+        auto [resultIt, resultInserted] = shard.table.emplace(
+            std::piecewise_construct,
+            std::make_tuple(key),             // Key
+            std::make_tuple(m_clock.now()));  // Entry
+
+        Entry& entry = resultIt->second;
+        // These never change once set, so they may be read without the lock
+        if (resultInserted)
+        {
+            entry.key = &resultIt->first;
+            entry.shard = index;
+        }
+        ++entry.refcount;
+        if (entry.refcount == 1)
+        {
+            if (!resultInserted)
+                shard.inactive.erase(shard.inactive.iterator_to(entry));
+            activeList(shard, kind).push_back(entry);
+        }
+        return entry;
+    }
+
+    void
+    erase(Shard& shard, Table::iterator iter)
+    {
+        Entry& entry(iter->second);
+        assert(entry.refcount == 0);
+        shard.inactive.erase(shard.inactive.iterator_to(entry));
+        shard.table.erase(iter);
+    }
+
+    Disposition
+    charge(
+        Entry& entry,
+        Charge const& fee,
+        std::lock_guard<std::mutex> const&)
+    {
+        clock_type::time_point const now(m_clock.now());
+        int const balance(entry.add(fee.cost(), now));
+        JLOG(m_journal.trace()) << "Charging " << entry << " for " << fee;
+        return disposition(balance);
+    }
+
+    void
+    addRemoteBalance(Entry& entry, int balance)
+    {
+        std::lock_guard _(shardOf(entry).lock);
+        entry.remote_balance += balance;
+    }
+
+    void
+    addJson(
+        Json::Value& ret,
+        EntryIntrusiveList& list,
+        char const* type,
+        int threshold,
+        clock_type::time_point const now)
+    {
+        for (auto& listEntry : list)
+        {
+            int localBalance = listEntry.local_balance.value(now);
+            if ((localBalance + listEntry.remote_balance) >= threshold)
+            {
+                Json::Value& entry =
+                    (ret[listEntry.to_string()] = Json::objectValue);
+                entry[jss::local] = localBalance;
+                entry[jss::remote] = listEntry.remote_balance;
+                entry[jss::type] = type;
+            }
         }
     }
 };
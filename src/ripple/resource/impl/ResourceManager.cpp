@@ -46,8 +46,10 @@ private:
 public:
     ManagerImp(
         beast::insight::Collector::ptr const& collector,
-        beast::Journal journal)
-        : journal_(journal), logic_(collector, stopwatch(), journal)
+        beast::Journal journal,
+        bool chargeMeasuredCost)
+        : journal_(journal)
+        , logic_(collector, stopwatch(), journal, chargeMeasuredCost)
     {
         thread_ = std::thread{&ManagerImp::run, this};
     }
@@ -135,6 +137,12 @@ public:
         return logic_.getJson(threshold);
     }
 
+    Json::Value
+    getUsageJson(std::size_t limit) override
+    {
+        return logic_.getUsageJson(limit);
+    }
+
     //--------------------------------------------------------------------------
 
     void
@@ -174,9 +182,11 @@ Manager::~Manager() = default;
 std::unique_ptr<Manager>
 make_Manager(
     beast::insight::Collector::ptr const& collector,
-    beast::Journal journal)
+    beast::Journal journal,
+    bool chargeMeasuredCost)
 {
-    return std::make_unique<ManagerImp>(collector, journal);
+    return std::make_unique<ManagerImp>(
+        collector, journal, chargeMeasuredCost);
 }
 
 }  // namespace Resource
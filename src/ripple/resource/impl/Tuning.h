@@ -21,6 +21,7 @@
 #define RIPPLE_RESOURCE_TUNING_H_INCLUDED
 
 #include <chrono>
+#include <cstddef>
 
 namespace ripple {
 namespace Resource {
@@ -50,6 +51,14 @@ std::chrono::seconds constexpr secondsUntilExpiration{300};
 // Number of seconds until imported gossip expires
 std::chrono::seconds constexpr gossipExpirationSeconds{30};
 
+// Number of independently locked slices of the consumer table
+std::size_t constexpr tableShards{16};
+
+// The CPU time which costs one unit of balance, when measured costs are
+// charged. A consumer using more than about 1.5 seconds of CPU in one
+// decay window is disconnected.
+std::chrono::microseconds constexpr measuredCostUnit{100};
+
 }  // namespace Resource
 }  // namespace ripple
 
@@ -20,6 +20,16 @@
 #ifndef RIPPLE_RPC_BOOKCHANGES_H_INCLUDED
 #define RIPPLE_RPC_BOOKCHANGES_H_INCLUDED
 
+#include <ripple/app/ledger/AcceptedLedger.h>
+#include <ripple/protocol/jss.h>
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
 namespace Json {
 class Value;
 }
@@ -33,9 +43,10 @@ class STTx;
 
 namespace RPC {
 
-template <class L>
-Json::Value
-computeBookChanges(std::shared_ptr<L const> const& lpAccepted)
+namespace detail {
+
+/** The volumes and rates of the offers crossed in a ledger, by book. */
+class BookChangesTally
 {
     std::map<
         std::string,
@@ -47,22 +58,23 @@ computeBookChanges(std::shared_ptr<L const> const& lpAccepted)
             STAmount,  // open rate
             STAmount   // close rate
             >>
-        tally;
+        tally_;
 
-    for (auto& tx : lpAccepted->txs)
+public:
+    void
+    add(STTx const& tx, STArray const& nodes)
     {
-        if (!tx.first || !tx.second ||
-            !tx.first->isFieldPresent(sfTransactionType))
-            continue;
+        if (!tx.isFieldPresent(sfTransactionType))
+            return;
 
         std::optional<uint32_t> offerCancel;
-        uint16_t tt = tx.first->getFieldU16(sfTransactionType);
+        uint16_t tt = tx.getFieldU16(sfTransactionType);
         switch (tt)
         {
             case ttOFFER_CANCEL:
             case ttOFFER_CREATE: {
-                if (tx.first->isFieldPresent(sfOfferSequence))
-                    offerCancel = tx.first->getFieldU32(sfOfferSequence);
+                if (tx.isFieldPresent(sfOfferSequence))
+                    offerCancel = tx.getFieldU32(sfOfferSequence);
                 break;
             }
             // in future if any other ways emerge to cancel an offer
@@ -71,11 +83,10 @@ computeBookChanges(std::shared_ptr<L const> const& lpAccepted)
                 break;
         }
 
-        for (auto const& node : tx.second->getFieldArray(sfAffectedNodes))
+        for (auto const& node : nodes)
         {
             SField const& metaType = node.getFName();
             uint16_t nodeType = node.getFieldU16(sfLedgerEntryType);
-
             // we only care about ltOFFER objects being modified or
             // deleted
             if (nodeType != ltOFFER || metaType == sfCreatedNode)
@@ -141,8 +152,8 @@ computeBookChanges(std::shared_ptr<L const> const& lpAccepted)
 
             std::string key{ss.str()};
 
-            if (tally.find(key) == tally.end())
-                tally[key] = {
+            if (tally_.find(key) == tally_.end())
+                tally_[key] = {
                     first,   // side A vol
                     second,  // side B vol
                     rate,    // high
@@ -153,7 +164,7 @@ computeBookChanges(std::shared_ptr<L const> const& lpAccepted)
             else
             {
                 // increment volume
-                auto& entry = tally[key];
+                auto& entry = tally_[key];
 
                 std::get<0>(entry) += first;   // side A vol
                 std::get<1>(entry) += second;  // side B vol
@@ -169,39 +180,91 @@ computeBookChanges(std::shared_ptr<L const> const& lpAccepted)
         }
     }
 
-    Json::Value jvObj(Json::objectValue);
-    jvObj[jss::type] = "bookChanges";
-    jvObj[jss::ledger_index] = lpAccepted->info().seq;
-    jvObj[jss::ledger_hash] = to_string(lpAccepted->info().hash);
-    jvObj[jss::ledger_time] = Json::Value::UInt(
-        lpAccepted->info().closeTime.time_since_epoch().count());
+    template <class Info>
+    Json::Value
+    json(Info const& info) const
+    {
+        Json::Value jvObj(Json::objectValue);
+        jvObj[jss::type] = "bookChanges";
+        jvObj[jss::ledger_index] = info.seq;
+        jvObj[jss::ledger_hash] = to_string(info.hash);
+        jvObj[jss::ledger_time] =
+            Json::Value::UInt(info.closeTime.time_since_epoch().count());
+
+        jvObj[jss::changes] = Json::arrayValue;
+
+        for (auto const& entry : tally_)
+        {
+            Json::Value& inner = jvObj[jss::changes].append(Json::objectValue);
+
+            STAmount volA = std::get<0>(entry.second);
+            STAmount volB = std::get<1>(entry.second);
+
+            inner[jss::currency_a] =
+                (isXRP(volA) ? "XRP_drops" : to_string(volA.issue()));
+            inner[jss::currency_b] =
+                (isXRP(volB) ? "XRP_drops" : to_string(volB.issue()));
+
+            inner[jss::volume_a] =
+                (isXRP(volA) ? to_string(volA.xrp()) : to_string(volA.iou()));
+            inner[jss::volume_b] =
+                (isXRP(volB) ? to_string(volB.xrp()) : to_string(volB.iou()));
+
+            inner[jss::high] = to_string(std::get<2>(entry.second).iou());
+            inner[jss::low] = to_string(std::get<3>(entry.second).iou());
+            inner[jss::open] = to_string(std::get<4>(entry.second).iou());
+            inner[jss::close] = to_string(std::get<5>(entry.second).iou());
+        }
+
+        return jvObj;
+    }
+};
+
+}  // namespace detail
 
-    jvObj[jss::changes] = Json::arrayValue;
+template <class L>
+Json::Value
+computeBookChanges(std::shared_ptr<L const> const& lpAccepted)
+{
+    detail::BookChangesTally tally;
 
-    for (auto const& entry : tally)
+    for (auto& tx : lpAccepted->txs)
     {
-        Json::Value& inner = jvObj[jss::changes].append(Json::objectValue);
+        if (!tx.first || !tx.second)
+            continue;
 
-        STAmount volA = std::get<0>(entry.second);
-        STAmount volB = std::get<1>(entry.second);
+        tally.add(*tx.first, tx.second->getFieldArray(sfAffectedNodes));
+    }
 
-        inner[jss::currency_a] =
-            (isXRP(volA) ? "XRP_drops" : to_string(volA.issue()));
-        inner[jss::currency_b] =
-            (isXRP(volB) ? "XRP_drops" : to_string(volB.issue()));
+    return tally.json(lpAccepted->info());
+}
 
-        inner[jss::volume_a] =
-            (isXRP(volA) ? to_string(volA.xrp()) : to_string(volA.iou()));
-        inner[jss::volume_b] =
-            (isXRP(volB) ? to_string(volB.xrp()) : to_string(volB.iou()));
+/** Compute the book changes of an accepted ledger.
 
-        inner[jss::high] = to_string(std::get<2>(entry.second).iou());
-        inner[jss::low] = to_string(std::get<3>(entry.second).iou());
-        inner[jss::open] = to_string(std::get<4>(entry.second).iou());
-        inner[jss::close] = to_string(std::get<5>(entry.second).iou());
+    Only the transactions which touched an offer are looked at. They are
+    tallied in the order of their IDs, as the transactions of a ledger are
+    iterated, so the open and close rates match those computed from the
+    ledger itself.
+*/
+inline Json::Value
+computeBookChanges(AcceptedLedger const& ledger)
+{
+    std::vector<AcceptedLedgerTx const*> txs;
+    for (auto const& tx : ledger)
+    {
+        if (!tx->getBooks().empty())
+            txs.push_back(tx.get());
     }
 
-    return jvObj;
+    std::sort(txs.begin(), txs.end(), [](auto const* a, auto const* b) {
+        return a->getTransactionID() < b->getTransactionID();
+    });
+
+    detail::BookChangesTally tally;
+    for (auto const* tx : txs)
+        tally.add(*tx->getTxn(), tx->getMeta().getNodes());
+
+    return tally.json(ledger.getLedger()->info());
 }
 
 }  // namespace RPC
@@ -35,6 +35,8 @@ class LedgerMaster;
 
 namespace RPC {
 
+class LedgerDataStream;
+
 /** The context of information needed to call an RPC. */
 struct Context
 {
@@ -45,6 +47,7 @@ struct Context
     LedgerMaster& ledgerMaster;
     Resource::Consumer& consumer;
     Role role;
+    // Null unless the request is one which may suspend
     std::shared_ptr<JobQueue::Coro> coro{};
     InfoSub::pointer infoSub{};
     unsigned int apiVersion;
@@ -64,6 +67,12 @@ struct JsonContext : public Context
     Json::Value params;
 
     Headers headers{};
+
+    /**
+     * Set by transports which can send a streamed response. A handler
+     * which streams stores the stream here and returns its header.
+     */
+    std::shared_ptr<LedgerDataStream>* stream = nullptr;
 };
 
 template <class RequestType>
@@ -49,6 +49,21 @@ std::pair<org::xrpl::rpc::v1::GetLedgerDiffResponse, grpc::Status>
 doLedgerDiffGrpc(
     RPC::GRPCContext<org::xrpl::rpc::v1::GetLedgerDiffRequest>& context);
 
+std::pair<org::xrpl::rpc::v1::GetAccountInfoResponse, grpc::Status>
+doAccountInfoGrpc(
+    RPC::GRPCContext<org::xrpl::rpc::v1::GetAccountInfoRequest>& context);
+
+std::pair<
+    org::xrpl::rpc::v1::GetAccountTransactionHistoryResponse,
+    grpc::Status>
+doAccountTxGrpc(
+    RPC::GRPCContext<org::xrpl::rpc::v1::GetAccountTransactionHistoryRequest>&
+        context);
+
+std::pair<org::xrpl::rpc::v1::GetBookOffersResponse, grpc::Status>
+doBookOffersGrpc(
+    RPC::GRPCContext<org::xrpl::rpc::v1::GetBookOffersRequest>& context);
+
 }  // namespace ripple
 
 #endif
@@ -24,6 +24,8 @@
 #include <ripple/net/InfoSub.h>
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/Status.h>
+#include <array>
+#include <string_view>
 
 namespace ripple {
 namespace RPC {
@@ -37,6 +39,16 @@ doCommand(RPC::JsonContext&, Json::Value&);
 Role
 roleRequired(unsigned int version, bool betaEnabled, std::string const& method);
 
+/** Methods whose handlers, when run in a coroutine, suspend it while
+    they wait for NodeStore fetches rather than block their thread.
+*/
+inline constexpr std::array<std::string_view, 5> fetchSuspendingMethods{
+    "account_objects",
+    "account_tx",
+    "ledger_data",
+    "ledger_entry",
+    "tx"};
+
 }  // namespace RPC
 }  // namespace ripple
 
@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_RPC_RESPONSECACHE_H_INCLUDED
+#define RIPPLE_RPC_RESPONSECACHE_H_INCLUDED
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/json/json_value.h>
+#include <ripple/rpc/Role.h>
+#include <ripple/rpc/Status.h>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ripple {
+namespace RPC {
+
+/** Shares the responses to identical read-only RPC requests.
+
+    A busy public server often receives the same request from many clients
+    between two ledgers: server_info, fee, or book_offers for a popular
+    pair. For the methods enabled in the [rpc_response_cache] section, the
+    response to a request is kept and returned for identical requests until
+    the ledgers change. Identical requests which arrive while the first is
+    still running wait for its response instead of running again.
+
+    Requests are identical if they name the same method with the same
+    parameters, ignoring the request id, and were made with the same API
+    version and role. Responses to requests for the open ledger are reused
+    until the next ledger closes, even though the open ledger may change in
+    the meantime; operators enable caching knowing this.
+*/
+class ResponseCache
+{
+public:
+    /** Create a cache.
+
+        @param methods The methods to cache. Methods which are not read-only
+                       queries are ignored with a warning.
+        @param size The largest number of responses to keep.
+    */
+    ResponseCache(
+        std::vector<std::string> const& methods,
+        beast::Journal journal,
+        std::size_t size = defaultSize);
+
+    /** Return true if responses to the method are cached. */
+    bool
+    enabled(std::string const& method) const;
+
+    /** Return the key identifying a request. */
+    static std::string
+    makeKey(
+        std::string const& method,
+        Json::Value const& params,
+        unsigned int apiVersion,
+        Role role);
+
+    /** Return the response to a request, computing it if needed.
+
+        @param key The key of the request, from makeKey.
+        @param ledgers Identifies the ledgers the response depends on. When
+                       it changes, every cached response is discarded.
+        @param result Receives the response.
+        @param compute Computes the response, if it is not available.
+    */
+    Status
+    fetch(
+        std::string const& key,
+        uint256 const& ledgers,
+        Json::Value& result,
+        std::function<Status(Json::Value&)> const& compute);
+
+    /** Return the number of cached and running requests. */
+    std::size_t
+    size() const;
+
+    /** The default number of responses to keep. */
+    static constexpr std::size_t defaultSize = 4096;
+
+    /** The longest time to wait for an identical request to finish. */
+    static constexpr std::chrono::seconds maxWait{5};
+
+private:
+    struct Entry
+    {
+        bool done = false;
+        bool valid = false;
+        Status status;
+        Json::Value result;
+    };
+
+    void
+    complete(
+        std::string const& key,
+        std::shared_ptr<Entry> const& entry,
+        Status const* status,
+        Json::Value const* result);
+
+    std::set<std::string> methods_;
+    std::size_t const size_;
+
+    std::mutex mutable mutex_;
+    std::condition_variable cond_;
+    uint256 ledgers_;
+    std::unordered_map<std::string, std::shared_ptr<Entry>> entries_;
+};
+
+}  // namespace RPC
+}  // namespace ripple
+
+#endif
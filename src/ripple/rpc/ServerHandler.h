@@ -116,6 +116,7 @@ private:
     make_ServerHandler(
         Application& app,
         boost::asio::io_service&,
+        boost::asio::io_service&,
         JobQueue&,
         NetworkOPs&,
         Resource::Manager&,
@@ -127,6 +128,7 @@ public:
         ServerHandlerCreator const&,
         Application& app,
         boost::asio::io_service& io_service,
+        boost::asio::io_service& peer_io_service,
         JobQueue& jobQueue,
         NetworkOPs& networkOPs,
         Resource::Manager& resourceManager,
@@ -190,16 +192,28 @@ public:
     onStopped(Server&);
 
 private:
+    // Runs f(coro) as a job. Only requests which may suspend get a
+    // coroutine, and with it a stack; for the rest coro is null.
+    template <class F>
+    bool
+    postRequest(
+        bool needsCoro,
+        JobType type,
+        std::string const& name,
+        F&& f);
+
     Json::Value
     processSession(
         std::shared_ptr<WSSession> const& session,
         std::shared_ptr<JobQueue::Coro> const& coro,
-        Json::Value const& jv);
+        Json::Value const& jv,
+        std::shared_ptr<RPC::LedgerDataStream>& stream);
 
     void
     processSession(
         std::shared_ptr<Session> const&,
-        std::shared_ptr<JobQueue::Coro> coro);
+        std::shared_ptr<JobQueue::Coro> coro,
+        std::string const& request);
 
     void
     processRequest(
@@ -209,7 +223,8 @@ private:
         Output&&,
         std::shared_ptr<JobQueue::Coro> coro,
         boost::string_view forwardedFor,
-        boost::string_view user);
+        boost::string_view user,
+        std::shared_ptr<RPC::LedgerDataStream>& stream);
 
     Handoff
     statusResponse(http_request_type const& request) const;
@@ -218,10 +233,16 @@ private:
 ServerHandler::Setup
 setup_ServerHandler(Config const& c, std::ostream&& log);
 
+/** Create the server handler.
+
+    Ports which speak the peer protocol run on the second io_service, so
+    peers are served apart from clients.
+*/
 std::unique_ptr<ServerHandler>
 make_ServerHandler(
     Application& app,
     boost::asio::io_service&,
+    boost::asio::io_service&,
     JobQueue&,
     NetworkOPs&,
     Resource::Manager&,
@@ -30,6 +30,8 @@
 #include <boost/asio/basic_waitable_timer.hpp>
 #include <boost/filesystem.hpp>
 
+#include <optional>
+
 namespace ripple {
 #ifdef ENABLE_TESTS
 namespace test {
@@ -102,43 +104,66 @@ private:
         parsedURL&& url,
         std::lock_guard<std::mutex> const&);
 
-    // Begins the download and import of the next archive.
+    // Begins processing the next downloaded archive if the importer is
+    // idle, and the download of the next archive if the downloader is.
     bool
     next(std::lock_guard<std::mutex> const& l);
 
+    // Confirms the last ledger hash of the shard being downloaded and
+    // starts its download.
+    bool
+    download(std::lock_guard<std::mutex> const& l);
+
     // Callback used by the downloader to notify completion of a download.
     void
     complete(boost::filesystem::path dstPath);
 
+    // Schedules the extraction and import of a downloaded archive.
+    bool
+    beginProcessing(
+        std::uint32_t shardIndex,
+        boost::filesystem::path dstPath,
+        std::lock_guard<std::mutex> const& l);
+
     // Extract a downloaded archive and import it into the shard store.
     void
-    process(boost::filesystem::path const& dstPath);
+    process(std::uint32_t shardIndex, boost::filesystem::path const& dstPath);
 
-    // Remove the archive being processed.
+    // Remove an archive and its download directory.
     void
-    remove(std::lock_guard<std::mutex> const&);
+    remove(std::uint32_t shardIndex, std::lock_guard<std::mutex> const&);
 
     void
     doRelease(std::lock_guard<std::mutex> const&);
 
     bool
     onClosureFailed(
+        std::uint32_t shardIndex,
         std::string const& errorMsg,
         std::lock_guard<std::mutex> const& lock);
 
     bool
-    removeAndProceed(std::lock_guard<std::mutex> const& lock);
+    removeAndProceed(
+        std::uint32_t shardIndex,
+        std::lock_guard<std::mutex> const& lock);
 
     /////////////////////////////////////////////////
     // m_ is used to protect access to downloader_,
-    // archives_, process_ and to protect setting and
-    // destroying sqlDB_.
+    // archives_, process_, the pipeline state and to
+    // protect setting and destroying sqlDB_.
     /////////////////////////////////////////////////
     std::mutex mutable m_;
     std::atomic_bool stopping_{false};
     std::shared_ptr<DatabaseDownloader> downloader_;
     std::map<std::uint32_t, parsedURL> archives_;
     bool process_;
+
+    // The download of one archive overlaps the import of the
+    // previous one. At most one downloaded archive waits for
+    // the importer, which bounds the disk space used.
+    std::optional<std::uint32_t> downloading_;
+    std::optional<std::pair<std::uint32_t, boost::filesystem::path>> ready_;
+    std::optional<std::uint32_t> processing_;
     std::unique_ptr<DatabaseCon> sqlDB_;
     /////////////////////////////////////////////////
 
@@ -163,25 +163,20 @@ doAccountChannels(RPC::JsonContext& context)
             startHint,
             limit + 1,
             [&visitData, &accountID, &count, &limit, &marker, &nextHint](
-                std::shared_ptr<SLE const> const& sleCur) {
-                if (!sleCur)
-                {
-                    assert(false);
-                    return false;
-                }
-
+                SLEView const& sleCur) {
                 if (++count == limit)
                 {
-                    marker = sleCur->key();
+                    marker = sleCur.key();
                     nextHint = RPC::getStartHint(sleCur, visitData.accountID);
                 }
 
-                if (count <= limit && sleCur->getType() == ltPAYCHAN &&
-                    (*sleCur)[sfAccount] == accountID &&
+                if (count <= limit && sleCur.getType() == ltPAYCHAN &&
+                    sleCur.getAccountID(sfAccount) == accountID &&
                     (!visitData.raDstAccount ||
-                     *visitData.raDstAccount == (*sleCur)[sfDestination]))
+                     *visitData.raDstAccount ==
+                         sleCur.getAccountID(sfDestination)))
                 {
-                    visitData.items.emplace_back(sleCur);
+                    visitData.items.emplace_back(sleCur.sle());
                 }
 
                 return true;
@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/TxQ.h>
 #include <ripple/json/json_value.h>
@@ -272,4 +273,60 @@ doAccountInfo(RPC::JsonContext& context)
     return result;
 }
 
+std::pair<org::xrpl::rpc::v1::GetAccountInfoResponse, grpc::Status>
+doAccountInfoGrpc(
+    RPC::GRPCContext<org::xrpl::rpc::v1::GetAccountInfoRequest>& context)
+{
+    org::xrpl::rpc::v1::GetAccountInfoRequest& request = context.params;
+    org::xrpl::rpc::v1::GetAccountInfoResponse response;
+    grpc::Status status = grpc::Status::OK;
+
+    std::shared_ptr<ReadView const> ledger;
+    if (auto status = RPC::ledgerFromRequest(ledger, context))
+    {
+        grpc::Status errorStatus;
+        if (status.toErrorCode() == rpcINVALID_PARAMS)
+        {
+            errorStatus = grpc::Status(
+                grpc::StatusCode::INVALID_ARGUMENT, status.message());
+        }
+        else
+        {
+            errorStatus =
+                grpc::Status(grpc::StatusCode::NOT_FOUND, status.message());
+        }
+        return {response, errorStatus};
+    }
+
+    auto const account = AccountID::fromVoidChecked(request.account());
+    if (!account)
+    {
+        grpc::Status errorStatus{
+            grpc::StatusCode::INVALID_ARGUMENT, "account malformed"};
+        return {response, errorStatus};
+    }
+
+    auto const sleAccepted = ledger->read(keylet::account(*account));
+    if (!sleAccepted)
+    {
+        grpc::Status errorStatus{
+            grpc::StatusCode::NOT_FOUND, "account not found"};
+        return {response, errorStatus};
+    }
+
+    Serializer s;
+    sleAccepted->add(s);
+
+    auto& accountData = *response.mutable_account_data();
+    accountData.set_data(s.peekData().data(), s.getLength());
+    accountData.set_key(sleAccepted->key().data(), sleAccepted->key().size());
+
+    response.set_ledger_index(ledger->info().seq);
+    if (!ledger->open())
+        response.set_ledger_hash(
+            ledger->info().hash.data(), ledger->info().hash.size());
+    response.set_validated(context.ledgerMaster.isValidated(*ledger));
+    return {response, status};
+}
+
 }  // namespace ripple
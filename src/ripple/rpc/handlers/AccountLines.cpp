@@ -183,39 +183,31 @@ doAccountLines(RPC::JsonContext& context)
                 startHint,
                 limit + 1,
                 [&visitData, &count, &marker, &limit, &nextHint](
-                    std::shared_ptr<SLE const> const& sleCur) {
-                    if (!sleCur)
-                    {
-                        assert(false);
-                        return false;
-                    }
-
+                    SLEView const& sleCur) {
                     if (++count == limit)
                     {
-                        marker = sleCur->key();
+                        marker = sleCur.key();
                         nextHint =
                             RPC::getStartHint(sleCur, visitData.accountID);
                     }
 
-                    if (sleCur->getType() != ltRIPPLE_STATE)
+                    if (sleCur.getType() != ltRIPPLE_STATE)
                         return true;
 
                     bool ignore = false;
                     if (visitData.ignoreDefault)
                     {
-                        if (sleCur->getFieldAmount(sfLowLimit).getIssuer() ==
+                        if (sleCur.getFieldAmount(sfLowLimit).getIssuer() ==
                             visitData.accountID)
-                            ignore =
-                                !(sleCur->getFieldU32(sfFlags) & lsfLowReserve);
+                            ignore = !sleCur.isFlag(lsfLowReserve);
                         else
-                            ignore = !(
-                                sleCur->getFieldU32(sfFlags) & lsfHighReserve);
+                            ignore = !sleCur.isFlag(lsfHighReserve);
                     }
 
                     if (!ignore && count <= limit)
                     {
-                        auto const line =
-                            RPCTrustLine::makeItem(visitData.accountID, sleCur);
+                        auto const line = RPCTrustLine::makeItem(
+                            visitData.accountID, sleCur.sle());
 
                         if (line &&
                             (!visitData.raPeerAccount ||
@@ -31,6 +31,9 @@
 #include <ripple/rpc/impl/RPCHelpers.h>
 #include <ripple/rpc/impl/Tuning.h>
 
+#include <boost/range/iterator_range.hpp>
+
+#include <algorithm>
 #include <sstream>
 #include <string>
 
@@ -98,35 +101,33 @@ doAccountNFTs(RPC::JsonContext& context)
 
     // Continue iteration from the current page:
     bool pastMarker = marker.isZero();
-    uint256 const maskedMarker = marker & nft::pageMask;
     while (cp)
     {
-        auto arr = cp->getFieldArray(sfNFTokens);
+        auto const& arr = cp->getFieldArray(sfNFTokens);
 
-        for (auto const& o : arr)
-        {
-            // Scrolling past the marker gets weird.  We need to look at
-            // a couple of conditions.
-            //
-            //  1. If the low 96-bits don't match, then we compare only
-            //     against the low 96-bits, since that's what determines
-            //     the sort order of the pages.
-            //
-            //  2. However, within one page there can be a number of
-            //     NFTokenIDs that all have the same low 96 bits.  If we're
-            //     in that case then we need to compare against the full
-            //     256 bits.
-            uint256 const nftokenID = o[sfNFTokenID];
-            uint256 const maskedNftokenID = nftokenID & nft::pageMask;
-
-            if (!pastMarker && maskedNftokenID < maskedMarker)
-                continue;
+        // Scrolling past the marker gets weird: tokens are sorted on their
+        // low 96 bits first and only then on the full 256 bits, since that's
+        // what determines the sort order of the pages.  That is exactly the
+        // order compareTokens defines, and the tokens on a page are kept in
+        // that order, so the tokens up to and including the marker can be
+        // skipped with a binary search instead of being visited one by one.
+        auto begin = arr.begin();
 
-            if (!pastMarker && maskedNftokenID == maskedMarker &&
-                nftokenID <= marker)
-                continue;
+        if (!pastMarker)
+        {
+            begin = std::upper_bound(
+                arr.begin(),
+                arr.end(),
+                marker,
+                [](uint256 const& m, STObject const& o) {
+                    return nft::compareTokens(m, o.getFieldH256(sfNFTokenID));
+                });
+            pastMarker = (begin != arr.end());
+        }
 
-            pastMarker = true;
+        for (auto const& o : boost::make_iterator_range(begin, arr.end()))
+        {
+            uint256 const nftokenID = o[sfNFTokenID];
 
             {
                 Json::Value& obj = nfts.append(o.getJson(JsonOptions::none));
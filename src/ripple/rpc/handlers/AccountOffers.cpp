@@ -139,22 +139,16 @@ doAccountOffers(RPC::JsonContext& context)
             startHint,
             limit + 1,
             [&offers, &count, &marker, &limit, &nextHint, &accountID](
-                std::shared_ptr<SLE const> const& sle) {
-                if (!sle)
-                {
-                    assert(false);
-                    return false;
-                }
-
+                SLEView const& sle) {
                 if (++count == limit)
                 {
-                    marker = sle->key();
+                    marker = sle.key();
                     nextHint = RPC::getStartHint(sle, accountID);
                 }
 
-                if (count <= limit && sle->getType() == ltOFFER)
+                if (count <= limit && sle.getType() == ltOFFER)
                 {
-                    offers.emplace_back(sle);
+                    offers.emplace_back(sle.sle());
                 }
 
                 return true;
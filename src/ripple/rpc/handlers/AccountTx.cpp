@@ -19,7 +19,6 @@
 
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/main/Application.h>
-#include <ripple/app/misc/DeliverMax.h>
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/app/misc/Transaction.h>
 #include <ripple/app/rdb/backend/PostgresDatabase.h>
@@ -36,6 +35,7 @@
 #include <ripple/resource/Fees.h>
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/DeliveredAmount.h>
+#include <ripple/rpc/GRPCHandlers.h>
 #include <ripple/rpc/Role.h>
 
 #include <grpcpp/grpcpp.h>
@@ -329,12 +329,10 @@ populateJsonResponse(
 
                     auto const json_tx =
                         (context.apiVersion > 1 ? jss::tx_json : jss::tx);
+                    jvObj[json_tx] = txn->getApiJson(
+                        context.apiVersion, JsonOptions::include_date);
                     if (context.apiVersion > 1)
                     {
-                        jvObj[json_tx] = txn->getJson(
-                            JsonOptions::include_date |
-                                JsonOptions::disable_API_prior_V2,
-                            false);
                         jvObj[jss::hash] = to_string(txn->getID());
                         jvObj[jss::ledger_index] = txn->getLedger();
                         jvObj[jss::ledger_hash] =
@@ -347,13 +345,8 @@ populateJsonResponse(
                             jvObj[jss::close_time_iso] =
                                 to_string_iso(*closeTime);
                     }
-                    else
-                        jvObj[json_tx] =
-                            txn->getJson(JsonOptions::include_date);
 
                     auto const& sttx = txn->getSTransaction();
-                    RPC::insertDeliverMax(
-                        jvObj[json_tx], sttx->getTxnType(), context.apiVersion);
                     if (txnMeta)
                     {
                         jvObj[jss::meta] =
@@ -481,4 +474,100 @@ doAccountTxJson(RPC::JsonContext& context)
     return populateJsonResponse(res, args, context);
 }
 
+std::pair<
+    org::xrpl::rpc::v1::GetAccountTransactionHistoryResponse,
+    grpc::Status>
+doAccountTxGrpc(
+    RPC::GRPCContext<org::xrpl::rpc::v1::GetAccountTransactionHistoryRequest>&
+        context)
+{
+    org::xrpl::rpc::v1::GetAccountTransactionHistoryRequest& request =
+        context.params;
+    org::xrpl::rpc::v1::GetAccountTransactionHistoryResponse response;
+    grpc::Status status = grpc::Status::OK;
+
+    if (!context.app.config().useTxTables())
+    {
+        grpc::Status errorStatus{
+            grpc::StatusCode::UNIMPLEMENTED, "transaction tables disabled"};
+        return {response, errorStatus};
+    }
+
+    AccountTxArgs args;
+    auto const account = AccountID::fromVoidChecked(request.account());
+    if (!account)
+    {
+        grpc::Status errorStatus{
+            grpc::StatusCode::INVALID_ARGUMENT, "account malformed"};
+        return {response, errorStatus};
+    }
+    args.account = *account;
+    args.binary = true;
+    args.forward = request.forward();
+    args.limit = request.limit();
+
+    if (request.ledger_index_min() != 0 || request.ledger_index_max() != 0)
+    {
+        args.ledger = LedgerRange{
+            request.ledger_index_min(),
+            request.ledger_index_max() != 0 ? request.ledger_index_max()
+                                            : UINT32_MAX};
+    }
+
+    if (request.has_marker())
+    {
+        args.marker = {
+            request.marker().ledger_index(),
+            request.marker().account_sequence()};
+    }
+
+    auto const [result, rpcStatus] = doAccountTxHelp(context, args);
+    if (rpcStatus)
+    {
+        grpc::Status errorStatus;
+        switch (rpcStatus.toErrorCode())
+        {
+            case rpcINVALID_PARAMS:
+            case rpcLGR_IDX_MALFORMED:
+            case rpcLGR_IDXS_INVALID:
+            case rpcINVALID_LGR_RANGE:
+                errorStatus = grpc::Status(
+                    grpc::StatusCode::INVALID_ARGUMENT, rpcStatus.toString());
+                break;
+            case rpcNOT_SYNCED:
+                errorStatus = grpc::Status(
+                    grpc::StatusCode::FAILED_PRECONDITION,
+                    rpcStatus.toString());
+                break;
+            default:
+                errorStatus = grpc::Status(
+                    grpc::StatusCode::NOT_FOUND, rpcStatus.toString());
+        }
+        return {response, errorStatus};
+    }
+
+    response.set_account(account->data(), account->size());
+    response.set_ledger_index_min(result.ledgerRange.min);
+    response.set_ledger_index_max(result.ledgerRange.max);
+    response.set_limit(result.limit);
+
+    for (auto const& [txn, meta, seq] :
+         std::get<TxnsDataBinary>(result.transactions))
+    {
+        auto& transaction = *response.add_transactions();
+        transaction.set_transaction_blob(txn.data(), txn.size());
+        transaction.set_metadata_blob(meta.data(), meta.size());
+        transaction.set_ledger_index(seq);
+    }
+
+    if (result.marker)
+    {
+        auto& marker = *response.mutable_marker();
+        marker.set_ledger_index(result.marker->ledgerSeq);
+        marker.set_account_sequence(result.marker->txnSeq);
+    }
+
+    return {response, status};
+}
+
 }  // namespace ripple
@@ -0,0 +1,55 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/json/json_value.h>
+#include <ripple/protocol/ApplyProfile.h>
+#include <ripple/protocol/ErrorCodes.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/rpc/Context.h>
+
+namespace ripple {
+
+// {
+//   clear: <bool>  // optional; discard the counts after returning them
+// }
+//
+// Returns what applying transactions has cost, by transaction type and
+// ledger entry type. Counts are only kept by servers configured with
+// -Dapply_profile=ON.
+Json::Value
+doApplyProfile(RPC::JsonContext& context)
+{
+    auto const& params = context.params;
+
+    if (params.isMember(jss::clear) && !params[jss::clear].isBool())
+        return RPC::expected_field_error(jss::clear, "boolean");
+
+    Json::Value ret = applyProfile::getJson();
+
+    if (params.isMember(jss::clear) && params[jss::clear].asBool())
+    {
+        applyProfile::clear();
+        ret[jss::clear] = true;
+    }
+
+    ret[jss::enabled] = applyProfile::compiled();
+    return ret;
+}
+
+}  // namespace ripple
@@ -20,14 +20,15 @@
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/basics/Log.h>
+#include <ripple/ledger/BookDirs.h>
 #include <ripple/ledger/ReadView.h>
 #include <ripple/net/RPCErr.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/protocol/UintTypes.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/resource/Fees.h>
-#include <ripple/rpc/BookChanges.h>
 #include <ripple/rpc/Context.h>
+#include <ripple/rpc/GRPCHandlers.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
 
 namespace ripple {
@@ -209,8 +210,134 @@ doBookChanges(RPC::JsonContext& context)
     if (std::holds_alternative<Json::Value>(res))
         return std::get<Json::Value>(res);
 
-    return RPC::computeBookChanges(
+    return *context.netOps.getBookChanges(
         std::get<std::shared_ptr<Ledger const>>(res));
 }
 
+std::pair<org::xrpl::rpc::v1::GetBookOffersResponse, grpc::Status>
+doBookOffersGrpc(
+    RPC::GRPCContext<org::xrpl::rpc::v1::GetBookOffersRequest>& context)
+{
+    org::xrpl::rpc::v1::GetBookOffersRequest& request = context.params;
+    org::xrpl::rpc::v1::GetBookOffersResponse response;
+    grpc::Status status = grpc::Status::OK;
+
+    std::shared_ptr<ReadView const> ledger;
+    if (auto status = RPC::ledgerFromRequest(ledger, context))
+    {
+        grpc::Status errorStatus;
+        if (status.toErrorCode() == rpcINVALID_PARAMS)
+        {
+            errorStatus = grpc::Status(
+                grpc::StatusCode::INVALID_ARGUMENT, status.message());
+        }
+        else
+        {
+            errorStatus =
+                grpc::Status(grpc::StatusCode::NOT_FOUND, status.message());
+        }
+        return {response, errorStatus};
+    }
+
+    // Both fields empty means XRP
+    auto const parseIssue = [](std::string const& currency,
+                               std::string const& issuer)
+        -> std::optional<Issue> {
+        if (currency.empty() && issuer.empty())
+            return xrpIssue();
+        auto const c = Currency::fromVoidChecked(currency);
+        auto const i = AccountID::fromVoidChecked(issuer);
+        if (!c || !i || isXRP(*c) || isXRP(*i))
+            return std::nullopt;
+        return Issue{*c, *i};
+    };
+
+    auto const pays = parseIssue(
+        request.taker_pays_currency(), request.taker_pays_issuer());
+    if (!pays)
+    {
+        grpc::Status errorStatus{
+            grpc::StatusCode::INVALID_ARGUMENT, "taker pays malformed"};
+        return {response, errorStatus};
+    }
+
+    auto const gets = parseIssue(
+        request.taker_gets_currency(), request.taker_gets_issuer());
+    if (!gets)
+    {
+        grpc::Status errorStatus{
+            grpc::StatusCode::INVALID_ARGUMENT, "taker gets malformed"};
+        return {response, errorStatus};
+    }
+
+    if (*pays == *gets)
+    {
+        grpc::Status errorStatus{
+            grpc::StatusCode::INVALID_ARGUMENT, "taker gets same as pays"};
+        return {response, errorStatus};
+    }
+
+    std::optional<uint256> marker;
+    if (!request.marker().empty())
+    {
+        marker = uint256::fromVoidChecked(request.marker());
+        if (!marker)
+        {
+            grpc::Status errorStatus{
+                grpc::StatusCode::INVALID_ARGUMENT, "marker malformed"};
+            return {response, errorStatus};
+        }
+    }
+
+    auto const& range = RPC::Tuning::bookOffers;
+    unsigned int limit = request.limit() ? request.limit() : range.rdefault;
+    if (!isUnlimited(context.role))
+        limit = std::max(range.rmin, std::min(range.rmax, limit));
+
+    BookDirs const dirs(*ledger, {*pays, *gets});
+    auto it = dirs.begin();
+    if (marker)
+    {
+        // Resume after the last offer of the previous page
+        while (it != dirs.end() && (!*it || (*it)->key() != *marker))
+            ++it;
+        if (it == dirs.end())
+        {
+            grpc::Status errorStatus{
+                grpc::StatusCode::NOT_FOUND, "marker not found"};
+            return {response, errorStatus};
+        }
+        ++it;
+    }
+
+    auto& offers = *response.mutable_offers();
+    std::optional<uint256> last;
+    for (; it != dirs.end(); ++it)
+    {
+        auto const& sle = *it;
+        if (!sle)
+            continue;
+
+        if (static_cast<unsigned int>(offers.objects_size()) >= limit)
+        {
+            response.set_marker(last->data(), last->size());
+            break;
+        }
+
+        Serializer s;
+        sle->add(s);
+        auto& offer = *offers.add_objects();
+        offer.set_data(s.peekData().data(), s.getLength());
+        offer.set_key(sle->key().data(), sle->key().size());
+        last = sle->key();
+    }
+
+    response.set_ledger_index(ledger->info().seq);
+    if (!ledger->open())
+        response.set_ledger_hash(
+            ledger->info().hash.data(), ledger->info().hash.size());
+
+    return {response, status};
+}
+
 }  // namespace ripple
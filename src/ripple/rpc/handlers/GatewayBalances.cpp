@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/app/ledger/ObligationsIndex.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/paths/TrustLine.h>
 #include <ripple/ledger/ReadView.h>
@@ -143,8 +144,72 @@ doGatewayBalances(RPC::JsonContext& context)
     std::map<AccountID, std::vector<STAmount>> assets;
     std::map<AccountID, std::vector<STAmount>> frozenBalances;
 
-    // Traverse the cold wallet's trust lines
+    // Start from the indexed balances of the cold wallet and take out the
+    // hot wallets' lines, which are the only ones that need to be read.
+    if (auto const indexed = context.app.getObligationsIndex().getBalances(
+            *ledger, accountID))
     {
+        sums = indexed->obligations;
+        auto frozen = indexed->frozen;
+        auto owed = indexed->assets;
+
+        for (auto const& hotWallet : hotWallets)
+        {
+            std::set<Currency> currencies;
+            for (auto const& [currency, sum] : sums)
+                currencies.insert(currency);
+            for (auto const* balances : {&frozen, &owed})
+            {
+                if (auto const it = balances->find(hotWallet);
+                    it != balances->end())
+                {
+                    for (auto const& [currency, sum] : it->second)
+                        currencies.insert(currency);
+                }
+            }
+
+            for (auto const& currency : currencies)
+            {
+                auto const rs = PathFindTrustLine::makeItem(
+                    accountID,
+                    ledger->read(keylet::line(accountID, hotWallet, currency)));
+                if (!rs || rs->getBalance().signum() == 0)
+                    continue;
+
+                hotBalances[hotWallet].push_back(-rs->getBalance());
+
+                // The index counts what is owed to the hot wallet as an
+                // obligation
+                if (rs->getBalance().signum() < 0 && !rs->getFreeze())
+                {
+                    if (auto const it = sums.find(currency); it != sums.end())
+                    {
+                        it->second += rs->getBalance();
+                        if (it->second.signum() <= 0)
+                            sums.erase(it);
+                    }
+                }
+            }
+            frozen.erase(hotWallet);
+            owed.erase(hotWallet);
+        }
+
+        auto const toVectors =
+            [](std::map<AccountID, std::map<Currency, STAmount>> const& from,
+               std::map<AccountID, std::vector<STAmount>>& to) {
+                for (auto const& [account, balances] : from)
+                {
+                    auto& v = to[account];
+                    for (auto const& [currency, balance] : balances)
+                        v.push_back(balance);
+                }
+            };
+        toVectors(frozen, frozenBalances);
+        toVectors(owed, assets);
+    }
+    else
+    {
+        // Traverse the cold wallet's trust lines
         forEachItem(
             *ledger, accountID, [&](std::shared_ptr<SLE const> const& sle) {
                 auto rs = PathFindTrustLine::makeItem(accountID, sle);
@@ -23,15 +23,18 @@
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/app/rdb/backend/SQLiteDatabase.h>
+#include <ripple/basics/CacheBudget.h>
 #include <ripple/basics/UptimeClock.h>
 #include <ripple/json/json_value.h>
 #include <ripple/ledger/CachedSLEs.h>
 #include <ripple/net/RPCErr.h>
 #include <ripple/nodestore/Database.h>
 #include <ripple/nodestore/DatabaseShard.h>
+#include <ripple/protocol/AccountID.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/rpc/Context.h>
+#include <ripple/shamap/SHAMapItem.h>
 #include <ripple/shamap/ShardFamily.h>
 
 namespace ripple {
@@ -73,6 +76,13 @@ getCountsJson(Application& app, int minObjectCount)
         ret[k] = v;
     }
 
+    {
+        Json::Value& jv = (ret[jss::object_bytes] = Json::objectValue);
+        for (auto const& [k, v] :
+             CountedObjects::getInstance().getBytes(minObjectCount))
+            jv[k] = std::to_string(v);
+    }
+
     if (!app.config().reporting() && app.config().useTxTables())
     {
         auto const db =
@@ -112,6 +122,13 @@ getCountsJson(Application& app, int minObjectCount)
     ret[jss::AL_size] = Json::UInt(app.getAcceptedLedgerCache().size());
     ret[jss::AL_hit_rate] = app.getAcceptedLedgerCache().getHitRate();
 
+    {
+        auto const ids = getAccountIdCacheStats();
+        auto const total = static_cast<float>(ids.hits + ids.misses);
+        ret[jss::AID_size] = Json::UInt(ids.size);
+        ret[jss::AID_hit_rate] = ids.hits * (100.0f / std::max(1.0f, total));
+    }
+
     ret[jss::fullbelow_size] =
         static_cast<int>(app.getNodeFamily().getFullBelowCache(0)->size());
     ret[jss::treenode_cache_size] =
@@ -119,6 +136,17 @@ getCountsJson(Application& app, int minObjectCount)
     ret[jss::treenode_track_size] =
         app.getNodeFamily().getTreeNodeCache(0)->getTrackSize();
 
+    ret[jss::cache_budget] = app.getCacheBudget().getJson();
+
+    {
+        auto const slabs = detail::slabber.stats();
+        Json::Value& jv = (ret[jss::slabs] = Json::objectValue);
+        jv[jss::count] = Json::UInt(slabs.slabs);
+        jv[jss::bytes] = std::to_string(slabs.bytes);
+        jv[jss::items] = std::to_string(slabs.items);
+        jv[jss::in_use] = std::to_string(slabs.inUse);
+    }
+
     std::string uptime;
     auto s = UptimeClock::now();
     using namespace std::chrono_literals;
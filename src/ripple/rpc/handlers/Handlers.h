@@ -43,6 +43,8 @@ doAccountTxJson(RPC::JsonContext&);
 Json::Value
 doAMMInfo(RPC::JsonContext&);
 Json::Value
+doApplyProfile(RPC::JsonContext&);
+Json::Value
 doBookOffers(RPC::JsonContext&);
 Json::Value
 doBookChanges(RPC::JsonContext&);
@@ -75,6 +77,8 @@ doGetCounts(RPC::JsonContext&);
 Json::Value
 doGetAggregatePrice(RPC::JsonContext&);
 Json::Value
+doHeapProfile(RPC::JsonContext&);
+Json::Value
 doLedgerAccept(RPC::JsonContext&);
 Json::Value
 doLedgerCleaner(RPC::JsonContext&);
@@ -127,6 +131,8 @@ doPeerReservationsDel(RPC::JsonContext&);
 Json::Value
 doPeerReservationsList(RPC::JsonContext&);
 Json::Value
+doResourceUsage(RPC::JsonContext&);
+Json::Value
 doRipplePathFind(RPC::JsonContext&);
 Json::Value
 doServerDefinitions(RPC::JsonContext&);
@@ -145,10 +151,14 @@ doStop(RPC::JsonContext&);
 Json::Value
 doSubmit(RPC::JsonContext&);
 Json::Value
+doSubmitBatch(RPC::JsonContext&);
+Json::Value
 doSubmitMultiSigned(RPC::JsonContext&);
 Json::Value
 doSubscribe(RPC::JsonContext&);
 Json::Value
+doTrace(RPC::JsonContext&);
+Json::Value
 doTransactionEntry(RPC::JsonContext&);
 Json::Value
 doTxJson(RPC::JsonContext&);
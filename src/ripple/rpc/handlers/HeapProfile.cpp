@@ -0,0 +1,68 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/HeapProfile.h>
+#include <ripple/json/json_value.h>
+#include <ripple/protocol/ErrorCodes.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/rpc/Context.h>
+
+namespace ripple {
+
+// {
+//   purge: <bool>  // optional; return unused dirty pages to the system
+//   dump: <bool>   // optional; write a heap profile
+// }
+//
+// Returns the allocator's statistics, taken after any purge.
+Json::Value
+doHeapProfile(RPC::JsonContext& context)
+{
+    auto const& params = context.params;
+
+    for (auto const& field : {jss::purge, jss::dump})
+    {
+        if (params.isMember(field) && !params[field].isBool())
+            return RPC::expected_field_error(field, "boolean");
+    }
+
+    auto const requested = [&params](Json::StaticString const& field) {
+        return params.isMember(field) && params[field].asBool();
+    };
+
+    if (requested(jss::purge) && !heapProfile::purge())
+        return RPC::make_error(
+            rpcNOT_SUPPORTED, "The allocator can not purge memory.");
+
+    if (requested(jss::dump))
+    {
+        std::string error;
+        if (!heapProfile::dump(error))
+            return RPC::make_error(rpcNOT_SUPPORTED, error);
+    }
+
+    Json::Value ret = heapProfile::getJson();
+    if (requested(jss::purge))
+        ret[jss::purged] = true;
+    if (requested(jss::dump))
+        ret[jss::dumped] = true;
+    return ret;
+}
+
+}  // namespace ripple
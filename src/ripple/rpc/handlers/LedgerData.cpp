@@ -19,12 +19,14 @@
 
 #include <ripple/app/ledger/LedgerToJson.h>
 #include <ripple/ledger/ReadView.h>
+#include <ripple/net/RPCErr.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/protocol/LedgerFormats.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/GRPCHandlers.h>
 #include <ripple/rpc/Role.h>
+#include <ripple/rpc/impl/LedgerDataStream.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
 #include <ripple/rpc/impl/Tuning.h>
 
@@ -36,6 +38,7 @@ namespace ripple {
 //     marker:       opaque, resume point
 //     binary:       boolean, format
 //     type:         string // optional, defaults to all ledger node types
+//     stream:       boolean, send every node in one streamed response
 //   Outputs:
 //     ledger_hash:  chosen ledger's hash
 //     ledger_index: chosen ledger's index
@@ -93,6 +96,31 @@ doLedgerData(RPC::JsonContext& context)
         rpcStatus.inject(jvResult);
         return jvResult;
     }
+
+    if (params[jss::stream].asBool())
+    {
+        if (!context.stream)
+            return RPC::make_error(
+                rpcNOT_SUPPORTED, "Streaming is not supported here.");
+        if (!isUnlimited(context.role))
+            return rpcError(rpcNO_PERMISSION);
+
+        // Unlike a paged request, a stream has no limit unless one is given.
+        std::optional<std::uint32_t> streamLimit;
+        if (params.isMember(jss::limit) && params[jss::limit].asInt() >= 0)
+            streamLimit = params[jss::limit].asUInt();
+
+        *context.stream = std::make_shared<RPC::LedgerDataStream>(
+            context.app.getJobQueue(),
+            lpLedger,
+            jvResult,
+            key,
+            type,
+            isBinary,
+            streamLimit);
+        return jvResult;
+    }
+
     Json::Value& nodes = jvResult[jss::state];
     if (nodes.type() == Json::nullValue)
     {
@@ -1,3 +1,4 @@
+#include <ripple/app/main/Application.h>
 #include <ripple/rpc/GRPCHandlers.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
 
@@ -50,8 +51,11 @@ doLedgerDiffGrpc(
 
     int maxDifferences = std::numeric_limits<int>::max();
 
-    bool res = baseLedger->stateMap().compare(
-        desiredLedger->stateMap(), differences, maxDifferences);
+    bool res = baseLedger->stateMap().compareParallel(
+        desiredLedger->stateMap(),
+        differences,
+        maxDifferences,
+        context.app.getJobQueue());
     if (!res)
     {
         grpc::Status errorStatus{
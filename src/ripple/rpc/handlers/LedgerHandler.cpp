@@ -193,8 +193,11 @@ doLedgerGrpc(RPC::GRPCContext<org::xrpl::rpc::v1::GetLedgerRequest>& context)
 
         int maxDifferences = std::numeric_limits<int>::max();
 
-        bool res = base->stateMap().compare(
-            desired->stateMap(), differences, maxDifferences);
+        bool res = base->stateMap().compareParallel(
+            desired->stateMap(),
+            differences,
+            maxDifferences,
+            context.app.getJobQueue());
         if (!res)
         {
             grpc::Status errorStatus{
@@ -0,0 +1,48 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/main/Application.h>
+#include <ripple/protocol/ErrorCodes.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/resource/ResourceManager.h>
+#include <ripple/rpc/Context.h>
+
+namespace ripple {
+
+// {
+//   limit: <number>  // optional, the most consumers to report
+// }
+Json::Value
+doResourceUsage(RPC::JsonContext& context)
+{
+    std::size_t limit = 100;
+    if (context.params.isMember(jss::limit))
+    {
+        auto const& jv = context.params[jss::limit];
+        if (!jv.isIntegral() || (jv.isInt() && jv.asInt() < 0))
+            return RPC::expected_field_error(jss::limit, "unsigned integer");
+        limit = jv.asUInt();
+    }
+
+    Json::Value ret(Json::objectValue);
+    ret[jss::consumers] = context.app.getResourceManager().getUsageJson(limit);
+    return ret;
+}
+
+}  // namespace ripple
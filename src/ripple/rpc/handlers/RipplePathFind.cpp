@@ -39,7 +39,9 @@ doRipplePathFind(RPC::JsonContext& context)
     std::shared_ptr<ReadView const> lpLedger;
     Json::Value jvResult;
 
-    if (!context.app.config().standalone() &&
+    // Waiting for the path finding engine suspends the request, which
+    // needs a coroutine. Without one, search the current ledger here.
+    if (context.coro && !context.app.config().standalone() &&
         !context.params.isMember(jss::ledger) &&
         !context.params.isMember(jss::ledger_index) &&
         !context.params.isMember(jss::ledger_hash))
@@ -21,6 +21,8 @@
 #include <ripple/app/misc/HashRouter.h>
 #include <ripple/app/misc/Transaction.h>
 #include <ripple/app/tx/apply.h>
+#include <ripple/core/JobQueue.h>
+#include <ripple/core/ParallelFor.h>
 #include <ripple/net/RPCErr.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/resource/Fees.h>
@@ -28,6 +30,9 @@
 #include <ripple/rpc/GRPCHandlers.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
 #include <ripple/rpc/impl/TransactionSign.h>
+#include <ripple/rpc/impl/Tuning.h>
+
+#include <vector>
 
 namespace ripple {
 
@@ -39,48 +44,22 @@ getFailHard(RPC::JsonContext const& context)
         context.params["fail_hard"].asBool());
 }
 
-// {
-//   tx_json: <object>,
-//   secret: <secret>
-// }
-Json::Value
-doSubmit(RPC::JsonContext& context)
+// Parse a signed transaction and check its signature and local checks.
+// Returns nothing, with the reason in jvResult, if it fails.
+static std::shared_ptr<Transaction>
+prepareBlob(
+    RPC::JsonContext const& context,
+    Json::Value const& blob,
+    Json::Value& jvResult)
 {
-    context.loadType = Resource::feeMediumBurdenRPC;
+    auto ret = strUnHex(blob.asString());
 
-    if (!context.params.isMember(jss::tx_blob))
+    if (!ret || !ret->size())
     {
-        auto const failType = getFailHard(context);
-
-        if (context.role != Role::ADMIN && !context.app.config().canSign())
-            return RPC::make_error(
-                rpcNOT_SUPPORTED, "Signing is not supported by this server.");
-
-        auto ret = RPC::transactionSubmit(
-            context.params,
-            context.apiVersion,
-            failType,
-            context.role,
-            context.ledgerMaster.getValidatedLedgerAge(),
-            context.app,
-            RPC::getProcessTxnFn(context.netOps));
-
-        ret[jss::deprecated] =
-            "Signing support in the 'submit' command has been "
-            "deprecated and will be removed in a future version "
-            "of the server. Please migrate to a standalone "
-            "signing tool.";
-
-        return ret;
+        jvResult = rpcError(rpcINVALID_PARAMS);
+        return {};
     }
 
-    Json::Value jvResult;
-
-    auto ret = strUnHex(context.params[jss::tx_blob].asString());
-
-    if (!ret || !ret->size())
-        return rpcError(rpcINVALID_PARAMS);
-
     SerialIter sitTrans(makeSlice(*ret));
 
     std::shared_ptr<STTx const> stpTrans;
@@ -94,7 +73,7 @@ doSubmit(RPC::JsonContext& context)
         jvResult[jss::error] = "invalidTransaction";
         jvResult[jss::error_exception] = e.what();
 
-        return jvResult;
+        return {};
     }
 
     {
@@ -113,7 +92,7 @@ doSubmit(RPC::JsonContext& context)
             jvResult[jss::error] = "invalidTransaction";
             jvResult[jss::error_exception] = "fails local checks: " + reason;
 
-            return jvResult;
+            return {};
         }
     }
 
@@ -124,42 +103,36 @@ doSubmit(RPC::JsonContext& context)
         jvResult[jss::error] = "invalidTransaction";
         jvResult[jss::error_exception] = "fails local checks: " + reason;
 
-        return jvResult;
+        return {};
     }
 
-    try
-    {
-        auto const failType = getFailHard(context);
-
-        context.netOps.processTransaction(
-            tpTrans, isUnlimited(context.role), true, failType);
-    }
-    catch (std::exception& e)
-    {
-        jvResult[jss::error] = "internalSubmit";
-        jvResult[jss::error_exception] = e.what();
+    return tpTrans;
+}
 
-        return jvResult;
-    }
+// The response to the submission of a transaction which was processed.
+static Json::Value
+submitResponse(Transaction& transaction)
+{
+    Json::Value jvResult;
 
     try
     {
-        jvResult[jss::tx_json] = tpTrans->getJson(JsonOptions::none);
+        jvResult[jss::tx_json] = transaction.getJson(JsonOptions::none);
         jvResult[jss::tx_blob] =
-            strHex(tpTrans->getSTransaction()->getSerializer().peekData());
+            strHex(transaction.getSTransaction()->getSerializer().peekData());
 
-        if (temUNCERTAIN != tpTrans->getResult())
+        if (temUNCERTAIN != transaction.getResult())
         {
             std::string sToken;
             std::string sHuman;
 
-            transResultInfo(tpTrans->getResult(), sToken, sHuman);
+            transResultInfo(transaction.getResult(), sToken, sHuman);
 
             jvResult[jss::engine_result] = sToken;
-            jvResult[jss::engine_result_code] = tpTrans->getResult();
+            jvResult[jss::engine_result_code] = transaction.getResult();
             jvResult[jss::engine_result_message] = sHuman;
 
-            auto const submitResult = tpTrans->getSubmitResult();
+            auto const submitResult = transaction.getSubmitResult();
 
             jvResult[jss::accepted] = submitResult.any();
             jvResult[jss::applied] = submitResult.applied;
@@ -167,7 +140,7 @@ doSubmit(RPC::JsonContext& context)
             jvResult[jss::queued] = submitResult.queued;
             jvResult[jss::kept] = submitResult.kept;
 
-            if (auto currentLedgerState = tpTrans->getCurrentLedgerState())
+            if (auto currentLedgerState = transaction.getCurrentLedgerState())
             {
                 jvResult[jss::account_sequence_next] =
                     safe_cast<Json::Value::UInt>(
@@ -194,4 +167,182 @@ doSubmit(RPC::JsonContext& context)
     }
 }
 
+// {
+//   tx_json: <object>,
+//   secret: <secret>
+// }
+Json::Value
+doSubmit(RPC::JsonContext& context)
+{
+    context.loadType = Resource::feeMediumBurdenRPC;
+
+    if (!context.params.isMember(jss::tx_blob))
+    {
+        auto const failType = getFailHard(context);
+
+        if (context.role != Role::ADMIN && !context.app.config().canSign())
+            return RPC::make_error(
+                rpcNOT_SUPPORTED, "Signing is not supported by this server.");
+
+        auto ret = RPC::transactionSubmit(
+            context.params,
+            context.apiVersion,
+            failType,
+            context.role,
+            context.ledgerMaster.getValidatedLedgerAge(),
+            context.app,
+            RPC::getProcessTxnFn(context.netOps));
+
+        ret[jss::deprecated] =
+            "Signing support in the 'submit' command has been "
+            "deprecated and will be removed in a future version "
+            "of the server. Please migrate to a standalone "
+            "signing tool.";
+
+        return ret;
+    }
+
+    Json::Value jvResult;
+
+    auto tpTrans = prepareBlob(context, context.params[jss::tx_blob], jvResult);
+    if (!tpTrans)
+        return jvResult;
+
+    try
+    {
+        auto const failType = getFailHard(context);
+
+        context.netOps.processTransaction(
+            tpTrans, isUnlimited(context.role), true, failType);
+    }
+    catch (std::exception& e)
+    {
+        jvResult[jss::error] = "internalSubmit";
+        jvResult[jss::error_exception] = e.what();
+
+        return jvResult;
+    }
+
+    return submitResponse(*tpTrans);
+}
+
+// {
+//   transactions: [<tx_blob> or {tx_json: <object>, secret: <secret>}, ...],
+//   fail_hard: <bool>
+// }
+Json::Value
+doSubmitBatch(RPC::JsonContext& context)
+{
+    context.loadType = Resource::feeHighBurdenRPC;
+
+    if (!context.params.isMember(jss::transactions))
+        return RPC::missing_field_error(jss::transactions);
+
+    Json::Value const& requests = context.params[jss::transactions];
+    if (!requests.isArray() || requests.size() > RPC::Tuning::maxSubmitBatch)
+        return RPC::invalid_field_error(jss::transactions);
+
+    auto const failType = getFailHard(context);
+    auto const canSign =
+        context.role == Role::ADMIN || context.app.config().canSign();
+
+    std::vector<std::shared_ptr<Transaction>> transactions(requests.size());
+    std::vector<Json::Value> results(requests.size());
+
+    // Sign, parse and check the signatures of the transactions in parallel
+    parallelFor(
+        context.app.getJobQueue(),
+        jtCLIENT_RPC,
+        "Submit::prepare",
+        requests.size(),
+        ParallelGrain{},
+        [&](std::size_t i) {
+            Json::Value const& request = requests[i];
+
+            try
+            {
+                if (request.isString())
+                {
+                    transactions[i] = prepareBlob(context, request, results[i]);
+                    return true;
+                }
+
+                if (!request.isObject())
+                {
+                    results[i] = rpcError(rpcINVALID_PARAMS);
+                    return true;
+                }
+
+                if (!canSign)
+                {
+                    results[i] = RPC::make_error(
+                        rpcNOT_SUPPORTED,
+                        "Signing is not supported by this server.");
+                    return true;
+                }
+
+                auto const signed_ = RPC::transactionSign(
+                    request,
+                    context.apiVersion,
+                    failType,
+                    context.role,
+                    context.ledgerMaster.getValidatedLedgerAge(),
+                    context.app);
+                if (!signed_.isMember(jss::tx_blob))
+                {
+                    results[i] = signed_;
+                    return true;
+                }
+
+                transactions[i] =
+                    prepareBlob(context, signed_[jss::tx_blob], results[i]);
+            }
+            catch (std::exception& e)
+            {
+                results[i] = Json::objectValue;
+                results[i][jss::error] = "internalSubmit";
+                results[i][jss::error_exception] = e.what();
+            }
+            return true;
+        });
+
+    std::vector<std::shared_ptr<Transaction>> submitted;
+    submitted.reserve(transactions.size());
+    for (auto const& transaction : transactions)
+    {
+        if (transaction)
+            submitted.push_back(transaction);
+    }
+
+    try
+    {
+        context.netOps.processTransactions(
+            submitted, isUnlimited(context.role), failType);
+    }
+    catch (std::exception& e)
+    {
+        Json::Value jvResult;
+        jvResult[jss::error] = "internalSubmit";
+        jvResult[jss::error_exception] = e.what();
+
+        return jvResult;
+    }
+
+    Json::Value jvResult;
+    Json::Value& jvTransactions =
+        (jvResult[jss::transactions] = Json::arrayValue);
+
+    // Report on the canonical objects, which processing may have swapped in
+    auto next = submitted.begin();
+    for (std::size_t i = 0; i < transactions.size(); ++i)
+    {
+        if (transactions[i])
+            jvTransactions.append(submitResponse(**next++));
+        else
+            jvTransactions.append(std::move(results[i]));
+    }
+
+    return jvResult;
+}
+
 }  // namespace ripple
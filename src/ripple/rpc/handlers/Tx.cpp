@@ -19,7 +19,6 @@
 
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/ledger/TransactionMaster.h>
-#include <ripple/app/misc/DeliverMax.h>
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/app/misc/Transaction.h>
 #include <ripple/app/rdb/RelationalDatabase.h>
@@ -105,7 +104,7 @@ doTxPostgres(RPC::Context& context, TxArgs const& args)
                 locator.getNodestoreHash(), locator.getLedgerSequence()))
         {
             auto node = SHAMapTreeNode::makeFromPrefix(
-                makeSlice(obj->getData()),
+                obj->getData(),
                 SHAMapHash{locator.getNodestoreHash()});
             if (!node)
             {
@@ -331,18 +330,9 @@ populateJsonResponse(
         auto const& sttx = result.txn->getSTransaction();
         if (context.apiVersion > 1)
         {
-            constexpr auto optionsJson =
-                JsonOptions::include_date | JsonOptions::disable_API_prior_V2;
-            if (args.binary)
-                response[jss::tx_blob] = result.txn->getJson(optionsJson, true);
-            else
-            {
-                response[jss::tx_json] = result.txn->getJson(optionsJson);
-                RPC::insertDeliverMax(
-                    response[jss::tx_json],
-                    sttx->getTxnType(),
-                    context.apiVersion);
-            }
+            response[args.binary ? jss::tx_blob : jss::tx_json] =
+                result.txn->getApiJson(
+                    context.apiVersion, JsonOptions::include_date, args.binary);
 
             // Note, result.ledgerHash is only set in a closed or validated
             // ledger - as seen in `doTxHelp` and `doTxPostgres`
@@ -360,11 +350,8 @@ populateJsonResponse(
         }
         else
         {
-            response =
-                result.txn->getJson(JsonOptions::include_date, args.binary);
-            if (!args.binary)
-                RPC::insertDeliverMax(
-                    response, sttx->getTxnType(), context.apiVersion);
+            response = result.txn->getApiJson(
+                context.apiVersion, JsonOptions::include_date, args.binary);
         }
 
         // populate binary metadata
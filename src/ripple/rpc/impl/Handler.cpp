@@ -91,6 +91,7 @@ Handler const handlerArray[]{
     {"account_offers", byRef(&doAccountOffers), Role::USER, NO_CONDITION},
     {"account_tx", byRef(&doAccountTxJson), Role::USER, NO_CONDITION},
     {"amm_info", byRef(&doAMMInfo), Role::USER, NO_CONDITION},
+    {"apply_profile", byRef(&doApplyProfile), Role::ADMIN, NO_CONDITION},
     {"blacklist", byRef(&doBlackList), Role::ADMIN, NO_CONDITION},
     {"book_changes", byRef(&doBookChanges), Role::USER, NO_CONDITION},
     {"book_offers", byRef(&doBookOffers), Role::USER, NO_CONDITION},
@@ -118,6 +119,7 @@ Handler const handlerArray[]{
      byRef(&doGetAggregatePrice),
      Role::USER,
      NO_CONDITION},
+    {"heap_profile", byRef(&doHeapProfile), Role::ADMIN, NO_CONDITION},
     {"ledger_accept",
      byRef(&doLedgerAccept),
      Role::ADMIN,
@@ -162,6 +164,7 @@ Handler const handlerArray[]{
      byRef(&doPeerReservationsList),
      Role::ADMIN,
      NO_CONDITION},
+    {"resource_usage", byRef(&doResourceUsage), Role::ADMIN, NO_CONDITION},
     {"ripple_path_find", byRef(&doRipplePathFind), Role::USER, NO_CONDITION},
     {"server_definitions",
      byRef(&doServerDefinitions),
@@ -173,10 +176,12 @@ Handler const handlerArray[]{
     {"sign_for", byRef(&doSignFor), Role::USER, NO_CONDITION},
     {"stop", byRef(&doStop), Role::ADMIN, NO_CONDITION},
     {"submit", byRef(&doSubmit), Role::USER, NEEDS_CURRENT_LEDGER},
+    {"submit_batch", byRef(&doSubmitBatch), Role::USER, NEEDS_CURRENT_LEDGER},
     {"submit_multisigned",
      byRef(&doSubmitMultiSigned),
      Role::USER,
      NEEDS_CURRENT_LEDGER},
+    {"trace", byRef(&doTrace), Role::ADMIN, NO_CONDITION},
     {"transaction_entry", byRef(&doTransactionEntry), Role::USER, NO_CONDITION},
     {"tx", byRef(&doTxJson), Role::USER, NEEDS_NETWORK_CONNECTION},
     {"tx_history", byRef(&doTxHistory), Role::USER, NO_CONDITION, 1, 1},
@@ -0,0 +1,246 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/contract.h>
+#include <ripple/core/JobQueue.h>
+#include <ripple/json/Output.h>
+#include <ripple/protocol/STLedgerEntry.h>
+#include <ripple/protocol/Serializer.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/protocol/serialize.h>
+#include <ripple/protocol/writeJson.h>
+#include <ripple/rpc/impl/LedgerDataStream.h>
+#include <ripple/rpc/impl/Tuning.h>
+
+namespace ripple {
+namespace RPC {
+
+namespace {
+
+void
+appendRecord(std::string& out, uint256 const& key, Slice data)
+{
+    out.append(reinterpret_cast<char const*>(key.data()), uint256::bytes);
+    auto const size = static_cast<std::uint32_t>(data.size());
+    for (int shift = 24; shift >= 0; shift -= 8)
+        out.push_back(static_cast<char>((size >> shift) & 0xff));
+    out.append(reinterpret_cast<char const*>(data.data()), data.size());
+}
+
+}  // namespace
+
+LedgerDataStream::LedgerDataStream(
+    JobQueue& jobQueue,
+    std::shared_ptr<ReadView const> ledger,
+    Json::Value const& header,
+    uint256 const& marker,
+    LedgerEntryType type,
+    bool binary,
+    std::optional<std::uint32_t> limit)
+    : jobQueue_(jobQueue)
+    , ledger_(std::move(ledger))
+    , type_(type)
+    , binary_(binary)
+    , remaining_(limit)
+    , prefix_("{")
+    , suffix_("}")
+    , key_(marker)
+{
+    // Keep the fields of the header without the braces around them.
+    std::string fields;
+    Json::outputJson(header, Json::stringOutput(fields));
+    if (fields.size() > 2)
+        header_ = fields.substr(1, fields.size() - 2) + ",";
+}
+
+void
+LedgerDataStream::setEnvelope(std::string prefix, std::string suffix)
+{
+    std::lock_guard lock(mutex_);
+    if (started_)
+        LogicError("LedgerDataStream::setEnvelope : already started");
+    prefix_ = std::move(prefix);
+    suffix_ = std::move(suffix);
+}
+
+void
+LedgerDataStream::useRawFormat()
+{
+    std::lock_guard lock(mutex_);
+    if (started_ || !binary_)
+        LogicError("LedgerDataStream::useRawFormat : invalid");
+    raw_ = true;
+}
+
+bool
+LedgerDataStream::prepare(std::function<void()> resume)
+{
+    std::lock_guard lock(mutex_);
+    if (consumed_ < buffer_.size() || finished_)
+        return true;
+    if (filling_)
+        return false;
+
+    filling_ = true;
+    if (jobQueue_.addJob(
+            jtCLIENT_RPC,
+            "LedgerDataStream",
+            [self = shared_from_this(), resume = std::move(resume)]() {
+                self->fill();
+                resume();
+            }))
+        return false;
+
+    // The server is stopping; end the stream where it is, so that the
+    // client can pick it up again from the marker.
+    filling_ = false;
+    buffer_.clear();
+    consumed_ = 0;
+    if (!started_)
+        start(buffer_);
+    finish(buffer_, key_);
+    finished_ = true;
+    return true;
+}
+
+boost::asio::const_buffer
+LedgerDataStream::data() const
+{
+    std::lock_guard lock(mutex_);
+    return {buffer_.data() + consumed_, buffer_.size() - consumed_};
+}
+
+void
+LedgerDataStream::consume(std::size_t bytes)
+{
+    std::lock_guard lock(mutex_);
+    consumed_ = std::min(consumed_ + bytes, buffer_.size());
+}
+
+bool
+LedgerDataStream::complete() const
+{
+    std::lock_guard lock(mutex_);
+    return finished_ && consumed_ == buffer_.size();
+}
+
+void
+LedgerDataStream::start(std::string& out)
+{
+    started_ = true;
+    if (!raw_)
+        out += prefix_ + header_ + "\"state\":[";
+}
+
+void
+LedgerDataStream::finish(
+    std::string& out,
+    std::optional<uint256> const& marker)
+{
+    if (raw_)
+    {
+        if (marker)
+            appendRecord(
+                out, uint256{}, Slice{marker->data(), uint256::bytes});
+        else
+            appendRecord(out, uint256{}, {});
+        return;
+    }
+
+    out += "]";
+    if (marker)
+        out += ",\"marker\":\"" + to_string(*marker) + "\"";
+    out += suffix_;
+}
+
+void
+LedgerDataStream::fill()
+{
+    // Only one fill runs at a time and the transport waits for it, so the
+    // objects are written to a separate string without holding the lock.
+    std::string out;
+    out.reserve(Tuning::streamChunkSize + 4096);
+
+    if (!started_)
+        start(out);
+
+    bool end = true;
+    std::optional<uint256> marker;
+    auto const e = ledger_->sles.end();
+    for (auto i = ledger_->sles.upper_bound(key_); i != e; ++i)
+    {
+        if (out.size() >= Tuning::streamChunkSize)
+        {
+            end = false;
+            break;
+        }
+
+        if (remaining_)
+        {
+            if (*remaining_ == 0)
+            {
+                // Stop before the current key.
+                marker = key_;
+                break;
+            }
+            --*remaining_;
+        }
+
+        auto const& sle = *i;
+        key_ = sle->key();
+        if (type_ != ltANY && sle->getType() != type_)
+            continue;
+
+        if (raw_)
+        {
+            Serializer s;
+            sle->add(s);
+            appendRecord(out, key_, s.slice());
+            continue;
+        }
+
+        if (!first_)
+            out += ",";
+        first_ = false;
+
+        if (binary_)
+        {
+            Json::Value entry(Json::objectValue);
+            entry[jss::data] = serializeHex(*sle);
+            entry[jss::index] = to_string(key_);
+            Json::outputJson(entry, Json::stringOutput(out));
+        }
+        else
+        {
+            outputJson(*sle, Json::stringOutput(out), JsonOptions::none);
+        }
+    }
+
+    if (end)
+        finish(out, marker);
+
+    std::lock_guard lock(mutex_);
+    buffer_ = std::move(out);
+    consumed_ = 0;
+    filling_ = false;
+    finished_ = end;
+}
+
+}  // namespace RPC
+}  // namespace ripple
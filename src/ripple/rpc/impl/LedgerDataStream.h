@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_RPC_LEDGERDATASTREAM_H_INCLUDED
+#define RIPPLE_RPC_LEDGERDATASTREAM_H_INCLUDED
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/json/json_value.h>
+#include <ripple/ledger/ReadView.h>
+#include <ripple/protocol/LedgerFormats.h>
+#include <boost/asio/buffer.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace ripple {
+
+class JobQueue;
+
+namespace RPC {
+
+/** Produces the state of a ledger as one long ledger_data response.
+
+    Instead of building the whole response as a Json::Value, the objects
+    are serialized a chunk at a time into a small buffer which the
+    transport drains. A chunk is only produced once the previous one has
+    been taken, so a slow client holds back the producer rather than
+    making the server buffer the ledger. Chunks are produced on the
+    JobQueue; the transport is told through the resume callback when one
+    is ready.
+
+    The default format is JSON: the fields of the header followed by
+    "state", the array of objects, exactly as ledger_data would return
+    them. The transport supplies the text which surrounds the result in
+    its responses. The raw format is a sequence of records, each a 32 byte
+    key, a 4 byte big endian length and the serialized object. The stream
+    ends with a record with a zero key: its data is empty if the stream is
+    complete, or else holds the key to pass as the marker to resume.
+
+    If the stream stops early, because of the limit or because the server
+    is stopping, the JSON format ends with a "marker" like a paged request.
+*/
+class LedgerDataStream : public std::enable_shared_from_this<LedgerDataStream>
+{
+public:
+    LedgerDataStream(
+        JobQueue& jobQueue,
+        std::shared_ptr<ReadView const> ledger,
+        Json::Value const& header,
+        uint256 const& marker,
+        LedgerEntryType type,
+        bool binary,
+        std::optional<std::uint32_t> limit);
+
+    LedgerDataStream(LedgerDataStream const&) = delete;
+    LedgerDataStream&
+    operator=(LedgerDataStream const&) = delete;
+
+    /** Whether the objects were requested in binary. */
+    bool
+    binary() const
+    {
+        return binary_;
+    }
+
+    /** Set the text written before and after the result object.
+
+        prefix must end by opening the result object and suffix must start
+        by closing it. Must be called before the first prepare.
+    */
+    void
+    setEnvelope(std::string prefix, std::string suffix);
+
+    /** Write raw records instead of JSON. Requires binary(). */
+    void
+    useRawFormat();
+
+    /** Make data available.
+
+        @return `true` if data() may be called, or `false` if resume will
+                be called once it may.
+    */
+    bool
+    prepare(std::function<void()> resume);
+
+    /** The data produced and not yet consumed. Empty once complete. */
+    boost::asio::const_buffer
+    data() const;
+
+    /** Remove bytes from the start of data(). */
+    void
+    consume(std::size_t bytes);
+
+    /** Returns `true` once everything has been produced and consumed. */
+    bool
+    complete() const;
+
+private:
+    // Serialize objects until the buffer holds a chunk or the end is
+    // reached.
+    void
+    fill();
+
+    // Write the text which opens the stream.
+    void
+    start(std::string& out);
+
+    // Write the text which ends the stream, with the key to resume from if
+    // it stopped early.
+    void
+    finish(std::string& out, std::optional<uint256> const& marker);
+
+    JobQueue& jobQueue_;
+    std::shared_ptr<ReadView const> const ledger_;
+    LedgerEntryType const type_;
+    bool const binary_;
+    std::optional<std::uint32_t> remaining_;
+
+    mutable std::mutex mutex_;
+    std::string header_;
+    std::string prefix_;
+    std::string suffix_;
+    bool raw_ = false;
+    bool started_ = false;
+    bool filling_ = false;
+    bool finished_ = false;
+    bool first_ = true;
+
+    // Objects after this key remain to be written.
+    uint256 key_;
+
+    std::string buffer_;
+    std::size_t consumed_ = 0;
+};
+
+}  // namespace RPC
+}  // namespace ripple
+
+#endif
@@ -21,6 +21,7 @@
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/ledger/LedgerToJson.h>
 #include <ripple/app/main/Application.h>
+#include <ripple/app/main/LoadManager.h>
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/app/reporting/P2pProxy.h>
 #include <ripple/basics/Log.h>
@@ -32,16 +33,21 @@
 #include <ripple/json/to_string.h>
 #include <ripple/net/InfoSub.h>
 #include <ripple/net/RPCErr.h>
+#include <ripple/nodestore/FetchSuspender.h>
 #include <ripple/protocol/ErrorCodes.h>
+#include <ripple/protocol/digest.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/resource/Fees.h>
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/RPCHandler.h>
+#include <ripple/rpc/ResponseCache.h>
 #include <ripple/rpc/Role.h>
 #include <ripple/rpc/impl/Handler.h>
 #include <ripple/rpc/impl/Tuning.h>
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <optional>
 #include <variant>
 
 namespace ripple {
@@ -141,6 +147,16 @@ fillHandler(JsonContext& context, Handler const*& result)
             JLOG(context.j.debug()) << "Too busy for command: " << jobCount;
             return rpcTOO_BUSY;
         }
+
+        // While client requests wait too long to run, turn away the
+        // clients which have used the most so the others are still served.
+        if (context.app.getLoadManager().isOverloaded(LoadManager::rpc) &&
+            context.consumer.disposition() != Resource::ok)
+        {
+            JLOG(context.j.debug())
+                << "Too busy for consumer: " << context.consumer;
+            return rpcTOO_BUSY;
+        }
     }
 
     if (!context.params.isMember(jss::command) &&
@@ -179,6 +195,32 @@ fillHandler(JsonContext& context, Handler const*& result)
     return rpcSUCCESS;
 }
 
+// Suspends the request's coroutine while its NodeStore fetches are made
+class CoroFetchSuspender : public NodeStore::FetchSuspender
+{
+    JobQueue::Coro& coro_;
+
+public:
+    explicit CoroFetchSuspender(JobQueue::Coro& coro) : coro_(coro)
+    {
+    }
+
+    void
+    suspend() override
+    {
+        coro_.yield();
+    }
+
+    void
+    resume() override
+    {
+        // If the JobQueue is stopping, finish the request on this thread
+        // so that shutdown does not wait on it forever.
+        if (!coro_.post())
+            coro_.resume();
+    }
+};
+
 template <class Object, class Method>
 Status
 callMethod(
@@ -196,10 +238,29 @@ callMethod(
         auto v =
             context.app.getJobQueue().makeLoadEvent(jtGENERIC, "cmd:" + name);
 
+        std::optional<CoroFetchSuspender> suspender;
+        std::optional<NodeStore::FetchSuspender::Scope> suspending;
+        if (context.coro &&
+            std::find(
+                fetchSuspendingMethods.begin(),
+                fetchSuspendingMethods.end(),
+                name) != fetchSuspendingMethods.end())
+        {
+            suspender.emplace(*context.coro);
+            suspending.emplace(*suspender);
+        }
+
         auto start = std::chrono::system_clock::now();
         auto ret = method(context, result);
         auto end = std::chrono::system_clock::now();
 
+        // Requests cost twice as much while client requests are backed up,
+        // so the clients making the most are warned and shed first.
+        if (!isUnlimited(context.role) &&
+            context.app.getLoadManager().isOverloaded(LoadManager::rpc))
+            context.loadType = Resource::Charge(
+                2 * context.loadType.cost(), context.loadType.label());
+
         JLOG(context.j.debug())
             << "RPC call " << name << " completed in "
             << ((end - start).count() / 1000000000.0) << "seconds";
@@ -224,6 +285,35 @@ callMethod(
     }
 }
 
+// Call the method, sharing the response with identical requests if the
+// method's responses are cached.
+Status
+callCachedMethod(
+    JsonContext& context,
+    Handler const& handler,
+    Json::Value& result)
+{
+    auto const call = [&context, &handler](Json::Value& r) {
+        return callMethod(context, handler.valueMethod_, handler.name_, r);
+    };
+
+    auto& cache = context.app.getRPCResponseCache();
+    if (context.app.config().reporting() || !cache.enabled(handler.name_))
+        return call(result);
+
+    auto const validated = context.ledgerMaster.getValidatedLedger();
+    auto const closed = context.ledgerMaster.getClosedLedger();
+    if (!validated || !closed)
+        return call(result);
+
+    return cache.fetch(
+        ResponseCache::makeKey(
+            handler.name_, context.params, context.apiVersion, context.role),
+        sha512Half(validated->info().hash, closed->info().hash),
+        result,
+        call);
+}
+
 }  // namespace
 
 void
@@ -263,7 +353,7 @@ doCommand(RPC::JsonContext& context, Json::Value& result)
         return error;
     }
 
-    if (auto method = handler->valueMethod_)
+    if (handler->valueMethod_)
     {
         if (!context.headers.user.empty() ||
             !context.headers.forwardedFor.empty())
@@ -273,7 +363,7 @@ doCommand(RPC::JsonContext& context, Json::Value& result)
                 << ", user: " << context.headers.user
                 << ", forwarded for: " << context.headers.forwardedFor;
 
-            auto ret = callMethod(context, method, handler->name_, result);
+            auto ret = callCachedMethod(context, *handler, result);
 
             JLOG(context.j.debug())
                 << "finish command: " << handler->name_
@@ -284,7 +374,7 @@ doCommand(RPC::JsonContext& context, Json::Value& result)
         }
         else
         {
-            auto ret = callMethod(context, method, handler->name_, result);
+            auto ret = callCachedMethod(context, *handler, result);
             injectReportingWarning(context, result);
             return ret;
         }
@@ -96,18 +96,24 @@ accountFromString(AccountID& result, std::string const& strIdent, bool bStrict)
 std::uint64_t
 getStartHint(std::shared_ptr<SLE const> const& sle, AccountID const& accountID)
 {
-    if (sle->getType() == ltRIPPLE_STATE)
+    return getStartHint(SLEView(sle), accountID);
+}
+
+std::uint64_t
+getStartHint(SLEView const& sle, AccountID const& accountID)
+{
+    if (sle.getType() == ltRIPPLE_STATE)
     {
-        if (sle->getFieldAmount(sfLowLimit).getIssuer() == accountID)
-            return sle->getFieldU64(sfLowNode);
-        else if (sle->getFieldAmount(sfHighLimit).getIssuer() == accountID)
-            return sle->getFieldU64(sfHighNode);
+        if (sle.getFieldAmount(sfLowLimit).getIssuer() == accountID)
+            return sle.getFieldU64(sfLowNode);
+        else if (sle.getFieldAmount(sfHighLimit).getIssuer() == accountID)
+            return sle.getFieldU64(sfHighNode);
     }
 
-    if (!sle->isFieldPresent(sfOwnerNode))
+    if (!sle.isFieldPresent(sfOwnerNode))
         return 0;
 
-    return sle->getFieldU64(sfOwnerNode);
+    return sle.getFieldU64(sfOwnerNode);
 }
 
 bool
@@ -280,12 +286,15 @@ getAccountObjects(
 
         for (; iter != entries.end(); ++iter)
         {
-            auto const sleNode = ledger.read(keylet::child(*iter));
+            // Only the type of an entry is needed to filter it, so entries
+            // are deserialized only once they are known to be returned.
+            auto const node = ledger.readLazy(keylet::child(*iter));
 
-            if (!typeFilter.has_value() ||
-                typeMatchesFilter(typeFilter.value(), sleNode->getType()))
+            if (node &&
+                (!typeFilter.has_value() ||
+                 typeMatchesFilter(typeFilter.value(), node->getType())))
             {
-                jvObjects.append(sleNode->getJson(JsonOptions::none));
+                jvObjects.append(node->sle()->getJson(JsonOptions::none));
             }
 
             if (++i == mlimit)
@@ -416,6 +425,18 @@ ledgerFromRequest<>(
     std::shared_ptr<ReadView const>&,
     GRPCContext<org::xrpl::rpc::v1::GetLedgerRequest>&);
 
+// explicit instantiation of above function
+template Status
+ledgerFromRequest<>(
+    std::shared_ptr<ReadView const>&,
+    GRPCContext<org::xrpl::rpc::v1::GetAccountInfoRequest>&);
+
+// explicit instantiation of above function
+template Status
+ledgerFromRequest<>(
+    std::shared_ptr<ReadView const>&,
+    GRPCContext<org::xrpl::rpc::v1::GetBookOffersRequest>&);
+
 template <class T>
 Status
 ledgerFromSpecifier(
@@ -79,6 +79,9 @@ accountFromStringWithCode(
 std::uint64_t
 getStartHint(std::shared_ptr<SLE const> const& sle, AccountID const& accountID);
 
+std::uint64_t
+getStartHint(SLEView const& sle, AccountID const& accountID);
+
 /**
  * Tests if a SLE is owned by accountID.
  * @param ledger - The ledger used to search for the sle.
@@ -0,0 +1,179 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/Log.h>
+#include <ripple/json/to_string.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/rpc/ResponseCache.h>
+
+namespace ripple {
+namespace RPC {
+
+namespace {
+
+// The methods which only query ledgers or server state, and so may safely
+// share a response between identical requests.
+std::set<std::string> const cacheableMethods = {
+    "account_channels", "account_currencies", "account_info",
+    "account_lines",    "account_nfts",       "account_objects",
+    "account_offers",   "amm_info",           "book_changes",
+    "book_offers",      "deposit_authorized", "fee",
+    "gateway_balances", "ledger",             "ledger_closed",
+    "ledger_current",   "ledger_data",        "ledger_entry",
+    "ledger_header",    "nft_buy_offers",     "nft_sell_offers",
+    "noripple_check",   "server_definitions", "server_info",
+    "server_state",     "transaction_entry",  "tx",
+};
+
+}  // namespace
+
+ResponseCache::ResponseCache(
+    std::vector<std::string> const& methods,
+    beast::Journal journal,
+    std::size_t size)
+    : size_(size)
+{
+    for (auto const& method : methods)
+    {
+        if (cacheableMethods.count(method))
+            methods_.insert(method);
+        else
+            JLOG(journal.warn())
+                << "Responses to RPC method " << method << " can't be cached";
+    }
+}
+
+bool
+ResponseCache::enabled(std::string const& method) const
+{
+    return methods_.count(method) != 0;
+}
+
+std::string
+ResponseCache::makeKey(
+    std::string const& method,
+    Json::Value const& params,
+    unsigned int apiVersion,
+    Role role)
+{
+    // Object members are kept sorted, so equal parameters give equal text
+    Json::Value canonical = params;
+    canonical.removeMember(jss::id);
+    canonical.removeMember(jss::command);
+    canonical.removeMember(jss::method);
+
+    return method + ' ' + std::to_string(apiVersion) + ' ' +
+        std::to_string(static_cast<int>(role)) + ' ' + to_string(canonical);
+}
+
+Status
+ResponseCache::fetch(
+    std::string const& key,
+    uint256 const& ledgers,
+    Json::Value& result,
+    std::function<Status(Json::Value&)> const& compute)
+{
+    std::shared_ptr<Entry> entry;
+
+    {
+        std::unique_lock lock(mutex_);
+
+        if (ledgers != ledgers_)
+        {
+            entries_.clear();
+            ledgers_ = ledgers;
+        }
+
+        if (auto const it = entries_.find(key); it != entries_.end())
+        {
+            auto const found = it->second;
+            bool const done = cond_.wait_for(
+                lock, maxWait, [&found] { return found->done; });
+
+            if (done && found->valid)
+            {
+                result = found->result;
+                return found->status;
+            }
+
+            // The request is taking too long or failed: run it ourselves
+        }
+        else if (entries_.size() < size_)
+        {
+            entry = std::make_shared<Entry>();
+            entries_.emplace(key, entry);
+        }
+    }
+
+    if (!entry)
+        return compute(result);
+
+    Status status;
+    try
+    {
+        status = compute(result);
+    }
+    catch (...)
+    {
+        complete(key, entry, nullptr, nullptr);
+        throw;
+    }
+
+    complete(key, entry, &status, &result);
+    return status;
+}
+
+void
+ResponseCache::complete(
+    std::string const& key,
+    std::shared_ptr<Entry> const& entry,
+    Status const* status,
+    Json::Value const* result)
+{
+    std::lock_guard lock(mutex_);
+
+    entry->done = true;
+    if (status && result)
+    {
+        // Requests waiting for this one share the response even if it is
+        // an error, but only successful responses are kept.
+        entry->valid = true;
+        entry->status = *status;
+        entry->result = *result;
+    }
+
+    if (!entry->valid || *status || result->isMember(jss::error))
+    {
+        if (auto const it = entries_.find(key);
+            it != entries_.end() && it->second == entry)
+            entries_.erase(it);
+    }
+
+    cond_.notify_all();
+}
+
+std::size_t
+ResponseCache::size() const
+{
+    std::lock_guard lock(mutex_);
+    return entries_.size();
+}
+
+}  // namespace RPC
+}  // namespace ripple
@@ -35,10 +35,13 @@
 #include <ripple/overlay/Overlay.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/resource/Fees.h>
+#include <ripple/resource/MeasuredCost.h>
 #include <ripple/resource/ResourceManager.h>
 #include <ripple/rpc/RPCHandler.h>
 #include <ripple/rpc/Role.h>
+#include <ripple/rpc/impl/LedgerDataStream.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
+#include <ripple/rpc/impl/StreamedResponse.h>
 #include <ripple/rpc/impl/Tuning.h>
 #include <ripple/rpc/json_body.h>
 #include <ripple/server/Server.h>
@@ -104,6 +107,7 @@ ServerHandler::ServerHandler(
     ServerHandlerCreator const&,
     Application& app,
     boost::asio::io_service& io_service,
+    boost::asio::io_service& peer_io_service,
     JobQueue& jobQueue,
     NetworkOPs& networkOPs,
     Resource::Manager& resourceManager,
@@ -112,7 +116,11 @@ ServerHandler::ServerHandler(
     , m_resourceManager(resourceManager)
     , m_journal(app_.journal("Server"))
     , m_networkOPs(networkOPs)
-    , m_server(make_Server(*this, io_service, app_.journal("Server")))
+    , m_server(make_Server(
+          *this,
+          io_service,
+          peer_io_service,
+          app_.journal("Server")))
     , m_jobQueue(jobQueue)
 {
     auto const& group(cm.group("rpc"));
@@ -271,6 +279,54 @@ buffers_to_string(ConstBufferSequence const& bs)
     return s;
 }
 
+// Returns true if requests for the method may suspend while they wait,
+// which needs a coroutine: ripple_path_find does while the path finding
+// engine works, and some methods do while their NodeStore fetches are
+// made.
+static bool
+needsCoro(std::string_view method)
+{
+    return method == "ripple_path_find" ||
+        std::find(
+            RPC::fetchSuspendingMethods.begin(),
+            RPC::fetchSuspendingMethods.end(),
+            method) != RPC::fetchSuspendingMethods.end();
+}
+
+// As above, for a request which has not been parsed yet, so that the test
+// can be made before it is: any such method name in quotes counts. A false
+// positive costs only a coroutine.
+static bool
+mayNeedCoro(std::string_view request)
+{
+    for (auto pos = request.find('"'); pos != std::string_view::npos;)
+    {
+        auto const end = request.find('"', pos + 1);
+        if (end == std::string_view::npos)
+            break;
+        if (needsCoro(request.substr(pos + 1, end - pos - 1)))
+            return true;
+        pos = request.find('"', end + 1);
+    }
+    return false;
+}
+
+template <class F>
+bool
+ServerHandler::postRequest(
+    bool needsCoro,
+    JobType type,
+    std::string const& name,
+    F&& f)
+{
+    if (needsCoro)
+        return m_jobQueue.postCoro(type, name, std::forward<F>(f)) != nullptr;
+
+    return m_jobQueue.addJob(type, name, [f = std::forward<F>(f)]() mutable {
+        f(std::shared_ptr<JobQueue::Coro>{});
+    });
+}
+
 void
 ServerHandler::onRequest(Session& session)
 {
@@ -291,16 +347,20 @@ ServerHandler::onRequest(Session& session)
         return;
     }
 
+    auto request = buffers_to_string(session.request().body().data());
+    auto const coroutine = mayNeedCoro(request);
     std::shared_ptr<Session> detachedSession = session.detach();
-    auto const postResult = m_jobQueue.postCoro(
+    auto const posted = postRequest(
+        coroutine,
         jtCLIENT_RPC,
         "RPC-Client",
-        [this, detachedSession](std::shared_ptr<JobQueue::Coro> coro) {
-            processSession(detachedSession, coro);
+        [this, detachedSession, request = std::move(request)](
+            std::shared_ptr<JobQueue::Coro> coro) {
+            processSession(detachedSession, coro, request);
         });
-    if (postResult == nullptr)
+    if (!posted)
     {
-        // The coroutine was rejected, probably because we're shutting down.
+        // The job was rejected, probably because we're shutting down.
         HTTPReply(
             503,
             "Service Unavailable",
@@ -339,12 +399,27 @@ ServerHandler::onWSMessage(
 
     JLOG(m_journal.trace()) << "Websocket received '" << jv << "'";
 
-    auto const postResult = m_jobQueue.postCoro(
+    bool coroutine = false;
+    for (auto const& field : {jss::command, jss::method})
+    {
+        if (jv.isMember(field) && jv[field].isString() &&
+            needsCoro(jv[field].asString()))
+            coroutine = true;
+    }
+    auto const posted = postRequest(
+        coroutine,
         jtCLIENT_WEBSOCKET,
         "WS-Client",
         [this, session, jv = std::move(jv)](
             std::shared_ptr<JobQueue::Coro> const& coro) {
-            auto const jr = this->processSession(session, coro, jv);
+            std::shared_ptr<RPC::LedgerDataStream> stream;
+            auto const jr = this->processSession(session, coro, jv, stream);
+            if (stream)
+            {
+                session->send(std::make_shared<RPC::StreamWSMsg>(stream));
+                session->complete();
+                return;
+            }
             auto const s = to_string(jr);
             auto const n = s.length();
             boost::beast::multi_buffer sb(n);
@@ -354,9 +429,9 @@ ServerHandler::onWSMessage(
                 std::make_shared<StreambufWSMsg<decltype(sb)>>(std::move(sb)));
             session->complete();
         });
-    if (postResult == nullptr)
+    if (!posted)
     {
-        // The coroutine was rejected, probably because we're shutting down.
+        // The job was rejected, probably because we're shutting down.
         session->close({boost::beast::websocket::going_away, "Shutting Down"});
     }
 }
@@ -401,7 +476,8 @@ Json::Value
 ServerHandler::processSession(
     std::shared_ptr<WSSession> const& session,
     std::shared_ptr<JobQueue::Coro> const& coro,
-    Json::Value const& jv)
+    Json::Value const& jv,
+    std::shared_ptr<RPC::LedgerDataStream>& stream)
 {
     auto is = std::static_pointer_cast<WSInfoSub>(session->appDefined);
     if (is->getConsumer().disconnect(m_journal))
@@ -477,7 +553,10 @@ ServerHandler::processSession(
                  apiVersion},
                 jv,
                 {is->user(), is->forwarded_for()}};
+            context.stream = &stream;
 
+            // A coroutine may suspend, so only its wall time is measured.
+            Resource::MeasuredCost cost(is->getConsumer(), !coro);
             auto start = std::chrono::system_clock::now();
             RPC::doCommand(context, jr[jss::result]);
             auto end = std::chrono::system_clock::now();
@@ -540,18 +619,36 @@ ServerHandler::processSession(
         jr[jss::api_version] = jv[jss::api_version];
 
     jr[jss::type] = jss::response;
+
+    if (stream)
+    {
+        if (jr[jss::status] != jss::success)
+        {
+            stream.reset();
+            return jr;
+        }
+
+        // The streamed result replaces "result" in the response.
+        jr.removeMember(jss::result);
+        std::string fields;
+        Json::outputJson(jr, Json::stringOutput(fields));
+        fields[0] = ',';
+        stream->setEnvelope("{\"result\":{", "}" + fields);
+    }
     return jr;
 }
 
-// Run as a coroutine.
+// Run as a job, in a coroutine if the request may suspend.
 void
 ServerHandler::processSession(
     std::shared_ptr<Session> const& session,
-    std::shared_ptr<JobQueue::Coro> coro)
+    std::shared_ptr<JobQueue::Coro> coro,
+    std::string const& request)
 {
+    std::shared_ptr<RPC::LedgerDataStream> stream;
     processRequest(
         session->port(),
-        buffers_to_string(session->request().body().data()),
+        request,
         session->remoteAddress().at_port(0),
         makeOutput(*session),
         coro,
@@ -561,7 +658,25 @@ ServerHandler::processSession(
             if (iter != session->request().end())
                 return iter->value();
             return boost::beast::string_view{};
-        }());
+        }(),
+        stream);
+
+    if (stream)
+    {
+        auto const keepAlive =
+            beast::rfc2616::is_keep_alive(session->request());
+        if (stream->binary())
+            stream->useRawFormat();
+        session->write(
+            std::make_shared<RPC::ChunkedStreamWriter>(
+                stream,
+                HTTPChunkedHeader(
+                    stream->binary() ? "application/octet-stream"
+                                     : "application/json; charset=UTF-8",
+                    keepAlive)),
+            keepAlive);
+        return;
+    }
 
     if (beast::rfc2616::is_keep_alive(session->request()))
         session->complete();
@@ -593,7 +708,8 @@ ServerHandler::processRequest(
     Output&& output,
     std::shared_ptr<JobQueue::Coro> coro,
     boost::string_view forwardedFor,
-    boost::string_view user)
+    boost::string_view user,
+    std::shared_ptr<RPC::LedgerDataStream>& stream)
 {
     auto rpcJ = app_.journal("RPC");
 
@@ -873,12 +989,15 @@ ServerHandler::processRequest(
              apiVersion},
             params,
             {user, forwardedFor}};
+        if (!batch)
+            context.stream = &stream;
         Json::Value result;
 
         auto start = std::chrono::system_clock::now();
 
         try
         {
+            Resource::MeasuredCost cost(usage, !coro);
             RPC::doCommand(context, result);
         }
         catch (std::exception const& ex)
@@ -955,6 +1074,26 @@ ServerHandler::processRequest(
             r[jss::ripplerpc] = params[jss::ripplerpc];
         if (params.isMember(jss::id))
             r[jss::id] = params[jss::id];
+        if (stream)
+        {
+            if (!r.isMember(jss::result) ||
+                r[jss::result][jss::status] != jss::success)
+            {
+                stream.reset();
+            }
+            else
+            {
+                // The streamed result replaces "result" in the reply.
+                r.removeMember(jss::result);
+                std::string fields;
+                Json::outputJson(r, Json::stringOutput(fields));
+                fields = r.size() == 0 ? "}}" : "}," + fields.substr(1);
+                stream->setEnvelope(
+                    "{\"result\":{", ",\"status\":\"success\"" + fields);
+                return;
+            }
+        }
+
         if (batch)
             reply.append(std::move(r));
         else
@@ -1079,25 +1218,31 @@ to_Port(ParsedPort const& parsed, std::ostream& log)
 {
     Port p;
     p.name = parsed.name;
+    p.path = parsed.path;
+    p.path_mode = parsed.path_mode;
 
-    if (!parsed.ip)
+    if (!p.local())
     {
-        log << "Missing 'ip' in [" << p.name << "]";
-        Throw<std::exception>();
-    }
-    p.ip = *parsed.ip;
+        if (!parsed.ip)
+        {
+            log << "Missing 'ip' in [" << p.name << "]";
+            Throw<std::exception>();
+        }
+        p.ip = *parsed.ip;
 
-    if (!parsed.port)
-    {
-        log << "Missing 'port' in [" << p.name << "]";
-        Throw<std::exception>();
-    }
-    else if (*parsed.port == 0)
-    {
-        log << "Port " << *parsed.port << "in [" << p.name << "] is invalid";
-        Throw<std::exception>();
+        if (!parsed.port)
+        {
+            log << "Missing 'port' in [" << p.name << "]";
+            Throw<std::exception>();
+        }
+        else if (*parsed.port == 0)
+        {
+            log << "Port " << *parsed.port << "in [" << p.name
+                << "] is invalid";
+            Throw<std::exception>();
+        }
+        p.port = *parsed.port;
     }
-    p.port = *parsed.port;
 
     if (parsed.protocol.empty())
     {
@@ -1106,6 +1251,26 @@ to_Port(ParsedPort const& parsed, std::ostream& log)
     }
     p.protocol = parsed.protocol;
 
+    if (p.local())
+    {
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+        for (auto const& proto : p.protocol)
+        {
+            if (!boost::iequals(proto, "http") &&
+                !boost::iequals(proto, "ws") && !boost::iequals(proto, "ws2"))
+            {
+                log << "Protocol '" << proto << "' in [" << p.name
+                    << "] is not supported on a local socket";
+                Throw<std::exception>();
+            }
+        }
+#else
+        log << "Local sockets are not supported, 'path' in [" << p.name
+            << "] is invalid";
+        Throw<std::exception>();
+#endif
+    }
+
     p.user = parsed.user;
     p.password = parsed.password;
     p.admin_user = parsed.admin_user;
@@ -1115,13 +1280,26 @@ to_Port(ParsedPort const& parsed, std::ostream& log)
     p.ssl_chain = parsed.ssl_chain;
     p.ssl_ciphers = parsed.ssl_ciphers;
     p.pmd_options = parsed.pmd_options;
+    p.compress_threshold = parsed.compress_threshold;
     p.ws_queue_limit = parsed.ws_queue_limit;
+    p.ws_queue_bytes = parsed.ws_queue_bytes;
+    p.ws_queue_policy = parsed.ws_queue_policy;
     p.limit = parsed.limit;
     p.admin_nets_v4 = parsed.admin_nets_v4;
     p.admin_nets_v6 = parsed.admin_nets_v6;
     p.secure_gateway_nets_v4 = parsed.secure_gateway_nets_v4;
     p.secure_gateway_nets_v6 = parsed.secure_gateway_nets_v6;
 
+    // Connections on a local socket carry no address, they are presented
+    // as loopback and are admin: whoever can open the socket file is.
+    if (p.local())
+    {
+        p.admin_nets_v4 = {boost::asio::ip::make_network_v4("127.0.0.1/32")};
+        p.admin_nets_v6.clear();
+        p.secure_gateway_nets_v4.clear();
+        p.secure_gateway_nets_v6.clear();
+    }
+
     return p;
 }
 
@@ -1202,8 +1380,9 @@ setup_Client(ServerHandler::Setup& setup)
 {
     decltype(setup.ports)::const_iterator iter;
     for (iter = setup.ports.cbegin(); iter != setup.ports.cend(); ++iter)
-        if (iter->protocol.count("http") > 0 ||
-            iter->protocol.count("https") > 0)
+        if (!iter->local() &&
+            (iter->protocol.count("http") > 0 ||
+             iter->protocol.count("https") > 0))
             break;
     if (iter == setup.ports.cend())
         return;
@@ -1253,6 +1432,7 @@ std::unique_ptr<ServerHandler>
 make_ServerHandler(
     Application& app,
     boost::asio::io_service& io_service,
+    boost::asio::io_service& peer_io_service,
     JobQueue& jobQueue,
     NetworkOPs& networkOPs,
     Resource::Manager& resourceManager,
@@ -1262,6 +1442,7 @@ make_ServerHandler(
         ServerHandler::ServerHandlerCreator(),
         app,
         io_service,
+        peer_io_service,
         jobQueue,
         networkOPs,
         resourceManager,
@@ -26,6 +26,7 @@
 #include <ripple/rpc/ShardArchiveHandler.h>
 #include <ripple/rpc/impl/Handler.h>
 
+#include <algorithm>
 #include <memory>
 
 namespace ripple {
@@ -297,13 +298,44 @@ ShardArchiveHandler::next(std::lock_guard<std::mutex> const& l)
     if (stopping_)
         return false;
 
-    if (archives_.empty())
+    // Hand a waiting archive to the importer once it is idle
+    if (ready_ && !processing_)
+    {
+        auto [shardIndex, dstPath] = std::move(*ready_);
+        ready_.reset();
+        if (!beginProcessing(shardIndex, std::move(dstPath), l))
+            return false;
+    }
+
+    // Download the next archive only when no other download is in
+    // flight and no downloaded archive is waiting for the importer.
+    if (downloading_ || ready_)
+        return true;
+
+    auto const it = std::find_if(
+        archives_.begin(), archives_.end(), [this](auto const& entry) {
+            return entry.first != processing_;
+        });
+
+    if (it == archives_.end())
     {
+        // The last archive is still being imported
+        if (processing_)
+            return true;
+
         doRelease(l);
         return false;
     }
 
-    auto const shardIndex{archives_.begin()->first};
+    downloading_ = it->first;
+    verificationScheduler_.reset();
+    return download(l);
+}
+
+bool
+ShardArchiveHandler::download(std::lock_guard<std::mutex> const& l)
+{
+    auto const shardIndex{*downloading_};
 
     // We use the sequence of the last validated ledger
     // to determine whether or not we have stored a ledger
@@ -321,25 +353,28 @@ ShardArchiveHandler::next(std::lock_guard<std::mutex> const& l)
 
     if (!expectedHash)
     {
-        auto wrapper =
-            timerCounter_.wrap([this](boost::system::error_code const& ec) {
+        auto wrapper = timerCounter_.wrap(
+            [this, shardIndex](boost::system::error_code const& ec) {
                 if (ec != boost::asio::error::operation_aborted)
                 {
                     std::lock_guard lock(m_);
-                    this->next(lock);
+                    if (downloading_ == shardIndex)
+                        this->download(lock);
                 }
             });
 
         if (!wrapper)
             return onClosureFailed(
-                "failed to wrap closure for last ledger confirmation timer", l);
+                shardIndex,
+                "failed to wrap closure for last ledger confirmation timer",
+                l);
 
         if (!verificationScheduler_.retry(app_, shouldHaveHash, *wrapper))
         {
             JLOG(j_.error()) << "failed to find last ledger hash for shard "
                              << shardIndex << ", maximum attempts reached";
 
-            return removeAndProceed(l);
+            return removeAndProceed(shardIndex, l);
         }
 
         return true;
@@ -354,14 +389,14 @@ ShardArchiveHandler::next(std::lock_guard<std::mutex> const& l)
     catch (std::exception const& e)
     {
         JLOG(j_.error()) << "exception: " << e.what();
-        return removeAndProceed(l);
+        return removeAndProceed(shardIndex, l);
     }
 
     // Download the archive. Process in another thread
     // to prevent holding up the lock if the downloader
     // sleeps.
-    auto const& url{archives_.begin()->second};
-    auto wrapper = jobCounter_.wrap([this, url, dstDir]() {
+    auto const& url{archives_.at(shardIndex)};
+    auto wrapper = jobCounter_.wrap([this, shardIndex, url, dstDir]() {
         auto const ssl = (url.scheme == "https");
         auto const defaultPort = ssl ? 443 : 80;
 
@@ -375,13 +410,13 @@ ShardArchiveHandler::next(std::lock_guard<std::mutex> const& l)
                 ssl))
         {
             std::lock_guard<std::mutex> l(m_);
-            removeAndProceed(l);
+            removeAndProceed(shardIndex, l);
         }
     });
 
     if (!wrapper)
         return onClosureFailed(
-            "failed to wrap closure for starting download", l);
+            shardIndex, "failed to wrap closure for starting download", l);
 
     app_.getJobQueue().addJob(jtCLIENT_SHARD, "ShardArchiveHandler", *wrapper);
 
@@ -394,27 +429,43 @@ ShardArchiveHandler::complete(path dstPath)
     if (stopping_)
         return;
 
+    std::lock_guard lock(m_);
+    if (!downloading_)
+        return;
+
+    auto const shardIndex{*downloading_};
+    downloading_.reset();
+
+    try
     {
-        std::lock_guard lock(m_);
-        try
+        if (!is_regular_file(dstPath))
         {
-            if (!is_regular_file(dstPath))
-            {
-                auto ar{archives_.begin()};
-                JLOG(j_.error())
-                    << "Downloading shard id " << ar->first << " from URL "
-                    << ar->second.domain << ar->second.path;
-                removeAndProceed(lock);
-                return;
-            }
-        }
-        catch (std::exception const& e)
-        {
-            JLOG(j_.error()) << "exception: " << e.what();
-            removeAndProceed(lock);
+            auto const& url{archives_.at(shardIndex)};
+            JLOG(j_.error()) << "Downloading shard id " << shardIndex
+                             << " from URL " << url.domain << url.path;
+            removeAndProceed(shardIndex, lock);
             return;
         }
     }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.error()) << "exception: " << e.what();
+        removeAndProceed(shardIndex, lock);
+        return;
+    }
+
+    // Queue the archive for import and start the next download
+    ready_.emplace(shardIndex, std::move(dstPath));
+    next(lock);
+}
+
+bool
+ShardArchiveHandler::beginProcessing(
+    std::uint32_t shardIndex,
+    path dstPath,
+    std::lock_guard<std::mutex> const& l)
+{
+    processing_ = shardIndex;
 
     // Make lambdas mutable captured vars can be moved from
     auto wrapper =
@@ -435,12 +486,20 @@ ShardArchiveHandler::complete(path dstPath)
                 auto wrapper = timerCounter_.wrap(
                     [=, this, dstPath = std::move(dstPath)](
                         boost::system::error_code const& ec) mutable {
-                        if (ec != boost::asio::error::operation_aborted)
-                            complete(std::move(dstPath));
+                        if (ec == boost::asio::error::operation_aborted)
+                            return;
+
+                        std::lock_guard lock(m_);
+                        if (processing_ == shardIndex)
+                        {
+                            beginProcessing(
+                                shardIndex, std::move(dstPath), lock);
+                        }
                     });
 
                 if (!wrapper)
                     onClosureFailed(
+                        shardIndex,
                         "failed to wrap closure for operating mode timer",
                         lock);
                 else
@@ -448,36 +507,26 @@ ShardArchiveHandler::complete(path dstPath)
             }
             else
             {
-                process(dstPath);
+                process(shardIndex, dstPath);
                 std::lock_guard lock(m_);
-                removeAndProceed(lock);
+                if (processing_ == shardIndex)
+                    removeAndProceed(shardIndex, lock);
             }
         });
 
     if (!wrapper)
-    {
-        if (stopping_)
-            return;
-
-        JLOG(j_.error()) << "failed to wrap closure for process()";
-
-        std::lock_guard lock(m_);
-        removeAndProceed(lock);
-    }
+        return onClosureFailed(
+            shardIndex, "failed to wrap closure for process()", l);
 
     // Process in another thread to not hold up the IO service
     app_.getJobQueue().addJob(jtCLIENT_SHARD, "ShardArchiveHandler", *wrapper);
+
+    return true;
 }
 
 void
-ShardArchiveHandler::process(path const& dstPath)
+ShardArchiveHandler::process(std::uint32_t shardIndex, path const& dstPath)
 {
-    std::uint32_t shardIndex;
-    {
-        std::lock_guard lock(m_);
-        shardIndex = archives_.begin()->first;
-    }
-
     auto const shardDir{dstPath.parent_path() / std::to_string(shardIndex)};
     try
     {
@@ -509,11 +558,17 @@ ShardArchiveHandler::process(path const& dstPath)
 }
 
 void
-ShardArchiveHandler::remove(std::lock_guard<std::mutex> const&)
+ShardArchiveHandler::remove(
+    std::uint32_t shardIndex,
+    std::lock_guard<std::mutex> const&)
 {
-    verificationScheduler_.reset();
+    if (downloading_ == shardIndex)
+        downloading_.reset();
+    if (processing_ == shardIndex)
+        processing_.reset();
+    if (ready_ && ready_->first == shardIndex)
+        ready_.reset();
 
-    auto const shardIndex{archives_.begin()->first};
     app_.getShardStore()->removePreShard(shardIndex);
     archives_.erase(shardIndex);
 
@@ -537,6 +592,9 @@ ShardArchiveHandler::doRelease(std::lock_guard<std::mutex> const&)
     for (auto const& ar : archives_)
         app_.getShardStore()->removePreShard(ar.first);
     archives_.clear();
+    downloading_.reset();
+    ready_.reset();
+    processing_.reset();
 
     dropArchiveDB(*sqlDB_);
 
@@ -559,6 +617,7 @@ ShardArchiveHandler::doRelease(std::lock_guard<std::mutex> const&)
 
 bool
 ShardArchiveHandler::onClosureFailed(
+    std::uint32_t shardIndex,
     std::string const& errorMsg,
     std::lock_guard<std::mutex> const& lock)
 {
@@ -567,13 +626,15 @@ ShardArchiveHandler::onClosureFailed(
 
     JLOG(j_.error()) << errorMsg;
 
-    return removeAndProceed(lock);
+    return removeAndProceed(shardIndex, lock);
 }
 
 bool
-ShardArchiveHandler::removeAndProceed(std::lock_guard<std::mutex> const& lock)
+ShardArchiveHandler::removeAndProceed(
+    std::uint32_t shardIndex,
+    std::lock_guard<std::mutex> const& lock)
 {
-    remove(lock);
+    remove(shardIndex, lock);
     return next(lock);
 }
 
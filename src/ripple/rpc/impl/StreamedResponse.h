@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_RPC_STREAMEDRESPONSE_H_INCLUDED
+#define RIPPLE_RPC_STREAMEDRESPONSE_H_INCLUDED
+
+#include <ripple/rpc/impl/LedgerDataStream.h>
+#include <ripple/server/WSSession.h>
+#include <ripple/server/Writer.h>
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+namespace ripple {
+namespace RPC {
+
+/** Sends a LedgerDataStream as an HTTP response with chunked encoding. */
+class ChunkedStreamWriter : public Writer
+{
+    std::shared_ptr<LedgerDataStream> stream_;
+    std::string out_;
+    std::size_t consumed_ = 0;
+    bool headerSent_ = false;
+    bool trailerSent_ = false;
+
+public:
+    /** Create the writer.
+
+        @param header The status line and header fields of the response,
+                      each ending in CRLF, without the blank line.
+    */
+    ChunkedStreamWriter(
+        std::shared_ptr<LedgerDataStream> stream,
+        std::string header)
+        : stream_(std::move(stream)), out_(std::move(header))
+    {
+        out_ += "Transfer-Encoding: chunked\r\n\r\n";
+    }
+
+    bool
+    complete() override
+    {
+        return trailerSent_ && consumed_ == out_.size();
+    }
+
+    void
+    consume(std::size_t bytes) override
+    {
+        consumed_ = std::min(consumed_ + bytes, out_.size());
+    }
+
+    bool
+    prepare(std::size_t, std::function<void(void)> resume) override
+    {
+        if (consumed_ < out_.size() || trailerSent_)
+            return true;
+
+        if (!stream_->prepare(std::move(resume)))
+            return false;
+
+        out_.clear();
+        consumed_ = 0;
+        auto const b = stream_->data();
+        if (auto const size = b.size(); size != 0)
+        {
+            char hex[20];
+            std::snprintf(hex, sizeof(hex), "%zx\r\n", size);
+            out_ += hex;
+            out_.append(static_cast<char const*>(b.data()), size);
+            out_ += "\r\n";
+            stream_->consume(size);
+        }
+        if (stream_->complete())
+        {
+            out_ += "0\r\n\r\n";
+            trailerSent_ = true;
+        }
+        return true;
+    }
+
+    std::vector<boost::asio::const_buffer>
+    data() override
+    {
+        return {{out_.data() + consumed_, out_.size() - consumed_}};
+    }
+};
+
+/** Sends a LedgerDataStream as one WebSocket message. */
+class StreamWSMsg : public WSMsg
+{
+    std::shared_ptr<LedgerDataStream> stream_;
+    std::size_t n_ = 0;
+
+public:
+    explicit StreamWSMsg(std::shared_ptr<LedgerDataStream> stream)
+        : stream_(std::move(stream))
+    {
+    }
+
+    std::pair<boost::tribool, std::vector<boost::asio::const_buffer>>
+    prepare(std::size_t bytes, std::function<void(void)> resume) override
+    {
+        // The bytes returned last time have been written.
+        stream_->consume(n_);
+        n_ = 0;
+
+        if (!stream_->prepare(std::move(resume)))
+            return {boost::indeterminate, {}};
+
+        auto const b = stream_->data();
+        if (b.size() == 0)
+            return {true, {}};
+        n_ = std::min(bytes, b.size());
+        return {false, {{b.data(), n_}}};
+    }
+};
+
+}  // namespace RPC
+}  // namespace ripple
+
+#endif
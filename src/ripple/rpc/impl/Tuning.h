@@ -20,6 +20,9 @@
 #ifndef RIPPLE_RPC_TUNING_H_INCLUDED
 #define RIPPLE_RPC_TUNING_H_INCLUDED
 
+#include <chrono>
+#include <cstddef>
+
 namespace ripple {
 namespace RPC {
 
@@ -65,6 +68,9 @@ static int constexpr maxJobQueueClients = 500;
 auto constexpr maxValidatedLedgerAge = std::chrono::minutes{2};
 static int constexpr maxRequestSize = 1000000;
 
+/** Maximum number of transactions in one submit_batch request. */
+static unsigned int constexpr maxSubmitBatch = 1000;
+
 /** Maximum number of pages in one response from a binary LedgerData request. */
 static int constexpr binaryPageLength = 2048;
 
@@ -77,12 +83,19 @@ inline int constexpr pageLength(bool isBinary)
     return isBinary ? binaryPageLength : jsonPageLength;
 }
 
+/** Bytes of a streamed LedgerData response produced at a time. */
+static std::size_t constexpr streamChunkSize = 64 * 1024;
+
 /** Maximum number of source currencies allowed in a path find request. */
 static int constexpr max_src_cur = 18;
 
 /** Maximum number of auto source currencies in a path find request. */
 static int constexpr max_auto_src_cur = 88;
 
+/** Time the searches of one path find update may take, summed over all of
+    the threads they run on, before the remaining ones are abandoned. */
+auto constexpr maxPathfindSearchTime = std::chrono::seconds{10};
+
 }  // namespace Tuning
 /** @} */
 
@@ -23,6 +23,7 @@
 #include <ripple/beast/net/IPAddressConversion.h>
 #include <ripple/json/json_writer.h>
 #include <ripple/net/InfoSub.h>
+#include <ripple/protocol/jss.h>
 #include <ripple/rpc/Role.h>
 #include <ripple/server/WSSession.h>
 #include <boost/utility/string_view.hpp>
@@ -79,7 +80,27 @@ public:
                 sb.prepare(n), boost::asio::buffer(data, n)));
         });
         auto m = std::make_shared<StreambufWSMsg<decltype(sb)>>(std::move(sb));
-        sp->send(m);
+        sp->send(m, messageType(jv));
+    }
+
+    void
+    publish(SharedJson const& message) override
+    {
+        auto sp = ws_.lock();
+        if (!sp)
+            return;
+        sp->send(
+            std::make_shared<SharedWSMsg>(message.text()),
+            messageType(message.json()));
+    }
+
+private:
+    static std::string
+    messageType(Json::Value const& jv)
+    {
+        if (jv.isObject() && jv.isMember(jss::type) && jv[jss::type].isString())
+            return jv[jss::type].asString();
+        return {};
     }
 };
 
@@ -28,6 +28,7 @@
 #include <boost/beast/core/string.hpp>
 #include <boost/beast/websocket/option.hpp>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <optional>
 #include <set>
@@ -44,6 +45,21 @@ class context;
 
 namespace ripple {
 
+/** What a websocket does with published messages when the client is slow.
+
+    Each type of message published on a subscription stream has a policy.
+    Messages without one, including responses to requests, use
+    `disconnect`.
+*/
+enum class WSQueuePolicy {
+    /// Close the connection when the send queue is full
+    disconnect,
+    /// Discard the oldest queued messages of the type when the queue is full
+    dropOldest,
+    /// Keep only the newest queued message of the type
+    conflate,
+};
+
 /** Configuration information for a Server listening port. */
 struct Port
 {
@@ -68,6 +84,18 @@ struct Port
     boost::beast::websocket::permessage_deflate pmd_options;
     std::shared_ptr<boost::asio::ssl::context> context;
 
+    // Filesystem path of a local (unix domain) listening socket. When set,
+    // ip and port are unused and access is governed by the permissions of
+    // the socket file.
+    std::string path;
+
+    // Permission bits applied to the socket file at path
+    unsigned int path_mode = 0600;
+
+    // Websocket messages smaller than this are sent uncompressed, even when
+    // permessage-deflate was negotiated
+    std::size_t compress_threshold = 256;
+
     // How many incoming connections are allowed on this
     // port in the range [0, 65535] where 0 means unlimited.
     int limit = 0;
@@ -75,6 +103,13 @@ struct Port
     // Websocket disconnects if send queue exceeds this limit
     std::uint16_t ws_queue_limit;
 
+    // Websocket send queue is also full past this many bytes,
+    // 0 means unlimited
+    std::size_t ws_queue_bytes = 0;
+
+    // How queued websocket messages are handled, by message type
+    std::map<std::string, WSQueuePolicy> ws_queue_policy;
+
     // Returns `true` if any websocket protocols are specified
     bool
     websockets() const;
@@ -86,6 +121,10 @@ struct Port
     // Returns a string containing the list of protocols
     std::string
     protocols() const;
+
+    // Returns `true` if this port listens on a local socket
+    bool
+    local() const;
 };
 
 std::ostream&
@@ -108,8 +147,13 @@ struct ParsedPort
     std::string ssl_chain;
     std::string ssl_ciphers;
     boost::beast::websocket::permessage_deflate pmd_options;
+    std::size_t compress_threshold = 256;
+    std::string path;
+    unsigned int path_mode = 0600;
     int limit = 0;
     std::uint16_t ws_queue_limit;
+    std::size_t ws_queue_bytes = 0;
+    std::map<std::string, WSQueuePolicy> ws_queue_policy;
 
     std::optional<boost::asio::ip::address> ip;
     std::optional<std::uint16_t> port;
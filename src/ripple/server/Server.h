@@ -39,6 +39,22 @@ make_Server(
     return std::make_unique<ServerImpl<Handler>>(handler, io_service, journal);
 }
 
+/** Create the HTTP server using the specified handler.
+
+    Ports which speak the peer protocol run on peer_io_service.
+*/
+template <class Handler>
+std::unique_ptr<Server>
+make_Server(
+    Handler& handler,
+    boost::asio::io_service& io_service,
+    boost::asio::io_service& peer_io_service,
+    beast::Journal journal)
+{
+    return std::make_unique<ServerImpl<Handler>>(
+        handler, io_service, peer_io_service, journal);
+}
+
 }  // namespace ripple
 
 #endif
@@ -33,6 +33,7 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -66,6 +67,13 @@ public:
     */
     virtual std::pair<boost::tribool, std::vector<boost::asio::const_buffer>>
     prepare(std::size_t bytes, std::function<void(void)> resume) = 0;
+
+    /** Return the number of bytes held by the message, if known. */
+    virtual std::size_t
+    size() const
+    {
+        return 0;
+    }
 };
 
 template <class Streambuf>
@@ -73,12 +81,19 @@ class StreambufWSMsg : public WSMsg
 {
     Streambuf sb_;
     std::size_t n_ = 0;
+    std::size_t const size_;
 
 public:
-    StreambufWSMsg(Streambuf&& sb) : sb_(std::move(sb))
+    StreambufWSMsg(Streambuf&& sb) : sb_(std::move(sb)), size_(sb_.size())
     {
     }
 
+    std::size_t
+    size() const override
+    {
+        return size_;
+    }
+
     std::pair<boost::tribool, std::vector<boost::asio::const_buffer>>
     prepare(std::size_t bytes, std::function<void(void)>) override
     {
@@ -104,6 +119,38 @@ public:
     }
 };
 
+/** A message whose data is shared with other messages. */
+class SharedWSMsg : public WSMsg
+{
+    std::shared_ptr<std::string const> data_;
+    std::size_t pos_ = 0;
+    std::size_t n_ = 0;
+
+public:
+    explicit SharedWSMsg(std::shared_ptr<std::string const> data)
+        : data_(std::move(data))
+    {
+    }
+
+    std::size_t
+    size() const override
+    {
+        return data_->size();
+    }
+
+    std::pair<boost::tribool, std::vector<boost::asio::const_buffer>>
+    prepare(std::size_t bytes, std::function<void(void)>) override
+    {
+        pos_ += n_;
+        auto const left = data_->size() - pos_;
+        if (left == 0)
+            return {true, {}};
+        n_ = std::min(bytes, left);
+        boost::tribool const done = n_ == left;
+        return {done, {boost::asio::const_buffer(data_->data() + pos_, n_)}};
+    }
+};
+
 struct WSSession
 {
     std::shared_ptr<void> appDefined;
@@ -130,6 +177,14 @@ struct WSSession
     virtual void
     send(std::shared_ptr<WSMsg> w) = 0;
 
+    /** Send a message published on a stream.
+
+        @param type The type of the message, which selects the policy
+                    applied when the client cannot keep up.
+    */
+    virtual void
+    send(std::shared_ptr<WSMsg> w, std::string type) = 0;
+
     virtual void
     close() = 0;
 
@@ -26,12 +26,15 @@
 #include <ripple/protocol/BuildInfo.h>
 #include <ripple/server/impl/BasePeer.h>
 #include <ripple/server/impl/LowestLayer.h>
+#include <ripple/server/impl/WSSendQueue.h>
+#include <boost/beast/core/flat_buffer.hpp>
 #include <boost/beast/core/multi_buffer.hpp>
 #include <boost/beast/http/message.hpp>
 #include <boost/beast/websocket.hpp>
 
 #include <cassert>
 #include <functional>
+#include <vector>
 
 namespace ripple {
 
@@ -49,10 +52,17 @@ protected:
 private:
     friend class BasePeer<Handler, Impl>;
 
+    // Read buffer capacity kept between messages. A larger buffer, grown by
+    // a large message, is released once that message has been handled.
+    static constexpr std::size_t readBufferRetain = 16 * 1024;
+
     http_request_type request_;
-    boost::beast::multi_buffer rb_;
+    // The read buffer and its buffer list are reused for every message of
+    // the session, so small messages are read without allocating.
+    boost::beast::flat_buffer rb_;
+    std::vector<boost::asio::const_buffer> rbs_;
     boost::beast::multi_buffer wb_;
-    std::list<std::shared_ptr<WSMsg>> wq_;
+    WSSendQueue wq_;
     /// The socket has been closed, or will close after the next write
     /// finishes. Do not do any more writes, and don't try to close
     /// again.
@@ -106,6 +116,9 @@ public:
     void
     send(std::shared_ptr<WSMsg> w) override;
 
+    void
+    send(std::shared_ptr<WSMsg> w, std::string type) override;
+
     void
     close() override;
 
@@ -125,6 +138,10 @@ protected:
     void
     on_ws_handshake(error_code const& ec);
 
+    // Start writing the message at the front of the queue
+    void
+    start_write();
+
     void
     do_write();
 
@@ -179,6 +196,7 @@ BaseWSPeer<Handler, Impl>::BaseWSPeer(
     beast::Journal journal)
     : BasePeer<Handler, Impl>(port, handler, executor, remote_address, journal)
     , request_(std::move(request))
+    , wq_(port)
     , timer_(std::move(timer))
     , payload_("12345678")  // ensures size is 8 bytes
 {
@@ -221,27 +239,38 @@ BaseWSPeer<Handler, Impl>::run()
 template <class Handler, class Impl>
 void
 BaseWSPeer<Handler, Impl>::send(std::shared_ptr<WSMsg> w)
+{
+    send(std::move(w), std::string{});
+}
+
+template <class Handler, class Impl>
+void
+BaseWSPeer<Handler, Impl>::send(std::shared_ptr<WSMsg> w, std::string type)
 {
     if (!strand_.running_in_this_thread())
         return post(
             strand_,
-            std::bind(
-                &BaseWSPeer::send, impl().shared_from_this(), std::move(w)));
+            [self = impl().shared_from_this(),
+             w = std::move(w),
+             type = std::move(type)]() mutable {
+                self->send(std::move(w), std::move(type));
+            });
     if (do_close_)
         return;
-    if (wq_.size() > port().ws_queue_limit)
+    if (!wq_.push(std::move(w), std::move(type)))
     {
         cr_.code = safe_cast<decltype(cr_.code)>(
             boost::beast::websocket::close_code::policy_error);
         cr_.reason = "Policy error: client is too slow.";
-        JLOG(this->j_.info()) << cr_.reason;
-        wq_.erase(std::next(wq_.begin()), wq_.end());
+        JLOG(this->j_.info())
+            << cr_.reason << " Queued " << wq_.size() << " messages, "
+            << wq_.bytes() << " bytes, dropped " << wq_.dropped();
+        wq_.clear_queued();
         close(cr_);
         return;
     }
-    wq_.emplace_back(std::move(w));
     if (wq_.size() == 1)
-        on_write({});
+        start_write();
 }
 
 template <class Handler, class Impl>
@@ -312,13 +341,25 @@ BaseWSPeer<Handler, Impl>::do_write()
     on_write({});
 }
 
+template <class Handler, class Impl>
+void
+BaseWSPeer<Handler, Impl>::start_write()
+{
+    // Compressing a small message costs more than the bytes it saves. The
+    // option is read when the next message starts, so it can't change the
+    // message being written.
+    auto const size = wq_.front().size();
+    impl().ws_.compress(size == 0 || size >= port().compress_threshold);
+    on_write({});
+}
+
 template <class Handler, class Impl>
 void
 BaseWSPeer<Handler, Impl>::on_write(error_code const& ec)
 {
     if (ec)
         return fail(ec, "write");
-    auto& w = *wq_.front();
+    auto& w = wq_.front();
     auto const result = w.prepare(
         65536, std::bind(&BaseWSPeer::do_write, impl().shared_from_this()));
     if (boost::indeterminate(result.first))
@@ -365,7 +406,7 @@ BaseWSPeer<Handler, Impl>::on_write_fin(error_code const& ec)
                     std::placeholders::_1)));
     }
     else if (!wq_.empty())
-        on_write({});
+        start_write();
 }
 
 template <class Handler, class Impl>
@@ -394,12 +435,11 @@ BaseWSPeer<Handler, Impl>::on_read(error_code const& ec)
         return on_close({});
     if (ec)
         return fail(ec, "read");
-    auto const& data = rb_.data();
-    std::vector<boost::asio::const_buffer> b;
-    b.reserve(std::distance(data.begin(), data.end()));
-    std::copy(data.begin(), data.end(), std::back_inserter(b));
-    this->handler_.onWSMessage(impl().shared_from_this(), b);
+    rbs_.assign(1, rb_.data());
+    this->handler_.onWSMessage(impl().shared_from_this(), rbs_);
     rb_.consume(rb_.size());
+    if (rb_.capacity() > readBufferRetain)
+        rb_.shrink_to_fit();
 }
 
 template <class Handler, class Impl>
@@ -156,4 +156,13 @@ HTTPReply(
     output("\r\n");
 }
 
+std::string
+HTTPChunkedHeader(std::string const& contentType, bool keepAlive)
+{
+    return "HTTP/1.1 200 OK\r\n" + getHTTPHeaderTimestamp() +
+        (keepAlive ? "Connection: Keep-Alive\r\n" : "Connection: close\r\n") +
+        "Content-Type: " + contentType + "\r\n" + "Server: " + systemName() +
+        "-json-rpc/" + BuildInfo::getFullVersionString() + "\r\n";
+}
+
 }  // namespace ripple
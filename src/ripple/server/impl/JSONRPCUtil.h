@@ -22,6 +22,7 @@
 
 #include <ripple/json/Output.h>
 #include <ripple/json/json_value.h>
+#include <string>
 
 namespace ripple {
 
@@ -32,6 +33,12 @@ HTTPReply(
     Json::Output const&,
     beast::Journal j);
 
+/** Returns the status line and header fields, each ending in CRLF, of a
+    successful reply whose body will follow with chunked encoding.
+*/
+std::string
+HTTPChunkedHeader(std::string const& contentType, bool keepAlive);
+
 }  // namespace ripple
 
 #endif
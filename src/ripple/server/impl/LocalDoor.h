@@ -0,0 +1,282 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#ifndef RIPPLE_SERVER_LOCALDOOR_H_INCLUDED
+#define RIPPLE_SERVER_LOCALDOOR_H_INCLUDED
+
+#include <ripple/basics/Log.h>
+#include <ripple/basics/contract.h>
+#include <ripple/server/impl/PlainHTTPPeer.h>
+#include <ripple/server/impl/io_list.h>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
+#include <boost/filesystem.hpp>
+#include <functional>
+#include <memory>
+
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+
+#include <unistd.h>
+
+namespace ripple {
+
+/** A listening unix domain socket.
+
+    Accepted connections are served by the same peers as a plain TCP port:
+    the descriptor is moved into a TCP stream, which only performs reads,
+    writes and shutdown on it. The remote address is reported as loopback,
+    so access is controlled by the permissions of the socket file.
+*/
+template <class Handler>
+class LocalDoor : public io_list::work,
+                  public std::enable_shared_from_this<LocalDoor<Handler>>
+{
+private:
+    using error_code = boost::system::error_code;
+    using yield_context = boost::asio::yield_context;
+    using protocol_type = boost::asio::local::stream_protocol;
+    using acceptor_type = protocol_type::acceptor;
+    using endpoint_type = boost::asio::ip::tcp::endpoint;
+    using stream_type = boost::beast::tcp_stream;
+
+    beast::Journal const j_;
+    Port const& port_;
+    Handler& handler_;
+    boost::asio::io_context& ioc_;
+    acceptor_type acceptor_;
+    boost::asio::io_context::strand strand_;
+
+    // Removes a socket file left behind by an earlier run. Anything else
+    // at the path, or a socket that is still being listened on, is an
+    // error.
+    void
+    removeStale();
+
+    void
+    open();
+
+public:
+    LocalDoor(
+        Handler& handler,
+        boost::asio::io_context& io_context,
+        Port const& port,
+        beast::Journal j);
+
+    // Work-around because we can't call shared_from_this in ctor
+    void
+    run();
+
+    /** Close the listening socket and remove the socket file.
+        Thread Safety:
+            May be called concurrently
+    */
+    void
+    close() override;
+
+private:
+    void
+    do_accept(yield_context yield);
+};
+
+template <class Handler>
+void
+LocalDoor<Handler>::removeStale()
+{
+    namespace fs = boost::filesystem;
+
+    error_code ec;
+    auto const status = fs::symlink_status(port_.path, ec);
+    if (status.type() == fs::file_not_found)
+        return;
+
+    if (status.type() != fs::socket_file)
+    {
+        JLOG(j_.error()) << "Port '" << port_.name << "': " << port_.path
+                         << " exists and is not a socket";
+        Throw<std::exception>();
+    }
+
+    // A socket that accepts a connection belongs to a running server
+    protocol_type::socket probe(ioc_);
+    probe.connect(protocol_type::endpoint(port_.path), ec);
+    if (ec != boost::asio::error::connection_refused)
+    {
+        JLOG(j_.error()) << "Port '" << port_.name << "': " << port_.path
+                         << " is in use";
+        Throw<std::exception>();
+    }
+
+    fs::remove(port_.path, ec);
+    if (ec)
+    {
+        JLOG(j_.error()) << "Port '" << port_.name << "': removing "
+                         << port_.path << " failed:" << ec.message();
+        Throw<std::exception>();
+    }
+}
+
+template <class Handler>
+void
+LocalDoor<Handler>::open()
+{
+    error_code ec;
+
+    removeStale();
+
+    protocol_type::endpoint const local_address(port_.path);
+
+    acceptor_.open(local_address.protocol(), ec);
+    if (ec)
+    {
+        JLOG(j_.error()) << "Open port '" << port_.name
+                         << "' failed:" << ec.message();
+        Throw<std::exception>();
+    }
+
+    acceptor_.bind(local_address, ec);
+    if (ec)
+    {
+        JLOG(j_.error()) << "Bind port '" << port_.name << "' to "
+                         << port_.path << " failed:" << ec.message();
+        Throw<std::exception>();
+    }
+
+    boost::filesystem::permissions(
+        port_.path,
+        static_cast<boost::filesystem::perms>(port_.path_mode),
+        ec);
+    if (ec)
+    {
+        JLOG(j_.error()) << "Permissions for port '" << port_.name
+                         << "' failed:" << ec.message();
+        Throw<std::exception>();
+    }
+
+    acceptor_.listen(boost::asio::socket_base::max_connections, ec);
+    if (ec)
+    {
+        JLOG(j_.error()) << "Listen on port '" << port_.name
+                         << "' failed:" << ec.message();
+        Throw<std::exception>();
+    }
+
+    JLOG(j_.info()) << "Opened " << port_;
+}
+
+template <class Handler>
+LocalDoor<Handler>::LocalDoor(
+    Handler& handler,
+    boost::asio::io_context& io_context,
+    Port const& port,
+    beast::Journal j)
+    : j_(j)
+    , port_(port)
+    , handler_(handler)
+    , ioc_(io_context)
+    , acceptor_(io_context)
+    , strand_(io_context)
+{
+    open();
+}
+
+template <class Handler>
+void
+LocalDoor<Handler>::run()
+{
+    boost::asio::spawn(
+        strand_,
+        std::bind(
+            &LocalDoor<Handler>::do_accept,
+            this->shared_from_this(),
+            std::placeholders::_1));
+}
+
+template <class Handler>
+void
+LocalDoor<Handler>::close()
+{
+    if (!strand_.running_in_this_thread())
+        return strand_.post(
+            std::bind(&LocalDoor<Handler>::close, this->shared_from_this()));
+    error_code ec;
+    if (acceptor_.is_open())
+    {
+        acceptor_.close(ec);
+        boost::filesystem::remove(port_.path, ec);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+template <class Handler>
+void
+LocalDoor<Handler>::do_accept(boost::asio::yield_context do_yield)
+{
+    endpoint_type const remote_address(
+        boost::asio::ip::address_v4::loopback(), 0);
+
+    while (acceptor_.is_open())
+    {
+        error_code ec;
+        protocol_type::socket local(ioc_);
+        acceptor_.async_accept(local, do_yield[ec]);
+        if (ec)
+        {
+            if (ec == boost::asio::error::operation_aborted)
+                break;
+            JLOG(j_.error()) << "accept: " << ec.message();
+            continue;
+        }
+
+        stream_type stream(ioc_);
+        auto const fd = local.release(ec);
+        if (ec)
+        {
+            JLOG(j_.error()) << "release: " << ec.message();
+            continue;
+        }
+        stream.socket().assign(boost::asio::ip::tcp::v4(), fd, ec);
+        if (ec)
+        {
+            JLOG(j_.error()) << "assign: " << ec.message();
+            ::close(fd);
+            continue;
+        }
+
+        if (auto sp = ios().template emplace<PlainHTTPPeer<Handler>>(
+                port_,
+                handler_,
+                ioc_,
+                j_,
+                remote_address,
+                boost::asio::null_buffers{},
+                std::move(stream)))
+            sp->run();
+    }
+}
+
+}  // namespace ripple
+
+#endif
+
+#endif
@@ -93,7 +93,9 @@ PlainHTTPPeer<Handler>::PlainHTTPPeer(
     // otherwise Nagle's algorithm makes Env
     // tests run slower on Linux systems.
     //
-    if (remote_endpoint.address().is_loopback())
+    // Local sockets are presented as loopback but have no such option.
+    //
+    if (!port.local() && remote_endpoint.address().is_loopback())
         socket_.set_option(boost::asio::ip::tcp::no_delay{true});
 }
 
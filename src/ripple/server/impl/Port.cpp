@@ -43,10 +43,19 @@ Port::protocols() const
     return s;
 }
 
+bool
+Port::local() const
+{
+    return !path.empty();
+}
+
 std::ostream&
 operator<<(std::ostream& os, Port const& p)
 {
-    os << "'" << p.name << "' (ip=" << p.ip << ":" << p.port << ", ";
+    if (p.local())
+        os << "'" << p.name << "' (path=" << p.path << ", ";
+    else
+        os << "'" << p.name << "' (ip=" << p.ip << ":" << p.port << ", ";
 
     if (p.admin_nets_v4.size() || p.admin_nets_v6.size())
     {
@@ -236,6 +245,33 @@ parse_Port(ParsedPort& port, Section const& section, std::ostream& log)
         }
     }
 
+    {
+        auto const optResult = section.get("path");
+        if (optResult)
+            port.path = *optResult;
+    }
+
+    {
+        auto const optResult = section.get("path_mode");
+        if (optResult)
+        {
+            try
+            {
+                std::size_t pos = 0;
+                auto const mode = std::stoul(*optResult, &pos, 8);
+                if (pos != optResult->size() || mode > 0777)
+                    Throw<std::exception>();
+                port.path_mode = static_cast<unsigned int>(mode);
+            }
+            catch (std::exception const&)
+            {
+                log << "Invalid value '" << *optResult << "' for key "
+                    << "'path_mode' in [" << section.name() << "]";
+                Rethrow();
+            }
+        }
+    }
+
     {
         auto const optResult = section.get("protocol");
         if (optResult)
@@ -292,6 +328,70 @@ parse_Port(ParsedPort& port, Section const& section, std::ostream& log)
         }
     }
 
+    {
+        auto const optResult = section.get("send_queue_bytes");
+        if (optResult)
+        {
+            try
+            {
+                port.ws_queue_bytes =
+                    beast::lexicalCastThrow<std::size_t>(*optResult);
+            }
+            catch (std::exception const&)
+            {
+                log << "Invalid value '" << *optResult << "' for key "
+                    << "'send_queue_bytes' in [" << section.name() << "]";
+                Rethrow();
+            }
+        }
+    }
+
+    {
+        auto const optResult = section.get("send_queue_policy");
+        if (optResult)
+        {
+            // The type of the messages published on each stream
+            static std::map<std::string, std::string> const types = {
+                {"book_changes", "bookChanges"},
+                {"consensus", "consensusPhase"},
+                {"ledger", "ledgerClosed"},
+                {"manifests", "manifestReceived"},
+                {"peer_status", "peerStatusChange"},
+                {"server", "serverStatus"},
+                {"transactions", "transaction"},
+                {"validations", "validationReceived"}};
+
+            static std::map<std::string, WSQueuePolicy> const policies = {
+                {"conflate", WSQueuePolicy::conflate},
+                {"disconnect", WSQueuePolicy::disconnect},
+                {"drop_oldest", WSQueuePolicy::dropOldest}};
+
+            for (auto const& entry : beast::rfc2616::split_commas(
+                     optResult->begin(), optResult->end()))
+            {
+                auto const colon = entry.find(':');
+                auto const type = colon == std::string::npos
+                    ? types.end()
+                    : types.find(boost::algorithm::trim_copy(
+                          entry.substr(0, colon)));
+                auto const policy = colon == std::string::npos
+                    ? policies.end()
+                    : policies.find(boost::algorithm::trim_copy(
+                          entry.substr(colon + 1)));
+
+                if (type == types.end() || policy == policies.end())
+                {
+                    log << "Invalid value '" << entry << "' for key "
+                        << "'send_queue_policy' in [" << section.name()
+                        << "]";
+                    Throw<std::exception>();
+                }
+
+                port.ws_queue_policy[type->second] = policy->second;
+            }
+        }
+    }
+
     populate(section, "admin", log, port.admin_nets_v4, port.admin_nets_v6);
     populate(
         section,
@@ -321,6 +421,7 @@ parse_Port(ParsedPort& port, Section const& section, std::ostream& log)
         section.value_or("server_no_context_takeover", false);
     port.pmd_options.compLevel = section.value_or("compress_level", 8);
     port.pmd_options.memLevel = section.value_or("memory_level", 4);
+    port.compress_threshold = section.value_or("compress_threshold", 256);
 }
 
 }  // namespace ripple
@@ -24,6 +24,7 @@
 #include <ripple/beast/core/List.h>
 #include <ripple/server/Server.h>
 #include <ripple/server/impl/Door.h>
+#include <ripple/server/impl/LocalDoor.h>
 #include <ripple/server/impl/io_list.h>
 #include <boost/asio.hpp>
 #include <array>
@@ -83,6 +84,7 @@ private:
     Handler& handler_;
     beast::Journal const j_;
     boost::asio::io_service& io_service_;
+    boost::asio::io_service& peer_io_service_;
     boost::asio::io_service::strand strand_;
     std::optional<boost::asio::io_service::work> work_;
 
@@ -100,6 +102,12 @@ public:
         boost::asio::io_service& io_service,
         beast::Journal journal);
 
+    ServerImpl(
+        Handler& handler,
+        boost::asio::io_service& io_service,
+        boost::asio::io_service& peer_io_service,
+        beast::Journal journal);
+
     ~ServerImpl();
 
     beast::Journal
@@ -139,9 +147,20 @@ ServerImpl<Handler>::ServerImpl(
     Handler& handler,
     boost::asio::io_service& io_service,
     beast::Journal journal)
+    : ServerImpl(handler, io_service, io_service, journal)
+{
+}
+
+template <class Handler>
+ServerImpl<Handler>::ServerImpl(
+    Handler& handler,
+    boost::asio::io_service& io_service,
+    boost::asio::io_service& peer_io_service,
+    beast::Journal journal)
     : handler_(handler)
     , j_(journal)
     , io_service_(io_service)
+    , peer_io_service_(peer_io_service)
     , strand_(io_service_)
     , work_(io_service_)
 {
@@ -168,8 +187,22 @@ ServerImpl<Handler>::ports(std::vector<Port> const& ports)
     for (auto const& port : ports)
     {
         ports_.push_back(port);
+        auto& ios =
+            port.protocol.count("peer") != 0 ? peer_io_service_ : io_service_;
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+        if (port.local())
+        {
+            if (auto sp = ios_.emplace<LocalDoor<Handler>>(
+                    handler_, ios, ports_.back(), j_))
+            {
+                eps.emplace_back();
+                sp->run();
+            }
+            continue;
+        }
+#endif
         if (auto sp = ios_.emplace<Door<Handler>>(
-                handler_, io_service_, ports_.back(), j_))
+                handler_, ios, ports_.back(), j_))
         {
             list_.push_back(sp);
             eps.push_back(sp->get_endpoint());
@@ -0,0 +1,105 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/server/impl/WSSendQueue.h>
+#include <algorithm>
+
+namespace ripple {
+
+WSSendQueue::WSSendQueue(Port const& port) : port_(port)
+{
+}
+
+bool
+WSSendQueue::push(std::shared_ptr<WSMsg> msg, std::string type)
+{
+    auto policy = WSQueuePolicy::disconnect;
+    if (!type.empty())
+    {
+        if (auto const it = port_.ws_queue_policy.find(type);
+            it != port_.ws_queue_policy.end())
+            policy = it->second;
+    }
+
+    if (policy == WSQueuePolicy::conflate && !entries_.empty())
+    {
+        // Only the newest message of this type is worth sending
+        for (auto it = std::next(entries_.begin()); it != entries_.end();)
+        {
+            if (it->type == type)
+                it = erase(it);
+            else
+                ++it;
+        }
+    }
+
+    auto const bytes = msg->size();
+    entries_.push_back({std::move(msg), std::move(type), bytes, policy});
+    bytes_ += bytes;
+
+    auto it = std::next(entries_.begin());
+    while (full())
+    {
+        it = std::find_if(it, entries_.end(), [](Entry const& entry) {
+            return entry.policy != WSQueuePolicy::disconnect;
+        });
+        if (it == entries_.end())
+            return false;
+        it = erase(it);
+    }
+
+    return true;
+}
+
+void
+WSSendQueue::pop_front()
+{
+    bytes_ -= entries_.front().bytes;
+    entries_.pop_front();
+}
+
+void
+WSSendQueue::clear_queued()
+{
+    while (entries_.size() > 1)
+    {
+        bytes_ -= entries_.back().bytes;
+        entries_.pop_back();
+    }
+}
+
+bool
+WSSendQueue::full() const
+{
+    // The front message is being written, so it does not count
+    if (entries_.size() > std::size_t(port_.ws_queue_limit) + 1)
+        return true;
+    return port_.ws_queue_bytes != 0 &&
+        bytes_ - entries_.front().bytes > port_.ws_queue_bytes;
+}
+
+std::list<WSSendQueue::Entry>::iterator
+WSSendQueue::erase(std::list<Entry>::iterator it)
+{
+    bytes_ -= it->bytes;
+    ++dropped_;
+    return entries_.erase(it);
+}
+
+}  // namespace ripple
@@ -0,0 +1,122 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_SERVER_WSSENDQUEUE_H_INCLUDED
+#define RIPPLE_SERVER_WSSENDQUEUE_H_INCLUDED
+
+#include <ripple/server/Port.h>
+#include <ripple/server/WSSession.h>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+
+namespace ripple {
+
+/** The messages waiting to be written to a websocket.
+
+    The front message is the one being written. It is never removed until
+    it has been written, even if the client is slow.
+
+    The queue is full when it holds more than the port's `send_queue_limit`
+    messages besides the front one, or more than its `send_queue_bytes`.
+    When a message is added, queued messages whose type uses the `conflate`
+    policy are replaced by a newer message of the same type. If the queue
+    is then full, the oldest queued messages whose type uses `drop_oldest`
+    are discarded until it is not. If that is not enough, the client is too
+    slow and must be disconnected.
+*/
+class WSSendQueue
+{
+    struct Entry
+    {
+        std::shared_ptr<WSMsg> msg;
+        std::string type;
+        std::size_t bytes;
+        WSQueuePolicy policy;
+    };
+
+    Port const& port_;
+    std::list<Entry> entries_;
+    std::size_t bytes_ = 0;
+    std::uint64_t dropped_ = 0;
+
+public:
+    explicit WSSendQueue(Port const& port);
+
+    /** Add a message to the queue.
+
+        @param type The type of a published message, or empty for a
+                    response to a request.
+        @return `false` if the queue is full and the client is too slow.
+    */
+    [[nodiscard]] bool
+    push(std::shared_ptr<WSMsg> msg, std::string type = {});
+
+    /** Remove the front message, once it has been written. */
+    void
+    pop_front();
+
+    /** Remove every message but the front one. */
+    void
+    clear_queued();
+
+    WSMsg&
+    front() const
+    {
+        return *entries_.front().msg;
+    }
+
+    bool
+    empty() const
+    {
+        return entries_.empty();
+    }
+
+    std::size_t
+    size() const
+    {
+        return entries_.size();
+    }
+
+    /** Return the number of bytes held by the queue. */
+    std::size_t
+    bytes() const
+    {
+        return bytes_;
+    }
+
+    /** Return the number of messages discarded or replaced. */
+    std::uint64_t
+    dropped() const
+    {
+        return dropped_;
+    }
+
+private:
+    bool
+    full() const;
+
+    std::list<Entry>::iterator
+    erase(std::list<Entry>::iterator it);
+};
+
+}  // namespace ripple
+
+#endif
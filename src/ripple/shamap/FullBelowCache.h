@@ -20,13 +20,17 @@
 #ifndef RIPPLE_SHAMAP_FULLBELOWCACHE_H_INCLUDED
 #define RIPPLE_SHAMAP_FULLBELOWCACHE_H_INCLUDED
 
-#include <ripple/basics/KeyCache.h>
-#include <ripple/basics/TaggedCache.h>
 #include <ripple/basics/base_uint.h>
-#include <ripple/beast/insight/Collector.h>
+#include <ripple/beast/clock/abstract_clock.h>
+#include <ripple/beast/insight/Insight.h>
 #include <ripple/beast/utility/Journal.h>
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace ripple {
 
@@ -34,17 +38,20 @@ namespace detail {
 
 /** Remembers which tree keys have all descendants resident.
     This optimizes the process of acquiring a complete tree.
+
+    The keys are kept whole in open addressing tables, with the second
+    each key was last touched. An entry takes 36 bytes in a table at most
+    three quarters full, where a node based cache also pays for a node
+    allocation and its links. Keys are compared in full: a false hit
+    would make sync skip a subtree this node does not have.
 */
 class BasicFullBelowCache
 {
-private:
-    using CacheType = KeyCache;
-
 public:
     enum { defaultCacheTargetSize = 0 };
 
     using key_type = uint256;
-    using clock_type = typename CacheType::clock_type;
+    using clock_type = beast::abstract_clock<std::chrono::steady_clock>;
 
     /** Construct the cache.
 
@@ -60,16 +67,13 @@ public:
         beast::insight::Collector::ptr const& collector =
             beast::insight::NullCollector::New(),
         std::size_t target_size = defaultCacheTargetSize,
-        std::chrono::seconds expiration = std::chrono::minutes{2})
-        : m_cache(name, target_size, expiration, clock, j, collector), m_gen(1)
-    {
-    }
+        std::chrono::seconds expiration = std::chrono::minutes{2});
 
     /** Return the clock associated with the cache. */
     clock_type&
     clock()
     {
-        return m_cache.clock();
+        return clock_;
     }
 
     /** Return the number of elements in the cache.
@@ -77,9 +81,26 @@ public:
             Safe to call from any thread.
     */
     std::size_t
-    size() const
+    size() const;
+
+    /** The target size, above which entries are aged out faster. */
+    int
+    getTargetSize() const
+    {
+        return targetSize_;
+    }
+
+    void
+    setTargetSize(int size)
     {
-        return m_cache.size();
+        targetSize_ = size;
+    }
+
+    /** Returns the number of lookups which found and did not find a key. */
+    std::pair<std::uint64_t, std::uint64_t>
+    getHitsAndMisses() const
+    {
+        return {hits_.load(), misses_.load()};
     }
 
     /** Remove expired cache items.
@@ -87,10 +108,7 @@ public:
             Safe to call from any thread.
     */
     void
-    sweep()
-    {
-        m_cache.sweep();
-    }
+    sweep();
 
     /** Refresh the last access time of an item, if it exists.
         Thread safety:
@@ -99,10 +117,7 @@ public:
         @return `true` If the key exists.
     */
     bool
-    touch_if_exists(key_type const& key)
-    {
-        return m_cache.touch_if_exists(key);
-    }
+    touch_if_exists(key_type const& key);
 
     /** Insert a key into the cache.
         If the key already exists, the last access time will still
@@ -112,10 +127,14 @@ public:
         @param key The key to insert.
     */
     void
-    insert(key_type const& key)
-    {
-        m_cache.insert(key);
-    }
+    insert(key_type const& key);
+
+    /** Return the keys in the cache.
+        Thread safety:
+            Safe to call from any thread.
+    */
+    std::vector<key_type>
+    getKeys() const;
 
     /** generation determines whether cached entry is valid */
     std::uint32_t
@@ -125,22 +144,79 @@ public:
     }
 
     void
-    clear()
-    {
-        m_cache.clear();
-        ++m_gen;
-    }
+    clear();
 
     void
-    reset()
-    {
-        m_cache.clear();
-        m_gen = 1;
-    }
+    reset();
 
 private:
-    CacheType m_cache;
+    // Each partition is an open addressing table with linear probing,
+    // guarded by its own lock. The partition and the slot come from the
+    // top and bottom bits of the mixed key.
+    struct Partition
+    {
+        mutable std::mutex mutex;
+
+        // A zero stamp marks an empty slot
+        std::vector<key_type> keys;
+        std::vector<std::uint32_t> stamps;
+        std::size_t count = 0;
+    };
+
+    static constexpr std::size_t partitionCount = 16;
+    static constexpr std::size_t minimumSlots = 64;
+
+    struct Stats
+    {
+        template <class Handler>
+        Stats(
+            std::string const& prefix,
+            Handler const& handler,
+            beast::insight::Collector::ptr const& collector)
+            : hook(collector->make_hook(handler))
+            , size(collector->make_gauge(prefix, "size"))
+            , hit_rate(collector->make_gauge(prefix, "hit_rate"))
+        {
+        }
+
+        beast::insight::Hook hook;
+        beast::insight::Gauge size;
+        beast::insight::Gauge hit_rate;
+    };
+
+    std::uint64_t
+    mix(key_type const& key) const;
+
+    std::uint32_t
+    stampOf(clock_type::time_point when) const;
+
+    Partition&
+    partitionFor(std::uint64_t mixed);
+
+    // Returns the slot holding the key, or the empty slot ending its
+    // probe sequence. The table must not be empty.
+    static std::size_t
+    probe(Partition const& p, key_type const& key, std::uint64_t mixed);
+
+    // Moves the entries stamped after `expire` to a table of `slots`.
+    void
+    rehash(Partition& p, std::size_t slots, std::uint32_t expire) const;
+
+    void
+    collect_metrics();
+
+    std::string const name_;
+    clock_type& clock_;
+    beast::Journal const j_;
+    clock_type::time_point const epoch_;
+    std::uint64_t const seed_;
+    std::atomic<int> targetSize_;
+    std::chrono::seconds const expiration_;
+    std::atomic<std::uint64_t> hits_{0};
+    std::atomic<std::uint64_t> misses_{0};
+    std::array<Partition, partitionCount> partitions_;
     std::atomic<std::uint32_t> m_gen;
+    Stats stats_;
 };
 
 }  // namespace detail
@@ -22,6 +22,7 @@
 
 #include <ripple/app/main/CollectorManager.h>
 #include <ripple/shamap/Family.h>
+#include <boost/filesystem/path.hpp>
 
 namespace ripple {
 
@@ -85,6 +86,24 @@ public:
     void
     missingNodeAcquireBySeq(std::uint32_t seq, uint256 const& hash) override;
 
+    /** Write the keys held by the full below and tree node caches to a file,
+        so that the next run of the server can start with them.
+    */
+    void
+    saveCaches(boost::filesystem::path const& file) const;
+
+    /** Reload the keys written by saveCaches.
+
+        The full below keys are inserted straight away, while the tree
+        nodes are fetched from the node store in the background. The file
+        is removed once it has been read, because the node store may change
+        before another one is written.
+
+        @return The number of keys loaded.
+    */
+    std::size_t
+    loadCaches(boost::filesystem::path const& file);
+
     void
     missingNodeAcquireByHash(uint256 const& hash, std::uint32_t seq) override
     {
@@ -33,12 +33,17 @@
 #include <ripple/shamap/SHAMapMissingNode.h>
 #include <ripple/shamap/SHAMapTreeNode.h>
 #include <ripple/shamap/TreeNodeCache.h>
+#include <boost/container/static_vector.hpp>
+#include <array>
 #include <cassert>
+#include <exception>
 #include <stack>
+#include <thread>
 #include <vector>
 
 namespace ripple {
 
+class JobQueue;
 class SHAMapNodeID;
 class SHAMapSyncFilter;
 
@@ -164,6 +169,11 @@ public:
     const_iterator
     end() const;
 
+    /** Builds an empty map bottom up from items supplied in key order.
+        @see addSortedItems
+    */
+    class Builder;
+
     //--------------------------------------------------------------------------
 
     // Returns a new map that's a snapshot of this one.
@@ -210,6 +220,22 @@ public:
         SHAMapNodeType type,
         boost::intrusive_ptr<SHAMapItem const> item);
 
+    /** Add many items to an empty map at once.
+
+        The tree is built bottom up from the sorted items, so each node is
+        created once instead of being revisited by every later insertion.
+        The subtrees below the root are built on separate threads when
+        there are enough items to make that worthwhile. Use a Builder when
+        the items are produced one at a time.
+
+        @param items The items, sorted by key, without duplicates.
+        @return false if the map is not empty or the items are not sorted.
+    */
+    bool
+    addSortedItems(
+        SHAMapNodeType type,
+        std::vector<boost::intrusive_ptr<SHAMapItem const>> const& items);
+
     // Save a copy if you need to extend the life
     // of the SHAMapItem beyond this SHAMap
     boost::intrusive_ptr<SHAMapItem const> const&
@@ -323,6 +349,20 @@ public:
         Slice const& rawNode,
         SHAMapSyncFilter* filter);
 
+    /** Add a batch of nodes, such as those carried by one reply.
+
+        The nodes are added in order of depth, so each is hooked below the
+        nodes added before it, and each descent resumes from the deepest
+        inner node it shares with the previous one instead of the root.
+        The filter is given the nodes once all of them have been added.
+
+        Stops at the first invalid node.
+    */
+    SHAMapAddNode
+    addKnownNodes(
+        std::vector<std::pair<SHAMapNodeID, Slice>> nodes,
+        SHAMapSyncFilter* filter);
+
     // status functions
     void
     setImmutable();
@@ -340,6 +380,17 @@ public:
     bool
     compare(SHAMap const& otherMap, Delta& differences, int maxCount) const;
 
+    /** Like compare, but compares the differing top-level branches of the
+        two maps concurrently, one client RPC job per branch. Worthwhile
+        only for large maps, such as full state trees of ledgers far apart.
+    */
+    bool
+    compareParallel(
+        SHAMap const& otherMap,
+        Delta& differences,
+        int maxCount,
+        JobQueue& jobQueue) const;
+
     /** Convert any modified nodes to shared. */
     int
     unshare();
@@ -348,12 +399,65 @@ public:
     int
     flushDirty(NodeObjectType t);
 
+    /** Convert modified nodes to shared, leaving storing them for later.
+
+        The nodes are hashed and canonicalized exactly as by flushDirty,
+        so the map's hash is final on return, but rather than being
+        written to the nodestore they are appended to `nodes`, to be
+        passed to storeNodes.
+    */
+    int
+    flushDirty(
+        NodeObjectType t,
+        std::vector<std::shared_ptr<SHAMapTreeNode>>& nodes);
+
+    /** Write nodes collected by flushDirty to the nodestore.
+
+        The nodes are shared, so this may be called from any thread.
+    */
+    void
+    storeNodes(
+        NodeObjectType t,
+        std::vector<std::shared_ptr<SHAMapTreeNode>> const& nodes) const;
+
     void
     walkMap(std::vector<SHAMapMissingNode>& missingNodes, int maxMissing) const;
+
+    /** Walk the map looking for missing nodes, using several threads.
+
+        The map is split into the subtrees two levels below the root, and
+        the worker threads take subtrees from that list until none remain.
+        Nodes that are not in memory
+        are fetched through the NodeStore read threads, a node's children at
+        a time. Progress is logged while the walk runs.
+
+        @param missingNodes Receives up to maxMissing missing nodes.
+        @param workers The number of threads to use, or 0 for one thread
+                       per root branch.
+        @return false if a worker could not finish its walk.
+    */
     bool
     walkMapParallel(
         std::vector<SHAMapMissingNode>& missingNodes,
-        int maxMissing) const;
+        int maxMissing,
+        int workers = 0) const;
+
+    /** Bring the nodes on the paths to some keys into memory.
+
+        The paths are walked together, one level at a time, and the nodes
+        of each level that are not in memory are read as one batch by the
+        NodeStore read threads. The nodes read are hooked into the map, so
+        that later lookups of the keys find them without touching the
+        database. Keys need not be in the map: the nodes read are those a
+        lookup of the key would have to read. Missing nodes are skipped.
+
+        The map must not be modified while this runs.
+
+        @param keys The keys. Their order does not matter.
+    */
+    void
+    prefetch(std::vector<uint256> keys) const;
+
     bool
     deepCompare(SHAMap& other) const;  // Intended for debug/test only
 
@@ -366,8 +470,13 @@ public:
     invariants() const;
 
 private:
-    using SharedPtrNodeStack =
-        std::stack<std::pair<std::shared_ptr<SHAMapTreeNode>, SHAMapNodeID>>;
+    // A path from the root holds at most one node per level, so it is
+    // kept inline rather than in a deque that allocates on first use.
+    using SharedPtrNodeStack = std::stack<
+        std::pair<std::shared_ptr<SHAMapTreeNode>, SHAMapNodeID>,
+        boost::container::static_vector<
+            std::pair<std::shared_ptr<SHAMapTreeNode>, SHAMapNodeID>,
+            leafDepth + 1>>;
     using DeltaRef = std::pair<
         boost::intrusive_ptr<SHAMapItem const>,
         boost::intrusive_ptr<SHAMapItem const>>;
@@ -391,6 +500,16 @@ private:
     std::shared_ptr<SHAMapTreeNode>
     checkFilter(SHAMapHash const& hash, SHAMapSyncFilter* filter) const;
 
+    /** Build the subtree holding a sorted, non-empty range of items */
+    using SortedItemIter =
+        std::vector<boost::intrusive_ptr<SHAMapItem const>>::const_iterator;
+    std::shared_ptr<SHAMapTreeNode>
+    makeSubtree(
+        SHAMapNodeType type,
+        SHAMapNodeID const& nodeID,
+        SortedItemIter first,
+        SortedItemIter last) const;
+
     /** Update hashes up to the root */
     void
     dirtyUp(
@@ -418,9 +537,16 @@ private:
     std::shared_ptr<Node>
     preFlushNode(std::shared_ptr<Node> node) const;
 
-    /** write and canonicalize modified node */
+    /** write and canonicalize modified node
+
+        If deferred is not null the node is appended to it instead of
+        being written.
+    */
     std::shared_ptr<SHAMapTreeNode>
-    writeNode(NodeObjectType t, std::shared_ptr<SHAMapTreeNode> node) const;
+    writeNode(
+        NodeObjectType t,
+        std::shared_ptr<SHAMapTreeNode> node,
+        std::vector<std::shared_ptr<SHAMapTreeNode>>* deferred = nullptr) const;
 
     // returns the first item at or below this node
     SHAMapLeafNode*
@@ -477,6 +603,30 @@ private:
         int branch,
         SHAMapSyncFilter* filter) const;
 
+    // The inner nodes on the way to the last node added, from the root
+    using DescentPath = std::vector<std::pair<SHAMapTreeNode*, SHAMapNodeID>>;
+
+    /** Hook a node received from a peer into the map.
+
+        The descent starts from the deepest node of the path which is an
+        ancestor of the node, and leaves the path leading to the node.
+        A node which was added is appended to hooked.
+    */
+    SHAMapAddNode
+    hookKnownNode(
+        SHAMapNodeID const& node,
+        Slice const& rawNode,
+        SHAMapSyncFilter* filter,
+        std::uint32_t generation,
+        DescentPath& path,
+        std::vector<std::shared_ptr<SHAMapTreeNode>>& hooked);
+
+    /** Give the nodes which were added to the filter. */
+    void
+    gotKnownNodes(
+        std::vector<std::shared_ptr<SHAMapTreeNode>> const& hooked,
+        SHAMapSyncFilter* filter) const;
+
     // Non-storing
     // Does not hook the returned node to its parent
     std::shared_ptr<SHAMapTreeNode>
@@ -502,8 +652,18 @@ private:
         bool isFirstMap,
         Delta& differences,
         int& maxCount) const;
+    bool
+    compareBranch(
+        SHAMapTreeNode* ours,
+        SHAMapTreeNode* other,
+        SHAMap const& otherMap,
+        Delta& differences,
+        int& maxCount) const;
     int
-    walkSubTree(bool doWrite, NodeObjectType t);
+    walkSubTree(
+        bool doWrite,
+        NodeObjectType t,
+        std::vector<std::shared_ptr<SHAMapTreeNode>>* deferred = nullptr);
 
     // Structure to track information about call to
     // getMissingNodes while it's in progress
@@ -517,7 +677,7 @@ private:
         // basic parameters
         int max_;
         SHAMapSyncFilter* filter_;
-        int const maxDefer_;
+        int maxDefer_;  // grows while the reads are slower than the search
         std::uint32_t generation_;
 
         // nodes we have discovered to be missing
@@ -547,6 +707,7 @@ private:
             std::shared_ptr<SHAMapTreeNode>>;  // node
 
         int deferred_;
+        std::set<SHAMapHash> pendingHashes_;
         std::mutex deferLock_;
         std::condition_variable deferCondVar_;
         std::vector<DeferredNode> finishedReads_;
@@ -575,9 +736,16 @@ private:
     void
     gmn_ProcessNodes(MissingNodes&, MissingNodes::StackEntry& node);
     void
-    gmn_ProcessDeferredReads(MissingNodes&);
+    gmn_ProcessDeferredReads(MissingNodes&, bool all);
 
     // fetch from DB helper function
+    // Get every child of node, reading those not in memory as one batch
+    void
+    fetchChildren(
+        SHAMapInnerNode& node,
+        std::array<std::shared_ptr<SHAMapTreeNode>, branchFactor>& children)
+        const;
+
     std::shared_ptr<SHAMapTreeNode>
     finishFetch(
         SHAMapHash const& hash,
@@ -754,6 +922,68 @@ SHAMap::end() const
     return const_iterator(this, nullptr);
 }
 
+//------------------------------------------------------------------------------
+
+/** Builds a map from items supplied in increasing key order.
+
+    All the items below one branch of the root are adjacent in key order.
+    When an item arrives for a new branch, the subtree of the previous
+    branch is complete, and is built bottom up while later items are still
+    being produced. Large subtrees are built on their own thread, which
+    spreads the cost of hashing the leaves.
+
+    Only the items of the branch being collected are held. Nothing is
+    visible in the map until finish() is called, and a builder which is
+    destroyed first leaves the map empty.
+*/
+class SHAMap::Builder
+{
+public:
+    /** Prepare to build the given map, which must be empty. */
+    Builder(SHAMap& map, SHAMapNodeType type);
+
+    Builder(Builder const&) = delete;
+    Builder&
+    operator=(Builder const&) = delete;
+
+    ~Builder();
+
+    /** Add the next item.
+
+        @return false if the key is not greater than that of the previous
+                item. The item is not added.
+    */
+    bool
+    add(boost::intrusive_ptr<SHAMapItem const> item);
+
+    /** Wait for the subtrees to be built and place them in the map.
+
+        Rethrows any exception thrown while building a subtree.
+    */
+    void
+    finish();
+
+private:
+    /** Build the subtree of the items collected so far */
+    void
+    buildBranch();
+
+    void
+    join() noexcept;
+
+    SHAMap& map_;
+    SHAMapNodeType const type_;
+
+    // The root branch of the items being collected, or -1 if none
+    int branch_ = -1;
+    std::vector<boost::intrusive_ptr<SHAMapItem const>> items_;
+    boost::intrusive_ptr<SHAMapItem const> last_;
+
+    std::array<std::shared_ptr<SHAMapTreeNode>, branchFactor> children_;
+    std::array<std::exception_ptr, branchFactor> errors_;
+    std::vector<std::thread> threads_;
+};
+
 }  // namespace ripple
 
 #endif
@@ -35,6 +35,7 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <span>
 #include <string>
 
 namespace ripple {
@@ -104,6 +105,10 @@ private:
     void
     iterNonEmptyChildIndexes(F&& f) const;
 
+    /** Refresh the cached hashes of the children held in memory. */
+    void
+    updateChildHashes();
+
 public:
     explicit SHAMapInnerNode(
         std::uint32_t cowid,
@@ -162,6 +167,15 @@ public:
     std::shared_ptr<SHAMapTreeNode>
     canonicalizeChild(int branch, std::shared_ptr<SHAMapTreeNode> node);
 
+    /** Hint the CPU to start loading the in-memory children of this node.
+
+        Traversals that only look at hashes touch every child on the next
+        level; issuing the loads up front overlaps the cache misses instead
+        of taking them one child at a time.
+    */
+    void
+    prefetchChildren() const;
+
     // sync functions
     bool
     isFullBelow(std::uint32_t generation) const;
@@ -176,6 +190,15 @@ public:
     void
     updateHashDeep();
 
+    /** Recalculate the hashes of several inner nodes at once.
+
+        This is equivalent to calling updateHashDeep on each node, but the
+        digests are computed together so they can share vector lanes.
+        None of the nodes may be a child of another.
+    */
+    static void
+    updateHashesDeep(std::span<SHAMapInnerNode* const> nodes);
+
     void
     serializeForWire(Serializer&) const override;
 
@@ -22,6 +22,7 @@
 
 #include <ripple/basics/CountedObject.h>
 #include <ripple/basics/base_uint.h>
+#include <cassert>
 #include <optional>
 #include <ostream>
 #include <string>
@@ -154,9 +155,33 @@ deserializeSHAMapNodeID(std::string const& s)
 }
 /** @} */
 
-/** Returns the branch that would contain the given hash */
-[[nodiscard]] unsigned int
-selectBranch(SHAMapNodeID const& id, uint256 const& hash);
+/** Returns the branch that would contain the given hash
+
+    Descending towards a key only needs the depth reached, so walks that
+    do not report the IDs of the nodes they pass keep just the depth
+    rather than building each ID.
+*/
+/** @{ */
+[[nodiscard]] inline unsigned int
+selectBranch(unsigned int depth, uint256 const& hash)
+{
+    auto branch = static_cast<unsigned int>(*(hash.begin() + (depth / 2)));
+
+    if (depth & 1)
+        branch &= 0xf;
+    else
+        branch >>= 4;
+
+    assert(branch < 16);
+    return branch;
+}
+
+[[nodiscard]] inline unsigned int
+selectBranch(SHAMapNodeID const& id, uint256 const& hash)
+{
+    return selectBranch(id.getDepth(), hash);
+}
+/** @} */
 
 }  // namespace ripple
 
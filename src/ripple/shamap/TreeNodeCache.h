@@ -20,11 +20,15 @@
 #ifndef RIPPLE_SHAMAP_TREENODECACHE_H_INCLUDED
 #define RIPPLE_SHAMAP_TREENODECACHE_H_INCLUDED
 
+#include <ripple/basics/ShardedTaggedCache.h>
 #include <ripple/shamap/SHAMapTreeNode.h>
 
 namespace ripple {
 
-using TreeNodeCache = TaggedCache<uint256, SHAMapTreeNode>;
+// Every SHAMap miss goes through this cache, often from many threads at
+// once, so it is sharded to keep them from serializing on one lock.
+using TreeNodeCache =
+    ShardedTaggedCache<uint256, SHAMapTreeNode, digest_hash>;
 
 }  // namespace ripple
 
@@ -0,0 +1,287 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/Log.h>
+#include <ripple/basics/random.h>
+#include <ripple/shamap/FullBelowCache.h>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace ripple {
+namespace detail {
+
+BasicFullBelowCache::BasicFullBelowCache(
+    std::string const& name,
+    clock_type& clock,
+    beast::Journal j,
+    beast::insight::Collector::ptr const& collector,
+    std::size_t target_size,
+    std::chrono::seconds expiration)
+    : name_(name)
+    , clock_(clock)
+    , j_(j)
+    , epoch_(clock.now())
+    , seed_(rand_int<std::uint64_t>())
+    , targetSize_(static_cast<int>(target_size))
+    , expiration_(expiration)
+    , m_gen(1)
+    , stats_(
+          name,
+          std::bind(&BasicFullBelowCache::collect_metrics, this),
+          collector)
+{
+    static_assert(partitionCount == 16, "partitions take the top 4 bits");
+}
+
+std::size_t
+BasicFullBelowCache::size() const
+{
+    std::size_t count = 0;
+    for (auto const& p : partitions_)
+    {
+        std::lock_guard lock(p.mutex);
+        count += p.count;
+    }
+    return count;
+}
+
+void
+BasicFullBelowCache::sweep()
+{
+    using namespace std::chrono;
+
+    auto const start = steady_clock::now();
+    auto const now = clock_.now();
+    auto const before = size();
+
+    // Like TaggedCache, age entries out faster while over the target
+    clock_type::duration age = expiration_;
+    if (auto const target = targetSize_.load();
+        target > 0 && before > static_cast<std::size_t>(target))
+    {
+        age = std::max<clock_type::duration>(
+            expiration_ * target / static_cast<std::int64_t>(before),
+            seconds(1));
+    }
+
+    // Entries last touched at or before this stamp expire
+    auto const when = now - age;
+    std::uint32_t const expire = when < epoch_ ? 0 : stampOf(when);
+
+    for (auto& p : partitions_)
+    {
+        std::lock_guard lock(p.mutex);
+        if (p.count == 0)
+            continue;
+
+        auto const live = static_cast<std::size_t>(std::count_if(
+            p.stamps.begin(), p.stamps.end(), [expire](std::uint32_t s) {
+                return s > expire;
+            }));
+
+        // Shrink the table to fit the entries that remain
+        std::size_t slots = 0;
+        if (live != 0)
+        {
+            slots = minimumSlots;
+            while (live * 4 > slots * 3)
+                slots *= 2;
+        }
+
+        rehash(p, slots, expire);
+    }
+
+    JLOG(j_.debug()) << name_ << " sweep removed " << before - size()
+                     << " of " << before << " entries in "
+                     << duration_cast<milliseconds>(steady_clock::now() - start)
+                            .count()
+                     << "ms";
+}
+
+bool
+BasicFullBelowCache::touch_if_exists(key_type const& key)
+{
+    auto const mixed = mix(key);
+    auto const stamp = stampOf(clock_.now());
+    auto& p = partitionFor(mixed);
+
+    {
+        std::lock_guard lock(p.mutex);
+        if (p.count != 0)
+        {
+            auto const i = probe(p, key, mixed);
+            if (p.stamps[i] != 0)
+            {
+                p.stamps[i] = stamp;
+                ++hits_;
+                return true;
+            }
+        }
+    }
+
+    ++misses_;
+    return false;
+}
+
+void
+BasicFullBelowCache::insert(key_type const& key)
+{
+    auto const mixed = mix(key);
+    auto const stamp = stampOf(clock_.now());
+    auto& p = partitionFor(mixed);
+
+    std::lock_guard lock(p.mutex);
+
+    // Keep the table at most three quarters full
+    if ((p.count + 1) * 4 > p.keys.size() * 3)
+        rehash(p, std::max(minimumSlots, p.keys.size() * 2), 0);
+
+    auto const i = probe(p, key, mixed);
+    if (p.stamps[i] == 0)
+    {
+        p.keys[i] = key;
+        ++p.count;
+    }
+    p.stamps[i] = stamp;
+}
+
+std::vector<BasicFullBelowCache::key_type>
+BasicFullBelowCache::getKeys() const
+{
+    std::vector<key_type> keys;
+    for (auto const& p : partitions_)
+    {
+        std::lock_guard lock(p.mutex);
+        keys.reserve(keys.size() + p.count);
+        for (std::size_t i = 0; i < p.stamps.size(); ++i)
+        {
+            if (p.stamps[i] != 0)
+                keys.push_back(p.keys[i]);
+        }
+    }
+    return keys;
+}
+
+void
+BasicFullBelowCache::clear()
+{
+    for (auto& p : partitions_)
+    {
+        std::lock_guard lock(p.mutex);
+        rehash(p, 0, 0);
+    }
+    ++m_gen;
+}
+
+void
+BasicFullBelowCache::reset()
+{
+    for (auto& p : partitions_)
+    {
+        std::lock_guard lock(p.mutex);
+        rehash(p, 0, 0);
+    }
+    hits_ = 0;
+    misses_ = 0;
+    m_gen = 1;
+}
+
+std::uint64_t
+BasicFullBelowCache::mix(key_type const& key) const
+{
+    // The keys are hashes already, but mixing in a random seed keeps
+    // anyone from choosing keys that crowd into the same slots.
+    std::uint64_t h;
+    std::memcpy(&h, key.data(), sizeof(h));
+    h ^= seed_;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+std::uint32_t
+BasicFullBelowCache::stampOf(clock_type::time_point when) const
+{
+    using namespace std::chrono;
+    return static_cast<std::uint32_t>(
+        duration_cast<seconds>(when - epoch_).count() + 1);
+}
+
+BasicFullBelowCache::Partition&
+BasicFullBelowCache::partitionFor(std::uint64_t mixed)
+{
+    return partitions_[mixed >> 60];
+}
+
+std::size_t
+BasicFullBelowCache::probe(
+    Partition const& p,
+    key_type const& key,
+    std::uint64_t mixed)
+{
+    auto const mask = p.keys.size() - 1;
+    auto i = static_cast<std::size_t>(mixed) & mask;
+    while (p.stamps[i] != 0 && p.keys[i] != key)
+        i = (i + 1) & mask;
+    return i;
+}
+
+void
+BasicFullBelowCache::rehash(
+    Partition& p,
+    std::size_t slots,
+    std::uint32_t expire) const
+{
+    std::vector<key_type> keys(slots);
+    std::vector<std::uint32_t> stamps(slots);
+    std::swap(keys, p.keys);
+    std::swap(stamps, p.stamps);
+    p.count = 0;
+
+    if (slots == 0)
+        return;
+
+    for (std::size_t i = 0; i < stamps.size(); ++i)
+    {
+        if (stamps[i] <= expire)
+            continue;
+
+        auto const j = probe(p, keys[i], mix(keys[i]));
+        p.keys[j] = keys[i];
+        p.stamps[j] = stamps[i];
+        ++p.count;
+    }
+}
+
+void
+BasicFullBelowCache::collect_metrics()
+{
+    stats_.size.set(size());
+
+    auto const [hits, misses] = getHitsAndMisses();
+    if (auto const total = hits + misses; total != 0)
+        stats_.hit_rate.set((hits * 100) / total);
+}
+
+}  // namespace detail
+}  // namespace ripple
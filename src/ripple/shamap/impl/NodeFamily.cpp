@@ -20,7 +20,10 @@
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/main/Tuning.h>
+#include <ripple/basics/FileUtilities.h>
+#include <ripple/protocol/Serializer.h>
 #include <ripple/shamap/NodeFamily.h>
+#include <boost/filesystem/operations.hpp>
 #include <sstream>
 
 namespace ripple {
@@ -102,6 +105,134 @@ NodeFamily::missingNodeAcquireBySeq(std::uint32_t seq, uint256 const& nodeHash)
     }
 }
 
+// Identifies a file written by saveCaches, and the version of its layout
+static std::uint32_t constexpr cacheSnapshotMagic = 0x52434E31;  // "RCN1"
+
+void
+NodeFamily::saveCaches(boost::filesystem::path const& file) const
+{
+    auto const fullBelow = fbCache_->getKeys();
+    auto const treeNodes = tnCache_->getKeys();
+
+    Serializer s(
+        64 + db_.getName().size() +
+        (fullBelow.size() + treeNodes.size()) * uint256::bytes);
+    s.add32(cacheSnapshotMagic);
+    s.addVL(makeSlice(db_.getName()));
+    s.add64(fullBelow.size());
+    for (auto const& key : fullBelow)
+        s.addBitString(key);
+    s.add64(treeNodes.size());
+    for (auto const& key : treeNodes)
+        s.addBitString(key);
+
+    boost::system::error_code ec;
+    writeFileContentsAtomic(ec, file, s.getString());
+    if (ec)
+    {
+        JLOG(j_.error()) << "Unable to write cache snapshot " << file << ": "
+                         << ec.message();
+        return;
+    }
+
+    JLOG(j_.info()) << "Saved " << fullBelow.size() << " full below and "
+                    << treeNodes.size() << " tree node keys to " << file;
+}
+
+std::size_t
+NodeFamily::loadCaches(boost::filesystem::path const& file)
+{
+    boost::system::error_code ec;
+    auto const data = getFileContents(ec, file);
+    if (ec)
+    {
+        if (ec != boost::system::errc::no_such_file_or_directory)
+            JLOG(j_.error()) << "Unable to read cache snapshot " << file
+                             << ": " << ec.message();
+        return 0;
+    }
+
+    boost::filesystem::remove(file, ec);
+    if (ec)
+    {
+        // Reusing the file on a later start could claim nodes that are no
+        // longer stored are full below.
+        JLOG(j_.error()) << "Unable to remove cache snapshot " << file << ": "
+                         << ec.message();
+        return 0;
+    }
+
+    std::vector<uint256> fullBelow;
+    std::vector<uint256> treeNodes;
+    try
+    {
+        SerialIter sit(makeSlice(data));
+        if (sit.get32() != cacheSnapshotMagic)
+        {
+            JLOG(j_.warn()) << "Ignoring unrecognized cache snapshot " << file;
+            return 0;
+        }
+
+        auto const name = sit.getVL();
+        if (std::string(name.begin(), name.end()) != db_.getName())
+        {
+            JLOG(j_.warn()) << "Ignoring cache snapshot " << file
+                            << " of a different node store";
+            return 0;
+        }
+
+        auto readKeys = [&sit](std::vector<uint256>& keys) {
+            auto const count = sit.get64();
+            if (count > sit.getBytesLeft() / uint256::bytes)
+                Throw<std::runtime_error>("truncated");
+            keys.reserve(count);
+            for (std::uint64_t i = 0; i < count; ++i)
+                keys.push_back(sit.get256());
+        };
+        readKeys(fullBelow);
+        readKeys(treeNodes);
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.warn()) << "Ignoring damaged cache snapshot " << file << ": "
+                        << e.what();
+        return 0;
+    }
+
+    for (auto const& key : fullBelow)
+        fbCache_->insert(key);
+
+    for (auto const& key : treeNodes)
+    {
+        db_.asyncFetch(
+            key,
+            0,
+            [cache = tnCache_,
+             j = j_](std::shared_ptr<NodeObject> const& object) {
+                if (!object)
+                    return;
+                try
+                {
+                    auto const hash = SHAMapHash{object->getHash()};
+                    auto node = SHAMapTreeNode::makeFromPrefix(
+                        object->getData(), hash);
+                    if (node)
+                        cache->canonicalize_replace_client(
+                            hash.as_uint256(), node);
+                }
+                catch (std::exception const& e)
+                {
+                    JLOG(j.warn()) << "Cache snapshot prefetch: " << e.what();
+                }
+            });
+    }
+
+    JLOG(j_.info()) << "Loaded " << fullBelow.size() << " full below and "
+                    << treeNodes.size() << " tree node keys from " << file;
+
+    return fullBelow.size() + treeNodes.size();
+}
+
 void
 NodeFamily::acquire(uint256 const& hash, std::uint32_t seq)
 {
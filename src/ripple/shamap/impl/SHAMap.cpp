@@ -24,6 +24,8 @@
 #include <ripple/shamap/SHAMapSyncFilter.h>
 #include <ripple/shamap/SHAMapTxLeafNode.h>
 #include <ripple/shamap/SHAMapTxPlusMetaLeafNode.h>
+#include <algorithm>
+#include <exception>
 
 namespace ripple {
 
@@ -128,6 +130,29 @@ SHAMapLeafNode*
 SHAMap::walkTowardsKey(uint256 const& id, SharedPtrNodeStack* stack) const
 {
     assert(stack == nullptr || stack->empty());
+
+    if (stack == nullptr)
+    {
+        // Nothing needs to hold on to the path, and every node on it is
+        // kept alive by its parent, so walk raw pointers. This keeps
+        // lookups from bouncing the reference counts of the upper nodes,
+        // which every thread reading the map shares, between cores.
+        SHAMapTreeNode* node = root_.get();
+        unsigned int depth = 0;
+
+        while (node->isInner())
+        {
+            auto const inner = static_cast<SHAMapInnerNode*>(node);
+            auto const branch = selectBranch(depth++, id);
+            if (inner->isEmptyBranch(branch))
+                return nullptr;
+
+            node = descendThrow(inner, branch);
+        }
+
+        return static_cast<SHAMapLeafNode*>(node);
+    }
+
     auto inNode = root_;
     SHAMapNodeID nodeID;
 
@@ -187,7 +212,7 @@ SHAMap::finishFetch(
         }
 
         auto node =
-            SHAMapTreeNode::makeFromPrefix(makeSlice(object->getData()), hash);
+            SHAMapTreeNode::makeFromPrefix(object->getData(), hash);
         if (node)
             canonicalize(hash, node);
         return node;
@@ -453,9 +478,9 @@ SHAMap::belowHelper(
     auto& [init, cmp, incr] = loopParams;
     if (node->isLeaf())
     {
-        auto n = std::static_pointer_cast<SHAMapLeafNode>(node);
-        stack.push({node, {leafDepth, n->peekItem()->key()}});
-        return n.get();
+        auto n = static_cast<SHAMapLeafNode*>(node.get());
+        stack.push({std::move(node), {leafDepth, n->peekItem()->key()}});
+        return n;
     }
     auto inner = std::static_pointer_cast<SHAMapInnerNode>(node);
     if (stack.empty())
@@ -470,9 +495,10 @@ SHAMap::belowHelper(
             assert(!stack.empty());
             if (node->isLeaf())
             {
-                auto n = std::static_pointer_cast<SHAMapLeafNode>(node);
-                stack.push({n, {leafDepth, n->peekItem()->key()}});
-                return n.get();
+                auto n = static_cast<SHAMapLeafNode*>(node.get());
+                stack.push(
+                    {std::move(node), {leafDepth, n->peekItem()->key()}});
+                return n;
             }
             inner = std::static_pointer_cast<SHAMapInnerNode>(node);
             stack.push({inner, stack.top().second.getChildNodeID(branch)});
@@ -567,15 +593,16 @@ SHAMap::peekNextItem(uint256 const& id, SharedPtrNodeStack& stack) const
     stack.pop();
     while (!stack.empty())
     {
-        auto [node, nodeID] = stack.top();
+        auto const& [node, nodeID] = stack.top();
         assert(!node->isLeaf());
-        auto inner = std::static_pointer_cast<SHAMapInnerNode>(node);
+        auto const inner = static_cast<SHAMapInnerNode*>(node.get());
         for (auto i = selectBranch(nodeID, id) + 1; i < branchFactor; ++i)
         {
             if (!inner->isEmptyBranch(i))
             {
-                node = descendThrow(inner, i);
-                auto leaf = firstBelow(node, stack, i);
+                // Only the reference that goes on the stack is taken
+                descendThrow(inner, i);
+                auto leaf = firstBelow(inner->getChild(i), stack, i);
                 if (!leaf)
                     Throw<SHAMapMissingNode>(type_, id);
                 assert(leaf->isLeaf());
@@ -848,6 +875,155 @@ SHAMap::addItem(
     return addGiveItem(type, std::move(item));
 }
 
+bool
+SHAMap::addSortedItems(
+    SHAMapNodeType type,
+    std::vector<boost::intrusive_ptr<SHAMapItem const>> const& items)
+{
+    assert(state_ != SHAMapState::Immutable);
+    assert(type != SHAMapNodeType::tnINNER);
+
+    if (!root_->isInner() ||
+        !std::static_pointer_cast<SHAMapInnerNode>(root_)->isEmpty())
+        return false;
+
+    Builder builder(*this, type);
+    for (auto const& item : items)
+    {
+        if (!builder.add(item))
+            return false;
+    }
+    builder.finish();
+    return true;
+}
+
+std::shared_ptr<SHAMapTreeNode>
+SHAMap::makeSubtree(
+    SHAMapNodeType type,
+    SHAMapNodeID const& nodeID,
+    SortedItemIter first,
+    SortedItemIter last) const
+{
+    assert(first != last);
+
+    // A single item is a leaf as high in the tree as it can be
+    if (std::next(first) == last)
+        return makeTypedLeaf(type, *first, cowid_);
+
+    auto inner = std::make_shared<SHAMapInnerNode>(cowid_);
+    while (first != last)
+    {
+        auto const branch = selectBranch(nodeID, (*first)->key());
+        auto const end = std::find_if(first, last, [&](auto const& item) {
+            return selectBranch(nodeID, item->key()) != branch;
+        });
+        inner->setChild(
+            branch,
+            makeSubtree(type, nodeID.getChildNodeID(branch), first, end));
+        first = end;
+    }
+    return inner;
+}
+
+//------------------------------------------------------------------------------
+
+SHAMap::Builder::Builder(SHAMap& map, SHAMapNodeType type)
+    : map_(map), type_(type)
+{
+    assert(map_.state_ != SHAMapState::Immutable);
+    assert(type_ != SHAMapNodeType::tnINNER);
+
+    if (!map_.root_->isInner() ||
+        !std::static_pointer_cast<SHAMapInnerNode>(map_.root_)->isEmpty())
+        LogicError("SHAMap::Builder: map is not empty");
+}
+
+SHAMap::Builder::~Builder()
+{
+    join();
+}
+
+bool
+SHAMap::Builder::add(boost::intrusive_ptr<SHAMapItem const> item)
+{
+    if (last_ && item->key() <= last_->key())
+        return false;
+
+    auto const branch = selectBranch(SHAMapNodeID{}, item->key());
+    if (branch != branch_)
+    {
+        buildBranch();
+        branch_ = branch;
+    }
+
+    last_ = item;
+    items_.push_back(std::move(item));
+    return true;
+}
+
+void
+SHAMap::Builder::finish()
+{
+    buildBranch();
+    join();
+
+    for (auto const& error : errors_)
+    {
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    auto root = std::make_shared<SHAMapInnerNode>(map_.cowid_);
+    for (int branch = 0; branch < branchFactor; ++branch)
+    {
+        if (children_[branch])
+            root->setChild(branch, std::move(children_[branch]));
+    }
+    map_.root_ = std::move(root);
+}
+
+void
+SHAMap::Builder::buildBranch()
+{
+    if (items_.empty())
+        return;
+
+    auto const size = items_.size();
+    auto build = [this,
+                  branch = branch_,
+                  items = std::move(items_)]() mutable noexcept {
+        try
+        {
+            children_[branch] = map_.makeSubtree(
+                type_,
+                SHAMapNodeID{}.getChildNodeID(branch),
+                items.cbegin(),
+                items.cend());
+        }
+        catch (...)
+        {
+            errors_[branch] = std::current_exception();
+        }
+    };
+    items_.clear();
+
+    // Creating the leaves hashes every item, which dominates the cost, so
+    // only subtrees with enough leaves are worth a thread of their own
+    constexpr std::size_t parallelThreshold = 256;
+    if (size < parallelThreshold)
+        build();
+    else
+        threads_.emplace_back(std::move(build));
+}
+
+void
+SHAMap::Builder::join() noexcept
+{
+    for (auto& t : threads_)
+        t.join();
+    threads_.clear();
+}
+
 SHAMapHash
 SHAMap::getHash() const
 {
@@ -947,13 +1123,22 @@ SHAMap::fetchRoot(SHAMapHash const& hash, SHAMapSyncFilter* filter)
           first call SHAMapTreeNode::unshare().
  */
 std::shared_ptr<SHAMapTreeNode>
-SHAMap::writeNode(NodeObjectType t, std::shared_ptr<SHAMapTreeNode> node) const
+SHAMap::writeNode(
+    NodeObjectType t,
+    std::shared_ptr<SHAMapTreeNode> node,
+    std::vector<std::shared_ptr<SHAMapTreeNode>>* deferred) const
 {
     assert(node->cowid() == 0);
     assert(backed_);
 
     canonicalize(node->getHash(), node);
 
+    if (deferred)
+    {
+        deferred->push_back(node);
+        return node;
+    }
+
     Serializer s;
     node->serializeWithPrefix(s);
     f_.db().store(
@@ -996,7 +1181,38 @@ SHAMap::flushDirty(NodeObjectType t)
 }
 
 int
-SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
+SHAMap::flushDirty(
+    NodeObjectType t,
+    std::vector<std::shared_ptr<SHAMapTreeNode>>& nodes)
+{
+    return walkSubTree(backed_, t, &nodes);
+}
+
+void
+SHAMap::storeNodes(
+    NodeObjectType t,
+    std::vector<std::shared_ptr<SHAMapTreeNode>> const& nodes) const
+{
+    assert(backed_);
+
+    for (auto const& node : nodes)
+    {
+        assert(node->cowid() == 0);
+        Serializer s;
+        node->serializeWithPrefix(s);
+        f_.db().store(
+            t,
+            std::move(s.modData()),
+            node->getHash().as_uint256(),
+            ledgerSeq_);
+    }
+}
+
+int
+SHAMap::walkSubTree(
+    bool doWrite,
+    NodeObjectType t,
+    std::vector<std::shared_ptr<SHAMapTreeNode>>* deferred)
 {
     assert(!doWrite || backed_);
 
@@ -1005,6 +1221,17 @@ SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
     if (!root_ || (root_->cowid() == 0))
         return flushed;
 
+    // Inner nodes can only be written once their children are, but the
+    // nodes are stored in depth-first order of their position in the
+    // tree, so that reading a subtree back touches nearby records. Each
+    // node is numbered as the walk first reaches it, and the nodes are
+    // put in that order before they are stored or handed back.
+    std::vector<std::shared_ptr<SHAMapTreeNode>> local;
+    auto& out = deferred ? *deferred : local;
+    auto const first = out.size();
+    std::vector<std::uint32_t> order;
+    std::uint32_t visited = 0;
+
     if (root_->isLeaf())
     {  // special case -- root_ is leaf
         root_ = preFlushNode(std::move(root_));
@@ -1012,7 +1239,7 @@ SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
         root_->unshare();
 
         if (doWrite)
-            root_ = writeNode(t, std::move(root_));
+            root_ = writeNode(t, std::move(root_), deferred);
 
         return 1;
     }
@@ -1025,14 +1252,32 @@ SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
         return 1;
     }
 
-    // Stack of {parent,index,child} pointers representing
+    // Stack of {parent,index,number} entries representing
     // inner nodes we are in the process of flushing
-    using StackEntry = std::pair<std::shared_ptr<SHAMapInnerNode>, int>;
+    struct StackEntry
+    {
+        std::shared_ptr<SHAMapInnerNode> node;
+        int pos;
+        std::uint32_t number;
+    };
     std::stack<StackEntry, std::vector<StackEntry>> stack;
 
+    // Inner nodes whose children have all been flushed, grouped by depth.
+    // The nodes on one level don't depend on each other, so each level is
+    // hashed in a single batch once the level below it has been written.
+    struct Pending
+    {
+        std::shared_ptr<SHAMapInnerNode> node;
+        SHAMapInnerNode* parent;
+        int branch;
+        std::uint32_t number;
+    };
+    std::vector<std::vector<Pending>> levels;
+
     node = preFlushNode(std::move(node));
 
     int pos = 0;
+    std::uint32_t number = visited++;
 
     // We can't flush an inner node until we flush its children
     while (1)
@@ -1060,13 +1305,14 @@ SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
                     {
                         // save our place and work on this node
 
-                        stack.emplace(std::move(node), branch);
+                        stack.push({std::move(node), branch, number});
                         // The semantics of this changes when we move to c++-20
                         // Right now no move will occur; With c++-20 child will
                         // be moved from.
                         node = std::static_pointer_cast<SHAMapInnerNode>(
                             std::move(child));
                         pos = 0;
+                        number = visited++;
                     }
                     else
                     {
@@ -1078,7 +1324,11 @@ SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
                         child->unshare();
 
                         if (doWrite)
-                            child = writeNode(t, std::move(child));
+                        {
+                            child = writeNode(t, std::move(child), &out);
+                            order.push_back(visited);
+                        }
+                        ++visited;
 
                         node->shareChild(branch, child);
                     }
@@ -1086,36 +1336,81 @@ SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
             }
         }
 
-        // update the hash of this inner node
-        node->updateHashDeep();
-
-        // This inner node can now be shared
-        node->unshare();
-
-        if (doWrite)
-            node = std::static_pointer_cast<SHAMapInnerNode>(
-                writeNode(t, std::move(node)));
-
-        ++flushed;
+        // All of this inner node's children have been visited
+        auto const depth = stack.size();
+        if (levels.size() <= depth)
+            levels.resize(depth + 1);
 
         if (stack.empty())
+        {
+            levels[depth].push_back({std::move(node), nullptr, 0, number});
             break;
+        }
 
-        auto parent = std::move(stack.top().first);
-        pos = stack.top().second;
+        auto parent = std::move(stack.top().node);
+        pos = stack.top().pos;
+        auto const parentNumber = stack.top().number;
         stack.pop();
 
-        // Hook this inner node to its parent
-        assert(parent->cowid() == cowid_);
-        parent->shareChild(pos, node);
+        levels[depth].push_back({std::move(node), parent.get(), pos, number});
 
         // Continue with parent's next child, if any
         node = std::move(parent);
+        number = parentNumber;
         ++pos;
     }
 
-    // Last inner node is the new root_
-    root_ = std::move(node);
+    std::vector<SHAMapInnerNode*> batch;
+
+    for (auto level = levels.rbegin(); level != levels.rend(); ++level)
+    {
+        // update the hashes of the inner nodes on this level
+        batch.clear();
+        for (auto const& pending : *level)
+            batch.push_back(pending.node.get());
+        SHAMapInnerNode::updateHashesDeep(batch);
+
+        for (auto& [inner, parent, branch, position] : *level)
+        {
+            // This inner node can now be shared
+            inner->unshare();
+
+            if (doWrite)
+            {
+                inner = std::static_pointer_cast<SHAMapInnerNode>(
+                    writeNode(t, std::move(inner), &out));
+                order.push_back(position);
+            }
+
+            ++flushed;
+
+            if (parent)
+            {
+                // Hook this inner node to its parent
+                assert(parent->cowid() == cowid_);
+                parent->shareChild(branch, inner);
+            }
+            else
+            {
+                // The only node without a parent is the new root_
+                root_ = std::move(inner);
+            }
+        }
+    }
+
+    if (doWrite)
+    {
+        // Every node the walk reached was written, so the numbers are
+        // exactly the positions of the nodes in depth-first order
+        assert(order.size() == visited && out.size() == first + visited);
+        std::vector<std::shared_ptr<SHAMapTreeNode>> sorted(visited);
+        for (std::size_t i = 0; i < visited; ++i)
+            sorted[order[i]] = std::move(out[first + i]);
+        std::move(sorted.begin(), sorted.end(), out.begin() + first);
+
+        if (!deferred)
+            storeNodes(t, local);
+    }
 
     return flushed;
 }
@@ -18,10 +18,17 @@
 //==============================================================================
 
 #include <ripple/basics/contract.h>
+#include <ripple/core/ParallelFor.h>
 #include <ripple/shamap/SHAMap.h>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <stack>
+#include <thread>
 #include <vector>
 
 namespace ripple {
@@ -133,11 +140,23 @@ SHAMap::compare(SHAMap const& otherMap, Delta& differences, int maxCount) const
     if (getHash() == otherMap.getHash())
         return true;
 
+    return compareBranch(
+        root_.get(), otherMap.root_.get(), otherMap, differences, maxCount);
+}
+
+bool
+SHAMap::compareBranch(
+    SHAMapTreeNode* ourRoot,
+    SHAMapTreeNode* otherRoot,
+    SHAMap const& otherMap,
+    Delta& differences,
+    int& maxCount) const
+{
     using StackEntry = std::pair<SHAMapTreeNode*, SHAMapTreeNode*>;
     std::stack<StackEntry, std::vector<StackEntry>>
         nodeStack;  // track nodes we've pushed
 
-    nodeStack.push({root_.get(), otherMap.root_.get()});
+    nodeStack.push({ourRoot, otherRoot});
     while (!nodeStack.empty())
     {
         auto [ourNode, otherNode] = nodeStack.top();
@@ -200,6 +219,8 @@ SHAMap::compare(SHAMap const& otherMap, Delta& differences, int maxCount) const
         {
             auto ours = static_cast<SHAMapInnerNode*>(ourNode);
             auto other = static_cast<SHAMapInnerNode*>(otherNode);
+            ours->prefetchChildren();
+            other->prefetchChildren();
             for (int i = 0; i < 16; ++i)
                 if (ours->getChildHash(i) != other->getChildHash(i))
                 {
@@ -232,6 +253,87 @@ SHAMap::compare(SHAMap const& otherMap, Delta& differences, int maxCount) const
     return true;
 }
 
+bool
+SHAMap::compareParallel(
+    SHAMap const& otherMap,
+    Delta& differences,
+    int maxCount,
+    JobQueue& jobQueue) const
+{
+    assert(isValid() && otherMap.isValid());
+
+    if (getHash() == otherMap.getHash())
+        return true;
+
+    if (!root_->isInner() || !otherMap.root_->isInner())
+        return compare(otherMap, differences, maxCount);
+
+    auto ours = static_cast<SHAMapInnerNode*>(root_.get());
+    auto other = static_cast<SHAMapInnerNode*>(otherMap.root_.get());
+
+    std::vector<int> branches;
+    for (int i = 0; i < 16; ++i)
+        if (ours->getChildHash(i) != other->getChildHash(i))
+            branches.push_back(i);
+
+    // A job per branch only pays off if there are several to compare
+    if (branches.size() < 2)
+        return compare(otherMap, differences, maxCount);
+
+    ours->prefetchChildren();
+    other->prefetchChildren();
+
+    // Each top branch is compared independently into its own Delta. No
+    // single branch can hold more than maxCount differences, so each one
+    // stops at that limit and the combined limit is applied on merging.
+    std::array<Delta, 16> deltas;
+    std::array<bool, 16> complete{};
+
+    parallelFor(
+        jobQueue,
+        jtCLIENT_RPC,
+        "SHAMap::compareParallel",
+        branches.size(),
+        branches.size() - 1,
+        [&](std::size_t n) {
+            auto const i = branches[n];
+            int budget = maxCount;
+            if (other->isEmptyBranch(i))
+                complete[i] = walkBranch(
+                    descendThrow(ours, i), nullptr, true, deltas[i], budget);
+            else if (ours->isEmptyBranch(i))
+                complete[i] = otherMap.walkBranch(
+                    otherMap.descendThrow(other, i),
+                    nullptr,
+                    false,
+                    deltas[i],
+                    budget);
+            else
+                complete[i] = compareBranch(
+                    descendThrow(ours, i),
+                    otherMap.descendThrow(other, i),
+                    otherMap,
+                    deltas[i],
+                    budget);
+            return true;
+        });
+
+    // Merge in branch order; like compare, stop after maxCount differences
+    for (auto const i : branches)
+    {
+        for (auto& difference : deltas[i])
+        {
+            differences.insert(std::move(difference));
+            if (--maxCount <= 0)
+                return false;
+        }
+        if (!complete[i])
+            return false;
+    }
+
+    return true;
+}
+
 void
 SHAMap::walkMap(std::vector<SHAMapMissingNode>& missingNodes, int maxMissing)
     const
@@ -248,11 +350,18 @@ SHAMap::walkMap(std::vector<SHAMapMissingNode>& missingNodes, int maxMissing)
     {
         std::shared_ptr<SHAMapInnerNode> node = std::move(nodeStack.top());
         nodeStack.pop();
+        node->prefetchChildren();
 
         for (int i = 0; i < 16; ++i)
         {
             if (!node->isEmptyBranch(i))
             {
+                // Leaves already in memory need no further work; skip them
+                // without taking a reference.
+                if (auto const child = node->getChildPointer(i);
+                    child && !child->isInner())
+                    continue;
+
                 std::shared_ptr<SHAMapTreeNode> nextNode =
                     descendNoStore(node, i);
 
@@ -274,93 +383,219 @@ SHAMap::walkMap(std::vector<SHAMapMissingNode>& missingNodes, int maxMissing)
     }
 }
 
+void
+SHAMap::fetchChildren(
+    SHAMapInnerNode& node,
+    std::array<std::shared_ptr<SHAMapTreeNode>, branchFactor>& children) const
+{
+    // The fetch results live apart from this frame so that a callback run
+    // after we stopped waiting for it, during shutdown, is harmless.
+    struct Pending
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        int count = 0;
+        std::array<std::shared_ptr<NodeObject>, branchFactor> objects;
+    };
+
+    auto const pending = std::make_shared<Pending>();
+    std::array<bool, branchFactor> fetching{};
+
+    for (int i = 0; i < branchFactor; ++i)
+    {
+        children[i].reset();
+        if (node.isEmptyBranch(i))
+            continue;
+
+        children[i] = node.getChild(i);
+        if (children[i] || !backed_)
+            continue;
+
+        auto const& hash = node.getChildHash(i);
+        if ((children[i] = cacheLookup(hash)))
+            continue;
+
+        fetching[i] = true;
+        {
+            std::lock_guard lock(pending->mutex);
+            ++pending->count;
+        }
+
+        // The NodeStore read threads look up queued requests in bundles
+        f_.db().asyncFetch(
+            hash.as_uint256(),
+            ledgerSeq_,
+            [pending, i](std::shared_ptr<NodeObject> const& object) {
+                std::lock_guard lock(pending->mutex);
+                pending->objects[i] = object;
+                if (--pending->count == 0)
+                    pending->cv.notify_all();
+            });
+    }
+
+    std::array<std::shared_ptr<NodeObject>, branchFactor> objects;
+    bool stopped = false;
+    {
+        std::unique_lock lock(pending->mutex);
+        while (pending->count != 0 && !stopped)
+        {
+            // A stopping database drops requests without calling back
+            if (pending->cv.wait_for(lock, std::chrono::milliseconds(100)) ==
+                std::cv_status::timeout)
+                stopped = f_.db().isStopping();
+        }
+        objects = pending->objects;
+    }
+
+    for (int i = 0; i < branchFactor; ++i)
+    {
+        if (fetching[i] && (objects[i] || !stopped))
+            children[i] = finishFetch(node.getChildHash(i), objects[i]);
+    }
+}
+
 bool
 SHAMap::walkMapParallel(
     std::vector<SHAMapMissingNode>& missingNodes,
-    int maxMissing) const
+    int maxMissing,
+    int workers) const
 {
     if (!root_->isInner())  // root_ is only node, and we have it
-        return false;
+        return true;
 
-    using StackEntry = std::shared_ptr<SHAMapInnerNode>;
-    std::array<std::shared_ptr<SHAMapTreeNode>, 16> topChildren;
+    if (workers <= 0)
+        workers = branchFactor;
+
+    // This mutex is used inside the worker threads to protect `missingNodes`,
+    // `maxMissing`, `exceptions` and `lastReport` from race conditions
+    std::mutex m;
+    std::vector<SHAMapMissingNode> exceptions;
+    std::atomic<bool> stop = false;
+
+    auto const missing = [&](SHAMapHash const& hash) {
+        std::lock_guard l{m};
+        if (maxMissing <= 0)
+            return;
+        missingNodes.emplace_back(type_, hash);
+        if (--maxMissing <= 0)
+            stop = true;
+    };
+
+    // Split the map below the second level, so that the work divides evenly
+    // among up to 256 subtrees however many workers there are.
+    std::vector<std::shared_ptr<SHAMapInnerNode>> subtrees;
     {
+        std::array<std::shared_ptr<SHAMapTreeNode>, branchFactor> children;
+        std::array<std::shared_ptr<SHAMapTreeNode>, branchFactor> grandChildren;
+
         auto const& innerRoot =
             std::static_pointer_cast<SHAMapInnerNode>(root_);
-        for (int i = 0; i < 16; ++i)
+        fetchChildren(*innerRoot, children);
+        for (int i = 0; i < branchFactor && !stop; ++i)
         {
-            if (!innerRoot->isEmptyBranch(i))
-                topChildren[i] = descendNoStore(innerRoot, i);
+            if (innerRoot->isEmptyBranch(i))
+                continue;
+            if (!children[i])
+            {
+                missing(innerRoot->getChildHash(i));
+                continue;
+            }
+            if (!children[i]->isInner())
+                continue;
+
+            auto const& child =
+                std::static_pointer_cast<SHAMapInnerNode>(children[i]);
+            fetchChildren(*child, grandChildren);
+            for (int j = 0; j < branchFactor && !stop; ++j)
+            {
+                if (child->isEmptyBranch(j))
+                    continue;
+                if (!grandChildren[j])
+                    missing(child->getChildHash(j));
+                else if (grandChildren[j]->isInner())
+                    subtrees.push_back(
+                        std::static_pointer_cast<SHAMapInnerNode>(
+                            grandChildren[j]));
+            }
         }
     }
-    std::vector<std::thread> workers;
-    workers.reserve(16);
-    std::vector<SHAMapMissingNode> exceptions;
-    exceptions.reserve(16);
-
-    std::array<std::stack<StackEntry, std::vector<StackEntry>>, 16> nodeStacks;
 
-    // This mutex is used inside the worker threads to protect `missingNodes`
-    // and `maxMissing` from race conditions
-    std::mutex m;
-
-    for (int rootChildIndex = 0; rootChildIndex < 16; ++rootChildIndex)
-    {
-        auto const& child = topChildren[rootChildIndex];
-        if (!child || !child->isInner())
-            continue;
+    auto const start = std::chrono::steady_clock::now();
+    auto lastReport = start;
+    std::atomic<std::size_t> next = 0;
+    std::atomic<std::size_t> finished = 0;
+    std::atomic<std::uint64_t> visited = 0;
 
-        nodeStacks[rootChildIndex].push(
-            std::static_pointer_cast<SHAMapInnerNode>(child));
+    auto const walkSubtrees = [&]() {
+        using StackEntry = std::shared_ptr<SHAMapInnerNode>;
+        std::stack<StackEntry, std::vector<StackEntry>> nodeStack;
+        std::array<std::shared_ptr<SHAMapTreeNode>, branchFactor> children;
 
-        JLOG(journal_.debug()) << "starting worker " << rootChildIndex;
-        workers.push_back(std::thread(
-            [&m, &missingNodes, &maxMissing, &exceptions, this](
-                std::stack<StackEntry, std::vector<StackEntry>> nodeStack) {
-                try
+        try
+        {
+            for (auto i = next++; i < subtrees.size() && !stop; i = next++)
+            {
+                nodeStack.push(subtrees[i]);
+                while (!nodeStack.empty() && !stop)
                 {
-                    while (!nodeStack.empty())
-                    {
-                        std::shared_ptr<SHAMapInnerNode> node =
-                            std::move(nodeStack.top());
-                        assert(node);
-                        nodeStack.pop();
+                    std::shared_ptr<SHAMapInnerNode> node =
+                        std::move(nodeStack.top());
+                    nodeStack.pop();
 
-                        for (int i = 0; i < 16; ++i)
-                        {
-                            if (node->isEmptyBranch(i))
-                                continue;
-                            std::shared_ptr<SHAMapTreeNode> nextNode =
-                                descendNoStore(node, i);
-
-                            if (nextNode)
-                            {
-                                if (nextNode->isInner())
-                                    nodeStack.push(std::static_pointer_cast<
-                                                   SHAMapInnerNode>(nextNode));
-                            }
-                            else
-                            {
-                                std::lock_guard l{m};
-                                missingNodes.emplace_back(
-                                    type_, node->getChildHash(i));
-                                if (--maxMissing <= 0)
-                                    return;
-                            }
-                        }
+                    fetchChildren(*node, children);
+                    for (int b = 0; b < branchFactor; ++b)
+                    {
+                        if (node->isEmptyBranch(b))
+                            continue;
+                        ++visited;
+                        if (!children[b])
+                            missing(node->getChildHash(b));
+                        else if (children[b]->isInner())
+                            nodeStack.push(
+                                std::static_pointer_cast<SHAMapInnerNode>(
+                                    std::move(children[b])));
                     }
                 }
-                catch (SHAMapMissingNode const& e)
+                nodeStack = {};
+
+                ++finished;
+                auto const now = std::chrono::steady_clock::now();
+                std::lock_guard l(m);
+                if (now - lastReport >= std::chrono::seconds(10))
                 {
-                    std::lock_guard l(m);
-                    exceptions.push_back(e);
+                    lastReport = now;
+                    JLOG(journal_.info())
+                        << "walkMapParallel: " << finished << " of "
+                        << subtrees.size() << " subtrees, " << visited
+                        << " nodes";
                 }
-            },
-            std::move(nodeStacks[rootChildIndex])));
-    }
-
-    for (std::thread& worker : workers)
-        worker.join();
+            }
+        }
+        catch (SHAMapMissingNode const& e)
+        {
+            std::lock_guard l(m);
+            exceptions.push_back(e);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    auto const count = std::min<std::size_t>(workers, subtrees.size());
+    threads.reserve(count);
+    JLOG(journal_.debug()) << "walkMapParallel: starting " << count
+                           << " workers for " << subtrees.size()
+                           << " subtrees";
+    for (std::size_t i = 0; i < count; ++i)
+        threads.emplace_back(walkSubtrees);
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    JLOG(journal_.debug())
+        << "walkMapParallel: visited " << visited << " nodes in "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - start)
+               .count()
+        << "ms";
 
     std::lock_guard l(m);
     if (exceptions.empty())
@@ -373,4 +608,137 @@ SHAMap::walkMapParallel(
     return false;
 }
 
+void
+SHAMap::prefetch(std::vector<uint256> keys) const
+{
+    if (!backed_ || !root_->isInner() || keys.empty())
+        return;
+
+    // Sorted, the keys that share a node on some level are neighbours
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    // As in fetchChildren, the results outlive this frame
+    struct Pending
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        int count = 0;
+        std::vector<std::pair<std::size_t, std::shared_ptr<NodeObject>>>
+            objects;
+    };
+
+    // The keys below one branch of an inner node, and that branch's child
+    struct Group
+    {
+        std::size_t first;
+        std::size_t last;
+        int branch;
+        std::shared_ptr<SHAMapTreeNode> child;
+    };
+
+    // The inner node each key has reached. Nodes are kept alive by their
+    // parents, since the map is not modified.
+    using Entry = std::pair<SHAMapInnerNode*, uint256 const*>;
+    std::vector<Entry> level;
+    level.reserve(keys.size());
+    for (auto const& key : keys)
+        level.emplace_back(static_cast<SHAMapInnerNode*>(root_.get()), &key);
+
+    for (int depth = 0; !level.empty(); ++depth)
+    {
+        auto const branchOf = [depth](uint256 const& key) {
+            return selectBranch(SHAMapNodeID::createID(depth, key), key);
+        };
+
+        auto const pending = std::make_shared<Pending>();
+        std::vector<Group> groups;
+
+        for (std::size_t first = 0; first < level.size();)
+        {
+            auto const node = level[first].first;
+            auto const branch = branchOf(*level[first].second);
+            auto last = first + 1;
+            while (last < level.size() && level[last].first == node &&
+                   branchOf(*level[last].second) == branch)
+                ++last;
+
+            if (!node->isEmptyBranch(branch))
+            {
+                auto& group = groups.emplace_back(Group{first, last, branch});
+                if (!(group.child = node->getChild(branch)))
+                {
+                    auto const& hash = node->getChildHash(branch);
+                    if ((group.child = cacheLookup(hash)))
+                    {
+                        group.child =
+                            node->canonicalizeChild(branch, group.child);
+                    }
+                    else
+                    {
+                        {
+                            std::lock_guard lock(pending->mutex);
+                            ++pending->count;
+                        }
+
+                        f_.db().asyncFetch(
+                            hash.as_uint256(),
+                            ledgerSeq_,
+                            [pending, i = groups.size() - 1](
+                                std::shared_ptr<NodeObject> const& object) {
+                                std::lock_guard lock(pending->mutex);
+                                pending->objects.emplace_back(i, object);
+                                if (--pending->count == 0)
+                                    pending->cv.notify_all();
+                            });
+                    }
+                }
+            }
+
+            first = last;
+        }
+
+        decltype(pending->objects) objects;
+        bool stopped = false;
+        {
+            std::unique_lock lock(pending->mutex);
+            while (pending->count != 0 && !stopped)
+            {
+                // A stopping database drops requests without calling back
+                if (pending->cv.wait_for(
+                        lock, std::chrono::milliseconds(100)) ==
+                    std::cv_status::timeout)
+                    stopped = f_.db().isStopping();
+            }
+
+            objects = std::move(pending->objects);
+        }
+
+        if (stopped)
+            return;
+
+        for (auto const& [i, object] : objects)
+        {
+            auto& group = groups[i];
+            auto const node = level[group.first].first;
+            if (auto child =
+                    finishFetch(node->getChildHash(group.branch), object))
+                group.child =
+                    node->canonicalizeChild(group.branch, std::move(child));
+        }
+
+        std::vector<Entry> next;
+        for (auto const& group : groups)
+        {
+            if (!group.child || !group.child->isInner())
+                continue;
+
+            auto const inner = static_cast<SHAMapInnerNode*>(group.child.get());
+            for (auto i = group.first; i != group.last; ++i)
+                next.emplace_back(inner, level[i].second);
+        }
+        level = std::move(next);
+    }
+}
+
 }  // namespace ripple
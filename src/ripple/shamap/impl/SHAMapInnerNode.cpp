@@ -30,19 +30,33 @@
 #include <ripple/shamap/impl/TaggedPointer.ipp>
 
 #include <algorithm>
+#include <cstring>
 #include <iterator>
 #include <utility>
+#include <vector>
 
 namespace ripple {
 
+// The memory held by child arrays with room for capacity children
+static std::ptrdiff_t
+arrayBytes(std::uint8_t capacity)
+{
+    return capacity *
+        (sizeof(SHAMapHash) + sizeof(std::shared_ptr<SHAMapTreeNode>));
+}
+
 SHAMapInnerNode::SHAMapInnerNode(
     std::uint32_t cowid,
     std::uint8_t numAllocatedChildren)
     : SHAMapTreeNode(cowid), hashesAndChildren_(numAllocatedChildren)
 {
+    countBytes(arrayBytes(hashesAndChildren_.capacity()));
 }
 
-SHAMapInnerNode::~SHAMapInnerNode() = default;
+SHAMapInnerNode::~SHAMapInnerNode()
+{
+    countBytes(-arrayBytes(hashesAndChildren_.capacity()));
+}
 
 template <class F>
 void
@@ -61,8 +75,10 @@ SHAMapInnerNode::iterNonEmptyChildIndexes(F&& f) const
 void
 SHAMapInnerNode::resizeChildArrays(std::uint8_t toAllocate)
 {
+    auto const before = arrayBytes(hashesAndChildren_.capacity());
     hashesAndChildren_ =
         TaggedPointer(std::move(hashesAndChildren_), isBranch_, toAllocate);
+    countBytes(arrayBytes(hashesAndChildren_.capacity()) - before);
 }
 
 std::optional<int>
@@ -208,7 +224,7 @@ SHAMapInnerNode::updateHash()
 }
 
 void
-SHAMapInnerNode::updateHashDeep()
+SHAMapInnerNode::updateChildHashes()
 {
     SHAMapHash* hashes;
     std::shared_ptr<SHAMapTreeNode>* children;
@@ -219,9 +235,60 @@ SHAMapInnerNode::updateHashDeep()
         if (children[indexNum] != nullptr)
             hashes[indexNum] = children[indexNum]->getHash();
     });
+}
+
+void
+SHAMapInnerNode::updateHashDeep()
+{
+    updateChildHashes();
     updateHash();
 }
 
+void
+SHAMapInnerNode::updateHashesDeep(std::span<SHAMapInnerNode* const> nodes)
+{
+    // The hashing prefix followed by all sixteen child hashes
+    constexpr std::size_t messageSize =
+        sizeof(std::uint32_t) + branchFactor * uint256::bytes;
+
+    std::vector<std::uint8_t> buffer(nodes.size() * messageSize);
+    std::vector<std::uint8_t const*> messages;
+    std::vector<SHAMapInnerNode*> hashed;
+    messages.reserve(nodes.size());
+    hashed.reserve(nodes.size());
+
+    auto const prefix = boost::endian::native_to_big(
+        static_cast<std::uint32_t>(HashPrefix::innerNode));
+
+    for (auto node : nodes)
+    {
+        node->updateChildHashes();
+
+        if (node->isBranch_ == 0)
+        {
+            node->hash_ = SHAMapHash{};
+            continue;
+        }
+
+        auto p = buffer.data() + messages.size() * messageSize;
+        messages.push_back(p);
+        hashed.push_back(node);
+
+        std::memcpy(p, &prefix, sizeof(prefix));
+        p += sizeof(prefix);
+        node->iterChildren([&](SHAMapHash const& hh) {
+            std::memcpy(p, hh.as_uint256().data(), uint256::bytes);
+            p += uint256::bytes;
+        });
+    }
+
+    std::vector<uint256> digests(messages.size());
+    sha512HalfBatch(messages, messageSize, digests);
+
+    for (std::size_t i = 0; i != hashed.size(); ++i)
+        hashed[i]->hash_ = SHAMapHash{digests[i]};
+}
+
 void
 SHAMapInnerNode::serializeForWire(Serializer& s) const
 {
@@ -288,8 +355,10 @@ SHAMapInnerNode::setChild(int m, std::shared_ptr<SHAMapTreeNode> child)
     auto const dstToAllocate = popcnt16(dstIsBranch);
     // change hashesAndChildren to remove the element, or make room for the
     // added element, if necessary
+    auto const before = arrayBytes(hashesAndChildren_.capacity());
     hashesAndChildren_ = TaggedPointer(
         std::move(hashesAndChildren_), isBranch_, dstIsBranch, dstToAllocate);
+    countBytes(arrayBytes(hashesAndChildren_.capacity()) - before);
 
     isBranch_ = dstIsBranch;
 
@@ -345,6 +414,22 @@ SHAMapInnerNode::getChild(int branch)
     return hashesAndChildren_.getChildren()[index];
 }
 
+void
+SHAMapInnerNode::prefetchChildren() const
+{
+#if defined(__GNUC__) || defined(__clang__)
+    auto const children = hashesAndChildren_.getChildren();
+
+    spinlock sl(lock_);
+    std::lock_guard lock(sl);
+
+    iterNonEmptyChildIndexes([&](auto, auto indexNum) {
+        if (auto const child = children[indexNum].get())
+            __builtin_prefetch(child);
+    });
+#endif
+}
+
 SHAMapHash const&
 SHAMapInnerNode::getChildHash(int m) const
 {
@@ -89,11 +89,13 @@ SHAMapNodeID::getChildNodeID(unsigned int m) const
         Throw<std::logic_error>(
             "Request for child node ID of " + to_string(*this));
 
-    if (id_ != (id_ & depthMask(depth_)))
-        Throw<std::logic_error>("Incorrect mask for " + to_string(*this));
+    // Every way of making an ID masks it to its depth, so checking the
+    // mask again here would only repeat 256-bit work on each descent.
+    assert(id_ == (id_ & depthMask(depth_)));
 
-    SHAMapNodeID node{depth_ + 1, id_};
+    SHAMapNodeID node{*this};
     node.id_.begin()[depth_ / 2] |= (depth_ & 1) ? m : (m << 4);
+    ++node.depth_;
     return node;
 }
 
@@ -117,21 +119,6 @@ deserializeSHAMapNodeID(void const* data, std::size_t size)
     return ret;
 }
 
-[[nodiscard]] unsigned int
-selectBranch(SHAMapNodeID const& id, uint256 const& hash)
-{
-    auto const depth = id.getDepth();
-    auto branch = static_cast<unsigned int>(*(hash.begin() + (depth / 2)));
-
-    if (depth & 1)
-        branch &= 0xf;
-    else
-        branch >>= 4;
-
-    assert(branch < SHAMap::branchFactor);
-    return branch;
-}
-
 SHAMapNodeID
 SHAMapNodeID::createID(int depth, uint256 const& key)
 {
@@ -177,6 +177,9 @@ SHAMap::gmn_ProcessNodes(MissingNodes& mn, MissingNodes::StackEntry& se)
     int& currentChild = std::get<3>(se);
     bool& fullBelow = std::get<4>(se);
 
+    if (currentChild == 0)
+        node->prefetchChildren();
+
     while (currentChild < 16)
     {
         int branch = (firstChild + currentChild++) % 16;
@@ -185,9 +188,10 @@ SHAMap::gmn_ProcessNodes(MissingNodes& mn, MissingNodes::StackEntry& se)
 
         auto const& childHash = node->getChildHash(branch);
 
-        if (mn.missingHashes_.count(childHash) != 0)
+        if (mn.missingHashes_.count(childHash) != 0 ||
+            mn.pendingHashes_.count(childHash) != 0)
         {
-            // we already know this child node is missing
+            // we already know this child node is missing, or are reading it
             fullBelow = false;
         }
         else if (
@@ -214,6 +218,7 @@ SHAMap::gmn_ProcessNodes(MissingNodes& mn, MissingNodes::StackEntry& se)
             {
                 fullBelow = false;
                 ++mn.deferred_;
+                mn.pendingHashes_.insert(childHash);
             }
             else if (!d)
             {
@@ -259,41 +264,33 @@ SHAMap::gmn_ProcessNodes(MissingNodes& mn, MissingNodes::StackEntry& se)
     node = nullptr;
 }
 
-// Wait for deferred reads to finish and
-// process their results
+// Process the deferred reads which have finished, after waiting for at
+// least one of them to finish, or for all of them if all is set.
 void
-SHAMap::gmn_ProcessDeferredReads(MissingNodes& mn)
+SHAMap::gmn_ProcessDeferredReads(MissingNodes& mn, bool all)
 {
-    // Process all deferred reads
-    int complete = 0;
-    while (complete != mn.deferred_)
+    std::vector<MissingNodes::DeferredNode> finished;
     {
-        std::tuple<
-            SHAMapInnerNode*,
-            SHAMapNodeID,
-            int,
-            std::shared_ptr<SHAMapTreeNode>>
-            deferredNode;
-        {
-            std::unique_lock<std::mutex> lock{mn.deferLock_};
+        std::unique_lock<std::mutex> lock{mn.deferLock_};
 
-            while (mn.finishedReads_.size() <= complete)
-                mn.deferCondVar_.wait(lock);
-            deferredNode = std::move(mn.finishedReads_[complete++]);
-        }
+        std::size_t const wanted = all ? mn.deferred_ : 1;
+        mn.deferCondVar_.wait(
+            lock, [&mn, wanted] { return mn.finishedReads_.size() >= wanted; });
+        finished.swap(mn.finishedReads_);
+    }
+    mn.deferred_ -= finished.size();
 
-        auto parent = std::get<0>(deferredNode);
-        auto const& parentID = std::get<1>(deferredNode);
-        auto branch = std::get<2>(deferredNode);
-        auto nodePtr = std::get<3>(deferredNode);
+    for (auto& [parent, parentID, branch, nodePtr] : finished)
+    {
         auto const& nodeHash = parent->getChildHash(branch);
+        mn.pendingHashes_.erase(nodeHash);
 
         if (nodePtr)
         {  // Got the node
             nodePtr = parent->canonicalizeChild(branch, std::move(nodePtr));
 
-            // When we finish this stack, we need to restart
-            // with the parent of this node
+            // Once the nodes we are traversing are done, we need to
+            // restart with the parent of this node
             mn.resumes_[parent] = parentID;
         }
         else if ((mn.max_ > 0) && (mn.missingHashes_.insert(nodeHash).second))
@@ -303,10 +300,6 @@ SHAMap::gmn_ProcessDeferredReads(MissingNodes& mn)
             --mn.max_;
         }
     }
-
-    mn.finishedReads_.clear();
-    mn.finishedReads_.reserve(mn.maxDefer_);
-    mn.deferred_ = 0;
 }
 
 /** Get a list of node IDs and hashes for nodes that are part of this SHAMap
@@ -319,10 +312,15 @@ SHAMap::getMissingNodes(int max, SHAMapSyncFilter* filter)
     assert(root_->getHash().isNonZero());
     assert(max > 0);
 
+    // The number of async reads which may be in flight at first, and at
+    // most when the backend is slow.
+    constexpr int initialDefer = 512;
+    constexpr int maxDeferLimit = 8192;
+
     MissingNodes mn(
         max,
         filter,
-        512,  // number of async reads per pass
+        initialDefer,
         f_.getFullBelowCache(ledgerSeq_)->getGeneration());
 
     if (!root_->isInner() ||
@@ -349,15 +347,31 @@ SHAMap::getMissingNodes(int max, SHAMapSyncFilter* filter)
     auto& nextChild = std::get<3>(pos);
     auto& fullBelow = std::get<4>(pos);
 
-    // Traverse the map without blocking
+    auto const readsFinished = [&mn] {
+        std::lock_guard lock{mn.deferLock_};
+        return !mn.finishedReads_.empty();
+    };
+
+    // Traverse the map without waiting for the reads of the nodes which are
+    // not in memory: their results are taken as they finish, while the rest
+    // of the map is searched, and their parents are resumed once there is
+    // nothing else to search.
     do
     {
-        while ((node != nullptr) && (mn.deferred_ <= mn.maxDefer_))
+        while ((node != nullptr) && (mn.max_ > 0))
         {
-            gmn_ProcessNodes(mn, pos);
+            if (mn.deferred_ >= mn.maxDefer_)
+            {
+                // If none of the reads has finished yet, the backend is
+                // slower than the search: allow more reads in flight.
+                if (mn.maxDefer_ < maxDeferLimit && !readsFinished())
+                    mn.maxDefer_ = std::min(mn.maxDefer_ * 2, maxDeferLimit);
+                else
+                    gmn_ProcessDeferredReads(mn, false);
+                continue;
+            }
 
-            if (mn.max_ <= 0)
-                break;
+            gmn_ProcessNodes(mn, pos);
 
             if ((node == nullptr) && !mn.stack_.empty())
             {
@@ -380,42 +394,42 @@ SHAMap::getMissingNodes(int max, SHAMapSyncFilter* filter)
             }
         }
 
-        // We have either emptied the stack or
-        // posted as many deferred reads as we can
-        if (mn.deferred_)
-            gmn_ProcessDeferredReads(mn);
-
         if (mn.max_ <= 0)
+        {
+            // The reads still in flight refer to mn
+            if (mn.deferred_)
+                gmn_ProcessDeferredReads(mn, true);
             return std::move(mn.missingNodes_);
+        }
 
-        if (node == nullptr)
-        {  // We weren't in the middle of processing a node
+        // We have emptied the stack. Unless there are nodes to resume,
+        // wait for the next reads to finish.
+        if (mn.resumes_.empty() && mn.deferred_)
+            gmn_ProcessDeferredReads(mn, false);
 
-            if (mn.stack_.empty() && !mn.resumes_.empty())
-            {
-                // Recheck nodes we could not finish before
-                for (auto const& [innerNode, nodeId] : mn.resumes_)
-                    if (!innerNode->isFullBelow(mn.generation_))
-                        mn.stack_.push(std::make_tuple(
-                            innerNode, nodeId, rand_int(255), 0, true));
+        if (!mn.resumes_.empty())
+        {
+            // Recheck nodes we could not finish before
+            for (auto const& [innerNode, nodeId] : mn.resumes_)
+                if (!innerNode->isFullBelow(mn.generation_))
+                    mn.stack_.push(std::make_tuple(
+                        innerNode, nodeId, rand_int(255), 0, true));
 
-                mn.resumes_.clear();
-            }
+            mn.resumes_.clear();
+        }
 
-            if (!mn.stack_.empty())
-            {
-                // Resume at the top of the stack
-                pos = mn.stack_.top();
-                mn.stack_.pop();
-                assert(node != nullptr);
-            }
+        if (!mn.stack_.empty())
+        {
+            // Resume at the top of the stack
+            pos = mn.stack_.top();
+            mn.stack_.pop();
+            assert(node != nullptr);
         }
 
-        // node will only still be nullptr if
-        // we finished the current node, the stack is empty
-        // and we have no nodes to resume
+        // node will only still be nullptr if the stack is empty, we have
+        // no nodes to resume and there are no reads left in flight
 
-    } while (node != nullptr);
+    } while ((node != nullptr) || (mn.deferred_ != 0));
 
     if (mn.missingNodes_.empty())
         clearSynching();
@@ -434,33 +448,37 @@ SHAMap::getNodeFat(
     // to a specified depth
 
     auto node = root_.get();
-    SHAMapNodeID nodeID;
+    unsigned int nodeDepth = 0;
 
-    while (node && node->isInner() && (nodeID.getDepth() < wanted.getDepth()))
+    // Walking towards the wanted ID, the node reached at its depth is the
+    // node with that ID, so only the depth needs to be tracked.
+    while (node && node->isInner() && (nodeDepth < wanted.getDepth()))
     {
-        int branch = selectBranch(nodeID, wanted.getNodeID());
+        int branch = selectBranch(nodeDepth++, wanted.getNodeID());
         auto inner = static_cast<SHAMapInnerNode*>(node);
         if (inner->isEmptyBranch(branch))
             return false;
         node = descendThrow(inner, branch);
-        nodeID = nodeID.getChildNodeID(branch);
     }
 
-    if (node == nullptr || wanted != nodeID)
+    if (node == nullptr || nodeDepth != wanted.getDepth())
     {
         JLOG(journal_.info())
             << "peer requested node that is not in the map: " << wanted
-            << " but found " << nodeID;
+            << " but found a leaf at depth " << nodeDepth;
         return false;
     }
 
+    SHAMapNodeID nodeID = wanted;
+
     if (node->isInner() && static_cast<SHAMapInnerNode*>(node)->isEmpty())
     {
         JLOG(journal_.warn()) << "peer requests empty node";
         return false;
     }
 
-    std::stack<std::tuple<SHAMapTreeNode*, SHAMapNodeID, int>> stack;
+    using StackEntry = std::tuple<SHAMapTreeNode*, SHAMapNodeID, int>;
+    std::stack<StackEntry, std::vector<StackEntry>> stack;
     stack.emplace(node, nodeID, depth);
 
     Serializer s(8192);
@@ -581,8 +599,76 @@ SHAMap::addKnownNode(
     }
 
     auto const generation = f_.getFullBelowCache(ledgerSeq_)->getGeneration();
-    SHAMapNodeID iNodeID;
-    auto iNode = root_.get();
+    DescentPath path{{root_.get(), SHAMapNodeID{}}};
+    std::vector<std::shared_ptr<SHAMapTreeNode>> hooked;
+
+    auto const ret =
+        hookKnownNode(node, rawNode, filter, generation, path, hooked);
+    gotKnownNodes(hooked, filter);
+    return ret;
+}
+
+SHAMapAddNode
+SHAMap::addKnownNodes(
+    std::vector<std::pair<SHAMapNodeID, Slice>> nodes,
+    SHAMapSyncFilter* filter)
+{
+    if (!isSynching())
+    {
+        JLOG(journal_.trace()) << "AddKnownNodes while not synching";
+        return SHAMapAddNode::duplicate();
+    }
+
+    // Node IDs order by depth first, so parents come before their children
+    // and siblings next to each other.
+    std::stable_sort(
+        nodes.begin(), nodes.end(), [](auto const& a, auto const& b) {
+            return a.first < b.first;
+        });
+
+    auto const generation = f_.getFullBelowCache(ledgerSeq_)->getGeneration();
+    DescentPath path{{root_.get(), SHAMapNodeID{}}};
+    std::vector<std::shared_ptr<SHAMapTreeNode>> hooked;
+    hooked.reserve(nodes.size());
+
+    SHAMapAddNode ret;
+    for (auto const& [node, rawNode] : nodes)
+    {
+        assert(!node.isRoot());
+
+        auto const added =
+            hookKnownNode(node, rawNode, filter, generation, path, hooked);
+        ret += added;
+
+        if (added.isInvalid() || state_ == SHAMapState::Invalid)
+            break;
+    }
+
+    gotKnownNodes(hooked, filter);
+    return ret;
+}
+
+SHAMapAddNode
+SHAMap::hookKnownNode(
+    SHAMapNodeID const& node,
+    Slice const& rawNode,
+    SHAMapSyncFilter* filter,
+    std::uint32_t generation,
+    DescentPath& path,
+    std::vector<std::shared_ptr<SHAMapTreeNode>>& hooked)
+{
+    // Back up to the deepest node walked through before that is an ancestor
+    // of this one. The root is an ancestor of every node.
+    while (path.size() > 1)
+    {
+        auto const& id = path.back().second;
+        if (id.getDepth() < node.getDepth() &&
+            SHAMapNodeID::createID(id.getDepth(), node.getNodeID()) == id)
+            break;
+        path.pop_back();
+    }
+
+    auto [iNode, iNodeID] = path.back();
 
     while (iNode->isInner() &&
            !static_cast<SHAMapInnerNode*>(iNode)->isFullBelow(generation) &&
@@ -643,26 +729,42 @@ SHAMap::addKnownNode(
 
             newNode = prevNode->canonicalizeChild(branch, std::move(newNode));
 
-            if (filter)
-            {
-                Serializer s;
-                newNode->serializeWithPrefix(s);
-                filter->gotNode(
-                    false,
-                    childHash,
-                    ledgerSeq_,
-                    std::move(s.modData()),
-                    newNode->getType());
-            }
+            if (newNode->isInner())
+                path.emplace_back(newNode.get(), iNodeID);
+            hooked.push_back(std::move(newNode));
 
             return SHAMapAddNode::useful();
         }
+
+        if (iNode->isInner())
+            path.emplace_back(iNode, iNodeID);
     }
 
     JLOG(journal_.trace()) << "got node, already had it (late)";
     return SHAMapAddNode::duplicate();
 }
 
+void
+SHAMap::gotKnownNodes(
+    std::vector<std::shared_ptr<SHAMapTreeNode>> const& hooked,
+    SHAMapSyncFilter* filter) const
+{
+    if (!filter)
+        return;
+
+    for (auto const& node : hooked)
+    {
+        Serializer s;
+        node->serializeWithPrefix(s);
+        filter->gotNode(
+            false,
+            node->getHash(),
+            ledgerSeq_,
+            std::move(s.modData()),
+            node->getType());
+    }
+}
+
 bool
 SHAMap::deepCompare(SHAMap& other) const
 {
@@ -741,17 +843,16 @@ SHAMap::hasInnerNode(
     SHAMapHash const& targetNodeHash) const
 {
     auto node = root_.get();
-    SHAMapNodeID nodeID;
+    unsigned int depth = 0;
 
-    while (node->isInner() && (nodeID.getDepth() < targetNodeID.getDepth()))
+    while (node->isInner() && (depth < targetNodeID.getDepth()))
     {
-        int branch = selectBranch(nodeID, targetNodeID.getNodeID());
+        int branch = selectBranch(depth++, targetNodeID.getNodeID());
         auto inner = static_cast<SHAMapInnerNode*>(node);
         if (inner->isEmptyBranch(branch))
             return false;
 
         node = descendThrow(inner, branch);
-        nodeID = nodeID.getChildNodeID(branch);
     }
 
     return (node->isInner()) && (node->getHash() == targetNodeHash);
@@ -763,14 +864,14 @@ bool
 SHAMap::hasLeafNode(uint256 const& tag, SHAMapHash const& targetNodeHash) const
 {
     auto node = root_.get();
-    SHAMapNodeID nodeID;
+    unsigned int depth = 0;
 
     if (!node->isInner())  // only one leaf node in the tree
         return node->getHash() == targetNodeHash;
 
     do
     {
-        int branch = selectBranch(nodeID, tag);
+        int branch = selectBranch(depth++, tag);
         auto inner = static_cast<SHAMapInnerNode*>(node);
         if (inner->isEmptyBranch(branch))
             return false;  // Dead end, node must not be here
@@ -780,7 +881,6 @@ SHAMap::hasLeafNode(uint256 const& tag, SHAMapHash const& targetNodeHash) const
             return true;
 
         node = descendThrow(inner, branch);
-        nodeID = nodeID.getChildNodeID(branch);
     } while (node->isInner());
 
     return false;  // If this was a matching leaf, we would have caught it
@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <ripple/basics/ByteUtilities.h>
+#include <ripple/basics/HugePages.h>
 #include <ripple/shamap/SHAMapInnerNode.h>
 #include <ripple/shamap/impl/TaggedPointer.h>
 
@@ -52,7 +53,11 @@ static_assert(
 constexpr size_t elementSizeBytes =
     (sizeof(SHAMapHash) + sizeof(std::shared_ptr<SHAMapTreeNode>));
 
-constexpr size_t blockSizeBytes = kilobytes(512);
+// Blocks are huge pages, so that the arrays can be mapped by them
+constexpr size_t blockSizeBytes = hugePages::size;
+
+// What a pool adds to the chunks of each block it allocates
+constexpr size_t blockOverheadBytes = 2 * sizeof(void*);
 
 template <std::size_t... I>
 constexpr std::array<size_t, boundaries.size()> initArrayChunkSizeBytes(
@@ -70,7 +75,7 @@ constexpr std::array<size_t, boundaries.size()> initArrayChunksPerBlock(
     std::index_sequence<I...>)
 {
     return std::array<size_t, boundaries.size()>{
-        blockSizeBytes / arrayChunkSizeBytes[I]...,
+        (blockSizeBytes - blockOverheadBytes) / arrayChunkSizeBytes[I]...,
     };
 }
 constexpr auto chunksPerBlock =
@@ -100,7 +105,7 @@ std::array<std::function<void*()>, boundaries.size()> initAllocateArrayFuns(
         boost::singleton_pool<
             boost::fast_pool_allocator_tag,
             arrayChunkSizeBytes[I],
-            boost::default_user_allocator_new_delete,
+            hugePages::PoolAllocator<blockSizeBytes>,
             std::mutex,
             chunksPerBlock[I],
             chunksPerBlock[I]>::malloc...,
@@ -117,7 +122,7 @@ std::array<std::function<void(void*)>, boundaries.size()> initFreeArrayFuns(
         static_cast<void (*)(void*)>(boost::singleton_pool<
                                      boost::fast_pool_allocator_tag,
                                      arrayChunkSizeBytes[I],
-                                     boost::default_user_allocator_new_delete,
+                                     hugePages::PoolAllocator<blockSizeBytes>,
                                      std::mutex,
                                      chunksPerBlock[I],
                                      chunksPerBlock[I]>::free)...,
@@ -134,7 +139,7 @@ std::array<std::function<bool(void*)>, boundaries.size()> initIsFromArrayFuns(
         boost::singleton_pool<
             boost::fast_pool_allocator_tag,
             arrayChunkSizeBytes[I],
-            boost::default_user_allocator_new_delete,
+            hugePages::PoolAllocator<blockSizeBytes>,
             std::mutex,
             chunksPerBlock[I],
             chunksPerBlock[I]>::is_from...,
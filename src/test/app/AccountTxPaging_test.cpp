@@ -17,6 +17,7 @@
 */
 //==============================================================================
 #include <ripple/beast/unit_test.h>
+#include <ripple/core/ConfigSections.h>
 #include <ripple/protocol/SField.h>
 #include <ripple/protocol/jss.h>
 #include <cstdlib>
@@ -263,11 +264,111 @@ class AccountTxPaging_test : public beast::unit_test::suite
         }
     }
 
+    class GrpcAccountTxClient : public test::GRPCTestClientBase
+    {
+    public:
+        org::xrpl::rpc::v1::GetAccountTransactionHistoryRequest request;
+        org::xrpl::rpc::v1::GetAccountTransactionHistoryResponse reply;
+
+        explicit GrpcAccountTxClient(std::string const& port)
+            : GRPCTestClientBase(port)
+        {
+        }
+
+        void
+        GetAccountTransactionHistory()
+        {
+            status =
+                stub_->GetAccountTransactionHistory(&context, request, &reply);
+        }
+    };
+
+    void
+    testAccountTxPagingGrpc()
+    {
+        testcase("Paging for Single Account over gRPC");
+        using namespace test::jtx;
+        std::unique_ptr<Config> config = envconfig(addGrpcConfig);
+        std::string grpcPort =
+            *(*config)[SECTION_PORT_GRPC].get<std::string>("port");
+        Env env(*this, std::move(config));
+        Account A1{"A1"};
+        Account A2{"A2"};
+
+        env.fund(XRP(10000), A1, A2);
+        env.close();
+
+        for (auto i = 0; i < 5; ++i)
+        {
+            env(pay(A1, A2, XRP(1)));
+            env(pay(A2, A1, XRP(2)));
+            env.close();
+        }
+
+        // The whole history, newest first, as JSON returns it
+        auto const all = next(env, A1, -1, -1, 400, false);
+        auto const& txs = all[jss::transactions];
+        if (!BEAST_EXPECT(txs.isArray() && txs.size() > 2))
+            return;
+
+        auto grpcNext = [&](org::xrpl::rpc::v1::AccountTransactionMarker const*
+                                marker) {
+            GrpcAccountTxClient grpcClient{grpcPort};
+            grpcClient.request.set_account(A1.id().data(), A1.id().size());
+            grpcClient.request.set_limit(2);
+            if (marker)
+                *grpcClient.request.mutable_marker() = *marker;
+            grpcClient.GetAccountTransactionHistory();
+            return std::make_pair(grpcClient.status, grpcClient.reply);
+        };
+
+        std::vector<std::uint32_t> ledgers;
+        std::optional<org::xrpl::rpc::v1::AccountTransactionMarker> marker;
+        do
+        {
+            auto const [status, reply] = grpcNext(marker ? &*marker : nullptr);
+            if (!BEAST_EXPECT(status.ok()))
+                return;
+            BEAST_EXPECT(reply.transactions_size() <= 2);
+            for (auto const& tx : reply.transactions())
+            {
+                SerialIter sit{makeSlice(tx.transaction_blob())};
+                STTx const sttx{sit};
+                BEAST_EXPECT(!tx.metadata_blob().empty());
+                BEAST_EXPECT(
+                    to_string(sttx.getTransactionID()) ==
+                    txs[static_cast<Json::UInt>(ledgers.size())][jss::tx]
+                       [jss::hash]
+                           .asString());
+                ledgers.push_back(tx.ledger_index());
+            }
+            if (reply.has_marker())
+                marker = reply.marker();
+            else
+                marker.reset();
+        } while (marker);
+
+        BEAST_EXPECT(ledgers.size() == txs.size());
+        BEAST_EXPECT(std::is_sorted(
+            ledgers.begin(), ledgers.end(), std::greater<std::uint32_t>{}));
+
+        {
+            // Malformed account
+            GrpcAccountTxClient grpcClient{grpcPort};
+            grpcClient.request.set_account("A1");
+            grpcClient.GetAccountTransactionHistory();
+            BEAST_EXPECT(
+                grpcClient.status.error_code() ==
+                grpc::StatusCode::INVALID_ARGUMENT);
+        }
+    }
+
 public:
     void
     run() override
     {
         testAccountTxPaging();
+        testAccountTxPagingGrpc();
     }
 };
 
@@ -0,0 +1,172 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/impl/AcquireScheduler.h>
+#include <ripple/beast/clock/manual_clock.h>
+#include <ripple/beast/unit_test.h>
+#include <test/unit_test/SuiteJournal.h>
+
+namespace ripple {
+namespace test {
+
+class AcquireScheduler_test : public beast::unit_test::suite
+{
+    using Priority = AcquireScheduler::Priority;
+    using Nodes = std::vector<std::pair<SHAMapNodeID, uint256>>;
+
+    static Nodes
+    makeNodes(std::initializer_list<int> ids)
+    {
+        Nodes nodes;
+        for (auto id : ids)
+            nodes.emplace_back(SHAMapNodeID{}, uint256(id));
+        return nodes;
+    }
+
+    static Nodes
+    filter(
+        AcquireScheduler& scheduler,
+        std::initializer_list<int> ids,
+        Priority priority,
+        bool retry = false,
+        std::size_t limit = 16)
+    {
+        auto nodes = makeNodes(ids);
+        scheduler.filterNodes(nodes, priority, retry, limit);
+        return nodes;
+    }
+
+    void
+    testDeduplicate()
+    {
+        testcase("Deduplicate node requests");
+        using namespace std::chrono_literals;
+        SuiteJournal journal("AcquireScheduler_test", *this);
+        beast::manual_clock<std::chrono::steady_clock> clock;
+        AcquireScheduler scheduler(clock, 3s, journal);
+
+        // Nodes requested by one acquisition are not requested by another
+        BEAST_EXPECT(
+            filter(scheduler, {1, 2, 3}, Priority::normal) ==
+            makeNodes({1, 2, 3}));
+        BEAST_EXPECT(
+            filter(scheduler, {2, 3, 4}, Priority::normal) == makeNodes({4}));
+        BEAST_EXPECT(filter(scheduler, {1, 4}, Priority::normal).empty());
+
+        // Unless there is nothing else to ask for on a retry
+        BEAST_EXPECT(
+            filter(scheduler, {1, 4}, Priority::normal, true) ==
+            makeNodes({1, 4}));
+        BEAST_EXPECT(
+            filter(scheduler, {1, 5}, Priority::normal, true) ==
+            makeNodes({5}));
+
+        // Requests are only outstanding until they time out
+        clock.advance(2s);
+        BEAST_EXPECT(filter(scheduler, {6}, Priority::normal).size() == 1);
+        clock.advance(1s);
+        BEAST_EXPECT(
+            filter(scheduler, {1, 2, 3, 6}, Priority::normal) ==
+            makeNodes({1, 2, 3}));
+
+        // A lower priority request does not hold back a higher one
+        BEAST_EXPECT(filter(scheduler, {7}, Priority::history).size() == 1);
+        BEAST_EXPECT(filter(scheduler, {7}, Priority::consensus).size() == 1);
+        BEAST_EXPECT(filter(scheduler, {7}, Priority::normal).empty());
+        BEAST_EXPECT(filter(scheduler, {8}, Priority::consensus).size() == 1);
+        BEAST_EXPECT(filter(scheduler, {8}, Priority::history).empty());
+
+        // Only the nodes within the limit are recorded as requested
+        BEAST_EXPECT(
+            filter(scheduler, {10, 11, 12}, Priority::normal, false, 2) ==
+            makeNodes({10, 11}));
+        BEAST_EXPECT(
+            filter(scheduler, {10, 11, 12}, Priority::normal) ==
+            makeNodes({12}));
+
+        // Sweeping forgets requests which timed out
+        clock.advance(3s);
+        scheduler.sweep();
+        BEAST_EXPECT(filter(scheduler, {7, 8}, Priority::history).size() == 2);
+    }
+
+    void
+    testBudget()
+    {
+        testcase("Per peer budget");
+        using namespace std::chrono_literals;
+        SuiteJournal journal("AcquireScheduler_test", *this);
+        beast::manual_clock<std::chrono::steady_clock> clock;
+        AcquireScheduler scheduler(clock, 3s, journal);
+        Peer::id_t const peer = 1;
+
+        // A peer of unknown latency gets the default budget, of which
+        // history requests may only use half
+        auto const budget = scheduler.budget(peer);
+        BEAST_EXPECT(budget > 1);
+        for (std::size_t i = 0; i < budget / 2; ++i)
+            BEAST_EXPECT(scheduler.reserve(peer, Priority::history));
+        BEAST_EXPECT(!scheduler.reserve(peer, Priority::history));
+        for (std::size_t i = budget / 2; i < budget; ++i)
+            BEAST_EXPECT(scheduler.reserve(peer, Priority::normal));
+        BEAST_EXPECT(!scheduler.reserve(peer, Priority::normal));
+
+        // Consensus requests are never held back
+        BEAST_EXPECT(scheduler.reserve(peer, Priority::consensus));
+        BEAST_EXPECT(scheduler.inFlight(peer) == budget + 1);
+
+        // A reply frees room and measures the peer's latency
+        clock.advance(100ms);
+        scheduler.onReply(peer);
+        BEAST_EXPECT(scheduler.inFlight(peer) == budget);
+        BEAST_EXPECT(scheduler.latency(peer) == 100ms);
+        BEAST_EXPECT(scheduler.budget(peer) > budget);
+        BEAST_EXPECT(scheduler.reserve(peer, Priority::normal));
+
+        // Unanswered requests time out and count against the peer
+        clock.advance(3s);
+        BEAST_EXPECT(scheduler.inFlight(peer) == 0);
+        BEAST_EXPECT(scheduler.latency(peer) > 1s);
+        BEAST_EXPECT(scheduler.budget(peer) == 1);
+        BEAST_EXPECT(scheduler.reserve(peer, Priority::history));
+        BEAST_EXPECT(!scheduler.reserve(peer, Priority::normal));
+
+        // Other peers are unaffected
+        BEAST_EXPECT(scheduler.budget(peer + 1) == budget);
+
+        // Peers which go quiet are forgotten
+        clock.advance(2min);
+        scheduler.sweep();
+        BEAST_EXPECT(!scheduler.latency(peer));
+        BEAST_EXPECT(scheduler.budget(peer) == budget);
+    }
+
+public:
+    void
+    run() override
+    {
+        testDeduplicate();
+        testBudget();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(AcquireScheduler, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
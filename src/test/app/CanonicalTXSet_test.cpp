@@ -0,0 +1,200 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/misc/CanonicalTXSet.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/digest.h>
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <tuple>
+
+namespace ripple {
+namespace test {
+
+class CanonicalTXSet_test : public beast::unit_test::suite
+{
+    static std::shared_ptr<STTx const>
+    makeTx(AccountID const& account, SeqProxy seqProxy, std::uint32_t flags)
+    {
+        return std::make_shared<STTx const>(ttACCOUNT_SET, [&](STObject& obj) {
+            obj.setAccountID(sfAccount, account);
+            obj.setFieldU32(sfFlags, flags);
+            if (seqProxy.isSeq())
+            {
+                obj.setFieldU32(sfSequence, seqProxy.value());
+            }
+            else
+            {
+                obj.setFieldU32(sfSequence, 0);
+                obj.setFieldU32(sfTicketSequence, seqProxy.value());
+            }
+        });
+    }
+
+    // The transactions for a mix of accounts: some share the leading bytes
+    // of their salted keys and some don't.
+    static std::vector<std::shared_ptr<STTx const>>
+    makeTxs()
+    {
+        std::vector<std::shared_ptr<STTx const>> txs;
+        for (std::uint64_t i = 0; i < 12; ++i)
+        {
+            AccountID const account = (i % 2)
+                ? AccountID(i)
+                : AccountID::fromVoid(sha512Half(i).data());
+
+            for (std::uint32_t seq = 1; seq < 4; ++seq)
+            {
+                txs.push_back(makeTx(account, SeqProxy::sequence(seq), 0));
+                txs.push_back(makeTx(account, SeqProxy::sequence(seq), 1));
+                txs.push_back(makeTx(
+                    account, SeqProxy{SeqProxy::ticket, seq * 7}, 0));
+            }
+        }
+
+        // Insert in an order unrelated to the canonical one.
+        std::sort(txs.begin(), txs.end(), [](auto const& a, auto const& b) {
+            return a->getTransactionID() > b->getTransactionID();
+        });
+        return txs;
+    }
+
+    // The canonical order spelled out directly.
+    static std::vector<uint256>
+    expectedOrder(
+        uint256 const& salt,
+        std::vector<std::shared_ptr<STTx const>> const& txs)
+    {
+        using Key = std::tuple<uint256, SeqProxy, uint256>;
+        std::vector<Key> keys;
+        for (auto const& tx : txs)
+        {
+            uint256 account = beast::zero;
+            auto const id = tx->getAccountID(sfAccount);
+            memcpy(account.begin(), id.begin(), id.size());
+            account ^= salt;
+            keys.emplace_back(
+                account, tx->getSeqProxy(), tx->getTransactionID());
+        }
+        std::sort(keys.begin(), keys.end());
+
+        std::vector<uint256> ret;
+        for (auto const& key : keys)
+            ret.push_back(std::get<2>(key));
+        return ret;
+    }
+
+    static std::vector<uint256>
+    order(CanonicalTXSet const& set)
+    {
+        std::vector<uint256> ret;
+        for (auto const& [key, tx] : set)
+            ret.push_back(tx->getTransactionID());
+        return ret;
+    }
+
+    void
+    testOrder()
+    {
+        testcase("Order");
+
+        auto const txs = makeTxs();
+
+        for (auto const& salt :
+             {uint256{}, sha512Half(std::uint64_t(1)), ~uint256{}})
+        {
+            auto const expected = expectedOrder(salt, txs);
+
+            CanonicalTXSet one(salt);
+            for (auto const& tx : txs)
+                one.insert(tx);
+            BEAST_EXPECT(order(one) == expected);
+
+            CanonicalTXSet batch(salt);
+            batch.insert(txs);
+            BEAST_EXPECT(order(batch) == expected);
+
+            // A batch into a set that already has transactions, including
+            // some of those in the batch.
+            CanonicalTXSet mixed(salt);
+            for (std::size_t i = 0; i < txs.size(); i += 3)
+                mixed.insert(txs[i]);
+            mixed.insert(txs);
+            BEAST_EXPECT(order(mixed) == expected);
+        }
+    }
+
+    void
+    testPopAcctTransaction()
+    {
+        testcase("Pop account transaction");
+
+        auto const txs = makeTxs();
+        std::map<uint256, std::shared_ptr<STTx const>> byId;
+        for (auto const& tx : txs)
+            byId.emplace(tx->getTransactionID(), tx);
+
+        CanonicalTXSet set(sha512Half(std::uint64_t(2)));
+        set.insert(txs);
+
+        for (std::uint64_t i = 0; i < 4; ++i)
+        {
+            AccountID const account = (i % 2)
+                ? AccountID(i)
+                : AccountID::fromVoid(sha512Half(i).data());
+
+            // The first transaction of the account that doesn't precede
+            // the probe in the canonical order.
+            auto const probe = makeTx(account, SeqProxy::sequence(2), 2);
+            std::optional<uint256> expected;
+            for (auto const& id : order(set))
+            {
+                auto const& tx = byId[id];
+                if (tx->getAccountID(sfAccount) == account &&
+                    tx->getSeqProxy() >= probe->getSeqProxy())
+                {
+                    expected = id;
+                    break;
+                }
+            }
+
+            auto const size = set.size();
+            auto const popped = set.popAcctTransaction(probe);
+            if (!BEAST_EXPECT(popped && expected))
+                return;
+            BEAST_EXPECT(popped->getTransactionID() == *expected);
+            BEAST_EXPECT(set.size() == size - 1);
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testOrder();
+        testPopAcctTransaction();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(CanonicalTXSet, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
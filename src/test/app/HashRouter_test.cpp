@@ -20,6 +20,9 @@
 #include <ripple/app/misc/HashRouter.h>
 #include <ripple/basics/chrono.h>
 #include <ripple/beast/unit_test.h>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 namespace ripple {
 namespace test {
@@ -242,6 +245,77 @@ class HashRouter_test : public beast::unit_test::suite
         BEAST_EXPECT(router.shouldProcess(key, peer, flags, 1s));
     }
 
+    void
+    testSweep()
+    {
+        using namespace std::chrono_literals;
+        TestStopwatch stopwatch;
+        HashRouter router(stopwatch, 2s);
+
+        // Many keys, so that every shard holds some.
+        std::vector<uint256> keys;
+        for (int i = 1; i <= 200; ++i)
+            keys.emplace_back(i);
+
+        for (auto const& key : keys)
+            router.setFlags(key, SF_BAD);
+        ++stopwatch;
+        for (std::size_t i = 0; i < keys.size(); i += 2)
+            BEAST_EXPECT(router.getFlags(keys[i]) == SF_BAD);
+        ++stopwatch;
+
+        // Without an insertion, nothing expires, swept or not.
+        router.sweep();
+        for (auto const& key : keys)
+            BEAST_EXPECT(router.getFlags(key) == SF_BAD);
+
+        stopwatch.advance(2s);
+        router.setFlags(uint256(1000), SF_SAVED);
+        router.sweep();
+        for (auto const& key : keys)
+            BEAST_EXPECT(router.getFlags(key) == 0);
+        BEAST_EXPECT(router.getFlags(uint256(1000)) == SF_SAVED);
+    }
+
+    void
+    testConcurrency()
+    {
+        using namespace std::chrono_literals;
+        TestStopwatch stopwatch;
+        HashRouter router(stopwatch, 2s);
+
+        // Each thread sets its own flag on every key and must be the
+        // only one told that it changed the flags.
+        int const threadCount = 8;
+        std::vector<uint256> keys;
+        for (int i = 1; i <= 500; ++i)
+            keys.emplace_back(i);
+
+        std::atomic<int> changes = 0;
+        std::atomic<int> created = 0;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&, t] {
+                for (auto const& key : keys)
+                {
+                    if (router.addSuppressionPeer(key, t + 1))
+                        ++created;
+                    if (router.setFlags(key, SF_PRIVATE1 << t))
+                        ++changes;
+                }
+            });
+        }
+        for (auto& t : threads)
+            t.join();
+
+        BEAST_EXPECT(created == static_cast<int>(keys.size()));
+        BEAST_EXPECT(changes == threadCount * static_cast<int>(keys.size()));
+        int const all = (SF_PRIVATE1 << threadCount) - SF_PRIVATE1;
+        for (auto const& key : keys)
+            BEAST_EXPECT(router.getFlags(key) == all);
+    }
+
 public:
     void
     run() override
@@ -252,6 +326,8 @@ public:
         testSetFlags();
         testRelay();
         testProcess();
+        testSweep();
+        testConcurrency();
     }
 };
 
@@ -0,0 +1,96 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerHashIndex.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/utility/temp_dir.h>
+#include <test/unit_test/SuiteJournal.h>
+
+namespace ripple {
+namespace test {
+
+class LedgerHashIndex_test : public beast::unit_test::suite
+{
+    static LedgerHash
+    hashFor(LedgerIndex seq)
+    {
+        return LedgerHash{seq} ^ LedgerHash{~0ull};
+    }
+
+public:
+    void
+    run() override
+    {
+        beast::temp_dir dir;
+        auto const file = dir.file("ledger_hashes.idx");
+        SuiteJournal journal("LedgerHashIndex_test", *this);
+
+        {
+            testcase("Lookup");
+            LedgerHashIndex index(file, 0, 100, journal);
+            BEAST_EXPECT(!index.get(100));
+            BEAST_EXPECT(!index.get(100000));
+
+            for (LedgerIndex seq = 100; seq < 110; ++seq)
+                index.set(seq, hashFor(seq));
+            index.set(5000, hashFor(5000));
+            index.set(50, hashFor(50));
+
+            for (LedgerIndex seq = 100; seq < 110; ++seq)
+                BEAST_EXPECT(index.get(seq) == hashFor(seq));
+            BEAST_EXPECT(index.get(5000) == hashFor(5000));
+            BEAST_EXPECT(!index.get(50));
+            BEAST_EXPECT(!index.get(110));
+            BEAST_EXPECT(!index.get(4999));
+            BEAST_EXPECT(!index.get(5001));
+
+            index.erase(105);
+            BEAST_EXPECT(!index.get(105));
+            index.set(105, hashFor(1));
+            BEAST_EXPECT(index.get(105) == hashFor(1));
+        }
+
+        {
+            testcase("Reopen");
+            LedgerHashIndex index(file, 0, 100, journal);
+            BEAST_EXPECT(index.get(100) == hashFor(100));
+            BEAST_EXPECT(index.get(105) == hashFor(1));
+            BEAST_EXPECT(index.get(5000) == hashFor(5000));
+        }
+
+        {
+            testcase("Different network");
+            LedgerHashIndex index(file, 1, 100, journal);
+            BEAST_EXPECT(!index.get(100));
+            BEAST_EXPECT(!index.get(5000));
+        }
+
+        {
+            testcase("Different earliest sequence");
+            LedgerHashIndex(file, 1, 100, journal).set(200, hashFor(200));
+            LedgerHashIndex index(file, 1, 150, journal);
+            BEAST_EXPECT(!index.get(200));
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(LedgerHashIndex, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
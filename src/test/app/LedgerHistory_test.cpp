@@ -192,10 +192,45 @@ public:
         }
     }
 
+    void
+    testRecentLedgers()
+    {
+        testcase("LedgerHistory recent ledgers");
+        using namespace jtx;
+        using namespace std::chrono;
+
+        Env env{*this};
+        LedgerHistory lh{beast::insight::NullCollector::New(), env.app()};
+        auto const genesis = makeLedger({}, env, lh, 0s);
+        auto const ledgerA = makeLedger(genesis, env, lh, 4s);
+        auto const ledgerB = makeLedger(genesis, env, lh, 40s);
+        auto const seq = ledgerA->info().seq;
+
+        // Only validated ledgers are published to the ring
+        BEAST_EXPECT(!lh.getRecentLedgerBySeq(seq));
+        lh.insert(ledgerA, true);
+        BEAST_EXPECT(lh.getRecentLedgerBySeq(seq) == ledgerA);
+        BEAST_EXPECT(lh.getLedgerBySeq(seq) == ledgerA);
+        BEAST_EXPECT(lh.getLedgerHash(seq) == ledgerA->info().hash);
+        BEAST_EXPECT(!lh.getRecentLedgerBySeq(seq + 1));
+
+        // Repairing the index drops the stale entry
+        BEAST_EXPECT(!lh.fixIndex(seq, ledgerB->info().hash));
+        BEAST_EXPECT(!lh.getRecentLedgerBySeq(seq));
+        BEAST_EXPECT(lh.getLedgerHash(seq) == ledgerB->info().hash);
+
+        lh.insert(ledgerB, true);
+        BEAST_EXPECT(lh.getRecentLedgerBySeq(seq) == ledgerB);
+
+        lh.clearLedgerCachePrior(seq + 1);
+        BEAST_EXPECT(!lh.getRecentLedgerBySeq(seq));
+    }
+
     void
     run() override
     {
         testHandleMismatch();
+        testRecentLedgers();
     }
 };
 
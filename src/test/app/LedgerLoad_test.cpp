@@ -235,6 +235,48 @@ class LedgerLoad_test : public beast::unit_test::suite
             jrb[jss::ledger][jss::accountState].size());
     }
 
+    void
+    testLoadBinary(beast::temp_dir const& td)
+    {
+        testcase("Load a binary ledger");
+        using namespace test::jtx;
+
+        std::string const ledgerFile = td.file("ledgerdata.bin.json");
+        Json::Value saved;
+        {
+            Env env{*this};
+            for (auto i = 0; i < 20; ++i)
+                env.fund(XRP(10000), Account{"B" + std::to_string(i)});
+            env.close();
+
+            Json::Value params;
+            params[jss::ledger_index] = "closed";
+            params[jss::full] = true;
+            params[jss::binary] = true;
+            saved = env.rpc("json", "ledger", to_string(params))[jss::result];
+            BEAST_EXPECT(saved[jss::ledger].isMember(jss::ledger_data));
+
+            std::ofstream o(ledgerFile, std::ios::out | std::ios::trunc);
+            o << to_string(saved);
+        }
+
+        Env env(
+            *this,
+            envconfig(
+                ledgerConfig, td.path(), ledgerFile, Config::LOAD_FILE),
+            nullptr,
+            beast::severities::kDisabled);
+        auto jrb = env.rpc("ledger", "closed", "full")[jss::result];
+        BEAST_EXPECT(
+            saved[jss::ledger][jss::accountState].size() ==
+            jrb[jss::ledger][jss::accountState].size());
+
+        auto const info = deserializeHeader(makeSlice(
+            *strUnHex(saved[jss::ledger][jss::ledger_data].asString())));
+        BEAST_EXPECT(
+            jrb[jss::ledger][jss::account_hash] == to_string(info.accountHash));
+    }
+
 public:
     void
     run() override
@@ -248,6 +290,7 @@ public:
         testLoadByHash(sd);
         testLoadLatest(sd);
         testLoadIndex(sd);
+        testLoadBinary(td);
     }
 };
 
@@ -396,6 +396,16 @@ struct TestPeerSet : public PeerSet
                 local.processReplayDeltaResponse(reply);
                 if (behavior == PeerSetBehavior::Repeat)
                     local.processReplayDeltaResponse(reply);
+                if (!reply->has_error())
+                {
+                    remote.processReplayDeltaAncestors(
+                        request,
+                        [this](protocol::TMReplayDeltaResponse const& r) {
+                            local.processReplayDeltaResponse(
+                                std::make_shared<
+                                    protocol::TMReplayDeltaResponse>(r));
+                        });
+                }
                 break;
             }
             default:
@@ -998,6 +1008,33 @@ struct LedgerReplayer_test : public beast::unit_test::suite
                     !server.msgHandler.processReplayDeltaResponse(reply));
             }
         }
+
+        {
+            // request for a ledger and two of its ancestors
+            LedgerServer history(*this, {4});
+            auto const last = history.ledgerMaster.getClosedLedger();
+            auto request = std::make_shared<protocol::TMReplayDeltaRequest>();
+            request->set_ledgerhash(
+                last->info().hash.data(), last->info().hash.size());
+            request->set_count(3);
+
+            std::vector<uint256> hashes;
+            history.msgHandler.processReplayDeltaAncestors(
+                request, [&](protocol::TMReplayDeltaResponse const& r) {
+                    hashes.emplace_back(r.ledgerhash());
+                    BEAST_EXPECT(history.msgHandler.processReplayDeltaResponse(
+                        std::make_shared<protocol::TMReplayDeltaResponse>(r)));
+                });
+            BEAST_EXPECT(hashes.size() == 2);
+            if (hashes.size() == 2)
+            {
+                auto const parent =
+                    history.ledgerMaster.getLedgerByHash(hashes[0]);
+                BEAST_EXPECT(hashes[0] == last->info().parentHash);
+                BEAST_EXPECT(
+                    parent && hashes[1] == parent->info().parentHash);
+            }
+        }
     }
 
     void
@@ -0,0 +1,143 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <test/jtx.h>
+#include <test/jtx/envconfig.h>
+
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+class ParallelApply_test : public beast::unit_test::suite
+{
+    // Submit the same transactions to every environment
+    template <class F>
+    static void
+    forEach(std::vector<std::unique_ptr<jtx::Env>>& envs, F&& f)
+    {
+        for (auto& env : envs)
+            f(*env);
+    }
+
+    void
+    expectSameLedgers(std::vector<std::unique_ptr<jtx::Env>>& envs)
+    {
+        forEach(envs, [](jtx::Env& env) { env.close(); });
+
+        auto const& serial = envs.front()->closed()->info();
+        for (auto const& env : envs)
+        {
+            auto const& info = env->closed()->info();
+            BEAST_EXPECT(info.seq == serial.seq);
+            BEAST_EXPECT(info.hash == serial.hash);
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testcase("Parallel ledger building matches serial");
+
+        using namespace jtx;
+
+        std::vector<std::unique_ptr<Env>> envs;
+        for (std::size_t threads : {0, 2, 8})
+        {
+            envs.push_back(std::make_unique<Env>(
+                *this, envconfig([threads](std::unique_ptr<Config> cfg) {
+                    cfg->PARALLEL_APPLY_THREADS = threads;
+                    return cfg;
+                })));
+        }
+
+        auto const gw = Account("gateway");
+        auto const USD = gw["USD"];
+
+        std::vector<Account> accounts;
+        for (int i = 0; i < 24; ++i)
+            accounts.emplace_back("a" + std::to_string(i));
+
+        forEach(envs, [&](Env& env) {
+            env.fund(XRP(100000), gw);
+            for (auto const& a : accounts)
+                env.fund(XRP(100000), a);
+        });
+        expectSameLedgers(envs);
+
+        forEach(envs, [&](Env& env) {
+            for (auto const& a : accounts)
+                env(trust(a, USD(100000)));
+        });
+        expectSameLedgers(envs);
+
+        forEach(envs, [&](Env& env) {
+            for (auto const& a : accounts)
+                env(pay(gw, a, USD(1000)));
+        });
+        expectSameLedgers(envs);
+
+        for (int round = 0; round < 4; ++round)
+        {
+            forEach(envs, [&](Env& env) {
+                auto const n = accounts.size();
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    // Disjoint payments
+                    if (i % 2 == 0)
+                        env(pay(accounts[i], accounts[i + 1], XRP(10 + round)));
+
+                    // A chain in which each payment reads the account the
+                    // previous one wrote
+                    env(pay(accounts[i], accounts[(i + 1) % n], USD(1)));
+
+                    // Several transactions from the same account
+                    env(noop(accounts[i]));
+
+                    // Offers on a shared book, some of which cross
+                    if (i % 3 == 0)
+                        env(offer(accounts[i], XRP(100), USD(10 + round)));
+                    else if (i % 3 == 1)
+                        env(offer(accounts[i], USD(10), XRP(100 - round)));
+                }
+            });
+            expectSameLedgers(envs);
+        }
+
+        // Transactions from accounts funded in the same ledger, which have
+        // to be retried when they come before the payment that funds them
+        forEach(envs, [&](Env& env) {
+            for (std::size_t i = 0; i < accounts.size(); ++i)
+            {
+                Account const fresh("fresh" + std::to_string(i));
+                env.fund(XRP(1000), fresh);
+                env(noop(fresh));
+                env(pay(fresh, accounts[i], XRP(10)));
+            }
+        });
+        expectSameLedgers(envs);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ParallelApply, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -18,11 +18,13 @@
 //==============================================================================
 
 #include <ripple/app/paths/AccountCurrencies.h>
+#include <ripple/app/paths/RippleLineCache.h>
 #include <ripple/basics/contract.h>
 #include <ripple/beast/unit_test.h>
 #include <ripple/core/JobQueue.h>
 #include <ripple/json/json_reader.h>
 #include <ripple/json/to_string.h>
+#include <ripple/ledger/RecordingView.h>
 #include <ripple/protocol/STParsedJSON.h>
 #include <ripple/protocol/TxFlags.h>
 #include <ripple/protocol/jss.h>
@@ -1345,6 +1347,155 @@ public:
         test("no ripple -> no ripple", false, false, false);
     }
 
+    void
+    line_cache_advance()
+    {
+        testcase("line cache advance");
+        using namespace jtx;
+        Env env = pathTestEnv();
+        auto const gw = Account("gateway");
+        auto const alice = Account("alice");
+        auto const bob = Account("bob");
+        auto const carol = Account("carol");
+        auto const USD = gw["USD"];
+        env.fund(XRP(10000), alice, bob, carol, gw);
+        env.close();
+        env.trust(USD(600), alice);
+        env.trust(USD(700), bob);
+        env.close();
+
+        auto const journal = env.app().journal("RippleLineCache");
+        auto first =
+            std::make_shared<RippleLineCache>(env.closed(), journal);
+        auto const aliceLines =
+            first->getRippleLines(alice.id(), LineDirection::outgoing);
+        auto const bobLines =
+            first->getRippleLines(bob.id(), LineDirection::outgoing);
+        auto const carolLines =
+            first->getRippleLines(carol.id(), LineDirection::outgoing);
+        BEAST_EXPECT(aliceLines && aliceLines->size() == 1);
+        BEAST_EXPECT(bobLines && bobLines->size() == 1);
+        BEAST_EXPECT(!carolLines);
+
+        // Only bob and the gateway are a party to a changed trust line
+        env(pay(gw, bob, USD(50)));
+        env.close();
+        BEAST_EXPECT(first->canAdvanceTo(*env.closed()));
+        BEAST_EXPECT(!first->canAdvanceTo(*env.current()));
+
+        auto second =
+            std::make_shared<RippleLineCache>(env.closed(), *first, journal);
+        BEAST_EXPECT(
+            second->getRippleLines(alice.id(), LineDirection::outgoing) ==
+            aliceLines);
+        auto const newBobLines =
+            second->getRippleLines(bob.id(), LineDirection::outgoing);
+        BEAST_EXPECT(newBobLines && newBobLines != bobLines);
+        BEAST_EXPECT(
+            newBobLines &&
+            newBobLines->front().getBalance() == USD(50).value());
+
+        // A trust line created for an account with none cached
+        env.trust(USD(100), carol);
+        env.close();
+        auto third =
+            std::make_shared<RippleLineCache>(env.closed(), *second, journal);
+        auto const newCarolLines =
+            third->getRippleLines(carol.id(), LineDirection::outgoing);
+        BEAST_EXPECT(newCarolLines && newCarolLines->size() == 1);
+        BEAST_EXPECT(
+            third->getRippleLines(alice.id(), LineDirection::outgoing) ==
+            aliceLines);
+
+        // A cache can't skip a ledger
+        env.close();
+        env.close();
+        BEAST_EXPECT(!third->canAdvanceTo(*env.closed()));
+    }
+
+    void
+    liquidity_cache_advance()
+    {
+        testcase("liquidity cache advance");
+        using namespace jtx;
+        Env env = pathTestEnv();
+        auto const gw = Account("gateway");
+        auto const alice = Account("alice");
+        auto const bob = Account("bob");
+        auto const carol = Account("carol");
+        auto const USD = gw["USD"];
+        env.fund(XRP(10000), alice, bob, carol, gw);
+        env.close();
+        env.trust(USD(600), alice);
+        env.trust(USD(700), bob);
+        env(offer(carol, XRP(100), USD(100)),
+            json(sfExpiration.fieldName, std::uint32_t(1) << 30));
+        env.close();
+
+        auto const journal = env.app().journal("RippleLineCache");
+        auto first =
+            std::make_shared<RippleLineCache>(env.closed(), journal);
+
+        // Remember a liquidity for each of the ways it can be invalidated
+        auto const remember = [&](std::uint8_t id, auto&& reads) {
+            RecordingView recorder(*env.closed());
+            reads(recorder);
+            first->setLiquidity(
+                uint256{id},
+                {tesSUCCESS, USD(int(id)), USD(int(id)), id},
+                recorder.reads());
+        };
+        remember(1, [&](ReadView const& view) {
+            view.read(keylet::line(alice, gw, USD.currency));
+        });
+        remember(2, [&](ReadView const& view) {
+            view.read(keylet::line(bob, gw, USD.currency));
+        });
+        remember(3, [&](ReadView const& view) {
+            view.readLazy(keylet::offer(carol, env.seq(carol) - 1));
+        });
+        remember(4, [&](ReadView const& view) {
+            auto key = keylet::line(bob, gw, USD.currency).key;
+            view.succ(--key);
+        });
+        remember(5, [&](ReadView const& view) {
+            for (auto const& sle : view.sles)
+                (void)sle;
+        });
+        remember(6, [&](ReadView const& view) {
+            view.exists(keylet::account(alice));
+        });
+        for (std::uint8_t id = 1; id <= 6; ++id)
+        {
+            auto const liquidity = first->getLiquidity(uint256{id});
+            BEAST_EXPECT(
+                liquidity && liquidity->result == tesSUCCESS &&
+                liquidity->amountOut == USD(int(id)).value() &&
+                liquidity->quality == id);
+        }
+        BEAST_EXPECT(!first->getLiquidity(uint256{7}));
+
+        // Only bob's trust line and the accounts of bob and the gateway change
+        env(pay(gw, bob, USD(50)));
+        env.close();
+        auto second =
+            std::make_shared<RippleLineCache>(env.closed(), *first, journal);
+        BEAST_EXPECT(second->getLiquidity(uint256{1}));
+        BEAST_EXPECT(!second->getLiquidity(uint256{2}));
+        BEAST_EXPECT(!second->getLiquidity(uint256{3}));
+        BEAST_EXPECT(!second->getLiquidity(uint256{4}));
+        BEAST_EXPECT(!second->getLiquidity(uint256{5}));
+        BEAST_EXPECT(second->getLiquidity(uint256{6}));
+
+        // Alice's account changes
+        env(noop(alice));
+        env.close();
+        auto third =
+            std::make_shared<RippleLineCache>(env.closed(), *second, journal);
+        BEAST_EXPECT(third->getLiquidity(uint256{1}));
+        BEAST_EXPECT(!third->getLiquidity(uint256{6}));
+    }
+
     void
     run() override
     {
@@ -1369,6 +1520,8 @@ public:
         xrp_to_xrp();
         receive_max();
         noripple_combinations();
+        line_cache_advance();
+        liquidity_cache_advance();
 
         // The following path_find_NN tests are data driven tests
         // that were originally implemented in js/coffee and migrated
@@ -0,0 +1,157 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/tx/PreflightCache.h>
+#include <ripple/basics/chrono.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/STTx.h>
+
+namespace ripple {
+namespace test {
+
+class PreflightCache_test : public beast::unit_test::suite
+{
+    std::unordered_set<uint256, beast::uhash<>> const presets_;
+
+    static std::pair<NotTEC, TxConsequences>
+    failure(NotTEC ter)
+    {
+        return {ter, TxConsequences{ter}};
+    }
+
+    void
+    testFetch()
+    {
+        testcase("fetch");
+
+        using namespace std::chrono_literals;
+        TestStopwatch stopwatch;
+        PreflightCache cache(stopwatch, 16, 2s);
+        Rules const rules{presets_};
+
+        uint256 const id1(1);
+        uint256 const id2(2);
+
+        BEAST_EXPECT(!cache.fetch(id1, rules, tapNONE));
+
+        STTx const tx(ttACCOUNT_SET, [](STObject& obj) {
+            obj[sfAccount] = AccountID(1);
+            obj[sfFee] = STAmount(XRPAmount(10));
+            obj[sfSequence] = 7;
+        });
+        cache.insert(id1, rules, tapNONE, {tesSUCCESS, TxConsequences{tx}});
+        cache.insert(id2, rules, tapNONE, failure(temMALFORMED));
+        BEAST_EXPECT(cache.size() == 2);
+
+        auto const hit = cache.fetch(id1, rules, tapNONE);
+        if (BEAST_EXPECT(hit))
+        {
+            BEAST_EXPECT(hit->first == tesSUCCESS);
+            BEAST_EXPECT(hit->second.fee() == XRPAmount(10));
+            BEAST_EXPECT(hit->second.seqProxy() == SeqProxy::sequence(7));
+        }
+        if (auto const bad = cache.fetch(id2, rules, tapNONE);
+            BEAST_EXPECT(bad))
+            BEAST_EXPECT(bad->first == temMALFORMED);
+
+        // Retry passes share the result of the first check, but other
+        // flags do not.
+        BEAST_EXPECT(cache.fetch(id1, rules, tapRETRY));
+        BEAST_EXPECT(!cache.fetch(id1, rules, tapUNLIMITED));
+        BEAST_EXPECT(!cache.fetch(id1, rules, tapFAIL_HARD | tapRETRY));
+
+        // A result for other flags replaces the old one.
+        cache.insert(id1, rules, tapUNLIMITED, failure(temBAD_FEE));
+        BEAST_EXPECT(cache.size() == 2);
+        BEAST_EXPECT(!cache.fetch(id1, rules, tapNONE));
+        if (auto const unlimited = cache.fetch(id1, rules, tapUNLIMITED);
+            BEAST_EXPECT(unlimited))
+            BEAST_EXPECT(unlimited->first == temBAD_FEE);
+    }
+
+    void
+    testExpiration()
+    {
+        testcase("expiration");
+
+        using namespace std::chrono_literals;
+        TestStopwatch stopwatch;
+        PreflightCache cache(stopwatch, 16, 2s);
+        Rules const rules{presets_};
+
+        uint256 const id1(1);
+        uint256 const id2(2);
+
+        cache.insert(id1, rules, tapNONE, failure(temMALFORMED));
+        cache.insert(id2, rules, tapNONE, failure(temMALFORMED));
+
+        ++stopwatch;
+        // Using an entry keeps it around.
+        BEAST_EXPECT(cache.fetch(id1, rules, tapNONE));
+
+        ++stopwatch;
+        cache.sweep();
+        BEAST_EXPECT(cache.size() == 1);
+        BEAST_EXPECT(cache.fetch(id1, rules, tapNONE));
+        BEAST_EXPECT(!cache.fetch(id2, rules, tapNONE));
+
+        stopwatch.advance(5s);
+        cache.sweep();
+        BEAST_EXPECT(cache.size() == 0);
+    }
+
+    void
+    testCapacity()
+    {
+        testcase("capacity");
+
+        TestStopwatch stopwatch;
+        PreflightCache cache(stopwatch, 4, std::chrono::seconds{60});
+        Rules const rules{presets_};
+
+        for (std::uint64_t i = 1; i <= 4; ++i)
+        {
+            cache.insert(uint256(i), rules, tapNONE, failure(temMALFORMED));
+            ++stopwatch;
+        }
+        BEAST_EXPECT(cache.size() == 4);
+
+        // The least recently used entry is evicted first.
+        BEAST_EXPECT(cache.fetch(uint256(1), rules, tapNONE));
+        cache.insert(uint256(5), rules, tapNONE, failure(temMALFORMED));
+        BEAST_EXPECT(cache.size() == 4);
+        BEAST_EXPECT(cache.fetch(uint256(1), rules, tapNONE));
+        BEAST_EXPECT(!cache.fetch(uint256(2), rules, tapNONE));
+        BEAST_EXPECT(cache.fetch(uint256(5), rules, tapNONE));
+    }
+
+public:
+    void
+    run() override
+    {
+        testFetch();
+        testExpiration();
+        testCapacity();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(PreflightCache, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
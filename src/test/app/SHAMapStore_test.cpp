@@ -17,6 +17,8 @@
 */
 //==============================================================================
 
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/ledger/PendingWrites.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/SHAMapStore.h>
 #include <ripple/app/rdb/backend/SQLiteDatabase.h>
@@ -518,12 +520,89 @@ public:
         lastRotated = ledgerSeq - 1;
     }
 
+    void
+    testIncremental()
+    {
+        testcase("incremental copy");
+        using namespace jtx;
+
+        Env env(*this, envconfig(onlineDelete));
+        auto& store = env.app().getSHAMapStore();
+        Account const alice{"alice"};
+
+        auto ledgerSeq = waitForReady(env);
+        auto lastRotated = ledgerSeq - 1;
+
+        env.fund(XRP(10000), alice);
+        env.close();
+        ++ledgerSeq;
+        store.rendezvous();
+
+        auto onlineDelete = [&env]() {
+            auto const info = env.rpc("server_info");
+            return info[jss::result][jss::info][jss::online_delete];
+        };
+
+        // Every node of the validated state must survive each rotation
+        auto missingNodes = [&env]() {
+            auto const validated =
+                env.app().getLedgerMaster().getValidatedLedger();
+            env.app().pendingWrites().waitThrough(validated->info().seq);
+
+            auto& nodeStore = env.app().getNodeStore();
+            int missing = 0;
+            validated->stateMap()
+                .snapShot(false)
+                ->visitNodes([&](SHAMapTreeNode& node) {
+                    if (!nodeStore.fetchNodeObject(node.getHash().as_uint256()))
+                        ++missing;
+                    return true;
+                });
+            return missing;
+        };
+
+        for (int rotation = 0; rotation < 3; ++rotation)
+        {
+            // The state is copied ahead of time halfway to the rotation
+            for (; ledgerSeq <= lastRotated + deleteInterval / 2; ++ledgerSeq)
+            {
+                BEAST_EXPECT(!onlineDelete().isMember(jss::copied_ledger));
+                env(noop(alice));
+                env.close();
+                store.rendezvous();
+            }
+            {
+                auto const info = onlineDelete();
+                BEAST_EXPECT(info[jss::state] == "idle");
+                BEAST_EXPECT(info[jss::last_rotated] == lastRotated);
+                BEAST_EXPECT(info[jss::copied_ledger] == ledgerSeq - 1);
+            }
+
+            // Rotating only copies what changed since then
+            for (; ledgerSeq <= lastRotated + deleteInterval; ++ledgerSeq)
+            {
+                env(noop(alice));
+                env.close();
+                store.rendezvous();
+            }
+            BEAST_EXPECT(store.getLastRotated() == ledgerSeq - 1);
+            lastRotated = store.getLastRotated();
+            {
+                auto const info = onlineDelete();
+                BEAST_EXPECT(info[jss::last_rotated] == lastRotated);
+                BEAST_EXPECT(!info.isMember(jss::copied_ledger));
+            }
+            BEAST_EXPECT(missingNodes() == 0);
+        }
+    }
+
     void
     run() override
     {
         testClear();
         testAutomatic();
         testCanDelete();
+        testIncremental();
     }
 };
 
@@ -0,0 +1,481 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/tx/applySteps.h>
+#include <ripple/ledger/OpenView.h>
+#include <ripple/protocol/Feature.h>
+#include <ripple/protocol/STIssue.h>
+#include <ripple/protocol/TxFlags.h>
+#include <ripple/protocol/jss.h>
+#include <test/jtx.h>
+#include <test/jtx/AMM.h>
+#include <boost/algorithm/string.hpp>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+/*  Build with this set to count heap allocations per step.
+
+    It replaces the global allocation functions for the whole binary,
+    so is only meant for builds made to run this benchmark.
+*/
+#ifndef TX_BENCHMARK_COUNT_ALLOCATIONS
+#define TX_BENCHMARK_COUNT_ALLOCATIONS 0
+#endif
+
+#if TX_BENCHMARK_COUNT_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+
+namespace ripple {
+namespace test {
+std::atomic<std::uint64_t> txBenchmarkAllocations{0};
+}  // namespace test
+}  // namespace ripple
+
+void*
+operator new(std::size_t size)
+{
+    ++ripple::test::txBenchmarkAllocations;
+    if (auto p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void*
+operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+#endif
+
+namespace ripple {
+namespace test {
+
+/** Times the transaction engine, one transaction type at a time.
+
+    A ledger is set up with many funded accounts, trust lines to a
+    gateway, deep order books, an AMM pool, and accounts holding many
+    NFTokens. Then, for each workload, one transaction per account is
+    signed against the open ledger and pushed through preflight,
+    preclaim and doApply, each on a fresh copy of the open ledger so
+    that every pass sees the same state.
+
+    The time spent in each step is reported in nanoseconds per
+    transaction, along with heap allocations per transaction in builds
+    with TX_BENCHMARK_COUNT_ALLOCATIONS set. Signatures are checked on
+    the first pass only; later passes find them in the HashRouter, as
+    transactions relayed to a server usually do, and find the preflight
+    result in the PreflightCache.
+
+    A second table reports the same for a round trip of each transaction
+    through its wire format: serializing it, then parsing it back into an
+    STTx, which includes computing its ID.
+
+    The argument is a list of options separated by ';':
+
+        accounts=N      Accounts sending transactions (default 100).
+        offers=N        Offers in each order book (default 200).
+        passes=N        Times each workload is replayed (default 5).
+
+    For example:
+
+        --unittest=TxBenchmark --unittest-arg="accounts=500;passes=10"
+*/
+class TxBenchmark_test : public beast::unit_test::suite
+{
+    using clock_type = std::chrono::steady_clock;
+
+    struct Options
+    {
+        std::size_t accounts = 100;
+        std::size_t offers = 200;
+        std::size_t passes = 5;
+    };
+
+    struct Step
+    {
+        std::chrono::nanoseconds elapsed{};
+        std::uint64_t allocations = 0;
+    };
+
+    struct Stats
+    {
+        std::size_t count = 0;
+        Step preflight;
+        Step preclaim;
+        Step apply;
+        Step serialize;
+        Step deserialize;
+    };
+
+    static std::uint64_t
+    allocations()
+    {
+#if TX_BENCHMARK_COUNT_ALLOCATIONS
+        return txBenchmarkAllocations.load();
+#else
+        return 0;
+#endif
+    }
+
+    // Run f, adding the time and allocations it takes to step
+    template <class F>
+    static auto
+    measure(Step& step, F&& f)
+    {
+        auto const allocs = allocations();
+        auto const start = clock_type::now();
+        auto result = f();
+        step.elapsed += clock_type::now() - start;
+        step.allocations += allocations() - allocs;
+        return result;
+    }
+
+    Stats
+    replay(
+        jtx::Env& env,
+        std::string const& name,
+        std::vector<jtx::JTx> const& txs,
+        Options const& options)
+    {
+        auto const base = env.current();
+        Stats stats;
+        std::size_t failed = 0;
+        TER firstFailure = tesSUCCESS;
+
+        for (std::size_t pass = 0; pass < options.passes; ++pass)
+        {
+            for (auto const& jt : txs)
+            {
+                OpenView view(*base);
+                auto const& tx = *jt.stx;
+
+                auto const pfResult = measure(stats.preflight, [&] {
+                    return preflight(
+                        env.app(), view.rules(), tx, tapNONE, env.journal);
+                });
+                auto const pcResult = measure(stats.preclaim, [&] {
+                    return preclaim(pfResult, env.app(), view);
+                });
+                auto const result = measure(stats.apply, [&] {
+                    return doApply(pcResult, env.app(), view);
+                });
+
+                auto const wire = measure(stats.serialize, [&] {
+                    Serializer s;
+                    tx.add(s);
+                    return s;
+                });
+                auto const parsed = measure(stats.deserialize, [&] {
+                    SerialIter sit(wire.slice());
+                    return STTx(sit);
+                });
+                BEAST_EXPECT(
+                    parsed.getTransactionID() == tx.getTransactionID());
+
+                ++stats.count;
+                if (result.first != tesSUCCESS)
+                {
+                    if (!failed++)
+                        firstFailure = result.first;
+                }
+            }
+        }
+
+        BEAST_EXPECTS(
+            failed == 0,
+            name + ": " + std::to_string(failed) + " failed, first with " +
+                transToken(firstFailure));
+        return stats;
+    }
+
+    // Nanoseconds per transaction spent in step
+    static std::int64_t
+    nsPerTx(Stats const& stats, Step const& step)
+    {
+        return stats.count ? step.elapsed.count() / stats.count : 0;
+    }
+
+    // Allocations per transaction made by step, if they were counted
+    static std::string
+    allocationsPerTx(Stats const& stats, Step const& step)
+    {
+        std::stringstream ss;
+        if (TX_BENCHMARK_COUNT_ALLOCATIONS && stats.count)
+            ss << std::fixed << std::setprecision(1)
+               << double(step.allocations) / stats.count;
+        else
+            ss << "-";
+        return ss.str();
+    }
+
+    void
+    report(std::string const& name, Stats const& stats)
+    {
+        using std::setw;
+        auto perTx = [&](Step const& step) { return nsPerTx(stats, step); };
+        auto allocsPerTx = [&](Step const& step) {
+            return allocationsPerTx(stats, step);
+        };
+
+        std::stringstream ss;
+        ss << std::left << setw(24) << name << std::right << setw(8)
+           << stats.count << setw(12) << perTx(stats.preflight) << setw(12)
+           << perTx(stats.preclaim) << setw(12) << perTx(stats.apply)
+           << setw(12)
+           << (perTx(stats.preflight) + perTx(stats.preclaim) +
+               perTx(stats.apply))
+           << setw(10) << allocsPerTx(stats.preflight) << setw(10)
+           << allocsPerTx(stats.preclaim) << setw(10)
+           << allocsPerTx(stats.apply);
+        log << ss.str() << std::endl;
+    }
+
+    void
+    reportRoundTrip(std::string const& name, Stats const& stats)
+    {
+        using std::setw;
+        std::stringstream ss;
+        ss << std::left << setw(24) << name << std::right << setw(8)
+           << stats.count << setw(12) << nsPerTx(stats, stats.serialize)
+           << setw(12) << nsPerTx(stats, stats.deserialize) << setw(10)
+           << allocationsPerTx(stats, stats.serialize) << setw(10)
+           << allocationsPerTx(stats, stats.deserialize);
+        log << ss.str() << std::endl;
+    }
+
+    static Options
+    parse(std::string const& args)
+    {
+        Options options;
+        std::vector<std::string> entries;
+        boost::split(entries, args, boost::algorithm::is_any_of(";"));
+        for (auto const& entry : entries)
+        {
+            auto const eq = entry.find('=');
+            if (eq == std::string::npos)
+                continue;
+            auto const key = entry.substr(0, eq);
+            auto const value = std::stoul(entry.substr(eq + 1));
+            if (key == "accounts")
+                options.accounts = value;
+            else if (key == "offers")
+                options.offers = value;
+            else if (key == "passes")
+                options.passes = value;
+        }
+        return options;
+    }
+
+public:
+    void
+    run() override
+    {
+        testcase("TxBenchmark");
+        using namespace jtx;
+
+        auto const options = parse(arg());
+
+        Env env(*this, supported_amendments());
+        Account const gw("gateway");
+        Account const maker("maker");
+        auto const USD = gw["USD"];
+        auto const EUR = gw["EUR"];
+
+        std::vector<Account> users;
+        for (std::size_t i = 0; i < options.accounts; ++i)
+            users.emplace_back("user" + std::to_string(i));
+
+        // Accounts, trust lines and balances
+        env.fund(XRP(100'000'000), gw, maker);
+        env(fset(gw, asfDefaultRipple));
+        env.close();
+        for (auto const& user : users)
+            env.fund(XRP(1'000'000), user);
+        env.close();
+        for (auto const& account : users)
+        {
+            env(trust(account, USD(1'000'000'000)));
+            env(trust(account, EUR(1'000'000'000)));
+        }
+        env(trust(maker, USD(1'000'000'000)));
+        env(trust(maker, EUR(1'000'000'000)));
+        env.close();
+        for (auto const& user : users)
+        {
+            env(pay(gw, user, USD(1'000'000)));
+            env(pay(gw, user, EUR(1'000'000)));
+        }
+        env(pay(gw, maker, USD(100'000'000)));
+        env(pay(gw, maker, EUR(100'000'000)));
+        env.close();
+
+        // Deep EUR/USD and XRP/USD books, each offer worse than the last
+        for (std::size_t i = 0; i < options.offers; ++i)
+        {
+            env(offer(maker, EUR(100 + i), USD(100)));
+            env(offer(maker, XRP(1000 + 10 * i), USD(100)));
+        }
+        env.close();
+
+        // An AMM pool alongside the EUR/USD book
+        AMM amm(env, maker, USD(1'000'000), EUR(1'010'000));
+        env.close();
+
+        // Accounts holding enough NFTokens to span several pages
+        std::size_t const collectors = std::min<std::size_t>(users.size(), 16);
+        std::vector<uint256> burnable;
+        for (std::size_t i = 0; i < collectors; ++i)
+        {
+            for (int n = 0; n < 95; ++n)
+            {
+                if (n == 47)
+                    burnable.push_back(token::getNextID(env, users[i], 0));
+                env(token::mint(users[i], 0));
+            }
+            env.close();
+        }
+
+        using Generator = std::function<Json::Value(std::size_t)>;
+        auto next = [&](std::size_t i) -> Account const& {
+            return users[(i + 1) % users.size()];
+        };
+        std::vector<std::pair<std::string, Generator>> const workloads = {
+            {"Payment XRP",
+             [&](std::size_t i) { return pay(users[i], next(i), XRP(10)); }},
+            {"Payment IOU",
+             [&](std::size_t i) { return pay(users[i], next(i), USD(10)); }},
+            {"Payment cross-currency",
+             [&](std::size_t i) {
+                 auto jv = pay(users[i], next(i), USD(1000));
+                 jv[jss::SendMax] =
+                     EUR(2000).value().getJson(JsonOptions::none);
+                 jv[jss::Paths] = Json::arrayValue;
+                 jv[jss::Paths].append(Json::arrayValue);
+                 Json::Value step;
+                 step[jss::currency] = "USD";
+                 step[jss::issuer] = gw.human();
+                 jv[jss::Paths][0u].append(step);
+                 return jv;
+             }},
+            {"OfferCreate crossing",
+             [&](std::size_t i) {
+                 return offer(users[i], USD(1000), XRP(20000));
+             }},
+            {"OfferCreate resting",
+             [&](std::size_t i) { return offer(users[i], USD(10), XRP(1)); }},
+            {"TrustSet",
+             [&](std::size_t i) {
+                 return trust(users[i], gw["JPY"](1000));
+             }},
+            {"AMMDeposit",
+             [&](std::size_t i) {
+                 Json::Value jv;
+                 jv[jss::TransactionType] = jss::AMMDeposit;
+                 jv[jss::Account] = users[i].human();
+                 jv[jss::Asset] =
+                     STIssue(sfAsset, USD.issue()).getJson(JsonOptions::none);
+                 jv[jss::Asset2] =
+                     STIssue(sfAsset, EUR.issue()).getJson(JsonOptions::none);
+                 jv[jss::Amount] = USD(100).value().getJson(JsonOptions::none);
+                 jv[jss::Flags] = tfSingleAsset;
+                 return jv;
+             }},
+            {"NFTokenMint",
+             [&](std::size_t i) {
+                 return token::mint(users[i % collectors], 0);
+             }},
+            {"NFTokenBurn",
+             [&](std::size_t i) {
+                 return token::burn(
+                     users[i % collectors], burnable[i % collectors]);
+             }},
+        };
+
+        {
+            using std::setw;
+            std::stringstream ss;
+            ss << std::left << setw(24) << "Workload" << std::right << setw(8)
+               << "Txs" << setw(12) << "preflight" << setw(12) << "preclaim"
+               << setw(12) << "doApply" << setw(12) << "total ns"
+               << setw(10) << "pf allocs" << setw(10) << "pc allocs"
+               << setw(10) << "ap allocs";
+            log << ss.str() << std::endl;
+        }
+
+        std::vector<std::pair<std::string, Stats>> results;
+        for (auto const& [name, generate] : workloads)
+        {
+            // One transaction per account, except where fewer accounts
+            // have what the workload needs
+            auto const count =
+                boost::starts_with(name, "NFToken") ? collectors : users.size();
+            std::vector<JTx> txs;
+            txs.reserve(count);
+            for (std::size_t i = 0; i < count; ++i)
+                txs.push_back(env.jt(generate(i)));
+
+            results.emplace_back(name, replay(env, name, txs, options));
+            report(name, results.back().second);
+        }
+
+        {
+            using std::setw;
+            std::stringstream ss;
+            ss << std::left << setw(24) << "Round trip" << std::right
+               << setw(8) << "Txs" << setw(12) << "serialize" << setw(12)
+               << "parse" << setw(10) << "se allocs" << setw(10)
+               << "pa allocs";
+            log << ss.str() << std::endl;
+        }
+        for (auto const& [name, stats] : results)
+            reportRoundTrip(name, stats);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(TxBenchmark, app, ripple, 10);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,147 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <ripple/app/misc/TxJsonCache.h>
+#include <ripple/basics/chrono.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/STTx.h>
+#include <ripple/protocol/jss.h>
+
+namespace ripple {
+namespace test {
+
+class TxJsonCache_test : public beast::unit_test::suite
+{
+    static STTx
+    payment(std::uint32_t seq)
+    {
+        return STTx(ttPAYMENT, [seq](STObject& obj) {
+            obj[sfAccount] = AccountID(1);
+            obj[sfDestination] = AccountID(2);
+            obj[sfAmount] = STAmount(XRPAmount(1000));
+            obj[sfFee] = STAmount(XRPAmount(10));
+            obj[sfSequence] = seq;
+        });
+    }
+
+    void
+    testVersions()
+    {
+        testcase("versions");
+
+        TestStopwatch stopwatch;
+        TxJsonCache cache(stopwatch, 16, std::chrono::seconds{60});
+        auto const tx = payment(7);
+
+        auto expected = tx.getJson(JsonOptions::none, false);
+        expected[jss::DeliverMax] = "1000";
+
+        auto const v1 = cache.get(tx, 1, false);
+        BEAST_EXPECT(*v1 == expected);
+        BEAST_EXPECT(v1->isMember(jss::hash));
+        BEAST_EXPECT(v1->isMember(jss::Amount));
+
+        auto const v2 = cache.get(tx, 2, false);
+        BEAST_EXPECT(!v2->isMember(jss::hash));
+        BEAST_EXPECT(!v2->isMember(jss::Amount));
+        BEAST_EXPECT((*v2)[jss::DeliverMax] == "1000");
+
+        auto const blob = cache.get(tx, 2, true);
+        BEAST_EXPECT(
+            *blob == tx.getJson(JsonOptions::disable_API_prior_V2, true));
+        BEAST_EXPECT(
+            *cache.get(tx, 1, true) == tx.getJson(JsonOptions::none, true));
+
+        // Every version of a transaction shares one entry, and later
+        // requests share the JSON built by the first.
+        BEAST_EXPECT(cache.size() == 1);
+        BEAST_EXPECT(cache.get(tx, 1, false) == v1);
+        BEAST_EXPECT(cache.get(tx, 2, false) == v2);
+        BEAST_EXPECT(cache.get(tx, 2, true) == blob);
+        BEAST_EXPECT(cache.get(tx, 3, false) != v2);
+        BEAST_EXPECT(*cache.get(tx, 3, false) == *v2);
+    }
+
+    void
+    testExpiration()
+    {
+        testcase("expiration");
+
+        using namespace std::chrono_literals;
+        TestStopwatch stopwatch;
+        TxJsonCache cache(stopwatch, 16, 2s);
+        auto const tx1 = payment(1);
+        auto const tx2 = payment(2);
+
+        cache.get(tx1, 1, false);
+        cache.get(tx2, 1, false);
+
+        ++stopwatch;
+        // Using an entry keeps it around, whatever the version.
+        auto const json = cache.get(tx1, 2, false);
+
+        ++stopwatch;
+        cache.sweep();
+        BEAST_EXPECT(cache.size() == 1);
+        BEAST_EXPECT(cache.get(tx1, 2, false) == json);
+
+        stopwatch.advance(5s);
+        cache.sweep();
+        BEAST_EXPECT(cache.size() == 0);
+    }
+
+    void
+    testCapacity()
+    {
+        testcase("capacity");
+
+        TestStopwatch stopwatch;
+        TxJsonCache cache(stopwatch, 4, std::chrono::seconds{60});
+
+        std::vector<std::shared_ptr<Json::Value const>> json;
+        for (std::uint32_t i = 1; i <= 4; ++i)
+        {
+            json.push_back(cache.get(payment(i), 1, false));
+            ++stopwatch;
+        }
+        BEAST_EXPECT(cache.size() == 4);
+
+        // The least recently used entry is evicted first.
+        BEAST_EXPECT(cache.get(payment(1), 1, false) == json[0]);
+        cache.get(payment(5), 1, false);
+        BEAST_EXPECT(cache.size() == 4);
+        BEAST_EXPECT(cache.get(payment(1), 1, false) == json[0]);
+        BEAST_EXPECT(cache.get(payment(2), 1, false) != json[1]);
+    }
+
+public:
+    void
+    run() override
+    {
+        testVersions();
+        testExpiration();
+        testCapacity();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(TxJsonCache, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/ByteUtilities.h>
+#include <ripple/basics/CacheBudget.h>
+#include <ripple/basics/TaggedCache.h>
+#include <ripple/basics/chrono.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/Protocol.h>
+#include <ripple/protocol/jss.h>
+#include <test/unit_test/SuiteJournal.h>
+
+namespace ripple {
+
+class CacheBudget_test : public beast::unit_test::suite
+{
+    using Cache = TaggedCache<LedgerIndex, std::string>;
+
+    static void
+    fill(Cache& cache, int count)
+    {
+        for (int i = 0; i < count; ++i)
+            cache.insert(i, std::to_string(i));
+    }
+
+    void
+    testShrink()
+    {
+        testcase("shrink");
+
+        using namespace std::chrono_literals;
+        test::SuiteJournal journal("CacheBudget_test", *this);
+        TestStopwatch clock;
+
+        Cache hot("hot", 100, 1min, clock, journal);
+        Cache cold("cold", 100, 1min, clock, journal);
+        fill(hot, 100);
+        fill(cold, 100);
+        for (int i = 0; i < 100; ++i)
+            BEAST_EXPECT(hot.fetch(i));
+
+        // Both caches hold 10000 bytes, but only the hot one is used.
+        CacheBudget budget(15000, journal);
+        budget.add("hot", hot, 100);
+        budget.add("cold", cold, 100);
+        budget.rebalance();
+        BEAST_EXPECT(hot.getTargetSize() == 100);
+        BEAST_EXPECT(cold.getTargetSize() == 50);
+
+        // The next sweep ages out the entries over the target first.
+        clock.advance(45s);
+        cold.sweep();
+        BEAST_EXPECT(cold.getCacheSize() == 0);
+        hot.sweep();
+        BEAST_EXPECT(hot.getCacheSize() == 100);
+
+        // No target falls below an eighth of the configured size.
+        Cache other("other", 100, 1min, clock, journal);
+        fill(other, 100);
+        CacheBudget tiny(1, journal);
+        tiny.add("other", other, 100);
+        tiny.rebalance();
+        BEAST_EXPECT(other.getTargetSize() == 12);
+    }
+
+    void
+    testGrow()
+    {
+        testcase("grow");
+
+        using namespace std::chrono_literals;
+        test::SuiteJournal journal("CacheBudget_test", *this);
+        TestStopwatch clock;
+
+        Cache missed("missed", 100, 1min, clock, journal);
+        Cache found("found", 100, 1min, clock, journal);
+        fill(missed, 100);
+        fill(found, 100);
+        for (int i = 0; i < 100; ++i)
+        {
+            BEAST_EXPECT(!missed.fetch(100 + i));
+            BEAST_EXPECT(found.fetch(i));
+        }
+
+        CacheBudget budget(megabytes(1), journal);
+        budget.add("missed", missed, 100);
+        budget.add("found", found, 100);
+
+        // The full cache which misses grows by an eighth at a time, up to
+        // four times its configured size.
+        budget.rebalance();
+        BEAST_EXPECT(missed.getTargetSize() == 112);
+        BEAST_EXPECT(found.getTargetSize() == 100);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            fill(missed, missed.getTargetSize());
+            for (int j = 0; j < 10; ++j)
+                missed.fetch(1000);
+            budget.rebalance();
+        }
+        BEAST_EXPECT(missed.getTargetSize() == 400);
+        BEAST_EXPECT(found.getTargetSize() == 100);
+
+        // Without a budget, the caches are only measured.
+        CacheBudget unlimited(0, journal);
+        unlimited.add("found", found, 100);
+        for (int i = 0; i < 100; ++i)
+            found.fetch(1000);
+        unlimited.rebalance();
+        BEAST_EXPECT(found.getTargetSize() == 100);
+    }
+
+    void
+    testJson()
+    {
+        testcase("json");
+
+        using namespace std::chrono_literals;
+        test::SuiteJournal journal("CacheBudget_test", *this);
+        TestStopwatch clock;
+
+        Cache cache("cache", 100, 1min, clock, journal);
+        fill(cache, 10);
+        BEAST_EXPECT(cache.fetch(0));
+        BEAST_EXPECT(!cache.fetch(10));
+
+        CacheBudget budget(megabytes(64), journal);
+        budget.add("cache", cache, 100);
+
+        auto const jv = budget.getJson();
+        BEAST_EXPECT(jv[jss::budget] == std::to_string(megabytes(64)));
+        BEAST_EXPECT(jv[jss::bytes] == "1000");
+
+        auto const& entry = jv[jss::caches]["cache"];
+        BEAST_EXPECT(entry[jss::entries] == "10");
+        BEAST_EXPECT(entry[jss::bytes] == "1000");
+        BEAST_EXPECT(entry[jss::target_size] == 100);
+        BEAST_EXPECT(entry[jss::hit_rate].asDouble() == 50.0);
+    }
+
+public:
+    void
+    run() override
+    {
+        testShrink();
+        testGrow();
+        testJson();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(CacheBudget, basics, ripple);
+
+}  // namespace ripple
@@ -69,6 +69,18 @@ public:
                 ec && ec.value() == boost::system::errc::file_too_large);
             BEAST_EXPECT(bad.empty());
         }
+
+        {
+            // Atomic writes replace the file and leave no temporary behind
+            ec = {};
+            writeFileContentsAtomic(ec, path, "replaced");
+            BEAST_EXPECT(!ec);
+            BEAST_EXPECT(getFileContents(ec, path) == "replaced");
+            BEAST_EXPECT(!ec);
+            auto temp = path;
+            temp += ".tmp";
+            BEAST_EXPECT(!boost::filesystem::exists(temp));
+        }
     }
 
     void
@@ -0,0 +1,149 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/LatencyHistogram.h>
+#include <ripple/beast/unit_test.h>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+
+class LatencyHistogram_test : public beast::unit_test::suite
+{
+    using us = std::chrono::microseconds;
+
+    void
+    testBuckets()
+    {
+        testcase("buckets");
+
+        using H = LatencyHistogram;
+
+        // Small values are exact.
+        for (std::uint64_t v = 0; v < 16; ++v)
+        {
+            BEAST_EXPECT(H::bucketFor(v) == v);
+            BEAST_EXPECT(H::highestInBucket(v) == v);
+        }
+
+        // Every value is in a bucket no wider than an eighth of it, and
+        // buckets are contiguous.
+        std::uint64_t expected = 0;
+        for (std::size_t b = 0; b < H::bucketCount; ++b)
+        {
+            auto const high = H::highestInBucket(b);
+            BEAST_EXPECT(H::bucketFor(expected) == b);
+            BEAST_EXPECT(H::bucketFor(high) == b);
+            auto const width = high - expected + 1;
+            BEAST_EXPECT(b < 16 || width * 8 <= expected);
+            expected = high + 1;
+        }
+
+        // Values too large to count precisely land in the last bucket.
+        BEAST_EXPECT(H::bucketFor(expected) == H::bucketCount - 1);
+        BEAST_EXPECT(
+            H::bucketFor(std::numeric_limits<std::uint64_t>::max()) ==
+            H::bucketCount - 1);
+    }
+
+    void
+    testPercentiles()
+    {
+        testcase("percentiles");
+
+        LatencyHistogram h;
+        BEAST_EXPECT(h.count() == 0);
+        BEAST_EXPECT(h.percentile(0.5) == us(0));
+
+        // 1000 fast samples and 10 slow ones
+        for (int i = 0; i < 1000; ++i)
+            h.record(us(10 + i % 5));
+        for (int i = 0; i < 10; ++i)
+            h.record(us(50'000));
+        h.record(us(-3));
+
+        BEAST_EXPECT(h.count() == 1011);
+        BEAST_EXPECT(h.percentile(0.0) == us(0));
+        BEAST_EXPECT(h.percentile(0.5) == us(12));
+        BEAST_EXPECT(h.percentile(0.99) == us(14));
+
+        auto const tail = h.percentile(0.999);
+        BEAST_EXPECT(tail >= us(50'000));
+        BEAST_EXPECT(tail <= us(50'000 + 50'000 / 8));
+        BEAST_EXPECT(h.percentile(1.0) == tail);
+    }
+
+    void
+    testSnapshots()
+    {
+        testcase("snapshots");
+
+        LatencyHistogram h;
+        for (int i = 0; i < 100; ++i)
+            h.record(us(50'000));
+        auto const before = h.snapshot();
+
+        // Only the fast samples recorded since the snapshot count
+        for (int i = 0; i < 100; ++i)
+            h.record(us(10));
+        auto window = h.snapshot();
+        for (std::size_t i = 0; i < window.size(); ++i)
+            window[i] -= before[i];
+
+        BEAST_EXPECT(LatencyHistogram::percentile(window, 1.0) == us(10));
+        BEAST_EXPECT(h.percentile(0.5) == us(10));
+        BEAST_EXPECT(h.percentile(1.0) >= us(50'000));
+
+        LatencyHistogram::Counts empty{};
+        BEAST_EXPECT(LatencyHistogram::percentile(empty, 0.5) == us(0));
+    }
+
+    void
+    testConcurrent()
+    {
+        testcase("concurrent");
+
+        LatencyHistogram h;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+            threads.emplace_back([&h, t] {
+                for (int i = 0; i < 10'000; ++i)
+                    h.record(us(t * 1000 + i % 100));
+            });
+        for (auto& t : threads)
+            t.join();
+
+        BEAST_EXPECT(h.count() == 40'000);
+    }
+
+public:
+    void
+    run() override
+    {
+        testBuckets();
+        testPercentiles();
+        testSnapshots();
+        testConcurrent();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(LatencyHistogram, basics, ripple);
+
+}  // namespace ripple
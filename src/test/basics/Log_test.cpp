@@ -0,0 +1,142 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/Log.h>
+#include <ripple/beast/unit_test.h>
+#include <test/unit_test/FileDirGuard.h>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+
+class Log_test : public beast::unit_test::suite
+{
+    static std::vector<std::string>
+    readLines(boost::filesystem::path const& path)
+    {
+        std::vector<std::string> lines;
+        std::ifstream in(path.string());
+        for (std::string line; std::getline(in, line);)
+            lines.push_back(line);
+        return lines;
+    }
+
+    void
+    testWrite()
+    {
+        testcase("write");
+
+        using namespace beast::severities;
+
+        test::detail::FileDirGuard const guard(
+            *this, "log_test", "debug.log", "", true, false);
+
+        Logs logs(kInfo);
+        logs.silent(true);
+        BEAST_EXPECT(logs.open(guard.file()));
+
+        auto const j = logs.journal("Partition");
+        JLOG(j.debug()) << "hidden";
+        JLOG(j.info()) << "first";
+        JLOG(j.warn()) << "second \"secret\":\"shh\"";
+        logs.flush();
+
+        auto lines = readLines(guard.file());
+        BEAST_EXPECT(lines.size() == 2);
+        if (lines.size() == 2)
+        {
+            BEAST_EXPECT(lines[0].ends_with(" Partition:NFO first"));
+            BEAST_EXPECT(
+                lines[1].ends_with(" Partition:WRN second \"secret\":\"***\""));
+        }
+
+        // Fatal messages are written before the call returns
+        JLOG(j.fatal()) << "third";
+        lines = readLines(guard.file());
+        BEAST_EXPECT(
+            lines.size() == 3 && lines[2].ends_with(" Partition:FTL third"));
+    }
+
+    void
+    testThreads()
+    {
+        testcase("threads");
+
+        using namespace beast::severities;
+
+        test::detail::FileDirGuard const guard(
+            *this, "log_test", "threads.log", "", true, false);
+
+        std::size_t const threads = 4;
+        std::size_t const perThread = 20000;
+
+        Logs logs(kInfo);
+        logs.silent(true);
+        BEAST_EXPECT(logs.open(guard.file()));
+
+        std::vector<std::thread> writers;
+        for (std::size_t t = 0; t != threads; ++t)
+        {
+            writers.emplace_back([&logs, t] {
+                auto const j = logs.journal("T" + std::to_string(t));
+                for (std::size_t i = 0; i != perThread; ++i)
+                    JLOG(j.info()) << i;
+            });
+        }
+        for (auto& w : writers)
+            w.join();
+        logs.flush();
+
+        // Every message was either written, in order, or counted as dropped
+        std::vector<std::size_t> next(threads, 0);
+        std::size_t written = 0;
+        bool ordered = true;
+        for (auto const& line : readLines(guard.file()))
+        {
+            auto const at = line.find(" T");
+            if (at == std::string::npos)
+                continue;
+
+            auto const t = std::stoul(line.substr(at + 2));
+            auto const i = std::stoul(line.substr(line.rfind(' ') + 1));
+            if (t >= threads || i < next[t])
+                ordered = false;
+            else
+                next[t] = i + 1;
+            ++written;
+        }
+
+        BEAST_EXPECT(ordered);
+        BEAST_EXPECT(written + logs.dropped() == threads * perThread);
+    }
+
+public:
+    void
+    run() override
+    {
+        testWrite();
+        testThreads();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(Log, basics, ripple);
+
+}  // namespace ripple
@@ -949,6 +949,19 @@ public:
         verifyCounters(perfLog->countersJson(), 2, 2, 24, 36);
         verifyEmptyCurrent(perfLog->currentJson());
 
+        // Both jobs are in the latency percentiles.  Durations this short
+        // are reported exactly, or rounded up to the odd microsecond.
+        {
+            Json::Value const latency{
+                perfLog->latencyJson()[jss::job_queue][jobTypeName]};
+            BEAST_EXPECT(latency[jss::queued][jss::count] == "2");
+            BEAST_EXPECT(latency[jss::queued][jss::p50_us] == "11");
+            BEAST_EXPECT(latency[jss::queued][jss::p999_us] == "13");
+            BEAST_EXPECT(latency[jss::running][jss::count] == "2");
+            BEAST_EXPECT(latency[jss::running][jss::p50_us] == "17");
+            BEAST_EXPECT(latency[jss::running][jss::p999_us] == "19");
+        }
+
         // Give the PerfLog enough time to flush it's state to the file.
         fixture.wait();
 
@@ -1045,6 +1058,39 @@ public:
         }
     }
 
+    void
+    testDbReaders()
+    {
+        using namespace std::chrono;
+
+        Fixture fixture{env_.app(), j_};
+        auto perfLog{fixture.perfLog(WithFile::no)};
+        perfLog->start();
+
+        // Nothing is reported until a reader has been checked out.
+        BEAST_EXPECT(!perfLog->countersJson().isMember(jss::db_readers));
+
+        perfLog->dbReader("ledger.db", microseconds{3});
+        perfLog->dbReader("ledger.db", microseconds{0});
+        perfLog->dbReader("ledger.db", microseconds{7});
+        perfLog->dbReader("transaction.db", microseconds{5});
+
+        Json::Value const readers{perfLog->countersJson()[jss::db_readers]};
+        BEAST_EXPECT(readers.size() == 2);
+
+        Json::Value const& ledger{readers["ledger.db"]};
+        BEAST_EXPECT(ledger[jss::checkouts] == "3");
+        BEAST_EXPECT(ledger[jss::wait_us] == "10");
+        BEAST_EXPECT(ledger[jss::max_wait_us] == "7");
+
+        Json::Value const& tx{readers["transaction.db"]};
+        BEAST_EXPECT(tx[jss::checkouts] == "1");
+        BEAST_EXPECT(tx[jss::wait_us] == "5");
+        BEAST_EXPECT(tx[jss::max_wait_us] == "5");
+
+        perfLog->stop();
+    }
+
     void
     run() override
     {
@@ -1057,6 +1103,7 @@ public:
         testInvalidID(WithFile::yes);
         testRotate(WithFile::no);
         testRotate(WithFile::yes);
+        testDbReaders();
     }
 };
 
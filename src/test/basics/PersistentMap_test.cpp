@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/PersistentMap.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+class PersistentMap_test : public beast::unit_test::suite
+{
+    using Map = PersistentMap<int, int>;
+
+    bool
+    same(Map const& m, std::map<int, int> const& expected)
+    {
+        if (m.size() != expected.size())
+            return false;
+        auto iter = m.begin();
+        for (auto const& [k, v] : expected)
+        {
+            if (iter == m.end() || iter->first != k || iter->second != v)
+                return false;
+            ++iter;
+        }
+        return iter == m.end();
+    }
+
+    void
+    testBasics()
+    {
+        testcase("basics");
+
+        Map m;
+        BEAST_EXPECT(m.empty());
+        BEAST_EXPECT(m.begin() == m.end());
+        BEAST_EXPECT(!m.get(1));
+
+        BEAST_EXPECT(m.insert(2, 20));
+        BEAST_EXPECT(m.insert(1, 10));
+        BEAST_EXPECT(m.insert(3, 30));
+        BEAST_EXPECT(!m.insert(2, 21));
+        BEAST_EXPECT(m.size() == 3);
+        BEAST_EXPECT(*m.get(2) == 20);
+
+        BEAST_EXPECT(!m.insert_or_assign(2, 22));
+        BEAST_EXPECT(*m.get(2) == 22);
+        BEAST_EXPECT(m.insert_or_assign(5, 50));
+        BEAST_EXPECT(same(m, {{1, 10}, {2, 22}, {3, 30}, {5, 50}}));
+
+        BEAST_EXPECT(m.find(3)->second == 30);
+        BEAST_EXPECT(m.find(4) == m.end());
+        BEAST_EXPECT(m.lower_bound(4)->first == 5);
+        BEAST_EXPECT(m.lower_bound(3)->first == 3);
+        BEAST_EXPECT(m.upper_bound(3)->first == 5);
+        BEAST_EXPECT(m.upper_bound(5) == m.end());
+
+        BEAST_EXPECT(m.erase(2) == 1);
+        BEAST_EXPECT(m.erase(2) == 0);
+        BEAST_EXPECT(same(m, {{1, 10}, {3, 30}, {5, 50}}));
+
+        m.clear();
+        BEAST_EXPECT(m.empty());
+        BEAST_EXPECT(m.begin() == m.end());
+    }
+
+    void
+    testCopies()
+    {
+        testcase("copies");
+
+        beast::xor_shift_engine gen(42);
+        std::uniform_int_distribution<int> key(0, 999);
+
+        // Each generation is copied from the last and changed, as an open
+        // ledger is. Every earlier copy must keep its contents.
+        std::vector<Map> maps(1);
+        std::vector<std::map<int, int>> expected(1);
+        for (int i = 0; i < 200; ++i)
+        {
+            Map m = maps.back();
+            auto e = expected.back();
+            for (int j = 0; j < 50; ++j)
+            {
+                auto const k = key(gen);
+                switch (gen() % 3)
+                {
+                    case 0:
+                        BEAST_EXPECT(m.insert(k, i) == e.emplace(k, i).second);
+                        break;
+                    case 1:
+                        BEAST_EXPECT(
+                            m.insert_or_assign(k, j) ==
+                            e.insert_or_assign(k, j).second);
+                        break;
+                    default:
+                        BEAST_EXPECT(m.erase(k) == e.erase(k));
+                        break;
+                }
+            }
+            maps.push_back(std::move(m));
+            expected.push_back(std::move(e));
+        }
+
+        bool ok = true;
+        for (std::size_t i = 0; i < maps.size(); ++i)
+            ok = ok && same(maps[i], expected[i]);
+        BEAST_EXPECT(ok);
+
+        auto const& m = maps.back();
+        auto const& e = expected.back();
+        for (int k = -1; k <= 1000; ++k)
+        {
+            auto const lb = e.lower_bound(k);
+            auto const ub = e.upper_bound(k);
+            ok = ok &&
+                (lb == e.end() ? m.lower_bound(k) == m.end()
+                               : m.lower_bound(k)->first == lb->first) &&
+                (ub == e.end() ? m.upper_bound(k) == m.end()
+                               : m.upper_bound(k)->first == ub->first) &&
+                ((m.find(k) != m.end()) == (e.count(k) != 0));
+        }
+        BEAST_EXPECT(ok);
+    }
+
+public:
+    void
+    run() override
+    {
+        testBasics();
+        testCopies();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(PersistentMap, basics, ripple);
+
+}  // namespace test
+}  // namespace ripple
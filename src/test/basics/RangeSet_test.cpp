@@ -53,6 +53,49 @@ public:
         }
     }
 
+    void
+    testMissingRanges()
+    {
+        testcase("missingRanges");
+
+        RangeSet<std::uint32_t> set;
+        BEAST_EXPECT(missingRanges(set, 100u, 0u, 10).empty());
+
+        // Set will include:
+        // [10,15]
+        // [20,25]
+        // [30,35]
+        for (std::uint32_t i = 1; i < 4; ++i)
+            set.insert(range(10 * i, 10 * i + 5));
+
+        using Ranges = std::vector<ClosedInterval<std::uint32_t>>;
+
+        BEAST_EXPECT(
+            missingRanges(set, 40u, 0u, 10) ==
+            (Ranges{range(36u, 39u), range(26u, 29u), range(16u, 19u),
+                    range(0u, 9u)}));
+        BEAST_EXPECT(
+            missingRanges(set, 40u, 5u, 10) ==
+            (Ranges{range(36u, 39u), range(26u, 29u), range(16u, 19u),
+                    range(5u, 9u)}));
+        BEAST_EXPECT(
+            missingRanges(set, 33u, 0u, 2) ==
+            (Ranges{range(26u, 29u), range(16u, 19u)}));
+        BEAST_EXPECT(missingRanges(set, 36u, 30u, 2).empty());
+        BEAST_EXPECT(missingRanges(set, 40u, 40u, 2).empty());
+        BEAST_EXPECT(missingRanges(set, 40u, 0u, 0).empty());
+
+        // The first range ends at the previous missing value
+        for (std::uint32_t i = 1; i < 50; ++i)
+        {
+            auto const ranges = missingRanges(set, i, 0u, 1);
+            auto const prev = prevMissing(set, i);
+            BEAST_EXPECT(ranges.empty() == !prev);
+            if (prev && !ranges.empty())
+                BEAST_EXPECT(ranges.front().last() == *prev);
+        }
+    }
+
     void
     testToString()
     {
@@ -134,6 +177,7 @@ public:
     run() override
     {
         testPrevMissing();
+        testMissingRanges();
         testToString();
         testFromString();
     }
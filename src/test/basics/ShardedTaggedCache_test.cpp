@@ -0,0 +1,199 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/ShardedTaggedCache.h>
+#include <ripple/basics/chrono.h>
+#include <ripple/beast/clock/manual_clock.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/Protocol.h>
+#include <test/unit_test/SuiteJournal.h>
+
+#include <string>
+#include <vector>
+
+namespace ripple {
+
+/*
+The same checks as TaggedCache_test, run against a cache with several
+shards. Keys that land in different shards are swept independently but
+must age out exactly as they would in an unsharded cache.
+*/
+
+class ShardedTaggedCache_test : public beast::unit_test::suite
+{
+public:
+    void
+    run() override
+    {
+        using namespace std::chrono_literals;
+        using namespace beast::severities;
+        test::SuiteJournal journal("ShardedTaggedCache_test", *this);
+
+        TestStopwatch clock;
+        clock.set(0);
+
+        using Key = LedgerIndex;
+        using Value = std::string;
+        using Cache = ShardedTaggedCache<Key, Value>;
+
+        Cache c(
+            "test",
+            1,
+            1s,
+            clock,
+            journal,
+            beast::insight::NullCollector::New(),
+            4);
+        BEAST_EXPECT(c.shards() == 4);
+
+        // Insert an item, retrieve it, and age it so it gets purged.
+        {
+            BEAST_EXPECT(c.getCacheSize() == 0);
+            BEAST_EXPECT(c.getTrackSize() == 0);
+            BEAST_EXPECT(!c.insert(1, "one"));
+            BEAST_EXPECT(c.getCacheSize() == 1);
+            BEAST_EXPECT(c.getTrackSize() == 1);
+
+            {
+                std::string s;
+                BEAST_EXPECT(c.retrieve(1, s));
+                BEAST_EXPECT(s == "one");
+            }
+
+            ++clock;
+            c.sweep();
+            BEAST_EXPECT(c.getCacheSize() == 0);
+            BEAST_EXPECT(c.getTrackSize() == 0);
+        }
+
+        // Insert an item, maintain a strong pointer, age it, and
+        // verify that the entry still exists.
+        {
+            BEAST_EXPECT(!c.insert(2, "two"));
+            BEAST_EXPECT(c.getCacheSize() == 1);
+            BEAST_EXPECT(c.getTrackSize() == 1);
+
+            {
+                auto p = c.fetch(2);
+                BEAST_EXPECT(p != nullptr);
+                ++clock;
+                c.sweep();
+                BEAST_EXPECT(c.getCacheSize() == 0);
+                BEAST_EXPECT(c.getTrackSize() == 1);
+            }
+
+            // Make sure its gone now that our reference is gone
+            ++clock;
+            c.sweep();
+            BEAST_EXPECT(c.getCacheSize() == 0);
+            BEAST_EXPECT(c.getTrackSize() == 0);
+        }
+
+        // Insert the same key/value pair and make sure we get the same result
+        {
+            BEAST_EXPECT(!c.insert(3, "three"));
+
+            {
+                auto const p1 = c.fetch(3);
+                auto p2 = std::make_shared<Value>("three");
+                c.canonicalize_replace_client(3, p2);
+                BEAST_EXPECT(p1.get() == p2.get());
+            }
+            ++clock;
+            c.sweep();
+            BEAST_EXPECT(c.getCacheSize() == 0);
+            BEAST_EXPECT(c.getTrackSize() == 0);
+        }
+
+        // Put an object in but keep a strong pointer to it, advance the clock a
+        // lot, then canonicalize a new object with the same key, make sure you
+        // get the original object.
+        {
+            // Put an object in
+            BEAST_EXPECT(!c.insert(4, "four"));
+            BEAST_EXPECT(c.getCacheSize() == 1);
+            BEAST_EXPECT(c.getTrackSize() == 1);
+
+            {
+                // Keep a strong pointer to it
+                auto const p1 = c.fetch(4);
+                BEAST_EXPECT(p1 != nullptr);
+                BEAST_EXPECT(c.getCacheSize() == 1);
+                BEAST_EXPECT(c.getTrackSize() == 1);
+                // Advance the clock a lot
+                ++clock;
+                c.sweep();
+                BEAST_EXPECT(c.getCacheSize() == 0);
+                BEAST_EXPECT(c.getTrackSize() == 1);
+                // Canonicalize a new object with the same key
+                auto p2 = std::make_shared<std::string>("four");
+                BEAST_EXPECT(c.canonicalize_replace_client(4, p2));
+                BEAST_EXPECT(c.getCacheSize() == 1);
+                BEAST_EXPECT(c.getTrackSize() == 1);
+                // Make sure we get the original object
+                BEAST_EXPECT(p1.get() == p2.get());
+            }
+
+            ++clock;
+            c.sweep();
+            BEAST_EXPECT(c.getCacheSize() == 0);
+            BEAST_EXPECT(c.getTrackSize() == 0);
+        }
+
+        // Fill several shards, keep some entries alive and make sure
+        // each shard keeps exactly the entries that are still referenced.
+        {
+            std::vector<std::shared_ptr<Value>> held;
+            for (Key k = 100; k < 164; ++k)
+            {
+                BEAST_EXPECT(!c.insert(k, std::to_string(k)));
+                if (k % 2 == 0)
+                    held.push_back(c.fetch(k));
+            }
+            BEAST_EXPECT(c.getCacheSize() == 64);
+            BEAST_EXPECT(c.getTrackSize() == 64);
+            BEAST_EXPECT(c.getKeys().size() == 64);
+
+            ++clock;
+            c.sweep();
+            BEAST_EXPECT(c.getCacheSize() == 0);
+            BEAST_EXPECT(c.getTrackSize() == 32);
+
+            for (Key k = 100; k < 164; ++k)
+            {
+                auto const p = c.fetch(k);
+                BEAST_EXPECT((p != nullptr) == (k % 2 == 0));
+                if (p)
+                    BEAST_EXPECT(*p == std::to_string(k));
+            }
+
+            held.clear();
+            ++clock;
+            c.sweep();
+            ++clock;
+            c.sweep();
+            BEAST_EXPECT(c.getCacheSize() == 0);
+            BEAST_EXPECT(c.getTrackSize() == 0);
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ShardedTaggedCache, common, ripple);
+
+}  // namespace ripple
@@ -0,0 +1,183 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/ByteUtilities.h>
+#include <ripple/basics/HugePages.h>
+#include <ripple/basics/SlabAllocator.h>
+#include <ripple/beast/unit_test.h>
+
+#include <atomic>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+class SlabAllocator_test : public beast::unit_test::suite
+{
+    struct Item
+    {
+        std::uint64_t a;
+        std::uint64_t b;
+    };
+
+    using Config = std::vector<SlabAllocatorSet<Item>::SlabConfig>;
+
+    void
+    testAllocate()
+    {
+        testcase("allocate and deallocate");
+
+        SlabAllocatorSet<Item> slabs(Config{
+            {16, megabytes(std::size_t(1))}, {64, megabytes(std::size_t(1))}});
+
+        std::vector<std::uint8_t*> items;
+        for (int i = 0; i != 1000; ++i)
+        {
+            auto const p = slabs.allocate(i % 2 ? 8 : 40);
+            BEAST_EXPECT(p != nullptr);
+            items.push_back(p);
+        }
+
+        // Too large for any of the slabs
+        BEAST_EXPECT(slabs.allocate(128) == nullptr);
+
+        std::set<std::uint8_t*> const unique(items.begin(), items.end());
+        BEAST_EXPECT(unique.size() == items.size());
+
+        auto stats = slabs.stats();
+        BEAST_EXPECT(stats.slabs == 2);
+        BEAST_EXPECT(stats.bytes == megabytes(std::size_t(2)));
+        BEAST_EXPECT(stats.inUse >= items.size());
+        BEAST_EXPECT(stats.items >= stats.inUse);
+
+        for (auto p : items)
+            BEAST_EXPECT(slabs.deallocate(p));
+
+        // Memory the slabs never handed out is not theirs to take back
+        std::uint8_t foreign[sizeof(Item)];
+        BEAST_EXPECT(!slabs.deallocate(foreign));
+
+        // Only what this thread keeps cached remains taken
+        stats = slabs.stats();
+        BEAST_EXPECT(stats.inUse < items.size());
+    }
+
+    void
+    testThreads()
+    {
+        testcase("threads");
+
+        SlabAllocatorSet<Item> slabs(Config{{16, megabytes(std::size_t(1))}});
+        std::atomic<bool> overlap{false};
+
+        auto const before = slabs.stats().inUse;
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t != 4; ++t)
+        {
+            threads.emplace_back([&slabs, &overlap, t]() {
+                std::vector<std::uint8_t*> items;
+                for (int round = 0; round != 50; ++round)
+                {
+                    for (int i = 0; i != 300; ++i)
+                    {
+                        auto const p = slabs.allocate(8);
+                        std::memset(p, t, sizeof(Item) + 8);
+                        items.push_back(p);
+                    }
+
+                    // Items freed on one thread may be reused by another
+                    // but never handed to two at once
+                    for (auto p : items)
+                    {
+                        for (std::size_t i = 0; i != sizeof(Item) + 8; ++i)
+                        {
+                            if (p[i] != t)
+                                overlap = true;
+                        }
+                        slabs.deallocate(p);
+                    }
+
+                    items.clear();
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        BEAST_EXPECT(!overlap);
+
+        // Exiting threads return their cached items to the slabs
+        BEAST_EXPECT(slabs.stats().inUse == before);
+    }
+
+    void
+    testHugePages()
+    {
+        testcase("huge pages");
+
+        using hugePages::Mode;
+        BEAST_EXPECT(hugePages::parseMode("off") == Mode::off);
+        BEAST_EXPECT(hugePages::parseMode("explicit") == Mode::explicit_);
+        BEAST_EXPECT(!hugePages::parseMode("always"));
+
+        // Explicit huge pages fall back to transparent ones when none are
+        // reserved, so every mode must give usable, aligned blocks.
+        auto const previous = hugePages::mode();
+        for (auto const mode : {Mode::off, Mode::transparent, Mode::explicit_})
+        {
+            hugePages::setMode(mode);
+
+            auto const bytes = megabytes(std::size_t(3));
+            auto const p =
+                static_cast<std::uint8_t*>(hugePages::allocate(bytes));
+            BEAST_EXPECT(p != nullptr);
+            BEAST_EXPECT(
+                reinterpret_cast<std::uintptr_t>(p) % hugePages::size == 0);
+            std::memset(p, 0xA5, bytes);
+            BEAST_EXPECT(p[bytes - 1] == 0xA5);
+            hugePages::deallocate(p, bytes);
+
+            SlabAllocatorSet<Item> slabs(
+                Config{{16, megabytes(std::size_t(2))}});
+            auto const item = slabs.allocate(8);
+            BEAST_EXPECT(item != nullptr);
+            BEAST_EXPECT(slabs.deallocate(item));
+        }
+        hugePages::setMode(previous);
+    }
+
+public:
+    void
+    run() override
+    {
+        testAllocate();
+        testThreads();
+        testHugePages();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SlabAllocator, basics, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,184 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/SubscriptionIndex.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/beast/unit_test.h>
+#include <set>
+#include <thread>
+
+namespace ripple {
+namespace test {
+
+class SubscriptionIndex_test : public beast::unit_test::suite
+{
+    struct Sub
+    {
+        int id;
+    };
+
+    using Index = SubscriptionIndex<uint160, Sub>;
+
+    static std::set<int>
+    ids(Index& index, uint160 const& key)
+    {
+        std::set<int> result;
+        index.forEach(key, [&](std::shared_ptr<Sub> const& s) {
+            result.insert(s->id);
+        });
+        return result;
+    }
+
+    void
+    testSubscribe()
+    {
+        testcase("subscribe");
+
+        Index index;
+        BEAST_EXPECT(index.empty());
+
+        auto const a = std::make_shared<Sub>(Sub{1});
+        auto const b = std::make_shared<Sub>(Sub{2});
+        uint160 const k1(1);
+        uint160 const k2(2);
+
+        index.insert(k1, 1, a);
+        index.insert(k1, 2, b);
+        index.insert(k2, 2, b);
+        BEAST_EXPECT(index.size() == 2);
+        BEAST_EXPECT(ids(index, k1) == std::set<int>({1, 2}));
+        BEAST_EXPECT(ids(index, k2) == std::set<int>({2}));
+        BEAST_EXPECT(ids(index, uint160(3)).empty());
+
+        // Subscribing again with the same seq replaces the subscriber
+        index.insert(k2, 2, a);
+        BEAST_EXPECT(ids(index, k2) == std::set<int>({1}));
+
+        index.erase(k1, 1);
+        BEAST_EXPECT(ids(index, k1) == std::set<int>({2}));
+        index.erase(k1, 7);
+        BEAST_EXPECT(ids(index, k1) == std::set<int>({2}));
+        index.erase(k1, 2);
+        BEAST_EXPECT(ids(index, k1).empty());
+        BEAST_EXPECT(index.size() == 1);
+        index.erase(k2, 2);
+        BEAST_EXPECT(index.empty());
+    }
+
+    void
+    testExpired()
+    {
+        testcase("expired");
+
+        Index index;
+        auto a = std::make_shared<Sub>(Sub{1});
+        auto const b = std::make_shared<Sub>(Sub{2});
+        uint160 const k1(1);
+        uint160 const k2(2);
+
+        index.insert(k1, 1, a);
+        index.insert(k1, 2, b);
+        index.insert(k2, 1, a);
+        a.reset();
+
+        BEAST_EXPECT(index.forEach(k1, [](auto const&) {}) == 1);
+        BEAST_EXPECT(index.size() == 2);
+        BEAST_EXPECT(index.forEach(k2, [](auto const&) {}) == 0);
+        BEAST_EXPECT(index.size() == 1);
+        BEAST_EXPECT(ids(index, k1) == std::set<int>({2}));
+    }
+
+    void
+    testMany()
+    {
+        testcase("many keys");
+
+        Index index;
+        auto const s = std::make_shared<Sub>(Sub{1});
+        for (std::uint64_t i = 0; i < 5000; ++i)
+            index.insert(uint160(i * 2), i, s);
+        BEAST_EXPECT(index.size() == 5000);
+
+        std::size_t found = 0;
+        for (std::uint64_t i = 0; i < 10000; ++i)
+            found += index.forEach(uint160(i), [](auto const&) {});
+        BEAST_EXPECT(found == 5000);
+
+        for (std::uint64_t i = 0; i < 5000; ++i)
+            index.erase(uint160(i * 2), i);
+        BEAST_EXPECT(index.empty());
+        for (std::uint64_t i = 0; i < 10000; ++i)
+            found += index.forEach(uint160(i), [](auto const&) {});
+        BEAST_EXPECT(found == 5000);
+    }
+
+    void
+    testConcurrent()
+    {
+        testcase("concurrent");
+
+        Index index;
+        uint160 const key(42);
+        auto const first = std::make_shared<Sub>(Sub{0});
+        index.insert(key, 0, first);
+
+        std::atomic<bool> stop{false};
+        std::atomic<bool> sawFirst{true};
+        std::thread publisher([&] {
+            while (!stop)
+            {
+                bool found = false;
+                index.forEach(key, [&](std::shared_ptr<Sub> const& s) {
+                    found = found || s->id == 0;
+                });
+                if (!found)
+                    sawFirst = false;
+            }
+        });
+
+        std::vector<std::shared_ptr<Sub>> subs;
+        for (int i = 1; i <= 1000; ++i)
+        {
+            subs.push_back(std::make_shared<Sub>(Sub{i}));
+            index.insert(key, i, subs.back());
+            if (i % 2 == 0)
+                index.erase(key, i - 1);
+        }
+        stop = true;
+        publisher.join();
+
+        BEAST_EXPECT(sawFirst);
+        BEAST_EXPECT(ids(index, key).size() == 501);
+    }
+
+public:
+    void
+    run() override
+    {
+        testSubscribe();
+        testExpired();
+        testMany();
+        testConcurrent();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SubscriptionIndex, basics, ripple);
+
+}  // namespace test
+}  // namespace ripple
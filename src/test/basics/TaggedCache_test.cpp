@@ -21,6 +21,7 @@
 #include <ripple/basics/chrono.h>
 #include <ripple/beast/clock/manual_clock.h>
 #include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
 #include <ripple/protocol/Protocol.h>
 #include <test/unit_test/SuiteJournal.h>
 
@@ -38,6 +39,63 @@ original object.
 
 class TaggedCache_test : public beast::unit_test::suite
 {
+    // Looks up digest keys through caches with each hasher, and reports
+    // how long the lookups take.
+    template <class Hash>
+    void
+    lookupDigests(
+        char const* name,
+        std::vector<uint256> const& keys,
+        TestStopwatch& clock,
+        beast::Journal journal)
+    {
+        using namespace std::chrono;
+
+        TaggedCache<uint256, int, false, Hash> c(
+            "test", 0, 1s, clock, journal);
+        for (auto const& key : keys)
+        {
+            auto p = std::make_shared<int>(0);
+            c.canonicalize_replace_client(key, p);
+        }
+        BEAST_EXPECT(c.getCacheSize() == keys.size());
+
+        std::size_t found = 0;
+        auto const start = steady_clock::now();
+        for (int pass = 0; pass < 10; ++pass)
+        {
+            for (auto const& key : keys)
+                found += c.fetch(key) != nullptr;
+        }
+        auto const elapsed = steady_clock::now() - start;
+        BEAST_EXPECT(found == 10 * keys.size());
+
+        log << name << ": " << 10 * keys.size() << " lookups in "
+            << duration_cast<milliseconds>(elapsed).count() << "ms"
+            << std::endl;
+    }
+
+    void
+    testDigestKeys()
+    {
+        testcase("digest keys");
+        test::SuiteJournal journal("TaggedCache_test", *this);
+
+        TestStopwatch clock;
+        clock.set(0);
+
+        beast::xor_shift_engine gen(19);
+        std::vector<uint256> keys(100000);
+        for (auto& key : keys)
+        {
+            for (auto& b : key)
+                b = static_cast<std::uint8_t>(gen());
+        }
+
+        lookupDigests<hardened_hash<>>("hardened_hash", keys, clock, journal);
+        lookupDigests<digest_hash>("digest_hash", keys, clock, journal);
+    }
+
 public:
     void
     run() override
@@ -148,6 +206,25 @@ public:
             BEAST_EXPECT(c.getCacheSize() == 0);
             BEAST_EXPECT(c.getTrackSize() == 0);
         }
+
+        // Sweep a partition at a time, and make sure every expired item is
+        // gone once a whole pass has been made.
+        {
+            for (Key i = 0; i < 100; ++i)
+                BEAST_EXPECT(!c.insert(i, std::to_string(i)));
+            BEAST_EXPECT(c.getCacheSize() == 100);
+
+            ++clock;
+            BEAST_EXPECT(!c.sweepPartitions(0));
+            BEAST_EXPECT(c.getCacheSize() == 100);
+
+            while (!c.sweepPartitions(1))
+                BEAST_EXPECT(c.getTrackSize() > 0);
+            BEAST_EXPECT(c.getCacheSize() == 0);
+            BEAST_EXPECT(c.getTrackSize() == 0);
+        }
+
+        testDigestKeys();
     }
 };
 
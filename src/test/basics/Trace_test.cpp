@@ -0,0 +1,175 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/Trace.h>
+#include <ripple/beast/unit_test.h>
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+
+class Trace_test : public beast::unit_test::suite
+{
+    // Returns the complete events with the given name.
+    static std::vector<Json::Value>
+    spansNamed(Json::Value const& exported, std::string const& name)
+    {
+        std::vector<Json::Value> result;
+        for (auto const& e : exported["traceEvents"])
+        {
+            if (e["ph"] == "X" && e["name"] == name)
+                result.push_back(e);
+        }
+        return result;
+    }
+
+    void
+    testDisabled()
+    {
+        testcase("disabled");
+
+        trace::enable(false);
+        BEAST_EXPECT(!trace::enabled());
+        {
+            trace::Span span("Trace_test::disabled");
+        }
+        BEAST_EXPECT(
+            spansNamed(trace::getChromeTrace(), "Trace_test::disabled")
+                .empty());
+    }
+
+    void
+    testRecord()
+    {
+        testcase("record");
+
+        trace::enable(true);
+        BEAST_EXPECT(trace::enabled() == (RIPPLE_TRACING != 0));
+
+        uint256 const hash{
+            "0123456789ABCDEF0123456789ABCDEF"
+            "0123456789ABCDEF0123456789ABCDEF"};
+        BEAST_EXPECT(trace::idOf(hash) == 0x0123456789ABCDEFull);
+        {
+            trace::Span outer("Trace_test::outer", trace::idOf(hash));
+            trace::Span inner("Trace_test::inner");
+        }
+        trace::enable(false);
+
+        auto const exported = trace::getChromeTrace();
+        BEAST_EXPECT(exported["traceEvents"].isArray());
+        auto const outer = spansNamed(exported, "Trace_test::outer");
+        auto const inner = spansNamed(exported, "Trace_test::inner");
+        if (RIPPLE_TRACING == 0)
+        {
+            BEAST_EXPECT(outer.empty() && inner.empty());
+            return;
+        }
+        if (!BEAST_EXPECT(outer.size() == 1 && inner.size() == 1))
+            return;
+
+        BEAST_EXPECT(outer[0]["args"]["id"] == "0123456789ABCDEF");
+        BEAST_EXPECT(!inner[0]["args"].isMember("id"));
+        BEAST_EXPECT(outer[0]["tid"] == inner[0]["tid"]);
+
+        // The inner span lies within the outer one.
+        auto const o = outer[0]["ts"].asDouble();
+        auto const i = inner[0]["ts"].asDouble();
+        BEAST_EXPECT(o <= i);
+        BEAST_EXPECT(
+            i + inner[0]["dur"].asDouble() <=
+            o + outer[0]["dur"].asDouble());
+
+        trace::clear();
+        BEAST_EXPECT(
+            spansNamed(trace::getChromeTrace(), "Trace_test::outer").empty());
+    }
+
+    void
+    testThreads()
+    {
+        if (RIPPLE_TRACING == 0)
+            return;
+
+        testcase("threads");
+
+        // Each thread records into its own ring, which keeps only the
+        // most recent spans.
+        constexpr std::size_t threads = 4;
+        constexpr std::size_t spans = trace::ringSize + 100;
+
+        trace::enable(true);
+        std::vector<std::thread> workers;
+        // Keep the threads, and so their rings, alive until exported.
+        std::atomic<bool> done{false};
+        std::atomic<std::size_t> finished{0};
+        for (std::size_t t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&] {
+                for (std::size_t i = 0; i < spans; ++i)
+                    trace::Span span("Trace_test::thread", i + 1);
+                ++finished;
+                while (!done)
+                    std::this_thread::yield();
+            });
+        }
+        while (finished != threads)
+            std::this_thread::yield();
+        trace::enable(false);
+
+        auto const exported = trace::getChromeTrace();
+        done = true;
+        for (auto& w : workers)
+            w.join();
+
+        auto const events = spansNamed(exported, "Trace_test::thread");
+        BEAST_EXPECT(events.size() == threads * trace::ringSize);
+
+        std::set<unsigned> tids;
+        for (auto const& e : events)
+            tids.insert(e["tid"].asUInt());
+        BEAST_EXPECT(tids.size() == threads);
+
+        // The oldest spans were overwritten.
+        BEAST_EXPECT(std::none_of(events.begin(), events.end(), [](auto& e) {
+            return e["args"]["id"] == "0000000000000001";
+        }));
+
+        // Spans of threads which have exited are gone.
+        BEAST_EXPECT(
+            spansNamed(trace::getChromeTrace(), "Trace_test::thread").empty());
+        trace::clear();
+    }
+
+public:
+    void
+    run() override
+    {
+        testDisabled();
+        testRecord();
+        testThreads();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(Trace, basics, ripple);
+
+}  // namespace ripple
@@ -27,10 +27,12 @@
 #include <boost/random.hpp>
 
 #include <array>
+#include <chrono>
 #include <cstddef>
 #include <random>
 #include <span>
 #include <sstream>
+#include <vector>
 
 namespace ripple {
 namespace test {
@@ -424,16 +426,126 @@ class base58_test : public beast::unit_test::suite
         }
     }
 
+    void
+    testBatch()
+    {
+        testcase("batch");
+
+        constexpr std::size_t count = 100;
+        constexpr std::size_t size = 20;
+
+        std::vector<std::uint8_t> input(count * size);
+        for (auto& b : input)
+            b = randEngine()();
+
+        // Some tokens with leading zeros
+        std::fill_n(input.begin(), 2 * size, 0);
+
+        std::vector<std::uint8_t> out(count * 64);
+        std::vector<std::size_t> ends(count);
+        auto const r = b58_fast::encodeBase58Tokens(
+            TokenType::AccountID, size, input, out, ends);
+        if (!BEAST_EXPECT(r))
+            return;
+
+        std::size_t begin = 0;
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            std::string const batch(
+                reinterpret_cast<char const*>(out.data()) + begin,
+                ends[i] - begin);
+            BEAST_EXPECT(
+                batch ==
+                b58_ref::encodeBase58Token(
+                    TokenType::AccountID, input.data() + i * size, size));
+            begin = ends[i];
+        }
+        BEAST_EXPECT(r.value().size() == begin);
+
+        // Partial tokens and too little room for the offsets are errors
+        BEAST_EXPECT(!b58_fast::encodeBase58Tokens(
+            TokenType::AccountID,
+            size,
+            std::span(input.data(), size + 1),
+            out,
+            ends));
+        BEAST_EXPECT(!b58_fast::encodeBase58Tokens(
+            TokenType::AccountID,
+            size,
+            input,
+            out,
+            std::span(ends.data(), count - 1)));
+    }
+
     void
     run() override
     {
         testMultiprecision();
         testFastMatchesRef();
+        testBatch();
     }
 };
 
 BEAST_DEFINE_TESTSUITE(base58, ripple_basics, ripple);
 
+/** Compares the cost of the base58 token encoders. */
+class base58_bench_test : public beast::unit_test::suite
+{
+    template <class F>
+    double
+    nsPerToken(std::size_t count, F&& f)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double, std::nano> const elapsed =
+            std::chrono::steady_clock::now() - start;
+        return elapsed.count() / count;
+    }
+
+public:
+    void
+    run() override
+    {
+        constexpr std::size_t count = 200000;
+        constexpr std::size_t size = 20;
+
+        std::vector<std::uint8_t> input(count * size);
+        for (auto& b : input)
+            b = randEngine()();
+
+        std::size_t total = 0;
+
+        auto const ref = nsPerToken(count, [&]() {
+            for (std::size_t i = 0; i != count; ++i)
+                total += b58_ref::encodeBase58Token(
+                             TokenType::AccountID, &input[i * size], size)
+                             .size();
+        });
+
+        auto const fast = nsPerToken(count, [&]() {
+            for (std::size_t i = 0; i != count; ++i)
+                total += b58_fast::encodeBase58Token(
+                             TokenType::AccountID, &input[i * size], size)
+                             .size();
+        });
+
+        std::vector<std::uint8_t> out(count * 64);
+        std::vector<std::size_t> ends(count);
+        auto const batch = nsPerToken(count, [&]() {
+            if (auto const r = b58_fast::encodeBase58Tokens(
+                    TokenType::AccountID, size, input, out, ends))
+                total += r.value().size();
+        });
+
+        log << "AccountID encoding, ns per token: ref " << ref << ", fast "
+            << fast << ", batch " << batch << " (" << total << ")"
+            << std::endl;
+        pass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(base58_bench, ripple_basics, ripple);
+
 }  // namespace test
 }  // namespace ripple
 #endif  // _MSC_VER
@@ -17,8 +17,10 @@
 */
 //==============================================================================
 
+#include <ripple/basics/base_uint.h>
 #include <ripple/basics/hardened_hash.h>
 #include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
 #include <boost/functional/hash.hpp>
 #include <array>
 #include <cstdint>
@@ -246,11 +248,54 @@ public:
         check_container<detail::test_hardened_unordered_multimap>();
     }
 
+    void
+    test_digest_hash()
+    {
+        testcase("digest hash");
+
+        BEAST_EXPECT(detail::fold_multiply(3, 5) == 15);
+        BEAST_EXPECT(detail::fold_multiply(1ull << 32, 1ull << 32) == 1);
+        BEAST_EXPECT(
+            detail::fold_multiply(~0ull, ~0ull) == ((~0ull - 1) ^ 1));
+
+        beast::xor_shift_engine gen(5);
+        auto const randomKey = [&gen]() {
+            uint256 key;
+            for (auto& b : key)
+                b = static_cast<std::uint8_t>(gen());
+            return key;
+        };
+
+        digest_hash const h1;
+        digest_hash const h2;
+        auto const key = randomKey();
+        BEAST_EXPECT(h1(key) == h1(key));
+        BEAST_EXPECT(h1(key) != h2(key));
+
+        // Keys differing in any one word hash differently
+        for (int word = 0; word < 4; ++word)
+        {
+            auto other = key;
+            other.data()[word * 8] ^= 1;
+            BEAST_EXPECT(h1(other) != h1(key));
+        }
+
+        // Digests spread evenly over buckets
+        std::array<int, 64> buckets{};
+        for (int i = 0; i < 64 * 1024; ++i)
+            ++buckets[h1(randomKey()) % buckets.size()];
+        BEAST_EXPECT(std::all_of(
+            buckets.begin(), buckets.end(), [](int n) {
+                return n > 768 && n < 1280;
+            }));
+    }
+
     void
     run() override
     {
         test_user_types();
         test_containers();
+        test_digest_hash();
     }
 };
 
@@ -1449,6 +1449,29 @@ aged_associative_container_test_base::testChronological()
         v.cend(),
         equal_value<Traits>()));
 
+    // Test refresh() leaves elements that are already current in place
+    for (auto iter(v.crbegin()); iter != v.crend(); ++iter)
+        c.refresh(c.find(Traits::extract(*iter)));
+
+    BEAST_EXPECT(std::equal(
+        c.chronological.cbegin(),
+        c.chronological.cend(),
+        v.cbegin(),
+        v.cend(),
+        equal_value<Traits>()));
+
+    // ...and moves the others to the end
+    ++clock;
+    c.refresh(c.find(Traits::extract(v.front())));
+
+    BEAST_EXPECT(std::equal(
+        c.chronological.cbegin(),
+        std::prev(c.chronological.cend()),
+        std::next(v.cbegin()),
+        v.cend(),
+        equal_value<Traits>()));
+    BEAST_EXPECT(std::prev(c.chronological.cend()).when() == clock.now());
+
     {
         // Because touch (reverse_iterator pos) is not allowed, the following
         // lines should not compile for any aged_container type.
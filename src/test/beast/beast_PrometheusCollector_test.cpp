@@ -0,0 +1,155 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of Beast: https://github.com/vinniefalco/Beast
+    Copyright 2013, Vinnie Falco <vinnie.falco@gmail.com>
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/insight/Insight.h>
+#include <ripple/beast/unit_test.h>
+#include <boost/asio/connect.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+
+namespace beast {
+namespace insight {
+
+class PrometheusCollector_test : public unit_test::suite
+{
+    static std::shared_ptr<PrometheusCollector>
+    make_collector()
+    {
+        return PrometheusCollector::New(
+            IP::Endpoint::from_string("127.0.0.1:0"),
+            "rippled",
+            Journal{Journal::getNullSink()});
+    }
+
+    static bool
+    contains(std::string const& text, std::string const& line)
+    {
+        return text.find(line + "\n") != std::string::npos;
+    }
+
+    void
+    testRender()
+    {
+        testcase("render");
+
+        auto const collector = make_collector();
+
+        auto counter = collector->make_counter("peer.disconnects");
+        counter.increment(3);
+        counter.increment(4);
+
+        auto gauge = collector->make_gauge("jobq", "job_count");
+        gauge.set(5);
+        gauge.increment(-7);
+        auto meter = collector->make_meter("overlay.traffic");
+        meter.increment(10);
+
+        // Events with the same name are reported together
+        auto event1 = collector->make_event("jobq.ledgerData");
+        auto event2 = collector->make_event("jobq.ledgerData");
+        event1.notify(std::chrono::milliseconds(3));
+        event1.notify(std::chrono::milliseconds(20000));
+        event2.notify(std::chrono::milliseconds(1));
+
+        int scrapes = 0;
+        auto hooked = collector->make_gauge("scrapes");
+        auto const hook = collector->make_hook([&] { hooked.set(++scrapes); });
+
+        auto const text = collector->render();
+        BEAST_EXPECT(scrapes == 1);
+        BEAST_EXPECT(contains(text, "# TYPE rippled_peer_disconnects counter"));
+        BEAST_EXPECT(contains(text, "rippled_peer_disconnects_total 7"));
+        BEAST_EXPECT(contains(text, "# TYPE rippled_jobq_job_count gauge"));
+        BEAST_EXPECT(contains(text, "rippled_jobq_job_count 0"));
+        BEAST_EXPECT(contains(text, "rippled_overlay_traffic_total 10"));
+        BEAST_EXPECT(contains(text, "rippled_scrapes 1"));
+        BEAST_EXPECT(
+            contains(text, "# TYPE rippled_jobq_ledgerData histogram"));
+        BEAST_EXPECT(
+            contains(text, "rippled_jobq_ledgerData_bucket{le=\"1\"} 1"));
+        BEAST_EXPECT(
+            contains(text, "rippled_jobq_ledgerData_bucket{le=\"5\"} 2"));
+        BEAST_EXPECT(
+            contains(text, "rippled_jobq_ledgerData_bucket{le=\"10000\"} 2"));
+        BEAST_EXPECT(
+            contains(text, "rippled_jobq_ledgerData_bucket{le=\"+Inf\"} 3"));
+        BEAST_EXPECT(contains(text, "rippled_jobq_ledgerData_count 3"));
+        BEAST_EXPECT(contains(text, "rippled_jobq_ledgerData_sum 20004"));
+        BEAST_EXPECT(text.ends_with("# EOF\n"));
+
+        // Each family is described once
+        auto const first = text.find("# TYPE rippled_jobq_ledgerData ");
+        BEAST_EXPECT(
+            text.find("# TYPE rippled_jobq_ledgerData ", first + 1) ==
+            std::string::npos);
+    }
+
+    void
+    testScrape()
+    {
+        testcase("scrape");
+
+        auto const collector = make_collector();
+        auto counter = collector->make_counter("ledgers");
+        counter.increment(2);
+
+        auto const port = collector->local_endpoint().port();
+        BEAST_EXPECT(port != 0);
+
+        boost::asio::io_service io;
+        boost::asio::ip::tcp::socket socket(io);
+        socket.connect(boost::asio::ip::tcp::endpoint(
+            boost::asio::ip::address_v4::loopback(), port));
+
+        // Two requests on one connection
+        std::string const request =
+            "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n"
+            "GET /other HTTP/1.1\r\nHost: localhost\r\n"
+            "Connection: close\r\n\r\n";
+        boost::asio::write(socket, boost::asio::buffer(request));
+
+        std::string response;
+        boost::system::error_code ec;
+        boost::asio::read(socket, boost::asio::dynamic_buffer(response), ec);
+        BEAST_EXPECT(ec == boost::asio::error::eof);
+
+        BEAST_EXPECT(response.starts_with("HTTP/1.1 200 OK\r\n"));
+        BEAST_EXPECT(
+            response.find("Content-Type: application/openmetrics-text") !=
+            std::string::npos);
+        BEAST_EXPECT(contains(response, "rippled_ledgers_total 2"));
+        BEAST_EXPECT(
+            response.find("HTTP/1.1 404 Not Found\r\n") != std::string::npos);
+    }
+
+public:
+    void
+    run() override
+    {
+        testRender();
+        testScrape();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(PrometheusCollector, insight, beast);
+
+}  // namespace insight
+}  // namespace beast
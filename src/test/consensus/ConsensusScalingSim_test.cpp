@@ -0,0 +1,293 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012-2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+#include <ripple/beast/unit_test.h>
+#include <test/csf.h>
+#include <test/csf/random.h>
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+/** Measures how consensus scales with the network it runs on.
+
+    Runs one simulation for every combination of the swept parameters and
+    writes a CSV row for each with ledger close intervals, consensus round
+    durations and transaction latencies. Parameters are passed as
+    space separated key=value pairs, where the value is a comma separated
+    list to sweep over:
+
+        validators  Number of validators
+        delay       Minimum one-way link delay, in milliseconds
+        jitter      Extra link delay drawn uniformly from [0, jitter] ms
+        rate        Transactions submitted per second, at least one
+        overlap     Fraction of validators shared by the two UNLs; 1 means
+                    everyone trusts everyone
+        duration    Simulated seconds per run
+        min_consensus, min_close
+                    ConsensusParms::ledgerMIN_CONSENSUS and ledgerMIN_CLOSE,
+                    in milliseconds
+        csv         File to append rows to instead of the log
+
+    For example:
+
+        rippled --unittest=ConsensusScaling \
+            --unittest-arg="validators=5,20,35 delay=50 jitter=0,200"
+*/
+class ConsensusScaling_test : public beast::unit_test::suite
+{
+    using Sweep = std::map<std::string, std::vector<std::string>>;
+
+    struct Params
+    {
+        std::size_t validators;
+        std::chrono::milliseconds delay;
+        std::chrono::milliseconds jitter;
+        std::size_t rate;
+        double overlap;
+        std::chrono::seconds duration;
+        ConsensusParms parms;
+    };
+
+    static Sweep
+    parse(std::string const& args)
+    {
+        Sweep sweep{
+            {"validators", {"5", "10", "20"}},
+            {"delay", {"50"}},
+            {"jitter", {"0"}},
+            {"rate", {"10"}},
+            {"overlap", {"1"}},
+            {"duration", {"300"}},
+            {"min_consensus",
+             {std::to_string(ConsensusParms{}.ledgerMIN_CONSENSUS.count())}},
+            {"min_close",
+             {std::to_string(ConsensusParms{}.ledgerMIN_CLOSE.count())}}};
+
+        std::vector<std::string> pairs;
+        boost::split(pairs, args, boost::algorithm::is_space());
+
+        for (auto const& pair : pairs)
+        {
+            auto const eq = pair.find('=');
+            if (eq == std::string::npos)
+                continue;
+
+            auto& values = sweep[pair.substr(0, eq)];
+            values.clear();
+            boost::split(
+                values, pair.substr(eq + 1), boost::algorithm::is_any_of(","));
+        }
+
+        return sweep;
+    }
+
+    template <class T>
+    static std::vector<T>
+    values(Sweep const& sweep, std::string const& key)
+    {
+        std::vector<T> ret;
+        for (auto const& v : sweep.at(key))
+        {
+            if constexpr (std::is_floating_point_v<T>)
+                ret.push_back(std::stod(v));
+            else
+                ret.push_back(std::stoull(v));
+        }
+        return ret;
+    }
+
+    template <class Out>
+    void
+    simulate(Params const& p, Out& out)
+    {
+        using namespace csf;
+        using namespace std::chrono;
+
+        Sim sim;
+        PeerGroup peers = sim.createGroup(p.validators);
+
+        for (Peer* peer : peers)
+            peer->consensusParms = p.parms;
+
+        // Two UNLs sharing the given fraction of the validators. The first
+        // half of the validators trusts the first, the rest the second.
+        auto const overlap = std::clamp(p.overlap, 0.0, 1.0);
+        auto const unlSize = std::min<std::size_t>(
+            p.validators, std::ceil(p.validators * (1 + overlap) / 2));
+        PeerGroup const unlA{
+            std::vector<Peer*>(peers.begin(), peers.begin() + unlSize)};
+        PeerGroup const unlB{
+            std::vector<Peer*>(peers.end() - unlSize, peers.end())};
+
+        for (std::size_t i = 0; i < p.validators; ++i)
+        {
+            PeerGroup self{peers[i]};
+            self.trust(i < p.validators / 2 ? unlA : unlB);
+        }
+
+        // Fully connected, with each link's delay drawn independently
+        std::uniform_int_distribution<milliseconds::rep> jitter{
+            0, p.jitter.count()};
+        for (std::size_t i = 0; i < p.validators; ++i)
+        {
+            for (std::size_t j = i + 1; j < p.validators; ++j)
+                peers[i]->connect(
+                    *peers[j], p.delay + milliseconds{jitter(sim.rng)});
+        }
+
+        TxCollector txCollector;
+        LedgerCollector ledgerCollector;
+        RoundCollector roundCollector;
+        auto colls =
+            makeCollectors(txCollector, ledgerCollector, roundCollector);
+        sim.collectors.add(colls);
+
+        // Initial round to set prior state
+        sim.run(1);
+
+        nanoseconds const simDuration = p.duration;
+        nanoseconds const quiet = std::min<nanoseconds>(10s, simDuration / 10);
+
+        auto peerSelector = makeSelector(
+            peers.begin(),
+            peers.end(),
+            std::vector<double>(p.validators, 1.),
+            sim.rng);
+        auto txSubmitter = makeSubmitter(
+            ConstantDistribution{Rate{p.rate, 1000ms}.inv()},
+            sim.scheduler.now() + quiet,
+            sim.scheduler.now() + simDuration - quiet,
+            peerSelector,
+            sim.scheduler,
+            sim.rng);
+
+        sim.run(simDuration);
+
+        auto const ms = [](SimDuration d) {
+            return duration_cast<duration<double, std::milli>>(d).count();
+        };
+
+        auto const& intervals = ledgerCollector.acceptToAccept;
+        auto const& rounds = roundCollector.roundDuration;
+
+        out << p.validators << "," << p.delay.count() << ","
+            << p.jitter.count() << "," << p.rate << "," << p.overlap << ","
+            << p.parms.ledgerMIN_CONSENSUS.count() << ","
+            << p.parms.ledgerMIN_CLOSE.count() << ","
+            << p.duration.count() << "," << sim.branches() << ","
+            << (sim.synchronized() ? 1 : 0) << ","
+            << ledgerCollector.accepted << ","
+            << ledgerCollector.fullyValidated << ","
+            << ms(intervals.percentile(0.1f)) << ","
+            << ms(intervals.percentile(0.5f)) << ","
+            << ms(intervals.percentile(0.9f)) << ","
+            << ms(intervals.maxValue()) << ","
+            << double(roundCollector.completed) / p.validators << ","
+            << roundCollector.wrongPrevLedger << ","
+            << ms(rounds.percentile(0.5f)) << ","
+            << ms(rounds.percentile(0.9f)) << ","
+            << ms(roundCollector.closeToAccept.percentile(0.5f)) << ","
+            << txCollector.submitted << "," << txCollector.validated << ","
+            << ms(txCollector.submitToValidate.percentile(0.5f)) << ","
+            << ms(txCollector.submitToValidate.percentile(0.9f)) << std::endl;
+    }
+
+public:
+    void
+    run() override
+    {
+        using namespace std::chrono;
+
+        auto const sweep = parse(arg());
+
+        std::ofstream file;
+        if (auto const it = sweep.find("csv");
+            it != sweep.end() && !it->second.empty())
+            file.open(it->second.front(), std::ofstream::app);
+
+        auto run = [&](auto& out) {
+            out << "validators,delay_ms,jitter_ms,tx_per_sec,unl_overlap,"
+                   "min_consensus_ms,min_close_ms,duration_s,branches,"
+                   "synchronized,ledgers_accepted,ledgers_validated,"
+                   "close_interval_p10_ms,close_interval_p50_ms,"
+                   "close_interval_p90_ms,close_interval_max_ms,"
+                   "rounds_per_validator,wrong_prev_ledger,round_p50_ms,"
+                   "round_p90_ms,close_to_accept_p50_ms,tx_submitted,"
+                   "tx_validated,tx_validate_p50_ms,tx_validate_p90_ms"
+                << std::endl;
+
+            auto const ns = values<std::size_t>(sweep, "validators");
+            auto const delays = values<std::size_t>(sweep, "delay");
+            auto const jitters = values<std::size_t>(sweep, "jitter");
+            auto const rates = values<std::size_t>(sweep, "rate");
+            auto const overlaps = values<double>(sweep, "overlap");
+            auto const durations = values<std::size_t>(sweep, "duration");
+            auto const minCons = values<std::size_t>(sweep, "min_consensus");
+            auto const minCloses = values<std::size_t>(sweep, "min_close");
+
+            // Walk every combination, varying the last parameter fastest
+            std::size_t const combinations = ns.size() * delays.size() *
+                jitters.size() * rates.size() * overlaps.size() *
+                durations.size() * minCons.size() * minCloses.size();
+
+            for (std::size_t i = 0; i < combinations; ++i)
+            {
+                std::size_t rest = i;
+                auto next = [&rest](auto const& v) {
+                    auto const& ret = v[rest % v.size()];
+                    rest /= v.size();
+                    return ret;
+                };
+
+                Params p;
+                p.parms = ConsensusParms{};
+                p.parms.ledgerMIN_CLOSE = milliseconds(next(minCloses));
+                p.parms.ledgerMIN_CONSENSUS = milliseconds(next(minCons));
+                p.duration = seconds(std::max<std::size_t>(next(durations), 1));
+                p.overlap = next(overlaps);
+                p.rate = std::max<std::size_t>(next(rates), 1);
+                p.jitter = milliseconds(next(jitters));
+                p.delay = milliseconds(next(delays));
+                p.validators = std::max<std::size_t>(next(ns), 1);
+
+                simulate(p, out);
+            }
+        };
+
+        if (file.is_open())
+            run(file);
+        else
+            run(log);
+
+        pass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(ConsensusScaling, consensus, ripple);
+
+}  // namespace test
+}  // namespace ripple
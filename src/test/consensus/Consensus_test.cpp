@@ -172,6 +172,8 @@ public:
                 // All transactions were accepted
                 for (std::uint32_t i = 0; i < peers.size(); ++i)
                     BEAST_EXPECT(lcl.txs().find(Tx{i}) != lcl.txs().end());
+                // The accepted set was seen to be stable first
+                BEAST_EXPECT(peer->stablePosition == TxSet{lcl.txs()}.id());
             }
         }
     }
@@ -1047,6 +1049,86 @@ public:
         BEAST_EXPECT(sim.synchronized());
     }
 
+    // Records the ledgers accepted by a peer
+    struct AcceptCollector
+    {
+        std::vector<csf::Ledger> accepted;
+
+        template <class E>
+        void
+        on(csf::PeerID, csf::SimTime, E const&)
+        {
+        }
+
+        void
+        on(csf::PeerID, csf::SimTime, csf::AcceptLedger const& e)
+        {
+            accepted.push_back(e.ledger);
+        }
+    };
+
+    void
+    testPeerChangedOnWrongLCL()
+    {
+        using namespace csf;
+        using namespace std::chrono;
+        testcase("peer changed on wrong LCL");
+
+        // Proposals from peers re-evaluate the establish phase between
+        // timer calls. That must not accept a round while the network has
+        // validated a different prior ledger.
+        //
+        // Nodes 0-1 trust nodes 0-4 and nodes 2-9 trust nodes 2-9. Nodes
+        // 0-4 see tx 0 and nodes 5-9 see tx 1, so nodes 0-1 build the wrong
+        // ledger. The timer of nodes 0-1 is slowed, so in the next round
+        // they learn of the right ledger from validations, and then see a
+        // proposal from each other, before their timer next runs. They must
+        // switch to the network's ledger without accepting a round on top
+        // of their own.
+
+        ConsensusParms const parms{};
+
+        Sim sim;
+        PeerGroup minority = sim.createGroup(2);
+        PeerGroup majorityA = sim.createGroup(3);
+        PeerGroup majorityB = sim.createGroup(5);
+        PeerGroup majority = majorityA + majorityB;
+        PeerGroup network = minority + majority;
+
+        SimDuration const delay =
+            round<milliseconds>(0.2 * parms.ledgerGRANULARITY);
+        minority.trustAndConnect(minority + majorityA, delay);
+        majority.trustAndConnect(majority, delay);
+
+        CollectByNode<AcceptCollector> accepts;
+        sim.collectors.add(accepts);
+
+        // initial round to set prior state
+        sim.run(1);
+
+        for (Peer* peer : (minority + majorityA))
+            peer->openTxs.insert(Tx{0});
+        for (Peer* peer : majorityB)
+            peer->openTxs.insert(Tx{1});
+        for (Peer* peer : minority)
+            peer->consensusParms.ledgerGRANULARITY = 2s;
+
+        sim.run(3);
+
+        Ledger const& last = majority[0]->lastClosedLedger;
+        for (Peer const* peer : minority)
+        {
+            auto const& accepted = accepts[peer->id].accepted;
+            auto const wrong = std::count_if(
+                accepted.begin(), accepted.end(), [&](Ledger const& l) {
+                    return !last.isAncestor(l) && l.id() != last.id();
+                });
+            BEAST_EXPECT(wrong == 0);
+            BEAST_EXPECT(peer->lastClosedLedger.id() == last.id());
+        }
+        BEAST_EXPECT(sim.synchronized(network));
+    }
+
     void
     run() override
     {
@@ -1063,6 +1145,7 @@ public:
         testHubNetwork();
         testPreferredByBranch();
         testPauseForLaggards();
+        testPeerChangedOnWrongLCL();
     }
 };
 
@@ -661,6 +661,14 @@ class LedgerTrie_test : public beast::unit_test::suite
                 t.remove(h[curr]);
             if (!BEAST_EXPECT(t.checkInvariants()))
                 return;
+
+            // Finding the preferred ledger must not disturb the trie
+            auto const preferred =
+                t.getPreferred(Ledger::Seq(depthDist(gen)));
+            if (!BEAST_EXPECT(preferred || t.empty()))
+                return;
+            if (!BEAST_EXPECT(t.checkInvariants()))
+                return;
         }
     }
 
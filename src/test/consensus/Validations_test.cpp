@@ -755,6 +755,49 @@ class Validations_test : public beast::unit_test::suite
         BEAST_EXPECT(harness.vals().numTrustedForLedger(ledgerC.id()) == 0);
     }
 
+    void
+    testExpireAfterRead()
+    {
+        // Verify reading the trusted validations for a ledger keeps them
+        // from expiring, as if the read touched them
+        testcase("Expire validations after read");
+        SuiteJournal j("Validations_test", *this);
+        LedgerHistoryHelper h;
+        TestHarness harness(h.oracle);
+        Node const a = harness.makeNode();
+        Node const b = harness.makeNode();
+        auto const expires = harness.parms().validationSET_EXPIRES;
+
+        Ledger const ledgerA = h["a"];
+        BEAST_EXPECT(ValStatus::current == harness.add(a.validate(ledgerA)));
+        harness.clock().advance(expires / 2);
+        BEAST_EXPECT(harness.vals().numTrustedForLedger(ledgerA.id()) == 1);
+
+        // Still used, so it survives past its original expiration
+        harness.clock().advance(expires / 2);
+        harness.vals().expire(j);
+        BEAST_EXPECT(harness.vals().numTrustedForLedger(ledgerA.id()) == 1);
+
+        // Unused for a full expiration interval
+        harness.clock().advance(expires);
+        harness.vals().expire(j);
+        BEAST_EXPECT(harness.vals().numTrustedForLedger(ledgerA.id()) == 0);
+        BEAST_EXPECT(harness.vals().sizeOfByLedgerCache() == 0);
+
+        // A set that is replaced by a later validation keeps its read time
+        Ledger const ledgerB = h["b"];
+        BEAST_EXPECT(ValStatus::current == harness.add(a.validate(ledgerB)));
+        harness.clock().advance(expires / 2);
+        BEAST_EXPECT(harness.vals().numTrustedForLedger(ledgerB.id()) == 1);
+        BEAST_EXPECT(ValStatus::current == harness.add(b.partial(ledgerB)));
+        harness.clock().advance(expires / 2);
+        harness.vals().expire(j);
+        BEAST_EXPECT(harness.vals().numTrustedForLedger(ledgerB.id()) == 1);
+        BEAST_EXPECT(
+            harness.vals().getTrustedForLedger(ledgerB.id(), ledgerB.seq())
+                .size() == 1);
+    }
+
     void
     testFlush()
     {
@@ -1135,6 +1178,7 @@ class Validations_test : public beast::unit_test::suite
         testGetCurrentPublicKeys();
         testTrustedByLedgerFunctions();
         testExpire();
+        testExpireAfterRead();
         testFlush();
         testGetPreferredLedger();
         testGetPreferredLCL();
@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <ripple/basics/contract.h>
+#include <ripple/basics/Numa.h>
 #include <ripple/core/Config.h>
 #include <ripple/core/ConfigSections.h>
 #include <ripple/server/Port.h>
@@ -1279,6 +1280,96 @@ r.ripple.com:51235
         BEAST_EXPECT(!testDiverged("901"));
     }
 
+    void
+    testHistoryFetch()
+    {
+        testcase("history_fetch");
+
+        {
+            Config c;
+            c.loadFromString("");
+            BEAST_EXPECT(c.HISTORY_FETCH_SEGMENTS == 1);
+            BEAST_EXPECT(c.HISTORY_MAX_WRITE_LOAD == 8192);
+            BEAST_EXPECT(c.HISTORY_MAX_FETCH_RATE == 0);
+        }
+        {
+            Config c;
+            c.loadFromString(R"rippleConfig(
+[history_fetch]
+segments=4
+max_write_load=1024
+max_fetch_rate=60
+)rippleConfig");
+            BEAST_EXPECT(c.HISTORY_FETCH_SEGMENTS == 4);
+            BEAST_EXPECT(c.HISTORY_MAX_WRITE_LOAD == 1024);
+            BEAST_EXPECT(c.HISTORY_MAX_FETCH_RATE == 60);
+        }
+
+        auto invalid = [](std::string const& value) {
+            try
+            {
+                Config c;
+                c.loadFromString("[history_fetch]\n" + value);
+            }
+            catch (std::runtime_error&)
+            {
+                return true;
+            }
+            return false;
+        };
+        BEAST_EXPECT(invalid("segments=0"));
+        BEAST_EXPECT(invalid("segments=17"));
+        BEAST_EXPECT(invalid("max_write_load=0"));
+        BEAST_EXPECT(!invalid("segments=16"));
+    }
+
+    void
+    testNuma()
+    {
+        testcase("numa");
+
+        {
+            Config c;
+            c.loadFromString("");
+            BEAST_EXPECT(!c.NUMA_SPREAD);
+        }
+        {
+            Config c;
+            c.loadFromString("[numa]\nspread\n");
+            BEAST_EXPECT(c.NUMA_SPREAD);
+        }
+        {
+            Config c;
+            c.loadFromString("[numa]\noff\n");
+            BEAST_EXPECT(!c.NUMA_SPREAD);
+        }
+
+        auto invalid = [](std::string const& config) {
+            try
+            {
+                Config c;
+                c.loadFromString(config);
+            }
+            catch (std::runtime_error&)
+            {
+                return true;
+            }
+            return false;
+        };
+        BEAST_EXPECT(invalid("[numa]\non\n"));
+        BEAST_EXPECT(invalid("[io_pools]\noverlay_affinity=node\n"));
+        BEAST_EXPECT(invalid("[io_pools]\noverlay_affinity=node1024\n"));
+
+        // Every CPU of a node is named by it
+        auto const& nodes = numa::nodes();
+        if (!nodes.empty() && !nodes[0].empty())
+        {
+            Config c;
+            c.loadFromString("[io_pools]\noverlay_affinity=node0\n");
+            BEAST_EXPECT(c.OVERLAY_IO_AFFINITY == nodes[0]);
+        }
+    }
+
     void
     run() override
     {
@@ -1296,6 +1387,8 @@ r.ripple.com:51235
         testAmendment();
         testOverlay();
         testNetworkID();
+        testHistoryFetch();
+        testNuma();
     }
 };
 
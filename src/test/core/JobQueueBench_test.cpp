@@ -0,0 +1,396 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/Log.h>
+#include <ripple/basics/PerfLog.h>
+#include <ripple/beast/insight/NullCollector.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/core/JobQueue.h>
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace ripple {
+namespace test {
+
+/** Measures how quickly the JobQueue dispatches jobs.
+
+    For each mix of job types and each number of worker threads, two
+    producer threads add jobs which each spin for a few microseconds,
+    and the suite reports:
+
+        jobs/s          Jobs run per second.
+        p50, p99 us     Time from adding a job to it starting.
+        waits/kjob      Times per thousand jobs a thread waited for the
+                        JobQueue's lock, as logged through the PerfLog.
+        wait us         The average of those waits.
+
+    It follows each mix with the average queue wait of each job type at
+    the largest thread count, also as logged through the PerfLog. Then
+    for each thread count, it reports the coroutine yield and post cycles
+    run per second.
+
+    The argument is a list of options separated by ';':
+
+        threads=N,...   The worker thread counts (default 1,2,4,8).
+        jobs=N          Jobs added for each run (default 100000).
+        work=N          Microseconds each job spins (default 2).
+        cycles=N        Yields of each coroutine (default 2000).
+
+    For example:
+
+        --unittest=JobQueueBench --unittest-arg="threads=4,16;work=10"
+*/
+class JobQueueBench_test : public beast::unit_test::suite
+{
+    using clock_type = Job::clock_type;
+
+    struct Options
+    {
+        std::vector<int> threads = {1, 2, 4, 8};
+        std::size_t jobs = 100'000;
+        std::chrono::microseconds work{2};
+        int cycles = 2000;
+    };
+
+    // Records the waits the JobQueue logs, ignoring everything else.
+    class RecordingPerfLog : public perf::PerfLog
+    {
+    public:
+        std::atomic<std::uint64_t> lockWaits{0};
+        std::atomic<std::uint64_t> lockWaitUs{0};
+        std::array<std::atomic<std::uint64_t>, 64> started{};
+        std::array<std::atomic<std::uint64_t>, 64> queuedUs{};
+
+        void
+        rpcStart(std::string const&, std::uint64_t) override
+        {
+        }
+
+        void
+        rpcFinish(std::string const&, std::uint64_t) override
+        {
+        }
+
+        void
+        rpcError(std::string const&, std::uint64_t) override
+        {
+        }
+
+        void
+        jobQueue(JobType const) override
+        {
+        }
+
+        void
+        jobStart(
+            JobType const type,
+            microseconds dur,
+            steady_time_point,
+            int) override
+        {
+            ++started[type];
+            queuedUs[type] += dur.count();
+        }
+
+        void
+        jobFinish(JobType const, microseconds, int) override
+        {
+        }
+
+        void
+        dbReader(std::string const&, microseconds) override
+        {
+        }
+
+        void
+        jobQueueLock(microseconds wait) override
+        {
+            ++lockWaits;
+            lockWaitUs += wait.count();
+        }
+
+        Json::Value
+        countersJson() const override
+        {
+            return Json::Value();
+        }
+
+        Json::Value
+        currentJson() const override
+        {
+            return Json::Value();
+        }
+
+        Json::Value
+        latencyJson() const override
+        {
+            return Json::Value();
+        }
+
+        void
+        resizeJobs(int const) override
+        {
+        }
+
+        void
+        rotate() override
+        {
+        }
+    };
+
+    // Job types and how many of every hundred jobs have each
+    using Mix = std::vector<std::pair<JobType, int>>;
+
+    static Options
+    parse(std::string const& args)
+    {
+        Options options;
+        std::vector<std::string> entries;
+        boost::split(entries, args, boost::algorithm::is_any_of(";"));
+        for (auto const& entry : entries)
+        {
+            auto const eq = entry.find('=');
+            if (eq == std::string::npos)
+                continue;
+            auto const key = entry.substr(0, eq);
+            auto const value = entry.substr(eq + 1);
+            if (key == "threads")
+            {
+                std::vector<std::string> counts;
+                boost::split(counts, value, boost::algorithm::is_any_of(","));
+                options.threads.clear();
+                for (auto const& count : counts)
+                    options.threads.push_back(std::max(std::stoi(count), 1));
+            }
+            else if (key == "jobs")
+                options.jobs = std::stoul(value);
+            else if (key == "work")
+                options.work = std::chrono::microseconds(std::stoul(value));
+            else if (key == "cycles")
+                options.cycles = std::stoi(value);
+        }
+        return options;
+    }
+
+    static void
+    spin(std::chrono::microseconds work)
+    {
+        auto const until = clock_type::now() + work;
+        while (clock_type::now() < until)
+            ;
+    }
+
+    struct Result
+    {
+        double jobsPerSecond;
+        std::chrono::microseconds p50;
+        std::chrono::microseconds p99;
+    };
+
+    Result
+    runMix(
+        JobQueue& jq,
+        Mix const& mix,
+        Options const& options,
+        std::size_t producers)
+    {
+        // The type of each job, spread evenly through the run
+        std::vector<JobType> types;
+        types.reserve(100);
+        for (auto const& [type, weight] : mix)
+            types.insert(types.end(), weight, type);
+
+        std::vector<std::chrono::microseconds> latencies(options.jobs);
+        auto const work = options.work;
+
+        auto const start = clock_type::now();
+        {
+            std::vector<std::thread> threads;
+            for (std::size_t p = 0; p < producers; ++p)
+            {
+                threads.emplace_back([&, p]() {
+                    for (auto i = p; i < options.jobs; i += producers)
+                    {
+                        auto const added = clock_type::now();
+                        jq.addJob(
+                            types[(i * 37) % types.size()],
+                            "bench",
+                            [&latencies, i, added, work]() {
+                                latencies[i] = std::chrono::ceil<
+                                    std::chrono::microseconds>(
+                                    clock_type::now() - added);
+                                spin(work);
+                            });
+                    }
+                });
+            }
+            for (auto& t : threads)
+                t.join();
+        }
+        jq.rendezvous();
+        std::chrono::duration<double> const elapsed =
+            clock_type::now() - start;
+
+        std::sort(latencies.begin(), latencies.end());
+        auto const percentile = [&latencies](std::size_t p) {
+            return latencies[std::min(
+                latencies.size() - 1, latencies.size() * p / 100)];
+        };
+        return {options.jobs / elapsed.count(), percentile(50), percentile(99)};
+    }
+
+    // Coroutines which yield repeatedly, each posted again by one thread
+    // as soon as it has yielded, as RPC handlers waiting on events are.
+    double
+    runCoros(JobQueue& jq, int count, int cycles)
+    {
+        std::vector<std::shared_ptr<JobQueue::Coro>> coros;
+        auto const start = clock_type::now();
+        for (int i = 0; i < count; ++i)
+        {
+            coros.push_back(jq.postCoro(
+                jtCLIENT,
+                "benchCoro",
+                [cycles](std::shared_ptr<JobQueue::Coro> const& coro) {
+                    for (int n = 0; n < cycles; ++n)
+                        coro->yield();
+                }));
+        }
+        std::size_t failed = 0;
+        for (int n = 0; n < cycles; ++n)
+        {
+            for (auto const& coro : coros)
+            {
+                coro->join();
+                failed += !coro->post();
+            }
+        }
+        jq.rendezvous();
+        BEAST_EXPECT(failed == 0);
+        std::chrono::duration<double> const elapsed =
+            clock_type::now() - start;
+        return count * cycles / elapsed.count();
+    }
+
+public:
+    void
+    run() override
+    {
+        testcase("JobQueueBench");
+
+        auto const options = parse(arg());
+        std::vector<std::pair<std::string, Mix>> const mixes = {
+            {"client", {{jtCLIENT, 100}}},
+            {"server",
+             {{jtTRANSACTION, 40},
+              {jtCLIENT_RPC, 15},
+              {jtPROPOSAL_t, 10},
+              {jtVALIDATION_t, 10},
+              {jtVALIDATION_ut, 10},
+              {jtLEDGER_DATA, 10},
+              {jtWRITE, 5}}}};
+
+        Logs logs(beast::severities::kError);
+        auto const collector = beast::insight::NullCollector::New();
+        log << options.jobs << " jobs per run, " << options.work.count()
+            << " us each" << std::endl;
+
+        using std::setw;
+        for (auto const& [name, mix] : mixes)
+        {
+            std::stringstream ss;
+            ss << std::left << setw(10) << name << std::right << setw(8)
+               << "Threads" << setw(12) << "jobs/s" << setw(10) << "p50 us"
+               << setw(10) << "p99 us" << setw(12) << "waits/kjob"
+               << setw(10) << "wait us";
+            log << ss.str() << std::endl;
+
+            // Kept from the run with the most threads
+            std::unique_ptr<RecordingPerfLog> perfLog;
+            for (auto const threads : options.threads)
+            {
+                perfLog = std::make_unique<RecordingPerfLog>();
+                JobQueue jq(
+                    threads,
+                    collector,
+                    logs.journal("JobQueue"),
+                    logs,
+                    *perfLog);
+                auto const result = runMix(jq, mix, options, 2);
+                jq.stop();
+
+                auto const waits = perfLog->lockWaits.load();
+                ss.str({});
+                ss << std::left << setw(10) << "" << std::right << setw(8)
+                   << threads << setw(12)
+                   << static_cast<std::uint64_t>(result.jobsPerSecond)
+                   << setw(10) << result.p50.count() << setw(10)
+                   << result.p99.count() << std::fixed
+                   << std::setprecision(1) << setw(12)
+                   << waits * 1000.0 / std::max<std::size_t>(options.jobs, 1)
+                   << setw(10)
+                   << (waits ? double(perfLog->lockWaitUs.load()) / waits : 0);
+                log << ss.str() << std::endl;
+            }
+
+            if (!perfLog)
+                continue;
+            ss.str({});
+            ss << "  queue wait us:";
+            for (auto const& [type, weight] : mix)
+            {
+                auto const started = perfLog->started[type].load();
+                ss << " " << JobTypes::name(type) << " "
+                   << (started ? perfLog->queuedUs[type].load() / started : 0);
+            }
+            log << ss.str() << std::endl;
+        }
+
+        {
+            std::stringstream ss;
+            ss << std::left << setw(10) << "coroutine" << std::right
+               << setw(8) << "Threads" << setw(12) << "cycles/s";
+            log << ss.str() << std::endl;
+        }
+        for (auto const threads : options.threads)
+        {
+            RecordingPerfLog perfLog;
+            JobQueue jq(
+                threads, collector, logs.journal("JobQueue"), logs, perfLog);
+            auto const rate = runCoros(jq, threads * 4, options.cycles);
+            jq.stop();
+
+            std::stringstream ss;
+            ss << std::left << setw(10) << "" << std::right << setw(8)
+               << threads << setw(12) << static_cast<std::uint64_t>(rate);
+            log << ss.str() << std::endl;
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(JobQueueBench, core, ripple, 10);
+
+}  // namespace test
+}  // namespace ripple
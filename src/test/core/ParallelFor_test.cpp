@@ -0,0 +1,171 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/core/ParallelFor.h>
+#include <test/jtx/Env.h>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+class ParallelFor_test : public beast::unit_test::suite
+{
+    void
+    testAllIndexes(JobQueue& jobQueue)
+    {
+        testcase("all indexes");
+
+        for (std::size_t const count : {0, 1, 2, 100})
+        {
+            std::vector<std::atomic<int>> calls(count);
+            BEAST_EXPECT(parallelFor(
+                jobQueue,
+                jtPATH_UPDATE,
+                "ParallelForTest",
+                count,
+                4,
+                [&calls](std::size_t i) {
+                    ++calls[i];
+                    return true;
+                }));
+
+            bool once = true;
+            for (auto const& c : calls)
+                once = once && c == 1;
+            BEAST_EXPECT(once);
+        }
+    }
+
+    void
+    testGrain(JobQueue& jobQueue)
+    {
+        testcase("grain");
+
+        for (auto const grain : {ParallelGrain{}, ParallelGrain{0}})
+        {
+            std::vector<std::atomic<int>> calls(1000);
+            BEAST_EXPECT(parallelFor(
+                jobQueue,
+                jtPATH_UPDATE,
+                "ParallelForTest",
+                calls.size(),
+                grain,
+                [&calls](std::size_t i) {
+                    ++calls[i];
+                    return true;
+                }));
+
+            bool once = true;
+            for (auto const& c : calls)
+                once = once && c == 1;
+            BEAST_EXPECT(once);
+        }
+    }
+
+    void
+    testStop(JobQueue& jobQueue)
+    {
+        testcase("stop");
+
+        std::atomic<int> calls = 0;
+        BEAST_EXPECT(!parallelFor(
+            jobQueue,
+            jtPATH_UPDATE,
+            "ParallelForTest",
+            1000,
+            0,
+            [&calls](std::size_t i) {
+                ++calls;
+                return i < 9;
+            }));
+        BEAST_EXPECT(calls == 10);
+    }
+
+    void
+    testException(JobQueue& jobQueue)
+    {
+        testcase("exception");
+
+        std::atomic<int> calls = 0;
+        try
+        {
+            parallelFor(
+                jobQueue,
+                jtPATH_UPDATE,
+                "ParallelForTest",
+                100,
+                4,
+                [&calls](std::size_t i) {
+                    ++calls;
+                    if (i == 50)
+                        throw std::runtime_error("expected");
+                    return true;
+                });
+            fail("no exception");
+        }
+        catch (std::runtime_error const& e)
+        {
+            BEAST_EXPECT(std::string(e.what()) == "expected");
+        }
+        BEAST_EXPECT(calls >= 51 && calls <= 100);
+    }
+
+    void
+    testStopped(JobQueue& jobQueue)
+    {
+        testcase("stopped queue");
+
+        // Without any helper jobs, all of the work is done by the caller
+        jobQueue.stop();
+        std::atomic<int> calls = 0;
+        BEAST_EXPECT(parallelFor(
+            jobQueue,
+            jtPATH_UPDATE,
+            "ParallelForTest",
+            20,
+            4,
+            [&calls](std::size_t) {
+                ++calls;
+                return true;
+            }));
+        BEAST_EXPECT(calls == 20);
+    }
+
+public:
+    void
+    run() override
+    {
+        jtx::Env env{*this};
+        auto& jobQueue = env.app().getJobQueue();
+
+        testAllIndexes(jobQueue);
+        testGrain(jobQueue);
+        testStop(jobQueue);
+        testException(jobQueue);
+        testStopped(jobQueue);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ParallelFor, core, ripple);
+
+}  // namespace test
+}  // namespace ripple
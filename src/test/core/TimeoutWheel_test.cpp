@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/core/TimeoutWheel.h>
+#include <atomic>
+#include <optional>
+#include <thread>
+
+namespace ripple {
+namespace test {
+
+class TimeoutWheel_test : public beast::unit_test::suite
+{
+    using clock_type = TimeoutWheel::clock_type;
+
+    void
+    testOrder()
+    {
+        testcase("order");
+
+        using namespace std::chrono_literals;
+        boost::asio::io_service io;
+        TimeoutWheel wheel(io, 5ms);
+
+        std::vector<int> order;
+        auto const start = clock_type::now();
+        std::vector<clock_type::duration> elapsed(3);
+        auto const add = [&](int i, std::chrono::milliseconds delay) {
+            wheel.schedule(delay, [&, i] {
+                elapsed[i] = clock_type::now() - start;
+                order.push_back(i);
+            });
+        };
+        add(0, 60ms);
+        add(1, 20ms);
+        add(2, 40ms);
+        BEAST_EXPECT(wheel.size() == 3);
+
+        // The wheel's timer keeps the io_service busy until the last
+        // handler has run.
+        io.run();
+        BEAST_EXPECT(wheel.size() == 0);
+        BEAST_EXPECT((order == std::vector<int>{1, 2, 0}));
+        BEAST_EXPECT(elapsed[0] >= 60ms);
+        BEAST_EXPECT(elapsed[1] >= 20ms);
+        BEAST_EXPECT(elapsed[2] >= 40ms);
+    }
+
+    void
+    testReschedule()
+    {
+        testcase("reschedule");
+
+        using namespace std::chrono_literals;
+        boost::asio::io_service io;
+        TimeoutWheel wheel(io, 1ms);
+
+        // A handler can schedule itself again, and delays longer than one
+        // turn of the wheel wait for more than one turn.
+        int runs = 0;
+        std::function<void()> again = [&] {
+            if (++runs < 5)
+                wheel.schedule(10ms, again);
+        };
+        wheel.schedule(10ms, again);
+
+        bool late = false;
+        auto const start = clock_type::now();
+        wheel.schedule(
+            1500ms, [&] { late = clock_type::now() - start >= 1500ms; });
+
+        io.run();
+        BEAST_EXPECT(runs == 5);
+        BEAST_EXPECT(late);
+    }
+
+    void
+    testStop()
+    {
+        testcase("stop");
+
+        using namespace std::chrono_literals;
+        boost::asio::io_service io;
+        std::optional<boost::asio::io_service::work> work(io);
+        std::thread thread([&io] { io.run(); });
+
+        std::atomic<int> runs = 0;
+        {
+            TimeoutWheel wheel(io, 5ms);
+            wheel.schedule(10ms, [&] { ++runs; });
+            wheel.schedule(10s, [&] { ++runs; });
+            while (runs == 0)
+                std::this_thread::sleep_for(1ms);
+
+            // Handlers still waiting are dropped
+            wheel.stop();
+            BEAST_EXPECT(wheel.size() == 0);
+            wheel.schedule(10ms, [&] { ++runs; });
+            BEAST_EXPECT(wheel.size() == 0);
+        }
+
+        work.reset();
+        thread.join();
+        BEAST_EXPECT(runs == 1);
+    }
+
+public:
+    void
+    run() override
+    {
+        testOrder();
+        testReschedule();
+        testStop();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(TimeoutWheel, core, ripple);
+
+}  // namespace test
+}  // namespace ripple
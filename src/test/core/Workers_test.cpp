@@ -74,6 +74,17 @@ class PerfLogTest : public PerfLog
     {
     }
 
+    void
+    dbReader(std::string const& database, std::chrono::microseconds wait)
+        override
+    {
+    }
+
+    void
+    jobQueueLock(std::chrono::microseconds wait) override
+    {
+    }
+
     Json::Value
     countersJson() const override
     {
@@ -86,6 +97,12 @@ class PerfLogTest : public PerfLog
         return Json::Value();
     }
 
+    Json::Value
+    latencyJson() const override
+    {
+        return Json::Value();
+    }
+
     void
     resizeJobs(int const resize) override
     {
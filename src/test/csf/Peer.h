@@ -26,6 +26,7 @@
 #include <boost/container/flat_map.hpp>
 #include <boost/container/flat_set.hpp>
 #include <algorithm>
+#include <optional>
 #include <test/csf/CollectorRef.h>
 #include <test/csf/Scheduler.h>
 #include <test/csf/TrustGraph.h>
@@ -237,6 +238,8 @@ struct Peer
     std::size_t prevProposers = 0;
     // Duration of prior round
     std::chrono::milliseconds prevRoundTime;
+    // Transaction set of the last position found to be stable
+    std::optional<TxSet::ID> stablePosition;
 
     // Quorum of validations needed for a ledger to be fully validated
     // TODO: Use the logic in ValidatorList to set this dynamically
@@ -648,6 +651,13 @@ struct Peer
     {
     }
 
+    // Ledgers are not built ahead of consensus, but note the position
+    void
+    onStablePosition(Result const& result, Ledger const&, NetClock::duration)
+    {
+        stablePosition = result.txns.id();
+    }
+
     // Share a message by broadcasting to all connected peers
     template <class M>
     void
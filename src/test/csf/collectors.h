@@ -25,6 +25,7 @@
 #include <test/csf/events.h>
 
 #include <chrono>
+#include <map>
 #include <optional>
 #include <ostream>
 #include <tuple>
@@ -751,6 +752,70 @@ struct JumpCollector
     }
 };
 
+/** Tracks how long each peer spends in consensus rounds.
+
+    A round runs from the peer starting consensus on a prior ledger to the
+    peer accepting the resulting ledger. Rounds that restart because the
+    peer switched to a different prior ledger are counted separately.
+*/
+struct RoundCollector
+{
+    std::size_t started{0};
+    std::size_t completed{0};
+    std::size_t wrongPrevLedger{0};
+
+    std::map<PeerID, SimTime> inProgress_;
+    std::map<PeerID, SimTime> closed_;
+
+    using Hist = Histogram<SimTime::duration>;
+    Hist roundDuration;
+    Hist closeToAccept;
+
+    // Ignore most events by default
+    template <class E>
+    void
+    on(PeerID, SimTime, E const& e)
+    {
+    }
+
+    void
+    on(PeerID who, SimTime when, StartRound const&)
+    {
+        ++started;
+        inProgress_[who] = when;
+        closed_.erase(who);
+    }
+
+    void
+    on(PeerID who, SimTime when, CloseLedger const&)
+    {
+        closed_[who] = when;
+    }
+
+    void
+    on(PeerID who, SimTime when, AcceptLedger const&)
+    {
+        if (auto const it = inProgress_.find(who); it != inProgress_.end())
+        {
+            ++completed;
+            roundDuration.insert(when - it->second);
+            inProgress_.erase(it);
+        }
+
+        if (auto const it = closed_.find(who); it != closed_.end())
+        {
+            closeToAccept.insert(when - it->second);
+            closed_.erase(it);
+        }
+    }
+
+    void
+    on(PeerID, SimTime, WrongPrevLedger const&)
+    {
+        ++wrongPrevLedger;
+    }
+};
+
 }  // namespace csf
 }  // namespace test
 }  // namespace ripple
@@ -0,0 +1,189 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/json/FlatValue.h>
+#include <ripple/json/json_errors.h>
+#include <ripple/json/json_reader.h>
+#include <ripple/json/json_value.h>
+#include <ripple/protocol/jss.h>
+
+namespace ripple {
+
+class FlatValue_test : public beast::unit_test::suite
+{
+    static std::string
+    toString(Json::FlatValue const& v)
+    {
+        std::string s;
+        Json::outputJson(v, Json::stringOutput(s));
+        return s;
+    }
+
+    static std::string
+    toString(Json::Value const& v)
+    {
+        std::string s;
+        Json::outputJson(v, Json::stringOutput(s));
+        return s;
+    }
+
+    void
+    testBuild()
+    {
+        testcase("build");
+
+        Json::Arena arena;
+        auto root = arena.make();
+        Json::Value expected;
+
+        // Added out of order; written sorted, like Json::Value.
+        root[jss::status] = jss::success;
+        expected[jss::status] = jss::success;
+        root[jss::account] = "rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh";
+        expected[jss::account] = "rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh";
+        root["dynamic"] = -3;
+        expected["dynamic"] = -3;
+        root[jss::ledger_index] = 7u;
+        expected[jss::ledger_index] = 7u;
+        root[jss::validated] = true;
+        expected[jss::validated] = true;
+        root["ratio"] = 0.5;
+        expected["ratio"] = 0.5;
+        root["nothing"];
+        expected["nothing"];
+
+        // References stay valid as members are added.
+        auto& lines = root[jss::lines];
+        auto& expectedLines = expected[jss::lines];
+        for (int i = 0; i < 100; ++i)
+        {
+            root["k" + std::to_string(i)] = i;
+            expected["k" + std::to_string(i)] = i;
+        }
+        for (int i = 0; i < 3; ++i)
+        {
+            auto& line = lines.append();
+            line[jss::balance] = std::to_string(i);
+            line[jss::limit] = "100";
+            expectedLines.append(Json::objectValue);
+            expectedLines[i][jss::balance] = std::to_string(i);
+            expectedLines[i][jss::limit] = "100";
+        }
+
+        BEAST_EXPECT(root.type() == Json::objectValue);
+        BEAST_EXPECT(root.size() == expected.size());
+        BEAST_EXPECT(lines.size() == 3);
+        BEAST_EXPECT(root.isMember("k42"));
+        BEAST_EXPECT(!root.isMember("k100"));
+        BEAST_EXPECT(root.find("dynamic")->asInt() == -3);
+        BEAST_EXPECT(root[jss::lines][1u][jss::balance].asString() == "1");
+
+        BEAST_EXPECT(toString(root) == toString(expected));
+        BEAST_EXPECT(root.toValue() == expected);
+
+        // Static names and strings are not copied.
+        auto const& status = *root.find(jss::status.c_str());
+        BEAST_EXPECT(status.asString().data() == jss::success.c_str());
+        auto const& first = root.members().front();
+        BEAST_EXPECT(first.name.data() == jss::account.c_str());
+    }
+
+    void
+    testCopy()
+    {
+        testcase("copy");
+
+        Json::Value v;
+        BEAST_EXPECT(Json::Reader{}.parse(
+            R"({"a":[1,-2,3.5,"four",true,null,{"b":{}}],"c":"d","e":[]})",
+            v));
+
+        Json::Arena arena;
+        auto flat = arena.make();
+        flat = v;
+        BEAST_EXPECT(flat.toValue() == v);
+        BEAST_EXPECT(toString(flat) == toString(v));
+
+        // A copy into another arena survives the original.
+        Json::Arena other;
+        auto copy = other.make();
+        {
+            Json::Arena temporary;
+            auto t = temporary.make();
+            t = flat;
+            t["a"][6u]["b"]["x"] = "y";
+            copy = t;
+        }
+        BEAST_EXPECT(copy["a"][6u]["b"]["x"].asString() == "y");
+        BEAST_EXPECT(!flat["a"][6u]["b"].isMember("x"));
+        copy["a"][6u]["b"] = Json::Value(Json::objectValue);
+        BEAST_EXPECT(copy.toValue() == v);
+    }
+
+    void
+    testErrors()
+    {
+        testcase("errors");
+
+        Json::Arena arena;
+        auto v = arena.make(Json::arrayValue);
+        v.append(1);
+        BEAST_EXPECT(v.size() == 1);
+        BEAST_EXPECT(v.members().empty());
+        BEAST_EXPECT(!v.isMember("a"));
+
+        auto expectThrow = [this](auto&& f) {
+            try
+            {
+                f();
+                fail();
+            }
+            catch (Json::error const&)
+            {
+                pass();
+            }
+        };
+        expectThrow([&] { v["a"]; });
+        expectThrow([&] { std::as_const(v)[1u]; });
+        expectThrow([&] { v[0u].asString(); });
+        expectThrow([&] { v[0u].append(); });
+
+        // Assigning a scalar replaces a collection.
+        v = 5;
+        BEAST_EXPECT(v.type() == Json::intValue && v.asUInt() == 5);
+        v = Json::Value();
+        BEAST_EXPECT(v.isNull() && v.toValue().isNull());
+        v["now"] = "an object";
+        BEAST_EXPECT(v.type() == Json::objectValue);
+    }
+
+public:
+    void
+    run() override
+    {
+        testBuild();
+        testCopy();
+        testErrors();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(FlatValue, json, ripple);
+
+}  // namespace ripple
@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/json/SharedJson.h>
+#include <ripple/server/WSSession.h>
+
+namespace ripple {
+namespace test {
+
+struct SharedJson_test : beast::unit_test::suite
+{
+    static std::string
+    streamed(Json::Value const& jv)
+    {
+        std::string text;
+        Json::stream(jv, [&text](void const* data, std::size_t n) {
+            text.append(static_cast<char const*>(data), n);
+        });
+        return text;
+    }
+
+    void
+    testText()
+    {
+        testcase("text");
+
+        Json::Value jv(Json::objectValue);
+        jv["type"] = "ledgerClosed";
+        jv["ledger_index"] = 42;
+
+        SharedJson const shared{jv};
+        BEAST_EXPECT(&shared.json() == &jv);
+
+        auto const text = shared.text();
+        BEAST_EXPECT(*text == streamed(jv));
+        // Later recipients share the same text
+        BEAST_EXPECT(shared.text() == text);
+
+        MultivarJson<3> multi{jv};
+        multi.val[2]["extra"] = true;
+        auto const versions = share(multi);
+        BEAST_EXPECT(*versions[0].text() == streamed(jv));
+        BEAST_EXPECT(*versions[1].text() == streamed(jv));
+        BEAST_EXPECT(*versions[2].text() == streamed(multi.val[2]));
+    }
+
+    void
+    testMessage()
+    {
+        testcase("websocket message");
+
+        auto const data = std::make_shared<std::string const>(10, 'x');
+
+        // Each message keeps its own position in the shared data
+        SharedWSMsg first{data};
+        SharedWSMsg second{data};
+
+        auto [done, buffers] = first.prepare(4, {});
+        BEAST_EXPECT(done == false);
+        BEAST_EXPECT(
+            buffers.size() == 1 && boost::asio::buffer_size(buffers) == 4);
+
+        std::tie(done, buffers) = second.prepare(64, {});
+        BEAST_EXPECT(done == true);
+        BEAST_EXPECT(boost::asio::buffer_size(buffers) == 10);
+
+        std::tie(done, buffers) = first.prepare(4, {});
+        BEAST_EXPECT(done == false);
+        BEAST_EXPECT(boost::asio::buffer_size(buffers) == 4);
+        BEAST_EXPECT(
+            static_cast<char const*>(buffers[0].data()) == data->data() + 4);
+
+        std::tie(done, buffers) = first.prepare(4, {});
+        BEAST_EXPECT(done == true);
+        BEAST_EXPECT(boost::asio::buffer_size(buffers) == 2);
+
+        SharedWSMsg empty{std::make_shared<std::string const>()};
+        std::tie(done, buffers) = empty.prepare(4, {});
+        BEAST_EXPECT(done == true);
+        BEAST_EXPECT(buffers.empty());
+    }
+
+    void
+    run() override
+    {
+        testText();
+        testMessage();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SharedJson, ripple_basics, ripple);
+
+}  // namespace test
+}  // namespace ripple
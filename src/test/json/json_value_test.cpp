@@ -604,6 +604,40 @@ struct json_value_test : beast::unit_test::suite
         pass();
     }
 
+    void
+    test_strings()
+    {
+        // Escapes at every offset within and across 8 byte words
+        for (std::size_t offset = 0; offset < 20; ++offset)
+        {
+            std::string const prefix(offset, 'a');
+            std::string const suffix(19 - offset, 'b');
+            std::string const json = "{\"s\":\"" + prefix +
+                "\\\"\\\\\\u00e9\\n" + suffix + "\"}";
+
+            Json::Value j;
+            BEAST_EXPECT(Json::Reader{}.parse(json, j));
+            BEAST_EXPECT(
+                j["s"].asString() == prefix + "\"\\\xc3\xa9\n" + suffix);
+        }
+
+        {
+            // Long strings without escapes
+            std::string const text(1000, 'x');
+            Json::Value j;
+            BEAST_EXPECT(Json::Reader{}.parse(
+                "{\"" + text + "\":\"" + text + "\"}", j));
+            BEAST_EXPECT(j[text].asString() == text);
+        }
+
+        {
+            // Unterminated string
+            Json::Value j;
+            BEAST_EXPECT(!Json::Reader{}.parse(
+                "{\"s\":\"abcdefghijklmnopqrstuvwxyz}", j));
+        }
+    }
+
     void
     test_edge_cases()
     {
@@ -1380,6 +1414,7 @@ struct json_value_test : beast::unit_test::suite
         test_compare();
         test_bool();
         test_bad_json();
+        test_strings();
         test_edge_cases();
         test_copy();
         test_move();
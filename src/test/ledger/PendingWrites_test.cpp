@@ -0,0 +1,74 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/PendingWrites.h>
+#include <ripple/beast/unit_test.h>
+#include <thread>
+
+namespace ripple {
+namespace test {
+
+struct PendingWrites_test : public beast::unit_test::suite
+{
+    void
+    testWrites()
+    {
+        PendingWrites pw;
+        int done = 0;
+
+        // Basic test
+        std::function<void()> first = [&] { ++done; };
+        BEAST_EXPECT(pw.add(5, std::move(first), 2));
+        std::function<void()> second = [&] { done += 10; };
+        BEAST_EXPECT(pw.add(6, std::move(second), 2));
+        BEAST_EXPECT(pw.size() == 2);
+
+        // Past the limit the caller keeps the work
+        std::function<void()> third = [&] { done += 100; };
+        BEAST_EXPECT(!pw.add(7, std::move(third), 2));
+        BEAST_EXPECT(third);
+        BEAST_EXPECT(pw.size() == 2);
+
+        // Test work stealing
+        pw.waitThrough(5);
+        BEAST_EXPECT(done == 1);
+        BEAST_EXPECT(pw.size() == 1);
+
+        std::thread job([&] { pw.doWrite(); });
+        job.join();
+        BEAST_EXPECT(done == 11);
+        BEAST_EXPECT(pw.size() == 0);
+
+        // Writes taken by waitThrough leave nothing for their job
+        pw.doWrite();
+        pw.waitThrough(100);
+        BEAST_EXPECT(done == 11);
+    }
+
+    void
+    run() override
+    {
+        testWrites();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(PendingWrites, ledger, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,167 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/ledger/SLEView.h>
+#include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/STArray.h>
+#include <ripple/protocol/STIssue.h>
+#include <ripple/protocol/jss.h>
+
+namespace ripple {
+namespace test {
+
+class SLEView_test : public beast::unit_test::suite
+{
+    static AccountID
+    account(std::uint64_t n)
+    {
+        return AccountID{n};
+    }
+
+    static SLEView
+    serialized(STLedgerEntry const& sle)
+    {
+        Serializer s;
+        sle.add(s);
+        return SLEView{make_shamapitem(sle.key(), s.slice())};
+    }
+
+    void
+    testAccountRoot()
+    {
+        testcase("account root");
+        auto const id = account(1);
+        auto const sle = std::make_shared<SLE>(keylet::account(id));
+        sle->setAccountID(sfAccount, id);
+        sle->setFieldAmount(sfBalance, XRPAmount{123456789});
+        sle->setFieldU32(sfSequence, 42);
+        sle->setFieldU32(sfOwnerCount, 7);
+        sle->setFieldU32(sfFlags, lsfGlobalFreeze);
+        sle->setFieldH256(sfPreviousTxnID, uint256{5});
+        sle->setFieldU32(sfPreviousTxnLgrSeq, 3);
+
+        for (auto const& view : {serialized(*sle), SLEView{sle}})
+        {
+            BEAST_EXPECT(view.key() == sle->key());
+            BEAST_EXPECT(view.getType() == ltACCOUNT_ROOT);
+            BEAST_EXPECT(view.getAccountID(sfAccount) == id);
+            BEAST_EXPECT(
+                view.getFieldAmount(sfBalance) == XRPAmount{123456789});
+            BEAST_EXPECT(view.getFieldU32(sfSequence) == 42);
+            BEAST_EXPECT(view.getFieldU32(sfOwnerCount) == 7);
+            BEAST_EXPECT(view.isFlag(lsfGlobalFreeze));
+            BEAST_EXPECT(!view.isFlag(lsfRequireAuth));
+            BEAST_EXPECT(view.getFieldH256(sfPreviousTxnID) == uint256{5});
+
+            // Optional fields that aren't present read as default
+            BEAST_EXPECT(!view.isFieldPresent(sfTransferRate));
+            BEAST_EXPECT(view.getFieldU32(sfTransferRate) == 0);
+            BEAST_EXPECT(!view.isFieldPresent(sfAMMID));
+            BEAST_EXPECT(view.getFieldH256(sfAMMID) == beast::zero);
+            BEAST_EXPECT(view.getAccountID(sfRegularKey) == beast::zero);
+
+            BEAST_EXPECT(view.sle()->isEquivalent(*sle));
+        }
+    }
+
+    void
+    testTrustLine()
+    {
+        testcase("trust line");
+        auto const low = account(1);
+        auto const high = account(2);
+        Currency const usd{3};
+        auto const sle =
+            std::make_shared<SLE>(keylet::line(low, high, usd));
+        STAmount const balance{Issue{usd, noAccount()}, 15u, -1, true};
+        sle->setFieldAmount(sfBalance, balance);
+        sle->setFieldAmount(sfLowLimit, STAmount{Issue{usd, low}, 100});
+        sle->setFieldAmount(sfHighLimit, STAmount{Issue{usd, high}, 0});
+        sle->setFieldU32(sfFlags, lsfHighFreeze);
+        sle->setFieldU64(sfLowNode, 9);
+
+        auto const view = serialized(*sle);
+        BEAST_EXPECT(view.getType() == ltRIPPLE_STATE);
+        BEAST_EXPECT(view.getFieldAmount(sfBalance) == balance);
+        BEAST_EXPECT(
+            view.getFieldAmount(sfLowLimit) ==
+            sle->getFieldAmount(sfLowLimit));
+        BEAST_EXPECT(view.getFieldAmount(sfLowLimit).getIssuer() == low);
+        BEAST_EXPECT(view.isFlag(lsfHighFreeze));
+        BEAST_EXPECT(!view.isFlag(lsfLowFreeze));
+        BEAST_EXPECT(view.getFieldU64(sfLowNode) == 9);
+        BEAST_EXPECT(view.getFieldU64(sfHighNode) == 0);
+    }
+
+    void
+    testNested()
+    {
+        testcase("nested fields");
+        auto const id = account(1);
+        Issue const usd{Currency{3}, account(2)};
+        auto const sle = std::make_shared<SLE>(keylet::amm(xrpIssue(), usd));
+        sle->setAccountID(sfAccount, id);
+        sle->setFieldU16(sfTradingFee, 100);
+        sle->setFieldAmount(sfLPTokenBalance, STAmount{Issue{usd}, 10});
+        sle->setFieldIssue(sfAsset, STIssue{sfAsset, xrpIssue()});
+        sle->setFieldIssue(sfAsset2, STIssue{sfAsset2, usd});
+        sle->setFieldU64(sfOwnerNode, 4);
+
+        STArray votes{sfVoteSlots};
+        STObject vote{sfVoteEntry};
+        vote.setAccountID(sfAccount, id);
+        vote.setFieldU32(sfVoteWeight, 100000);
+        votes.push_back(std::move(vote));
+        sle->setFieldArray(sfVoteSlots, votes);
+
+        STObject slot{sfAuctionSlot};
+        slot.setAccountID(sfAccount, id);
+        slot.setFieldU32(sfExpiration, 1000);
+        slot.setFieldAmount(sfPrice, STAmount{Issue{usd}, 0});
+        sle->set(std::move(slot));
+
+        // Fields after objects and arrays are found by skipping them
+        auto const view = serialized(*sle);
+        BEAST_EXPECT(view.getType() == ltAMM);
+        BEAST_EXPECT(view.getFieldU16(sfTradingFee) == 100);
+        BEAST_EXPECT(view.getFieldU64(sfOwnerNode) == 4);
+        BEAST_EXPECT(view.getAccountID(sfAccount) == id);
+        BEAST_EXPECT(view.isFieldPresent(sfAuctionSlot));
+        BEAST_EXPECT(view.isFieldPresent(sfVoteSlots));
+        BEAST_EXPECT(view.isFieldPresent(sfAsset));
+        BEAST_EXPECT(view.isFieldPresent(sfAsset2));
+        BEAST_EXPECT(!view.isFieldPresent(sfXChainBridge));
+        BEAST_EXPECT(view.sle()->isEquivalent(*sle));
+    }
+
+public:
+    void
+    run() override
+    {
+        testAccountRoot();
+        testTrustLine();
+        testNested();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SLEView, ledger, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -25,6 +25,7 @@
 #include <ripple/ledger/Sandbox.h>
 #include <ripple/protocol/Feature.h>
 #include <ripple/protocol/Protocol.h>
+#include <ripple/rpc/impl/RPCHelpers.h>
 #include <test/jtx.h>
 #include <type_traits>
 
@@ -1050,6 +1051,80 @@ class View_test : public beast::unit_test::suite
         BEAST_EXPECT(!areCompatible(iA4.hash, iA4.seq, *rdViewB4, jStream, ""));
     }
 
+    void
+    testForEachItemAfter()
+    {
+        testcase("For each item after");
+
+        using namespace jtx;
+        Env env(*this);
+
+        auto const alice = Account("alice");
+        env.fund(XRP(100000), alice);
+        env.close();
+
+        // Enough trust lines and offers to span several directory pages.
+        for (int i = 0; i < 40; ++i)
+        {
+            auto const gw = Account("gw" + std::to_string(i));
+            env.fund(XRP(10000), gw);
+            env.close();
+            env(trust(alice, gw["USD"](1000)));
+            env(offer(alice, gw["USD"](10), XRP(10)));
+            env.close();
+        }
+
+        auto const view = env.closed();
+
+        // Visit the items of alice's owner directory with both overloads,
+        // counting only offers, and check they agree.
+        auto const visit = [&](uint256 const& after,
+                               std::uint64_t hint,
+                               unsigned int limit) {
+            std::vector<uint256> full;
+            std::vector<uint256> lazy;
+            bool const fullOk = forEachItemAfter(
+                *view,
+                alice.id(),
+                after,
+                hint,
+                limit,
+                [&full](std::shared_ptr<SLE const> const& sle) {
+                    full.push_back(sle->key());
+                    return sle->getType() == ltOFFER;
+                });
+            bool const lazyOk = forEachItemAfter(
+                *view,
+                alice.id(),
+                after,
+                hint,
+                limit,
+                [&lazy](SLEView const& sle) {
+                    lazy.push_back(sle.key());
+                    return sle.getType() == ltOFFER;
+                });
+            BEAST_EXPECT(fullOk == lazyOk);
+            BEAST_EXPECT(full == lazy);
+            return full;
+        };
+
+        auto const all = visit(beast::zero, 0, 1000);
+        BEAST_EXPECT(all.size() == 80);
+
+        auto const some = visit(beast::zero, 0, 10);
+        BEAST_EXPECT(some.size() == 20);
+
+        auto const after = all[30];
+        auto const sle = view->read(keylet::child(after));
+        if (!BEAST_EXPECT(sle))
+            return;
+        auto const hint = RPC::getStartHint(sle, alice.id());
+        auto const rest = visit(after, hint, 1000);
+        BEAST_EXPECT(rest.size() == all.size() - 31);
+        BEAST_EXPECT(std::equal(rest.begin(), rest.end(), all.begin() + 31));
+        BEAST_EXPECT(hint == RPC::getStartHint(SLEView(sle), alice.id()));
+    }
+
     void
     testRegressions()
     {
@@ -1108,6 +1183,7 @@ class View_test : public beast::unit_test::suite
         testFlags();
         testTransferRate();
         testAreCompatible();
+        testForEachItemAfter();
         testRegressions();
     }
 };
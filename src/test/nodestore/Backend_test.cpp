@@ -20,8 +20,10 @@
 #include <ripple/beast/utility/temp_dir.h>
 #include <ripple/nodestore/DummyScheduler.h>
 #include <ripple/nodestore/Manager.h>
+#include <ripple/nodestore/impl/IoUringQueue.h>
 #include <ripple/unity/rocksdb.h>
 #include <algorithm>
+#include <map>
 #include <test/nodestore/TestBase.h>
 #include <test/unit_test/SuiteJournal.h>
 
@@ -38,16 +40,22 @@ public:
     testBackend(
         std::string const& type,
         std::uint64_t const seedValue,
-        int numObjsToTest = 2000)
+        int numObjsToTest = 2000,
+        std::map<std::string, std::string> const& options = {})
     {
         DummyScheduler scheduler;
 
-        testcase("Backend type=" + type);
+        std::string name = "Backend type=" + type;
+        for (auto const& [key, value] : options)
+            name += " " + key + "=" + value;
+        testcase(name);
 
         Section params;
         beast::temp_dir tempDir;
         params.set("type", type);
         params.set("path", tempDir.path());
+        for (auto const& [key, value] : options)
+            params.set(key, value);
 
         beast::xor_shift_engine rng(seedValue);
 
@@ -73,6 +81,24 @@ public:
                 BEAST_EXPECT(areBatchesEqual(batch, copy));
             }
 
+            {
+                // Read it back in one batch, along with a missing object
+                uint256 const missing{1};
+                std::vector<uint256 const*> hashes;
+                for (auto const& object : batch)
+                    hashes.push_back(&object->getHash());
+                hashes.push_back(&missing);
+
+                auto const [objects, status] = backend->fetchBatch(hashes);
+                BEAST_EXPECT(status == ok);
+                if (BEAST_EXPECT(objects.size() == hashes.size()))
+                {
+                    BEAST_EXPECT(!objects.back());
+                    Batch copy(objects.begin(), objects.end() - 1);
+                    BEAST_EXPECT(areBatchesEqual(batch, copy));
+                }
+            }
+
             {
                 // Reorder and read the copy again
                 std::shuffle(batch.begin(), batch.end(), rng);
@@ -107,6 +133,16 @@ public:
 
         testBackend("nudb", seedValue);
 
+#if RIPPLE_IO_URING_AVAILABLE
+        // Falls back to blocking reads if the kernel refuses the ring
+        testBackend("nudb", seedValue, 2000, {{"io_uring", "1"}});
+        testBackend(
+            "nudb",
+            seedValue,
+            2000,
+            {{"io_uring", "1"}, {"io_uring_depth", "1"}});
+#endif
+
 #if RIPPLE_ROCKSDB_AVAILABLE
         testBackend("rocksdb", seedValue);
 #endif
@@ -17,11 +17,19 @@
 */
 //==============================================================================
 
+#include <ripple/beast/utility/temp_dir.h>
 #include <ripple/nodestore/DummyScheduler.h>
 #include <ripple/nodestore/Manager.h>
 #include <ripple/nodestore/impl/DecodedBlob.h>
 #include <ripple/nodestore/impl/EncodedBlob.h>
+#include <ripple/nodestore/impl/NodeDictionary.h>
+#include <ripple/nodestore/impl/codec.h>
+#include <ripple/protocol/HashPrefix.h>
+#include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/STLedgerEntry.h>
+#include <ripple/protocol/digest.h>
 #include <test/nodestore/TestBase.h>
+#include <test/unit_test/SuiteJournal.h>
 
 namespace ripple {
 namespace NodeStore {
@@ -75,6 +83,153 @@ public:
         }
     }
 
+    // Checks decoding compressed values straight into objects
+    void
+    testDecode(std::uint64_t const seedValue)
+    {
+        testcase("decode");
+
+        beast::xor_shift_engine rng(seedValue);
+        auto batch = createPredictableBatch(numObjectsToTest, seedValue);
+
+        // Inner nodes, with and without empty branches
+        for (int children : {1, 5, 16})
+        {
+            Blob data(4 + 16 * 32, 0);
+            auto const prefix =
+                static_cast<std::uint32_t>(HashPrefix::innerNode);
+            for (int i = 0; i < 4; ++i)
+                data[i] = static_cast<std::uint8_t>(prefix >> (24 - 8 * i));
+            for (int i = 0; i < children; ++i)
+                beast::rngfill(&data[4 + 32 * i], 32, rng);
+
+            uint256 hash;
+            beast::rngfill(hash.begin(), hash.size(), rng);
+            batch.push_back(
+                NodeObject::createObject(hotUNKNOWN, std::move(data), hash));
+        }
+
+        for (auto const& original : batch)
+        {
+            EncodedBlob encoded(original);
+            nudb::detail::buffer bf;
+            auto const compressed =
+                nodeobject_compress(encoded.getData(), encoded.getSize(), bf);
+
+            nudb::detail::buffer bf1;
+            auto const object = nodeobject_decode(
+                encoded.getKey(), compressed.first, compressed.second, bf1);
+
+            nudb::detail::buffer bf2;
+            auto const result = nodeobject_decompress(
+                compressed.first, compressed.second, bf2);
+            DecodedBlob decoded(encoded.getKey(), result.first, result.second);
+
+            BEAST_EXPECT(object && decoded.wasOk());
+            if (object && decoded.wasOk())
+            {
+                BEAST_EXPECT(isSame(object, decoded.createObject()));
+                BEAST_EXPECT(object->getData() == original->getData());
+            }
+        }
+    }
+
+    // Checks values compressed with trained dictionaries
+    void
+    testDictionary(std::uint64_t const seedValue)
+    {
+        testcase("dictionary");
+
+        beast::xor_shift_engine rng(seedValue);
+
+        // Account roots, which share most of their structure
+        Batch batch;
+        for (int i = 0; i < 2000; ++i)
+        {
+            AccountID id;
+            beast::rngfill(id.begin(), id.size(), rng);
+            uint256 txID;
+            beast::rngfill(txID.begin(), txID.size(), rng);
+
+            auto const k = keylet::account(id);
+            STLedgerEntry sle(k);
+            sle.setAccountID(sfAccount, id);
+            sle.setFieldAmount(
+                sfBalance, XRPAmount{rand_int(rng, 100'000'000'000)});
+            sle.setFieldU32(sfSequence, rand_int(rng, 100'000u));
+            sle.setFieldU32(sfOwnerCount, rand_int(rng, 10u));
+            sle.setFieldH256(sfPreviousTxnID, txID);
+            sle.setFieldU32(sfPreviousTxnLgrSeq, rand_int(rng, 1'000'000u));
+
+            Serializer s;
+            s.add32(HashPrefix::leafNode);
+            sle.add(s);
+            s.addBitString(k.key);
+            auto const hash = sha512Half(s.slice());
+            batch.push_back(NodeObject::createObject(
+                hotACCOUNT_NODE, std::move(s.modData()), hash));
+        }
+
+        NodeDictionary::Trainer trainer(8 * 1024);
+        for (auto const& object : batch)
+        {
+            EncodedBlob encoded(object);
+            BEAST_EXPECT(
+                NodeDictionary::family(encoded.getData(), encoded.getSize()) ==
+                ((hotACCOUNT_NODE << 16) | ltACCOUNT_ROOT));
+            trainer.insert(encoded.getData(), encoded.getSize());
+        }
+        test::SuiteJournal journal("NodeStoreBasic_test", *this);
+        auto const trained = trainer.finish(7, journal);
+        BEAST_EXPECT(trained->size() == 1);
+
+        // The dictionaries survive a round trip through a file
+        beast::temp_dir dir;
+        trained->save(dir.file("dictionary"));
+        auto const dictionary = NodeDictionary::load(dir.file("dictionary"));
+        BEAST_EXPECT(dictionary->version() == 7);
+        BEAST_EXPECT(dictionary->size() == 1);
+
+        std::size_t lz4Size = 0;
+        std::size_t zstdSize = 0;
+        for (auto const& original : batch)
+        {
+            EncodedBlob encoded(original);
+            nudb::detail::buffer bf;
+            lz4Size +=
+                nodeobject_compress(encoded.getData(), encoded.getSize(), bf)
+                    .second;
+
+            auto const compressed = nodeobject_compress(
+                encoded.getData(), encoded.getSize(), bf, dictionary.get());
+            zstdSize += compressed.second;
+            BEAST_EXPECT(
+                *static_cast<std::uint8_t const*>(compressed.first) == 4);
+
+            nudb::detail::buffer bf1;
+            auto const object = nodeobject_decode(
+                encoded.getKey(),
+                compressed.first,
+                compressed.second,
+                bf1,
+                dictionary.get());
+            BEAST_EXPECT(object && isSame(object, original));
+
+            // Without the dictionaries the value can't be read
+            try
+            {
+                nodeobject_decode(
+                    encoded.getKey(), compressed.first, compressed.second, bf1);
+                fail();
+            }
+            catch (std::runtime_error const&)
+            {
+                pass();
+            }
+        }
+        BEAST_EXPECT(zstdSize < lz4Size);
+    }
+
     void
     run() override
     {
@@ -83,6 +238,10 @@ public:
         testBatches(seedValue);
 
         testBlobs(seedValue);
+
+        testDecode(seedValue);
+
+        testDictionary(seedValue);
     }
 };
 
@@ -0,0 +1,635 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/BasicConfig.h>
+#include <ripple/basics/ByteUtilities.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/unit_test/thread.hpp>
+#include <ripple/beast/utility/temp_dir.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <ripple/json/json_value.h>
+#include <ripple/json/to_string.h>
+#include <ripple/nodestore/DummyScheduler.h>
+#include <ripple/nodestore/Manager.h>
+#include <ripple/protocol/HashPrefix.h>
+#include <ripple/shamap/SHAMapTreeNode.h>
+#include <ripple/unity/rocksdb.h>
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <test/unit_test/SuiteJournal.h>
+#include <thread>
+
+namespace ripple {
+namespace NodeStore {
+
+/** Measures backends with traffic shaped like a server's.
+
+    Unlike Timing, the objects stored look like serialized SHAMap nodes:
+    inner nodes with a realistic spread of children, which the backends
+    compress, and leaves sized like ledger entries and transactions with
+    metadata. Each backend is first loaded, then put through these
+    workloads in turn:
+
+        close       Storing the nodes of new ledgers, with some reads of
+                    recent nodes and checks for nodes not yet stored.
+        sync        Acquiring ledgers: mostly checks for missing nodes,
+                    storing what arrives, and historical reads.
+        history     Reads of older nodes, as when serving peers and
+                    clients.
+        nodes       Reads of older nodes, each turned into the SHAMap
+                    tree node it holds, as when a map is traversed.
+        rotate      An online_delete rotation: every node is read from
+                    the backend and stored in a fresh one.
+
+    Latency percentiles and throughput are reported for every workload
+    and thread count, as a table and as one JSON object per line.
+
+    The argument is a list separated by ';'. Entries containing "type="
+    are backend configurations, with keys separated by ',' as in
+    rippled.cfg. Any backend known to the Manager may be named,
+    including cassandra in builds with reporting support, given its
+    usual settings. Other entries set options:
+
+        items=N         Objects loaded before the workloads run.
+        threads=A,B     Thread counts to measure with.
+        output=PATH     Append the JSON results to this file rather
+                        than the log.
+
+    For example:
+
+        --unittest=Benchmark --unittest-arg="type=nudb;threads=1,8"
+*/
+class Benchmark_test : public beast::unit_test::suite
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+#ifndef NDEBUG
+    std::size_t const default_items = 10000;
+#else
+    std::size_t const default_items = 100000;  // release
+#endif
+
+    // Produces a deterministic sequence of node objects resembling the
+    // serialized nodes of ledger state and transaction maps.
+    class NodeSequence
+    {
+    private:
+        // percent of nodes which are inner nodes
+        static int const innerPercent = 60;
+        // percent of nodes which belong to state maps
+        static int const statePercent = 70;
+
+        beast::xor_shift_engine gen_;
+        std::uint8_t prefix_;
+        std::uniform_int_distribution<int> percent_{0, 99};
+        // Inner nodes near the leaves, by far the most numerous, have
+        // few children. Those near the root have all sixteen.
+        std::discrete_distribution<int> children_{
+            {0, 0, 40, 18, 9, 5, 3, 2, 2, 1, 1, 1, 1, 1, 1, 1, 14}};
+        std::uniform_int_distribution<std::size_t> stateSize_{80, 400};
+        std::lognormal_distribution<double> txSize_{6.5, 0.6};
+
+        void
+        fill(std::uint8_t* buffer, std::size_t bytes)
+        {
+            while (bytes > 0)
+            {
+                auto const v = gen_();
+                auto const n = std::min(bytes, sizeof(v));
+                std::memcpy(buffer, &v, n);
+                buffer += n;
+                bytes -= n;
+            }
+        }
+
+        static void
+        putPrefix(Blob& data, HashPrefix prefix)
+        {
+            auto const p = static_cast<std::uint32_t>(prefix);
+            data[0] = static_cast<std::uint8_t>(p >> 24);
+            data[1] = static_cast<std::uint8_t>(p >> 16);
+            data[2] = static_cast<std::uint8_t>(p >> 8);
+            data[3] = static_cast<std::uint8_t>(p);
+        }
+
+    public:
+        explicit NodeSequence(std::uint8_t prefix) : prefix_(prefix)
+        {
+        }
+
+        // Returns the n-th key
+        uint256
+        key(std::size_t n)
+        {
+            gen_.seed(n + 1);
+            uint256 result;
+            fill(result.data(), result.size());
+            *result.data() = prefix_;
+            return result;
+        }
+
+        // Returns the n-th complete NodeObject
+        std::shared_ptr<NodeObject>
+        obj(std::size_t n)
+        {
+            auto const k = key(n);
+            bool const inner = percent_(gen_) < innerPercent;
+            bool const state = percent_(gen_) < statePercent;
+            auto const type = state ? hotACCOUNT_NODE : hotTRANSACTION_NODE;
+
+            Blob data;
+            if (inner)
+            {
+                // 16 child hashes, unused branches left zero
+                data.resize(4 + 16 * 32, 0);
+                putPrefix(data, HashPrefix::innerNode);
+                std::array<int, 16> branches;
+                std::iota(branches.begin(), branches.end(), 0);
+                auto const children = children_(gen_);
+                for (int i = 0; i < children; ++i)
+                {
+                    std::swap(branches[i], branches[i + gen_() % (16 - i)]);
+                    fill(&data[4 + 32 * branches[i]], 32);
+                }
+            }
+            else
+            {
+                auto const size = state
+                    ? stateSize_(gen_)
+                    : std::clamp<std::size_t>(txSize_(gen_), 200, 16384);
+                data.resize(4 + size + 32);
+                putPrefix(
+                    data, state ? HashPrefix::leafNode : HashPrefix::txNode);
+                fill(&data[4], size);
+                std::memcpy(&data[4 + size], k.data(), k.size());
+            }
+
+            return NodeObject::createObject(type, std::move(data), k);
+        }
+    };
+
+    // How often each operation is chosen, in percent
+    struct Mix
+    {
+        std::string name;
+        int store;
+        int fetchRecent;
+        int fetchOld;
+        int fetchMissing;
+    };
+
+    // Latencies of one kind of operation, in nanoseconds
+    using Latencies = std::vector<std::uint64_t>;
+
+    struct Result
+    {
+        std::string workload;
+        std::chrono::nanoseconds elapsed{};
+        std::map<std::string, Latencies> latencies;
+    };
+
+    struct Params
+    {
+        std::size_t items;
+        std::size_t threads;
+    };
+
+    static Section
+    parse(std::string s)
+    {
+        Section section;
+        std::vector<std::string> v;
+        boost::split(v, s, boost::algorithm::is_any_of(","));
+        section.append(v);
+        return section;
+    }
+
+    std::unique_ptr<Backend>
+    makeBackend(
+        Section const& config,
+        Scheduler& scheduler,
+        beast::Journal journal)
+    {
+        auto backend = Manager::instance().make_Backend(
+            config, megabytes(4), scheduler, journal);
+        BEAST_EXPECT(backend != nullptr);
+        backend->open();
+        return backend;
+    }
+
+    // Time a call, recording its latency
+    template <class F>
+    static void
+    timed(Latencies& latencies, F&& f)
+    {
+        auto const start = clock_type::now();
+        f();
+        latencies.push_back(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                clock_type::now() - start)
+                .count());
+    }
+
+    // Run body(thread, latencies) on each of params.threads threads and
+    // merge what they recorded.
+    template <class Body>
+    Result
+    runThreads(
+        std::string const& workload,
+        Params const& params,
+        Body&& body)
+    {
+        std::vector<std::map<std::string, Latencies>> recorded(
+            params.threads);
+        std::vector<beast::unit_test::thread> threads;
+        threads.reserve(params.threads);
+
+        auto const start = clock_type::now();
+        for (std::size_t id = 0; id < params.threads; ++id)
+            threads.emplace_back(*this, [&, id]() {
+                try
+                {
+                    body(id, recorded[id]);
+                }
+                catch (std::exception const& e)
+                {
+                    fail(e.what());
+                }
+            });
+        for (auto& t : threads)
+            t.join();
+
+        Result result;
+        result.workload = workload;
+        result.elapsed = clock_type::now() - start;
+        for (auto& r : recorded)
+        {
+            for (auto& [op, latencies] : r)
+            {
+                auto& all = result.latencies[op];
+                all.insert(all.end(), latencies.begin(), latencies.end());
+            }
+        }
+        return result;
+    }
+
+    // Store `items` objects, in batches the size of a small ledger
+    Result
+    doLoad(Backend& backend, Params const& params)
+    {
+        std::size_t const batchSize = 256;
+        std::atomic<std::size_t> next{0};
+        return runThreads("load", params, [&](std::size_t, auto& recorded) {
+            NodeSequence seq(1);
+            auto& latencies = recorded["store_batch"];
+            Batch batch;
+            for (;;)
+            {
+                auto const first = next.fetch_add(batchSize);
+                if (first >= params.items)
+                    break;
+                auto const last = std::min(params.items, first + batchSize);
+                batch.clear();
+                for (auto i = first; i < last; ++i)
+                    batch.push_back(seq.obj(i));
+                timed(latencies, [&] { backend.storeBatch(batch); });
+            }
+        });
+    }
+
+    // Perform `items` operations chosen according to the mix. New
+    // objects are numbered from `written`, which keeps growing across
+    // workloads.
+    Result
+    doMix(
+        Backend& backend,
+        Params const& params,
+        Mix const& mix,
+        std::atomic<std::size_t>& written)
+    {
+        std::atomic<std::size_t> next{0};
+        auto body = [&](std::size_t id, auto& recorded) {
+            NodeSequence seq(1);
+            NodeSequence missing(2);
+            beast::xor_shift_engine gen(id + 1);
+            std::uniform_int_distribution<int> percent(0, 99);
+            auto& stores = recorded["store"];
+            auto& fetches = recorded["fetch"];
+            auto& misses = recorded["fetch_missing"];
+            std::shared_ptr<NodeObject> result;
+
+            while (next++ < params.items)
+            {
+                auto const p = percent(gen);
+                if (p < mix.store)
+                {
+                    auto obj = seq.obj(written++);
+                    timed(stores, [&] { backend.store(obj); });
+                }
+                else if (p < mix.store + mix.fetchRecent)
+                {
+                    // one of the last few thousand objects stored
+                    auto const end = written.load();
+                    auto const window = std::min<std::size_t>(end, 4096);
+                    auto const key = seq.key(end - 1 - gen() % window);
+                    timed(fetches, [&] {
+                        backend.fetch(key.data(), &result);
+                    });
+                }
+                else if (p < mix.store + mix.fetchRecent + mix.fetchOld)
+                {
+                    auto const key = seq.key(gen() % params.items);
+                    timed(fetches, [&] {
+                        backend.fetch(key.data(), &result);
+                    });
+                    if (!result)
+                        fail("missing object");
+                }
+                else
+                {
+                    auto const key = missing.key(gen());
+                    timed(misses, [&] {
+                        backend.fetch(key.data(), &result);
+                    });
+                }
+            }
+        };
+        return runThreads(mix.name, params, body);
+    }
+
+    // Fetch `items` stored objects and make tree nodes from them
+    Result
+    doNodes(Backend& backend, Params const& params)
+    {
+        std::atomic<std::size_t> next{0};
+        auto body = [&](std::size_t id, auto& recorded) {
+            NodeSequence seq(1);
+            beast::xor_shift_engine gen(id + 1);
+            auto& fetches = recorded["fetch"];
+            auto& makes = recorded["make_node"];
+            std::shared_ptr<NodeObject> obj;
+            std::shared_ptr<SHAMapTreeNode> node;
+            while (next++ < params.items)
+            {
+                auto const key = seq.key(gen() % params.items);
+                timed(fetches, [&] { backend.fetch(key.data(), &obj); });
+                if (!obj)
+                {
+                    fail("missing object");
+                    continue;
+                }
+                timed(makes, [&] {
+                    node = SHAMapTreeNode::makeFromPrefix(
+                        obj->getData(), SHAMapHash{key});
+                });
+                if (!node)
+                    fail("bad node");
+            }
+        };
+        return runThreads("nodes", params, body);
+    }
+
+    // Copy every object into a fresh backend, as online_delete does
+    // when it rotates
+    Result
+    doRotate(
+        Backend& from,
+        Backend& to,
+        Params const& params,
+        std::size_t written)
+    {
+        std::atomic<std::size_t> next{0};
+        return runThreads("rotate", params, [&](std::size_t, auto& recorded) {
+            NodeSequence seq(1);
+            auto& fetches = recorded["fetch"];
+            auto& stores = recorded["store"];
+            std::shared_ptr<NodeObject> obj;
+            for (;;)
+            {
+                auto const i = next++;
+                if (i >= written)
+                    break;
+                auto const key = seq.key(i);
+                timed(fetches, [&] { from.fetch(key.data(), &obj); });
+                if (!obj)
+                {
+                    fail("missing object");
+                    continue;
+                }
+                timed(stores, [&] { to.store(obj); });
+            }
+        });
+    }
+
+    static std::uint64_t
+    percentile(Latencies const& sorted, double q)
+    {
+        if (sorted.empty())
+            return 0;
+        return sorted[std::min(
+            sorted.size() - 1,
+            static_cast<std::size_t>(q * sorted.size()))];
+    }
+
+    static std::string
+    micros(std::uint64_t ns)
+    {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(1) << (ns / 1000.);
+        return ss.str();
+    }
+
+    void
+    report(
+        std::string const& backend,
+        Params const& params,
+        Result& result,
+        std::ostream* output)
+    {
+        using std::setw;
+        auto const seconds =
+            std::chrono::duration<double>(result.elapsed).count();
+
+        for (auto& [op, latencies] : result.latencies)
+        {
+            if (latencies.empty())
+                continue;
+
+            std::sort(latencies.begin(), latencies.end());
+            auto const p50 = percentile(latencies, 0.50);
+            auto const p99 = percentile(latencies, 0.99);
+            auto const p999 = percentile(latencies, 0.999);
+            auto const rate = seconds > 0 ? latencies.size() / seconds : 0;
+
+            std::stringstream ss;
+            ss << std::left << setw(10) << backend << setw(10)
+               << result.workload << setw(14) << op << std::right << setw(8)
+               << params.threads << setw(10) << latencies.size() << setw(12)
+               << static_cast<std::uint64_t>(rate) << setw(10) << micros(p50)
+               << setw(10) << micros(p99) << setw(10) << micros(p999);
+            log << ss.str() << std::endl;
+
+            Json::Value json(Json::objectValue);
+            json["backend"] = backend;
+            json["workload"] = result.workload;
+            json["op"] = op;
+            json["threads"] = static_cast<Json::UInt>(params.threads);
+            json["items"] = static_cast<Json::UInt>(params.items);
+            json["count"] = static_cast<Json::UInt>(latencies.size());
+            json["seconds"] = seconds;
+            json["ops_per_second"] = rate;
+            json["p50_us"] = p50 / 1000.;
+            json["p99_us"] = p99 / 1000.;
+            json["p999_us"] = p999 / 1000.;
+            if (output)
+                *output << Json::to_string(json) << std::endl;
+            else
+                log << Json::to_string(json) << std::endl;
+        }
+    }
+
+    void
+    doBackend(
+        std::string const& config_string,
+        Params const& params,
+        std::ostream* output)
+    {
+        using namespace beast::severities;
+        test::SuiteJournal journal("Benchmark_test", *this);
+        DummyScheduler scheduler;
+
+        beast::temp_dir tempDir;
+        Section config = parse(config_string);
+        if (!config.exists("path"))
+            config.set("path", tempDir.path());
+        auto const type = get(config, "type", std::string());
+
+        std::vector<Mix> const mixes = {
+            {"close", 80, 15, 0, 5},
+            {"sync", 30, 5, 15, 50},
+            {"history", 0, 0, 90, 10}};
+
+        std::atomic<std::size_t> written{params.items};
+        auto backend = makeBackend(config, scheduler, journal);
+
+        {
+            auto result = doLoad(*backend, params);
+            report(type, params, result, output);
+        }
+        for (auto const& mix : mixes)
+        {
+            auto result = doMix(*backend, params, mix, written);
+            report(type, params, result, output);
+        }
+        {
+            auto result = doNodes(*backend, params);
+            report(type, params, result, output);
+        }
+        {
+            beast::temp_dir rotatedDir;
+            Section rotated = config;
+            rotated.set("path", rotatedDir.path());
+            auto fresh = makeBackend(rotated, scheduler, journal);
+            fresh->setDeletePath();
+
+            auto result = doRotate(*backend, *fresh, params, written);
+            report(type, params, result, output);
+            fresh->close();
+        }
+
+        backend->setDeletePath();
+        backend->close();
+    }
+
+    void
+    run() override
+    {
+        testcase("Benchmark", beast::unit_test::abort_on_fail);
+
+        std::string default_args =
+            "type=nudb"
+#if RIPPLE_ROCKSDB_AVAILABLE
+            ";type=rocksdb,open_files=2000,filter_bits=12,cache_mb=256,"
+            "file_size_mb=8,file_size_mult=2"
+#endif
+            ";type=memory";
+
+        auto args = arg().empty() ? default_args : arg();
+        std::vector<std::string> entries;
+        boost::split(entries, args, boost::algorithm::is_any_of(";"));
+
+        std::vector<std::string> config_strings;
+        std::vector<std::size_t> thread_counts = {1, 4, 8};
+        std::size_t items = default_items;
+        std::unique_ptr<std::ofstream> output;
+        for (auto const& entry : entries)
+        {
+            if (entry.empty())
+                continue;
+            if (entry.find("type=") != std::string::npos)
+                config_strings.push_back(entry);
+            else if (boost::starts_with(entry, "items="))
+                items = std::stoul(entry.substr(6));
+            else if (boost::starts_with(entry, "threads="))
+            {
+                std::vector<std::string> v;
+                auto const counts = entry.substr(8);
+                boost::split(v, counts, boost::algorithm::is_any_of(","));
+                thread_counts.clear();
+                for (auto const& n : v)
+                    thread_counts.push_back(std::stoul(n));
+            }
+            else if (boost::starts_with(entry, "output="))
+                output = std::make_unique<std::ofstream>(
+                    entry.substr(7), std::ios::app);
+            else
+                fail("unknown argument: " + entry);
+        }
+
+        {
+            using std::setw;
+            std::stringstream ss;
+            ss << std::left << setw(10) << "Backend" << setw(10) << "Workload"
+               << setw(14) << "Op" << std::right << setw(8) << "Threads"
+               << setw(10) << "Count" << setw(12) << "Ops/s" << setw(10)
+               << "p50 us" << setw(10) << "p99 us" << setw(10) << "p999 us";
+            log << ss.str() << std::endl;
+        }
+
+        for (auto const threads : thread_counts)
+            for (auto const& config_string : config_strings)
+                doBackend(config_string, {items, threads}, output.get());
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(Benchmark, NodeStore, ripple, 1);
+
+}  // namespace NodeStore
+}  // namespace ripple
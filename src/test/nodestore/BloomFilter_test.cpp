@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/nodestore/impl/BloomFilter.h>
+#include <ripple/protocol/digest.h>
+#include <test/unit_test/FileDirGuard.h>
+
+namespace ripple {
+namespace NodeStore {
+namespace tests {
+
+class BloomFilter_test : public beast::unit_test::suite
+{
+    static uint256
+    key(std::uint64_t n)
+    {
+        return sha512Half(n);
+    }
+
+    void
+    testInsert()
+    {
+        testcase("insert");
+        BloomFilter filter(1000);
+        BEAST_EXPECT(filter.enabled());
+        BEAST_EXPECT(!filter.complete());
+
+        for (std::uint64_t i = 0; i < 1000; ++i)
+            filter.insert(key(i));
+
+        bool all = true;
+        for (std::uint64_t i = 0; i < 1000; ++i)
+            all = all && filter.mayContain(key(i));
+        BEAST_EXPECT(all);
+
+        // An incomplete filter excludes nothing
+        int falsePositives = 0;
+        bool excluded = false;
+        for (std::uint64_t i = 1000; i < 11000; ++i)
+        {
+            falsePositives += filter.mayContain(key(i)) ? 1 : 0;
+            excluded = excluded || filter.excludes(key(i));
+        }
+        BEAST_EXPECT(!excluded);
+        BEAST_EXPECT(falsePositives < 200);
+
+        filter.setComplete(true);
+        int excludedCount = 0;
+        for (std::uint64_t i = 0; i < 11000; ++i)
+            excludedCount += filter.excludes(key(i)) ? 1 : 0;
+        BEAST_EXPECT(excludedCount == 10000 - falsePositives);
+    }
+
+    void
+    testDisabled()
+    {
+        testcase("disabled");
+        BloomFilter filter(0);
+        BEAST_EXPECT(!filter.enabled());
+        filter.setComplete(true);
+        filter.insert(key(1));
+        BEAST_EXPECT(!filter.excludes(key(2)));
+    }
+
+    void
+    testSaveLoad()
+    {
+        testcase("save and load");
+        using namespace boost::filesystem;
+        beast::Journal const j{beast::Journal::getNullSink()};
+        test::detail::DirGuard dir(*this, "bloom_filter_test");
+        auto const file = dir.subdir() / "filter";
+
+        BloomFilter filter(100);
+        for (std::uint64_t i = 0; i < 100; ++i)
+            filter.insert(key(i));
+
+        // Only a complete filter is saved
+        BEAST_EXPECT(!filter.save(file, j));
+        BEAST_EXPECT(!exists(file));
+        filter.setComplete(true);
+        BEAST_EXPECT(filter.save(file, j));
+        BEAST_EXPECT(exists(file));
+
+        BloomFilter loaded(100);
+        BEAST_EXPECT(loaded.load(file, j));
+        BEAST_EXPECT(loaded.complete());
+        BEAST_EXPECT(!exists(file));
+        bool same = true;
+        for (std::uint64_t i = 0; i < 1000; ++i)
+            same = same &&
+                loaded.mayContain(key(i)) == filter.mayContain(key(i));
+        BEAST_EXPECT(same);
+
+        // The file can only be loaded once
+        BloomFilter again(100);
+        BEAST_EXPECT(!again.load(file, j));
+        BEAST_EXPECT(!again.complete());
+
+        // A filter of another size isn't loaded
+        BEAST_EXPECT(filter.save(file, j));
+        BloomFilter other(100000);
+        BEAST_EXPECT(!other.load(file, j));
+        BEAST_EXPECT(!other.complete());
+        BEAST_EXPECT(!exists(file));
+    }
+
+public:
+    void
+    run() override
+    {
+        testInsert();
+        testDisabled();
+        testSaveLoad();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(BloomFilter, NodeStore, ripple);
+
+}  // namespace tests
+}  // namespace NodeStore
+}  // namespace ripple
@@ -20,13 +20,18 @@
 #include <ripple/beast/utility/temp_dir.h>
 #include <ripple/core/DatabaseCon.h>
 #include <ripple/nodestore/DummyScheduler.h>
+#include <ripple/nodestore/FetchSuspender.h>
 #include <ripple/nodestore/Manager.h>
+#include <ripple/nodestore/impl/DatabaseRotatingImp.h>
 #include <test/jtx.h>
 #include <test/jtx/CheckMessageLogs.h>
 #include <test/jtx/envconfig.h>
 #include <test/nodestore/TestBase.h>
 #include <test/unit_test/SuiteJournal.h>
 
+#include <condition_variable>
+#include <mutex>
+
 namespace ripple {
 
 namespace NodeStore {
@@ -443,6 +448,136 @@ public:
 
     //--------------------------------------------------------------------------
 
+    void
+    testColdTier(std::int64_t seedValue)
+    {
+        testcase("cold tier");
+
+        DummyScheduler scheduler;
+
+        auto makeBackend = [&](std::string const& name) {
+            Section section;
+            section.set("type", "memory");
+            section.set("path", "cold_tier_test_" + name);
+            auto backend = Manager::instance().make_Backend(
+                section, megabytes(4), scheduler, journal_);
+            backend->open();
+            return backend;
+        };
+
+        Section params;
+        params.set("type", "memory");
+        DatabaseRotatingImp db(
+            scheduler,
+            2,
+            makeBackend("writable"),
+            makeBackend("archive"),
+            params,
+            journal_,
+            makeBackend("cold"));
+
+        auto const older = createPredictableBatch(numObjectsToTest, seedValue);
+        auto const newer =
+            createPredictableBatch(numObjectsToTest, seedValue + 1);
+
+        storeBatch(db, older);
+        db.rotateWithLock([&](std::string const&) {
+            return makeBackend("writable2");
+        });
+        storeBatch(db, newer);
+        db.rotateWithLock([&](std::string const&) {
+            return makeBackend("writable3");
+        });
+
+        // The older objects were rotated out of the archive backend and
+        // moved to the cold backend
+        Batch copy;
+        fetchCopyOfBatch(*makeBackend("cold"), &copy, older);
+        BEAST_EXPECT(areBatchesEqual(older, copy));
+
+        // and both batches can still be fetched
+        fetchCopyOfBatch(db, &copy, older);
+        BEAST_EXPECT(areBatchesEqual(older, copy));
+        fetchCopyOfBatch(db, &copy, newer);
+        BEAST_EXPECT(areBatchesEqual(newer, copy));
+    }
+
+    //--------------------------------------------------------------------------
+
+    void
+    testSuspendedFetch(std::int64_t seedValue)
+    {
+        testcase("suspended fetch");
+
+        // Stands in for a coroutine by blocking until resumed
+        class Suspender : public FetchSuspender
+        {
+            std::mutex mutex_;
+            std::condition_variable cv_;
+            bool resumed_ = false;
+
+        public:
+            int suspends = 0;
+            int resumes = 0;
+
+            void
+            suspend() override
+            {
+                std::unique_lock lock(mutex_);
+                ++suspends;
+                cv_.wait(lock, [this] { return resumed_; });
+                resumed_ = false;
+            }
+
+            void
+            resume() override
+            {
+                std::lock_guard lock(mutex_);
+                ++resumes;
+                resumed_ = true;
+                cv_.notify_all();
+            }
+        };
+
+        DummyScheduler scheduler;
+        beast::temp_dir node_db;
+        Section nodeParams;
+        nodeParams.set("type", "nudb");
+        nodeParams.set("path", node_db.path());
+        std::unique_ptr<Database> db = Manager::instance().make_Database(
+            megabytes(4), scheduler, 2, nodeParams, journal_);
+
+        auto const batch = createPredictableBatch(numObjectsToTest, seedValue);
+        auto const missing = createPredictableBatch(1, seedValue + 1);
+        storeBatch(*db, batch);
+
+        Suspender suspender;
+        {
+            FetchSuspender::Scope scope(suspender);
+            BEAST_EXPECT(FetchSuspender::current() == &suspender);
+
+            Batch copy;
+            fetchCopyOfBatch(*db, &copy, batch);
+            BEAST_EXPECT(areBatchesEqual(batch, copy));
+            BEAST_EXPECT(!db->fetchNodeObject(missing[0]->getHash(), 0));
+        }
+        BEAST_EXPECT(FetchSuspender::current() == nullptr);
+
+        // Each fetch either completed before it could suspend, or
+        // suspended and was resumed once.
+        BEAST_EXPECT(suspender.suspends == suspender.resumes);
+        BEAST_EXPECT(suspender.suspends <= numObjectsToTest + 1);
+
+        // Fetches made without a suspender are unaffected
+        auto const before = suspender.suspends;
+        Batch copy;
+        fetchCopyOfBatch(*db, &copy, batch);
+        BEAST_EXPECT(areBatchesEqual(batch, copy));
+        BEAST_EXPECT(suspender.suspends == before);
+    }
+
+    //--------------------------------------------------------------------------
+
     void
     testImport(
         std::string const& destBackendType,
@@ -546,6 +681,39 @@ public:
                 fetchCopyOfBatch(*db, &copy, batch);
                 BEAST_EXPECT(areBatchesEqual(batch, copy));
             }
+
+            {
+                // Read it back through the read threads, which fetch
+                // queued requests in batches
+                std::mutex mutex;
+                std::condition_variable cv;
+                std::size_t pending = batch.size() + 1;
+                std::size_t found = 0;
+                auto const missing = createPredictableBatch(1, rng());
+
+                auto const request = [&](std::shared_ptr<NodeObject> const&
+                                             expected) {
+                    db->asyncFetch(
+                        expected->getHash(),
+                        0,
+                        [&, expected](
+                            std::shared_ptr<NodeObject> const& object) {
+                            std::lock_guard lock(mutex);
+                            if (object && isSame(object, expected))
+                                ++found;
+                            if (--pending == 0)
+                                cv.notify_all();
+                        });
+                };
+
+                for (auto const& object : batch)
+                    request(object);
+                request(missing.front());
+
+                std::unique_lock lock(mutex);
+                cv.wait(lock, [&] { return pending == 0; });
+                BEAST_EXPECT(found == batch.size());
+            }
         }
 
         if (testPersistence)
@@ -661,6 +829,10 @@ public:
 
         testNodeStore("memory", false, seedValue);
 
+        testColdTier(seedValue);
+
+        testSuspendedFetch(seedValue);
+
         // Persistent backend tests
         {
             testNodeStore("nudb", true, seedValue);
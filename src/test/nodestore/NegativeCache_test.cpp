@@ -0,0 +1,167 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/chrono.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/nodestore/impl/NegativeCache.h>
+
+namespace ripple {
+namespace NodeStore {
+namespace tests {
+
+class NegativeCache_test : public beast::unit_test::suite
+{
+    static uint256
+    key(std::uint64_t low, std::uint64_t high = 0)
+    {
+        // The slot of a key is given by its first bytes
+        uint256 k;
+        std::memcpy(k.data(), &low, sizeof(low));
+        std::memcpy(k.data() + sizeof(low), &high, sizeof(high));
+        return k;
+    }
+
+    void
+    testInsert()
+    {
+        testcase("insert");
+        using namespace std::chrono_literals;
+        TestStopwatch clock;
+        NegativeCache cache(16, 10s, clock);
+        BEAST_EXPECT(cache.enabled());
+
+        auto const a = key(1);
+        BEAST_EXPECT(!cache.contains(a));
+        cache.insert(a, cache.ticket(a));
+        BEAST_EXPECT(cache.contains(a));
+
+        // A key in the same slot replaces the first one
+        auto const b = key(1, 1);
+        BEAST_EXPECT(!cache.contains(b));
+        cache.insert(b, cache.ticket(b));
+        BEAST_EXPECT(cache.contains(b));
+        BEAST_EXPECT(!cache.contains(a));
+
+        // Keys in other slots are kept
+        auto const c = key(2);
+        cache.insert(c, cache.ticket(c));
+        BEAST_EXPECT(cache.contains(b));
+        BEAST_EXPECT(cache.contains(c));
+    }
+
+    void
+    testErase()
+    {
+        testcase("erase");
+        using namespace std::chrono_literals;
+        TestStopwatch clock;
+        NegativeCache cache(16, 10s, clock);
+
+        auto const a = key(3);
+        cache.insert(a, cache.ticket(a));
+        cache.erase(a);
+        BEAST_EXPECT(!cache.contains(a));
+
+        // Erasing another key of the slot leaves the entry alone
+        cache.insert(a, cache.ticket(a));
+        cache.erase(key(3, 1));
+        BEAST_EXPECT(cache.contains(a));
+
+        // A lookup that started before a store doesn't record its miss
+        auto const b = key(4);
+        auto const ticket = cache.ticket(b);
+        cache.erase(b);
+        cache.insert(b, ticket);
+        BEAST_EXPECT(!cache.contains(b));
+        cache.insert(b, cache.ticket(b));
+        BEAST_EXPECT(cache.contains(b));
+    }
+
+    void
+    testClear()
+    {
+        testcase("clear");
+        using namespace std::chrono_literals;
+        TestStopwatch clock;
+        NegativeCache cache(16, 10s, clock);
+
+        auto const a = key(5);
+        auto const b = key(6);
+        cache.insert(a, cache.ticket(a));
+        auto const ticket = cache.ticket(b);
+        cache.clear();
+        BEAST_EXPECT(!cache.contains(a));
+
+        // Lookups that started before the clear don't record their miss
+        cache.insert(b, ticket);
+        BEAST_EXPECT(!cache.contains(b));
+        cache.insert(a, cache.ticket(a));
+        BEAST_EXPECT(cache.contains(a));
+    }
+
+    void
+    testExpiry()
+    {
+        testcase("expiry");
+        using namespace std::chrono_literals;
+        TestStopwatch clock;
+        NegativeCache cache(16, 10s, clock);
+
+        auto const a = key(7);
+        cache.insert(a, cache.ticket(a));
+        clock.advance(9s);
+        BEAST_EXPECT(cache.contains(a));
+        clock.advance(1s);
+        BEAST_EXPECT(!cache.contains(a));
+    }
+
+    void
+    testDisabled()
+    {
+        testcase("disabled");
+        using namespace std::chrono_literals;
+        TestStopwatch clock;
+        for (auto const& [size, age] :
+             {std::pair{std::size_t{0}, 10s}, std::pair{std::size_t{16}, 0s}})
+        {
+            NegativeCache cache(size, age, clock);
+            BEAST_EXPECT(!cache.enabled());
+            auto const a = key(8);
+            cache.insert(a, cache.ticket(a));
+            BEAST_EXPECT(!cache.contains(a));
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testInsert();
+        testErase();
+        testClear();
+        testExpiry();
+        testDisabled();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(NegativeCache, NodeStore, ripple);
+
+}  // namespace tests
+}  // namespace NodeStore
+}  // namespace ripple
@@ -197,7 +197,8 @@ public:
         {
             std::shared_ptr<NodeObject> const object(batch[i]);
 
-            Blob data(object->getData());
+            auto const slice = object->getData();
+            Blob data(slice.begin(), slice.end());
 
             db.store(
                 object->getType(),
@@ -0,0 +1,217 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/overlay/impl/SendQueue.h>
+#include <ripple/overlay/impl/Tuning.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/protocol/messages.h>
+
+#include <string>
+
+namespace ripple {
+namespace test {
+
+class SendQueue_test : public beast::unit_test::suite
+{
+    using Class = SendQueue::Class;
+
+    static constexpr auto off = compression::Compressed::Off;
+
+    // A message of the given type, with a payload of about `bytes`.
+    static std::shared_ptr<Message>
+    make(int type, std::size_t bytes = 16)
+    {
+        protocol::TMValidation m;
+        m.set_validation(std::string(bytes, 'x'));
+        return std::make_shared<Message>(m, type);
+    }
+
+    // Start and finish a write, returning the class and size of the batch.
+    static std::pair<Class, std::size_t>
+    write(SendQueue& q)
+    {
+        auto const& batch = q.startWrite(off);
+        auto const result = std::make_pair(
+            SendQueue::classify(batch.front()->getType()), batch.size());
+        q.finishWrite();
+        return result;
+    }
+
+    void
+    testClassify()
+    {
+        testcase("classify");
+
+        using SQ = SendQueue;
+        BEAST_EXPECT(
+            SQ::classify(protocol::mtPROPOSE_LEDGER) == Class::consensus);
+        BEAST_EXPECT(SQ::classify(protocol::mtMANIFESTS) == Class::consensus);
+        BEAST_EXPECT(
+            SQ::classify(protocol::mtVALIDATION) == Class::validations);
+        BEAST_EXPECT(
+            SQ::classify(protocol::mtTRANSACTION) == Class::transactions);
+        BEAST_EXPECT(
+            SQ::classify(protocol::mtLEDGER_DATA) == Class::ledgerData);
+        BEAST_EXPECT(
+            SQ::classify(protocol::mtHAVE_TRANSACTIONS) == Class::inventory);
+        BEAST_EXPECT(SQ::classify(protocol::mtGET_LEDGER) == Class::inventory);
+    }
+
+    void
+    testPriority()
+    {
+        testcase("priority");
+
+        SendQueue q;
+        q.push(make(protocol::mtHAVE_TRANSACTIONS));
+        q.push(make(protocol::mtLEDGER_DATA));
+        q.push(make(protocol::mtTRANSACTION));
+        q.push(make(protocol::mtVALIDATION));
+        q.push(make(protocol::mtPROPOSE_LEDGER));
+        BEAST_EXPECT(q.size() == 5);
+        BEAST_EXPECT(q.depth(Class::ledgerData) == 1);
+
+        auto const& batch = q.startWrite(off);
+        BEAST_EXPECT(q.writing());
+        BEAST_EXPECT(batch.size() == 1);
+        BEAST_EXPECT(batch.front()->getType() == protocol::mtPROPOSE_LEDGER);
+
+        // Messages being written still count towards the size.
+        BEAST_EXPECT(q.size() == 5);
+        BEAST_EXPECT(q.depth(Class::consensus) == 0);
+        q.finishWrite();
+        BEAST_EXPECT(!q.writing());
+        BEAST_EXPECT(q.size() == 4);
+
+        BEAST_EXPECT(write(q).first == Class::validations);
+        BEAST_EXPECT(write(q).first == Class::transactions);
+        BEAST_EXPECT(write(q).first == Class::ledgerData);
+        BEAST_EXPECT(write(q).first == Class::inventory);
+        BEAST_EXPECT(q.empty());
+    }
+
+    void
+    testCoalesce()
+    {
+        testcase("coalesce");
+
+        SendQueue q;
+        std::size_t const batch = Tuning::sendBatchMessages;
+        for (std::size_t i = 0; i != batch + 8; ++i)
+            q.push(make(protocol::mtTRANSACTION));
+        q.push(make(protocol::mtHAVE_TRANSACTIONS));
+
+        // Writes take one class at a time, up to the batch limit.
+        BEAST_EXPECT(write(q) == std::make_pair(Class::transactions, batch));
+        BEAST_EXPECT(
+            write(q) == std::make_pair(Class::transactions, std::size_t{8}));
+        BEAST_EXPECT(
+            write(q) == std::make_pair(Class::inventory, std::size_t{1}));
+
+        // Ledger data is also limited by size, but a write always takes
+        // at least one message.
+        std::size_t const big = Tuning::sendBatchLedgerDataBytes * 3 / 4;
+        for (int i = 0; i != 3; ++i)
+            q.push(make(protocol::mtLEDGER_DATA, big));
+        for (int i = 0; i != 3; ++i)
+            BEAST_EXPECT(
+                write(q) == std::make_pair(Class::ledgerData, std::size_t{1}));
+
+        q.push(make(protocol::mtLEDGER_DATA, big * 2));
+        for (int i = 0; i != 4; ++i)
+            q.push(make(protocol::mtLEDGER_DATA, big / 4));
+        BEAST_EXPECT(
+            write(q) == std::make_pair(Class::ledgerData, std::size_t{1}));
+        BEAST_EXPECT(
+            write(q) == std::make_pair(Class::ledgerData, std::size_t{4}));
+        BEAST_EXPECT(q.empty());
+    }
+
+    void
+    testWeights()
+    {
+        testcase("weights");
+
+        // With every class backlogged, each gets as many writes in a
+        // round as its weight.
+        SendQueue q;
+        int const types[] = {
+            protocol::mtPROPOSE_LEDGER,
+            protocol::mtVALIDATION,
+            protocol::mtTRANSACTION,
+            protocol::mtLEDGER_DATA,
+            protocol::mtHAVE_TRANSACTIONS};
+        for (auto type : types)
+            for (std::size_t i = 0; i != 100 * Tuning::sendBatchMessages; ++i)
+                q.push(make(type));
+
+        std::uint32_t round = 0;
+        for (auto w : SendQueue::weights)
+            round += w;
+
+        std::array<std::uint32_t, SendQueue::classCount> writes{};
+        for (std::uint32_t i = 0; i != 3 * round; ++i)
+            ++writes[static_cast<std::size_t>(write(q).first)];
+        for (std::size_t c = 0; c != SendQueue::classCount; ++c)
+            BEAST_EXPECT(writes[c] == 3 * SendQueue::weights[c]);
+
+        // A class with nothing queued does not hold up the others.
+        SendQueue r;
+        for (std::size_t i = 0; i != 20; ++i)
+            r.push(make(protocol::mtLEDGER_DATA, 1));
+        r.push(make(protocol::mtVALIDATION));
+        BEAST_EXPECT(write(r).first == Class::validations);
+        BEAST_EXPECT(write(r).first == Class::ledgerData);
+        BEAST_EXPECT(r.empty());
+    }
+
+    void
+    testJson()
+    {
+        testcase("json");
+
+        SendQueue q;
+        q.push(make(protocol::mtVALIDATION));
+        q.push(make(protocol::mtVALIDATION));
+        q.push(make(protocol::mtGET_LEDGER));
+        auto const j = q.json();
+        BEAST_EXPECT(j[jss::consensus] == 0);
+        BEAST_EXPECT(j[jss::validations] == 2);
+        BEAST_EXPECT(j[jss::transactions] == 0);
+        BEAST_EXPECT(j[jss::ledger_data] == 0);
+        BEAST_EXPECT(j[jss::inventory] == 1);
+    }
+
+public:
+    void
+    run() override
+    {
+        testClassify();
+        testPriority();
+        testCoalesce();
+        testWeights();
+        testJson();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SendQueue, overlay, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,188 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/overlay/impl/TxRelayFanout.h>
+#include <ripple/protocol/jss.h>
+
+#include <random>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+class TxRelayFanout_test : public beast::unit_test::suite
+{
+    using clock_type = TxRelayFanout::clock_type;
+
+    // Count transactions so that each new one is received `copies` times.
+    static void
+    receive(TxRelayFanout& fanout, std::size_t txs, std::size_t copies)
+    {
+        for (std::size_t i = 0; i < txs; ++i)
+        {
+            fanout.received(false);
+            for (std::size_t c = 1; c < copies; ++c)
+                fanout.received(true);
+        }
+    }
+
+    void
+    testFixed()
+    {
+        testcase("fixed");
+
+        TxRelayFanout fanout(25, 0);
+        auto now = clock_type::now();
+        receive(fanout, 1000, 8);
+        for (int i = 0; i < 5; ++i)
+        {
+            now += TxRelayFanout::interval;
+            BEAST_EXPECT(fanout.percentage(now) == 25);
+        }
+        BEAST_EXPECT(fanout.json()[jss::target_redundancy] == "0");
+    }
+
+    void
+    testAdjust()
+    {
+        testcase("adjust");
+
+        auto constexpr step = TxRelayFanout::step;
+        TxRelayFanout fanout(50, 4);
+        auto now = clock_type::now() + TxRelayFanout::interval;
+
+        // Nothing changes before the interval ends.
+        receive(fanout, 100, 8);
+        BEAST_EXPECT(fanout.percentage(clock_type::now()) == 50);
+
+        // Too many copies: relay to fewer peers.
+        BEAST_EXPECT(fanout.percentage(now) == 50 - step);
+        BEAST_EXPECT(fanout.json()[jss::redundancy] == "8.00");
+
+        // Within the band around the target: no change.
+        now += TxRelayFanout::interval;
+        receive(fanout, 100, 4);
+        BEAST_EXPECT(fanout.percentage(now) == 50 - step);
+
+        // Too few copies: relay to more peers.
+        now += TxRelayFanout::interval;
+        receive(fanout, 100, 2);
+        BEAST_EXPECT(fanout.percentage(now) == 50);
+        BEAST_EXPECT(fanout.json()[jss::redundancy] == "2.00");
+
+        // Too few samples to judge; they are kept for the next interval.
+        now += TxRelayFanout::interval;
+        receive(fanout, TxRelayFanout::minSamples / 2, 8);
+        BEAST_EXPECT(fanout.percentage(now) == 50);
+        now += TxRelayFanout::interval;
+        receive(fanout, TxRelayFanout::minSamples / 2, 8);
+        BEAST_EXPECT(fanout.percentage(now) == 50 - step);
+    }
+
+    void
+    testBounds()
+    {
+        testcase("bounds");
+
+        TxRelayFanout fanout(15, 3);
+        auto now = clock_type::now();
+        for (int i = 0; i < 10; ++i)
+        {
+            now += TxRelayFanout::interval;
+            receive(fanout, 100, 10);
+            fanout.percentage(now);
+        }
+        BEAST_EXPECT(
+            fanout.percentage(now) == TxRelayFanout::minPercentage);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            now += TxRelayFanout::interval;
+            receive(fanout, 100, 1);
+            fanout.percentage(now);
+        }
+        BEAST_EXPECT(
+            fanout.percentage(now) == TxRelayFanout::maxPercentage);
+        BEAST_EXPECT(fanout.json()[jss::relay_percentage] == "100");
+    }
+
+    void
+    testRatio()
+    {
+        testcase("ratio");
+
+        std::uint32_t ratio = 0;
+        for (int i = 0; i < 200; ++i)
+            ratio = TxRelayFanout::updateRatio(ratio, true);
+        BEAST_EXPECT(ratio > TxRelayFanout::ratioScale * 99 / 100);
+        BEAST_EXPECT(ratio <= TxRelayFanout::ratioScale);
+
+        for (int i = 0; i < 200; ++i)
+            ratio = TxRelayFanout::updateRatio(ratio, false);
+        BEAST_EXPECT(ratio < TxRelayFanout::ratioScale / 100);
+    }
+
+    void
+    testShuffle()
+    {
+        testcase("shuffle");
+
+        // Half the peers only ever send duplicates. They should be
+        // picked among the first half much less often than the others.
+        std::mt19937 engine(42);
+        std::size_t const peers = 20;
+        std::size_t noisyFirst = 0;
+        for (int round = 0; round < 1000; ++round)
+        {
+            std::vector<std::size_t> order(peers);
+            for (std::size_t i = 0; i < peers; ++i)
+                order[i] = i;
+
+            TxRelayFanout::shuffle(
+                order,
+                [](std::size_t p) -> std::uint32_t {
+                    return p % 2 ? TxRelayFanout::ratioScale : 0;
+                },
+                engine);
+
+            BEAST_EXPECT(order.size() == peers);
+            for (std::size_t i = 0; i < peers / 2; ++i)
+                noisyFirst += order[i] % 2;
+        }
+        BEAST_EXPECT(noisyFirst < 1000 * peers / 2 / 4);
+        BEAST_EXPECT(noisyFirst > 0);
+    }
+
+public:
+    void
+    run() override
+    {
+        testFixed();
+        testAdjust();
+        testBounds();
+        testRatio();
+        testShuffle();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(TxRelayFanout, overlay, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -85,13 +85,14 @@ public:
         std::shared_ptr<T> proto,
         protocol::MessageType mt,
         uint16_t nbuffers,
-        std::string msg)
+        std::string msg,
+        Algorithm algorithm = Algorithm::LZ4)
     {
         testcase("Compress/Decompress: " + msg);
 
         Message m(*proto, mt);
 
-        auto& buffer = m.getBuffer(Compressed::On);
+        auto& buffer = m.getBuffer(Compressed::On, algorithm);
 
         boost::beast::multi_buffer buffers;
 
@@ -129,12 +130,21 @@ public:
             stream,
             header->payload_wire_size,
             decompressed.data(),
-            header->uncompressed_size);
+            header->uncompressed_size,
+            header->algorithm);
         BEAST_EXPECT(decompressedSize == header->uncompressed_size);
         auto const proto1 = std::make_shared<T>();
 
         BEAST_EXPECT(
             proto1->ParseFromArray(decompressed.data(), decompressedSize));
+
+        // Large messages are parsed onto an arena.
+        auto const proto2 = ripple::detail::parseMessageContent<T>(
+            *header, buffers.data(), true);
+        BEAST_EXPECT(proto2 && proto2->GetArena() != nullptr);
+        BEAST_EXPECT(
+            proto2 &&
+            proto2->SerializeAsString() == proto1->SerializeAsString());
         auto uncompressed = m.getBuffer(Compressed::Off);
         BEAST_EXPECT(std::equal(
             uncompressed.begin() + ripple::compression::headerBytes,
@@ -462,6 +472,54 @@ public:
             "TMValidatorListCollection");
     }
 
+    void
+    testZstd()
+    {
+        auto thresh = beast::severities::Severity::kInfo;
+        auto logs = std::make_unique<Logs>(thresh);
+
+        doTest(
+            buildManifests(100),
+            protocol::mtMANIFESTS,
+            4,
+            "zstd TMManifests100",
+            Algorithm::ZSTD);
+        doTest(
+            buildLedgerData(1000, *logs),
+            protocol::mtLEDGER_DATA,
+            20,
+            "zstd TMLedgerData1000",
+            Algorithm::ZSTD);
+        doTest(
+            buildGetObjectByHash(),
+            protocol::mtGET_OBJECTS,
+            4,
+            "zstd TMGetObjectByHash",
+            Algorithm::ZSTD);
+
+        testcase("Algorithm selection");
+        // The algorithm used for a message sent to a peer accepting `accepted`
+        auto sentWith = [](Message& m, Algorithm accepted) {
+            auto const& buffer = m.getBuffer(Compressed::On, accepted);
+            return (buffer[0] & 0x80)
+                ? static_cast<Algorithm>(buffer[0] & 0xF0)
+                : Algorithm::None;
+        };
+        // Bulk messages use zstd when the peer accepts it.
+        Message ledgerData(
+            *buildLedgerData(1000, *logs), protocol::mtLEDGER_DATA);
+        BEAST_EXPECT(sentWith(ledgerData, Algorithm::ZSTD) == Algorithm::ZSTD);
+        BEAST_EXPECT(sentWith(ledgerData, Algorithm::LZ4) == Algorithm::LZ4);
+        // Other message types, and small messages, stay on LZ4.
+        Message endpoints(*buildEndpoints(100), protocol::mtENDPOINTS);
+        BEAST_EXPECT(sentWith(endpoints, Algorithm::ZSTD) == Algorithm::LZ4);
+        Message manifests(*buildManifests(1), protocol::mtMANIFESTS);
+        BEAST_EXPECT(
+            manifests.getBufferSize() <
+            compression::zstdMinBytes + compression::headerBytes);
+        BEAST_EXPECT(sentWith(manifests, Algorithm::ZSTD) != Algorithm::ZSTD);
+    }
+
     void
     testHandshake()
     {
@@ -493,7 +551,8 @@ public:
                 env->app().config().COMPRESSION,
                 false,
                 env->app().config().TX_REDUCE_RELAY_ENABLE,
-                env->app().config().VP_REDUCE_RELAY_ENABLE);
+                env->app().config().VP_REDUCE_RELAY_ENABLE,
+                false);
             http_request_type http_request;
             http_request.version(request.version());
             http_request.base() = request.base();
@@ -505,6 +564,10 @@ public:
             auto const inboundEnabled = peerFeatureEnabled(
                 http_request, FEATURE_COMPR, "lz4", inboundEnable);
             BEAST_EXPECT(!(peerEnabled ^ inboundEnabled));
+            BEAST_EXPECT(
+                inboundEnabled ==
+                peerFeatureEnabled(
+                    http_request, FEATURE_COMPR, "zstd", inboundEnable));
 
             env.reset();
             env = getEnv(inboundEnable);
@@ -522,6 +585,10 @@ public:
             auto const outboundEnabled = peerFeatureEnabled(
                 http_resp, FEATURE_COMPR, "lz4", outboundEnable);
             BEAST_EXPECT(!(peerEnabled ^ outboundEnabled));
+            BEAST_EXPECT(
+                outboundEnabled ==
+                peerFeatureEnabled(
+                    http_resp, FEATURE_COMPR, "zstd", outboundEnable));
         };
         handshake(1, 1);
         handshake(1, 0);
@@ -533,6 +600,7 @@ public:
     run() override
     {
         testProtocol();
+        testZstd();
         testHandshake();
     }
 };
@@ -0,0 +1,360 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/overlay/Message.h>
+#include <ripple/overlay/impl/ProtocolMessage.h>
+#include <ripple/overlay/impl/SendQueue.h>
+#include <ripple/protocol/messages.h>
+
+#include <boost/asio.hpp>
+#include <boost/beast/core/multi_buffer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <ctime>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+/** Measures the throughput of the peer protocol's send and receive paths.
+
+    Each pair of peers is connected over loopback. One side serializes,
+    compresses and queues a mix of the messages a busy server relays, then
+    writes the batches its SendQueue chooses. The other side reads them and
+    parses them with invokeProtocolMessage, as PeerImp does. The handshake
+    and TLS are left out, since they cost nothing per message.
+
+    For each compression setting, this reports messages and bytes per
+    second, the latency from queueing a message to parsing it, and the CPU
+    time used per message by both sides together.
+*/
+class overlay_bench_test : public beast::unit_test::suite
+{
+    using clock_type = std::chrono::steady_clock;
+    using socket_type = boost::asio::ip::tcp::socket;
+    using Compressed = compression::Compressed;
+    using Algorithm = compression::Algorithm;
+
+    static constexpr std::size_t pairs = 4;
+    static constexpr std::size_t messagesPerPair = 20000;
+
+    // The messages a busy peer has queued at any time
+    static constexpr std::size_t backlog = 64;
+
+    // When each queued message was sent. Messages of one class arrive in
+    // the order they were queued.
+    struct Stamps
+    {
+        std::mutex mutex;
+        std::array<std::deque<clock_type::time_point>, SendQueue::classCount>
+            sent;
+
+        void
+        push(int type)
+        {
+            std::lock_guard lock(mutex);
+            sent[static_cast<std::size_t>(SendQueue::classify(type))]
+                .push_back(clock_type::now());
+        }
+
+        clock_type::time_point
+        pop(int type)
+        {
+            std::lock_guard lock(mutex);
+            auto& q = sent[static_cast<std::size_t>(SendQueue::classify(type))];
+            auto const t = q.front();
+            q.pop_front();
+            return t;
+        }
+    };
+
+    // Receives messages like PeerImp, recording when each one is parsed.
+    struct Handler
+    {
+        Stamps& stamps;
+        std::vector<std::chrono::microseconds>& latencies;
+
+        bool
+        compressionEnabled() const
+        {
+            return true;
+        }
+
+        void
+        onMessageUnknown(std::uint16_t)
+        {
+        }
+
+        void
+        onMessageBegin(
+            std::uint16_t,
+            std::shared_ptr<::google::protobuf::Message> const&,
+            std::size_t,
+            std::size_t,
+            bool)
+        {
+        }
+
+        template <class T>
+        void
+        onMessage(std::shared_ptr<T> const&)
+        {
+        }
+
+        void
+        onMessageEnd(
+            std::uint16_t type,
+            std::shared_ptr<::google::protobuf::Message> const&)
+        {
+            latencies.push_back(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    clock_type::now() - stamps.pop(type)));
+        }
+
+        // PeerImp parses large messages in a job; here it's done in line.
+        template <class T>
+        void
+        onMessageDeferred(
+            detail::MessageHeader const& header,
+            std::vector<std::uint8_t>&& message)
+        {
+            if (detail::parseMessageContent<T>(
+                    header, boost::asio::buffer(message), true))
+                onMessageEnd(header.message_type, nullptr);
+        }
+    };
+
+    // Random bytes, like hashes and signatures, followed by bytes which
+    // repeat, like the common fields of serialized objects.
+    static std::string
+    bytes(std::mt19937& rng, std::size_t random, std::size_t repeated)
+    {
+        std::string s(random + repeated, '\0');
+        for (std::size_t i = 0; i < random; ++i)
+            s[i] = static_cast<char>(rng());
+        for (std::size_t i = 0; i < repeated; ++i)
+            s[random + i] = static_cast<char>(i % 24);
+        return s;
+    }
+
+    // The i-th message of a mix which is mostly transactions, with the
+    // validations, proposals and ledger data that come with them.
+    static std::shared_ptr<Message>
+    makeMessage(std::mt19937& rng, std::size_t i)
+    {
+        auto const n = i % 100;
+
+        if (n < 60)
+        {
+            protocol::TMTransaction m;
+            m.set_rawtransaction(bytes(rng, 140, 110));
+            m.set_status(protocol::tsNEW);
+            return std::make_shared<Message>(m, protocol::mtTRANSACTION);
+        }
+
+        if (n < 80)
+        {
+            protocol::TMValidation m;
+            m.set_validation(bytes(rng, 170, 60));
+            return std::make_shared<Message>(m, protocol::mtVALIDATION);
+        }
+
+        if (n < 95)
+        {
+            protocol::TMProposeSet m;
+            m.set_proposeseq(1);
+            m.set_currenttxhash(bytes(rng, 32, 0));
+            m.set_nodepubkey(bytes(rng, 33, 0));
+            m.set_closetime(static_cast<std::uint32_t>(i));
+            m.set_signature(bytes(rng, 72, 0));
+            m.set_previousledger(bytes(rng, 32, 0));
+            return std::make_shared<Message>(m, protocol::mtPROPOSE_LEDGER);
+        }
+
+        protocol::TMLedgerData m;
+        m.set_ledgerhash(bytes(rng, 32, 0));
+        m.set_ledgerseq(static_cast<std::uint32_t>(i));
+        m.set_type(protocol::liAS_NODE);
+        for (int node = 0; node < 200; ++node)
+        {
+            auto ln = m.add_nodes();
+            ln->set_nodeid(bytes(rng, 33, 0));
+            ln->set_nodedata(bytes(rng, 100, 200));
+        }
+        return std::make_shared<Message>(m, protocol::mtLEDGER_DATA);
+    }
+
+    static std::size_t
+    send(
+        socket_type& socket,
+        Stamps& stamps,
+        Compressed compressed,
+        Algorithm algorithm)
+    {
+        std::mt19937 rng;
+        SendQueue queue;
+        std::size_t bytes = 0;
+        std::size_t queued = 0;
+
+        std::vector<boost::asio::const_buffer> buffers;
+        while (queued < messagesPerPair || !queue.empty())
+        {
+            while (queued < messagesPerPair && queue.size() < backlog)
+            {
+                auto m = makeMessage(rng, queued++);
+                stamps.push(m->getType());
+                queue.push(m);
+            }
+
+            buffers.clear();
+            for (auto const& m : queue.startWrite(compressed, algorithm))
+            {
+                auto const& buffer = m->getBuffer(compressed, algorithm);
+                buffers.push_back(boost::asio::buffer(buffer));
+                bytes += buffer.size();
+            }
+            boost::asio::write(socket, buffers);
+            queue.finishWrite();
+        }
+
+        socket.shutdown(socket_type::shutdown_send);
+        return bytes;
+    }
+
+    static void
+    receive(socket_type& socket, Handler& handler)
+    {
+        boost::beast::multi_buffer buffer;
+        std::size_t hint = 0;
+        for (;;)
+        {
+            boost::system::error_code ec;
+            auto const n = socket.read_some(
+                buffer.prepare(std::max<std::size_t>(hint, 16384)), ec);
+            if (ec)
+                break;
+            buffer.commit(n);
+
+            for (;;)
+            {
+                auto const [used, error] =
+                    invokeProtocolMessage(buffer.data(), handler, hint);
+                if (error || used == 0)
+                    break;
+                buffer.consume(used);
+            }
+        }
+    }
+
+    void
+    measure(std::string const& name, Compressed compressed, Algorithm algorithm)
+    {
+        boost::asio::io_context io;
+        boost::asio::ip::tcp::acceptor acceptor(
+            io, {boost::asio::ip::address_v4::loopback(), 0});
+
+        std::vector<socket_type> senders;
+        std::vector<socket_type> receivers;
+        for (std::size_t i = 0; i < pairs; ++i)
+        {
+            senders.emplace_back(io);
+            senders.back().connect(acceptor.local_endpoint());
+            senders.back().set_option(boost::asio::ip::tcp::no_delay(true));
+            receivers.push_back(acceptor.accept());
+        }
+
+        std::array<Stamps, pairs> stamps;
+        std::array<std::vector<std::chrono::microseconds>, pairs> latencies;
+        std::array<std::size_t, pairs> bytes{};
+
+        auto const cpuStart = std::clock();
+        auto const start = clock_type::now();
+        {
+            std::vector<std::thread> threads;
+            for (std::size_t i = 0; i < pairs; ++i)
+            {
+                latencies[i].reserve(messagesPerPair);
+                threads.emplace_back([&, i]() {
+                    bytes[i] =
+                        send(senders[i], stamps[i], compressed, algorithm);
+                });
+                threads.emplace_back([&, i]() {
+                    Handler handler{stamps[i], latencies[i]};
+                    receive(receivers[i], handler);
+                });
+            }
+            for (auto& t : threads)
+                t.join();
+        }
+        std::chrono::duration<double> const elapsed =
+            clock_type::now() - start;
+        auto const cpu =
+            static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+        std::vector<std::chrono::microseconds> all;
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < pairs; ++i)
+        {
+            all.insert(all.end(), latencies[i].begin(), latencies[i].end());
+            total += bytes[i];
+        }
+
+        if (!BEAST_EXPECT(all.size() == pairs * messagesPerPair))
+            return;
+
+        std::sort(all.begin(), all.end());
+        auto const percentile = [&all](std::size_t p) {
+            return all[std::min(all.size() - 1, all.size() * p / 100)].count();
+        };
+
+        auto const rate = [&elapsed](double n) {
+            return static_cast<std::size_t>(n / elapsed.count());
+        };
+
+        log << name << ": " << rate(all.size()) << " msg/s, "
+            << rate(total / 1024.0) << " KiB/s, latency us p50 "
+            << percentile(50) << " p90 " << percentile(90) << " p99 "
+            << percentile(99) << ", CPU us/msg " << cpu * 1e6 / all.size()
+            << std::endl;
+    }
+
+public:
+    void
+    run() override
+    {
+        log << pairs << " peer pairs, " << messagesPerPair
+            << " messages each" << std::endl;
+        measure("uncompressed", Compressed::Off, Algorithm::LZ4);
+        measure("lz4", Compressed::On, Algorithm::LZ4);
+        measure("zstd", Compressed::On, Algorithm::ZSTD);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(overlay_bench, overlay, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -28,8 +28,10 @@
 
 #include <boost/thread.hpp>
 
+#include <atomic>
 #include <numeric>
 #include <optional>
+#include <thread>
 
 namespace ripple {
 
@@ -1489,6 +1491,77 @@ vp_squelched=1
         });
     }
 
+    void
+    testConcurrentSlots(bool log)
+    {
+        doTest("Concurrent Slots", log, [&](bool log) {
+            struct Handler : public reduce_relay::SquelchHandler
+            {
+                void
+                squelch(PublicKey const&, Peer::id_t, std::uint32_t)
+                    const override
+                {
+                    ++squelched_;
+                }
+                void
+                unsquelch(PublicKey const&, Peer::id_t) const override
+                {
+                }
+                mutable std::atomic<int> squelched_{0};
+            };
+            Handler handler;
+            reduce_relay::Slots<ManualClock> slots(env_.app().logs(), handler);
+
+            // Each thread drives its own validator's slot from counting
+            // to peer selection while the other threads do the same.
+            int constexpr nValidators = 8;
+            int constexpr nPeers = 20;
+            std::vector<PublicKey> validators;
+            for (int v = 0; v < nValidators; ++v)
+                validators.push_back(
+                    std::get<0>(randomKeyPair(KeyType::ed25519)));
+
+            std::vector<std::thread> threads;
+            for (int v = 0; v < nValidators; ++v)
+            {
+                threads.emplace_back([&, v]() {
+                    for (int m = 1;
+                         m <= reduce_relay::MAX_MESSAGE_THRESHOLD + 2;
+                         ++m)
+                    {
+                        for (int peer = 0; peer < nPeers; ++peer)
+                        {
+                            std::uint64_t mid =
+                                (v + 1) * 1000000 + m * 1000 + peer;
+                            slots.updateSlotAndSquelch(
+                                uint256{mid},
+                                validators[v],
+                                peer,
+                                protocol::MessageType::mtVALIDATION);
+                        }
+                    }
+                });
+            }
+            for (auto& t : threads)
+                t.join();
+
+            for (auto const& validator : validators)
+            {
+                BEAST_EXPECT(slots.inState(
+                    validator, reduce_relay::SlotState::Selected));
+                BEAST_EXPECT(
+                    slots.getSelected(validator).size() ==
+                    reduce_relay::MAX_SELECTED_PEERS);
+            }
+            BEAST_EXPECT(
+                handler.squelched_ ==
+                nValidators * (nPeers - reduce_relay::MAX_SELECTED_PEERS));
+
+            // make Slot's internal hash router expire all messages
+            ManualClock::advance(hours(1));
+        });
+    }
+
     void
     testHandshake(bool log)
     {
@@ -1518,7 +1591,8 @@ vp_squelched=1
                     env_.app().config().COMPRESSION,
                     false,
                     env_.app().config().TX_REDUCE_RELAY_ENABLE,
-                    env_.app().config().VP_REDUCE_RELAY_ENABLE);
+                    env_.app().config().VP_REDUCE_RELAY_ENABLE,
+                    false);
                 http_request_type http_request;
                 http_request.version(request.version());
                 http_request.base() = request.base();
@@ -1576,6 +1650,7 @@ public:
         testSelectedPeerStopsRelaying(log);
         testInternalHashRouter(log);
         testRandomSquelch(log);
+        testConcurrentSlots(log);
         testHandshake(log);
     }
 };
@@ -87,6 +87,26 @@ private:
             test(false, false, 20, 101, false);
             test(false, false, 9, 10, false);
             test(false, false, 10, 9, false);
+
+            auto testTarget = [&](std::size_t target, bool success) {
+                Config c;
+                try
+                {
+                    c.loadFromString(
+                        "[reduce_relay]\ntx_target_redundancy=" +
+                        std::to_string(target) + "\n");
+                    BEAST_EXPECT(success);
+                    BEAST_EXPECT(c.TX_TARGET_REDUNDANCY == target);
+                }
+                catch (...)
+                {
+                    BEAST_EXPECT(!success);
+                }
+            };
+
+            testTarget(0, true);
+            testTarget(1, false);
+            testTarget(3, true);
         });
     }
 
@@ -140,7 +160,8 @@ private:
         }
         inline static std::size_t sid_ = 0;
         inline static std::uint16_t queueTx_ = 0;
-        inline static std::uint16_t sendTx_ = 0;
+        // Batches are sent from the peer's strand
+        inline static std::atomic<std::uint16_t> sendTx_ = 0;
     };
 
     std::uint16_t lid_{0};
@@ -160,18 +181,19 @@ private:
     addPeer(
         jtx::Env& env,
         std::vector<std::shared_ptr<PeerTest>>& peers,
-        std::uint16_t& nDisabled)
+        std::uint16_t& nDisabled,
+        bool txBatch = false,
+        boost::asio::io_service* ios = nullptr)
     {
         auto& overlay = dynamic_cast<OverlayImpl&>(env.app().overlay());
         boost::beast::http::request<boost::beast::http::dynamic_body> request;
         (nDisabled == 0)
             ? (void)request.insert(
                   "X-Protocol-Ctl",
-                  makeFeaturesRequestHeader(false, false, true, false))
+                  makeFeaturesRequestHeader(false, false, true, false, txBatch))
             : (void)nDisabled--;
         auto stream_ptr = std::make_unique<stream_type>(
-            socket_type(std::forward<boost::asio::io_service&>(
-                env.app().getIOService())),
+            socket_type(ios ? *ios : env.app().getIOService()),
             *context_);
         beast::IP::Endpoint local(
             beast::IP::Address::from_string("172.1.1." + std::to_string(lid_)));
@@ -229,12 +251,71 @@ private:
             PeerTest::queueTx_ == expectQueue);
     }
 
+    void
+    testBatch()
+    {
+        testcase("batch");
+        // The peers run on an io_service that only this test polls, so
+        // the batch delay timer never fires while the test is checking.
+        boost::asio::io_service ios;
+        jtx::Env env(*this);
+        std::vector<std::shared_ptr<PeerTest>> peers;
+        env.app().config().TX_RELAY_BATCH = true;
+        PeerTest::init();
+        lid_ = 0;
+        rid_ = 0;
+        std::uint16_t nDisabled = 0;
+        for (int i = 0; i < 3; i++)
+            addPeer(env, peers, nDisabled, true, &ios);
+        BEAST_EXPECT(peers.front()->txBatchEnabled());
+
+        int seq = 0;
+        auto relay = [&](int count) {
+            for (int i = 0; i < count; ++i, ++seq)
+            {
+                protocol::TMTransaction m;
+                m.set_rawtransaction("transaction" + std::to_string(seq));
+                m.set_deferred(false);
+                m.set_status(protocol::TransactionStatus::tsNEW);
+                env.app().overlay().relay(uint256(seq), m, {});
+            }
+        };
+        auto poll = [&]() {
+            ios.restart();
+            ios.poll();
+        };
+
+        // Nothing is sent until the peers' strands run
+        relay(Tuning::txBatchMaxCount);
+        BEAST_EXPECT(PeerTest::sendTx_ == 0);
+
+        // A full batch is one message
+        poll();
+        BEAST_EXPECT(PeerTest::sendTx_ == 3);
+
+        // A partial batch is one message once flushed. The flush is queued
+        // on each strand behind the transactions, so they all run together
+        // before the timer could complete.
+        relay(Tuning::txBatchMaxCount / 2);
+        for (auto const& peer : peers)
+            peer->flushTxBatch();
+        poll();
+        BEAST_EXPECT(PeerTest::sendTx_ == 6);
+
+        // Flushing an empty batch sends nothing
+        for (auto const& peer : peers)
+            peer->flushTxBatch();
+        poll();
+        BEAST_EXPECT(PeerTest::sendTx_ == 6);
+    }
+
     void
     run() override
     {
         bool log = false;
         std::set<Peer::id_t> skip = {0, 1, 2, 3, 4};
         testConfig(log);
+        testBatch();
         // relay to all peers, no hash queue
         testRelay("feature disabled", false, 10, 0, 10, 25, 10, 0);
         // relay to nPeers - skip (10-5=5)
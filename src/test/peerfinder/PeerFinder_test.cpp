@@ -40,15 +40,20 @@ public:
 
     struct TestStore : Store
     {
+        std::vector<Entry> entries;
+
         std::size_t
         load(load_callback const& cb) override
         {
-            return 0;
+            for (auto const& e : entries)
+                cb(e.endpoint, e.valence, e.latency);
+            return entries.size();
         }
 
         void
-        save(std::vector<Entry> const&) override
+        save(std::vector<Entry> const& v) override
         {
+            entries = v;
         }
     };
 
@@ -274,6 +279,77 @@ public:
 )rippleConfig");
     }
 
+    void
+    test_bootcacheLatency()
+    {
+        testcase("bootcache latency");
+        using namespace std::chrono_literals;
+
+        auto ep = [](std::string const& s) {
+            return beast::IP::Endpoint::from_string(s);
+        };
+        auto entry = [&](std::string const& s,
+                         int valence,
+                         std::chrono::milliseconds latency) {
+            Store::Entry e;
+            e.endpoint = ep(s);
+            e.valence = valence;
+            e.latency = latency;
+            return e;
+        };
+
+        TestStore store;
+        store.entries = {
+            entry("65.0.0.1:5", 5, 0ms),
+            entry("65.0.0.2:5", 2, 300ms),
+            entry("65.0.0.3:5", 1, 50ms),
+            entry("65.0.0.4:5", -3, 10ms),
+            entry("65.0.0.5:5", 0, 0ms)};
+        TestStopwatch clock;
+
+        auto order = [](Bootcache const& bootcache) {
+            std::vector<std::string> result;
+            for (auto const& e : bootcache)
+                result.push_back(e.address().to_string());
+            return result;
+        };
+
+        {
+            Bootcache bootcache(store, clock, journal_);
+            bootcache.load();
+
+            // Measured successful endpoints first, fastest first, then the
+            // rest by valence.
+            BEAST_EXPECT(
+                order(bootcache) ==
+                std::vector<std::string>(
+                    {"65.0.0.3",
+                     "65.0.0.2",
+                     "65.0.0.1",
+                     "65.0.0.5",
+                     "65.0.0.4"}));
+
+            // A measurement ranks the endpoint among the measured ones and
+            // later measurements are smoothed.
+            bootcache.on_latency(ep("65.0.0.1:5"), 100ms);
+            bootcache.on_latency(ep("65.0.0.1:5"), 20ms);
+            BEAST_EXPECT(order(bootcache).front() == "65.0.0.3");
+            BEAST_EXPECT(order(bootcache)[1] == "65.0.0.1");
+
+            // Failing drops an endpoint behind all successful ones.
+            bootcache.on_failure(ep("65.0.0.3:5"));
+            BEAST_EXPECT(order(bootcache).front() == "65.0.0.1");
+            BEAST_EXPECT(order(bootcache)[3] == "65.0.0.3");
+        }
+
+        // The latency is persisted
+        auto const saved = std::find_if(
+            store.entries.begin(), store.entries.end(), [&](auto const& e) {
+                return e.endpoint == ep("65.0.0.1:5");
+            });
+        BEAST_EXPECT(saved != store.entries.end() && saved->latency == 80ms);
+    }
+
     void
     run() override
     {
@@ -281,6 +357,7 @@ public:
         test_backoff2();
         test_config();
         test_invalid_config();
+        test_bootcacheLatency();
     }
 };
 
@@ -21,6 +21,7 @@
 #include <ripple/basics/random.h>
 #include <ripple/beast/unit_test.h>
 #include <ripple/protocol/STAmount.h>
+#include <boost/multiprecision/cpp_int.hpp>
 
 namespace ripple {
 
@@ -673,6 +674,273 @@ public:
 
     //--------------------------------------------------------------------------
 
+    // mulRound and divRound as they were computed with loops, one digit at a
+    // time, before their normalization and rounding used tables of powers of
+    // ten.  Their results must not change.
+    struct Reference
+    {
+        static void
+        normalize(std::uint64_t& value, int& offset)
+        {
+            while (value < STAmount::cMinValue)
+            {
+                value *= 10;
+                --offset;
+            }
+        }
+
+        static std::uint64_t
+        muldivRound(
+            std::uint64_t multiplier,
+            std::uint64_t multiplicand,
+            std::uint64_t divisor,
+            std::uint64_t rounding)
+        {
+            boost::multiprecision::uint128_t ret;
+            boost::multiprecision::multiply(ret, multiplier, multiplicand);
+            ret += rounding;
+            ret /= divisor;
+            if (ret > std::numeric_limits<std::uint64_t>::max())
+                Throw<std::overflow_error>("overflow");
+            return static_cast<std::uint64_t>(ret);
+        }
+
+        static void
+        canonicalizeRound(
+            bool native,
+            std::uint64_t& value,
+            int& offset,
+            bool strict,
+            bool roundUp)
+        {
+            if (native)
+            {
+                if (offset < 0)
+                {
+                    int loops = 0;
+                    bool hadRemainder = false;
+                    while (offset < -1)
+                    {
+                        hadRemainder |= value % 10 != 0;
+                        value /= 10;
+                        ++offset;
+                        ++loops;
+                    }
+                    if (strict)
+                        value += (hadRemainder && roundUp) ? 10 : 9;
+                    else
+                        value += (loops >= 2) ? 9 : 10;
+                    value /= 10;
+                    ++offset;
+                }
+            }
+            else if (value > STAmount::cMaxValue)
+            {
+                while (value > (10 * STAmount::cMaxValue))
+                {
+                    value /= 10;
+                    ++offset;
+                }
+                value += 9;
+                value /= 10;
+                ++offset;
+            }
+        }
+
+        // Returns the smallest value above zero if rounding up produced zero.
+        static STAmount
+        finish(
+            STAmount const& result,
+            Issue const& issue,
+            bool resultNegative,
+            bool roundUp)
+        {
+            if (roundUp && !resultNegative && !result)
+            {
+                if (isXRP(issue))
+                    return STAmount(issue, std::uint64_t(1), 0, false);
+                return STAmount(
+                    issue, STAmount::cMinValue, STAmount::cMinOffset, false);
+            }
+            return result;
+        }
+
+        static STAmount
+        mulRound(
+            STAmount const& v1,
+            STAmount const& v2,
+            Issue const& issue,
+            bool roundUp,
+            bool strict)
+        {
+            if (v1 == beast::zero || v2 == beast::zero)
+                return {issue};
+
+            std::uint64_t value1 = v1.mantissa(), value2 = v2.mantissa();
+            int offset1 = v1.exponent(), offset2 = v2.exponent();
+            if (v1.native())
+                normalize(value1, offset1);
+            if (v2.native())
+                normalize(value2, offset2);
+
+            bool const resultNegative = v1.negative() != v2.negative();
+            std::uint64_t const tenTo14 = 100000000000000ull;
+            std::uint64_t amount = muldivRound(
+                value1,
+                value2,
+                tenTo14,
+                (resultNegative != roundUp) ? tenTo14 - 1 : 0);
+            int offset = offset1 + offset2 + 14;
+            if (resultNegative != roundUp)
+                canonicalizeRound(
+                    isXRP(issue), amount, offset, strict, roundUp);
+
+            auto const mode =
+                strict ? Number::towards_zero : Number::getround();
+            saveNumberRoundMode const saved(Number::setround(mode));
+            return finish(
+                STAmount(issue, amount, offset, resultNegative),
+                issue,
+                resultNegative,
+                roundUp);
+        }
+
+        static STAmount
+        divRound(
+            STAmount const& num,
+            STAmount const& den,
+            Issue const& issue,
+            bool roundUp,
+            bool strict)
+        {
+            if (den == beast::zero)
+                Throw<std::runtime_error>("division by zero");
+            if (num == beast::zero)
+                return {issue};
+
+            std::uint64_t numVal = num.mantissa(), denVal = den.mantissa();
+            int numOffset = num.exponent(), denOffset = den.exponent();
+            if (num.native())
+                normalize(numVal, numOffset);
+            if (den.native())
+                normalize(denVal, denOffset);
+
+            bool const resultNegative = num.negative() != den.negative();
+            std::uint64_t amount = muldivRound(
+                numVal,
+                100000000000000000ull,
+                denVal,
+                (resultNegative != roundUp) ? denVal - 1 : 0);
+            int offset = numOffset - denOffset - 17;
+            if (resultNegative != roundUp)
+                canonicalizeRound(
+                    isXRP(issue), amount, offset, false, roundUp);
+
+            auto const mode = !strict ? Number::getround()
+                : roundUp ^ resultNegative ? Number::upward
+                                           : Number::downward;
+            saveNumberRoundMode const saved(Number::setround(mode));
+            return finish(
+                STAmount(issue, amount, offset, resultNegative),
+                issue,
+                resultNegative,
+                roundUp);
+        }
+    };
+
+    void
+    testArithmeticMatchesReference()
+    {
+        testcase("arithmetic matches reference");
+
+        auto& engine = default_prng();
+        Issue const usd{Currency(0x5553440000000000), AccountID(0x4985601)};
+
+        auto const randomAmount = [&](bool native) {
+            // Mantissas of every number of digits
+            std::uint64_t limit = 1;
+            for (auto digits = rand_int(engine, 1, 19); digits; --digits)
+                limit *= 10;
+            auto const mantissa =
+                rand_int(engine, std::uint64_t(1), limit - 1);
+            bool const negative = rand_int(engine, 3) == 0;
+            if (native)
+                return STAmount(mantissa % STAmount::cMaxNativeN + 1, negative);
+            return STAmount(usd, mantissa, rand_int(engine, -40, 20), negative);
+        };
+
+        // Either both throw or both give the same amount
+        auto const same = [](auto&& f, auto&& reference) {
+            std::optional<STAmount> expected;
+            std::optional<STAmount> actual;
+            try
+            {
+                expected = reference();
+            }
+            catch (std::exception const&)
+            {
+            }
+            try
+            {
+                actual = f();
+            }
+            catch (std::exception const&)
+            {
+            }
+            return expected == actual &&
+                (!actual || actual->exponent() == expected->exponent());
+        };
+
+        for (bool const numberSwitchover : {false, true})
+        {
+            NumberSO const numberSO{numberSwitchover};
+            int mismatches = 0;
+            for (int i = 0; i < 20000; ++i)
+            {
+                bool const native1 = rand_int(engine, 2) == 0;
+                bool const native2 = rand_int(engine, 2) == 0;
+                auto const v1 = randomAmount(native1);
+                auto const v2 = randomAmount(native2);
+                Issue const& issue =
+                    rand_int(engine, 1) == 0 ? xrpIssue() : usd;
+                for (bool const roundUp : {false, true})
+                {
+                    for (bool const strict : {false, true})
+                    {
+                        auto const mul = [&] {
+                            return strict
+                                ? mulRoundStrict(v1, v2, issue, roundUp)
+                                : mulRound(v1, v2, issue, roundUp);
+                        };
+                        auto const mulReference = [&] {
+                            return Reference::mulRound(
+                                v1, v2, issue, roundUp, strict);
+                        };
+                        auto const div = [&] {
+                            return strict
+                                ? divRoundStrict(v1, v2, issue, roundUp)
+                                : divRound(v1, v2, issue, roundUp);
+                        };
+                        auto const divReference = [&] {
+                            return Reference::divRound(
+                                v1, v2, issue, roundUp, strict);
+                        };
+
+                        // Multiplying drops by drops doesn't normalize
+                        if ((!native1 || !native2 || !isXRP(issue)) &&
+                            !same(mul, mulReference))
+                            ++mismatches;
+                        if (!same(div, divReference))
+                            ++mismatches;
+                    }
+                }
+            }
+            BEAST_EXPECTS(mismatches == 0, std::to_string(mismatches));
+        }
+    }
+
+    //--------------------------------------------------------------------------
+
     void
     run() override
     {
@@ -684,6 +952,7 @@ public:
         testRounding();
         testConvertXRP();
         testConvertIOU();
+        testArithmeticMatchesReference();
     }
 };
 
@@ -698,6 +698,52 @@ testMalformed()
     }
 }
 
+void
+testScratchSerializer()
+{
+    testcase("Scratch serializer");
+
+    {
+        ScratchSerializer outer;
+        outer->add32(1);
+        {
+            // A nested scratch buffer is separate, and starts out empty.
+            ScratchSerializer inner;
+            BEAST_EXPECT(&*inner != &*outer);
+            BEAST_EXPECT(inner->size() == 0);
+            inner->add32(2);
+        }
+        BEAST_EXPECT(outer->size() == 4);
+    }
+    {
+        // The thread's buffer is cleared before it is lent again.
+        ScratchSerializer s;
+        BEAST_EXPECT(s->size() == 0);
+    }
+
+    // Hashes computed in the scratch buffer match ones computed in a
+    // fresh Serializer, including for objects too large to keep the
+    // buffer for.
+    auto check = [this](STObject const& object) {
+        Serializer s;
+        s.add32(HashPrefix::transactionID);
+        object.add(s);
+        BEAST_EXPECT(
+            object.getHash(HashPrefix::transactionID) == s.getSHA512Half());
+        BEAST_EXPECT(
+            object.getHash(HashPrefix::transactionID) == s.getSHA512Half());
+    };
+
+    STObject small(sfGeneric);
+    small.setFieldU32(sfFlags, 7);
+    check(small);
+
+    STObject large(sfGeneric);
+    large.setFieldVL(sfMemoData, Blob(100 * 1024, 0xab));
+    check(large);
+    check(small);
+}
+
 void
 run() override
 {
@@ -710,6 +756,7 @@ run() override
     testParseJSONArrayWithInvalidChildrenObjects();
     testParseJSONEdgeCases();
     testMalformed();
+    testScratchSerializer();
 }
 }
 ;
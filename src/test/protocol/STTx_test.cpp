@@ -61,6 +61,9 @@ public:
 
         testcase("STObject constructor errors");
         testObjectCtorErrors();
+
+        testcase("multi-signatures");
+        testMultiSign();
     }
 
     void
@@ -1634,6 +1637,90 @@ public:
         }
     }
 
+    void
+    testMultiSign()
+    {
+        auto const owner = randomKeyPair(KeyType::secp256k1);
+        STTx txn(ttACCOUNT_SET, [&owner](auto& obj) {
+            obj.setAccountID(sfAccount, calcAccountID(owner.first));
+            obj.setFieldVL(sfMessageKey, owner.first.slice());
+            obj.setFieldVL(sfSigningPubKey, Slice{});
+        });
+
+        // A mix of Ed25519 signers, which sign the whole message, and
+        // secp256k1 ones, which share the hashed prefix
+        std::vector<std::pair<PublicKey, SecretKey>> keys;
+        for (int i = 0; i < 7; ++i)
+            keys.push_back(randomKeyPair(
+                i % 3 == 0 ? KeyType::secp256k1 : KeyType::ed25519));
+        std::sort(keys.begin(), keys.end(), [](auto const& a, auto const& b) {
+            return calcAccountID(a.first) < calcAccountID(b.first);
+        });
+
+        auto signers = [&txn, &keys](std::size_t corrupt = -1) {
+            STArray signers(sfSigners, keys.size());
+            for (std::size_t i = 0; i < keys.size(); ++i)
+            {
+                auto const id = calcAccountID(keys[i].first);
+                auto sig = sign(
+                    keys[i].first,
+                    keys[i].second,
+                    buildMultiSigningData(txn, id).slice());
+                if (i == corrupt)
+                    sig.data()[sig.size() / 2] ^= 0x01;
+
+                STObject signer(sfSigner);
+                signer.setAccountID(sfAccount, id);
+                signer.setFieldVL(sfSigningPubKey, keys[i].first.slice());
+                signer.setFieldVL(sfTxnSignature, sig);
+                signers.push_back(std::move(signer));
+            }
+            return signers;
+        };
+
+        std::unordered_set<uint256, beast::uhash<>> const presets;
+        Rules const defaultRules{presets};
+
+        auto check = [&](STArray const& array) {
+            STTx signedTxn(txn);
+            signedTxn.setFieldArray(sfSigners, array);
+            return signedTxn.checkSign(
+                STTx::RequireFullyCanonicalSig::yes, defaultRules);
+        };
+
+        BEAST_EXPECT(check(signers()));
+
+        // The first bad signature is reported, whatever its key type
+        for (std::size_t corrupt : {0, 1, 5})
+        {
+            auto const result = check(signers(corrupt));
+            BEAST_EXPECT(
+                !result &&
+                result.error() ==
+                    "Invalid signature on account " +
+                        toBase58(calcAccountID(keys[corrupt].first)) + ".");
+        }
+
+        // A bad signature comes before a later problem with the array
+        {
+            auto array = signers(2);
+            array.push_back(array[array.size() - 1]);
+            auto const result = check(array);
+            BEAST_EXPECT(
+                !result &&
+                result.error() ==
+                    "Invalid signature on account " +
+                        toBase58(calcAccountID(keys[2].first)) + ".");
+        }
+        {
+            auto array = signers();
+            array.push_back(array[array.size() - 1]);
+            auto const result = check(array);
+            BEAST_EXPECT(
+                !result && result.error() == "Duplicate Signers not allowed.");
+        }
+    }
+
     void
     testObjectCtorErrors()
     {
@@ -0,0 +1,83 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/digest.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace ripple {
+
+class digest_test : public beast::unit_test::suite
+{
+    void
+    testBatch()
+    {
+        testcase("sha512HalfBatch");
+
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> byte(0, 255);
+
+        // Message sizes either side of the block and padding boundaries,
+        // plus the size of a serialized inner node.
+        for (std::size_t size : {0, 1, 111, 112, 127, 128, 239, 240, 516})
+        {
+            // Batch sizes that exercise every vector width and the tail
+            for (std::size_t count : {0, 1, 3, 4, 7, 8, 9, 13, 16, 17})
+            {
+                std::vector<std::vector<std::uint8_t>> data(count);
+                std::vector<std::uint8_t const*> messages;
+                for (auto& d : data)
+                {
+                    d.resize(size + 1);
+                    for (auto& b : d)
+                        b = static_cast<std::uint8_t>(byte(gen));
+                    messages.push_back(d.data());
+                }
+
+                std::vector<uint256> results(count);
+                sha512HalfBatch(messages, size, results);
+
+                bool match = true;
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    sha512_half_hasher h;
+                    h(messages[i], size);
+                    if (static_cast<uint256>(h) != results[i])
+                        match = false;
+                }
+                BEAST_EXPECTS(
+                    match,
+                    std::to_string(count) + " x " + std::to_string(size));
+            }
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testBatch();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(digest, protocol, ripple);
+
+}  // namespace ripple
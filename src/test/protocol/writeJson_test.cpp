@@ -0,0 +1,181 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/json/json_reader.h>
+#include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/STLedgerEntry.h>
+#include <ripple/protocol/STParsedJSON.h>
+#include <ripple/protocol/STTx.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/protocol/writeJson.h>
+
+namespace ripple {
+
+class writeJson_test : public beast::unit_test::suite
+{
+    Json::Value
+    parse(std::string const& text)
+    {
+        Json::Value jv;
+        BEAST_EXPECT(Json::Reader{}.parse(text, jv));
+        return jv;
+    }
+
+    STObject
+    parseObject(std::string const& text)
+    {
+        STParsedJSONObject parsed("test", parse(text));
+        if (!BEAST_EXPECT(parsed.object))
+            return STObject(sfGeneric);
+        return std::move(*parsed.object);
+    }
+
+    template <class T>
+    void
+    expectSame(T const& value, JsonOptions options)
+    {
+        std::string streamed;
+        outputJson(value, Json::stringOutput(streamed), options);
+        auto const expected = Json::jsonAsString(value.getJson(options));
+        BEAST_EXPECT(streamed == expected);
+    }
+
+    void
+    testTransaction()
+    {
+        testcase("transaction");
+
+        auto const object = parseObject(R"({
+            "Account": "rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh",
+            "Amount": {
+                "currency": "USD",
+                "issuer": "rPT1Sjq2YGrBMTttX4GZHjKu9dyfzbpAYe",
+                "value": "-1.25e-7"
+            },
+            "Destination": "rPT1Sjq2YGrBMTttX4GZHjKu9dyfzbpAYe",
+            "Fee": "10",
+            "Flags": 2147483648,
+            "Memos": [
+                {"Memo": {"MemoData": "0102", "MemoType": "6E6F7465"}},
+                {"Memo": {"MemoFormat": "74657874"}}
+            ],
+            "Paths": [[{
+                "account": "rPT1Sjq2YGrBMTttX4GZHjKu9dyfzbpAYe",
+                "currency": "USD",
+                "issuer": "rPT1Sjq2YGrBMTttX4GZHjKu9dyfzbpAYe"
+            }]],
+            "SendMax": "1000000",
+            "Sequence": 7,
+            "SigningPubKey": "",
+            "TransactionType": "Payment"
+        })");
+        STTx const tx{STObject(object)};
+
+        expectSame(tx, JsonOptions::none);
+        expectSame(tx, JsonOptions::disable_API_prior_V2);
+        expectSame(static_cast<STObject const&>(tx), JsonOptions::none);
+        expectSame(tx.getFieldAmount(sfAmount), JsonOptions::none);
+        expectSame(tx.getFieldAmount(sfSendMax), JsonOptions::none);
+        expectSame(tx.getFieldArray(sfMemos), JsonOptions::none);
+    }
+
+    void
+    testMetadata()
+    {
+        testcase("metadata");
+
+        auto const meta = parseObject(R"({
+            "AffectedNodes": [
+                {"ModifiedNode": {
+                    "FinalFields": {
+                        "Account": "rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh",
+                        "Balance": "99999990",
+                        "Flags": 0,
+                        "OwnerCount": 1,
+                        "Sequence": 8
+                    },
+                    "LedgerEntryType": "AccountRoot",
+                    "LedgerIndex": ")"
+                    "13F1A95D7AAB7108D5CE7EEAF504B289"
+                    "4B8C674E6D68499076441C4837282BF8"
+                    R"(",
+                    "PreviousFields": {"Balance": "100000000", "Sequence": 7}
+                }},
+                {"CreatedNode": {
+                    "LedgerEntryType": "Offer",
+                    "LedgerIndex": ")"
+                    "00000000000000000000000000000000"
+                    "00000000000000000000000000000001"
+                    R"(",
+                    "NewFields": {
+                        "Account": "rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh",
+                        "TakerGets": "5",
+                        "TakerPays": {
+                            "currency": ")"
+                            "0158415500000000C1F7"
+                            "6FF6ECB0BAC600000000"
+                            R"(",
+                            "issuer": "rPT1Sjq2YGrBMTttX4GZHjKu9dyfzbpAYe",
+                            "value": "3"
+                        }
+                    }
+                }}
+            ],
+            "TransactionIndex": 2,
+            "TransactionResult": "tesSUCCESS"
+        })");
+        expectSame(meta, JsonOptions::none);
+
+        // An empty object and an empty array.
+        expectSame(STObject(sfGeneric), JsonOptions::none);
+        expectSame(STArray(sfAffectedNodes), JsonOptions::none);
+    }
+
+    void
+    testLedgerEntry()
+    {
+        testcase("ledger entry");
+
+        auto const id = parseBase58<AccountID>(
+            "rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh");
+        if (!BEAST_EXPECT(id))
+            return;
+        STLedgerEntry sle(keylet::account(*id));
+        sle.setAccountID(sfAccount, *id);
+        sle.setFieldAmount(sfBalance, STAmount(XRPAmount(12345)));
+        sle.setFieldU32(sfSequence, 3);
+        sle.setFieldU32(sfOwnerCount, 0);
+        sle.setFieldU32(sfFlags, 0);
+        expectSame(sle, JsonOptions::none);
+    }
+
+public:
+    void
+    run() override
+    {
+        testTransaction();
+        testMetadata();
+        testLedgerEntry();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(writeJson, protocol, ripple);
+
+}  // namespace ripple
@@ -26,7 +26,9 @@
 #include <test/unit_test/SuiteJournal.h>
 
 #include <boost/utility/base_from_member.hpp>
+#include <algorithm>
 #include <functional>
+#include <thread>
 
 namespace ripple {
 namespace Resource {
@@ -42,8 +44,14 @@ public:
         using clock_type = boost::base_from_member<TestStopwatch>;
 
     public:
-        explicit TestLogic(beast::Journal journal)
-            : Logic(beast::insight::NullCollector::New(), member, journal)
+        explicit TestLogic(
+            beast::Journal journal,
+            bool chargeMeasuredCost = false)
+            : Logic(
+                  beast::insight::NullCollector::New(),
+                  member,
+                  journal,
+                  chargeMeasuredCost)
         {
         }
 
@@ -275,6 +283,106 @@ public:
         pass();
     }
 
+    void
+    testConcurrency(beast::Journal j)
+    {
+        testcase("Concurrency");
+
+        TestLogic logic(j);
+
+        int const threads = 4;
+        int const charges = 1000;
+        Charge const fee(100);
+        beast::IP::Endpoint const shared(
+            beast::IP::Endpoint::from_string("192.0.2.1"));
+
+        // Charge one shared consumer and many distinct ones from several
+        // threads while gossip is imported and the table is groomed.
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&, t]() {
+                Consumer c(logic.newInboundEndpoint(shared));
+                for (int i = 0; i < charges; ++i)
+                {
+                    c.charge(fee);
+                    beast::IP::AddressV4::bytes_type d = {
+                        {198,
+                         51,
+                         static_cast<std::uint8_t>(t),
+                         static_cast<std::uint8_t>(i)}};
+                    Consumer other(logic.newInboundEndpoint(
+                        beast::IP::Endpoint{beast::IP::AddressV4{d}}));
+                    other.charge(fee);
+                }
+            });
+        }
+        workers.emplace_back([&]() {
+            for (int i = 0; i < 20; ++i)
+            {
+                Gossip g;
+                createGossip(g);
+                logic.importConsumers(std::to_string(i % 3), g);
+                logic.periodicActivity();
+            }
+        });
+        for (auto& worker : workers)
+            worker.join();
+
+        // The clock did not move so no charge decayed.
+        Consumer c(logic.newInboundEndpoint(shared));
+        BEAST_EXPECT(
+            c.balance() == threads * charges * fee.cost() / decayWindowSeconds);
+        BEAST_EXPECT(logic.getJson(0).isMember(c.to_string()));
+
+        auto const gossip = logic.exportConsumers();
+        BEAST_EXPECT(std::any_of(
+            gossip.items.begin(), gossip.items.end(), [&](auto const& item) {
+                return item.address == shared.at_port(0);
+            }));
+    }
+
+    void
+    testMeasuredCost(beast::Journal j)
+    {
+        testcase("Measured cost");
+
+        using namespace std::chrono_literals;
+        beast::IP::Endpoint const addr(
+            beast::IP::Endpoint::from_string("192.0.2.3"));
+
+        for (bool const enabled : {false, true})
+        {
+            TestLogic logic(j, enabled);
+            Consumer c(logic.newInboundEndpoint(addr));
+
+            c.chargeTime(50ms, 80ms);
+            c.chargeTime(10us, 20us);
+            auto const usage = c.usage();
+            BEAST_EXPECT(usage.cpu == 50010us);
+            BEAST_EXPECT(usage.wall == 80020us);
+            BEAST_EXPECT(usage.jobs == 2);
+
+            // Only the job longer than the unit is charged
+            int const expected =
+                enabled ? (50ms / measuredCostUnit) / decayWindowSeconds : 0;
+            BEAST_EXPECT(c.balance() == expected);
+
+            auto const json = logic.getUsageJson(10);
+            BEAST_EXPECT(json.size() == 1);
+            BEAST_EXPECT(json[0u][jss::cpu_duration_us] == "50010");
+            BEAST_EXPECT(json[0u][jss::jobs] == 2);
+
+            // Unlimited consumers accumulate usage but are never charged
+            Consumer admin(logic.newUnlimitedEndpoint(addr));
+            admin.chargeTime(1s, 1s);
+            BEAST_EXPECT(admin.usage().jobs == 1);
+            BEAST_EXPECT(admin.balance() == 0);
+            BEAST_EXPECT(logic.getUsageJson(1)[0u][jss::type] == "admin");
+            BEAST_EXPECT(logic.getUsageJson(10).size() == 2);
+        }
+    }
+
     void
     run() override
     {
@@ -286,6 +394,8 @@ public:
         testCharges(journal);
         testImports(journal);
         testImport(journal);
+        testConcurrency(journal);
+        testMeasuredCost(journal);
     }
 };
 
@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/core/ConfigSections.h>
 #include <ripple/protocol/Feature.h>
 #include <ripple/protocol/jss.h>
 #include <test/jtx.h>
@@ -635,6 +636,78 @@ public:
         }
     }
 
+    class GrpcAccountInfoClient : public GRPCTestClientBase
+    {
+    public:
+        org::xrpl::rpc::v1::GetAccountInfoRequest request;
+        org::xrpl::rpc::v1::GetAccountInfoResponse reply;
+
+        explicit GrpcAccountInfoClient(std::string const& port)
+            : GRPCTestClientBase(port)
+        {
+        }
+
+        void
+        GetAccountInfo()
+        {
+            status = stub_->GetAccountInfo(&context, request, &reply);
+        }
+    };
+
+    void
+    testAccountInfoGrpc()
+    {
+        testcase("GetAccountInfo");
+        using namespace jtx;
+        std::unique_ptr<Config> config = envconfig(addGrpcConfig);
+        std::string grpcPort =
+            *(*config)[SECTION_PORT_GRPC].get<std::string>("port");
+        Env env(*this, std::move(config));
+
+        auto grpcAccountInfo = [&grpcPort, &env](std::string const& account) {
+            GrpcAccountInfoClient grpcClient{grpcPort};
+            grpcClient.request.set_account(account);
+            grpcClient.request.mutable_ledger()->set_sequence(
+                env.closed()->seq());
+            grpcClient.GetAccountInfo();
+            return std::make_pair(grpcClient.status, grpcClient.reply);
+        };
+
+        Account const alice{"alice"};
+        env.fund(XRP(1000), alice);
+        env.close();
+
+        {
+            auto const [status, reply] = grpcAccountInfo(
+                std::string(alice.id().begin(), alice.id().end()));
+            BEAST_EXPECT(status.ok());
+            auto const sle = env.closed()->read(keylet::account(alice.id()));
+            if (!BEAST_EXPECT(sle))
+                return;
+            BEAST_EXPECT(
+                makeSlice(reply.account_data().data()) ==
+                sle->getSerializer().slice());
+            BEAST_EXPECT(
+                uint256::fromVoid(reply.account_data().key().data()) ==
+                sle->key());
+            BEAST_EXPECT(reply.ledger_index() == env.closed()->seq());
+            BEAST_EXPECT(reply.validated());
+        }
+        {
+            // Unfunded account
+            Account const bob{"bob"};
+            auto const [status, reply] = grpcAccountInfo(
+                std::string(bob.id().begin(), bob.id().end()));
+            BEAST_EXPECT(status.error_code() == grpc::StatusCode::NOT_FOUND);
+        }
+        {
+            // Malformed account
+            auto const [status, reply] = grpcAccountInfo("alice");
+            BEAST_EXPECT(
+                status.error_code() == grpc::StatusCode::INVALID_ARGUMENT);
+        }
+    }
+
     void
     run() override
     {
@@ -642,6 +715,7 @@ public:
         testSignerLists();
         testSignerListsApiVersion2();
         testSignerListsV2();
+        testAccountInfoGrpc();
 
         FeatureBitset const allFeatures{
             ripple::test::jtx::supported_amendments()};
@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <ripple/beast/unit_test.h>
+#include <ripple/core/ConfigSections.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/protocol/jss.h>
 #include <test/jtx.h>
@@ -730,6 +731,71 @@ class AccountTx_test : public beast::unit_test::suite
         }
     }
 
+    void
+    testAccountTxIndex()
+    {
+        // Page through an account's history using the account transaction
+        // index and check it gives the same answers as the SQL tables.
+        testcase("account_tx index");
+
+        using namespace test::jtx;
+
+        auto history = [this](bool useIndex, bool forward) {
+            Env env(*this, envconfig([useIndex](std::unique_ptr<Config> cfg) {
+                if (useIndex)
+                    cfg->section(SECTION_ACCOUNT_TX_INDEX)
+                        .set("type", "memory");
+                return cfg;
+            }));
+
+            Account const alice{"alice"};
+            Account const becky{"becky"};
+            env.fund(XRP(10000), alice, becky);
+            env.close();
+
+            for (int i = 0; i < 6; ++i)
+            {
+                for (int j = 0; j <= i % 3; ++j)
+                    env(pay(alice, becky, XRP(1 + j)));
+                env(noop(becky));
+                env.close();
+            }
+
+            std::vector<std::string> hashes;
+            std::optional<Json::Value> marker;
+            do
+            {
+                Json::Value params;
+                params[jss::account] = alice.human();
+                params[jss::limit] = 2;
+                params[jss::forward] = forward;
+                if (marker)
+                    params[jss::marker] = *marker;
+
+                auto const result = env.rpc(
+                    "json", "account_tx", to_string(params))[jss::result];
+                if (!BEAST_EXPECT(result[jss::status] == "success"))
+                    break;
+
+                for (auto const& tx : result[jss::transactions])
+                    hashes.push_back(tx[jss::tx][jss::hash].asString());
+
+                marker.reset();
+                if (result.isMember(jss::marker))
+                    marker = result[jss::marker];
+            } while (marker);
+
+            return hashes;
+        };
+
+        for (bool const forward : {true, false})
+        {
+            auto const expected = history(false, forward);
+            BEAST_EXPECT(expected.size() == 14);
+            BEAST_EXPECT(history(true, forward) == expected);
+        }
+    }
+
 public:
     void
     run() override
@@ -738,6 +804,7 @@ public:
             std::bind_front(&AccountTx_test::testParameters, this));
         testContents();
         testAccountDelete();
+        testAccountTxIndex();
     }
 };
 BEAST_DEFINE_TESTSUITE(AccountTx, app, ripple);
@@ -0,0 +1,123 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/protocol/ApplyProfile.h>
+#include <ripple/protocol/jss.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class ApplyProfile_test : public beast::unit_test::suite
+{
+    // Funds two accounts and pays between them, returning the counts.
+    Json::Value
+    payments()
+    {
+        using namespace jtx;
+        Env env{*this};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+
+        env.rpc("apply_profile", "clear");
+        env.fund(XRP(10000), alice, bob);
+        env.close();
+        env(pay(alice, bob, XRP(100)));
+        env.close();
+
+        return env.rpc("apply_profile")[jss::result];
+    }
+
+    void
+    testCounts()
+    {
+        testcase("counts");
+
+        auto const jr = payments();
+        BEAST_EXPECT(jr[jss::status] == "success");
+        BEAST_EXPECT(jr[jss::enabled].asBool() == applyProfile::compiled());
+
+        auto const& txs = jr[jss::transactions];
+        auto const& entries = jr[jss::ledger_entries];
+        if (!applyProfile::compiled())
+        {
+            BEAST_EXPECT(txs.isObject() && txs.size() == 0);
+            BEAST_EXPECT(entries.isObject() && entries.size() == 0);
+            return;
+        }
+
+        auto const count = [](Json::Value const& v) {
+            return std::stoull(v.asString());
+        };
+
+        BEAST_EXPECT(txs.isMember("Payment"));
+        auto const& payment = txs["Payment"];
+        BEAST_EXPECT(count(payment[jss::applied]) >= 3);
+        BEAST_EXPECT(count(payment[jss::peeks]) > 0);
+        BEAST_EXPECT(count(payment[jss::inserts]) > 0);
+        BEAST_EXPECT(count(payment[jss::field_lookups]) > 0);
+        BEAST_EXPECT(count(payment[jss::serialized_bytes]) > 0);
+
+        BEAST_EXPECT(entries.isMember("AccountRoot"));
+        auto const& root = entries["AccountRoot"];
+        BEAST_EXPECT(count(root[jss::peeks]) > 0);
+        BEAST_EXPECT(count(root[jss::copies]) > 0);
+        BEAST_EXPECT(count(root[jss::inserts]) >= 2);
+
+        // The same transactions on the same ledger cost the same
+        BEAST_EXPECT(payments() == jr);
+    }
+
+    void
+    testClear()
+    {
+        testcase("clear");
+
+        using namespace jtx;
+        Env env{*this};
+        env.fund(XRP(10000), "alice");
+        env.close();
+
+        auto jr = env.rpc("apply_profile", "clear")[jss::result];
+        BEAST_EXPECT(jr[jss::clear].asBool());
+
+        jr = env.rpc("apply_profile")[jss::result];
+        BEAST_EXPECT(jr[jss::transactions].size() == 0);
+        BEAST_EXPECT(jr[jss::ledger_entries].size() == 0);
+
+        jr = env.rpc("json", "apply_profile", R"({"clear": 1})")[jss::result];
+        BEAST_EXPECT(jr[jss::error] == "invalidParams");
+
+        jr = env.rpc("apply_profile", "reset")[jss::result];
+        BEAST_EXPECT(jr[jss::error] == "invalidParams");
+    }
+
+public:
+    void
+    run() override
+    {
+        testCounts();
+        testClear();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ApplyProfile, rpc, ripple);
+
+}  // namespace test
+}  // namespace ripple
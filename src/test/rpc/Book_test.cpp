@@ -15,12 +15,16 @@
 */
 //==============================================================================
 
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/ledger/OrderBookDB.h>
 #include <ripple/beast/unit_test.h>
+#include <ripple/core/ConfigSections.h>
 #include <ripple/protocol/Indexes.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/rpc/impl/Tuning.h>
 #include <test/jtx.h>
 #include <test/jtx/WSClient.h>
+#include <test/rpc/GRPCTestClientBase.h>
 
 namespace ripple {
 namespace test {
@@ -1709,6 +1713,227 @@ public:
             (asAdmin ? RPC::Tuning::bookOffers.rdefault : 0u));
     }
 
+    class GrpcBookOffersClient : public GRPCTestClientBase
+    {
+    public:
+        org::xrpl::rpc::v1::GetBookOffersRequest request;
+        org::xrpl::rpc::v1::GetBookOffersResponse reply;
+
+        explicit GrpcBookOffersClient(std::string const& port)
+            : GRPCTestClientBase(port)
+        {
+        }
+
+        void
+        GetBookOffers()
+        {
+            status = stub_->GetBookOffers(&context, request, &reply);
+        }
+    };
+
+    void
+    testBookOffersGrpc()
+    {
+        testcase("GetBookOffers");
+        using namespace jtx;
+        std::unique_ptr<Config> config = envconfig(addGrpcConfig);
+        std::string grpcPort =
+            *(*config)[SECTION_PORT_GRPC].get<std::string>("port");
+        Env env(*this, std::move(config));
+        Account gw{"gw"};
+        env.fund(XRP(200000), gw);
+        env.close();
+
+        auto USD = gw["USD"];
+        for (auto i = 0; i < 5; i++)
+            env(offer(gw, XRP(50 + 1 * i), USD(1.0 + 0.1 * i)));
+        env.close();
+
+        Json::Value jvParams;
+        jvParams[jss::ledger_index] = "validated";
+        jvParams[jss::taker_pays][jss::currency] = "XRP";
+        jvParams[jss::taker_gets][jss::currency] = "USD";
+        jvParams[jss::taker_gets][jss::issuer] = gw.human();
+        auto const jrr =
+            env.rpc("json", "book_offers", to_string(jvParams))[jss::result];
+        if (!BEAST_EXPECT(jrr[jss::offers].size() == 5u))
+            return;
+
+        auto grpcBookOffers = [&](std::string const& marker) {
+            GrpcBookOffersClient grpcClient{grpcPort};
+            auto const currency = USD.currency;
+            grpcClient.request.set_taker_gets_currency(
+                currency.data(), currency.size());
+            grpcClient.request.set_taker_gets_issuer(
+                gw.id().data(), gw.id().size());
+            grpcClient.request.mutable_ledger()->set_sequence(
+                env.closed()->seq());
+            grpcClient.request.set_limit(2);
+            grpcClient.request.set_marker(marker);
+            grpcClient.GetBookOffers();
+            return std::make_pair(grpcClient.status, grpcClient.reply);
+        };
+
+        // Pages of 2, 2 and 1 offers, in the same order as book_offers
+        std::string marker;
+        Json::UInt i = 0;
+        do
+        {
+            auto const [status, reply] = grpcBookOffers(marker);
+            if (!BEAST_EXPECT(status.ok()))
+                return;
+            for (auto const& obj : reply.offers().objects())
+            {
+                auto const key = uint256::fromVoid(obj.key().data());
+                BEAST_EXPECT(
+                    to_string(key) == jrr[jss::offers][i][jss::index]);
+                auto const sle = env.closed()->read(keylet::offer(key));
+                if (BEAST_EXPECT(sle))
+                    BEAST_EXPECT(
+                        makeSlice(obj.data()) == sle->getSerializer().slice());
+                ++i;
+            }
+            marker = reply.marker();
+            BEAST_EXPECT(marker.empty() || reply.offers().objects_size() == 2);
+        } while (!marker.empty());
+        BEAST_EXPECT(i == 5u);
+
+        {
+            // Same asset on both sides
+            GrpcBookOffersClient grpcClient{grpcPort};
+            grpcClient.GetBookOffers();
+            BEAST_EXPECT(
+                grpcClient.status.error_code() ==
+                grpc::StatusCode::INVALID_ARGUMENT);
+        }
+    }
+
+    void
+    testBookIndex()
+    {
+        testcase("BookOffers from the book index");
+        using namespace jtx;
+        using namespace std::chrono_literals;
+        Env env{*this, envconfig([](std::unique_ptr<Config> cfg) {
+                    cfg->section(SECTION_BOOK_INDEX).set("books", "4");
+                    cfg->section(SECTION_BOOK_INDEX).set("offers", "2");
+                    return cfg;
+                })};
+        Account gw{"gw"};
+        Account alice{"alice"};
+        env.fund(XRP(10000), gw, alice);
+        env.close();
+        auto USD = gw["USD"];
+        env(trust(alice, USD(100)));
+        env(offer(gw, XRP(50), USD(1)));
+        env(offer(gw, XRP(60), USD(1)));
+        env(offer(gw, XRP(70), USD(1)));
+        env.close();
+
+        auto& index = env.app().getOrderBookDB().bookIndex();
+        Book const book{xrpIssue(), USD.issue()};
+
+        // Ledgers are indexed by a job once they are validated
+        auto indexed = [&](std::size_t limit) {
+            for (int i = 0; i < 100; ++i)
+            {
+                auto const ledger =
+                    env.app().getLedgerMaster().getValidatedLedger();
+                if (ledger->info().seq == env.closed()->info().seq)
+                {
+                    if (auto offers = index.getOffers(*ledger, book, limit))
+                        return offers;
+                }
+                std::this_thread::sleep_for(10ms);
+            }
+            return std::shared_ptr<BookIndex::Offers const>{};
+        };
+
+        auto bookOffers = [&](unsigned int limit) {
+            Json::Value jvParams;
+            jvParams[jss::limit] = limit;
+            jvParams[jss::ledger_index] = "validated";
+            jvParams[jss::taker_pays][jss::currency] = "XRP";
+            jvParams[jss::taker_gets][jss::currency] = "USD";
+            jvParams[jss::taker_gets][jss::issuer] = gw.human();
+            auto const jrr = env.rpc(
+                "json", "book_offers", to_string(jvParams))[jss::result];
+            return jrr[jss::offers];
+        };
+
+        auto offers = indexed(2);
+        if (!BEAST_EXPECT(offers))
+            return;
+        BEAST_EXPECT(offers->offers.size() == 2 && !offers->complete);
+        BEAST_EXPECT(
+            offers->offers[0]->getFieldAmount(sfTakerPays) == XRP(50));
+
+        // Only the validated ledger is indexed, to the number of offers kept
+        auto const validated =
+            env.app().getLedgerMaster().getValidatedLedger();
+        BEAST_EXPECT(!index.getOffers(*validated, book, 3));
+        BEAST_EXPECT(!index.getOffers(*env.current(), book, 1));
+
+        // Pages served from the index match those read from the ledger
+        auto const fromIndex = bookOffers(2);
+        auto const fromLedger = bookOffers(3);
+        BEAST_EXPECT(fromIndex.size() == 2 && fromLedger.size() == 3);
+        BEAST_EXPECT(
+            fromIndex[0u] == fromLedger[0u] && fromIndex[1u] == fromLedger[1u]);
+
+        // A ledger taking an offer of the book drops it from the index
+        env(offer(alice, USD(1), XRP(50)));
+        env.close();
+        offers = indexed(2);
+        if (!BEAST_EXPECT(offers))
+            return;
+        BEAST_EXPECT(offers->offers.size() == 2 && offers->complete);
+        BEAST_EXPECT(
+            offers->offers[0]->getFieldAmount(sfTakerPays) == XRP(60));
+        BEAST_EXPECT(bookOffers(2) == bookOffers(3));
+    }
+
+    void
+    testOrderBookDB()
+    {
+        testcase("OrderBookDB follows validated ledgers");
+        using namespace jtx;
+        using namespace std::chrono_literals;
+        Env env(*this);
+        Account gw{"gw"};
+        env.fund(XRP(10000), gw);
+        env.close();
+        auto USD = gw["USD"];
+        auto& db = env.app().getOrderBookDB();
+
+        // Validated ledgers are processed by a job once they are published
+        auto eventually = [&](auto&& condition) {
+            for (int i = 0; i < 100; ++i)
+            {
+                if (condition())
+                    return true;
+                std::this_thread::sleep_for(10ms);
+            }
+            return false;
+        };
+
+        auto const seq = env.seq(gw);
+        env(offer(gw, USD(1), XRP(50)));
+        env.close();
+        BEAST_EXPECT(eventually([&] {
+            return db.getBookSize(USD.issue()) == 1 &&
+                db.isBookToXRP(USD.issue());
+        }));
+
+        // The book goes when the directory of its only quality is deleted
+        env(offer_cancel(gw, seq));
+        env.close();
+        BEAST_EXPECT(eventually([&] {
+            return db.getBookSize(USD.issue()) == 0 &&
+                !db.isBookToXRP(USD.issue());
+        }));
+    }
+
     void
     run() override
     {
@@ -1726,6 +1951,9 @@ public:
         testBookOfferErrors();
         testBookOfferLimits(true);
         testBookOfferLimits(false);
+        testBookOffersGrpc();
+        testBookIndex();
+        testOrderBookDB();
     }
 };
 
@@ -19,6 +19,7 @@
 
 #include <ripple/app/misc/AmendmentTable.h>
 #include <ripple/protocol/Feature.h>
+#include <ripple/protocol/Rules.h>
 #include <ripple/protocol/jss.h>
 #include <test/jtx.h>
 
@@ -103,6 +104,35 @@ class Feature_test : public beast::unit_test::suite
         BEAST_EXPECT(
             featureToName(fixTakerDryOfferRemoval) ==
             "fixTakerDryOfferRemoval");
+
+        // Registered features carry their bitset index
+        BEAST_EXPECT(featureFlow.index() == featureToBitsetIndex(featureFlow));
+        BEAST_EXPECT(fix1578.index() == featureToBitsetIndex(fix1578));
+        BEAST_EXPECT(findFeatureBitsetIndex(featureDID) == featureDID.index());
+        BEAST_EXPECT(!findFeatureBitsetIndex(zero));
+    }
+
+    void
+    testRules()
+    {
+        testcase("Rules");
+
+        uint256 const unknown{1};
+        std::unordered_set<uint256, beast::uhash<>> const presets{
+            featureFlow, featureNonFungibleTokensV1_1, unknown};
+        Rules const rules{presets};
+
+        BEAST_EXPECT(rules.enabled(featureFlow));
+        BEAST_EXPECT(rules.enabled(uint256{featureFlow}));
+        BEAST_EXPECT(!rules.enabled(featureDID));
+        BEAST_EXPECT(!rules.enabled(uint256{featureDID}));
+        BEAST_EXPECT(rules.enabled(unknown));
+        BEAST_EXPECT(!rules.enabled(uint256{2}));
+
+        // Implied by NonFungibleTokensV1_1
+        BEAST_EXPECT(rules.enabled(featureNonFungibleTokensV1));
+        BEAST_EXPECT(rules.enabled(uint256{fixNFTokenNegOffer}));
+        BEAST_EXPECT(rules.enabled(fixNFTokenDirV1));
     }
 
     void
@@ -561,6 +591,7 @@ public:
     {
         testInternals();
         testFeatureLookups();
+        testRules();
         testNoParams();
         testSingleFeature();
         testInvalidFeature();
@@ -15,7 +15,10 @@
 */
 //==============================================================================
 
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/ledger/ObligationsIndex.h>
 #include <ripple/beast/unit_test.h>
+#include <ripple/core/ConfigSections.h>
 #include <ripple/protocol/Feature.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
@@ -241,6 +244,124 @@ public:
         expect(jv[jss::result][jss::obligations]["USD"] == maxUSD.getText());
     }
 
+    void
+    testGWBIndex()
+    {
+        testcase("Obligations index");
+        using namespace std::chrono_literals;
+        using namespace jtx;
+
+        Account const alice{"alice"};
+        Env env{*this, envconfig([&alice](std::unique_ptr<Config> cfg) {
+                    cfg->section(SECTION_OBLIGATIONS_INDEX)
+                        .append(alice.human());
+                    return cfg;
+                })};
+
+        auto USD = alice["USD"];
+        auto CNY = alice["CNY"];
+        Account const hw{"hw"};
+        Account const bob{"bob"};
+        Account const carol{"carol"};
+        env.fund(XRP(10000), alice, hw, bob, carol);
+        env.close();
+        env(trust(hw, USD(10000)));
+        env(trust(bob, USD(100)));
+        env(trust(bob, CNY(100)));
+        env(trust(carol, CNY(500)));
+        env(pay(alice, hw, USD(5000)));
+        env(pay(alice, bob, USD(50)));
+        env(pay(alice, bob, CNY(20)));
+        env(pay(alice, carol, CNY(250)));
+        env.close();
+
+        auto& index = env.app().getObligationsIndex();
+
+        // Ledgers are indexed by a job once they are validated
+        auto indexed = [&]() {
+            for (int i = 0; i < 100; ++i)
+            {
+                auto const ledger =
+                    env.app().getLedgerMaster().getValidatedLedger();
+                if (ledger->info().seq == env.closed()->info().seq)
+                {
+                    if (auto balances = index.getBalances(*ledger, alice))
+                        return balances;
+                }
+                std::this_thread::sleep_for(10ms);
+            }
+            return std::shared_ptr<ObligationsIndex::Balances const>{};
+        };
+
+        // The open ledger is never indexed, so compare what is served
+        // from the index with what is read from the trust lines.
+        auto check = [&]() {
+            Json::Value query;
+            query[jss::account] = alice.human();
+            query[jss::hotwallet] = hw.human();
+            query[jss::ledger_index] = "validated";
+            auto const fromIndex = env.rpc(
+                "json", "gateway_balances", to_string(query))[jss::result];
+            query[jss::ledger_index] = "current";
+            auto const fromLedger = env.rpc(
+                "json", "gateway_balances", to_string(query))[jss::result];
+            for (auto const& field :
+                 {jss::obligations,
+                  jss::balances,
+                  jss::frozen_balances,
+                  jss::assets})
+                BEAST_EXPECT(fromIndex[field] == fromLedger[field]);
+            return fromIndex;
+        };
+
+        auto balances = indexed();
+        if (!BEAST_EXPECT(balances))
+            return;
+        BEAST_EXPECT(balances->obligations.size() == 2);
+        BEAST_EXPECT(!index.getBalances(*env.current(), alice));
+        BEAST_EXPECT(!index.getBalances(
+            *env.app().getLedgerMaster().getValidatedLedger(), bob));
+
+        auto result = check();
+        BEAST_EXPECT(result[jss::obligations]["USD"] == "50");
+        BEAST_EXPECT(result[jss::obligations]["CNY"] == "270");
+        BEAST_EXPECT(
+            result[jss::balances][hw.human()][0u][jss::value] == "5000");
+
+        // Following ledgers change the indexed balances
+        env(pay(bob, carol, CNY(20)));
+        env(pay(hw, bob, USD(25)));
+        env(trust(alice, carol["CNY"](0), carol, tfSetFreeze));
+        env(trust(alice, bob["USD"](10)));
+        env(pay(bob, alice, USD(5)));
+        env.close();
+
+        balances = indexed();
+        if (!BEAST_EXPECT(balances))
+            return;
+        BEAST_EXPECT(balances->frozen.size() == 1);
+        BEAST_EXPECT(balances->assets.empty());
+
+        result = check();
+        BEAST_EXPECT(result[jss::obligations]["USD"] == "70");
+        BEAST_EXPECT(!result[jss::obligations].isMember("CNY"));
+        BEAST_EXPECT(
+            result[jss::frozen_balances][carol.human()][0u][jss::value] ==
+            "270");
+
+        // Paying every obligation back removes the currency
+        env(pay(bob, alice, USD(70)));
+        env(pay(hw, alice, USD(4975)));
+        env.close();
+
+        balances = indexed();
+        if (!BEAST_EXPECT(balances))
+            return;
+        BEAST_EXPECT(balances->obligations.empty());
+        result = check();
+        BEAST_EXPECT(!result.isMember(jss::obligations));
+    }
+
     void
     run() override
     {
@@ -253,6 +374,7 @@ public:
         }
 
         testGWBOverflow();
+        testGWBIndex();
     }
 };
 
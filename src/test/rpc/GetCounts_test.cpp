@@ -77,6 +77,16 @@ class GetCounts_test : public beast::unit_test::suite
                 BEAST_EXPECTS(result[it.first].asInt() == it.second, it.first);
             }
             BEAST_EXPECT(!result.isMember(jss::local_txs));
+
+            // the memory held by each type which accounts for it
+            auto const& bytes = result[jss::object_bytes];
+            BEAST_EXPECT(bytes.isObject());
+            BEAST_EXPECT(bytes.isMember("SHAMapInnerNode"));
+            for (auto const& name : bytes.getMemberNames())
+            {
+                BEAST_EXPECTS(result.isMember(name), name);
+                BEAST_EXPECTS(std::stoll(bytes[name].asString()) > 0, name);
+            }
         }
 
         {
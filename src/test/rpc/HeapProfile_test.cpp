@@ -0,0 +1,100 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/HeapProfile.h>
+#include <ripple/protocol/jss.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class HeapProfile_test : public beast::unit_test::suite
+{
+    void
+    testStats()
+    {
+        testcase("stats");
+
+        using namespace jtx;
+        Env env{*this};
+
+        auto const jr = env.rpc("heap_profile")[jss::result];
+        BEAST_EXPECT(jr[jss::status] == "success");
+        BEAST_EXPECT(jr[jss::allocator] == heapProfile::allocator());
+        BEAST_EXPECT(jr[jss::profiling].isBool());
+        BEAST_EXPECT(!jr.isMember(jss::purged));
+        BEAST_EXPECT(!jr.isMember(jss::dumped));
+
+        // Byte counts are strings, and whatever the allocator reports of
+        // what the server holds can't be nothing
+        if (jr.isMember(jss::allocated))
+        {
+            BEAST_EXPECT(jr[jss::allocated].isString());
+            BEAST_EXPECT(std::stoull(jr[jss::allocated].asString()) > 0);
+        }
+
+        if (jr.isMember(jss::arenas))
+        {
+            BEAST_EXPECT(jr[jss::arenas].isArray());
+            for (auto const& arena : jr[jss::arenas])
+                BEAST_EXPECT(arena.isMember(jss::arena));
+        }
+    }
+
+    void
+    testControl()
+    {
+        testcase("control");
+
+        using namespace jtx;
+        Env env{*this};
+
+        auto jr = env.rpc("heap_profile", "purge")[jss::result];
+        if (jr[jss::status] == "success")
+            BEAST_EXPECT(jr[jss::purged].asBool());
+        else
+            BEAST_EXPECT(jr[jss::error] == "notSupported");
+
+        // Profiles can only be written if profiling was enabled at startup
+        jr = env.rpc("heap_profile", "dump")[jss::result];
+        if (jr[jss::status] == "success")
+            BEAST_EXPECT(jr[jss::dumped].asBool());
+        else
+            BEAST_EXPECT(jr[jss::error] == "notSupported");
+
+        jr = env.rpc("json", "heap_profile", R"({"purge": 1})")[jss::result];
+        BEAST_EXPECT(jr[jss::error] == "invalidParams");
+
+        jr = env.rpc("heap_profile", "collect")[jss::result];
+        BEAST_EXPECT(jr[jss::error] == "invalidParams");
+    }
+
+public:
+    void
+    run() override
+    {
+        testStats();
+        testControl();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(HeapProfile, rpc, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -18,8 +18,13 @@
 //==============================================================================
 
 #include <ripple/basics/StringUtilities.h>
+#include <ripple/json/json_reader.h>
 #include <ripple/protocol/jss.h>
+#include <ripple/rpc/impl/LedgerDataStream.h>
+#include <ripple/rpc/impl/StreamedResponse.h>
 #include <test/jtx.h>
+#include <boost/algorithm/string/predicate.hpp>
+#include <future>
 
 namespace ripple {
 
@@ -498,6 +503,194 @@ public:
         }
     }
 
+    // Pull everything from a stream the way a transport would.
+    template <class Source>
+    static std::string
+    drain(Source& source)
+    {
+        std::string out;
+        while (!source.complete())
+        {
+            std::promise<void> ready;
+            if (!source.prepare(0, [&ready] { ready.set_value(); }))
+            {
+                ready.get_future().wait();
+                continue;
+            }
+            for (auto const& b : source.data())
+            {
+                out.append(static_cast<char const*>(b.data()), b.size());
+                source.consume(b.size());
+            }
+        }
+        return out;
+    }
+
+    // Adapts a LedgerDataStream to drain.
+    struct StreamSource
+    {
+        std::shared_ptr<RPC::LedgerDataStream> stream;
+
+        bool
+        complete() const
+        {
+            return stream->complete();
+        }
+
+        bool
+        prepare(std::size_t, std::function<void()> resume)
+        {
+            return stream->prepare(std::move(resume));
+        }
+
+        std::vector<boost::asio::const_buffer>
+        data() const
+        {
+            return {stream->data()};
+        }
+
+        void
+        consume(std::size_t bytes)
+        {
+            stream->consume(bytes);
+        }
+    };
+
+    void
+    testStream()
+    {
+        testcase("Stream");
+        using namespace test::jtx;
+        Env env{*this};
+
+        // Enough objects to take several chunks.
+        for (auto i = 0; i < 300; ++i)
+            env.fund(XRP(1000), Account{"bob" + std::to_string(i)});
+        env.close();
+
+        auto const ledger = env.closed();
+        std::vector<uint256> keys;
+        for (auto const& sle : ledger->sles)
+            keys.push_back(sle->key());
+
+        Json::Value header;
+        header[jss::ledger_index] = ledger->info().seq;
+
+        auto makeStream = [&](uint256 const& marker,
+                              bool binary,
+                              std::optional<std::uint32_t> limit) {
+            auto stream = std::make_shared<RPC::LedgerDataStream>(
+                env.app().getJobQueue(),
+                ledger,
+                header,
+                marker,
+                ltANY,
+                binary,
+                limit);
+            stream->setEnvelope("{\"result\":{", ",\"status\":1}}");
+            return stream;
+        };
+
+        auto parse = [&](std::string const& text) {
+            Json::Value jv;
+            BEAST_EXPECT(Json::Reader{}.parse(text, jv));
+            return jv[jss::result];
+        };
+
+        {
+            // The whole ledger in one response.
+            StreamSource source{makeStream({}, false, std::nullopt)};
+            auto const text = drain(source);
+            BEAST_EXPECT(text.size() > RPC::Tuning::streamChunkSize);
+            auto const result = parse(text);
+            BEAST_EXPECT(result[jss::ledger_index] == ledger->info().seq);
+            BEAST_EXPECT(result[jss::status] == 1);
+            BEAST_EXPECT(!result.isMember(jss::marker));
+            auto const& state = result[jss::state];
+            BEAST_EXPECT(state.size() == keys.size());
+            for (Json::UInt i = 0; i < state.size(); ++i)
+            {
+                BEAST_EXPECT(state[i][jss::index] == to_string(keys[i]));
+                BEAST_EXPECT(state[i].isMember(sfLedgerEntryType.jsonName));
+            }
+        }
+
+        {
+            // A limited stream ends with a marker to resume from.
+            StreamSource first{makeStream({}, true, 10)};
+            auto const head = parse(drain(first));
+            BEAST_EXPECT(head[jss::state].size() == 10);
+            BEAST_EXPECT(head[jss::state][0u].isMember(jss::data));
+            BEAST_EXPECT(checkMarker(head));
+
+            uint256 marker;
+            BEAST_EXPECT(marker.parseHex(head[jss::marker].asString()));
+            StreamSource rest{makeStream(marker, true, std::nullopt)};
+            auto const tail = parse(drain(rest));
+            BEAST_EXPECT(!tail.isMember(jss::marker));
+            BEAST_EXPECT(tail[jss::state].size() == keys.size() - 10);
+            BEAST_EXPECT(
+                tail[jss::state][0u][jss::index] == to_string(keys[10]));
+        }
+
+        {
+            // Raw records, ending with an empty record.
+            auto stream = makeStream({}, true, std::nullopt);
+            stream->useRawFormat();
+            StreamSource source{stream};
+            auto const raw = drain(source);
+
+            std::vector<uint256> seen;
+            std::size_t pos = 0;
+            bool ended = false;
+            while (!ended && pos + 36 <= raw.size())
+            {
+                auto const key = uint256::fromVoid(raw.data() + pos);
+                std::uint32_t size = 0;
+                for (int i = 0; i < 4; ++i)
+                    size = (size << 8) |
+                        static_cast<unsigned char>(raw[pos + 32 + i]);
+                pos += 36;
+                if (key == beast::zero)
+                {
+                    ended = true;
+                    BEAST_EXPECT(size == 0);
+                    break;
+                }
+                SerialIter sit(raw.data() + pos, size);
+                STLedgerEntry const sle(sit, key);
+                BEAST_EXPECT(sle == *ledger->read(keylet::unchecked(key)));
+                seen.push_back(key);
+                pos += size;
+            }
+            BEAST_EXPECT(ended && pos == raw.size());
+            BEAST_EXPECT(seen == keys);
+        }
+
+        {
+            // Chunked HTTP framing.
+            RPC::ChunkedStreamWriter writer(
+                makeStream({}, false, 5), "HTTP/1.1 200 OK\r\n");
+            auto const text = drain(writer);
+            auto const body = text.find("\r\n\r\n");
+            BEAST_EXPECT(
+                text.find("Transfer-Encoding: chunked\r\n") < body);
+            BEAST_EXPECT(
+                boost::algorithm::ends_with(text, "\r\n0\r\n\r\n"));
+        }
+
+        {
+            // Transports which can not stream refuse the request.
+            Json::Value jvParams;
+            jvParams[jss::stream] = true;
+            auto const jrr = env.rpc(
+                "json",
+                "ledger_data",
+                boost::lexical_cast<std::string>(jvParams))[jss::result];
+            BEAST_EXPECT(jrr[jss::error] == "notSupported");
+        }
+    }
+
     void
     run() override
     {
@@ -508,6 +701,7 @@ public:
         testMarkerFollow();
         testLedgerHeader();
         testLedgerType();
+        testStream();
     }
 };
 
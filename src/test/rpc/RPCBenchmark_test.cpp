@@ -0,0 +1,410 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/protocol/jss.h>
+#include <test/jtx.h>
+#include <test/jtx/JSONRPCClient.h>
+#include <test/jtx/WSClient.h>
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace ripple {
+namespace test {
+
+/** Measures RPC throughput and latency against a fixed ledger.
+
+    A standalone server is given many funded accounts with trust lines,
+    payment history and a deep order book. Then, once over JSON-RPC and
+    once over WebSockets, several clients each send a fixed mix of
+    account_info, account_lines, account_tx, book_offers,
+    ripple_path_find, ledger_data and submit requests, as fast as the
+    server answers them.
+
+    Requests per second are reported for each transport, and the 50th,
+    99th and 99.9th percentile latencies for each method. Every run
+    builds the same ledger and sends the same requests, so results can
+    be compared between versions.
+
+    The argument is a list of options separated by ';':
+
+        accounts=N      Funded accounts (default 200).
+        offers=N        Offers in the order book (default 200).
+        clients=N       Clients sending requests at once (default 8).
+        requests=N      Requests sent by each client (default 2000).
+
+    For example:
+
+        --unittest=RPCBenchmark --unittest-arg="clients=32;requests=5000"
+*/
+class RPCBenchmark_test : public beast::unit_test::suite
+{
+    using clock_type = std::chrono::steady_clock;
+
+    struct Options
+    {
+        std::size_t accounts = 200;
+        std::size_t offers = 200;
+        std::size_t clients = 8;
+        std::size_t requests = 2000;
+    };
+
+    enum Method {
+        accountInfo,
+        accountLines,
+        accountTx,
+        bookOffers,
+        pathFind,
+        ledgerData,
+        submit,
+        methodCount
+    };
+
+    static constexpr std::array<char const*, methodCount> names = {
+        "account_info",
+        "account_lines",
+        "account_tx",
+        "book_offers",
+        "ripple_path_find",
+        "ledger_data",
+        "submit"};
+
+    // Out of every 100 requests
+    static constexpr std::array<int, methodCount> weights =
+        {30, 15, 15, 15, 5, 5, 15};
+
+    struct Request
+    {
+        Method method;
+        Json::Value params;
+    };
+
+    struct Results
+    {
+        std::array<std::vector<std::chrono::microseconds>, methodCount>
+            latencies;
+        std::size_t errors = 0;
+    };
+
+    static Options
+    parse(std::string const& args)
+    {
+        Options options;
+        std::vector<std::string> entries;
+        boost::split(entries, args, boost::algorithm::is_any_of(";"));
+        for (auto const& entry : entries)
+        {
+            auto const eq = entry.find('=');
+            if (eq == std::string::npos)
+                continue;
+            auto const key = entry.substr(0, eq);
+            auto const value = std::stoul(entry.substr(eq + 1));
+            if (key == "accounts")
+                options.accounts = value;
+            else if (key == "offers")
+                options.offers = value;
+            else if (key == "clients")
+                options.clients = value;
+            else if (key == "requests")
+                options.requests = value;
+        }
+        options.clients = std::max<std::size_t>(options.clients, 1);
+        options.accounts = std::max(options.accounts, options.clients);
+        return options;
+    }
+
+    static Method
+    pick(std::mt19937& rng)
+    {
+        auto n = std::uniform_int_distribution<int>(0, 99)(rng);
+        for (int m = 0; m < methodCount; ++m)
+        {
+            if (n < weights[m])
+                return static_cast<Method>(m);
+            n -= weights[m];
+        }
+        return accountInfo;
+    }
+
+    // The requests each client sends, the same in every run except for
+    // the sequence numbers of the transactions submitted.
+    std::vector<std::vector<Request>>
+    makeRequests(
+        jtx::Env& env,
+        std::vector<jtx::Account> const& users,
+        std::vector<std::uint32_t>& sequences,
+        jtx::Account const& gw,
+        Options const& options)
+    {
+        using namespace jtx;
+        auto const USD = gw["USD"];
+
+        std::vector<std::vector<Request>> clients(options.clients);
+        for (std::size_t c = 0; c < options.clients; ++c)
+        {
+            std::mt19937 rng(static_cast<std::uint32_t>(c));
+            auto user = [&]() -> Account const& {
+                return users[std::uniform_int_distribution<std::size_t>(
+                    0, users.size() - 1)(rng)];
+            };
+
+            // Each client submits from its own accounts, in order, so
+            // that no transaction waits for another client's.
+            auto const own = perClient(options, c);
+            std::size_t submitted = 0;
+
+            auto& requests = clients[c];
+            requests.reserve(options.requests);
+            for (std::size_t i = 0; i < options.requests; ++i)
+            {
+                Request request{pick(rng), Json::objectValue};
+                auto& params = request.params;
+                switch (request.method)
+                {
+                    case accountInfo:
+                    case accountLines:
+                        params[jss::account] = user().human();
+                        break;
+                    case accountTx:
+                        params[jss::account] = user().human();
+                        params[jss::limit] = 20;
+                        break;
+                    case bookOffers:
+                        params[jss::taker_gets][jss::currency] = "XRP";
+                        params[jss::taker_pays][jss::currency] = "USD";
+                        params[jss::taker_pays][jss::issuer] = gw.human();
+                        params[jss::limit] = 20;
+                        break;
+                    case pathFind:
+                        params[jss::source_account] = user().human();
+                        params[jss::destination_account] = user().human();
+                        params[jss::destination_amount] =
+                            USD(10).value().getJson(JsonOptions::none);
+                        break;
+                    case ledgerData:
+                        params[jss::limit] = 256;
+                        break;
+                    case submit: {
+                        auto const n =
+                            c + options.clients * (submitted++ % own);
+                        auto const jt = env.jt(
+                            pay(users[n], gw, XRP(1)), seq(sequences[n]++));
+                        params[jss::tx_blob] =
+                            strHex(jt.stx->getSerializer().slice());
+                        break;
+                    }
+                    default:
+                        break;
+                }
+                requests.push_back(std::move(request));
+            }
+        }
+        return clients;
+    }
+
+    // The number of accounts client c submits from
+    static std::size_t
+    perClient(Options const& options, std::size_t c)
+    {
+        return (options.accounts - c + options.clients - 1) / options.clients;
+    }
+
+    static void
+    send(
+        AbstractClient& client,
+        std::vector<Request> const& requests,
+        Results& results)
+    {
+        for (auto& latencies : results.latencies)
+            latencies.reserve(requests.size());
+
+        for (auto const& request : requests)
+        {
+            auto const start = clock_type::now();
+            auto const jr =
+                client.invoke(names[request.method], request.params);
+            results.latencies[request.method].push_back(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    clock_type::now() - start));
+            if (jr.isMember(jss::error) ||
+                jr[jss::result].isMember(jss::error))
+                ++results.errors;
+        }
+    }
+
+    void
+    measure(
+        std::string const& transport,
+        std::function<std::unique_ptr<AbstractClient>()> const& connect,
+        std::vector<std::vector<Request>> const& requests)
+    {
+        std::vector<std::unique_ptr<AbstractClient>> clients;
+        for (std::size_t c = 0; c < requests.size(); ++c)
+            clients.push_back(connect());
+
+        std::vector<Results> results(requests.size());
+        auto const start = clock_type::now();
+        {
+            std::vector<std::thread> threads;
+            for (std::size_t c = 0; c < requests.size(); ++c)
+                threads.emplace_back([&, c]() {
+                    send(*clients[c], requests[c], results[c]);
+                });
+            for (auto& t : threads)
+                t.join();
+        }
+        std::chrono::duration<double> const elapsed =
+            clock_type::now() - start;
+
+        Results all;
+        std::size_t total = 0;
+        for (auto const& r : results)
+        {
+            for (int m = 0; m < methodCount; ++m)
+                all.latencies[m].insert(
+                    all.latencies[m].end(),
+                    r.latencies[m].begin(),
+                    r.latencies[m].end());
+            all.errors += r.errors;
+        }
+
+        using std::setw;
+        std::stringstream ss;
+        ss << std::left << setw(20) << transport << std::right << setw(8)
+           << "Count" << setw(10) << "p50 us" << setw(10) << "p99 us"
+           << setw(10) << "p999 us";
+        log << ss.str() << std::endl;
+
+        for (int m = 0; m < methodCount; ++m)
+        {
+            auto& latencies = all.latencies[m];
+            total += latencies.size();
+            if (latencies.empty())
+                continue;
+
+            std::sort(latencies.begin(), latencies.end());
+            auto const percentile = [&latencies](std::size_t p) {
+                return latencies[std::min(
+                                     latencies.size() - 1,
+                                     latencies.size() * p / 1000)]
+                    .count();
+            };
+
+            ss.str({});
+            ss << std::left << setw(20) << names[m] << std::right << setw(8)
+               << latencies.size() << setw(10) << percentile(500) << setw(10)
+               << percentile(990) << setw(10) << percentile(999);
+            log << ss.str() << std::endl;
+        }
+
+        log << transport << ": "
+            << static_cast<std::size_t>(total / elapsed.count())
+            << " requests/s, " << all.errors << " errors" << std::endl;
+        BEAST_EXPECTS(
+            all.errors == 0,
+            transport + ": " + std::to_string(all.errors) + " errors");
+    }
+
+public:
+    void
+    run() override
+    {
+        testcase("RPCBenchmark");
+        using namespace jtx;
+
+        auto const options = parse(arg());
+
+        // Every submitted transaction goes into the open ledger
+        Env env(
+            *this,
+            envconfig([](std::unique_ptr<Config> cfg) {
+                cfg->section("transaction_queue")
+                    .set("minimum_txn_in_ledger_standalone", "1000000");
+                return cfg;
+            }),
+            supported_amendments());
+        Account const gw("gateway");
+        Account const maker("maker");
+        auto const USD = gw["USD"];
+
+        std::vector<Account> users;
+        for (std::size_t i = 0; i < options.accounts; ++i)
+            users.emplace_back("user" + std::to_string(i));
+
+        // Accounts, trust lines and balances
+        env.fund(XRP(100'000'000), gw, maker);
+        env(fset(gw, asfDefaultRipple));
+        env.close();
+        for (auto const& user : users)
+            env.fund(XRP(1'000'000), user);
+        env.close();
+        for (auto const& account : users)
+            env(trust(account, USD(1'000'000'000)));
+        env(trust(maker, USD(1'000'000'000)));
+        env.close();
+        for (auto const& user : users)
+            env(pay(gw, user, USD(1'000'000)));
+        env(pay(gw, maker, USD(100'000'000)));
+        env.close();
+
+        // A deep XRP/USD book, each offer worse than the last
+        for (std::size_t i = 0; i < options.offers; ++i)
+            env(offer(maker, XRP(1000 + 10 * i), USD(100)));
+        env.close();
+
+        // Some history for account_tx to find
+        for (int round = 0; round < 5; ++round)
+        {
+            for (std::size_t i = 0; i < users.size(); ++i)
+                env(pay(users[i], users[(i + 1) % users.size()], USD(10)));
+            env.close();
+        }
+
+        std::vector<std::uint32_t> sequences;
+        for (auto const& user : users)
+            sequences.push_back(env.seq(user));
+
+        log << options.clients << " clients, " << options.requests
+            << " requests each" << std::endl;
+
+        auto const& config = env.app().config();
+        measure(
+            "JSON-RPC",
+            [&config] { return makeJSONRPCClient(config); },
+            makeRequests(env, users, sequences, gw, options));
+        env.close();
+
+        measure(
+            "WebSocket",
+            [&config] { return makeWSClient(config); },
+            makeRequests(env, users, sequences, gw, options));
+        env.close();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(RPCBenchmark, rpc, ripple, 10);
+
+}  // namespace test
+}  // namespace ripple
@@ -3160,6 +3160,77 @@ static RPCCallTestData const rpcCallTestArray[] = {
      RPCCallTestData::bad_cast,
      R"()"},
 
+    // heap_profile
+    // ------------------------------------------------------------------
+    {"heap_profile: minimal.",
+     __LINE__,
+     {
+         "heap_profile",
+     },
+     RPCCallTestData::no_exception,
+     R"({
+    "method" : "heap_profile",
+    "params" : [
+      {
+         "api_version" : %API_VER%,
+      }
+    ]
+    })"},
+    {"heap_profile: purge.",
+     __LINE__,
+     {"heap_profile", "purge"},
+     RPCCallTestData::no_exception,
+     R"({
+    "method" : "heap_profile",
+    "params" : [
+      {
+         "api_version" : %API_VER%,
+         "purge" : true
+      }
+    ]
+    })"},
+    {"heap_profile: dump.",
+     __LINE__,
+     {"heap_profile", "dump"},
+     RPCCallTestData::no_exception,
+     R"({
+    "method" : "heap_profile",
+    "params" : [
+      {
+         "api_version" : %API_VER%,
+         "dump" : true
+      }
+    ]
+    })"},
+    {"heap_profile: too many arguments.",
+     __LINE__,
+     {"heap_profile", "purge", "dump"},
+     RPCCallTestData::no_exception,
+     R"({
+    "method" : "heap_profile",
+    "params" : [
+      {
+         "error" : "badSyntax",
+         "error_code" : 1,
+         "error_message" : "Syntax error."
+      }
+    ]
+    })"},
+    {"heap_profile: invalid argument.",
+     __LINE__,
+     {"heap_profile", "collect"},
+     RPCCallTestData::no_exception,
+     R"({
+    "method" : "heap_profile",
+    "params" : [
+      {
+         "error" : "invalidParams",
+         "error_code" : 31,
+         "error_message" : "Invalid parameters."
+      }
+    ]
+    })"},
+
     // json
     // ------------------------------------------------------------------------
     {"json: minimal.",
@@ -0,0 +1,242 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/ErrorCodes.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/rpc/ResponseCache.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace ripple {
+namespace test {
+
+class ResponseCache_test : public beast::unit_test::suite
+{
+    beast::Journal const j_{beast::Journal::getNullSink()};
+
+    static Json::Value
+    request(std::string const& account, int id)
+    {
+        Json::Value params{Json::objectValue};
+        params[jss::command] = "account_info";
+        params[jss::account] = account;
+        params[jss::ledger_index] = "validated";
+        params[jss::id] = id;
+        return params;
+    }
+
+    void
+    testKey()
+    {
+        testcase("key");
+
+        using RPC::ResponseCache;
+        auto const key = ResponseCache::makeKey(
+            "account_info", request("alice", 1), 1, Role::USER);
+
+        // The request id does not matter
+        BEAST_EXPECT(
+            key ==
+            ResponseCache::makeKey(
+                "account_info", request("alice", 2), 1, Role::USER));
+
+        // Member order does not matter
+        Json::Value reordered{Json::objectValue};
+        reordered[jss::ledger_index] = "validated";
+        reordered[jss::account] = "alice";
+        BEAST_EXPECT(
+            key ==
+            ResponseCache::makeKey(
+                "account_info", reordered, 1, Role::USER));
+
+        // The parameters, method, API version and role do
+        BEAST_EXPECT(
+            key !=
+            ResponseCache::makeKey(
+                "account_info", request("bob", 1), 1, Role::USER));
+        BEAST_EXPECT(
+            key !=
+            ResponseCache::makeKey(
+                "account_lines", request("alice", 1), 1, Role::USER));
+        BEAST_EXPECT(
+            key !=
+            ResponseCache::makeKey(
+                "account_info", request("alice", 1), 2, Role::USER));
+        BEAST_EXPECT(
+            key !=
+            ResponseCache::makeKey(
+                "account_info", request("alice", 1), 1, Role::ADMIN));
+    }
+
+    void
+    testFetch()
+    {
+        testcase("fetch");
+
+        RPC::ResponseCache cache({"account_info", "submit", "fee"}, j_, 2);
+        BEAST_EXPECT(cache.enabled("account_info"));
+        BEAST_EXPECT(cache.enabled("fee"));
+        BEAST_EXPECT(!cache.enabled("submit"));
+        BEAST_EXPECT(!cache.enabled("server_info"));
+
+        int calls = 0;
+        auto const compute = [&calls](Json::Value& result) -> RPC::Status {
+            result[jss::status] = ++calls;
+            return RPC::Status::OK;
+        };
+        auto const failure = [&calls](Json::Value& result) -> RPC::Status {
+            ++calls;
+            RPC::inject_error(rpcACT_NOT_FOUND, result);
+            return rpcACT_NOT_FOUND;
+        };
+
+        uint256 const ledger1{1};
+        uint256 const ledger2{2};
+
+        Json::Value result;
+        BEAST_EXPECT(!cache.fetch("a", ledger1, result, compute));
+        BEAST_EXPECT(result[jss::status] == 1);
+
+        // Identical requests share the response until the ledgers change
+        result.clear();
+        BEAST_EXPECT(!cache.fetch("a", ledger1, result, compute));
+        BEAST_EXPECT(result[jss::status] == 1);
+        BEAST_EXPECT(calls == 1);
+        BEAST_EXPECT(cache.size() == 1);
+
+        BEAST_EXPECT(!cache.fetch("b", ledger1, result, compute));
+        BEAST_EXPECT(result[jss::status] == 2);
+        BEAST_EXPECT(cache.size() == 2);
+
+        // The cache is full
+        BEAST_EXPECT(!cache.fetch("c", ledger1, result, compute));
+        BEAST_EXPECT(!cache.fetch("c", ledger1, result, compute));
+        BEAST_EXPECT(result[jss::status] == 4);
+        BEAST_EXPECT(cache.size() == 2);
+
+        BEAST_EXPECT(!cache.fetch("a", ledger2, result, compute));
+        BEAST_EXPECT(result[jss::status] == 5);
+        BEAST_EXPECT(cache.size() == 1);
+
+        // Errors are not kept
+        result.clear();
+        BEAST_EXPECT(cache.fetch("d", ledger2, result, failure));
+        BEAST_EXPECT(result.isMember(jss::error));
+        BEAST_EXPECT(cache.fetch("d", ledger2, result, failure));
+        BEAST_EXPECT(calls == 7);
+        BEAST_EXPECT(cache.size() == 1);
+
+        // Nor are exceptions
+        try
+        {
+            cache.fetch("e", ledger2, result, [](Json::Value&) -> RPC::Status {
+                Throw<std::runtime_error>("failed");
+                return RPC::Status::OK;
+            });
+            fail();
+        }
+        catch (std::runtime_error const&)
+        {
+            pass();
+        }
+        BEAST_EXPECT(cache.size() == 1);
+        BEAST_EXPECT(!cache.fetch("e", ledger2, result, compute));
+        BEAST_EXPECT(result[jss::status] == 8);
+    }
+
+    void
+    testCoalesce()
+    {
+        testcase("coalesce");
+
+        RPC::ResponseCache cache({"fee"}, j_);
+        uint256 const ledger{1};
+
+        std::mutex mutex;
+        std::condition_variable cond;
+        bool started = false;
+        bool release = false;
+        std::atomic<int> calls = 0;
+
+        // The first request holds its computation until released
+        auto const slow = [&](Json::Value& result) -> RPC::Status {
+            ++calls;
+            std::unique_lock lock(mutex);
+            started = true;
+            cond.notify_all();
+            cond.wait(lock, [&] { return release; });
+            result[jss::status] = "slow";
+            return RPC::Status::OK;
+        };
+        auto const fast = [&](Json::Value& result) -> RPC::Status {
+            ++calls;
+            result[jss::status] = "fast";
+            return RPC::Status::OK;
+        };
+
+        Json::Value first;
+        std::thread runner(
+            [&] { BEAST_EXPECT(!cache.fetch("a", ledger, first, slow)); });
+        {
+            std::unique_lock lock(mutex);
+            cond.wait(lock, [&] { return started; });
+        }
+
+        std::vector<Json::Value> results(4);
+        std::vector<std::thread> waiters;
+        for (auto& result : results)
+            waiters.emplace_back([&] {
+                BEAST_EXPECT(!cache.fetch("a", ledger, result, fast));
+            });
+
+        // Give the waiters a chance to start waiting
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        {
+            std::lock_guard lock(mutex);
+            release = true;
+        }
+        cond.notify_all();
+
+        runner.join();
+        for (auto& waiter : waiters)
+            waiter.join();
+
+        BEAST_EXPECT(calls == 1);
+        BEAST_EXPECT(first[jss::status] == "slow");
+        for (auto const& result : results)
+            BEAST_EXPECT(result[jss::status] == "slow");
+    }
+
+public:
+    void
+    run() override
+    {
+        testKey();
+        testFetch();
+        testCoalesce();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ResponseCache, rpc, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,167 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/protocol/ErrorCodes.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/rpc/impl/Tuning.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class SubmitBatch_test : public beast::unit_test::suite
+{
+    static Json::Value
+    batch(Json::Value const& transactions)
+    {
+        Json::Value params{Json::objectValue};
+        params[jss::transactions] = transactions;
+        return params;
+    }
+
+    void
+    testBlobs()
+    {
+        testcase("blobs");
+
+        using namespace jtx;
+        Env env{*this};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        env.fund(XRP(10000), alice, bob);
+        env.close();
+
+        // Enough transactions to be checked on several threads, applied in
+        // the order they were given
+        std::size_t const count = 40;
+        auto const seq = env.seq(alice);
+        Json::Value blobs{Json::arrayValue};
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto const jt = env.jt(pay(alice, bob, XRP(1)), jtx::seq(seq + i));
+            blobs.append(strHex(jt.stx->getSerializer().slice()));
+        }
+
+        auto const jr = env.rpc(
+            "json", "submit_batch", to_string(batch(blobs)))[jss::result];
+        BEAST_EXPECT(jr[jss::status] == "success");
+        BEAST_EXPECT(jr[jss::transactions].size() == count);
+        for (auto const& result : jr[jss::transactions])
+        {
+            BEAST_EXPECT(result[jss::engine_result] == "tesSUCCESS");
+            BEAST_EXPECT(result[jss::applied].asBool());
+        }
+
+        env.close();
+        BEAST_EXPECT(env.seq(alice) == seq + count);
+        BEAST_EXPECT(env.balance(bob) == XRP(10000 + count));
+    }
+
+    void
+    testMixed()
+    {
+        testcase("mixed");
+
+        using namespace jtx;
+        Env env{*this};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        env.fund(XRP(10000), alice, bob);
+        env.close();
+
+        Json::Value transactions{Json::arrayValue};
+
+        auto const jt = env.jt(pay(alice, bob, XRP(1)));
+        transactions.append(strHex(jt.stx->getSerializer().slice()));
+
+        // Not a transaction
+        transactions.append("DEADBEEF");
+
+        // Signed by the server
+        Json::Value request{Json::objectValue};
+        request[jss::tx_json] = pay(bob, alice, XRP(2));
+        request[jss::secret] = toBase58(generateSeed("bob"));
+        transactions.append(request);
+
+        // Neither a blob nor a request
+        transactions.append(42);
+
+        auto const jr = env.rpc(
+            "json",
+            "submit_batch",
+            to_string(batch(transactions)))[jss::result];
+        BEAST_EXPECT(jr[jss::status] == "success");
+        auto const& results = jr[jss::transactions];
+        BEAST_EXPECT(results.size() == 4);
+        BEAST_EXPECT(results[0u][jss::engine_result] == "tesSUCCESS");
+        BEAST_EXPECT(results[1u][jss::error] == "invalidTransaction");
+        BEAST_EXPECT(results[2u][jss::engine_result] == "tesSUCCESS");
+        BEAST_EXPECT(results[3u][jss::error] == "invalidParams");
+
+        env.close();
+        BEAST_EXPECT(env.balance(alice) == XRP(10001) - drops(10));
+    }
+
+    void
+    testInvalid()
+    {
+        testcase("invalid");
+
+        using namespace jtx;
+        Env env{*this};
+
+        auto jr = env.rpc("json", "submit_batch", "{}")[jss::result];
+        BEAST_EXPECT(jr[jss::error] == "invalidParams");
+
+        jr = env.rpc(
+            "json",
+            "submit_batch",
+            to_string(batch("deadbeef")))[jss::result];
+        BEAST_EXPECT(jr[jss::error] == "invalidParams");
+
+        Json::Value tooMany{Json::arrayValue};
+        for (unsigned int i = 0; i <= RPC::Tuning::maxSubmitBatch; ++i)
+            tooMany.append("00");
+        jr = env.rpc(
+            "json", "submit_batch", to_string(batch(tooMany)))[jss::result];
+        BEAST_EXPECT(jr[jss::error] == "invalidParams");
+
+        // An empty batch submits nothing
+        jr = env.rpc(
+            "json",
+            "submit_batch",
+            to_string(batch(Json::Value{Json::arrayValue})))[jss::result];
+        BEAST_EXPECT(jr[jss::status] == "success");
+        BEAST_EXPECT(jr[jss::transactions].size() == 0);
+    }
+
+public:
+    void
+    run() override
+    {
+        testBlobs();
+        testMixed();
+        testInvalid();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SubmitBatch, rpc, ripple);
+
+}  // namespace test
+}  // namespace ripple
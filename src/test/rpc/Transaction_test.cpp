@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <ripple/app/rdb/backend/SQLiteDatabase.h>
+#include <ripple/core/ConfigSections.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/protocol/STBase.h>
 #include <ripple/protocol/jss.h>
@@ -695,6 +696,76 @@ class Transaction_test : public beast::unit_test::suite
         }
     }
 
+    void
+    testTxIndex(FeatureBitset features)
+    {
+        // Find transactions by hash and by CTID through the transaction
+        // index rather than the Transactions table.
+        testcase("tx index");
+
+        using namespace test::jtx;
+
+        Env env{*this, envconfig([](std::unique_ptr<Config> cfg) {
+                    cfg->NETWORK_ID = 11111;
+                    cfg->section(SECTION_TX_INDEX).set("type", "memory");
+                    return cfg;
+                }),
+                features};
+        auto const netID = env.app().config().NETWORK_ID;
+
+        auto const alice = Account("alice");
+        auto const bob = Account("bob");
+        env.fund(XRP(10000), alice, bob);
+        env.close();
+
+        auto const seq = env.current()->info().seq;
+        env(pay(alice, bob, XRP(10)));
+        auto const payID = env.tx()->getTransactionID();
+        env(noop(bob));
+        auto const noopID = env.tx()->getTransactionID();
+        env.close();
+
+        auto db = dynamic_cast<SQLiteDatabase*>(
+            &env.app().getRelationalDatabase());
+        if (!BEAST_EXPECT(db))
+            return;
+
+        for (auto const& id : {payID, noopID})
+        {
+            error_code_i ec = rpcSUCCESS;
+            auto const v = db->getTransaction(id, std::nullopt, ec);
+            auto const found = std::get_if<RelationalDatabase::AccountTx>(&v);
+            if (!BEAST_EXPECT(found && found->first && found->second))
+                continue;
+            BEAST_EXPECT(ec == rpcSUCCESS);
+            BEAST_EXPECT(found->first->getID() == id);
+            BEAST_EXPECT(found->first->getLedger() == seq);
+            BEAST_EXPECT(found->second->getLgrSeq() == seq);
+            BEAST_EXPECT(found->second->getResultTER() == tesSUCCESS);
+
+            auto const txnIndex = found->second->getIndex();
+            BEAST_EXPECT(db->getTransactionIdByIndex(seq, txnIndex) == id);
+
+            auto const ctid = *RPC::encodeCTID(seq, txnIndex, netID);
+            Json::Value jsonTx;
+            jsonTx[jss::ctid] = ctid;
+            auto const jrr =
+                env.rpc("json", "tx", to_string(jsonTx))[jss::result];
+            BEAST_EXPECT(jrr[jss::hash] == to_string(id));
+            BEAST_EXPECT(jrr[jss::ctid] == ctid);
+            BEAST_EXPECT(jrr[jss::validated] == true);
+        }
+        BEAST_EXPECT(!db->getTransactionIdByIndex(seq, 2));
+        BEAST_EXPECT(!db->getTransactionIdByIndex(seq + 1, 0));
+
+        // Online deletion removes the entries of older ledgers
+        db->deleteTransactionsBeforeLedgerSeq(seq + 1);
+        BEAST_EXPECT(!db->getTransactionIdByIndex(seq, 0));
+        error_code_i ec = rpcSUCCESS;
+        BEAST_EXPECT(std::holds_alternative<TxSearched>(
+            db->getTransaction(payID, std::nullopt, ec)));
+    }
+
     void
     testRequest(FeatureBitset features, unsigned apiVersion)
     {
@@ -863,6 +934,7 @@ public:
         testRangeCTIDRequest(features);
         testCTIDValidation(features);
         testCTIDRPC(features);
+        testTxIndex(features);
         test::jtx::forAllApiVersions(
             std::bind_front(&Transaction_test::testRequest, this, features));
     }
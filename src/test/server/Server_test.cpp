@@ -32,9 +32,11 @@
 #include <boost/asio.hpp>
 #include <boost/beast/core/tcp_stream.hpp>
 #include <boost/beast/ssl/ssl_stream.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/utility/in_place_factory.hpp>
 
 #include <chrono>
+#include <fstream>
 #include <optional>
 #include <stdexcept>
 #include <thread>
@@ -306,6 +308,75 @@ public:
         pass();
     }
 
+    void
+    localSocketTests()
+    {
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+        testcase("Local socket");
+        namespace fs = boost::filesystem;
+        TestSink sink{*this};
+        TestThread thread;
+        sink.threshold(beast::severities::Severity::kAll);
+        beast::Journal journal{sink};
+        TestHandler handler;
+        auto s = make_Server(handler, thread.get_io_service(), journal);
+        auto const path =
+            fs::temp_directory_path() / fs::unique_path("rippled-%%%%%%.sock");
+        std::vector<Port> serverPort(1);
+        serverPort.back().path = path.string();
+        serverPort.back().protocol.insert("http");
+        s->ports(serverPort);
+        BEAST_EXPECT(
+            fs::status(path).permissions() ==
+            static_cast<fs::perms>(serverPort.back().path_mode));
+
+        boost::asio::io_service ios;
+        using socket = boost::asio::local::stream_protocol::socket;
+        socket sock(ios);
+        if (connect(sock, socket::endpoint_type(path.string())) &&
+            write(
+                sock,
+                "GET / HTTP/1.1\r\n"
+                "Connection: close\r\n"
+                "\r\n"))
+            expect_read(sock, "Hello, world!\n");
+        boost::system::error_code ec;
+        sock.shutdown(socket::shutdown_both, ec);
+
+        auto const opens = [&](fs::path const& at) {
+            auto other = make_Server(handler, thread.get_io_service(), journal);
+            std::vector<Port> ports(1);
+            ports.back().path = at.string();
+            ports.back().protocol.insert("http");
+            try
+            {
+                other->ports(ports);
+                return true;
+            }
+            catch (std::exception const&)
+            {
+                return false;
+            }
+        };
+
+        // A socket another server listens on is not taken over
+        BEAST_EXPECT(!opens(path));
+        BEAST_EXPECT(fs::exists(path));
+
+        s = nullptr;
+        BEAST_EXPECT(!fs::exists(path));
+
+        // Nor is a file which isn't a socket removed
+        {
+            std::ofstream file(path.string());
+            file << "not a socket";
+        }
+        BEAST_EXPECT(!opens(path));
+        BEAST_EXPECT(fs::is_regular_file(path));
+        fs::remove(path);
+#endif
+    }
+
     void
     stressTest()
     {
@@ -442,6 +513,23 @@ public:
             messages.find("Missing 'protocol' in [port_rpc]") !=
             std::string::npos);
 
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+        except([&] {
+            Env env{
+                *this,
+                envconfig([](std::unique_ptr<Config> cfg) {
+                    (*cfg).deprecatedClearSection("port_rpc");
+                    (*cfg)["port_rpc"].set("path", "rippled.sock");
+                    (*cfg)["port_rpc"].set("protocol", "https");
+                    return cfg;
+                }),
+                std::make_unique<CaptureLogs>(&messages)};
+        });
+        BEAST_EXPECT(
+            messages.find("Protocol 'https' in [port_rpc] is not supported "
+                          "on a local socket") != std::string::npos);
+#endif
+
         except(
             [&]  // this creates a standard test config without the server
                  // section
@@ -507,6 +595,7 @@ public:
     run() override
     {
         basicTests();
+        localSocketTests();
         stressTest();
         testBadConfig();
     }
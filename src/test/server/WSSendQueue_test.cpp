@@ -0,0 +1,172 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/server/impl/WSSendQueue.h>
+
+namespace ripple {
+namespace test {
+
+class WSSendQueue_test : public beast::unit_test::suite
+{
+    class Msg : public WSMsg
+    {
+        std::size_t size_;
+
+    public:
+        int const id;
+
+        Msg(int id_, std::size_t size) : size_(size), id(id_)
+        {
+        }
+
+        std::pair<boost::tribool, std::vector<boost::asio::const_buffer>>
+        prepare(std::size_t, std::function<void(void)>) override
+        {
+            return {true, {}};
+        }
+
+        std::size_t
+        size() const override
+        {
+            return size_;
+        }
+    };
+
+    static Port
+    makePort(std::uint16_t limit, std::size_t bytes = 0)
+    {
+        Port port;
+        port.ws_queue_limit = limit;
+        port.ws_queue_bytes = bytes;
+        port.ws_queue_policy["ledgerClosed"] = WSQueuePolicy::conflate;
+        port.ws_queue_policy["transaction"] = WSQueuePolicy::dropOldest;
+        return port;
+    }
+
+    static std::vector<int>
+    ids(WSSendQueue& q)
+    {
+        std::vector<int> result;
+        while (!q.empty())
+        {
+            result.push_back(static_cast<Msg&>(q.front()).id);
+            q.pop_front();
+        }
+        return result;
+    }
+
+    void
+    testDisconnect()
+    {
+        testcase("disconnect");
+
+        auto const port = makePort(2);
+        WSSendQueue q(port);
+        BEAST_EXPECT(q.push(std::make_shared<Msg>(1, 10)));
+        BEAST_EXPECT(q.push(std::make_shared<Msg>(2, 10), "serverStatus"));
+        BEAST_EXPECT(q.push(std::make_shared<Msg>(3, 10)));
+        BEAST_EXPECT(q.bytes() == 30);
+        BEAST_EXPECT(!q.push(std::make_shared<Msg>(4, 10)));
+        BEAST_EXPECT(q.dropped() == 0);
+
+        q.clear_queued();
+        BEAST_EXPECT(q.size() == 1);
+        BEAST_EXPECT(q.bytes() == 10);
+        BEAST_EXPECT(ids(q) == std::vector<int>({1}));
+        BEAST_EXPECT(q.bytes() == 0);
+    }
+
+    void
+    testDropOldest()
+    {
+        testcase("drop oldest");
+
+        auto const port = makePort(3);
+        WSSendQueue q(port);
+        BEAST_EXPECT(q.push(std::make_shared<Msg>(1, 10), "transaction"));
+        BEAST_EXPECT(q.push(std::make_shared<Msg>(2, 10), "transaction"));
+        BEAST_EXPECT(q.push(std::make_shared<Msg>(3, 10)));
+        BEAST_EXPECT(q.push(std::make_shared<Msg>(4, 10), "transaction"));
+        // The front message is being written and is never dropped
+        BEAST_EXPECT(q.push(std::make_shared<Msg>(5, 10), "transaction"));
+        BEAST_EXPECT(q.push(std::make_shared<Msg>(6, 10), "transaction"));
+        BEAST_EXPECT(q.dropped() == 2);
+        BEAST_EXPECT(q.bytes() == 40);
+        BEAST_EXPECT(ids(q) == std::vector<int>({1, 3, 5, 6}));
+
+        // Once only messages that must not be dropped remain, disconnect
+        BEAST_EXPECT(q.push(std::make_shared<Msg>(7, 10)));
+        for (int i = 8; i < 11; ++i)
+            BEAST_EXPECT(q.push(std::make_shared<Msg>(i, 10)));
+        BEAST_EXPECT(q.push(std::make_shared<Msg>(11, 10), "transaction"));
+        BEAST_EXPECT(q.dropped() == 3);
+        BEAST_EXPECT(!q.push(std::make_shared<Msg>(12, 10)));
+    }
+
+    void
+    testConflate()
+    {
+        testcase("conflate");
+
+        auto const port = makePort(100);
+        WSSendQueue q(port);
+        BEAST_EXPECT(q.push(std::make_shared<Msg>(1, 10), "ledgerClosed"));
+        BEAST_EXPECT(q.push(std::make_shared<Msg>(2, 10), "ledgerClosed"));
+        BEAST_EXPECT(q.push(std::make_shared<Msg>(3, 10), "transaction"));
+        BEAST_EXPECT(q.push(std::make_shared<Msg>(4, 10), "ledgerClosed"));
+        BEAST_EXPECT(q.push(std::make_shared<Msg>(5, 10), "ledgerClosed"));
+        BEAST_EXPECT(q.dropped() == 2);
+        BEAST_EXPECT(ids(q) == std::vector<int>({1, 3, 5}));
+    }
+
+    void
+    testBytes()
+    {
+        testcase("byte limit");
+
+        auto const port = makePort(100, 100);
+        WSSendQueue q(port);
+        // The front message does not count against the limit
+        BEAST_EXPECT(q.push(std::make_shared<Msg>(1, 500)));
+        BEAST_EXPECT(q.push(std::make_shared<Msg>(2, 60), "transaction"));
+        BEAST_EXPECT(q.push(std::make_shared<Msg>(3, 40), "serverStatus"));
+        BEAST_EXPECT(q.bytes() == 600);
+        BEAST_EXPECT(q.push(std::make_shared<Msg>(4, 50), "transaction"));
+        BEAST_EXPECT(q.dropped() == 1);
+        BEAST_EXPECT(q.bytes() == 590);
+        BEAST_EXPECT(!q.push(std::make_shared<Msg>(5, 80), "serverStatus"));
+        BEAST_EXPECT(q.dropped() == 2);
+    }
+
+public:
+    void
+    run() override
+    {
+        testDisconnect();
+        testDropOldest();
+        testConflate();
+        testBytes();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(WSSendQueue, server, ripple);
+
+}  // namespace test
+}  // namespace ripple
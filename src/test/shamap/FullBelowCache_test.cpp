@@ -0,0 +1,152 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/chrono.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <ripple/shamap/FullBelowCache.h>
+#include <test/unit_test/SuiteJournal.h>
+
+namespace ripple {
+namespace tests {
+
+class FullBelowCache_test : public beast::unit_test::suite
+{
+    static uint256
+    randomKey(beast::xor_shift_engine& gen)
+    {
+        uint256 key;
+        for (auto& b : key)
+            b = static_cast<std::uint8_t>(gen());
+        return key;
+    }
+
+    void
+    testExpiration()
+    {
+        testcase("expiration");
+        using namespace std::chrono_literals;
+
+        TestStopwatch clock;
+        clock.set(0);
+        test::SuiteJournal j("FullBelowCache_test", *this);
+        FullBelowCache cache(
+            "test", clock, j, beast::insight::NullCollector::New(), 0, 2s);
+
+        beast::xor_shift_engine gen(7);
+        auto const one = randomKey(gen);
+        auto const two = randomKey(gen);
+
+        BEAST_EXPECT(cache.size() == 0);
+        BEAST_EXPECT(!cache.touch_if_exists(one));
+        cache.insert(one);
+        cache.insert(one);
+        BEAST_EXPECT(cache.size() == 1);
+        BEAST_EXPECT(cache.touch_if_exists(one));
+
+        // Keys are compared in full, not only by their leading bits
+        auto alias = one;
+        alias.data()[alias.size() - 1] ^= 1;
+        BEAST_EXPECT(!cache.touch_if_exists(alias));
+
+        cache.insert(two);
+        ++clock;
+        cache.sweep();
+        BEAST_EXPECT(cache.size() == 2);
+        BEAST_EXPECT(cache.touch_if_exists(two));
+        ++clock;
+        cache.sweep();
+        BEAST_EXPECT(cache.size() == 1);
+        BEAST_EXPECT(!cache.touch_if_exists(one));
+        BEAST_EXPECT(cache.touch_if_exists(two));
+
+        auto const [hits, misses] = cache.getHitsAndMisses();
+        BEAST_EXPECT(hits == 3);
+        BEAST_EXPECT(misses == 3);
+
+        BEAST_EXPECT(cache.getGeneration() == 1);
+        cache.clear();
+        BEAST_EXPECT(cache.size() == 0);
+        BEAST_EXPECT(cache.getGeneration() == 2);
+        cache.reset();
+        BEAST_EXPECT(cache.getGeneration() == 1);
+    }
+
+    void
+    testMany()
+    {
+        testcase("many keys");
+        using namespace std::chrono_literals;
+
+        TestStopwatch clock;
+        clock.set(0);
+        test::SuiteJournal j("FullBelowCache_test", *this);
+        FullBelowCache cache(
+            "test", clock, j, beast::insight::NullCollector::New(), 0, 10s);
+
+        beast::xor_shift_engine gen(42);
+        std::vector<uint256> keys;
+        for (int i = 0; i < 100000; ++i)
+        {
+            keys.push_back(randomKey(gen));
+            cache.insert(keys.back());
+        }
+        BEAST_EXPECT(cache.size() == keys.size());
+
+        BEAST_EXPECT(std::all_of(keys.begin(), keys.end(), [&](auto const& k) {
+            return cache.touch_if_exists(k);
+        }));
+
+        int found = 0;
+        for (int i = 0; i < 100000; ++i)
+            found += cache.touch_if_exists(randomKey(gen));
+        BEAST_EXPECT(found == 0);
+
+        // The keys returned restore the same entries
+        auto const saved = cache.getKeys();
+        BEAST_EXPECT(saved.size() == keys.size());
+        cache.reset();
+        BEAST_EXPECT(cache.size() == 0);
+        for (auto const& key : saved)
+            cache.insert(key);
+        BEAST_EXPECT(cache.size() == keys.size());
+        BEAST_EXPECT(std::all_of(keys.begin(), keys.end(), [&](auto const& k) {
+            return cache.touch_if_exists(k);
+        }));
+
+        // Over its target size, the cache ages entries out faster
+        cache.setTargetSize(keys.size() / 4);
+        clock.advance(3s);
+        cache.sweep();
+        BEAST_EXPECT(cache.size() == 0);
+    }
+
+public:
+    void
+    run() override
+    {
+        testExpiration();
+        testMany();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(FullBelowCache, shamap, ripple);
+
+}  // namespace tests
+}  // namespace ripple
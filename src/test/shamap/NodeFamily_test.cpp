@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/utility/temp_dir.h>
+#include <ripple/shamap/NodeFamily.h>
+#include <boost/filesystem/operations.hpp>
+#include <test/jtx.h>
+#include <algorithm>
+#include <fstream>
+#include <thread>
+
+namespace ripple {
+namespace test {
+
+class NodeFamily_test : public beast::unit_test::suite
+{
+    void
+    testSnapshot()
+    {
+        testcase("cache snapshot");
+        using namespace jtx;
+
+        Env env(*this);
+        env.fund(XRP(10000), "alice", "bob");
+        for (int i = 0; i < 5; ++i)
+        {
+            env(pay("alice", "bob", XRP(1)));
+            env.close();
+        }
+
+        auto& family = dynamic_cast<NodeFamily&>(env.app().getNodeFamily());
+        auto fullBelow = family.getFullBelowCache(0);
+        auto treeNodes = family.getTreeNodeCache(0);
+
+        uint256 const fullBelowKey{1};
+        fullBelow->insert(fullBelowKey);
+        auto const fullBelowCount = fullBelow->size();
+        auto const treeNodeKeys = treeNodes->getKeys();
+        BEAST_EXPECT(!treeNodeKeys.empty());
+
+        beast::temp_dir dir;
+        boost::filesystem::path const file{dir.file("snapshot")};
+
+        family.saveCaches(file);
+        BEAST_EXPECT(boost::filesystem::exists(file));
+
+        family.reset();
+        BEAST_EXPECT(fullBelow->size() == 0);
+        BEAST_EXPECT(treeNodes->getCacheSize() == 0);
+
+        BEAST_EXPECT(
+            family.loadCaches(file) == fullBelowCount + treeNodeKeys.size());
+        BEAST_EXPECT(!boost::filesystem::exists(file));
+        BEAST_EXPECT(fullBelow->touch_if_exists(fullBelowKey));
+
+        // The tree nodes arrive in the background
+        using namespace std::chrono_literals;
+        for (int i = 0; i < 100 && treeNodes->getCacheSize() <
+                 static_cast<int>(treeNodeKeys.size());
+             ++i)
+            std::this_thread::sleep_for(10ms);
+        BEAST_EXPECT(treeNodes->getCacheSize() > 0);
+        BEAST_EXPECT(std::any_of(
+            treeNodeKeys.begin(), treeNodeKeys.end(), [&](auto const& key) {
+                return treeNodes->fetch(key) != nullptr;
+            }));
+
+        // The snapshot is only used once
+        BEAST_EXPECT(family.loadCaches(file) == 0);
+
+        // A damaged snapshot is ignored
+        family.saveCaches(file);
+        boost::filesystem::resize_file(
+            file, boost::filesystem::file_size(file) / 2);
+        BEAST_EXPECT(family.loadCaches(file) == 0);
+        BEAST_EXPECT(!boost::filesystem::exists(file));
+
+        // So is a file of something else
+        {
+            std::ofstream out(file.string());
+            out << "not a snapshot";
+        }
+        BEAST_EXPECT(family.loadCaches(file) == 0);
+    }
+
+public:
+    void
+    run() override
+    {
+        testSnapshot();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(NodeFamily, shamap, ripple);
+
+}  // namespace test
+}  // namespace ripple
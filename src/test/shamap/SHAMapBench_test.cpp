@@ -0,0 +1,450 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/HugePages.h>
+#include <ripple/basics/random.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/utility/temp_dir.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <ripple/shamap/SHAMap.h>
+#include <test/jtx.h>
+#include <test/shamap/common.h>
+#include <test/unit_test/SuiteJournal.h>
+#include <boost/algorithm/string.hpp>
+#include <boost/predef.h>
+#include <chrono>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#if BOOST_OS_LINUX
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ripple {
+namespace tests {
+
+/** Times SHAMap operations on a map of realistic size.
+
+    A state map is filled with random leaves and flushed. A snapshot of
+    it then has a tenth of its leaves updated and another tenth deleted,
+    and the two maps are compared, walked, iterated and synced, as a
+    server does with consecutive ledgers:
+
+        addItem             Leaves added to an empty map.
+        flushDirty          Hashing and storing the new map.
+        snapShot            Copying the map for a new ledger.
+        updateGiveItem      Leaves replaced in the copy, copying on write.
+        delItem             Leaves deleted from the copy.
+        flushDirty (delta)  Hashing and storing the copy's changes.
+        compare             Finding the leaves that differ.
+        compareParallel     The same, a branch of the root per job.
+        walkMap             Visiting every node, looking for missing ones.
+        walkMapParallel     The same, on several threads.
+        const_iterator      Visiting every leaf in order.
+        upper_bound         Finding the leaf after random keys.
+        getFetchPack        Serializing the nodes the copy adds.
+        addKnownNode        Syncing a new map from the copy's nodes.
+
+    Each line reports the operations done, the time per operation and,
+    where the kernel lets the process count them, the data TLB misses per
+    operation.
+
+    The argument is a list of options separated by ';':
+
+        leaves=N        Leaves in the map (default 1000000).
+        lookups=N       Keys looked up by upper_bound (default 100000).
+        backend=NAME    The NodeStore backend the maps are flushed to,
+                        such as memory or nudb, or none to keep the maps
+                        in memory only (default memory).
+        hugepages=MODE  How slabs and inner node arrays are backed: off,
+                        transparent or explicit (default transparent).
+
+    For example:
+
+        --unittest=SHAMapBench --unittest-arg="leaves=10000000;backend=nudb"
+
+    Comparing hugepages=off with the other modes shows what huge pages
+    save. Memory allocated before the suite starts keeps its pages, so
+    run the suite on its own.
+*/
+class SHAMapBench_test : public beast::unit_test::suite
+{
+    using clock_type = std::chrono::steady_clock;
+
+    struct Options
+    {
+        std::size_t leaves = 1'000'000;
+        std::size_t lookups = 100'000;
+        std::string backend = "memory";
+        hugePages::Mode hugePages = hugePages::Mode::transparent;
+    };
+
+    // Counts the data TLB misses of this thread and the threads it starts
+    class TlbMisses
+    {
+        int fd_ = -1;
+
+    public:
+        TlbMisses()
+        {
+#if BOOST_OS_LINUX
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd_ = static_cast<int>(
+                syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+        }
+
+        ~TlbMisses()
+        {
+#if BOOST_OS_LINUX
+            if (fd_ >= 0)
+                close(fd_);
+#endif
+        }
+
+        TlbMisses(TlbMisses const&) = delete;
+        TlbMisses&
+        operator=(TlbMisses const&) = delete;
+
+        std::optional<std::uint64_t>
+        read() const
+        {
+#if BOOST_OS_LINUX
+            std::uint64_t count = 0;
+            if (fd_ >= 0 && ::read(fd_, &count, sizeof(count)) == sizeof(count))
+                return count;
+#endif
+            return std::nullopt;
+        }
+    };
+
+    TlbMisses tlbMisses_;
+
+    beast::xor_shift_engine eng_;
+
+    static Options
+    parse(std::string const& args)
+    {
+        Options options;
+        std::vector<std::string> entries;
+        boost::split(entries, args, boost::algorithm::is_any_of(";"));
+        for (auto const& entry : entries)
+        {
+            auto const eq = entry.find('=');
+            if (eq == std::string::npos)
+                continue;
+            auto const key = entry.substr(0, eq);
+            auto const value = entry.substr(eq + 1);
+            if (key == "leaves")
+                options.leaves = std::stoul(value);
+            else if (key == "lookups")
+                options.lookups = std::stoul(value);
+            else if (key == "backend")
+                options.backend = value;
+            else if (key == "hugepages")
+            {
+                if (auto const mode = hugePages::parseMode(value))
+                    options.hugePages = *mode;
+            }
+        }
+        options.leaves = std::max<std::size_t>(options.leaves, 10);
+        return options;
+    }
+
+    static char const*
+    modeName(hugePages::Mode mode)
+    {
+        switch (mode)
+        {
+            case hugePages::Mode::off:
+                return "off";
+            case hugePages::Mode::explicit_:
+                return "explicit";
+            default:
+                return "transparent";
+        }
+    }
+
+    uint256
+    randomKey()
+    {
+        uint256 key;
+        for (auto& byte : key)
+            byte = rand_byte<unsigned char>(eng_);
+        return key;
+    }
+
+    // About the size of a serialized account root
+    boost::intrusive_ptr<SHAMapItem const>
+    makeItem(uint256 const& key)
+    {
+        Serializer s;
+        for (int i = 0; i < 25; ++i)
+            s.add32(rand_int<std::uint32_t>(eng_));
+        return make_shamapitem(key, s.slice());
+    }
+
+    void
+    report(
+        std::string const& name,
+        std::size_t ops,
+        std::chrono::nanoseconds elapsed,
+        std::optional<std::uint64_t> misses)
+    {
+        using std::setw;
+        std::stringstream ss;
+        ss << std::left << setw(22) << name << std::right << setw(12) << ops
+           << setw(14) << (ops ? elapsed.count() / ops : 0) << setw(14)
+           << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed)
+                  .count()
+           << setw(14);
+        if (misses)
+            ss << std::fixed << std::setprecision(1)
+               << (ops ? double(*misses) / ops : 0);
+        else
+            ss << "-";
+        log << ss.str() << std::endl;
+    }
+
+    // Run f, which returns the operations it did, and report them
+    template <class F>
+    void
+    measure(std::string const& name, F&& f)
+    {
+        auto const misses = tlbMisses_.read();
+        auto const start = clock_type::now();
+        std::size_t const ops = f();
+        auto const elapsed = clock_type::now() - start;
+        auto const after = tlbMisses_.read();
+        report(
+            name,
+            ops,
+            elapsed,
+            misses && after ? std::optional(*after - *misses) : std::nullopt);
+    }
+
+public:
+    void
+    run() override
+    {
+        testcase("SHAMapBench");
+
+        auto const options = parse(arg());
+        auto const previousMode = hugePages::mode();
+        hugePages::setMode(options.hugePages);
+        bool const backed = options.backend != "none";
+        auto const leaves = options.leaves;
+        auto const changes = leaves / 10;
+
+        test::SuiteJournal journal("SHAMapBench_test", *this);
+        beast::temp_dir dir;
+        auto config = [&](std::string const& name) {
+            Section section;
+            section.set("type", backed ? options.backend : "memory");
+            section.set("path", dir.file(name));
+            return section;
+        };
+
+        TestNodeFamily family(config("source"), journal);
+        SHAMap map(SHAMapType::STATE, family);
+        if (!backed)
+            map.setUnbacked();
+
+        log << leaves << " leaves, backend " << options.backend
+            << ", huge pages " << modeName(options.hugePages) << std::endl;
+        {
+            using std::setw;
+            std::stringstream ss;
+            ss << std::left << setw(22) << "Operation" << std::right
+               << setw(12) << "Count" << setw(14) << "ns/op" << setw(14)
+               << "total ms" << setw(14) << "dTLB miss/op";
+            log << ss.str() << std::endl;
+        }
+
+        std::vector<uint256> keys;
+        keys.reserve(leaves);
+        for (std::size_t i = 0; i < leaves; ++i)
+            keys.push_back(randomKey());
+
+        std::vector<boost::intrusive_ptr<SHAMapItem const>> items;
+        items.reserve(leaves);
+        for (auto const& key : keys)
+            items.push_back(makeItem(key));
+
+        measure("addItem", [&] {
+            for (auto& item : items)
+                map.addItem(SHAMapNodeType::tnACCOUNT_STATE, std::move(item));
+            return leaves;
+        });
+        items.clear();
+
+        measure("flushDirty", [&] {
+            return map.flushDirty(hotACCOUNT_NODE);
+        });
+        map.setImmutable();
+
+        std::shared_ptr<SHAMap> copy;
+        measure("snapShot", [&] {
+            copy = map.snapShot(true);
+            return 1;
+        });
+
+        for (std::size_t i = 0; i < changes; ++i)
+            items.push_back(makeItem(keys[i]));
+        measure("updateGiveItem", [&] {
+            for (auto& item : items)
+                copy->updateGiveItem(
+                    SHAMapNodeType::tnACCOUNT_STATE, std::move(item));
+            return changes;
+        });
+        items.clear();
+
+        measure("delItem", [&] {
+            for (std::size_t i = changes; i < 2 * changes; ++i)
+                copy->delItem(keys[i]);
+            return changes;
+        });
+
+        measure("flushDirty (delta)", [&] {
+            return copy->flushDirty(hotACCOUNT_NODE);
+        });
+        copy->setImmutable();
+
+        SHAMap::Delta differences;
+        auto constexpr maxCount = std::numeric_limits<int>::max();
+        measure("compare", [&] {
+            BEAST_EXPECT(map.compare(*copy, differences, maxCount));
+            return differences.size();
+        });
+        BEAST_EXPECT(differences.size() == 2 * changes);
+
+        differences.clear();
+        test::jtx::Env env(*this);
+        measure("compareParallel", [&] {
+            BEAST_EXPECT(map.compareParallel(
+                *copy, differences, maxCount, env.app().getJobQueue()));
+            return differences.size();
+        });
+        BEAST_EXPECT(differences.size() == 2 * changes);
+
+        std::vector<SHAMapMissingNode> missing;
+        measure("walkMap", [&] {
+            map.walkMap(missing, 1);
+            return leaves;
+        });
+        BEAST_EXPECT(missing.empty());
+
+        measure("walkMapParallel", [&] {
+            map.walkMapParallel(missing, 1);
+            return leaves;
+        });
+        BEAST_EXPECT(missing.empty());
+
+        measure("const_iterator", [&] {
+            std::size_t count = 0;
+            for (auto const& item : map)
+            {
+                (void)item;
+                ++count;
+            }
+            return count;
+        });
+
+        std::vector<uint256> lookups;
+        lookups.reserve(options.lookups);
+        for (std::size_t i = 0; i < options.lookups; ++i)
+            lookups.push_back(randomKey());
+        measure("upper_bound", [&] {
+            std::size_t found = 0;
+            for (auto const& key : lookups)
+                found += map.upper_bound(key) != map.end();
+            return lookups.size();
+        });
+
+        // As LedgerMaster builds a fetch pack for a peer which has the map
+        std::vector<std::pair<uint256, Blob>> pack;
+        measure("getFetchPack", [&] {
+            Serializer s(1024);
+            copy->visitDifferences(&map, [&](SHAMapTreeNode const& node) {
+                s.erase();
+                node.serializeWithPrefix(s);
+                pack.emplace_back(node.getHash().as_uint256(), s.getData());
+                return true;
+            });
+            return pack.size();
+        });
+        pack.clear();
+
+        // Sync a map from the copy's nodes, as InboundLedger does, timing
+        // only the adding of the nodes
+        TestNodeFamily destFamily(config("destination"), journal);
+        SHAMap dest(SHAMapType::STATE, destFamily);
+        dest.setSynching();
+        {
+            std::vector<std::pair<SHAMapNodeID, Blob>> root;
+            BEAST_EXPECT(copy->getNodeFat(SHAMapNodeID(), root, true, 0));
+            BEAST_EXPECT(dest.addRootNode(
+                                 copy->getHash(),
+                                 makeSlice(root.front().second),
+                                 nullptr)
+                             .isGood());
+        }
+
+        std::size_t added = 0;
+        std::chrono::nanoseconds adding{};
+        for (;;)
+        {
+            auto const wanted = dest.getMissingNodes(2048, nullptr);
+            if (wanted.empty())
+                break;
+
+            std::vector<std::pair<SHAMapNodeID, Blob>> nodes;
+            for (auto const& node : wanted)
+                copy->getNodeFat(node.first, nodes, true, 2);
+
+            auto const start = clock_type::now();
+            for (auto const& [id, data] : nodes)
+                dest.addKnownNode(id, makeSlice(data), nullptr);
+            adding += clock_type::now() - start;
+            added += nodes.size();
+        }
+        dest.clearSynching();
+        BEAST_EXPECT(dest.getHash() == copy->getHash());
+
+        report("addKnownNode", added, adding, std::nullopt);
+
+        hugePages::setMode(previousMode);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(SHAMapBench, shamap, ripple, 10);
+
+}  // namespace tests
+}  // namespace ripple
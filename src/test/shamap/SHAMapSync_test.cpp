@@ -184,6 +184,96 @@ public:
         BEAST_EXPECT(source.deepCompare(destination));
 
         destination.invariants();
+
+        testBatched();
+        testFromStore();
+    }
+
+    void
+    testBatched()
+    {
+        test::SuiteJournal journal("SHAMapSync_test", *this);
+
+        TestNodeFamily f(journal), f2(journal);
+        SHAMap source(SHAMapType::FREE, f);
+        SHAMap destination(SHAMapType::FREE, f2);
+
+        for (int i = 0; i < 5000; ++i)
+            source.addItem(SHAMapNodeType::tnACCOUNT_STATE, makeRandomAS());
+        source.invariants();
+        source.setImmutable();
+
+        destination.setSynching();
+
+        {
+            std::vector<std::pair<SHAMapNodeID, Blob>> a;
+            BEAST_EXPECT(source.getNodeFat(SHAMapNodeID(), a, false, 0));
+            BEAST_EXPECT(
+                destination
+                    .addRootNode(
+                        source.getHash(), makeSlice(a[0].second), nullptr)
+                    .isGood());
+        }
+
+        do
+        {
+            f.clock().advance(std::chrono::seconds(1));
+
+            auto nodesMissing = destination.getMissingNodes(2048, nullptr);
+            if (nodesMissing.empty())
+                break;
+
+            std::vector<std::pair<SHAMapNodeID, Blob>> b;
+            for (auto& it : nodesMissing)
+            {
+                if (!source.getNodeFat(it.first, b, false, 2))
+                    fail("", __FILE__, __LINE__);
+            }
+
+            // Hand the nodes over with children ahead of their parents,
+            // which the batch must put back in order.
+            std::vector<std::pair<SHAMapNodeID, Slice>> nodes;
+            for (auto it = b.rbegin(); it != b.rend(); ++it)
+                nodes.emplace_back(it->first, makeSlice(it->second));
+
+            auto const san = destination.addKnownNodes(nodes, nullptr);
+            if (san.isInvalid() ||
+                san.getGood() != static_cast<int>(nodes.size()))
+                fail("", __FILE__, __LINE__);
+        } while (true);
+
+        destination.clearSynching();
+
+        BEAST_EXPECT(source.deepCompare(destination));
+        destination.invariants();
+    }
+
+    void
+    testFromStore()
+    {
+        // A map whose nodes are all in the node store is completed by the
+        // reads made while looking for missing nodes.
+        test::SuiteJournal journal("SHAMapSync_test", *this);
+
+        TestNodeFamily f(journal);
+        SHAMap source(SHAMapType::FREE, f);
+
+        for (int i = 0; i < 5000; ++i)
+            source.addItem(SHAMapNodeType::tnACCOUNT_STATE, makeRandomAS());
+        source.flushDirty(hotACCOUNT_NODE);
+
+        // Forget the nodes, so that they must be read back.
+        f.reset();
+
+        SHAMap destination(SHAMapType::FREE, f);
+        destination.setSynching();
+        BEAST_EXPECT(destination.fetchRoot(source.getHash(), nullptr));
+
+        BEAST_EXPECT(destination.getMissingNodes(2048, nullptr).empty());
+        BEAST_EXPECT(!destination.isSynching());
+
+        BEAST_EXPECT(source.deepCompare(destination));
+        destination.invariants();
     }
 };
 
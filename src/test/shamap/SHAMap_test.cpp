@@ -21,7 +21,9 @@
 #include <ripple/basics/Buffer.h>
 #include <ripple/beast/unit_test.h>
 #include <ripple/beast/utility/Journal.h>
+#include <ripple/protocol/digest.h>
 #include <ripple/shamap/SHAMap.h>
+#include <test/jtx.h>
 #include <test/shamap/common.h>
 #include <test/unit_test/SuiteJournal.h>
 
@@ -325,6 +327,325 @@ public:
                 --h;
             }
         }
+
+        if (!backed)
+            return;
+
+        testcase("deferred flush");
+
+        {
+            tests::TestNodeFamily tf{journal};
+            SHAMap deferred{SHAMapType::FREE, tf};
+            SHAMap direct{SHAMapType::FREE, tf};
+            for (int i = 0; i < 500; ++i)
+            {
+                auto const key = sha512Half(i);
+                deferred.addItem(
+                    SHAMapNodeType::tnTRANSACTION_NM,
+                    make_shamapitem(key, IntToVUC(i)));
+                direct.addItem(
+                    SHAMapNodeType::tnTRANSACTION_NM,
+                    make_shamapitem(key, IntToVUC(i + 1)));
+            }
+
+            std::vector<std::shared_ptr<SHAMapTreeNode>> nodes;
+            auto const flushed =
+                deferred.flushDirty(hotTRANSACTION_NODE, nodes);
+            BEAST_EXPECT(flushed > 0);
+            BEAST_EXPECT(direct.flushDirty(hotTRANSACTION_NODE) > 0);
+            BEAST_EXPECT(direct.getHash() != deferred.getHash());
+
+            // The hashes are final, but nothing has been written
+            auto const root = deferred.getHash().as_uint256();
+            BEAST_EXPECT(!tf.db().fetchNodeObject(root));
+            BEAST_EXPECT(
+                tf.db().fetchNodeObject(direct.getHash().as_uint256()));
+
+            // The nodes are in depth-first order: the root first, and the
+            // children of each inner node after it, in branch order
+            BEAST_EXPECT(nodes.front()->getHash().as_uint256() == root);
+            std::map<uint256, std::size_t> position;
+            for (std::size_t i = 0; i < nodes.size(); ++i)
+                position[nodes[i]->getHash().as_uint256()] = i;
+            for (std::size_t i = 0; i < nodes.size(); ++i)
+            {
+                if (!nodes[i]->isInner())
+                    continue;
+                auto const& inner =
+                    static_cast<SHAMapInnerNode const&>(*nodes[i]);
+                std::size_t last = i;
+                for (unsigned branch = 0; branch < SHAMap::branchFactor;
+                     ++branch)
+                {
+                    if (inner.isEmptyBranch(branch))
+                        continue;
+                    auto const it = position.find(
+                        inner.getChildHash(branch).as_uint256());
+                    BEAST_EXPECT(it != position.end() && it->second > last);
+                    if (it != position.end())
+                        last = it->second;
+                }
+            }
+
+            deferred.storeNodes(hotTRANSACTION_NODE, nodes);
+            for (auto const& node : nodes)
+                BEAST_EXPECT(
+                    tf.db().fetchNodeObject(node->getHash().as_uint256()));
+            BEAST_EXPECT(tf.db().fetchNodeObject(root));
+        }
+
+        testcase("parallel compare");
+
+        {
+            test::jtx::Env env(*this);
+            auto& jobQueue = env.app().getJobQueue();
+            tests::TestNodeFamily tf{journal};
+            SHAMap base{SHAMapType::FREE, tf};
+            SHAMap changed{SHAMapType::FREE, tf};
+            for (int i = 0; i < 1000; ++i)
+            {
+                auto const key = sha512Half(i);
+                base.addItem(
+                    SHAMapNodeType::tnACCOUNT_STATE,
+                    make_shamapitem(key, IntToVUC(i)));
+                // Modify some items, drop some, and add some new ones
+                if (i % 7 == 0)
+                    changed.addItem(
+                        SHAMapNodeType::tnACCOUNT_STATE,
+                        make_shamapitem(key, IntToVUC(i + 1)));
+                else if (i % 11 != 0)
+                    changed.addItem(
+                        SHAMapNodeType::tnACCOUNT_STATE,
+                        make_shamapitem(key, IntToVUC(i)));
+                if (i % 13 == 0)
+                    changed.addItem(
+                        SHAMapNodeType::tnACCOUNT_STATE,
+                        make_shamapitem(sha512Half(-i - 1), IntToVUC(i)));
+            }
+            base.flushDirty(hotACCOUNT_NODE);
+            changed.flushDirty(hotACCOUNT_NODE);
+
+            SHAMap::Delta serial;
+            SHAMap::Delta parallel;
+            BEAST_EXPECT(base.compare(changed, serial, 100000));
+            BEAST_EXPECT(
+                base.compareParallel(changed, parallel, 100000, jobQueue));
+            BEAST_EXPECT(!serial.empty());
+            BEAST_EXPECT(serial.size() == parallel.size());
+            for (auto const& [key, items] : serial)
+            {
+                auto const it = parallel.find(key);
+                if (!BEAST_EXPECT(it != parallel.end()))
+                    continue;
+                BEAST_EXPECT(bool(items.first) == bool(it->second.first));
+                BEAST_EXPECT(bool(items.second) == bool(it->second.second));
+                if (items.first && it->second.first)
+                    BEAST_EXPECT(*items.first == *it->second.first);
+                if (items.second && it->second.second)
+                    BEAST_EXPECT(*items.second == *it->second.second);
+            }
+
+            // Identical maps have no differences
+            SHAMap::Delta none;
+            BEAST_EXPECT(base.compareParallel(base, none, 10, jobQueue));
+            BEAST_EXPECT(none.empty());
+
+            // Too many differences
+            SHAMap::Delta limited;
+            BEAST_EXPECT(
+                !base.compareParallel(changed, limited, 10, jobQueue));
+            BEAST_EXPECT(limited.size() == 10);
+        }
+
+        testcase("parallel walk");
+
+        {
+            tests::TestNodeFamily tf{journal};
+            SHAMap map{SHAMapType::FREE, tf};
+            for (int i = 0; i < 5000; ++i)
+                map.addItem(
+                    SHAMapNodeType::tnACCOUNT_STATE,
+                    make_shamapitem(sha512Half(i + 100000), IntToVUC(i)));
+
+            std::vector<std::shared_ptr<SHAMapTreeNode>> nodes;
+            map.flushDirty(hotACCOUNT_NODE, nodes);
+            auto const root = map.getHash();
+
+            // Store all but some of the leaves, and load the map through a
+            // family that has none of its nodes in memory
+            tests::TestNodeFamily partial{journal};
+            std::vector<std::shared_ptr<SHAMapTreeNode>> kept;
+            std::size_t dropped = 0;
+            for (auto const& node : nodes)
+            {
+                if (node->isLeaf() && ++dropped % 100 == 0)
+                    continue;
+                kept.push_back(node);
+            }
+            dropped /= 100;
+            map.storeNodes(hotACCOUNT_NODE, kept);
+
+            SHAMap incomplete{
+                SHAMapType::FREE, root.as_uint256(), partial};
+            BEAST_EXPECT(incomplete.fetchRoot(root, nullptr));
+
+            for (int workers : {0, 1, 5, 64})
+            {
+                std::vector<SHAMapMissingNode> missing;
+                BEAST_EXPECT(map.walkMapParallel(missing, 1000, workers));
+                BEAST_EXPECT(missing.empty());
+
+                BEAST_EXPECT(
+                    incomplete.walkMapParallel(missing, 1000, workers));
+                BEAST_EXPECT(missing.size() == dropped);
+            }
+
+            std::vector<SHAMapMissingNode> missing;
+            BEAST_EXPECT(incomplete.walkMapParallel(missing, 10, 4));
+            BEAST_EXPECT(missing.size() == 10);
+        }
+
+        testcase("prefetch");
+
+        {
+            tests::TestNodeFamily tf{journal};
+            SHAMap map{SHAMapType::FREE, tf};
+            std::vector<uint256> keys;
+            for (int i = 0; i < 5000; ++i)
+            {
+                keys.push_back(sha512Half(i + 200000));
+                map.addItem(
+                    SHAMapNodeType::tnACCOUNT_STATE,
+                    make_shamapitem(keys.back(), IntToVUC(i)));
+            }
+
+            std::vector<std::shared_ptr<SHAMapTreeNode>> nodes;
+            map.flushDirty(hotACCOUNT_NODE, nodes);
+            map.storeNodes(hotACCOUNT_NODE, nodes);
+            auto const root = map.getHash();
+
+            // Load the map through a family with none of its nodes in
+            // memory, and read in the paths to every other key and to
+            // some keys that are not in the map
+            tests::TestNodeFamily loaded{journal};
+            SHAMap prefetched{SHAMapType::FREE, root.as_uint256(), loaded};
+            BEAST_EXPECT(prefetched.fetchRoot(root, nullptr));
+
+            std::vector<uint256> wanted;
+            for (std::size_t i = 0; i < keys.size(); i += 2)
+                wanted.push_back(keys[i]);
+            for (int i = 0; i < 100; ++i)
+                wanted.push_back(sha512Half(-i - 1));
+            prefetched.prefetch(wanted);
+
+            // With the node store out of reach, the keys read in are
+            // found and the others are not
+            prefetched.setUnbacked();
+            for (std::size_t i = 0; i < keys.size(); i += 2)
+                BEAST_EXPECT(prefetched.hasItem(keys[i]));
+            for (int i = 0; i < 100; ++i)
+                BEAST_EXPECT(!prefetched.hasItem(sha512Half(-i - 1)));
+
+            std::size_t found = 0;
+            for (std::size_t i = 1; i < keys.size(); i += 2)
+            {
+                try
+                {
+                    found += prefetched.hasItem(keys[i]);
+                }
+                catch (SHAMapMissingNode const&)
+                {
+                }
+            }
+            BEAST_EXPECT(found <= 100);
+        }
+
+        testcase("sorted build");
+
+        // Small enough to be built on one thread, and large enough to be
+        // built on several
+        for (int count : {0, 1, 2, 300, 10000})
+        {
+            tests::TestNodeFamily tf{journal};
+            SHAMap incremental{SHAMapType::FREE, tf};
+            std::vector<boost::intrusive_ptr<SHAMapItem const>> items;
+            for (int i = 0; i < count; ++i)
+            {
+                auto item = make_shamapitem(sha512Half(i), IntToVUC(i));
+                incremental.addItem(
+                    SHAMapNodeType::tnACCOUNT_STATE, make_shamapitem(*item));
+                items.push_back(std::move(item));
+            }
+            std::sort(
+                items.begin(), items.end(), [](auto const& a, auto const& b) {
+                    return a->key() < b->key();
+                });
+
+            SHAMap sorted{SHAMapType::FREE, tf};
+            BEAST_EXPECT(
+                sorted.addSortedItems(SHAMapNodeType::tnACCOUNT_STATE, items));
+            BEAST_EXPECT(sorted.getHash() == incremental.getHash());
+            for (auto const& item : items)
+                BEAST_EXPECT(sorted.hasItem(item->key()));
+
+            // The map must be empty
+            BEAST_EXPECT(
+                count == 0 ||
+                !sorted.addSortedItems(
+                    SHAMapNodeType::tnACCOUNT_STATE, items));
+        }
+
+        {
+            tests::TestNodeFamily tf{journal};
+            std::vector<boost::intrusive_ptr<SHAMapItem const>> items{
+                make_shamapitem(uint256{2}, IntToVUC(2)),
+                make_shamapitem(uint256{1}, IntToVUC(1))};
+            SHAMap unsorted{SHAMapType::FREE, tf};
+            BEAST_EXPECT(!unsorted.addSortedItems(
+                SHAMapNodeType::tnACCOUNT_STATE, items));
+
+            items[0] = items[1];
+            SHAMap duplicate{SHAMapType::FREE, tf};
+            BEAST_EXPECT(!duplicate.addSortedItems(
+                SHAMapNodeType::tnACCOUNT_STATE, items));
+        }
+
+        testcase("streamed build");
+
+        {
+            tests::TestNodeFamily tf{journal};
+            SHAMap incremental{SHAMapType::FREE, tf};
+            std::vector<boost::intrusive_ptr<SHAMapItem const>> items;
+            for (int i = 0; i < 5000; ++i)
+            {
+                auto item = make_shamapitem(sha512Half(i), IntToVUC(i));
+                incremental.addItem(
+                    SHAMapNodeType::tnACCOUNT_STATE, make_shamapitem(*item));
+                items.push_back(std::move(item));
+            }
+            std::sort(
+                items.begin(), items.end(), [](auto const& a, auto const& b) {
+                    return a->key() < b->key();
+                });
+
+            SHAMap streamed{SHAMapType::FREE, tf};
+            {
+                // An abandoned build leaves the map empty
+                SHAMap::Builder builder(
+                    streamed, SHAMapNodeType::tnACCOUNT_STATE);
+                for (auto const& item : items)
+                    BEAST_EXPECT(builder.add(item));
+                BEAST_EXPECT(!builder.add(items.front()));
+            }
+            BEAST_EXPECT(streamed.getHash().isZero());
+
+            SHAMap::Builder builder(streamed, SHAMapNodeType::tnACCOUNT_STATE);
+            for (auto const& item : items)
+                BEAST_EXPECT(builder.add(item));
+            BEAST_EXPECT(!builder.add(items.back()));
+            builder.finish();
+            BEAST_EXPECT(streamed.getHash() == incremental.getHash());
+        }
     }
 };
 
@@ -43,7 +43,12 @@ private:
     beast::Journal const j_;
 
 public:
-    TestNodeFamily(beast::Journal j)
+    TestNodeFamily(beast::Journal j) : TestNodeFamily(memoryConfig(), j)
+    {
+    }
+
+    /** Use the NodeStore backend described by config. */
+    TestNodeFamily(Section const& config, beast::Journal j)
         : fbCache_(std::make_shared<FullBelowCache>(
               "App family full below cache",
               clock_,
@@ -56,11 +61,17 @@ public:
               j))
         , j_(j)
     {
-        Section testSection;
-        testSection.set("type", "memory");
-        testSection.set("path", "SHAMap_test");
         db_ = NodeStore::Manager::instance().make_Database(
-            megabytes(4), scheduler_, 1, testSection, j);
+            megabytes(4), scheduler_, 1, config, j);
+    }
+
+    static Section
+    memoryConfig()
+    {
+        Section config;
+        config.set("type", "memory");
+        config.set("path", "SHAMap_test");
+        return config;
     }
 
     NodeStore::Database&